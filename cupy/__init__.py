@@ -9,6 +9,7 @@ from cupy import _version
 
 _environment._detect_duplicate_installation()  # NOQA
 _environment._setup_win32_dll_directory()  # NOQA
+_environment._setup_lazy_module_loading()  # NOQA
 _environment._preload_library('cutensor')  # NOQA
 
 
@@ -808,7 +809,8 @@ from cupy._core import fromDlpack  # NOQA
 from cupy._core import from_dlpack  # NOQA
 
 
-def asnumpy(a, stream=None, order='C', out=None, *, blocking=True):
+def asnumpy(
+        a, stream=None, order='C', out=None, *, blocking=True, out_pool=None):
     """Returns an array on the host memory from an arbitrary source array.
 
     Args:
@@ -827,11 +829,28 @@ def asnumpy(a, stream=None, order='C', out=None, *, blocking=True):
             on the given (if given) or current stream, and users are
             responsible for ensuring the stream order. Default is ``True``,
             so the copy is synchronous (with respect to the host).
+        out_pool (cupy.cuda.PinnedMemoryPool): If given and ``out`` is not,
+            the host array is allocated from this pool of pinned memory, so
+            that the copy is asynchronous with ``blocking=False`` and the
+            memory is reused after the array is freed, instead of
+            allocating pageable memory for each call.
 
     Returns:
         numpy.ndarray: Converted array on the host memory.
 
+    .. seealso:: :meth:`cupy.ndarray.host_view` to read arrays in managed
+        memory without a copy.
+
     """
+    if out is None and out_pool is not None and (
+            isinstance(a, ndarray) or hasattr(a, '__cuda_array_interface__')):
+        if not isinstance(a, ndarray):
+            a = array(a)
+        order = order.upper()
+        if order == 'A':
+            order = 'F' if a.flags.f_contiguous else 'C'
+        mem = out_pool.malloc(a.nbytes)
+        out = _numpy.ndarray(a.shape, dtype=a.dtype, buffer=mem, order=order)
     if isinstance(a, ndarray):
         return a.get(stream=stream, order=order, out=out, blocking=blocking)
     elif hasattr(a, "__cuda_array_interface__"):
@@ -875,7 +894,8 @@ def get_array_module(*args):
     for arg in args:
         if isinstance(arg, (ndarray, _cupyx.scipy.sparse.spmatrix,
                             _core.fusion._FusionVarArray,
-                            _core.new_fusion._ArrayProxy)):
+                            _core.new_fusion._ArrayProxy,
+                            _cupyx._lazy.LazyArray)):
             return _cupy
     return _numpy
 
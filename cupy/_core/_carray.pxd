@@ -42,6 +42,10 @@ cdef class Indexer:
         readonly Py_ssize_t size
         readonly shape_t shape
         readonly bint _index_32_bits
+        # If True, the shape is compiled into the kernel as constants
+        public bint _static_shape
+        # The CIndexer passed to the kernels, created once
+        function.CPointer _cindexer
 
     cdef void init(self, const shape_t& shape)
 
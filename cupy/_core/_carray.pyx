@@ -84,15 +84,19 @@ cdef class Indexer:
         self.shape = shape
         self.size = internal.prod(shape)
         self._index_32_bits = self.size <= (1 << 31)
+        self._static_shape = False
 
     @property
     def ndim(self):
         return self.shape.size()
 
     cdef function.CPointer get_pointer(self):
-        cdef CIndexer indexer = CIndexer.__new__(CIndexer)
-        indexer.init(self.size, self.shape)
-        return indexer
+        cdef CIndexer indexer
+        if self._cindexer is None:
+            indexer = CIndexer.__new__(CIndexer)
+            indexer.init(self.size, self.shape)
+            self._cindexer = indexer
+        return self._cindexer
 
 
 cdef inline Indexer _indexer_init(const shape_t& shape):
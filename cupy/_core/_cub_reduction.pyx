@@ -14,6 +14,9 @@ from cupy_backends.cuda.api cimport runtime
 
 import math
 import string
+
+import numpy
+
 from cupy import _environment
 from cupy._core._kernel import _get_param_info
 from cupy.cuda import driver
@@ -245,6 +248,103 @@ def _SimpleCubReductionKernel_get_cached_function(
         type_map, preamble, options)
 
 
+# The kernel reducing the rows of a matrix, whose columns are contiguous,
+# into one row. Each block reduces a tile of _tile_cols columns, so that the
+# loads of a warp are coalesced however far apart the rows are, and the
+# block_size / _tile_cols threads of each column accumulate down the rows.
+# With a grid of several blocks along y, each reduces a share of the rows
+# and writes a row of partial results, which is reduced by a second launch.
+cdef str _column_reduction_kernel_code = '''
+${type_preamble}
+${preamble}
+
+typedef ${reduce_type} _type_reduce;
+
+static_assert(sizeof(_type_reduce) <= 32,
+    "The intermediate reduction type is assumed to be at most 32 bytes.");
+
+#define REDUCE(a, b) (${reduce_expr})
+
+#if defined FIRST_PASS
+    typedef type_in0_raw  type_mid_in;
+    typedef _type_reduce  type_mid_out;
+    #define POST_MAP(a)   out0 = a;
+#elif defined SECOND_PASS
+    typedef _type_reduce  type_mid_in;
+    typedef type_out0_raw type_mid_out;
+    #define POST_MAP(a)   (${post_map_expr})
+#else  // one-pass reduction
+    typedef type_in0_raw  type_mid_in;
+    typedef type_out0_raw type_mid_out;
+    #define POST_MAP(a)   (${post_map_expr})
+#endif
+
+extern "C"
+__global__ void ${name}(const void* _raw_in0, void* _raw_out0,
+                        long long _rows, long long _cols,
+                        long long _row_stride, long long _reduce_size) {
+  constexpr unsigned int _block_size = ${block_size};
+  constexpr unsigned int _tile_cols = 32;
+  constexpr unsigned int _tile_rows = _block_size / _tile_cols;
+  __shared__ char _sdata_raw[_block_size * sizeof(_type_reduce)];
+  _type_reduce *_sdata = reinterpret_cast<_type_reduce*>(_sdata_raw);
+
+  const type_mid_in* _in0 = static_cast<const type_mid_in*>(_raw_in0);
+  type_mid_out* _out0 = static_cast<type_mid_out*>(_raw_out0);
+
+  unsigned int _tid = threadIdx.x;
+  unsigned int _x = _tid % _tile_cols;
+  unsigned int _y = _tid / _tile_cols;
+  long long _c = (long long)blockIdx.x * _tile_cols + _x;
+
+  _type_reduce _s = _type_reduce(${identity});
+  if (_c < _cols) {
+    for (IndexT _J = (IndexT)blockIdx.y * _tile_rows + _y; _J < _rows;
+         _J += (IndexT)gridDim.y * _tile_rows) {
+      const type_mid_in in0 = _in0[_J * _row_stride + _c];
+      _type_reduce _a = static_cast<_type_reduce>(${pre_map_expr});
+      _s = REDUCE(_s, _a);
+    }
+  }
+  _sdata[_tid] = _s;
+  __syncthreads();
+  for (unsigned int _k = _tile_rows / 2; _k > 0; _k >>= 1) {
+    if (_y < _k) {
+      _type_reduce _a = _sdata[_tid], _b = _sdata[_tid + _k * _tile_cols];
+      _sdata[_tid] = REDUCE(_a, _b);
+    }
+    __syncthreads();
+  }
+
+  if (_y == 0 && _c < _cols) {
+    type_mid_out& out0 = _out0[blockIdx.y * _cols + _c];
+    POST_MAP(_sdata[_x]);
+  }
+}
+'''
+
+
+@_util.memoize(for_each_device=True)
+def _ColumnReductionKernel_get_cached_function(
+        map_expr, reduce_expr, post_map_expr, reduce_type,
+        _kernel._TypeMap type_map, name, block_size, identity, preamble,
+        options):
+    name = name.replace('cupy_', 'cupy_column_')
+    name = name.replace('cupyx_', 'cupyx_column_')
+    module_code = string.Template(_column_reduction_kernel_code).substitute(
+        name=name,
+        block_size=block_size,
+        reduce_type=reduce_type,
+        identity=identity,
+        reduce_expr=reduce_expr,
+        pre_map_expr=map_expr,
+        post_map_expr=post_map_expr,
+        type_preamble=type_map.get_typedef_code(),
+        preamble=preamble)
+    module = compile_with_cache(module_code, options)
+    return module.get_function(name)
+
+
 cdef str _cub_path = _environment.get_cub_path()
 cdef str _nvcc_path = _environment.get_nvcc_path()
 cdef str _rocm_path = _environment.get_rocm_path()
@@ -548,6 +648,160 @@ cdef inline void _launch_cub(
             out_block_num * block_size, inout_args, 0, block_size, stream)
 
 
+cdef Py_ssize_t _column_block_size = 256
+cdef Py_ssize_t _column_tile_cols = 32
+cdef dict _sm_counts = {}
+
+
+cdef inline bint _collapse_axes(
+        _ndarray_base arr, tuple axes, Py_ssize_t* size,
+        Py_ssize_t* stride):
+    # Whether the axes can be viewed as one axis, in the C order; sets its
+    # size and its stride in elements.
+    cdef Py_ssize_t i, n = 1, s = 0, itemsize = arr.dtype.itemsize
+    for i in reversed(axes):
+        if arr._shape[i] == 1:
+            continue
+        if s == 0:
+            if arr._strides[i] <= 0 or arr._strides[i] % itemsize:
+                return False
+            s = arr._strides[i] // itemsize
+        elif arr._strides[i] != s * n * itemsize:
+            return False
+        n *= arr._shape[i]
+    size[0] = n
+    stride[0] = s
+    return True
+
+
+# make it cpdef'd for unit tests
+cpdef inline tuple _can_use_column_reduction(
+        list in_args, list out_args, tuple reduce_axis, tuple out_axis):
+    '''
+    If the input can be reduced as a matrix with contiguous columns, this
+    function returns a tuple of the number of rows, the number of columns and
+    the stride of the rows in elements, otherwise returns None.
+    '''
+    cdef _ndarray_base in_arr, out_arr
+    cdef Py_ssize_t rows, cols, row_stride, col_stride
+
+    # we currently support reductions with 1 input and 1 output
+    if len(in_args) != 1 or len(out_args) != 1:
+        return None
+    if not isinstance(in_args[0], _ndarray_base):
+        return None
+    in_arr = in_args[0]
+    out_arr = out_args[0]
+
+    # the columns are written in the order of the output axes
+    reduce_axis = tuple(sorted(reduce_axis))
+    if not out_arr._c_contiguous:
+        return None
+    if not _collapse_axes(in_arr, out_axis, &cols, &col_stride):
+        return None
+    if not _collapse_axes(in_arr, reduce_axis, &rows, &row_stride):
+        return None
+    if col_stride != 1 or rows < 2 or cols < 2:
+        return None
+    return (rows, cols, row_stride)
+
+
+cdef inline void _launch_column_reduction(
+        self, _ndarray_base in_arr, _ndarray_base out_arr,
+        Py_ssize_t rows, Py_ssize_t cols, Py_ssize_t row_stride,
+        str map_expr, str reduce_expr, str post_map_expr, str reduce_type,
+        _kernel._TypeMap type_map, stream) except *:
+    cdef function.Function func
+    cdef memory.MemoryPointer memptr
+    cdef Py_ssize_t n_tiles, n_splits, tile_rows
+    cdef int device_id
+
+    device_id = in_arr.data.device_id
+    sm_count = _sm_counts.get(device_id)
+    if sm_count is None:
+        sm_count = runtime.deviceGetAttribute(
+            runtime.cudaDevAttrMultiProcessorCount, device_id)
+        _sm_counts[device_id] = sm_count
+
+    # split the rows among several blocks if the tiles do not fill the
+    # device, keeping at least 16 rows for each thread
+    tile_rows = _column_block_size // _column_tile_cols
+    n_tiles = (cols + _column_tile_cols - 1) // _column_tile_cols
+    n_splits = min(4 * sm_count // n_tiles, rows // (tile_rows * 16), 65535)
+    block = (_column_block_size,)
+
+    if n_splits < 2:
+        func = _ColumnReductionKernel_get_cached_function(
+            map_expr, reduce_expr, post_map_expr, reduce_type, type_map,
+            self.name, _column_block_size, self.identity, self.preamble, ())
+        func((n_tiles,), block, (
+            in_arr.data, out_arr.data, numpy.int64(rows), numpy.int64(cols),
+            numpy.int64(row_stride), numpy.int64(rows)), stream=stream)
+        return
+
+    # Because we can't know sizeof(reduce_type) in advance, here we
+    # conservatively assume it's 32 bytes and allocate a work area
+    memptr = memory.alloc(n_splits * cols * 32)
+    func = _ColumnReductionKernel_get_cached_function(
+        map_expr, reduce_expr, post_map_expr, reduce_type, type_map,
+        self.name + '_pass1', _column_block_size, self.identity,
+        self.preamble, ('-DFIRST_PASS=1',))
+    func((n_tiles, n_splits), block, (
+        in_arr.data, memptr, numpy.int64(rows), numpy.int64(cols),
+        numpy.int64(row_stride), numpy.int64(rows)), stream=stream)
+    func = _ColumnReductionKernel_get_cached_function(
+        'in0', reduce_expr, post_map_expr, reduce_type, type_map,
+        self.name + '_pass2', _column_block_size, self.identity,
+        self.preamble, ('-DSECOND_PASS=1',))
+    func((n_tiles,), block, (
+        memptr, out_arr.data, numpy.int64(n_splits), numpy.int64(cols),
+        numpy.int64(cols), numpy.int64(rows)), stream=stream)
+
+
+cdef bint _try_to_call_column_reduction(
+        self, list in_args, list out_args, map_expr, reduce_expr,
+        post_map_expr, reduce_type, _kernel._TypeMap type_map,
+        tuple reduce_axis, tuple out_axis, stream) except *:
+    """Try to reduce the input as a matrix with contiguous columns.
+
+    This is for the reductions over axes that are not contiguous, e.g. over
+    axis 0 of a C-contiguous matrix, which CUB cannot reduce without a copy.
+    It does not need the CUB headers.
+    """
+    cdef tuple params
+    cdef str old_in0, old_out0
+
+    can_use = _can_use_column_reduction(
+        in_args, out_args, reduce_axis, out_axis)
+    if can_use is None:
+        return False
+    rows, cols, row_stride = can_use
+
+    # the kernel has no indexers
+    post_map_expr = post_map_expr.replace('_in_ind.size()', '_reduce_size')
+    post_map_expr = post_map_expr.replace('_out_ind.size()', '1.0')
+    for expr in (map_expr, post_map_expr):
+        if '_in_ind' in expr or '_out_ind' in expr:
+            return False
+
+    # the same HACK for ReductionKernel as in _try_to_call_cub_reduction
+    params = self._params
+    old_in0 = params[0].name
+    old_out0 = params[1].name
+    if old_in0 != 'in0' or old_out0 != 'out0':
+        map_expr = map_expr.replace(old_in0, 'in0')
+        post_map_expr = post_map_expr.replace(old_out0, 'out0')
+        type_map = _kernel._TypeMap(type_map._pairs + (
+            ('type_in0_raw', in_args[0].dtype.type),
+            ('type_out0_raw', out_args[0].dtype.type),
+        ))
+
+    _launch_column_reduction(
+        self, in_args[0], out_args[0], rows, cols, row_stride,
+        map_expr, reduce_expr, post_map_expr, reduce_type, type_map, stream)
+    return True
+
+
 def _get_cub_optimized_params(
         self, optimize_config, in_args, out_args, in_shape, out_shape,
         type_map, map_expr, reduce_expr, post_map_expr, reduce_type,
@@ -616,7 +870,9 @@ cdef bint _try_to_call_cub_reduction(
         in_args, out_args, reduce_axis, out_axis)
 
     if can_use_cub is None:
-        return False
+        return _try_to_call_column_reduction(
+            self, in_args, out_args, map_expr, reduce_expr, post_map_expr,
+            reduce_type, type_map, reduce_axis, out_axis, stream)
 
     axis_permutes, contiguous_size, full_reduction = can_use_cub
 
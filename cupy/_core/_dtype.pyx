@@ -30,6 +30,13 @@ cdef str all_type_chars = '?bhilqBHILQefdFD'
 cdef dict _dtype_dict = {}
 cdef _dtype = numpy.dtype
 
+# bfloat16 is not a NumPy type; it is available when ml_dtypes is installed.
+try:
+    import ml_dtypes
+    bfloat16 = _dtype(ml_dtypes.bfloat16)
+except ImportError:
+    bfloat16 = None
+
 
 cdef _init_dtype_dict():
     for i in (int, float, bool, complex, None):
@@ -17,6 +17,7 @@ from cupy._core import _dtype
 from cupy import _util
 from cupy._core import _codeblock
 from cupy._core import _fusion_op
+from cupy._core import _fusion_optimization
 from cupy._core._fusion_variable import _TraceVariable
 from cupy._core._fusion_variable import _TraceScalar
 from cupy._core._fusion_variable import _TraceArray
@@ -25,6 +26,10 @@ from cupy._core._fusion_variable import _TraceArray
 cdef Py_ssize_t _default_block_size = (
     256 if runtime._is_hip_environment else 512)
 
+# The maximum bytes of the arrays in a row for a kernel to be computed row by
+# row, so that the row stays in the cache of the multiprocessor.
+cdef Py_ssize_t _max_row_bytes = 48 * 1024
+
 
 @_util.memoize(for_each_device=True)
 def _cuda_compile(preamble, name, cuda_params, cuda_body, use_grid_sync):
@@ -63,6 +68,8 @@ cdef class FusedKernel:
         readonly dict _cuda_params_memo
         readonly list _block_strides
         readonly bint _use_grid_sync
+        readonly str _row_cuda_body
+        readonly Py_ssize_t _row_itemsize
 
         readonly list _reduction_in_array
         readonly list _reduction_out_array
@@ -102,6 +109,33 @@ cdef class FusedKernel:
                 codes.append('_cg::sync(_grid);')
             codes.append(op.emit_code())
 
+        # Generate the function body computing the ops row by row, if
+        # possible.
+        row_plan = _fusion_optimization.row_plan(op_list)
+        self._row_cuda_body = None
+        self._row_itemsize = 0
+        if row_plan is not None:
+            submodule_code += '\n\n' + '\n\n'.join(
+                itertools.chain.from_iterable([
+                    op.emit_row_submodule_codes() for op in op_list
+                    if isinstance(op, _fusion_op._ReductionTraceOp)]))
+            row_codes = []
+            for op, kind in zip(op_list, row_plan.kinds):
+                if kind == 'reduction':
+                    row_codes.append(op.emit_row_code())
+                else:
+                    row_codes.append(op.emit_row_code(kind))
+                row_codes.append('__syncthreads();')
+            self._row_cuda_body = str(_codeblock.CodeBlock('', [
+                _codeblock.CodeBlock(
+                    'for (ptrdiff_t _row = blockIdx.x; _row < _n_rows; '
+                    '_row += gridDim.x)', row_codes)]))
+            full = row_plan.rows + row_plan.cols
+            for p in params:
+                if isinstance(p, _TraceArray) and p.is_base and (
+                        p.ashape == full):
+                    self._row_itemsize += p.dtype.itemsize
+
         self._submodule_code = submodule_code
         self._cuda_body = str(_codeblock.CodeBlock('', codes))
 
@@ -302,11 +336,13 @@ cdef class FusedKernel:
 
         return params + indexers
 
-    cdef str _get_cuda_params(self, tuple key, list ndarray_list):
+    cdef str _get_cuda_params(
+            self, tuple key, list ndarray_list, bint by_row):
         """Get a string of parameters of CUDA main function code.
         """
         cdef int i
 
+        key = key + (by_row,)
         if key in self._cuda_params_memo:
             return self._cuda_params_memo[key]
 
@@ -331,11 +367,34 @@ cdef class FusedKernel:
             else:
                 raise TypeError('Unknown type {}.'.format(type(a)))
 
-        ret = cuda_params + indexers + self._block_strides
+        if by_row:
+            ret = cuda_params + indexers + [
+                'long long _n_rows', 'long long _row_size']
+        else:
+            ret = cuda_params + indexers + self._block_strides
         ret = ', '.join(ret)
         self._cuda_params_memo[key] = ret
         return ret
 
+    cdef tuple _get_row_size(self, list ndarray_list):
+        """Returns the number of rows and the size of a row if the kernel is
+        computed row by row, and ``None`` otherwise.
+        """
+        cdef _ndarray_base in_array, out_array
+        cdef Py_ssize_t n_rows, row_size
+
+        if self._row_cuda_body is None:
+            return None
+        in_array = ndarray_list[self._reduction_in_array[0]]
+        out_array = ndarray_list[self._reduction_out_array[0]]
+        n_rows = out_array.size
+        if n_rows == 0:
+            return None
+        row_size = in_array.size // n_rows
+        if row_size * self._row_itemsize > _max_row_bytes:
+            return None
+        return n_rows, row_size
+
     def _get_typedefs(self, tuple args):
         index_type = 'int'
         for array in args:
@@ -348,8 +407,26 @@ cdef class FusedKernel:
         ret = self._get_return_value(ndarray_list)
         reduce_key = self._reduce_dims(ndarray_list)
         inout_args = self._get_inout_args(args, ndarray_list)
-        cuda_params = self._get_cuda_params(reduce_key, ndarray_list)
         typedef = self._get_typedefs(args)
+
+        row_size = self._get_row_size(ndarray_list)
+        if row_size is not None:
+            # Each block computes all the ops on a row at a time.
+            n_rows, size = row_size
+            cuda_params = self._get_cuda_params(
+                reduce_key, ndarray_list, True)
+            kern = _cuda_compile(
+                typedef + self._submodule_code,
+                self._name, cuda_params, self._row_cuda_body, False)
+            block_size = min(
+                _default_block_size, max(32, internal.clp2(size)))
+            shared_mem = block_size * 32  # max bytesize of reduce_ctype.
+            kern.linear_launch(
+                min(n_rows, 0x7fffffff) * block_size,
+                inout_args + [n_rows, size], shared_mem, block_size)
+            return ret
+
+        cuda_params = self._get_cuda_params(reduce_key, ndarray_list, False)
         kern = _cuda_compile(
             typedef + self._submodule_code,
             self._name, cuda_params, self._cuda_body, self._use_grid_sync)
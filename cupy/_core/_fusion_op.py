@@ -168,20 +168,47 @@ class _ElementwiseTraceOp:
             for p in indexed_params
         ]
 
-    def emit_code(self):
-        _fusion_thread_local.check_not_runtime()
+    def _emit_loop_body(self, index_name):
+        """Returns a tuple of size 2.
 
+        1. The name of an indexer of the loop.
+        2. CUDA code: the operations on the element at ``index_name``.
+        """
         declaration, s1 = self._emit_declaration(self.params, self.in_params)
         operation = [op.emit_call_code() for op in self.ops]
         after_operation, s2 = self._emit_after_operation(self.out_params)
-        index_name = 'i'
         indexed_array = s1 + s2
         indexer_name = next(iter(indexed_array)).indexer_name
         indexer_setup = self._emit_set_index(indexed_array, index_name)
+        return (
+            indexer_name,
+            indexer_setup + declaration + operation + after_operation)
 
+    def emit_code(self):
+        _fusion_thread_local.check_not_runtime()
+
+        index_name = 'i'
+        indexer_name, body = self._emit_loop_body(index_name)
         return _codeblock.CodeBlock(
-            'CUPY_FOR({}, {}.size())'.format(index_name, indexer_name),
-            indexer_setup + declaration + operation + after_operation)
+            'CUPY_FOR({}, {}.size())'.format(index_name, indexer_name), body)
+
+    def emit_row_code(self, kind):
+        """Returns a CUDA code: the operations on the row ``_row``.
+
+        ``kind`` is ``'full'`` if the op runs over all the elements of the
+        rows, and ``'row'`` if it runs over one element per row.
+        """
+        _fusion_thread_local.check_not_runtime()
+
+        _, body = self._emit_loop_body('i')
+        if kind == 'full':
+            return _codeblock.CodeBlock(
+                'for (ptrdiff_t _j = threadIdx.x; _j < _row_size; '
+                '_j += blockDim.x)',
+                ['ptrdiff_t i = _row * _row_size + _j;'] + body)
+        assert kind == 'row'
+        return _codeblock.CodeBlock(
+            'if (threadIdx.x == 0)', ['ptrdiff_t i = _row;'] + body)
 
     def emit_preamble_codes(self):
         return [subm.preamble for subm in self.ops if subm.preamble != '']
@@ -241,6 +268,21 @@ class _ReductionTraceOp:
         return '{}({}, {});'.format(
             self.name, params, self.block_stride_name)
 
+    def emit_row_code(self):
+        """Returns a CUDA code: the reduction of the row ``_row`` by the
+        block.
+        """
+        _fusion_thread_local.check_not_runtime()
+        in_param, = self.in_params
+        out_param, = self.out_params
+        params = ', '.join([
+            in_param.var_name,
+            out_param.var_name,
+            in_param.indexer_name,
+            out_param.indexer_name,
+        ])
+        return '{}_row({}, _row);'.format(self.name, params)
+
     def emit_preamble_codes(self):
         preamble = self.preamble
         return [preamble] if preamble != '' else []
@@ -314,3 +356,59 @@ __device__ void ${name}(
         )
 
         return [code]
+
+    def emit_row_submodule_codes(self):
+        """Returns a CUDA device function code reducing a single row by the
+        block, used by the kernels computed row by row.
+
+        The reduced axes are the leading axes of the input, as rotated by the
+        trace, so the elements of the row ``row`` are strided by the number
+        of rows. The emitted code assumes that `blockDim.x` is a power of 2.
+        """
+
+        in_param, = self.in_params
+        out_param, = self.out_params
+
+        template = string.Template('''
+template <typename InType, typename OutType, typename InIndexerType, typename OutIndexerType>
+__device__ void ${name}_row(
+        InType in_arr, OutType out_arr,
+        InIndexerType in_ind, OutIndexerType out_ind, ptrdiff_t row) {
+    typedef ${in_type} type_in0_raw;
+    typedef ${out_type} type_out0_raw;
+    typedef ${reduce_ctype} _type_reduce;
+    extern __shared__ char _sdata_raw[];
+    _type_reduce *sdata = reinterpret_cast<_type_reduce*>(_sdata_raw);
+    unsigned int tid = threadIdx.x;
+    ptrdiff_t n_rows = out_ind.size();
+    _type_reduce s = _type_reduce(${identity});
+    for (ptrdiff_t j = (ptrdiff_t)tid * n_rows + row; j < in_ind.size();
+            j += (ptrdiff_t)blockDim.x * n_rows) {
+        in_ind.set(j);
+        s = ${op_name}(s, static_cast<_type_reduce>(in_arr[in_ind.get()]));
+    }
+    sdata[tid] = s;
+    __syncthreads();
+    for (unsigned int block = blockDim.x / 2; block > 0; block >>= 1) {
+        if (tid < block) {
+            sdata[tid] = ${op_name}(sdata[tid], sdata[tid + block]);
+        }
+        __syncthreads();
+    }
+    if (tid == 0) {
+        out_ind.set(row);
+        ${postmap_name}(sdata[0], out_arr[out_ind.get()]);
+    }
+    __syncthreads();
+}''')  # NOQA
+        code = template.substitute(
+            name=self.name,
+            op_name='{}_op'.format(self.name),
+            postmap_name='{}_postmap'.format(self.name),
+            in_type=get_typename(in_param.dtype),
+            out_type=get_typename(out_param.dtype),
+            reduce_ctype=self.reduce_ctype,
+            identity=self.identity,
+        )
+
+        return [code]
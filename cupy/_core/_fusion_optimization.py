@@ -82,6 +82,112 @@ def _fuse_consecutive_ops(ops, shape_constraints):
     return res
 
 
+def _row_reduction_shape(op):
+    """Returns the abstracted shapes of the kept axes and the reduced axes of
+    a reduction if it reduces trailing axes, and ``None`` otherwise.
+    """
+    in_param = op.in_params.item()
+    out_param = op.out_params.item()
+    if in_param.rotate_axis is not None:
+        in_param = in_param._view_of
+    ndim = in_param.ndim
+    n_rows_axes = ndim - len(op.axis)
+    if n_rows_axes == 0 or op.axis != tuple(range(n_rows_axes, ndim)):
+        return None
+    rows = in_param.ashape[:n_rows_axes]
+    if out_param.ashape != rows:
+        return None
+    return rows, in_param.ashape[n_rows_axes:]
+
+
+def _is_row_local(param, rows, cols):
+    """Returns ``True`` if the elements of a row of an array are only accessed
+    when the row is processed.
+    """
+    ones = (1,) * len(cols)
+    if param.is_base:
+        return param.ashape in (rows + cols, rows, rows + ones)
+    view = param._view_of
+    if param.is_broadcast:
+        return (param.ashape == rows + cols
+                and view.ashape == rows + ones
+                and _is_row_local(view, rows, cols))
+    if param.slice_key is not None:
+        # e.g. the output of a reduction with keepdims.
+        new_axes = (None,) * len(cols)
+        keys = ((slice(None),) * len(rows) + new_axes, (Ellipsis,) + new_axes)
+        return (view.is_base
+                and view.ashape == rows
+                and param.slice_key in keys)
+    if param.rotate_axis is not None:
+        # The input of a reduction along the trailing axes.
+        return (view.is_base
+                and view.ashape == rows + cols
+                and param.rotate_axis == tuple(
+                    range(len(rows), len(rows) + len(cols))))
+    return False
+
+
+class _RowPlan:
+    """The plan to compute the ops of a fused kernel row by row.
+
+    Each row is processed by a single block, which runs the ops in order with
+    ``__syncthreads()`` between them instead of a grid synchronization.
+
+    Attributes:
+        rows (tuple): The abstracted shape of the axes kept by reductions.
+        cols (tuple): The abstracted shape of the reduced axes.
+        kinds (list of str): The kind of each op: ``'full'`` for elementwise
+            ops over ``rows + cols``, ``'row'`` for elementwise ops over
+            ``rows``, and ``'reduction'`` for reductions.
+    """
+
+    def __init__(self, rows, cols, kinds):
+        self.rows = rows
+        self.cols = cols
+        self.kinds = kinds
+
+
+def row_plan(ops):
+    """Returns a `_RowPlan` if the ops can be computed row by row, that is,
+    for patterns like reduction -> broadcast elementwise -> reduction along
+    the same trailing axes (e.g. softmax), and ``None`` otherwise.
+    """
+    reductions = [
+        op for op in ops if isinstance(op, _fusion_op._ReductionTraceOp)]
+    if len(ops) < 2 or len(reductions) == 0:
+        return None
+    shape = _row_reduction_shape(reductions[0])
+    if shape is None:
+        return None
+    rows, cols = shape
+    ones = (1,) * len(cols)
+
+    kinds = []
+    for op in ops:
+        if isinstance(op, _fusion_op._ReductionTraceOp):
+            if _row_reduction_shape(op) != shape:
+                return None
+            kinds.append('reduction')
+        elif op.ashape == rows + cols:
+            kinds.append('full')
+        elif op.ashape in (rows, rows + ones):
+            kinds.append('row')
+        else:
+            return None
+
+    # The arrays written in the kernel must be accessed only by the block
+    # processing the row.
+    written = [p.memory for op in ops for p in op.out_params]
+    for op in ops:
+        for p in op.in_params + op.out_params:
+            if (isinstance(p, _fusion_variable._TraceArray)
+                    and p.memory in written
+                    and not _is_row_local(p, rows, cols)):
+                return None
+    return _RowPlan(rows, cols, kinds)
+
+
 def optimize(ops, variables, shape_constraints):
     _normalize_ashapes(ops, variables, shape_constraints)
     ops = _reduce_memory_access(ops)
@@ -3,6 +3,10 @@ import threading
 
 thread_local = threading.local()
 
+# The number of threads in which the ufuncs are evaluated lazily, so that
+# the other threads do not look up the thread local.
+cdef int _n_lazy = 0
+
 
 cpdef inline bint is_old_fusing() except? -1:
     try:
@@ -24,6 +28,27 @@ cpdef inline bint is_fusing() except? -1:
     return is_old_fusing() or is_new_fusing()
 
 
+cpdef inline bint is_lazy() except? -1:
+    if _n_lazy == 0:
+        return False
+    try:
+        return thread_local.is_lazy
+    except AttributeError:
+        thread_local.is_lazy = False
+    return False
+
+
+def set_lazy(bint lazy):
+    """Sets whether the ufuncs are evaluated lazily in this thread, and
+    returns the previous setting."""
+    global _n_lazy
+    cdef bint prev = getattr(thread_local, 'is_lazy', False)
+    if lazy != prev:
+        _n_lazy += 1 if lazy else -1
+    thread_local.is_lazy = lazy
+    return prev
+
+
 def check_not_runtime():
     assert is_new_fusing()
 
@@ -42,5 +67,10 @@ def call_reduction(fusion_op, *args, **kwargs):
     return cupy._core.fusion._call_reduction(fusion_op, *args, **kwargs)
 
 
+def call_lazy_ufunc(ufunc, args, kwargs):
+    from cupyx import _lazy
+    return _lazy._call_ufunc(ufunc, args, kwargs)
+
+
 def call_indexing(fusion_op, *args, **kwargs):
     return thread_local.history.call_indexing(fusion_op, *args, **kwargs)
@@ -426,8 +426,9 @@ class TraceImpl:
         if dtype is not None:
             dtype = numpy.dtype(dtype)
 
-        if keepdims:
-            raise NotImplementedError('keepdims is not supported.')
+        if keepdims and out is not None:
+            raise NotImplementedError(
+                'keepdims with an output array is not supported.')
 
         # Determine the shape of out_param.
         out_ashape = tuple([
@@ -461,6 +462,13 @@ class TraceImpl:
             name, reduce_func, expr, in_param, out_param, axes)
         self.op_list.append(op)
 
+        if keepdims:
+            # Returns a view with the reduced axes of length 1.
+            indices = tuple([
+                None if axis in axes else slice(None)
+                for axis in range(len(axes) + out_param.ndim)])
+            out_param = self.vc.indexing(out_param, indices)
+
         # Returns.
         return self._make_interface(out_param)
 
@@ -0,0 +1,250 @@
+"""Distinct values of an array in an open-addressing hash table.
+
+Each slot of the table is the index of the first item of its value (or
+empty), so that the table does not depend on the width of the keys and no
+value is reserved as the empty key. The items are inserted with linear
+probing, and equal values are found by comparing the items the slots point
+to. Floating point values are hashed by their bits, with one bit pattern for
+all the zeros and one for all the NaNs.
+
+The table lives in arrays of the memory pool, sized for a bounded number of
+distinct values so that it stays cache-resident. Insertion gives up as soon
+as this bound is passed, which also bounds what is wasted on an input of a
+high cardinality; the callers then fall back to sorting. An input of at most
+that many items cannot pass the bound, so its table is built without
+waiting for the device; `isin` only uses such tables, so that it stays as
+asynchronous as the sorting path.
+"""
+
+import numpy
+
+import cupy
+from cupy._core._scalar import get_typename
+from cupy import _util
+
+
+# Smaller inputs are sorted about as fast as the table is built.
+_min_size = 1 << 14
+# A table of twice this many slots of 8 bytes, with the counts, fits in the
+# L2 cache of the recent devices.
+_max_distinct = 1 << 18
+_block_size = 256
+_max_blocks = 4096
+_dtypes = '?bhilqBHILQfd'
+_empty = numpy.uint64(0xffffffffffffffff)
+# a null pointer argument
+_null = numpy.uint64(0)
+
+
+_hash_table_code = r'''
+#define EMPTY 0xffffffffffffffffULL
+
+template <typename U>
+__device__ __forceinline__ unsigned long long key_bits(U x) {
+    return (unsigned long long)x;
+}
+__device__ __forceinline__ unsigned long long key_bits(float x) {
+    if (x == 0) {
+        return 0;
+    }
+    return isnan(x) ? 0x7fc00000ULL : __float_as_uint(x);
+}
+__device__ __forceinline__ unsigned long long key_bits(double x) {
+    if (x == 0) {
+        return 0;
+    }
+    return isnan(x) ? 0x7ff8000000000000ULL
+                    : (unsigned long long)__double_as_longlong(x);
+}
+
+// the finalizer of MurmurHash3
+__device__ __forceinline__ unsigned long long hash_bits(
+        unsigned long long k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+// Inserts the items of x. With first_index, a slot keeps the smallest index
+// of its value, and counts and slots (if not null) get the number of items
+// of each slot and the slot of each item. state[0] counts the slots taken
+// and state[1] is set when more than max_distinct values are found, after
+// which the items are no longer inserted.
+extern "C" __global__ void cupy_hash_insert(
+        const T* __restrict__ x, const long long n,
+        unsigned long long* table, const unsigned long long mask,
+        const int first_index, unsigned long long* counts, int* slots,
+        unsigned long long* state, const unsigned long long max_distinct) {
+    const long long stride = (long long)gridDim.x * blockDim.x;
+    for (long long i = (long long)blockIdx.x * blockDim.x + threadIdx.x;
+            i < n; i += stride) {
+        if (((volatile unsigned long long*)state)[1]) {
+            return;
+        }
+        const unsigned long long k = key_bits(x[i]);
+        unsigned long long s = hash_bits(k) & mask;
+        while (true) {
+            unsigned long long cur = table[s];
+            if (cur == EMPTY) {
+                // a slot is reserved first, so that the table never fills up
+                if (atomicAdd(&state[0], 1ULL) >= max_distinct) {
+                    state[1] = 1;
+                    return;
+                }
+                cur = atomicCAS(&table[s], EMPTY, (unsigned long long)i);
+                if (cur == EMPTY) {
+                    break;
+                }
+                atomicAdd(&state[0], ~0ULL);
+            }
+            if (key_bits(x[cur]) == k) {
+                if (first_index && i < cur) {
+                    atomicMin(&table[s], (unsigned long long)i);
+                }
+                break;
+            }
+            s = (s + 1) & mask;
+        }
+        if (counts != NULL) {
+            atomicAdd(&counts[s], 1ULL);
+        }
+        if (slots != NULL) {
+            slots[i] = (int)s;
+        }
+    }
+}
+
+// Tells for each item of y if its value is one of the items of x in the
+// table. NaNs are not found, as they compare unequal.
+extern "C" __global__ void cupy_hash_contains(
+        const T* __restrict__ y, const long long n,
+        const T* __restrict__ x, const unsigned long long* __restrict__ table,
+        const unsigned long long mask, const int invert,
+        bool* __restrict__ out) {
+    const long long stride = (long long)gridDim.x * blockDim.x;
+    for (long long i = (long long)blockIdx.x * blockDim.x + threadIdx.x;
+            i < n; i += stride) {
+        const T v = y[i];
+        bool found = false;
+        if (v == v) {
+            const unsigned long long k = key_bits(v);
+            unsigned long long s = hash_bits(k) & mask;
+            unsigned long long cur;
+            while ((cur = table[s]) != EMPTY) {
+                if (key_bits(x[cur]) == k) {
+                    found = true;
+                    break;
+                }
+                s = (s + 1) & mask;
+            }
+        }
+        out[i] = found != (bool)invert;
+    }
+}
+'''
+
+
+@_util.memoize(for_each_device=True)
+def _get_module(dtype):
+    code = '#define T {}\n'.format(get_typename(dtype))
+    return cupy.RawModule(code=code + _hash_table_code)
+
+
+def _grid(n):
+    return (min((n + _block_size - 1) // _block_size, _max_blocks),)
+
+
+def available(a):
+    """Tells if the distinct values of ``a`` may be found in a hash table."""
+    return a.dtype.char in _dtypes and _min_size <= a.size <= 0x7fffffff
+
+
+def isin_available(ar1, ar2):
+    """Tells if the items of ``ar1`` may be looked up in a table of ``ar2``.
+    """
+    return (ar1.dtype == ar2.dtype and ar2.dtype.char in _dtypes
+            and ar1.size + ar2.size >= _min_size
+            and ar2.size <= _max_distinct)
+
+
+def build(x, first_index=False, counts=False, slots=False,
+          max_distinct=_max_distinct):
+    """Inserts the items of the 1-D contiguous array ``x`` in a hash table.
+
+    Returns the table, and the counts and the slots of the items (or
+    ``None`` if not requested). When ``x`` has more than ``max_distinct``
+    items, this synchronizes the device to check the number of distinct
+    values, and ``None`` is returned when there are more of them. Smaller
+    inputs always fit in the table and are not checked.
+    """
+    n = x.size
+    checked = n > max_distinct
+    max_distinct = min(max_distinct, n)
+    capacity = 1 << max(2 * max_distinct - 1, 1).bit_length()
+    table = cupy.full(capacity, _empty, numpy.uint64)
+    state = cupy.zeros(2, numpy.uint64)
+    counts = cupy.zeros(capacity, numpy.uint64) if counts else None
+    slots = cupy.empty(n, numpy.int32) if slots else None
+    kernel = _get_module(x.dtype).get_function('cupy_hash_insert')
+    kernel(_grid(n), (_block_size,),
+           (x, numpy.int64(n), table, numpy.uint64(capacity - 1),
+            numpy.int32(first_index),
+            _null if counts is None else counts,
+            _null if slots is None else slots, state,
+            numpy.uint64(max_distinct)))
+    if checked and state[1].get():
+        return None
+    return table, counts, slots
+
+
+def unique(ar, return_index=False, return_inverse=False,
+           return_counts=False, equal_nan=True, inverse_shape=None):
+    """Finds the sorted distinct values of ``ar`` as :func:`cupy.unique`.
+
+    Returns ``None`` when the values are not found here, i.e. for NaNs that
+    are not collapsed or for too many distinct values.
+    """
+    if ar.dtype.kind == 'f' and not equal_nan:
+        return None
+    x = cupy.ascontiguousarray(ar).ravel()
+    built = build(x, first_index=return_index, counts=return_counts,
+                  slots=return_inverse)
+    if built is None:
+        return None
+    table, counts, slots = built
+    taken = cupy.flatnonzero(table != _empty)
+    n_distinct = taken.size
+    first = table[taken].astype(numpy.int64)
+    values = x[first]
+    order = cupy.argsort(values)
+
+    ret = values[order],
+    if return_index:
+        ret += first[order],
+    if return_inverse:
+        rank = cupy.empty(table.size, numpy.int64)
+        rank[taken[order]] = cupy.arange(n_distinct, dtype=numpy.int64)
+        ret += rank[slots].reshape(inverse_shape),
+    if return_counts:
+        ret += counts[taken[order]].astype(numpy.int64),
+    return ret
+
+
+def isin(ar1, ar2, invert=False):
+    """Tests whether each item of ``ar1`` is in ``ar2`` with a hash table.
+
+    Both arrays must be 1-D and of the same dtype, and ``ar2`` must be
+    accepted by :func:`isin_available`. This does not synchronize.
+    """
+    ar1 = cupy.ascontiguousarray(ar1)
+    ar2 = cupy.ascontiguousarray(ar2)
+    table = build(ar2)[0]
+    out = cupy.empty(ar1.size, numpy.bool_)
+    kernel = _get_module(ar1.dtype).get_function('cupy_hash_contains')
+    kernel(_grid(ar1.size), (_block_size,),
+           (ar1, numpy.int64(ar1.size), ar2, table,
+            numpy.uint64(table.size - 1), numpy.int32(invert), out))
+    return out
@@ -36,6 +36,8 @@ cdef class _ArgInfo:
         readonly int ndim
         readonly bint c_contiguous
         readonly bint index_32_bits
+        # Shape of an indexer compiled into the kernel, or None
+        readonly tuple static_shape
 
     cdef _ArgInfo _init(
         self,
@@ -148,12 +150,14 @@ cdef class _Ops:
 
 cpdef create_ufunc(name, ops, routine=*, preamble=*, doc=*,
                    default_casting=*, loop_prep=*, out_ops=*,
-                   cutensor_op=*, scatter_op=*)
+                   cutensor_op=*, scatter_op=*, half2=*)
 
 cdef tuple _get_arginfos(list args)
 
 cdef str _get_kernel_params(tuple params, tuple arginfos)
 
+cdef bint _is_index_32_bits(tuple arginfos)
+
 cdef list _broadcast(list args, tuple params, bint use_size, shape_t& shape)
 
 cdef list _get_out_args_from_optionals(
@@ -1,3 +1,4 @@
+import functools
 import string
 import warnings
 
@@ -8,6 +9,7 @@ from cupy.cuda import compiler
 from cupy import _util
 
 cimport cython  # NOQA
+from cpython.bytes cimport PyBytes_FromStringAndSize
 
 from libcpp cimport vector
 
@@ -20,6 +22,7 @@ from cupy._core cimport _carray
 from cupy._core cimport _scalar
 from cupy._core._dtype cimport get_dtype, _raise_if_invalid_cast
 from cupy._core._memory_range cimport may_share_bounds
+from cupy._core._dtype import bfloat16 as _bfloat16
 from cupy._core._scalar import get_typename as _get_typename
 from cupy._core cimport core
 from cupy._core.core cimport _convert_object_with_cuda_array_interface
@@ -35,6 +38,7 @@ except ImportError:
     cuda_cutensor = None
 
 from cupy._core import _fusion_thread_local
+from cupy._core import _tuning
 
 
 cdef inline bint _contains_zero(const shape_t& v) except? -1:
@@ -50,26 +54,123 @@ def _get_warpsize():
     return runtime.getDeviceProperties(device_id)['warpSize']
 
 
+# Upper bound of the bytes loaded or stored per array and thread by the
+# vectorized elementwise loop (the widest CUDA access is 16 bytes).
+cdef int _max_vec_bytes = 16
+
+
+cdef int _get_vec_width(list args, tuple params, const shape_t& shape):
+    # Returns the number of elements each thread handles per iteration in the
+    # vectorized elementwise loop, or 1 if the arguments do not allow it.
+    # Every non-raw array must be contiguous and aligned to the width times
+    # its itemsize, which is only the case for 1-dim (reduced) shapes.
+    cdef Py_ssize_t i
+    cdef int vec_width, itemsize, max_itemsize = 0
+    cdef _ndarray_base arr
+    cdef ParameterInfo p
+
+    if shape.size() != 1:
+        return 1
+    for i in range(len(args)):
+        a = args[i]
+        if not isinstance(a, _ndarray_base):
+            continue
+        p = params[i]
+        if p.raw:
+            continue
+        arr = a
+        if not arr._c_contiguous:
+            return 1
+        max_itemsize = max(max_itemsize, arr.dtype.itemsize)
+    if max_itemsize == 0:
+        return 1
+    vec_width = _max_vec_bytes // max_itemsize
+    if shape[0] < vec_width:
+        return 1
+    for i in range(len(args)):
+        a = args[i]
+        if not isinstance(a, _ndarray_base) or (<ParameterInfo>params[i]).raw:
+            continue
+        arr = a
+        itemsize = arr.dtype.itemsize
+        while vec_width > 1 and arr.data.ptr % (vec_width * itemsize) != 0:
+            vec_width //= 2
+    return vec_width
+
+
+cdef bint _is_index_32_bits(tuple arginfos):
+    # True if the loop index and the offsets in all the arrays, including the
+    # raw ones, fit in `int`. The kernel bodies use `_index_t` for the index
+    # arithmetic, so that it does not do 64-bit division for small arrays.
+    cdef _ArgInfo a
+    for a in arginfos:
+        if (a.arg_kind == ARG_KIND_NDARRAY or a.arg_kind == ARG_KIND_INDEXER) \
+                and not a.index_32_bits:
+            return False
+    return True
+
+
 cdef str _get_simple_elementwise_kernel_code(
         tuple params, tuple arginfos, str operation, str name,
-        _TypeMap type_map, str preamble, str loop_prep='', str after_loop=''):
+        _TypeMap type_map, str preamble, str loop_prep='', str after_loop='',
+        int vec_width=1, str vec_load='', str vec_operation='',
+        str vec_store='', int vec_step=1):
     # No loop unrolling due to avoid 64-bit division
-    module_code = string.Template('''
-    ${typedef_preamble}
-    ${preamble}
-    extern "C" __global__ void ${name}(${params}) {
-      ${loop_prep};
+    if vec_width == 1:
+        loop = string.Template('''
       #pragma unroll 1
       CUPY_FOR(i, _ind.size()) {
         _ind.set(i);
         ${operation};
       }
+        ''').substitute(operation=operation)
+    else:
+        # Each thread loads `vec_width` consecutive elements of every array at
+        # once, applies the operation to `vec_step` of them at a time and
+        # stores them at once. The remainder is processed element-wise.
+        loop = string.Template('''
+      const ptrdiff_t _vec_size = _ind.size() / ${vec_width};
+      #pragma unroll 1
+      CUPY_FOR(_vec_i, _vec_size) {
+        const ptrdiff_t _vec_base = _vec_i * ${vec_width};
+        ${vec_load};
+        #pragma unroll
+        for (int _vec_k = 0; _vec_k < ${vec_width}; _vec_k += ${vec_step}) {
+          ptrdiff_t i = _vec_base + _vec_k;
+          _ind.set(i);
+          ${vec_operation};
+        }
+        ${vec_store};
+      }
+      #pragma unroll 1
+      for (ptrdiff_t i = _vec_size * ${vec_width} +
+               static_cast<ptrdiff_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+           i < _ind.size();
+           i += static_cast<ptrdiff_t>(blockDim.x) * gridDim.x) {
+        _ind.set(i);
+        ${operation};
+      }
+        ''').substitute(
+            vec_width=vec_width,
+            vec_step=vec_step,
+            vec_load=vec_load,
+            vec_operation=vec_operation,
+            vec_store=vec_store,
+            operation=operation)
+    module_code = string.Template('''
+    ${typedef_preamble}
+    ${preamble}
+    extern "C" __global__ void ${name}(${params}) {
+      typedef ${index_type} _index_t;
+      ${loop_prep};
+      ${loop}
       ${after_loop};
     }
     ''').substitute(
         typedef_preamble=type_map.get_typedef_code(),
         params=_get_kernel_params(params, arginfos),
-        operation=operation,
+        index_type='int' if _is_index_32_bits(arginfos) else 'ptrdiff_t',
+        loop=loop,
         name=name,
         preamble=preamble,
         loop_prep=loop_prep,
@@ -86,10 +187,11 @@ cdef function.Function _get_simple_elementwise_kernel_from_code(
 cdef function.Function _get_simple_elementwise_kernel(
         tuple params, tuple arginfos, str operation, str name,
         _TypeMap type_map, str preamble, str loop_prep='', str after_loop='',
-        tuple options=()):
+        tuple options=(), int vec_width=1, str vec_load='',
+        str vec_operation='', str vec_store='', int vec_step=1):
     code = _get_simple_elementwise_kernel_code(
         params, arginfos, operation, name, type_map, preamble, loop_prep,
-        after_loop
+        after_loop, vec_width, vec_load, vec_operation, vec_store, vec_step
     )
     return _get_simple_elementwise_kernel_from_code(name, code, options)
 
@@ -235,6 +337,8 @@ cdef class _ArgInfo:
         ret._init(
             ARG_KIND_INDEXER, _carray.Indexer, None, arg.ndim, True,
             arg._index_32_bits)
+        if arg._static_shape:
+            ret.static_shape = tuple(arg.shape)
         return ret
 
     @staticmethod
@@ -253,7 +357,8 @@ cdef class _ArgInfo:
 
     def __hash__(self):
         return hash((self.arg_kind, self.type, self.dtype, self.ndim,
-                     self.c_contiguous, self.index_32_bits))
+                     self.c_contiguous, self.index_32_bits,
+                     self.static_shape))
 
     def __eq__(self, other):
         cdef _ArgInfo oth
@@ -266,7 +371,8 @@ cdef class _ArgInfo:
             and self.dtype == oth.dtype
             and self.ndim == oth.ndim
             and self.c_contiguous == oth.c_contiguous
-            and self.index_32_bits == oth.index_32_bits)
+            and self.index_32_bits == oth.index_32_bits
+            and self.static_shape == oth.static_shape)
 
     def __repr__(self):
         return '<_ArgInfo({})>'.format(
@@ -277,6 +383,7 @@ cdef class _ArgInfo:
                 'ndim={!r}'.format(self.ndim),
                 'c_contiguous={!r}'.format(self.c_contiguous),
                 'index_32_bits={!r}'.format(self.index_32_bits),
+                'static_shape={!r}'.format(self.static_shape),
             ]))
 
     cdef _ArgInfo as_ndarray_with_ndim(self, int ndim):
@@ -303,6 +410,10 @@ cdef class _ArgInfo:
         if self.arg_kind == ARG_KIND_SCALAR:
             return _get_typename(self.dtype)
         if self.arg_kind == ARG_KIND_INDEXER:
+            if self.static_shape is not None and self.ndim > 0:
+                return 'CIndexer<%d, %d, %s>' % (
+                    self.ndim, self.index_32_bits,
+                    ', '.join([str(s) for s in self.static_shape]))
             return 'CIndexer<%d, %d>' % (self.ndim, self.index_32_bits)
         if self.arg_kind == ARG_KIND_TEXTURE:
             return 'cudaTextureObject_t'
@@ -442,6 +553,97 @@ cdef shape_t _reduced_view_core(list args, tuple params, const shape_t& shape):
     return newshape
 
 
+cdef class _ReducedDims:
+    # The result of `_reduce_dims` for a combination of shapes and strides.
+
+    cdef:
+        shape_t shape
+        vector.vector[int] indexes  # of the arguments replaced with views
+        vector.vector[shape_t] strides  # of the views
+        _carray.Indexer indexer
+
+
+# The number of combinations of shapes and strides cached for each kernel
+cdef Py_ssize_t _max_reduced_dims = 32
+
+
+cdef class _ReducedDimsCache:
+
+    """Memoizes the reduced dims and indexers of the launches of a kernel.
+
+    The launches of a kernel repeat a few combinations of shapes and strides
+    in most workloads. They are looked up by the raw bytes of the shapes and
+    strides, instead of running `_reduce_dims` and creating an indexer and
+    its CIndexer for each launch. The oldest entry is dropped when the cache
+    is full.
+    """
+
+    cdef readonly dict _entries
+
+    def __init__(self):
+        self._entries = {}
+
+    cdef _carray.Indexer get(
+            self, list args, tuple params, const shape_t& shape,
+            bint reduce_dims):
+        # Replaces the arguments with their reduced views, as `_reduce_dims`
+        # does, and returns the indexer of the reduced shape.
+        cdef vector.vector[Py_ssize_t] key
+        cdef _ReducedDims entry
+        cdef _ndarray_base arr
+        cdef Py_ssize_t i, j, k, n_args = len(args)
+
+        if reduce_dims and n_args <= 1:
+            # the fast path of `_reduce_dims`
+            return _carray._indexer_init(_reduce_dims(args, params, shape))
+
+        key.push_back(n_args)
+        for j in range(<Py_ssize_t>shape.size()):
+            key.push_back(shape[j])
+        for i in range(n_args):
+            a = args[i]
+            if (<ParameterInfo>params[i]).raw or \
+                    not isinstance(a, _ndarray_base):
+                continue
+            arr = a
+            key.push_back(i)
+            key.push_back(arr._c_contiguous)
+            if arr._c_contiguous:
+                key.push_back(arr.dtype.itemsize)
+            else:
+                for j in range(<Py_ssize_t>arr._strides.size()):
+                    key.push_back(arr._strides[j])
+        bkey = PyBytes_FromStringAndSize(
+            <char*>key.data(), key.size() * sizeof(Py_ssize_t))
+
+        entry = self._entries.get(bkey)
+        if entry is None:
+            entry = _ReducedDims.__new__(_ReducedDims)
+            if reduce_dims:
+                originals = list(args)
+                entry.shape = _reduce_dims(args, params, shape)
+                for i in range(n_args):
+                    if args[i] is not originals[i]:
+                        entry.indexes.push_back(i)
+                        entry.strides.push_back(
+                            (<_ndarray_base>args[i])._strides)
+            else:
+                entry.shape = shape
+            entry.indexer = _carray._indexer_init(entry.shape)
+            if len(self._entries) >= _max_reduced_dims:
+                del self._entries[next(iter(self._entries))]
+            self._entries[bkey] = entry
+            return entry.indexer
+
+        for k in range(<Py_ssize_t>entry.indexes.size()):
+            i = entry.indexes[k]
+            arr = args[i]
+            # TODO(niboshi): Confirm update_x_contiguity flags
+            args[i] = arr._view(
+                type(arr), entry.shape, entry.strides[k], False, True, arr)
+        return entry.indexer
+
+
 cdef class ParameterInfo:
 
     def __init__(self, str param, bint is_const):
@@ -693,36 +895,111 @@ cdef list _get_out_args_with_params(
 def _get_elementwise_kernel_code(
         tuple arginfos, _TypeMap type_map,
         tuple params, str operation, str name,
-        str preamble, str loop_prep='', str after_loop='', tuple options=()):
+        str preamble, str loop_prep='', str after_loop='', tuple options=(),
+        int vec_width=1):
     cdef _ArgInfo arginfo
 
     op = []
+    vec_load = []
+    vec_op = []
+    vec_store = []
     for p, arginfo in zip(params, arginfos):
         if arginfo.is_ndarray() and not p.raw:
             if p.is_const:
                 fmt = 'const {t} &{n} = _raw_{n}[_ind.get()];'
+                vec_fmt = 'const {t} &{n} = _vec_{n}[_vec_k];'
             else:
                 fmt = '{t} &{n} = _raw_{n}[_ind.get()];'
+                vec_fmt = '{t} &{n} = _vec_{n}[_vec_k];'
+                vec_store.append(
+                    '_raw_{n}.store_vec(_vec_base, _vec_{n});'.format(
+                        n=p.name))
             op.append(fmt.format(t=p.ctype, n=p.name))
+            vec_op.append(vec_fmt.format(t=p.ctype, n=p.name))
+            vec_load.append(
+                '{t} _vec_{n}[{w}];\n'
+                '_raw_{n}.load_vec(_vec_base, _vec_{n});'.format(
+                    t=p.ctype, n=p.name, w=vec_width))
     op.append(operation)
-    operation = '\n'.join(op)
+    vec_op.append(operation)
     return _get_simple_elementwise_kernel_code(
-        params, arginfos, operation, name, type_map,
-        preamble, loop_prep, after_loop)
+        params, arginfos, '\n'.join(op), name, type_map,
+        preamble, loop_prep, after_loop, vec_width, '\n'.join(vec_load),
+        '\n'.join(vec_op), '\n'.join(vec_store))
 
 
 @_util.memoize(for_each_device=True)
 def _get_elementwise_kernel(
         tuple arginfos, _TypeMap type_map,
         tuple params, str operation, str name,
-        str preamble, str loop_prep='', str after_loop='', tuple options=()):
+        str preamble, str loop_prep='', str after_loop='', tuple options=(),
+        int vec_width=1):
     cdef str code = _get_elementwise_kernel_code(
         arginfos, type_map, params, operation, name, preamble, loop_prep,
-        after_loop
+        after_loop, vec_width=vec_width
     )
     return _get_simple_elementwise_kernel_from_code(name, code, options)
 
 
+cdef bint _tuning_active = _tuning.active
+_block_size_candidates = (64, 128, 256, 512, 1024)
+
+
+cdef str _get_tuning_key(
+        str name, tuple arginfos, Py_ssize_t size, int vec_width):
+    # The key of an elementwise kernel in the tuning database: its name, the
+    # dtypes of its arrays, the ndim of the indexer (the last argument), the
+    # vector width and the size rounded to a power of 2.
+    cdef _ArgInfo a
+    types = ''.join([
+        numpy.dtype(a.dtype).char for a in arginfos if a.is_ndarray()])
+    return '{}/{}/{}/{}/{}'.format(
+        name, types, (<_ArgInfo>arginfos[-1]).ndim, vec_width,
+        _tuning.get_size_bucket(size))
+
+
+def _prepare_elementwise_tuning(
+        function.Function kern, size_t size, list args):
+    # Returns the function tuning the block size in the background; see
+    # _tuning.maybe_tune.
+    args = _tuning.copy_args(args)
+
+    def tune(stream):
+        def launch(block_size):
+            kern.linear_launch(size, args, 0, block_size, stream)
+        return _tuning.pick_fastest(_block_size_candidates, launch, stream)
+    return tune
+
+
+cdef size_t _get_block_size(
+        int dev_id, str name, tuple arginfos, function.Function kern,
+        size_t size, list args, int vec_width, size_t default):
+    # The block size tuned on this GPU model, if any.
+    db_key = _get_tuning_key(name, arginfos, size, vec_width)
+    tuned = _tuning.lookup(dev_id, 'elementwise', db_key)
+    if tuned is not None:
+        return tuned
+    _tuning.maybe_tune(
+        dev_id, 'elementwise', db_key,
+        functools.partial(_prepare_elementwise_tuning, kern, size, args))
+    return default
+
+
+cdef class _ElementwisePlan:
+    # The result of the argument processing of an ElementwiseKernel call.
+    # kern is None if the kernel is not launched (the size is zero).
+
+    cdef:
+        function.Function kern
+        list inout_args
+        list out_args
+        tuple in_types
+        object ret
+        Py_ssize_t launch_size
+        Py_ssize_t block_size
+        int vec_width
+
+
 cdef class ElementwiseKernel:
 
     """User-defined elementwise kernel.
@@ -760,6 +1037,18 @@ cdef class ElementwiseKernel:
             loop.
         after_loop (str): Fragment of the CUDA-C/C++ code that is inserted at
             the bottom of the kernel function definition.
+        static_shape (bool): If ``True``, the (reduced) shape of each call is
+            compiled into the kernel as constants, so that the index
+            calculation divides by compile-time values. A kernel is compiled
+            for each distinct shape, so this only pays off for hot kernels
+            called with a few fixed shapes.
+        vectorize (bool): If ``True``, calls whose non-raw arrays are all
+            contiguous and suitably aligned make each thread load and store
+            up to 16 bytes of consecutive elements per array at once, which
+            pays off for small itemsizes such as ``int8`` and ``float16``.
+            All non-raw arrays, including outputs, are then read, and the
+            operation must not access elements of non-raw arrays through raw
+            arguments.
 
     """
 
@@ -780,11 +1069,15 @@ cdef class ElementwiseKernel:
         readonly dict kwargs
         readonly dict _params_type_memo
         readonly dict _elementwise_kernel_memo
+        readonly _ReducedDimsCache _reduced_dims_cache
         readonly dict _cached_codes
+        readonly bint static_shape
+        readonly bint vectorize
 
     def __init__(self, in_params, out_params, operation,
                  name='kernel', reduce_dims=True, preamble='',
-                 no_return=False, return_tuple=False, **kwargs):
+                 no_return=False, return_tuple=False, static_shape=False,
+                 vectorize=False, **kwargs):
         if not compiler.is_valid_kernel_name(name):
             raise ValueError(
                 'Invalid kernel name: "%s"' % name)
@@ -802,6 +1095,8 @@ cdef class ElementwiseKernel:
         self.preamble = preamble
         self.no_return = no_return
         self.return_tuple = return_tuple
+        self.static_shape = static_shape
+        self.vectorize = vectorize
         self.kwargs = kwargs
         self._params_type_memo = {}
         self._cached_codes = {}
@@ -809,6 +1104,7 @@ cdef class ElementwiseKernel:
         if 'i' in names:
             raise ValueError('Can not use \'i\' as a parameter name')
         self._elementwise_kernel_memo = {}
+        self._reduced_dims_cache = _ReducedDimsCache()
         # This is for profiling mechanisms to auto infer a name
         self.__name__ = name
 
@@ -828,7 +1124,8 @@ cdef class ElementwiseKernel:
                 are `raw` and the range size cannot be determined
                 automatically.
             block_size (int): Number of threads per block. By default, the
-                value is set to 128.
+                value tuned for the GPU model is used (see
+                :envvar:`CUPY_AUTOTUNE`), or 128 if there is none.
 
         Returns:
             If ``no_return`` has not set, arrays are returned according to the
@@ -836,18 +1133,15 @@ cdef class ElementwiseKernel:
             If ``no_return`` has set, ``None`` is returned.
 
         """
-        cdef function.Function kern
-        cdef Py_ssize_t size, i
-        cdef list in_args, out_args
-        cdef tuple in_types, out_types
-        cdef shape_t shape
+        cdef _ElementwisePlan plan
+        cdef Py_ssize_t size
 
         size = kwargs.pop('size', -1)
         stream = kwargs.pop('stream', None)
-        block_size = kwargs.pop('block_size', 128)
+        block_size = kwargs.pop('block_size', None)
         if len(kwargs):
             raise TypeError('Wrong arguments %s' % kwargs)
-        if block_size <= 0:
+        if block_size is not None and block_size <= 0:
             raise ValueError('block_size must be greater than zero')
         n_args = len(args)
         if n_args != self.nin and n_args != self.nargs:
@@ -860,6 +1154,57 @@ cdef class ElementwiseKernel:
             if hasattr(arg, '__cupy_override_elementwise_kernel__'):
                 return arg.__cupy_override_elementwise_kernel__(
                     self, *args, **kwargs)
+        plan = self._plan(args, size, block_size)
+        if plan.kern is not None:
+            plan.kern.linear_launch(
+                plan.launch_size, plan.inout_args, shared_mem=0,
+                block_max_size=plan.block_size, stream=stream)
+        return plan.ret
+
+    def bind(self, *args, size=-1, block_size=None):
+        """Prepares a launch of the kernel to be repeated with new arrays.
+
+        The argument processing of :meth:`__call__` (the type resolution,
+        the broadcasting, the allocation of the outputs, the reduction of
+        the dimensions and the lookup of the compiled kernel) is done once
+        with the given arguments, and the returned object launches the
+        kernel with arrays of the same shapes, strides and dtypes by only
+        replacing their pointers in the packed kernel arguments.
+
+        Args:
+            args: Arguments of the kernel, as in :meth:`__call__`.
+            size (int): Range size of the indices, as in :meth:`__call__`.
+            block_size (int): Number of threads per block, as in
+                :meth:`__call__`.
+
+        Returns:
+            BoundElementwiseKernel: The launch, whose ``launch(*args)``
+            method runs the kernel.
+
+        .. note::
+            The outputs allocated by :meth:`bind` are reused by each launch
+            that does not give them.
+        """
+        if block_size is not None and block_size <= 0:
+            raise ValueError('block_size must be greater than zero')
+        n_args = len(args)
+        if n_args != self.nin and n_args != self.nargs:
+            raise TypeError(
+                'Wrong number of arguments for {!r}. '
+                'It must be either {} or {} (with outputs), '
+                'but given {}.'.format(
+                    self.name, self.nin, self.nargs, n_args))
+        return BoundElementwiseKernel(
+            self, args, self._plan(args, size, block_size))
+
+    cdef _ElementwisePlan _plan(self, tuple args, Py_ssize_t size, block_size):
+        cdef function.Function kern
+        cdef Py_ssize_t i
+        cdef list in_args, out_args
+        cdef tuple in_types, out_types
+        cdef shape_t shape
+        cdef _ElementwisePlan plan = _ElementwisePlan.__new__(_ElementwisePlan)
+
         dev_id = device.get_device_id()
         arg_list, _ = _preprocess_args(dev_id, args, True)
 
@@ -890,15 +1235,12 @@ cdef class ElementwiseKernel:
 
         out_args = _get_out_args_with_params(
             out_args, out_types, shape, self.out_params, is_size_specified)
-        if self.no_return:
-            ret = None
-        elif not self.return_tuple and self.nout == 1:
-            ret = out_args[0]
-        else:
-            ret = tuple(out_args)
+        plan.out_args = out_args
+        plan.in_types = in_types
+        plan.ret = self._get_return_value(out_args)
 
         if _contains_zero(shape):
-            return ret
+            return plan
 
         for i, x in enumerate(in_args):
             if type(x) is _scalar.CScalar:
@@ -906,16 +1248,39 @@ cdef class ElementwiseKernel:
 
         inout_args = in_args + out_args
 
-        if self.reduce_dims:
-            shape = _reduce_dims(inout_args, self.params, shape)
-        indexer = _carray._indexer_init(shape)
+        indexer = self._reduced_dims_cache.get(
+            inout_args, self.params, shape, self.reduce_dims)
+        shape = indexer.shape
+        indexer._static_shape = self.static_shape
         inout_args.append(indexer)
+        vec_width = (
+            _get_vec_width(inout_args, self.params, shape)
+            if self.vectorize else 1)
 
         arginfos = _get_arginfos(inout_args)
-        kern = self._get_elementwise_kernel(dev_id, arginfos, type_map)
-        kern.linear_launch(indexer.size, inout_args, shared_mem=0,
-                           block_max_size=block_size, stream=stream)
-        return ret
+        kern = self._get_elementwise_kernel(
+            dev_id, arginfos, type_map, vec_width)
+        launch_size = (indexer.size + vec_width - 1) // vec_width
+        if block_size is None:
+            block_size = 128
+            if _tuning_active:
+                block_size = _get_block_size(
+                    dev_id, self.name, arginfos, kern, launch_size,
+                    inout_args, vec_width, block_size)
+        plan.kern = kern
+        plan.inout_args = inout_args
+        plan.launch_size = launch_size
+        plan.block_size = block_size
+        plan.vec_width = vec_width
+        return plan
+
+    cdef _get_return_value(self, list out_args):
+        if self.no_return:
+            return None
+        elif not self.return_tuple and self.nout == 1:
+            return out_args[0]
+        else:
+            return tuple(out_args)
 
     cpdef tuple _decide_params_type(
             self, tuple in_args_dtype, tuple out_args_dtype):
@@ -929,17 +1294,19 @@ cdef class ElementwiseKernel:
         return ret
 
     cpdef function.Function _get_elementwise_kernel(
-            self, int dev_id, tuple arginfos, _TypeMap type_map):
+            self, int dev_id, tuple arginfos, _TypeMap type_map,
+            int vec_width=1):
         key = (
             dev_id,
             arginfos,
-            type_map)
+            type_map,
+            vec_width)
         kern = self._elementwise_kernel_memo.get(key, None)
         if kern is not None:
             return kern
         kern = _get_elementwise_kernel(
             arginfos, type_map, self.params, self.operation,
-            self.name, self.preamble, **self.kwargs)
+            self.name, self.preamble, vec_width=vec_width, **self.kwargs)
 
         # Store the compiled kernel in the cache.
         # Potentially overwrite a duplicate cache entry because
@@ -952,7 +1319,8 @@ cdef class ElementwiseKernel:
         if in_types not in self._cached_codes:
             code = _get_elementwise_kernel_code(
                 arginfos, type_map, self.params, self.operation,
-                self.name, self.preamble, **self.kwargs)
+                self.name, self.preamble, vec_width=vec_width,
+                **self.kwargs)
             self._cached_codes[in_types] = code
         self._elementwise_kernel_memo[key] = kern
         return kern
@@ -985,6 +1353,153 @@ cdef class ElementwiseKernel:
         return next(iter(codes.values()))
 
 
+cdef class BoundElementwiseKernel:
+
+    """Launch of an elementwise kernel with its arguments processed.
+
+    Created by :meth:`ElementwiseKernel.bind`. It holds the compiled kernel,
+    the launch configuration and the packed kernel arguments, and each
+    :meth:`launch` only checks the arrays and replaces their pointers before
+    launching the kernel.
+
+    Attributes:
+        kernel (ElementwiseKernel): The kernel.
+
+    .. note::
+        Unlike :meth:`ElementwiseKernel.__call__`, the launches do not check
+        whether the outputs overlap with the inputs. A bound kernel must not
+        be launched concurrently from several threads.
+    """
+
+    cdef:
+        readonly ElementwiseKernel kernel
+        _ElementwisePlan _plan
+        int _dev_id
+        # The packed arguments, in the order of the kernel parameters, and
+        # the indexer
+        list _packed
+        # The positions of the array arguments, and the shape, strides and
+        # dtype that each of them must have
+        vector.vector[Py_ssize_t] _array_pos
+        vector.vector[shape_t] _shapes
+        vector.vector[shape_t] _strides
+        list _dtypes
+        # The positions of the scalar arguments
+        vector.vector[Py_ssize_t] _scalar_pos
+
+    def __init__(self, ElementwiseKernel kernel, tuple args,
+                 _ElementwisePlan plan):
+        cdef Py_ssize_t i
+        cdef _ndarray_base arr
+
+        self.kernel = kernel
+        self._plan = plan
+        self._dev_id = device.get_device_id()
+        self._dtypes = []
+        all_args = list(args[:kernel.nin]) + plan.out_args
+        for i in range(len(all_args)):
+            a = all_args[i]
+            if isinstance(a, _ndarray_base):
+                arr = a
+                self._array_pos.push_back(i)
+                self._shapes.push_back(arr._shape)
+                self._strides.push_back(arr._strides)
+                self._dtypes.append(arr.dtype)
+            elif not isinstance(a, texture.TextureObject):
+                self._scalar_pos.push_back(i)
+        if plan.kern is None:
+            return
+        self._packed = []
+        for a in plan.inout_args:
+            if isinstance(a, _ndarray_base):
+                a = (<_ndarray_base>a).get_pointer()
+            elif isinstance(a, _carray.Indexer):
+                a = (<_carray.Indexer>a).get_pointer()
+            self._packed.append(a)
+
+    def launch(self, *args, stream=None):
+        """Launches the kernel.
+
+        Args:
+            args: Arguments of the kernel. The arrays must have the same
+                shapes, strides and dtypes as the ones given to
+                :meth:`ElementwiseKernel.bind`, and be on the same device.
+                The scalars are cast to the types resolved by
+                :meth:`ElementwiseKernel.bind`. If the outputs are omitted,
+                the outputs of :meth:`ElementwiseKernel.bind` are written.
+            stream (cupy.cuda.Stream): The stream to launch the kernel on.
+                The current stream is used by default.
+
+        Returns:
+            The outputs, as returned by :meth:`ElementwiseKernel.__call__`.
+        """
+        cdef Py_ssize_t i, j, n_args = len(args)
+        cdef Py_ssize_t nin = self.kernel.nin
+        cdef _ElementwisePlan plan = self._plan
+        cdef _ndarray_base arr
+        cdef _scalar.CScalar s
+        cdef function.CPointer p
+        cdef list out_args = plan.out_args
+
+        if n_args != nin and n_args != self.kernel.nargs:
+            raise TypeError(
+                'Wrong number of arguments for {!r}. '
+                'It must be either {} or {} (with outputs), '
+                'but given {}.'.format(
+                    self.kernel.name, nin, self.kernel.nargs, n_args))
+        if device.get_device_id() != self._dev_id:
+            raise ValueError(
+                'The kernel was bound on device {}, but the current device '
+                'is {}.'.format(self._dev_id, device.get_device_id()))
+        if n_args != nin:
+            out_args = list(args[nin:])
+
+        for j in range(<Py_ssize_t>self._array_pos.size()):
+            i = self._array_pos[j]
+            a = args[i] if i < nin else out_args[i - nin]
+            if not isinstance(a, _ndarray_base):
+                raise TypeError(
+                    'Argument {} must be a cupy.ndarray, but given {}.'.format(
+                        i, type(a)))
+            arr = a
+            if (arr.dtype != self._dtypes[j] or arr._shape != self._shapes[j]
+                    or arr._strides != self._strides[j]):
+                raise ValueError(
+                    'Argument {} must have the shape {}, strides {} and '
+                    'dtype {} given to bind, but has {}, {} and {}.'.format(
+                        i, tuple(self._shapes[j]), tuple(self._strides[j]),
+                        self._dtypes[j], arr.shape, arr.strides, arr.dtype))
+            if plan.kern is None:
+                continue
+            if (plan.vec_width > 1
+                    and not (<ParameterInfo>self.kernel.params[i]).raw
+                    and arr.data.ptr % (plan.vec_width * arr.dtype.itemsize)):
+                raise ValueError(
+                    'Argument {} is not aligned as the array given to '
+                    'bind.'.format(i))
+            # The data pointer is the first member of CArray.
+            p = self._packed[i]
+            (<void**>p.ptr)[0] = <void*>arr.data.ptr
+
+        for j in range(<Py_ssize_t>self._scalar_pos.size()):
+            i = self._scalar_pos[j]
+            if plan.kern is None:
+                break
+            s = _scalar.scalar_to_c_scalar(args[i])
+            if s is None:
+                raise TypeError('Unsupported type %s' % type(args[i]))
+            s.apply_dtype(plan.in_types[i])
+            self._packed[i] = s
+
+        if plan.kern is not None:
+            plan.kern.linear_launch(
+                plan.launch_size, self._packed, shared_mem=0,
+                block_max_size=plan.block_size, stream=stream)
+        if n_args == nin:
+            return plan.ret
+        return self.kernel._get_return_value(out_args)
+
+
 cdef str fix_cast_expr(src_type, dst_type, str expr):
     src_kind = get_dtype(src_type).kind
     dst_kind = get_dtype(dst_type).kind
@@ -1004,12 +1519,25 @@ cdef str fix_cast_expr(src_type, dst_type, str expr):
     return expr
 
 
+cdef bint _is_half2_op(_Op op, list args):
+    for t in op.in_types + op.out_types:
+        if t is not numpy.float16:
+            return False
+    for a in args:
+        if isinstance(a, _ndarray_base) and a.dtype.char != 'e':
+            return False
+    return True
+
+
 cdef function.Function _get_ufunc_kernel(
         tuple in_types, tuple out_types, routine, tuple arginfos,
         bint has_where, params,
-        name, preamble, loop_prep):
+        name, preamble, loop_prep, int vec_width=1, bint half2=False):
+    # With `half2`, all types are float16 and the vectorized loop applies the
+    # routine to pairs of elements packed into float16x2, which shadows the
+    # input and output types inside the loop.
     cdef _ArgInfo arginfo
-    cdef str str_type, str_var
+    cdef str str_type, str_var, str_ctype
 
     offset_where = len(in_types)
     offset_out = offset_where
@@ -1018,6 +1546,9 @@ cdef function.Function _get_ufunc_kernel(
 
     types = []
     op = []
+    vec_load = []
+    vec_op = []
+    vec_store = []
     if has_where:
         arginfo = arginfos[offset_where]
         if arginfo.is_ndarray():
@@ -1035,8 +1566,31 @@ cdef function.Function _get_ufunc_kernel(
                 str_var,
                 fix_cast_expr(arginfo.dtype, x, f'_raw_{str_var}[_ind.get()]')
             ))
+            if vec_width > 1:
+                str_ctype = _scalar.get_typename(arginfo.dtype)
+                vec_load.append(
+                    f'{str_ctype} _vec_{str_var}[{vec_width}];\n'
+                    f'_raw_{str_var}.load_vec(_vec_base, _vec_{str_var});')
+                if half2:
+                    vec_load.append(f'typedef float16x2 {str_type};')
+                    vec_op.append(
+                        f'const {str_type} {str_var}(_vec_{str_var}[_vec_k], '
+                        f'_vec_{str_var}[_vec_k + 1]);')
+                else:
+                    vec_op.append('const {} {}({});'.format(
+                        str_type,
+                        str_var,
+                        fix_cast_expr(
+                            arginfo.dtype, x, f'_vec_{str_var}[_vec_k]')
+                    ))
+        elif half2:
+            vec_load.append(
+                f'typedef float16x2 {str_type};\n'
+                f'const {str_type} _vec_{str_var}({str_var}, {str_var});')
+            vec_op.append(f'const {str_type} {str_var}(_vec_{str_var});')
 
     out_op = []
+    vec_out_op = []
     for i, x in enumerate(out_types):
         str_var = 'out%d' % i
         str_type = str_var + '_type'
@@ -1047,6 +1601,20 @@ cdef function.Function _get_ufunc_kernel(
             f'_raw_{str_var}[_ind.get()]',
             fix_cast_expr(x, arginfo.dtype, str_var)
         ))
+        if vec_width > 1:
+            str_ctype = _scalar.get_typename(arginfo.dtype)
+            vec_load.append(f'{str_ctype} _vec_{str_var}[{vec_width}];')
+            vec_op.append(f'{str_type} {str_var};')
+            if half2:
+                vec_load.append(f'typedef float16x2 {str_type};')
+                vec_out_op.append(
+                    f'_vec_{str_var}[_vec_k] = {str_var}.lo();\n'
+                    f'_vec_{str_var}[_vec_k + 1] = {str_var}.hi();')
+            else:
+                vec_out_op.append('_vec_{}[_vec_k] = {};'.format(
+                    str_var, fix_cast_expr(x, arginfo.dtype, str_var)))
+            vec_store.append(
+                f'_raw_{str_var}.store_vec(_vec_base, _vec_{str_var});')
 
     type_map = _TypeMap(tuple(types))
 
@@ -1054,6 +1622,9 @@ cdef function.Function _get_ufunc_kernel(
     op.append(';')
     op.extend(out_op)
     operation = '\n'.join(op)
+    vec_op.append(routine)
+    vec_op.append(';')
+    vec_op.extend(vec_out_op)
     # HIP/ROCm 4.3 has an issue with ifs and ternary operators
     #
     # int bool(int x) {
@@ -1076,7 +1647,9 @@ cdef function.Function _get_ufunc_kernel(
         """
     return _get_simple_elementwise_kernel(
         params, arginfos, operation, name, type_map, preamble,
-        loop_prep=loop_prep)
+        loop_prep=loop_prep, vec_width=vec_width,
+        vec_load='\n'.join(vec_load), vec_operation='\n'.join(vec_op),
+        vec_store='\n'.join(vec_store), vec_step=2 if half2 else 1)
 
 
 cdef dict _mst_unsigned_to_signed = {
@@ -1092,6 +1665,8 @@ cdef inline int _get_kind_score(type kind):
         return 1
     if issubclass(kind, (numpy.inexact, float, complex)):
         return 2
+    if _bfloat16 is not None and kind is _bfloat16.type:
+        return 2
     # unknown type, assume higher score
     return 3
 
@@ -1156,10 +1731,12 @@ cdef class ufunc:
         readonly int _cutensor_alpha
         readonly int _cutensor_gamma
         readonly str _scatter_op
+        readonly bint _half2
         readonly tuple _params
         readonly tuple _params_with_where
         readonly dict _routine_cache
         readonly dict _kernel_memo
+        readonly _ReducedDimsCache _reduced_dims_cache
         readonly object _doc
         public object __doc__
         readonly object __name__
@@ -1168,7 +1745,7 @@ cdef class ufunc:
     def __init__(
             self, name, nin, nout, _Ops ops, preamble='', loop_prep='', doc='',
             default_casting=None, *, _Ops out_ops=None, cutensor_op=None,
-            scatter_op=None):
+            scatter_op=None, half2=False):
         self.name = name
         self.__name__ = name
         self.nin = nin
@@ -1190,6 +1767,7 @@ cdef class ufunc:
                 getattr(cuda_cutensor, cutensor_op[0]),
                 cutensor_op[1], cutensor_op[2])
         self._scatter_op = scatter_op
+        self._half2 = half2
 
         _in_params = tuple(
             ParameterInfo('T in%d' % i, True)
@@ -1205,6 +1783,7 @@ cdef class ufunc:
             + _out_params + _other_params)
         self._routine_cache = {}
         self._kernel_memo = {}
+        self._reduced_dims_cache = _ReducedDimsCache()
 
     def __repr__(self):
         return '<ufunc \'%s\'>' % self.name
@@ -1247,6 +1826,9 @@ cdef class ufunc:
         if _fusion_thread_local.is_fusing():
             return _fusion_thread_local.call_ufunc(self, *args, **kwargs)
 
+        if _fusion_thread_local.is_lazy():
+            return _fusion_thread_local.call_lazy_ufunc(self, args, kwargs)
+
         cdef function.Function kern
         cdef list broad_values
         cdef shape_t shape
@@ -1377,14 +1959,27 @@ cdef class ufunc:
             x = broad_values[self.nin]
             inout_args.append(x)
         inout_args.extend(out_args)
-        shape = _reduce_dims(inout_args, self._params, shape)
-        indexer = _carray._indexer_init(shape)
+        indexer = self._reduced_dims_cache.get(
+            inout_args, self._params, shape, True)
+        shape = indexer.shape
+        vec_width = (
+            1 if has_where else
+            _get_vec_width(inout_args, self._params, shape))
+        half2 = (
+            self._half2 and vec_width > 1 and _is_half2_op(op, inout_args))
         inout_args.append(indexer)
         arginfos = _get_arginfos(inout_args)
 
-        kern = self._get_ufunc_kernel(dev_id, op, arginfos, has_where)
+        kern = self._get_ufunc_kernel(
+            dev_id, op, arginfos, has_where, vec_width, half2)
 
-        kern.linear_launch(indexer.size, inout_args)
+        launch_size = (indexer.size + vec_width - 1) // vec_width
+        block_size = 128
+        if _tuning_active:
+            block_size = _get_block_size(
+                dev_id, self.name, arginfos, kern, launch_size, inout_args,
+                vec_width, block_size)
+        kern.linear_launch(launch_size, inout_args, 0, block_size)
         return ret
 
     cdef str _get_name_with_type(self, tuple arginfos, bint has_where):
@@ -1402,16 +1997,18 @@ cdef class ufunc:
         return '{}__{}'.format(name, '_'.join(inout_type_words))
 
     cdef function.Function _get_ufunc_kernel(
-            self, int dev_id, _Op op, tuple arginfos, bint has_where):
+            self, int dev_id, _Op op, tuple arginfos, bint has_where,
+            int vec_width=1, bint half2=False):
         cdef function.Function kern
-        key = (dev_id, op, arginfos, has_where)
+        key = (dev_id, op, arginfos, has_where, vec_width, half2)
         kern = self._kernel_memo.get(key, None)
         if kern is None:
             name = self._get_name_with_type(arginfos, has_where)
             params = self._params_with_where if has_where else self._params
             kern = _get_ufunc_kernel(
                 op.in_types, op.out_types, op.routine, arginfos, has_where,
-                params, name, self._preamble, self._loop_prep)
+                params, name, self._preamble, self._loop_prep, vec_width,
+                half2)
             self._kernel_memo[key] = kern
         return kern
 
@@ -1563,6 +2160,26 @@ cdef class _Op:
         return tuple([get_dtype(t) for t in self.out_types])
 
 
+cdef list _add_bfloat16_ops(list ops):
+    # Derive a bfloat16 loop from each float16 loop. bfloat16 converts to
+    # and from float implicitly, so the float16 routines compile as is.
+    cdef _Op op
+    cdef list ret = []
+    f16 = numpy.float16
+    bf16 = _bfloat16.type
+    for op in ops:
+        ret.append(op)
+        types = op.in_types + op.out_types
+        if f16 not in types or not all(
+                [t is f16 or t is numpy.bool_ for t in types]):
+            continue
+        ret.append(_Op(
+            tuple([bf16 if t is f16 else t for t in op.in_types]),
+            tuple([bf16 if t is f16 else t for t in op.out_types]),
+            op.routine, op.error_func))
+    return ret
+
+
 cdef class _Ops:
 
     def __init__(self, tuple ops):
@@ -1591,6 +2208,8 @@ cdef class _Ops:
                 assert isinstance(t, str)
                 typ, rt = t, routine
             ops_.append(_Op.from_type_and_routine(typ, rt))
+        if _bfloat16 is not None:
+            ops_ = _add_bfloat16_ops(ops_)
         return _Ops(tuple(ops_))
 
     cpdef _Op guess_routine(
@@ -1691,10 +2310,13 @@ cdef class _Ops:
 
 cpdef create_ufunc(name, ops, routine=None, preamble='', doc='',
                    default_casting=None, loop_prep='', out_ops=None,
-                   cutensor_op=None, scatter_op=None):
+                   cutensor_op=None, scatter_op=None, half2=False):
+    # `half2` declares that the float16 routine only uses operators that
+    # float16x2 supports, so that contiguous calls compute two elements at
+    # once with packed half precision instructions.
     ops_ = _Ops.from_tuples(ops, routine)
     _out_ops = None if out_ops is None else _Ops.from_tuples(out_ops, routine)
     return ufunc(
         name, ops_.nin, ops_.nout, ops_, preamble,
         loop_prep, doc, default_casting=default_casting, out_ops=_out_ops,
-        cutensor_op=cutensor_op, scatter_op=scatter_op)
+        cutensor_op=cutensor_op, scatter_op=scatter_op, half2=half2)
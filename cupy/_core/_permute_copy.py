@@ -0,0 +1,180 @@
+"""Tiled copy between arrays whose fastest-varying axes differ.
+
+An elementwise copy from a transposed (or otherwise permuted) array reads
+or writes with a large stride. Here the axes are ordered by the strides of
+the (dense) destination and merged when they are contiguous in both arrays.
+When the unit-stride axis of the source is not the innermost one, the two
+axes are copied through 32 x 32 tiles in shared memory, so that both the
+reads and the writes are coalesced. Up to three other axes are iterated
+over by the grid, and the dtype conversion is done on the way.
+"""
+
+import numpy
+
+import cupy
+from cupy._core._scalar import get_typename
+from cupy import _util
+
+
+# Smaller copies are dominated by the launch either way.
+_min_size = 1 << 15
+_max_batch_dims = 3
+_tile = 32
+_block_rows = 8
+
+# Same-dtype copies move the bytes as is.
+_raw_types = {1: 'unsigned char', 2: 'unsigned short', 4: 'unsigned int',
+              8: 'unsigned long long', 16: 'ulonglong2'}
+# float16 is only copied as is.
+_convertible = '?bBhHiIlLqQfdFD'
+
+
+_permute_copy_code = r'''
+#include <cupy/complex.cuh>
+
+#define TILE 32
+#define BLOCK_ROWS 8
+
+// Copies a (rows x cols) matrix whose rows have a unit stride in src and
+// whose columns have a unit stride in dst, for each of the b0 x b1 x b2
+// batch items.
+extern "C" __global__ void cupy_permute_copy(
+        const IN* __restrict__ src, OUT* __restrict__ dst,
+        const long long rows, const long long cols,
+        const long long src_col, const long long dst_row,
+        const long long b0, const long long b1, const long long b2,
+        const long long s0, const long long s1, const long long s2,
+        const long long d0, const long long d1, const long long d2) {
+    // raw storage, as the complex types cannot be __shared__ variables
+    __shared__ __align__(16) char smem[TILE * (TILE + 1) * sizeof(OUT)];
+    OUT (*tile)[TILE + 1] = reinterpret_cast<OUT(*)[TILE + 1]>(smem);
+    const int tx = threadIdx.x;
+    const int ty = threadIdx.y;
+    const long long n_batch = b0 * b1 * b2;
+    const long long n_row_tiles = (rows + TILE - 1) / TILE;
+    const long long col0 = (long long)blockIdx.x * TILE;
+
+    for (long long b = blockIdx.z; b < n_batch; b += gridDim.z) {
+        const long long i2 = b % b2;
+        const long long i1 = b / b2 % b1;
+        const long long i0 = b / (b2 * b1);
+        const IN* s = src + i0 * s0 + i1 * s1 + i2 * s2;
+        OUT* d = dst + i0 * d0 + i1 * d1 + i2 * d2;
+        for (long long t = blockIdx.y; t < n_row_tiles; t += gridDim.y) {
+            const long long row0 = t * TILE;
+            for (int j = ty; j < TILE; j += BLOCK_ROWS) {
+                const long long r = row0 + tx;
+                const long long c = col0 + j;
+                if (r < rows && c < cols) {
+                    tile[j][tx] = (OUT)s[r + c * src_col];
+                }
+            }
+            __syncthreads();
+            for (int j = ty; j < TILE; j += BLOCK_ROWS) {
+                const long long r = row0 + j;
+                const long long c = col0 + tx;
+                if (r < rows && c < cols) {
+                    d[r * dst_row + c] = tile[tx][j];
+                }
+            }
+            __syncthreads();
+        }
+    }
+}
+'''
+
+
+@_util.memoize(for_each_device=True)
+def _get_kernel(in_type, out_type):
+    code = '#define IN {}\n#define OUT {}\n'.format(in_type, out_type)
+    return cupy.RawKernel(code + _permute_copy_code, 'cupy_permute_copy')
+
+
+def _kernel_types(src_dtype, dst_dtype):
+    if src_dtype == dst_dtype:
+        return _raw_types.get(src_dtype.itemsize)
+    if (src_dtype.char not in _convertible
+            or dst_dtype.char not in _convertible):
+        return None
+    if src_dtype.kind == 'c' and dst_dtype.kind != 'c':
+        # the elementwise copy warns about the discarded imaginary part
+        return None
+    return get_typename(src_dtype), get_typename(dst_dtype)
+
+
+def _reduced_layout(src, dst):
+    # Returns the axes as (size, src stride, dst stride) tuples in items,
+    # ordered by the dst strides and merged where contiguous in both,
+    # or None if dst is not dense.
+    src_item = src.itemsize
+    dst_item = dst.itemsize
+    axes = []
+    for size, s, d in zip(src.shape, src.strides, dst.strides):
+        if size == 1:
+            continue
+        if s % src_item or d % dst_item:
+            return None
+        axes.append((size, s // src_item, d // dst_item))
+    axes.sort(key=lambda axis: -abs(axis[2]))
+    expected = 1
+    for size, _, d in reversed(axes):
+        if d != expected:
+            return None
+        expected *= size
+    merged = []
+    for size, s, d in axes:
+        if merged:
+            prev_size, prev_s, prev_d = merged[-1]
+            if prev_s == s * size:
+                merged[-1] = (prev_size * size, s, d)
+                continue
+        merged.append((size, s, d))
+    return merged
+
+
+def copy(src, dst):
+    """Copies ``src`` to ``dst`` with tiles if their fastest axes differ.
+
+    Returns False, without copying, when the layout is not handled here.
+    ``dst`` must be a new array of the shape of ``src``.
+    """
+    if src.size < _min_size or src.shape != dst.shape:
+        return False
+    types = _kernel_types(src.dtype, dst.dtype)
+    if types is None:
+        return False
+    if isinstance(types, str):
+        types = types, types
+    axes = _reduced_layout(src, dst)
+    if axes is None or len(axes) < 2 or axes[-1][1] == 1:
+        # the innermost axis is contiguous in both
+        return False
+    for k, (_, s, _) in enumerate(axes):
+        if s == 1:
+            break
+    else:
+        return False
+    batch = axes[:k] + axes[k + 1:-1]
+    if len(batch) > _max_batch_dims:
+        return False
+    batch = [(1, 0, 0)] * (_max_batch_dims - len(batch)) + batch
+    rows, _, dst_row = axes[k]
+    cols, src_col, _ = axes[-1]
+    if rows < _block_rows or cols < _block_rows:
+        # mostly idle tiles
+        return False
+    n_batch = 1
+    for size, _, _ in batch:
+        n_batch *= size
+
+    grid = ((cols + _tile - 1) // _tile,
+            min((rows + _tile - 1) // _tile, 65535),
+            min(n_batch, 65535))
+    args = [src, dst, rows, cols, src_col, dst_row]
+    args += [size for size, _, _ in batch]
+    args += [s for _, s, _ in batch]
+    args += [d for _, _, d in batch]
+    kernel = _get_kernel(*types)
+    kernel(grid, (_tile, _block_rows),
+           tuple(args[:2]) + tuple(numpy.int64(x) for x in args[2:]))
+    return True
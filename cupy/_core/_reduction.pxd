@@ -35,7 +35,8 @@ cdef class _AbstractReductionKernel:
         self, out_block_num, block_size, block_stride,
         in_args, out_args, in_shape, out_shape, types,
         map_expr, reduce_expr, post_map_expr, reduce_type,
-        stream, params)
+        stream, params, Py_ssize_t items_per_thread=*,
+        Py_ssize_t n_splits=*)
 
     cdef tuple _get_expressions_and_types(
         self, list in_args, list out_args, dtype)
@@ -47,7 +48,7 @@ cdef class _AbstractReductionKernel:
         self,
         tuple params, tuple arginfos, _kernel._TypeMap types,
         str map_expr, str reduce_expr, str post_map_expr, str reduce_type,
-        Py_ssize_t block_size)
+        Py_ssize_t block_size, Py_ssize_t items_per_thread, bint split)
 
 
 cdef class ReductionKernel(_AbstractReductionKernel):
@@ -25,9 +25,12 @@ from cupy._core.core cimport _ndarray_base
 from cupy._core cimport internal
 from cupy.cuda cimport device
 from cupy.cuda cimport function
+from cupy_backends.cuda.api cimport driver
 from cupy_backends.cuda.api cimport runtime
 
+import functools
 import math
+import os
 import string
 import warnings
 
@@ -37,39 +40,100 @@ import cupy
 from cupy._core._kernel import _get_param_info
 from cupy._core._kernel import _decide_params_type
 from cupy._core._ufuncs import elementwise_copy
+from cupy._core import _tuning
 from cupy.cuda import compiler
 from cupy import _util
 
 
-cpdef str _create_reduction_function_code(
-        name, block_size, reduce_type, params, arginfos, identity,
-        pre_map_expr, reduce_expr, post_map_expr,
-        _kernel._TypeMap type_map, input_expr, output_expr, preamble, options):
-    # A (incomplete) list of internal variables:
-    # _J            : the index of an element in the array
-    # _block_size   : the number of threads in a block; should be power of 2
-    # _block_stride : the number of elements being processed by a block; should
-    #                 be power of 2 and <= _block_size
-
-    module_code = string.Template('''
-${type_preamble}
-${preamble}
-#define REDUCE(a, b) (${reduce_expr})
-#define POST_MAP(a) (${post_map_expr})
-#define _REDUCE(_offset) if (_tid < _offset) { \
-  _type_reduce _a = _sdata[_tid], _b = _sdata[(_tid + _offset)]; \
-  _sdata[_tid] = REDUCE(_a, _b); \
+# Shuffles a value of any trivially copyable type, 32 bits at a time.
+cdef str _shfl_down_code = '''
+template <typename T>
+__device__ __forceinline__ T _cupy_reduce_shfl_down(T v, unsigned int delta) {
+  constexpr int _n = (sizeof(T) + sizeof(int) - 1) / sizeof(int);
+  int _w[_n];
+  memcpy(_w, &v, sizeof(T));
+#pragma unroll
+  for (int _k = 0; _k < _n; ++_k) {
+    _w[_k] = __shfl_down_sync(0xffffffff, _w[_k], delta);
+  }
+  memcpy(&v, _w, sizeof(T));
+  return v;
 }
+'''
+
+# The reduction of each thread. With several items per thread, the loop is
+# unrolled so that the loads of the items are issued together, and the
+# remaining items are reduced one by one; the order of the reduction is the
+# same in both cases.
+cdef str _thread_reduce_code = '''
+    for (; _j < _in_ind.size(); _j += _j_stride, _J += _J_stride) {
+      _in_ind.set(_j);
+      ${input_expr}
+      _type_reduce _a = static_cast<_type_reduce>(${pre_map_expr});
+      _s = REDUCE(_s, _a);
+    }'''
+
+cdef str _thread_reduce_unrolled_code = '''
+    for (; _j + (_items_per_thread - 1) * _j_stride < _in_ind.size();
+         _j += _items_per_thread * _j_stride) {
+#pragma unroll
+      for (int _k = 0; _k < _items_per_thread; ++_k, _J += _J_stride) {
+        _in_ind.set(_j + _k * _j_stride);
+        ${input_expr}
+        _type_reduce _a = static_cast<_type_reduce>(${pre_map_expr});
+        _s = REDUCE(_s, _a);
+      }
+    }''' + _thread_reduce_code
 
-typedef ${reduce_type} _type_reduce;
+# The reduction of the block in the shared memory.
+cdef str _block_reduce_code = '''
+    for (unsigned int _block = _block_size / 2;
+         _block >= _block_stride; _block >>= 1) {
+      if (_tid < _block) {
+        _REDUCE(_block);
+      }
+      __syncthreads();
+    }
+    if (_tid < _block_stride) {
+      _s = _sdata[_tid];
+    }'''
+
+# The same, but the last steps, that are within the first warp, are done
+# with shuffles instead of the shared memory and barriers.
+cdef str _block_reduce_shfl_code = '''
+    for (unsigned int _block = _block_size / 2;
+         _block >= _block_stride && _block >= 32; _block >>= 1) {
+      if (_tid < _block) {
+        _REDUCE(_block);
+      }
+      __syncthreads();
+    }
+    if (_block_stride < 32) {
+      if (_tid < 32) {
+        _s = _sdata[_tid];
+        for (unsigned int _block = 16; _block >= _block_stride;
+             _block >>= 1) {
+          _type_reduce _b = _cupy_reduce_shfl_down(_s, _block);
+          _s = REDUCE(_s, _b);
+        }
+      }
+    } else if (_tid < _block_stride) {
+      _s = _sdata[_tid];
+    }'''
+
+
+# The kernel reducing each block of _block_stride outputs in a block.
+cdef str _reduction_kernel_code = '''
 extern "C" __global__ void ${name}(${params}) {
-  __shared__ char _sdata_raw[${block_size} * sizeof(_type_reduce)];
+  constexpr unsigned int _block_size = ${block_size};
+  constexpr int _items_per_thread = ${items_per_thread};
+  __shared__ char _sdata_raw[_block_size * sizeof(_type_reduce)];
   _type_reduce *_sdata = reinterpret_cast<_type_reduce*>(_sdata_raw);
   unsigned int _tid = threadIdx.x;
 
   IndexT _J_offset = _tid >> __popc(_block_stride - 1); // _tid / _block_stride
   ptrdiff_t _j_offset = (ptrdiff_t)_J_offset * _out_ind.size();
-  IndexT _J_stride = ${block_size} >> __popc(_block_stride - 1);
+  IndexT _J_stride = _block_size >> __popc(_block_stride - 1);
   ptrdiff_t _j_stride = (ptrdiff_t)_J_stride * _out_ind.size();
 
   for (ptrdiff_t _i_base = (ptrdiff_t)blockIdx.x * _block_stride;
@@ -79,42 +143,162 @@ extern "C" __global__ void ${name}(${params}) {
     ptrdiff_t _i =
         _i_base + (_tid & (_block_stride - 1));  // _tid % _block_stride
     IndexT _J = _J_offset;
-    for (ptrdiff_t _j = _i + _j_offset; _j < _in_ind.size();
-         _j += _j_stride, _J += _J_stride) {
-      _in_ind.set(_j);
-      ${input_expr}
-      _type_reduce _a = static_cast<_type_reduce>(${pre_map_expr});
-      _s = REDUCE(_s, _a);
-    }
+    ptrdiff_t _j = _i + _j_offset;${thread_reduce}
     _sdata[_tid] = _s;
-    __syncthreads();
-    for (unsigned int _block = ${block_size} / 2;
-         _block >= _block_stride; _block >>= 1) {
-      if (_tid < _block) {
-        _REDUCE(_block);
-      }
-      __syncthreads();
-    }
-    if (_tid < _block_stride) {
-      _s = _sdata[_tid];
-    }
+    __syncthreads();${block_reduce}
     if (_tid < _block_stride && _i < _out_ind.size()) {
       _out_ind.set(static_cast<ptrdiff_t>(_i));
       ${output_expr}
       POST_MAP(_s);
     }
   }
-}''').substitute(
+}'''
+
+# The kernel reducing each block of _block_stride outputs in _n_splits
+# blocks, for reductions to few outputs. Each block reduces its share of
+# the elements and writes the partial results to the scratch memory; the
+# last block to finish (counted with an atomic per block of outputs)
+# reduces the partial results and writes the outputs. The grid must be of
+# _n_splits blocks per block of outputs, and the scratch memory (the _scratch
+# argument) holds zero-initialized counters, padded to 64 bytes, followed by
+# the partial results.
+cdef str _split_reduction_kernel_code = '''
+template <typename T>
+__device__ __forceinline__ T _cupy_reduce_load_cg(const T* p) {
+  // bypasses the L1 cache, that is not coherent across blocks
+  constexpr int _n = (sizeof(T) + sizeof(int) - 1) / sizeof(int);
+  int _w[_n];
+  const int* _p = reinterpret_cast<const int*>(p);
+#pragma unroll
+  for (int _k = 0; _k < _n; ++_k) {
+#if defined(__HIP_DEVICE_COMPILE__)
+    _w[_k] = __atomic_load_n(_p + _k, __ATOMIC_RELAXED);
+#else
+    _w[_k] = __ldcg(_p + _k);
+#endif
+  }
+  T v = *p;
+  memcpy(&v, _w, sizeof(T));
+  return v;
+}
+
+extern "C" __global__ void ${name}(${params}) {
+  constexpr unsigned int _block_size = ${block_size};
+  constexpr int _items_per_thread = ${items_per_thread};
+  __shared__ char _sdata_raw[_block_size * sizeof(_type_reduce)];
+  __shared__ bool _is_last;
+  _type_reduce *_sdata = reinterpret_cast<_type_reduce*>(_sdata_raw);
+  unsigned int _tid = threadIdx.x;
+
+  unsigned int _out_blocks =
+      (_out_ind.size() + _block_stride - 1) / _block_stride;
+  unsigned int _n_splits = gridDim.x / _out_blocks;
+  unsigned int _out_block = blockIdx.x / _n_splits;
+  unsigned int _split = blockIdx.x % _n_splits;
+
+  IndexT _J_offset = _tid >> __popc(_block_stride - 1); // _tid / _block_stride
+  IndexT _J_block = _block_size >> __popc(_block_stride - 1);
+  IndexT _J_stride = _J_block * _n_splits;
+  ptrdiff_t _j_stride = (ptrdiff_t)_J_stride * _out_ind.size();
+
+  _type_reduce _s = _type_reduce(${identity});
+  ptrdiff_t _i = (ptrdiff_t)_out_block * _block_stride
+      + (_tid & (_block_stride - 1));  // _tid % _block_stride
+  IndexT _J = _J_offset + _J_block * _split;
+  ptrdiff_t _j = _i + (ptrdiff_t)_J * _out_ind.size();${thread_reduce}
+  _sdata[_tid] = _s;
+  __syncthreads();${block_reduce}
+
+  unsigned int* _counters = reinterpret_cast<unsigned int*>(_scratch);
+  _type_reduce* _partials = reinterpret_cast<_type_reduce*>(
+      _scratch + (_out_blocks * sizeof(unsigned int) + 63) / 64 * 64);
+  if (_tid < _block_stride) {
+    _partials[(_out_block * _n_splits + _split) * _block_stride + _tid] = _s;
+  }
+  __threadfence();
+  __syncthreads();
+  if (_tid == 0) {
+    _is_last = atomicAdd(&_counters[_out_block], 1u) == _n_splits - 1;
+  }
+  __syncthreads();
+  if (!_is_last) {
+    return;
+  }
+
+  _s = _type_reduce(${identity});
+  for (unsigned int _k = _J_offset; _k < _n_splits; _k += _J_block) {
+    _type_reduce _b = _cupy_reduce_load_cg(&_partials[
+        (_out_block * _n_splits + _k) * _block_stride
+        + (_tid & (_block_stride - 1))]);
+    _s = REDUCE(_s, _b);
+  }
+  _sdata[_tid] = _s;
+  __syncthreads();${block_reduce}
+  if (_tid < _block_stride && _i < _out_ind.size()) {
+    _out_ind.set(static_cast<ptrdiff_t>(_i));
+    ${output_expr}
+    POST_MAP(_s);
+  }
+}'''
+
+
+cpdef str _create_reduction_function_code(
+        name, block_size, reduce_type, params, arginfos, identity,
+        pre_map_expr, reduce_expr, post_map_expr,
+        _kernel._TypeMap type_map, input_expr, output_expr, preamble, options,
+        items_per_thread=1, split=False):
+    # A (incomplete) list of internal variables:
+    # _J            : the index of an element in the array
+    # _block_size   : the number of threads in a block; should be power of 2
+    # _block_stride : the number of elements being processed by a block; should
+    #                 be power of 2 and <= _block_size
+    # _items_per_thread : the number of elements loaded by a thread at once
+    # _n_splits     : the number of blocks reducing each block of outputs,
+    #                 with split=True
+
+    thread_reduce = string.Template(
+        _thread_reduce_unrolled_code if items_per_thread > 1
+        else _thread_reduce_code).substitute(
+            input_expr=input_expr, pre_map_expr=pre_map_expr)
+    if runtime._is_hip_environment:
+        # the warps are of 64 threads on AMD GPUs
+        shfl_down = ''
+        block_reduce = _block_reduce_code
+    else:
+        shfl_down = _shfl_down_code
+        block_reduce = _block_reduce_shfl_code
+    if split:
+        kernel_code = _split_reduction_kernel_code
+    else:
+        kernel_code = _reduction_kernel_code
+
+    module_code = string.Template('''
+${type_preamble}
+${preamble}
+#define REDUCE(a, b) (${reduce_expr})
+#define POST_MAP(a) (${post_map_expr})
+#define _REDUCE(_offset) if (_tid < _offset) { \
+  _type_reduce _a = _sdata[_tid], _b = _sdata[(_tid + _offset)]; \
+  _sdata[_tid] = REDUCE(_a, _b); \
+}
+${shfl_down}
+typedef ${reduce_type} _type_reduce;
+typedef ${index_type} _index_t;
+''' + kernel_code).substitute(
+        thread_reduce=thread_reduce,
+        block_reduce=block_reduce,
+        shfl_down=shfl_down,
         name=name,
         block_size=block_size,
+        items_per_thread=items_per_thread,
         reduce_type=reduce_type,
         params=_kernel._get_kernel_params(params, arginfos),
+        index_type=(
+            'int' if _kernel._is_index_32_bits(arginfos) else 'ptrdiff_t'),
         identity=identity,
         reduce_expr=reduce_expr,
-        pre_map_expr=pre_map_expr,
         post_map_expr=post_map_expr,
         type_preamble=type_map.get_typedef_code(),
-        input_expr=input_expr,
         output_expr=output_expr,
         preamble=preamble)
     return module_code
@@ -129,11 +313,12 @@ cpdef function.Function _create_reduction_function_from_code(
 cpdef function.Function _create_reduction_function(
         name, block_size, reduce_type, params, arginfos, identity,
         pre_map_expr, reduce_expr, post_map_expr,
-        _kernel._TypeMap type_map, input_expr, output_expr, preamble, options):
+        _kernel._TypeMap type_map, input_expr, output_expr, preamble, options,
+        items_per_thread=1, split=False):
     code = _create_reduction_function_code(
         name, block_size, reduce_type, params, arginfos, identity,
         pre_map_expr, reduce_expr, post_map_expr, type_map, input_expr,
-        output_expr, preamble, options
+        output_expr, preamble, options, items_per_thread, split
     )
     return _create_reduction_function_from_code(name, code, options)
 
@@ -246,6 +431,74 @@ cpdef (Py_ssize_t, Py_ssize_t, Py_ssize_t) _get_block_specs(  # NOQA
     return block_size, block_stride, out_block_num
 
 
+# The numbers of items per thread the kernels are specialized for.
+_items_per_thread_candidates = (1, 2, 4, 8)
+
+# The number of items per thread found fastest by the autotuner, for each
+# (device, reduce type, reduce size bucket).
+_tuned_items_per_thread = {}
+
+cdef bint _tuning_active = _tuning.active
+
+cdef bint _autotune_items_per_thread = (
+    int(os.environ.get('CUPY_REDUCTION_AUTOTUNE', '0')) != 0)
+
+
+cpdef bint _set_autotune(bint enabled):
+    # Returns the previous setting; for testing.
+    global _autotune_items_per_thread
+    previous = _autotune_items_per_thread
+    _autotune_items_per_thread = enabled
+    return previous
+
+
+cdef inline Py_ssize_t _get_reduce_size_bucket(
+        Py_ssize_t in_size, Py_ssize_t out_size):
+    return max(1, in_size // max(1, out_size)).bit_length()
+
+
+cpdef Py_ssize_t _get_items_per_thread(
+        Py_ssize_t in_size, Py_ssize_t out_size,
+        Py_ssize_t block_size, Py_ssize_t block_stride):
+    # The number of elements each thread reduces, by default. Only unroll
+    # the loop when it runs long enough, so that short reductions do not
+    # compile another variant.
+    cdef Py_ssize_t reduce_size, n_items
+    reduce_size = max(1, in_size // max(1, out_size))
+    n_items = reduce_size // (block_size // block_stride)
+    return 4 if n_items >= 16 else 1
+
+
+# The minimum number of elements reduced by each block of a split reduction.
+cdef Py_ssize_t _min_split_size = 1 << 16
+cdef dict _sm_counts = {}
+
+# The scratch memory of split reductions: an argument appended to the
+# parameters of the kernel.
+cdef tuple _split_params = _get_param_info('uint64 _scratch', True)
+
+
+cpdef Py_ssize_t _get_n_splits(
+        Py_ssize_t in_size, Py_ssize_t out_size,
+        Py_ssize_t block_stride, Py_ssize_t out_block_num,
+        int device_id) except -1:
+    # The number of blocks each block of outputs is reduced by. A reduction
+    # to few outputs has as many blocks, so it is split to fill the device.
+    cdef Py_ssize_t n_blocks, n_splits
+    sm_count = _sm_counts.get(device_id)
+    if sm_count is None:
+        sm_count = runtime.deviceGetAttribute(
+            runtime.cudaDevAttrMultiProcessorCount, device_id)
+        _sm_counts[device_id] = sm_count
+    n_blocks = 4 * sm_count
+    if out_block_num * 2 > n_blocks:
+        return 1
+    n_splits = min(
+        n_blocks // out_block_num,
+        max(1, in_size // out_size) * block_stride // _min_split_size)
+    return n_splits if n_splits >= 2 else 1
+
+
 cdef tuple _sort_axis(tuple axis, tuple strides):
     # Sorts axis in the decreasing order of absolute values of strides.
     return tuple(sorted(axis, key=lambda i: -abs(strides[i])))
@@ -310,6 +563,7 @@ cdef class _AbstractReductionKernel:
         cdef tuple shape_and_strides
         cdef Py_ssize_t contiguous_size = -1
         cdef Py_ssize_t block_size, block_stride, out_block_num = 0
+        cdef Py_ssize_t n_splits = 1
         cdef shape_t in_shape, out_shape
         cdef _ndarray_base ret
         cdef bint cub_success
@@ -384,15 +638,34 @@ cdef class _AbstractReductionKernel:
 
         params = self._params
 
+        in_size = internal.prod(in_shape)
+        out_size = internal.prod(out_shape)
+        db_params = None
+
         # Calculate the reduction block dimensions.
         if optimize_context is None:
-            # Calculate manually
+            # Calculate manually, unless tuned on this GPU model
             contiguous_size = _get_contiguous_size(
                 in_args, self.in_params, out_shape, in_shape.size())
+            block_size = -1
+            if _tuning_active:
+                db_key = '{}/{}/{}'.format(
+                    self.name, reduce_type,
+                    _get_reduce_size_bucket(in_size, out_size))
+                db_params = _tuning.lookup(device_id, 'reduction', db_key)
+                if db_params is None:
+                    _tuning.maybe_tune(
+                        device_id, 'reduction', db_key, functools.partial(
+                            self._prepare_tuning, in_args, out_args,
+                            in_shape, out_shape, contiguous_size, type_map,
+                            map_expr, reduce_expr, post_map_expr,
+                            reduce_type))
+                else:
+                    block_size = db_params[0]
             block_size, block_stride, out_block_num = _get_block_specs(
-                internal.prod(in_shape),
-                internal.prod(out_shape),
-                contiguous_size, -1)
+                in_size, out_size, contiguous_size, block_size)
+            n_splits = _get_n_splits(
+                in_size, out_size, block_stride, out_block_num, device_id)
         else:
             # Optimize dynamically
             key = ('simple_reduction',) + key
@@ -405,6 +678,24 @@ cdef class _AbstractReductionKernel:
                 optimize_context.set_params(key, opt_params)
             block_size, block_stride, out_block_num = opt_params
 
+        if db_params is not None:
+            items_per_thread = db_params[1]
+        else:
+            items_per_thread = _get_items_per_thread(
+                in_size, out_size, block_size, block_stride)
+        if _autotune_items_per_thread:
+            tune_key = (device_id, reduce_type,
+                        _get_reduce_size_bucket(in_size, out_size))
+            tuned = _tuned_items_per_thread.get(tune_key)
+            if tuned is None:
+                tuned = self._tune_items_per_thread(
+                    out_block_num, block_size, block_stride, in_args,
+                    out_args, in_shape, out_shape, type_map, map_expr,
+                    reduce_expr, post_map_expr, reduce_type, stream,
+                    n_splits)
+                _tuned_items_per_thread[tune_key] = tuned
+            items_per_thread = tuned
+
         # Launch the kernel
         self._launch(
             out_block_num,
@@ -414,10 +705,75 @@ cdef class _AbstractReductionKernel:
             in_shape, out_shape,
             type_map,
             map_expr, reduce_expr, post_map_expr, reduce_type,
-            stream, params)
+            stream, params, items_per_thread, n_splits)
 
         return ret
 
+    def _prepare_tuning(
+            self, in_args, out_args, in_shape, out_shape, contiguous_size,
+            type_map, map_expr, reduce_expr, post_map_expr, reduce_type):
+        # Returns the function tuning the block size and the items per
+        # thread in the background; see _tuning.maybe_tune.
+        in_args = [_optimizer_copy_arg(a) for a in in_args]
+        out_args = [_optimizer_copy_arg(a) for a in out_args]
+        in_size = internal.prod(in_shape)
+        out_size = internal.prod(out_shape)
+        candidates = [
+            (1 << block_size_log, items_per_thread)
+            for block_size_log in range(
+                _min_block_size_log, _max_block_size_log + 1)
+            for items_per_thread in _items_per_thread_candidates]
+
+        def tune(stream):
+            def launch(candidate):
+                block_size, items_per_thread = candidate
+                block_size, block_stride, out_block_num = _get_block_specs(
+                    in_size, out_size, contiguous_size, block_size)
+                n_splits = _get_n_splits(
+                    in_size, out_size, block_stride, out_block_num,
+                    device.get_device_id())
+                self._launch(
+                    out_block_num, block_size, block_stride, in_args,
+                    out_args, in_shape, out_shape, type_map, map_expr,
+                    reduce_expr, post_map_expr, reduce_type, stream,
+                    self._params, items_per_thread, n_splits)
+            return _tuning.pick_fastest(candidates, launch, stream)
+        return tune
+
+    def _tune_items_per_thread(
+            self, out_block_num, block_size, block_stride, in_args, out_args,
+            in_shape, out_shape, type_map, map_expr, reduce_expr,
+            post_map_expr, reduce_type, stream, n_splits=1, n_repeat=10):
+        # Times the kernel for each number of items per thread on copies of
+        # the arguments, and returns the fastest.
+        in_args = [_optimizer_copy_arg(a) for a in in_args]
+        out_args = [_optimizer_copy_arg(a) for a in out_args]
+        if stream is None:
+            stream = cupy.cuda.get_current_stream()
+        start = cupy.cuda.Event()
+        end = cupy.cuda.Event()
+        best = None
+        for items_per_thread in _items_per_thread_candidates:
+            # the first launch compiles and warms up the kernel
+            self._launch(
+                out_block_num, block_size, block_stride, in_args, out_args,
+                in_shape, out_shape, type_map, map_expr, reduce_expr,
+                post_map_expr, reduce_type, stream, self._params,
+                items_per_thread, n_splits)
+            start.record(stream)
+            for _ in range(n_repeat):
+                self._launch(
+                    out_block_num, block_size, block_stride, in_args,
+                    out_args, in_shape, out_shape, type_map, map_expr,
+                    reduce_expr, post_map_expr, reduce_type, stream,
+                    self._params, items_per_thread, n_splits)
+            end.record(stream)
+            end.synchronize()
+            elapsed = cupy.cuda.get_elapsed_time(start, end)
+            if best is None or elapsed < best[0]:
+                best = (elapsed, items_per_thread)
+        return best[1]
+
     def _get_optimized_params(
             self, optimize_config, in_args, out_args, in_shape, out_shape,
             type_map, map_expr, reduce_expr, post_map_expr, reduce_type,
@@ -436,10 +792,13 @@ cdef class _AbstractReductionKernel:
         default_block_stride_log = math.floor(math.log2(block_stride))
 
         def target_func(block_size, block_stride, out_block_num):
+            items_per_thread = _get_items_per_thread(
+                internal.prod(in_shape), out_size, block_size, block_stride)
             self._launch(
                 out_block_num, block_size, block_stride, in_args, out_args,
                 in_shape, out_shape, type_map, map_expr, reduce_expr,
-                post_map_expr, reduce_type, stream, self._params)
+                post_map_expr, reduce_type, stream, self._params,
+                items_per_thread)
 
         def suggest_func(trial):
             block_size_log = trial.suggest_int(
@@ -474,8 +833,10 @@ cdef class _AbstractReductionKernel:
             self, out_block_num, block_size, block_stride,
             in_args, out_args, in_shape, out_shape, type_map,
             map_expr, reduce_expr, post_map_expr, reduce_type,
-            stream, params):
+            stream, params, Py_ssize_t items_per_thread=1,
+            Py_ssize_t n_splits=1):
         cdef function.Function func
+        cdef bint split = n_splits > 1
 
         inout_args = (
             in_args
@@ -486,6 +847,11 @@ cdef class _AbstractReductionKernel:
                 # block_stride is passed as the last argument.
                 _scalar.CScalar.from_int32(block_stride),
             ])
+        if split:
+            # and the scratch memory after it, set below
+            params = params + _split_params
+            inout_args.append(_scalar.CScalar.from_numpy_scalar_with_dtype(
+                numpy.uint64(0), numpy.uint64))
 
         # Retrieve the kernel function
         func = self._get_function(
@@ -493,7 +859,24 @@ cdef class _AbstractReductionKernel:
             _get_arginfos(inout_args),
             type_map,
             map_expr, reduce_expr, post_map_expr, reduce_type,
-            block_size)
+            block_size, items_per_thread, split)
+
+        if split:
+            # one slot of the shared memory per thread is a partial result
+            partial_size = driver.funcGetAttribute(
+                driver.CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES,
+                func.ptr) // block_size
+            scratch_size = (
+                (out_block_num * 4 + 63) // 64 * 64
+                + out_block_num * n_splits * block_stride * partial_size)
+            if stream is None:
+                scratch = cupy.zeros(scratch_size, numpy.uint8)
+            else:
+                with stream:
+                    scratch = cupy.zeros(scratch_size, numpy.uint8)
+            inout_args[-1] = _scalar.CScalar.from_numpy_scalar_with_dtype(
+                numpy.uint64(scratch.data.ptr), numpy.uint64)
+            out_block_num *= n_splits
 
         # Launch the kernel
         func.linear_launch(
@@ -511,7 +894,7 @@ cdef class _AbstractReductionKernel:
             self,
             tuple params, tuple arginfos, _kernel._TypeMap type_map,
             str map_expr, str reduce_expr, str post_map_expr, str reduce_type,
-            Py_ssize_t block_size):
+            Py_ssize_t block_size, Py_ssize_t items_per_thread, bint split):
         raise NotImplementedError()
 
     @property
@@ -665,7 +1048,7 @@ cdef class _SimpleReductionKernel(_AbstractReductionKernel):
             self,
             tuple params, tuple arginfos, _kernel._TypeMap type_map,
             str map_expr, str reduce_expr, str post_map_expr, str reduce_type,
-            Py_ssize_t block_size):
+            Py_ssize_t block_size, Py_ssize_t items_per_thread, bint split):
 
         in_types = []
         for x in arginfos:
@@ -677,14 +1060,16 @@ cdef class _SimpleReductionKernel(_AbstractReductionKernel):
                 map_expr, reduce_expr, post_map_expr, reduce_type,
                 params, arginfos, type_map,
                 self.name, block_size, self.identity,
-                self._input_expr, self._output_expr, self.preamble, ())
+                self._input_expr, self._output_expr, self.preamble, (),
+                items_per_thread, split)
             self._cached_codes[in_types] = code
 
         return _SimpleReductionKernel_get_cached_function(
             map_expr, reduce_expr, post_map_expr, reduce_type,
             params, arginfos, type_map,
             self.name, block_size, self.identity,
-            self._input_expr, self._output_expr, self.preamble, ())
+            self._input_expr, self._output_expr, self.preamble, (),
+            items_per_thread, split)
 
 
 @_util.memoize()
@@ -692,11 +1077,12 @@ def _SimpleReductionKernel_get_cached_function_code(
         map_expr, reduce_expr, post_map_expr, reduce_type,
         params, arginfos, _kernel._TypeMap type_map,
         name, block_size, identity, input_expr, output_expr, preamble,
-        options):
+        options, items_per_thread, split):
     return _create_reduction_function_code(
         name, block_size, reduce_type, params, arginfos, identity,
         map_expr, reduce_expr, post_map_expr,
-        type_map, input_expr, output_expr, preamble, options)
+        type_map, input_expr, output_expr, preamble, options,
+        items_per_thread, split)
 
 
 @_util.memoize(for_each_device=True)
@@ -704,11 +1090,12 @@ def _SimpleReductionKernel_get_cached_function(
         map_expr, reduce_expr, post_map_expr, reduce_type,
         params, arginfos, _kernel._TypeMap type_map,
         name, block_size, identity, input_expr, output_expr, preamble,
-        options):
+        options, items_per_thread, split):
     return _create_reduction_function(
         name, block_size, reduce_type, params, arginfos, identity,
         map_expr, reduce_expr, post_map_expr,
-        type_map, input_expr, output_expr, preamble, options)
+        type_map, input_expr, output_expr, preamble, options,
+        items_per_thread, split)
 
 
 # -----------------------------------------------------------------------------
@@ -859,7 +1246,7 @@ cdef class ReductionKernel(_AbstractReductionKernel):
             self,
             tuple params, tuple arginfos, _kernel._TypeMap type_map,
             str map_expr, str reduce_expr, str post_map_expr, str reduce_type,
-            Py_ssize_t block_size):
+            Py_ssize_t block_size, Py_ssize_t items_per_thread, bint split):
 
         in_types = []
         for x in arginfos:
@@ -871,20 +1258,20 @@ cdef class ReductionKernel(_AbstractReductionKernel):
                 self.nin, self.nout, params, arginfos, type_map,
                 self.name, block_size, reduce_type, self.identity,
                 map_expr, reduce_expr, post_map_expr,
-                self.preamble, self.options)
+                self.preamble, self.options, items_per_thread, split)
             self._cached_codes[in_types] = code
         return _ReductionKernel_get_cached_function(
             self.nin, self.nout, params, arginfos, type_map,
             self.name, block_size, reduce_type, self.identity,
             map_expr, reduce_expr, post_map_expr,
-            self.preamble, self.options)
+            self.preamble, self.options, items_per_thread, split)
 
 
 @_util.memoize()
 def _ReductionKernel_get_cached_function_code(
         nin, nout, params, arginfos, _kernel._TypeMap type_map,
         name, block_size, reduce_type, identity, map_expr, reduce_expr,
-        post_map_expr, preamble, options):
+        post_map_expr, preamble, options, items_per_thread, split):
     cdef ParameterInfo p
     cdef _ArgInfo arginfo
     in_arrays = [
@@ -904,16 +1291,17 @@ def _ReductionKernel_get_cached_function_code(
     return _create_reduction_function_code(
         name, block_size, reduce_type, params, arginfos, identity,
         map_expr, reduce_expr, post_map_expr,
-        type_map, input_expr, output_expr, preamble, options)
+        type_map, input_expr, output_expr, preamble, options,
+        items_per_thread, split)
 
 
 @_util.memoize(for_each_device=True)
 def _ReductionKernel_get_cached_function(
         nin, nout, params, arginfos, _kernel._TypeMap type_map,
         name, block_size, reduce_type, identity, map_expr, reduce_expr,
-        post_map_expr, preamble, options):
+        post_map_expr, preamble, options, items_per_thread, split):
     code = _ReductionKernel_get_cached_function_code(
         nin, nout, params, arginfos, type_map,
         name, block_size, reduce_type, identity, map_expr, reduce_expr,
-        post_map_expr, preamble, options)
+        post_map_expr, preamble, options, items_per_thread, split)
     return _create_reduction_function_from_code(name, code, options)
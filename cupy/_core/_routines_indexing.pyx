@@ -7,13 +7,16 @@ import cupy
 import cupy._core.core as core
 from cupy.exceptions import AxisError
 from cupy._core._kernel import ElementwiseKernel, _get_warpsize
+from cupy._core._scalar import get_typename
 from cupy._core._ufuncs import elementwise_copy
+from cupy.cuda import cub
 
 from libcpp cimport vector
 
 from cupy._core._carray cimport shape_t
 from cupy._core._carray cimport strides_t
 from cupy._core cimport core
+from cupy._core cimport _accelerator
 from cupy._core cimport _routines_math as _math
 from cupy._core cimport _routines_manipulation as _manipulation
 from cupy._core.core cimport _ndarray_base
@@ -68,6 +71,12 @@ cpdef _ndarray_base _ndarray_argwhere(_ndarray_base self):
     cdef int ndim
     cdef _ndarray_base nonzero
     numpy_int64 = numpy.int64
+    if self.size > 0 and self._shape.size() >= 1:
+        for accelerator in _accelerator._routine_accelerators:
+            if accelerator == _accelerator.ACCELERATOR_CUB:
+                dst = _cub_argwhere(self)
+                if dst is not None:
+                    return dst
     if self.size == 0:
         count_nonzero = 0
     else:
@@ -116,6 +125,71 @@ cpdef _ndarray_base _ndarray_argwhere(_ndarray_base self):
     return dst
 
 
+cpdef tuple _ndarray_argwhere_bounded(
+        _ndarray_base self, _ndarray_base out=None, bint flat=False):
+    # _ndarray_argwhere (or flatnonzero if flat) without reading the count
+    # back. The output has a row for every item of self, and only the rows
+    # up to the count, which is returned as a 0-dim device array, are valid.
+    cdef Py_ssize_t n = self.size
+    cdef int ndim = self._shape.size()
+    cdef tuple shape = (n,) if flat else (n, ndim)
+    cdef _ndarray_base nonzero, scan_index, count, index
+
+    if out is None:
+        out = core.ndarray(shape, dtype=numpy.int64)
+    elif (out.dtype != numpy.int64 or not out._c_contiguous
+            or out.ndim != len(shape) or out._shape[0] < n
+            or out.shape[1:] != shape[1:]):
+        raise ValueError(
+            'out must be a C-contiguous int64 array of shape {} or with more '
+            'rows'.format(shape))
+    if n == 0:
+        count = core.ndarray((), dtype=numpy.int64)
+        count.fill(0)
+        return out, count
+
+    if flat or ndim == 1:
+        res = cub.cub_nonzero_bounded(self, out.ravel())
+        if res is not None:
+            return out, res[1]
+    else:
+        res = cub.cub_nonzero_bounded(self)
+        if res is not None:
+            index, count = res
+            _unravel_nonzero_bounded_kernel(index, self, count, out)
+            return out, count
+
+    if self.dtype == numpy.bool_:
+        nonzero = self.ravel()
+    else:
+        nonzero = cupy._core.not_equal(self, 0).ravel()
+    scan_index = _math.scan(
+        nonzero, op=_math.scan_op.SCAN_SUM, dtype=numpy.int64, out=None)
+    count = scan_index[-1]
+    if flat:
+        _flatnonzero_kernel(nonzero, scan_index, out)
+    else:
+        nonzero.shape = self.shape
+        scan_index.shape = self.shape
+        _nonzero_kernel(nonzero, scan_index, out)
+    return out, count
+
+
+cdef _cub_argwhere(_ndarray_base self):
+    # DeviceSelect gives the flat indices of the nonzero items in one pass,
+    # which are then unraveled in C order.
+    cdef _ndarray_base index, dst
+    index = cub.cub_nonzero(self)
+    if index is None:
+        return None
+    if self._shape.size() == 1:
+        return _manipulation._reshape(index, (index.size, 1))
+    dst = core.ndarray((index.size, self._shape.size()), dtype=numpy.int64)
+    if dst.size != 0:
+        _unravel_nonzero_kernel(index, self, dst)
+    return dst
+
+
 cdef _ndarray_base _ndarray_take(_ndarray_base self, indices, axis, out):
     cdef Py_ssize_t ndim = self._shape.size()
     if axis is None:
@@ -516,11 +590,48 @@ _nonzero_kernel = ElementwiseKernel(
     reduce_dims=False)
 
 
+_flatnonzero_kernel = ElementwiseKernel(
+    'T src, int64 index', 'raw int64 dst',
+    'if (src != 0) dst[index - 1] = i;',
+    'cupy_flatnonzero_kernel')
+
+
+# The flat indices past the count are left undefined by DeviceSelect.
+_unravel_nonzero_bounded_kernel = ElementwiseKernel(
+    'int64 index, raw T src, raw int64 count', 'raw int64 dst',
+    '''
+    if (i < count[0]) {
+        _index_t r = index;
+        for (int j = src.ndim - 1; j >= 0; j--) {
+            ptrdiff_t ind[] = {i, j};
+            _index_t d = src.shape()[j];
+            dst[ind] = r % d;
+            r /= d;
+        }
+    }''',
+    'cupy_unravel_nonzero_bounded_kernel',
+    reduce_dims=False)
+
+
+_unravel_nonzero_kernel = ElementwiseKernel(
+    'int64 index, raw T src', 'raw int64 dst',
+    '''
+    _index_t r = index;
+    for (int j = src.ndim - 1; j >= 0; j--) {
+        ptrdiff_t ind[] = {i, j};
+        _index_t d = src.shape()[j];
+        dst[ind] = r % d;
+        r /= d;
+    }''',
+    'cupy_unravel_nonzero_kernel',
+    reduce_dims=False)
+
+
 _take_kernel_core = '''
-ptrdiff_t out_i = indices % index_range;
+_index_t out_i = indices % index_range;
 if (out_i < 0) out_i += index_range;
-if (ldim != 1) out_i += (i / (cdim * rdim)) * index_range;
-if (rdim != 1) out_i = out_i * rdim + i % rdim;
+if (ldim != 1) out_i += ((_index_t)i / (cdim * rdim)) * index_range;
+if (rdim != 1) out_i = out_i * rdim + (_index_t)i % rdim;
 out = a[out_i];
 '''
 
@@ -537,6 +648,73 @@ _take_kernel_scalar = ElementwiseKernel(
     'T out', _take_kernel_core, 'cupy_take_scalar')
 
 
+# Gathers whole rows of a C-contiguous array: a group of 32 threads copies a
+# row with the widest vector type that the row size and the addresses are
+# aligned to, and the index is read once per row.
+_take_rows_code = '''
+extern "C" __global__ void cupy_take_rows(
+        const V* __restrict__ a, const S* __restrict__ indices,
+        V* __restrict__ out, long long n_indices, long long index_range,
+        long long row_size) {
+    const int lane = threadIdx.x % 32;
+    const long long n_groups = (long long)gridDim.x * blockDim.x / 32;
+    for (long long i = ((long long)blockIdx.x * blockDim.x + threadIdx.x)
+                       / 32;
+         i < n_indices; i += n_groups) {
+        long long k = (long long)indices[i] % index_range;
+        if (k < 0) k += index_range;
+        const V* src = a + k * row_size;
+        V* dst = out + i * row_size;
+        for (long long j = lane; j < row_size; j += 32) {
+            dst[j] = src[j];
+        }
+    }
+}
+'''
+
+_take_rows_vector_types = (
+    (16, 'uint4'), (8, 'uint2'), (4, 'unsigned int'),
+    (2, 'unsigned short'), (1, 'unsigned char'))
+
+# Rows narrower than this are left to the elementwise kernel.
+_take_rows_min_bytes = 128
+_take_rows_block_size = 256
+
+
+@cupy._util.memoize(for_each_device=True)
+def _get_take_rows_kernel(vector_type, index_dtype):
+    code = '#define V {}\n#define S {}\n'.format(
+        vector_type, get_typename(index_dtype)) + _take_rows_code
+    return cupy.RawKernel(code, 'cupy_take_rows')
+
+
+cdef bint _take_rows(
+        _ndarray_base a, _ndarray_base indices, _ndarray_base out) except *:
+    # Takes along the first axis of a C-contiguous array with wide rows,
+    # a row at a time. Returns False when the rows are too narrow.
+    cdef Py_ssize_t row_bytes, n_indices, width, n_blocks
+    if not a._c_contiguous or not out._c_contiguous:
+        return False
+    if indices.dtype.kind not in 'iu' or a.dtype.kind == 'V':
+        return False
+    row_bytes = a.nbytes // a._shape[0]
+    if row_bytes < _take_rows_min_bytes:
+        return False
+    for width, vector_type in _take_rows_vector_types:
+        if (row_bytes % width == 0 and a.data.ptr % width == 0
+                and out.data.ptr % width == 0):
+            break
+    indices = core._internal_ascontiguousarray(indices)
+    n_indices = indices.size
+    n_blocks = (n_indices * 32 + _take_rows_block_size - 1) // (
+        _take_rows_block_size)
+    kern = _get_take_rows_kernel(vector_type, indices.dtype)
+    kern((min(n_blocks, 0x7fffffff),), (_take_rows_block_size,),
+         (a, indices, out, numpy.int64(n_indices),
+          numpy.int64(a._shape[0]), numpy.int64(row_bytes // width)))
+    return True
+
+
 _choose_kernel = ElementwiseKernel(
     'S a, raw T choices, int32 n_channel',
     'T y',
@@ -608,8 +786,8 @@ cdef _create_scatter_kernel(name, code):
         string.Template('''
             S wrap_indices = indices % adim;
             if (wrap_indices < 0) wrap_indices += adim;
-            ptrdiff_t li = i / (rdim * cdim);
-            ptrdiff_t ri = i % rdim;
+            _index_t li = (_index_t)i / (rdim * cdim);
+            _index_t ri = (_index_t)i % rdim;
             T &out0 = a[(li * adim + wrap_indices) * rdim + ri];
             T &in0 = out0;
             const T &in1 = v;
@@ -619,11 +797,26 @@ cdef _create_scatter_kernel(name, code):
     )
 
 
+# the flat index into a updated by each item of v, for _scatter_reduce
+cdef _scatter_flat_index_kernel = ElementwiseKernel(
+    'S indices, int32 cdim, int32 rdim, int32 adim',
+    'int64 k',
+    '''
+        S wrap_indices = indices % adim;
+        if (wrap_indices < 0) wrap_indices += adim;
+        _index_t li = (_index_t)i / (rdim * cdim);
+        _index_t ri = (_index_t)i % rdim;
+        k = (li * adim + wrap_indices) * rdim + ri;
+    ''',
+    'cupy_scatter_flat_index',
+)
+
+
 cdef _scatter_update_kernel = _create_scatter_kernel(
     'cupy_scatter_update', 'out0 = in1')
 
 cdef _scatter_add_kernel = _create_scatter_kernel(
-    'cupy_scatter_add', 'atomicAdd(&out0, in1)')
+    'cupy_scatter_add', 'warpAggregatedAtomicAdd(&out0, in1)')
 
 cdef _scatter_sub_kernel = _create_scatter_kernel(
     'cupy_scatter_sub', 'atomicSub(&out0, in1)')
@@ -763,6 +956,12 @@ cpdef _ndarray_base _getitem_mask_single(
     cdef _ndarray_base mask_scanned
     cdef tuple masked_shape
 
+    if axis == 0 and a.size > 0 and a.shape == mask.shape:
+        for accelerator in _accelerator._routine_accelerators:
+            if accelerator == _accelerator.ACCELERATOR_CUB:
+                out = cub.cub_select_flagged(a, mask)
+                if out is not None:
+                    return out
     mask, mask_scanned, masked_shape = _prepare_mask_indexing_single(
         a, mask, axis)
     out = core.ndarray(masked_shape, dtype=a.dtype)
@@ -819,6 +1018,11 @@ cdef _ndarray_base _take(
     if a.size == 0 and out.size != 0:
         raise IndexError('cannot do a non-empty take from an empty axes.')
 
+    if (start == 0 and stop == 1 and ndim >= 2 and out.size != 0
+            and isinstance(indices, _ndarray_base)):
+        if _take_rows(a, indices, out):
+            return out
+
     if isinstance(indices, _ndarray_base):
         return _take_kernel(
             a.reduced_view(), indices, ldim, cdim, rdim, index_range, out)
@@ -879,6 +1083,15 @@ cdef _scatter_op_single(
             raise TypeError(
                 'cupy.add.at only supports int32, float16, float32, float64, '
                 'uint32, uint64, as data type')
+        if a._c_contiguous:
+            from cupy._core import _scatter_reduce
+            a_flat = a.ravel()
+            if _scatter_reduce.is_beneficial(a_flat, v.size):
+                flat_indices = _scatter_flat_index_kernel(
+                    indices, cdim, rdim, adim)
+                _scatter_reduce.scatter_add(
+                    a_flat, flat_indices.ravel(), v.ravel())
+                return
         _scatter_add_kernel(
             v, indices, cdim, rdim, adim, a.reduced_view())
     elif op == 'sub':
@@ -1,5 +1,6 @@
 import math
 import os
+import threading
 import warnings
 
 import cython
@@ -82,6 +83,24 @@ cpdef set_compute_type(dtype, compute_type):
         raise ValueError('Unknown compute type: {}'.format(compute_type))
 
 
+# The compute types of the current thread that take precedence over
+# compute_types, e.g. within cupyx.matmul_precision.
+cdef object _thread_local = threading.local()
+
+
+cpdef list _get_thread_compute_types():
+    return getattr(_thread_local, 'compute_types', None)
+
+
+cpdef _set_thread_compute_types(list types):
+    if types is not None:
+        for compute_type in types:
+            if compute_type not in compute_type_str:
+                raise ValueError(
+                    'Unknown compute type: {}'.format(compute_type))
+    _thread_local.compute_types = types
+
+
 cpdef compute_type_to_str(compute_type):
     if compute_type in compute_type_str:
         return compute_type_str[compute_type]
@@ -446,6 +465,10 @@ cdef _tensordot_core_mul_sum = ReductionKernel(
 cpdef get_compute_type(dtype):
     global compute_types
     cdef int index = to_compute_type_index(dtype)
+    cdef list thread_types = _get_thread_compute_types()
+    if (thread_types is not None
+            and thread_types[index] != COMPUTE_TYPE_TBD):
+        return thread_types[index]
     if compute_types[index] == COMPUTE_TYPE_TBD:
         compute_type = COMPUTE_TYPE_DEFAULT
         dtype_char = numpy.dtype(dtype).char
@@ -620,8 +643,8 @@ cpdef _ndarray_base tensordot_core(
         return out
 
     if (
-        not runtime._is_hip_environment and
-        compute_capability >= 50
+        (not runtime._is_hip_environment and compute_capability >= 50)
+        or _use_hip_fast_compute_type(dtype)
     ):
         tensordot_core_v11(transb, transa, m, n, k, b, ldb, a, lda, c, m)
         if copy_to_out is not None:
@@ -692,6 +715,42 @@ cpdef _ndarray_base tensordot_core(
     return out
 
 
+cdef int _to_cublas_compute_type(str dtype, int compute_type) except -1:
+    # The cuBLAS compute type of the GEMMs of dtype. The inputs of float32
+    # GEMMs are converted to TF32, FP16 or BF16 for the tensor cores (the
+    # matrix cores of ROCm) when asked, with float32 accumulation.
+    from cupy_backends.cuda.libs import cublas
+
+    if dtype in 'efF':
+        if compute_type == COMPUTE_TYPE_PEDANTIC:
+            return cublas.CUBLAS_COMPUTE_32F_PEDANTIC
+        if dtype in 'fF':
+            if compute_type == COMPUTE_TYPE_TF32:
+                return cublas.CUBLAS_COMPUTE_32F_FAST_TF32
+            elif compute_type == COMPUTE_TYPE_FP16:
+                return cublas.CUBLAS_COMPUTE_32F_FAST_16F
+            elif compute_type == COMPUTE_TYPE_BF16:
+                return cublas.CUBLAS_COMPUTE_32F_FAST_16BF
+        return cublas.CUBLAS_COMPUTE_32F
+    elif dtype in 'dD':
+        if compute_type == COMPUTE_TYPE_PEDANTIC:
+            return cublas.CUBLAS_COMPUTE_64F_PEDANTIC
+        return cublas.CUBLAS_COMPUTE_64F
+    raise ValueError('Invalid dtype: {}'.format(dtype))
+
+
+cdef bint _use_hip_fast_compute_type(str dtype) except -1:
+    # hipBLAS takes the compute types of cuBLAS since ROCm 6.0. They are only
+    # used for the reduced precisions asked for float32, as the other GEMMs
+    # of ROCm keep the legacy API.
+    if not runtime._is_hip_environment or dtype not in 'fF':
+        return False
+    if get_compute_type(dtype) not in (
+            COMPUTE_TYPE_FP16, COMPUTE_TYPE_BF16, COMPUTE_TYPE_TF32):
+        return False
+    return runtime.runtimeGetVersion() >= 60000000
+
+
 cpdef _ndarray_base tensordot_core_v11(
         Py_ssize_t transa, Py_ssize_t transb, Py_ssize_t m, Py_ssize_t n,
         Py_ssize_t k, _ndarray_base a, Py_ssize_t lda, _ndarray_base b,
@@ -705,22 +764,8 @@ cpdef _ndarray_base tensordot_core_v11(
     cdef size_t one_ptr, zero_ptr
 
     cdef int compute_capability = int(device.get_compute_capability())
-    cdef int compute_type = get_compute_type(c.dtype)
-    cdef int cublas_compute_type = -1
-    if c.dtype.char in 'efF':
-        if compute_type == COMPUTE_TYPE_PEDANTIC:
-            cublas_compute_type = cublas.CUBLAS_COMPUTE_32F_PEDANTIC
-        elif compute_type == COMPUTE_TYPE_TF32 and c.dtype.char in 'fF':
-            cublas_compute_type = cublas.CUBLAS_COMPUTE_32F_FAST_TF32
-        else:
-            cublas_compute_type = cublas.CUBLAS_COMPUTE_32F
-    elif c.dtype.char in 'dD':
-        if compute_type == COMPUTE_TYPE_PEDANTIC:
-            cublas_compute_type = cublas.CUBLAS_COMPUTE_64F_PEDANTIC
-        else:
-            cublas_compute_type = cublas.CUBLAS_COMPUTE_64F
-    else:
-        raise ValueError('Invalid dtype: {}'.format(c.dtype))
+    cdef int cublas_compute_type = _to_cublas_compute_type(
+        c.dtype.char, get_compute_type(c.dtype))
 
     cdef int algo = cublas.CUBLAS_GEMM_DEFAULT
     if ((compute_capability >= 80) or
@@ -992,6 +1037,14 @@ cpdef _ndarray_base matmul(
     cdef int cuda_dtype = to_cuda_dtype(dtype)
     cdef int algo = cublas.CUBLAS_GEMM_DEFAULT
 
+    cdef int compute_type = cuda_dtype
+    cdef int requested = get_compute_type(dtype)
+    if dtype.char in 'fF' and requested in (
+            COMPUTE_TYPE_FP16, COMPUTE_TYPE_BF16, COMPUTE_TYPE_TF32) and (
+            not runtime._is_hip_environment
+            or _use_hip_fast_compute_type(dtype.char)):
+        compute_type = _to_cublas_compute_type(dtype.char, requested)
+
     one = numpy.array(1, dtype=dtype)
     zero = numpy.array(0, dtype=dtype)
     if not use_broadcast:
@@ -1008,7 +1061,7 @@ cpdef _ndarray_base matmul(
                 b.data.ptr, cuda_dtype, ldb, strideB,
                 zero.ctypes.data,
                 c_view.data.ptr, cuda_dtype, ldc, strideC,
-                batchCount, cuda_dtype, algo)
+                batchCount, compute_type, algo)
         else:
             raise TypeError(dtype, a.dtype, b.dtype)
     else:
@@ -3,6 +3,7 @@ import functools
 
 import numpy
 
+import cupy
 from cupy._core._kernel import ElementwiseKernel
 from cupy._core._ufuncs import elementwise_copy
 import cupy._core.core as core
@@ -808,6 +809,9 @@ cdef _ndarray_base _concatenate_single_kernel(
 
     assert out is not None
 
+    if out._c_contiguous and _concatenate_tiled(arrays, axis, shape, out):
+        return out
+
     ptrs = numpy.ndarray(len(arrays), numpy.int64)
     for i, a in enumerate(arrays):
         _check_peer_access(a, device_id)
@@ -825,15 +829,137 @@ cdef _ndarray_base _concatenate_single_kernel(
     cum = 0
     for i, a in enumerate(arrays):
         for j in range(ndim):
-            x_strides[i, j] = <int>a._strides[j]
+            x_strides[i, j] = a._strides[j]
         cum_sizes[i] = cum
-        cum += <int>a._shape[axis]
+        cum += a._shape[axis]
 
     _concatenate_kernel(
         x, axis, core.array(cum_sizes), core.array(x_strides), out)
     return out
 
 
+# Each input is split into tiles of _concatenate_tile items, and a block
+# copies one tile. The descriptor table holds the shape of the output, then
+# a row per input: its pointer, its first tile, its offset and length along
+# the axis, whether it is C-contiguous, and its strides. A block finds its
+# input by a binary search over the first tiles, once for all its items.
+_concatenate_tiled_code = '''
+extern "C" __global__ void cupy_concatenate_tiled(
+        const long long* __restrict__ table, const int n_arrays,
+        const int ndim, const int axis, T* __restrict__ out) {
+    const long long* out_shape = table;
+    const int width = 5 + ndim;
+    const long long* rows = table + ndim;
+    const long long tile = blockIdx.x;
+    int lo = 0;
+    int hi = n_arrays;
+    while (hi - lo > 1) {
+        const int mid = (lo + hi) / 2;
+        if (rows[mid * width + 1] <= tile) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    const long long* d = rows + (long long)lo * width;
+    const char* src = reinterpret_cast<const char*>(d[0]);
+    const long long axis_offset = d[2];
+    const long long axis_len = d[3];
+    const bool contiguous = d[4];
+    const long long* strides = d + 5;
+
+    long long inner = 1;
+    for (int j = axis + 1; j < ndim; j++) {
+        inner *= out_shape[j];
+    }
+    long long outer = 1;
+    for (int j = 0; j < axis; j++) {
+        outer *= out_shape[j];
+    }
+    const long long slab = axis_len * inner;
+    const long long out_slab = out_shape[axis] * inner;
+    const long long begin = (tile - d[1]) * TILE;
+    const long long end = min(begin + TILE, outer * slab);
+    for (long long e = begin + threadIdx.x; e < end; e += blockDim.x) {
+        const long long o = e / slab;
+        const char* p = src;
+        if (contiguous) {
+            p += e * sizeof(T);
+        } else {
+            long long r = e;
+            for (int j = ndim - 1; j >= 0; j--) {
+                const long long dim = (j == axis) ? axis_len : out_shape[j];
+                p += r % dim * strides[j];
+                r /= dim;
+            }
+        }
+        out[o * out_slab + axis_offset * inner + (e - o * slab)] =
+            *reinterpret_cast<const T*>(p);
+    }
+}
+'''
+
+# Items are moved as is. The 16-byte type only needs an 8-byte alignment.
+_concatenate_tiled_types = {
+    1: 'unsigned char', 2: 'unsigned short', 4: 'unsigned int',
+    8: 'unsigned long long', 16: 'cupy_concatenate_16'}
+_concatenate_tile = 1024
+_concatenate_block_size = 256
+
+
+@cupy._util.memoize(for_each_device=True)
+def _get_concatenate_tiled_kernel(itemsize):
+    code = (
+        'struct cupy_concatenate_16 {{ unsigned long long v[2]; }};\n'
+        '#define T {}\n#define TILE {}\n'.format(
+            _concatenate_tiled_types[itemsize], _concatenate_tile))
+    return cupy.RawKernel(code + _concatenate_tiled_code,
+                          'cupy_concatenate_tiled')
+
+
+cdef bint _concatenate_tiled(
+        list arrays, Py_ssize_t axis, tuple shape, _ndarray_base out) except *:
+    # Copies the arrays of the dtype of out into the C-contiguous out with a
+    # single launch, and a single upload of the descriptor table. Returns
+    # False if the layout is not handled.
+    cdef _ndarray_base a
+    cdef Py_ssize_t i, j, row, width, ndim, n_tiles, cum
+    cdef Py_ssize_t[:] table
+    cdef int device_id = device.get_device_id()
+    cdef Py_ssize_t itemsize = out.dtype.itemsize
+
+    if itemsize not in _concatenate_tiled_types:
+        return False
+    ndim = len(shape)
+    width = 5 + ndim
+    table = numpy.empty(ndim + len(arrays) * width, numpy.int64)
+    for j in range(ndim):
+        table[j] = shape[j]
+    n_tiles = 0
+    cum = 0
+    for i, a in enumerate(arrays):
+        _check_peer_access(a, device_id)
+        row = ndim + i * width
+        table[row] = a.data.ptr
+        table[row + 1] = n_tiles
+        table[row + 2] = cum
+        table[row + 3] = a._shape[axis]
+        table[row + 4] = a._c_contiguous
+        for j in range(ndim):
+            table[row + 5 + j] = a._strides[j]
+        n_tiles += (a.size + _concatenate_tile - 1) // _concatenate_tile
+        cum += a._shape[axis]
+    if n_tiles > 0x7fffffff:
+        return False
+    if n_tiles == 0:
+        return True
+    kern = _get_concatenate_tiled_kernel(itemsize)
+    kern((n_tiles,), (_concatenate_block_size,),
+         (core.array(table), numpy.int32(len(arrays)), numpy.int32(ndim),
+          numpy.int32(axis), out))
+    return True
+
+
 cdef _concatenate_kernel_same_size = ElementwiseKernel(
     'raw P x, int64 base',
     'T y',
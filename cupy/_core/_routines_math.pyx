@@ -709,16 +709,16 @@ cpdef scan_core(
         else:
             result = a.astype(out.dtype, order='C')
 
+    if op == scan_op.SCAN_SUM:
+        cub_op = cub.CUPY_CUB_CUMSUM
+    else:
+        cub_op = cub.CUPY_CUB_CUMPROD
     if axis is None:
         for accelerator in _accelerator._routine_accelerators:
             if accelerator == _accelerator.ACCELERATOR_CUB:
                 if result is None:
                     result = a.astype(dtype, order='C').ravel()
                 # result will be None if the scan is not compatible with CUB
-                if op == scan_op.SCAN_SUM:
-                    cub_op = cub.CUPY_CUB_CUMSUM
-                else:
-                    cub_op = cub.CUPY_CUB_CUMPROD
                 res = cub.cub_scan(result, cub_op)
                 if res is not None:
                     break
@@ -731,7 +731,18 @@ cpdef scan_core(
         if result is None:
             result = a.astype(dtype, order='C')
         axis = internal._normalize_axis_index(axis, a.ndim)
-        result = _proc_as_batch(result, axis, op)
+        res = None
+        if axis == a.ndim - 1 and result.flags.c_contiguous:
+            for accelerator in _accelerator._routine_accelerators:
+                if accelerator == _accelerator.ACCELERATOR_CUB:
+                    # scan all the rows at once, each row being a segment;
+                    # res will be None if the scan is not compatible with CUB
+                    res = cub.cub_scan_by_key(
+                        result.ravel(), cub_op, None, result.shape[axis])
+                    if res is not None:
+                        break
+        if res is None:
+            result = _proc_as_batch(result, axis, op)
     # This is for when the original out param was not contiguous
     if out is not None and out.data != result.data:
         elementwise_copy(result.reshape(out.shape), out)
@@ -746,6 +757,13 @@ def _scan_for_test(a, out=None):
 
 
 cpdef _ndarray_base _nansum(_ndarray_base a, axis, dtype, out, keepdims):
+    for accelerator in _accelerator._routine_accelerators:
+        if accelerator == _accelerator.ACCELERATOR_CUB:
+            # result will be None if the reduction is not compatible with CUB
+            result = cub.cub_nan_reduction(
+                a, cub.CUPY_CUB_NANSUM, axis, dtype, out, keepdims)
+            if result is not None:
+                return result
     if cupy.iscomplexobj(a):
         return _nansum_complex_dtype(a, axis, dtype, out, keepdims)
     elif dtype is None:
@@ -859,7 +877,8 @@ _nanprod_complex_dtype = create_reduction_func(
      'a * b', 'out0 = type_out0_raw(a)', None), 1)
 
 cdef create_arithmetic(
-        name, op, boolop, doc, cutensor_op=None, scatter_op=None):
+        name, op, boolop, doc, cutensor_op=None, scatter_op=None,
+        half2=False):
     # boolop is either
     #  - str (the operator for bool-bool inputs) or
     #  - callable (a function to raise an error for bool-bool inputs).
@@ -875,7 +894,8 @@ cdef create_arithmetic(
         'out0 = in0 %s in1' % op,
         doc=doc,
         cutensor_op=cutensor_op,
-        scatter_op=scatter_op)
+        scatter_op=scatter_op,
+        half2=half2)
 
 
 _add = create_arithmetic(
@@ -885,7 +905,7 @@ _add = create_arithmetic(
     .. seealso:: :data:`numpy.add`
 
     ''',
-    cutensor_op=('OP_ADD', 1, 1), scatter_op='add')
+    cutensor_op=('OP_ADD', 1, 1), scatter_op='add', half2=True)
 
 
 _conjugate = create_ufunc(
@@ -943,7 +963,8 @@ _positive = create_ufunc(
 
     .. seealso:: :data:`numpy.positive`
 
-    ''')
+    ''',
+    half2=True)
 
 
 def _negative_boolean_error():
@@ -962,7 +983,8 @@ _negative = create_ufunc(
 
     .. seealso:: :data:`numpy.negative`
 
-    ''')
+    ''',
+    half2=True)
 
 
 _multiply = create_arithmetic(
@@ -972,7 +994,7 @@ _multiply = create_arithmetic(
     .. seealso:: :data:`numpy.multiply`
 
     ''',
-    cutensor_op=('OP_MUL', 1, 1))
+    cutensor_op=('OP_MUL', 1, 1), half2=True)
 
 
 # `integral_power` should return somewhat appropriate values for negative
@@ -1033,7 +1055,7 @@ _subtract = create_arithmetic(
     .. seealso:: :data:`numpy.subtract`
 
     ''',
-    cutensor_op=('OP_ADD', 1, -1), scatter_op='sub')
+    cutensor_op=('OP_ADD', 1, -1), scatter_op='sub', half2=True)
 
 
 # NB: Cannot define loops with short ints in the NEP 50 world. Consider
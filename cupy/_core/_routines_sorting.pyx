@@ -8,7 +8,6 @@ from cupy._core._scalar import get_typename as _get_typename
 from cupy._core._ufuncs import elementwise_copy
 import cupy._core.core as core
 from cupy import _util
-from cupy.cuda import thrust
 
 from cupy._core cimport _routines_manipulation as _manipulation
 from cupy._core.core cimport compile_with_cache
@@ -24,6 +23,7 @@ cdef _ndarray_sort(_ndarray_base self, int axis):
         raise RuntimeError('Thrust is needed to use cupy.sort. Please '
                            'install CUDA Toolkit with Thrust then '
                            'reinstall CuPy after uninstalling it.')
+    from cupy.cuda import thrust
 
     if ndim == 0:
         raise AxisError('Sorting arrays with the rank of zero is not '
@@ -72,6 +72,7 @@ cdef _ndarray_base _ndarray_argsort(_ndarray_base self, axis):
         raise RuntimeError('Thrust is needed to use cupy.argsort. Please '
                            'install CUDA Toolkit with Thrust then '
                            'reinstall CuPy after uninstalling it.')
+    from cupy.cuda import thrust
 
     self = cupy.atleast_1d(self)
     ndim = self._shape.size()
@@ -125,8 +126,8 @@ cdef _ndarray_partition(_ndarray_base self, kth, int axis):
     """
 
     cdef int ndim = self._shape.size()
-    cdef Py_ssize_t k, max_k, length, s, sz, t
-    cdef _ndarray_base data
+    cdef Py_ssize_t k, max_k, kth_max, length, s, sz, t
+    cdef _ndarray_base data, values, indices
 
     if ndim == 0:
         raise AxisError('Sorting arrays with the rank of zero is not '
@@ -155,6 +156,8 @@ cdef _ndarray_partition(_ndarray_base self, kth, int axis):
         if max_k < k:
             max_k = k
 
+    kth_max = max_k
+
     # For simplicity, max_k is round up to the power of 2. If max_k is
     # already the power of 2, it is round up to the next power of 2 because
     # we need to collect the first max(kth)+1 elements.
@@ -171,8 +174,18 @@ cdef _ndarray_partition(_ndarray_base self, kth, int axis):
 
     # If the array size is small or k is large, we simply sort the array.
     if length < 32 or sz <= 32 or max_k >= 1024:
-        # kth is ignored.
-        data.sort(axis=-1)
+        if _use_topk(data, length, kth_max + 1):
+            # Radix-select the head and sort only that
+            values = core.ndarray(data.shape, data.dtype)
+            indices = core.ndarray(data.shape, numpy.intp)
+            from cupy.cuda import thrust
+            thrust.topk(self.dtype, data.data.ptr, values.data.ptr,
+                        indices.data.ptr, data.size // length, length,
+                        kth_max + 1, False, True)
+            elementwise_copy(values, data)
+        else:
+            # kth is ignored.
+            data.sort(axis=-1)
     else:
         shape = data.shape
         data = data.ravel()
@@ -220,8 +233,8 @@ cdef _ndarray_base _ndarray_argpartition(self, kth, axis):
 
     """
     cdef int _axis, ndim
-    cdef Py_ssize_t k, max_k, length, s, sz, t
-    cdef _ndarray_base data
+    cdef Py_ssize_t k, max_k, kth_max, length, s, sz, t
+    cdef _ndarray_base data, values
     if axis is None:
         data = self.ravel()
         _axis = -1
@@ -251,6 +264,8 @@ cdef _ndarray_base _ndarray_argpartition(self, kth, axis):
         if max_k < k:
             max_k = k
 
+    kth_max = max_k
+
     # For simplicity, max_k is round up to the power of 2. If max_k is
     # already the power of 2, it is round up to the next power of 2 because
     # we need to collect the first max(kth)+1 elements.
@@ -268,8 +283,18 @@ cdef _ndarray_base _ndarray_argpartition(self, kth, axis):
 
     # If the array size is small or k is large, we simply sort the array.
     if length < 32 or sz < 1 or max_k >= 1024:
-        # kth is ignored.
-        indices = data.argsort(axis=-1)
+        if _use_topk(data, length, kth_max + 1):
+            # Radix-select the head and sort only that
+            data = data.copy() if not data._c_contiguous else data
+            values = core.ndarray(shape, data.dtype)
+            indices = core.ndarray(shape, numpy.intp)
+            from cupy.cuda import thrust
+            thrust.topk(self.dtype, data.data.ptr, values.data.ptr,
+                        indices.data.ptr, data.size // length, length,
+                        kth_max + 1, False, True)
+        else:
+            # kth is ignored.
+            indices = data.argsort(axis=-1)
     else:
         data = data.ravel()
         indices = cupy.arange(0, data.shape[0], dtype=cupy.int64)
@@ -301,6 +326,12 @@ cdef _ndarray_base _ndarray_argpartition(self, kth, axis):
     return indices
 
 
+cdef bint _use_topk(_ndarray_base data, Py_ssize_t length, Py_ssize_t k):
+    # Radix select only pays off if a small head of long rows is needed
+    return (data.dtype.char in 'bhilqBHILQfd' and length >= 1024
+            and k * 4 <= length and data.size <= 0x7fffffff)
+
+
 @_util.memoize(for_each_device=True)
 def _partition_kernel(dtype):
     name = 'partition_kernel'
@@ -1,7 +1,6 @@
 from cpython cimport sequence
 
 import numpy
-from numpy import nan
 
 import cupy
 from cupy.exceptions import AxisError
@@ -389,6 +388,17 @@ cdef _exists_nan = ReductionKernel(
     'T x', 'bool y', 'isnan(x)', 'a || b', 'y = a', 'false', '_exists_nan')
 
 
+cdef object _selection = None
+
+
+cdef object _get_selection():
+    global _selection
+    if _selection is None:
+        from cupy._core import _selection as module
+        _selection = module
+    return _selection
+
+
 cpdef _ndarray_base _median(
         _ndarray_base a, axis, out, overwrite_input, keepdims):
 
@@ -415,6 +425,22 @@ cpdef _ndarray_base _median(
         if axis < -keep_ndim or axis >= keep_ndim:
             raise AxisError('Axis overrun')
         sz = a.shape[axis]
+
+    rows = a.reshape(1, -1) if axis is None else cupy.moveaxis(a, axis, -1)
+    if _get_selection().available(rows):
+        # the two middle items are searched for instead of partitioning
+        ret = _selection.median(rows)
+        if axis is None:
+            ret = ret.reshape((1,) * keep_ndim if keepdims else ())
+        elif keepdims and out_shape is None:
+            ret = cupy.expand_dims(ret, axis)
+        if out_shape is not None:
+            ret = ret.reshape(out_shape)
+        if out is None:
+            return ret
+        elementwise_copy(ret, out)
+        return out
+
     if sz % 2 == 0:
         szh = sz // 2
         kth = [szh - 1, szh]
@@ -487,15 +513,19 @@ cpdef _ndarray_base _nanmedian(
     a = a.reshape(out_shape + [-1, ])
     a = cupy.ascontiguousarray(a)
 
-    n_reduce = numpy.prod(reduce_shape)
-    n_reduce_each = cupy.full(out_shape, n_reduce, dtype='int32')
-    if a_data_ptr == a.data.ptr and overwrite_input is False:
-        a = a.copy()
-    _replace_nan_kernel(n_reduce, numpy.finfo(a.dtype).max, a, n_reduce_each)
-    a = cupy.sort(a, axis=-1)
+    if _get_selection().available(a):
+        b = _selection.median(a, nan_aware=True)
+    else:
+        n_reduce = numpy.prod(reduce_shape)
+        n_reduce_each = cupy.full(out_shape, n_reduce, dtype='int32')
+        if a_data_ptr == a.data.ptr and overwrite_input is False:
+            a = a.copy()
+        _replace_nan_kernel(
+            n_reduce, numpy.finfo(a.dtype).max, a, n_reduce_each)
+        a = cupy.sort(a, axis=-1)
 
-    b = cupy.full(out_shape, cupy.nan, dtype=a.dtype)
-    _pickup_median_kernel(n_reduce, n_reduce_each, a, b)
+        b = cupy.full(out_shape, cupy.nan, dtype=a.dtype)
+        _pickup_median_kernel(n_reduce, n_reduce_each, a, b)
 
     if keepdims:
         b = b.reshape(out_shape + [1, ] * len(reduce_axis))
@@ -550,48 +580,34 @@ cdef _ndarray_base _mean(
 cdef _ndarray_base _var(
         _ndarray_base a, axis=None, dtype=None, out=None, ddof=0,
         keepdims=False):
-
-    if axis is None:
-        axis = tuple(range(a.ndim))
-    if not isinstance(axis, tuple):
-        axis = (axis,)
-
-    dtype_mean = a.dtype
-    dtype_out = numpy.dtype(dtype)
     if dtype is None:
         if a.dtype.kind in 'biu':
-            dtype_mean = 'float64'
-            dtype_out = 'float64'
+            dtype_out = numpy.dtype('float64')
         else:
-            dtype_mean = a.dtype
-            dtype_out = a.dtype
-            if a.dtype.kind == 'c':
-                dtype_out = numpy.dtype(a.dtype.char.lower())
-
-    shape = a.shape
-    cdef Py_ssize_t items = 1
-    for ax in axis:
-        items *= shape[ax]
-
-    # Make alpha NaN when array is empty, mimics NumPy behavior, resulting in
-    # NaN. See https://github.com/numpy/numpy/issues/13582 for an explanation
-    # on why NaN is the result.
-    div = max(items - ddof, 0)
-    alpha = 1. / div if div != 0 else nan
-
-    arrmean = a.mean(axis=axis, dtype=dtype_mean, out=None, keepdims=True)
-
-    if out is None:
-        if dtype_out == 'float16':
-            var_core = _var_core_float16
-        elif dtype_out == 'float32':
-            var_core = _var_core_float32
+            dtype_out = numpy.dtype(a.dtype.char.lower())
+    else:
+        dtype_out = numpy.dtype(dtype)
+        if dtype_out.kind in 'fc':
+            dtype_out = numpy.dtype(dtype_out.char.lower())
         else:
-            var_core = _var_core_float64
-        return var_core(a, arrmean, alpha, axis=axis, keepdims=keepdims)
-
-    out = _var_core_out(a, arrmean, alpha, out, axis=axis, keepdims=keepdims)
-    return out.astype(dtype_out, copy=False)
+            dtype_out = numpy.dtype('float64')
+
+    # The variance is accumulated in the precision of the output, which must
+    # be a real floating point array. An empty slice, or one with no more
+    # items than ddof, results in NaN; see also
+    # https://github.com/numpy/numpy/issues/13582.
+    if out is not None and out.dtype.kind == 'f':
+        _var_core(a, ddof, out, axis=axis, keepdims=keepdims)
+        return out
+    reduce_axis, out_axis = _reduction._get_axis(axis, a.ndim)
+    ret = cupy.empty(
+        _reduction._get_out_shape(a.shape, reduce_axis, out_axis, keepdims),
+        dtype_out)
+    _var_core(a, ddof, ret, axis=axis, keepdims=keepdims)
+    if out is None:
+        return ret
+    elementwise_copy(ret, out)
+    return out
 
 
 cdef _ndarray_base _std(
@@ -602,39 +618,78 @@ cdef _ndarray_base _std(
     return _math._sqrt(ret, dtype=dtype, out=out)
 
 
-cdef _norm_preamble = '''
-template <typename T> __device__ T my_norm(T x) { return x * x; }
-__device__ float my_norm(const complex<float>& x) { return norm(x); }
-__device__ double my_norm(const complex<double>& x) { return norm(x); }
-'''
-
-
-cdef _var_core_float16 = ReductionKernel(
-    'S x, T mean, float32 alpha', 'float16 out',
-    'my_norm(x - mean)',
-    'a + b', 'out = alpha * a', '0', 'cupy_var_core_float16',
-    preamble=_norm_preamble)
+cdef _var_preamble = '''
+template <typename U> struct var_real { typedef U type; };
+template <> struct var_real<float16> { typedef float type; };
+template <typename T> struct var_real<complex<T> > { typedef T type; };
 
+template <typename S, typename R> struct var_value { typedef R type; };
+template <typename T, typename R> struct var_value<complex<T>, R> {
+    typedef complex<R> type;
+};
 
-cdef _var_core_float32 = ReductionKernel(
-    'S x, T mean, float32 alpha', 'float32 out',
-    'my_norm(x - mean)',
-    'a + b', 'out = alpha * a', '0', 'cupy_var_core_float32',
-    preamble=_norm_preamble)
-
+template <typename T> __device__ bool var_isnan(const T& x) { return false; }
+__device__ bool var_isnan(float16 x) { return isnan(x); }
+__device__ bool var_isnan(float x) { return isnan(x); }
+__device__ bool var_isnan(double x) { return isnan(x); }
+template <typename T>
+__device__ bool var_isnan(const complex<T>& x) { return isnan(x); }
+
+__device__ float var_norm(float x) { return x * x; }
+__device__ double var_norm(double x) { return x * x; }
+__device__ float var_norm(const complex<float>& x) { return norm(x); }
+__device__ double var_norm(const complex<double>& x) { return norm(x); }
+
+// The count of the items, their mean and the sum of the squared deviations
+// from it, accumulated in the precision of the output U. The partial states
+// are merged as by Chan et al., so that the input is read once. With
+// SKIP_NAN, the items that are NaN are not counted.
+template <typename S, typename U, bool SKIP_NAN>
+struct var_st {
+    typedef typename var_real<U>::type R;
+    typedef typename var_value<S, R>::type A;
+    long long count;
+    A mean;
+    R m2;
+    __device__ var_st() : count(0), mean(0), m2(0) { }
+    __device__ var_st(S x) : m2(0) {
+        const bool skip = SKIP_NAN && var_isnan(x);
+        count = skip ? 0 : 1;
+        mean = skip ? A(0) : A(x);
+    }
+    __device__ R variance(long long ddof) const {
+        const long long dof = count - ddof;
+        return dof > 0 ? m2 / R(dof) : R(nan(""));
+    }
+};
 
-cdef _var_core_float64 = ReductionKernel(
-    'S x, T mean, float64 alpha', 'float64 out',
-    'my_norm(x - mean)',
-    'a + b', 'out = alpha * a', '0', 'cupy_var_core_float64',
-    preamble=_norm_preamble)
+template <typename S, typename U, bool SKIP_NAN>
+__device__ var_st<S, U, SKIP_NAN> var_merge(
+        const var_st<S, U, SKIP_NAN>& a, const var_st<S, U, SKIP_NAN>& b) {
+    typedef typename var_st<S, U, SKIP_NAN>::A A;
+    typedef typename var_st<S, U, SKIP_NAN>::R R;
+    if (a.count == 0) {
+        return b;
+    }
+    if (b.count == 0) {
+        return a;
+    }
+    var_st<S, U, SKIP_NAN> r;
+    r.count = a.count + b.count;
+    const A delta = b.mean - a.mean;
+    const R wb = R(b.count) / R(r.count);
+    r.mean = a.mean + delta * wb;
+    r.m2 = a.m2 + b.m2 + var_norm(delta) * R(a.count) * wb;
+    return r;
+}
+'''
 
 
-cdef _var_core_out = ReductionKernel(
-    'S x, T mean, U alpha', 'U out',
-    'my_norm(x - mean)',
-    'a + b', 'out = alpha * a', '0', 'cupy_var_core_out',
-    preamble=_norm_preamble)
+cdef _var_core = ReductionKernel(
+    'S x, int64 ddof', 'U out',
+    'x', 'var_merge(a, b)', 'out = a.variance(ddof)',
+    'var_st<S, U, false>()', 'cupy_var',
+    reduce_type='var_st<S, U, false>', preamble=_var_preamble)
 
 
 # TODO(okuta) needs cast
@@ -684,13 +739,14 @@ cdef _nanmean_func = create_reduction_func(
     None, _nanmean_preamble)
 
 
-_count_non_nan = create_reduction_func(
-    'cupy_count_non_nan',
-    ('e->q', 'f->q', 'd->q', 'F->q', 'D->q'),
-    ('isnan(in0) ? 0 : 1', 'a + b', 'out0 = a', None), 0)
-
-
 cpdef _ndarray_base _nanmean(_ndarray_base a, axis, dtype, out, keepdims):
+    for accelerator in _accelerator._routine_accelerators:
+        if accelerator == _accelerator.ACCELERATOR_CUB:
+            # result will be None if the reduction is not compatible with CUB
+            result = cub.cub_nan_reduction(
+                a, cub.CUPY_CUB_NANMEAN, axis, dtype, out, keepdims)
+            if result is not None:
+                return result
     return _nanmean_func(a, axis=axis, dtype=dtype, out=out, keepdims=keepdims)
 
 
@@ -700,62 +756,30 @@ cpdef _ndarray_base _nanstd(_ndarray_base a, axis, dtype, out, ddof, keepdims):
 
 
 cpdef _ndarray_base _nanvar(_ndarray_base a, axis, dtype, out, ddof, keepdims):
-
-    _count = _count_non_nan(a, axis=axis, keepdims=True)
-    arrsum = _math._nansum(a, axis=axis, dtype=dtype, out=None, keepdims=True)
+    for accelerator in _accelerator._routine_accelerators:
+        if accelerator == _accelerator.ACCELERATOR_CUB:
+            # result will be None if the reduction is not compatible with CUB
+            result = cub.cub_nan_reduction(
+                a, cub.CUPY_CUB_NANVAR, axis, dtype, out, keepdims, ddof)
+            if result is not None:
+                return result
 
     if out is None:
-        if a.dtype == cupy.complex64 or dtype == cupy.complex64:
-            nanvar_core = _nanvar_core_complex64
-        elif a.dtype == cupy.complex128 or dtype == cupy.complex128:
-            nanvar_core = _nanvar_core_complex128
-        else:
-            nanvar_core = _nanvar_core
-        out = nanvar_core(
-            a, arrsum, _count, ddof, axis=axis, keepdims=keepdims)
-    else:
-        _nanvar_core_out(
-            a, arrsum, _count, ddof, out, axis=axis, keepdims=keepdims)
+        reduce_axis, out_axis = _reduction._get_axis(axis, a.ndim)
+        out_dtype = a.dtype if dtype is None else numpy.dtype(dtype)
+        out = cupy.empty(
+            _reduction._get_out_shape(a.shape, reduce_axis, out_axis,
+                                      keepdims),
+            out_dtype.char.lower())
+    _nanvar_core(a, ddof, out, axis=axis, keepdims=keepdims)
     return out
 
 
-cdef _nanvar_preamble = '''
-template <typename S, typename T>
-__device__ T nanvar_impl(S x, T mean, long long alpha) {
-    return (isnan(x) ? T(0) : T((x - mean) * (x - mean))) / alpha;
-}
-
-template <typename S, typename T>
-__device__ T nanvar_impl(complex<S> x, complex<T> mean, long long alpha) {
-    return (isnan(x) ? T(0) : T(norm(x - mean))) / alpha;
-}
-'''
-
-
 cdef _nanvar_core = ReductionKernel(
-    'S x, T sum, int64 _count, int64 ddof', 'S out',
-    'nanvar_impl(x, sum / _count, max(_count - ddof, 0LL))',
-    'a + b', 'out = a', '0', '_nanvar_core', preamble=_nanvar_preamble)
-
-
-cdef _nanvar_core_complex64 = ReductionKernel(
-    'complex64 x, complex64 sum, int64 _count, int64 ddof', 'float32 out',
-    'nanvar_impl(x, sum/static_cast<float>(_count), max(_count-ddof, 0LL))',
-    'a + b', 'out = a', '0', '_nanvar_core_complex64',
-    preamble=_nanvar_preamble)
-
-
-cdef _nanvar_core_complex128 = ReductionKernel(
-    'complex128 x, complex128 sum, int64 _count, int64 ddof', 'float64 out',
-    'nanvar_impl(x, sum/static_cast<double>(_count), max(_count-ddof, 0LL))',
-    'a + b', 'out = a', '0', '_nanvar_core_complex128',
-    preamble=_nanvar_preamble)
-
-
-cdef _nanvar_core_out = ReductionKernel(
-    'S x, T sum, int64 _count, int64 ddof', 'U out',
-    'nanvar_impl(x, sum / static_cast<T>(_count), max(_count - ddof, 0LL))',
-    'a + b', 'out = a', '0', '_nanvar_core', preamble=_nanvar_preamble)
+    'S x, int64 ddof', 'U out',
+    'x', 'var_merge(a, b)', 'out = a.variance(ddof)',
+    'var_st<S, U, true>()', 'cupy_nanvar',
+    reduce_type='var_st<S, U, true>', preamble=_var_preamble)
 
 
 # Variables to expose to Python
@@ -12,6 +12,7 @@ import numpy
 
 from cupy._core cimport _dtype
 from cupy._core cimport internal
+from cupy._core._dtype import bfloat16 as _bfloat16
 
 
 cdef union Scalar:
@@ -96,6 +97,11 @@ cdef set _python_scalar_type_set = {int, float, bool, complex}
 cdef set _numpy_scalar_type_set = set(_typenames.keys())
 cdef set scalar_type_set = _python_scalar_type_set | _numpy_scalar_type_set
 
+# bfloat16 arrays get a typename, but bfloat16 scalars are not kernel
+# arguments since CScalar cannot hold them.
+if _bfloat16 is not None:
+    _typenames[_bfloat16.type] = 'bfloat16'
+
 
 _int_iinfo = numpy.iinfo(int)
 cdef _int_min = _int_iinfo.min
@@ -0,0 +1,220 @@
+"""Scatter-add engine shared by bincount, histogram and scatter_add.
+
+``out[indices[i]] += values[i]`` is computed in one of three ways:
+
+- ``'shared'``: each block accumulates into a private copy of ``out`` in
+  shared memory, and the copies are merged into ``out`` at the end. Used
+  when ``out`` fits in shared memory.
+- ``'sort'``: the indices are sorted and each run of equal indices is
+  reduced with CUB, so that every item of ``out`` is updated once. Used for
+  larger outputs when a sample of the indices shows many collisions.
+- ``'atomic'``: one (warp-aggregated) global atomic per item.
+"""
+
+import string
+
+import numpy
+
+import cupy
+from cupy._core import _accelerator
+from cupy._core._kernel import ElementwiseKernel
+from cupy._core._scalar import get_typename
+from cupy import _util
+from cupy.cuda import cub
+from cupy.cuda import device
+
+
+# Budget for the private copies; the default limit is 48 KiB per block.
+_max_shared_bytes = 32 * 1024
+_block_size = 256
+# The sort is only worth it for many items colliding on few addresses.
+_min_sort_size = 1 << 20
+_sort_collision_threshold = 0.5
+_n_samples = 1024
+
+# atomicAdd is available for these on both global and shared memory
+_atomic_dtypes = 'iIlLqQefd'
+
+
+_atomic_scatter_add_kernel = ElementwiseKernel(
+    'S k, V v', 'raw T out',
+    '''
+    if (0 <= (ptrdiff_t)k && (ptrdiff_t)k < out.size()) {
+        warpAggregatedAtomicAdd(&out[k], (T)v);
+    }
+    ''',
+    'cupy_atomic_scatter_add')
+
+_atomic_scatter_count_kernel = ElementwiseKernel(
+    'S k', 'raw T out',
+    '''
+    if (0 <= (ptrdiff_t)k && (ptrdiff_t)k < out.size()) {
+        warpAggregatedAtomicAdd(&out[k], T(1));
+    }
+    ''',
+    'cupy_atomic_scatter_count')
+
+# The keys are unique here, so no atomics are needed.
+_unique_scatter_add_kernel = ElementwiseKernel(
+    'int64 k, T v', 'raw T out',
+    'if (0 <= k && k < out.size()) out[k] += v;',
+    'cupy_unique_scatter_add')
+
+
+_privatized_scatter_add_code = string.Template('''
+#include <cupy/carray.cuh>
+#include <cupy/atomics.cuh>
+
+extern "C" __global__ void cupy_privatized_scatter_add(
+        const ${index_t}* indices, const ${value_t}* values, ${out_t}* out,
+        long long n, int n_bins) {
+    typedef ${out_t} T;
+    extern __shared__ __align__(8) unsigned char _smem[];
+    T* bins = reinterpret_cast<T*>(_smem);
+    for (int j = threadIdx.x; j < n_bins; j += blockDim.x) {
+        bins[j] = T(0);
+    }
+    __syncthreads();
+    for (long long i = (long long)blockIdx.x * blockDim.x + threadIdx.x;
+         i < n; i += (long long)blockDim.x * gridDim.x) {
+        long long k = (long long)indices[i];
+        if (0 <= k && k < n_bins) {
+            atomicAdd(&bins[k], ${value});
+        }
+    }
+    __syncthreads();
+    for (int j = threadIdx.x; j < n_bins; j += blockDim.x) {
+        T v = bins[j];
+        if (v != T(0)) {
+            atomicAdd(&out[j], v);
+        }
+    }
+}
+''')
+
+
+@_util.memoize(for_each_device=True)
+def _get_privatized_kernel(index_dtype, value_dtype, out_dtype):
+    if value_dtype is None:
+        value_t, value = 'char', 'T(1)'
+    else:
+        value_t, value = get_typename(value_dtype), 'T(values[i])'
+    code = _privatized_scatter_add_code.substitute(
+        index_t=get_typename(index_dtype), value_t=value_t,
+        out_t=get_typename(out_dtype), value=value)
+    return cupy.RawKernel(code, 'cupy_privatized_scatter_add')
+
+
+def _collision_rate(indices):
+    # Fraction of a strided sample of the indices that repeat another one.
+    # This synchronizes the device.
+    stride = max(1, indices.size // _n_samples)
+    sample = indices[::stride][:_n_samples]
+    return 1 - cupy.unique(sample).size / sample.size
+
+
+def _can_use_sort(out):
+    if (_accelerator.ACCELERATOR_CUB
+            not in _accelerator.get_routine_accelerators()):
+        return False
+    if out.dtype.char not in 'iIlLqQfd':
+        return False
+    return True
+
+
+def _can_privatize(out, n):
+    return (out.dtype.char in _atomic_dtypes
+            and out.nbytes + 4 <= _max_shared_bytes and n >= out.size)
+
+
+def is_beneficial(out, n):
+    """Returns whether scatter_add may beat plain atomics for ``n`` items.
+
+    Callers that have to materialize the indices first use this to skip the
+    extra pass when it cannot pay off.
+    """
+    return _can_privatize(out, n) or (
+        n >= _min_sort_size and _can_use_sort(out))
+
+
+def _choose_method(out, indices):
+    n = indices.size
+    if _can_privatize(out, n):
+        return 'shared'
+    if (n >= _min_sort_size and _can_use_sort(out)
+            and _collision_rate(indices) >= _sort_collision_threshold):
+        return 'sort'
+    return 'atomic'
+
+
+def _scatter_add_shared(out, indices, values):
+    n = indices.size
+    n_bins = out.size
+    indices = cupy.ascontiguousarray(indices)
+    if values is None:
+        kern = _get_privatized_kernel(indices.dtype, None, out.dtype)
+        values_ptr = numpy.intp(0)
+    else:
+        values = cupy.ascontiguousarray(values)
+        kern = _get_privatized_kernel(indices.dtype, values.dtype, out.dtype)
+        values_ptr = values
+    num_sm = device.Device().attributes['MultiProcessorCount']
+    # Fewer blocks than this leave SMs idle; more blocks add merging work.
+    grid = min(2 * num_sm, (n + _block_size - 1) // _block_size,
+               max(1, n // max(1, n_bins)))
+    # Round up to a whole word for the float16 CAS loop.
+    shared_mem = (out.nbytes + 3) // 4 * 4
+    kern((grid,), (_block_size,),
+         (indices, values_ptr, out, numpy.int64(n), numpy.int32(n_bins)),
+         shared_mem=shared_mem)
+
+
+def _scatter_add_sort(out, indices, values):
+    keys = indices.astype(numpy.int64, copy=False)
+    if values is None:
+        keys = cupy.sort(keys)
+        values = cupy.ones(keys.shape, out.dtype)
+    else:
+        order = cupy.argsort(keys)
+        keys = keys[order]
+        values = values.astype(out.dtype, copy=False)[order]
+    unique_keys, sums, num_runs = cub.device_reduce_by_key(
+        keys, values, cub.CUPY_CUB_SUM)
+    num_runs = int(num_runs)
+    _unique_scatter_add_kernel(
+        unique_keys[:num_runs], sums[:num_runs], out)
+
+
+def scatter_add(out, indices, values=None, method=None):
+    """Computes ``out[indices[i]] += values[i]`` for all ``i``.
+
+    Args:
+        out (cupy.ndarray): 1-D C-contiguous output array, updated in place.
+        indices (cupy.ndarray): 1-D integer array. Indices out of
+            ``[0, out.size)`` are ignored.
+        values (cupy.ndarray): Values to add, of the same shape as
+            ``indices``. If ``None``, ones are added, i.e., the occurrences
+            of each index are counted.
+        method (str): ``'shared'``, ``'sort'`` or ``'atomic'``. By default
+            it is chosen from the size of ``out`` and, for large inputs, from
+            the collision rate of a sample of the indices, which synchronizes
+            the device.
+    """
+    assert out.ndim == 1 and out._c_contiguous
+    assert indices.ndim == 1
+    assert values is None or values.shape == indices.shape
+    if indices.size == 0 or out.size == 0:
+        return
+    if method is None:
+        method = _choose_method(out, indices)
+    if method == 'shared':
+        _scatter_add_shared(out, indices, values)
+    elif method == 'sort':
+        _scatter_add_sort(out, indices, values)
+    elif method == 'atomic':
+        if values is None:
+            _atomic_scatter_count_kernel(indices, out)
+        else:
+            _atomic_scatter_add_kernel(indices, values, out)
+    else:
+        raise ValueError('unknown method: {}'.format(method))
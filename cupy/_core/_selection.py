@@ -0,0 +1,342 @@
+"""Order statistics of the rows of an array by radix select.
+
+The quantiles of a row only need a few of its order statistics, so the row
+is not sorted. Its items are mapped to unsigned keys ordered as by
+:func:`cupy.sort` (NaNs last), and the wanted ranks are found together, one
+byte of the keys per pass: each pass builds a histogram of the current byte
+of the items that match the bytes found so far, for every rank, and a scan
+of the histograms picks the next byte. A row is read once per byte of its
+keys and nothing is written but the histograms.
+
+In the NaN-aware mode the ranks are taken among the items that are not
+NaN, since the NaNs have the largest key.
+"""
+
+import numpy
+
+import cupy
+from cupy._core._scalar import get_typename
+from cupy import _util
+
+
+# Shorter rows are sorted faster than their histograms are built.
+_min_length = 4096
+_max_quantiles = 8
+_block_size = 256
+_items_per_block = 16 * _block_size
+
+_key_types = {1: 'unsigned char', 2: 'unsigned short', 4: 'unsigned int',
+              8: 'unsigned long long'}
+_dtypes = 'bhilqBHILQfd'
+
+# How the two ranks and the weight of the upper one are found from the
+# position q * (m - 1) in a row of m items.
+_methods = {'linear': 0, 'lower': 1, 'higher': 2, 'nearest': 3,
+            'midpoint': 4, 'median': 5}
+quantile_methods = ('linear', 'lower', 'higher', 'nearest', 'midpoint')
+
+
+_selection_code = r'''
+#define MAX_RANKS (2 * MAX_QUANTILES)
+#define KEY_BITS (int)(sizeof(U) * 8)
+
+__device__ __forceinline__ U to_key(T x) {
+#if IS_FLOAT
+    const U sign = (U)1 << (KEY_BITS - 1);
+    if (isnan(x)) {
+        return (U)~(U)0;
+    }
+    const T y = (x == (T)0) ? (T)0 : x;  // -0.0 is ordered as 0.0
+    U b;
+    memcpy(&b, &y, sizeof(U));
+    return (b & sign) ? (U)~b : (U)(b | sign);
+#else
+    U b = (U)x;
+#if IS_SIGNED
+    b ^= (U)((U)1 << (KEY_BITS - 1));
+#endif
+    return b;
+#endif
+}
+
+__device__ __forceinline__ T from_key(U k) {
+#if IS_FLOAT
+    // the key of NaNs maps back to a NaN
+    const U sign = (U)1 << (KEY_BITS - 1);
+    const U b = (k & sign) ? (U)(k & ~sign) : (U)~k;
+    T y;
+    memcpy(&y, &b, sizeof(U));
+    return y;
+#else
+#if IS_SIGNED
+    k ^= (U)((U)1 << (KEY_BITS - 1));
+#endif
+    return (T)k;
+#endif
+}
+
+extern "C" __global__ void cupy_select_count_nan(
+        const T* __restrict__ data, const long long n,
+        unsigned long long* __restrict__ n_nan) {
+#if IS_FLOAT
+    const T* x = data + blockIdx.y * n;
+    unsigned long long count = 0;
+    for (long long i = (long long)blockIdx.x * blockDim.x + threadIdx.x;
+            i < n; i += (long long)gridDim.x * blockDim.x) {
+        count += isnan(x[i]) ? 1 : 0;
+    }
+    if (count) {
+        atomicAdd(&n_nan[blockIdx.y], count);
+    }
+#endif
+}
+
+// The two ranks of each quantile of each row. remaining holds the 1-based
+// rank among the items matching the prefix, as the prefix grows.
+extern "C" __global__ void cupy_select_init(
+        const long long n_rows, const long long n, const double* qs,
+        const int nq, const int method, const int nan_aware,
+        const unsigned long long* __restrict__ n_nan,
+        U* __restrict__ prefix, long long* __restrict__ remaining,
+        double* __restrict__ weight) {
+    const long long t = (long long)blockIdx.x * blockDim.x + threadIdx.x;
+    if (t >= n_rows * nq) {
+        return;
+    }
+    const long long row = t / nq;
+    const long long m = nan_aware ? n - (long long)n_nan[row] : n;
+    const double pos = (method == 5) ? 0 : qs[t % nq] * (double)(m - 1);
+    long long r0;
+    long long r1;
+    double w = 0;
+    if (method == 0) {
+        r0 = (long long)floor(pos);
+        r1 = r0 + 1;
+        w = pos - (double)r0;
+    } else if (method == 1) {
+        r0 = r1 = (long long)floor(pos);
+    } else if (method == 2) {
+        r0 = r1 = (long long)ceil(pos);
+    } else if (method == 3) {
+        r0 = r1 = (long long)rint(pos);
+    } else if (method == 4) {
+        r0 = (long long)floor(pos);
+        r1 = (long long)ceil(pos);
+        w = (r1 > r0) ? 0.5 : 0;
+    } else {
+        r0 = (m - 1) / 2;
+        r1 = m / 2;
+        w = (r1 > r0) ? 0.5 : 0;
+    }
+    const long long last = (m > 0) ? m - 1 : 0;
+    r0 = min(max(r0, 0LL), last);
+    r1 = min(max(r1, 0LL), last);
+    prefix[2 * t] = 0;
+    prefix[2 * t + 1] = 0;
+    remaining[2 * t] = r0 + 1;
+    remaining[2 * t + 1] = r1 + 1;
+    weight[t] = w;
+}
+
+// The histograms of the byte at shift of the items matching each prefix
+// in the higher bytes. The grid is (blocks per row, rows).
+extern "C" __global__ void cupy_select_histogram(
+        const T* __restrict__ data, const long long n, const int n_ranks,
+        const int shift, const U* __restrict__ prefix,
+        unsigned int* __restrict__ hist) {
+    __shared__ unsigned int h[MAX_RANKS * 256];
+    __shared__ U pre[MAX_RANKS];
+    const long long row = blockIdx.y;
+    for (int j = threadIdx.x; j < n_ranks * 256; j += blockDim.x) {
+        h[j] = 0;
+    }
+    if (threadIdx.x < n_ranks) {
+        pre[threadIdx.x] = prefix[row * n_ranks + threadIdx.x];
+    }
+    __syncthreads();
+    const U mask = (shift + 8 >= KEY_BITS) ?
+        (U)0 : (U)((U)~(U)0 << (shift + 8));
+    const T* x = data + row * n;
+    for (long long i = (long long)blockIdx.x * blockDim.x + threadIdx.x;
+            i < n; i += (long long)gridDim.x * blockDim.x) {
+        const U key = to_key(x[i]);
+        const int bin = (int)((key >> shift) & 0xff);
+        for (int j = 0; j < n_ranks; j++) {
+            if ((U)(key & mask) == pre[j]) {
+                atomicAdd(&h[j * 256 + bin], 1u);
+            }
+        }
+    }
+    __syncthreads();
+    unsigned int* g = hist + row * n_ranks * 256;
+    for (int j = threadIdx.x; j < n_ranks * 256; j += blockDim.x) {
+        if (h[j]) {
+            atomicAdd(&g[j], h[j]);
+        }
+    }
+}
+
+// Picks the byte at shift of each rank, and clears its histogram for the
+// next pass.
+extern "C" __global__ void cupy_select_scan(
+        const long long n_items, const int shift, U* __restrict__ prefix,
+        long long* __restrict__ remaining, unsigned int* __restrict__ hist) {
+    const long long t = (long long)blockIdx.x * blockDim.x + threadIdx.x;
+    if (t >= n_items) {
+        return;
+    }
+    unsigned int* h = hist + t * 256;
+    long long r = remaining[t];
+    int d = 0;
+    for (; d < 255 && h[d] < r; d++) {
+        r -= h[d];
+    }
+    prefix[t] |= (U)((U)d << shift);
+    remaining[t] = r;
+    for (int j = 0; j < 256; j++) {
+        h[j] = 0;
+    }
+}
+
+extern "C" __global__ void cupy_select_finish(
+        const long long n_rows, const long long n, const int nq,
+        const int nan_aware, const int propagate_nan,
+        const unsigned long long* __restrict__ n_nan,
+        const U* __restrict__ prefix, T* __restrict__ v0,
+        T* __restrict__ v1) {
+    const long long t = (long long)blockIdx.x * blockDim.x + threadIdx.x;
+    if (t >= n_rows * nq) {
+        return;
+    }
+    const long long nan_count = n_nan[t / nq];
+    if ((nan_aware && nan_count == n) || (propagate_nan && nan_count)) {
+        v0[t] = v1[t] = from_key((U)~(U)0);
+    } else {
+        v0[t] = from_key(prefix[2 * t]);
+        v1[t] = from_key(prefix[2 * t + 1]);
+    }
+}
+'''
+
+
+@_util.memoize(for_each_device=True)
+def _get_module(dtype):
+    code = ('#define T {}\n#define U {}\n#define IS_FLOAT {}\n'
+            '#define IS_SIGNED {}\n#define MAX_QUANTILES {}\n').format(
+                get_typename(dtype), _key_types[dtype.itemsize],
+                int(dtype.kind == 'f'), int(dtype.kind == 'i'),
+                _max_quantiles)
+    return cupy.RawModule(code=code + _selection_code)
+
+
+def available(a, n_quantiles=1):
+    """Tells if the quantiles of the last axis of ``a`` are selected here."""
+    if a.ndim == 0 or a.dtype.char not in _dtypes:
+        return False
+    n = a.shape[-1]
+    return (_min_length <= n <= 0x7fffffff
+            and 0 < n_quantiles <= _max_quantiles
+            and 0 < a.size // n <= 65535)
+
+
+def _launch(kernel, size, *args):
+    kernel(((size + _block_size - 1) // _block_size,), (_block_size,), args)
+
+
+def select(a, q, method, nan_aware=False, propagate_nan=False):
+    """Finds the two order statistics surrounding each quantile of the rows.
+
+    Returns the lower and upper values, and the weight of the upper one, of
+    shape ``a.shape[:-1] + (len(q),)``. ``q`` is ignored for the median.
+    NaNs are found in the NaN-aware mode, where rows of NaNs get NaNs, and
+    when they are propagated to the results of their rows.
+    """
+    a = cupy.ascontiguousarray(a)
+    n = a.shape[-1]
+    n_rows = a.size // n
+    if method == 'median':
+        qs = cupy.zeros(1, numpy.float64)
+    else:
+        qs = cupy.ascontiguousarray(q, dtype=numpy.float64).ravel()
+    nq = qs.size
+    n_ranks = 2 * nq
+    mod = _get_module(a.dtype)
+    blocks_per_row = min((n + _items_per_block - 1) // _items_per_block,
+                         max(1, 4096 // n_rows))
+
+    n_nan = cupy.zeros(n_rows, numpy.uint64)
+    if a.dtype.kind == 'f' and (nan_aware or propagate_nan):
+        mod.get_function('cupy_select_count_nan')(
+            (blocks_per_row, n_rows), (_block_size,),
+            (a, numpy.int64(n), n_nan))
+    prefix = cupy.empty((n_rows, n_ranks), 'u{}'.format(a.itemsize))
+    remaining = cupy.empty((n_rows, n_ranks), numpy.int64)
+    weight = cupy.empty(a.shape[:-1] + (nq,), numpy.float64)
+    _launch(mod.get_function('cupy_select_init'), n_rows * nq,
+            numpy.int64(n_rows), numpy.int64(n), qs, numpy.int32(nq),
+            numpy.int32(_methods[method]), numpy.int32(nan_aware), n_nan,
+            prefix, remaining, weight)
+
+    hist = cupy.zeros((n_rows, n_ranks, 256), numpy.uint32)
+    histogram = mod.get_function('cupy_select_histogram')
+    scan = mod.get_function('cupy_select_scan')
+    for shift in range(a.itemsize * 8 - 8, -1, -8):
+        histogram((blocks_per_row, n_rows), (_block_size,),
+                  (a, numpy.int64(n), numpy.int32(n_ranks),
+                   numpy.int32(shift), prefix, hist))
+        _launch(scan, n_rows * n_ranks, numpy.int64(n_rows * n_ranks),
+                numpy.int32(shift), prefix, remaining, hist)
+
+    v0 = cupy.empty(weight.shape, a.dtype)
+    v1 = cupy.empty(weight.shape, a.dtype)
+    _launch(mod.get_function('cupy_select_finish'), n_rows * nq,
+            numpy.int64(n_rows), numpy.int64(n), numpy.int32(nq),
+            numpy.int32(nan_aware), numpy.int32(propagate_nan), n_nan,
+            prefix, v0, v1)
+    return v0, v1, weight
+
+
+_interpolate_kernel = cupy.ElementwiseKernel(
+    'T v0, T v1, float64 w', 'U ret',
+    '''
+    U lo = v0;
+    U diff = (U)v1 - lo;
+    U weight_above = w;
+    if (weight_above < 0.5) {
+        ret = lo + diff * weight_above;
+    } else {
+        ret = (U)v1 - diff * (1 - weight_above);
+    }
+    ''',
+    'cupy_select_interpolate')
+
+_median_kernel = cupy.ElementwiseKernel(
+    'T v0, T v1, float64 w', 'U ret',
+    'ret = (w == 0) ? (U)v0 : ((U)v0 + (U)v1) / (U)2',
+    'cupy_select_median')
+
+
+def quantile(a, q, method, dtype):
+    """The quantiles of the rows of ``a``, with the quantiles first.
+
+    The results of the methods picking a single item are of the dtype of
+    ``a``, the others of ``dtype``.
+    """
+    v0, v1, w = select(a, q, method)
+    if method in ('lower', 'higher', 'nearest'):
+        ret = v0
+    else:
+        ret = _interpolate_kernel(v0, v1, w, cupy.empty(v0.shape, dtype))
+    return cupy.moveaxis(ret, -1, 0)
+
+
+def median(a, nan_aware=False):
+    """The medians of the rows of ``a``.
+
+    NaNs are ignored if ``nan_aware``, and propagated otherwise.
+    """
+    dtype = a.dtype if a.dtype.kind == 'f' else numpy.dtype(numpy.float64)
+    v0, v1, w = select(a, None, 'median', nan_aware=nan_aware,
+                       propagate_nan=not nan_aware)
+    ret = _median_kernel(v0, v1, w, cupy.empty(v0.shape, dtype))
+    return ret[..., 0]
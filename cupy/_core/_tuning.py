@@ -0,0 +1,226 @@
+"""Persistent database of tuned kernel launch parameters.
+
+The launch parameters of the reduction and elementwise kernels (the block
+size, and the items per thread of reductions) are looked up here before the
+built-in defaults are used. The database has a JSON file per GPU model in
+:envvar:`CUPY_TUNING_DIR`, which is read the first time a device is used.
+
+When :envvar:`CUPY_AUTOTUNE` is set, a kernel that is called
+``_hot_threshold`` times with the same key (its name, dtypes, and the size
+of the problem rounded to a power of 2) is tuned on a background thread:
+the candidate parameters are timed on copies of the arguments on a separate
+stream, and the fastest one is written to the database.
+"""
+
+import concurrent.futures
+import json
+import os
+import re
+import tempfile
+import threading
+import warnings
+
+from cupy.cuda import compiler
+from cupy.cuda import device
+from cupy.cuda import stream as stream_module
+from cupy_backends.cuda.api import driver
+from cupy_backends.cuda.api import runtime
+
+
+_autotune = int(os.environ.get('CUPY_AUTOTUNE', '0')) != 0
+_hot_threshold = 8
+_n_repeat = 10
+
+
+def _get_tuning_dir():
+    return os.environ.get(
+        'CUPY_TUNING_DIR', os.path.join(compiler.get_cache_dir(), 'tuning'))
+
+
+# Whether the kernels need to look up the database at all; the directory is
+# only listed once, so that the lookups cost nothing when it is not used.
+active = _autotune or os.path.isdir(_get_tuning_dir())
+
+
+class _TuningDB:
+
+    def __init__(self, path):
+        self.path = path
+        self._lock = threading.Lock()
+        self._entries = {}
+        if os.path.exists(path):
+            try:
+                self._entries = self._read()
+            except (OSError, ValueError) as e:
+                warnings.warn(f'Ignoring the tuning database {path}: {e}')
+
+    def _read(self):
+        with open(self.path) as f:
+            return json.load(f)
+
+    def lookup(self, kind, key):
+        return self._entries.get(kind, {}).get(key)
+
+    def get_entries(self, kinds):
+        with self._lock:
+            return {kind: dict(self._entries[kind]) for kind in kinds
+                    if kind in self._entries}
+
+    def update(self, kind, key, value):
+        self.merge({kind: {key: value}})
+
+    def merge(self, entries):
+        """Adds the entries ``{kind: {key: value}}`` and writes the file."""
+        with self._lock:
+            for kind, values in entries.items():
+                self._entries.setdefault(kind, {}).update(values)
+            # keep the entries tuned by other processes meanwhile
+            if os.path.exists(self.path):
+                try:
+                    on_disk = self._read()
+                except (OSError, ValueError):
+                    on_disk = {}
+                for k, values in on_disk.items():
+                    for name, v in values.items():
+                        self._entries.setdefault(k, {}).setdefault(name, v)
+            directory = os.path.dirname(self.path)
+            os.makedirs(directory, exist_ok=True)
+            with tempfile.NamedTemporaryFile(
+                    'w', dir=directory, delete=False) as f:
+                json.dump(self._entries, f, indent=1, sort_keys=True)
+                temp_path = f.name
+            os.replace(temp_path, self.path)
+
+
+_dbs_lock = threading.Lock()
+_dbs = {}          # device id -> _TuningDB
+_dbs_by_path = {}  # devices of the same model share the database
+_counts = {}
+_executor = None
+_streams = {}
+
+
+def _get_model_name(device_id):
+    props = runtime.getDeviceProperties(device_id)
+    if runtime.is_hip:
+        name = props['gcnArchName']
+    else:
+        name = props['name']
+    if isinstance(name, bytes):
+        name = name.decode()
+    return re.sub(r'[^A-Za-z0-9_.-]+', '_', name)
+
+
+def _get_db(device_id):
+    db = _dbs.get(device_id)
+    if db is None:
+        path = os.path.join(
+            _get_tuning_dir(), _get_model_name(device_id) + '.json')
+        with _dbs_lock:
+            db = _dbs_by_path.get(path)
+            if db is None:
+                db = _dbs_by_path[path] = _TuningDB(path)
+            _dbs[device_id] = db
+    return db
+
+
+def lookup(device_id, kind, key):
+    """Returns the tuned parameters of a kernel, or ``None``."""
+    return _get_db(device_id).lookup(kind, key)
+
+
+def record(device_id, kind, key, value):
+    """Writes parameters found by the caller to the database.
+
+    A failure to write the file is only warned, as the parameters are still
+    looked up in memory.
+    """
+    try:
+        _get_db(device_id).update(kind, key, value)
+    except OSError as e:
+        warnings.warn(f'Failed to save the {kind} parameters {key}: {e}')
+
+
+def get_size_bucket(size):
+    return max(1, size).bit_length()
+
+
+def copy_args(args):
+    """Copies the arrays among the arguments of a kernel, for tuning."""
+    from cupy._core.core import _ndarray_base
+    return [a.copy(order='K') if isinstance(a, _ndarray_base) else a
+            for a in args]
+
+
+def _get_stream(device_id):
+    s = _streams.get(device_id)
+    if s is None:
+        with device.Device(device_id):
+            s = _streams[device_id] = stream_module.Stream(non_blocking=True)
+    return s
+
+
+def _run(device_id, kind, key, tune, ready):
+    try:
+        with device.Device(device_id):
+            s = _get_stream(device_id)
+            s.wait_event(ready)
+            value = tune(s)
+        _get_db(device_id).update(kind, key, value)
+    except Exception as e:
+        warnings.warn(f'Failed to tune {kind} kernel {key}: {e}')
+
+
+def maybe_tune(device_id, kind, key, prepare):
+    """Counts a call of a kernel and tunes it once it is hot.
+
+    ``prepare`` is called on the calling thread, and returns a function that
+    takes a stream and returns the parameters to record. ``prepare`` should
+    copy the arguments, so that the tuning does not race with the caller.
+    """
+    if not _autotune:
+        return
+    count_key = (device_id, kind, key)
+    count = _counts.get(count_key, 0) + 1
+    _counts[count_key] = count
+    if count != _hot_threshold:
+        return
+    global _executor
+    with _dbs_lock:
+        if _executor is None:
+            _executor = concurrent.futures.ThreadPoolExecutor(
+                1, thread_name_prefix='cupy_autotune')
+    tune = prepare()
+    ready = stream_module.get_current_stream().record()
+    _executor.submit(_run, device_id, kind, key, tune, ready)
+
+
+def pick_fastest(candidates, launch, stream):
+    """Times ``launch(candidate)`` on ``stream`` and returns the fastest."""
+    start = stream_module.Event()
+    end = stream_module.Event()
+    best = None
+    for candidate in candidates:
+        try:
+            # warms up, and compiles the variant if needed
+            launch(candidate)
+            start.record(stream)
+            for _ in range(_n_repeat):
+                launch(candidate)
+            end.record(stream)
+            end.synchronize()
+        except driver.CUDADriverError:
+            # e.g. too many resources requested for the block size
+            continue
+        elapsed = stream_module.get_elapsed_time(start, end)
+        if best is None or elapsed < best[0]:
+            best = (elapsed, candidate)
+    if best is None:
+        raise RuntimeError('no candidate could be launched')
+    return best[1]
+
+
+def _wait():
+    # Waits for the tunings in progress; for testing.
+    if _executor is not None:
+        _executor.submit(lambda: None).result()
@@ -74,6 +74,7 @@ cdef class _ndarray_base:
     cpdef _ndarray_base any(self, axis=*, out=*, keepdims=*)
     cpdef _ndarray_base conj(self)
     cpdef _ndarray_base conjugate(self)
+    cpdef host_view(self, stream=*, bint prefetch=*)
     cpdef get(self, stream=*, order=*, out=*, blocking=*)
     cpdef set(self, arr, stream=*)
     cpdef _ndarray_base reduced_view(self, dtype=*)
@@ -109,6 +109,22 @@ cdef inline bint is_ump_supported(int device_id) except*:
         return False
 
 
+class _HostView:
+    # Exposes the host-accessible memory of an array to NumPy, keeping the
+    # array alive as the base of the view.
+
+    def __init__(self, _ndarray_base a):
+        self.base = a
+        self.__array_interface__ = {
+            'shape': a.shape,
+            'strides': a.strides,
+            'typestr': a.dtype.str,
+            'descr': a.dtype.descr,
+            'data': (a.data.ptr, False),
+            'version': 3,
+        }
+
+
 class ndarray(_ndarray_base):
     """
     __init__(self, shape, dtype=float, memptr=None, strides=None, order='C')
@@ -301,6 +317,7 @@ cdef class _ndarray_base:
             self, *, stream=None, max_version=None, dl_device=None, copy=None):
         cdef bint use_versioned = False
         cdef bint to_cpu = False
+        cdef _ndarray_base src = self
 
         # Check if we can export version 1
         if max_version is not None and max_version[0] >= 1:
@@ -312,9 +329,9 @@ cdef class _ndarray_base:
         if dl_device is None or dl_device == self.__dlpack_device__():
             # We chose the device or the device matches, so export normally.
             if copy is True:
-                # Could be implemented, but there may be some subtleties to
-                # consider here.
-                raise BufferError("copy=True only supported for copy to CPU.")
+                # The copy is made on the current stream, which the consumer
+                # stream waits for below.
+                src = self.copy(order='K')
         elif dl_device == (dlpack.kDLCPU, 0):
             # The user explicitly requested CPU device export.
             # NOTE:
@@ -376,11 +393,11 @@ cdef class _ndarray_base:
             stream = None
         elif stream != curr_stream_ptr:
             stream = stream_mod.ExternalStream(stream)
-            event = curr_stream.record()
+            event = curr_stream.record(stream_mod.Event(disable_timing=True))
             stream.wait_event(event)
 
         return dlpack.toDlpack(
-            self, use_versioned=use_versioned, to_cpu=to_cpu,
+            src, use_versioned=use_versioned, to_cpu=to_cpu,
             ensure_copy=copy is True, stream=stream)
 
     def __dlpack_device__(self):
@@ -658,7 +675,7 @@ cdef class _ndarray_base:
                     'part',
                     ComplexWarning)
         else:
-            elementwise_copy(self, newarray)
+            _copy_array(self, newarray)
         return newarray
 
     cpdef _ndarray_base astype(
@@ -1885,6 +1902,62 @@ cdef class _ndarray_base:
         """CUDA device on which this array resides."""
         return self.data.device
 
+    cpdef host_view(self, stream=None, bint prefetch=True):
+        """Returns a NumPy view of the array without a copy.
+
+        The array must be in managed memory or, on systems with HMM or ATS,
+        in system memory, e.g. allocated by
+        :func:`cupy.cuda.malloc_managed` or :func:`cupy.cuda.malloc_system`.
+        The pages of the array are prefetched to the host on the stream, if
+        the device supports it, and the stream is synchronized so that the
+        host reads the results of the work issued on it. This avoids the
+        copy of :meth:`get` on the devices that share the memory with the
+        host, e.g. MI300A and Grace Hopper.
+
+        Args:
+            stream (cupy.cuda.Stream): CUDA stream object. The current
+                stream is used by default.
+            prefetch (bool): If ``False``, the pages are not prefetched and
+                migrate on demand.
+
+        Returns:
+            numpy.ndarray: The view, which shares the memory with the array.
+            It must not be read or written by the host while kernels access
+            the array.
+
+        .. seealso:: :meth:`get`
+        """
+        cdef int device_id = self.data.device_id
+        cdef Py_ssize_t lo, hi, extent
+        cdef size_t i
+        if not self.is_host_accessible():
+            raise ValueError(
+                'host_view requires an array in managed memory or system '
+                'memory')
+        if (self.data.mem.identity == 'SystemMemory'
+                and not runtime.deviceGetAttribute(
+                    runtime.cudaDevAttrPageableMemoryAccess, device_id)):
+            raise RuntimeError(
+                'system memory is not accessible by the device, which '
+                'requires HMM or ATS')
+        if stream is None:
+            stream = stream_module.get_current_stream()
+        if (prefetch and self.size > 0 and runtime.deviceGetAttribute(
+                runtime.cudaDevAttrConcurrentManagedAccess, device_id)):
+            lo = hi = self.data.ptr
+            for i in range(self._shape.size()):
+                extent = (self._shape[i] - 1) * self._strides[i]
+                if extent < 0:
+                    lo += extent
+                else:
+                    hi += extent
+            runtime.memPrefetchAsync(
+                lo, hi - lo + self.dtype.itemsize, runtime.cudaCpuDeviceId,
+                stream.ptr)
+        syncdetect._declare_synchronize()
+        stream.synchronize()
+        return numpy.asarray(_HostView(self))
+
     cpdef get(self, stream=None, order='C', out=None, blocking=True):
         """Returns a copy of the array on host memory.
 
@@ -2664,7 +2737,7 @@ cdef _ndarray_base _array_from_nested_numpy_sequence(
             src_cpu)
         a = ndarray(shape, dtype=a_dtype, order=order)
         a.data.copy_from_host_async(mem.ptr, nbytes, stream)
-        pinned_memory._add_to_watch_list(stream.record(), mem)
+        pinned_memory._record_and_watch(stream, mem)
     else:
         # fallback to numpy array and send it to GPU
         # Note: a_cpu.ndim is always >= 1
@@ -2792,7 +2865,7 @@ cdef _ndarray_base _array_default(
     cdef intptr_t ptr_h = <intptr_t>(a_cpu.ctypes.data)
     if pinned_memory.is_memory_pinned(ptr_h):
         a.data.copy_from_host_async(ptr_h, nbytes, stream)
-        pinned_memory._add_to_watch_list(stream.record(), a_cpu)
+        pinned_memory._record_and_watch(stream, a_cpu)
     else:
         # The input numpy array does not live on pinned memory, so we allocate
         # an extra buffer and copy from it to avoid potential data race, see
@@ -2803,7 +2876,7 @@ cdef _ndarray_base _array_default(
             src_cpu = numpy.frombuffer(mem, a_dtype, a_cpu.size)
             src_cpu[:] = a_cpu.ravel(order)
             a.data.copy_from_host_async(mem.ptr, nbytes, stream)
-            pinned_memory._add_to_watch_list(stream.record(), mem)
+            pinned_memory._record_and_watch(stream, mem)
         else:
             a.data.copy_from_host_async(ptr_h, nbytes, stream)
 
@@ -2904,11 +2977,29 @@ cdef inline _alloc_async_transfer_buffer(Py_ssize_t nbytes):
     return None
 
 
+cdef object _permute_copy = None
+
+
+cdef _copy_array(_ndarray_base src, _ndarray_base dst):
+    # Copies src to the new array dst. Permuted layouts, of which the fastest
+    # axes differ, are copied through shared memory tiles.
+    global _permute_copy
+    if (src._shape.size() >= 2
+            and not (src._c_contiguous and dst._c_contiguous)
+            and not (src._f_contiguous and dst._f_contiguous)):
+        if _permute_copy is None:
+            from cupy._core import _permute_copy as module
+            _permute_copy = module
+        if _permute_copy.copy(src, dst):
+            return
+    elementwise_copy(src, dst)
+
+
 cpdef _ndarray_base _internal_ascontiguousarray(_ndarray_base a):
     if a._c_contiguous:
         return a
     newarray = _ndarray_init(ndarray, a._shape, a.dtype, None)
-    elementwise_copy(a, newarray)
+    _copy_array(a, newarray)
     return newarray
 
 
@@ -2944,7 +3035,7 @@ cpdef _ndarray_base _internal_asfortranarray(_ndarray_base a):
                 m, n, one.ctypes.data, a.data.ptr, n,
                 zero.ctypes.data, a.data.ptr, n, newarray.data.ptr, m)
     else:
-        elementwise_copy(a, newarray)
+        _copy_array(a, newarray)
     return newarray
 
 
@@ -2965,7 +3056,7 @@ cpdef _ndarray_base ascontiguousarray(_ndarray_base a, dtype=None):
 
     shape = (1,) if zero_dim else a.shape
     newarray = ndarray(shape, dtype)
-    elementwise_copy(a, newarray)
+    _copy_array(a, newarray)
     return newarray
 
 
@@ -2990,7 +3081,7 @@ cpdef _ndarray_base asfortranarray(_ndarray_base a, dtype=None):
         return _internal_asfortranarray(a)
 
     newarray = ndarray((1,) if zero_dim else a.shape, dtype, order='F')
-    elementwise_copy(a, newarray)
+    _copy_array(a, newarray)
     return newarray
 
 
@@ -117,7 +117,8 @@ cpdef object toDlpack(
     to_cpu : bool
         Whether we should make the data CPU available.
     ensure_copy : bool
-        If `to_cpu` is True, whether a copy is requested/required.
+        Whether a copy is requested/required. If `to_cpu` is False, the array
+        is the copy made by the caller, which is flagged as copied.
     stream : None or stream
         Only used with `to_cpu`. The stream to use for making the data
         available to the CPU.
@@ -188,9 +189,9 @@ cpdef object toDlpack(
         dlm_tensor_ver.version.major = IMPL_VER_MAJOR
         dlm_tensor_ver.version.minor = IMPL_VER_MINOR
 
-        # CuPy arrays are writeable but may be copied if copying to the CPU.
+        # CuPy arrays are writeable but may be copied.
         dlm_tensor_ver.flags = 0
-        if owner is not array:
+        if owner is not array or ensure_copy:
             dlm_tensor_ver.flags |= DLPACK_FLAG_BITMASK_IS_COPIED
     else:
         dlm_tensor = <DLManagedTensor*>dlm_tensor_ptr
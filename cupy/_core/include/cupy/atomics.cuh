@@ -17,6 +17,21 @@ __device__ double atomicAdd(double *address, double val)
 
 #endif // #if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ < 600)
 
+// sm_70 has a native half atomicAdd. (gfx90a also has packed half atomics,
+// but HIP does not expose them portably yet, so HIP keeps the CAS loop.)
+#if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 700) && (__CUDACC_VER_MAJOR__ >= 10)
+#define CUPY_NATIVE_HALF_ATOMIC
+#endif
+
+#ifdef CUPY_NATIVE_HALF_ATOMIC
+
+__device__ float16 atomicAdd(float16* address, float16 val) {
+  return float16(atomicAdd(reinterpret_cast<__half*>(address),
+                           __half(float(val))));
+}
+
+#else  // #ifdef CUPY_NATIVE_HALF_ATOMIC
+
 __device__ float16 atomicAdd(float16* address, float16 val) {
   unsigned int *aligned = (unsigned int*)((size_t)address - ((size_t)address & 2));
   unsigned int old = *aligned;
@@ -40,6 +55,26 @@ __device__ float16 atomicAdd(float16* address, float16 val) {
   return float16(raw);
 };
 
+#endif  // #ifdef CUPY_NATIVE_HALF_ATOMIC
+
+#ifdef CUPY_HAS_HALF2
+
+// Adds both halves of a 4-byte aligned pair; sm_60 has it natively.
+__device__ float16x2 atomicAdd(float16x2* address, float16x2 val) {
+#if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 600) && !defined(__HIPCC__)
+  __half2 ret = atomicAdd(reinterpret_cast<__half2*>(address),
+                          *reinterpret_cast<__half2*>(&val));
+  return *reinterpret_cast<float16x2*>(&ret);
+#else
+  float16* p = reinterpret_cast<float16*>(address);
+  float16 lo = atomicAdd(p, val.lo());
+  float16 hi = atomicAdd(p + 1, val.hi());
+  return float16x2(lo, hi);
+#endif
+}
+
+#endif  // #ifdef CUPY_HAS_HALF2
+
 
 __device__ long long atomicAdd(long long *address, long long val) {
     return atomicAdd(reinterpret_cast<unsigned long long*>(address),
@@ -47,6 +82,56 @@ __device__ long long atomicAdd(long long *address, long long val) {
 }
 
 
+// Warp-aggregated atomicAdd: the lanes of a warp that target the same
+// address sum their values with shuffles and the lowest of them issues a
+// single atomic. This helps when many lanes hit a few addresses (e.g.
+// scatter_add and histograms) and costs little otherwise. It needs
+// __match_any_sync (sm_70); elsewhere it is a plain atomicAdd. Unlike
+// atomicAdd, it does not return the old value.
+#if defined(__CUDA_ARCH__) && (__CUDA_ARCH__ >= 700) && !defined(__HIPCC__)
+
+__device__ inline float16 _cupy_shfl(unsigned int mask, float16 x, int lane) {
+  return float16(__shfl_sync(mask, __half(float(x)), lane));
+}
+
+template <typename T>
+__device__ inline T _cupy_shfl(unsigned int mask, T x, int lane) {
+  return __shfl_sync(mask, x, lane);
+}
+
+template <typename T>
+__device__ void warpAggregatedAtomicAdd(T* address, T val) {
+  unsigned int active = __activemask();
+  unsigned int peers = __match_any_sync(
+      active, reinterpret_cast<unsigned long long>(address));
+  unsigned int lane;
+  asm("mov.u32 %0, %%laneid;" : "=r"(lane));
+  unsigned int lower = (1u << lane) - 1;
+  bool leader = (peers & lower) == 0;
+  // Tree reduction over the peers: at each level, the peers at an even
+  // relative position take the partial sum of the next remaining peer.
+  unsigned int rel_pos = __popc(peers & lower);
+  peers &= ~(lower | (1u << lane));
+  while (__any_sync(active, peers)) {
+    int next = __ffs(peers);
+    T t = _cupy_shfl(active, val, next - 1);
+    if ((rel_pos & 1) == 0 && next) val += t;
+    peers &= __ballot_sync(active, (rel_pos & 1) == 0);
+    rel_pos >>= 1;
+  }
+  if (leader) atomicAdd(address, val);
+}
+
+#else
+
+template <typename T>
+__device__ void warpAggregatedAtomicAdd(T* address, T val) {
+  atomicAdd(address, val);
+}
+
+#endif
+
+
 #if __HIPCC__
 #include <hip/hip_version.h>
 #endif  // #if __HIPCC__
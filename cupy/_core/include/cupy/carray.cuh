@@ -47,14 +47,17 @@ namespace cupy {
 #else
 #include <hip/hip_fp16.h>
 #endif  // #if HIP_VERSION >= 40400000
+#define CUPY_HAS_HALF2
 
 #elif __HIPCC__
 
 #include <hip/hip_fp16.h>
+#define CUPY_HAS_HALF2
 
 #elif __CUDACC_VER_MAJOR__ >= 9
 
 #include <cuda_fp16.h>
+#define CUPY_HAS_HALF2
 
 #else  // #if __CUDACC_VER_MAJOR__ >= 9
 
@@ -84,9 +87,12 @@ public:
 
 #endif  // #if __CUDACC_VER_MAJOR__ >= 9
 
+class float16x2;
+
 class float16 {
 private:
   half  data_;
+  friend class float16x2;
 public:
   __device__ float16() {}
   __device__ float16(float v) : data_(v) {}
@@ -217,6 +223,211 @@ __device__ int isinf(float16 x) {return x.isinf();}
 __device__ int isfinite(float16 x) {return x.isfinite();}
 __device__ int signbit(float16 x) {return x.signbit();}
 
+#ifdef CUPY_HAS_HALF2
+
+#if defined(__HIPCC__) || defined(__HIPCC_RTC__) || \
+    (defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 530)
+#define CUPY_NATIVE_HALF2
+#endif
+
+// Two float16 values packed into a half2. Addition, subtraction and
+// multiplication of both halves are single instructions on devices with
+// native half2 arithmetic; elsewhere they go through float2. Both give the
+// same results as float16, which rounds the float result of each operation.
+class float16x2 {
+private:
+  __half2 data_;
+public:
+  __device__ float16x2() {}
+  __device__ float16x2(float16 lo, float16 hi)
+      : data_(__halves2half2(lo.data_, hi.data_)) {}
+  explicit __device__ float16x2(const __half2 &v) : data_(v) {}
+
+  __device__ float16 lo() const {return float16(__low2half(data_));}
+  __device__ float16 hi() const {return float16(__high2half(data_));}
+
+#ifdef CUPY_NATIVE_HALF2
+  friend __device__ float16x2 operator+(float16x2 x, float16x2 y) {
+    return float16x2(__hadd2(x.data_, y.data_));
+  }
+  friend __device__ float16x2 operator-(float16x2 x, float16x2 y) {
+    return float16x2(__hsub2(x.data_, y.data_));
+  }
+  friend __device__ float16x2 operator*(float16x2 x, float16x2 y) {
+    return float16x2(__hmul2(x.data_, y.data_));
+  }
+  friend __device__ float16x2 fma(float16x2 x, float16x2 y, float16x2 z) {
+    return float16x2(__hfma2(x.data_, y.data_, z.data_));
+  }
+  __device__ float16x2 operator-() const {
+    return float16x2(__hneg2(data_));
+  }
+#else
+  friend __device__ float16x2 operator+(float16x2 x, float16x2 y) {
+    float2 a = __half22float2(x.data_), b = __half22float2(y.data_);
+    return float16x2(__floats2half2_rn(a.x + b.x, a.y + b.y));
+  }
+  friend __device__ float16x2 operator-(float16x2 x, float16x2 y) {
+    float2 a = __half22float2(x.data_), b = __half22float2(y.data_);
+    return float16x2(__floats2half2_rn(a.x - b.x, a.y - b.y));
+  }
+  friend __device__ float16x2 operator*(float16x2 x, float16x2 y) {
+    float2 a = __half22float2(x.data_), b = __half22float2(y.data_);
+    return float16x2(__floats2half2_rn(a.x * b.x, a.y * b.y));
+  }
+  friend __device__ float16x2 fma(float16x2 x, float16x2 y, float16x2 z) {
+    float2 a = __half22float2(x.data_), b = __half22float2(y.data_);
+    float2 c = __half22float2(z.data_);
+    return float16x2(
+        __floats2half2_rn(fmaf(a.x, b.x, c.x), fmaf(a.y, b.y, c.y)));
+  }
+  __device__ float16x2 operator-() const {
+    float2 a = __half22float2(data_);
+    return float16x2(__floats2half2_rn(-a.x, -a.y));
+  }
+#endif  // #ifdef CUPY_NATIVE_HALF2
+
+  __device__ float16x2 operator+() const {return *this;}
+
+  inline __device__ float16x2& operator+=(float16x2 rhs) {
+    *this = *this + rhs;
+    return *this;
+  }
+
+  inline __device__ float16x2& operator-=(float16x2 rhs) {
+    *this = *this - rhs;
+    return *this;
+  }
+
+  inline __device__ float16x2& operator*=(float16x2 rhs) {
+    *this = *this * rhs;
+    return *this;
+  }
+};
+
+#endif  // #ifdef CUPY_HAS_HALF2
+
+// bfloat16 is kept as its bit pattern, so that it neither depends on
+// cuda_bf16.h nor on the architecture. Like float16, the arithmetic goes
+// through float; conversions from float round to nearest even.
+class bfloat16 {
+private:
+  unsigned short data_;
+
+  static __device__ unsigned short from_float(float v) {
+    unsigned int x = __float_as_uint(v);
+    if ((x & 0x7fffffffu) > 0x7f800000u) {
+      return static_cast<unsigned short>((x >> 16) | 0x0040u);  // quiet NaN
+    }
+    return static_cast<unsigned short>((x + 0x7fffu + ((x >> 16) & 1u)) >> 16);
+  }
+
+public:
+  __device__ bfloat16() {}
+  __device__ bfloat16(float v) : data_(from_float(v)) {}
+
+  explicit __device__ bfloat16(bool v) : data_(from_float(float(v))) {}
+  explicit __device__ bfloat16(double v) : data_(from_float(float(v))) {}
+  explicit __device__ bfloat16(int v) : data_(from_float(float(v))) {}
+  explicit __device__ bfloat16(unsigned int v) : data_(from_float(float(v))) {}
+  explicit __device__ bfloat16(long long v) : data_(from_float(float(v))) {}
+  explicit __device__ bfloat16(unsigned long long v) : data_(from_float(float(v))) {}
+  explicit __device__ bfloat16(float16 v) : data_(from_float(float(v))) {}
+
+  __device__ operator float() const {
+    return __uint_as_float(static_cast<unsigned int>(data_) << 16);
+  }
+
+  static __device__ bfloat16 from_bits(unsigned short bits) {
+    bfloat16 ret;
+    ret.data_ = bits;
+    return ret;
+  }
+
+  static const unsigned short nan = 0x7fc0u;
+
+  __device__ int iszero() const {return (data_ & 0x7fffu) == 0;}
+  __device__ int isnan() const {return (data_ & 0x7fffu) > 0x7f80u;}
+  __device__ int isinf() const {return (data_ & 0x7fffu) == 0x7f80u;}
+  __device__ int isfinite() const {return (data_ & 0x7f80u) != 0x7f80u;}
+  __device__ int signbit() const {return (data_ & 0x8000u) != 0;}
+
+  template<typename T>
+  inline __device__ bfloat16& operator+=(const T& rhs) {
+    *this = *this + rhs;
+    return *this;
+  }
+
+  template<typename T>
+  inline __device__ bfloat16& operator-=(const T& rhs) {
+    *this = *this - rhs;
+    return *this;
+  }
+
+  template<typename T>
+  inline __device__ bfloat16& operator*=(const T& rhs) {
+    *this = *this * rhs;
+    return *this;
+  }
+
+  template<typename T>
+  inline __device__ bfloat16& operator/=(const T& rhs) {
+    *this = *this / rhs;
+    return *this;
+  }
+
+  friend __device__ bfloat16 copysign(bfloat16 x, bfloat16 y) {
+    return from_bits((x.data_ & 0x7fffu) | (y.data_ & 0x8000u));
+  }
+
+  friend __device__ bfloat16 nextafter(bfloat16 x, bfloat16 y) {
+    unsigned short ret;
+    if (!x.isfinite() || y.isnan()) {
+      ret = nan;
+    } else if (x.data_ == y.data_ || ((x.data_ | y.data_) & 0x7fffu) == 0) {
+      ret = x.data_;
+    } else if (x.iszero()) {
+      ret = (y.data_ & 0x8000u) + 1;
+    } else if (!(x.data_ & 0x8000u)) {
+      if (static_cast<signed short>(x.data_) > static_cast<signed short>(y.data_)) {
+        ret = x.data_ - 1;
+      } else {
+        ret = x.data_ + 1;
+      }
+    } else if (!(y.data_ & 0x8000u) || (x.data_ & 0x7fffu) > (y.data_ & 0x7fffu)) {
+      ret = x.data_ - 1;
+    } else {
+      ret = x.data_ + 1;
+    }
+    return from_bits(ret);
+  }
+};
+
+__device__ bfloat16 min(bfloat16 x, bfloat16 y) {
+  return bfloat16(min(float(x), float(y)));
+}
+__device__ bfloat16 max(bfloat16 x, bfloat16 y) {
+  return bfloat16(max(float(x), float(y)));
+}
+__device__ bfloat16 fmin(bfloat16 x, bfloat16 y) {
+  return bfloat16(fmin(float(x), float(y)));
+}
+__device__ bfloat16 fmax(bfloat16 x, bfloat16 y) {
+  return bfloat16(fmax(float(x), float(y)));
+}
+__device__ int iszero(bfloat16 x) {return x.iszero();}
+__device__ int isnan(bfloat16 x) {return x.isnan();}
+__device__ int isinf(bfloat16 x) {return x.isinf();}
+__device__ int isfinite(bfloat16 x) {return x.isfinite();}
+__device__ int signbit(bfloat16 x) {return x.signbit();}
+
+// Aligned vector of N elements, used by CArray::load_vec/store_vec so that
+// N consecutive elements are moved with a single 4, 8 or 16 byte access.
+template <typename T, int N>
+struct alignas(sizeof(T) * N) _aligned_vector {
+  T val[N];
+};
+
 // CArray
 #define CUPY_FOR(i, n) \
     for (ptrdiff_t i = \
@@ -605,6 +816,31 @@ public:
       return *reinterpret_cast<const T*>(ptr + diff);
     }
   }
+
+  // Loads/stores the N elements starting at `idx` with one vector access.
+  // Only valid for contiguous arrays whose element `idx` is aligned to
+  // `sizeof(T) * N` bytes; the caller is responsible for checking it.
+  template <int N>
+  __device__ void load_vec(ptrdiff_t idx, T (&v)[N]) const {
+    assert(c_contiguous);
+    const _aligned_vector<T, N> r =
+        *reinterpret_cast<const _aligned_vector<T, N>*>(data_ + idx);
+#pragma unroll
+    for (int k = 0; k < N; ++k) {
+      v[k] = r.val[k];
+    }
+  }
+
+  template <int N>
+  __device__ void store_vec(ptrdiff_t idx, const T (&v)[N]) {
+    assert(c_contiguous);
+    _aligned_vector<T, N> r;
+#pragma unroll
+    for (int k = 0; k < N; ++k) {
+      r.val[k] = v[k];
+    }
+    *reinterpret_cast<_aligned_vector<T, N>*>(data_ + idx) = r;
+  }
 };
 
 template <typename T, bool _use_32bit_indexing>
@@ -664,7 +900,11 @@ public:
   }
 };
 
-template <int _ndim, bool _use_32bit_indexing=false>
+// When `_static_shape` is given (it must then have `_ndim` extents), the
+// shape is known at compile time and `set` divides by constants, which the
+// compiler turns into multiply-shift sequences. The layout is the same as
+// with a runtime shape, so the host passes the same arguments.
+template <int _ndim, bool _use_32bit_indexing=false, ptrdiff_t... _static_shape>
 class CIndexer {
 public:
   static const int ndim = _ndim;
@@ -738,6 +978,12 @@ public:
     // ndim == 0 case uses partial template specialization
     if (ndim == 1) {
       index_[0] = i;
+    } else if (sizeof...(_static_shape) == ndim) {
+      if (_use_32bit_indexing) {
+        this->_set_static(static_cast<unsigned int>(i));
+      } else {
+        this->_set_static(static_cast<unsigned long long int>(i));
+      }
     } else if (!_use_32bit_indexing && size_ > 1LL << 31) {
       // 64-bit division is very slow on GPU
       this->_set(static_cast<unsigned long long int>(i));
@@ -763,13 +1009,27 @@ private:
       index_[0] = i;
   }
 
+  template<typename index_t>
+  __device__ void _set_static(index_t i) {
+      // Only called with a full static shape; the extra element keeps the
+      // array well-formed for the instantiations that never call it
+      const index_t shape[ndim + 1] = {static_cast<index_t>(_static_shape)..., 1};
+#pragma unroll
+      for (int dim = ndim; --dim > 0; ) {
+        index_t t = i / shape[dim];
+        index_[dim] = i - t * shape[dim];
+        i = t;
+      }
+      index_[0] = i;
+  }
+
   // can also be implemented as __ffs(x)-1 or 31-__clz(x)
   static unsigned int __device__ _log2(unsigned int x) { return __popc(x-1); }
   static unsigned long long int __device__ _log2(unsigned long long int x) { return __popcll(x-1); }
 };
 
-template <bool _use_32bit_indexing>
-class CIndexer<0, _use_32bit_indexing> {
+template <bool _use_32bit_indexing, ptrdiff_t... _static_shape>
+class CIndexer<0, _use_32bit_indexing, _static_shape...> {
 private:
   ptrdiff_t size_;
 
@@ -22,6 +22,9 @@ using thrust::atanh;
 using thrust::asin;
 using thrust::acos;
 using thrust::atan;
+using thrust::fast_exp;
+using thrust::fast_log;
+using thrust::fast_sqrt;
 
 template<typename T>
 __host__ __device__ bool isnan(complex<T> x) {
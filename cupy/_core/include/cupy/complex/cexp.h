@@ -169,7 +169,11 @@ __host__ __device__ inline complex<ValueType> exp(const complex<ValueType>& z) {
 
 template <>
 __host__ __device__ inline complex<double> exp(const complex<double>& z) {
+#ifdef CUPY_COMPLEX_FAST_MATH
+  return detail::complex::fast_cexp(z);
+#else
   return detail::complex::cexp(z);
+#endif
 }
 
 THRUST_NAMESPACE_END
@@ -149,7 +149,11 @@ __host__ __device__ inline complex<float> cexpf(const complex<float>& z) {
 
 template <>
 __host__ __device__ inline complex<float> exp(const complex<float>& z) {
+#ifdef CUPY_COMPLEX_FAST_MATH
+  return detail::complex::fast_cexp(z);
+#else
   return detail::complex::cexpf(z);
+#endif
 }
 
 THRUST_NAMESPACE_END
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cupy/complex/math_private.h>
+
+/*
+ * Branch-light complex exp, log and sqrt.
+ *
+ * The FreeBSD ports below branch on every special value, so that a warp
+ * diverges through several code paths even when all its inputs are plain
+ * finite numbers. The functions here evaluate a straight-line formula for
+ * the common case of finite inputs of moderate magnitude, and call the
+ * IEEE-exact port only if some input needs it (infinities, NaNs, values
+ * close to overflow or underflow, and zeros for log and sqrt). On the
+ * device this is decided per warp with a vote, so that the warp runs either
+ * the formula or the exact port in lockstep. The results are the same up to
+ * rounding, except that the real part of log(z) loses relative accuracy
+ * when |z| is close to 1.
+ *
+ * They are available as fast_exp, fast_log and fast_sqrt, and replace
+ * exp, log and sqrt of complex numbers when CUPY_COMPLEX_FAST_MATH is
+ * defined.
+ */
+
+THRUST_NAMESPACE_BEGIN
+namespace detail {
+namespace complex {
+
+using thrust::complex;
+
+// the IEEE-exact ports, defined in cexp.h, clog.h, csqrt.h and friends
+__host__ __device__ inline complex<double> cexp(const complex<double>& z);
+__host__ __device__ inline complex<float> cexpf(const complex<float>& z);
+__host__ __device__ inline complex<double> clog(const complex<double>& z);
+__host__ __device__ inline complex<float> clogf(const complex<float>& z);
+__host__ __device__ inline complex<double> csqrt(const complex<double>& z);
+__host__ __device__ inline complex<float> csqrtf(const complex<float>& z);
+
+__host__ __device__ inline complex<double> exact_exp(const complex<double>& z) { return cexp(z); }
+__host__ __device__ inline complex<float> exact_exp(const complex<float>& z) { return cexpf(z); }
+__host__ __device__ inline complex<double> exact_log(const complex<double>& z) { return clog(z); }
+__host__ __device__ inline complex<float> exact_log(const complex<float>& z) { return clogf(z); }
+__host__ __device__ inline complex<double> exact_sqrt(const complex<double>& z) { return csqrt(z); }
+__host__ __device__ inline complex<float> exact_sqrt(const complex<float>& z) { return csqrtf(z); }
+
+template <typename T> struct fast_limits;
+
+template <> struct fast_limits<float> {
+  // exp(x) does not overflow below this
+  __host__ __device__ static float exp_max() { return 88.0f; }
+  // (|z| + hypot) neither overflows nor loses bits to denormals in between;
+  // these are the scaling thresholds of csqrtf
+  __host__ __device__ static float abs_min() { return 2.35098870164458e-38f; }
+  __host__ __device__ static float abs_max() { return 1.40949553037932e+38f; }
+};
+
+template <> struct fast_limits<double> {
+  __host__ __device__ static double exp_max() { return 709.0; }
+  __host__ __device__ static double abs_min() { return 4.450147717014402766180465e-308; }
+  __host__ __device__ static double abs_max() { return 7.446288774449766337959726e+307; }
+};
+
+// Returns whether pred is set on any active thread of the warp.
+__host__ __device__ inline bool any_in_warp(bool pred) {
+#if defined(__CUDA_ARCH__) && !defined(__HIP_DEVICE_COMPILE__)
+  return __any_sync(__activemask(), pred);
+#else
+  return pred;
+#endif
+}
+
+// NaN compares false, so that it is never moderate.
+template <typename T>
+__host__ __device__ inline bool is_moderate(T a, T b) {
+  T m = ::fmax(::fabs(a), ::fabs(b));
+  return m >= fast_limits<T>::abs_min() && m < fast_limits<T>::abs_max();
+}
+
+template <typename T>
+__host__ __device__ inline complex<T> fast_cexp(const complex<T>& z) {
+  T x = z.real(), y = z.imag();
+  bool special = !(::fabs(x) < fast_limits<T>::exp_max() &&
+                   ::fabs(y) < infinity<T>());
+  if (any_in_warp(special)) return exact_exp(z);
+  T e = ::exp(x);
+  return complex<T>(e * ::cos(y), e * ::sin(y));
+}
+
+template <typename T>
+__host__ __device__ inline complex<T> fast_clog(const complex<T>& z) {
+  T x = z.real(), y = z.imag();
+  if (any_in_warp(!is_moderate(x, y))) return exact_log(z);
+  return complex<T>(::log(::hypot(x, y)), ::atan2(y, x));
+}
+
+template <typename T>
+__host__ __device__ inline complex<T> fast_csqrt(const complex<T>& z) {
+  T a = z.real(), b = z.imag();
+  if (any_in_warp(!is_moderate(a, b))) return exact_sqrt(z);
+  /* Algorithm 312, CACM vol 10, Oct 1967, without branches. */
+  T t = ::sqrt((::fabs(a) + ::hypot(a, b)) * T(0.5));
+  T u = b / (T(2) * t);
+  return a >= T(0) ? complex<T>(t, u)
+                   : complex<T>(::fabs(u), ::copysign(t, b));
+}
+
+}  // namespace complex
+
+}  // namespace detail
+
+template <typename T>
+__host__ __device__ inline complex<T> fast_exp(const complex<T>& z) {
+  return detail::complex::fast_cexp(z);
+}
+
+template <typename T>
+__host__ __device__ inline complex<T> fast_log(const complex<T>& z) {
+  return detail::complex::fast_clog(z);
+}
+
+template <typename T>
+__host__ __device__ inline complex<T> fast_sqrt(const complex<T>& z) {
+  return detail::complex::fast_csqrt(z);
+}
+
+THRUST_NAMESPACE_END
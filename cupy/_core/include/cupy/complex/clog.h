@@ -192,7 +192,11 @@ __host__ __device__ inline complex<ValueType> log(const complex<ValueType>& z) {
 
 template <>
 __host__ __device__ inline complex<double> log(const complex<double>& z) {
+#ifdef CUPY_COMPLEX_FAST_MATH
+  return detail::complex::fast_clog(z);
+#else
   return detail::complex::clog(z);
+#endif
 }
 
 template <typename ValueType>
@@ -188,7 +188,11 @@ __host__ __device__ inline complex<float> clogf(const complex<float>& z) {
 
 template <>
 __host__ __device__ inline complex<float> log(const complex<float>& z) {
+#ifdef CUPY_COMPLEX_FAST_MATH
+  return detail::complex::fast_clog(z);
+#else
   return detail::complex::clogf(z);
+#endif
 }
 
 THRUST_NAMESPACE_END
@@ -149,6 +149,7 @@ THRUST_NAMESPACE_END
 
 
 #include <cupy/complex/arithmetic.h>
+#include <cupy/complex/cfast.h>
 #include <cupy/complex/cproj.h>
 #include <cupy/complex/cexp.h>
 #include <cupy/complex/cexpf.h>
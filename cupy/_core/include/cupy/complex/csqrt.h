@@ -140,7 +140,11 @@ __host__ __device__ inline complex<ValueType> sqrt(const complex<ValueType>& z)
 
 template <>
 __host__ __device__ inline complex<double> sqrt(const complex<double>& z) {
+#ifdef CUPY_COMPLEX_FAST_MATH
+  return detail::complex::fast_csqrt(z);
+#else
   return detail::complex::csqrt(z);
+#endif
 }
 
 THRUST_NAMESPACE_END
@@ -137,7 +137,11 @@ __host__ __device__ inline complex<float> csqrtf(const complex<float>& z) {
 
 template <>
 __host__ __device__ inline complex<float> sqrt(const complex<float>& z) {
+#ifdef CUPY_COMPLEX_FAST_MATH
+  return detail::complex::fast_csqrt(z);
+#else
   return detail::complex::csqrtf(z);
+#endif
 }
 
 THRUST_NAMESPACE_END
@@ -4,12 +4,20 @@
 #include <cupy/complex.cuh>
 #include <stdexcept>
 #include <cstdint>
+#include <type_traits>
+#include <utility>
 #if (__CUDACC_VER_MAJOR__ > 9 || (__CUDACC_VER_MAJOR__ == 9 && __CUDACC_VER_MINOR__ == 2)) \
     && (__CUDA_ARCH__ >= 530 || !defined(__CUDA_ARCH__))
 #include <cuda_fp16.h>
 #elif (defined(__HIPCC__) || defined(CUPY_USE_HIP))
 #include <hip/hip_fp16.h>
 #endif
+// bfloat16 arithmetic and comparisons need sm_80
+#if __CUDACC_VER_MAJOR__ >= 11 && (__CUDA_ARCH__ >= 800 || !defined(__CUDA_ARCH__)) \
+    && !(defined(__HIPCC__) || defined(CUPY_USE_HIP))
+#include <cuda_bf16.h>
+#define CUPY_ENABLE_BFLOAT16
+#endif
 
 
 #define CUPY_TYPE_INT8        0
@@ -26,6 +34,7 @@
 #define CUPY_TYPE_COMPLEX64  11
 #define CUPY_TYPE_COMPLEX128 12
 #define CUPY_TYPE_BOOL       13
+#define CUPY_TYPE_BFLOAT16   14
 
 
 //
@@ -34,6 +43,26 @@
 // This is implemented with reference to the following implementation.
 // https://github.com/rapidsai/cudf/blob/branch-0.6/cpp/src/utilities/type_dispatcher.hpp
 //
+// Only the functors that specialize dispatch_bfloat16 to true_type are
+// instantiated for bfloat16; the others reject it as an unsupported dtype.
+//
+template <class functor_t>
+struct dispatch_bfloat16 : std::false_type {};
+
+#ifdef CUPY_ENABLE_BFLOAT16
+template <class functor_t, typename... Ts>
+void _dispatch_bfloat16(std::true_type, functor_t& f, Ts&&... args)
+{
+    return f.template operator()<__nv_bfloat16>(std::forward<Ts>(args)...);
+}
+
+template <class functor_t, typename... Ts>
+void _dispatch_bfloat16(std::false_type, functor_t& f, Ts&&... args)
+{
+    throw std::runtime_error("Unsupported dtype ID");
+}
+#endif
+
 template <class functor_t, typename... Ts>
 void dtype_dispatcher(int dtype_id, functor_t f, Ts&&... args)
 {
@@ -55,6 +84,9 @@ void dtype_dispatcher(int dtype_id, functor_t f, Ts&&... args)
     case CUPY_TYPE_COMPLEX64:  return f.template operator()<complex<float>>(std::forward<Ts>(args)...);
     case CUPY_TYPE_COMPLEX128: return f.template operator()<complex<double>>(std::forward<Ts>(args)...);
     case CUPY_TYPE_BOOL:       return f.template operator()<bool>(std::forward<Ts>(args)...);
+#ifdef CUPY_ENABLE_BFLOAT16
+    case CUPY_TYPE_BFLOAT16:   return _dispatch_bfloat16(dispatch_bfloat16<functor_t>(), f, std::forward<Ts>(args)...);
+#endif
     default:
 	    throw std::runtime_error("Unsupported dtype ID");
     }
@@ -171,11 +171,13 @@ def frombuffer(*args, **kwargs):
     return asarray(numpy.frombuffer(*args, **kwargs))
 
 
-def fromfile(*args, **kwargs):
+def fromfile(file, dtype=float, count=-1, sep='', offset=0, **kwargs):
     """Reads an array from a file.
 
     .. note::
-        Uses NumPy's ``fromfile`` and coerces the result to a CuPy array.
+        A binary file (``sep=''``) is read into pinned staging buffers and
+        copied to the device chunk by chunk, on a separate stream. Otherwise
+        it uses NumPy's ``fromfile`` and coerces the result to a CuPy array.
 
     .. note::
        If you let NumPy's ``fromfile`` read the file in big-endian, CuPy
@@ -185,7 +187,13 @@ def fromfile(*args, **kwargs):
     .. seealso:: :func:`numpy.fromfile`
 
     """
-    return asarray(numpy.fromfile(*args, **kwargs))
+    if sep == '' and not kwargs:
+        from cupy._io import _direct
+        a = _direct.fromfile(file, dtype, count, offset)
+        if a is not None:
+            return a
+    return asarray(numpy.fromfile(
+        file, dtype=dtype, count=count, sep=sep, offset=offset, **kwargs))
 
 
 def fromfunction(*args, **kwargs):
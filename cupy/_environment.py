@@ -245,6 +245,17 @@ def _setup_win32_dll_directory():
                 os.environ['PATH'] = wheel_libdir + os.pathsep + path
 
 
+def _setup_lazy_module_loading():
+    # Load the kernels of the fat binaries on their first launch instead of
+    # at context creation, unless the user chooses otherwise. Only effective
+    # before the CUDA (HIP) runtime is initialized in this process.
+    for name, value in (('CUDA_MODULE_LOADING', 'LAZY'),
+                        ('HIP_ENABLE_DEFERRED_LOADING', '1')):
+        if name not in os.environ:
+            _log('Setting {}={}'.format(name, value))
+            os.environ[name] = value
+
+
 def get_cupy_install_path():
     # Path to the directory where the package is installed.
     return os.path.abspath(
@@ -0,0 +1,89 @@
+"""Reads of binary files into device memory without a NumPy intermediate.
+
+The file is read straight into pinned staging buffers, which are copied to
+the device asynchronously on a separate stream while the next chunk is
+read (see :func:`cupyx.to_device_pipelined`), so that the data is copied
+once on the host instead of twice.
+"""
+
+import contextlib
+import os
+
+import numpy
+from numpy.lib import format as _format
+
+
+def _is_supported(dtype):
+    return not dtype.hasobject and dtype.isnative
+
+
+@contextlib.contextmanager
+def _open(file):
+    if isinstance(file, (str, bytes, os.PathLike)):
+        with open(file, 'rb') as f:
+            yield f
+    else:
+        yield file
+
+
+def _readable(f):
+    try:
+        return hasattr(f, 'readinto') and f.seekable()
+    except (AttributeError, ValueError):
+        return False
+
+
+def _read(f, dtype, shape):
+    from cupyx import _pipelined_transfer
+    return _pipelined_transfer.to_device_pipelined(
+        f, dtype=dtype, shape=shape)
+
+
+def load_npy(file):
+    """Reads a ``.npy`` file to the device.
+
+    Returns ``None``, with the file position unchanged, if the file is not a
+    ``.npy`` file or cannot be read directly, e.g. if it holds objects.
+    """
+    with _open(file) as f:
+        if not _readable(f):
+            return None
+        start = f.tell()
+        if f.read(len(_format.MAGIC_PREFIX)) != _format.MAGIC_PREFIX:
+            f.seek(start)
+            return None
+        f.seek(start)
+        version = _format.read_magic(f)
+        if version == (1, 0):
+            header = _format.read_array_header_1_0(f)
+        elif version == (2, 0):
+            header = _format.read_array_header_2_0(f)
+        else:
+            header = None
+        if header is None or not _is_supported(header[2]):
+            f.seek(start)
+            return None
+        shape, fortran_order, dtype = header
+        if fortran_order:
+            return _read(f, dtype, shape[::-1]).T
+        return _read(f, dtype, shape)
+
+
+def fromfile(file, dtype, count, offset):
+    """Reads a raw binary file to the device.
+
+    Returns ``None`` if the file cannot be read directly.
+    """
+    dtype = numpy.dtype(dtype)
+    if not _is_supported(dtype) or dtype.itemsize == 0:
+        return None
+    with _open(file) as f:
+        if not _readable(f):
+            return None
+        start = f.tell() + offset
+        end = f.seek(0, os.SEEK_END)
+        available = max(0, end - start) // dtype.itemsize
+        if count < 0 or count > available:
+            count = available
+        f.seek(start)
+        return _read(f, dtype, (count,))
@@ -3,6 +3,7 @@ import warnings
 import numpy
 
 import cupy
+from cupy._io import _direct
 
 
 _support_allow_pickle = (numpy.lib.NumpyVersion(numpy.__version__) >= '1.10.0')
@@ -31,8 +32,10 @@ class NpzFile(object):
 def load(file, mmap_mode=None, allow_pickle=None):
     """Loads arrays or pickled objects from ``.npy``, ``.npz`` or pickled file.
 
-    This function just calls ``numpy.load`` and then sends the arrays to the
-    current device. NPZ file is converted to NpzFile object, which defers the
+    A ``.npy`` file is read into pinned staging buffers and copied to the
+    current device chunk by chunk, on a separate stream. Other files are
+    loaded by ``numpy.load``, and then the arrays are sent to the current
+    device. NPZ file is converted to NpzFile object, which defers the
     transfer to the time of accessing the items.
 
     Args:
@@ -59,6 +62,11 @@ def load(file, mmap_mode=None, allow_pickle=None):
     .. seealso:: :func:`numpy.load`
 
     """
+    if mmap_mode is None:
+        arr = _direct.load_npy(file)
+        if arr is not None:
+            return arr
+
     if _support_allow_pickle:
         allow_pickle = False if allow_pickle is None else allow_pickle
         obj = numpy.load(file, mmap_mode, allow_pickle)
@@ -1,4 +1,5 @@
 import cupy
+from cupy._core import _hash_table
 from cupy._core import _routines_logic as _logic
 from cupy._core import _fusion_thread_local
 from cupy._sorting import search as _search
@@ -121,6 +122,8 @@ def in1d(ar1, ar2, assume_unique=False, invert=False):
             return cupy.ones(ar1.shape, dtype=cupy.bool_)
         else:
             return cupy.zeros(ar1.shape, dtype=cupy.bool_)
+    if _hash_table.isin_available(ar1, ar2):
+        return _hash_table.isin(ar1, ar2, invert)
     # Use brilliant searchsorted trick
     # https://github.com/cupy/cupy/pull/4018#discussion_r495790724
     ar2 = cupy.sort(ar2)
@@ -171,12 +174,19 @@ def intersect1d(arr1, arr2, assume_unique=False, return_indices=False):
         arr1 = arr1.ravel()
         arr2 = arr2.ravel()
 
-    if not return_indices:
+    if not assume_unique and _search._tree_available(arr2, arr1):
+        # arr1 is sorted, so that the searches of chunks of arr1 are
+        # confined to short ranges of arr2
+        v1 = _search._searchsorted_sorted(arr2, arr1, False)
+        mask = _search._found_kernel(arr1, arr2, v1, arr2.size)
+        if not return_indices:
+            return arr1[mask]
+    elif not return_indices:
         mask = _search._exists_kernel(arr1, arr2, arr2.size, False)
         return arr1[mask]
-
-    mask, v1 = _search._exists_and_searchsorted_kernel(
-        arr1, arr2, arr2.size, False)
+    else:
+        mask, v1 = _search._exists_and_searchsorted_kernel(
+            arr1, arr2, arr2.size, False)
     int1d = arr1[mask]
     arr1_indices = cupy.flatnonzero(mask)
     arr2_indices = v1[mask]
@@ -5,6 +5,9 @@ import numpy
 import cupy
 import math
 from cupy import _core
+from cupy._core import _accelerator
+from cupy._core import _hash_table
+from cupy.cuda import cub
 
 
 def delete(arr, indices, axis=None):
@@ -328,7 +331,16 @@ def unique(ar, return_index=False, return_inverse=False,
 
 def _unique_1d(ar, return_index=False, return_inverse=False,
                return_counts=False, equal_nan=True, inverse_shape=None):
-    ar = cupy.asarray(ar).flatten()
+    ar = cupy.asarray(ar)
+    if _hash_table.available(ar):
+        # None if there are too many distinct values to hash them
+        ret = _hash_table.unique(
+            ar, return_index=return_index, return_inverse=return_inverse,
+            return_counts=return_counts, equal_nan=equal_nan,
+            inverse_shape=inverse_shape)
+        if ret is not None:
+            return ret if len(ret) > 1 else ret[0]
+    ar = ar.flatten()
 
     if return_index or return_inverse:
         perm = ar.argsort()
@@ -336,6 +348,11 @@ def _unique_1d(ar, return_index=False, return_inverse=False,
     else:
         ar.sort()
         aux = ar
+        if (not return_counts and _accelerator.ACCELERATOR_CUB in
+                _accelerator.get_routine_accelerators()):
+            ret = cub.cub_unique(aux, equal_nan)
+            if ret is not None:
+                return ret
     mask = cupy.empty(aux.shape, dtype=cupy.bool_)
     mask[:1] = True
     mask[1:] = aux[1:] != aux[:-1]
@@ -1,5 +1,8 @@
+import numpy
+
 import cupy
 from cupy import _core
+from cupy._core._scalar import get_typename
 from cupy._core import fusion
 from cupy import _util
 
@@ -347,6 +350,231 @@ _searchsorted_kernel = _core.ElementwiseKernel(
     name='cupy_searchsorted_kernel', preamble=_preamble+_hip_preamble)
 
 
+# Searches for many needles in a long haystack. The haystack is sampled at
+# up to 2047 evenly spaced splitters, stored in shared memory as an implicit
+# binary tree in BFS (Eytzinger) order, so that a needle walks down the top
+# levels of its search in shared memory and finishes it in a short range of
+# the haystack. For sorted needles, a block finds the range of the haystack
+# spanned by a chunk of needles first, and searches the chunk within this
+# range, read once into shared memory when it fits.
+_tree_code = _preamble + _hip_preamble + r'''
+#define TREE_CAP 2047
+#define CHUNK_ITEMS 8
+
+__device__ void searchsorted_plain(
+        const S x, const T* bins, const long long n_bins,
+        const bool side_is_right, const bool assume_increasing,
+        long long& y) {
+''' + _searchsorted_code + r'''
+}
+
+// the order of cupy.sort, with the NaNs last
+template <typename A, typename B>
+__device__ __forceinline__ bool sort_less(const A& a, const B& b) {
+    return _isnan<B>(b) ? !_isnan<A>(a) : a < b;
+}
+
+// Tells if the position of x is past the item b of the bins.
+__device__ __forceinline__ bool past(
+        const T& b, const S& x, const bool side_is_right) {
+    return side_is_right ? !sort_less(x, b) : sort_less(b, x);
+}
+
+// the position of the splitter of in-order rank r (1-based) among k
+__device__ __forceinline__ long long splitter_pos(
+        const long long r, const long long n_bins, const int k) {
+    return r * n_bins / (k + 1);
+}
+
+// With histogram, y is the bin of x (the last bin is closed), or -1 out of
+// the range of the bins.
+extern "C" __global__ void cupy_searchsorted_tree(
+        const S* __restrict__ x, const long long n_x,
+        const T* __restrict__ bins, const long long n_bins,
+        const int levels, const int side_is_right,
+        const int assume_increasing, const int histogram,
+        long long* __restrict__ y) {
+    // raw storage, as float16 has no default constructor for __shared__
+    __shared__ __align__(16) char smem[TREE_CAP * sizeof(T)];
+    T* tree = reinterpret_cast<T*>(smem);  // node j at tree[j - 1]
+    const long long stride = (long long)gridDim.x * blockDim.x;
+    const long long i0 = (long long)blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (!assume_increasing && n_bins >= 2) {
+        const bool inc = (bins[0] <= bins[n_bins-1])
+            || (!_isnan<T>(bins[0]) && _isnan<T>(bins[n_bins-1]));
+        if (!inc) {
+            for (long long i = i0; i < n_x; i += stride) {
+                long long r;
+                searchsorted_plain(x[i], bins, n_bins, side_is_right, false,
+                                   r);
+                y[i] = r;
+            }
+            return;
+        }
+    }
+
+    const int k = (1 << levels) - 1;
+    for (int j = threadIdx.x + 1; j <= k; j += blockDim.x) {
+        const int depth = 31 - __clz(j);
+        const long long rank =
+            (long long)(2 * (j - (1 << depth)) + 1) << (levels - 1 - depth);
+        tree[j - 1] = bins[splitter_pos(rank, n_bins, k)];
+    }
+    __syncthreads();
+
+    for (long long i = i0; i < n_x; i += stride) {
+        const S v = x[i];
+        int j = 1;
+        for (int d = 0; d < levels; d++) {
+            j = 2 * j + past(tree[j - 1], v, side_is_right);
+        }
+        // the number of splitters v is past
+        const int b = j - (1 << levels);
+        long long lo = (b == 0) ? 0 : splitter_pos(b, n_bins, k) + 1;
+        long long hi = (b == k) ? n_bins : splitter_pos(b + 1, n_bins, k);
+        while (lo < hi) {
+            const long long m = lo + (hi - lo) / 2;
+            if (past(bins[m], v, side_is_right)) {
+                lo = m + 1;
+            } else {
+                hi = m;
+            }
+        }
+        if (histogram) {
+            if (_isnan<S>(v) || v < bins[0] || bins[n_bins - 1] < v) {
+                lo = -1;
+            } else {
+                lo = min(lo - 1, n_bins - 2);
+            }
+        }
+        y[i] = lo;
+    }
+}
+
+// Searches for increasing needles, CHUNK_ITEMS per thread of a block.
+extern "C" __global__ void cupy_searchsorted_sorted(
+        const S* __restrict__ x, const long long n_x,
+        const T* __restrict__ bins, const long long n_bins,
+        const int side_is_right, long long* __restrict__ y) {
+    __shared__ __align__(16) char smem[TREE_CAP * sizeof(T)];
+    __shared__ long long range[2];
+    T* cache = reinterpret_cast<T*>(smem);
+    const long long chunk = (long long)blockDim.x * CHUNK_ITEMS;
+
+    for (long long start = blockIdx.x * chunk; start < n_x;
+            start += gridDim.x * chunk) {
+        const long long end = min(start + chunk, n_x);
+        if (threadIdx.x < 2) {
+            // the positions of the first and the last needles of the chunk
+            // bound those of the others
+            const S v = x[threadIdx.x == 0 ? start : end - 1];
+            long long lo = 0;
+            long long hi = n_bins;
+            while (lo < hi) {
+                const long long m = lo + (hi - lo) / 2;
+                if (past(bins[m], v, side_is_right)) {
+                    lo = m + 1;
+                } else {
+                    hi = m;
+                }
+            }
+            range[threadIdx.x] = lo;
+        }
+        __syncthreads();
+        const long long first = range[0];
+        const long long last = range[1];
+        const bool cached = (last - first) <= TREE_CAP;
+        if (cached) {
+            for (long long j = first + threadIdx.x; j < last;
+                    j += blockDim.x) {
+                cache[j - first] = bins[j];
+            }
+        }
+        __syncthreads();
+        for (long long i = start + threadIdx.x; i < end; i += blockDim.x) {
+            const S v = x[i];
+            long long lo = first;
+            long long hi = last;
+            while (lo < hi) {
+                const long long m = lo + (hi - lo) / 2;
+                const T b = cached ? cache[m - first] : bins[m];
+                if (past(b, v, side_is_right)) {
+                    lo = m + 1;
+                } else {
+                    hi = m;
+                }
+            }
+            y[i] = lo;
+        }
+        __syncthreads();
+    }
+}
+'''
+
+# Shorter haystacks stay in the L1 cache, and fewer needles do not pay for
+# the trees of the blocks.
+_tree_min_bins = 1 << 12
+_tree_min_needles = 1 << 16
+_tree_max_levels = 11
+_tree_block_size = 256
+_tree_max_blocks = 1024
+
+
+@_util.memoize(for_each_device=True)
+def _get_tree_module(s_dtype, t_dtype):
+    code = '#define S {}\n#define T {}\n'.format(
+        get_typename(s_dtype), get_typename(t_dtype))
+    return cupy.RawModule(code=code + _tree_code)
+
+
+def _tree_available(a, v):
+    return (a.dtype.kind in 'biuf' and v.dtype.kind in 'biuf'
+            and a.size >= _tree_min_bins and v.size >= _tree_min_needles)
+
+
+def _searchsorted_tree(a, v, side_is_right, assume_increasing,
+                       histogram=False):
+    # a is a 1-D haystack, and the result has the shape of v.
+    a = cupy.ascontiguousarray(a)
+    x = cupy.ascontiguousarray(v)
+    y = cupy.empty(v.shape, dtype=cupy.int64)
+    levels = min(a.size.bit_length() - 1, _tree_max_levels)
+    block = _tree_block_size
+    grid = min((x.size + block - 1) // block, _tree_max_blocks)
+    kernel = _get_tree_module(x.dtype, a.dtype).get_function(
+        'cupy_searchsorted_tree')
+    kernel((grid,), (block,),
+           (x, numpy.int64(x.size), a, numpy.int64(a.size),
+            numpy.int32(levels), numpy.int32(side_is_right),
+            numpy.int32(assume_increasing), numpy.int32(histogram), y))
+    return y
+
+
+# Tells if the needle x is at its position y in the bins.
+_found_kernel = _core.ElementwiseKernel(
+    'S x, raw T bins, int64 y, int64 n_bins',
+    'bool out',
+    'out = y < n_bins && bins[y] == x',
+    'cupy_searchsorted_found')
+
+
+def _searchsorted_sorted(a, v, side_is_right):
+    # The needles v are 1-D and sorted as by cupy.sort.
+    a = cupy.ascontiguousarray(a)
+    x = cupy.ascontiguousarray(v)
+    y = cupy.empty(v.shape, dtype=cupy.int64)
+    block = _tree_block_size
+    chunk = block * 8
+    grid = min((x.size + chunk - 1) // chunk, 65535)
+    kernel = _get_tree_module(x.dtype, a.dtype).get_function(
+        'cupy_searchsorted_sorted')
+    kernel((grid,), (block,),
+           (x, numpy.int64(x.size), a, numpy.int64(a.size),
+            numpy.int32(side_is_right), y))
+    return y
+
+
 _hip_preamble = r'''
 #ifdef __HIP_DEVICE_COMPILE__
   #define no_thread_divergence(do_work, to_return) \
@@ -461,6 +689,9 @@ def _searchsorted(a, v, side, sorter, assume_increasing):
             raise ValueError('sorter.size must equal a.size')
         a = a.take(sorter)
 
+    if _tree_available(a, v):
+        return _searchsorted_tree(a, v, side == 'right', assume_increasing)
+
     y = cupy.zeros(v.shape, dtype=cupy.int64)
 
     _searchsorted_kernel(v, a, a.size, side == 'right', assume_increasing, y)
@@ -3,8 +3,6 @@ import warnings
 import cupy
 import numpy
 
-from cupy.cuda import thrust
-
 
 def sort(a, axis=-1, kind=None):
     """Returns a sorted copy of an array with a stable sorting algorithm.
@@ -63,6 +61,7 @@ def lexsort(keys):
         raise RuntimeError('Thrust is needed to use cupy.lexsort. Please '
                            'install CUDA Toolkit with Thrust then reinstall '
                            'CuPy after uninstalling it.')
+    from cupy.cuda import thrust
 
     if keys.ndim == ():
         # as numpy.lexsort() raises
@@ -5,6 +5,10 @@ import numpy
 
 import cupy
 from cupy import _core
+from cupy._core import _accelerator
+from cupy._core import _scatter_reduce
+from cupy._sorting import search as _search
+from cupy.cuda import cub
 
 
 # rename builtin range for use in functions that take a range argument
@@ -30,7 +34,7 @@ _histogram_kernel = _core.ElementwiseKernel(
             high = mid;
         }
     }
-    atomicAdd(&y[low], U(1));
+    warpAggregatedAtomicAdd(&y[low], U(1));
     ''',
     'cupy_histogram_kernel')
 
@@ -53,11 +57,214 @@ _weighted_histogram_kernel = _core.ElementwiseKernel(
             high = mid;
         }
     }
-    atomicAdd(&y[low], (Y)weights[i]);
+    warpAggregatedAtomicAdd(&y[low], (Y)weights[i]);
     ''',
     'cupy_weighted_histogram_kernel')
 
 
+# Computes the bin of each item (-1 if out of range) for _scatter_reduce.
+_histogram_bin_kernel = _core.ElementwiseKernel(
+    'S x, raw T bins, int32 n_bins',
+    'int64 k',
+    '''
+    if (x < bins[0] or bins[n_bins - 1] < x) {
+        k = -1;
+        return;
+    }
+    int high = n_bins - 1;
+    int low = 0;
+
+    while (high - low > 1) {
+        int mid = (high + low) / 2;
+        if (bins[mid] <= x) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    k = low;
+    ''',
+    'cupy_histogram_bin_kernel')
+
+
+# The flat bin of a sample of histogramdd, or -1 for an outlier. The edges of
+# all the dimensions are concatenated, those of dimension d being
+# edges[offsets[d]:offsets[d + 1]]. The bins of the dimensions in the bit mask
+# `uniform` have the same width, so their index is computed arithmetically and
+# then corrected against the edges, which keeps the result of searchsorted.
+_histogramdd_preamble = '''
+template <typename T, typename S, typename O>
+__device__ long long cupy_histogramdd_bin(
+        const S& sample, const T& edges, const O& offsets, long long i,
+        int ndim, unsigned int uniform) {
+    long long flat = 0;
+    for (int d = 0; d < ndim; ++d) {
+        const auto x = sample[i * ndim + d];
+        const long long begin = offsets[d];
+        const long long n_bins = offsets[d + 1] - begin - 1;
+        const auto lo = edges[begin];
+        const auto hi = edges[begin + n_bins];
+        if (!(lo <= x && x <= hi)) {
+            return -1;  // also for NaN
+        }
+        long long low;
+        if (d < 32 && (uniform >> d) & 1) {
+            low = (long long)((double)(x - lo) / (double)(hi - lo) * n_bins);
+            low = min(max(low, 0LL), n_bins - 1);
+            while (low > 0 && x < edges[begin + low]) {
+                --low;
+            }
+            while (low < n_bins - 1 && edges[begin + low + 1] <= x) {
+                ++low;
+            }
+        } else {
+            // the last edge not greater than x, the right edge being in the
+            // last bin
+            low = 0;
+            long long high = n_bins;
+            while (high - low > 1) {
+                long long mid = (high + low) / 2;
+                if (edges[begin + mid] <= x) {
+                    low = mid;
+                } else {
+                    high = mid;
+                }
+            }
+        }
+        flat = flat * n_bins + low;
+    }
+    return flat;
+}
+'''
+
+
+_histogramdd_bin_kernel = _core.ElementwiseKernel(
+    'raw S sample, raw T edges, raw int64 offsets, int32 ndim, '
+    'uint32 uniform',
+    'int64 k',
+    'k = cupy_histogramdd_bin(sample, edges, offsets, i, ndim, uniform);',
+    'cupy_histogramdd_bin_kernel', preamble=_histogramdd_preamble)
+
+
+_histogramdd_kernel = _core.ElementwiseKernel(
+    'raw S sample, raw T edges, raw int64 offsets, int32 ndim, '
+    'uint32 uniform',
+    'raw U y',
+    '''
+    long long k = cupy_histogramdd_bin(
+        sample, edges, offsets, i, ndim, uniform);
+    if (k >= 0) {
+        warpAggregatedAtomicAdd(&y[k], U(1));
+    }
+    ''',
+    'cupy_histogramdd_kernel', preamble=_histogramdd_preamble)
+
+
+_weighted_histogramdd_kernel = _core.ElementwiseKernel(
+    'raw S sample, raw T edges, raw int64 offsets, int32 ndim, '
+    'uint32 uniform, raw W weights',
+    'raw Y y',
+    '''
+    long long k = cupy_histogramdd_bin(
+        sample, edges, offsets, i, ndim, uniform);
+    if (k >= 0) {
+        warpAggregatedAtomicAdd(&y[k], (Y)weights[i]);
+    }
+    ''',
+    'cupy_weighted_histogramdd_kernel', preamble=_histogramdd_preamble)
+
+
+def _histogramdd_accumulate(sample, edges, uniform, weights, y):
+    # Bins the (N, D) samples and accumulates them into the flat histogram y
+    # without the outliers, in a single pass over the samples.
+    nsamples, ndim = sample.shape
+    offsets = numpy.zeros(ndim + 1, numpy.int64)
+    offsets[1:] = numpy.cumsum([e.size for e in edges])
+    offsets = cupy.asarray(offsets)
+    edges = cupy.concatenate(edges)
+    mask = 0
+    for d in uniform:
+        if d < 32:
+            mask |= 1 << d
+    args = (sample, edges, offsets, ndim, mask)
+    if _scatter_reduce.is_beneficial(y, nsamples):
+        # privatizes the histogram in shared memory when it fits
+        k = _histogramdd_bin_kernel(
+            *args, cupy.empty(nsamples, numpy.int64))
+        _scatter_reduce.scatter_add(y, k, weights)
+    elif weights is None:
+        _histogramdd_kernel(*args, y, size=nsamples)
+    else:
+        _weighted_histogramdd_kernel(*args, weights, y, size=nsamples)
+
+
+def _histogram_accumulate(x, bin_edges, y, weights=None):
+    if _scatter_reduce.is_beneficial(y, x.size):
+        if _search._tree_available(bin_edges, x):
+            k = _search._searchsorted_tree(
+                bin_edges, x, True, True, histogram=True)
+        else:
+            k = _histogram_bin_kernel(x, bin_edges, bin_edges.size)
+        _scatter_reduce.scatter_add(y, k, weights)
+    elif weights is None:
+        _histogram_kernel(x, bin_edges, bin_edges.size, y)
+    else:
+        _weighted_histogram_kernel(x, bin_edges, bin_edges.size, weights, y)
+
+
+# The sample dtypes whose values fit in the int levels of HistogramEven
+_cub_even_dtypes = 'bBhHi'
+
+_complex_modes = {
+    'abs': cupy.abs,
+    'angle': cupy.angle,
+}
+
+
+def _histogram_cub(x, bin_edges, uniform_bins, y, complex_mode):
+    # Counts x into y by CUB, with HistogramEven for unit-width bins of
+    # integer samples and HistogramRange otherwise. Returns False when CUB
+    # cannot be used.
+    if (_accelerator.ACCELERATOR_CUB
+            not in _accelerator.get_routine_accelerators()):
+        return False
+    if x.size > 0x7fffffff or bin_edges.size > 0x7fffffff:
+        return False
+
+    if uniform_bins is not None and x.dtype.char in _cub_even_dtypes:
+        first_edge, last_edge, n_equal_bins = uniform_bins
+        if (first_edge == int(first_edge)
+                and last_edge - first_edge == n_equal_bins
+                and -(1 << 31) <= first_edge
+                and last_edge + 1 < (1 << 31)):
+            # CUB's bins exclude their upper edge, so the last edge is
+            # counted in one more bin and added to the last one
+            z = cupy.empty(n_equal_bins + 1, numpy.int64)
+            if cub.cub_histogram(
+                    x, z, n_equal_bins + 2, None, int(first_edge)) is None:
+                return False
+            y[...] = z[:-1]
+            y[-1:] += z[-1:]
+            return True
+
+    if x.dtype.kind in 'bui':
+        edges = bin_edges.astype(numpy.float64)
+    else:
+        real_type = x.real.dtype if x.dtype.kind == 'c' else x.dtype
+        bin_type = numpy.result_type(bin_edges.dtype, real_type)
+        if bin_type.char not in 'fd':
+            return False
+        if x.dtype.kind == 'c':
+            x = x.astype(bin_type.char.upper(), copy=False)
+        else:
+            x = x.astype(bin_type, copy=False)
+        edges = bin_edges.astype(bin_type)
+    # the last bin includes its upper edge, unlike those of CUB
+    edges[-1:] = cupy.nextafter(
+        edges[-1:], cupy.full(1, numpy.inf, edges.dtype))
+    return cub.cub_histogram(x, y, edges, complex_mode) is not None
+
+
 def _ravel_and_check_weights(a, weights):
     """ Check a and weights have matching shapes, and ravel both """
 
@@ -122,7 +329,9 @@ def _get_bin_edges(a, bins, range):
         range (None or tuple): Forwarded argument from `histogram`.
 
     Returns:
-        bin_edges (ndarray): Array of bin edges
+        tuple: ``(bin_edges, uniform_bins)``, where ``bin_edges`` is the
+        array of bin edges and ``uniform_bins`` is ``(first_edge, last_edge,
+        n_equal_bins)`` for bins of equal width, or None, as in NumPy.
     """
     # parse the overloaded bins argument
     n_equal_bins = None
@@ -168,10 +377,12 @@ def _get_bin_edges(a, bins, range):
         bin_edges = cupy.linspace(
             first_edge, last_edge, n_equal_bins + 1,
             endpoint=True, dtype=bin_type)
-    return bin_edges
+        return bin_edges, (first_edge, last_edge, n_equal_bins)
+    return bin_edges, None
 
 
-def histogram(x, bins=10, range=None, density=False, weights=None):
+def histogram(x, bins=10, range=None, density=False, weights=None, *,
+              complex_mode=None):
     """Computes the histogram of a set of data.
 
     Args:
@@ -192,6 +403,10 @@ def histogram(x, bins=10, range=None, density=False, weights=None):
         weights (cupy.ndarray, optional): An array of weights, of the same
             shape as `x`.  Each value in `x` only contributes its associated
             weight towards the bin count (instead of 1).
+        complex_mode (str, optional): How complex samples are binned:
+            ``'abs'`` by their magnitude and ``'angle'`` by their phase. The
+            range and the bin edges are then those of the magnitudes or the
+            phases. Complex samples are not supported without it.
     Returns:
         tuple: ``(hist, bin_edges)`` where ``hist`` is a :class:`cupy.ndarray`
         storing the values of the histogram, and ``bin_edges`` is a
@@ -201,10 +416,17 @@ def histogram(x, bins=10, range=None, density=False, weights=None):
 
         This function may synchronize the device.
 
+    .. note::
+        ``complex_mode`` is specific to CuPy. With the CUB accelerator and
+        bin edges given as an array, the magnitudes or the phases are binned
+        without being stored.
+
     .. seealso:: :func:`numpy.histogram`
     """
 
-    if x.dtype.kind == 'c':
+    if complex_mode is not None and complex_mode not in _complex_modes:
+        raise ValueError('unknown complex_mode: {}'.format(complex_mode))
+    if x.dtype.kind == 'c' and complex_mode is None:
         # TODO(unno): comparison between complex numbers is not implemented
         raise NotImplementedError('complex number is not supported')
 
@@ -212,14 +434,20 @@ def histogram(x, bins=10, range=None, density=False, weights=None):
         raise ValueError('x must be a cupy.ndarray')
 
     x, weights = _ravel_and_check_weights(x, weights)
-    bin_edges = _get_bin_edges(x, bins, range)
+    if x.dtype.kind != 'c':
+        complex_mode = None
+    elif weights is not None or numpy.ndim(bins) != 1:
+        # the range is found from the magnitudes or the phases
+        x = _complex_modes[complex_mode](x)
+        complex_mode = None
+    bin_edges, uniform_bins = _get_bin_edges(x, bins, range)
 
     if weights is None:
         y = cupy.zeros(bin_edges.size - 1, dtype=cupy.int64)
-        # TODO(leofang): we temporarily remove CUB histogram support for now,
-        # see cupy/cupy#7698. When it's ready, revert the commit that checked
-        # in this comment to restore the support.
-        _histogram_kernel(x, bin_edges, bin_edges.size, y)
+        if not _histogram_cub(x, bin_edges, uniform_bins, y, complex_mode):
+            if complex_mode is not None:
+                x = _complex_modes[complex_mode](x)
+            _histogram_accumulate(x, bin_edges, y)
     else:
         simple_weights = (
             cupy.can_cast(weights.dtype, cupy.float64) or
@@ -241,8 +469,7 @@ def histogram(x, bins=10, range=None, density=False, weights=None):
                 y = cupy.zeros(bin_edges.size - 1, dtype=int)
             else:
                 y = cupy.zeros(bin_edges.size - 1, dtype=cupy.float64)
-            _weighted_histogram_kernel(
-                x, bin_edges, bin_edges.size, weights, y)
+            _histogram_accumulate(x, bin_edges, y, weights)
 
     if density:
         db = cupy.array(cupy.diff(bin_edges), cupy.float64)
@@ -312,6 +539,7 @@ def histogramdd(sample, bins=10, range=None, weights=None, density=False):
     nbin = numpy.empty(ndim, int)
     edges = ndim * [None]
     dedges = ndim * [None]
+    uniform = []
     if weights is not None:
         weights = cupy.asarray(weights)
 
@@ -345,6 +573,7 @@ def histogramdd(sample, bins=10, range=None, weights=None, density=False):
                     if issubclass(sample.dtype.type, numpy.inexact)
                     else numpy.float64)
             edges[i] = cupy.linspace(smin, smax, num, dtype=dtyp)
+            uniform.append(i)
         elif cupy.ndim(bins[i]) == 1:
             if not isinstance(bins[i], cupy.ndarray):
                 raise ValueError('array-like bins not supported')
@@ -362,39 +591,28 @@ def histogramdd(sample, bins=10, range=None, weights=None, density=False):
         nbin[i] = len(edges[i]) + 1  # includes an outlier on each end
         dedges[i] = cupy.diff(edges[i])
 
-    # Compute the bin number each sample falls into.
-    ncount = tuple(
-        # avoid cupy.digitize to work around NumPy issue gh-11022
-        cupy.searchsorted(edges[i], sample[:, i], side='right')
-        for i in _range(ndim)
-    )
-
-    # Using digitize, values that fall on an edge are put in the right bin.
-    # For the rightmost bin, we want values equal to the right edge to be
-    # counted in the last bin, and not as an outlier.
-    for i in _range(ndim):
-        # Find which points are on the rightmost edge.
-        on_edge = sample[:, i] == edges[i][-1]
-        # Shift these points one bin to the left.
-        ncount[i][on_edge] -= 1
-
-    # Compute the sample indices in the flattened histogram matrix.
-    # This raises an error if the array is too large.
-    xy = cupy.ravel_multi_index(ncount, nbin)
-
-    # Compute the number of repetitions in xy and assign it to the
-    # flattened histmat.
-    hist = cupy.bincount(xy, weights, minlength=numpy.prod(nbin))
-
-    # Shape into a proper matrix
-    hist = hist.reshape(nbin)
+    # The samples are compared with the edges as searchsorted does, values
+    # on an edge going to the right bin except for the rightmost edge, which
+    # is in the last bin. The outliers are dropped.
+    dtype = numpy.result_type(sample.dtype, *[e.dtype for e in edges])
+    sample = cupy.ascontiguousarray(sample, dtype)
+    hist_size = int(numpy.prod(nbin - 2))
+    if weights is None:
+        hist = cupy.zeros(hist_size, numpy.int64)
+    else:
+        # as bincount does
+        weights = cupy.ascontiguousarray(weights.ravel(), numpy.float64)
+        if weights.size != nsamples:
+            raise ValueError(
+                'The weights and list don\'t have the same length.')
+        hist = cupy.zeros(hist_size, numpy.float64)
+    _histogramdd_accumulate(
+        sample, [e.astype(dtype, copy=False) for e in edges], uniform,
+        weights, hist)
 
     # This preserves the (bad) behavior observed in NumPy gh-7845, for now.
     hist = hist.astype(float)  # Note: NumPy uses casting='safe' here too
-
-    # Remove outliers (indices 0 and -1 for each dimension).
-    core = ndim * (slice(1, -1),)
-    hist = hist[core]
+    hist = hist.reshape(tuple(nbin - 2))
 
     if density:
         # calculate the probability density function
@@ -469,18 +687,6 @@ def histogram2d(x, y, bins=10, range=None, weights=None, density=None):
     return hist, edges[0], edges[1]
 
 
-_bincount_kernel = _core.ElementwiseKernel(
-    'S x', 'raw U bin',
-    'atomicAdd(&bin[x], U(1))',
-    'cupy_bincount_kernel')
-
-
-_bincount_with_weight_kernel = _core.ElementwiseKernel(
-    'S x, T w', 'raw U bin',
-    'atomicAdd(&bin[x], w)',
-    'cupy_bincount_with_weight_kernel')
-
-
 def bincount(x, weights=None, minlength=None):
     """Count number of occurrences of each value in array of non-negative ints.
 
@@ -525,10 +731,10 @@ def bincount(x, weights=None, minlength=None):
         # TODO(leofang): we temporarily remove CUB histogram support for now,
         # see cupy/cupy#7698. When it's ready, revert the commit that checked
         # in this comment to restore the support.
-        _bincount_kernel(x, b)
+        _scatter_reduce.scatter_add(b, x)
     else:
         b = cupy.zeros((size,), dtype=numpy.float64)
-        _bincount_with_weight_kernel(x, weights, b)
+        _scatter_reduce.scatter_add(b, x, weights)
 
     return b
 
@@ -6,6 +6,7 @@ import cupy
 from cupy import _core
 from cupy._core import _routines_statistics as _statistics
 from cupy._core import _fusion_thread_local
+from cupy._core import _selection
 from cupy._logic import content
 
 
@@ -202,10 +203,7 @@ def _quantile_unchecked(a, q, axis=None, out=None,
                 keepdim[ax % a.ndim] = 1
             keepdim = tuple(keepdim)
     if axis is None:
-        if overwrite_input:
-            ap = a.ravel()
-        else:
-            ap = a.flatten()
+        ap = a.ravel()
         nkeep = 0
     else:
         # Reduce axes from a and put them last
@@ -214,11 +212,30 @@ def _quantile_unchecked(a, q, axis=None, out=None,
         nkeep = len(keep)
         for i, s in enumerate(sorted(keep)):
             a = a.swapaxes(i, s)
-        if overwrite_input:
-            ap = a.reshape(a.shape[:nkeep] + (-1,))
-        else:
-            ap = a.reshape(a.shape[:nkeep] + (-1,)).copy()
+        ap = a.reshape(a.shape[:nkeep] + (-1,))
+
+    if (out is None and method in _selection.quantile_methods
+            and _selection.available(ap, q.size)):
+        # only the order statistics around the quantiles are searched for,
+        # and the input is only read
+        ret = _selection.quantile(ap, q, method, dtype)
+    else:
+        # the rows are sorted in place; ravel and reshape may have copied
+        if not overwrite_input and cupy.may_share_memory(ap, a):
+            ap = ap.copy()
+        ret = _quantile_sorted(ap, q, out, method, dtype)
+
+    if zerod:
+        ret = ret.squeeze(0)
+    if keepdims:
+        if q.size > 1:
+            keepdim = (-1,) + keepdim
+        ret = ret.reshape(keepdim)
 
+    return _core._internal_ascontiguousarray(ret)
+
+
+def _quantile_sorted(ap, q, out, method, dtype):
     axis = -1
     ap.sort(axis=axis)
     Nx = ap.shape[axis]
@@ -275,15 +292,7 @@ def _quantile_unchecked(a, q, axis=None, out=None,
             'cupy_percentile_weightnening'
         )(indices, ap, ap.shape[-1] if ap.ndim > 1 else 0, ap.size, ret)
         ret = cupy.rollaxis(ret, -1)  # Roll q dimension back to first axis
-
-    if zerod:
-        ret = ret.squeeze(0)
-    if keepdims:
-        if q.size > 1:
-            keepdim = (-1,) + keepdim
-        ret = ret.reshape(keepdim)
-
-    return _core._internal_ascontiguousarray(ret)
+    return ret
 
 
 def _quantile_is_valid(q):
@@ -39,11 +39,6 @@ try:
 except ImportError:
     nvtx = _UnavailableModule('cupy.cuda.nvtx')
 
-try:
-    from cupy.cuda import thrust  # NOQA
-except ImportError:
-    thrust = _UnavailableModule('cupy.cuda.thrust')
-
 
 def __getattr__(key):
     if key == 'cusolver':
@@ -62,6 +57,15 @@ def __getattr__(key):
         from cupy_backends.cuda.libs import cublas
         _cupy.cuda.cublas = cublas
         return cublas
+    elif key == 'thrust':
+        # The sort kernels are the largest part of the fat binaries, so the
+        # module is loaded on the first sort.
+        try:
+            import cupy.cuda.thrust as thrust
+        except ImportError:
+            thrust = _UnavailableModule('cupy.cuda.thrust')
+        _cupy.cuda.thrust = thrust
+        return thrust
     elif key == 'jitify':
         if not runtime.is_hip and driver.get_build_version() > 0:
             import cupy.cuda.jitify as jitify
@@ -129,6 +133,10 @@ from cupy.cuda.memory import MemoryAsync  # NOQA
 from cupy.cuda.memory import MemoryPointer  # NOQA
 from cupy.cuda.memory import MemoryPool  # NOQA
 from cupy.cuda.memory import MemoryAsyncPool  # NOQA
+from cupy.cuda.memory import ImportedMemoryAsyncPool  # NOQA
+from cupy.cuda.memory import malloc_virtual  # NOQA
+from cupy.cuda.memory import SystemMemoryAllocator  # NOQA
+from cupy.cuda.memory import VirtualMemory  # NOQA
 from cupy.cuda.memory import PythonFunctionAllocator  # NOQA
 from cupy.cuda.memory import CFunctionAllocator  # NOQA
 from cupy.cuda.memory import set_allocator  # NOQA
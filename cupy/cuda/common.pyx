@@ -3,6 +3,8 @@ from cupy.cuda cimport device
 
 import numpy
 
+from cupy._core._dtype import bfloat16 as _bfloat16
+
 
 cpdef int _get_dtype_id(dtype) except -1:
     cdef int ret
@@ -35,6 +37,8 @@ cpdef int _get_dtype_id(dtype) except -1:
         ret = CUPY_TYPE_COMPLEX128
     elif dtype == numpy.bool_:
         ret = CUPY_TYPE_BOOL
+    elif _bfloat16 is not None and dtype == _bfloat16:
+        ret = CUPY_TYPE_BFLOAT16
     else:
         raise ValueError('Unsupported dtype ({})'.format(dtype))
     return ret
@@ -57,3 +61,22 @@ cpdef int _is_fp16_supported() except -2:
     else:
         _has_fp16 = 1
     return _has_fp16
+
+
+cdef int _has_bf16 = -1
+
+
+cpdef int _is_bf16_supported() except -2:
+    global _has_bf16
+
+    if _has_bf16 != -1:
+        return _has_bf16
+
+    # The bfloat16 instantiations are only built for CUDA on sm_80+.
+    if runtime._is_hip_environment:
+        _has_bf16 = 0
+    elif int(device.get_compute_capability()) < 80:
+        _has_bf16 = 0
+    else:
+        _has_bf16 = 1
+    return _has_bf16
@@ -1,13 +1,18 @@
+import concurrent.futures
 import copy
 import hashlib
+import json
 import math
+import mmap
 import os
 import platform
 import re
 import shutil
+import struct
 import subprocess
 import sys
 import tempfile
+import threading
 from typing import Optional
 import warnings
 
@@ -504,6 +509,221 @@ def get_cache_dir():
 
 _empty_file_preprocess_cache: dict = {}
 
+# Compilations in progress, so that a thread requesting a kernel that another
+# thread (e.g. a prefetch worker) is compiling waits for its result.
+_in_flight_lock = threading.Lock()
+_in_flight_compiles: dict = {}
+
+
+# Kernel cache bundles: the entries of a cache directory packed into a single
+# file, that is mapped into memory and looked up before the directory. The
+# layout is: magic, the length of the JSON metadata and the metadata, the
+# number of entries, the index of (name length, name, offset, size) sorted by
+# name, and the binaries (as stored in the cache files, i.e. with the hash).
+_bundle_magic = b'CUPYKCB1'
+_bundle_lock = threading.Lock()
+_bundles: list = []
+_bundles_from_env_loaded = False
+
+
+def _get_cupy_cache_key():
+    if runtime.is_hip:
+        from cupy import _version
+        return _version.__version__
+    from cupy.cuda import jitify
+    return jitify.get_cupy_cache_key()
+
+
+def _get_bundle_arch():
+    if runtime.is_hip:
+        return device.Device().compute_capability
+    return _get_arch()
+
+
+class _CacheBundle:
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self._mmap = m = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        if m[:8] != _bundle_magic:
+            raise ValueError(f'not a CuPy kernel cache bundle: {path}')
+        meta_size, = struct.unpack_from('<Q', m, 8)
+        offset = 16 + meta_size
+        self.metadata = json.loads(m[16:offset].decode())
+        count, = struct.unpack_from('<Q', m, offset)
+        offset += 8
+        self._index = {}
+        for _ in range(count):
+            name_size, = struct.unpack_from('<H', m, offset)
+            offset += 2
+            name = m[offset:offset + name_size].decode()
+            offset += name_size
+            self._index[name] = struct.unpack_from('<QQ', m, offset)
+            offset += 16
+
+    def __len__(self):
+        return len(self._index)
+
+    def get(self, name):
+        entry = self._index.get(name)
+        if entry is None:
+            return None
+        start, size = entry
+        return self._mmap[start:start + size]
+
+
+def load_cache_bundle(path):
+    """Loads a kernel cache bundle.
+
+    The kernels in the bundle are looked up before the cache directory. A
+    bundle made for another CuPy build, backend or architecture is ignored
+    with a warning.
+
+    Args:
+        path (str): The bundle made by :func:`export_cache_bundle`.
+
+    Returns:
+        bool: Whether the bundle is used.
+
+    """
+    bundle = _CacheBundle(path)
+    meta = bundle.metadata
+    expected = {
+        'cupy_cache_key': _get_cupy_cache_key(),
+        'backend': 'hip' if runtime.is_hip else 'cuda',
+        'arch': _get_bundle_arch(),
+    }
+    for key, value in expected.items():
+        if meta.get(key) != value:
+            warnings.warn(
+                f'Ignoring the kernel cache bundle {path}, which was made '
+                f'for {key} {meta.get(key)!r} instead of {value!r}')
+            return False
+    with _bundle_lock:
+        _bundles.append(bundle)
+    return True
+
+
+def export_cache_bundle(path, cache_dir=None, arch=None):
+    """Packs the kernel cache into a single bundle file.
+
+    Args:
+        path (str): The bundle to write.
+        cache_dir (str): The cache directory. Defaults to
+            :envvar:`CUPY_CACHE_DIR`.
+        arch (str): The architecture of the devices that will use the
+            bundle. Defaults to that of the current device. The cache file
+            names depend on the architecture, so only the kernels compiled
+            for it are looked up on such devices.
+
+    Returns:
+        int: The number of kernels in the bundle.
+
+    .. note::
+        Load the bundle with :func:`load_cache_bundle`, or by setting
+        :envvar:`CUPY_CACHE_BUNDLE`.
+
+    """
+    if cache_dir is None:
+        cache_dir = get_cache_dir()
+    if arch is None:
+        arch = _get_bundle_arch()
+    suffix = '.hsaco' if runtime.is_hip else '.cubin'
+    entries = []
+    for name in sorted(os.listdir(cache_dir)):
+        if not name.endswith(suffix):
+            continue
+        with open(os.path.join(cache_dir, name), 'rb') as f:
+            data = f.read()
+        # skip corrupted entries, as when reading them
+        hash_value = data[:_hash_length]
+        binary_hash = _hash_hexdigest(data[_hash_length:]).encode('ascii')
+        if len(data) >= _hash_length and hash_value == binary_hash:
+            entries.append((name.encode(), data))
+
+    meta = json.dumps({
+        'cupy_cache_key': _get_cupy_cache_key(),
+        'backend': 'hip' if runtime.is_hip else 'cuda',
+        'arch': str(arch),
+    }).encode()
+    offset = 16 + len(meta) + 8 + sum(2 + len(n) + 16 for n, _ in entries)
+    directory = os.path.dirname(os.path.abspath(path))
+    with tempfile.NamedTemporaryFile(dir=directory, delete=False) as f:
+        f.write(_bundle_magic)
+        f.write(struct.pack('<Q', len(meta)))
+        f.write(meta)
+        f.write(struct.pack('<Q', len(entries)))
+        for name, data in entries:
+            f.write(struct.pack('<H', len(name)))
+            f.write(name)
+            f.write(struct.pack('<QQ', offset, len(data)))
+            offset += len(data)
+        for _, data in entries:
+            f.write(data)
+        temp_path = f.name
+    os.replace(temp_path, path)
+    return len(entries)
+
+
+def _get_installed_bundle_path(arch=None):
+    # The bundle of the core kernels built into the package by
+    # `python -m cupyx.tools.kernel_cache_bundle build`, one per architecture.
+    if arch is None:
+        arch = _get_bundle_arch()
+    backend = 'hip' if runtime.is_hip else 'cuda'
+    return os.path.join(
+        _environment.get_cupy_install_path(), 'cupy', '.data',
+        'kernel_bundles', f'{backend}_{arch}.bundle')
+
+
+def _get_bundled_binary(name):
+    global _bundles_from_env_loaded
+    if not _bundles_from_env_loaded:
+        with _bundle_lock:
+            paths = os.environ.get('CUPY_CACHE_BUNDLE', '').split(os.pathsep)
+            _bundles_from_env_loaded = True
+        paths = [path for path in paths if path]
+        # the bundles of the user take precedence over the installed one
+        installed = _get_installed_bundle_path()
+        if os.path.isfile(installed):
+            paths.append(installed)
+        for path in paths:
+            try:
+                load_cache_bundle(path)
+            except (OSError, ValueError) as e:
+                warnings.warn(
+                    f'Cannot load the kernel cache bundle {path}: {e}')
+    for bundle in _bundles:
+        data = bundle.get(name)
+        if data is None:
+            continue
+        binary = data[_hash_length:]
+        if data[:_hash_length] == _hash_hexdigest(binary).encode('ascii'):
+            return binary
+    return None
+
+
+def _compile_once(key, func):
+    with _in_flight_lock:
+        future = _in_flight_compiles.get(key)
+        is_owner = future is None
+        if is_owner:
+            future = concurrent.futures.Future()
+            _in_flight_compiles[key] = future
+    if not is_owner:
+        return future.result()
+    try:
+        result = func()
+    except BaseException as e:
+        future.set_exception(e)
+        raise
+    else:
+        future.set_result(result)
+        return result
+    finally:
+        with _in_flight_lock:
+            del _in_flight_compiles[key]
+
 
 def _compile_module_with_cache(
         source, options=(), arch=None, cache_dir=None, extra_source=None,
@@ -524,6 +744,11 @@ def _compile_module_with_cache(
         _get_bool_env_variable('CUPY_CACHE_IN_MEMORY', False)
         and backend == 'nvrtc')
 
+    # Kernels can also opt in individually by passing this option.
+    if (_get_bool_env_variable('CUPY_COMPLEX_FAST_MATH', False)
+            and '-DCUPY_COMPLEX_FAST_MATH' not in options):
+        options += ('-DCUPY_COMPLEX_FAST_MATH',)
+
     if runtime.is_hip:
         backend = 'hiprtc' if backend == 'nvrtc' else 'hipcc'
         return _compile_with_cache_hip(
@@ -583,6 +808,12 @@ def _compile_with_cache_cuda(
 
     mod = function.Module()
 
+    if not name_expressions:
+        cubin = _get_bundled_binary(name)
+        if cubin is not None:
+            mod.load(cubin)
+            return mod
+
     if not cache_in_memory:
         # Read from disk cache
         if not os.path.isdir(cache_dir):
@@ -607,29 +838,43 @@ def _compile_with_cache_cuda(
         # so we do nothing
         pass
 
-    if backend == 'nvrtc':
-        cu_name = '' if cache_in_memory else name + '.cu'
-        ptx, mapping = compile_using_nvrtc(
-            source, options, arch, cu_name, name_expressions,
-            log_stream, cache_in_memory, jitify)
-        if _is_cudadevrt_needed(options):
-            # for separate compilation
-            ls = function.LinkState()
-            ls.add_ptr_data(ptx, 'cupy.ptx')
-            _cudadevrt = _get_cudadevrt_path()
-            ls.add_ptr_file(_cudadevrt)
-            cubin = ls.complete()
+    def compile():
+        mapping = None
+        if backend == 'nvrtc':
+            cu_name = '' if cache_in_memory else name + '.cu'
+            ptx, mapping = compile_using_nvrtc(
+                source, options, arch, cu_name, name_expressions,
+                log_stream, cache_in_memory, jitify)
+            if _is_cudadevrt_needed(options):
+                # for separate compilation
+                ls = function.LinkState()
+                ls.add_ptr_data(ptx, 'cupy.ptx')
+                _cudadevrt = _get_cudadevrt_path()
+                ls.add_ptr_file(_cudadevrt)
+                cubin = ls.complete()
+            else:
+                cubin = ptx
+        elif backend == 'nvcc':
+            rdc = _is_cudadevrt_needed(options)
+            cubin = compile_using_nvcc(source, options, arch,
+                                       name + '.cu', code_type='cubin',
+                                       separate_compilation=rdc,
+                                       log_stream=log_stream)
         else:
-            cubin = ptx
-        mod._set_mapping(mapping)
-    elif backend == 'nvcc':
-        rdc = _is_cudadevrt_needed(options)
-        cubin = compile_using_nvcc(source, options, arch,
-                                   name + '.cu', code_type='cubin',
-                                   separate_compilation=rdc,
-                                   log_stream=log_stream)
+            raise ValueError('Invalid backend %s' % backend)
+        return cubin, mapping
+
+    if log_stream is None:
+        # The log is only written by the thread that compiles, so the
+        # requests with a log stream are not shared.
+        cubin, mapping = _compile_once(
+            (name, cache_in_memory,
+             None if name_expressions is None else tuple(name_expressions)),
+            compile)
     else:
-        raise ValueError('Invalid backend %s' % backend)
+        cubin, mapping = compile()
+    if mapping is not None:
+        mod._set_mapping(mapping)
 
     if not cache_in_memory:
         # Write to disk cache
@@ -737,8 +982,9 @@ class _NVRTCProgram(object):
                 return nvrtc.getCUBIN(self.ptr), mapping
             elif self.method == 'ptx':
                 return nvrtc.getPTX(self.ptr), mapping
-            # TODO(leofang): support JIT LTO using nvrtc.getNVVM()?
-            # need -dlto and -arch=compute_XX
+            elif self.method == 'ltoir':
+                # needs -dlto and -arch=compute_XX
+                return nvrtc.getNVVM(self.ptr), mapping
             else:
                 raise RuntimeError('Unknown NVRTC compile method')
         except nvrtc.NVRTCError:
@@ -922,6 +1168,12 @@ def _compile_with_cache_hip(source, options, arch, cache_dir, extra_source,
 
     mod = function.Module()
 
+    if not name_expressions:
+        binary = _get_bundled_binary(name)
+        if binary is not None:
+            mod.load(binary)
+            return mod
+
     if not cache_in_memory:
         # Read from disk cache
         if not os.path.isdir(cache_dir):
@@ -946,14 +1198,23 @@ def _compile_with_cache_hip(source, options, arch, cache_dir, extra_source,
         # so we do nothing
         pass
 
-    if backend == 'hiprtc':
-        # compile_using_nvrtc calls hiprtc for hip builds
-        binary, mapping = compile_using_nvrtc(
-            source, options, arch, name + '.cu', name_expressions,
-            log_stream, cache_in_memory)
-        mod._set_mapping(mapping)
+    def compile():
+        if backend == 'hiprtc':
+            # compile_using_nvrtc calls hiprtc for hip builds
+            return compile_using_nvrtc(
+                source, options, arch, name + '.cu', name_expressions,
+                log_stream, cache_in_memory)
+        return compile_using_hipcc(source, options, arch, log_stream), None
+
+    if log_stream is None:
+        binary, mapping = _compile_once(
+            (name, cache_in_memory,
+             None if name_expressions is None else tuple(name_expressions)),
+            compile)
     else:
-        binary = compile_using_hipcc(source, options, arch, log_stream)
+        binary, mapping = compile()
+    if mapping is not None:
+        mod._set_mapping(mapping)
 
     if not cache_in_memory:
         # Write to disk cache
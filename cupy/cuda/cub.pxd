@@ -10,11 +10,43 @@ cpdef enum cupy_cub_op:
     CUPY_CUB_CUMSUM = 5
     CUPY_CUB_CUMPROD = 6
     CUPY_CUB_PROD = 7
+    CUPY_CUB_EXCLUSIVE_CUMSUM = 8
+    CUPY_CUB_EXCLUSIVE_CUMPROD = 9
+    CUPY_CUB_CUMMIN = 10
+    CUPY_CUB_CUMMAX = 11
+    CUPY_CUB_EXCLUSIVE_CUMMIN = 12
+    CUPY_CUB_EXCLUSIVE_CUMMAX = 13
+
+
+cpdef enum cupy_cub_nan_op:
+    CUPY_CUB_NANSUM = 0
+    CUPY_CUB_NANMEAN = 1
+    CUPY_CUB_NANVAR = 2
+
+
+cpdef enum cupy_cub_select_op:
+    CUPY_CUB_SELECT_NONZERO = 0
+    CUPY_CUB_SELECT_NOT_NAN = 1
+    CUPY_CUB_SELECT_GREATER = 2
+    CUPY_CUB_SELECT_GREATER_EQUAL = 3
+    CUPY_CUB_SELECT_LESS = 4
+    CUPY_CUB_SELECT_LESS_EQUAL = 5
+    CUPY_CUB_SELECT_EQUAL = 6
+    CUPY_CUB_SELECT_NOT_EQUAL = 7
 
 
 # TODO(leofang): cimport these in other modules?
 cpdef cub_reduction(_ndarray_base arr, op,
                     axis=*, dtype=*, _ndarray_base out=*, keepdims=*)
+cpdef cub_nan_reduction(_ndarray_base arr, op, axis=*, dtype=*,
+                        _ndarray_base out=*, keepdims=*, Py_ssize_t ddof=*)
 cpdef cub_scan(_ndarray_base arr, op)
+cpdef cub_scan_by_key(_ndarray_base arr, op, _ndarray_base keys=*,
+                      Py_ssize_t segment_size=*)
+
+cpdef cub_nonzero(_ndarray_base arr)
+cpdef cub_nonzero_bounded(_ndarray_base arr, _ndarray_base out=*)
+cpdef cub_select_flagged(_ndarray_base arr, _ndarray_base mask)
+cpdef cub_unique(_ndarray_base arr, bint equal_nan=*)
 
 cpdef bint _cub_device_segmented_reduce_axis_compatible(tuple, Py_ssize_t, str)
@@ -3,18 +3,19 @@
 """Wrapper of CUB functions for CuPy API."""
 
 from cpython cimport sequence
-from libc.stdint cimport intptr_t
+from libc.stdint cimport intptr_t, int64_t
 
-from cupy_backends.cuda.api cimport runtime
 from cupy._core.core cimport _internal_ascontiguousarray
 from cupy._core.internal cimport _contig_axes, is_in
 from cupy.cuda cimport common
 from cupy.cuda cimport device
+from cupy.cuda cimport function
 from cupy.cuda cimport memory
 from cupy.cuda cimport stream
 
 import cupy
 import cupy._core as _core
+from cupy._core._dtype import bfloat16 as _bfloat16
 from cupy.cuda import memory as _memory
 import numpy
 
@@ -43,6 +44,11 @@ CUB_sum_support_dtype_with_half = \
 
 CUB_sum_support_dtype = {}
 
+CUB_scan_ops = (CUPY_CUB_CUMSUM, CUPY_CUB_CUMPROD,
+                CUPY_CUB_CUMMIN, CUPY_CUB_CUMMAX,
+                CUPY_CUB_EXCLUSIVE_CUMSUM, CUPY_CUB_EXCLUSIVE_CUMPROD,
+                CUPY_CUB_EXCLUSIVE_CUMMIN, CUPY_CUB_EXCLUSIVE_CUMMAX)
+
 
 ###############################################################################
 # Extern
@@ -51,27 +57,63 @@ CUB_sum_support_dtype = {}
 cdef extern from 'cupy_cub.h' nogil:
     ctypedef void* Stream_t 'cudaStream_t'
 
-    void cub_device_reduce(void*, size_t&, void*, void*, int, Stream_t,
+    void cub_device_reduce(void*, size_t&, void*, void*, int64_t, Stream_t,
                            int, int)
-    void cub_device_segmented_reduce(void*, size_t&, void*, void*, int, int,
-                                     Stream_t, int, int)
+    void cub_device_multi_reduce(void*, size_t&, void*, void*, void*, int,
+                                 Stream_t, int, int)
+    void cub_device_nan_reduce(void*, size_t&, void*, void*, int, Stream_t,
+                               int, int, int64_t)
+    void cub_device_segmented_reduce(void*, size_t&, void*, void*, int,
+                                     int64_t, Stream_t, int, int)
     void cub_device_spmv(void*, size_t&, void*, void*, void*, void*, void*,
-                         int, int, int, Stream_t, int)
-    void cub_device_scan(void*, size_t&, void*, void*, int, Stream_t, int, int)
+                         int64_t, int64_t, Stream_t, int, int)
+    void cub_device_spmm(void*, void*, void*, void*, void*, int64_t, int64_t,
+                         Stream_t, int, int)
+    void cub_device_scan(void*, size_t&, void*, void*, int64_t, Stream_t, int,
+                         int)
+    void cub_device_scan_by_key(void*, size_t&, void*, void*, void*, int64_t,
+                                int64_t, Stream_t, int, int, int)
+    void cub_device_reduce_by_key(void*, size_t&, void*, void*, void*, void*,
+                                  void*, int64_t, Stream_t, int, int)
+    void cub_device_select_flagged(void*, size_t&, void*, void*, void*, void*,
+                                   int64_t, Stream_t, int, int)
+    void cub_device_select_if(void*, size_t&, void*, void*, void*, int64_t,
+                              void*, Stream_t, int, int)
+    void cub_device_unique(void*, size_t&, void*, void*, void*, int64_t,
+                           bint, Stream_t, int)
+    void cub_device_partition(void*, size_t&, void*, void*, void*, void*,
+                              int64_t, Stream_t, int)
     void cub_device_histogram_range(void*, size_t&, void*, void*, int, void*,
-                                    size_t, Stream_t, int)
+                                    size_t, Stream_t, int, int)
     void cub_device_histogram_even(void*, size_t&, void*, void*, int, int, int,
                                    size_t, Stream_t, int)
-    size_t cub_device_reduce_get_workspace_size(void*, void*, int, Stream_t,
-                                                int, int)
+    size_t cub_device_reduce_get_workspace_size(void*, void*, int64_t,
+                                                Stream_t, int, int)
+    size_t cub_device_multi_reduce_get_workspace_size(
+        void*, void*, void*, int, Stream_t, int, int)
+    size_t cub_device_nan_reduce_get_workspace_size(
+        void*, void*, int, Stream_t, int, int)
     size_t cub_device_segmented_reduce_get_workspace_size(
-        void*, void*, int, int, Stream_t, int, int)
+        void*, void*, int, int64_t, Stream_t, int, int)
     size_t cub_device_spmv_get_workspace_size(
-        void*, void*, void*, void*, void*, int, int, int, Stream_t, int)
+        void*, void*, void*, void*, void*, int64_t, int64_t, Stream_t, int,
+        int)
     size_t cub_device_scan_get_workspace_size(
-        void*, void*, int, Stream_t, int, int)
+        void*, void*, int64_t, Stream_t, int, int)
+    size_t cub_device_scan_by_key_get_workspace_size(
+        void*, void*, void*, int64_t, int64_t, Stream_t, int, int, int)
+    size_t cub_device_reduce_by_key_get_workspace_size(
+        void*, void*, void*, void*, void*, int64_t, Stream_t, int, int)
+    size_t cub_device_select_flagged_get_workspace_size(
+        void*, void*, void*, void*, int64_t, Stream_t, int, int)
+    size_t cub_device_select_if_get_workspace_size(
+        void*, void*, void*, int64_t, void*, Stream_t, int, int)
+    size_t cub_device_unique_get_workspace_size(
+        void*, void*, void*, int64_t, bint, Stream_t, int)
+    size_t cub_device_partition_get_workspace_size(
+        void*, void*, void*, void*, int64_t, Stream_t, int)
     size_t cub_device_histogram_range_get_workspace_size(
-        void*, void*, int, void*, size_t, Stream_t, int)
+        void*, void*, int, void*, size_t, Stream_t, int, int)
     size_t cub_device_histogram_even_get_workspace_size(
         void*, void*, int, int, int, size_t, Stream_t, int)
 
@@ -139,7 +181,8 @@ def device_reduce(_ndarray_base x, op, tuple reduce_axis, tuple out_axis,
                   out=None, bint keepdims=False):
     cdef _ndarray_base y
     cdef memory.MemoryPointer ws
-    cdef int dtype_id, ndim_out, kv_bytes, x_size, op_code
+    cdef int dtype_id, ndim_out, kv_bytes, op_code
+    cdef int64_t x_size
     cdef size_t ws_size
     cdef void *x_ptr
     cdef void *y_ptr
@@ -185,15 +228,18 @@ def device_reduce(_ndarray_base x, op, tuple reduce_axis, tuple out_axis,
     y_ptr = <void *>y.data.ptr
     dtype_id = common._get_dtype_id(x.dtype)
     s = <Stream_t>stream.get_current_stream_ptr()
-    x_size = <int>x.size
-    ws_size = cub_device_reduce_get_workspace_size(x_ptr, y_ptr, x.size, s,
+    x_size = <int64_t>x.size
+    ws_size = cub_device_reduce_get_workspace_size(x_ptr, y_ptr, x_size, s,
                                                    op, dtype_id)
     ws = memory.alloc(ws_size)
     ws_ptr = <void *>ws.ptr
     op_code = <int>op
+    ranged = function._push_range('cub::reduce', (x, y), <intptr_t>s)
     with nogil:
         cub_device_reduce(ws_ptr, ws_size, x_ptr, y_ptr, x_size, s, op_code,
                           dtype_id)
+    if ranged:
+        function._pop_range(ranged, <intptr_t>s)
     if op in (CUPY_CUB_ARGMIN, CUPY_CUB_ARGMAX):
         # get key from KeyValuePair: need to reinterpret the first 4 bytes
         # and then cast it
@@ -208,6 +254,130 @@ def device_reduce(_ndarray_base x, op, tuple reduce_axis, tuple out_axis,
     return y
 
 
+def device_multi_reduce(_ndarray_base x, ops):
+    """Compute several full reductions of ``x`` with a single read.
+
+    Args:
+        x (cupy.ndarray): The input array.
+        ops (sequence): Any of ``CUPY_CUB_SUM``, ``CUPY_CUB_PROD``,
+            ``CUPY_CUB_MIN``, ``CUPY_CUB_MAX``, ``CUPY_CUB_ARGMIN`` and
+            ``CUPY_CUB_ARGMAX``.
+
+    Returns:
+        tuple: 0-dim arrays holding the results, in the order of ``ops``.
+        The indices returned by argmin and argmax are of type int64.
+    """
+    cdef _ndarray_base values, indices
+    cdef memory.MemoryPointer ws
+    cdef int dtype_id, x_size, op_mask = 0
+    cdef size_t ws_size
+    cdef void *x_ptr
+    cdef void *values_ptr
+    cdef void *indices_ptr
+    cdef void *ws_ptr
+    cdef Stream_t s
+
+    # slots of the outputs filled by cub_device_multi_reduce
+    slots = {CUPY_CUB_SUM: 0, CUPY_CUB_PROD: 1, CUPY_CUB_MIN: 2,
+             CUPY_CUB_MAX: 3, CUPY_CUB_ARGMIN: 0, CUPY_CUB_ARGMAX: 1}
+    ops = tuple(ops)
+    if len(ops) == 0:
+        raise ValueError('at least one reduction op must be given')
+    for op in ops:
+        if op not in slots:
+            raise ValueError('only CUPY_CUB_SUM, CUPY_CUB_PROD, CUPY_CUB_MIN, '
+                             'CUPY_CUB_MAX, CUPY_CUB_ARGMIN, and '
+                             'CUPY_CUB_ARGMAX are supported.')
+        if x.size == 0 and op not in (CUPY_CUB_SUM, CUPY_CUB_PROD):
+            raise ValueError('zero-size array to reduction operation {} which '
+                             'has no identity'.format(op.name))
+        op_mask |= 1 << <int>op
+    if x.size > 0x7fffffff:
+        raise ValueError('array is too large for cub_device_multi_reduce')
+
+    x = _internal_ascontiguousarray(x)
+    values = _core.ndarray((4,), x.dtype)
+    indices = _core.ndarray((2,), numpy.int64)
+    if x.size == 0:
+        values[0] = 0
+        values[1] = 1
+    else:
+        x_ptr = <void *>x.data.ptr
+        values_ptr = <void *>values.data.ptr
+        indices_ptr = <void *>indices.data.ptr
+        dtype_id = common._get_dtype_id(x.dtype)
+        s = <Stream_t>stream.get_current_stream_ptr()
+        x_size = <int>x.size
+        ws_size = cub_device_multi_reduce_get_workspace_size(
+            x_ptr, values_ptr, indices_ptr, x_size, s, op_mask, dtype_id)
+        ws = memory.alloc(ws_size)
+        ws_ptr = <void *>ws.ptr
+        ranged = function._push_range('cub::multi_reduce', x, <intptr_t>s)
+        with nogil:
+            cub_device_multi_reduce(ws_ptr, ws_size, x_ptr, values_ptr,
+                                    indices_ptr, x_size, s, op_mask, dtype_id)
+        if ranged:
+            function._pop_range(ranged, <intptr_t>s)
+
+    out = []
+    for op in ops:
+        if op in (CUPY_CUB_ARGMIN, CUPY_CUB_ARGMAX):
+            out.append(indices[slots[op]])
+        else:
+            out.append(values[slots[op]])
+    return tuple(out)
+
+
+def device_nan_reduce(_ndarray_base x, op, int64_t ddof=0):
+    """Reduces all the items of ``x`` that are not NaN in a single pass.
+
+    Args:
+        x (cupy.ndarray): A floating point or complex array.
+        op: ``CUPY_CUB_NANSUM``, ``CUPY_CUB_NANMEAN`` or ``CUPY_CUB_NANVAR``.
+        ddof (int): The delta degrees of freedom of the variance.
+
+    Returns:
+        cupy.ndarray: A 0-dim array of the dtype of ``x``, or of its real
+        part for the variance.
+    """
+    cdef _ndarray_base y
+    cdef memory.MemoryPointer ws
+    cdef int dtype_id, x_size, op_code
+    cdef size_t ws_size
+    cdef void *x_ptr
+    cdef void *y_ptr
+    cdef void *ws_ptr
+    cdef Stream_t s
+
+    if op not in (CUPY_CUB_NANSUM, CUPY_CUB_NANMEAN, CUPY_CUB_NANVAR):
+        raise ValueError('only CUPY_CUB_NANSUM, CUPY_CUB_NANMEAN and '
+                         'CUPY_CUB_NANVAR are supported.')
+    if x.size > 0x7fffffff:
+        raise ValueError('array is too large for cub_device_nan_reduce')
+    x = _internal_ascontiguousarray(x)
+    if op == CUPY_CUB_NANVAR:
+        y = _core.ndarray((), x.dtype.char.lower())
+    else:
+        y = _core.ndarray((), x.dtype)
+    x_ptr = <void *>x.data.ptr
+    y_ptr = <void *>y.data.ptr
+    dtype_id = common._get_dtype_id(x.dtype)
+    s = <Stream_t>stream.get_current_stream_ptr()
+    x_size = <int>x.size
+    op_code = <int>op
+    ws_size = cub_device_nan_reduce_get_workspace_size(
+        x_ptr, y_ptr, x_size, s, op_code, dtype_id)
+    ws = memory.alloc(ws_size)
+    ws_ptr = <void *>ws.ptr
+    ranged = function._push_range('cub::nan_reduce', x, <intptr_t>s)
+    with nogil:
+        cub_device_nan_reduce(ws_ptr, ws_size, x_ptr, y_ptr, x_size, s,
+                              op_code, dtype_id, ddof)
+    if ranged:
+        function._pop_range(ranged, <intptr_t>s)
+    return y
+
+
 def device_segmented_reduce(_ndarray_base x, op, tuple reduce_axis,
                             tuple out_axis, out=None, bint keepdims=False,
                             Py_ssize_t contiguous_size=0):
@@ -262,9 +432,12 @@ def device_segmented_reduce(_ndarray_base x, op, tuple reduce_axis,
     ws = memory.alloc(ws_size)
     ws_ptr = <void*>ws.ptr
     op_code = <int>op
+    ranged = function._push_range('cub::segmented_reduce', (x, y), <intptr_t>s)
     with nogil:
         cub_device_segmented_reduce(ws_ptr, ws_size, x_ptr, y_ptr, n_segments,
                                     contiguous_size, s, op_code, dtype_id)
+    if ranged:
+        function._pop_range(ranged, <intptr_t>s)
 
     if out is not None:
         cupy._core.elementwise_copy(y, out)
@@ -272,8 +445,32 @@ def device_segmented_reduce(_ndarray_base x, op, tuple reduce_axis,
     return y
 
 
-def device_csrmv(int n_rows, int n_cols, int nnz, _ndarray_base values,
-                 _ndarray_base indptr, _ndarray_base indices, _ndarray_base x):
+cdef tuple _csr_promote(_ndarray_base values, _ndarray_base indptr,
+                        _ndarray_base indices, _ndarray_base x):
+    if values.dtype == x.dtype:
+        dtype = values.dtype
+    else:
+        dtype = numpy.promote_types(values.dtype, x.dtype)
+        values = values.astype(dtype, "C", None, None, False)
+        x = x.astype(dtype, "C", None, None, False)
+    if indptr.dtype != indices.dtype:
+        index_dtype = numpy.promote_types(indptr.dtype, indices.dtype)
+        indptr = indptr.astype(index_dtype, "C", None, None, False)
+        indices = indices.astype(index_dtype, "C", None, None, False)
+    if indptr.dtype != numpy.int32 and indptr.dtype != numpy.int64:
+        raise TypeError('the indices must be int32 or int64')
+    return dtype, values, indptr, indices, x
+
+
+def device_csrmv(int64_t n_rows, int64_t n_cols, int64_t nnz,
+                 _ndarray_base values, _ndarray_base indptr,
+                 _ndarray_base indices, _ndarray_base x):
+    """Multiplies a CSR matrix by a dense vector.
+
+    This is a merge-path SpMV, which balances the work among threads however
+    the nonzeros are distributed among the rows. The indices may be int32 or
+    int64.
+    """
     cdef _ndarray_base y
     cdef memory.MemoryPointer ws
     cdef void* values_ptr
@@ -282,7 +479,7 @@ def device_csrmv(int n_rows, int n_cols, int nnz, _ndarray_base values,
     cdef void* x_ptr
     cdef void* y_ptr
     cdef void* ws_ptr
-    cdef int dtype_id
+    cdef int dtype_id, index_dtype_id
     cdef size_t ws_size
     cdef Stream_t s
 
@@ -290,15 +487,9 @@ def device_csrmv(int n_rows, int n_cols, int nnz, _ndarray_base values,
         raise ValueError('array must be 1d')
     if x.size != n_cols:
         raise ValueError("size of array does not match the CSR matrix")
-    if runtime._is_hip_environment:
-        raise RuntimeError("hipCUB does not support SpMV")
 
-    if values.dtype == x.dtype:
-        dtype = values.dtype
-    else:
-        dtype = numpy.promote_types(values.dtype, x.dtype)
-        values = values.astype(dtype, "C", None, None, False)
-        x = x.astype(dtype, "C", None, None, False)
+    dtype, values, indptr, indices, x = _csr_promote(
+        values, indptr, indices, x)
 
     # CSR matrix attributes
     values_ptr = <void*>values.data.ptr
@@ -313,35 +504,80 @@ def device_csrmv(int n_rows, int n_cols, int nnz, _ndarray_base values,
 
     s = <Stream_t>stream.get_current_stream_ptr()
     dtype_id = common._get_dtype_id(dtype)
+    index_dtype_id = common._get_dtype_id(indptr.dtype)
 
     # get workspace size and then fire up
     ws_size = cub_device_spmv_get_workspace_size(
         values_ptr, row_offsets_ptr, col_indices_ptr, x_ptr, y_ptr, n_rows,
-        n_cols, nnz, s, dtype_id)
+        nnz, s, dtype_id, index_dtype_id)
     ws = memory.alloc(ws_size)
     ws_ptr = <void *>ws.ptr
+    ranged = function._push_range('cub::csrmv', (values, x, y), <intptr_t>s)
     with nogil:
         cub_device_spmv(ws_ptr, ws_size, values_ptr, row_offsets_ptr,
-                        col_indices_ptr, x_ptr, y_ptr, n_rows, n_cols, nnz, s,
-                        dtype_id)
+                        col_indices_ptr, x_ptr, y_ptr, n_rows, nnz, s,
+                        dtype_id, index_dtype_id)
+    if ranged:
+        function._pop_range(ranged, <intptr_t>s)
 
     return y
 
 
+def device_csrmm(int64_t n_rows, int64_t n_cols, _ndarray_base values,
+                 _ndarray_base indptr, _ndarray_base indices,
+                 _ndarray_base x):
+    """Multiplies a CSR matrix by a dense matrix.
+
+    Each thread computes an element of the output, and the threads of a warp
+    compute consecutive columns of a row, so that their loads from the
+    C-contiguous ``x`` are coalesced. The indices may be int32 or int64.
+    """
+    cdef _ndarray_base y
+    cdef int dtype_id, index_dtype_id
+    cdef int64_t n_vecs
+    cdef Stream_t s
+
+    if x.ndim != 2:
+        raise ValueError('array must be 2d')
+    if x.shape[0] != n_cols:
+        raise ValueError("size of array does not match the CSR matrix")
+    n_vecs = x.shape[1]
+
+    dtype, values, indptr, indices, x = _csr_promote(
+        values, indptr, indices, x)
+    x = _internal_ascontiguousarray(x)
+    y = _core.ndarray((n_rows, n_vecs), dtype=dtype)
+
+    s = <Stream_t>stream.get_current_stream_ptr()
+    dtype_id = common._get_dtype_id(dtype)
+    index_dtype_id = common._get_dtype_id(indptr.dtype)
+    ranged = function._push_range('cub::csrmm', (values, x, y), <intptr_t>s)
+    with nogil:
+        cub_device_spmm(<void*>values.data.ptr, <void*>indptr.data.ptr,
+                        <void*>indices.data.ptr, <void*>x.data.ptr,
+                        <void*>y.data.ptr, n_rows, n_vecs, s, dtype_id,
+                        index_dtype_id)
+    if ranged:
+        function._pop_range(ranged, <intptr_t>s)
+    return y
+
+
 def device_scan(_ndarray_base x, op):
     cdef memory.MemoryPointer ws
-    cdef int dtype_id, x_size, op_code
+    cdef int dtype_id, op_code
+    cdef int64_t x_size
     cdef size_t ws_size
     cdef void *x_ptr
     cdef void *ws_ptr
     cdef Stream_t s
 
-    if op not in (CUPY_CUB_CUMSUM, CUPY_CUB_CUMPROD):
-        raise ValueError('only CUPY_CUB_CUMSUM and CUPY_CUB_CUMPROD '
-                         'are supported.')
+    if op not in CUB_scan_ops:
+        raise ValueError('only CUPY_CUB_CUMSUM, CUPY_CUB_CUMPROD, '
+                         'CUPY_CUB_CUMMIN, CUPY_CUB_CUMMAX and their '
+                         'exclusive variants are supported.')
 
     # determine shape: x is either 1D (with axis=None,0) or ND but ravelled.
-    x_size = <int>x.size
+    x_size = <int64_t>x.size
     if x_size == 0:
         return x
 
@@ -354,17 +590,399 @@ def device_scan(_ndarray_base x, op):
     ws = memory.alloc(ws_size)
     ws_ptr = <void *>ws.ptr
     op_code = <int>op
+    ranged = function._push_range('cub::scan', x, <intptr_t>s)
     with nogil:
         # the scan is in-place
         cub_device_scan(ws_ptr, ws_size, x_ptr, x_ptr, x_size, s,
                         op_code, dtype_id)
+    if ranged:
+        function._pop_range(ranged, <intptr_t>s)
     return x
 
 
-def device_histogram(_ndarray_base x, _ndarray_base y, bins):
+def device_scan_by_key(_ndarray_base x, op, _ndarray_base keys=None,
+                       Py_ssize_t segment_size=0):
+    """Perform an in-place segmented prefix scan of a 1D array.
+
+    Segments are runs of consecutive equal ``keys`` (int32 or int64). If
+    ``keys`` is not given, every ``segment_size`` items form a segment, which
+    scans the rows of a C-contiguous array in one launch.
+    """
+    cdef memory.MemoryPointer ws
+    cdef int dtype_id, key_dtype_id, op_code
+    cdef int64_t x_size, seg_size
+    cdef size_t ws_size
+    cdef void *x_ptr
+    cdef void *keys_ptr
+    cdef void *ws_ptr
+    cdef Stream_t s
+
+    if op not in CUB_scan_ops:
+        raise ValueError('only CUPY_CUB_CUMSUM, CUPY_CUB_CUMPROD, '
+                         'CUPY_CUB_CUMMIN, CUPY_CUB_CUMMAX and their '
+                         'exclusive variants are supported.')
+    x_size = <int64_t>x.size
+    if x_size == 0:
+        return x
+
+    x = _internal_ascontiguousarray(x)
+    if keys is None:
+        if segment_size <= 0:
+            raise ValueError('segment_size must be positive')
+        keys_ptr = NULL
+        key_dtype_id = -1
+        seg_size = <int64_t>segment_size
+    else:
+        if keys.size != x.size:
+            raise ValueError('keys and x must have the same size')
+        if keys.dtype not in (numpy.int32, numpy.int64):
+            raise ValueError('only int32 and int64 keys are supported')
+        keys = _internal_ascontiguousarray(keys)
+        keys_ptr = <void *>keys.data.ptr
+        key_dtype_id = common._get_dtype_id(keys.dtype)
+        seg_size = 0
+    x_ptr = <void *>x.data.ptr
+    s = <Stream_t>stream.get_current_stream_ptr()
+    dtype_id = common._get_dtype_id(x.dtype)
+    op_code = <int>op
+    ws_size = cub_device_scan_by_key_get_workspace_size(
+        keys_ptr, x_ptr, x_ptr, x_size, seg_size, s, op_code, key_dtype_id,
+        dtype_id)
+    ws = memory.alloc(ws_size)
+    ws_ptr = <void *>ws.ptr
+    ranged = function._push_range('cub::scan_by_key', (keys, x), <intptr_t>s)
+    with nogil:
+        # the scan is in-place
+        cub_device_scan_by_key(ws_ptr, ws_size, keys_ptr, x_ptr, x_ptr,
+                               x_size, seg_size, s, op_code, key_dtype_id,
+                               dtype_id)
+    if ranged:
+        function._pop_range(ranged, <intptr_t>s)
+    return x
+
+
+def device_reduce_by_key(_ndarray_base keys, _ndarray_base x, op):
+    """Reduce each run of consecutive equal ``keys`` into one item.
+
+    Args:
+        keys (cupy.ndarray): The int64 key of each item of ``x``.
+        x (cupy.ndarray): The items to reduce.
+        op: ``CUPY_CUB_SUM``, ``CUPY_CUB_MIN`` or ``CUPY_CUB_MAX``.
+
+    Returns:
+        tuple: The key and the reduced value of each run, and the number of
+        runs as a 0-dim int64 array on the device. Only the leading items of
+        the first two arrays, up to the number of runs, are valid.
+    """
+    cdef _ndarray_base unique_keys, y, num_runs
+    cdef memory.MemoryPointer ws
+    cdef int dtype_id, op_code
+    cdef int64_t n
+    cdef size_t ws_size
+    cdef void *keys_ptr
+    cdef void *unique_keys_ptr
+    cdef void *x_ptr
+    cdef void *y_ptr
+    cdef void *num_ptr
+    cdef void *ws_ptr
+    cdef Stream_t s
+
+    if op not in (CUPY_CUB_SUM, CUPY_CUB_MIN, CUPY_CUB_MAX):
+        raise ValueError('only CUPY_CUB_SUM, CUPY_CUB_MIN, and CUPY_CUB_MAX '
+                         'are supported.')
+    if keys.dtype != numpy.int64:
+        raise ValueError('keys must be of int64 dtype')
+    if x.size != keys.size:
+        raise ValueError('x and keys must have the same size')
+    keys = _internal_ascontiguousarray(keys)
+    x = _internal_ascontiguousarray(x)
+    unique_keys = _core.ndarray((x.size,), numpy.int64)
+    y = _core.ndarray((x.size,), x.dtype)
+    num_runs = _core.ndarray((), numpy.int64)
+    n = <int64_t>x.size
+    if n == 0:
+        num_runs.fill(0)
+        return unique_keys, y, num_runs
+
+    keys_ptr = <void *>keys.data.ptr
+    unique_keys_ptr = <void *>unique_keys.data.ptr
+    x_ptr = <void *>x.data.ptr
+    y_ptr = <void *>y.data.ptr
+    num_ptr = <void *>num_runs.data.ptr
+    dtype_id = common._get_dtype_id(x.dtype)
+    s = <Stream_t>stream.get_current_stream_ptr()
+    op_code = <int>op
+    ws_size = cub_device_reduce_by_key_get_workspace_size(
+        keys_ptr, unique_keys_ptr, x_ptr, y_ptr, num_ptr, n, s, op_code,
+        dtype_id)
+    ws = memory.alloc(ws_size)
+    ws_ptr = <void *>ws.ptr
+    ranged = function._push_range('cub::reduce_by_key', (keys, x), <intptr_t>s)
+    with nogil:
+        cub_device_reduce_by_key(ws_ptr, ws_size, keys_ptr, unique_keys_ptr,
+                                 x_ptr, y_ptr, num_ptr, n, s, op_code,
+                                 dtype_id)
+    if ranged:
+        function._pop_range(ranged, <intptr_t>s)
+    return unique_keys, y, num_runs
+
+
+def device_select_flagged(_ndarray_base x, _ndarray_base flags,
+                          _ndarray_base out=None):
+    """Select the items of ``x`` whose ``flags`` are True.
+
+    If ``x`` is None, the (flat) indices of the nonzero items of ``flags``
+    are selected instead, in which case ``flags`` can be of any dtype.
+
+    If ``out`` is given, the selected items are written to it. It must be
+    a 1-dim C-contiguous array of the output dtype with room for all the
+    items of the input.
+
+    Returns:
+        tuple: The output array of the same size as the input (or ``out``),
+        of which only the first ``num_selected`` items are valid, and
+        ``num_selected`` as a 0-dim int64 array on the device.
+    """
+    cdef _ndarray_base y, num_selected
+    cdef memory.MemoryPointer ws
+    cdef int dtype_id, flag_dtype_id
+    cdef int64_t n
+    cdef size_t ws_size
+    cdef void *x_ptr
+    cdef void *flags_ptr
+    cdef void *y_ptr
+    cdef void *num_ptr
+    cdef void *ws_ptr
+    cdef Stream_t s
+
+    flags = _internal_ascontiguousarray(flags)
+    if x is None:
+        y_dtype = numpy.int64
+        x_ptr = NULL
+        dtype_id = -1
+    else:
+        if flags.dtype != numpy.bool_:
+            raise ValueError('flags must be of bool dtype')
+        if x.size != flags.size:
+            raise ValueError('x and flags must have the same size')
+        x = _internal_ascontiguousarray(x)
+        y_dtype = x.dtype
+        x_ptr = <void *>x.data.ptr
+        dtype_id = common._get_dtype_id(x.dtype)
+    if out is None:
+        y = _core.ndarray((flags.size,), y_dtype)
+    else:
+        if (out.ndim != 1 or not out._c_contiguous
+                or out.dtype != y_dtype or out.size < flags.size):
+            raise ValueError(
+                'out must be a 1-dim C-contiguous {} array of at least {} '
+                'items'.format(numpy.dtype(y_dtype), flags.size))
+        y = out
+    num_selected = _core.ndarray((), numpy.int64)
+    n = <int64_t>flags.size
+    if n == 0:
+        num_selected.fill(0)
+        return y, num_selected
+
+    flags_ptr = <void *>flags.data.ptr
+    y_ptr = <void *>y.data.ptr
+    num_ptr = <void *>num_selected.data.ptr
+    flag_dtype_id = common._get_dtype_id(flags.dtype)
+    s = <Stream_t>stream.get_current_stream_ptr()
+    ws_size = cub_device_select_flagged_get_workspace_size(
+        x_ptr, flags_ptr, y_ptr, num_ptr, n, s, flag_dtype_id, dtype_id)
+    ws = memory.alloc(ws_size)
+    ws_ptr = <void *>ws.ptr
+    ranged = function._push_range(
+        'cub::select_flagged', (x, flags), <intptr_t>s)
+    with nogil:
+        cub_device_select_flagged(ws_ptr, ws_size, x_ptr, flags_ptr, y_ptr,
+                                  num_ptr, n, s, flag_dtype_id, dtype_id)
+    if ranged:
+        function._pop_range(ranged, <intptr_t>s)
+    return y, num_selected
+
+
+def device_select_if(_ndarray_base x, op, threshold=None):
+    """Select the items of ``x`` satisfying a predicate.
+
+    ``op`` is one of the ``CUPY_CUB_SELECT_*`` predicates; the comparison
+    predicates compare each item against ``threshold``.
+
+    Returns:
+        tuple: See :func:`device_select_flagged`.
+    """
+    cdef _ndarray_base y, num_selected
+    cdef memory.MemoryPointer ws
+    cdef int dtype_id, op_code
+    cdef int64_t n
+    cdef size_t ws_size
+    cdef void *x_ptr
+    cdef void *y_ptr
+    cdef void *num_ptr
+    cdef void *thres_ptr
+    cdef void *ws_ptr
+    cdef Stream_t s
+
+    if op not in (CUPY_CUB_SELECT_NONZERO, CUPY_CUB_SELECT_NOT_NAN,
+                  CUPY_CUB_SELECT_GREATER, CUPY_CUB_SELECT_GREATER_EQUAL,
+                  CUPY_CUB_SELECT_LESS, CUPY_CUB_SELECT_LESS_EQUAL,
+                  CUPY_CUB_SELECT_EQUAL, CUPY_CUB_SELECT_NOT_EQUAL):
+        raise ValueError('unsupported select op: {}'.format(op))
+    if op in (CUPY_CUB_SELECT_NONZERO, CUPY_CUB_SELECT_NOT_NAN):
+        thres = None
+        thres_ptr = NULL
+    else:
+        if threshold is None:
+            raise ValueError('threshold is required for comparisons')
+        # keep a host copy alive until the call returns
+        thres = numpy.array(threshold, dtype=x.dtype)
+        thres_ptr = <void *><intptr_t>thres.ctypes.data
+
+    x = _internal_ascontiguousarray(x)
+    y = _core.ndarray((x.size,), x.dtype)
+    num_selected = _core.ndarray((), numpy.int64)
+    n = <int64_t>x.size
+    if n == 0:
+        num_selected.fill(0)
+        return y, num_selected
+
+    x_ptr = <void *>x.data.ptr
+    y_ptr = <void *>y.data.ptr
+    num_ptr = <void *>num_selected.data.ptr
+    dtype_id = common._get_dtype_id(x.dtype)
+    op_code = <int>op
+    s = <Stream_t>stream.get_current_stream_ptr()
+    ws_size = cub_device_select_if_get_workspace_size(
+        x_ptr, y_ptr, num_ptr, n, thres_ptr, s, op_code, dtype_id)
+    ws = memory.alloc(ws_size)
+    ws_ptr = <void *>ws.ptr
+    ranged = function._push_range('cub::select_if', x, <intptr_t>s)
+    with nogil:
+        cub_device_select_if(ws_ptr, ws_size, x_ptr, y_ptr, num_ptr, n,
+                             thres_ptr, s, op_code, dtype_id)
+    if ranged:
+        function._pop_range(ranged, <intptr_t>s)
+    return y, num_selected
+
+
+def device_unique(_ndarray_base x, bint equal_nan=True):
+    """Drop the consecutive duplicates of ``x`` (sorted unique if sorted).
+
+    Returns:
+        tuple: See :func:`device_select_flagged`.
+    """
+    cdef _ndarray_base y, num_selected
+    cdef memory.MemoryPointer ws
+    cdef int dtype_id
+    cdef int64_t n
+    cdef size_t ws_size
+    cdef void *x_ptr
+    cdef void *y_ptr
+    cdef void *num_ptr
+    cdef void *ws_ptr
+    cdef Stream_t s
+
+    x = _internal_ascontiguousarray(x)
+    y = _core.ndarray((x.size,), x.dtype)
+    num_selected = _core.ndarray((), numpy.int64)
+    n = <int64_t>x.size
+    if n == 0:
+        num_selected.fill(0)
+        return y, num_selected
+
+    x_ptr = <void *>x.data.ptr
+    y_ptr = <void *>y.data.ptr
+    num_ptr = <void *>num_selected.data.ptr
+    dtype_id = common._get_dtype_id(x.dtype)
+    s = <Stream_t>stream.get_current_stream_ptr()
+    ws_size = cub_device_unique_get_workspace_size(
+        x_ptr, y_ptr, num_ptr, n, equal_nan, s, dtype_id)
+    ws = memory.alloc(ws_size)
+    ws_ptr = <void *>ws.ptr
+    ranged = function._push_range('cub::unique', x, <intptr_t>s)
+    with nogil:
+        cub_device_unique(ws_ptr, ws_size, x_ptr, y_ptr, num_ptr, n,
+                          equal_nan, s, dtype_id)
+    if ranged:
+        function._pop_range(ranged, <intptr_t>s)
+    return y, num_selected
+
+
+def device_partition(_ndarray_base x, _ndarray_base flags):
+    """Stably move the items of ``x`` whose ``flags`` are True to the front.
+
+    The rejected items are stored after the selected ones in reverse order.
+
+    Returns:
+        tuple: The partitioned array and the number of selected items as a
+        0-dim int64 array on the device.
+    """
+    cdef _ndarray_base y, num_selected
+    cdef memory.MemoryPointer ws
+    cdef int dtype_id
+    cdef int64_t n
+    cdef size_t ws_size
+    cdef void *x_ptr
+    cdef void *flags_ptr
+    cdef void *y_ptr
+    cdef void *num_ptr
+    cdef void *ws_ptr
+    cdef Stream_t s
+
+    if flags.dtype != numpy.bool_:
+        raise ValueError('flags must be of bool dtype')
+    if x.size != flags.size:
+        raise ValueError('x and flags must have the same size')
+    x = _internal_ascontiguousarray(x)
+    flags = _internal_ascontiguousarray(flags)
+    y = _core.ndarray((x.size,), x.dtype)
+    num_selected = _core.ndarray((), numpy.int64)
+    n = <int64_t>x.size
+    if n == 0:
+        num_selected.fill(0)
+        return y, num_selected
+
+    x_ptr = <void *>x.data.ptr
+    flags_ptr = <void *>flags.data.ptr
+    y_ptr = <void *>y.data.ptr
+    num_ptr = <void *>num_selected.data.ptr
+    dtype_id = common._get_dtype_id(x.dtype)
+    s = <Stream_t>stream.get_current_stream_ptr()
+    ws_size = cub_device_partition_get_workspace_size(
+        x_ptr, flags_ptr, y_ptr, num_ptr, n, s, dtype_id)
+    ws = memory.alloc(ws_size)
+    ws_ptr = <void *>ws.ptr
+    ranged = function._push_range('cub::partition', (x, flags), <intptr_t>s)
+    with nogil:
+        cub_device_partition(ws_ptr, ws_size, x_ptr, flags_ptr, y_ptr,
+                             num_ptr, n, s, dtype_id)
+    if ranged:
+        function._pop_range(ranged, <intptr_t>s)
+    return y, num_selected
+
+
+# how device_histogram bins complex samples; this mirrors cupy_cub.h
+_histogram_complex_modes = {None: 0, 'abs': 1, 'angle': 2}
+
+
+def device_histogram(_ndarray_base x, _ndarray_base y, bins,
+                     complex_mode=None, int lower=0):
+    """Count the samples of ``x`` falling into each bin into ``y``.
+
+    Args:
+        x (cupy.ndarray): The samples.
+        y (cupy.ndarray): The int64 output of size ``n_bins - 1``.
+        bins (int or cupy.ndarray): The bin edges, or the number of edges of
+            the unit-width bins starting at ``lower`` for integer samples.
+        complex_mode (str): For complex samples, ``'abs'`` bins them by
+            magnitude and ``'angle'`` by phase. The bin edges are then of
+            the corresponding real dtype.
+        lower (int): The first edge of the unit-width bins.
+    """
     cdef memory.MemoryPointer ws
     cdef size_t ws_size, n_samples
-    cdef int dtype_id, n_bins
+    cdef int dtype_id, n_bins, mode
     cdef void* x_ptr
     cdef void* bins_ptr
     cdef void* y_ptr
@@ -372,6 +990,17 @@ def device_histogram(_ndarray_base x, _ndarray_base y, bins):
     cdef Stream_t s
     cdef bint is_even
 
+    if complex_mode not in _histogram_complex_modes:
+        raise ValueError('unknown complex_mode: {}'.format(complex_mode))
+    if x.dtype.kind == 'c':
+        if complex_mode is None:
+            raise ValueError('complex samples need complex_mode')
+        if not isinstance(bins, _ndarray_base):
+            raise ValueError('complex samples need explicit bin edges')
+        if bins.dtype != x.real.dtype:
+            raise ValueError('bins must be of dtype {}'.format(x.real.dtype))
+    mode = _histogram_complex_modes[complex_mode]
+
     # TODO(leofang): perhaps not needed?
     # y is guaranteed contiguous
     x = _internal_ascontiguousarray(x)
@@ -383,8 +1012,6 @@ def device_histogram(_ndarray_base x, _ndarray_base y, bins):
     else:
         n_bins = bins
         is_even = True
-        if runtime._is_hip_environment:
-            raise RuntimeError("not supported yet")
         if x.dtype.kind not in 'bui':
             raise ValueError("only integer input is supported")
     assert y.size == n_bins - 1
@@ -397,22 +1024,26 @@ def device_histogram(_ndarray_base x, _ndarray_base y, bins):
 
     if is_even:
         ws_size = cub_device_histogram_even_get_workspace_size(
-            x_ptr, y_ptr, n_bins, 0, n_bins-1, n_samples, s, dtype_id)
+            x_ptr, y_ptr, n_bins, lower, lower+n_bins-1, n_samples, s,
+            dtype_id)
     else:
         ws_size = cub_device_histogram_range_get_workspace_size(
-            x_ptr, y_ptr, n_bins, bins_ptr, n_samples, s, dtype_id)
+            x_ptr, y_ptr, n_bins, bins_ptr, n_samples, s, dtype_id, mode)
     ws = memory.alloc(ws_size)
     ws_ptr = <void*>ws.ptr
 
+    ranged = function._push_range('cub::histogram', (x, y), <intptr_t>s)
     with nogil:
         if is_even:
             cub_device_histogram_even(
-                ws_ptr, ws_size, x_ptr, y_ptr, n_bins, 0, n_bins-1,
-                n_samples, s, dtype_id)
+                ws_ptr, ws_size, x_ptr, y_ptr, n_bins, lower,
+                lower+n_bins-1, n_samples, s, dtype_id)
         else:
             cub_device_histogram_range(
                 ws_ptr, ws_size, x_ptr, y_ptr, n_bins,
-                bins_ptr, n_samples, s, dtype_id)
+                bins_ptr, n_samples, s, dtype_id, mode)
+    if ranged:
+        function._pop_range(ranged, <intptr_t>s)
     return y
 
 
@@ -429,10 +1060,13 @@ cpdef bint _cub_device_segmented_reduce_axis_compatible(
 
 cdef bint can_use_device_reduce(
         _ndarray_base x, int op, tuple out_axis, dtype=None) except*:
+    # 64-bit offsets are used for large arrays, except for argmin and argmax
+    # whose outputs hold 32-bit keys
     return (
         out_axis is ()
         and _cub_reduce_dtype_compatible(x.dtype, op, dtype)
-        and x.size <= 0x7fffffff)  # until we resolve cupy/cupy#3309
+        and (x.size <= 0x7fffffff
+             or op not in (CUPY_CUB_ARGMIN, CUPY_CUB_ARGMAX)))
 
 
 cdef (bint, Py_ssize_t) can_use_device_segmented_reduce(  # noqa: E211
@@ -447,10 +1081,13 @@ cdef (bint, Py_ssize_t) can_use_device_segmented_reduce(  # noqa: E211
             return (False, 0)
     else:
         order = 'CF'  # for computing the contig size
-    # until we resolve cupy/cupy#3309
     cdef Py_ssize_t contiguous_size = _preprocess_array(
         x.shape, reduce_axis, out_axis, order)
-    return (contiguous_size <= 0x7fffffff, contiguous_size)
+    # CUB takes the number of segments as int; the offsets are 64-bit if
+    # needed
+    if contiguous_size > 0 and x.size // contiguous_size > 0x7fffffff:
+        return (False, 0)
+    return (True, contiguous_size)
 
 
 cdef _cub_support_dtype(bint sum_mode, int dev_id):
@@ -474,9 +1111,21 @@ cdef _cub_support_dtype(bint sum_mode, int dev_id):
     return support_dtype_dict[dev_id]
 
 
+cdef bint _cub_bf16_compatible(x_dtype) except*:
+    # Only the sum, prod, min and max reductions and scans are instantiated
+    # for bfloat16.
+    return (_bfloat16 is not None and x_dtype == _bfloat16
+            and common._is_bf16_supported())
+
+
 cdef _cub_reduce_dtype_compatible(x_dtype, int op, dtype=None):
     cdef int dev_id = device.get_device_id()
 
+    if _cub_bf16_compatible(x_dtype):
+        return (op in (CUPY_CUB_SUM, CUPY_CUB_PROD, CUPY_CUB_MIN,
+                       CUPY_CUB_MAX)
+                and (dtype is None or dtype == x_dtype))
+
     if dtype is None:
         if op in (CUPY_CUB_SUM, CUPY_CUB_PROD):
             # auto dtype:
@@ -559,12 +1208,49 @@ cpdef cub_reduction(
     return None
 
 
+cpdef cub_nan_reduction(
+        _ndarray_base arr, op, axis=None, dtype=None,
+        _ndarray_base out=None, keepdims=False, Py_ssize_t ddof=0):
+    """Perform a NaN-ignoring reduction of all the items using CUB.
+
+    If the specified reduction is not possible, None is returned.
+    """
+    from cupy._core._reduction import _get_axis
+    cdef tuple reduce_axis, out_axis
+    cdef int dev_id = device.get_device_id()
+
+    if not (arr._c_contiguous or arr._f_contiguous):
+        return None
+    if dtype is not None and dtype != arr.dtype:
+        return None
+    if (arr.dtype.char not in 'efdFD'
+            or arr.dtype not in _cub_support_dtype(False, dev_id)):
+        return None
+    if not 0 < arr.size <= 0x7fffffff:
+        return None
+    reduce_axis, out_axis = _get_axis(axis, arr.ndim)
+    if out_axis != ():
+        return None
+
+    y = device_nan_reduce(arr, op, ddof)
+    if keepdims:
+        y = y.reshape(_get_output_shape(arr, out_axis, keepdims))
+    if out is not None:
+        if out.ndim != y.ndim:
+            raise ValueError(
+                'output parameter for reduction operation has the wrong '
+                'number of dimensions')
+        cupy._core.elementwise_copy(y, out)
+        y = out
+    return y
+
+
 cpdef cub_scan(_ndarray_base arr, op):
     """Perform an (in-place) prefix scan using CUB.
 
     If the specified scan is not possible, None is returned.
     """
-    if op not in (CUPY_CUB_CUMSUM, CUPY_CUB_CUMPROD):
+    if op not in CUB_scan_ops:
         return None
 
     x_dtype = arr.dtype
@@ -574,19 +1260,96 @@ cpdef cub_scan(_ndarray_base arr, op):
         return None
 
     cdef int dev_id = device.get_device_id()
-    if x_dtype in _cub_support_dtype(False, dev_id):
+    if (x_dtype in _cub_support_dtype(False, dev_id)
+            or _cub_bf16_compatible(x_dtype)):
         return device_scan(arr, op)
 
     return None
 
 
-cpdef cub_histogram(_ndarray_base x, _ndarray_base y, bins):
+cpdef cub_scan_by_key(_ndarray_base arr, op, _ndarray_base keys=None,
+                      Py_ssize_t segment_size=0):
+    """Perform an (in-place) segmented prefix scan using CUB.
+
+    If the specified scan is not possible, None is returned.
+    """
+    if op not in CUB_scan_ops:
+        return None
+
+    x_dtype = arr.dtype
+    if x_dtype == numpy.complex128:
+        # see the comment in cub_scan
+        return None
+
+    cdef int dev_id = device.get_device_id()
+    if x_dtype in _cub_support_dtype(False, dev_id):
+        return device_scan_by_key(arr, op, keys, segment_size)
+
+    return None
+
+
+cdef bint _cub_select_dtype_compatible(x_dtype) except*:
+    cdef int dev_id = device.get_device_id()
+    return (x_dtype == numpy.bool_
+            or x_dtype in _cub_support_dtype(False, dev_id))
+
+
+cpdef cub_nonzero(_ndarray_base arr):
+    """Return the flat indices of the nonzero items of ``arr`` (in C order)
+    using CUB.
+
+    If not possible, None is returned. This function synchronizes the device.
+    """
+    if not _cub_select_dtype_compatible(arr.dtype):
+        return None
+    y, num_selected = device_select_flagged(None, arr)
+    return y[:int(num_selected)]
+
+
+cpdef cub_nonzero_bounded(_ndarray_base arr, _ndarray_base out=None):
+    """Return the flat indices of the nonzero items of ``arr`` (in C order)
+    and their number as a 0-dim device array, using CUB.
+
+    Only the leading items of the indices, up to the number, are valid. If
+    not possible, None is returned. This function does not synchronize.
+    """
+    if not _cub_select_dtype_compatible(arr.dtype):
+        return None
+    return device_select_flagged(None, arr, out)
+
+
+cpdef cub_select_flagged(_ndarray_base arr, _ndarray_base mask):
+    """Return ``arr[mask]`` for ``arr`` and ``mask`` of the same shape,
+    flattened in C order, using CUB.
+
+    If not possible, None is returned. This function synchronizes the device.
+    """
+    if (mask.dtype != numpy.bool_ or arr.shape != mask.shape
+            or not _cub_select_dtype_compatible(arr.dtype)):
+        return None
+    y, num_selected = device_select_flagged(arr, mask)
+    return y[:int(num_selected)]
+
+
+cpdef cub_unique(_ndarray_base arr, bint equal_nan=True):
+    """Return the unique items of the sorted 1D array ``arr`` using CUB.
+
+    If not possible, None is returned. This function synchronizes the device.
+    """
+    if not _cub_select_dtype_compatible(arr.dtype):
+        return None
+    y, num_selected = device_unique(arr, equal_nan)
+    return y[:int(num_selected)]
+
+
+cpdef cub_histogram(_ndarray_base x, _ndarray_base y, bins,
+                    complex_mode=None, int lower=0):
     """Check if the required workspace size is too much, if not then proceed
     to compute the histogram, otherwise return None. This is a workaround for
     NVIDIA/cub#613.
     """
     try:
-        out = device_histogram(x, y, bins)
+        out = device_histogram(x, y, bins, complex_mode, lower)
     except _memory.OutOfMemoryError:
         return None
     return out
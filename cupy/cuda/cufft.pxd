@@ -42,6 +42,8 @@ cpdef enum:
 
 
 cpdef get_current_plan()
+cpdef dict get_shared_work_area_sizes(int device_id)
+cpdef release_shared_work_areas(int device_id)
 cpdef int getVersion() except? -1
 
 
@@ -49,6 +51,9 @@ cdef class Plan1d:
     cdef:
         readonly intptr_t handle
         readonly object work_area  # can be MemoryPointer or a list of it
+        readonly size_t work_size
+        readonly bint shared_work_area
+        readonly bint deferred_work_area
         readonly int nx
         readonly int batch
         readonly Type fft_type
@@ -73,6 +78,9 @@ cdef class PlanNd:
     cdef:
         readonly intptr_t handle
         readonly object work_area  # memory.MemoryPointer
+        readonly size_t work_size
+        readonly bint shared_work_area
+        readonly bint deferred_work_area
         readonly tuple shape
         readonly Type fft_type
         readonly str order
@@ -110,6 +110,14 @@ cdef extern from 'cupy_cufft.h' nogil:
                                     XtArray* odata, int direction)
     Result cufftXtExecDescriptorZ2Z(Handle plan, XtArray* idata,
                                     XtArray* odata, int direction)
+
+    # cuFFT LTO callback
+    ctypedef enum JITCallbackType 'cufftXtCallbackType':
+        pass
+    Result cufftXtSetJITCallback(
+        Handle plan, const char* lto_callback_symbol_name,
+        const void* lto_callback_fatbin, size_t lto_callback_fatbin_size,
+        JITCallbackType type, void** caller_info)
     Result cufftXtMakePlanMany(Handle plan, int rank, long long int* n,
                                long long int* inembed,
                                long long int istride,
@@ -272,9 +280,98 @@ cdef _XtFree(intptr_t ptr):
     PyMem_Free(xtArr)
 
 
+# Work areas shared by the plans made with shared_work_area=True, keyed by
+# (device, stream). They only grow, and the plans are pointed to the current
+# one right before each execution, so that a plan never sees a freed buffer.
+# Plans sharing an area are serialized by the stream.
+cdef dict _shared_work_areas = {}
+
+
+cdef intptr_t _get_shared_work_area(size_t work_size, intptr_t s) except*:
+    cdef tuple key = (runtime.getDevice(), s)
+    work_area = _shared_work_areas.get(key)
+    if work_area is None or work_area.mem.size < work_size:
+        # drop the old area first so that the pool can reuse it
+        _shared_work_areas.pop(key, None)
+        work_area = memory.alloc(work_size)
+        _shared_work_areas[key] = work_area
+    return <intptr_t>(work_area.ptr)
+
+
+cdef void _set_shared_work_area(
+        intptr_t plan, size_t work_size, intptr_t s) except*:
+    cdef intptr_t ptr = _get_shared_work_area(work_size, s)
+    cdef int result
+    with nogil:
+        result = cufftSetWorkArea(<Handle>plan, <void*>ptr)
+    check_result(result)
+
+
+cdef object _borrow_work_area(intptr_t plan, size_t work_size):
+    # The work area of a plan made with deferred_work_area=True is taken from
+    # the memory pool for one execution. The caller holds it until the
+    # execution is enqueued, so that the pool reuses it in stream order.
+    work_area = memory.alloc(work_size)
+    cdef intptr_t ptr = <intptr_t>(work_area.ptr)
+    cdef int result
+    with nogil:
+        result = cufftSetWorkArea(<Handle>plan, <void*>ptr)
+    check_result(result)
+    return work_area
+
+
+cpdef dict get_shared_work_area_sizes(int device_id):
+    """Returns the sizes of the shared work areas on a device.
+
+    Args:
+        device_id (int): The device ID.
+
+    Returns:
+        dict: The sizes in bytes, keyed by the stream pointers.
+
+    """
+    cdef dict sizes = {}
+    for (dev, s), work_area in _shared_work_areas.items():
+        if dev == device_id:
+            sizes[s] = work_area.mem.size
+    return sizes
+
+
+cpdef release_shared_work_areas(int device_id):
+    """Releases the shared work areas on a device.
+
+    Plans sharing them allocate a new one on their next execution.
+
+    Args:
+        device_id (int): The device ID.
+
+    """
+    cdef tuple key
+    for key in list(_shared_work_areas):
+        if key[0] == device_id:
+            del _shared_work_areas[key]
+
+
+cdef void _set_jit_callbacks(Handle plan, tuple jit_callbacks) except*:
+    # Each item is (symbol name, LTO-IR, callback type, caller info pointer).
+    # This must be done before the plan is made.
+    cdef bytes name, ltoir
+    cdef int cb_type, result
+    cdef intptr_t caller_info
+    cdef void** caller_info_ptr
+
+    for name, ltoir, cb_type, caller_info in jit_callbacks:
+        caller_info_ptr = <void**>(&caller_info) if caller_info else NULL
+        result = cufftXtSetJITCallback(
+            plan, name, <const char*>ltoir, len(ltoir),
+            <JITCallbackType>cb_type, caller_info_ptr)
+        check_result(result)
+
+
 cdef class Plan1d:
     def __init__(self, int nx, int fft_type, int batch, *,
-                 devices=None, out=None):
+                 devices=None, out=None, tuple jit_callbacks=None,
+                 bint shared_work_area=False, bint deferred_work_area=False):
         cdef Handle plan
         cdef bint use_multi_gpus = 0 if devices is None else 1
         cdef int result
@@ -291,8 +388,20 @@ cdef class Plan1d:
 
         self.handle = <intptr_t>plan
         self.work_area = None
+        self.work_size = 0
+        # not supported for multi-GPU plans
+        self.shared_work_area = shared_work_area and not use_multi_gpus
+        self.deferred_work_area = (
+            deferred_work_area and not use_multi_gpus
+            and not self.shared_work_area)
         self.gpus = None
 
+        if jit_callbacks:
+            if use_multi_gpus:
+                raise NotImplementedError(
+                    'multi-GPU cuFFT callbacks are not yet supported')
+            _set_jit_callbacks(plan, jit_callbacks)
+
         self.gather_streams = None
         self.gather_events = None
         self.scatter_streams = None
@@ -341,6 +450,11 @@ cdef class Plan1d:
                                          &work_size)
         check_result(result)
 
+        self.work_size = work_size
+        if self.shared_work_area or self.deferred_work_area:
+            # set right before each execution
+            return
+
         work_area = memory.alloc(work_size)
         ptr = <intptr_t>(work_area.ptr)
         with nogil:
@@ -507,6 +621,10 @@ cdef class Plan1d:
         with nogil:
             result = cufftSetStream(<Handle>plan, <Stream>s)
         check_result(result)
+        if self.shared_work_area:
+            _set_shared_work_area(plan, self.work_size, s)
+        elif self.deferred_work_area:
+            work_area = _borrow_work_area(plan, self.work_size)
 
         if self.fft_type == CUFFT_C2C:
             execC2C(plan, a.data.ptr, out.data.ptr, direction)
@@ -742,7 +860,9 @@ cdef class Plan1d:
 cdef class PlanNd:
     def __init__(self, object shape, object inembed, int istride,
                  int idist, object onembed, int ostride, int odist,
-                 int fft_type, int batch, str order, int last_axis, last_size):
+                 int fft_type, int batch, str order, int last_axis, last_size,
+                 *, tuple jit_callbacks=None, bint shared_work_area=False,
+                 bint deferred_work_area=False):
         cdef Handle plan
         cdef size_t work_size
         cdef int ndim, result
@@ -778,6 +898,9 @@ cdef class PlanNd:
         self.handle = <intptr_t>plan
         self.gpus = None  # TODO(leofang): support multi-GPU PlanNd
 
+        if jit_callbacks:
+            _set_jit_callbacks(plan, jit_callbacks)
+
         if batch == 0:
             work_size = 0
         else:
@@ -802,11 +925,17 @@ cdef class PlanNd:
         # TODO: for CUDA>=9.2 could also allow setting a work area policy
         # result = cufftXtSetWorkAreaPolicy(plan, policy, &work_size)
 
-        work_area = memory.alloc(work_size)
-        ptr = <intptr_t>(work_area.ptr)
-        with nogil:
-            result = cufftSetWorkArea(plan, <void*>(ptr))
-        check_result(result)
+        self.work_size = work_size
+        self.shared_work_area = shared_work_area
+        self.deferred_work_area = deferred_work_area and not shared_work_area
+        if shared_work_area or deferred_work_area:
+            work_area = None  # set right before each execution
+        else:
+            work_area = memory.alloc(work_size)
+            ptr = <intptr_t>(work_area.ptr)
+            with nogil:
+                result = cufftSetWorkArea(plan, <void*>(ptr))
+            check_result(result)
 
         self.shape = tuple(shape)
         self.fft_type = <Type>fft_type
@@ -840,6 +969,10 @@ cdef class PlanNd:
         with nogil:
             result = cufftSetStream(<Handle>plan, <Stream>s)
         check_result(result)
+        if self.shared_work_area:
+            _set_shared_work_area(plan, self.work_size, s)
+        elif self.deferred_work_area:
+            work_area = _borrow_work_area(plan, self.work_size)
 
         if self.fft_type == CUFFT_C2C:
             execC2C(plan, a.data.ptr, out.data.ptr, direction)
@@ -1,13 +1,16 @@
 #include "cupy_cub.h"  // need to make atomicAdd visible to CUB templates early
 #include <cupy/type_dispatcher.cuh>
+#include <climits> // For INT_MAX
 
 #ifndef CUPY_USE_HIP
 #include <cfloat> // For FLT_MAX definitions
 #include <cub/device/device_reduce.cuh>
 #include <cub/device/device_segmented_reduce.cuh>
-#include <cub/device/device_spmv.cuh>
 #include <cub/device/device_scan.cuh>
+#include <cub/thread/thread_operators.cuh>
 #include <cub/device/device_histogram.cuh>
+#include <cub/device/device_select.cuh>
+#include <cub/device/device_partition.cuh>
 #include <cub/iterator/counting_input_iterator.cuh>
 #include <cub/iterator/transform_input_iterator.cuh>
 #else
@@ -15,6 +18,8 @@
 #include <hipcub/device/device_segmented_reduce.hpp>
 #include <hipcub/device/device_scan.hpp>
 #include <hipcub/device/device_histogram.hpp>
+#include <hipcub/device/device_select.hpp>
+#include <hipcub/device/device_partition.hpp>
 #include <rocprim/iterator/counting_iterator.hpp>
 #include <hipcub/iterator/transform_input_iterator.hpp>
 #endif
@@ -100,6 +105,20 @@ class numeric_limits<__half> {
     static constexpr bool has_infinity = true;
 };
 
+#ifdef CUPY_ENABLE_BFLOAT16
+template <>
+class numeric_limits<__nv_bfloat16> {
+  public:
+    static __host__ __device__ __nv_bfloat16 infinity() noexcept {
+        __nv_bfloat16_raw inf_raw;
+        inf_raw.x = 0x7F80U;
+        return __nv_bfloat16(inf_raw);
+    }
+
+    static constexpr bool has_infinity = true;
+};
+#endif  // CUPY_ENABLE_BFLOAT16
+
 }  // namespace std
 
 
@@ -185,6 +204,43 @@ __host__ __device__ __half half_negate_inf() {
     return *minf_value;
 }
 
+// -infinity; the unary minus does not compile for __half on HIP, nor for
+// __nv_bfloat16 on the host
+template <typename T>
+__host__ __device__ __forceinline__ T _cub_negative_infinity() {
+    return -std::numeric_limits<T>::infinity();
+}
+
+template <>
+__host__ __device__ __forceinline__ __half _cub_negative_infinity<__half>() {
+    return half_negate_inf();
+}
+
+#ifdef CUPY_ENABLE_BFLOAT16
+template <>
+__host__ __device__ __forceinline__ __nv_bfloat16 _cub_negative_infinity<__nv_bfloat16>() {
+    __nv_bfloat16_raw minf_raw;
+    minf_raw.x = 0xFF80U;
+    return __nv_bfloat16(minf_raw);
+}
+
+__host__ __device__ __forceinline__ bool bf16_isnan(const __nv_bfloat16& x) {
+#ifdef __CUDA_ARCH__
+    return __hisnan(x);
+#else
+    return isnan(__bfloat162float(x));
+#endif
+}
+
+__host__ __device__ __forceinline__ bool bf16_less(const __nv_bfloat16& l, const __nv_bfloat16& r) {
+#ifdef __CUDA_ARCH__
+    return l < r;
+#else
+    return __bfloat162float(l) < __bfloat162float(r);
+#endif
+}
+#endif  // CUPY_ENABLE_BFLOAT16
+
 /* ------------------------------------ end of boilerplate ------------------------------------ */
 
 
@@ -207,24 +263,30 @@ struct _multiply
 //
 // arange functor: arange(0, n+1) -> arange(0, n+1, step_size)
 //
+template <typename OffsetT>
 struct _arange
 {
     private:
-        int step_size;
+        OffsetT step_size;
 
     public:
-    __host__ __device__ __forceinline__ _arange(int i): step_size(i) {}
-    __host__ __device__ __forceinline__ int operator()(const int &in) const {
+    __host__ __device__ __forceinline__ _arange(OffsetT i): step_size(i) {}
+    __host__ __device__ __forceinline__ OffsetT operator()(const OffsetT &in) const {
         return step_size * in;
     }
 };
 
 #ifndef CUPY_USE_HIP
-typedef TransformInputIterator<int, _arange, CountingInputIterator<int>> seg_offset_itr;
+template <typename OffsetT>
+using counting_itr = CountingInputIterator<OffsetT>;
 #else
-typedef TransformInputIterator<int, _arange, rocprim::counting_iterator<int>> seg_offset_itr;
+template <typename OffsetT>
+using counting_itr = rocprim::counting_iterator<OffsetT>;
 #endif
 
+template <typename OffsetT>
+using seg_offset_itr = TransformInputIterator<OffsetT, _arange<OffsetT>, counting_itr<OffsetT>>;
+
 /*
    These stubs are needed because CUB does not handle NaNs properly, while NumPy has certain
    behaviors with which we must comply.
@@ -622,6 +684,17 @@ __host__ __device__ __forceinline__ __half Max::operator()(__half &a, __half &b)
 }
 #endif
 
+#ifdef CUPY_ENABLE_BFLOAT16
+template<>
+__host__ __device__ __forceinline__ __nv_bfloat16 Max::operator()(__nv_bfloat16 &a, __nv_bfloat16 &b) const
+{
+    // NumPy behavior: NaN is always chosen!
+    if (bf16_isnan(a)) {return a;}
+    else if (bf16_isnan(b)) {return b;}
+    else { return bf16_less(a, b) ? b : a; }
+}
+#endif
+
 //
 // Min()
 //
@@ -677,6 +750,17 @@ __host__ __device__ __forceinline__ __half Min::operator()(__half &a, __half &b)
 }
 #endif
 
+#ifdef CUPY_ENABLE_BFLOAT16
+template<>
+__host__ __device__ __forceinline__ __nv_bfloat16 Min::operator()(__nv_bfloat16 &a, __nv_bfloat16 &b) const
+{
+    // NumPy behavior: NaN is always chosen!
+    if (bf16_isnan(a)) {return a;}
+    else if (bf16_isnan(b)) {return b;}
+    else { return bf16_less(a, b) ? a : b; }
+}
+#endif
+
 #endif  // #ifndef CUPY_USE_HIP
 
 /* ------------------------------------ End of "patches" ------------------------------------ */
@@ -684,20 +768,22 @@ __host__ __device__ __forceinline__ __half Min::operator()(__half &a, __half &b)
 //
 // **** CUB Sum ****
 //
+template <typename OffsetT>
 struct _cub_reduce_sum {
     template <typename T>
     void operator()(void* workspace, size_t& workspace_size, void* x, void* y,
-        int num_items, cudaStream_t s)
+        OffsetT num_items, cudaStream_t s)
     {
         DeviceReduce::Sum(workspace, workspace_size, static_cast<T*>(x),
             static_cast<T*>(y), num_items, s);
     }
 };
 
+template <typename OffsetT>
 struct _cub_segmented_reduce_sum {
     template <typename T>
     void operator()(void* workspace, size_t& workspace_size, void* x, void* y,
-        int num_segments, seg_offset_itr offset_start, cudaStream_t s)
+        int num_segments, seg_offset_itr<OffsetT> offset_start, cudaStream_t s)
     {
         DeviceSegmentedReduce::Sum(workspace, workspace_size,
             static_cast<T*>(x), static_cast<T*>(y), num_segments,
@@ -708,10 +794,11 @@ struct _cub_segmented_reduce_sum {
 //
 // **** CUB Prod ****
 //
+template <typename OffsetT>
 struct _cub_reduce_prod {
     template <typename T>
     void operator()(void* workspace, size_t& workspace_size, void* x, void* y,
-        int num_items, cudaStream_t s)
+        OffsetT num_items, cudaStream_t s)
     {
         _multiply product_op;
         // the init value is cast from 1.0f because on host __half can only be
@@ -721,10 +808,11 @@ struct _cub_reduce_prod {
     }
 };
 
+template <typename OffsetT>
 struct _cub_segmented_reduce_prod {
     template <typename T>
     void operator()(void* workspace, size_t& workspace_size, void* x, void* y,
-        int num_segments, seg_offset_itr offset_start, cudaStream_t s)
+        int num_segments, seg_offset_itr<OffsetT> offset_start, cudaStream_t s)
     {
         _multiply product_op;
         // the init value is cast from 1.0f because on host __half can only be
@@ -739,10 +827,11 @@ struct _cub_segmented_reduce_prod {
 //
 // **** CUB Min ****
 //
+template <typename OffsetT>
 struct _cub_reduce_min {
     template <typename T>
     void operator()(void* workspace, size_t& workspace_size, void* x, void* y,
-        int num_items, cudaStream_t s)
+        OffsetT num_items, cudaStream_t s)
     {
         if constexpr (std::numeric_limits<T>::has_infinity)
         {
@@ -758,10 +847,11 @@ struct _cub_reduce_min {
     }
 };
 
+template <typename OffsetT>
 struct _cub_segmented_reduce_min {
     template <typename T>
     void operator()(void* workspace, size_t& workspace_size, void* x, void* y,
-        int num_segments, seg_offset_itr offset_start, cudaStream_t s)
+        int num_segments, seg_offset_itr<OffsetT> offset_start, cudaStream_t s)
     {
         if constexpr (std::numeric_limits<T>::has_infinity)
         {
@@ -782,27 +872,17 @@ struct _cub_segmented_reduce_min {
 //
 // **** CUB Max ****
 //
+template <typename OffsetT>
 struct _cub_reduce_max {
     template <typename T>
     void operator()(void* workspace, size_t& workspace_size, void* x, void* y,
-        int num_items, cudaStream_t s)
+        OffsetT num_items, cudaStream_t s)
     {
         if constexpr (std::numeric_limits<T>::has_infinity)
         {
-            // to avoid compiler error: invalid argument type '__half' to unary expression on HIP...
-            if constexpr (std::is_same_v<T, __half>)
-            {
-                DeviceReduce::Reduce(workspace, workspace_size, static_cast<T*>(x),
-                    static_cast<T*>(y), num_items,
-                    CUPY_CUB_NAMESPACE::Max(), half_negate_inf(), s);
-            }
-            else
-            {
-                DeviceReduce::Reduce(workspace, workspace_size, static_cast<T*>(x),
-                    static_cast<T*>(y), num_items,
-                    CUPY_CUB_NAMESPACE::Max(), -std::numeric_limits<T>::infinity(), s);
-
-            }
+            DeviceReduce::Reduce(workspace, workspace_size, static_cast<T*>(x),
+                static_cast<T*>(y), num_items,
+                CUPY_CUB_NAMESPACE::Max(), _cub_negative_infinity<T>(), s);
         }
         else
         {
@@ -812,28 +892,18 @@ struct _cub_reduce_max {
     }
 };
 
+template <typename OffsetT>
 struct _cub_segmented_reduce_max {
     template <typename T>
     void operator()(void* workspace, size_t& workspace_size, void* x, void* y,
-        int num_segments, seg_offset_itr offset_start, cudaStream_t s)
+        int num_segments, seg_offset_itr<OffsetT> offset_start, cudaStream_t s)
     {
         if constexpr (std::numeric_limits<T>::has_infinity)
         {
-            // to avoid compiler error: invalid argument type '__half' to unary expression on HIP...
-            if constexpr (std::is_same_v<T, __half>)
-            {
-                DeviceSegmentedReduce::Reduce(workspace, workspace_size,
-                    static_cast<T*>(x), static_cast<T*>(y), num_segments,
-                    offset_start, offset_start+1,
-                    CUPY_CUB_NAMESPACE::Max(), half_negate_inf(), s);
-            }
-            else
-            {
-                DeviceSegmentedReduce::Reduce(workspace, workspace_size,
-                    static_cast<T*>(x), static_cast<T*>(y), num_segments,
-                    offset_start, offset_start+1,
-                    CUPY_CUB_NAMESPACE::Max(), -std::numeric_limits<T>::infinity(), s);
-            }
+            DeviceSegmentedReduce::Reduce(workspace, workspace_size,
+                static_cast<T*>(x), static_cast<T*>(y), num_segments,
+                offset_start, offset_start+1,
+                CUPY_CUB_NAMESPACE::Max(), _cub_negative_infinity<T>(), s);
         }
         else
         {
@@ -847,10 +917,11 @@ struct _cub_segmented_reduce_max {
 //
 // **** CUB ArgMin ****
 //
+template <typename OffsetT>
 struct _cub_reduce_argmin {
     template <typename T>
     void operator()(void* workspace, size_t& workspace_size, void* x, void* y,
-        int num_items, cudaStream_t s)
+        OffsetT num_items, cudaStream_t s)
     {
         DeviceReduce::ArgMin(workspace, workspace_size, static_cast<T*>(x),
             static_cast<KeyValuePair<int, T>*>(y), num_items, s);
@@ -862,10 +933,11 @@ struct _cub_reduce_argmin {
 //
 // **** CUB ArgMax ****
 //
+template <typename OffsetT>
 struct _cub_reduce_argmax {
     template <typename T>
     void operator()(void* workspace, size_t& workspace_size, void* x, void* y,
-        int num_items, cudaStream_t s)
+        OffsetT num_items, cudaStream_t s)
     {
         DeviceReduce::ArgMax(workspace, workspace_size, static_cast<T*>(x),
             static_cast<KeyValuePair<int, T>*>(y), num_items, s);
@@ -875,30 +947,357 @@ struct _cub_reduce_argmax {
 // TODO(leofang): add _cub_segmented_reduce_argmax
 
 //
-// **** CUB SpMV ****
+// **** CUB multi-statistic reduce ****
+//
+// All requested statistics are carried in one tuple-like struct so that the
+// input is read only once. The struct is "empty" for the initial value, which
+// spares us from providing identities (infinity, lowest, ...) for every dtype.
 //
-struct _cub_device_spmv {
+template <typename T>
+struct _multi_stat {
+    T sum;
+    T prod;
+    T min;
+    T max;
+    long long argmin;
+    long long argmax;
+    bool empty;
+};
+
+template <typename T>
+__host__ __device__ __forceinline__ bool _multi_isnan(const T& x) { return false; }
+__host__ __device__ __forceinline__ bool _multi_isnan(const float& x) { return isnan(x); }
+__host__ __device__ __forceinline__ bool _multi_isnan(const double& x) { return isnan(x); }
+__host__ __device__ __forceinline__ bool _multi_isnan(const complex<float>& x) { return isnan(x); }
+__host__ __device__ __forceinline__ bool _multi_isnan(const complex<double>& x) { return isnan(x); }
+
+template <typename T>
+__host__ __device__ __forceinline__ bool _multi_less(const T& l, const T& r) { return l < r; }
+
+template <typename T>
+__host__ __device__ __forceinline__ bool _multi_equal(const T& l, const T& r) { return l == r; }
+
+#if ((__CUDACC_VER_MAJOR__ > 9 || (__CUDACC_VER_MAJOR__ == 9 && __CUDACC_VER_MINOR__ == 2)) \
+    && (__CUDA_ARCH__ >= 530 || !defined(__CUDA_ARCH__))) || (defined(__HIPCC__) || defined(CUPY_USE_HIP))
+__host__ __device__ __forceinline__ bool _multi_isnan(const __half& x) { return half_isnan(x); }
+template <>
+__host__ __device__ __forceinline__ bool _multi_less(const __half& l, const __half& r) { return half_less(l, r); }
+template <>
+__host__ __device__ __forceinline__ bool _multi_equal(const __half& l, const __half& r) { return half_equal(l, r); }
+#endif
+
+template <typename T>
+struct _to_multi_stat {
+    const T* x;
+
+    __host__ __device__ __forceinline__ _to_multi_stat(const T* x): x(x) {}
+    __host__ __device__ __forceinline__ _multi_stat<T> operator()(const int& i) const {
+        _multi_stat<T> s;
+        const T v = x[i];
+        s.sum = v;
+        s.prod = v;
+        s.min = v;
+        s.max = v;
+        s.argmin = i;
+        s.argmax = i;
+        s.empty = false;
+        return s;
+    }
+};
+
+template <typename T>
+struct _multi_stat_op {
+    int op_mask;
+
+    __host__ __device__ __forceinline__ _multi_stat_op(int mask): op_mask(mask) {}
+    __host__ __device__ __forceinline__ _multi_stat<T> operator()(
+        const _multi_stat<T>& a, const _multi_stat<T>& b) const
+    {
+        if (a.empty) {return b;}
+        if (b.empty) {return a;}
+
+        _multi_stat<T> r;
+        r.empty = false;
+        if (op_mask & CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_SUM)) {
+            r.sum = a.sum + b.sum;
+        }
+        if (op_mask & CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_PROD)) {
+            r.prod = a.prod * b.prod;
+        }
+        if (op_mask & (CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_MIN) |
+                       CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_ARGMIN))) {
+            // NumPy behavior: the first NaN is always chosen
+            bool take_b;
+            if (_multi_isnan(a.min)) {take_b = false;}
+            else if (_multi_isnan(b.min)) {take_b = true;}
+            else {
+                take_b = _multi_less(b.min, a.min) ||
+                         (_multi_equal(a.min, b.min) && (b.argmin < a.argmin));
+            }
+            r.min = take_b ? b.min : a.min;
+            r.argmin = take_b ? b.argmin : a.argmin;
+        }
+        if (op_mask & (CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_MAX) |
+                       CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_ARGMAX))) {
+            bool take_b;
+            if (_multi_isnan(a.max)) {take_b = false;}
+            else if (_multi_isnan(b.max)) {take_b = true;}
+            else {
+                take_b = _multi_less(a.max, b.max) ||
+                         (_multi_equal(a.max, b.max) && (b.argmax < a.argmax));
+            }
+            r.max = take_b ? b.max : a.max;
+            r.argmax = take_b ? b.argmax : a.argmax;
+        }
+        return r;
+    }
+};
+
+// Scatter the fields of the reduced struct to the user-visible outputs:
+// values = [sum, prod, min, max] (of type T), indices = [argmin, argmax].
+template <typename T>
+__global__ void _cub_multi_reduce_unpack(const _multi_stat<T>* stat,
+    T* values, long long* indices, int op_mask)
+{
+    if (op_mask & CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_SUM))    {values[0] = stat->sum;}
+    if (op_mask & CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_PROD))   {values[1] = stat->prod;}
+    if (op_mask & CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_MIN))    {values[2] = stat->min;}
+    if (op_mask & CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_MAX))    {values[3] = stat->max;}
+    if (op_mask & CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_ARGMIN)) {indices[0] = stat->argmin;}
+    if (op_mask & CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_ARGMAX)) {indices[1] = stat->argmax;}
+}
+
+struct _cub_multi_reduce {
     template <typename T>
-    void operator()(void* workspace, size_t& workspace_size, void* values,
-        void* row_offsets, void* column_indices, void* x, void* y,
-        int num_rows, int num_cols, int num_nonzeros, cudaStream_t stream)
+    void operator()(void* workspace, size_t& workspace_size, void* x,
+        void* values, void* indices, int num_items, cudaStream_t s, int op_mask)
     {
-        #ifndef CUPY_USE_HIP
-        DeviceSpmv::CsrMV(workspace, workspace_size, static_cast<T*>(values),
-            static_cast<int*>(row_offsets), static_cast<int*>(column_indices),
-            static_cast<T*>(x), static_cast<T*>(y), num_rows, num_cols,
-            num_nonzeros, stream);
-        #endif
+        typedef _multi_stat<T> stat_t;
+        typedef counting_itr<int> count_itr_t;
+        typedef TransformInputIterator<stat_t, _to_multi_stat<T>, count_itr_t> stat_itr_t;
+
+        // the reduced struct lives at the head of the workspace
+        const size_t offset = (sizeof(stat_t) + 255) / 256 * 256;
+        count_itr_t count_itr(0);
+        stat_itr_t itr(count_itr, _to_multi_stat<T>(static_cast<T*>(x)));
+        _multi_stat_op<T> op(op_mask);
+        stat_t init;
+        init.empty = true;
+
+        if (workspace == NULL) {
+            size_t temp_size = 0;
+            DeviceReduce::Reduce(NULL, temp_size, itr, static_cast<stat_t*>(NULL),
+                num_items, op, init, s);
+            workspace_size = offset + temp_size;
+            return;
+        }
+
+        stat_t* d_stat = static_cast<stat_t*>(workspace);
+        size_t temp_size = workspace_size - offset;
+        DeviceReduce::Reduce(static_cast<char*>(workspace) + offset, temp_size,
+            itr, d_stat, num_items, op, init, s);
+        _cub_multi_reduce_unpack<T><<<1, 1, 0, s>>>(d_stat, static_cast<T*>(values),
+            static_cast<long long*>(indices), op_mask);
     }
 };
 
+//
+// **** CUB NaN-ignoring sum, mean and variance ****
+//
+// The count of the items that are not NaN and their sum, or for the variance
+// their mean and the sum of the squared deviations from it, are reduced in a
+// single pass. The variance is merged with the pairwise update of Chan et
+// al., so that no mean has to be computed beforehand. float16 is
+// accumulated in single precision.
+//
+template <typename T>
+struct _nan_acc {
+    typedef T type;
+    typedef T real;
+    static constexpr bool value = false;
+};
+
+template <>
+struct _nan_acc<float> {
+    typedef float type;
+    typedef float real;
+    static constexpr bool value = true;
+};
+
+template <>
+struct _nan_acc<double> {
+    typedef double type;
+    typedef double real;
+    static constexpr bool value = true;
+};
+
+template <>
+struct _nan_acc<complex<float>> {
+    typedef complex<float> type;
+    typedef float real;
+    static constexpr bool value = true;
+};
+
+template <>
+struct _nan_acc<complex<double>> {
+    typedef complex<double> type;
+    typedef double real;
+    static constexpr bool value = true;
+};
+
+#if ((__CUDACC_VER_MAJOR__ > 9 || (__CUDACC_VER_MAJOR__ == 9 && __CUDACC_VER_MINOR__ == 2)) \
+    && (__CUDA_ARCH__ >= 530 || !defined(__CUDA_ARCH__))) || (defined(__HIPCC__) || defined(CUPY_USE_HIP))
+template <>
+struct _nan_acc<__half> {
+    typedef float type;
+    typedef float real;
+    static constexpr bool value = true;
+};
+#endif
+
+// the dtype of the variance
+template <typename T> struct _nan_var_type { typedef T type; };
+template <> struct _nan_var_type<complex<float>> { typedef float type; };
+template <> struct _nan_var_type<complex<double>> { typedef double type; };
+
+__host__ __device__ __forceinline__ float _nan_norm(const float& x) { return x * x; }
+__host__ __device__ __forceinline__ double _nan_norm(const double& x) { return x * x; }
+__host__ __device__ __forceinline__ float _nan_norm(const complex<float>& x) { return norm(x); }
+__host__ __device__ __forceinline__ double _nan_norm(const complex<double>& x) { return norm(x); }
+
+template <typename A, typename R>
+struct _nan_stat {
+    long long count;
+    A mean;  // the sum for the sum and the mean
+    R m2;
+};
+
+template <typename T>
+struct _to_nan_stat {
+    typedef _nan_stat<typename _nan_acc<T>::type, typename _nan_acc<T>::real> stat_t;
+
+    __host__ __device__ __forceinline__ stat_t operator()(const T& x) const {
+        typedef typename _nan_acc<T>::type A;
+        typedef typename _nan_acc<T>::real R;
+        const bool nan = _multi_isnan(x);
+        stat_t s;
+        s.count = nan ? 0 : 1;
+        s.mean = nan ? A(0) : A(x);
+        s.m2 = R(0);
+        return s;
+    }
+};
+
+template <typename A, typename R>
+struct _nan_stat_op {
+    bool variance;
+
+    __host__ __device__ __forceinline__ _nan_stat_op(bool variance): variance(variance) {}
+    __host__ __device__ __forceinline__ _nan_stat<A, R> operator()(
+        const _nan_stat<A, R>& a, const _nan_stat<A, R>& b) const
+    {
+        _nan_stat<A, R> r;
+        r.count = a.count + b.count;
+        if (!variance) {
+            r.mean = a.mean + b.mean;
+            r.m2 = R(0);
+            return r;
+        }
+        if (a.count == 0) {return b;}
+        if (b.count == 0) {return a;}
+        const A delta = b.mean - a.mean;
+        const R wb = R(b.count) / R(r.count);
+        r.mean = a.mean + delta * wb;
+        r.m2 = a.m2 + b.m2 + _nan_norm(delta) * R(a.count) * wb;
+        return r;
+    }
+};
+
+// The empty sum is 0, and the mean and the variance without items (or
+// degrees of freedom) are NaN, as in NumPy.
+template <typename T, typename A, typename R>
+__global__ void _cub_nan_reduce_unpack(const _nan_stat<A, R>* stat, void* y,
+    int op, long long ddof)
+{
+    if (op == CUPY_CUB_NANSUM) {
+        static_cast<T*>(y)[0] = T(stat->mean);
+    } else if (op == CUPY_CUB_NANMEAN) {
+        static_cast<T*>(y)[0] = T(stat->mean / R(stat->count));
+    } else {
+        typedef typename _nan_var_type<T>::type V;
+        const long long dof = stat->count - ddof;
+        static_cast<V*>(y)[0] = V(dof > 0 ? stat->m2 / R(dof) : R(NAN));
+    }
+}
+
+struct _cub_nan_reduce {
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* x, void* y,
+        int num_items, cudaStream_t s, int op, int64_t ddof)
+    {
+        if constexpr (_nan_acc<T>::value) {
+            typedef typename _nan_acc<T>::type A;
+            typedef typename _nan_acc<T>::real R;
+            typedef _nan_stat<A, R> stat_t;
+            typedef TransformInputIterator<stat_t, _to_nan_stat<T>, const T*> stat_itr_t;
+
+            // the reduced struct lives at the head of the workspace
+            const size_t offset = (sizeof(stat_t) + 255) / 256 * 256;
+            stat_itr_t itr(static_cast<const T*>(x), _to_nan_stat<T>());
+            _nan_stat_op<A, R> stat_op(op == CUPY_CUB_NANVAR);
+            stat_t init;
+            init.count = 0;
+            init.mean = A(0);
+            init.m2 = R(0);
+
+            if (workspace == NULL) {
+                size_t temp_size = 0;
+                DeviceReduce::Reduce(NULL, temp_size, itr, static_cast<stat_t*>(NULL),
+                    num_items, stat_op, init, s);
+                workspace_size = offset + temp_size;
+                return;
+            }
+
+            stat_t* d_stat = static_cast<stat_t*>(workspace);
+            size_t temp_size = workspace_size - offset;
+            DeviceReduce::Reduce(static_cast<char*>(workspace) + offset, temp_size,
+                itr, d_stat, num_items, stat_op, init, s);
+            _cub_nan_reduce_unpack<T, A, R><<<1, 1, 0, s>>>(d_stat, y, op, ddof);
+        } else {
+            throw std::runtime_error("Unsupported dtype ID");
+        }
+    }
+};
+
+//
+// identities for min/max scans
+//
+template <typename T>
+__host__ __device__ __forceinline__ T _cub_min_identity() {
+    if constexpr (std::numeric_limits<T>::has_infinity) {
+        return std::numeric_limits<T>::infinity();
+    } else {
+        return std::numeric_limits<T>::max();
+    }
+}
+
+template <typename T>
+__host__ __device__ __forceinline__ T _cub_max_identity() {
+    if constexpr (std::numeric_limits<T>::has_infinity) {
+        return _cub_negative_infinity<T>();
+    } else {
+        return std::numeric_limits<T>::lowest();
+    }
+}
+
 //
 // **** CUB InclusiveSum  ****
 //
+template <typename OffsetT>
 struct _cub_inclusive_sum {
     template <typename T>
     void operator()(void* workspace, size_t& workspace_size, void* input, void* output,
-        int num_items, cudaStream_t s)
+        OffsetT num_items, cudaStream_t s)
     {
         DeviceScan::InclusiveSum(workspace, workspace_size, static_cast<T*>(input),
             static_cast<T*>(output), num_items, s);
@@ -908,10 +1307,11 @@ struct _cub_inclusive_sum {
 //
 // **** CUB inclusive product  ****
 //
+template <typename OffsetT>
 struct _cub_inclusive_product {
     template <typename T>
     void operator()(void* workspace, size_t& workspace_size, void* input, void* output,
-        int num_items, cudaStream_t s)
+        OffsetT num_items, cudaStream_t s)
     {
         _multiply product_op;
         DeviceScan::InclusiveScan(workspace, workspace_size, static_cast<T*>(input),
@@ -919,95 +1319,687 @@ struct _cub_inclusive_product {
     }
 };
 
+//
+// **** CUB inclusive min/max  ****
+//
+template <typename OffsetT>
+struct _cub_inclusive_min {
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* input, void* output,
+        OffsetT num_items, cudaStream_t s)
+    {
+        DeviceScan::InclusiveScan(workspace, workspace_size, static_cast<T*>(input),
+            static_cast<T*>(output), CUPY_CUB_NAMESPACE::Min(), num_items, s);
+    }
+};
+
+template <typename OffsetT>
+struct _cub_inclusive_max {
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* input, void* output,
+        OffsetT num_items, cudaStream_t s)
+    {
+        DeviceScan::InclusiveScan(workspace, workspace_size, static_cast<T*>(input),
+            static_cast<T*>(output), CUPY_CUB_NAMESPACE::Max(), num_items, s);
+    }
+};
+
+//
+// **** CUB ExclusiveSum  ****
+//
+template <typename OffsetT>
+struct _cub_exclusive_sum {
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* input, void* output,
+        OffsetT num_items, cudaStream_t s)
+    {
+        DeviceScan::ExclusiveSum(workspace, workspace_size, static_cast<T*>(input),
+            static_cast<T*>(output), num_items, s);
+    }
+};
+
+//
+// **** CUB exclusive product/min/max  ****
+//
+template <typename OffsetT>
+struct _cub_exclusive_product {
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* input, void* output,
+        OffsetT num_items, cudaStream_t s)
+    {
+        _multiply product_op;
+        // the init value is cast from 1.0f because on host __half can only be
+        // initialized by float or double; static_cast<__half>(1) = 0 on host.
+        DeviceScan::ExclusiveScan(workspace, workspace_size, static_cast<T*>(input),
+            static_cast<T*>(output), product_op, static_cast<T>(1.0f), num_items, s);
+    }
+};
+
+template <typename OffsetT>
+struct _cub_exclusive_min {
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* input, void* output,
+        OffsetT num_items, cudaStream_t s)
+    {
+        DeviceScan::ExclusiveScan(workspace, workspace_size, static_cast<T*>(input),
+            static_cast<T*>(output), CUPY_CUB_NAMESPACE::Min(), _cub_min_identity<T>(),
+            num_items, s);
+    }
+};
+
+template <typename OffsetT>
+struct _cub_exclusive_max {
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* input, void* output,
+        OffsetT num_items, cudaStream_t s)
+    {
+        DeviceScan::ExclusiveScan(workspace, workspace_size, static_cast<T*>(input),
+            static_cast<T*>(output), CUPY_CUB_NAMESPACE::Max(), _cub_max_identity<T>(),
+            num_items, s);
+    }
+};
+
+//
+// **** CUB ScanByKey ****
+//
+// keys: an iterator over the segment ID of each item; items of consecutive
+// equal keys are scanned independently.
+//
+template <typename KeyItrT, typename OffsetT>
+struct _cub_scan_by_key {
+    int op;
+
+    _cub_scan_by_key(int op): op(op) {}
+
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, KeyItrT keys,
+        void* input, void* output, OffsetT num_items, cudaStream_t s) const
+    {
+        T* x = static_cast<T*>(input);
+        T* y = static_cast<T*>(output);
+        CUPY_CUB_NAMESPACE::Equality eq;
+        _multiply product_op;
+
+        switch(op) {
+        case CUPY_CUB_CUMSUM:
+            DeviceScan::InclusiveSumByKey(workspace, workspace_size, keys, x, y,
+                num_items, eq, s);
+            break;
+        case CUPY_CUB_CUMPROD:
+            DeviceScan::InclusiveScanByKey(workspace, workspace_size, keys, x, y,
+                product_op, num_items, eq, s);
+            break;
+        case CUPY_CUB_CUMMIN:
+            DeviceScan::InclusiveScanByKey(workspace, workspace_size, keys, x, y,
+                CUPY_CUB_NAMESPACE::Min(), num_items, eq, s);
+            break;
+        case CUPY_CUB_CUMMAX:
+            DeviceScan::InclusiveScanByKey(workspace, workspace_size, keys, x, y,
+                CUPY_CUB_NAMESPACE::Max(), num_items, eq, s);
+            break;
+        case CUPY_CUB_EXCLUSIVE_CUMSUM:
+            DeviceScan::ExclusiveSumByKey(workspace, workspace_size, keys, x, y,
+                num_items, eq, s);
+            break;
+        case CUPY_CUB_EXCLUSIVE_CUMPROD:
+            DeviceScan::ExclusiveScanByKey(workspace, workspace_size, keys, x, y,
+                product_op, static_cast<T>(1.0f), num_items, eq, s);
+            break;
+        case CUPY_CUB_EXCLUSIVE_CUMMIN:
+            DeviceScan::ExclusiveScanByKey(workspace, workspace_size, keys, x, y,
+                CUPY_CUB_NAMESPACE::Min(), _cub_min_identity<T>(), num_items, eq, s);
+            break;
+        case CUPY_CUB_EXCLUSIVE_CUMMAX:
+            DeviceScan::ExclusiveScanByKey(workspace, workspace_size, keys, x, y,
+                CUPY_CUB_NAMESPACE::Max(), _cub_max_identity<T>(), num_items, eq, s);
+            break;
+        default:
+            throw std::runtime_error("Unsupported operation");
+        }
+    }
+};
+
+//
+// **** CUB ReduceByKey ****
+//
+// keys: the int64 key of each item; each run of consecutive equal keys is
+// reduced to one item, so sorted keys give one item per distinct key.
+//
+template <typename OffsetT>
+struct _cub_reduce_by_key {
+    int op;
+
+    _cub_reduce_by_key(int op): op(op) {}
+
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* keys,
+        void* unique_keys, void* input, void* output, void* num_runs,
+        OffsetT num_items, cudaStream_t s) const
+    {
+        int64_t* k = static_cast<int64_t*>(keys);
+        int64_t* uk = static_cast<int64_t*>(unique_keys);
+        T* x = static_cast<T*>(input);
+        T* y = static_cast<T*>(output);
+        long long* n = static_cast<long long*>(num_runs);
+
+        switch(op) {
+        case CUPY_CUB_SUM:
+            DeviceReduce::ReduceByKey(workspace, workspace_size, k, uk, x, y, n,
+                CUPY_CUB_NAMESPACE::Sum(), num_items, s);
+            break;
+        case CUPY_CUB_MIN:
+            DeviceReduce::ReduceByKey(workspace, workspace_size, k, uk, x, y, n,
+                CUPY_CUB_NAMESPACE::Min(), num_items, s);
+            break;
+        case CUPY_CUB_MAX:
+            DeviceReduce::ReduceByKey(workspace, workspace_size, k, uk, x, y, n,
+                CUPY_CUB_NAMESPACE::Max(), num_items, s);
+            break;
+        default:
+            throw std::runtime_error("Unsupported operation");
+        }
+    }
+};
+
+//
+// **** SpMV / SpMM (sparse-matrix dense-vector / dense-matrix multiply) ****
+//
+// The SpMV is a merge-path CSR SpMV: the rows and the nonzeros are merged
+// into one path, of which each thread processes an equal share however the
+// nonzeros are distributed among the rows. A thread writes the rows it
+// completes, and the partial sum of the row it stops in (its carry) to the
+// workspace; the carries are reduced by row with ReduceByKey and added to
+// the outputs. The offsets are 64-bit so that large graphs are supported.
+//
+template <typename IndexT>
+__device__ __forceinline__ void _csrmv_merge_path_search(long long diagonal,
+    const IndexT* row_end_offsets, long long num_rows, long long nnz,
+    long long& row, long long& nz)
+{
+    // the number of rows consumed by the path at the diagonal
+    long long lo = diagonal > nnz ? diagonal - nnz : 0;
+    long long hi = diagonal < num_rows ? diagonal : num_rows;
+    while (lo < hi) {
+        long long mid = (lo + hi) >> 1;
+        if (static_cast<long long>(row_end_offsets[mid]) <= diagonal - mid - 1) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    row = lo;
+    nz = diagonal - lo;
+}
+
+template <typename T, typename IndexT>
+__global__ void _cupy_csrmv_merge_path(const T* values,
+    const IndexT* row_offsets, const IndexT* column_indices, const T* x, T* y,
+    long long num_rows, long long nnz, long long items_per_thread,
+    long long num_threads, int64_t* carry_rows, T* carry_values)
+{
+    long long tid = static_cast<long long>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (tid >= num_threads) {
+        return;
+    }
+    const long long path_length = num_rows + nnz;
+    long long diagonal = tid * items_per_thread;
+    long long diagonal_end = diagonal + items_per_thread;
+    if (diagonal > path_length) {diagonal = path_length;}
+    if (diagonal_end > path_length) {diagonal_end = path_length;}
+
+    long long row, nz, row_end, nz_end;
+    _csrmv_merge_path_search(diagonal, row_offsets + 1, num_rows, nnz, row, nz);
+    _csrmv_merge_path_search(diagonal_end, row_offsets + 1, num_rows, nnz,
+                             row_end, nz_end);
+
+    T sum = T(0);
+    for (; row < row_end; ++row) {
+        const long long nz_row_end = static_cast<long long>(row_offsets[row + 1]);
+        for (; nz < nz_row_end; ++nz) {
+            sum = static_cast<T>(sum + values[nz] * x[column_indices[nz]]);
+        }
+        y[row] = sum;
+        sum = T(0);
+    }
+    for (; nz < nz_end; ++nz) {
+        sum = static_cast<T>(sum + values[nz] * x[column_indices[nz]]);
+    }
+    carry_rows[tid] = row_end;
+    carry_values[tid] = sum;
+}
+
+template <typename T>
+__global__ void _cupy_csrmv_fix_up(const int64_t* rows, const T* aggregates,
+    const long long* num_runs, T* y, long long num_rows)
+{
+    long long i = static_cast<long long>(blockIdx.x) * blockDim.x + threadIdx.x;
+    // the row past the end collects the carry of a path ending at a row end
+    if (i < *num_runs && rows[i] < num_rows) {
+        y[rows[i]] = static_cast<T>(y[rows[i]] + aggregates[i]);
+    }
+}
+
+inline size_t _cupy_csrmv_align(size_t size) {
+    return (size + 255) / 256 * 256;
+}
+
+template <typename IndexT>
+struct _cupy_csrmv {
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* values,
+        void* row_offsets, void* column_indices, void* x, void* y,
+        int64_t num_rows, int64_t nnz, cudaStream_t s)
+    {
+        const int block_size = 256;
+        // enough threads to fill the device, each with a share long enough
+        // to amortize its searches of the path
+        const long long path_length = num_rows + nnz;
+        long long items_per_thread = (path_length + (1 << 20) - 1) >> 20;
+        if (items_per_thread < 8) {items_per_thread = 8;}
+        const long long num_threads =
+            (path_length + items_per_thread - 1) / items_per_thread;
+
+        const size_t rows_size = _cupy_csrmv_align(num_threads * sizeof(int64_t));
+        const size_t values_size = _cupy_csrmv_align(num_threads * sizeof(T));
+        // the workspace holds the carries (their rows and values), the
+        // reduced carries and their number, and then the temporary storage
+        // of ReduceByKey
+        const size_t offset = 2 * (rows_size + values_size)
+            + _cupy_csrmv_align(sizeof(long long));
+        size_t temp_size = 0;
+        _cub_reduce_by_key<long long> reduce_by_key(CUPY_CUB_SUM);
+        if (workspace == NULL) {
+            reduce_by_key.template operator()<T>(NULL, temp_size, NULL, NULL,
+                NULL, NULL, NULL, num_threads, s);
+            workspace_size = offset + temp_size;
+            return;
+        }
+        if (num_rows == 0) {
+            return;
+        }
+        char* ws = static_cast<char*>(workspace);
+        int64_t* carry_rows = reinterpret_cast<int64_t*>(ws);
+        T* carry_values = reinterpret_cast<T*>(ws + rows_size);
+        int64_t* unique_rows = reinterpret_cast<int64_t*>(ws + rows_size + values_size);
+        T* aggregates = reinterpret_cast<T*>(ws + 2 * rows_size + values_size);
+        long long* num_runs = reinterpret_cast<long long*>(ws + 2 * (rows_size + values_size));
+
+        const unsigned int num_blocks = static_cast<unsigned int>(
+            (num_threads + block_size - 1) / block_size);
+        _cupy_csrmv_merge_path<T, IndexT><<<num_blocks, block_size, 0, s>>>(
+            static_cast<const T*>(values), static_cast<const IndexT*>(row_offsets),
+            static_cast<const IndexT*>(column_indices), static_cast<const T*>(x),
+            static_cast<T*>(y), num_rows, nnz, items_per_thread, num_threads,
+            carry_rows, carry_values);
+        temp_size = workspace_size - offset;
+        reduce_by_key.template operator()<T>(ws + offset, temp_size, carry_rows,
+            unique_rows, carry_values, aggregates, num_runs, num_threads, s);
+        _cupy_csrmv_fix_up<T><<<num_blocks, block_size, 0, s>>>(
+            unique_rows, aggregates, num_runs, static_cast<T*>(y), num_rows);
+    }
+};
+
+// The SpMM is row-split: each block computes tiles of 32 columns of the
+// outputs for 8 rows, a thread per element. The dense matrices are
+// C-contiguous, so that the loads of a warp from a row of x are coalesced.
+template <typename T, typename IndexT>
+__global__ void _cupy_csrmm_row_split(const T* values,
+    const IndexT* row_offsets, const IndexT* column_indices, const T* x, T* y,
+    long long num_rows, long long num_vecs)
+{
+    long long row = static_cast<long long>(blockIdx.x) * blockDim.y + threadIdx.y;
+    if (row >= num_rows) {
+        return;
+    }
+    const long long nz_begin = static_cast<long long>(row_offsets[row]);
+    const long long nz_end = static_cast<long long>(row_offsets[row + 1]);
+    for (long long j = static_cast<long long>(blockIdx.y) * blockDim.x + threadIdx.x;
+         j < num_vecs; j += static_cast<long long>(gridDim.y) * blockDim.x) {
+        T sum = T(0);
+        for (long long nz = nz_begin; nz < nz_end; ++nz) {
+            sum = static_cast<T>(
+                sum + values[nz] * x[static_cast<long long>(column_indices[nz]) * num_vecs + j]);
+        }
+        y[row * num_vecs + j] = sum;
+    }
+}
+
+template <typename IndexT>
+struct _cupy_csrmm {
+    template <typename T>
+    void operator()(void* values, void* row_offsets, void* column_indices,
+        void* x, void* y, int64_t num_rows, int64_t num_vecs, cudaStream_t s)
+    {
+        if (num_rows == 0 || num_vecs == 0) {
+            return;
+        }
+        const dim3 block(32, 8);
+        const long long num_tiles = (num_vecs + block.x - 1) / block.x;
+        const dim3 grid(static_cast<unsigned int>((num_rows + block.y - 1) / block.y),
+                        static_cast<unsigned int>(num_tiles < 65535 ? num_tiles : 65535));
+        _cupy_csrmm_row_split<T, IndexT><<<grid, block, 0, s>>>(
+            static_cast<const T*>(values), static_cast<const IndexT*>(row_offsets),
+            static_cast<const IndexT*>(column_indices), static_cast<const T*>(x),
+            static_cast<T*>(y), num_rows, num_vecs);
+    }
+};
+
+//
+// divide functor: arange(0, n) -> arange(0, n) // segment_size
+//
+template <typename OffsetT>
+struct _segment_id
+{
+    private:
+        OffsetT segment_size;
+
+    public:
+    __host__ __device__ __forceinline__ _segment_id(OffsetT i): segment_size(i) {}
+    __host__ __device__ __forceinline__ OffsetT operator()(const OffsetT &in) const {
+        return in / segment_size;
+    }
+};
+
+template <typename OffsetT>
+using seg_id_itr = TransformInputIterator<OffsetT, _segment_id<OffsetT>, counting_itr<OffsetT>>;
+
+//
+// **** CUB DeviceSelect / DevicePartition ****
+//
+// NumPy semantics of "nonzero": NaN counts as nonzero, and for complex
+// numbers either part being nonzero suffices.
+//
+template <typename T>
+struct _is_nonzero {
+    __host__ __device__ __forceinline__ bool operator()(const T& x) const {
+        return x != T(0);
+    }
+};
+
+template <typename T>
+struct _is_nonzero<complex<T>> {
+    __host__ __device__ __forceinline__ bool operator()(const complex<T>& x) const {
+        return (x.real() != T(0)) || (x.imag() != T(0));
+    }
+};
+
+#if ((__CUDACC_VER_MAJOR__ > 9 || (__CUDACC_VER_MAJOR__ == 9 && __CUDACC_VER_MINOR__ == 2)) \
+    && (__CUDA_ARCH__ >= 530 || !defined(__CUDA_ARCH__))) || (defined(__HIPCC__) || defined(CUPY_USE_HIP))
+template <>
+struct _is_nonzero<__half> {
+    __host__ __device__ __forceinline__ bool operator()(const __half& x) const {
+        // +0 and -0 are the only zeros
+        const __half_raw r = x;
+        return (r.x & 0x7fff) != 0;
+    }
+};
+#endif
+
+template <typename T>
+struct _select_pred {
+    int op;
+    T threshold;
+
+    __host__ __device__ __forceinline__ _select_pred(int op, T threshold): op(op), threshold(threshold) {}
+    __host__ __device__ __forceinline__ bool operator()(const T& x) const {
+        switch(op) {
+        case CUPY_CUB_SELECT_NONZERO:       return _is_nonzero<T>()(x);
+        case CUPY_CUB_SELECT_NOT_NAN:       return !_multi_isnan(x);
+        case CUPY_CUB_SELECT_GREATER:       return _multi_less(threshold, x);
+        case CUPY_CUB_SELECT_GREATER_EQUAL: return _ordered(x) && !_multi_less(x, threshold);
+        case CUPY_CUB_SELECT_LESS:          return _multi_less(x, threshold);
+        case CUPY_CUB_SELECT_LESS_EQUAL:    return _ordered(x) && !_multi_less(threshold, x);
+        case CUPY_CUB_SELECT_EQUAL:         return _multi_equal(x, threshold);
+        case CUPY_CUB_SELECT_NOT_EQUAL:     return !_multi_equal(x, threshold);
+        default:                            return false;
+        }
+    }
+
+  private:
+    __host__ __device__ __forceinline__ bool _ordered(const T& x) const {
+        return !_multi_isnan(x) && !_multi_isnan(threshold);
+    }
+};
+
+// flags[i] = (i == 0) || (x[i] != x[i-1]), optionally treating NaNs as equal
+template <typename T>
+struct _unique_flag {
+    const T* x;
+    bool equal_nan;
+
+    __host__ __device__ __forceinline__ _unique_flag(const T* x, bool equal_nan): x(x), equal_nan(equal_nan) {}
+    __host__ __device__ __forceinline__ bool operator()(const long long& i) const {
+        if (i == 0) {return true;}
+        const T a = x[i - 1];
+        const T b = x[i];
+        if (equal_nan && _multi_isnan(a) && _multi_isnan(b)) {return false;}
+        return !_multi_equal(a, b);
+    }
+};
+
+template <typename OffsetT>
+struct _cub_select_flagged {
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* x, void* flags,
+        void* y, void* num_selected, OffsetT num_items, cudaStream_t s) const
+    {
+        DeviceSelect::Flagged(workspace, workspace_size, static_cast<T*>(x),
+            static_cast<bool*>(flags), static_cast<T*>(y),
+            static_cast<long long*>(num_selected), num_items, s);
+    }
+};
+
+// select the (flat) indices of nonzero items, i.e., nonzero()
+template <typename OffsetT>
+struct _cub_select_flagged_index {
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* flags,
+        void* y, void* num_selected, OffsetT num_items, cudaStream_t s) const
+    {
+        counting_itr<long long> idx_itr(0);
+        TransformInputIterator<bool, _is_nonzero<T>, T*> flag_itr(
+            static_cast<T*>(flags), _is_nonzero<T>());
+        DeviceSelect::Flagged(workspace, workspace_size, idx_itr, flag_itr,
+            static_cast<long long*>(y), static_cast<long long*>(num_selected),
+            num_items, s);
+    }
+};
+
+template <typename OffsetT>
+struct _cub_select_if {
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* x, void* y,
+        void* num_selected, OffsetT num_items, void* threshold, cudaStream_t s, int op) const
+    {
+        // the threshold lives on host and is only read for comparison ops
+        T thres = (threshold == NULL) ? T() : *static_cast<T*>(threshold);
+        DeviceSelect::If(workspace, workspace_size, static_cast<T*>(x),
+            static_cast<T*>(y), static_cast<long long*>(num_selected), num_items,
+            _select_pred<T>(op, thres), s);
+    }
+};
+
+template <typename OffsetT>
+struct _cub_unique {
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* x, void* y,
+        void* num_selected, OffsetT num_items, bool equal_nan, cudaStream_t s) const
+    {
+        counting_itr<long long> idx_itr(0);
+        TransformInputIterator<bool, _unique_flag<T>, counting_itr<long long>> flag_itr(
+            idx_itr, _unique_flag<T>(static_cast<T*>(x), equal_nan));
+        DeviceSelect::Flagged(workspace, workspace_size, static_cast<T*>(x),
+            flag_itr, static_cast<T*>(y), static_cast<long long*>(num_selected),
+            num_items, s);
+    }
+};
+
+template <typename OffsetT>
+struct _cub_partition {
+    template <typename T>
+    void operator()(void* workspace, size_t& workspace_size, void* x, void* flags,
+        void* y, void* num_selected, OffsetT num_items, cudaStream_t s) const
+    {
+        DevicePartition::Flagged(workspace, workspace_size, static_cast<T*>(x),
+            static_cast<bool*>(flags), static_cast<T*>(y),
+            static_cast<long long*>(num_selected), num_items, s);
+    }
+};
+
 //
 // **** CUB histogram range ****
 //
+// complex samples are binned by their magnitude or phase, with real bins
+template <typename T>
+struct _complex_to_real {
+    int mode;
+
+    __host__ __device__ __forceinline__ _complex_to_real(int mode): mode(mode) {}
+    __host__ __device__ __forceinline__ T operator()(const complex<T>& x) const {
+        return (mode == CUPY_CUB_HISTOGRAM_ANGLE) ? arg(x) : abs(x);
+    }
+};
+
+template <typename SampleItrT, typename LevelT, typename OffsetT>
+void _histogram_range(void* workspace, size_t& workspace_size, SampleItrT input,
+    void* output, int n_bins, LevelT* bins, OffsetT n_samples, cudaStream_t s)
+{
+    DeviceHistogram::HistogramRange(workspace, workspace_size, input,
+        #ifndef CUPY_USE_HIP
+        static_cast<long long*>(output), n_bins, bins, n_samples, s);
+        #else
+        // rocPRIM looks up atomic_add() from the namespace rocprim::detail; there's no way we can
+        // inject a "long long" version as we did for CUDA, so we must do it in "unsigned long long"
+        // and convert later...
+        static_cast<unsigned long long*>(output), n_bins, bins, n_samples, s);
+        #endif
+}
+
+template <typename OffsetT>
 struct _cub_histogram_range {
-    template <typename sampleT,
-              typename binT = typename std::conditional<std::is_integral<sampleT>::value, double, sampleT>::type>
+    template <typename sampleT>
     void operator()(void* workspace, size_t& workspace_size, void* input, void* output,
-        int n_bins, void* bins, size_t n_samples, cudaStream_t s) const
+        int n_bins, void* bins, OffsetT n_samples, int complex_mode, cudaStream_t s) const
     {
-        // Ugly hack to avoid specializing complex types, which cub::DeviceHistogram does not support.
-        // TODO(leofang): revisit this part when complex support is added to cupy.histogram()
-        typedef typename std::conditional<(std::is_same<sampleT, complex<float>>::value || std::is_same<sampleT, complex<double>>::value),
-                                          double,
-                                          sampleT>::type h_sampleT;
-        typedef typename std::conditional<(std::is_same<binT, complex<float>>::value || std::is_same<binT, complex<double>>::value),
-                                          double,
-                                          binT>::type h_binT;
-
-        // TODO(leofang): CUB has a bug that when specializing n_samples with type size_t,
-        // it would error out. Before the fix (thrust/cub#38) is merged we disable the code
-        // path splitting for now. A type/range check must be done in the caller.
-        // TODO(leofang): check if hipCUB has the same bug or not
-
-        // if (n_samples < (1ULL << 31)) {
-            int num_samples = n_samples;
-            DeviceHistogram::HistogramRange(workspace, workspace_size, static_cast<h_sampleT*>(input),
-                #ifndef CUPY_USE_HIP
-                static_cast<long long*>(output), n_bins, static_cast<h_binT*>(bins), num_samples, s);
-                #else
-                // rocPRIM looks up atomic_add() from the namespace rocprim::detail; there's no way we can
-                // inject a "long long" version as we did for CUDA, so we must do it in "unsigned long long"
-                // and convert later...
-                static_cast<unsigned long long*>(output), n_bins, static_cast<h_binT*>(bins), num_samples, s);
-                #endif
-        // } else {
-        //     DeviceHistogram::HistogramRange(workspace, workspace_size, static_cast<h_sampleT*>(input),
-        //         static_cast<long long*>(output), n_bins, static_cast<h_binT*>(bins), n_samples, s);
-        // }
+        run(workspace, workspace_size, static_cast<sampleT*>(input), output, n_bins,
+            bins, n_samples, complex_mode, s);
+    }
+
+  private:
+    template <typename sampleT>
+    void run(void* workspace, size_t& workspace_size, sampleT* input, void* output,
+        int n_bins, void* bins, OffsetT n_samples, int complex_mode, cudaStream_t s) const
+    {
+        typedef typename std::conditional<std::is_integral<sampleT>::value, double, sampleT>::type binT;
+        _histogram_range(workspace, workspace_size, input, output, n_bins,
+            static_cast<binT*>(bins), n_samples, s);
+    }
+
+    template <typename T>
+    void run(void* workspace, size_t& workspace_size, complex<T>* input, void* output,
+        int n_bins, void* bins, OffsetT n_samples, int complex_mode, cudaStream_t s) const
+    {
+        if (complex_mode != CUPY_CUB_HISTOGRAM_ABS && complex_mode != CUPY_CUB_HISTOGRAM_ANGLE) {
+            throw std::runtime_error("complex samples need a magnitude or phase mode");
+        }
+        TransformInputIterator<T, _complex_to_real<T>, complex<T>*> itr(
+            input, _complex_to_real<T>(complex_mode));
+        _histogram_range(workspace, workspace_size, itr, output, n_bins,
+            static_cast<T*>(bins), n_samples, s);
     }
 };
 
 //
 // **** CUB histogram even ****
 //
+template <typename OffsetT>
 struct _cub_histogram_even {
     template <typename sampleT>
     void operator()(void* workspace, size_t& workspace_size, void* input, void* output,
-        int& n_bins, int& lower, int& upper, size_t n_samples, cudaStream_t s) const
+        int& n_bins, int& lower, int& upper, OffsetT n_samples, cudaStream_t s) const
     {
-        #ifndef CUPY_USE_HIP
         // Ugly hack to avoid specializing numerical types
         typedef typename std::conditional<std::is_integral<sampleT>::value, sampleT, int>::type h_sampleT;
-        int num_samples = n_samples;
+        #ifndef CUPY_USE_HIP
         static_assert(sizeof(long long) == sizeof(intptr_t), "not supported");
         DeviceHistogram::HistogramEven(workspace, workspace_size, static_cast<h_sampleT*>(input),
-            static_cast<long long*>(output), n_bins, lower, upper, num_samples, s);
+            static_cast<long long*>(output), n_bins, lower, upper, n_samples, s);
         #else
-        throw std::runtime_error("HIP is not supported yet");
+        // see _histogram_range for the counter type
+        DeviceHistogram::HistogramEven(workspace, workspace_size, static_cast<h_sampleT*>(input),
+            static_cast<unsigned long long*>(output), n_bins, lower, upper, n_samples, s);
         #endif
     }
 };
 
+//
+// bfloat16 is only instantiated for the reductions and scans; ArgMin/ArgMax,
+// the other routines, and multi-statistic reductions reject it.
+//
+template <typename OffsetT> struct dispatch_bfloat16<_cub_reduce_sum<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_reduce_prod<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_reduce_min<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_reduce_max<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_segmented_reduce_sum<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_segmented_reduce_prod<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_segmented_reduce_min<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_segmented_reduce_max<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_inclusive_sum<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_inclusive_product<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_inclusive_min<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_inclusive_max<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_exclusive_sum<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_exclusive_product<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_exclusive_min<OffsetT>> : std::true_type {};
+template <typename OffsetT> struct dispatch_bfloat16<_cub_exclusive_max<OffsetT>> : std::true_type {};
+
 //
 // APIs exposed to CuPy
 //
 
 /* -------- device reduce -------- */
 
-void cub_device_reduce(void* workspace, size_t& workspace_size, void* x, void* y,
-    int num_items, cudaStream_t stream, int op, int dtype_id)
+template <typename OffsetT>
+void _cub_device_reduce(void* workspace, size_t& workspace_size, void* x, void* y,
+    OffsetT num_items, cudaStream_t stream, int op, int dtype_id)
 {
     switch(op) {
-    case CUPY_CUB_SUM:      return dtype_dispatcher(dtype_id, _cub_reduce_sum(),
+    case CUPY_CUB_SUM:      return dtype_dispatcher(dtype_id, _cub_reduce_sum<OffsetT>(),
                                 workspace, workspace_size, x, y, num_items, stream);
-    case CUPY_CUB_MIN:      return dtype_dispatcher(dtype_id, _cub_reduce_min(),
+    case CUPY_CUB_MIN:      return dtype_dispatcher(dtype_id, _cub_reduce_min<OffsetT>(),
                                 workspace, workspace_size, x, y, num_items, stream);
-    case CUPY_CUB_MAX:      return dtype_dispatcher(dtype_id, _cub_reduce_max(),
+    case CUPY_CUB_MAX:      return dtype_dispatcher(dtype_id, _cub_reduce_max<OffsetT>(),
                                 workspace, workspace_size, x, y, num_items, stream);
-    case CUPY_CUB_ARGMIN:   return dtype_dispatcher(dtype_id, _cub_reduce_argmin(),
+    case CUPY_CUB_PROD:     return dtype_dispatcher(dtype_id, _cub_reduce_prod<OffsetT>(),
                                 workspace, workspace_size, x, y, num_items, stream);
-    case CUPY_CUB_ARGMAX:   return dtype_dispatcher(dtype_id, _cub_reduce_argmax(),
-                                workspace, workspace_size, x, y, num_items, stream);
-    case CUPY_CUB_PROD:     return dtype_dispatcher(dtype_id, _cub_reduce_prod(),
-                                workspace, workspace_size, x, y, num_items, stream);
-    default:            throw std::runtime_error("Unsupported operation");
+    }
+    // The output of ArgMin/ArgMax is a KeyValuePair<int, T>, so the key
+    // cannot hold 64-bit indices.
+    if constexpr (std::is_same<OffsetT, int>::value) {
+        switch(op) {
+        case CUPY_CUB_ARGMIN:   return dtype_dispatcher(dtype_id, _cub_reduce_argmin<OffsetT>(),
+                                    workspace, workspace_size, x, y, num_items, stream);
+        case CUPY_CUB_ARGMAX:   return dtype_dispatcher(dtype_id, _cub_reduce_argmax<OffsetT>(),
+                                    workspace, workspace_size, x, y, num_items, stream);
+        }
+    }
+    throw std::runtime_error("Unsupported operation");
+}
+
+void cub_device_reduce(void* workspace, size_t& workspace_size, void* x, void* y,
+    int64_t num_items, cudaStream_t stream, int op, int dtype_id)
+{
+    // use 32-bit offsets whenever possible as they are faster
+    if (num_items <= INT_MAX) {
+        return _cub_device_reduce<int>(workspace, workspace_size, x, y,
+                                       static_cast<int>(num_items), stream, op, dtype_id);
+    } else {
+        return _cub_device_reduce<long long>(workspace, workspace_size, x, y,
+                                             static_cast<long long>(num_items), stream, op, dtype_id);
     }
 }
 
-size_t cub_device_reduce_get_workspace_size(void* x, void* y, int num_items,
+size_t cub_device_reduce_get_workspace_size(void* x, void* y, int64_t num_items,
     cudaStream_t stream, int op, int dtype_id)
 {
     size_t workspace_size = 0;
@@ -1016,42 +2008,105 @@ size_t cub_device_reduce_get_workspace_size(void* x, void* y, int num_items,
     return workspace_size;
 }
 
+/* -------- device multi-statistic reduce -------- */
+
+void cub_device_multi_reduce(void* workspace, size_t& workspace_size, void* x,
+    void* values, void* indices, int num_items, cudaStream_t stream,
+    int op_mask, int dtype_id)
+{
+    const int supported = CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_SUM)
+                        | CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_PROD)
+                        | CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_MIN)
+                        | CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_MAX)
+                        | CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_ARGMIN)
+                        | CUPY_CUB_MULTI_REDUCE_FLAG(CUPY_CUB_ARGMAX);
+    if (op_mask == 0 || (op_mask & ~supported)) {
+        throw std::runtime_error("Unsupported operation");
+    }
+    return dtype_dispatcher(dtype_id, _cub_multi_reduce(),
+                            workspace, workspace_size, x, values, indices,
+                            num_items, stream, op_mask);
+}
+
+size_t cub_device_multi_reduce_get_workspace_size(void* x, void* values,
+    void* indices, int num_items, cudaStream_t stream, int op_mask, int dtype_id)
+{
+    size_t workspace_size = 0;
+    cub_device_multi_reduce(NULL, workspace_size, x, values, indices,
+                            num_items, stream, op_mask, dtype_id);
+    return workspace_size;
+}
+
+/* -------- device NaN-ignoring reduce -------- */
+
+void cub_device_nan_reduce(void* workspace, size_t& workspace_size, void* x,
+    void* y, int num_items, cudaStream_t stream, int op, int dtype_id,
+    int64_t ddof)
+{
+    if (op != CUPY_CUB_NANSUM && op != CUPY_CUB_NANMEAN && op != CUPY_CUB_NANVAR) {
+        throw std::runtime_error("Unsupported operation");
+    }
+    return dtype_dispatcher(dtype_id, _cub_nan_reduce(),
+                            workspace, workspace_size, x, y, num_items,
+                            stream, op, ddof);
+}
+
+size_t cub_device_nan_reduce_get_workspace_size(void* x, void* y,
+    int num_items, cudaStream_t stream, int op, int dtype_id)
+{
+    size_t workspace_size = 0;
+    cub_device_nan_reduce(NULL, workspace_size, x, y, num_items, stream, op,
+                          dtype_id, 0);
+    return workspace_size;
+}
+
 /* -------- device segmented reduce -------- */
 
-void cub_device_segmented_reduce(void* workspace, size_t& workspace_size,
-    void* x, void* y, int num_segments, int segment_size,
+template <typename OffsetT>
+void _cub_device_segmented_reduce(void* workspace, size_t& workspace_size,
+    void* x, void* y, int num_segments, OffsetT segment_size,
     cudaStream_t stream, int op, int dtype_id)
 {
-    // CUB internally use int for offset...
     // This iterates over [0, segment_size, 2*segment_size, 3*segment_size, ...]
-    #ifndef CUPY_USE_HIP
-    CountingInputIterator<int> count_itr(0);
-    #else
-    rocprim::counting_iterator<int> count_itr(0);
-    #endif
-    _arange scaling(segment_size);
-    seg_offset_itr itr(count_itr, scaling);
+    counting_itr<OffsetT> count_itr(0);
+    _arange<OffsetT> scaling(segment_size);
+    seg_offset_itr<OffsetT> itr(count_itr, scaling);
 
     switch(op) {
     case CUPY_CUB_SUM:
-        return dtype_dispatcher(dtype_id, _cub_segmented_reduce_sum(),
+        return dtype_dispatcher(dtype_id, _cub_segmented_reduce_sum<OffsetT>(),
                    workspace, workspace_size, x, y, num_segments, itr, stream);
     case CUPY_CUB_MIN:
-        return dtype_dispatcher(dtype_id, _cub_segmented_reduce_min(),
+        return dtype_dispatcher(dtype_id, _cub_segmented_reduce_min<OffsetT>(),
                    workspace, workspace_size, x, y, num_segments, itr, stream);
     case CUPY_CUB_MAX:
-        return dtype_dispatcher(dtype_id, _cub_segmented_reduce_max(),
+        return dtype_dispatcher(dtype_id, _cub_segmented_reduce_max<OffsetT>(),
                    workspace, workspace_size, x, y, num_segments, itr, stream);
     case CUPY_CUB_PROD:
-        return dtype_dispatcher(dtype_id, _cub_segmented_reduce_prod(),
+        return dtype_dispatcher(dtype_id, _cub_segmented_reduce_prod<OffsetT>(),
                    workspace, workspace_size, x, y, num_segments, itr, stream);
     default:
         throw std::runtime_error("Unsupported operation");
     }
 }
 
+void cub_device_segmented_reduce(void* workspace, size_t& workspace_size,
+    void* x, void* y, int num_segments, int64_t segment_size,
+    cudaStream_t stream, int op, int dtype_id)
+{
+    // The offsets of all segments must be representable by the offset type,
+    // so switch to 64-bit offsets only if the whole array is too large.
+    if (static_cast<int64_t>(num_segments) * segment_size <= INT_MAX) {
+        return _cub_device_segmented_reduce<int>(workspace, workspace_size, x, y,
+                   num_segments, static_cast<int>(segment_size), stream, op, dtype_id);
+    } else {
+        return _cub_device_segmented_reduce<long long>(workspace, workspace_size, x, y,
+                   num_segments, static_cast<long long>(segment_size), stream, op, dtype_id);
+    }
+}
+
 size_t cub_device_segmented_reduce_get_workspace_size(void* x, void* y,
-    int num_segments, int segment_size,
+    int num_segments, int64_t segment_size,
     cudaStream_t stream, int op, int dtype_id)
 {
     size_t workspace_size = 0;
@@ -1063,49 +2118,107 @@ size_t cub_device_segmented_reduce_get_workspace_size(void* x, void* y,
 
 /*--------- device spmv (sparse-matrix dense-vector multiply) ---------*/
 
+// The indices are int32 or int64, given by index_dtype_id.
 void cub_device_spmv(void* workspace, size_t& workspace_size, void* values,
-    void* row_offsets, void* column_indices, void* x, void* y, int num_rows,
-    int num_cols, int num_nonzeros, cudaStream_t stream,
-    int dtype_id)
+    void* row_offsets, void* column_indices, void* x, void* y, int64_t num_rows,
+    int64_t num_nonzeros, cudaStream_t stream, int dtype_id, int index_dtype_id)
 {
-    #ifndef CUPY_USE_HIP
-    return dtype_dispatcher(dtype_id, _cub_device_spmv(),
-                            workspace, workspace_size, values, row_offsets,
-                            column_indices, x, y, num_rows, num_cols,
-                            num_nonzeros, stream);
-    #endif
+    switch (index_dtype_id) {
+    case CUPY_TYPE_INT32:
+        return dtype_dispatcher(dtype_id, _cupy_csrmv<int>(),
+                                workspace, workspace_size, values, row_offsets,
+                                column_indices, x, y, num_rows, num_nonzeros,
+                                stream);
+    case CUPY_TYPE_INT64:
+        return dtype_dispatcher(dtype_id, _cupy_csrmv<int64_t>(),
+                                workspace, workspace_size, values, row_offsets,
+                                column_indices, x, y, num_rows, num_nonzeros,
+                                stream);
+    default:
+        throw std::runtime_error("Unsupported index dtype ID");
+    }
 }
 
 size_t cub_device_spmv_get_workspace_size(void* values, void* row_offsets,
-    void* column_indices, void* x, void* y, int num_rows, int num_cols,
-    int num_nonzeros, cudaStream_t stream, int dtype_id)
+    void* column_indices, void* x, void* y, int64_t num_rows,
+    int64_t num_nonzeros, cudaStream_t stream, int dtype_id, int index_dtype_id)
 {
     size_t workspace_size = 0;
-    #ifndef CUPY_USE_HIP
     cub_device_spmv(NULL, workspace_size, values, row_offsets, column_indices,
-                    x, y, num_rows, num_cols, num_nonzeros, stream, dtype_id);
-    #endif
+                    x, y, num_rows, num_nonzeros, stream, dtype_id,
+                    index_dtype_id);
     return workspace_size;
 }
 
+/*--------- device spmm (sparse-matrix dense-matrix multiply) ---------*/
+
+void cub_device_spmm(void* values, void* row_offsets, void* column_indices,
+    void* x, void* y, int64_t num_rows, int64_t num_vecs, cudaStream_t stream,
+    int dtype_id, int index_dtype_id)
+{
+    switch (index_dtype_id) {
+    case CUPY_TYPE_INT32:
+        return dtype_dispatcher(dtype_id, _cupy_csrmm<int>(), values,
+                                row_offsets, column_indices, x, y, num_rows,
+                                num_vecs, stream);
+    case CUPY_TYPE_INT64:
+        return dtype_dispatcher(dtype_id, _cupy_csrmm<int64_t>(), values,
+                                row_offsets, column_indices, x, y, num_rows,
+                                num_vecs, stream);
+    default:
+        throw std::runtime_error("Unsupported index dtype ID");
+    }
+}
+
 /* -------- device scan -------- */
 
-void cub_device_scan(void* workspace, size_t& workspace_size, void* x, void* y,
-    int num_items, cudaStream_t stream, int op, int dtype_id)
+template <typename OffsetT>
+void _cub_device_scan(void* workspace, size_t& workspace_size, void* x, void* y,
+    OffsetT num_items, cudaStream_t stream, int op, int dtype_id)
 {
     switch(op) {
     case CUPY_CUB_CUMSUM:
-        return dtype_dispatcher(dtype_id, _cub_inclusive_sum(),
+        return dtype_dispatcher(dtype_id, _cub_inclusive_sum<OffsetT>(),
                                 workspace, workspace_size, x, y, num_items, stream);
     case CUPY_CUB_CUMPROD:
-        return dtype_dispatcher(dtype_id, _cub_inclusive_product(),
+        return dtype_dispatcher(dtype_id, _cub_inclusive_product<OffsetT>(),
+                                workspace, workspace_size, x, y, num_items, stream);
+    case CUPY_CUB_CUMMIN:
+        return dtype_dispatcher(dtype_id, _cub_inclusive_min<OffsetT>(),
+                                workspace, workspace_size, x, y, num_items, stream);
+    case CUPY_CUB_CUMMAX:
+        return dtype_dispatcher(dtype_id, _cub_inclusive_max<OffsetT>(),
+                                workspace, workspace_size, x, y, num_items, stream);
+    case CUPY_CUB_EXCLUSIVE_CUMSUM:
+        return dtype_dispatcher(dtype_id, _cub_exclusive_sum<OffsetT>(),
+                                workspace, workspace_size, x, y, num_items, stream);
+    case CUPY_CUB_EXCLUSIVE_CUMPROD:
+        return dtype_dispatcher(dtype_id, _cub_exclusive_product<OffsetT>(),
+                                workspace, workspace_size, x, y, num_items, stream);
+    case CUPY_CUB_EXCLUSIVE_CUMMIN:
+        return dtype_dispatcher(dtype_id, _cub_exclusive_min<OffsetT>(),
+                                workspace, workspace_size, x, y, num_items, stream);
+    case CUPY_CUB_EXCLUSIVE_CUMMAX:
+        return dtype_dispatcher(dtype_id, _cub_exclusive_max<OffsetT>(),
                                 workspace, workspace_size, x, y, num_items, stream);
     default:
         throw std::runtime_error("Unsupported operation");
     }
 }
 
-size_t cub_device_scan_get_workspace_size(void* x, void* y, int num_items,
+void cub_device_scan(void* workspace, size_t& workspace_size, void* x, void* y,
+    int64_t num_items, cudaStream_t stream, int op, int dtype_id)
+{
+    if (num_items <= INT_MAX) {
+        return _cub_device_scan<int>(workspace, workspace_size, x, y,
+                                     static_cast<int>(num_items), stream, op, dtype_id);
+    } else {
+        return _cub_device_scan<long long>(workspace, workspace_size, x, y,
+                                           static_cast<long long>(num_items), stream, op, dtype_id);
+    }
+}
+
+size_t cub_device_scan_get_workspace_size(void* x, void* y, int64_t num_items,
     cudaStream_t stream, int op, int dtype_id)
 {
     size_t workspace_size = 0;
@@ -1114,37 +2227,235 @@ size_t cub_device_scan_get_workspace_size(void* x, void* y, int num_items,
     return workspace_size;
 }
 
+/* -------- device scan by key -------- */
+
+template <typename OffsetT>
+void _cub_device_scan_by_key(void* workspace, size_t& workspace_size, void* keys,
+    void* x, void* y, OffsetT num_items, OffsetT segment_size, cudaStream_t stream,
+    int op, int key_dtype_id, int dtype_id)
+{
+    if (keys == NULL) {
+        // keys are not given; each run of segment_size items is a segment
+        counting_itr<OffsetT> count_itr(0);
+        seg_id_itr<OffsetT> itr(count_itr, _segment_id<OffsetT>(segment_size));
+        return dtype_dispatcher(dtype_id, _cub_scan_by_key<seg_id_itr<OffsetT>, OffsetT>(op),
+                                workspace, workspace_size, itr, x, y, num_items, stream);
+    }
+    switch(key_dtype_id) {
+    case CUPY_TYPE_INT32:
+        return dtype_dispatcher(dtype_id, _cub_scan_by_key<int*, OffsetT>(op),
+                                workspace, workspace_size, static_cast<int*>(keys),
+                                x, y, num_items, stream);
+    case CUPY_TYPE_INT64:
+        return dtype_dispatcher(dtype_id, _cub_scan_by_key<int64_t*, OffsetT>(op),
+                                workspace, workspace_size, static_cast<int64_t*>(keys),
+                                x, y, num_items, stream);
+    default:
+        throw std::runtime_error("Unsupported key dtype");
+    }
+}
+
+void cub_device_scan_by_key(void* workspace, size_t& workspace_size, void* keys,
+    void* x, void* y, int64_t num_items, int64_t segment_size, cudaStream_t stream,
+    int op, int key_dtype_id, int dtype_id)
+{
+    if (num_items <= INT_MAX) {
+        return _cub_device_scan_by_key<int>(workspace, workspace_size, keys, x, y,
+                   static_cast<int>(num_items), static_cast<int>(segment_size),
+                   stream, op, key_dtype_id, dtype_id);
+    } else {
+        return _cub_device_scan_by_key<long long>(workspace, workspace_size, keys, x, y,
+                   static_cast<long long>(num_items), static_cast<long long>(segment_size),
+                   stream, op, key_dtype_id, dtype_id);
+    }
+}
+
+size_t cub_device_scan_by_key_get_workspace_size(void* keys, void* x, void* y,
+    int64_t num_items, int64_t segment_size, cudaStream_t stream,
+    int op, int key_dtype_id, int dtype_id)
+{
+    size_t workspace_size = 0;
+    cub_device_scan_by_key(NULL, workspace_size, keys, x, y, num_items, segment_size,
+                           stream, op, key_dtype_id, dtype_id);
+    return workspace_size;
+}
+
+/* -------- device reduce by key -------- */
+
+void cub_device_reduce_by_key(void* workspace, size_t& workspace_size, void* keys,
+    void* unique_keys, void* x, void* y, void* num_runs, int64_t num_items,
+    cudaStream_t stream, int op, int dtype_id)
+{
+    if (num_items <= INT_MAX) {
+        return dtype_dispatcher(dtype_id, _cub_reduce_by_key<int>(op), workspace,
+                                workspace_size, keys, unique_keys, x, y, num_runs,
+                                static_cast<int>(num_items), stream);
+    } else {
+        return dtype_dispatcher(dtype_id, _cub_reduce_by_key<long long>(op), workspace,
+                                workspace_size, keys, unique_keys, x, y, num_runs,
+                                static_cast<long long>(num_items), stream);
+    }
+}
+
+size_t cub_device_reduce_by_key_get_workspace_size(void* keys, void* unique_keys,
+    void* x, void* y, void* num_runs, int64_t num_items, cudaStream_t stream,
+    int op, int dtype_id)
+{
+    size_t workspace_size = 0;
+    cub_device_reduce_by_key(NULL, workspace_size, keys, unique_keys, x, y,
+                             num_runs, num_items, stream, op, dtype_id);
+    return workspace_size;
+}
+
+/* -------- device select & partition -------- */
+
+// Pick 32-bit offsets whenever possible, as the other entry points do.
+#define CUPY_CUB_DISPATCH_OFFSET(num_items, FUNCTOR, ...) \
+    do { \
+        if ((num_items) <= INT_MAX) { \
+            return dtype_dispatcher(dtype_id, FUNCTOR<int>(), __VA_ARGS__, \
+                                    static_cast<int>(num_items), stream); \
+        } else { \
+            return dtype_dispatcher(dtype_id, FUNCTOR<long long>(), __VA_ARGS__, \
+                                    static_cast<long long>(num_items), stream); \
+        } \
+    } while (0)
+
+void cub_device_select_flagged(void* workspace, size_t& workspace_size, void* x,
+    void* flags, void* y, void* num_selected, int64_t num_items, cudaStream_t stream,
+    int flag_dtype_id, int dtype_id)
+{
+    if (x == NULL) {
+        // select indices; the flags can be of any dtype ("nonzero" semantics)
+        dtype_id = flag_dtype_id;
+        CUPY_CUB_DISPATCH_OFFSET(num_items, _cub_select_flagged_index,
+                                 workspace, workspace_size, flags, y, num_selected);
+    }
+    if (flag_dtype_id != CUPY_TYPE_BOOL) {
+        throw std::runtime_error("flags must be of bool dtype");
+    }
+    CUPY_CUB_DISPATCH_OFFSET(num_items, _cub_select_flagged,
+                             workspace, workspace_size, x, flags, y, num_selected);
+}
+
+size_t cub_device_select_flagged_get_workspace_size(void* x, void* flags, void* y,
+    void* num_selected, int64_t num_items, cudaStream_t stream, int flag_dtype_id,
+    int dtype_id)
+{
+    size_t workspace_size = 0;
+    cub_device_select_flagged(NULL, workspace_size, x, flags, y, num_selected,
+                              num_items, stream, flag_dtype_id, dtype_id);
+    return workspace_size;
+}
+
+void cub_device_select_if(void* workspace, size_t& workspace_size, void* x, void* y,
+    void* num_selected, int64_t num_items, void* threshold, cudaStream_t stream,
+    int op, int dtype_id)
+{
+    if (op < CUPY_CUB_SELECT_NONZERO || op > CUPY_CUB_SELECT_NOT_EQUAL) {
+        throw std::runtime_error("Unsupported operation");
+    }
+    if (num_items <= INT_MAX) {
+        return dtype_dispatcher(dtype_id, _cub_select_if<int>(), workspace, workspace_size,
+                                x, y, num_selected, static_cast<int>(num_items),
+                                threshold, stream, op);
+    } else {
+        return dtype_dispatcher(dtype_id, _cub_select_if<long long>(), workspace, workspace_size,
+                                x, y, num_selected, static_cast<long long>(num_items),
+                                threshold, stream, op);
+    }
+}
+
+size_t cub_device_select_if_get_workspace_size(void* x, void* y, void* num_selected,
+    int64_t num_items, void* threshold, cudaStream_t stream, int op, int dtype_id)
+{
+    size_t workspace_size = 0;
+    cub_device_select_if(NULL, workspace_size, x, y, num_selected, num_items,
+                         threshold, stream, op, dtype_id);
+    return workspace_size;
+}
+
+void cub_device_unique(void* workspace, size_t& workspace_size, void* x, void* y,
+    void* num_selected, int64_t num_items, bool equal_nan, cudaStream_t stream,
+    int dtype_id)
+{
+    if (num_items <= INT_MAX) {
+        return dtype_dispatcher(dtype_id, _cub_unique<int>(), workspace, workspace_size,
+                                x, y, num_selected, static_cast<int>(num_items),
+                                equal_nan, stream);
+    } else {
+        return dtype_dispatcher(dtype_id, _cub_unique<long long>(), workspace, workspace_size,
+                                x, y, num_selected, static_cast<long long>(num_items),
+                                equal_nan, stream);
+    }
+}
+
+size_t cub_device_unique_get_workspace_size(void* x, void* y, void* num_selected,
+    int64_t num_items, bool equal_nan, cudaStream_t stream, int dtype_id)
+{
+    size_t workspace_size = 0;
+    cub_device_unique(NULL, workspace_size, x, y, num_selected, num_items,
+                      equal_nan, stream, dtype_id);
+    return workspace_size;
+}
+
+void cub_device_partition(void* workspace, size_t& workspace_size, void* x,
+    void* flags, void* y, void* num_selected, int64_t num_items, cudaStream_t stream,
+    int dtype_id)
+{
+    CUPY_CUB_DISPATCH_OFFSET(num_items, _cub_partition,
+                             workspace, workspace_size, x, flags, y, num_selected);
+}
+
+size_t cub_device_partition_get_workspace_size(void* x, void* flags, void* y,
+    void* num_selected, int64_t num_items, cudaStream_t stream, int dtype_id)
+{
+    size_t workspace_size = 0;
+    cub_device_partition(NULL, workspace_size, x, flags, y, num_selected,
+                         num_items, stream, dtype_id);
+    return workspace_size;
+}
+
+#undef CUPY_CUB_DISPATCH_OFFSET
+
 /* -------- device histogram -------- */
 
 void cub_device_histogram_range(void* workspace, size_t& workspace_size, void* x, void* y,
-    int n_bins, void* bins, size_t n_samples, cudaStream_t stream, int dtype_id)
+    int n_bins, void* bins, size_t n_samples, cudaStream_t stream, int dtype_id,
+    int complex_mode)
 {
-    // TODO(leofang): support complex
-    if (dtype_id == CUPY_TYPE_COMPLEX64 || dtype_id == CUPY_TYPE_COMPLEX128) {
-	    throw std::runtime_error("complex dtype is not yet supported");
+    if (n_samples <= INT_MAX) {
+        return dtype_dispatcher(dtype_id, _cub_histogram_range<int>(),
+                                workspace, workspace_size, x, y, n_bins, bins,
+                                static_cast<int>(n_samples), complex_mode, stream);
+    } else {
+        return dtype_dispatcher(dtype_id, _cub_histogram_range<long long>(),
+                                workspace, workspace_size, x, y, n_bins, bins,
+                                static_cast<long long>(n_samples), complex_mode, stream);
     }
-
-    // TODO(leofang): n_samples is of type size_t, but if it's < 2^31 we cast it to int later
-    return dtype_dispatcher(dtype_id, _cub_histogram_range(),
-                            workspace, workspace_size, x, y, n_bins, bins, n_samples, stream);
 }
 
 size_t cub_device_histogram_range_get_workspace_size(void* x, void* y, int n_bins,
-    void* bins, size_t n_samples, cudaStream_t stream, int dtype_id)
+    void* bins, size_t n_samples, cudaStream_t stream, int dtype_id, int complex_mode)
 {
     size_t workspace_size = 0;
     cub_device_histogram_range(NULL, workspace_size, x, y, n_bins, bins, n_samples,
-                               stream, dtype_id);
+                               stream, dtype_id, complex_mode);
     return workspace_size;
 }
 
 void cub_device_histogram_even(void* workspace, size_t& workspace_size, void* x, void* y,
     int n_bins, int lower, int upper, size_t n_samples, cudaStream_t stream, int dtype_id)
 {
-    #ifndef CUPY_USE_HIP
-    return dtype_dispatcher(dtype_id, _cub_histogram_even(),
-                            workspace, workspace_size, x, y, n_bins, lower, upper, n_samples, stream);
-    #endif
+    if (n_samples <= INT_MAX) {
+        return dtype_dispatcher(dtype_id, _cub_histogram_even<int>(),
+                                workspace, workspace_size, x, y, n_bins, lower, upper,
+                                static_cast<int>(n_samples), stream);
+    } else {
+        return dtype_dispatcher(dtype_id, _cub_histogram_even<long long>(),
+                                workspace, workspace_size, x, y, n_bins, lower, upper,
+                                static_cast<long long>(n_samples), stream);
+    }
 }
 
 size_t cub_device_histogram_even_get_workspace_size(void* x, void* y, int n_bins,
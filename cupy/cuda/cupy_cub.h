@@ -9,6 +9,35 @@
 #define CUPY_CUB_CUMSUM  5
 #define CUPY_CUB_CUMPROD 6
 #define CUPY_CUB_PROD    7
+#define CUPY_CUB_EXCLUSIVE_CUMSUM  8
+#define CUPY_CUB_EXCLUSIVE_CUMPROD 9
+#define CUPY_CUB_CUMMIN            10
+#define CUPY_CUB_CUMMAX            11
+#define CUPY_CUB_EXCLUSIVE_CUMMIN  12
+#define CUPY_CUB_EXCLUSIVE_CUMMAX  13
+
+// predicates for cub_device_select_if
+#define CUPY_CUB_SELECT_NONZERO       0
+#define CUPY_CUB_SELECT_NOT_NAN       1
+#define CUPY_CUB_SELECT_GREATER       2
+#define CUPY_CUB_SELECT_GREATER_EQUAL 3
+#define CUPY_CUB_SELECT_LESS          4
+#define CUPY_CUB_SELECT_LESS_EQUAL    5
+#define CUPY_CUB_SELECT_EQUAL         6
+#define CUPY_CUB_SELECT_NOT_EQUAL     7
+
+// how cub_device_histogram_range bins complex samples
+#define CUPY_CUB_HISTOGRAM_REAL  0  // complex samples are rejected
+#define CUPY_CUB_HISTOGRAM_ABS   1
+#define CUPY_CUB_HISTOGRAM_ANGLE 2
+
+// NaN-ignoring reductions of cub_device_nan_reduce
+#define CUPY_CUB_NANSUM  0
+#define CUPY_CUB_NANMEAN 1
+#define CUPY_CUB_NANVAR  2
+
+// bit flags for cub_device_multi_reduce, one per reduction op code above
+#define CUPY_CUB_MULTI_REDUCE_FLAG(op) (1 << (op))
 
 // this is defined during the build process
 #ifndef CUPY_CUB_VERSION_CODE
@@ -17,6 +46,8 @@
 
 #ifndef CUPY_NO_CUDA
 
+#include <cstdint>
+
 // for cudaStream_t
 #ifndef CUPY_USE_HIP
 #include <cuda_runtime.h>
@@ -25,17 +56,34 @@
 #define cudaStream_t hipStream_t
 #endif
 
-void cub_device_reduce(void*, size_t&, void*, void*, int, cudaStream_t, int, int);
-void cub_device_segmented_reduce(void*, size_t&, void*, void*, int, int, cudaStream_t, int, int);
-void cub_device_spmv(void*, size_t&, void*, void*, void*, void*, void*, int, int, int, cudaStream_t, int);
-void cub_device_scan(void*, size_t&, void*, void*, int, cudaStream_t, int, int);
-void cub_device_histogram_range(void*, size_t&, void*, void*, int, void*, size_t, cudaStream_t, int);
+void cub_device_reduce(void*, size_t&, void*, void*, int64_t, cudaStream_t, int, int);
+void cub_device_multi_reduce(void*, size_t&, void*, void*, void*, int, cudaStream_t, int, int);
+void cub_device_nan_reduce(void*, size_t&, void*, void*, int, cudaStream_t, int, int, int64_t);
+void cub_device_segmented_reduce(void*, size_t&, void*, void*, int, int64_t, cudaStream_t, int, int);
+void cub_device_spmv(void*, size_t&, void*, void*, void*, void*, void*, int64_t, int64_t, cudaStream_t, int, int);
+void cub_device_spmm(void*, void*, void*, void*, void*, int64_t, int64_t, cudaStream_t, int, int);
+void cub_device_scan(void*, size_t&, void*, void*, int64_t, cudaStream_t, int, int);
+void cub_device_scan_by_key(void*, size_t&, void*, void*, void*, int64_t, int64_t, cudaStream_t, int, int, int);
+void cub_device_reduce_by_key(void*, size_t&, void*, void*, void*, void*, void*, int64_t, cudaStream_t, int, int);
+void cub_device_select_flagged(void*, size_t&, void*, void*, void*, void*, int64_t, cudaStream_t, int, int);
+void cub_device_select_if(void*, size_t&, void*, void*, void*, int64_t, void*, cudaStream_t, int, int);
+void cub_device_unique(void*, size_t&, void*, void*, void*, int64_t, bool, cudaStream_t, int);
+void cub_device_partition(void*, size_t&, void*, void*, void*, void*, int64_t, cudaStream_t, int);
+void cub_device_histogram_range(void*, size_t&, void*, void*, int, void*, size_t, cudaStream_t, int, int);
 void cub_device_histogram_even(void*, size_t&, void*, void*, int, int, int, size_t, cudaStream_t, int);
-size_t cub_device_reduce_get_workspace_size(void*, void*, int, cudaStream_t, int, int);
-size_t cub_device_segmented_reduce_get_workspace_size(void*, void*, int, int, cudaStream_t, int, int);
-size_t cub_device_spmv_get_workspace_size(void*, void*, void*, void*, void*, int, int, int, cudaStream_t, int);
-size_t cub_device_scan_get_workspace_size(void*, void*, int, cudaStream_t, int, int);
-size_t cub_device_histogram_range_get_workspace_size(void*, void*, int, void*, size_t, cudaStream_t, int);
+size_t cub_device_reduce_get_workspace_size(void*, void*, int64_t, cudaStream_t, int, int);
+size_t cub_device_multi_reduce_get_workspace_size(void*, void*, void*, int, cudaStream_t, int, int);
+size_t cub_device_nan_reduce_get_workspace_size(void*, void*, int, cudaStream_t, int, int);
+size_t cub_device_segmented_reduce_get_workspace_size(void*, void*, int, int64_t, cudaStream_t, int, int);
+size_t cub_device_spmv_get_workspace_size(void*, void*, void*, void*, void*, int64_t, int64_t, cudaStream_t, int, int);
+size_t cub_device_scan_get_workspace_size(void*, void*, int64_t, cudaStream_t, int, int);
+size_t cub_device_scan_by_key_get_workspace_size(void*, void*, void*, int64_t, int64_t, cudaStream_t, int, int, int);
+size_t cub_device_reduce_by_key_get_workspace_size(void*, void*, void*, void*, void*, int64_t, cudaStream_t, int, int);
+size_t cub_device_select_flagged_get_workspace_size(void*, void*, void*, void*, int64_t, cudaStream_t, int, int);
+size_t cub_device_select_if_get_workspace_size(void*, void*, void*, int64_t, void*, cudaStream_t, int, int);
+size_t cub_device_unique_get_workspace_size(void*, void*, void*, int64_t, bool, cudaStream_t, int);
+size_t cub_device_partition_get_workspace_size(void*, void*, void*, void*, int64_t, cudaStream_t, int);
+size_t cub_device_histogram_range_get_workspace_size(void*, void*, int, void*, size_t, cudaStream_t, int, int);
 size_t cub_device_histogram_even_get_workspace_size(void*, void*, int, int, int, size_t, cudaStream_t, int);
 
 // This is for CUB's HistogramRange; hipCUB does not need this (see comment in cupy_cub.cu)
@@ -57,15 +105,42 @@ typedef struct CUstream_st *cudaStream_t;
 void cub_device_reduce(...) {
 }
 
+void cub_device_multi_reduce(...) {
+}
+
+void cub_device_nan_reduce(...) {
+}
+
 void cub_device_segmented_reduce(...) {
 }
 
 void cub_device_spmv(...) {
 }
 
+void cub_device_spmm(...) {
+}
+
 void cub_device_scan(...) {
 }
 
+void cub_device_scan_by_key(...) {
+}
+
+void cub_device_reduce_by_key(...) {
+}
+
+void cub_device_select_flagged(...) {
+}
+
+void cub_device_select_if(...) {
+}
+
+void cub_device_unique(...) {
+}
+
+void cub_device_partition(...) {
+}
+
 void cub_device_histogram_range(...) {
 }
 
@@ -76,6 +151,14 @@ size_t cub_device_reduce_get_workspace_size(...) {
     return 0;
 }
 
+size_t cub_device_multi_reduce_get_workspace_size(...) {
+    return 0;
+}
+
+size_t cub_device_nan_reduce_get_workspace_size(...) {
+    return 0;
+}
+
 size_t cub_device_segmented_reduce_get_workspace_size(...) {
     return 0;
 }
@@ -88,6 +171,30 @@ size_t cub_device_scan_get_workspace_size(...) {
     return 0;
 }
 
+size_t cub_device_scan_by_key_get_workspace_size(...) {
+    return 0;
+}
+
+size_t cub_device_reduce_by_key_get_workspace_size(...) {
+    return 0;
+}
+
+size_t cub_device_select_flagged_get_workspace_size(...) {
+    return 0;
+}
+
+size_t cub_device_select_if_get_workspace_size(...) {
+    return 0;
+}
+
+size_t cub_device_unique_get_workspace_size(...) {
+    return 0;
+}
+
+size_t cub_device_partition_get_workspace_size(...) {
+    return 0;
+}
+
 size_t cub_device_histogram_range_get_workspace_size(...) {
     return 0;
 }
@@ -11,6 +11,15 @@
 #include <cufft.h>
 #include <cufftXt.h>
 
+#if CUFFT_VERSION < 11300
+// LTO callbacks are supported since cuFFT 11.3
+extern "C" {
+cufftResult_t cufftXtSetJITCallback(...) {
+    return CUFFT_NOT_SUPPORTED;
+}
+} // extern "C"
+#endif
+
 #elif defined(CUPY_USE_HIP)
 #include <hip/hip_version.h> //for HIP_VERSION
 #if HIP_VERSION >= 50530600 
@@ -152,6 +161,10 @@ cufftResult_t cufftXtExecDescriptorZ2Z(...) {
     return HIPFFT_NOT_IMPLEMENTED;
 }
 
+cufftResult_t cufftXtSetJITCallback(...) {
+    return HIPFFT_NOT_IMPLEMENTED;
+}
+
 } // extern "C"
 
 #else  // defined(CUPY_NO_CUDA)
@@ -280,6 +293,10 @@ cufftResult_t cufftXtExecDescriptorZ2Z(...) {
     return CUFFT_SUCCESS;
 }
 
+cufftResult_t cufftXtSetJITCallback(...) {
+    return CUFFT_SUCCESS;
+}
+
 }  // extern "C"
 
 #endif  // #if !defined(CUPY_NO_CUDA) && !defined(CUPY_USE_HIP)
@@ -322,6 +339,8 @@ typedef enum cufftXtCopyType_t {
     CUFFT_COPY_UNDEFINED = 0x03
 } cufftXtCopyType;
 
+typedef enum {} cufftXtCallbackType;
+
 } // extern "C"
 
 #endif // #if defined(CUPY_NO_CUDA) || defined(CUPY_USE_HIP)
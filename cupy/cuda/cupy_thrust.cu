@@ -1,14 +1,37 @@
 #include "cupy_thrust.h"
 #include <cupy/type_dispatcher.cuh>
+#include <thrust/copy.h>
 #include <thrust/device_ptr.h>
 #include <thrust/device_vector.h>
 #include <thrust/iterator/zip_iterator.h>
 #include <thrust/iterator/constant_iterator.h>
+#include <thrust/binary_search.h>
 #include <thrust/sequence.h>
 #include <thrust/sort.h>
 #include <thrust/tuple.h>
 #include <thrust/execution_policy.h>
 #include <type_traits>
+#include <map>
+#include <utility>
+#include <climits>  // For INT_MAX
+#include <stdexcept>
+#if CUPY_USE_HIP
+#include <hipcub/block/block_scan.hpp>
+#include <hipcub/device/device_radix_sort.hpp>
+#include <hipcub/device/device_segmented_radix_sort.hpp>
+#include <hipcub/device/device_segmented_sort.hpp>
+#include <hipcub/iterator/transform_input_iterator.hpp>
+#include <rocprim/iterator/counting_iterator.hpp>
+#define CUPY_CUB_NAMESPACE hipcub
+#else
+#include <cub/block/block_scan.cuh>
+#include <cub/device/device_radix_sort.cuh>
+#include <cub/device/device_segmented_radix_sort.cuh>
+#include <cub/device/device_segmented_sort.cuh>
+#include <cub/iterator/counting_input_iterator.cuh>
+#include <cub/iterator/transform_input_iterator.cuh>
+#define CUPY_CUB_NAMESPACE cub
+#endif
 #if (__CUDACC_VER_MAJOR__ >11 || (__CUDACC_VER_MAJOR__ == 11 && __CUDACC_VER_MINOR__ >= 2) || HIP_VERSION >= 402)
 // This is used to avoid a problem with constexpr in functions declarations introduced in
 // cuda 11.2, MSVC 15 does not fully support it so we need a dummy constexpr declaration
@@ -39,23 +62,116 @@ namespace cuda {
 
 extern "C" char *cupy_malloc(void *, size_t);
 extern "C" void cupy_free(void *, char *);
+extern "C" char *cupy_workspace_realloc(int, intptr_t, size_t);
+extern "C" intptr_t cupy_workspace_key(void *);
+
+
+/*
+ * Per-stream workspace arena
+ *
+ * Temporary allocations are bump-allocated from a cached buffer owned by the Python side (one per device and stream),
+ * so that no Python round-trip is needed. The arena is reset when all of its allocations are returned; requests that
+ * do not fit are served by the memory pool, and the arena grows geometrically to the peak demand once it is idle.
+ * The buffer is only reused in stream order, so no synchronization is needed. Callers hold the GIL, which serializes
+ * the access to the arenas.
+ *
+ * The arenas are keyed by the stream identifier of the memory pool, which tells apart the per-thread default streams
+ * of the threads. The GIL may be released while calling back into Python, so the arena is looked up again after each
+ * callback. While an arena is being replaced it has no buffer, so that the allocations of the other threads in the
+ * meantime are served by the memory pool, and it counts as live, so that it is not released.
+ */
+
+// Demands beyond this are always served by the memory pool
+#define CUPY_THRUST_WORKSPACE_LIMIT (size_t(64) << 20)
+#define CUPY_THRUST_WORKSPACE_ALIGN 256
+
+struct cupy_workspace {
+    char *ptr = NULL;
+    size_t capacity = 0;
+    size_t offset = 0;
+    size_t n_live = 0;
+    size_t peak = 0;
+};
 
+static std::map<std::pair<int, intptr_t>, cupy_workspace> cupy_workspaces;
 
 class cupy_allocator {
 private:
     void* memory;
+    std::pair<int, intptr_t> key;
 
 public:
     typedef char value_type;
 
-    cupy_allocator(void* memory) : memory(memory) {}
+    cupy_allocator(void* memory) : memory(memory) {
+        int device;
+        #if CUPY_USE_HIP
+        hipGetDevice(&device);
+        #else
+        cudaGetDevice(&device);
+        #endif
+        key = std::make_pair(device, cupy_workspace_key(memory));
+    }
 
     char *allocate(size_t num_bytes) {
-        return cupy_malloc(memory, num_bytes);
+        cupy_workspace& ws = cupy_workspaces[key];
+        const size_t n = (num_bytes + CUPY_THRUST_WORKSPACE_ALIGN - 1) / CUPY_THRUST_WORKSPACE_ALIGN
+                         * CUPY_THRUST_WORKSPACE_ALIGN;
+        const bool fits = ws.ptr != NULL && ws.offset + n <= ws.capacity;
+        char *ptr = fits ? ws.ptr + ws.offset : NULL;
+
+        ws.offset += n;
+        ws.n_live++;
+        if (ws.peak < ws.offset) {
+            ws.peak = ws.offset;
+        }
+        if (!fits) {
+            ptr = cupy_malloc(memory, num_bytes);
+        }
+        return ptr;
     }
 
     void deallocate(char *ptr, size_t n) {
-        cupy_free(memory, ptr);
+        cupy_workspace& ws = cupy_workspaces[key];
+        // served by the memory pool rather than by the arena
+        const bool pooled = ptr < ws.ptr || ptr >= ws.ptr + ws.capacity;
+
+        if (--ws.n_live > 0) {
+            if (pooled) {
+                cupy_free(memory, ptr);
+            }
+            return;
+        }
+        // idle: reset, and grow if the last use did not fit
+        size_t capacity = 0;
+        ws.offset = 0;
+        if (ws.peak > ws.capacity && ws.peak <= CUPY_THRUST_WORKSPACE_LIMIT) {
+            capacity = ws.capacity * 2;
+            if (capacity < ws.peak) {
+                capacity = ws.peak;
+            }
+            if (capacity > CUPY_THRUST_WORKSPACE_LIMIT) {
+                capacity = CUPY_THRUST_WORKSPACE_LIMIT;
+            }
+            // without a buffer and live until the new buffer is in place, as the old one is released first
+            ws.ptr = NULL;
+            ws.capacity = 0;
+            ws.n_live = 1;
+        }
+        ws.peak = 0;
+        if (pooled) {
+            cupy_free(memory, ptr);
+        }
+        if (capacity > 0) {
+            char *buffer = cupy_workspace_realloc(key.first, key.second, capacity);
+            cupy_workspace& grown = cupy_workspaces[key];
+            grown.ptr = buffer;
+            grown.capacity = (buffer == NULL) ? 0 : capacity;
+            // other threads may have allocations from the pool in the meantime
+            if (--grown.n_live == 0) {
+                grown.offset = 0;
+            }
+        }
     }
 };
 
@@ -101,6 +217,16 @@ __host__ __device__ __forceinline__ bool isnan(const __half& x) {
 }
 #endif // ENABLE_HALF
 
+#ifdef CUPY_ENABLE_BFLOAT16
+__host__ __device__ __forceinline__ bool isnan(const __nv_bfloat16& x) {
+    #ifdef __CUDA_ARCH__
+    return __hisnan(x);
+    #else
+    return false;  // This will never be called on the host
+    #endif
+}
+#endif // CUPY_ENABLE_BFLOAT16
+
 template <typename T>
 __host__ __device__ __forceinline__ CONSTEXPR_FUNC
 static bool real_less(const T& lhs, const T& rhs) {
@@ -305,11 +431,339 @@ struct select_less<thrust::tuple<size_t, __half>> {
 };
 #endif  // ENABLE_HALF
 
+#ifdef CUPY_ENABLE_BFLOAT16
+template <>
+struct select_less<__nv_bfloat16> {
+    struct type {
+        __host__ __device__ __forceinline__ CONSTEXPR_COMPARATOR
+        bool operator() (const __nv_bfloat16& lhs, const __nv_bfloat16& rhs) const {
+            return real_less(lhs, rhs);
+        }
+    };
+};
+
+template <>
+struct select_less<thrust::tuple<size_t, __nv_bfloat16>> {
+    struct type {
+        __host__ __device__ __forceinline__ CONSTEXPR_COMPARATOR
+        bool operator() (
+            const thrust::tuple<size_t, __nv_bfloat16>& lhs, const thrust::tuple<size_t, __nv_bfloat16>& rhs) const {
+            return tuple_less(lhs, rhs);
+        }
+    };
+};
+#endif  // CUPY_ENABLE_BFLOAT16
+
 /*
  * -------------------------------------------------- end of boilerplate --------------------------------------------------
  */
 
 
+/*
+ * Segmented radix sort
+ *
+ * The rows are sorted with CUB's DeviceSegmentedRadixSort (DeviceRadixSort for a single row) instead of a comparison
+ * sort over (row key, value) tuples. Integers are used as radix keys as-is. Floating points, including half and
+ * bfloat16, are mapped to unsigned integers of the same width whose order matches the NumPy order: all NaNs compare
+ * equal and go last, and -0.0 is folded into +0.0 so the two stay in their input order. A complex number is mapped to
+ * two such words, (real, imag), compared lexicographically; an item with a NaN part goes to one of three classes above
+ * all the non-NaN keys in its first word, ordered as in the NumPy rules above, and its second word holds the non-NaN
+ * part if any. For complex<float> the two words make one 64-bit key. For complex<double> the rows are sorted stably by
+ * the second word and then by the first one (LSD order). The original values are carried along as the payload.
+ */
+
+template <typename T, typename Enable = void>
+struct radix_key {
+    static constexpr bool value = false;
+};
+
+template <typename T>
+struct radix_key<T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>> {
+    static constexpr bool value = true;
+    using type = T;
+};
+
+template <>
+struct radix_key<float> {
+    static constexpr bool value = true;
+    using type = unsigned int;
+
+    __device__ __forceinline__ type operator()(const float& x) const {
+        if (isnan(x)) {
+            return 0xffffffffu;
+        }
+        const type b = __float_as_uint(x == 0.0f ? 0.0f : x);
+        return (b & 0x80000000u) ? ~b : (b | 0x80000000u);
+    }
+};
+
+template <>
+struct radix_key<double> {
+    static constexpr bool value = true;
+    using type = unsigned long long;
+
+    __device__ __forceinline__ type operator()(const double& x) const {
+        if (isnan(x)) {
+            return 0xffffffffffffffffull;
+        }
+        const type b = static_cast<type>(__double_as_longlong(x == 0.0 ? 0.0 : x));
+        return (b & 0x8000000000000000ull) ? ~b : (b | 0x8000000000000000ull);
+    }
+};
+
+#ifdef CUPY_ENABLE_BFLOAT16
+template <>
+struct radix_key<__nv_bfloat16> {
+    static constexpr bool value = true;
+    using type = unsigned short;
+
+    __device__ __forceinline__ type operator()(const __nv_bfloat16& x) const {
+        type b = __bfloat16_as_ushort(x);
+        if ((b & 0x7fffu) > 0x7f80u) {
+            return 0xffffu;
+        }
+        if ((b & 0x7fffu) == 0) {
+            b = 0;
+        }
+        return static_cast<type>((b & 0x8000u) ? ~b : (b | 0x8000u));
+    }
+};
+#endif  // CUPY_ENABLE_BFLOAT16
+
+#ifdef ENABLE_HALF
+template <>
+struct radix_key<__half> {
+    static constexpr bool value = true;
+    using type = unsigned short;
+
+    __device__ __forceinline__ type operator()(const __half& x) const {
+        type b = __half_as_ushort(x);
+        if ((b & 0x7fffu) > 0x7c00u) {
+            return 0xffffu;
+        }
+        if ((b & 0x7fffu) == 0) {
+            b = 0;
+        }
+        return static_cast<type>((b & 0x8000u) ? ~b : (b | 0x8000u));
+    }
+};
+#endif  // ENABLE_HALF
+
+// The (first, second) words of a complex number; the largest three values of the first word are the NaN classes.
+template <typename F>
+struct radix_complex_words {
+    using word = typename radix_key<F>::type;
+
+    __device__ __forceinline__ void operator()(const complex<F>& x, word& first, word& second) const {
+        const bool re_nan = isnan(x.real());
+        const bool im_nan = isnan(x.imag());
+        const radix_key<F> key;
+
+        if (!re_nan && !im_nan) {
+            first = key(x.real());
+            second = key(x.imag());
+        } else if (!re_nan) {  // R + nanj
+            first = static_cast<word>(~word(2));
+            second = key(x.real());
+        } else if (!im_nan) {  // nan + Rj
+            first = static_cast<word>(~word(1));
+            second = key(x.imag());
+        } else {  // nan + nanj
+            first = static_cast<word>(~word(0));
+            second = 0;
+        }
+    }
+};
+
+template <>
+struct radix_key<complex<float>> {
+    static constexpr bool value = true;
+    using type = unsigned long long;
+
+    __device__ __forceinline__ type operator()(const complex<float>& x) const {
+        unsigned int first, second;
+        radix_complex_words<float>()(x, first, second);
+        return (static_cast<type>(first) << 32) | second;
+    }
+};
+
+// Keys that are sorted as two words, the second one first.
+template <typename T>
+struct radix_key_pair {
+    static constexpr bool value = false;
+};
+
+template <>
+struct radix_key_pair<complex<double>> {
+    static constexpr bool value = true;
+    using type = unsigned long long;
+
+    struct first {
+        __device__ __forceinline__ type operator()(const complex<double>& x) const {
+            type w0, w1;
+            radix_complex_words<double>()(x, w0, w1);
+            return w0;
+        }
+    };
+
+    struct second {
+        __device__ __forceinline__ type operator()(const complex<double>& x) const {
+            type w0, w1;
+            radix_complex_words<double>()(x, w0, w1);
+            return w1;
+        }
+    };
+};
+
+template <typename T>
+struct radix_sortable {
+    static constexpr bool value = radix_key<T>::value || radix_key_pair<T>::value;
+};
+
+// The key of the item at position i of a row, whose in-row index is idx[i].
+template <typename T, typename F>
+struct radix_row_gather {
+    const size_t *idx;
+    const T *data;
+    size_t n_cols;
+
+    radix_row_gather(const size_t *idx, const T *data, size_t n_cols) : idx(idx), data(data), n_cols(n_cols) {}
+    __device__ __forceinline__ typename radix_key_pair<T>::type operator()(const size_t& i) const {
+        return F()(data[i - i % n_cols + idx[i]]);
+    }
+};
+
+struct radix_row_offset {
+    int n_cols;
+
+    __host__ __device__ radix_row_offset(int n_cols) : n_cols(n_cols) {}
+    __host__ __device__ __forceinline__ int operator()(const int& i) const {
+        return i * n_cols;
+    }
+};
+
+#if CUPY_USE_HIP
+typedef hipcub::TransformInputIterator<int, radix_row_offset, rocprim::counting_iterator<int>> radix_offset_itr;
+#else
+typedef cub::TransformInputIterator<int, radix_row_offset, cub::CountingInputIterator<int>> radix_offset_itr;
+#endif
+
+template <typename K, typename V>
+void segmented_radix_sort(CUPY_CUB_NAMESPACE::DoubleBuffer<K>& keys, CUPY_CUB_NAMESPACE::DoubleBuffer<V>* values,
+                          int size, int n_cols, cudaStream_t stream, cupy_allocator& alloc) {
+    #if CUPY_USE_HIP
+    rocprim::counting_iterator<int> count_itr(0);
+    #else
+    cub::CountingInputIterator<int> count_itr(0);
+    #endif
+    radix_offset_itr begin_offsets(count_itr, radix_row_offset(n_cols));
+    int n_rows = size / n_cols;
+    size_t ws_size = 0;
+    char *ws = NULL;
+
+    // the first pass only queries the workspace size
+    for (int pass = 0; pass < 2; ++pass) {
+        if (n_rows == 1) {
+            // one segment would be sorted by a single block
+            if (values == NULL) {
+                CUPY_CUB_NAMESPACE::DeviceRadixSort::SortKeys(
+                    ws, ws_size, keys, size, 0, sizeof(K) * 8, stream);
+            } else {
+                CUPY_CUB_NAMESPACE::DeviceRadixSort::SortPairs(
+                    ws, ws_size, keys, *values, size, 0, sizeof(K) * 8, stream);
+            }
+        } else if (values == NULL) {
+            CUPY_CUB_NAMESPACE::DeviceSegmentedRadixSort::SortKeys(
+                ws, ws_size, keys, size, n_rows, begin_offsets, begin_offsets + 1,
+                0, sizeof(K) * 8, stream);
+        } else {
+            CUPY_CUB_NAMESPACE::DeviceSegmentedRadixSort::SortPairs(
+                ws, ws_size, keys, *values, size, n_rows, begin_offsets, begin_offsets + 1,
+                0, sizeof(K) * 8, stream);
+        }
+        if (pass == 0) {
+            ws = alloc.allocate(ws_size);
+        }
+    }
+    alloc.deallocate(ws, ws_size);
+}
+
+// Sort the rows of `data` in place. `scratch` must hold at least `size` elements of T.
+template <typename T>
+void radix_sort_rows(T *data, void *scratch, int size, int n_cols, cudaStream_t stream, cupy_allocator& alloc) {
+    CUPY_CUB_NAMESPACE::DoubleBuffer<T> values(data, static_cast<T*>(scratch));
+
+    if constexpr (radix_key_pair<T>::value) {
+        using P = radix_key_pair<T>;
+        using K = typename P::type;
+        K *encoded = reinterpret_cast<K*>(alloc.allocate(2 * size * sizeof(K)));
+        CUPY_CUB_NAMESPACE::DoubleBuffer<K> keys(encoded, encoded + size);
+        thrust::transform(cuda::par(alloc).on(stream), data, data + size, keys.Current(), typename P::second());
+        segmented_radix_sort(keys, &values, size, n_cols, stream, alloc);
+        // the sort is stable, so the items with the same first word stay sorted by the second one
+        thrust::transform(cuda::par(alloc).on(stream), values.Current(), values.Current() + size, keys.Current(),
+                          typename P::first());
+        segmented_radix_sort(keys, &values, size, n_cols, stream, alloc);
+        alloc.deallocate(reinterpret_cast<char*>(encoded), 2 * size * sizeof(K));
+    } else if constexpr (std::is_same<typename radix_key<T>::type, T>::value) {
+        segmented_radix_sort<T, T>(values, NULL, size, n_cols, stream, alloc);
+    } else {
+        using K = typename radix_key<T>::type;
+        K *encoded = reinterpret_cast<K*>(alloc.allocate(2 * size * sizeof(K)));
+        thrust::transform(cuda::par(alloc).on(stream), data, data + size, encoded, radix_key<T>());
+        CUPY_CUB_NAMESPACE::DoubleBuffer<K> keys(encoded, encoded + size);
+        segmented_radix_sort(keys, &values, size, n_cols, stream, alloc);
+        alloc.deallocate(reinterpret_cast<char*>(encoded), 2 * size * sizeof(K));
+    }
+    if (values.Current() != data) {
+        thrust::copy(cuda::par(alloc).on(stream), values.Current(), values.Current() + size, data);
+    }
+}
+
+// Sort the in-row indices in `idx` by the rows of `data`. `data` is clobbered and `scratch` must hold at least
+// `size` elements of size_t.
+template <typename T>
+void radix_argsort_rows(size_t *idx, T *data, size_t *scratch, int size, int n_cols, cudaStream_t stream,
+                        cupy_allocator& alloc) {
+    CUPY_CUB_NAMESPACE::DoubleBuffer<size_t> values(idx, scratch);
+    if constexpr (radix_key_pair<T>::value) {
+        using P = radix_key_pair<T>;
+        using K = typename P::type;
+        #ifdef __HIP_PLATFORM_HCC__
+        rocprim::counting_iterator<size_t> count_first(0);
+        #else
+        thrust::counting_iterator<size_t> count_first(0);
+        #endif
+        K *buf = reinterpret_cast<K*>(alloc.allocate(2 * size * sizeof(K)));
+        CUPY_CUB_NAMESPACE::DoubleBuffer<K> keys(buf, buf + size);
+        thrust::transform(cuda::par(alloc).on(stream), data, data + size, keys.Current(), typename P::second());
+        segmented_radix_sort(keys, &values, size, n_cols, stream, alloc);
+        // the sort is stable, so the items with the same first word stay sorted by the second one
+        thrust::transform(cuda::par(alloc).on(stream), count_first, count_first + size, keys.Current(),
+                          radix_row_gather<T, typename P::first>(values.Current(), data, n_cols));
+        segmented_radix_sort(keys, &values, size, n_cols, stream, alloc);
+        alloc.deallocate(reinterpret_cast<char*>(buf), 2 * size * sizeof(K));
+    } else if constexpr (std::is_same<typename radix_key<T>::type, T>::value) {
+        using K = T;
+        K *buf;
+        buf = reinterpret_cast<K*>(alloc.allocate(size * sizeof(K)));
+        CUPY_CUB_NAMESPACE::DoubleBuffer<K> keys(data, buf);
+        segmented_radix_sort(keys, &values, size, n_cols, stream, alloc);
+        alloc.deallocate(reinterpret_cast<char*>(buf), size * sizeof(K));
+    } else {
+        using K = typename radix_key<T>::type;
+        K *buf = reinterpret_cast<K*>(alloc.allocate(2 * size * sizeof(K)));
+        thrust::transform(cuda::par(alloc).on(stream), data, data + size, buf, radix_key<T>());
+        CUPY_CUB_NAMESPACE::DoubleBuffer<K> keys(buf, buf + size);
+        segmented_radix_sort(keys, &values, size, n_cols, stream, alloc);
+        alloc.deallocate(reinterpret_cast<char*>(buf), 2 * size * sizeof(K));
+    }
+    if (values.Current() != idx) {
+        thrust::copy(cuda::par(alloc).on(stream), values.Current(), values.Current() + size, idx);
+    }
+}
+
+
 /*
  * sort
  */
@@ -336,10 +790,33 @@ struct _sort {
         dp_data_last  = thrust::device_pointer_cast(static_cast<T*>(data_start) + size);
 
         if (ndim == 1) {
+            if constexpr (!std::is_arithmetic<T>::value && radix_sortable<T>::value) {
+                // complex and half floats would need a comparator, which makes thrust use merge sort
+                if (size <= INT_MAX && size > 0) {
+                    void *scratch = alloc.allocate(size * sizeof(T));
+                    radix_sort_rows(static_cast<T*>(data_start), scratch, size, size, stream_, alloc);
+                    alloc.deallocate(static_cast<char*>(scratch), size * sizeof(T));
+                    return;
+                }
+            }
             // we use thrust::less directly to sort floating points, because then it can use radix sort, which happens to sort NaNs to the back
             using compare_op = std::conditional_t<std::is_floating_point<T>::value, thrust::less<T>, typename select_less<T>::type>;
             stable_sort(cuda::par(alloc).on(stream_), dp_data_first, dp_data_last, compare_op{});
         } else {
+            if constexpr (radix_sortable<T>::value) {
+                if (size <= INT_MAX && size > 0) {
+                    // the keys only hold `size` elements of size_t, which complex128 does not fit in
+                    if constexpr (sizeof(T) <= sizeof(size_t)) {
+                        radix_sort_rows(static_cast<T*>(data_start), keys_start, size, shape[ndim-1], stream_, alloc);
+                    } else {
+                        void *scratch = alloc.allocate(size * sizeof(T));
+                        radix_sort_rows(static_cast<T*>(data_start), scratch, size, shape[ndim-1], stream_, alloc);
+                        alloc.deallocate(static_cast<char*>(scratch), size * sizeof(T));
+                    }
+                    return;
+                }
+            }
+
             // Generate key indices.
             dp_keys_first = thrust::device_pointer_cast(keys_start);
             dp_keys_last  = thrust::device_pointer_cast(keys_start + size);
@@ -366,6 +843,214 @@ struct _sort {
 };
 
 
+/*
+ * top-k
+ *
+ * Radix select: every row is mapped to unsigned keys whose order matches the requested one (NumPy order for the
+ * smallest items, its reverse for the largest), the k-th key of each row is found by one histogram pass per byte, and
+ * only the k selected items are sorted afterwards. Ties at the k-th key are broken by the index in the row.
+ */
+
+#define CUPY_TOPK_BLOCK_SIZE 256
+
+template <typename T, typename Enable = void>
+struct radix_ordered {
+    // integers: flipping the sign bit makes the unsigned order match the signed one
+    using type = std::make_unsigned_t<T>;
+    bool flip;
+
+    __host__ __device__ radix_ordered(bool flip) : flip(flip) {}
+    __device__ __forceinline__ type operator()(const T& x) const {
+        type b = static_cast<type>(x);
+        if (std::is_signed<T>::value) {
+            b ^= static_cast<type>(type(1) << (sizeof(T) * 8 - 1));
+        }
+        return flip ? static_cast<type>(~b) : b;
+    }
+};
+
+template <typename T>
+struct radix_ordered<T, std::enable_if_t<!std::is_integral<T>::value>> {
+    using type = typename radix_key<T>::type;
+    bool flip;
+
+    __host__ __device__ radix_ordered(bool flip) : flip(flip) {}
+    __device__ __forceinline__ type operator()(const T& x) const {
+        const type b = radix_key<T>()(x);
+        return flip ? static_cast<type>(~b) : b;
+    }
+};
+
+// Find the k-th smallest key of each row and how many items equal to it are to be selected. One block per row.
+template <typename U>
+__global__ void _radix_select_kernel(const U *keys, long long n_cols, int k, U *thresholds, int *n_eq) {
+    __shared__ int hist[CUPY_TOPK_BLOCK_SIZE];
+    __shared__ U prefix;
+    __shared__ U mask;
+    __shared__ int remaining;
+    const U *row = keys + blockIdx.x * n_cols;
+
+    if (threadIdx.x == 0) {
+        prefix = 0;
+        mask = 0;
+        remaining = k;
+    }
+    for (int shift = sizeof(U) * 8 - 8; shift >= 0; shift -= 8) {
+        hist[threadIdx.x] = 0;
+        __syncthreads();
+        for (long long i = threadIdx.x; i < n_cols; i += CUPY_TOPK_BLOCK_SIZE) {
+            const U key = row[i];
+            if ((key & mask) == prefix) {
+                atomicAdd(&hist[(key >> shift) & 0xff], 1);
+            }
+        }
+        __syncthreads();
+        if (threadIdx.x == 0) {
+            int r = remaining;
+            int d = 0;
+            for (; d < 255 && hist[d] < r; ++d) {
+                r -= hist[d];
+            }
+            prefix |= static_cast<U>(static_cast<U>(d) << shift);
+            mask |= static_cast<U>(static_cast<U>(0xff) << shift);
+            remaining = r;
+        }
+        __syncthreads();
+    }
+    if (threadIdx.x == 0) {
+        thresholds[blockIdx.x] = prefix;
+        n_eq[blockIdx.x] = remaining;
+    }
+}
+
+// Compact the selected items of each row, in index order, to sel_keys/sel_idx (k per row). If rest_values is not
+// NULL, the rejected items are also written, in index order, to positions [k, n_cols) of each row of
+// rest_values/rest_idx. One block per row.
+template <typename T, typename U>
+__global__ void _radix_select_gather_kernel(const U *keys, const T *data, long long n_cols, int k,
+                                            const U *thresholds, const int *n_eq, U *sel_keys, size_t *sel_idx,
+                                            T *rest_values, size_t *rest_idx) {
+    typedef CUPY_CUB_NAMESPACE::BlockScan<int, CUPY_TOPK_BLOCK_SIZE> BlockScanT;
+    __shared__ typename BlockScanT::TempStorage temp;
+    __shared__ int lt_base, eq_base, rest_base;
+    const long long row_start = blockIdx.x * n_cols;
+    const U thres = thresholds[blockIdx.x];
+    const int eq_limit = n_eq[blockIdx.x];
+    const int lt_total = k - eq_limit;
+    U *out_keys = sel_keys + static_cast<long long>(blockIdx.x) * k;
+    size_t *out_idx = sel_idx + static_cast<long long>(blockIdx.x) * k;
+
+    if (threadIdx.x == 0) {
+        lt_base = eq_base = rest_base = 0;
+    }
+    __syncthreads();
+    for (long long start = 0; start < n_cols; start += CUPY_TOPK_BLOCK_SIZE) {
+        const long long i = start + threadIdx.x;
+        const bool valid = i < n_cols;
+        const U key = valid ? keys[row_start + i] : thres;
+        const int lt = valid && key < thres;
+        const int eq = valid && key == thres;
+        int lt_pos, eq_pos, rest_pos, lt_sum, eq_sum, rest_sum;
+
+        BlockScanT(temp).ExclusiveSum(lt, lt_pos, lt_sum);
+        __syncthreads();
+        BlockScanT(temp).ExclusiveSum(eq, eq_pos, eq_sum);
+        __syncthreads();
+        lt_pos += lt_base;
+        eq_pos += eq_base;
+        const int rest = valid && !lt && !(eq && eq_pos < eq_limit);
+        BlockScanT(temp).ExclusiveSum(rest, rest_pos, rest_sum);
+        rest_pos += rest_base;
+
+        if (lt) {
+            out_keys[lt_pos] = key;
+            out_idx[lt_pos] = i;
+        } else if (eq && eq_pos < eq_limit) {
+            out_keys[lt_total + eq_pos] = key;
+            out_idx[lt_total + eq_pos] = i;
+        } else if (rest && rest_values != NULL) {
+            rest_values[row_start + k + rest_pos] = data[row_start + i];
+            rest_idx[row_start + k + rest_pos] = i;
+        }
+        __syncthreads();
+        if (threadIdx.x == 0) {
+            lt_base += lt_sum;
+            eq_base += eq_sum;
+            rest_base += rest_sum;
+        }
+        __syncthreads();
+    }
+}
+
+// Write the sorted selection: values[r, j] = data[r, idx[r, j]] for j < k, with a row stride of out_cols.
+template <typename T>
+__global__ void _topk_gather_kernel(const T *data, long long n_cols, long long k, long long out_cols,
+                                    const size_t *sel_idx, T *values, size_t *idx, long long n_sel) {
+    for (long long i = blockIdx.x * static_cast<long long>(blockDim.x) + threadIdx.x; i < n_sel;
+         i += static_cast<long long>(gridDim.x) * blockDim.x) {
+        const long long r = i / k;
+        const long long j = i - r * k;
+        const size_t col = sel_idx[i];
+        values[r * out_cols + j] = data[r * n_cols + col];
+        idx[r * out_cols + j] = col;
+    }
+}
+
+struct _topk {
+    template <typename T>
+    __forceinline__ void operator()(void *data_start, void *values_start, size_t *idx_start,
+                                    size_t n_rows, size_t n_cols, size_t k, bool largest,
+                                    bool keep_rest, intptr_t stream, void *memory) {
+        if constexpr (!radix_key<T>::value) {
+            throw std::runtime_error("top-k is not supported for this dtype");
+        } else {
+            using U = typename radix_ordered<T>::type;
+            cudaStream_t stream_ = (cudaStream_t)stream;
+            cupy_allocator alloc(memory);
+            const T *data = static_cast<const T*>(data_start);
+            T *values = static_cast<T*>(values_start);
+            const size_t size = n_rows * n_cols;
+            const size_t n_sel = n_rows * k;
+
+            if (n_sel == 0) {
+                return;
+            }
+            if (n_sel > INT_MAX || n_cols > INT_MAX) {
+                throw std::runtime_error("top-k selection is too large");
+            }
+
+            U *keys = reinterpret_cast<U*>(alloc.allocate(size * sizeof(U)));
+            thrust::transform(cuda::par(alloc).on(stream_), data, data + size, keys, radix_ordered<T>(largest));
+
+            U *thresholds = reinterpret_cast<U*>(alloc.allocate(n_rows * sizeof(U)));
+            int *n_eq = reinterpret_cast<int*>(alloc.allocate(n_rows * sizeof(int)));
+            _radix_select_kernel<U><<<n_rows, CUPY_TOPK_BLOCK_SIZE, 0, stream_>>>(
+                keys, n_cols, k, thresholds, n_eq);
+
+            U *sel_keys = reinterpret_cast<U*>(alloc.allocate(2 * n_sel * sizeof(U)));
+            size_t *sel_idx = reinterpret_cast<size_t*>(alloc.allocate(2 * n_sel * sizeof(size_t)));
+            _radix_select_gather_kernel<T, U><<<n_rows, CUPY_TOPK_BLOCK_SIZE, 0, stream_>>>(
+                keys, data, n_cols, k, thresholds, n_eq, sel_keys, sel_idx,
+                keep_rest ? values : NULL, keep_rest ? idx_start : NULL);
+            alloc.deallocate(reinterpret_cast<char*>(n_eq), n_rows * sizeof(int));
+            alloc.deallocate(reinterpret_cast<char*>(thresholds), n_rows * sizeof(U));
+            alloc.deallocate(reinterpret_cast<char*>(keys), size * sizeof(U));
+
+            CUPY_CUB_NAMESPACE::DoubleBuffer<U> sorted_keys(sel_keys, sel_keys + n_sel);
+            CUPY_CUB_NAMESPACE::DoubleBuffer<size_t> sorted_idx(sel_idx, sel_idx + n_sel);
+            segmented_radix_sort(sorted_keys, &sorted_idx, static_cast<int>(n_sel), static_cast<int>(k),
+                                 stream_, alloc);
+
+            const size_t n_blocks = (n_sel + CUPY_TOPK_BLOCK_SIZE - 1) / CUPY_TOPK_BLOCK_SIZE;
+            _topk_gather_kernel<T><<<n_blocks < 4096 ? n_blocks : 4096, CUPY_TOPK_BLOCK_SIZE, 0, stream_>>>(
+                data, n_cols, k, keep_rest ? n_cols : k, sorted_idx.Current(), values, idx_start, n_sel);
+            alloc.deallocate(reinterpret_cast<char*>(sel_idx), 2 * n_sel * sizeof(size_t));
+            alloc.deallocate(reinterpret_cast<char*>(sel_keys), 2 * n_sel * sizeof(U));
+        }
+    }
+};
+
+
 /*
  * lexsort
  */
@@ -381,6 +1066,92 @@ private:
     const T *_data;
 };
 
+// Pack the k ordered keys of item j into one composite key, the last key being the most significant.
+template <typename T>
+struct lexsort_pack {
+    const T *keys;
+    size_t k;
+    size_t n;
+
+    lexsort_pack(const T *keys, size_t k, size_t n) : keys(keys), k(k), n(n) {}
+    __device__ __forceinline__ unsigned long long operator()(const size_t& j) const {
+        const radix_ordered<T> ord(false);
+        unsigned long long c = ord(keys[(k - 1) * n + j]);
+        for (size_t i = k - 1; i-- > 0;) {
+            c = (c << (sizeof(T) * 8)) | ord(keys[i * n + j]);
+        }
+        return c;
+    }
+};
+
+// Fetch the ordered key of the item at the (current) permuted position.
+template <typename T>
+struct lexsort_gather {
+    const T *key;
+
+    lexsort_gather(const T *key) : key(key) {}
+    __device__ __forceinline__ typename radix_ordered<T>::type operator()(const size_t& j) const {
+        return radix_ordered<T>(false)(key[j]);
+    }
+};
+
+template <typename K>
+void radix_sort_pairs(CUPY_CUB_NAMESPACE::DoubleBuffer<K>& keys, CUPY_CUB_NAMESPACE::DoubleBuffer<size_t>& values,
+                      int n, int end_bit, char *ws, size_t& ws_size, cudaStream_t stream) {
+    CUPY_CUB_NAMESPACE::DeviceRadixSort::SortPairs(ws, ws_size, keys, values, n, 0, end_bit, stream);
+}
+
+// Radix lexsort: the keys are packed into one 64-bit composite key if their widths allow, so a single radix sort
+// does. Otherwise every key, from the least significant one, is gathered by the current permutation and stably radix
+// sorted (LSD order), so no comparator ever gathers.
+template <typename T>
+void radix_lexsort(size_t *idx, const T *keys, size_t k, size_t n, cudaStream_t stream, cupy_allocator& alloc) {
+    using U = typename radix_ordered<T>::type;
+    auto policy = cuda::par(alloc).on(stream);
+    size_t *idx_buf = reinterpret_cast<size_t*>(alloc.allocate(n * sizeof(size_t)));
+    CUPY_CUB_NAMESPACE::DoubleBuffer<size_t> values(idx, idx_buf);
+    size_t ws_size = 0;
+    char *ws;
+
+    #ifdef __HIP_PLATFORM_HCC__
+    rocprim::counting_iterator<size_t> count_first(0);
+    #else
+    thrust::counting_iterator<size_t> count_first(0);
+    #endif
+    thrust::sequence(policy, idx, idx + n);
+
+    if (k * sizeof(U) <= sizeof(unsigned long long)) {
+        typedef unsigned long long K;
+        K *key_buf = reinterpret_cast<K*>(alloc.allocate(2 * n * sizeof(K)));
+        CUPY_CUB_NAMESPACE::DoubleBuffer<K> packed(key_buf, key_buf + n);
+        const int end_bit = static_cast<int>(k * sizeof(U) * 8);
+
+        thrust::transform(policy, count_first, count_first + n, key_buf, lexsort_pack<T>(keys, k, n));
+        radix_sort_pairs(packed, values, n, end_bit, NULL, ws_size, stream);
+        ws = alloc.allocate(ws_size);
+        radix_sort_pairs(packed, values, n, end_bit, ws, ws_size, stream);
+        alloc.deallocate(ws, ws_size);
+        alloc.deallocate(reinterpret_cast<char*>(key_buf), 2 * n * sizeof(K));
+    } else {
+        U *key_buf = reinterpret_cast<U*>(alloc.allocate(2 * n * sizeof(U)));
+        CUPY_CUB_NAMESPACE::DoubleBuffer<U> permuted(key_buf, key_buf + n);
+
+        radix_sort_pairs(permuted, values, n, sizeof(U) * 8, NULL, ws_size, stream);
+        ws = alloc.allocate(ws_size);
+        for (size_t i = 0; i < k; ++i) {
+            const size_t *perm = values.Current();
+            thrust::transform(policy, perm, perm + n, permuted.Current(), lexsort_gather<T>(keys + i * n));
+            radix_sort_pairs(permuted, values, n, sizeof(U) * 8, ws, ws_size, stream);
+        }
+        alloc.deallocate(ws, ws_size);
+        alloc.deallocate(reinterpret_cast<char*>(key_buf), 2 * n * sizeof(U));
+    }
+    if (values.Current() != idx) {
+        thrust::copy(policy, values.Current(), values.Current() + n, idx);
+    }
+    alloc.deallocate(reinterpret_cast<char*>(idx_buf), n * sizeof(size_t));
+}
+
 struct _lexsort {
     template <typename T>
     __forceinline__ void operator()(size_t *idx_start, void *keys_start, size_t k,
@@ -392,6 +1163,12 @@ struct _lexsort {
         thrust::device_ptr<size_t> dp_last  = thrust::device_pointer_cast(idx_start + n);
         cudaStream_t stream_ = (cudaStream_t)stream;
         cupy_allocator alloc(memory);
+        if constexpr (radix_key<T>::value) {
+            if (k > 0 && n > 0 && n <= INT_MAX) {
+                radix_lexsort(idx_start, static_cast<const T*>(keys_start), k, n, stream_, alloc);
+                return;
+            }
+        }
         sequence(cuda::par(alloc).on(stream_), dp_first, dp_last);
         for (size_t i = 0; i < k; ++i) {
             T *key_start = static_cast<T*>(keys_start) + i * n;
@@ -456,6 +1233,16 @@ struct _argsort {
                   thrust::modulus<size_t>());
 
         if (ndim == 1) {
+            if constexpr (!std::is_arithmetic<T>::value && radix_sortable<T>::value) {
+                // complex and half floats would need a comparator, which makes thrust use merge sort
+                if (size <= INT_MAX && size > 0) {
+                    size_t *scratch = reinterpret_cast<size_t*>(alloc.allocate(size * sizeof(size_t)));
+                    radix_argsort_rows(static_cast<size_t*>(idx_start), static_cast<T*>(data_start),
+                                       scratch, size, size, stream_, alloc);
+                    alloc.deallocate(reinterpret_cast<char*>(scratch), size * sizeof(size_t));
+                    return;
+                }
+            }
             // we use thrust::less directly to sort floating points, because then it can use radix sort, which happens to sort NaNs to the back
             using compare_op = std::conditional_t<std::is_floating_point<T>::value, thrust::less<T>, typename select_less<T>::type>;
             // Sort the index sequence by data.
@@ -465,6 +1252,14 @@ struct _argsort {
                                dp_idx_first,
                                compare_op{});
         } else {
+            if constexpr (radix_sortable<T>::value) {
+                if (size <= INT_MAX && size > 0) {
+                    radix_argsort_rows(static_cast<size_t*>(idx_start), static_cast<T*>(data_start),
+                                       static_cast<size_t*>(keys_start), size, shape[ndim-1], stream_, alloc);
+                    return;
+                }
+            }
+
             // Generate key indices.
             dp_keys_first = thrust::device_pointer_cast(static_cast<size_t*>(keys_start));
             dp_keys_last  = thrust::device_pointer_cast(static_cast<size_t*>(keys_start) + size);
@@ -492,6 +1287,160 @@ struct _argsort {
 };
 
 
+/*
+ * segmented sort
+ *
+ * Sort the segments of a flat array given by CSR-style offsets (n_segments + 1 items, int64). Integers and floats use
+ * CUB's DeviceSegmentedSort, which sorts small segments within a warp, on the same radix keys as the row sort above;
+ * other dtypes stably sort (segment id, value) tuples by thrust.
+ */
+
+template <typename K, typename V>
+void segmented_stable_sort(CUPY_CUB_NAMESPACE::DoubleBuffer<K>& keys, CUPY_CUB_NAMESPACE::DoubleBuffer<V>* values,
+                           int size, int n_segments, const long long *offsets, cudaStream_t stream,
+                           cupy_allocator& alloc) {
+    size_t ws_size = 0;
+    char *ws = NULL;
+
+    // the first pass only queries the workspace size
+    for (int pass = 0; pass < 2; ++pass) {
+        if (values == NULL) {
+            CUPY_CUB_NAMESPACE::DeviceSegmentedSort::StableSortKeys(
+                ws, ws_size, keys, size, n_segments, offsets, offsets + 1, stream);
+        } else {
+            CUPY_CUB_NAMESPACE::DeviceSegmentedSort::StableSortPairs(
+                ws, ws_size, keys, *values, size, n_segments, offsets, offsets + 1, stream);
+        }
+        if (pass == 0) {
+            ws = alloc.allocate(ws_size);
+        }
+    }
+    alloc.deallocate(ws, ws_size);
+}
+
+// segment_ids[i] = the segment that item i belongs to
+static void segment_ids(size_t *ids, const long long *offsets, size_t size, size_t n_segments,
+                        cudaStream_t stream, cupy_allocator& alloc) {
+    thrust::upper_bound(cuda::par(alloc).on(stream), offsets + 1, offsets + 1 + n_segments,
+                        #ifdef __HIP_PLATFORM_HCC__
+                        rocprim::make_counting_iterator<long long>(0),
+                        rocprim::make_counting_iterator<long long>(size),
+                        #else
+                        thrust::make_counting_iterator<long long>(0),
+                        thrust::make_counting_iterator<long long>(size),
+                        #endif
+                        ids);
+}
+
+struct _segmented_sort {
+    template <typename T>
+    __forceinline__ void operator()(void *data_start, const long long *offsets, size_t size,
+                                    size_t n_segments, intptr_t stream, void *memory) {
+        cudaStream_t stream_ = (cudaStream_t)stream;
+        cupy_allocator alloc(memory);
+        T *data = static_cast<T*>(data_start);
+
+        if (size == 0 || n_segments == 0) {
+            return;
+        }
+        if constexpr (radix_key<T>::value) {
+            if (size <= INT_MAX && n_segments <= INT_MAX) {
+                using K = typename radix_key<T>::type;
+                T *buf = reinterpret_cast<T*>(alloc.allocate(size * sizeof(T)));
+                CUPY_CUB_NAMESPACE::DoubleBuffer<T> values(data, buf);
+
+                if constexpr (std::is_same<K, T>::value) {
+                    segmented_stable_sort<T, T>(values, NULL, size, n_segments, offsets, stream_, alloc);
+                } else {
+                    K *encoded = reinterpret_cast<K*>(alloc.allocate(2 * size * sizeof(K)));
+                    thrust::transform(cuda::par(alloc).on(stream_), data, data + size, encoded, radix_key<T>());
+                    CUPY_CUB_NAMESPACE::DoubleBuffer<K> keys(encoded, encoded + size);
+                    segmented_stable_sort(keys, &values, size, n_segments, offsets, stream_, alloc);
+                    alloc.deallocate(reinterpret_cast<char*>(encoded), 2 * size * sizeof(K));
+                }
+                if (values.Current() != data) {
+                    thrust::copy(cuda::par(alloc).on(stream_), values.Current(), values.Current() + size, data);
+                }
+                alloc.deallocate(reinterpret_cast<char*>(buf), size * sizeof(T));
+                return;
+            }
+        }
+
+        size_t *ids = reinterpret_cast<size_t*>(alloc.allocate(size * sizeof(size_t)));
+        segment_ids(ids, offsets, size, n_segments, stream_, alloc);
+        thrust::device_ptr<size_t> dp_ids = thrust::device_pointer_cast(ids);
+        thrust::device_ptr<T> dp_data = thrust::device_pointer_cast(data);
+        stable_sort(
+            cuda::par(alloc).on(stream_),
+            make_zip_iterator(dp_ids, dp_data),
+            make_zip_iterator(dp_ids + size, dp_data + size),
+            typename select_less<thrust::tuple<size_t, T>>::type{});
+        alloc.deallocate(reinterpret_cast<char*>(ids), size * sizeof(size_t));
+    }
+};
+
+struct _segmented_argsort {
+    template <typename T>
+    __forceinline__ void operator()(size_t *idx_start, void *data_start, const long long *offsets,
+                                    size_t size, size_t n_segments, intptr_t stream, void *memory) {
+        /* The flat positions that sort every segment are written to idx_start. The data is clobbered. */
+        cudaStream_t stream_ = (cudaStream_t)stream;
+        cupy_allocator alloc(memory);
+        T *data = static_cast<T*>(data_start);
+
+        if (size == 0 || n_segments == 0) {
+            return;
+        }
+        thrust::sequence(cuda::par(alloc).on(stream_), idx_start, idx_start + size);
+        if constexpr (radix_key<T>::value) {
+            if (size <= INT_MAX && n_segments <= INT_MAX) {
+                using K = typename radix_key<T>::type;
+                size_t *idx_buf = reinterpret_cast<size_t*>(alloc.allocate(size * sizeof(size_t)));
+                CUPY_CUB_NAMESPACE::DoubleBuffer<size_t> values(idx_start, idx_buf);
+                K *buf;
+
+                if constexpr (std::is_same<K, T>::value) {
+                    buf = reinterpret_cast<K*>(alloc.allocate(size * sizeof(K)));
+                    CUPY_CUB_NAMESPACE::DoubleBuffer<K> keys(data, buf);
+                    segmented_stable_sort(keys, &values, size, n_segments, offsets, stream_, alloc);
+                    alloc.deallocate(reinterpret_cast<char*>(buf), size * sizeof(K));
+                } else {
+                    buf = reinterpret_cast<K*>(alloc.allocate(2 * size * sizeof(K)));
+                    thrust::transform(cuda::par(alloc).on(stream_), data, data + size, buf, radix_key<T>());
+                    CUPY_CUB_NAMESPACE::DoubleBuffer<K> keys(buf, buf + size);
+                    segmented_stable_sort(keys, &values, size, n_segments, offsets, stream_, alloc);
+                    alloc.deallocate(reinterpret_cast<char*>(buf), 2 * size * sizeof(K));
+                }
+                if (values.Current() != idx_start) {
+                    thrust::copy(cuda::par(alloc).on(stream_), values.Current(), values.Current() + size,
+                                 idx_start);
+                }
+                alloc.deallocate(reinterpret_cast<char*>(idx_buf), size * sizeof(size_t));
+                return;
+            }
+        }
+
+        size_t *ids = reinterpret_cast<size_t*>(alloc.allocate(size * sizeof(size_t)));
+        segment_ids(ids, offsets, size, n_segments, stream_, alloc);
+        thrust::device_ptr<size_t> dp_ids = thrust::device_pointer_cast(ids);
+        thrust::device_ptr<T> dp_data = thrust::device_pointer_cast(data);
+        stable_sort_by_key(
+            cuda::par(alloc).on(stream_),
+            make_zip_iterator(dp_ids, dp_data),
+            make_zip_iterator(dp_ids + size, dp_data + size),
+            thrust::device_pointer_cast(idx_start),
+            typename select_less<thrust::tuple<size_t, T>>::type{});
+        alloc.deallocate(reinterpret_cast<char*>(ids), size * sizeof(size_t));
+    }
+};
+
+
+// bfloat16 is only instantiated for sorting; lexsort and top-k reject it.
+template <> struct dispatch_bfloat16<_sort> : std::true_type {};
+template <> struct dispatch_bfloat16<_argsort> : std::true_type {};
+template <> struct dispatch_bfloat16<_segmented_sort> : std::true_type {};
+template <> struct dispatch_bfloat16<_segmented_argsort> : std::true_type {};
+
 //
 // APIs exposed to CuPy
 //
@@ -515,6 +1464,51 @@ void thrust_lexsort(int dtype_id, size_t *idx_start, void *keys_start, size_t k,
 }
 
 
+/* -------- segmented sort -------- */
+void thrust_segmented_sort(int dtype_id, void *data_start, void *offsets_start, size_t size,
+    size_t n_segments, intptr_t stream, void *memory) {
+
+    _segmented_sort op;
+    return dtype_dispatcher(dtype_id, op, data_start, static_cast<const long long*>(offsets_start),
+                            size, n_segments, stream, memory);
+}
+
+void thrust_segmented_argsort(int dtype_id, size_t *idx_start, void *data_start, void *offsets_start,
+    size_t size, size_t n_segments, intptr_t stream, void *memory) {
+
+    _segmented_argsort op;
+    return dtype_dispatcher(dtype_id, op, idx_start, data_start,
+                            static_cast<const long long*>(offsets_start), size, n_segments, stream,
+                            memory);
+}
+
+
+/* -------- top-k -------- */
+void thrust_topk(int dtype_id, void *data_start, void *values_start, size_t *idx_start,
+    size_t n_rows, size_t n_cols, size_t k, bool largest, bool keep_rest, intptr_t stream,
+    void *memory) {
+
+    _topk op;
+    return dtype_dispatcher(dtype_id, op, data_start, values_start, idx_start, n_rows, n_cols,
+                            k, largest, keep_rest, stream, memory);
+}
+
+
+/* -------- workspace -------- */
+bool thrust_release_workspace(int device, intptr_t key) {
+    // the buffers themselves are owned (and released) by the Python side
+    auto it = cupy_workspaces.find(std::make_pair(device, key));
+    if (it == cupy_workspaces.end()) {
+        return true;
+    }
+    if (it->second.n_live > 0) {
+        return false;
+    }
+    cupy_workspaces.erase(it);
+    return true;
+}
+
+
 /* -------- argsort -------- */
 void thrust_argsort(int dtype_id, size_t *idx_start, void *data_start,
     void *keys_start, const std::vector<ptrdiff_t>& shape, intptr_t stream, void *memory) {
@@ -9,6 +9,10 @@
 void thrust_sort(int, void *, size_t *, const std::vector<ptrdiff_t>&, intptr_t, void *);
 void thrust_lexsort(int, size_t *, void *, size_t, size_t, intptr_t, void *);
 void thrust_argsort(int, size_t *, void *, void *, const std::vector<ptrdiff_t>&, intptr_t, void *);
+void thrust_topk(int, void *, void *, size_t *, size_t, size_t, size_t, bool, bool, intptr_t, void *);
+void thrust_segmented_sort(int, void *, void *, size_t, size_t, intptr_t, void *);
+void thrust_segmented_argsort(int, size_t *, void *, void *, size_t, size_t, intptr_t, void *);
+bool thrust_release_workspace(int, intptr_t);
 
 #if (defined(_MSC_VER) && (__CUDACC_VER_MAJOR__ == 11 && __CUDACC_VER_MINOR__ == 2))
   #define __builtin_unreachable() __assume(false)
@@ -27,6 +31,19 @@ void thrust_lexsort(...) {
 void thrust_argsort(...) {
 }
 
+void thrust_topk(...) {
+}
+
+void thrust_segmented_sort(...) {
+}
+
+void thrust_segmented_argsort(...) {
+}
+
+bool thrust_release_workspace(...) {
+    return true;
+}
+
 #endif // #ifndef CUPY_NO_CUDA
 
 #endif // INCLUDE_GUARD_CUPY_CUDA_THRUST_H
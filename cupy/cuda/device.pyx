@@ -36,6 +36,16 @@ cdef class _ThreadLocalStack:
         return <int>self._devices.pop()
 
 
+cdef inline int _switch_device(int device_id) except? -1:
+    # Makes the device current and returns the previous one. cudaSetDevice
+    # is skipped when the device does not change, as cudaGetDevice only reads
+    # the state of the calling thread.
+    cdef int prev_device = runtime.getDevice()
+    if prev_device != device_id:
+        runtime.setDevice(device_id)
+    return prev_device
+
+
 cpdef int get_device_id() except? -1:
     return runtime.getDevice()
 
@@ -91,14 +101,13 @@ cdef bint _enable_peer_access(int device, int peer) except -1:
     if can_access == 0:
         return False
 
-    cdef int current = runtime.getDevice()
-    runtime.setDevice(device)
+    cdef int current = _switch_device(device)
     try:
         # Note: external libraries may disable the peer access, so we need to
         # call this everytime. See #5496.
         runtime._deviceEnsurePeerAccess(peer)
     finally:
-        runtime.setDevice(current)
+        _switch_device(current)
     return True
 
 
@@ -170,14 +179,11 @@ cdef class Device:
         return self.id
 
     def __enter__(self):
-        cdef int id = runtime.getDevice()
-        _ThreadLocalStack.get().push(id)
-        if self.id != id:
-            runtime.setDevice(self.id)
+        _ThreadLocalStack.get().push(_switch_device(self.id))
         return self
 
     def __exit__(self, *args):
-        runtime.setDevice(_ThreadLocalStack.get().pop())
+        _switch_device(_ThreadLocalStack.get().pop())
 
     def __repr__(self):
         return '<CUDA Device %d>' % self.id
@@ -194,12 +200,11 @@ cdef class Device:
     cpdef synchronize(self):
         """Synchronizes the current thread to the device."""
         syncdetect._declare_synchronize()
-        prev_device = runtime.getDevice()
+        prev_device = _switch_device(self.id)
         try:
-            runtime.setDevice(self.id)
             runtime.deviceSynchronize()
         finally:
-            runtime.setDevice(prev_device)
+            _switch_device(prev_device)
 
     @property
     def compute_capability(self):
@@ -212,9 +217,8 @@ cdef class Device:
         """
         if self.id in _compute_capabilities:
             return _compute_capabilities[self.id]
-        prev_device = runtime.getDevice()
+        prev_device = _switch_device(self.id)
         try:
-            runtime.setDevice(self.id)
             major = runtime.deviceGetAttribute(
                 runtime.deviceAttributeComputeCapabilityMajor, self.id)
             minor = runtime.deviceGetAttribute(
@@ -223,7 +227,7 @@ cdef class Device:
             _compute_capabilities[self.id] = cc
             return cc
         finally:
-            runtime.setDevice(prev_device)
+            _switch_device(prev_device)
 
     def _get_handle(self, name, create_func, destroy_func):
         handles = getattr(_thread_local, name, None)
@@ -233,14 +237,13 @@ cdef class Device:
         handle = handles.get(self.id, None)
         if handle is not None:
             return handle.handle
-        prev_device = runtime.getDevice()
+        prev_device = _switch_device(self.id)
         try:
-            runtime.setDevice(self.id)
             handle = create_func()
             handles[self.id] = Handle(handle, destroy_func)
             return handle
         finally:
-            runtime.setDevice(prev_device)
+            _switch_device(prev_device)
 
     @property
     def cublas_handle(self):
@@ -298,12 +301,11 @@ cdef class Device:
             free: The amount of free memory, in bytes.
             total: The total amount of memory, in bytes.
         """
-        prev_device = runtime.getDevice()
+        prev_device = _switch_device(self.id)
         try:
-            runtime.setDevice(self.id)
             return runtime.memGetInfo()
         finally:
-            runtime.setDevice(prev_device)
+            _switch_device(prev_device)
 
     @property
     def attributes(self):
@@ -5,11 +5,17 @@ cdef class CPointer:
     cdef void* ptr
 
 
+cpdef bint _kernel_ranges_enabled()
+cpdef int _push_range(str name, args, intptr_t stream) except -1
+cpdef _pop_range(int flags, intptr_t stream)
+
+
 cdef class Function:
 
     cdef:
         public Module module
         public intptr_t ptr
+        readonly str name
 
     cpdef linear_launch(self, size_t size, args, size_t shared_mem=*,
                         size_t block_max_size=*, stream=*,
@@ -1,5 +1,7 @@
 # distutils: language = c++
 
+import os
+
 import numpy
 import warnings
 
@@ -9,7 +11,11 @@ from libc.stdint cimport int32_t
 from libc.stdint cimport int64_t
 from libc.stdint cimport intptr_t
 from libc.stdint cimport uintmax_t
+from libc.string cimport memcpy
 from libcpp cimport vector
+from cpython.buffer cimport PyBUF_SIMPLE
+from cpython.buffer cimport PyBuffer_Release
+from cpython.buffer cimport PyObject_GetBuffer
 
 from cupy._core cimport _carray
 from cupy._core.core cimport _ndarray_base
@@ -158,6 +164,92 @@ cdef inline CPointer _pointer(x):
     raise TypeError('Unsupported type %s. (size=%d)', type(x), itemsize)
 
 
+# Whether each kernel launch is wrapped in an NVTX (or rocTX) range; see
+# `cupyx.profiler.kernel_ranges`.
+cdef bint _kernel_ranges = False
+cdef object _nvtx = None
+
+# The collector of `cupyx.profiler.kernel_stats` timing each kernel launch,
+# or None.
+cdef object _kernel_stats = None
+
+
+cpdef _set_kernel_ranges(bint enabled):
+    global _kernel_ranges, _nvtx
+    if enabled and _nvtx is None:
+        from cupy.cuda import nvtx
+        if not nvtx.available:
+            raise RuntimeError('nvtx is not installed')
+        _nvtx = nvtx
+    _kernel_ranges = enabled
+
+
+cpdef bint _kernel_ranges_enabled():
+    return _kernel_ranges
+
+
+cpdef _set_kernel_stats(stats):
+    global _kernel_stats
+    _kernel_stats = stats
+
+
+cpdef _get_kernel_stats():
+    return _kernel_stats
+
+
+cdef tuple _describe(args):
+    # Returns e.g. ("float32(1000,), float32(1000,)", 8000), or the string
+    # of any other value and None.
+    cdef list descs = []
+    cdef Py_ssize_t nbytes = 0
+    cdef _ndarray_base arr
+    if isinstance(args, _ndarray_base):
+        args = (args,)
+    elif not isinstance(args, (tuple, list)):
+        return str(args), None
+    for a in args:
+        if isinstance(a, _ndarray_base):
+            arr = a
+            descs.append('{}{}'.format(arr.dtype.name, arr.shape))
+            nbytes += arr.nbytes
+    return ', '.join(descs), nbytes
+
+
+cpdef int _push_range(str name, args, intptr_t stream) except -1:
+    """Opens a range for a kernel or library call if it is being profiled.
+
+    ``args`` is an array or a sequence of the arrays it touches, or any other
+    value to show. Returns the flags to pass to `_pop_range` after the call
+    has been issued on ``stream``, which are zero if nothing was opened.
+    """
+    cdef int flags = 0
+    if not _kernel_ranges and _kernel_stats is None:
+        return 0
+    signature, nbytes = _describe(args)
+    if _kernel_ranges:
+        if nbytes is None:
+            _nvtx.RangePush('{} [{}]'.format(name, signature))
+        else:
+            _nvtx.RangePush('{} [{}, {} bytes]'.format(
+                name, signature, nbytes))
+        flags |= 1
+    if _kernel_stats is not None:
+        _kernel_stats._start(name, signature, nbytes or 0, stream)
+        flags |= 2
+    return flags
+
+
+cpdef _pop_range(int flags, intptr_t stream):
+    if flags & 1:
+        _nvtx.RangePop()
+    if flags & 2 and _kernel_stats is not None:
+        _kernel_stats._stop(stream)
+
+
+if int(os.environ.get('CUPY_KERNEL_RANGES', '0')):
+    _set_kernel_ranges(True)
+
+
 cdef inline size_t _get_stream(stream) except *:
     if stream is None:
         return stream_module.get_current_stream_ptr()
@@ -165,18 +257,90 @@ cdef inline size_t _get_stream(stream) except *:
         return stream.ptr
 
 
+cdef inline bint _pack(x, vector.vector[int64_t]& words) except -1:
+    # Appends the value of a kernel argument to ``words``, so that the
+    # common arguments need no Python object and the GIL is held briefly.
+    # Returns False for the other arguments, which go through `_pointer`.
+    cdef _ndarray_base arr
+    cdef size_t offset = words.size()
+    cdef size_t ndim
+    cdef int64_t i
+    cdef double d
+    cdef double complex z
+    cdef Py_buffer view
+    if isinstance(x, _ndarray_base):
+        # the layout of CArray
+        arr = x
+        ndim = arr._shape.size()
+        words.resize(offset + 2 + 2 * ndim)
+        words[offset] = <int64_t>arr.data.ptr
+        words[offset + 1] = arr.size
+        if ndim != 0:
+            memcpy(&words[offset + 2], arr._shape.data(),
+                   sizeof(Py_ssize_t) * ndim)
+            memcpy(&words[offset + 2 + ndim], arr._strides.data(),
+                   sizeof(Py_ssize_t) * ndim)
+        return True
+    if isinstance(x, MemoryPointer):
+        words.push_back(<int64_t>(<MemoryPointer>x).ptr)
+        return True
+    if type(x) in _pointer_numpy_types:
+        PyObject_GetBuffer(x, &view, PyBUF_SIMPLE)
+        try:
+            if view.len > 16:
+                return False
+            words.resize(offset + (view.len + 7) // 8, 0)
+            memcpy(&words[offset], view.buf, view.len)
+        finally:
+            PyBuffer_Release(&view)
+        return True
+    if isinstance(x, int):
+        # including bool, as `_pointer`
+        i = x
+        words.push_back(i)
+        return True
+    if isinstance(x, float):
+        d = x
+        words.push_back(0)
+        memcpy(&words[offset], &d, sizeof(double))
+        return True
+    if isinstance(x, complex):
+        z = x
+        words.resize(offset + 2)
+        memcpy(&words[offset], &z, sizeof(double complex))
+        return True
+    return False
+
+
 cdef _launch(intptr_t func, Py_ssize_t grid0, int grid1, int grid2,
              Py_ssize_t block0, int block1, int block2,
              args, Py_ssize_t shared_mem, size_t stream,
              bint enable_cooperative_groups=False):
-    cdef list pargs = []
+    # The arguments are marshalled into ``words``, and only the others are
+    # converted to CPointer objects, kept alive in ``pargs``. The launch
+    # itself releases the GIL.
+    cdef list pargs = None
     cdef vector.vector[void*] kargs
+    cdef vector.vector[int64_t] words
+    cdef vector.vector[Py_ssize_t] offsets
     cdef CPointer cp
-    kargs.reserve(len(args))
-    for a in args:
-        cp = _pointer(a)
-        pargs.append(cp)  # keep the CPointer objects alive
-        kargs.push_back(cp.ptr)
+    cdef Py_ssize_t i, n_args = len(args)
+    kargs.resize(n_args)
+    offsets.resize(n_args)
+    words.reserve(4 * n_args)
+    for i in range(n_args):
+        a = args[i]
+        offsets[i] = words.size()
+        if not _pack(a, words):
+            offsets[i] = -1
+            cp = _pointer(a)
+            if pargs is None:
+                pargs = []
+            pargs.append(cp)
+            kargs[i] = cp.ptr
+    for i in range(n_args):
+        if offsets[i] >= 0:
+            kargs[i] = &words[offsets[i]]
 
     runtime._ensure_context()
 
@@ -214,17 +378,23 @@ cdef class Function:
     def __init__(self, Module module, str funcname):
         self.module = module  # to keep module loaded
         self.ptr = driver.moduleGetFunction(module.ptr, funcname)
+        self.name = funcname
 
     def __call__(self, tuple grid, tuple block, args, size_t shared_mem=0,
                  stream=None, enable_cooperative_groups=False):
         grid = (grid + (1, 1))[:3]
         block = (block + (1, 1))[:3]
         s = _get_stream(stream)
-        _launch(
-            self.ptr,
-            max(1, grid[0]), max(1, grid[1]), max(1, grid[2]),
-            max(1, block[0]), max(1, block[1]), max(1, block[2]),
-            args, shared_mem, s, enable_cooperative_groups)
+        cdef int ranged = _push_range(self.name, args, s)
+        try:
+            _launch(
+                self.ptr,
+                max(1, grid[0]), max(1, grid[1]), max(1, grid[2]),
+                max(1, block[0]), max(1, block[1]), max(1, block[2]),
+                args, shared_mem, s, enable_cooperative_groups)
+        finally:
+            if ranged:
+                _pop_range(ranged, s)
 
     cpdef linear_launch(self, size_t size, args, size_t shared_mem=0,
                         size_t block_max_size=128, stream=None,
@@ -234,11 +404,16 @@ cdef class Function:
             0x7fffffffUL, (size + block_max_size - 1) // block_max_size)
         cdef size_t blockx = min(block_max_size, size)
         s = _get_stream(stream)
-        _launch(
-            self.ptr,
-            gridx, 1, 1, blockx, 1, 1,
-            args,
-            shared_mem, s, enable_cooperative_groups)
+        cdef int ranged = _push_range(self.name, args, s)
+        try:
+            _launch(
+                self.ptr,
+                gridx, 1, 1, blockx, 1, 1,
+                args,
+                shared_mem, s, enable_cooperative_groups)
+        finally:
+            if ranged:
+                _pop_range(ranged, s)
 
 
 cdef class Module:
@@ -1,16 +1,34 @@
 from libc.stdint cimport intptr_t
 
 
+cdef class _GraphMemory:
+    cdef:
+        list _releasers
+
+    cdef add_releaser(self, releaser)
+    cpdef release(self)
+
+
+cdef _begin_capture(intptr_t stream_ptr)
+cdef _GraphMemory _end_capture(intptr_t stream_ptr)
+cdef _GraphMemory _get_capture_memory(intptr_t stream_ptr)
+
+
 cdef class Graph:
     cdef:
         readonly intptr_t graph  # cudaGraph_t
         readonly intptr_t graphExec  # cudaGraphExec_t
+        _GraphMemory _memory
 
     cdef void _init(self, intptr_t g, intptr_t ge) except*
 
     @staticmethod
-    cdef Graph from_stream(intptr_t g)
+    cdef Graph from_stream(intptr_t g, bint instantiate=*,
+                           _GraphMemory memory=*)
+
+    cdef void _instantiate(self) except*
 
     cpdef launch(self, stream=*)
     cpdef upload(self, stream=*)
+    cpdef bint update(self, Graph graph) except*
     cpdef debug_dot_str(self, flags=*)
@@ -5,6 +5,44 @@ from cupy_backends.cuda.api cimport runtime
 from cupy_backends.cuda cimport stream as stream_module
 
 
+# Map from the pointer of each stream being captured by
+# `Stream.begin_capture` to the memory owned by the graph being captured.
+cdef dict _captures = {}
+
+
+cdef class _GraphMemory:
+    # The memory that the memory pools handed out during a capture, which
+    # is kept for the graph until it is destroyed (see
+    # `MemoryPool.set_capture_policy`). Each pool registers a callable that
+    # returns the memory to its free lists.
+
+    def __init__(self):
+        self._releasers = []
+
+    cdef add_releaser(self, releaser):
+        self._releasers.append(releaser)
+
+    cpdef release(self):
+        releasers = self._releasers
+        self._releasers = []
+        for releaser in releasers:
+            releaser()
+
+
+cdef _begin_capture(intptr_t stream_ptr):
+    _captures[stream_ptr] = _GraphMemory()
+
+
+cdef _GraphMemory _end_capture(intptr_t stream_ptr):
+    return _captures.pop(stream_ptr, None)
+
+
+cdef _GraphMemory _get_capture_memory(intptr_t stream_ptr):
+    if not _captures:
+        return None
+    return _captures.get(stream_ptr)
+
+
 cdef class Graph:
     """The CUDA graph object.
 
@@ -22,6 +60,8 @@ cdef class Graph:
             runtime.graphDestroy(self.graph)
         if self.graphExec > 0:
             runtime.graphExecDestroy(self.graphExec)
+        if self._memory is not None:
+            self._memory.release()
 
     def __init__(self, *args, **kwargs):
         raise NotImplementedError(
@@ -29,13 +69,28 @@ cdef class Graph:
             'be created via stream capture')
 
     @staticmethod
-    cdef Graph from_stream(intptr_t g):
+    cdef Graph from_stream(intptr_t g, bint instantiate=True,
+                           _GraphMemory memory=None):
         # TODO(leofang): optionally print out the error log?
-        cdef intptr_t ge = runtime.graphInstantiate(g)
-        cdef Graph graph = Graph.__new__(Graph)
+        cdef intptr_t ge
+        cdef Graph graph
+        try:
+            ge = runtime.graphInstantiate(g) if instantiate else 0
+        except Exception:
+            if memory is not None:
+                memory.release()
+            raise
+        graph = Graph.__new__(Graph)
         graph._init(g, ge)
+        graph._memory = memory
         return graph
 
+    cdef void _instantiate(self) except*:
+        # A graph that is only used to update another one is not
+        # instantiated until it is launched.
+        if self.graphExec == 0:
+            self.graphExec = runtime.graphInstantiate(self.graph)
+
     cpdef launch(self, stream=None):
         """Launch the CUDA graph on the given stream.
 
@@ -55,6 +110,7 @@ cdef class Graph:
             stream_ptr = stream_module.get_current_stream_ptr()
         else:
             stream_ptr = stream.ptr
+        self._instantiate()
         runtime.graphLaunch(self.graphExec, stream_ptr)
 
     cpdef upload(self, stream=None):
@@ -76,8 +132,49 @@ cdef class Graph:
             stream_ptr = stream_module.get_current_stream_ptr()
         else:
             stream_ptr = stream.ptr
+        self._instantiate()
         runtime.graphUpload(self.graphExec, stream_ptr)
 
+    cpdef bint update(self, Graph graph) except*:
+        """Update the CUDA graph in place with the parameters of another.
+
+        The parameters of the nodes of ``graph``, e.g. the pointers passed
+        to the kernels, are copied to the executable graph of this object,
+        which is much cheaper than instantiating ``graph``. The update is
+        only possible if ``graph`` has the same topology, e.g. if it was
+        captured from the same sequence of operations on other buffers.
+
+        Args:
+            graph (:class:`~cupy.cuda.Graph`): The graph to take the
+                parameters from.
+
+        Returns:
+            bool: ``True`` if the graph was updated, ``False`` if the update
+            was rejected, in which case this graph is unchanged.
+
+        .. note:: :meth:`debug_dot_str` still shows the parameters of the
+            original graph after an update. The memory kept for ``graph``
+            by the ``'per_graph'`` capture policy of the memory pool is then
+            kept for this graph, and the other way around.
+
+        .. seealso:: `cudaGraphExecUpdate()`_
+
+        .. _cudaGraphExecUpdate():
+            https://docs.nvidia.com/cuda/cuda-runtime-api/group__CUDART__GRAPH.html#group__CUDART__GRAPH_1g96efefc56df46927da7297f122adfb9f
+
+        """
+        cdef _GraphMemory memory
+        cdef int result
+        self._instantiate()
+        result = runtime.graphExecUpdate(self.graphExec, graph.graph)
+        if result != runtime.cudaGraphExecUpdateSuccess:
+            return False
+        # the executable graph now uses the memory captured for `graph`
+        memory = self._memory
+        self._memory = graph._memory
+        graph._memory = memory
+        return True
+
     cpdef debug_dot_str(self, flags=0):
         """Make DOT formatted string of CUDA graph definition for debugging.
 
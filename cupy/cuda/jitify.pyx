@@ -2,14 +2,16 @@
 
 """Wrapper of Jitify utilities for CuPy API."""
 
+from cython.operator cimport dereference as deref
 from libcpp cimport nullptr
 from libcpp.map cimport map as cpp_map
 from libcpp.string cimport string as cpp_str
 from libcpp.vector cimport vector
 
-import json
+import mmap
 import os
 import re
+import struct
 import tempfile
 import warnings
 
@@ -59,6 +61,11 @@ def get_build_version():
     return jitify_ver.decode()
 
 
+cpdef str get_cupy_cache_key():
+    # the hash of the CuPy headers, set at build time
+    return cupy_cache_key.decode()
+
+
 cpdef str get_cuda_version():
     # Read CUDART version from header if it exists, otherwise use NVRTC version
     # as a proxy.
@@ -92,9 +99,15 @@ cdef cpp_map[cpp_str, cpp_str] cupy_headers
 
 # Module-level constants
 cdef bint _jitify_init = False
+cdef bint _jitify_cache_enabled = True
 cdef str _jitify_cache_dir = None
 cdef str _jitify_cache_versions = None
 
+# The on-disk caches are flat lists of byte strings, each prefixed with its
+# length. They are read through mmap, so that the processes of a node that
+# start at the same time share the pages instead of parsing their own copy.
+cdef bytes _cache_magic = b'CUPYJTF1'
+
 
 cpdef _add_sources(dict sources, bint is_str=False):
     cdef str k, v
@@ -107,28 +120,56 @@ cpdef _add_sources(dict sources, bint is_str=False):
             cupy_headers[hdr_name] = hdr_source
 
 
-cdef inline void dump_cache(cpp_map[cpp_str, cpp_str]& cupy_headers) except*:
+cdef inline void _write_records(str path, list records) except*:
     # Ensure the directory exists
     os.makedirs(_jitify_cache_dir, exist_ok=True)
 
-    # Construct a temporary Python dict for serialization
-    cdef dict data = {}
-    cdef bytes k, v
-    for it in cupy_headers:
-        k = it.first
-        v = it.second
-        data[k.decode()] = v.decode()
-
     # Set up a temporary file; it must be under the cache directory so
     # that atomic moves within the same filesystem can be guaranteed
+    cdef bytes r
     with tempfile.NamedTemporaryFile(
-            mode='w', dir=_jitify_cache_dir, delete=False) as f:
-        json.dump(data, f)
+            mode='wb', dir=_jitify_cache_dir, delete=False) as f:
+        f.write(_cache_magic)
+        f.write(struct.pack('<Q', len(records)))
+        for r in records:
+            f.write(struct.pack('<Q', len(r)))
+            f.write(r)
         f_name = f.name
 
     # atomic move with the destination guaranteed to be overwritten
-    os.replace(f_name,
-               f'{_jitify_cache_dir}/jitify_{_jitify_cache_versions}.json')
+    os.replace(f_name, path)
+
+
+cdef inline list _read_records(str path):
+    # Raises if the file is missing or corrupted.
+    cdef list records = []
+    cdef Py_ssize_t offset, size, count, i
+    with open(path, 'rb') as f, \
+            mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as m:
+        if m[:8] != _cache_magic:
+            raise ValueError(f'invalid Jitify cache: {path}')
+        count = struct.unpack_from('<Q', m, 8)[0]
+        offset = 16
+        for i in range(count):
+            size = struct.unpack_from('<Q', m, offset)[0]
+            offset += 8
+            if offset + size > len(m):
+                raise ValueError(f'truncated Jitify cache: {path}')
+            records.append(m[offset:offset + size])
+            offset += size
+    return records
+
+
+cdef inline str _headers_cache_path():
+    return f'{_jitify_cache_dir}/jitify_{_jitify_cache_versions}.bin'
+
+
+cdef inline void dump_cache(cpp_map[cpp_str, cpp_str]& cupy_headers) except*:
+    cdef list records = []
+    for it in cupy_headers:
+        records.append(it.first)
+        records.append(it.second)
+    _write_records(_headers_cache_path(), records)
 
 
 # This kernel simply includes commonly used headers in CuPy's codebase
@@ -156,14 +197,10 @@ cdef inline void _init_cupy_headers_from_cache() except*:
     assert _jitify_cache_versions is not None
 
     # Attempt to load from the disk/persistent cache
-    cdef dict data
-    with open(
-            f'{_jitify_cache_dir}/jitify_{_jitify_cache_versions}.json',
-            'r') as f:
-        data = json.load(f)
+    cdef list records = _read_records(_headers_cache_path())
 
     # Populate the cache (cupy_headers)
-    _add_sources(data, is_str=True)
+    _add_sources(dict(zip(records[0::2], records[1::2])))
 
     global _jitify_init
     _jitify_init = True
@@ -207,7 +244,10 @@ cdef inline void _init_cupy_headers_from_scratch() except*:
 
 
 cdef inline void _init_cupy_headers() except*:
-    if int(os.getenv('CUPY_DISABLE_JITIFY_CACHE', '0')) == 0:
+    global _jitify_cache_enabled
+    _jitify_cache_enabled = (
+        int(os.getenv('CUPY_DISABLE_JITIFY_CACHE', '0')) == 0)
+    if _jitify_cache_enabled:
         try:
             _init_cupy_headers_from_cache()
         except Exception:
@@ -244,10 +284,44 @@ cpdef void _init_module() except*:
     _init_cupy_headers()
 
 
+cdef inline str _program_cache_path(str code, tuple opt):
+    # avoid circular dependency
+    from cupy.cuda.compiler import _hash_hexdigest
+    key = _hash_hexdigest('\0'.join((code,) + opt).encode())
+    return f'{_jitify_cache_dir}/jitify_{_jitify_cache_versions}_{key}.bin'
+
+
+cdef inline tuple _load_program_from_cache(str path):
+    # The records are the program name, the options, and the pairs of
+    # headers that were not in cupy_headers when the program was resolved.
+    cdef list records
+    try:
+        records = _read_records(path)
+    except Exception:
+        return None
+    if len(records) < 2 or len(records) % 2 != 0:
+        return None
+    _add_sources(dict(zip(records[2::2], records[3::2])))
+
+    cdef list hdr_codes = []
+    cdef list hdr_names = []
+    cdef bytes k, v
+    for itr in cupy_headers:
+        k = itr.first
+        v = itr.second
+        hdr_codes.append(v)
+        hdr_names.append(k)
+    cdef bytes opts = records[1]
+    return (records[0].decode(),
+            tuple(o.decode() for o in opts.split(b'\0')) if opts else (),
+            hdr_codes, hdr_names)
+
+
 # Use Jitify's internal mechanism to search all included headers, and return
 # the modified options and the header mapping (as two lists). This roughly
 # follows the constructor of jitify::Program(). The found headers are cached
-# to accelerate Jitify's search loop.
+# to accelerate Jitify's search loop; the result for each program is also
+# cached on disk, so that other processes can skip the search.
 cpdef jitify(str code, tuple opt):
     # input
     cdef cpp_str cuda_source
@@ -267,6 +341,16 @@ cpdef jitify(str code, tuple opt):
     cdef str s
     cdef bytes k, v
 
+    cdef str cache_path = None
+    cdef tuple cached
+    cdef list new_records = []
+    cdef cpp_map[cpp_str, cpp_str].iterator found
+    if _jitify_init and _jitify_cache_enabled:
+        cache_path = _program_cache_path(code, opt)
+        cached = _load_program_from_cache(cache_path)
+        if cached is not None:
+            return cached
+
     cuda_source = code.encode()
     _options = [s.encode() for s in opt]
 
@@ -290,6 +374,19 @@ cpdef jitify(str code, tuple opt):
         v = itr.second
         hdr_codes.append(v)
         hdr_names.append(k)
+        if cache_path is not None:
+            found = cupy_headers.find(k)
+            if (found == cupy_headers.end()
+                    or <bytes>deref(found).second != v):
+                new_records.append(k)
+                new_records.append(v)
         cupy_headers[k] = v
 
+    if cache_path is not None:
+        try:
+            _write_records(cache_path, [
+                _name, '\0'.join(new_opt).encode()] + new_records)
+        except OSError:
+            pass  # the cache is best-effort
+
     return _name.decode(), tuple(new_opt), hdr_codes, hdr_names
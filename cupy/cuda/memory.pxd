@@ -49,6 +49,8 @@ cdef class MemoryPointer:
 
 
 cpdef MemoryPointer alloc(size)
+cdef intptr_t _get_stream_identifier(intptr_t stream_ptr)
+cpdef _register_release_callback(func)
 
 
 cpdef set_allocator(allocator=*)
@@ -62,6 +64,10 @@ cdef class MemoryPool:
 
     cpdef MemoryPointer malloc(self, size_t size)
     cpdef free_all_blocks(self, stream=?)
+    cpdef trim(self, stream=?)
+    cpdef set_arena_policy(self, policy)
+    cpdef set_capture_policy(self, policy)
+    cpdef dict get_fragmentation_info(self)
     cpdef free_all_free(self)
     cpdef size_t n_free_blocks(self)
     cpdef size_t used_bytes(self)
@@ -69,6 +75,7 @@ cdef class MemoryPool:
     cpdef size_t total_bytes(self)
     cpdef set_limit(self, size=?, fraction=?)
     cpdef size_t get_limit(self)
+    cpdef set_slab_threshold(self, size_t size)
 
 
 @cython.no_gc
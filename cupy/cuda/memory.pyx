@@ -4,6 +4,7 @@ cimport cython  # NOQA
 
 import atexit
 import collections
+import functools
 import gc
 import os
 import threading
@@ -19,11 +20,13 @@ from libc.stdlib cimport free as c_free
 from libcpp cimport algorithm
 
 from cupy.cuda cimport device
+from cupy.cuda cimport graph
 from cupy.cuda cimport memory_hook
 from cupy.cuda cimport stream as stream_module
 from cupy_backends.cuda.api cimport driver
 from cupy_backends.cuda.api cimport runtime
 
+from cupy_backends.cuda.api.driver import CUDADriverError
 from cupy_backends.cuda.api.runtime import CUDARuntimeError
 from cupy import _util
 
@@ -264,6 +267,113 @@ cdef class ManagedMemory(BaseMemory):
 
 
 @cython.no_gc
+cdef inline size_t _round_up(size_t size, size_t unit):
+    return (size + unit - 1) // unit * unit
+
+
+cdef class VirtualMemory(BaseMemory):
+    """Memory allocation on a CUDA device with the virtual memory API.
+
+    A range of virtual addresses is reserved once, and physical memory is
+    mapped to its head on demand. The mapped part can be grown or shrunk in
+    place with :meth:`resize`, without moving or copying the buffer.
+
+    Args:
+        size (int): Size of the memory allocation in bytes.
+        reserve (int): Size of the range of virtual addresses to reserve in
+            bytes, which is the largest size it can be resized to. The
+            default reserves ``size`` bytes.
+
+    Attributes:
+        reserved_size (int): Size of the reserved range in bytes.
+        granularity (int): The physical memory is mapped in multiples of
+            this size.
+    """
+
+    cdef:
+        readonly size_t reserved_size
+        readonly size_t granularity
+        # (offset, size, handle) of each mapping of physical memory, in the
+        # order of addresses
+        list _mappings
+
+    def __init__(self, size_t size, size_t reserve=0):
+        self.size = 0
+        self.device_id = device.get_device_id()
+        self.ptr = 0
+        self._mappings = []
+        reserve = max(reserve, size)
+        if reserve == 0:
+            return
+        self.granularity = driver.memGetAllocationGranularity(
+            self.device_id, driver.CU_MEM_ALLOC_GRANULARITY_RECOMMENDED)
+        self.reserved_size = _round_up(reserve, self.granularity)
+        self.ptr = driver.memAddressReserve(self.reserved_size, 0)
+        self.resize(size)
+
+    cdef size_t _mapped_size(self):
+        if not self._mappings:
+            return 0
+        offset, size, _ = self._mappings[-1]
+        return offset + size
+
+    cpdef resize(self, size_t size):
+        """Grows or shrinks the allocation in place.
+
+        Growing maps new physical memory after the current one, and
+        shrinking unmaps the physical memory that is no longer used. The
+        address of the allocation does not change.
+
+        Args:
+            size (int): New size of the allocation in bytes, up to
+                :attr:`reserved_size`.
+        """
+        cdef size_t mapped = self._mapped_size()
+        cdef size_t new_mapped, n
+        cdef unsigned long long handle
+        if size > self.reserved_size:
+            raise ValueError(
+                'cannot resize beyond the reserved size: {} > {}'.format(
+                    size, self.reserved_size))
+        new_mapped = _round_up(size, self.granularity) if size else 0
+        if new_mapped > mapped:
+            n = new_mapped - mapped
+            try:
+                handle = driver.memCreate(n, self.device_id)
+            except CUDADriverError as e:
+                if e.status != driver.CUDA_ERROR_OUT_OF_MEMORY:
+                    raise
+                # so that the memory pool frees its cached blocks and retries
+                raise CUDARuntimeError(runtime.errorMemoryAllocation)
+            try:
+                driver.memMap(self.ptr + mapped, n, 0, handle)
+            except Exception:
+                driver.memRelease(handle)
+                raise
+            self._mappings.append((mapped, n, handle))
+            driver.memSetAccess(self.ptr + mapped, n, self.device_id)
+        elif new_mapped < mapped:
+            # the memory may still be used by the work in flight
+            runtime.deviceSynchronize()
+            self._unmap(new_mapped)
+        self.size = size
+
+    cdef _unmap(self, size_t size):
+        # Unmaps the mappings that start at `size` or later.
+        while self._mappings and self._mappings[-1][0] >= size:
+            offset, n, handle = self._mappings.pop()
+            driver.memUnmap(self.ptr + <size_t>offset, n)
+            driver.memRelease(handle)
+
+    def __dealloc__(self):
+        # Note: Cannot raise in the destructor! (cython/cython#1613)
+        if self.ptr:
+            if self._mappings:
+                runtime.deviceSynchronize()
+                self._unmap(0)
+            driver.memAddressFree(self.ptr, self.reserved_size)
+
+
 cdef class SystemMemory(BaseMemory):
     """Memory allocation on an HMM/ATS enabled system.
 
@@ -778,6 +888,29 @@ cpdef MemoryPointer malloc_managed(size_t size):
     return MemoryPointer(mem, 0)
 
 
+cpdef MemoryPointer malloc_virtual(size_t size):
+    """Allocate memory with the virtual memory API.
+
+    This method can be used as a CuPy memory allocator, also for a memory
+    pool::
+
+        set_allocator(MemoryPool(malloc_virtual).malloc)
+
+    The physical memory is mapped in multiples of the allocation granularity
+    of the device (2 MiB on most GPUs), and is returned to the device as
+    soon as the allocation is freed. To grow a buffer in place, use
+    :class:`VirtualMemory` with a larger ``reserve``.
+
+    Args:
+        size (int): Size of the memory allocation in bytes.
+
+    Returns:
+        ~cupy.cuda.MemoryPointer: Pointer to the allocated buffer.
+    """
+    mem = VirtualMemory(size)
+    return MemoryPointer(mem, 0)
+
+
 cpdef MemoryPointer malloc_system(size_t size):
     """Allocate memory on an HMM/ATS enabled system.
 
@@ -827,7 +960,7 @@ def _set_thread_local_allocator(allocator):
     _thread_local.allocator = allocator
 
 
-cdef inline intptr_t _get_stream_identifier(intptr_t stream_ptr):
+cdef intptr_t _get_stream_identifier(intptr_t stream_ptr):
     # When PTDS is enabled, return an ID to uniquely identify the default
     # stream for each thread. (#5069)
     if stream_ptr != runtime.streamPerThread:
@@ -842,6 +975,22 @@ cdef inline intptr_t _get_stream_identifier(intptr_t stream_ptr):
     return -tid
 
 
+# Callbacks releasing the memory cached outside the pool, e.g. the workspace
+# arenas of Thrust. They are called by `free_all_blocks` with the device ID
+# and the stream identifier (None for all the streams) before the free blocks
+# are released, so that the cached buffers are returned to the pool first.
+cdef list _release_callbacks = []
+
+
+cpdef _register_release_callback(func):
+    _release_callbacks.append(func)
+
+
+cdef _release_cached(int device_id, stream_ident):
+    for func in _release_callbacks:
+        func(device_id, stream_ident)
+
+
 cpdef MemoryPointer alloc(size):
     """Calls the current allocator.
 
@@ -936,6 +1085,8 @@ cdef class PooledMemory(BaseMemory):
             self.identity = "ManagedMemory"
             self.prefetch = <ManagedMemory>(chunk.mem).prefetch
             self.advise = <ManagedMemory>(chunk.mem).advise
+        elif isinstance(chunk.mem, VirtualMemory):
+            self.identity = "VirtualMemory"
         elif isinstance(chunk.mem, CFunctionAllocatorMemory):
             self.identity = "CFunctionAllocatorMemory"
         elif isinstance(chunk.mem, PythonFunctionAllocatorMemory):
@@ -1003,6 +1154,60 @@ cpdef size_t _bin_index_from_size(size_t size):
     return (size - 1) // ALLOCATION_UNIT_SIZE
 
 
+# Allocations of at most this size are served from slabs; 0 disables them.
+cdef size_t _default_slab_threshold = _round_size(
+    int(os.environ.get('CUPY_POOL_SLAB_THRESHOLD', '0')))
+# The size of a slab taken from the pool, and its minimum number of slots.
+cdef size_t _slab_size = 1024 * 1024
+cdef size_t _min_slab_slots = 8
+
+
+@cython.final
+cdef class _Slab:
+
+    """An allocation from the pool, divided into slots of the same size.
+
+    The free slots are kept in ``free_slots``; while there is any, the slab
+    is in ``partial``, the list of slabs of its size class and stream.
+    These are only changed while holding the GIL without calling back into
+    Python, so that they do not need the locks of the pool.
+    """
+
+    cdef:
+        MemoryPointer memptr
+        size_t slot_size
+        size_t n_slots
+        list partial
+        vector.vector[intptr_t] free_slots
+
+
+@cython.final
+@cython.no_gc
+cdef class _SlabMemory(BaseMemory):
+
+    """A slot of a slab, allocated by the slab tier of a memory pool."""
+
+    cdef:
+        _Slab _slab
+        object _pool
+
+    cpdef free(self):
+        """Returns the slot to its slab for reuse."""
+        cdef intptr_t ptr = self.ptr
+        if ptr == 0:
+            return
+        self.ptr = 0
+        pool = self._pool()
+        if pool is None:
+            return
+        (<SingleDeviceMemoryPool>pool)._free_slot(self._slab, ptr)
+
+    def __dealloc__(self):
+        if _exit_mode:
+            return  # To avoid error at exit
+        self.free()
+
+
 cdef _gc_isenabled = gc.isenabled
 cdef _gc_disable = gc.disable
 cdef _gc_enable = gc.enable
@@ -1062,9 +1267,13 @@ cdef class _Arena:
         vector.vector[size_t] _index
         # `_free_lock` must be acquired to access it.
         vector.vector[int8_t] _flag
+        # Bins requested since the last trim.
+        # `_free_lock` must be acquired to access it.
+        set _hot
 
     def __init__(self):
         self._free = []
+        self._hot = set()
 
     cdef append_to_free_list(self, _Chunk chunk):
         # need self._free_lock
@@ -1177,17 +1386,40 @@ cdef class SingleDeviceMemoryPool:
         object _total_bytes_lock
         readonly int _device_id
 
+        # Map from stream identifier to the list of partial slabs of each
+        # size class; see `_Slab`.
+        dict _slabs
+        size_t _slab_threshold
+        # Bytes of the slabs, and of their slots in use.
+        size_t _slab_total_bytes
+        size_t _slab_used_bytes
+
+        # Whether a miss may take a free block from the arena of another
+        # stream before allocating a new one.
+        bint _best_fit_across_arenas
+
+        # Whether the allocations during a capture are owned by the graph;
+        # see `set_capture_policy`.
+        bint _graph_safe
+        # Map from the identifier of the arena of each graph (the id of its
+        # `_GraphMemory`) to the identifier of the captured stream.
+        # `_free_lock` must be acquired to access it.
+        dict _graph_arenas
+
     def __init__(self, allocator=None):
         if allocator is None:
             allocator = _malloc
         self._in_use = {}
         self._arenas = {}
+        self._graph_arenas = {}
         self._allocator = allocator
         self._weakref = weakref.ref(self)
         self._device_id = device.get_device_id()
         self._free_lock = rlock.create_fastrlock()
         self._in_use_lock = rlock.create_fastrlock()
         self._total_bytes_lock = rlock.create_fastrlock()
+        self._slabs = {}
+        self._slab_threshold = _default_slab_threshold
 
         self.set_limit(**(_parse_limit_string()))
 
@@ -1223,8 +1455,61 @@ cdef class SingleDeviceMemoryPool:
                 return memptr
         return self._allocator(rounded_size)
 
+    cdef bint _in_graph_capture(self):
+        return self._graph_safe and graph._get_capture_memory(
+            stream_module.get_current_stream_ptr()) is not None
+
+    cdef intptr_t _graph_arena(
+            self, graph._GraphMemory memory, intptr_t stream_ident):
+        # Returns the identifier of the arena of the graph being captured,
+        # which keeps the blocks freed during the capture for reuse by the
+        # graph only.
+        cdef intptr_t ident = id(memory)
+        cdef bint is_new
+        with LockAndNoGc(self._free_lock):
+            is_new = ident not in self._graph_arenas
+            if is_new:
+                self._graph_arenas[ident] = stream_ident
+        if is_new:
+            memory.add_releaser(functools.partial(
+                _release_graph_arena, self._weakref, ident))
+        return ident
+
+    cdef _release_graph_arena(self, intptr_t ident):
+        # Moves the blocks of the arena of a destroyed graph to the arena of
+        # the captured stream. The blocks still in use are freed there.
+        cdef _Chunk chunk
+        cdef _Arena arena, target
+        cdef set free_list
+        cdef intptr_t stream_ident
+        with LockAndNoGc(self._free_lock):
+            if ident not in self._graph_arenas:
+                return
+            stream_ident = self._graph_arenas.pop(ident)
+            rlock.lock_fastrlock(self._in_use_lock, -1, True)
+            try:
+                for chunk in self._in_use.itervalues():
+                    if chunk.stream_ident == ident:
+                        chunk.stream_ident = stream_ident
+            finally:
+                rlock.unlock_fastrlock(self._in_use_lock)
+            arena = self._arenas.pop(ident, None)
+            if arena is None:
+                return
+            target = self._arena(stream_ident)
+            for free_list in arena._free:
+                if not free_list:
+                    continue
+                for chunk in free_list:
+                    chunk.stream_ident = stream_ident
+                    target.append_to_free_list(chunk)
+
     cpdef MemoryPointer malloc(self, size_t size):
         rounded_size = _round_size(size)
+        if (0 < rounded_size <= self._slab_threshold
+                and not memory_hook._has_memory_hooks()
+                and not self._in_graph_capture()):
+            return self._slab_malloc(rounded_size)
         if memory_hook._has_memory_hooks():
             hooks = memory_hook.get_memory_hooks()
             if hooks:
@@ -1257,11 +1542,17 @@ cdef class SingleDeviceMemoryPool:
         cdef BaseMemory mem
         cdef PooledMemory pmem
         cdef MemoryPointer ret
+        cdef graph._GraphMemory capture = None
+        cdef intptr_t stream_ptr
         if size == 0:
             return MemoryPointer(Memory(0), 0)
 
-        stream_ident = _get_stream_identifier(
-            stream_module.get_current_stream_ptr())
+        stream_ptr = stream_module.get_current_stream_ptr()
+        stream_ident = _get_stream_identifier(stream_ptr)
+        if self._graph_safe:
+            capture = graph._get_capture_memory(stream_ptr)
+            if capture is not None:
+                stream_ident = self._graph_arena(capture, stream_ident)
 
         # find best-fit, or a smallest larger allocation
         gc_mode = _lock_no_gc(self._free_lock)
@@ -1270,6 +1561,10 @@ cdef class SingleDeviceMemoryPool:
         finally:
             _unlock_no_gc(self._free_lock, gc_mode)
 
+        if (chunk is None and self._best_fit_across_arenas
+                and capture is None):
+            chunk = self._take_chunk_from_other_arenas(size, stream_ident)
+
         if chunk is None:
             mem = self._try_malloc(size)
             chunk = _Chunk.__new__(_Chunk)
@@ -1287,6 +1582,104 @@ cdef class SingleDeviceMemoryPool:
         ret._init(pmem, 0)
         return ret
 
+    cdef MemoryPointer _slab_malloc(self, size_t size):
+        cdef _Slab slab
+        cdef _SlabMemory mem
+        cdef MemoryPointer ret
+        cdef list classes, partial
+        cdef size_t index = size // ALLOCATION_UNIT_SIZE - 1
+        cdef intptr_t ptr
+
+        stream_ident = _get_stream_identifier(
+            stream_module.get_current_stream_ptr())
+        classes = self._slabs.get(stream_ident)
+        if classes is None:
+            self._slabs[stream_ident] = classes = []
+        while len(classes) <= index:
+            classes.append([])
+        partial = classes[index]
+        if len(partial) == 0:
+            self._new_slab(size, partial)
+
+        # Takes the slot before creating any object, as the GC may free
+        # other slots in between.
+        slab = partial[-1]
+        ptr = slab.free_slots.back()
+        slab.free_slots.pop_back()
+        if slab.free_slots.empty():
+            partial.pop()
+        self._slab_used_bytes += size
+
+        mem = _SlabMemory.__new__(_SlabMemory)
+        mem.ptr = ptr
+        mem.size = size
+        mem.device_id = self._device_id
+        mem._slab = slab
+        mem._pool = self._weakref
+        ret = MemoryPointer.__new__(MemoryPointer)
+        ret._init(mem, 0)
+        return ret
+
+    cdef _new_slab(self, size_t size, list partial):
+        cdef _Slab slab
+        cdef size_t i, n_slots
+        n_slots = max(_min_slab_slots, _slab_size // size)
+        slab = _Slab.__new__(_Slab)
+        slab.memptr = self._malloc(size * n_slots)
+        slab.slot_size = size
+        slab.n_slots = n_slots
+        slab.partial = partial
+        # in reverse, so that the slots are taken in the order of addresses
+        for i in range(n_slots):
+            slab.free_slots.push_back(
+                slab.memptr.ptr + <intptr_t>((n_slots - 1 - i) * size))
+        self._slab_total_bytes += size * n_slots
+        partial.append(slab)
+
+    cdef _free_slot(self, _Slab slab, intptr_t ptr):
+        if slab.free_slots.empty():
+            slab.partial.append(slab)
+        slab.free_slots.push_back(ptr)
+        self._slab_used_bytes -= slab.slot_size
+
+    cdef list _release_slabs(self, stream=None):
+        # Removes the slabs without slots in use, and returns their memory
+        # to be freed by the caller.
+        cdef _Slab slab
+        cdef list released = [], partial, kept
+        if stream is None:
+            streams = list(self._slabs.values())
+        else:
+            classes = self._slabs.get(_get_stream_identifier(stream.ptr))
+            streams = [] if classes is None else [classes]
+        for classes in streams:
+            for partial in classes:
+                kept = []
+                for slab in partial:
+                    if slab.free_slots.size() == slab.n_slots:
+                        released.append(slab.memptr)
+                        slab.memptr = None
+                        self._slab_total_bytes -= (
+                            slab.slot_size * slab.n_slots)
+                    else:
+                        kept.append(slab)
+                partial[:] = kept
+        return released
+
+    cpdef set_slab_threshold(self, size_t size):
+        """Sets the largest size of the allocations served from slabs.
+
+        The allocations of at most ``size`` bytes are carved out of slabs,
+        which are large blocks taken from this pool and divided into slots
+        of the same rounded size for each stream. This skips the splitting
+        and merging of blocks and the locks of the pool for small
+        allocations. ``0`` disables the slabs.
+
+        The slabs already taken are kept, and released by
+        :meth:`free_all_blocks` once none of their slots is used.
+        """
+        self._slab_threshold = _round_size(size)
+
     cpdef free(self, intptr_t ptr, size_t size):
         cdef _Chunk chunk, c
 
@@ -1297,11 +1690,12 @@ cdef class SingleDeviceMemoryPool:
             raise RuntimeError('Cannot free out-of-pool memory')
         finally:
             rlock.unlock_fastrlock(self._in_use_lock)
-        stream_ident = chunk.stream_ident
 
         gc_mode = _lock_no_gc(self._free_lock)
         try:
-            arena = self._arena(stream_ident)
+            # read under the lock, as the chunk is moved to another arena
+            # when the graph that owns it is destroyed
+            arena = self._arena(chunk.stream_ident)
 
             c = chunk.next
             if c is not None and arena.remove_from_free_list(c):
@@ -1320,14 +1714,94 @@ cdef class SingleDeviceMemoryPool:
         """Free all **non-split** chunks"""
         cdef intptr_t stream_ident
 
+        _release_cached(
+            self._device_id,
+            None if stream is None else _get_stream_identifier(stream.ptr))
+        # returns the empty slabs to the pool before compacting it
+        released = self._release_slabs(stream)
+        del released
         with LockAndNoGc(self._free_lock):
-            # free blocks in all arenas
+            # free blocks in all arenas, except the blocks owned by graphs
             if stream is None:
                 for stream_ident in list(self._arenas.iterkeys()):
-                    self._compact_index(stream_ident, True)
+                    if stream_ident not in self._graph_arenas:
+                        self._compact_index(stream_ident, True)
             else:
                 self._compact_index(_get_stream_identifier(stream.ptr), True)
 
+    cpdef trim(self, stream=None):
+        """Free the **non-split** chunks of the bins not used since the last
+        trim"""
+        cdef intptr_t stream_ident
+        cdef _Arena arena
+        cdef set hot
+
+        released = self._release_slabs(stream)
+        del released
+        with LockAndNoGc(self._free_lock):
+            if stream is None:
+                stream_idents = [
+                    ident for ident in self._arenas.iterkeys()
+                    if ident not in self._graph_arenas]
+            else:
+                stream_idents = [_get_stream_identifier(stream.ptr)]
+            for stream_ident in stream_idents:
+                arena = self._arenas.get(stream_ident)
+                if arena is None:
+                    continue
+                hot = arena._hot
+                arena._hot = set()
+                self._compact_index(stream_ident, True, hot)
+
+    cpdef set_arena_policy(self, policy):
+        if policy == 'per_stream':
+            self._best_fit_across_arenas = False
+        elif policy == 'best_fit':
+            self._best_fit_across_arenas = True
+        else:
+            raise ValueError('unknown arena policy: {}'.format(policy))
+
+    cpdef set_capture_policy(self, policy):
+        if policy == 'shared':
+            self._graph_safe = False
+        elif policy == 'per_graph':
+            self._graph_safe = True
+        else:
+            raise ValueError('unknown capture policy: {}'.format(policy))
+
+    cpdef dict get_fragmentation_info(self):
+        cdef dict info = {}, histogram
+        cdef set free_list
+        cdef _Chunk chunk
+        cdef _Arena arena
+        cdef size_t index, size, n, free_bytes, largest, releasable
+        rlock.lock_fastrlock(self._free_lock, -1, True)
+        try:
+            for stream_ident, arena in self._arenas.iteritems():
+                histogram = {}
+                n = free_bytes = largest = releasable = 0
+                for index, free_list in enumerate(arena._free):
+                    if not free_list:
+                        continue
+                    size = (arena._index.at(index) + 1) * ALLOCATION_UNIT_SIZE
+                    histogram[size] = len(free_list)
+                    n += len(free_list)
+                    free_bytes += size * len(free_list)
+                    largest = max(largest, size)
+                    for chunk in free_list:
+                        if chunk.prev is None and chunk.next is None:
+                            releasable += size
+                info[stream_ident] = {
+                    'n_free_blocks': n,
+                    'free_bytes': free_bytes,
+                    'largest_free_block': largest,
+                    'releasable_bytes': releasable,
+                    'histogram': histogram,
+                }
+        finally:
+            rlock.unlock_fastrlock(self._free_lock)
+        return info
+
     cpdef free_all_free(self):
         warnings.warn(
             'free_all_free is deprecated. Use free_all_blocks instead.',
@@ -1356,7 +1830,8 @@ cdef class SingleDeviceMemoryPool:
                 size += chunk.size
         finally:
             rlock.unlock_fastrlock(self._in_use_lock)
-        return size
+        # the slabs are in use by the pool, but only their used slots count
+        return size - self._slab_total_bytes + self._slab_used_bytes
 
     cpdef size_t free_bytes(self):
         cdef size_t size = 0
@@ -1373,7 +1848,7 @@ cdef class SingleDeviceMemoryPool:
                         size += chunk.size
         finally:
             rlock.unlock_fastrlock(self._free_lock)
-        return size
+        return size + self._slab_total_bytes - self._slab_used_bytes
 
     cpdef size_t total_bytes(self):
         with LockAndNoGc(self._total_bytes_lock):
@@ -1407,8 +1882,11 @@ cdef class SingleDeviceMemoryPool:
         with LockAndNoGc(self._total_bytes_lock):
             return self._total_bytes_limit
 
-    cdef _compact_index(self, intptr_t stream_ident, bint free):
+    cdef _compact_index(self, intptr_t stream_ident, bint free,
+                        set keep=None):
         # need self._free_lock
+        # With `free`, the non-split chunks are freed except in the bins of
+        # `keep`.
         cdef _Arena arena
         cdef list new_free
         cdef set free_list, keep_list
@@ -1424,7 +1902,7 @@ cdef class SingleDeviceMemoryPool:
         for index, free_list in enumerate(arena._free):
             if not free_list:
                 continue
-            if free:
+            if free and (keep is None or arena._index.at(index) not in keep):
                 keep_list = set()
                 for chunk in free_list:
                     if chunk.prev is not None or chunk.next is not None:
@@ -1454,6 +1932,7 @@ cdef class SingleDeviceMemoryPool:
         cdef _Chunk chunk
         cdef size_t bin_index = _bin_index_from_size(size)
         cdef _Arena a = self._arena(stream_ident)
+        a._hot.add(bin_index)
         index = <size_t>(
             algorithm.lower_bound(a._index.begin(), a._index.end(), bin_index)
             - a._index.begin())
@@ -1475,6 +1954,54 @@ cdef class SingleDeviceMemoryPool:
             return chunk
         return None
 
+    cdef object _take_chunk_from_other_arenas(
+            self, size_t size, intptr_t stream_ident):
+        # Finds the smallest non-split free chunk that fits in the arenas of
+        # the other streams, and moves it to the arena of `stream_ident`.
+        cdef _Chunk chunk, best = None
+        cdef _Arena arena, best_arena = None
+        cdef set free_list
+        cdef size_t i, index, best_bin = 0
+        cdef size_t bin_index = _bin_index_from_size(size)
+        gc_mode = _lock_no_gc(self._free_lock)
+        try:
+            for ident, arena in self._arenas.iteritems():
+                if ident == stream_ident or ident in self._graph_arenas:
+                    continue
+                index = <size_t>(
+                    algorithm.lower_bound(
+                        arena._index.begin(), arena._index.end(), bin_index)
+                    - arena._index.begin())
+                for i in range(index, arena._index.size()):
+                    if best is not None and arena._index.at(i) >= best_bin:
+                        break
+                    if arena._flag.at(i) == 0:
+                        continue
+                    free_list = arena._free[i]
+                    for chunk in free_list:
+                        if chunk.prev is None and chunk.next is None:
+                            best = chunk
+                            best_arena = arena
+                            best_bin = arena._index.at(i)
+                            break
+                    if best_arena is arena:
+                        break
+            if best is None:
+                return None
+            best_arena.remove_from_free_list(best)
+            chunk = _Chunk.__new__(_Chunk)
+            chunk._init(best.mem, best.offset, best.size, stream_ident)
+            remaining = chunk.split(size)
+            if remaining is not None:
+                self._arena(stream_ident).append_to_free_list(remaining)
+        finally:
+            _unlock_no_gc(self._free_lock, gc_mode)
+        # The chunk may still be used by the work queued on the other stream,
+        # which may even have been destroyed; this is the synchronization
+        # that freeing it and allocating a new one would imply.
+        runtime.deviceSynchronize()
+        return chunk
+
     cdef BaseMemory _try_malloc(self, size_t size):
         cdef size_t limit
         cdef bint limit_ok
@@ -1524,6 +2051,12 @@ cdef class SingleDeviceMemoryPool:
         return mem
 
 
+def _release_graph_arena(pool_ref, intptr_t ident):
+    pool = pool_ref()
+    if pool is not None:
+        (<SingleDeviceMemoryPool>pool)._release_graph_arena(ident)
+
+
 cdef class MemoryPool:
 
     """Memory pool for all GPU devices on the host.
@@ -1597,6 +2130,79 @@ cdef class MemoryPool:
         mp = <SingleDeviceMemoryPool>self._pools[device.get_device_id()]
         mp.free_all_blocks(stream=stream)
 
+    cpdef trim(self, stream=None):
+        """Releases the free blocks of the sizes not requested recently.
+
+        Unlike :meth:`free_all_blocks`, the free blocks of the sizes that
+        were requested since the last call of this method are kept for
+        reuse, so that it can be called periodically, e.g. once per
+        iteration of a training loop, to return the memory that the
+        application stopped using.
+
+        Args:
+            stream (cupy.cuda.Stream): Release free blocks in the arena
+                of the given stream. The default releases blocks in all
+                arenas.
+        """
+        mp = <SingleDeviceMemoryPool>self._pools[device.get_device_id()]
+        mp.trim(stream=stream)
+
+    cpdef set_arena_policy(self, policy):
+        """Sets how the free blocks of the streams are shared.
+
+        The free blocks are kept in an arena for each stream, and are only
+        reused by allocations on the same stream. With ``'best_fit'``, an
+        allocation that finds no free block in its arena takes the smallest
+        fitting free block of the other arenas, which is not split, before
+        allocating a new one. This synchronizes the device, but avoids
+        releasing all the free blocks when the device memory is short.
+
+        Args:
+            policy (str): ``'per_stream'`` (default) or ``'best_fit'``.
+        """
+        mp = <SingleDeviceMemoryPool>self._pools[device.get_device_id()]
+        mp.set_arena_policy(policy)
+
+    cpdef set_capture_policy(self, policy):
+        """Sets how the blocks allocated during a stream capture are reused.
+
+        With ``'shared'``, the blocks freed during a capture by
+        :meth:`~cupy.cuda.Stream.begin_capture` return to the free blocks of
+        the captured stream, and may be handed out to other work while the
+        graph is alive, which then corrupts its replays. With
+        ``'per_graph'``, the blocks allocated during a capture on the
+        current stream are owned by the graph: the blocks freed during the
+        capture are only reused by the later allocations of the same
+        capture, and they return to the free blocks of the stream when the
+        :class:`~cupy.cuda.Graph` is destroyed. Such blocks are not released
+        by :meth:`free_all_blocks` or :meth:`trim` before that.
+
+        Args:
+            policy (str): ``'shared'`` (default) or ``'per_graph'``.
+
+        .. note::
+            The memory is reused on the captured stream once the graph is
+            destroyed, so the replays launched on other streams must be
+            complete by then. The allocations on other streams forked into
+            the capture are not tracked.
+        """
+        mp = <SingleDeviceMemoryPool>self._pools[device.get_device_id()]
+        mp.set_capture_policy(policy)
+
+    cpdef dict get_fragmentation_info(self):
+        """Reports the free blocks of each arena.
+
+        Returns:
+            dict: A dict from the identifier of each stream (its pointer) to
+            a dict of ``n_free_blocks``, ``free_bytes``,
+            ``largest_free_block``, ``releasable_bytes`` (the bytes of the
+            blocks that are not split, which :meth:`free_all_blocks` can
+            release) and ``histogram``, a dict from the sizes of the free
+            blocks to their count.
+        """
+        mp = <SingleDeviceMemoryPool>self._pools[device.get_device_id()]
+        return mp.get_fragmentation_info()
+
     cpdef free_all_free(self):
         """(Deprecated) Use :meth:`free_all_blocks` instead."""
         warnings.warn(
@@ -1679,6 +2285,124 @@ cdef class MemoryPool:
         mp = <SingleDeviceMemoryPool>self._pools[device.get_device_id()]
         return mp.get_limit()
 
+    cpdef set_slab_threshold(self, size_t size):
+        """Sets the largest size of the allocations served from slabs.
+
+        Small allocations are carved out of slabs, which are large blocks
+        taken from the pool and divided into slots of the same size, so that
+        they skip the splitting and merging of blocks. The slots are reused
+        within each stream like the other blocks, and are counted by
+        :meth:`used_bytes` and :meth:`free_bytes`.
+
+        .. note::
+            You can also set the threshold by using
+            ``CUPY_POOL_SLAB_THRESHOLD`` environment variable, see
+            :ref:`environment` for the details. This method only changes the
+            threshold for the current device.
+
+        Args:
+            size (int): The threshold in bytes. ``0`` disables the slabs.
+        """
+        mp = <SingleDeviceMemoryPool>self._pools[device.get_device_id()]
+        mp.set_slab_threshold(size)
+
+
+cdef class SystemMemoryAllocator:
+
+    """Memory pool of system memory placed for the GPU.
+
+    On systems where the GPU accesses the memory of the host, i.e. with HMM
+    or ATS such as MI300A and Grace Hopper, this allocator draws system
+    memory from a :class:`MemoryPool` of :func:`malloc_system`, and gives
+    the driver hints on its placement: each block allocated by the pool is
+    advised to be located on the GPU and to be accessed by the host, and
+    each allocation is prefetched to the GPU on the current stream, so that
+    the kernels writing a new array do not fault on its pages and the host
+    reads it without a migration.
+
+    Together with ``CUPY_ENABLE_UMP=1``, it makes the unified memory mode of
+    CuPy, where :meth:`~cupy.ndarray.get`, :func:`cupy.asnumpy` and
+    :func:`cupy.asarray` do not copy::
+
+        set_allocator(SystemMemoryAllocator().malloc)
+
+    Args:
+        prefetch (bool): If ``True``, each allocation is prefetched to the
+            current device on the current stream.
+        preferred_location (str): ``'device'`` or ``'host'``, the preferred
+            location of the blocks, or ``None`` to not advise it.
+        accessed_by_host (bool): If ``True``, the blocks are advised to be
+            accessed by the host, which keeps them mapped in the page table
+            of the host.
+
+    .. seealso:: :meth:`cupy.ndarray.host_view`
+    """
+
+    cdef:
+        readonly MemoryPool pool
+        readonly bint prefetch
+        readonly object preferred_location
+        readonly bint accessed_by_host
+        dict _concurrent_access  # device ID -> bool
+
+    def __init__(self, *, bint prefetch=True, preferred_location='device',
+                 bint accessed_by_host=True):
+        if preferred_location not in ('device', 'host', None):
+            raise ValueError(
+                'preferred_location must be \'device\', \'host\' or None')
+        self.prefetch = prefetch
+        self.preferred_location = preferred_location
+        self.accessed_by_host = accessed_by_host
+        self._concurrent_access = {}
+        self.pool = MemoryPool(self._malloc_block)
+
+    cdef bint _supports_concurrent_access(self, int device_id) except *:
+        supported = self._concurrent_access.get(device_id)
+        if supported is None:
+            if not runtime.deviceGetAttribute(
+                    runtime.cudaDevAttrPageableMemoryAccess, device_id):
+                raise RuntimeError(
+                    'device {} cannot access system memory, which requires '
+                    'HMM or ATS'.format(device_id))
+            supported = self._concurrent_access[device_id] = bool(
+                runtime.deviceGetAttribute(
+                    runtime.cudaDevAttrConcurrentManagedAccess, device_id))
+        return supported
+
+    def _malloc_block(self, size_t size):
+        cdef MemoryPointer memptr = malloc_system(size)
+        cdef int device_id = memptr.device_id
+        cdef int location
+        if size > 0 and self._supports_concurrent_access(device_id):
+            if self.preferred_location is not None:
+                location = (device_id if self.preferred_location == 'device'
+                            else runtime.cudaCpuDeviceId)
+                runtime.memAdvise(
+                    memptr.ptr, size,
+                    runtime.cudaMemAdviseSetPreferredLocation, location)
+            if self.accessed_by_host:
+                runtime.memAdvise(
+                    memptr.ptr, size, runtime.cudaMemAdviseSetAccessedBy,
+                    runtime.cudaCpuDeviceId)
+        return memptr
+
+    cpdef MemoryPointer malloc(self, size_t size):
+        """Allocates the memory, from the pool if possible.
+
+        Args:
+            size (int): Size of the memory buffer to allocate in bytes.
+
+        Returns:
+            ~cupy.cuda.MemoryPointer: Pointer to the allocated buffer.
+        """
+        cdef MemoryPointer memptr = self.pool.malloc(size)
+        if (self.prefetch and size > 0
+                and self._supports_concurrent_access(memptr.device_id)):
+            runtime.memPrefetchAsync(
+                memptr.ptr, size, memptr.device_id,
+                stream_module.get_current_stream_ptr())
+        return memptr
+
 
 cdef class MemoryAsyncPool:
     """(Experimental) CUDA memory pool for all GPU devices on the host.
@@ -1699,9 +2423,11 @@ cdef class MemoryAsyncPool:
     Args:
         pool_handles (str or int): A flag to indicate which mempool to use.
             `'default'` is for the device's default mempool, `'current'` is for
-            the current mempool (which could be the default one), and an `int`
-            that represents ``cudaMemPool_t`` created from elsewhere for an
-            external mempool. A list consisting of these flags can also be
+            the current mempool (which could be the default one), `'create'`
+            is for a new mempool that can be shared with other processes (see
+            :meth:`export_handle`), and an `int` that represents
+            ``cudaMemPool_t`` created from elsewhere for an external mempool.
+            A list consisting of these flags can also be
             accepted, in which case the list length must equal to the total
             number of visible devices so that the mempools for each device can
             be set independently.
@@ -1776,8 +2502,12 @@ cdef class MemoryAsyncPool:
             # Use the device's current pool
             pool = runtime.deviceGetMemPool(dev_id)
         elif handle == 'create':
-            # TODO(leofang): Support cudaMemPoolCreate
-            raise NotImplementedError('cudaMemPoolCreate is not yet supported')
+            # A pool that can be exported to other processes. It is never
+            # destroyed, as it stays the current pool of the device.
+            pool = runtime.memPoolCreate(runtime.MemPoolProps(
+                runtime.cudaMemAllocationTypePinned,
+                runtime.cudaMemHandleTypePosixFileDescriptor,
+                runtime.cudaMemLocationTypeDevice, dev_id))
         elif isinstance(handle, int):
             # Use an existing pool (likely from other applications?)
             pool = <intptr_t>(handle)
@@ -1785,6 +2515,7 @@ cdef class MemoryAsyncPool:
             raise ValueError("handle must be "
                              "'default' (for the device's default pool), "
                              "'current' (for the device's current pool), "
+                             "'create' (for a new exportable pool), "
                              "or int (a pointer to cudaMemPool_t)")
         runtime.deviceSetMemPool(dev_id, pool)
         return pool
@@ -1866,6 +2597,8 @@ cdef class MemoryAsyncPool:
         # https://github.com/cupy/cupy/issues/3777#issuecomment-758890450
         if stream is None:
             stream = stream_module.get_current_stream()
+        _release_cached(
+            device.get_device_id(), _get_stream_identifier(stream.ptr))
         stream.synchronize()
         cdef intptr_t pool = self._pools[device.get_device_id()]
         # We don't care the actual limit; putting 0 here means we guarantee
@@ -1986,6 +2719,110 @@ cdef class MemoryAsyncPool:
         return runtime.memPoolGetAttribute(
             pool, runtime.cudaMemPoolAttrReleaseThreshold)
 
+    cpdef int export_handle(self) except? -1:
+        """Exports the pool of the current device to other processes.
+
+        The pool must have been created with ``'create'``. The returned file
+        descriptor is passed to the other process, e.g. by ``SCM_RIGHTS`` on
+        a Unix domain socket, where it is opened by
+        :class:`ImportedMemoryAsyncPool`. The caller owns the descriptor and
+        should close it once it has been sent.
+
+        Returns:
+            int: A POSIX file descriptor of the pool.
+        """
+        cdef intptr_t pool = self._pools[device.get_device_id()]
+        return runtime.memPoolExportToShareableHandle(
+            pool, runtime.cudaMemHandleTypePosixFileDescriptor)
+
+    cpdef bytes export_pointer(self, MemoryPointer memptr):
+        """Exports an allocation of this pool to other processes.
+
+        The whole allocation that ``memptr`` points into is shared. Its data
+        can be read by the other process only after the work that writes it
+        has completed, and it must not be freed here before the other process
+        has freed its import; both are up to the caller to ensure, e.g. with
+        an interprocess event.
+
+        Args:
+            memptr (~cupy.cuda.MemoryPointer): A pointer returned by
+                :meth:`malloc`.
+
+        Returns:
+            bytes: The 64 bytes to pass to
+            :meth:`ImportedMemoryAsyncPool.import_pointer`.
+        """
+        if not isinstance(memptr.mem, MemoryAsync):
+            raise ValueError('memptr is not allocated by MemoryAsyncPool')
+        return runtime.memPoolExportPointer(memptr.mem.ptr)
+
+
+cdef class _ImportedMemoryAsync(BaseMemory):
+    """An allocation imported from a pool of another process."""
+
+    cdef:
+        readonly object pool
+
+    def __init__(self, pool, intptr_t ptr, size_t size):
+        self.pool = pool
+        self.ptr = ptr
+        self.size = size
+        self.device_id = pool.device_id
+
+    def __dealloc__(self):
+        if self.ptr:
+            runtime.freeAsync(
+                self.ptr, stream_module.get_current_stream_ptr())
+
+
+cdef class ImportedMemoryAsyncPool:
+    """(Experimental) A memory pool exported by another process.
+
+    The allocations of the other process are mapped into this one with
+    :meth:`import_pointer`, without any copy of the data. No memory can be
+    allocated from an imported pool.
+
+    Args:
+        fd (int): The file descriptor returned by
+            :meth:`MemoryAsyncPool.export_handle` in the other process. The
+            pool is imported on the current device.
+
+    .. warning::
+        This feature is currently experimental and subject to change.
+    """
+
+    cdef:
+        readonly intptr_t pool
+        readonly int device_id
+
+    def __init__(self, int fd):
+        _util.experimental('cupy.cuda.ImportedMemoryAsyncPool')
+        self.device_id = device.get_device_id()
+        self.pool = runtime.memPoolImportFromShareableHandle(
+            fd, runtime.cudaMemHandleTypePosixFileDescriptor)
+
+    def __dealloc__(self):
+        if self.pool:
+            runtime.memPoolDestroy(self.pool)
+
+    cpdef MemoryPointer import_pointer(self, bytes data, size_t size):
+        """Imports an allocation of the pool.
+
+        The imported memory is released, on the current stream, when the
+        returned pointer is no longer referenced; the pool is kept alive
+        until then.
+
+        Args:
+            data (bytes): The bytes returned by
+                :meth:`MemoryAsyncPool.export_pointer` in the other process.
+            size (int): The size of the allocation in bytes.
+
+        Returns:
+            ~cupy.cuda.MemoryPointer: Pointer to the imported allocation.
+        """
+        cdef intptr_t ptr = runtime.memPoolImportPointer(self.pool, data)
+        return MemoryPointer(_ImportedMemoryAsync(self, ptr, size), 0)
+
 
 ctypedef void*(*malloc_func_type)(void*, size_t, int)
 ctypedef void(*free_func_type)(void*, void*, int)
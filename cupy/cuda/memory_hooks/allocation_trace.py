@@ -0,0 +1,280 @@
+import json
+import sys
+import time
+
+from cupy.cuda import memory_hook
+from cupy.cuda import stream as stream_module
+
+
+_MALLOC = 0
+_FREE = 1
+_ALLOC = 2
+_OOM = 3
+_kind_names = ('malloc', 'free', 'alloc', 'oom')
+
+
+class AllocationTraceHook(memory_hook.MemoryHook):
+    """Memory hook that traces allocations into a ring buffer.
+
+    This memory hook records each ``malloc`` and ``free`` of the memory pool,
+    each allocation of the pool from the device (``alloc``) and each
+    ``malloc`` that failed (``oom``), with the time, the size, the pointer,
+    the current stream and the id of the Python call stack. Only the last
+    ``capacity`` events are kept. The memory used by the allocations made
+    while the hook is enabled is tracked for each device, and the live bytes
+    of each call stack are saved when this usage reaches a new peak, so that
+    the code that holds the memory at the high-water mark can be found.
+
+    Example:
+        Code example::
+
+            from cupy.cuda import memory_hooks
+            hook = memory_hooks.AllocationTraceHook()
+            with hook:
+                # some CuPy codes
+            hook.print_report()
+            hook.export_chrome_trace('trace.json')
+
+        Output example::
+
+            device 0: peak 3.00KB at 0.012s
+              2.00KB tests/cupy_tests/test.py:39:test
+              1.00KB tests/cupy_tests/test.py:37:test
+
+        The exported file can be opened with ``chrome://tracing`` or
+        `Perfetto <https://ui.perfetto.dev>`_; it shows the used memory of
+        each device as a counter, and each event with its call stack.
+
+    Args:
+        capacity (int): The number of events kept.
+        stack_depth (int): The number of innermost Python frames recorded
+            for each event. If ``0``, the stacks are not recorded.
+
+    .. note::
+        The allocations served by the slabs of small blocks
+        (:envvar:`CUPY_POOL_SLAB_THRESHOLD`) do not call the hooks, and are
+        not traced. Like :class:`LineProfileHook`, the stacks only show the
+        Python frames.
+    """
+
+    name = 'AllocationTraceHook'
+
+    def __init__(self, capacity=65536, stack_depth=8):
+        if capacity <= 0:
+            raise ValueError('capacity must be positive')
+        if stack_depth < 0:
+            raise ValueError('stack_depth must not be negative')
+        self._capacity = capacity
+        self._stack_depth = stack_depth
+        # (time in ns, kind, device id, size, ptr, stream ptr, stack id,
+        #  used bytes of the device after the event)
+        self._events = [None] * capacity
+        self._n_events = 0
+        # stack (tuple of (filename, lineno, name), innermost last) <-> id
+        self._stack_ids = {(): 0}
+        self._stacks = [()]
+        # ptr -> (size, stack id) of the live allocations
+        self._live = {}
+        # device id -> used bytes, and stack id -> live bytes
+        self._used = {}
+        self._stack_bytes = {}
+        # device id -> (peak bytes, time in ns, {stack id: live bytes})
+        self._peaks = {}
+        self._start_time = time.perf_counter_ns()
+
+    def _stack_id(self):
+        if self._stack_depth == 0:
+            return 0
+        frames = []
+        # skips this method and the hook callback
+        f = sys._getframe(2)
+        while f is not None and len(frames) < self._stack_depth:
+            code = f.f_code
+            frames.append((code.co_filename, f.f_lineno, code.co_name))
+            f = f.f_back
+        stack = tuple(reversed(frames))
+        stack_id = self._stack_ids.get(stack)
+        if stack_id is None:
+            stack_id = self._stack_ids[stack] = len(self._stacks)
+            self._stacks.append(stack)
+        return stack_id
+
+    def _record(self, kind, device_id, size, ptr, stack_id):
+        t = time.perf_counter_ns()
+        self._events[self._n_events % self._capacity] = (
+            t, kind, device_id, size, ptr,
+            stream_module.get_current_stream_ptr(), stack_id,
+            self._used.get(device_id, 0))
+        self._n_events += 1
+        return t
+
+    # callback
+    def malloc_postprocess(self, device_id, size, mem_size, mem_ptr, pmem_id):
+        stack_id = self._stack_id()
+        if mem_ptr == 0:
+            self._record(_OOM, device_id, mem_size, 0, stack_id)
+            return
+        self._live[mem_ptr] = (mem_size, stack_id)
+        stack_bytes = self._stack_bytes.setdefault(device_id, {})
+        stack_bytes[stack_id] = stack_bytes.get(stack_id, 0) + mem_size
+        used = self._used.get(device_id, 0) + mem_size
+        self._used[device_id] = used
+        t = self._record(_MALLOC, device_id, mem_size, mem_ptr, stack_id)
+        peak = self._peaks.get(device_id)
+        if peak is None or used > peak[0]:
+            self._peaks[device_id] = (used, t, dict(stack_bytes))
+
+    # callback
+    def free_postprocess(self, device_id, mem_size, mem_ptr, pmem_id):
+        entry = self._live.pop(mem_ptr, None)
+        stack_id = 0
+        if entry is not None:
+            # only the allocations made while tracing are counted
+            size, stack_id = entry
+            stack_bytes = self._stack_bytes[device_id]
+            stack_bytes[stack_id] -= size
+            if stack_bytes[stack_id] == 0:
+                del stack_bytes[stack_id]
+            self._used[device_id] -= size
+        self._record(_FREE, device_id, mem_size, mem_ptr, stack_id)
+
+    # callback
+    def alloc_postprocess(self, device_id, mem_size, mem_ptr):
+        self._record(_ALLOC, device_id, mem_size, mem_ptr, self._stack_id())
+
+    def events(self):
+        """Returns the events kept, from the oldest.
+
+        Returns:
+            list of dict: The events, with the keys ``time`` (in seconds from
+            the creation of the hook), ``hook`` (``'malloc'``, ``'free'``,
+            ``'alloc'`` or ``'oom'``), ``device_id``, ``mem_size``,
+            ``mem_ptr``, ``stream`` (the pointer of the current stream),
+            ``stack`` (a list of ``(filename, lineno, name)``, innermost
+            last) and ``used`` (the bytes used on the device by the
+            allocations made while tracing, after the event).
+        """
+        n = self._n_events
+        if n <= self._capacity:
+            events = self._events[:n]
+        else:
+            i = n % self._capacity
+            events = self._events[i:] + self._events[:i]
+        return [{
+            'time': (t - self._start_time) * 1e-9,
+            'hook': _kind_names[kind],
+            'device_id': device_id,
+            'mem_size': size,
+            'mem_ptr': ptr,
+            'stream': stream_ptr,
+            'stack': list(self._stacks[stack_id]),
+            'used': used,
+        } for t, kind, device_id, size, ptr, stream_ptr, stack_id, used
+            in events]
+
+    @property
+    def dropped_events(self):
+        """The number of events dropped from the ring buffer."""
+        return max(0, self._n_events - self._capacity)
+
+    def peak_attribution(self, device_id):
+        """Returns the live bytes of each call stack at the peak of a device.
+
+        Args:
+            device_id (int): The device.
+
+        Returns:
+            tuple: The peak bytes, and a list of ``(bytes, stack)`` sorted by
+            the bytes in descending order, where ``stack`` is a list of
+            ``(filename, lineno, name)``, innermost last. The peak is ``0``
+            if no memory was allocated on the device while tracing.
+        """
+        peak = self._peaks.get(device_id)
+        if peak is None:
+            return 0, []
+        stacks = sorted(
+            ((nbytes, list(self._stacks[stack_id]))
+             for stack_id, nbytes in peak[2].items() if nbytes > 0),
+            key=lambda x: x[0], reverse=True)
+        return peak[0], stacks
+
+    def print_report(self, file=sys.stdout, limit=10):
+        """Prints the peak memory of each device and its call stacks.
+
+        Args:
+            file: The output file-like object.
+            limit (int): The number of call stacks shown for each device.
+        """
+        for device_id in sorted(self._peaks):
+            peak, t, _ = self._peaks[device_id]
+            file.write('device %d: peak %s at %.3fs\n' % (
+                device_id, _humanized_size(peak),
+                (t - self._start_time) * 1e-9))
+            _, stacks = self.peak_attribution(device_id)
+            for nbytes, stack in stacks[:limit]:
+                if stack:
+                    filename, lineno, name = stack[-1]
+                    where = '%s:%s:%s' % (filename, lineno, name)
+                else:
+                    where = '(unknown)'
+                file.write('  %s %s\n' % (_humanized_size(nbytes), where))
+        file.flush()
+
+    def export_chrome_trace(self, file):
+        """Writes the events in the Chrome trace event format.
+
+        Args:
+            file (str or file-like): The path or the text file to write.
+        """
+        frame_ids = {}
+        frames = {}
+
+        def frame_id(stack):
+            # Interns the frames of a stack, and returns the innermost one.
+            parent = None
+            for frame in stack:
+                key = (parent, frame)
+                fid = frame_ids.get(key)
+                if fid is None:
+                    fid = frame_ids[key] = len(frame_ids) + 1
+                    frames[fid] = {'name': '%s (%s:%s)' % (
+                        frame[2], frame[0], frame[1])}
+                    if parent is not None:
+                        frames[fid]['parent'] = parent
+                parent = fid
+            return parent
+
+        trace = []
+        for e in self.events():
+            ts = e['time'] * 1e6
+            event = {
+                'name': e['hook'], 'ph': 'i', 's': 't', 'ts': ts,
+                'pid': 0, 'tid': e['device_id'],
+                'args': {'mem_size': e['mem_size'], 'mem_ptr': e['mem_ptr'],
+                         'stream': e['stream']},
+            }
+            fid = frame_id(e['stack'])
+            if fid is not None:
+                event['sf'] = fid
+            trace.append(event)
+            if e['hook'] in ('malloc', 'free'):
+                trace.append({
+                    'name': 'memory (device %d)' % e['device_id'],
+                    'ph': 'C', 'ts': ts, 'pid': 0,
+                    'args': {'used': e['used']}})
+        data = {'traceEvents': trace,
+                'stackFrames': {str(k): v for k, v in frames.items()},
+                'displayTimeUnit': 'ms'}
+        if isinstance(file, str):
+            with open(file, 'w') as f:
+                json.dump(data, f)
+        else:
+            json.dump(data, file)
+
+
+def _humanized_size(size):
+    for unit in ['', 'K', 'M', 'G', 'T', 'P', 'E']:
+        if size < 1024.0:
+            return '%3.2f%sB' % (size, unit)
+        size /= 1024.0
+    return '%.2f%sB' % (size, 'Z')
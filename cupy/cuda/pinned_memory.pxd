@@ -15,6 +15,9 @@ cdef class PinnedMemoryPointer:
 cpdef _add_to_watch_list(event, obj)
 
 
+cpdef _record_and_watch(stream, obj)
+
+
 cpdef PinnedMemoryPointer alloc_pinned_memory(size_t size)
 
 
@@ -26,16 +29,24 @@ cdef class PinnedMemoryPool:
     cdef:
         object _alloc
         dict _in_use
-        object _free
+        list _free
         object __weakref__
         object _weakref
         object _lock
         size_t _allocation_unit_size
+        object _local
+        object _caches
+        list _arenas
+
+    cdef object _get_thread_cache(self)
+    cdef _reclaim(self, list blocks)
+    cdef size_t _round_size(self, size_t size)
 
     cpdef PinnedMemoryPointer malloc(self, size_t size)
     cpdef free(self, intptr_t ptr, size_t size)
     cpdef free_all_blocks(self)
     cpdef n_free_blocks(self)
+    cpdef reserve(self, size_t size, Py_ssize_t count)
 
 
 cpdef bint is_memory_pinned(intptr_t data) except*
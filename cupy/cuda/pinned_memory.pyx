@@ -1,6 +1,7 @@
 # distutils: language = c++
 
 import collections
+import threading
 import weakref
 
 from fastrlock cimport rlock
@@ -8,8 +9,19 @@ from fastrlock cimport rlock
 from cupy_backends.cuda.api import runtime
 
 from cupy._core cimport internal
+from cupy.cuda cimport device
 from cupy_backends.cuda.api cimport runtime
 from cupy import _util
+from cupy.cuda import stream as stream_module
+
+
+# The number of the free blocks of each size class that a thread keeps for
+# itself, and the largest size of the blocks that are kept this way.
+cdef Py_ssize_t _thread_cache_size = 4
+cdef size_t _thread_cache_max_size = 1 << 20
+
+# The number of completed events kept for reuse on each device.
+cdef Py_ssize_t _max_free_events = 64
 
 
 class PinnedMemory(object):
@@ -135,11 +147,16 @@ cdef class PinnedMemoryPointer:
 
 cdef class _EventWatcher:
     cdef:
-        cdef list events
-        cdef object _lock
+        # (event, obj, device id of a recyclable event or -1), in the order
+        # of recording
+        object events
+        # device id -> list of completed events to be recorded again
+        dict _free_events
+        object _lock
 
     def __init__(self):
-        self.events = []
+        self.events = collections.deque()
+        self._free_events = {}
         self._lock = rlock.create_fastrlock()
 
     cpdef add(self, event, obj):
@@ -153,18 +170,50 @@ cdef class _EventWatcher:
         """
         rlock.lock_fastrlock(self._lock, -1, True)
         try:
-            self._check_and_release_without_lock()
-            if event.done:
-                return
-            self.events.append((event, obj))
+            self.events.append((event, obj, -1))
+        finally:
+            rlock.unlock_fastrlock(self._lock)
+
+    cpdef record(self, stream, obj):
+        """ Record an event on the stream and monitor it.
+
+        The event is taken from the completed ones when possible, so that no
+        event is created in the steady state.
+
+        Args:
+            stream (cupy.cuda.Stream): The stream to record the event on.
+            obj: The object to be held until the work queued on the stream
+                so far is done.
+        """
+        cdef int dev_id = device.get_device_id()
+        cdef list free
+        event = None
+        rlock.lock_fastrlock(self._lock, -1, True)
+        try:
+            free = self._free_events.get(dev_id)
+            if free:
+                event = free.pop()
+        finally:
+            rlock.unlock_fastrlock(self._lock)
+        if event is None:
+            event = stream_module.Event(disable_timing=True)
+        event.record(stream)
+        rlock.lock_fastrlock(self._lock, -1, True)
+        try:
+            self.events.append((event, obj, dev_id))
         finally:
             rlock.unlock_fastrlock(self._lock)
 
     cpdef check_and_release(self):
         """ Check and release completed events.
 
+        Only the oldest event is queried unless it is done, in which case all
+        the completed events are released at once.
         """
-        if not self.events:
+        try:
+            if not self.events[0][0].done:
+                return
+        except IndexError:
             return
         rlock.lock_fastrlock(self._lock, -1, True)
         try:
@@ -173,8 +222,17 @@ cdef class _EventWatcher:
             rlock.unlock_fastrlock(self._lock)
 
     cpdef _check_and_release_without_lock(self):
+        cdef list free
+        cdef int dev_id
         while self.events and self.events[0][0].done:
-            del self.events[0]
+            event, _, dev_id = self.events.popleft()
+            if dev_id < 0:
+                continue
+            free = self._free_events.get(dev_id)
+            if free is None:
+                free = self._free_events[dev_id] = []
+            if len(free) < _max_free_events:
+                free.append(event)
 
 
 cpdef PinnedMemoryPointer _malloc(size_t size):
@@ -198,6 +256,20 @@ cpdef _add_to_watch_list(event, obj):
     _watcher.add(event, obj)
 
 
+cpdef _record_and_watch(stream, obj):
+    """ Record an event on the stream and monitor it.
+
+    The ``obj`` are automatically released when the work queued on the
+    stream so far is done. Unlike :func:`_add_to_watch_list`, the events are
+    reused.
+
+    Args:
+        stream (cupy.cuda.Stream): The stream to record the event on.
+        obj: The object to be held.
+    """
+    _watcher.record(stream, obj)
+
+
 cpdef PinnedMemoryPointer alloc_pinned_memory(size_t size):
     """Calls the current allocator.
 
@@ -262,6 +334,66 @@ class PooledPinnedMemory(PinnedMemory):
     __del__ = free
 
 
+class _ReservedPinnedMemory(PinnedMemory):
+
+    """A block of the pinned memory reserved by a memory pool.
+
+    The block is a part of a larger allocation, which is released with the
+    pool.
+
+    """
+
+    def __init__(self, arena, ptrdiff_t offset, size_t size):
+        self.arena = arena
+        self.ptr = arena.ptr + offset
+        self.size = size
+
+    def __del__(self):
+        pass
+
+
+cdef inline int _size_class(size_t size):
+    # the index of the highest bit, which is the class of the rounded sizes
+    cdef int i = 0
+    while size > 1:
+        size >>= 1
+        i += 1
+    return i
+
+
+cdef list _new_free_lists():
+    return [[] for _ in range(64)]
+
+
+cdef void _pop_all(list src, list dst):
+    # Each pop is atomic, so that a block popped concurrently by its owner
+    # thread is not moved as well.
+    while True:
+        try:
+            dst.append(src.pop())
+        except IndexError:
+            return
+
+
+cdef class _ThreadCache:
+
+    cdef:
+        # size class -> free blocks
+        list blocks
+        object pool_ref
+        object __weakref__
+
+    def __init__(self, pool_ref):
+        self.blocks = _new_free_lists()
+        self.pool_ref = pool_ref
+
+    def __dealloc__(self):
+        # the thread has exited; its blocks go back to the pool
+        pool = self.pool_ref()
+        if pool is not None:
+            (<PinnedMemoryPool>pool)._reclaim(self.blocks)
+
+
 cdef class PinnedMemoryPool:
 
     """Memory pool for pinned memory on the host.
@@ -269,7 +401,10 @@ cdef class PinnedMemoryPool:
     Note that it preserves all allocated memory buffers even if the user
     explicitly release the one. Those released memory buffers are held by the
     memory pool as *free blocks*, and reused for further memory allocations of
-    the same size.
+    the same size class. The sizes are rounded up to powers of two.
+
+    Each thread keeps a few free blocks of each small size class for itself,
+    which it allocates and frees without taking the lock of the pool.
 
     Args:
         allocator (function): The base CuPy pinned memory allocator. It is
@@ -280,60 +415,118 @@ cdef class PinnedMemoryPool:
 
     def __init__(self, allocator=_malloc):
         self._in_use = {}
-        self._free = collections.defaultdict(list)
+        self._free = _new_free_lists()
         self._alloc = allocator
         self._weakref = weakref.ref(self)
         self._lock = rlock.create_fastrlock()
         self._allocation_unit_size = 512
+        self._local = threading.local()
+        self._caches = weakref.WeakSet()
+        self._arenas = []
+
+    cdef object _get_thread_cache(self):
+        try:
+            return self._local.cache
+        except AttributeError:
+            pass
+        cache = _ThreadCache(self._weakref)
+        self._local.cache = cache
+        rlock.lock_fastrlock(self._lock, -1, True)
+        try:
+            self._caches.add(cache)
+        finally:
+            rlock.unlock_fastrlock(self._lock)
+        return cache
+
+    cdef _reclaim(self, list blocks):
+        cdef list free
+        rlock.lock_fastrlock(self._lock, -1, True)
+        try:
+            for i, free in enumerate(blocks):
+                (<list>self._free[i]).extend(free)
+        finally:
+            rlock.unlock_fastrlock(self._lock)
+
+    cdef size_t _round_size(self, size_t size):
+        # Round up the memory size to fit memory alignment of cudaHostAlloc
+        cdef size_t unit = self._allocation_unit_size
+        return internal.clp2(((size + unit - 1) // unit) * unit)
 
     cpdef PinnedMemoryPointer malloc(self, size_t size):
         cdef list free
-        cdef size_t unit
+        cdef _ThreadCache cache
 
         if size == 0:
             return PinnedMemoryPointer(PinnedMemory(0), 0)
 
-        # Round up the memory size to fit memory alignment of cudaHostAlloc
-        unit = self._allocation_unit_size
-        size = internal.clp2(((size + unit - 1) // unit) * unit)
-        rlock.lock_fastrlock(self._lock, -1, True)
-        try:
-            free = self._free[size]
-            if free:
-                mem = free.pop()
-            else:
-                try:
-                    mem = self._alloc(size).mem
-                except runtime.CUDARuntimeError as e:
-                    if e.status != runtime.errorMemoryAllocation:
-                        raise
-                    self.free_all_blocks()
-                    mem = self._alloc(size).mem
-
-            self._in_use[mem.ptr] = mem
-        finally:
-            rlock.unlock_fastrlock(self._lock)
+        size = self._round_size(size)
+        mem = None
+        if size <= _thread_cache_max_size:
+            cache = self._get_thread_cache()
+            try:
+                mem = (<list>cache.blocks[_size_class(size)]).pop()
+            except IndexError:
+                pass
+        if mem is None:
+            rlock.lock_fastrlock(self._lock, -1, True)
+            try:
+                free = self._free[_size_class(size)]
+                if free:
+                    mem = free.pop()
+                else:
+                    try:
+                        mem = self._alloc(size).mem
+                    except runtime.CUDARuntimeError as e:
+                        if e.status != runtime.errorMemoryAllocation:
+                            raise
+                        self.free_all_blocks()
+                        mem = self._alloc(size).mem
+            finally:
+                rlock.unlock_fastrlock(self._lock)
+
+        self._in_use[mem.ptr] = mem
         pmem = PooledPinnedMemory(mem, self._weakref)
         return PinnedMemoryPointer(pmem, 0)
 
     cpdef free(self, intptr_t ptr, size_t size):
         cdef list free
+        cdef _ThreadCache cache
+        mem = self._in_use.pop(ptr, None)
+        if mem is None:
+            raise RuntimeError('Cannot free out-of-pool memory')
+        if size <= _thread_cache_max_size:
+            cache = self._get_thread_cache()
+            free = cache.blocks[_size_class(size)]
+            if len(free) < _thread_cache_size:
+                free.append(mem)
+                return
         rlock.lock_fastrlock(self._lock, -1, True)
         try:
-            mem = self._in_use.pop(ptr, None)
-            if mem is None:
-                raise RuntimeError('Cannot free out-of-pool memory')
-            free = self._free[size]
+            free = self._free[_size_class(size)]
             free.append(mem)
         finally:
             rlock.unlock_fastrlock(self._lock)
 
     cpdef free_all_blocks(self):
-        """Release free all blocks."""
+        """Release free all blocks.
+
+        The blocks reserved by :meth:`reserve` are kept.
+        """
+        cdef list blocks = []
+        cdef list free
+        cdef _ThreadCache cache
         _watcher.check_and_release()
         rlock.lock_fastrlock(self._lock, -1, True)
         try:
-            self._free.clear()
+            for cache in list(self._caches):
+                for free in cache.blocks:
+                    _pop_all(free, blocks)
+            for free in self._free:
+                _pop_all(free, blocks)
+            for mem in blocks:
+                if isinstance(mem, _ReservedPinnedMemory):
+                    free = self._free[_size_class(mem.size)]
+                    free.append(mem)
         finally:
             rlock.unlock_fastrlock(self._lock)
 
@@ -344,14 +537,47 @@ cdef class PinnedMemoryPool:
             int: The total number of free blocks.
         """
         cdef Py_ssize_t n = 0
+        cdef _ThreadCache cache
         rlock.lock_fastrlock(self._lock, -1, True)
         try:
-            for v in self._free.values():
+            for v in self._free:
                 n += len(v)
+            for cache in list(self._caches):
+                for v in cache.blocks:
+                    n += len(v)
         finally:
             rlock.unlock_fastrlock(self._lock)
         return n
 
+    cpdef reserve(self, size_t size, Py_ssize_t count):
+        """Reserves free blocks in a single pinned memory allocation.
+
+        The allocations of up to ``size`` bytes are then served from these
+        blocks without calling the allocator, as long as they are not all in
+        use. They are kept by :meth:`free_all_blocks`, and released with the
+        pool. This is typically called once at startup, so that staging
+        buffers of a known size have a predictable latency.
+
+        Args:
+            size (int): The size of each block in bytes. It is rounded up in
+                the same way as in :meth:`malloc`.
+            count (int): The number of blocks.
+        """
+        cdef list free
+        cdef Py_ssize_t i
+        if size == 0 or count <= 0:
+            raise ValueError('size and count must be positive')
+        size = self._round_size(size)
+        arena = self._alloc(size * count).mem
+        rlock.lock_fastrlock(self._lock, -1, True)
+        try:
+            self._arenas.append(arena)
+            free = self._free[_size_class(size)]
+            for i in range(count):
+                free.append(_ReservedPinnedMemory(arena, i * size, size))
+        finally:
+            rlock.unlock_fastrlock(self._lock)
+
 
 cpdef bint is_memory_pinned(intptr_t data) except*:
     cdef runtime.PointerAttributes attrs = runtime.pointerGetAttributes(data)
@@ -53,10 +53,13 @@ cdef class _ThreadLocal:
         assert len(self.current_stream_stack[device_id]) >= 1
 
     cdef set_current_stream(self, stream):
-        cdef intptr_t ptr = <intptr_t>stream.ptr
         cdef int device_id = stream.device_id
         if device_id == -1:
             device_id = runtime.getDevice()
+        if self.current_stream[device_id] is stream:
+            # the backend already has its pointer
+            return
+        cdef intptr_t ptr = <intptr_t>stream.ptr
         backends_stream.set_current_stream_ptr(ptr, device_id)
         self.current_stream[device_id] = stream
 
@@ -354,6 +357,11 @@ class _BaseStream:
             mode (int): The stream capture mode. Default is
                 :data:`~cupy.cuda.runtime.streamCaptureModeRelaxed`.
 
+        .. note:: The blocks that the memory pool frees during the capture
+            may be reused by other work while the graph is alive, which
+            corrupts its replays, unless the ``'per_graph'`` policy of
+            :meth:`~cupy.cuda.MemoryPool.set_capture_policy` is set.
+
         .. note:: During the stream capture, synchronous device-host transfers
             are not allowed. This has a particular implication for CuPy APIs,
             as some functions that internally require synchronous transfer
@@ -381,10 +389,17 @@ class _BaseStream:
             # the async APIs, such as cudaMallocAsync.)
             mode = runtime.streamCaptureModeRelaxed
         runtime.streamBeginCapture(self.ptr, mode)
+        graph._begin_capture(self.ptr)
 
-    def end_capture(self):
+    def end_capture(self, instantiate=True):
         """End stream capture and retrieve the constructed CUDA graph.
 
+        Args:
+            instantiate (bool): If ``False``, the graph is instantiated when
+                it is first launched or uploaded, so that a graph only used
+                to :meth:`~cupy.cuda.Graph.update` another one is never
+                instantiated.
+
         Returns:
             cupy.cuda.Graph:
                 A CUDA graph object that encapsulates the captured work.
@@ -397,8 +412,15 @@ class _BaseStream:
             https://docs.nvidia.com/cuda/cuda-runtime-api/group__CUDART__STREAM.html#group__CUDART__STREAM_1gf5a0efebc818054ceecd1e3e5e76d93e
 
         """
-        cdef intptr_t g = runtime.streamEndCapture(self.ptr)
-        return graph.Graph.from_stream(g)
+        cdef intptr_t g
+        cdef graph._GraphMemory memory = graph._end_capture(self.ptr)
+        try:
+            g = runtime.streamEndCapture(self.ptr)
+        except Exception:
+            if memory is not None:
+                memory.release()
+            raise
+        return graph.Graph.from_stream(g, instantiate, memory)
 
     def is_capturing(self):
         """Check if the stream is capturing.
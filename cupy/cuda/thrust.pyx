@@ -6,6 +6,7 @@ from libc.stdint cimport intptr_t
 from libcpp cimport vector
 
 from cupy.cuda cimport common
+from cupy.cuda cimport function
 from cupy.cuda cimport memory
 from cupy.cuda cimport stream
 
@@ -19,9 +20,12 @@ from cupy.cuda cimport stream
 cdef class _MemoryManager:
     cdef:
         dict memory
+        intptr_t stream_ident
 
     def __init__(self):
         self.memory = dict()
+        self.stream_ident = memory._get_stream_identifier(
+            stream.get_current_stream_ptr())
 
 
 cdef public char* cupy_malloc(void *m, size_t size) with gil:
@@ -40,6 +44,32 @@ cdef public void cupy_free(void *m, char* ptr) with gil:
     del mm.memory[<size_t>ptr]
 
 
+# Cached workspace arenas for the temporaries, keyed by the device and the
+# stream identifier of the memory pool, which differs between the threads
+# that use the per-thread default stream. The C++ side bump-allocates from
+# them and only calls back to grow them.
+cdef dict _workspaces = {}
+
+
+cdef public intptr_t cupy_workspace_key(void *m) with gil:
+    return (<_MemoryManager>m).stream_ident
+
+
+cdef public char* cupy_workspace_realloc(
+        int device_id, intptr_t stream_ident, size_t size) with gil:
+    cdef memory.MemoryPointer mem
+    key = (device_id, stream_ident)
+    # the old buffer is returned to the pool in stream order
+    _workspaces.pop(key, None)
+    try:
+        mem = memory.alloc(size)
+    except Exception:
+        # out of memory; keep running without the arena
+        return <char *>0
+    _workspaces[key] = mem
+    return <char *>mem.ptr
+
+
 ###############################################################################
 # Extern
 ###############################################################################
@@ -51,6 +81,13 @@ cdef extern from 'cupy_thrust.h':
         int, size_t *, void *, size_t, size_t, intptr_t, void *)
     void thrust_argsort(int, size_t *, void *, void *,
                         const vector.vector[ptrdiff_t]&, intptr_t, void *)
+    void thrust_topk(int, void *, void *, size_t *, size_t, size_t, size_t,
+                     bint, bint, intptr_t, void *)
+    void thrust_segmented_sort(int, void *, void *, size_t, size_t, intptr_t,
+                               void *)
+    void thrust_segmented_argsort(int, size_t *, void *, void *, size_t,
+                                  size_t, intptr_t, void *)
+    bint thrust_release_workspace(int, intptr_t)
 
     # Build-time version
     int THRUST_VERSION
@@ -68,6 +105,28 @@ def get_build_version():
     return THRUST_VERSION
 
 
+def _release_workspaces(int device_id, stream_ident):
+    # the arenas in use by a running sort are kept
+    for key in list(_workspaces):
+        if device_id >= 0 and key[0] != device_id:
+            continue
+        if stream_ident is not None and key[1] != stream_ident:
+            continue
+        if thrust_release_workspace(key[0], key[1]):
+            _workspaces.pop(key, None)
+
+
+memory._register_release_callback(_release_workspaces)
+
+
+def free_workspace():
+    """Releases the cached workspace arenas of the Thrust routines.
+
+    The arenas are also released by ``free_all_blocks`` of the memory pool.
+    """
+    _release_workspaces(-1, None)
+
+
 cpdef sort(dtype, intptr_t data_start, intptr_t keys_start,
            const vector.vector[ptrdiff_t]& shape) except +:
     cdef void* _data_start = <void*>data_start
@@ -85,8 +144,14 @@ cpdef sort(dtype, intptr_t data_start, intptr_t keys_start,
     if dtype_id == 8 and not common._is_fp16_supported():
         raise RuntimeError('either the GPU or the CUDA Toolkit does not '
                            'support fp16')
+    if dtype_id == 14 and not common._is_bf16_supported():
+        raise RuntimeError('either the GPU or the CUDA Toolkit does not '
+                           'support bf16')
 
+    ranged = function._push_range('thrust::sort', dtype, _strm)
     thrust_sort(dtype_id, _data_start, _keys_start, shape, _strm, mem)
+    if ranged:
+        function._pop_range(ranged, _strm)
 
 
 cpdef lexsort(dtype, intptr_t idx_start, intptr_t keys_start,
@@ -106,8 +171,14 @@ cpdef lexsort(dtype, intptr_t idx_start, intptr_t keys_start,
     if dtype_id == 8 and not common._is_fp16_supported():
         raise RuntimeError('either the GPU or the CUDA Toolkit does not '
                            'support fp16')
+    if dtype_id == 14 and not common._is_bf16_supported():
+        raise RuntimeError('either the GPU or the CUDA Toolkit does not '
+                           'support bf16')
 
+    ranged = function._push_range('thrust::lexsort', dtype, _strm)
     thrust_lexsort(dtype_id, idx_ptr, keys_ptr, k, n, _strm, mem)
+    if ranged:
+        function._pop_range(ranged, _strm)
 
 
 cpdef argsort(dtype, intptr_t idx_start, intptr_t data_start,
@@ -129,6 +200,111 @@ cpdef argsort(dtype, intptr_t idx_start, intptr_t data_start,
     if dtype_id == 8 and not common._is_fp16_supported():
         raise RuntimeError('either the GPU or the CUDA Toolkit does not '
                            'support fp16')
+    if dtype_id == 14 and not common._is_bf16_supported():
+        raise RuntimeError('either the GPU or the CUDA Toolkit does not '
+                           'support bf16')
 
+    ranged = function._push_range('thrust::argsort', dtype, _strm)
     thrust_argsort(
         dtype_id, _idx_start, _data_start, _keys_start, shape, _strm, mem)
+    if ranged:
+        function._pop_range(ranged, _strm)
+
+
+cpdef segmented_sort(dtype, intptr_t data_start, intptr_t offsets_start,
+                     size_t size, size_t n_segments) except +:
+    """Sort the segments of a flat array in place.
+
+    The segments are given by ``n_segments + 1`` int64 offsets, starting at
+    0 and ending at ``size``.
+    """
+    cdef void* _data_start = <void*>data_start
+    cdef void* _offsets_start = <void*>offsets_start
+    cdef intptr_t _strm = stream.get_current_stream_ptr()
+    cdef _MemoryManager mem_obj = _MemoryManager()
+    cdef void* mem = <void*>mem_obj
+
+    cdef int dtype_id
+    try:
+        dtype_id = common._get_dtype_id(dtype)
+    except ValueError:
+        raise NotImplementedError('Sorting arrays with dtype \'{}\' is not '
+                                  'supported'.format(dtype))
+    if dtype_id == 8 and not common._is_fp16_supported():
+        raise RuntimeError('either the GPU or the CUDA Toolkit does not '
+                           'support fp16')
+    if dtype_id == 14 and not common._is_bf16_supported():
+        raise RuntimeError('either the GPU or the CUDA Toolkit does not '
+                           'support bf16')
+
+    ranged = function._push_range('thrust::segmented_sort', dtype, _strm)
+    thrust_segmented_sort(dtype_id, _data_start, _offsets_start, size,
+                          n_segments, _strm, mem)
+    if ranged:
+        function._pop_range(ranged, _strm)
+
+
+cpdef segmented_argsort(dtype, intptr_t idx_start, intptr_t data_start,
+                        intptr_t offsets_start, size_t size,
+                        size_t n_segments) except +:
+    """Compute the flat positions that sort every segment of a flat array.
+
+    See :func:`segmented_sort` for the offsets. The data is clobbered.
+    """
+    cdef size_t* _idx_start = <size_t*>idx_start
+    cdef void* _data_start = <void*>data_start
+    cdef void* _offsets_start = <void*>offsets_start
+    cdef intptr_t _strm = stream.get_current_stream_ptr()
+    cdef _MemoryManager mem_obj = _MemoryManager()
+    cdef void* mem = <void*>mem_obj
+
+    cdef int dtype_id
+    try:
+        dtype_id = common._get_dtype_id(dtype)
+    except ValueError:
+        raise NotImplementedError('Sorting arrays with dtype \'{}\' is not '
+                                  'supported'.format(dtype))
+    if dtype_id == 8 and not common._is_fp16_supported():
+        raise RuntimeError('either the GPU or the CUDA Toolkit does not '
+                           'support fp16')
+    if dtype_id == 14 and not common._is_bf16_supported():
+        raise RuntimeError('either the GPU or the CUDA Toolkit does not '
+                           'support bf16')
+
+    ranged = function._push_range('thrust::segmented_argsort', dtype, _strm)
+    thrust_segmented_argsort(dtype_id, _idx_start, _data_start,
+                             _offsets_start, size, n_segments, _strm, mem)
+    if ranged:
+        function._pop_range(ranged, _strm)
+
+
+cpdef topk(dtype, intptr_t data_start, intptr_t values_start,
+           intptr_t idx_start, size_t n_rows, size_t n_cols, size_t k,
+           bint largest, bint keep_rest) except +:
+    """Select the ``k`` smallest (or largest) items of each row.
+
+    The selected items of each row are written in sorted order to the head
+    of the rows of ``values_start`` and their in-row indices to
+    ``idx_start``. The output rows have ``k`` items, or ``n_cols`` items if
+    ``keep_rest`` is True, in which case the remaining items follow the
+    selected ones.
+    """
+    cdef void* _data_start = <void*>data_start
+    cdef void* _values_start = <void*>values_start
+    cdef size_t* _idx_start = <size_t*>idx_start
+    cdef intptr_t _strm = stream.get_current_stream_ptr()
+    cdef _MemoryManager mem_obj = _MemoryManager()
+    cdef void* mem = <void *>mem_obj
+
+    cdef int dtype_id
+    try:
+        dtype_id = common._get_dtype_id(dtype)
+    except ValueError:
+        raise NotImplementedError('Selecting items with dtype \'{}\' is not '
+                                  'supported'.format(dtype))
+
+    ranged = function._push_range('thrust::topk', dtype, _strm)
+    thrust_topk(dtype_id, _data_start, _values_start, _idx_start, n_rows,
+                n_cols, k, largest, keep_rest, _strm, mem)
+    if ranged:
+        function._pop_range(ranged, _strm)
@@ -224,6 +224,27 @@ cdef class PlanCache:
         5. This cache supports the iterator protocol, and returns a 2-tuple:
            ``(key, node)`` starting from the most recently used plan.
 
+        6. By calling :meth:`set_shared_work_area`, the single-GPU plans
+           created afterwards share one work area per stream instead of
+           allocating their own. The shared area grows to the largest
+           requirement and is kept until :meth:`clear` is called. Its size
+           is reported by :meth:`get_shared_work_area_size` and
+           :meth:`show_info`, and is not counted in ``memsize``.
+
+        7. By calling :meth:`set_deferred_work_area`, the single-GPU plans
+           created afterwards hold no work area while they are cached.
+           Each execution borrows one from the memory pool of the current
+           stream and returns it right after, so the work areas are counted
+           in the limit of the pool (see
+           :meth:`~cupy.cuda.MemoryPool.set_limit`) only while they are
+           used, and the cached plans are not counted in ``memsize``.
+
+        8. When :data:`cupy.fft.config.enable_plan_autotuning` is ``True``,
+           the cache also remembers the fastest way of running each
+           transform that was timed on the device (see
+           :meth:`get_tuned_layout`). They are dropped by :meth:`clear`,
+           but not evicted with the plans.
+
     """
     # total number of plans, regardless of plan type
     # -1: unlimited/ignored, cache size is restricted by "memsize"
@@ -251,6 +272,12 @@ cdef class PlanCache:
     # the ID of the device on which the cached plans are allocated
     cdef int dev
 
+    # whether new plans share the per-stream work areas of the device
+    cdef bint shared_work_area
+
+    # whether new plans borrow their work areas from the memory pool
+    cdef bint deferred_work_area
+
     # key: all arguments used to construct Plan1d or PlanNd
     # value: the node that holds the plan corresponding to the key
     cdef dict cache
@@ -260,6 +287,10 @@ cdef class PlanCache:
     # lru.tail: most recent used
     cdef _LinkedList lru
 
+    # key: the transform timed by the autotuner
+    # value: the function that ran it the fastest
+    cdef dict tuned_layouts
+
     # ---------------------- Python methods ---------------------- #
 
     def __init__(self, Py_ssize_t size=16, Py_ssize_t memsize=-1, int dev=-1):
@@ -267,6 +298,8 @@ cdef class PlanCache:
         self._set_size_memsize(size, memsize)
         self._reset()
         self.dev = dev if dev != -1 else runtime.getDevice()
+        self.shared_work_area = False
+        self.deferred_work_area = False
 
     def __dealloc__(self):
         self._cleanup()
@@ -354,6 +387,13 @@ cdef class PlanCache:
             '(unlimited)' if self.memsize == -1 else self.memsize)
         output += 'hits / misses: {0} / {1} (counts)\n'.format(
             self.hits, self.misses)
+        output += 'shared work area: {0} ({1} bytes)\n'.format(
+            'enabled' if self.shared_work_area else 'disabled',
+            self.get_shared_work_area_size())
+        output += 'deferred work area: {0}\n'.format(
+            'enabled' if self.deferred_work_area else 'disabled')
+        output += 'tuned layouts: {0} (counts)\n'.format(
+            len(self.tuned_layouts))
         output += '\ncached plans (most recently used first):\n'
 
         cdef tuple key
@@ -385,6 +425,7 @@ cdef class PlanCache:
         self.misses = 0
         self.cache = {}
         self.lru = _LinkedList()
+        self.tuned_layouts = {}
 
     cdef void _cleanup(self):
         # remove circular reference and kick off garbage collection by
@@ -467,6 +508,12 @@ cdef class PlanCache:
             else:
                 # remove from the front to free up space
                 unwanted_node = self.lru.head.next
+                if self.curr_size <= size or size == -1:
+                    # only the memory is over the limit, so the plans that
+                    # hold no work area are kept
+                    while (unwanted_node is not self.lru.tail
+                           and unwanted_node.memsize == 0):
+                        unwanted_node = unwanted_node.next
                 if unwanted_node is not self.lru.tail:
                     gpus = unwanted_node.gpus
                     if gpus is None:
@@ -511,8 +558,111 @@ cdef class PlanCache:
         return plan
 
     cpdef clear(self):
+        from cupy.cuda import cufft
+
         self._cleanup()
         self._reset()
+        cufft.release_shared_work_areas(self.dev)
+
+    cpdef set_shared_work_area(self, bint flag):
+        """Sets whether the plans share one work area per stream.
+
+        Changing the mode clears the cache, so that all the cached plans are
+        made in the same mode.
+
+        Args:
+            flag (bool): If ``True``, the single-GPU plans created while this
+                cache is current allocate no work area of their own. Before
+                each execution, they are pointed to a work area shared by all
+                such plans on the device and the current stream, which grows
+                to the largest requirement seen.
+
+        """
+        if flag and self.deferred_work_area:
+            raise ValueError(
+                'the work areas are deferred; call '
+                'set_deferred_work_area(False) first')
+        if flag != self.shared_work_area:
+            self.clear()
+            self.shared_work_area = flag
+
+    cpdef bint get_shared_work_area(self):
+        return self.shared_work_area
+
+    cpdef set_deferred_work_area(self, bint flag):
+        """Sets whether the plans borrow their work areas from the pool.
+
+        Changing the mode clears the cache, so that all the cached plans are
+        made in the same mode. It cannot be used with
+        :meth:`set_shared_work_area`.
+
+        Args:
+            flag (bool): If ``True``, the single-GPU plans created while this
+                cache is current allocate no work area of their own. Before
+                each execution, they allocate one from the memory pool on the
+                current stream, which is freed once the execution is
+                enqueued.
+
+        """
+        if flag and self.shared_work_area:
+            raise ValueError(
+                'the work areas are shared; call set_shared_work_area(False) '
+                'first')
+        if flag != self.deferred_work_area:
+            self.clear()
+            self.deferred_work_area = flag
+
+    cpdef bint get_deferred_work_area(self):
+        return self.deferred_work_area
+
+    cpdef Py_ssize_t evict_work_areas(self) except -1:
+        """Removes the cached plans that hold a work area on this device.
+
+        This is called when an allocation for a transform fails, so that
+        the memory of the idle plans can be reused.
+
+        Returns:
+            int: The total size of the work areas released, in bytes.
+
+        """
+        cdef Py_ssize_t released = 0
+        cdef _Node node = self.lru.head.next
+        cdef _Node next_node
+
+        while node is not self.lru.tail:
+            next_node = node.next
+            if node.memsize > 0:
+                released += node.memsize
+                if node.gpus is None:
+                    self._remove_plan(key=None, node=node)
+                else:
+                    _remove_multi_gpu_plan(node.gpus, node.key)
+            node = next_node
+        return released
+
+    cpdef Py_ssize_t get_shared_work_area_size(self):
+        """Returns the total size, in bytes, of the shared work areas of the
+        device over all streams."""
+        from cupy.cuda import cufft
+
+        return sum(cufft.get_shared_work_area_sizes(self.dev).values())
+
+    cpdef get_tuned_layout(self, tuple key):
+        """Returns the layout chosen by the autotuner for a transform.
+
+        Args:
+            key (tuple): The transform, as made by the FFT functions.
+
+        Returns:
+            The function that runs the transform, or ``None`` if it has not
+            been timed on this device.
+
+        """
+        return self.tuned_layouts.get(key)
+
+    cpdef set_tuned_layout(self, tuple key, layout):
+        """Remembers the layout chosen by the autotuner for a transform."""
+        self.tuned_layouts[key] = layout
 
     cpdef show_info(self):
         print(self)
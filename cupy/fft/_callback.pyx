@@ -4,7 +4,6 @@ from cupy_backends.cuda.api cimport runtime
 from cupy._core.core cimport _ndarray_base
 from cupy.cuda.device cimport get_compute_capability
 
-import hashlib
 import importlib
 import os
 import shutil
@@ -18,7 +17,8 @@ import warnings
 
 from cupy import __version__ as _cupy_ver
 from cupy._environment import (get_nvcc_path, get_cuda_path)
-from cupy.cuda.compiler import (_get_bool_env_variable, CompileException)
+from cupy.cuda.compiler import (
+    _get_bool_env_variable, _hash_hexdigest, CompileException)
 
 
 # information needed for building an external module
@@ -40,7 +40,9 @@ cdef str _ext_suffix = None
 cdef bint _is_init = False
 cdef str _callback_dev_code = None
 cdef str _callback_cache_dir = None
+cdef str _source_hash = None
 cdef dict _callback_mgr = {}  # keep the Python modules alive
+cdef list _registered_callbacks = []
 cdef object _callback_thread_local = threading.local()
 
 
@@ -303,6 +305,114 @@ cdef inline void _nvcc_link(
     os.rename(mod_temp, mod_cached)
 
 
+cdef inline str _get_source_hash():
+    # The generated module is built from these files, so that a module
+    # cached by a different build of CuPy is never picked up.
+    global _source_hash
+    cdef str f
+    if _source_hash is None:
+        h = []
+        for f in ('cupy_cufftXt.cu', 'cupy_cufftXt.h', 'cupy_cufft.h',
+                  'cufft.pxd', 'cufft.pyx'):
+            with open(os.path.join(_source_dir, f), 'rb') as fp:
+                h.append(_hash_hexdigest(fp.read()))
+        _source_hash = ' '.join(h)
+    return _source_hash
+
+
+cdef inline str _get_mod_name(str cb_load, str cb_store, str arch):
+    # For hash; note this is independent of the plan to be created, and only
+    # depends on the given load/store callbacks and the runtime environment.
+    # All modules with the identical callbacks are considered identical
+    # regardless of which plan is actually executed at the time of generation
+    keys = (_cc, _nvcc, arch, _build_ver, _cufft_ver, _cupy_ver,
+            _python_include, _get_source_hash(), cb_load, cb_store)
+    keys = '%s %s %s %s %s %s %s %s %s %s' % keys
+    return 'cupy_callback_' + _hash_hexdigest(keys.encode())
+
+
+cdef str _build_module(str cb_load, str cb_store, str arch, str mod_name):
+    # Returns the path to the module in the disk cache, compiling it first if
+    # it is not cached yet.
+    cdef str tempdir
+    cdef str obj_host
+    cdef str obj_dev
+    cdef str mod_filename = mod_name + _ext_suffix
+    cdef str cache_dir
+    cdef str path
+    cdef str cufft_lib_pruned
+
+    # Check if the module is already cached on disk. If not, we compile.
+    cache_dir = get_cache_dir()
+    if not os.path.isdir(cache_dir):
+        os.makedirs(cache_dir, exist_ok=True)
+    path = os.path.join(cache_dir, mod_filename)
+    if os.path.isfile(path):
+        return path
+
+    # Set up temp directory; it must be under the cache directory so that
+    # atomic moves within the same filesystem can be guaranteed
+    tempdir_obj = tempfile.TemporaryDirectory(dir=cache_dir)
+    tempdir = tempdir_obj.name
+
+    # Cythonize the Cython code to produce a c++ source file
+    _cythonize(tempdir, mod_name)
+
+    # Compile the Python module
+    obj_host = os.path.join(tempdir, mod_name + '.o')
+    _mod_compile(tempdir, mod_name, obj_host)
+
+    # Prune libcufft_static.a for the target arch and cache it
+    cufft_lib_pruned = _prune(tempdir, cache_dir, str(_cufft_ver), arch)
+
+    # Dump and compile device code using nvcc
+    obj_dev = os.path.join(tempdir, mod_name + '_dev.o')
+    _nvcc_compile(tempdir, mod_name, cb_load, cb_store, obj_dev, arch)
+
+    # Use nvcc to link and generate a shared library, and place it in the
+    # disk cache
+    _nvcc_link(tempdir, obj_host, obj_dev, arch, mod_filename,
+               cache_dir, cufft_lib_pruned)
+
+    # Clean up build directory
+    tempdir_obj.cleanup()
+    return path
+
+
+cdef tuple _get_callback_types(int fft_type, str cb_load, str cb_store):
+    # Returns the load and store callback types for the transform, or -1 if
+    # the callback is not given.
+    from cupy.cuda.cufft import (
+        CUFFT_C2C, CUFFT_C2R, CUFFT_R2C,
+        CUFFT_Z2Z, CUFFT_Z2D, CUFFT_D2Z,
+        CUFFT_CB_LD_COMPLEX, CUFFT_CB_LD_COMPLEX_DOUBLE,
+        CUFFT_CB_LD_REAL, CUFFT_CB_LD_REAL_DOUBLE,
+        CUFFT_CB_ST_COMPLEX, CUFFT_CB_ST_COMPLEX_DOUBLE,
+        CUFFT_CB_ST_REAL, CUFFT_CB_ST_REAL_DOUBLE,)
+
+    if fft_type == CUFFT_C2C:
+        cb_load_type = CUFFT_CB_LD_COMPLEX if cb_load else -1
+        cb_store_type = CUFFT_CB_ST_COMPLEX if cb_store else -1
+    elif fft_type == CUFFT_R2C:
+        cb_load_type = CUFFT_CB_LD_REAL if cb_load else -1
+        cb_store_type = CUFFT_CB_ST_COMPLEX if cb_store else -1
+    elif fft_type == CUFFT_C2R:
+        cb_load_type = CUFFT_CB_LD_COMPLEX if cb_load else -1
+        cb_store_type = CUFFT_CB_ST_REAL if cb_store else -1
+    elif fft_type == CUFFT_Z2Z:
+        cb_load_type = CUFFT_CB_LD_COMPLEX_DOUBLE if cb_load else -1
+        cb_store_type = CUFFT_CB_ST_COMPLEX_DOUBLE if cb_store else -1
+    elif fft_type == CUFFT_D2Z:
+        cb_load_type = CUFFT_CB_LD_REAL_DOUBLE if cb_load else -1
+        cb_store_type = CUFFT_CB_ST_COMPLEX_DOUBLE if cb_store else -1
+    elif fft_type == CUFFT_Z2D:
+        cb_load_type = CUFFT_CB_LD_COMPLEX_DOUBLE if cb_load else -1
+        cb_store_type = CUFFT_CB_ST_REAL_DOUBLE if cb_store else -1
+    else:
+        raise ValueError
+    return cb_load_type, cb_store_type
+
+
 # make it a plain Python function so that we can mock-test it
 def get_cache_dir():
     global _callback_cache_dir
@@ -320,6 +430,7 @@ cpdef get_current_callback_manager():
 
 cdef class _CallbackManager:
     cdef:
+        readonly str backend
         readonly str cb_load
         readonly str cb_store
         readonly _ndarray_base cb_load_aux_arr
@@ -336,70 +447,15 @@ cdef class _CallbackManager:
         _sanity_checks(cb_load, cb_store,
                        cb_load_aux_arr, cb_store_aux_arr)
 
+        self.backend = 'legacy'
         self.cb_load = cb_load
         self.cb_store = cb_store
         self.cb_load_aux_arr = cb_load_aux_arr
         self.cb_store_aux_arr = cb_store_aux_arr
 
-        # Set up some variables...
         cdef str arch = get_compute_capability()
-        cdef str tempdir
-        cdef str obj_host
-        cdef str obj_dev
-        cdef str mod_name
-        cdef str mod_filename
-        cdef str cache_dir
-        cdef str path
-        cdef str cufft_lib_pruned
-
-        # For hash; note this is independent of the plan to be created, and
-        # only depends on the given load/store callbacks and the runtime
-        # environment
-        keys = (_cc, _nvcc, arch, _build_ver, _cufft_ver, _cupy_ver,
-                _python_include, cb_load, cb_store)
-        keys = '%s %s %s %s %s %s %s %s %s' % keys
-
-        # Generate module filename: all modules with the identical callbacks
-        # are considered identical regardless of which plan is actually
-        # executed at the time of generation
-        mod_name = 'cupy_callback_'
-        mod_name += hashlib.md5(keys.encode()).hexdigest()
-        mod_name = mod_name.replace('.', '')
-        mod_filename = mod_name + _ext_suffix
-
-        # Check if the module is already cached on disk. If not, we compile.
-        cache_dir = get_cache_dir()
-        if not os.path.isdir(cache_dir):
-            os.makedirs(cache_dir, exist_ok=True)
-        path = os.path.join(cache_dir, mod_filename)
-        if not os.path.isfile(path):
-            # Set up temp directory; it must be under the cache directory so
-            # that atomic moves within the same filesystem can be guaranteed
-            tempdir_obj = tempfile.TemporaryDirectory(dir=cache_dir)
-            tempdir = tempdir_obj.name
-
-            # Cythonize the Cython code to produce a c++ source file
-            _cythonize(tempdir, mod_name)
-
-            # Compile the Python module
-            obj_host = os.path.join(tempdir, mod_name + '.o')
-            _mod_compile(tempdir, mod_name, obj_host)
-
-            # Prune libcufft_static.a for the target arch and cache it
-            cufft_lib_pruned = _prune(
-                tempdir, cache_dir, str(_cufft_ver), arch)
-
-            # Dump and compile device code using nvcc
-            obj_dev = os.path.join(tempdir, mod_name + '_dev.o')
-            _nvcc_compile(tempdir, mod_name, cb_load, cb_store, obj_dev, arch)
-
-            # Use nvcc to link and generate a shared library, and place it in
-            # the disk cache
-            _nvcc_link(tempdir, obj_host, obj_dev, arch, mod_filename,
-                       cache_dir, cufft_lib_pruned)
-
-            # Clean up build directory
-            tempdir_obj.cleanup()
+        cdef str mod_name = _get_mod_name(cb_load, cb_store, arch)
+        cdef str path = _build_module(cb_load, cb_store, arch, mod_name)
 
         # Load the Python module
         spec = importlib.util.spec_from_file_location(mod_name, path)
@@ -429,39 +485,12 @@ cdef class _CallbackManager:
             follow.
 
         '''
-        from cupy.cuda.cufft import (
-            CUFFT_C2C, CUFFT_C2R, CUFFT_R2C,
-            CUFFT_Z2Z, CUFFT_Z2D, CUFFT_D2Z,
-            CUFFT_CB_LD_COMPLEX, CUFFT_CB_LD_COMPLEX_DOUBLE,
-            CUFFT_CB_LD_REAL, CUFFT_CB_LD_REAL_DOUBLE,
-            CUFFT_CB_ST_COMPLEX, CUFFT_CB_ST_COMPLEX_DOUBLE,
-            CUFFT_CB_ST_REAL, CUFFT_CB_ST_REAL_DOUBLE,)
-
         cdef _ndarray_base cb_load_aux_arr = self.cb_load_aux_arr
         cdef _ndarray_base cb_store_aux_arr = self.cb_store_aux_arr
         cdef intptr_t cb_load_ptr=0, cb_store_ptr=0
 
-        fft_type = plan.fft_type
-        if fft_type == CUFFT_C2C:
-            cb_load_type = CUFFT_CB_LD_COMPLEX if self.cb_load else -1
-            cb_store_type = CUFFT_CB_ST_COMPLEX if self.cb_store else -1
-        elif fft_type == CUFFT_R2C:
-            cb_load_type = CUFFT_CB_LD_REAL if self.cb_load else -1
-            cb_store_type = CUFFT_CB_ST_COMPLEX if self.cb_store else -1
-        elif fft_type == CUFFT_C2R:
-            cb_load_type = CUFFT_CB_LD_COMPLEX if self.cb_load else -1
-            cb_store_type = CUFFT_CB_ST_REAL if self.cb_store else -1
-        elif fft_type == CUFFT_Z2Z:
-            cb_load_type = CUFFT_CB_LD_COMPLEX_DOUBLE if self.cb_load else -1
-            cb_store_type = CUFFT_CB_ST_COMPLEX_DOUBLE if self.cb_store else -1
-        elif fft_type == CUFFT_D2Z:
-            cb_load_type = CUFFT_CB_LD_REAL_DOUBLE if self.cb_load else -1
-            cb_store_type = CUFFT_CB_ST_COMPLEX_DOUBLE if self.cb_store else -1
-        elif fft_type == CUFFT_Z2D:
-            cb_load_type = CUFFT_CB_LD_COMPLEX_DOUBLE if self.cb_load else -1
-            cb_store_type = CUFFT_CB_ST_REAL_DOUBLE if self.cb_store else -1
-        else:
-            raise ValueError
+        cb_load_type, cb_store_type = _get_callback_types(
+            plan.fft_type, self.cb_load, self.cb_store)
 
         if self.cb_load:
             if cb_load_aux_arr is not None:
@@ -495,6 +524,138 @@ cdef class _CallbackManager:
         self.cb_store_aux_arr = cb_store_aux_arr
 
 
+# The names of the callbacks in the LTO (JIT) backend. They are called from
+# extern "C" wrappers of the signature that cuFFT expects, so that the user
+# code is name-mangled as usual and inlined by the LTO.
+cdef str _jit_preamble = '''
+typedef float cufftReal;
+typedef double cufftDoubleReal;
+typedef float2 cufftComplex;
+typedef double2 cufftDoubleComplex;
+'''
+
+cdef str _jit_load_wrapper = '''
+extern "C" __device__ ${data_type} cupy_jit_load_callback(
+        void* dataIn, unsigned long long offset, void* callerInfo,
+        void* sharedPointer) {
+    return d_loadCallback(dataIn, offset, callerInfo, sharedPointer);
+}
+'''
+
+cdef str _jit_store_wrapper = '''
+extern "C" __device__ void cupy_jit_store_callback(
+        void* dataOut, unsigned long long offset, ${data_type} element,
+        void* callerInfo, void* sharedPointer) {
+    d_storeCallback(dataOut, offset, element, callerInfo, sharedPointer);
+}
+'''
+
+# indexed by cufftXtCallbackType
+cdef tuple _jit_data_types = (
+    'cufftComplex', 'cufftDoubleComplex', 'cufftReal', 'cufftDoubleReal',
+    'cufftComplex', 'cufftDoubleComplex', 'cufftReal', 'cufftDoubleReal',
+)
+
+cdef dict _jit_ltoir_cache = {}
+
+
+cdef bytes _compile_ltoir(str code, int cb_type, bint is_load, str arch):
+    from cupy.cuda.compiler import _NVRTCProgram
+
+    cdef tuple key = (code, cb_type, arch)
+    cdef bytes ltoir = _jit_ltoir_cache.get(key)
+    if ltoir is not None:
+        return ltoir
+
+    wrapper = _jit_load_wrapper if is_load else _jit_store_wrapper
+    src = _jit_preamble + code + string.Template(wrapper).substitute(
+        data_type=_jit_data_types[cb_type])
+    prog = _NVRTCProgram(src, 'cupy_jit_callback.cu', method='ltoir')
+    try:
+        ltoir, _ = prog.compile(
+            ('-arch=compute_' + arch, '-dlto', '-rdc=true'))
+    except CompileException as e:
+        if _get_bool_env_variable('CUPY_DUMP_CUDA_SOURCE_ON_ERROR', False):
+            e.dump(sys.stderr)
+        raise
+    _jit_ltoir_cache[key] = ltoir
+    return ltoir
+
+
+cdef class _JITCallbackManager(_CallbackManager):
+    # The LTO backend: the callbacks are compiled to LTO-IR with NVRTC and
+    # handed to cuFFT before each plan is made, so that neither nvcc nor the
+    # static cuFFT library is needed.
+
+    def __init__(self,
+                 str cb_load='',
+                 str cb_store='',
+                 _ndarray_base cb_load_aux_arr=None,
+                 _ndarray_base cb_store_aux_arr=None):
+        from cupy.cuda.cufft import getVersion as get_cufft_version
+
+        if runtime._is_hip_environment:
+            raise RuntimeError('hipFFT does not support callbacks')
+        if get_cufft_version() < 11300:
+            raise RuntimeError('LTO callbacks require cuFFT 11.3 or later')
+        if not cb_load and not cb_store:
+            raise ValueError('need to specify either cb_load or cb_store, '
+                             'or both')
+        if cb_load and 'd_loadCallback' not in cb_load:
+            raise ValueError('need to specify d_loadCallback in cb_load')
+        if cb_store and 'd_storeCallback' not in cb_store:
+            raise ValueError('need to specify d_storeCallback in cb_store')
+        if cb_load_aux_arr is not None and not cb_load:
+            raise ValueError('load callback is not given')
+        if cb_store_aux_arr is not None and not cb_store:
+            raise ValueError('store callback is not given')
+
+        self.backend = 'jit'
+        self.cb_load = cb_load
+        self.cb_store = cb_store
+        self.cb_load_aux_arr = cb_load_aux_arr
+        self.cb_store_aux_arr = cb_store_aux_arr
+
+    cdef tuple _get_jit_callbacks(self, int fft_type):
+        cdef str arch = get_compute_capability()
+        cdef list callbacks = []
+        cdef _ndarray_base aux
+
+        cb_load_type, cb_store_type = _get_callback_types(
+            fft_type, self.cb_load, self.cb_store)
+        if self.cb_load:
+            aux = self.cb_load_aux_arr
+            callbacks.append((
+                b'cupy_jit_load_callback',
+                _compile_ltoir(self.cb_load, cb_load_type, True, arch),
+                cb_load_type, 0 if aux is None else aux.data.ptr))
+        if self.cb_store:
+            aux = self.cb_store_aux_arr
+            callbacks.append((
+                b'cupy_jit_store_callback',
+                _compile_ltoir(self.cb_store, cb_store_type, False, arch),
+                cb_store_type, 0 if aux is None else aux.data.ptr))
+        return tuple(callbacks)
+
+    cpdef create_plan(self, tuple plan_info):
+        from cupy.cuda import cufft
+
+        cdef str plan_type
+        cdef tuple plan_args
+
+        plan_type, plan_args = plan_info
+        if plan_type == 'Plan1d':
+            fft_type = plan_args[1]
+        else:  # PlanNd
+            fft_type = plan_args[7]
+        return getattr(cufft, plan_type)(
+            *plan_args, jit_callbacks=self._get_jit_callbacks(fft_type))
+
+    cpdef set_callbacks(self, plan):
+        # the callbacks are already set in create_plan()
+        pass
+
+
 cdef class set_cufft_callbacks:
     """A context manager for setting up load and/or store callbacks.
 
@@ -507,6 +668,10 @@ cdef class set_cufft_callbacks:
             data to be used in the load callback.
         cb_store_aux_arr (cupy.ndarray, optional): A CuPy array containing
             data to be used in the store callback.
+        backend (str): ``'legacy'`` (default) builds and statically links an
+            external module as described below. ``'jit'`` compiles the
+            callbacks to LTO-IR with NVRTC and links them into the plans at
+            runtime; see the note below.
 
     .. note::
         Any FFT calls living in this context will have callbacks set up. An
@@ -539,6 +704,15 @@ cdef class set_cufft_callbacks:
               package from Conda-Forge is not enough, as it does not contain
               static libraries.
 
+    .. note::
+        The ``'jit'`` backend needs cuFFT 11.3 (CUDA 12.6) or later but
+        neither ``nvcc`` nor the static cuFFT library, and the first call for
+        each transform costs only an NVRTC compilation. The callbacks are
+        written as plain device functions named ``d_loadCallback`` and
+        ``d_storeCallback``, of the signatures of ``cufftCallbackLoad*`` and
+        ``cufftCallbackStore*``, respectively; no ``d_*CallbackPtr`` is
+        needed. The offsets are of type ``unsigned long long``.
+
     .. note::
         Callbacks only work for transforms over contiguous axes; the behavior
         for non-contiguous transforms is in general undefined.
@@ -556,7 +730,8 @@ cdef class set_cufft_callbacks:
         ``~/.cupy/callback_cache`` for possible reuse (with the same set of
         load/store callbacks). Due to static linking, however, the file sizes
         can be excessive! The cache position can be changed via setting
-        ``CUPY_CACHE_DIR``.
+        ``CUPY_CACHE_DIR``. The modules can be compiled ahead of time with
+        :func:`warm_up_cufft_callbacks`.
 
     .. seealso:: `cuFFT Callback Routines`_
 
@@ -576,13 +751,20 @@ cdef class set_cufft_callbacks:
                  str cb_store='',
                  *,
                  _ndarray_base cb_load_aux_arr=None,
-                 _ndarray_base cb_store_aux_arr=None):
+                 _ndarray_base cb_store_aux_arr=None,
+                 str backend='legacy'):
+        if backend not in ('legacy', 'jit'):
+            raise ValueError(f'unknown callback backend: {backend}')
+
         # For every distinct pair of load & store callbacks, we compile an
-        # external Python module and cache it.
-        cdef tuple key = (cb_load, cb_store)
+        # external Python module (or the LTO-IR) and cache it.
+        cdef tuple key = (cb_load, cb_store, backend)
         cdef _CallbackManager mgr = _callback_mgr.get(key)
         if mgr is None:
-            mgr = _CallbackManager(
+            mgr_type = (
+                _CallbackManager if backend == 'legacy'
+                else _JITCallbackManager)
+            mgr = mgr_type(
                 cb_load=cb_load,
                 cb_store=cb_store,
                 cb_load_aux_arr=cb_load_aux_arr,
@@ -605,3 +787,53 @@ cdef class set_cufft_callbacks:
         tls._current_cufft_callback = self.mgr_prev
         # do not remove mgr from _callback_mgr, as one might still wanna use
         # plans generated by it in the same Python session
+
+
+def register_cufft_callbacks(str cb_load='', str cb_store=''):
+    """Registers a pair of load and/or store callbacks for warm-up.
+
+    Args:
+        cb_load (str): A string contains the device kernel for the load
+            callback. It must define ``d_loadCallbackPtr``.
+        cb_store (str): A string contains the device kernel for the store
+            callback. It must define ``d_storeCallbackPtr``.
+
+    .. seealso:: :func:`warm_up_cufft_callbacks`
+
+    """
+    cdef tuple key = (cb_load, cb_store)
+    if key not in _registered_callbacks:
+        _registered_callbacks.append(key)
+
+
+def warm_up_cufft_callbacks(callbacks=None, arch=None):
+    """Compiles the modules for cuFFT callbacks ahead of time.
+
+    The modules are placed in the disk cache, so that the first
+    :class:`set_cufft_callbacks` with the same callbacks does not have to
+    compile them. Call this at deploy time to move the compilation out of
+    the service startup.
+
+    Args:
+        callbacks (list of tuple of str): Pairs of ``(cb_load, cb_store)``
+            to compile. Either may be an empty string. If ``None``
+            (default), the pairs registered with
+            :func:`register_cufft_callbacks` are compiled.
+        arch (str): The compute capability to compile for, e.g. ``'80'``.
+            If ``None`` (default), the modules are compiled for the current
+            device, and also loaded into this process. Otherwise they are
+            only compiled, so that no device of that kind is needed.
+
+    """
+    cdef str cb_load, cb_store
+    if callbacks is None:
+        callbacks = list(_registered_callbacks)
+    if not _is_init:
+        _set_vars()
+    for cb_load, cb_store in callbacks:
+        _sanity_checks(cb_load, cb_store, None, None)
+        if arch is None:
+            set_cufft_callbacks(cb_load, cb_store)
+        else:
+            _build_module(cb_load, cb_store, str(arch),
+                          _get_mod_name(cb_load, cb_store, str(arch)))
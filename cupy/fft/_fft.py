@@ -78,6 +78,17 @@ def _convert_fft_type(dtype, value_type):
         raise ValueError
 
 
+def _retry_out_of_memory(func, *args, **kwargs):
+    # Retries once after releasing the work areas of the idle cached plans,
+    # which are then taken from the memory pool.
+    try:
+        return func(*args, **kwargs)
+    except cupy.cuda.memory.OutOfMemoryError:
+        if get_plan_cache().evict_work_areas() == 0:
+            raise
+    return func(*args, **kwargs)
+
+
 def _exec_fft(a, direction, value_type, norm, axis, overwrite_x,
               out_size=None, out=None, plan=None):
     from cupy.cuda import cufft
@@ -147,7 +158,7 @@ def _exec_fft(a, direction, value_type, norm, axis, overwrite_x,
             # still generated from the same external Python module
             load_aux = mgr.cb_load_aux_arr
             store_aux = mgr.cb_store_aux_arr
-            keys += (mgr.cb_load, mgr.cb_store,
+            keys += (mgr.backend, mgr.cb_load, mgr.cb_store,
                      0 if load_aux is None else load_aux.data.ptr,
                      0 if store_aux is None else store_aux.data.ptr)
         cache = get_plan_cache()
@@ -155,14 +166,17 @@ def _exec_fft(a, direction, value_type, norm, axis, overwrite_x,
         if cached_plan is not None:
             plan = cached_plan
         elif mgr is None:
-            plan = cufft.Plan1d(out_size, fft_type, batch, devices=devices)
+            plan = _retry_out_of_memory(
+                cufft.Plan1d, out_size, fft_type, batch, devices=devices,
+                shared_work_area=cache.get_shared_work_area(),
+                deferred_work_area=cache.get_deferred_work_area())
             cache[keys] = plan
         else:  # has callback
             # TODO(leofang): support multi-GPU callback (devices is ignored)
             if devices:
                 raise NotImplementedError('multi-GPU cuFFT callbacks are not '
                                           'yet supported')
-            plan = mgr.create_plan(('Plan1d', keys[:-5]))
+            plan = mgr.create_plan(('Plan1d', keys[:-6]))
             mgr.set_callbacks(plan)
             cache[keys] = plan
     else:
@@ -188,7 +202,7 @@ def _exec_fft(a, direction, value_type, norm, axis, overwrite_x,
         out = plan.get_output_array(a)
 
     if batch != 0:
-        plan.fft(a, out, direction)
+        _retry_out_of_memory(plan.fft, a, out, direction)
 
     sz = out.shape[-1]
     if fft_type == cufft.CUFFT_R2C or fft_type == cufft.CUFFT_D2Z:
@@ -451,7 +465,7 @@ def _get_cufft_plan_nd(
         # still generated from the same external Python module
         load_aux = mgr.cb_load_aux_arr
         store_aux = mgr.cb_store_aux_arr
-        keys += (mgr.cb_load, mgr.cb_store,
+        keys += (mgr.backend, mgr.cb_load, mgr.cb_store,
                  0 if load_aux is None else load_aux.data.ptr,
                  0 if store_aux is None else store_aux.data.ptr)
     cache = get_plan_cache()
@@ -459,11 +473,14 @@ def _get_cufft_plan_nd(
     if cached_plan is not None:
         plan = cached_plan
     elif mgr is None:
-        plan = cufft.PlanNd(*keys)
+        plan = _retry_out_of_memory(
+            cufft.PlanNd, *keys,
+            shared_work_area=cache.get_shared_work_area(),
+            deferred_work_area=cache.get_deferred_work_area())
         if to_cache:
             cache[keys] = plan
     else:  # has callback
-        plan = mgr.create_plan(('PlanNd', keys[:-4]))
+        plan = mgr.create_plan(('PlanNd', keys[:-5]))
         mgr.set_callbacks(plan)
         if to_cache:
             cache[keys] = plan
@@ -557,7 +574,7 @@ def _exec_fftn(a, direction, value_type, norm, axes, overwrite_x,
         plan.check_output_array(a, out)
 
     if out.size != 0:
-        plan.fft(a, out, direction)
+        _retry_out_of_memory(plan.fft, a, out, direction)
 
     # normalize by the product of the shape along the transformed axes
     arr = a if fft_type in (cufft.CUFFT_R2C, cufft.CUFFT_D2Z) else out
@@ -658,8 +675,59 @@ def _default_fft_func(a, s=None, axes=None, plan=None, value_type='C2C'):
                 return _fft
 
         # prefer Plan1D in the 1D case
-        return _fftn
-    return _fft
+        candidates = (_fftn, _fft)
+    elif (axes_sorted == (0,) and a.ndim > 1 and value_type == 'C2C'
+            and a.flags.c_contiguous and not cupy.cuda.runtime.is_hip):
+        # Plan1d transposes the array, while PlanNd reads it with a stride
+        candidates = (_fft, _fftn)
+    else:
+        return _fft
+
+    if (not config.enable_plan_autotuning or config.use_multi_gpus
+            or config.get_current_callback_manager() is not None
+            or a.size == 0
+            or cupy.cuda.get_current_stream().is_capturing()):
+        return candidates[0]
+    return _tuned_fft_func(a, s, axes, value_type, candidates)
+
+
+def _tuned_layout_key(a, s, axes, value_type):
+    if s is not None:
+        s = tuple(s)
+    if axes is not None:
+        axes = tuple(axes)
+    return ('layout', a.shape, a.strides, a.dtype.char, s, axes, value_type)
+
+
+def _tuned_fft_func(a, s, axes, value_type, candidates):
+    # Times each way of running the transform once, after a first call that
+    # creates its plans, and remembers the fastest in the plan cache.
+    from cupy.cuda import cufft
+
+    cache = get_plan_cache()
+    key = _tuned_layout_key(a, s, axes, value_type)
+    func = cache.get_tuned_layout(key)
+    if func is not None:
+        return func
+
+    if value_type == 'C2R':
+        direction = cufft.CUFFT_INVERSE
+    else:
+        direction = cufft.CUFFT_FORWARD
+    start = cupy.cuda.Event()
+    end = cupy.cuda.Event()
+    best_time = None
+    for candidate in candidates:
+        candidate(a, s, axes, None, direction, value_type)
+        start.record()
+        candidate(a, s, axes, None, direction, value_type)
+        end.record()
+        end.synchronize()
+        time = cupy.cuda.get_elapsed_time(start, end)
+        if best_time is None or time < best_time:
+            func, best_time = candidate, time
+    cache.set_tuned_layout(key, func)
+    return func
 
 
 def _compat_caster(a, axes):
@@ -14,6 +14,8 @@ import sys as _sys
 if _sys.platform.startswith('linux'):
     from cupy.fft._callback import get_current_callback_manager  # NOQA
     from cupy.fft._callback import set_cufft_callbacks  # NOQA
+    from cupy.fft._callback import register_cufft_callbacks  # NOQA
+    from cupy.fft._callback import warm_up_cufft_callbacks  # NOQA
 else:
     def get_current_callback_manager(*args, **kwargs):
         return None
@@ -22,8 +24,15 @@ else:
         def __init__(self, *args, **kwargs):
             raise RuntimeError('cuFFT callback is only available on Linux')
 
+    def register_cufft_callbacks(*args, **kwargs):
+        raise RuntimeError('cuFFT callback is only available on Linux')
+
+    def warm_up_cufft_callbacks(*args, **kwargs):
+        raise RuntimeError('cuFFT callback is only available on Linux')
+
 
 enable_nd_planning = True
+enable_plan_autotuning = False
 use_multi_gpus = False
 _devices = None
 
@@ -346,10 +346,9 @@ def polyval(p, x):
         return cupy.zeros(x.shape, dtype)
     if dtype == numpy.bool_:
         return p.any() * x + p[-1]
-    if not cupy.isscalar(x):
-        x = cupy.asarray(x, dtype=dtype)[..., None]
-    x = x ** cupy.arange(p.size, dtype=dtype)
-    return (p[::-1] * x).sum(axis=-1, dtype=dtype)
+    x = cupy.asarray(x, dtype=dtype)
+    c = cupy.ascontiguousarray(p[::-1]).reshape(1, -1)
+    return cupy.polynomial.polynomial._horner(x, c, x.shape)
 
 
 def roots(p):
@@ -369,6 +368,11 @@ def roots(p):
 
         The current `cupy.roots` doesn't guarantee the order of results.
 
+    .. note::
+        The roots of the other polynomials of degree up to 8 are found by
+        Aberth iteration on the device, see
+        :func:`cupy.polynomial.polynomial.polyroots`.
+
     .. seealso:: :func:`numpy.roots`
 
     """
@@ -388,12 +392,16 @@ def roots(p):
         if p[0] == 0:
             out = out.real.astype(numpy.float64)
         return out
-    cmatrix = cupy.polynomial.polynomial.polycompanion(p)
+    polynomial = cupy.polynomial.polynomial
+    cmatrix = polynomial.polycompanion(p)
     # TODO(Dahlia-Chehata): Support after cupy.linalg.eigvals is supported
     if cupy.array_equal(cmatrix, cmatrix.conj().T):
         out = cupy.linalg.eigvalsh(cmatrix)
+    elif p.size - 1 <= polynomial._max_aberth_degree:
+        return polynomial._aberth_roots(p[None])[0]
     else:
         raise NotImplementedError('Only complex Hermitian and real '
                                   'symmetric 2d arrays are supported '
-                                  'currently')
+                                  'currently above degree {}'.format(
+                                      polynomial._max_aberth_degree))
     return out.astype(p.dtype)
@@ -0,0 +1,275 @@
+import numpy
+from numpy import linalg
+
+import cupy
+from cupy._core._scalar import get_typename
+from cupy.cuda import runtime
+import cupyx
+
+
+# Kernels for stacks of matrices up to 32 x 32, one matrix per warp. Lane i
+# keeps the row i of the matrix (and of the right-hand sides) in registers,
+# and the pivot row is broadcast with warp shuffles, so that a matrix is
+# read and written once and no pointer array or workspace is needed.
+_small_code = r'''
+#include <cupy/complex.cuh>
+
+#define FULL_MASK 0xffffffff
+
+__device__ float shfl(float v, int src) {
+    return __shfl_sync(FULL_MASK, v, src);
+}
+__device__ double shfl(double v, int src) {
+    return __shfl_sync(FULL_MASK, v, src);
+}
+template<typename U>
+__device__ complex<U> shfl(complex<U> v, int src) {
+    return complex<U>(shfl(v.real(), src), shfl(v.imag(), src));
+}
+
+// the magnitude used for pivoting, |re| + |im| for complex as in LAPACK
+__device__ double pivot_mag(float v) { return fabsf(v); }
+__device__ double pivot_mag(double v) { return fabs(v); }
+template<typename U>
+__device__ double pivot_mag(complex<U> v) {
+    return fabs((double)v.real()) + fabs((double)v.imag());
+}
+
+__device__ float real_part(float v) { return v; }
+__device__ double real_part(double v) { return v; }
+template<typename U>
+__device__ U real_part(complex<U> v) { return v.real(); }
+
+__device__ float conj_(float v) { return v; }
+__device__ double conj_(double v) { return v; }
+template<typename U>
+__device__ complex<U> conj_(complex<U> v) { return conj(v); }
+
+// Solves a x = b by Gauss-Jordan elimination with partial pivoting. With
+// INVERSE, b is the identity and x is written to out. info is the 1-based
+// index of the first zero pivot, as getrf.
+extern "C" __global__ void small_solve(
+        const T* __restrict__ a, const T* __restrict__ b,
+        T* __restrict__ out, int* __restrict__ info,
+        const long long batch) {
+    const long long mat =
+        ((long long)blockIdx.x * blockDim.x + threadIdx.x) / 32;
+    const int lane = threadIdx.x % 32;
+    if(mat >= batch) {
+        return;  // the whole warp leaves
+    }
+    const bool active = lane < N;
+    const T* am = a + mat * N * N;
+    T r[N];
+    T x[NRHS];
+#pragma unroll
+    for(int j = 0; j < N; j++) {
+        r[j] = active ? am[lane * N + j] : T(0);
+    }
+#ifdef INVERSE
+#pragma unroll
+    for(int j = 0; j < NRHS; j++) {
+        x[j] = (lane == j) ? T(1) : T(0);
+    }
+#else
+    const T* bm = b + mat * N * NRHS;
+#pragma unroll
+    for(int j = 0; j < NRHS; j++) {
+        x[j] = active ? bm[lane * NRHS + j] : T(0);
+    }
+#endif
+
+    int pos = lane;  // the row of the matrix the lane now holds
+    int singular = 0;
+#pragma unroll
+    for(int k = 0; k < N; k++) {
+        // the largest pivot among the rows not eliminated yet, the first
+        // row on ties
+        double mag = (active && pos >= k) ? pivot_mag(r[k]) : -1.0;
+        int p = lane;
+        int q = pos;
+#pragma unroll
+        for(int offset = 16; offset > 0; offset /= 2) {
+            const double mag2 = __shfl_xor_sync(FULL_MASK, mag, offset);
+            const int p2 = __shfl_xor_sync(FULL_MASK, p, offset);
+            const int q2 = __shfl_xor_sync(FULL_MASK, q, offset);
+            if(mag2 > mag || (mag2 == mag && q2 < q)) {
+                mag = mag2;
+                p = p2;
+                q = q2;
+            }
+        }
+        if(pos == k) {
+            pos = q;
+        } else if(lane == p) {
+            pos = k;
+        }
+        if(mag == 0) {
+            if(singular == 0) {
+                singular = k + 1;
+            }
+            continue;
+        }
+        const T piv = shfl(r[k], p);
+        const T f = (lane == p) ? T(1) / piv : r[k] / piv;
+#pragma unroll
+        for(int j = k + 1; j < N; j++) {
+            const T pj = shfl(r[j], p);
+            r[j] = (lane == p) ? pj * f : r[j] - f * pj;
+        }
+#pragma unroll
+        for(int j = 0; j < NRHS; j++) {
+            const T pj = shfl(x[j], p);
+            x[j] = (lane == p) ? pj * f : x[j] - f * pj;
+        }
+    }
+
+    if(active) {
+        T* om = out + mat * N * NRHS;
+#pragma unroll
+        for(int j = 0; j < NRHS; j++) {
+            om[pos * NRHS + j] = x[j];
+        }
+    }
+    if(lane == 0) {
+        info[mat] = singular;
+    }
+}
+
+// The lower Cholesky factor of the lower triangle of a. info is the
+// 1-based index of the first non-positive pivot, as potrf.
+extern "C" __global__ void small_cholesky(
+        const T* __restrict__ a, T* __restrict__ out,
+        int* __restrict__ info, const long long batch) {
+    const long long mat =
+        ((long long)blockIdx.x * blockDim.x + threadIdx.x) / 32;
+    const int lane = threadIdx.x % 32;
+    if(mat >= batch) {
+        return;
+    }
+    const bool active = lane < N;
+    const T* am = a + mat * N * N;
+    T r[N];
+#pragma unroll
+    for(int j = 0; j < N; j++) {
+        r[j] = (active && j <= lane) ? am[lane * N + j] : T(0);
+    }
+
+    int failed = 0;
+#pragma unroll
+    for(int k = 0; k < N; k++) {
+        const R d = real_part(shfl(r[k], k));
+        if(!(d > 0) && failed == 0) {
+            failed = k + 1;
+        }
+        const R s = sqrt(d);
+        if(lane == k) {
+            r[k] = T(s);
+        } else if(lane > k) {
+            r[k] = r[k] / s;
+        }
+#pragma unroll
+        for(int j = k + 1; j < N; j++) {
+            const T ljk = shfl(r[k], j);
+            if(lane >= j) {
+                r[j] = r[j] - r[k] * conj_(ljk);
+            }
+        }
+    }
+
+    if(active) {
+        T* om = out + mat * N * N;
+#pragma unroll
+        for(int j = 0; j < N; j++) {
+            om[lane * N + j] = (j <= lane) ? r[j] : T(0);
+        }
+    }
+    if(lane == 0) {
+        info[mat] = failed;
+    }
+}
+'''
+
+_MAX_SIZE = 32
+_WARPS_PER_BLOCK = 4
+
+
+@cupy.memoize(for_each_device=True)
+def _get_kernel(name, dtype, n, nrhs=0, inverse=False):
+    real = numpy.dtype(dtype.char.lower())
+    code = '#define T {}\n#define R {}\n#define N {}\n#define NRHS {}\n'
+    code = code.format(get_typename(dtype), get_typename(real), n,
+                       max(nrhs, 1))
+    if inverse:
+        code += '#define INVERSE\n'
+    return cupy.RawKernel(code + _small_code, name, options=('-std=c++11',))
+
+
+def available(a, nrhs=None):
+    """Tells if the stack of matrices ``a`` is solved by these kernels."""
+    n = a.shape[-1]
+    return (not runtime.is_hip and a.ndim > 2 and 0 < n <= _MAX_SIZE
+            and (nrhs is None or nrhs <= _MAX_SIZE))
+
+
+def _launch(kernel, batch, *args):
+    threads = 32 * _WARPS_PER_BLOCK
+    kernel(((batch + _WARPS_PER_BLOCK - 1) // _WARPS_PER_BLOCK,), (threads,),
+           args + (numpy.int64(batch),))
+
+
+def _check_info(name, info):
+    # Mirrors the checks of the cuSOLVER and cuBLAS info arrays.
+    config_linalg = cupyx._ufunc_config.get_config_linalg()
+    if config_linalg == 'ignore':
+        return
+    assert config_linalg == 'raise'
+    if (info != 0).any():
+        raise linalg.LinAlgError(
+            'Error reported by {}. info = {}.'.format(name, info))
+
+
+def solve(a, b, dtype, out_dtype):
+    # a is (..., n, n), and b is (..., n) or (..., n, k) of the same batch.
+    n = a.shape[-1]
+    vector = b.ndim == a.ndim - 1
+    nrhs = 1 if vector else b.shape[-1]
+    if b.size == 0:
+        return cupy.empty(b.shape, out_dtype)
+    batch = b.size // (n * nrhs)
+    a_ = cupy.ascontiguousarray(a, dtype=dtype)
+    b_ = cupy.ascontiguousarray(b, dtype=dtype)
+    x = cupy.empty(b.shape, dtype)
+    info = cupy.empty(batch, dtype=numpy.int32)
+    _launch(_get_kernel('small_solve', numpy.dtype(dtype), n, nrhs), batch,
+            a_, b_, x, info)
+    _check_info('small_solve', info)
+    return x.astype(out_dtype, copy=False)
+
+
+def inv(a, dtype, out_dtype):
+    n = a.shape[-1]
+    if a.size == 0:
+        return cupy.empty(a.shape, out_dtype)
+    batch = a.size // (n * n)
+    a_ = cupy.ascontiguousarray(a, dtype=dtype)
+    x = cupy.empty(a.shape, dtype)
+    info = cupy.empty(batch, dtype=numpy.int32)
+    _launch(_get_kernel('small_solve', numpy.dtype(dtype), n, n, True), batch,
+            a_, a_, x, info)
+    _check_info('small_inv', info)
+    return x.astype(out_dtype, copy=False)
+
+
+def cholesky(a, dtype, out_dtype):
+    n = a.shape[-1]
+    if a.size == 0:
+        return cupy.empty(a.shape, out_dtype)
+    batch = a.size // (n * n)
+    a_ = cupy.ascontiguousarray(a, dtype=dtype)
+    x = cupy.empty(a.shape, dtype)
+    info = cupy.empty(batch, dtype=numpy.int32)
+    _launch(_get_kernel('small_cholesky', numpy.dtype(dtype), n), batch,
+            a_, x, info)
+    _check_info('small_cholesky', info)
+    return x.astype(out_dtype, copy=False)
@@ -4,6 +4,7 @@ import cupy
 from cupy_backends.cuda.api import runtime
 from cupy._core import internal
 from cupy.cuda import device
+from cupy.linalg import _batched_small
 from cupy.linalg import _util
 
 
@@ -48,7 +49,12 @@ def _lu_factor(a_t, dtype):
     # TODO(kataoka): autotune
     use_batched = batch_size * 65536 >= n * n
 
-    if use_batched:
+    if use_batched and runtime.is_hip:
+        # rocSOLVER takes the strided batch as is, without a pointer array
+        from cupyx.cusolver import _getrf_strided_batched
+        _getrf_strided_batched(a_t, ipiv, dev_info)
+
+    elif use_batched:
         handle = device.get_cublas_handle()
         lda = n
         step = n * lda * a_t.itemsize
@@ -138,16 +144,23 @@ def _potrf_batched(a):
         potrfBatched = cusolver.zpotrfBatched
 
     x = a.astype(dtype, order='C', copy=True)
-    xp = cupy._core._mat_ptrs(x)
     n = x.shape[-1]
     ldx = x.strides[-2] // x.dtype.itemsize
-    handle = device.get_cusolver_handle()
     batch_size = internal.prod(x.shape[:-2])
     dev_info = cupy.empty(batch_size, dtype=numpy.int32)
 
-    potrfBatched(
-        handle, cublas.CUBLAS_FILL_MODE_UPPER, n, xp.data.ptr, ldx,
-        dev_info.data.ptr, batch_size)
+    if runtime.is_hip:
+        # rocSOLVER takes the strided batch as is, without a pointer array
+        from cupyx.cusolver import _potrf_strided_batched
+        _potrf_strided_batched(
+            x.reshape(batch_size, n, n), cublas.CUBLAS_FILL_MODE_UPPER,
+            dev_info)
+    else:
+        xp = cupy._core._mat_ptrs(x)
+        handle = device.get_cusolver_handle()
+        potrfBatched(
+            handle, cublas.CUBLAS_FILL_MODE_UPPER, n, xp.data.ptr, ldx,
+            dev_info.data.ptr, batch_size)
     cupy.linalg._util._check_cusolver_dev_info_if_synchronization_allowed(
         potrfBatched, dev_info)
 
@@ -184,6 +197,9 @@ def cholesky(a):
     _util._assert_stacked_2d(a)
     _util._assert_stacked_square(a)
 
+    if _batched_small.available(a):
+        dtype, out_dtype = _util.linalg_common_type(a)
+        return _batched_small.cholesky(a, dtype, out_dtype)
     if a.ndim > 2:
         return _potrf_batched(a)
 
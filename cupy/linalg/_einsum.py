@@ -1,4 +1,5 @@
 import copy
+import functools
 import itertools
 import operator
 import string
@@ -282,6 +283,22 @@ def _iter_path_pairs(path):
                 yield -1, idx
 
 
+_optimize_algorithms = {
+    'greedy': _greedy_path,
+    'optimal': _optimal_path,
+}
+
+
+@functools.lru_cache(maxsize=1024)
+def _search_path(algo, memory_limit, input_subscripts, output_subscript,
+                 dimensions):
+    # The contraction path of the (hashable) reduced subscripts, memoized
+    # as the search often costs as much as small contractions.
+    input_sets = [set(sub) for sub in input_subscripts]
+    return tuple(_optimize_algorithms[algo](
+        input_sets, set(output_subscript), dict(dimensions), memory_limit))
+
+
 def _flatten_transpose(a, axeses):
     """Transpose and flatten each
 
@@ -317,6 +334,11 @@ def _use_cutensor(dtype0, sub0, dtype1, sub1, batch_dims, contract_dims):
     return True
 
 
+def _cutensor_operand(a):
+    view = cutensor._strided_operand(a)
+    return cupy.ascontiguousarray(a) if view is None else view
+
+
 def _get_out_shape(shape0, sub0, shape1, sub1, sub_out):
     extent = {}
     for size, i in zip(shape0 + shape1, sub0 + sub1):
@@ -406,8 +428,9 @@ def reduced_binary_einsum(arr0, sub0, arr1, sub1, sub_others):
                 out_shape = _get_out_shape(
                     arr0.shape, sub0, arr1.shape, sub1, sub_out)
                 arr_out = cupy.empty(out_shape, arr0.dtype)
-                arr0 = cupy.ascontiguousarray(arr0)
-                arr1 = cupy.ascontiguousarray(arr1)
+                # cuTENSOR takes the permuted operands as they are
+                arr0 = _cutensor_operand(arr0)
+                arr1 = _cutensor_operand(arr1)
                 arr_out = cutensor.contraction(
                     1.0,
                     arr0, sub0,
@@ -492,6 +515,7 @@ def einsum(*operands, **kwargs):
     .. seealso:: :func:`numpy.einsum`
     .. _cuQuantum Python: https://docs.nvidia.com/cuda/cuquantum/python/
     """
+    plan = kwargs.pop('_plan', None)
     out = _try_use_cutensornet(*operands, **kwargs)
     if out is not None:
         return out
@@ -639,32 +663,36 @@ def einsum(*operands, **kwargs):
 
     # no more casts
 
-    optimize_algorithms = {
-        'greedy': _greedy_path,
-        'optimal': _optimal_path,
-    }
-    if optimize is False:
+    if plan is not None and plan._path is not None:
+        path = plan._path
+    elif optimize is False:
         path = [tuple(range(len(operands)))]
     elif len(optimize) and (optimize[0] == 'einsum_path'):
         path = optimize[1:]
     else:
         try:
             if len(optimize) == 2 and isinstance(optimize[1], (int, float)):
-                algo = optimize_algorithms[optimize[0]]
+                algo = optimize[0]
                 memory_limit = int(optimize[1])
             else:
-                algo = optimize_algorithms[optimize]
+                algo = optimize
                 memory_limit = 2 ** 31  # TODO(kataoka): fix?
+            if algo not in _optimize_algorithms:
+                raise KeyError(algo)
         except (TypeError, KeyError):  # unhashable type or not found
             raise TypeError('Did not understand the path (optimize): %s'
                             % str(optimize))
-        input_sets = [set(sub) for sub in input_subscripts]
-        output_set = set(output_subscript)
-        path = algo(input_sets, output_set, dimension_dict, memory_limit)
+        path = _search_path(
+            algo, memory_limit,
+            tuple(tuple(sub) for sub in input_subscripts),
+            tuple(output_subscript),
+            tuple(sorted(dimension_dict.items())))
         if any(len(indices) > 2 for indices in path):
             warnings.warn(
                 'memory efficient einsum is not supported yet',
                 _util.PerformanceWarning)
+    if plan is not None:
+        plan._path = path
 
     for idx0, idx1 in _iter_path_pairs(path):
         # "reduced" binary einsum
@@ -696,3 +724,96 @@ def einsum(*operands, **kwargs):
     ])
     assert returns_view or arr_out.dtype == result_dtype
     return arr_out
+
+
+class EinsumPlan:
+    """A planned :func:`cupy.einsum` for operands of fixed shapes and dtypes.
+
+    The contraction path is searched at the first call and reused by the
+    following ones, and the cuTENSOR descriptors, plans and workspace sizes
+    of the pairwise contractions are cached by their shapes and dtypes.
+    Plans are created by :func:`cupyx.einsum_plan`.
+    """
+
+    def __init__(self, subscripts, shapes, dtypes, dtype, optimize):
+        self.subscripts = subscripts
+        self.shapes = shapes
+        self.dtypes = dtypes
+        self.dtype = dtype
+        self.optimize = optimize
+        self._path = None
+
+    @property
+    def path(self):
+        """The pairwise contraction path, or ``None`` before the first call.
+        """
+        return None if self._path is None else list(self._path)
+
+    def __call__(self, *operands):
+        """Evaluates the planned summation on the operands.
+
+        Args:
+            operands (sequence of cupy.ndarray): The arrays, with the shapes
+                and dtypes the plan was created for.
+
+        Returns:
+            cupy.ndarray: The result of :func:`cupy.einsum`.
+        """
+        if len(operands) != len(self.shapes):
+            raise ValueError('the plan takes {} operands, got {}'.format(
+                len(self.shapes), len(operands)))
+        for i, (arr, shape, dtype) in enumerate(
+                zip(operands, self.shapes, self.dtypes)):
+            if arr.shape != shape or arr.dtype != dtype:
+                raise ValueError(
+                    'operand {} must have shape {} and dtype {}, got {} and '
+                    '{}'.format(i, shape, dtype, arr.shape, arr.dtype))
+        return einsum(self.subscripts, *operands, dtype=self.dtype,
+                      optimize=self.optimize, _plan=self)
+
+    def __repr__(self):
+        return 'EinsumPlan({!r}, shapes={}, path={})'.format(
+            self.subscripts, self.shapes, self.path)
+
+
+def einsum_plan(subscripts, *operands, dtype=None, optimize='greedy'):
+    """Creates a plan of :func:`cupy.einsum` to evaluate repeatedly.
+
+    Args:
+        subscripts (str): Specifies the subscripts for summation, as for
+            :func:`cupy.einsum`.
+        operands (sequence of arrays or shapes): The operands, or their
+            shapes (tuples of ints) for ``float64`` operands.
+        dtype: The data type of the calculation, as for :func:`cupy.einsum`.
+        optimize: The path optimization, as for :func:`cupy.einsum`.
+            Defaults to ``'greedy'``.
+
+    Returns:
+        EinsumPlan: The plan. Calling it with the operands gives the result
+        of ``cupy.einsum(subscripts, *operands, dtype=dtype,
+        optimize=optimize)``, without searching the contraction path again.
+
+    .. note::
+        This function is specific to CuPy.
+
+    Example:
+        >>> plan = cupyx.einsum_plan('ij,jk,kl->il', (8, 64), (64, 64),
+        ...                          (64, 8))
+        >>> a, b, c = [cupy.random.random(s) for s in plan.shapes]
+        >>> out = plan(a, b, c)
+
+    .. seealso:: :func:`cupy.einsum`
+    """
+    if not isinstance(subscripts, str):
+        raise TypeError('subscripts must be a string')
+    shapes = []
+    dtypes = []
+    for op in operands:
+        if isinstance(op, tuple):
+            shapes.append(tuple(int(d) for d in op))
+            dtypes.append(cupy.dtype(cupy.float64))
+        else:
+            shapes.append(op.shape)
+            dtypes.append(op.dtype)
+    return EinsumPlan(subscripts, tuple(shapes), tuple(dtypes), dtype,
+                      optimize)
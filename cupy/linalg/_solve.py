@@ -4,6 +4,7 @@ from numpy import linalg
 import cupy
 from cupy._core import internal
 from cupy.cuda import device
+from cupy.linalg import _batched_small
 from cupy.linalg import _decomposition
 from cupy.linalg import _util
 import cupyx
@@ -54,6 +55,12 @@ def solve(a, b):
             "a must have (..., M, M) shape and b must have (..., M, K) "
             "for multidimensional b")
 
+    nrhs = 1 if b.ndim == a.ndim - 1 else b.shape[-1]
+    if _batched_small.available(a, nrhs):
+        # Tiny matrices are dominated by the launches of batched_gesv
+        dtype, out_dtype = _util.linalg_common_type(a, b)
+        return _batched_small.solve(a, b, dtype, out_dtype)
+
     if a.ndim > 2 and a.shape[-1] <= get_batched_gesv_limit():
         # Note: There is a low performance issue in batched_gesv when matrix is
         # large, so it is not used in such cases.
@@ -278,6 +285,8 @@ def _batched_inv(a):
 
     if 0 in a.shape:
         return cupy.empty_like(a, dtype=out_dtype)
+    if _batched_small.available(a):
+        return _batched_small.inv(a, dtype, out_dtype)
     a_shape = a.shape
 
     # copy is necessary to present `a` to be overwritten.
@@ -1,4 +1,156 @@
+import numpy
+
 import cupy
+from cupy import _util
+
+
+_horner_preamble = r'''
+template<int D, typename T>
+__device__ T horner(const T* c, const T x, const int deg) {
+    // `D` is the degree, or -1 when it is only known at run time
+    const int n = D < 0 ? deg : D;
+    T y = c[n];
+    #pragma unroll
+    for (int k = n - 1; k >= 0; k--) {
+        y = c[k] + y * x;
+    }
+    return y;
+}
+'''
+
+# The degrees up to which the Horner loop is unrolled
+_max_unrolled_degree = 16
+
+
+@_util.memoize(for_each_device=True)
+def _get_horner_kernel(deg):
+    return cupy._core.ElementwiseKernel(
+        'T x, raw T c, int64 n_points, int32 deg', 'T y',
+        'y = horner<%d>(&c[i / n_points * (deg + 1)], x, deg)' % deg,
+        'cupy_polyval_horner', preamble=_horner_preamble)
+
+
+def _horner(x, c, shape):
+    # Evaluates the polynomials in the rows of `c`, whose coefficients are
+    # ordered from low to high degree, in a single kernel. Each polynomial
+    # gives consecutive elements of the result of `shape`, and `x` is
+    # broadcast to `shape`.
+    y = cupy.empty(shape, dtype=c.dtype)
+    if y.size == 0:
+        return y
+    deg = c.shape[1] - 1
+    kernel = _get_horner_kernel(deg if deg <= _max_unrolled_degree else -1)
+    kernel(x.astype(c.dtype, copy=False), c, y.size // c.shape[0], deg, y)
+    return y
+
+
+_aberth_code = r'''
+#include <cupy/complex.cuh>
+#include <cupy/math_constants.h>
+
+// Finds the D roots of each polynomial of the rows of `c`, whose
+// coefficients are ordered from low to high degree, by Aberth iteration.
+// The roots are updated in turn with the others already updated.
+extern "C" __global__ void aberth_roots(
+        const long long n, const complex<T>* __restrict__ c,
+        complex<T>* roots, const T tol, const int max_iter) {
+    const long long tid = (long long)blockIdx.x * blockDim.x + threadIdx.x;
+    if (tid >= n) {
+        return;
+    }
+    const complex<T>* p = c + tid * (D + 1);
+    complex<T>* z = roots + tid * D;
+    const complex<T> lead = p[D];
+    if (lead == complex<T>(0)) {
+        // The degree is lower than the others
+        for (int k = 0; k < D; k++) {
+            z[k] = complex<T>(CUDART_NAN, CUDART_NAN);
+        }
+        return;
+    }
+
+    complex<T> a[D];
+    complex<T> w[D];
+    for (int k = 0; k < D; k++) {
+        a[k] = p[k] / lead;
+    }
+    // The initial roots are on a circle holding all the roots, and all the
+    // roots are zero if its radius is zero
+    T r = 0;
+    for (int k = 0; k < D; k++) {
+        r = max(r, pow(abs(a[k]), T(1) / (D - k)));
+    }
+    for (int k = 0; k < D; k++) {
+        w[k] = thrust::polar(r, T(2 * CUDART_PI * k / D + 0.4));
+    }
+
+    for (int iter = 0; r != 0 && iter < max_iter; iter++) {
+        bool converged = true;
+        for (int k = 0; k < D; k++) {
+            // The value and the derivative of the monic polynomial
+            complex<T> v = complex<T>(1);
+            complex<T> dv = complex<T>(0);
+            for (int j = D - 1; j >= 0; j--) {
+                dv = dv * w[k] + v;
+                v = v * w[k] + a[j];
+            }
+            if (v == complex<T>(0)) {
+                continue;
+            }
+            complex<T> s = complex<T>(0);
+            for (int j = 0; j < D; j++) {
+                if (j != k) {
+                    s += T(1) / (w[k] - w[j]);
+                }
+            }
+            const complex<T> den = dv - v * s;
+            if (den == complex<T>(0)) {
+                converged = false;
+                continue;
+            }
+            const complex<T> step = v / den;
+            w[k] -= step;
+            if (!(abs(step) <= tol * abs(w[k]))) {
+                converged = false;
+            }
+        }
+        if (converged) {
+            break;
+        }
+    }
+    for (int k = 0; k < D; k++) {
+        z[k] = w[k];
+    }
+}
+'''
+
+# The degrees whose roots are found by Aberth iteration
+_max_aberth_degree = 8
+_aberth_max_iter = 100
+
+
+@_util.memoize(for_each_device=True)
+def _get_aberth_kernel(deg, dtype):
+    code = '#define D {}\n#define T {}\n'.format(
+        deg, 'float' if dtype == numpy.complex64 else 'double')
+    return cupy.RawKernel(code + _aberth_code, 'aberth_roots')
+
+
+def _aberth_roots(c):
+    # The roots of the polynomials in the rows of `c`, whose coefficients
+    # are ordered from low to high degree, sorted in each row
+    dtype = numpy.complex64 if c.dtype.char in 'efF' else numpy.complex128
+    c = cupy.ascontiguousarray(c, dtype=dtype)
+    n, deg = c.shape[0], c.shape[1] - 1
+    roots = cupy.empty((n, deg), dtype=dtype)
+    if roots.size == 0:
+        return roots
+    finfo = numpy.finfo(dtype)
+    block_size = 128
+    kernel = _get_aberth_kernel(deg, dtype)
+    kernel(((n + block_size - 1) // block_size,), (block_size,),
+           (n, c, roots, finfo.dtype.type(finfo.eps * 4), _aberth_max_iter))
+    return cupy.sort(roots, axis=-1)
 
 
 def polyvander(x, deg):
@@ -109,6 +261,19 @@ def polyval(x, c, tensor=True):
         c = c + 0.0
     if isinstance(x, (tuple, list)):
         x = cupy.asarray(x)
+    if (isinstance(x, cupy.ndarray) and len(c) > 0
+            and x.dtype.kind in 'biufc' and c.dtype.kind in 'fc'):
+        # All the Horner steps in one kernel
+        dtype = numpy.result_type(c.dtype, x.dtype)
+        if tensor:
+            shape = c.shape[1:] + x.shape
+            c = c.reshape(len(c), -1)
+        else:
+            shape = numpy.broadcast_shapes(c.shape[1:], x.shape)
+            c = cupy.broadcast_to(c, c.shape[:1] + shape)
+            c = c.reshape(len(c), -1)
+        c = cupy.ascontiguousarray(c.T, dtype=dtype)
+        return _horner(x, c, shape)
     if isinstance(x, cupy.ndarray) and tensor:
         c = c.reshape(c.shape + (1,)*x.ndim)
 
@@ -179,3 +344,58 @@ def polyvalfromroots(x, r, tensor=True):
         elif x.ndim >= r.ndim:
             raise ValueError("x.ndim must be < r.ndim when tensor == False")
     return cupy.prod(x - r, axis=0)
+
+
+def polyroots(c):
+    """Computes the roots of a polynomial.
+
+    Args:
+        c (cupy.ndarray): Array of polynomial coefficients ordered from low
+            to high degree. If `c` is multidimensional, the remaining
+            indices enumerate polynomials of the same degree, whose roots
+            are found together.
+
+    Returns:
+        cupy.ndarray: The roots. For a 1-D `c`, the roots are sorted. For a
+        multidimensional `c`, the first index is the root index, as in
+        :func:`polyvalfromroots`, and the roots of each polynomial are
+        sorted.
+
+    .. note::
+        The roots of the polynomials of degree up to 8 are found by Aberth
+        iteration, with a thread per polynomial, and are complex. The
+        polynomials of a multidimensional `c` whose leading coefficients
+        are zero have NaN roots. The roots of 1-D polynomials of higher
+        degrees are the eigenvalues of their companion matrices, which are
+        supported when the matrices are Hermitian.
+
+    .. seealso:: :func:`numpy.polynomial.polynomial.polyroots`
+    """
+    c = cupy.asarray(c)
+    if c.ndim > 1:
+        if c.dtype.kind not in 'biufc':
+            raise TypeError('Coefficient arrays must be numeric')
+        deg = c.shape[0] - 1
+        if deg > _max_aberth_degree:
+            raise NotImplementedError(
+                'Batched roots are supported up to degree {}'.format(
+                    _max_aberth_degree))
+        if deg < 1:
+            raise ValueError(
+                'Series must have maximum degree of at least 1.')
+        roots = _aberth_roots(cupy.moveaxis(c, 0, -1).reshape(-1, deg + 1))
+        return cupy.moveaxis(roots.reshape(c.shape[1:] + (deg,)), -1, 0)
+
+    [c] = cupy.polynomial.polyutils.as_series([c])
+    if c.size < 2:
+        return cupy.array([], dtype=c.dtype)
+    if c.size == 2:
+        return (-c[0] / c[1])[None]
+    if c.size - 1 <= _max_aberth_degree:
+        return _aberth_roots(c[None])[0]
+    matrix = polycompanion(c)
+    if not cupy.array_equal(matrix, matrix.conj().T):
+        raise NotImplementedError(
+            'Only complex Hermitian and real symmetric companion matrices '
+            'are supported above degree {}'.format(_max_aberth_degree))
+    return cupy.sort(cupy.linalg.eigvalsh(matrix))
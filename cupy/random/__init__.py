@@ -113,3 +113,7 @@ from cupy.random._bit_generator import BitGenerator  # NOQA
 from cupy.random._bit_generator import XORWOW  # NOQA
 from cupy.random._bit_generator import MRG32k3a  # NOQA
 from cupy.random._bit_generator import Philox4x3210  # NOQA
+from cupy.random._bit_generator import Philox4x3210Counter  # NOQA
+from cupy.random._bit_generator import Philox4x3210Sharded  # NOQA
+from cupy.random._bit_generator import Sobol  # NOQA
+from cupy.random._bit_generator import Halton  # NOQA
@@ -22,6 +22,10 @@ cdef extern from 'cupy_distributions.cuh' nogil:
         CURAND_XOR_WOW
         CURAND_MRG32k3a
         CURAND_PHILOX_4x32_10
+        CURAND_PHILOX_4x32_10_COUNTER
+        CURAND_PHILOX_4x32_10_SHARDED
+        QUASI_SOBOL
+        QUASI_HALTON
 
 
 class BitGenerator:
@@ -61,6 +65,10 @@ class BitGenerator:
         """
         return 0
 
+    def _advance(self, size):
+        """Called after each launch that drew ``size`` elements."""
+        pass
+
     def _check_device(self):
         if cupy.cuda.get_device_id() != self._current_device_id:
             raise RuntimeError(
@@ -187,3 +195,291 @@ class Philox4x3210(_cuRANDGenerator):
 
     def _type_size(self):
         return sizeof(curandStatePhilox4_32_10_t)
+
+
+class Philox4x3210Counter(BitGenerator):
+    """BitGenerator that uses a stateless, counter-based Philox4x3210.
+
+    Unlike :class:`Philox4x3210`, no per-thread state is kept in device
+    memory. Each launch derives the generator of every thread from the seed,
+    a launch counter and the thread index, so creating the generator costs
+    no kernel launch and no allocation.
+
+    Args:
+        seed (int, array_like[ints], numpy.random.SeedSequence, optional):
+            A seed to initialize the `BitGenerator`. If None, then fresh,
+            unpredictable entropy will be pulled from the OS. If an ``int`` or
+            ``array_like[ints]`` is passed, then it will be passed to
+            ~`numpy.random.SeedSequence` to derive the initial `BitGenerator`
+            state. One may also pass in a `SeedSequence` instance.
+        size (int): Number of threads used per launch. Defaults to
+            ``8 * 256`` times the number of multiprocessors.
+    """
+    generator = CURAND_PHILOX_4x32_10_COUNTER
+
+    def __init__(self, seed=None, *, size=-1):
+        super().__init__(seed)
+        self._seed = int(self._seed_seq.generate_state(1, numpy.uint32)[0])
+        if size < 0:
+            size = 8 * 256 * runtime.deviceGetAttribute(
+                runtime.cudaDevAttrMultiProcessorCount,
+                self._current_device_id)
+        self._size = size
+        self._counter = 0
+
+    def random_raw(self, size=None, output=True):
+        """Return randoms as generated by the underlying BitGenerator.
+
+        Args:
+            size (int or tuple of ints, optional):
+                Output shape.  If the given shape is, e.g., ``(m, n, k)``, then
+                ``m * n * k`` samples are drawn.  Default is None, in which
+                case a single value is returned.
+            output (bool, optional):
+                Output values.  Used for performance testing since the
+                generated values are not returned.
+
+        Returns:
+            cupy.ndarray: Drawn samples.
+
+        """
+        from cupy.random._generator_api import random_raw
+
+        shape = size if size is not None else ()
+        y = cupy.zeros(shape, dtype=numpy.int32)
+        random_raw(self, y)
+        return y if output else None
+
+    def advance(self, delta):
+        """Skips the next ``delta`` launches.
+
+        Args:
+            delta (int): Number of launches to skip.
+
+        Returns:
+            Philox4x3210Counter: This generator.
+        """
+        with self.lock:
+            self._counter = (self._counter + delta) & 0xffffffff
+        return self
+
+    def state(self):
+        # The key passed to the kernels instead of a state pointer; every
+        # launch takes the next counter value.
+        self._check_device()
+        with self.lock:
+            key = (self._seed << 32) | self._counter
+            self._counter = (self._counter + 1) & 0xffffffff
+        # Reinterpret as signed so that it fits in intptr_t
+        return key - (1 << 64) if key >> 63 else key
+
+    def _state_size(self):
+        return self._size
+
+
+class Philox4x3210Sharded(Philox4x3210Counter):
+    """BitGenerator that splits one Philox4x3210 stream into shards.
+
+    Every output element is drawn from its own Philox subsequence, selected
+    by the element index within the launch. A fill can therefore be split
+    into shards that run on different streams or devices, and their
+    concatenation is bitwise identical to the same fill done at once,
+    whatever the number of shards.
+
+    Args:
+        seed (int, array_like[ints], numpy.random.SeedSequence, optional):
+            A seed to initialize the `BitGenerator`. If None, then fresh,
+            unpredictable entropy will be pulled from the OS. If an ``int`` or
+            ``array_like[ints]`` is passed, then it will be passed to
+            ~`numpy.random.SeedSequence` to derive the initial `BitGenerator`
+            state. One may also pass in a `SeedSequence` instance.
+        size (int): Number of threads used per launch. Defaults to
+            ``8 * 256`` times the number of multiprocessors.
+        start (int): Index of the first element drawn by this shard.
+
+    .. note::
+        Use :meth:`shard` to create the shards of a generator. A shard
+        performs the same sequence of launches as its parent, but draws the
+        elements from ``start`` onwards.
+    """
+    generator = CURAND_PHILOX_4x32_10_SHARDED
+
+    def __init__(self, seed=None, *, size=-1, start=0):
+        super().__init__(seed, size=size)
+        if start < 0:
+            raise ValueError('start must be non-negative')
+        self._start = start
+        self._params = None
+
+    def shard(self, start):
+        """Returns a shard of this generator for the current device.
+
+        Args:
+            start (int): Index of the first element drawn by the shard in
+                each launch.
+
+        Returns:
+            Philox4x3210Sharded: A generator positioned at the same launch
+            as this one.
+        """
+        shard = Philox4x3210Sharded(self._seed_seq, start=start)
+        with self.lock:
+            shard._counter = self._counter
+        return shard
+
+    def state(self):
+        key = super().state()
+        # Keeps the parameters alive until the next launch on this shard,
+        # they are released in stream order afterwards
+        self._params = cupy.array(
+            [key & 0xffffffffffffffff, self._start], dtype=numpy.uint64)
+        return self._params.data.ptr
+
+
+class _QuasiGenerator(BitGenerator):
+    # The points are computed from their indices on the device, so that
+    # there is no state other than the index of the next point.
+
+    _max_dims = 0
+
+    def __init__(self, d, *, scramble=True, seed=None, size=-1):
+        super().__init__(seed)
+        if not 1 <= d <= self._max_dims:
+            raise ValueError(
+                'd must be between 1 and {}'.format(self._max_dims))
+        self._d = d
+        self._scramble = bool(scramble)
+        self._scramble_seed = int(
+            self._seed_seq.generate_state(1, numpy.uint32)[0])
+        if size < 0:
+            size = 8 * 256 * runtime.deviceGetAttribute(
+                runtime.cudaDevAttrMultiProcessorCount,
+                self._current_device_id)
+        self._size = size
+        self._index = 0
+        self._params = None
+
+    @property
+    def d(self):
+        """The number of dimensions of the points."""
+        return self._d
+
+    def random_raw(self, size=None, output=True):
+        """Returns the coordinates of the next points as 32-bit fractions.
+
+        Args:
+            size (int or tuple of ints, optional): Output shape. The
+                coordinates of consecutive points are laid out contiguously,
+                ``d`` per point.
+            output (bool, optional): Output values.
+
+        Returns:
+            cupy.ndarray: Drawn samples.
+        """
+        from cupy.random._generator_api import random_raw
+
+        shape = size if size is not None else ()
+        y = cupy.zeros(shape, dtype=numpy.int32)
+        random_raw(self, y)
+        return y if output else None
+
+    def fast_forward(self, n):
+        """Skips the next ``n`` points.
+
+        Args:
+            n (int): Number of points to skip.
+
+        Returns:
+            This generator.
+        """
+        if n < 0:
+            raise ValueError('n must be non-negative')
+        with self.lock:
+            self._index += n
+        return self
+
+    def reset(self):
+        """Restarts the sequence from its first point.
+
+        Returns:
+            This generator.
+        """
+        with self.lock:
+            self._index = 0
+        return self
+
+    def state(self):
+        self._check_device()
+        with self.lock:
+            # Kept alive until the next launch, as for Philox4x3210Sharded
+            self._params = cupy.array(
+                [self._d, self._index, self._scramble_seed,
+                 int(self._scramble)], dtype=numpy.uint64)
+        return self._params.data.ptr
+
+    def _advance(self, size):
+        with self.lock:
+            self._index += -(-size // self._d)
+
+    def _state_size(self):
+        return self._size
+
+
+class Sobol(_QuasiGenerator):
+    """BitGenerator of the scrambled Sobol sequence.
+
+    The points of the sequence fill the unit hypercube of ``d`` dimensions
+    more evenly than random points, which reduces the variance of
+    quasi-Monte Carlo estimates. A draw of shape ``(n, d)`` holds the next
+    ``n`` points, and the transforms by inversion, e.g.
+    :meth:`Generator.random` and :meth:`Generator.standard_normal`, keep
+    this property. Every point is computed on the device from its index
+    with the Joe-Kuo direction numbers of cuRAND, so that
+    :meth:`fast_forward` costs nothing.
+
+    Args:
+        d (int): The number of dimensions, up to 20000.
+        scramble (bool): If ``True`` (default), the points are Owen
+            scrambled, with a hash-based nested uniform scrambling.
+        seed (int, array_like[ints], numpy.random.SeedSequence, optional):
+            The seed of the scrambling.
+        size (int): Number of threads used per launch. Defaults to
+            ``8 * 256`` times the number of multiprocessors.
+
+    .. note::
+        The sequence has ``2 ** 32`` points. Its balance properties hold for
+        draws of a power of two number of points. The distributions that
+        draw several values per element take them from the following
+        dimensions of the same point.
+
+    .. seealso:: :class:`scipy.stats.qmc.Sobol`
+    """
+    generator = QUASI_SOBOL
+    _max_dims = 20000
+
+    def __init__(self, d, *, scramble=True, seed=None, size=-1):
+        if runtime.is_hip:
+            raise RuntimeError('Sobol is not supported on ROCm')
+        super().__init__(d, scramble=scramble, seed=seed, size=size)
+
+
+class Halton(_QuasiGenerator):
+    """BitGenerator of the Halton sequence.
+
+    Dimension ``k`` of the points is the radical inverse of their index in
+    the base of the ``k``-th prime. As for :class:`Sobol`, a draw of shape
+    ``(n, d)`` holds the next ``n`` points, computed from their indices.
+
+    Args:
+        d (int): The number of dimensions, up to 1024.
+        scramble (bool): If ``True`` (default), every dimension is shifted
+            by a random amount modulo 1.
+        seed (int, array_like[ints], numpy.random.SeedSequence, optional):
+            The seed of the scrambling.
+        size (int): Number of threads used per launch. Defaults to
+            ``8 * 256`` times the number of multiprocessors.
+
+    .. seealso:: :class:`scipy.stats.qmc.Halton`
+    """
+    generator = QUASI_HALTON
+    _max_dims = 1024
@@ -25,6 +25,13 @@ _UINT32_MAX = 0xffffffff
 _UINT64_MAX = 0xffffffffffffffff
 
 
+def _has_generator_api():
+    # The kernels of `cupy.random.Generator` are stubs on ROCm < 4.3
+    runtime = cuda.runtime
+    return not (runtime.is_hip
+                and int(str(runtime.runtimeGetVersion())[:3]) < 403)
+
+
 class RandomState(object):
 
     """Portable container of a pseudo-random number generator.
@@ -1114,11 +1121,12 @@ class RandomState(object):
         if a_size == 0 and size > 0:
             raise ValueError('a cannot be empty unless no samples are taken')
 
+        if not replace and a_size < size:
+            raise ValueError(
+                'Cannot take a larger sample than population when '
+                '\'replace=False\'')
+
         if not replace and p is None:
-            if a_size < size:
-                raise ValueError(
-                    'Cannot take a larger sample than population when '
-                    '\'replace=False\'')
             if isinstance(a, int):
                 indices = cupy.arange(a, dtype='l')
             else:
@@ -1127,9 +1135,22 @@ class RandomState(object):
             return indices[:size].reshape(shape)
 
         if not replace:
-            raise NotImplementedError
-
-        if p is not None:
+            if int(cupy.count_nonzero(p)) < size:
+                raise ValueError('Fewer non-zero entries in p than size')
+            # The order of the exponential keys E / p is the one of
+            # successive weighted draws (Efraimidis and Spirakis).
+            keys = self.standard_exponential(a_size) / p
+            index = cupy.argsort(keys)[:size].reshape(shape)
+        elif p is not None and _has_generator_api():
+            # Imported here as it depends on cuRAND
+            from cupy.random import _generator_api
+
+            # Walker's alias method: one uniform sample per draw, whatever
+            # the number of items
+            prob, alias = _generator_api._alias_table(p)
+            uniform_samples = self.random_sample(shape)
+            index = _kernels.alias_kernel(uniform_samples, prob, alias, a_size)
+        elif p is not None:
             # https://github.com/numpy/numpy/blob/v2.0.1/numpy/random/mtrand.pyx#L1013  # NOQA
             cdf = p.cumsum()
             cdf /= cdf[-1]
@@ -1164,23 +1185,29 @@ class RandomState(object):
         if a.ndim == 0:
             raise TypeError('An array whose ndim is 0 is not supported')
 
-        a[:] = a[self._permutation(len(a))]
+        a[:] = self.permutation(a)
 
     def permutation(self, a):
         """Returns a permuted range or a permutation of an array."""
         if isinstance(a, int):
             return self._permutation(a)
-        else:
-            return a[self._permutation(len(a))]
+        if a.ndim == 1:
+            # gathered in the same pass as the permutation is computed
+            n = len(a)
+            return _kernels.permuted_take_kernel(
+                a, n, _kernels.feistel_half_bits(n), self._feistel_keys(),
+                size=n)
+        return a[self._permutation(len(a))]
+
+    def _feistel_keys(self):
+        return self._curand_generate(_kernels.feistel_rounds, numpy.uint32)
 
     def _permutation(self, num):
         """Returns a permuted range."""
-        from cupy_backends.cuda.libs import curand
-
-        sample = cupy.empty((num,), dtype=numpy.int32)
-        curand.generate(self._generator, sample.data.ptr, num)
-        array = cupy.argsort(sample)
-        return array
+        # A bijective hash of the indices, without sorting any keys
+        return _kernels.permutation_kernel(
+            num, _kernels.feistel_half_bits(num), self._feistel_keys(),
+            size=num)
 
     _gumbel_kernel = _core.ElementwiseKernel(
         'T x, T loc, T scale', 'T y',
@@ -6,7 +6,9 @@ from libc.stdint cimport intptr_t, uint64_t, int32_t, int64_t
 import cupy
 from cupy import _core
 from cupy.cuda cimport stream
+from cupy._core cimport internal
 from cupy._core.core cimport _ndarray_base
+from cupy.random import _kernels
 from cupy_backends.cuda.api import runtime
 
 _UINT32_MAX = 0xffffffff
@@ -70,10 +72,55 @@ cdef extern from 'cupy_distributions.cuh' nogil:
         int generator, intptr_t state, ssize_t state_size, intptr_t out,
         ssize_t size, intptr_t stream,
         intptr_t arg1, intptr_t arg2, intptr_t arg3)
+    void standard_normal_ziggurat(
+        int generator, intptr_t state, ssize_t state_size, intptr_t out,
+        ssize_t size, intptr_t stream)
+    void standard_normal_float_ziggurat(
+        int generator, intptr_t state, ssize_t state_size, intptr_t out,
+        ssize_t size, intptr_t stream)
+    void exponential_ziggurat(
+        int generator, intptr_t state, ssize_t state_size, intptr_t out,
+        ssize_t size, intptr_t stream)
+    void standard_gamma_ziggurat(
+        int generator, intptr_t state, ssize_t state_size, intptr_t out,
+        ssize_t size, intptr_t stream, intptr_t arg1)
+    void binomial_table(
+        int generator, intptr_t state, ssize_t state_size, intptr_t out,
+        ssize_t size, intptr_t stream,
+        intptr_t arg1, intptr_t arg2, intptr_t arg3, intptr_t arg4)
+    void binomial_setup(
+        intptr_t n, intptr_t p, intptr_t table, ssize_t size, intptr_t stream)
+    void alias_choice(
+        int generator, intptr_t state, ssize_t state_size, intptr_t out,
+        ssize_t size, intptr_t stream,
+        int64_t n, intptr_t prob, intptr_t alias)
+    void alias_setup(
+        intptr_t q, intptr_t deficit, intptr_t heavy, intptr_t excess,
+        intptr_t rank, intptr_t prob, intptr_t alias, ssize_t size,
+        intptr_t stream)
+    void multinomial(
+        int generator, intptr_t state, ssize_t state_size, intptr_t out,
+        ssize_t size, intptr_t stream, intptr_t n, intptr_t pvals, int64_t k)
+    void get_launch_config(int* block_size, int* grid_size, ssize_t* n_threads)
 
 
 cdef _ndarray_base _array_data(_ndarray_base x):
-    return cupy.array((x.data.ptr, x.ndim) + x.shape + x.strides)
+    # Drop unit dimensions and merge the ones that can be indexed as one, so
+    # that contiguous and broadcast parameters take the fast paths of
+    # `array_indexer` in `cupy_distributions.cu`.
+    cdef list shape = []
+    cdef list strides = []
+    cdef Py_ssize_t i
+    for i in range(x.ndim):
+        if x.shape[i] == 1:
+            continue
+        if shape and strides[-1] == x.strides[i] * x.shape[i]:
+            shape[-1] *= x.shape[i]
+            strides[-1] = x.strides[i]
+        else:
+            shape.append(x.shape[i])
+            strides.append(x.strides[i])
+    return cupy.array((x.data.ptr, len(shape)) + tuple(shape) + tuple(strides))
 
 
 class Generator:
@@ -95,14 +142,20 @@ class Generator:
     Args:
         bit_generator : (cupy.random.BitGenerator): BitGenerator to use
             as the core generator.
+        ziggurat (bool): If ``True``, :meth:`standard_normal`,
+            :meth:`standard_exponential` and :meth:`standard_gamma` (and the
+            distributions built on them) use Ziggurat samplers, which need
+            far fewer transcendental function calls than the default
+            Box-Muller and inverse CDF transforms. Default is ``False``.
 
     """
-    def __init__(self, bit_generator):
+    def __init__(self, bit_generator, *, ziggurat=False):
         if runtime.is_hip and int(str(runtime.runtimeGetVersion())[:3]) < 403:
             raise RuntimeError('Generator API not supported in ROCm<4.3,'
                                ' please use the legacy one or update ROCm.')
         self.bit_generator = bit_generator
         self._binomial_state = None
+        self._ziggurat = bool(ziggurat)
 
     def _check_output_array(self, dtype, size, out, check_only_c_cont=False):
         # Checks borrowed from NumPy
@@ -691,7 +744,7 @@ class Generator:
 
     def standard_exponential(
             self, size=None, dtype=numpy.float64,
-            method='inv', out=None):
+            method=None, out=None):
         """Standard exponential distribution.
 
         Returns an array of samples drawn from the standard exponential
@@ -705,8 +758,10 @@ class Generator:
                 a zero-dimensional array is generated.
             dtype: Data type specifier. Only :class:`numpy.float32` and
                 :class:`numpy.float64` types are allowed.
-            method (str): Method to sample. Currently only ``'inv'``, sampling
-                from the default inverse CDF, is supported.
+            method (str): Method to sample, ``'inv'`` for the inverse CDF or
+                ``'zig'`` for the Ziggurat method. Defaults to ``'zig'`` if
+                the generator was created with ``ziggurat=True`` and to
+                ``'inv'`` otherwise.
             out (cupy.ndarray, optional): If specified, values will be written
                 to this array
         Returns:
@@ -718,14 +773,19 @@ class Generator:
         """
         cdef _ndarray_base y
 
-        if method == 'zig':
-            raise NotImplementedError('Ziggurat method is not supported')
+        if method is None:
+            method = 'zig' if self._ziggurat else 'inv'
+        if method not in ('inv', 'zig'):
+            raise ValueError(f'Unknown method: {method}')
 
         if out is not None:
             self._check_output_array(dtype, size, out)
 
         y = _core.ndarray(size if size is not None else (), numpy.float64)
-        _launch_dist(self.bit_generator, exponential, y, ())
+        if method == 'zig':
+            _launch_dist(self.bit_generator, exponential_ziggurat, y, ())
+        else:
+            _launch_dist(self.bit_generator, exponential, y, ())
         if out is not None:
             _core.elementwise_copy(y, out)
             y = out
@@ -857,7 +917,14 @@ class Generator:
             raise TypeError(
                 f'Unsupported dtype {y.dtype.name} for standard_normal')
 
-        if y.dtype.char == 'd':
+        if self._ziggurat:
+            if y.dtype.char == 'd':
+                _launch_dist(
+                    self.bit_generator, standard_normal_ziggurat, y, ())
+            else:
+                _launch_dist(
+                    self.bit_generator, standard_normal_float_ziggurat, y, ())
+        elif y.dtype.char == 'd':
             _launch_dist(self.bit_generator, standard_normal, y, ())
         else:
             _launch_dist(self.bit_generator, standard_normal_float, y, ())
@@ -952,7 +1019,11 @@ class Generator:
 
         shape = cupy.broadcast_to(shape, y.shape)
 
-        _launch_dist(self.bit_generator, standard_gamma, y, (shape,))
+        if self._ziggurat:
+            _launch_dist(
+                self.bit_generator, standard_gamma_ziggurat, y, (shape,))
+        else:
+            _launch_dist(self.bit_generator, standard_gamma, y, (shape,))
         if out is not None and y is not out:
             _core.elementwise_copy(y, out)
             y = out
@@ -1004,11 +1075,19 @@ class Generator:
         else:
             raise TypeError('p is required to be a cupy.ndarray or a scalar')
 
+        params_shape = cupy.broadcast(n, p).shape
         if size is None:
-            size = cupy.broadcast(n, p).shape
+            size = params_shape
 
         y = _core.ndarray(size if size is not None else (), numpy.int64)
 
+        if internal.prod(params_shape) > 1:
+            # Array-valued parameters: precompute the setup of every
+            # parameter element once instead of letting each draw find the
+            # per-thread state stale and rebuild it.
+            _binomial_with_table(self.bit_generator, y, n, p, params_shape)
+            return y
+
         n = cupy.broadcast_to(n, y.shape)
         p = cupy.broadcast_to(p, y.shape)
 
@@ -1022,6 +1101,255 @@ class Generator:
             (n, p, binomial_state_ptr))
         return y
 
+    def multinomial(self, n, pvals, size=None):
+        """Multinomial distribution.
+
+        Returns an array of samples drawn from the multinomial distribution.
+        Each sample splits ``n`` trials over the ``len(pvals)`` outcomes with
+        one conditional binomial draw per outcome.
+
+        Args:
+            n (int or cupy.ndarray of ints): Number of trials, >= 0.
+            pvals (cupy.ndarray): 1-D array of the probabilities of the
+                outcomes. The last one is implied by the others.
+            size (int or tuple of ints, optional): The shape of the samples.
+                If ``None`` (default), ``n.shape`` samples are drawn.
+
+        Returns:
+            cupy.ndarray: The counts of the outcomes, of shape
+            ``size + (len(pvals),)``.
+
+        .. seealso::
+           :meth:`numpy.random.Generator.multinomial`
+        """
+        cdef _ndarray_base y
+        cdef int64_t k
+        cdef intptr_t strm
+
+        if isinstance(n, _ndarray_base):
+            n = n.astype(numpy.int64, copy=False)
+        else:
+            n = cupy.asarray(n, numpy.int64)
+        pvals = cupy.ascontiguousarray(pvals, dtype=numpy.float64)
+        if pvals.ndim != 1:
+            raise ValueError('pvals must be 1-dimensional')
+        if bool((pvals < 0).any()):
+            raise ValueError('pvals < 0')
+        if float(pvals[:-1].sum()) > 1.0 + 1e-12:
+            raise ValueError('sum(pvals[:-1]) > 1.0')
+
+        size = n.shape if size is None else internal.get_size(size)
+        k = pvals.size
+        y = _core.ndarray(size + (k,), numpy.int64)
+        if y.size == 0:
+            return y
+        n = _array_data(cupy.broadcast_to(n, size))
+        strm = stream.get_current_stream_ptr()
+        multinomial(
+            self.bit_generator.generator,
+            <intptr_t>self.bit_generator.state(),
+            self.bit_generator._state_size(), <intptr_t>y.data.ptr,
+            y.size // k, strm, <intptr_t>n.data.ptr,
+            <intptr_t>pvals.data.ptr, k)
+        self.bit_generator._advance(y.size // k)
+        return y
+
+    def choice(self, a, size=None, replace=True, p=None, axis=0,
+               shuffle=True):
+        """Generates a random sample from a given array.
+
+        Args:
+            a (int or cupy.ndarray): If an int, the sample is drawn from
+                ``cupy.arange(a)``. Otherwise it is drawn from the items of
+                ``a`` along ``axis``.
+            size (int or tuple of ints, optional): The shape of the sample.
+                If ``None`` (default), a single item is drawn.
+            replace (bool): Whether the sample is drawn with replacement.
+            p (cupy.ndarray, optional): The probabilities of the items. By
+                default, the items are drawn uniformly.
+            axis (int): The axis of ``a`` along which the items are drawn.
+            shuffle (bool): Accepted for compatibility. The sample drawn
+                without replacement is always in a random order.
+
+        Returns:
+            cupy.ndarray: The drawn items.
+
+        .. note::
+            Weighted draws with replacement look up an alias table built on
+            the device, so that each draw takes one uniform variate
+            whatever the number of items. Weighted draws without
+            replacement sort the items by exponential keys ``E / p``, whose
+            order is the one of successive weighted draws, and unweighted
+            ones are the first items of a permutation.
+
+        .. seealso::
+           :meth:`numpy.random.Generator.choice`
+        """
+        cdef _ndarray_base index
+
+        if isinstance(a, (int, numpy.integer)):
+            pop_size = int(a)
+            if pop_size < 0:
+                raise ValueError('a must be a positive integer unless no '
+                                 'samples are taken')
+        else:
+            a = cupy.asarray(a)
+            if a.ndim == 0:
+                raise ValueError('a must be a sequence or an integer, not a '
+                                 '0-d array')
+            axis = internal._normalize_axis_index(axis, a.ndim)
+            pop_size = a.shape[axis]
+
+        if p is not None:
+            p = cupy.asarray(p, dtype=numpy.float64)
+            if p.ndim != 1:
+                raise ValueError('p must be 1-dimensional')
+            if p.size != pop_size:
+                raise ValueError('a and p must have same size')
+            if not bool((p >= 0).all()):
+                raise ValueError('probabilities are not non-negative')
+            if not numpy.allclose(float(p.sum()), 1):
+                raise ValueError('probabilities do not sum to 1')
+
+        shape = () if size is None else internal.get_size(size)
+        n_samples = internal.prod(shape)
+        if pop_size == 0 and n_samples > 0:
+            raise ValueError('a cannot be empty unless no samples are taken')
+
+        if not replace:
+            if n_samples > pop_size:
+                raise ValueError('Cannot take a larger sample than '
+                                 'population when replace is False')
+            if p is None:
+                # the first items of a permutation
+                index = _kernels.permutation_kernel(
+                    pop_size, _kernels.feistel_half_bits(pop_size),
+                    self._feistel_keys(), size=n_samples).reshape(shape)
+            else:
+                if int(cupy.count_nonzero(p)) < n_samples:
+                    raise ValueError('Fewer non-zero entries in p than size')
+                keys = self.standard_exponential(pop_size) / p
+                index = cupy.argsort(keys)[:n_samples].reshape(shape)
+        elif p is None:
+            index = self.integers(0, max(pop_size, 1), size=shape)
+        else:
+            prob, alias = _alias_table(p)
+            index = _core.ndarray(shape, numpy.int64)
+            _launch_dist(
+                self.bit_generator, alias_choice, index,
+                (pop_size, <intptr_t>prob.data.ptr,
+                 <intptr_t>alias.data.ptr))
+
+        if not isinstance(a, _ndarray_base):
+            return index
+        return cupy.take(a, index, axis=axis)
+
+
+    def _feistel_keys(self):
+        return self.integers(
+            0, 1 << 32, size=_kernels.feistel_rounds, dtype=numpy.uint32)
+
+    def permutation(self, x, axis=0):
+        """Randomly permutes a sequence, or returns a permuted range.
+
+        Args:
+            x (int or cupy.ndarray): If an int, ``cupy.arange(x)`` is
+                permuted. Otherwise, a copy of ``x`` is permuted along
+                ``axis``.
+            axis (int): The axis of ``x`` that is permuted.
+
+        Returns:
+            cupy.ndarray: The permuted array.
+
+        .. note::
+            The permutation is a bijective hash of the indices (a Feistel
+            network keyed by the generator), so that no keys are sorted
+            and a 1-D array is gathered in a single pass.
+
+        .. seealso::
+           :meth:`numpy.random.Generator.permutation`
+        """
+        if isinstance(x, (int, numpy.integer)):
+            n = int(x)
+            return _kernels.permutation_kernel(
+                n, _kernels.feistel_half_bits(n), self._feistel_keys(),
+                size=n)
+        x = cupy.asarray(x)
+        if x.ndim == 0:
+            raise ValueError('x must be an integer or at least 1-dimensional')
+        axis = internal._normalize_axis_index(axis, x.ndim)
+        n = x.shape[axis]
+        if x.ndim == 1:
+            return _kernels.permuted_take_kernel(
+                x, n, _kernels.feistel_half_bits(n), self._feistel_keys(),
+                size=n)
+        return cupy.take(x, self.permutation(n), axis=axis)
+
+    def shuffle(self, x, axis=0):
+        """Shuffles an array in place along an axis.
+
+        Args:
+            x (cupy.ndarray): The array to shuffle.
+            axis (int): The axis of ``x`` that is shuffled.
+
+        .. seealso::
+           :meth:`numpy.random.Generator.shuffle`
+        """
+        if not isinstance(x, _ndarray_base):
+            raise TypeError('x must be a cupy.ndarray')
+        if x.ndim == 0:
+            raise TypeError('An array whose ndim is 0 is not supported')
+        x[...] = self.permutation(x, axis=axis)
+
+
+def _alias_table(p):
+    """Builds on the device the alias table of the probabilities ``p``.
+
+    Returns:
+        tuple of cupy.ndarray: The probabilities of keeping each column and
+        the aliases of the columns, for the draws of ``alias_choice``.
+    """
+    cdef ssize_t n = p.size
+    prob = cupy.ones(n, numpy.float64)
+    alias = cupy.arange(n, dtype=numpy.int64)
+    if n == 0:
+        return prob, alias
+    p = p.astype(numpy.float64, copy=False)
+    q = p * (n / p.sum())
+    # The prefix sums that pair the columns in parallel: the deficits of
+    # the light columns, and the heavy columns in order with their excesses,
+    # compacted by scattering the light ones to a slot n + 1 past the
+    # padding column n.
+    light = q < 1
+    deficit = cupy.where(light, 1 - q, 0).cumsum()
+    rank = (~light).cumsum(dtype=numpy.int64) - 1
+    dest = cupy.where(light, n + 1, rank)
+    heavy = cupy.full(n + 2, n, numpy.int64)
+    excess = cupy.full(n + 2, numpy.inf)
+    heavy[dest] = cupy.arange(n, dtype=numpy.int64)
+    excess[dest] = cupy.where(light, 0, q - 1).cumsum()
+    alias_setup(
+        <intptr_t>q.data.ptr, <intptr_t>deficit.data.ptr,
+        <intptr_t>heavy.data.ptr, <intptr_t>excess.data.ptr,
+        <intptr_t>rank.data.ptr, <intptr_t>prob.data.ptr,
+        <intptr_t>alias.data.ptr, n, stream.get_current_stream_ptr())
+    return prob, alias
+
+
+def _get_launch_config():
+    """Returns the configuration of the last distribution kernel launch.
+
+    Returns:
+        tuple of ints: ``(block_size, grid_size, n_threads)``. ``n_threads``
+        is the number of launched threads, which is at most the state size
+        of the bit generator. Each of them runs one or more of the logical
+        threads, one per state, so the samples do not depend on it.
+    """
+    cdef int block_size, grid_size
+    cdef ssize_t n_threads
+    get_launch_config(&block_size, &grid_size, &n_threads)
+    return block_size, grid_size, n_threads
+
 
 def init_curand(generator, state, seed, size):
     init_curand_generator(
@@ -1055,9 +1383,33 @@ cdef void _launch(
          <intptr_t>out.data.ptr, size, strm, *args_ptr)
 
 
+cdef void _binomial_with_table(
+        bit_generator, _ndarray_base y, n, p, params_shape) except*:
+    cdef ssize_t n_params = internal.prod(params_shape)
+    cdef intptr_t strm
+    if y.size == 0:
+        return
+    strm = stream.get_current_stream_ptr()
+    n_params_arr = _array_data(cupy.broadcast_to(n, params_shape))
+    p_params_arr = _array_data(cupy.broadcast_to(p, params_shape))
+    table = cupy.empty(
+        sizeof(rk_binomial_state) * n_params, dtype=numpy.int8)
+    binomial_setup(
+        <intptr_t>n_params_arr.data.ptr, <intptr_t>p_params_arr.data.ptr,
+        <intptr_t>table.data.ptr, n_params, strm)
+    index = cupy.broadcast_to(
+        cupy.arange(n_params, dtype=numpy.int64).reshape(params_shape),
+        y.shape)
+    _launch_dist(
+        bit_generator, binomial_table, y,
+        (cupy.broadcast_to(n, y.shape), cupy.broadcast_to(p, y.shape),
+         <intptr_t>table.data.ptr, index))
+
+
 cdef void _launch_dist(bit_generator, func, out, args) except*:
     cdef intptr_t strm = stream.get_current_stream_ptr()
     cdef intptr_t state = <intptr_t>bit_generator.state()
     cdef int generator = bit_generator.generator
     cdef bsize = bit_generator._state_size()
     _launch(func, generator, state, strm, bsize, out, args)
+    bit_generator._advance(out.size)
@@ -1085,3 +1085,67 @@ open_uniform_kernel = _core.ElementwiseKernel(
     preamble=''.join(definitions),
     loop_prep='rk_state internal_state;'
 )
+
+# Maps uniform samples to the columns of an alias table or their aliases
+alias_kernel = _core.ElementwiseKernel(
+    'float64 u, raw float64 prob, raw int64 alias, int64 n', 'int64 index',
+    '''
+    double x = u * n;
+    long long j = min((long long)x, n - 1);
+    index = (x - j < prob[j]) ? j : alias[j];
+    ''',
+    'cupy_alias_kernel'
+)
+
+# A random permutation of [0, n) without sorting: a Feistel network with
+# the random round keys is a bijection of [0, 4^half_bits), and it is
+# applied again to the values that fall out of [0, n) (cycle walking),
+# which gives a bijection of [0, n). As 4^half_bits < 4n, there are less
+# than four walks per item in average.
+feistel_rounds = 24
+
+feistel_definition = '''
+__device__ unsigned int feistel_round(unsigned int r, unsigned int key) {
+    unsigned long long p = (unsigned long long)(r ^ key)
+        * 0xd2b74407b1ce6e93ULL;
+    return (unsigned int)(p >> 32) ^ (unsigned int)p;
+}
+
+__device__ long long feistel_permute(
+        long long x, long long n, int half_bits, const unsigned int* keys) {
+    const unsigned int mask =
+        half_bits >= 32 ? 0xffffffffU : (1U << half_bits) - 1;
+    do {
+        unsigned int l = (unsigned long long)x >> half_bits;
+        unsigned int r = x & mask;
+        for (int k = 0; k < %d; k++) {
+            unsigned int t = l ^ (feistel_round(r, keys[k]) & mask);
+            l = r;
+            r = t;
+        }
+        x = (long long)(((unsigned long long)l << half_bits) | r);
+    } while (x >= n);
+    return x;
+}
+''' % feistel_rounds
+
+
+def feistel_half_bits(n):
+    """Returns the number of bits of each half of the Feistel network."""
+    return ((max(n - 1, 1).bit_length()) + 1) // 2
+
+
+permutation_kernel = _core.ElementwiseKernel(
+    'int64 n, int32 half_bits, raw uint32 keys', 'int64 y',
+    'y = feistel_permute(i, n, half_bits, &keys[0]);',
+    'cupy_permutation_kernel',
+    preamble=feistel_definition
+)
+
+# Gathers a 1-D array in the order of the permutation in the same pass
+permuted_take_kernel = _core.ElementwiseKernel(
+    'raw T a, int64 n, int32 half_bits, raw uint32 keys', 'T y',
+    'y = a[feistel_permute(i, n, half_bits, &keys[0])];',
+    'cupy_permuted_take_kernel',
+    preamble=feistel_definition
+)
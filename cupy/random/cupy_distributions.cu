@@ -4,6 +4,9 @@
 #include <iostream>
 #include <stdint.h>
 #include <type_traits>
+#include <algorithm>
+#include <map>
+#include <mutex>
 
 
 #include "cupy_distributions.cuh"
@@ -14,19 +17,8 @@
 
 
 template<typename CURAND_TYPE>
-struct curand_pseudo_state {
-    // Valid for  XORWOW and MRG32k3a
+struct curand_state_ops {
     CURAND_TYPE _state;
-    CURAND_TYPE* _state_ptr;
-
-    __device__ curand_pseudo_state(int id, intptr_t state) {
-        _state_ptr = reinterpret_cast<CURAND_TYPE*>(state) + id;
-        _state = *_state_ptr;
-    }
-
-    __device__ ~curand_pseudo_state() {
-        *_state_ptr = _state;
-    }
 
     __device__ uint32_t rk_int() {
         return curand(&_state);
@@ -63,9 +55,352 @@ struct curand_pseudo_state {
     __device__ float rk_normal_float() {
         return curand_normal(&_state);
     }
+
+    // Generators whose draws for output `id` only depend on `id` re-seek
+    // their state before every element, see curand_element_state.
+    static constexpr bool per_element = false;
+    // Quasi-random generators have no cuRAND state to initialize
+    static constexpr bool quasi = false;
+
+    __device__ void seek(ssize_t id) {
+    }
+
+    // Vector draws used by the bulk uniform and normal fills. Philox yields
+    // four 32-bit outputs per round, so its native vector functions are used;
+    // the other generators compose the vector from scalar draws.
+#ifdef CUPY_USE_HIP
+    static constexpr bool native_vector = false;
+#else
+    static constexpr bool native_vector = std::is_same<CURAND_TYPE, curandStatePhilox4_32_10_t>::value;
+#endif
+
+    __device__ double2 rk_double2() {
+        double2 r;
+#ifndef CUPY_USE_HIP
+        if constexpr (native_vector) {
+            r = curand_uniform2_double(&_state);
+            r.x = r.x >= 1.0 ? 0.0 : r.x;
+            r.y = r.y >= 1.0 ? 0.0 : r.y;
+            return r;
+        }
+#endif
+        r.x = rk_double();
+        r.y = rk_double();
+        return r;
+    }
+
+    __device__ float4 rk_float4() {
+        float4 r;
+#ifndef CUPY_USE_HIP
+        if constexpr (native_vector) {
+            r = curand_uniform4(&_state);
+            r.x = r.x >= 1.0f ? 0.0f : r.x;
+            r.y = r.y >= 1.0f ? 0.0f : r.y;
+            r.z = r.z >= 1.0f ? 0.0f : r.z;
+            r.w = r.w >= 1.0f ? 0.0f : r.w;
+            return r;
+        }
+#endif
+        r.x = rk_float();
+        r.y = rk_float();
+        r.z = rk_float();
+        r.w = rk_float();
+        return r;
+    }
+
+    __device__ double2 rk_normal2() {
+#ifndef CUPY_USE_HIP
+        if constexpr (native_vector) {
+            return curand_normal2_double(&_state);
+        }
+#endif
+        double2 r;
+        r.x = rk_normal();
+        r.y = rk_normal();
+        return r;
+    }
+
+    __device__ float4 rk_normal_float4() {
+#ifndef CUPY_USE_HIP
+        if constexpr (native_vector) {
+            return curand_normal4(&_state);
+        }
+#endif
+        float4 r;
+        r.x = rk_normal_float();
+        r.y = rk_normal_float();
+        r.z = rk_normal_float();
+        r.w = rk_normal_float();
+        return r;
+    }
+};
+
+
+template<typename CURAND_TYPE>
+struct curand_pseudo_state : curand_state_ops<CURAND_TYPE> {
+    // Valid for  XORWOW and MRG32k3a
+    CURAND_TYPE* _state_ptr;
+
+    __device__ curand_pseudo_state(int id, intptr_t state) {
+        _state_ptr = reinterpret_cast<CURAND_TYPE*>(state) + id;
+        this->_state = *_state_ptr;
+    }
+
+    __device__ ~curand_pseudo_state() {
+        *_state_ptr = this->_state;
+    }
 };
 
 
+// Counter-based Philox4x32-10 that keeps no state in memory. Instead of a
+// pointer, `state` carries the key: the 32-bit seed in the upper half and a
+// 32-bit launch counter in the lower half. Every thread of every launch gets
+// its own subsequence, (counter << 32) | id, so initializing it is O(1) and
+// skipping ahead is just advancing the counter.
+struct curand_counter_state : curand_state_ops<curandStatePhilox4_32_10_t> {
+    __device__ curand_counter_state(int id, intptr_t state) {
+        const uint64_t key = static_cast<uint64_t>(state);
+        const uint64_t subsequence = (key << 32) | static_cast<uint32_t>(id);
+        curand_init(key >> 32, subsequence, 0, &this->_state);
+    }
+};
+
+
+// Philox4x32-10 that derives the state of every output element from its
+// index. `state` points to {key, start} on the device, where the 64-bit
+// Philox key holds the seed and the launch counter as for
+// curand_counter_state. Element `id` uses subsequence start + id, so the
+// value drawn for an element does not depend on how the output is split
+// across threads, streams or devices.
+struct curand_element_state : curand_state_ops<curandStatePhilox4_32_10_t> {
+    static constexpr bool per_element = true;
+    uint64_t _key;
+    uint64_t _start;
+
+    __device__ curand_element_state(int id, intptr_t state) {
+        const uint64_t* params = reinterpret_cast<const uint64_t*>(state);
+        _key = params[0];
+        _start = params[1];
+    }
+
+    __device__ void seek(ssize_t id) {
+        curand_init(_key, _start + id, 0, &this->_state);
+    }
+};
+
+
+// Quasi-random (low-discrepancy) generators. They are counter based, like
+// curand_element_state: `state` points to {dims, start, seed, scramble} on
+// the device, and output element `id` is coordinate id % dims of point
+// start + id / dims, so that an array of shape (n, dims) holds n consecutive
+// points. Every point is computed from its index, which makes skipping
+// ahead free. Further draws of the same element take the following
+// dimensions of its point (id % dims + dims, and so on); past the last
+// dimension of the tables they restart from the first one with another
+// scrambling, so that the rejection samplers keep seeing new values.
+#define SOBOL_MAX_DIMS 20000
+#define HALTON_MAX_DIMS 1024
+
+// Read through the read-only cache rather than constant memory, as the
+// lanes of a warp read different dimensions
+__device__ const uint32_t* sobol_directions;
+__device__ const uint32_t* halton_primes;
+
+__device__ __forceinline__ uint32_t quasi_hash(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+template<typename Q>
+struct quasi_state {
+    static constexpr bool per_element = true;
+    static constexpr bool quasi = true;
+    static constexpr bool native_vector = false;
+    uint64_t _dims, _start, _index, _dim;
+    uint32_t _seed;
+    bool _scramble;
+
+    __device__ quasi_state(int id, intptr_t state) {
+        const uint64_t* params = reinterpret_cast<const uint64_t*>(state);
+        _dims = params[0];
+        _start = params[1];
+        _seed = static_cast<uint32_t>(params[2]);
+        _scramble = params[3] != 0;
+        seek(id);
+    }
+
+    __device__ void seek(ssize_t id) {
+        _index = _start + id / _dims;
+        _dim = id % _dims;
+    }
+
+    // The next coordinate as a 32-bit fixed-point fraction
+    __device__ uint32_t rk_int() {
+        uint32_t x = Q::coordinate(_index, _dim % Q::max_dims);
+        if (_scramble || _dim >= Q::max_dims) {
+            x = Q::scramble(x, quasi_hash(_seed ^ quasi_hash(_dim)));
+        }
+        _dim += _dims;
+        return x;
+    }
+
+    __device__ double rk_double() {
+        return rk_int() * 2.3283064365386963e-10;  // 2^-32
+    }
+
+    __device__ float rk_float() {
+        return (rk_int() >> 8) * 5.9604645e-08f;  // 2^-24
+    }
+
+    // By inversion, which keeps the low discrepancy of the points
+    __device__ double rk_normal() {
+        return normcdfinv((rk_int() + 0.5) * 2.3283064365386963e-10);
+    }
+
+    __device__ float rk_normal_float() {
+        return normcdfinvf(((rk_int() >> 8) + 0.5f) * 5.9604645e-08f);
+    }
+
+    __device__ double2 rk_double2() {
+        double2 r;
+        r.x = rk_double();
+        r.y = rk_double();
+        return r;
+    }
+
+    __device__ float4 rk_float4() {
+        float4 r;
+        r.x = rk_float();
+        r.y = rk_float();
+        r.z = rk_float();
+        r.w = rk_float();
+        return r;
+    }
+
+    __device__ double2 rk_normal2() {
+        double2 r;
+        r.x = rk_normal();
+        r.y = rk_normal();
+        return r;
+    }
+
+    __device__ float4 rk_normal_float4() {
+        float4 r;
+        r.x = rk_normal_float();
+        r.y = rk_normal_float();
+        r.z = rk_normal_float();
+        r.w = rk_normal_float();
+        return r;
+    }
+};
+
+// Sobol points in Gray code order, with the Joe-Kuo direction numbers of
+// cuRAND. A point is the XOR of the direction numbers of the set bits of
+// the Gray code of its index, and the scrambling is the hash-based Owen
+// scrambling of Laine, Karras and Burley, where each bit of the reversed
+// fraction only depends on the bits below it.
+struct sobol_state : quasi_state<sobol_state> {
+    static constexpr uint32_t max_dims = SOBOL_MAX_DIMS;
+
+    using quasi_state<sobol_state>::quasi_state;
+
+    static __device__ uint32_t coordinate(uint64_t index, uint32_t dim) {
+        const uint32_t* v = sobol_directions + dim * 32;
+        uint32_t gray = static_cast<uint32_t>(index ^ (index >> 1));
+        uint32_t x = 0;
+        while (gray != 0) {
+            x ^= __ldg(v + __ffs(gray) - 1);
+            gray &= gray - 1;
+        }
+        return x;
+    }
+
+    static __device__ uint32_t scramble(uint32_t x, uint32_t seed) {
+        x = __brev(x);
+        x += seed;
+        x ^= x * 0x6c50b47cU;
+        x ^= x * 0xb82f1e52U;
+        x ^= x * 0xc7afe638U;
+        x ^= x * 0x8d22f6e6U;
+        return __brev(x);
+    }
+};
+
+// Halton points: the radical inverse of the index in the base of the
+// prime of each dimension. The scrambling is a random shift modulo 1 of
+// every dimension (Cranley-Patterson rotation).
+struct halton_state : quasi_state<halton_state> {
+    static constexpr uint32_t max_dims = HALTON_MAX_DIMS;
+
+    using quasi_state<halton_state>::quasi_state;
+
+    static __device__ uint32_t coordinate(uint64_t index, uint32_t dim) {
+        const uint32_t base = __ldg(halton_primes + dim);
+        const double inv = 1.0 / base;
+        double f = inv, r = 0.0;
+        while (index > 0) {
+            r += f * (index % base);
+            index /= base;
+            f *= inv;
+        }
+        return static_cast<uint32_t>(min(r * 4294967296.0, 4294967295.0));
+    }
+
+    static __device__ uint32_t scramble(uint32_t x, uint32_t seed) {
+        return x + seed;
+    }
+};
+
+// Copies the direction numbers and the primes to the current device the
+// first time a quasi-random generator is used on it.
+void quasi_tables_init(int generator) {
+    static std::mutex mtx;
+    static std::map<std::pair<int, int>, bool> initialized;
+    int device = 0;
+    cudaGetDevice(&device);
+    std::lock_guard<std::mutex> lock(mtx);
+    std::pair<int, int> key(generator, device);
+    if (initialized[key]) {
+        return;
+    }
+    if (generator == QUASI_SOBOL) {
+#ifndef CUPY_USE_HIP
+        curandDirectionVectors32_t* vectors;
+        curandGetDirectionVectors32(&vectors, CURAND_DIRECTION_VECTORS_32_JOEKUO6);
+        void* table;
+        const size_t n_bytes = sizeof(uint32_t) * 32 * SOBOL_MAX_DIMS;
+        cudaMalloc(&table, n_bytes);
+        cudaMemcpy(table, vectors, n_bytes, cudaMemcpyHostToDevice);
+        cudaMemcpyToSymbol(sobol_directions, &table, sizeof(table));
+#endif
+    } else {
+        uint32_t primes[HALTON_MAX_DIMS];
+        int n = 0;
+        for (uint32_t k = 2; n < HALTON_MAX_DIMS; k++) {
+            bool prime = true;
+            for (int i = 0; i < n && primes[i] * primes[i] <= k; i++) {
+                if (k % primes[i] == 0) {
+                    prime = false;
+                    break;
+                }
+            }
+            if (prime) {
+                primes[n++] = k;
+            }
+        }
+        void* table;
+        cudaMalloc(&table, sizeof(primes));
+        cudaMemcpy(table, primes, sizeof(primes), cudaMemcpyHostToDevice);
+        cudaMemcpyToSymbol(halton_primes, &table, sizeof(table));
+    }
+    initialized[key] = true;
+}
+
+
 // This design is the same as the dtypes one
 template <typename F, typename... Ts>
 void generator_dispatcher(int generator_id, F f, Ts&&... args) {
@@ -73,19 +408,96 @@ void generator_dispatcher(int generator_id, F f, Ts&&... args) {
        case CURAND_XOR_WOW: return f.template operator()<curand_pseudo_state<curandState>>(std::forward<Ts>(args)...);
        case CURAND_MRG32k3a: return f.template operator()<curand_pseudo_state<curandStateMRG32k3a>>(std::forward<Ts>(args)...);
        case CURAND_PHILOX_4x32_10: return f.template operator()<curand_pseudo_state<curandStatePhilox4_32_10_t>>(std::forward<Ts>(args)...);
+       case CURAND_PHILOX_4x32_10_COUNTER: return f.template operator()<curand_counter_state>(std::forward<Ts>(args)...);
+       case CURAND_PHILOX_4x32_10_SHARDED: return f.template operator()<curand_element_state>(std::forward<Ts>(args)...);
+       case QUASI_SOBOL: quasi_tables_init(generator_id); return f.template operator()<sobol_state>(std::forward<Ts>(args)...);
+       case QUASI_HALTON: quasi_tables_init(generator_id); return f.template operator()<halton_state>(std::forward<Ts>(args)...);
        default: throw std::runtime_error("Unknown random generator");
    }
 }
 
 
+// Launch configuration of the kernels below. The block size is the one that
+// maximizes occupancy for each kernel, as reported by
+// cudaOccupancyMaxPotentialBlockSize, so that the heavy distributions (e.g.
+// binomial BTPE or hypergeometric HRUA) get smaller blocks than the uniform
+// fills.
+//
+// The samples do not depend on the launch: there is one logical thread per
+// state (the ones past the amount of work have nothing to draw), and logical
+// thread `i` uses state `i` and strides over the output by the state size,
+// as when one thread was launched per state. The number of launched threads
+// is capped by the number of threads the device keeps resident, and each of
+// them runs the logical threads that are a multiple of the launched threads
+// apart.
+struct launch_config {
+    int block_size;
+    int grid_size;
+    // the number of launched threads and of logical threads
+    ssize_t n_threads;
+    ssize_t n_logical;
+};
+
+// The last launch of the calling host thread, only for inspection
+static thread_local launch_config last_launch_config = {0, 0, 0, 0};
+
+template<typename K>
+launch_config occupancy_config(K kernel) {
+    // `grid_size` here is the number of blocks that fills the device
+    static std::mutex mtx;
+    static std::map<std::pair<const void*, int>, launch_config> cache;
+    int device = 0;
+    cudaGetDevice(&device);
+    std::pair<const void*, int> key(reinterpret_cast<const void*>(kernel), device);
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        return it->second;
+    }
+    launch_config config = {256, 0, 0, 0};
+    int min_grid_size, block_size;
+    if (cudaOccupancyMaxPotentialBlockSize(&min_grid_size, &block_size, kernel, 0, 0) == cudaSuccess) {
+        config.block_size = block_size;
+        config.grid_size = min_grid_size;
+    } else {
+        // Clear the error and keep the default block size
+        cudaGetLastError();
+    }
+    cache[key] = config;
+    return config;
+}
+
+template<typename K>
+launch_config grid_stride_config(K kernel, ssize_t state_size, ssize_t work) {
+    launch_config config = occupancy_config(kernel);
+    const ssize_t n_logical = std::min(state_size, std::max<ssize_t>(work, 1));
+    ssize_t n_threads = n_logical;
+    if (config.grid_size > 0) {
+        n_threads = std::min(n_threads, static_cast<ssize_t>(config.grid_size) * config.block_size);
+    }
+    config.n_threads = n_threads;
+    config.n_logical = n_logical;
+    config.grid_size = (n_threads + config.block_size - 1) / config.block_size;
+    last_launch_config = config;
+    return config;
+}
+
+void get_launch_config(int* block_size, int* grid_size, ssize_t* n_threads) {
+    *block_size = last_launch_config.block_size;
+    *grid_size = last_launch_config.grid_size;
+    *n_threads = last_launch_config.n_threads;
+}
+
 template<typename T>
 __global__ void init_curand(intptr_t state, uint64_t seed, ssize_t size) {
     int id = threadIdx.x + blockIdx.x * blockDim.x;
     /* Each thread gets same seed, a different sequence
        number, no offset */
-    T curand_state(id, state);
-    if (id < size) {
-        curand_init(seed, id, 0, &curand_state._state);    
+    if constexpr (!T::quasi) {
+        if (id < size) {
+            T curand_state(id, state);
+            curand_init(seed, id, 0, &curand_state._state);    
+        }
     }
 }
 
@@ -94,9 +506,10 @@ struct initialize_launcher {
     }
     template<typename T, typename... Args>
     void operator()(Args&&... args) { 
-        int tpb = 256;
-        int bpg =  (_size + tpb - 1) / tpb;
-        init_curand<T><<<bpg, tpb, 0, _stream>>>(std::forward<Args>(args)...);
+        // Every state must be initialized, so there is no cap on the grid
+        launch_config config = occupancy_config(init_curand<T>);
+        int bpg =  (_size + config.block_size - 1) / config.block_size;
+        init_curand<T><<<bpg, config.block_size, 0, _stream>>>(std::forward<Args>(args)...);
     }
     ssize_t _size;
     cudaStream_t _stream;
@@ -124,18 +537,195 @@ __device__ float rk_standard_normal_float(T& state) {
     return state.rk_normal_float();
 }
 
+// Ziggurat samplers (Marsaglia and Tsang, 2000) with 256 layers. The layer
+// tables are computed on the host and copied to constant memory the first
+// time a ziggurat distribution is launched on a device. `k` is the ratio
+// that accepts a draw without any transcendental call, `w` the layer width
+// and `f` the density at the layer boundary.
+#define ZIGGURAT_LAYERS 256
+#define ZIGGURAT_NORMAL_R 3.6541528853610088
+#define ZIGGURAT_NORMAL_V 0.00492867323399
+#define ZIGGURAT_EXP_R 7.69711747013104972
+#define ZIGGURAT_EXP_V 0.0039496598225815571993
+
+__constant__ double zig_kn[ZIGGURAT_LAYERS], zig_wn[ZIGGURAT_LAYERS], zig_fn[ZIGGURAT_LAYERS];
+__constant__ double zig_ke[ZIGGURAT_LAYERS], zig_we[ZIGGURAT_LAYERS], zig_fe[ZIGGURAT_LAYERS];
+__constant__ float zig_kn_f[ZIGGURAT_LAYERS], zig_wn_f[ZIGGURAT_LAYERS], zig_fn_f[ZIGGURAT_LAYERS];
+
+void ziggurat_tables_init() {
+    static std::mutex mtx;
+    static std::map<int, bool> initialized;
+    int device = 0;
+    cudaGetDevice(&device);
+    std::lock_guard<std::mutex> lock(mtx);
+    if (initialized[device]) {
+        return;
+    }
+    const int n = ZIGGURAT_LAYERS;
+    double kn[n], wn[n], fn[n], ke[n], we[n], fe[n];
+    float kn_f[n], wn_f[n], fn_f[n];
+
+    double dn = ZIGGURAT_NORMAL_R, tn = dn, vn = ZIGGURAT_NORMAL_V;
+    double q = vn / exp(-0.5 * dn * dn);
+    kn[0] = dn / q;
+    kn[1] = 0;
+    wn[0] = q;
+    wn[n - 1] = dn;
+    fn[0] = 1.0;
+    fn[n - 1] = exp(-0.5 * dn * dn);
+    for (int i = n - 2; i >= 1; i--) {
+        dn = sqrt(-2.0 * log(vn / dn + exp(-0.5 * dn * dn)));
+        kn[i + 1] = dn / tn;
+        tn = dn;
+        fn[i] = exp(-0.5 * dn * dn);
+        wn[i] = dn;
+    }
+
+    double de = ZIGGURAT_EXP_R, te = de, ve = ZIGGURAT_EXP_V;
+    q = ve / exp(-de);
+    ke[0] = de / q;
+    ke[1] = 0;
+    we[0] = q;
+    we[n - 1] = de;
+    fe[0] = 1.0;
+    fe[n - 1] = exp(-de);
+    for (int i = n - 2; i >= 1; i--) {
+        de = -log(ve / de + exp(-de));
+        ke[i + 1] = de / te;
+        te = de;
+        fe[i] = exp(-de);
+        we[i] = de;
+    }
+
+    for (int i = 0; i < n; i++) {
+        kn_f[i] = kn[i];
+        wn_f[i] = wn[i];
+        fn_f[i] = fn[i];
+    }
+    cudaMemcpyToSymbol(zig_kn, kn, sizeof(kn));
+    cudaMemcpyToSymbol(zig_wn, wn, sizeof(wn));
+    cudaMemcpyToSymbol(zig_fn, fn, sizeof(fn));
+    cudaMemcpyToSymbol(zig_ke, ke, sizeof(ke));
+    cudaMemcpyToSymbol(zig_we, we, sizeof(we));
+    cudaMemcpyToSymbol(zig_fe, fe, sizeof(fe));
+    cudaMemcpyToSymbol(zig_kn_f, kn_f, sizeof(kn_f));
+    cudaMemcpyToSymbol(zig_wn_f, wn_f, sizeof(wn_f));
+    cudaMemcpyToSymbol(zig_fn_f, fn_f, sizeof(fn_f));
+    initialized[device] = true;
+}
+
+template<typename T>
+__device__ uint64_t rk_uint64(T& state) {
+    uint64_t hi = state.rk_int();
+    return (hi << 32) | state.rk_int();
+}
+
+// The low 8 bits pick the layer, the remaining bits give the signed
+// position within it, u in [-1, 1).
+template<typename T>
+__device__ double rk_ziggurat_normal(T& state) {
+    for (;;) {
+        int64_t hz = static_cast<int64_t>(rk_uint64(state));
+        int iz = hz & 0xff;
+        double u = (hz >> 8) * (1.0 / 36028797018963968.0);  // 2^-55
+        double x = u * zig_wn[iz];
+        if (fabs(u) < zig_kn[iz]) {
+            return x;
+        }
+        if (iz == 0) {
+            // Tail beyond R, sampled from the exponential bound
+            double xx, yy;
+            do {
+                xx = -log(1.0 - state.rk_double()) / ZIGGURAT_NORMAL_R;
+                yy = -log(1.0 - state.rk_double());
+            } while (yy + yy < xx * xx);
+            return u > 0 ? ZIGGURAT_NORMAL_R + xx : -(ZIGGURAT_NORMAL_R + xx);
+        }
+        if (zig_fn[iz] + state.rk_double() * (zig_fn[iz - 1] - zig_fn[iz]) < exp(-0.5 * x * x)) {
+            return x;
+        }
+    }
+}
+
+template<typename T>
+__device__ float rk_ziggurat_normal_float(T& state) {
+    for (;;) {
+        int32_t hz = static_cast<int32_t>(state.rk_int());
+        int iz = hz & 0xff;
+        float u = (hz >> 8) * (1.0f / 8388608.0f);  // 2^-23
+        float x = u * zig_wn_f[iz];
+        if (fabsf(u) < zig_kn_f[iz]) {
+            return x;
+        }
+        if (iz == 0) {
+            float xx, yy;
+            do {
+                xx = -logf(1.0f - state.rk_float()) / static_cast<float>(ZIGGURAT_NORMAL_R);
+                yy = -logf(1.0f - state.rk_float());
+            } while (yy + yy < xx * xx);
+            const float r = ZIGGURAT_NORMAL_R;
+            return u > 0 ? r + xx : -(r + xx);
+        }
+        if (zig_fn_f[iz] + state.rk_float() * (zig_fn_f[iz - 1] - zig_fn_f[iz]) < expf(-0.5f * x * x)) {
+            return x;
+        }
+    }
+}
+
 template<typename T>
+__device__ double rk_ziggurat_exponential(T& state) {
+    for (;;) {
+        uint64_t jz = rk_uint64(state);
+        int iz = jz & 0xff;
+        double u = (jz >> 11) * (1.0 / 9007199254740992.0);  // 2^-53
+        double x = u * zig_we[iz];
+        if (u < zig_ke[iz]) {
+            return x;
+        }
+        if (iz == 0) {
+            return ZIGGURAT_EXP_R - log(1.0 - state.rk_double());
+        }
+        if (zig_fe[iz] + state.rk_double() * (zig_fe[iz - 1] - zig_fe[iz]) < exp(-x)) {
+            return x;
+        }
+    }
+}
+
+// Sources of normal and exponential variates used by rk_standard_gamma
+struct default_sampler {
+    template<typename T>
+    __device__ static double normal(T& state) {
+        return state.rk_normal();
+    }
+    template<typename T>
+    __device__ static double exponential(T& state) {
+        return rk_standard_exponential(state);
+    }
+};
+
+struct ziggurat_sampler {
+    template<typename T>
+    __device__ static double normal(T& state) {
+        return rk_ziggurat_normal(state);
+    }
+    template<typename T>
+    __device__ static double exponential(T& state) {
+        return rk_ziggurat_exponential(state);
+    }
+};
+
+template<typename T, typename Z = default_sampler>
 __device__ double rk_standard_gamma(T& state, double shape) {
     double b, c;
     double U, V, X, Y;
     if (shape == 1.0) {
-        return rk_standard_exponential(state);
+        return Z::exponential(state);
     } else if (shape < 0.0) {
         return 0.0;
     } else if (shape < 1.0) {
         for (;;) {
             U = state.rk_double();
-            V = rk_standard_exponential(state);
+            V = Z::exponential(state);
             if (U <= 1.0 - shape) {
                 X = pow(U, 1./shape);
                 if (X <= V) {
@@ -154,7 +744,7 @@ __device__ double rk_standard_gamma(T& state, double shape) {
         c = 1./sqrt(9*b);
         for (;;) {
             do {
-                X = state.rk_normal();
+                X = Z::normal(state);
                 V = 1.0 + c*X;
             } while (V <= 0.0);
             V = V*V*V;
@@ -465,6 +1055,30 @@ __device__ uint64_t rk_interval_64(T& state, uint64_t  mx, uint64_t mask) {
     return sampled;
 }
 
+__device__ void rk_binomial_btpe_init(long n, double p, rk_binomial_state *binomial_state) {
+    double a, r, q, fm, p1, xm, xl, xr, c, laml, lamr, p2, p3;
+    int m;
+    binomial_state->nsave = n;
+    binomial_state->psave = p;
+    binomial_state->initialized = 1;
+    binomial_state->r = r = min(p, 1.0-p);
+    binomial_state->q = q = 1.0 - r;
+    binomial_state->fm = fm = n*r+r;
+    binomial_state->m = m = (long)floor(binomial_state->fm);
+    binomial_state->p1 = p1 = floor(2.195*sqrt(n*r*q)-4.6*q) + 0.5;
+    binomial_state->xm = xm = m + 0.5;
+    binomial_state->xl = xl = xm - p1;
+    binomial_state->xr = xr = xm + p1;
+    binomial_state->c = c = 0.134 + 20.5/(15.3 + m);
+    a = (fm - xl)/(fm-xl*r);
+    binomial_state->laml = laml = a*(1.0 + a/2.0);
+    a = (xr - fm)/(xr*q);
+    binomial_state->lamr = lamr = a*(1.0 + a/2.0);
+    binomial_state->p2 = p2 = p1*(1.0 + 2.0*c);
+    binomial_state->p3 = p3 = p2 + c/laml;
+    binomial_state->p4 = p3 + c/lamr;
+}
+
 template<typename T>
 __device__ int64_t rk_binomial_btpe(T& state, long n, double p, rk_binomial_state *binomial_state) {
     double r,q,fm,p1,xm,xl,xr,c,laml,lamr,p2,p3,p4;
@@ -474,42 +1088,22 @@ __device__ int64_t rk_binomial_btpe(T& state, long n, double p, rk_binomial_stat
     if (!(binomial_state->initialized) ||
          (binomial_state->nsave != n) ||
          (binomial_state->psave != p)) {
-        /* initialize */
-        binomial_state->nsave = n;
-        binomial_state->psave = p;
-        binomial_state->initialized = 1;
-        binomial_state->r = r = min(p, 1.0-p);
-        binomial_state->q = q = 1.0 - r;
-        binomial_state->fm = fm = n*r+r;
-        binomial_state->m = m = (long)floor(binomial_state->fm);
-        binomial_state->p1 = p1 = floor(2.195*sqrt(n*r*q)-4.6*q) + 0.5;
-        binomial_state->xm = xm = m + 0.5;
-        binomial_state->xl = xl = xm - p1;
-        binomial_state->xr = xr = xm + p1;
-        binomial_state->c = c = 0.134 + 20.5/(15.3 + m);
-        a = (fm - xl)/(fm-xl*r);
-        binomial_state->laml = laml = a*(1.0 + a/2.0);
-        a = (xr - fm)/(xr*q);
-        binomial_state->lamr = lamr = a*(1.0 + a/2.0);
-        binomial_state->p2 = p2 = p1*(1.0 + 2.0*c);
-        binomial_state->p3 = p3 = p2 + c/laml;
-        binomial_state->p4 = p4 = p3 + c/lamr;
-    } else {
-        r = binomial_state->r;
-        q = binomial_state->q;
-        fm = binomial_state->fm;
-        m = binomial_state->m;
-        p1 = binomial_state->p1;
-        xm = binomial_state->xm;
-        xl = binomial_state->xl;
-        xr = binomial_state->xr;
-        c = binomial_state->c;
-        laml = binomial_state->laml;
-        lamr = binomial_state->lamr;
-        p2 = binomial_state->p2;
-        p3 = binomial_state->p3;
-        p4 = binomial_state->p4;
+        rk_binomial_btpe_init(n, p, binomial_state);
     }
+    r = binomial_state->r;
+    q = binomial_state->q;
+    fm = binomial_state->fm;
+    m = binomial_state->m;
+    p1 = binomial_state->p1;
+    xm = binomial_state->xm;
+    xl = binomial_state->xl;
+    xr = binomial_state->xr;
+    c = binomial_state->c;
+    laml = binomial_state->laml;
+    lamr = binomial_state->lamr;
+    p2 = binomial_state->p2;
+    p3 = binomial_state->p3;
+    p4 = binomial_state->p4;
   /* sigh ... */
   Step10:
     nrq = n*r*q;
@@ -582,6 +1176,17 @@ __device__ int64_t rk_binomial_btpe(T& state, long n, double p, rk_binomial_stat
     return y;
 }
 
+__device__ void rk_binomial_inversion_init(int n, double p, rk_binomial_state *binomial_state) {
+    double q, np;
+    binomial_state->nsave = n;
+    binomial_state->psave = p;
+    binomial_state->initialized = 1;
+    binomial_state->q = q = 1.0 - p;
+    binomial_state->r = exp(n * log(q));
+    binomial_state->c = np = n*p;
+    binomial_state->m = min((double)n, np + 10.0*sqrt(np*q + 1));
+}
+
 template<typename T>
 __device__ int64_t rk_binomial_inversion(T& state, int n, double p, rk_binomial_state *binomial_state) {
     double q, qn, np, px, U;
@@ -590,19 +1195,12 @@ __device__ int64_t rk_binomial_inversion(T& state, int n, double p, rk_binomial_
     if (!(binomial_state->initialized) ||
          (binomial_state->nsave != n) ||
          (binomial_state->psave != p)) {
-        binomial_state->nsave = n;
-        binomial_state->psave = p;
-        binomial_state->initialized = 1;
-        binomial_state->q = q = 1.0 - p;
-        binomial_state->r = qn = exp(n * log(q));
-        binomial_state->c = np = n*p;
-        binomial_state->m = bound = min((double)n, np + 10.0*sqrt(np*q + 1));
-    } else {
-        q = binomial_state->q;
-        qn = binomial_state->r;
-        np = binomial_state->c;
-        bound = binomial_state->m;
+        rk_binomial_inversion_init(n, p, binomial_state);
     }
+    q = binomial_state->q;
+    qn = binomial_state->r;
+    np = binomial_state->c;
+    bound = binomial_state->m;
     X = 0;
     px = qn;
     U = state.rk_double();
@@ -640,6 +1238,52 @@ __device__ int64_t rk_binomial(T& state, int n, double p, rk_binomial_state *bin
     }
 }
 
+// Fills `binomial_state` the same way the first draw of rk_binomial would,
+// so that draws with these parameters find it initialized.
+__device__ void rk_binomial_setup(int n, double p, rk_binomial_state *binomial_state) {
+    if (p <= 0.5) {
+        if (p*n <= 30.0) {
+            rk_binomial_inversion_init(n, p, binomial_state);
+        } else {
+            rk_binomial_btpe_init(n, p, binomial_state);
+        }
+    } else {
+        double q = 1.0-p;
+        if (q*n <= 30.0) {
+            rk_binomial_inversion_init(n, q, binomial_state);
+        } else {
+            rk_binomial_btpe_init(n, q, binomial_state);
+        }
+    }
+}
+
+// Draws an index of the alias table of Walker and Vose built by
+// `alias_setup`: a uniform column, then the column itself or its alias.
+template<typename T>
+__device__ int64_t rk_alias(T& state, int64_t n, const double *prob, const int64_t *alias) {
+    double x = state.rk_double() * n;
+    int64_t i = min(static_cast<int64_t>(x), n - 1);
+    return (x - i < prob[i]) ? i : alias[i];
+}
+
+// Splits n trials over the k categories of pvals with a binomial draw per
+// category, conditioned on the trials left and the probability left.
+template<typename T>
+__device__ void rk_multinomial(T& state, int64_t n, const double *pvals, int64_t k, int64_t *out, rk_binomial_state *binomial_state) {
+    double remaining = 1.0;
+    for (int64_t j = 0; j < k - 1; j++) {
+        int64_t count = 0;
+        if (n > 0 && pvals[j] > 0) {
+            double p = remaining > pvals[j] ? pvals[j] / remaining : 1.0;
+            binomial_state->initialized = 0;
+            count = rk_binomial(state, n, p, binomial_state);
+        }
+        out[j] = count;
+        n -= count;
+        remaining -= pvals[j];
+    }
+    out[k - 1] = n;
+}
 
 struct raw_functor {
     template<typename... Args>
@@ -735,6 +1379,72 @@ struct standard_normal_float_functor {
     }
 };
 
+struct ziggurat_normal_functor {
+    template<typename T>
+    __device__ double operator () (T& state) {
+        return rk_ziggurat_normal(state);
+    }
+};
+
+struct ziggurat_normal_float_functor {
+    template<typename T>
+    __device__ float operator () (T& state) {
+        return rk_ziggurat_normal_float(state);
+    }
+};
+
+struct ziggurat_exponential_functor {
+    template<typename T>
+    __device__ double operator () (T& state) {
+        return rk_ziggurat_exponential(state);
+    }
+};
+
+struct ziggurat_gamma_functor {
+    template<typename T>
+    __device__ double operator () (T& state, double shape) {
+        return rk_standard_gamma<T, ziggurat_sampler>(state, shape);
+    }
+};
+
+// Vector functors, `scalar_functor` is used when the output is not aligned
+// for vector stores
+struct random_uniform_vec_functor {
+    using vector_type = double2;
+    using scalar_functor = random_uniform_functor;
+    template<typename T>
+    __device__ double2 operator () (T& state) {
+        return state.rk_double2();
+    }
+};
+
+struct random_uniform_float_vec_functor {
+    using vector_type = float4;
+    using scalar_functor = random_uniform_float_functor;
+    template<typename T>
+    __device__ float4 operator () (T& state) {
+        return state.rk_float4();
+    }
+};
+
+struct standard_normal_vec_functor {
+    using vector_type = double2;
+    using scalar_functor = standard_normal_functor;
+    template<typename T>
+    __device__ double2 operator () (T& state) {
+        return state.rk_normal2();
+    }
+};
+
+struct standard_normal_float_vec_functor {
+    using vector_type = float4;
+    using scalar_functor = standard_normal_float_functor;
+    template<typename T>
+    __device__ float4 operator () (T& state) {
+        return state.rk_normal_float4();
+    }
+};
+
 // There are several errors when trying to do this a full template
 struct standard_gamma_functor {
     template<typename... Args>
@@ -750,6 +1460,22 @@ struct binomial_functor {
     }
 };
 
+// Draws with the setup precomputed by `binomial_setup` for the parameters of
+// this element; the entry is only read since it always matches (n, p).
+struct binomial_table_functor {
+    template<typename T>
+    __device__ int64_t operator () (T& state, int n, double p, intptr_t table, int64_t index) {
+        return rk_binomial(state, n, p, reinterpret_cast<rk_binomial_state*>(table) + index);
+    }
+};
+
+struct alias_functor {
+    template<typename T>
+    __device__ int64_t operator () (T& state, int64_t n, intptr_t prob, intptr_t alias) {
+        return rk_alias(state, n, reinterpret_cast<const double*>(prob), reinterpret_cast<const int64_t*>(alias));
+    }
+};
+
 // The following templates are used to unwrap arrays into an elementwise
 // approach, the array is `_array_data` in `cupy/random/_generator_api.pyx`.
 // When a pointer to `array_data<T>` is present in the variadic Args, it will
@@ -758,39 +1484,96 @@ struct binomial_functor {
 template<typename T>
 struct array_data {};  // opaque type always used as a pointer type
 
+// Reads the `_array_data` metadata once per thread. The host collapses the
+// dimensions beforehand, so C-contiguous parameters and broadcast scalars
+// have ndim 1 (offset is id * stride), parameters broadcast along one axis
+// have ndim 2 (a single division), and only the remaining arrays take the
+// general loop, which computes each remainder from its quotient.
 template<typename T>
-__device__ T get_index(array_data<T> *value, ssize_t id, ssize_t state_size) {
-    int64_t* data = reinterpret_cast<int64_t*>(value);
-    intptr_t ptr = reinterpret_cast<intptr_t>(data[0]);
-    int ndim = data[1];
-    ptrdiff_t offset = 0;
-    for (int dim = ndim; --dim >= 0; ) {
-        offset += data[ndim + dim + 2] * (id % data[dim + 2]);
-        id /= data[dim + 2];
+struct array_indexer {
+    const char* _ptr;
+    const int64_t* _data;
+    int _ndim;
+    int64_t _shape1;
+    ptrdiff_t _stride0, _stride1;
+
+    __device__ array_indexer(array_data<T> *value) {
+        _data = reinterpret_cast<const int64_t*>(value);
+        _ptr = reinterpret_cast<const char*>(_data[0]);
+        _ndim = _data[1];
+        if (_ndim == 1) {
+            _stride0 = _data[3];
+        } else if (_ndim == 2) {
+            _shape1 = _data[3];
+            _stride0 = _data[4];
+            _stride1 = _data[5];
+        }
+    }
+
+    __device__ T operator()(ssize_t id) const {
+        ptrdiff_t offset = 0;
+        if (_ndim == 1) {
+            offset = id * _stride0;
+        } else if (_ndim == 2) {
+            ssize_t q = id / _shape1;
+            offset = q * _stride0 + (id - q * _shape1) * _stride1;
+        } else {
+            for (int dim = _ndim; --dim >= 0; ) {
+                int64_t extent = _data[dim + 2];
+                ssize_t q = id / extent;
+                offset += _data[_ndim + dim + 2] * (id - q * extent);
+                id = q;
+            }
+        }
+        return *reinterpret_cast<const T*>(_ptr + offset);
     }
-    return *reinterpret_cast<T*>(ptr + offset);
+};
+
+template<typename T>
+__device__ array_indexer<T> make_indexer(array_data<T> *value) {
+    return array_indexer<T>(value);
+}
+
+template<typename T>
+__device__ T make_indexer(T value) {
+    return value;
 }
 
 template<typename T>
-__device__ typename std::enable_if<std::is_arithmetic<T>::value, T>::type get_index(T value, ssize_t id, ssize_t state_size) {
+__device__ T get_index(const array_indexer<T>& value, ssize_t id, ssize_t n_threads) {
+    return value(id);
+}
+
+template<typename T>
+__device__ typename std::enable_if<std::is_arithmetic<T>::value, T>::type get_index(T value, ssize_t id, ssize_t n_threads) {
     return value;
 }
 
+// One binomial state per logical thread; `state_size` is the output stride
 __device__ rk_binomial_state* get_index(rk_binomial_state *value, ssize_t id, ssize_t state_size) {
     return (value + id % state_size);
 }
 
-template<typename F, typename T, typename R, typename... Args>
-__global__ void execute_dist( intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, Args... args) {
-    R* out_ptr = reinterpret_cast<R*>(out);
+template<typename F, typename T, typename R, typename... I>
+__device__ void draw_dist(T& random, ssize_t tid, ssize_t state_size, R* out_ptr, ssize_t size, I... indexers) {
     F func;
-    T random(blockIdx.x * blockDim.x + threadIdx.x, state);
-    for (ssize_t id = blockIdx.x * blockDim.x + threadIdx.x;
-             id < size; 
-             id += state_size) {
-        out_ptr[id] = func(random, (get_index(args, id, state_size))...);
+    for (ssize_t id = tid; id < size; id += state_size) {
+        random.seek(id);
+        out_ptr[id] = func(random, (get_index(indexers, id, state_size))...);
+    }
+}
+
+// Each launched thread runs the logical threads `i` below `n_logical` (at
+// most the number of states) that it is a multiple of the grid apart from.
+// Logical thread `i` uses state `i` and strides over the output by
+// `state_size`, whatever the size of the grid.
+template<typename F, typename T, typename R, typename... Args>
+__global__ void execute_dist(intptr_t state, ssize_t state_size, ssize_t n_logical, intptr_t out, ssize_t size, Args... args) {
+    const ssize_t stride = static_cast<ssize_t>(gridDim.x) * blockDim.x;
+    for (ssize_t tid = blockIdx.x * blockDim.x + threadIdx.x; tid < n_logical; tid += stride) {
+        T random(tid, state);
+        draw_dist<F>(random, tid, state_size, reinterpret_cast<R*>(out), size, make_indexer(args)...);
     }
-    return;
 }
 
 template <typename F, typename R>
@@ -798,11 +1581,94 @@ struct kernel_launcher {
     kernel_launcher(ssize_t size, cudaStream_t stream) : _size(size), _stream(stream) {
     }
     template<typename T, typename... Args>
-    void operator()(Args&&... args) { 
-        int tpb = 256;
-        // Launch one thread per state size
-        int bpg = (_size + tpb - 1) / tpb; 
-        execute_dist<F, T, R><<<bpg, tpb, 0, _stream>>>(std::forward<Args>(args)...);
+    void operator()(intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, Args&&... args) { 
+        auto kernel = execute_dist<F, T, R, typename std::decay<Args>::type...>;
+        launch_config config = grid_stride_config(kernel, _size, size);
+        kernel<<<config.grid_size, config.block_size, 0, _stream>>>(state, _size, config.n_logical, out, size, std::forward<Args>(args)...);
+    }
+    ssize_t _size;
+    cudaStream_t _stream;
+};
+
+// Each thread draws a whole vector per iteration and writes it with a single
+// vector store. The elements that do not fill a vector are written by the
+// thread whose turn is next.
+template<typename F, typename T, typename R>
+__global__ void execute_dist_vec(intptr_t state, ssize_t state_size, ssize_t n_logical, intptr_t out, ssize_t size) {
+    using V = typename F::vector_type;
+    constexpr int N = sizeof(V) / sizeof(R);
+    V* out_ptr = reinterpret_cast<V*>(out);
+    F func;
+    const ssize_t n_vec = size / N;
+    const ssize_t tail = size - n_vec * N;
+    const ssize_t stride = static_cast<ssize_t>(gridDim.x) * blockDim.x;
+    for (ssize_t tid = blockIdx.x * blockDim.x + threadIdx.x; tid < n_logical; tid += stride) {
+        T random(tid, state);
+        for (ssize_t id = tid; id < n_vec; id += state_size) {
+            out_ptr[id] = func(random);
+        }
+        if (tail > 0 && tid == n_vec % state_size) {
+            V v = func(random);
+            const R* lanes = reinterpret_cast<const R*>(&v);
+            R* tail_ptr = reinterpret_cast<R*>(out_ptr + n_vec);
+            for (ssize_t i = 0; i < tail; i++) {
+                tail_ptr[i] = lanes[i];
+            }
+        }
+    }
+}
+
+template <typename F, typename R>
+struct vector_kernel_launcher {
+    vector_kernel_launcher(ssize_t size, cudaStream_t stream) : _size(size), _stream(stream) {
+    }
+    template<typename T>
+    void operator()(intptr_t state, ssize_t state_size, intptr_t out, ssize_t size) {
+        using V = typename F::vector_type;
+        if constexpr (T::per_element) {
+            // Vectors would tie neighbouring elements to one subsequence
+            kernel_launcher<typename F::scalar_functor, R> launcher(_size, _stream);
+            launcher.template operator()<T>(state, state_size, out, size);
+        } else if (out % sizeof(V) != 0) {
+            kernel_launcher<typename F::scalar_functor, R> launcher(_size, _stream);
+            launcher.template operator()<T>(state, state_size, out, size);
+        } else {
+            constexpr ssize_t N = sizeof(V) / sizeof(R);
+            auto kernel = execute_dist_vec<F, T, R>;
+            launch_config config = grid_stride_config(kernel, _size, (size + N - 1) / N);
+            kernel<<<config.grid_size, config.block_size, 0, _stream>>>(state, _size, config.n_logical, out, size);
+        }
+    }
+    ssize_t _size;
+    cudaStream_t _stream;
+};
+
+// Each multinomial sample writes its k counts, so it does not fit the
+// single output of `draw_dist`; the threads stride over the samples the same
+// way, with a binomial state of their own.
+template<typename T>
+__global__ void execute_multinomial(intptr_t state, ssize_t state_size, ssize_t n_logical, intptr_t out, ssize_t size, array_data<int64_t>* n, intptr_t pvals, int64_t k) {
+    array_indexer<int64_t> n_indexer(n);
+    int64_t* out_ptr = reinterpret_cast<int64_t*>(out);
+    const ssize_t stride = static_cast<ssize_t>(gridDim.x) * blockDim.x;
+    for (ssize_t tid = blockIdx.x * blockDim.x + threadIdx.x; tid < n_logical; tid += stride) {
+        T random(tid, state);
+        rk_binomial_state binomial_state;
+        for (ssize_t id = tid; id < size; id += state_size) {
+            random.seek(id);
+            rk_multinomial(random, n_indexer(id), reinterpret_cast<const double*>(pvals), k, out_ptr + id * k, &binomial_state);
+        }
+    }
+}
+
+struct multinomial_launcher {
+    multinomial_launcher(ssize_t size, cudaStream_t stream) : _size(size), _stream(stream) {
+    }
+    template<typename T, typename... Args>
+    void operator()(intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, Args&&... args) {
+        auto kernel = execute_multinomial<T>;
+        launch_config config = grid_stride_config(kernel, _size, size);
+        kernel<<<config.grid_size, config.block_size, 0, _stream>>>(state, _size, config.n_logical, out, size, std::forward<Args>(args)...);
     }
     ssize_t _size;
     cudaStream_t _stream;
@@ -815,12 +1681,12 @@ void raw(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_
 }
 
 void random_uniform(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {
-    kernel_launcher<random_uniform_functor, double> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
+    vector_kernel_launcher<random_uniform_vec_functor, double> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
     generator_dispatcher(generator, launcher, state, state_size, out, size);
 }
 
 void random_uniform_float(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {
-    kernel_launcher<random_uniform_float_functor, float> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
+    vector_kernel_launcher<random_uniform_float_vec_functor, float> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
     generator_dispatcher(generator, launcher, state, state_size, out, size);
 }
 
@@ -866,12 +1732,12 @@ void poisson(int generator, intptr_t state, ssize_t state_size, intptr_t out, ss
 }
 
 void standard_normal(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {
-    kernel_launcher<standard_normal_functor, double> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
+    vector_kernel_launcher<standard_normal_vec_functor, double> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
     generator_dispatcher(generator, launcher, state, state_size, out, size);
 }
 
 void standard_normal_float(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {
-    kernel_launcher<standard_normal_float_functor, float> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
+    vector_kernel_launcher<standard_normal_float_vec_functor, float> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
     generator_dispatcher(generator, launcher, state, state_size, out, size);
 }
 
@@ -885,6 +1751,136 @@ void binomial(int generator, intptr_t state, ssize_t state_size, intptr_t out, s
     generator_dispatcher(generator, launcher, state, state_size, out, size, reinterpret_cast<array_data<int>*>(n), reinterpret_cast<array_data<double>*>(p), reinterpret_cast<rk_binomial_state*>(binomial_state));
 }
 
+void standard_normal_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {
+    ziggurat_tables_init();
+    kernel_launcher<ziggurat_normal_functor, double> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
+    generator_dispatcher(generator, launcher, state, state_size, out, size);
+}
+
+void standard_normal_float_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {
+    ziggurat_tables_init();
+    kernel_launcher<ziggurat_normal_float_functor, float> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
+    generator_dispatcher(generator, launcher, state, state_size, out, size);
+}
+
+void exponential_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {
+    ziggurat_tables_init();
+    kernel_launcher<ziggurat_exponential_functor, double> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
+    generator_dispatcher(generator, launcher, state, state_size, out, size);
+}
+
+void standard_gamma_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t shape) {
+    ziggurat_tables_init();
+    kernel_launcher<ziggurat_gamma_functor, double> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
+    generator_dispatcher(generator, launcher, state, state_size, out, size, reinterpret_cast<array_data<double>*>(shape));
+}
+
+void binomial_table(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t n, intptr_t p, intptr_t table, intptr_t index) {
+    kernel_launcher<binomial_table_functor, int64_t> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
+    generator_dispatcher(generator, launcher, state, state_size, out, size, reinterpret_cast<array_data<int>*>(n), reinterpret_cast<array_data<double>*>(p), table, reinterpret_cast<array_data<int64_t>*>(index));
+}
+
+__global__ void binomial_setup_kernel(array_data<int>* n, array_data<double>* p, rk_binomial_state* table, ssize_t size) {
+    array_indexer<int> n_indexer(n);
+    array_indexer<double> p_indexer(p);
+    for (ssize_t id = blockIdx.x * blockDim.x + threadIdx.x;
+             id < size;
+             id += blockDim.x * gridDim.x) {
+        rk_binomial_setup(n_indexer(id), p_indexer(id), table + id);
+    }
+}
+
+void binomial_setup(intptr_t n, intptr_t p, intptr_t table, ssize_t size, intptr_t stream) {
+    launch_config config = occupancy_config(binomial_setup_kernel);
+    ssize_t bpg = (size + config.block_size - 1) / config.block_size;
+    if (config.grid_size > 0) {
+        bpg = std::min<ssize_t>(bpg, config.grid_size);
+    }
+    binomial_setup_kernel<<<bpg, config.block_size, 0, reinterpret_cast<cudaStream_t>(stream)>>>(reinterpret_cast<array_data<int>*>(n), reinterpret_cast<array_data<double>*>(p), reinterpret_cast<rk_binomial_state*>(table), size);
+}
+
+void alias_choice(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, int64_t n, intptr_t prob, intptr_t alias) {
+    kernel_launcher<alias_functor, int64_t> launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
+    generator_dispatcher(generator, launcher, state, state_size, out, size, n, prob, alias);
+}
+
+// Builds the alias table of the weights q, scaled to a mean of 1, as Vose's
+// sweep would: the light columns (q < 1) are served in order by the heavy
+// ones taken in order, each heavy column giving its excess until it turns
+// light and is served by the next one. The sweep is found in closed form
+// from inclusive prefix sums, so that every column is paired by a binary
+// search: `deficit` sums 1 - q over the light columns up to each column,
+// `heavy` lists the heavy columns in order and `excess` sums q - 1 over
+// them, both padded with a column n of infinite excess; `rank` is the
+// position of each heavy column in `heavy`. A light column is then served
+// by the first heavy column whose excess covers the deficits before it,
+// and a heavy one turns light past the last light column it covers, even
+// when no light column is left for it, and is served by the next heavy one.
+// prob and alias are filled beforehand with 1 and the identity, which is
+// what the columns left (up to rounding) keep.
+__device__ ssize_t alias_lower_bound(const double* a, ssize_t n, double v) {
+    ssize_t lo = 0, hi = n;
+    while (lo < hi) {
+        ssize_t mid = lo + (hi - lo) / 2;
+        if (a[mid] < v) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+__device__ ssize_t alias_upper_bound(const double* a, ssize_t n, double v) {
+    ssize_t lo = 0, hi = n;
+    while (lo < hi) {
+        ssize_t mid = lo + (hi - lo) / 2;
+        if (a[mid] <= v) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+__global__ void alias_setup_kernel(const double* q, const double* deficit, const int64_t* heavy, const double* excess, const int64_t* rank, double* prob, int64_t* alias, ssize_t n) {
+    for (ssize_t id = blockIdx.x * blockDim.x + threadIdx.x;
+             id < n;
+             id += blockDim.x * gridDim.x) {
+        if (q[id] < 1.0) {
+            double before = id > 0 ? deficit[id - 1] : 0.0;
+            ssize_t r = alias_lower_bound(excess, n, before);
+            if (r < n && heavy[r] < n) {
+                prob[id] = q[id];
+                alias[id] = heavy[r];
+            }
+        } else {
+            int64_t r = rank[id];
+            double left = excess[r];
+            ssize_t t = alias_upper_bound(deficit, n, left);
+            if (t < n && heavy[r + 1] < n) {
+                prob[id] = min(max(left + 1.0 - deficit[t], 0.0), 1.0);
+                alias[id] = heavy[r + 1];
+            }
+        }
+    }
+}
+
+void alias_setup(intptr_t q, intptr_t deficit, intptr_t heavy, intptr_t excess, intptr_t rank, intptr_t prob, intptr_t alias, ssize_t size, intptr_t stream) {
+    launch_config config = occupancy_config(alias_setup_kernel);
+    ssize_t bpg = (size + config.block_size - 1) / config.block_size;
+    if (config.grid_size > 0) {
+        bpg = std::min<ssize_t>(bpg, config.grid_size);
+    }
+    alias_setup_kernel<<<bpg, config.block_size, 0, reinterpret_cast<cudaStream_t>(stream)>>>(reinterpret_cast<const double*>(q), reinterpret_cast<const double*>(deficit), reinterpret_cast<const int64_t*>(heavy), reinterpret_cast<const double*>(excess), reinterpret_cast<const int64_t*>(rank), reinterpret_cast<double*>(prob), reinterpret_cast<int64_t*>(alias), size);
+}
+
+void multinomial(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t n, intptr_t pvals, int64_t k) {
+    multinomial_launcher launcher(state_size, reinterpret_cast<cudaStream_t>(stream));
+    generator_dispatcher(generator, launcher, state, state_size, out, size, reinterpret_cast<array_data<int64_t>*>(n), pvals, k);
+}
+
 #else
 // the stubs need to be redeclared here for HIP versions less than 4.3 to avoid redeclarations in cython when importing the headers
 // No cuda will not compile the .cu file, so the definition needs to be done here explicitly
@@ -904,5 +1900,19 @@ void standard_normal(int generator, intptr_t state, ssize_t state_size, intptr_t
 void standard_normal_float(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {}
 void standard_gamma(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t shape) {}
 void binomial(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t n, intptr_t p, intptr_t binomial_state) {}
+void standard_normal_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {}
+void standard_normal_float_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {}
+void exponential_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {}
+void standard_gamma_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t shape) {}
+void binomial_table(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t n, intptr_t p, intptr_t table, intptr_t index) {}
+void binomial_setup(intptr_t n, intptr_t p, intptr_t table, ssize_t size, intptr_t stream) {}
+void alias_choice(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, int64_t n, intptr_t prob, intptr_t alias) {}
+void alias_setup(intptr_t q, intptr_t deficit, intptr_t heavy, intptr_t excess, intptr_t rank, intptr_t prob, intptr_t alias, ssize_t size, intptr_t stream) {}
+void multinomial(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t n, intptr_t pvals, int64_t k) {}
+void get_launch_config(int* block_size, int* grid_size, ssize_t* n_threads) {
+    *block_size = 0;
+    *grid_size = 0;
+    *n_threads = 0;
+}
 
 #endif
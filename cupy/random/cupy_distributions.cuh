@@ -16,7 +16,11 @@ typedef SSIZE_T ssize_t;
 enum RandGenerators{
    CURAND_XOR_WOW,
    CURAND_MRG32k3a,
-   CURAND_PHILOX_4x32_10
+   CURAND_PHILOX_4x32_10,
+   CURAND_PHILOX_4x32_10_COUNTER,
+   CURAND_PHILOX_4x32_10_SHARDED,
+   QUASI_SOBOL,
+   QUASI_HALTON
 };
 
 struct rk_binomial_state {
@@ -45,6 +49,14 @@ typedef struct {} hiprandStateMRG32k3a;
 typedef struct {} hiprandStatePhilox4_32_10_t;
 #endif
 #define cudaStream_t hipStream_t
+#define cudaSuccess hipSuccess
+#define cudaGetDevice hipGetDevice
+#define cudaGetLastError hipGetLastError
+#define cudaOccupancyMaxPotentialBlockSize hipOccupancyMaxPotentialBlockSize
+#define cudaMemcpyToSymbol hipMemcpyToSymbol
+#define cudaMalloc hipMalloc
+#define cudaMemcpy hipMemcpy
+#define cudaMemcpyHostToDevice hipMemcpyHostToDevice
 #define curandState hiprandState
 #define curandStateMRG32k3a hiprandStateMRG32k3a
 #define curandStatePhilox4_32_10_t hiprandStatePhilox4_32_10_t
@@ -77,6 +89,16 @@ void standard_normal(int generator, intptr_t state, ssize_t state_size, intptr_t
 void standard_normal_float(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream);
 void standard_gamma(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t shape);
 void binomial(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t n, intptr_t p, intptr_t binomial_state);
+void standard_normal_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream);
+void standard_normal_float_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream);
+void exponential_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream);
+void standard_gamma_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t shape);
+void binomial_table(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t n, intptr_t p, intptr_t table, intptr_t index);
+void binomial_setup(intptr_t n, intptr_t p, intptr_t table, ssize_t size, intptr_t stream);
+void alias_choice(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, int64_t n, intptr_t prob, intptr_t alias);
+void alias_setup(intptr_t q, intptr_t deficit, intptr_t heavy, intptr_t excess, intptr_t rank, intptr_t prob, intptr_t alias, ssize_t size, intptr_t stream);
+void multinomial(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t n, intptr_t pvals, int64_t k);
+void get_launch_config(int* block_size, int* grid_size, ssize_t* n_threads);
 
 #else
 // --no -cuda will not compile the .cu file, so the definition needs to be done here explicitly
@@ -99,6 +121,20 @@ void standard_normal(int generator, intptr_t state, ssize_t state_size, intptr_t
 void standard_normal_float(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {}
 void standard_gamma(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t shape) {}
 void binomial(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t n, intptr_t p, intptr_t binomial_state) {}
+void standard_normal_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {}
+void standard_normal_float_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {}
+void exponential_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream) {}
+void standard_gamma_ziggurat(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t shape) {}
+void binomial_table(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t n, intptr_t p, intptr_t table, intptr_t index) {}
+void binomial_setup(intptr_t n, intptr_t p, intptr_t table, ssize_t size, intptr_t stream) {}
+void alias_choice(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, int64_t n, intptr_t prob, intptr_t alias) {}
+void alias_setup(intptr_t q, intptr_t deficit, intptr_t heavy, intptr_t excess, intptr_t rank, intptr_t prob, intptr_t alias, ssize_t size, intptr_t stream) {}
+void multinomial(int generator, intptr_t state, ssize_t state_size, intptr_t out, ssize_t size, intptr_t stream, intptr_t n, intptr_t pvals, int64_t k) {}
+void get_launch_config(int* block_size, int* grid_size, ssize_t* n_threads) {
+    *block_size = 0;
+    *grid_size = 0;
+    *n_threads = 0;
+}
 
 #endif
 
@@ -49,6 +49,7 @@ cpdef enum:
 
     # CUresult
     CUDA_ERROR_INVALID_VALUE = 1
+    CUDA_ERROR_OUT_OF_MEMORY = 2
 
     # CUarray_format
     CU_AD_FORMAT_UNSIGNED_INT8 = 0x01
@@ -76,3 +77,18 @@ cpdef enum:
     CU_TRSF_READ_AS_INTEGER = 0x01
     CU_TRSF_NORMALIZED_COORDINATES = 0x02
     CU_TRSF_SRGB = 0x10
+
+    # CUmemAllocationType
+    CU_MEM_ALLOCATION_TYPE_PINNED = 0x1
+
+    # CUmemLocationType
+    CU_MEM_LOCATION_TYPE_DEVICE = 0x1
+
+    # CUmemAccess_flags
+    CU_MEM_ACCESS_FLAGS_PROT_NONE = 0x0
+    CU_MEM_ACCESS_FLAGS_PROT_READ = 0x1
+    CU_MEM_ACCESS_FLAGS_PROT_READWRITE = 0x3
+
+    # CUmemAllocationGranularity_flags
+    CU_MEM_ALLOC_GRANULARITY_MINIMUM = 0x0
+    CU_MEM_ALLOC_GRANULARITY_RECOMMENDED = 0x1
@@ -68,6 +68,24 @@ cdef F_cuOccupancyMaxPotentialBlockSize cuOccupancyMaxPotentialBlockSize
 ctypedef int (*F_cuStreamGetCtx)(Stream hStream, Context* pctx) nogil
 cdef F_cuStreamGetCtx cuStreamGetCtx
 
+# Virtual memory management
+ctypedef int (*F_cuMemGetAllocationGranularity)(size_t* granularity, const MemAllocationProp* prop, MemAllocationGranularityFlags option) nogil  # NOQA
+cdef F_cuMemGetAllocationGranularity cuMemGetAllocationGranularity
+ctypedef int (*F_cuMemAddressReserve)(Deviceptr* ptr, size_t size, size_t alignment, Deviceptr addr, unsigned long long flags) nogil  # NOQA
+cdef F_cuMemAddressReserve cuMemAddressReserve
+ctypedef int (*F_cuMemAddressFree)(Deviceptr ptr, size_t size) nogil
+cdef F_cuMemAddressFree cuMemAddressFree
+ctypedef int (*F_cuMemCreate)(MemGenericAllocationHandle* handle, size_t size, const MemAllocationProp* prop, unsigned long long flags) nogil  # NOQA
+cdef F_cuMemCreate cuMemCreate
+ctypedef int (*F_cuMemRelease)(MemGenericAllocationHandle handle) nogil
+cdef F_cuMemRelease cuMemRelease
+ctypedef int (*F_cuMemMap)(Deviceptr ptr, size_t size, size_t offset, MemGenericAllocationHandle handle, unsigned long long flags) nogil  # NOQA
+cdef F_cuMemMap cuMemMap
+ctypedef int (*F_cuMemUnmap)(Deviceptr ptr, size_t size) nogil
+cdef F_cuMemUnmap cuMemUnmap
+ctypedef int (*F_cuMemSetAccess)(Deviceptr ptr, size_t size, const MemAccessDesc* desc, size_t count) nogil  # NOQA
+cdef F_cuMemSetAccess cuMemSetAccess
+
 
 cdef extern from '../../cupy_backend.h' nogil:
     # Build-time version
@@ -137,6 +155,22 @@ cdef SoftLink _initialize():
     cuOccupancyMaxPotentialBlockSize = <F_cuOccupancyMaxPotentialBlockSize>_L.get('OccupancyMaxPotentialBlockSize')  # NOQA
     global cuStreamGetCtx
     cuStreamGetCtx = <F_cuStreamGetCtx>_L.get('StreamGetCtx')
+    global cuMemGetAllocationGranularity
+    cuMemGetAllocationGranularity = <F_cuMemGetAllocationGranularity>_L.get('MemGetAllocationGranularity')  # NOQA
+    global cuMemAddressReserve
+    cuMemAddressReserve = <F_cuMemAddressReserve>_L.get('MemAddressReserve')
+    global cuMemAddressFree
+    cuMemAddressFree = <F_cuMemAddressFree>_L.get('MemAddressFree')
+    global cuMemCreate
+    cuMemCreate = <F_cuMemCreate>_L.get('MemCreate')
+    global cuMemRelease
+    cuMemRelease = <F_cuMemRelease>_L.get('MemRelease')
+    global cuMemMap
+    cuMemMap = <F_cuMemMap>_L.get('MemMap')
+    global cuMemUnmap
+    cuMemUnmap = <F_cuMemUnmap>_L.get('MemUnmap')
+    global cuMemSetAccess
+    cuMemSetAccess = <F_cuMemSetAccess>_L.get('MemSetAccess')
 
     return _L
 
@@ -28,3 +28,19 @@ cdef extern from *:
         size_t Width
     ctypedef int Address_mode 'CUaddress_mode'
     ctypedef int Filter_mode 'CUfilter_mode'
+
+    # For Virtual Memory Management
+    ctypedef unsigned long long MemGenericAllocationHandle 'CUmemGenericAllocationHandle'  # NOQA
+    ctypedef int MemAllocationType 'CUmemAllocationType'
+    ctypedef int MemLocationType 'CUmemLocationType'
+    ctypedef int MemAccessFlags 'CUmemAccess_flags'
+    ctypedef int MemAllocationGranularityFlags 'CUmemAllocationGranularity_flags'  # NOQA
+    ctypedef struct MemLocation 'CUmemLocation':
+        MemLocationType type
+        int id
+    ctypedef struct MemAllocationProp 'CUmemAllocationProp':
+        MemAllocationType type
+        MemLocation location
+    ctypedef struct MemAccessDesc 'CUmemAccessDesc':
+        MemLocation location
+        MemAccessFlags flags
@@ -110,6 +110,18 @@ cpdef enum:
     cudaGraphDebugDotFlagsHandles = 1<<10
     cudaGraphDebugDotFlagsConditionalNodeParams = 1<<15
 
+    # cudaGraphExecUpdateResult
+    cudaGraphExecUpdateSuccess = 0x0
+    cudaGraphExecUpdateError = 0x1
+    cudaGraphExecUpdateErrorTopologyChanged = 0x2
+    cudaGraphExecUpdateErrorNodeTypeChanged = 0x3
+    cudaGraphExecUpdateErrorFunctionChanged = 0x4
+    cudaGraphExecUpdateErrorParametersChanged = 0x5
+    cudaGraphExecUpdateErrorNotSupported = 0x6
+
+    # cudaErrorGraphExecUpdateFailure (the same value on HIP)
+    cudaErrorGraphExecUpdateFailure = 910
+
 # This was a legacy mistake: the prefix "cuda" should have been removed
 # so that we can directly assign their C counterparts here. Now because
 # of backward compatibility and no flexible Cython macro (IF/ELSE), we
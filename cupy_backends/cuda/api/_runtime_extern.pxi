@@ -100,6 +100,12 @@ cdef extern from '../../cupy_backend_runtime.h' nogil:
     int cudaMemPoolTrimTo(MemPool, size_t)
     int cudaMemPoolGetAttribute(MemPool, MemPoolAttr, void*)
     int cudaMemPoolSetAttribute(MemPool, MemPoolAttr, void*)
+    int cudaMemPoolExportToShareableHandle(
+        void*, MemPool, MemAllocationHandleType, unsigned int)
+    int cudaMemPoolImportFromShareableHandle(
+        MemPool*, void*, MemAllocationHandleType, unsigned int)
+    int cudaMemPoolExportPointer(MemPoolPtrExportData*, void*)
+    int cudaMemPoolImportPointer(void**, MemPool, MemPoolPtrExportData*)
     int cudaPointerGetAttributes(_PointerAttributes* attributes,
                                  const void* ptr)
     Extent make_cudaExtent(size_t w, size_t h, size_t d)
@@ -155,6 +161,8 @@ cdef extern from '../../cupy_backend_runtime.h' nogil:
     int cudaGraphInstantiate(GraphExec*, Graph, GraphNode*, char*, size_t)
     int cudaGraphLaunch(GraphExec, driver.Stream)
     int cudaGraphUpload(GraphExec, driver.Stream)
+    int cudaGraphExecUpdate(GraphExec, Graph, GraphNode*,
+                            GraphExecUpdateResult*)
     int cudaGraphDebugDotPrint(Graph, const char*, unsigned int)
 
     # Constants
@@ -48,6 +48,7 @@ cdef extern from *:
     ctypedef int StreamCaptureMode 'cudaStreamCaptureMode'
     ctypedef void* Graph 'cudaGraph_t'
     ctypedef void* GraphExec 'cudaGraphExec_t'
+    ctypedef int GraphExecUpdateResult 'cudaGraphExecUpdateResult'
 
     # This is for the annoying nested struct cudaResourceDesc, which is not
     # perfectly supported in Cython
@@ -114,6 +115,9 @@ cdef extern from *:
     ctypedef void* MemPool 'cudaMemPool_t'
     ctypedef int MemPoolAttr 'cudaMemPoolAttr'
 
+    ctypedef struct MemPoolPtrExportData 'cudaMemPoolPtrExportData':
+        unsigned char[64] reserved
+
     ctypedef int MemAllocationType 'cudaMemAllocationType'
     ctypedef int MemAllocationHandleType 'cudaMemAllocationHandleType'
     ctypedef int MemLocationType 'cudaMemLocationType'
@@ -24,6 +24,14 @@ IF CUPY_USE_CUDA_PYTHON:
     ctypedef CUDA_ARRAY_DESCRIPTOR Array_desc
     ctypedef CUaddress_mode Address_mode
     ctypedef CUfilter_mode Filter_mode
+    ctypedef CUmemGenericAllocationHandle MemGenericAllocationHandle
+    ctypedef CUmemAllocationType MemAllocationType
+    ctypedef CUmemLocationType MemLocationType
+    ctypedef CUmemAccess_flags MemAccessFlags
+    ctypedef CUmemAllocationGranularity_flags MemAllocationGranularityFlags
+    ctypedef CUmemLocation MemLocation
+    ctypedef CUmemAllocationProp MemAllocationProp
+    ctypedef CUmemAccessDesc MemAccessDesc
 ELSE:
     include "_driver_typedef.pxi"
     from cupy_backends.cuda.api._driver_enum cimport *
@@ -99,3 +107,17 @@ cpdef occupancyMaxPotentialBlockSize(intptr_t func, size_t dynamicSMemSize,
 ###############################################################################
 
 cpdef intptr_t streamGetCtx(intptr_t stream) except? 0
+
+###############################################################################
+# Virtual memory management
+###############################################################################
+
+cpdef size_t memGetAllocationGranularity(int device, int option) except? 0
+cpdef intptr_t memAddressReserve(size_t size, size_t alignment) except? 0
+cpdef memAddressFree(intptr_t ptr, size_t size)
+cpdef unsigned long long memCreate(size_t size, int device) except? 0
+cpdef memRelease(unsigned long long handle)
+cpdef memMap(intptr_t ptr, size_t size, size_t offset,
+             unsigned long long handle)
+cpdef memUnmap(intptr_t ptr, size_t size)
+cpdef memSetAccess(intptr_t ptr, size_t size, int device)
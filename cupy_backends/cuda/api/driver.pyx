@@ -13,6 +13,7 @@ There are four differences compared to the original C API.
 """
 cimport cython  # NOQA
 from libc.stdint cimport intptr_t
+from libc.string cimport memset
 
 
 ###############################################################################
@@ -355,3 +356,80 @@ cpdef intptr_t streamGetCtx(intptr_t stream) except? 0:
         status = cuStreamGetCtx(<Stream>stream, &ctx)
     check_status(status)
     return <intptr_t>ctx
+
+###############################################################################
+# Virtual memory management
+###############################################################################
+
+cdef inline void _init_allocation_prop(MemAllocationProp* prop, int device):
+    # the pinned memory of the device
+    memset(prop, 0, sizeof(MemAllocationProp))
+    prop.type = <MemAllocationType>CU_MEM_ALLOCATION_TYPE_PINNED
+    prop.location.type = <MemLocationType>CU_MEM_LOCATION_TYPE_DEVICE
+    prop.location.id = device
+
+cpdef size_t memGetAllocationGranularity(int device, int option) except? 0:
+    initialize()
+    cdef MemAllocationProp prop
+    cdef size_t granularity
+    _init_allocation_prop(&prop, device)
+    with nogil:
+        status = cuMemGetAllocationGranularity(
+            &granularity, &prop, <MemAllocationGranularityFlags>option)
+    check_status(status)
+    return granularity
+
+cpdef intptr_t memAddressReserve(size_t size, size_t alignment) except? 0:
+    initialize()
+    cdef Deviceptr ptr
+    with nogil:
+        status = cuMemAddressReserve(&ptr, size, alignment, <Deviceptr>0, 0)
+    check_status(status)
+    return <intptr_t>ptr
+
+cpdef memAddressFree(intptr_t ptr, size_t size):
+    initialize()
+    with nogil:
+        status = cuMemAddressFree(<Deviceptr>ptr, size)
+    check_status(status)
+
+cpdef unsigned long long memCreate(size_t size, int device) except? 0:
+    initialize()
+    cdef MemAllocationProp prop
+    cdef MemGenericAllocationHandle handle
+    _init_allocation_prop(&prop, device)
+    with nogil:
+        status = cuMemCreate(&handle, size, &prop, 0)
+    check_status(status)
+    return <unsigned long long>handle
+
+cpdef memRelease(unsigned long long handle):
+    initialize()
+    with nogil:
+        status = cuMemRelease(<MemGenericAllocationHandle>handle)
+    check_status(status)
+
+cpdef memMap(intptr_t ptr, size_t size, size_t offset,
+             unsigned long long handle):
+    initialize()
+    with nogil:
+        status = cuMemMap(<Deviceptr>ptr, size, offset,
+                          <MemGenericAllocationHandle>handle, 0)
+    check_status(status)
+
+cpdef memUnmap(intptr_t ptr, size_t size):
+    initialize()
+    with nogil:
+        status = cuMemUnmap(<Deviceptr>ptr, size)
+    check_status(status)
+
+cpdef memSetAccess(intptr_t ptr, size_t size, int device):
+    """Makes the range readable and writable from the device."""
+    initialize()
+    cdef MemAccessDesc desc
+    desc.location.type = <MemLocationType>CU_MEM_LOCATION_TYPE_DEVICE
+    desc.location.id = device
+    desc.flags = <MemAccessFlags>CU_MEM_ACCESS_FLAGS_PROT_READWRITE
+    with nogil:
+        status = cuMemSetAccess(<Deviceptr>ptr, size, &desc, 1)
+    check_status(status)
@@ -76,6 +76,8 @@ IF CUPY_USE_CUDA_PYTHON:
 
     ctypedef cudaMemPoolProps _MemPoolProps
 
+    ctypedef cudaMemPoolPtrExportData MemPoolPtrExportData
+
     ctypedef cudaPointerAttributes _PointerAttributes
 
     ctypedef cudaDeviceProp DeviceProp
@@ -85,6 +87,7 @@ IF CUPY_USE_CUDA_PYTHON:
     ctypedef cudaGraph_t Graph
     ctypedef cudaGraphExec_t GraphExec
     ctypedef cudaGraphNode_t GraphNode
+    ctypedef cudaGraphExecUpdateResult GraphExecUpdateResult
 
     ctypedef cudaMemAllocationType MemAllocationType
     ctypedef cudaMemAllocationHandleType MemAllocationHandleType
@@ -258,6 +261,10 @@ cpdef memPoolDestroy(intptr_t)
 cpdef memPoolTrimTo(intptr_t, size_t)
 cpdef memPoolGetAttribute(intptr_t, int)
 cpdef memPoolSetAttribute(intptr_t, int, object)
+cpdef int memPoolExportToShareableHandle(intptr_t, int) except? -1
+cpdef intptr_t memPoolImportFromShareableHandle(int, int) except? 0
+cpdef bytes memPoolExportPointer(intptr_t)
+cpdef intptr_t memPoolImportPointer(intptr_t, bytes) except? 0
 
 
 ###############################################################################
@@ -325,6 +332,7 @@ cpdef graphExecDestroy(intptr_t graphExec)
 cpdef intptr_t graphInstantiate(intptr_t graph) except? 0
 cpdef graphLaunch(intptr_t graphExec, intptr_t stream)
 cpdef graphUpload(intptr_t graphExec, intptr_t stream)
+cpdef int graphExecUpdate(intptr_t graphExec, intptr_t graph) except? -1
 cpdef graphDebugDotPrint(intptr_t graph, str path, unsigned int flags)
 
 
@@ -827,6 +827,60 @@ cpdef memPoolSetAttribute(intptr_t pool, int attr, object value):
         status = cudaMemPoolSetAttribute(<MemPool>pool, <MemPoolAttr>attr, out)
     check_status(status)
 
+cpdef int memPoolExportToShareableHandle(
+        intptr_t pool, int handleType) except? -1:
+    # Only cudaMemHandleTypePosixFileDescriptor is supported, for which the
+    # handle is a file descriptor owned by the caller.
+    if _is_hip_environment:
+        raise RuntimeError(
+            'HIP does not support memPoolExportToShareableHandle')
+    if handleType != cudaMemHandleTypePosixFileDescriptor:
+        raise ValueError('unsupported handle type: {}'.format(handleType))
+    cdef int fd
+    with nogil:
+        status = cudaMemPoolExportToShareableHandle(
+            <void*>&fd, <MemPool>pool, <MemAllocationHandleType>handleType, 0)
+    check_status(status)
+    return fd
+
+cpdef intptr_t memPoolImportFromShareableHandle(
+        int fd, int handleType) except? 0:
+    if _is_hip_environment:
+        raise RuntimeError(
+            'HIP does not support memPoolImportFromShareableHandle')
+    if handleType != cudaMemHandleTypePosixFileDescriptor:
+        raise ValueError('unsupported handle type: {}'.format(handleType))
+    cdef MemPool pool
+    with nogil:
+        status = cudaMemPoolImportFromShareableHandle(
+            &pool, <void*><intptr_t>fd, <MemAllocationHandleType>handleType, 0)
+    check_status(status)
+    return <intptr_t>pool
+
+cpdef bytes memPoolExportPointer(intptr_t ptr):
+    if _is_hip_environment:
+        raise RuntimeError('HIP does not support memPoolExportPointer')
+    cdef MemPoolPtrExportData data
+    with nogil:
+        status = cudaMemPoolExportPointer(&data, <void*>ptr)
+    check_status(status)
+    # see ipcGetMemHandle for why the bytes are copied one by one
+    reserved = [<unsigned char>data.reserved[i] for i in range(64)]
+    return bytes(reserved)
+
+cpdef intptr_t memPoolImportPointer(intptr_t pool, bytes data) except? 0:
+    if _is_hip_environment:
+        raise RuntimeError('HIP does not support memPoolImportPointer')
+    if len(data) != 64:
+        raise ValueError('the export data must be 64 bytes')
+    cdef MemPoolPtrExportData data_c
+    cdef void* ptr
+    data_c.reserved = data
+    with nogil:
+        status = cudaMemPoolImportPointer(&ptr, <MemPool>pool, &data_c)
+    check_status(status)
+    return <intptr_t>ptr
+
 
 ###############################################################################
 # Stream and Event
@@ -1109,6 +1163,19 @@ cpdef graphUpload(intptr_t graphExec, intptr_t stream):
         status = cudaGraphUpload(<GraphExec>(graphExec), <driver.Stream>stream)
     check_status(status)
 
+cpdef int graphExecUpdate(intptr_t graphExec, intptr_t graph) except? -1:
+    # Returns the cudaGraphExecUpdateResult; a rejected update is not an
+    # error, the caller is expected to instantiate the graph instead.
+    cdef GraphNode error_node
+    cdef GraphExecUpdateResult result
+    with nogil:
+        status = cudaGraphExecUpdate(<GraphExec>graphExec, <Graph>graph,
+                                     &error_node, &result)
+    if status == cudaErrorGraphExecUpdateFailure:
+        return <int>result
+    check_status(status)
+    return <int>result
+
 cpdef graphDebugDotPrint(intptr_t graph, str path, unsigned int flags):
     if runtimeGetVersion() < 11030:
         raise RuntimeError('graphDebugDotPrint requires CUDA 11.3+')
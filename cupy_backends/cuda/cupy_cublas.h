@@ -21,4 +21,12 @@ cublasStatus_t cublasGemmStridedBatchedEx_v11(...) {
 
 #endif // if CUDA_VERSION >= 11000
 
+#if CUDA_VERSION < 12050
+
+cublasStatus_t cublasGemmGroupedBatchedEx(...) {
+    return CUBLAS_STATUS_NOT_SUPPORTED;
+}
+
+#endif // if CUDA_VERSION < 12050
+
 #endif // #ifndef INCLUDE_GUARD_CUDA_CUPY_CUBLAS_H
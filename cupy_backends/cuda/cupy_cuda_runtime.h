@@ -17,6 +17,10 @@ const int cudaErrorContextIsDestroyed = 709;
 cudaError_t cudaGraphUpload(...) {
     return cudaErrorUnknown;
 }
+
+cudaError_t cudaGraphExecUpdate(...) {
+    return cudaErrorUnknown;
+}
 #endif
 
 #if CUDA_VERSION < 11020
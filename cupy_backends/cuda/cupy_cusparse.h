@@ -623,6 +623,22 @@ typedef enum {} cusparseSpMatAttribute_t;
 typedef void* cusparseSpSMDescr_t;
 typedef enum {} cusparseSpSMAlg_t;
 
+cusparseStatus_t cusparseSpGEMMreuse_workEstimation(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
+cusparseStatus_t cusparseSpGEMMreuse_nnz(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
+cusparseStatus_t cusparseSpGEMMreuse_copy(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
+cusparseStatus_t cusparseSpGEMMreuse_compute(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
 #endif // #if CUSPARSE_VERSION < 11600
 
 #if CUSPARSE_VERSION >= 12000
@@ -339,6 +339,15 @@ cpdef gemmStridedBatchedEx(
     size_t beta,
     size_t C, int Ctype, int ldc, long long strideC,
     int batchCount, int computeType, int algo)
+cpdef gemmGroupedBatchedEx(
+    intptr_t handle, size_t transa_array, size_t transb_array,
+    size_t m_array, size_t n_array, size_t k_array,
+    size_t alpha_array,
+    size_t Aarray, int Atype, size_t lda_array,
+    size_t Barray, int Btype, size_t ldb_array,
+    size_t beta_array,
+    size_t Carray, int Ctype, size_t ldc_array,
+    int group_count, size_t group_size, int computeType)
 
 cpdef stpttr(intptr_t handle, int uplo, int n, size_t AP, size_t A, int lda)
 cpdef dtpttr(intptr_t handle, int uplo, int n, size_t AP, size_t A, int lda)
@@ -391,6 +391,16 @@ cdef extern from '../../cupy_blas.h' nogil:
         const void *beta,
         void *C, DataType Ctype, int ldc, long long strideC,
         int batchCount, ComputeType computetype, GemmAlgo algo)
+    int cublasGemmGroupedBatchedEx(
+        Handle handle,
+        const Operation *transa_array, const Operation *transb_array,
+        const int *m_array, const int *n_array, const int *k_array,
+        const void *alpha_array,
+        const void *const *Aarray, DataType Atype, const int *lda_array,
+        const void *const *Barray, DataType Btype, const int *ldb_array,
+        const void *beta_array,
+        void *const *Carray, DataType Ctype, const int *ldc_array,
+        int group_count, const int *group_size, ComputeType computeType)
     int cublasStpttr(
         Handle handle, FillMode uplo, int n, const float *AP, float *A,
         int lda)
@@ -1561,6 +1571,35 @@ cpdef gemmStridedBatchedEx(
     check_status(status)
 
 
+cpdef gemmGroupedBatchedEx(
+        intptr_t handle, size_t transa_array, size_t transb_array,
+        size_t m_array, size_t n_array, size_t k_array,
+        size_t alpha_array,
+        size_t Aarray, int Atype, size_t lda_array,
+        size_t Barray, int Btype, size_t ldb_array,
+        size_t beta_array,
+        size_t Carray, int Ctype, size_t ldc_array,
+        int group_count, size_t group_size, int computeType):
+    # The problem descriptions, alpha and beta are host arrays of a value
+    # per group, and Aarray, Barray and Carray are device arrays of a pointer
+    # per problem.
+    _setStream(handle)
+    with nogil:
+        status = cublasGemmGroupedBatchedEx(
+            <Handle>handle,
+            <const Operation*>transa_array, <const Operation*>transb_array,
+            <const int*>m_array, <const int*>n_array, <const int*>k_array,
+            <const void*>alpha_array,
+            <const void* const*>Aarray, <DataType>Atype,
+            <const int*>lda_array,
+            <const void* const*>Barray, <DataType>Btype,
+            <const int*>ldb_array,
+            <const void*>beta_array,
+            <void* const*>Carray, <DataType>Ctype, <const int*>ldc_array,
+            group_count, <const int*>group_size, <ComputeType>computeType)
+    check_status(status)
+
+
 cpdef stpttr(intptr_t handle, int uplo, int n, size_t AP, size_t A, int lda):
     _setStream(handle)
     with nogil:
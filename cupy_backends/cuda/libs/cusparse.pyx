@@ -181,6 +181,34 @@ cdef extern from '../../cupy_sparse.h' nogil:
     Status cusparseXcsrsv2_zeroPivot(
         Handle handle, csrsv2Info_t info, int* position)
 
+    Status cusparseSbsrmv(
+        Handle handle, cusparseDirection_t dirA, Operation transA, int mb,
+        int nb, int nnzb, const float *alpha, MatDescr descrA,
+        const float *bsrSortedValA, const int *bsrSortedRowPtrA,
+        const int *bsrSortedColIndA, int blockDim, const float *x,
+        const float *beta, float *y)
+
+    Status cusparseDbsrmv(
+        Handle handle, cusparseDirection_t dirA, Operation transA, int mb,
+        int nb, int nnzb, const double *alpha, MatDescr descrA,
+        const double *bsrSortedValA, const int *bsrSortedRowPtrA,
+        const int *bsrSortedColIndA, int blockDim, const double *x,
+        const double *beta, double *y)
+
+    Status cusparseCbsrmv(
+        Handle handle, cusparseDirection_t dirA, Operation transA, int mb,
+        int nb, int nnzb, const cuComplex *alpha, MatDescr descrA,
+        const cuComplex *bsrSortedValA, const int *bsrSortedRowPtrA,
+        const int *bsrSortedColIndA, int blockDim, const cuComplex *x,
+        const cuComplex *beta, cuComplex *y)
+
+    Status cusparseZbsrmv(
+        Handle handle, cusparseDirection_t dirA, Operation transA, int mb,
+        int nb, int nnzb, const cuDoubleComplex *alpha, MatDescr descrA,
+        const cuDoubleComplex *bsrSortedValA, const int *bsrSortedRowPtrA,
+        const int *bsrSortedColIndA, int blockDim, const cuDoubleComplex *x,
+        const cuDoubleComplex *beta, cuDoubleComplex *y)
+
     # cuSPARSE Level3 Function
     Status cusparseScsrmm(
         Handle handle, Operation transA, int m, int n, int k, int nnz,
@@ -331,6 +359,38 @@ cdef extern from '../../cupy_sparse.h' nogil:
     Status cusparseXcsrsm2_zeroPivot(
         Handle handle, csrsm2Info_t info, int* position)
 
+    Status cusparseSbsrmm(
+        Handle handle, cusparseDirection_t dirA, Operation transA,
+        Operation transB, int mb, int n, int kb, int nnzb,
+        const float *alpha, MatDescr descrA,
+        const float *bsrSortedValA, const int *bsrSortedRowPtrA,
+        const int *bsrSortedColIndA, int blockSize, const float *B, int ldb,
+        const float *beta, float *C, int ldc)
+
+    Status cusparseDbsrmm(
+        Handle handle, cusparseDirection_t dirA, Operation transA,
+        Operation transB, int mb, int n, int kb, int nnzb,
+        const double *alpha, MatDescr descrA,
+        const double *bsrSortedValA, const int *bsrSortedRowPtrA,
+        const int *bsrSortedColIndA, int blockSize, const double *B, int ldb,
+        const double *beta, double *C, int ldc)
+
+    Status cusparseCbsrmm(
+        Handle handle, cusparseDirection_t dirA, Operation transA,
+        Operation transB, int mb, int n, int kb, int nnzb,
+        const cuComplex *alpha, MatDescr descrA,
+        const cuComplex *bsrSortedValA, const int *bsrSortedRowPtrA,
+        const int *bsrSortedColIndA, int blockSize, const cuComplex *B,
+        int ldb, const cuComplex *beta, cuComplex *C, int ldc)
+
+    Status cusparseZbsrmm(
+        Handle handle, cusparseDirection_t dirA, Operation transA,
+        Operation transB, int mb, int n, int kb, int nnzb,
+        const cuDoubleComplex *alpha, MatDescr descrA,
+        const cuDoubleComplex *bsrSortedValA, const int *bsrSortedRowPtrA,
+        const int *bsrSortedColIndA, int blockSize, const cuDoubleComplex *B,
+        int ldb, const cuDoubleComplex *beta, cuDoubleComplex *C, int ldc)
+
     # cuSPARSE Extra Function
     Status cusparseXcsrgeamNnz(
         Handle handle, int m, int n, const MatDescr descrA, int nnzA,
@@ -1352,6 +1412,24 @@ cdef extern from '../../cupy_sparse.h' nogil:
         Handle handle, Operation opA, Operation opB, const void* alpha,
         SpMatDescr matA, SpMatDescr matB, const void* beta, SpMatDescr matC,
         DataType computeType, SpGEMMAlg alg, SpGEMMDescr spgemmDescr)
+    Status cusparseSpGEMMreuse_workEstimation(
+        Handle handle, Operation opA, Operation opB, SpMatDescr matA,
+        SpMatDescr matB, SpMatDescr matC, SpGEMMAlg alg,
+        SpGEMMDescr spgemmDescr, size_t* bufferSize1, void* externalBuffer1)
+    Status cusparseSpGEMMreuse_nnz(
+        Handle handle, Operation opA, Operation opB, SpMatDescr matA,
+        SpMatDescr matB, SpMatDescr matC, SpGEMMAlg alg,
+        SpGEMMDescr spgemmDescr, size_t* bufferSize2, void* externalBuffer2,
+        size_t* bufferSize3, void* externalBuffer3, size_t* bufferSize4,
+        void* externalBuffer4)
+    Status cusparseSpGEMMreuse_copy(
+        Handle handle, Operation opA, Operation opB, SpMatDescr matA,
+        SpMatDescr matB, SpMatDescr matC, SpGEMMAlg alg,
+        SpGEMMDescr spgemmDescr, size_t* bufferSize5, void* externalBuffer5)
+    Status cusparseSpGEMMreuse_compute(
+        Handle handle, Operation opA, Operation opB, const void* alpha,
+        SpMatDescr matA, SpMatDescr matB, const void* beta, SpMatDescr matC,
+        DataType computeType, SpGEMMAlg alg, SpGEMMDescr spgemmDescr)
     Status cusparseGather(Handle handle, DnVecDescr vecY, SpVecDescr vecX)
 
     # CSR2CSC
@@ -1748,6 +1826,62 @@ cpdef void zcsrmv(
         <cuDoubleComplex *>y)
     check_status(status)
 
+cpdef void sbsrmv(
+        intptr_t handle, int dirA, int transA, int mb, int nb, int nnzb,
+        size_t alpha, size_t descrA, size_t bsrSortedValA,
+        size_t bsrSortedRowPtrA, size_t bsrSortedColIndA, int blockDim,
+        size_t x, size_t beta, size_t y) except *:
+    _setStream(handle)
+    status = cusparseSbsrmv(
+        <Handle>handle, <cusparseDirection_t>dirA, <Operation>transA, mb, nb,
+        nnzb, <const float *>alpha, <MatDescr>descrA,
+        <const float *>bsrSortedValA, <const int *>bsrSortedRowPtrA,
+        <const int *>bsrSortedColIndA, blockDim, <const float *>x,
+        <const float *>beta, <float *>y)
+    check_status(status)
+
+cpdef void dbsrmv(
+        intptr_t handle, int dirA, int transA, int mb, int nb, int nnzb,
+        size_t alpha, size_t descrA, size_t bsrSortedValA,
+        size_t bsrSortedRowPtrA, size_t bsrSortedColIndA, int blockDim,
+        size_t x, size_t beta, size_t y) except *:
+    _setStream(handle)
+    status = cusparseDbsrmv(
+        <Handle>handle, <cusparseDirection_t>dirA, <Operation>transA, mb, nb,
+        nnzb, <const double *>alpha, <MatDescr>descrA,
+        <const double *>bsrSortedValA, <const int *>bsrSortedRowPtrA,
+        <const int *>bsrSortedColIndA, blockDim, <const double *>x,
+        <const double *>beta, <double *>y)
+    check_status(status)
+
+cpdef void cbsrmv(
+        intptr_t handle, int dirA, int transA, int mb, int nb, int nnzb,
+        size_t alpha, size_t descrA, size_t bsrSortedValA,
+        size_t bsrSortedRowPtrA, size_t bsrSortedColIndA, int blockDim,
+        size_t x, size_t beta, size_t y) except *:
+    _setStream(handle)
+    status = cusparseCbsrmv(
+        <Handle>handle, <cusparseDirection_t>dirA, <Operation>transA, mb, nb,
+        nnzb, <const cuComplex *>alpha, <MatDescr>descrA,
+        <const cuComplex *>bsrSortedValA, <const int *>bsrSortedRowPtrA,
+        <const int *>bsrSortedColIndA, blockDim, <const cuComplex *>x,
+        <const cuComplex *>beta, <cuComplex *>y)
+    check_status(status)
+
+cpdef void zbsrmv(
+        intptr_t handle, int dirA, int transA, int mb, int nb, int nnzb,
+        size_t alpha, size_t descrA, size_t bsrSortedValA,
+        size_t bsrSortedRowPtrA, size_t bsrSortedColIndA, int blockDim,
+        size_t x, size_t beta, size_t y) except *:
+    _setStream(handle)
+    status = cusparseZbsrmv(
+        <Handle>handle, <cusparseDirection_t>dirA, <Operation>transA, mb, nb,
+        nnzb, <const cuDoubleComplex *>alpha, <MatDescr>descrA,
+        <const cuDoubleComplex *>bsrSortedValA, <const int *>bsrSortedRowPtrA,
+        <const int *>bsrSortedColIndA, blockDim, <const cuDoubleComplex *>x,
+        <const cuDoubleComplex *>beta, <cuDoubleComplex *>y)
+    check_status(status)
+
 cpdef size_t csrmvEx_bufferSize(
         intptr_t handle, int alg, int transA, int m, int n,
         int nnz, size_t alpha, int alphatype, size_t descrA,
@@ -2025,6 +2159,66 @@ cpdef void zcsrmm(
         <const cuDoubleComplex *>beta, <cuDoubleComplex *>C, ldc)
     check_status(status)
 
+cpdef void sbsrmm(
+        intptr_t handle, int dirA, int transA, int transB, int mb, int n,
+        int kb, int nnzb, size_t alpha, size_t descrA, size_t bsrSortedValA,
+        size_t bsrSortedRowPtrA, size_t bsrSortedColIndA, int blockSize,
+        size_t B, int ldb, size_t beta, size_t C, int ldc) except *:
+    _setStream(handle)
+    status = cusparseSbsrmm(
+        <Handle>handle, <cusparseDirection_t>dirA, <Operation>transA,
+        <Operation>transB, mb, n, kb, nnzb, <const float *>alpha,
+        <MatDescr>descrA, <const float *>bsrSortedValA,
+        <const int *>bsrSortedRowPtrA, <const int *>bsrSortedColIndA,
+        blockSize, <const float *>B, ldb, <const float *>beta,
+        <float *>C, ldc)
+    check_status(status)
+
+cpdef void dbsrmm(
+        intptr_t handle, int dirA, int transA, int transB, int mb, int n,
+        int kb, int nnzb, size_t alpha, size_t descrA, size_t bsrSortedValA,
+        size_t bsrSortedRowPtrA, size_t bsrSortedColIndA, int blockSize,
+        size_t B, int ldb, size_t beta, size_t C, int ldc) except *:
+    _setStream(handle)
+    status = cusparseDbsrmm(
+        <Handle>handle, <cusparseDirection_t>dirA, <Operation>transA,
+        <Operation>transB, mb, n, kb, nnzb, <const double *>alpha,
+        <MatDescr>descrA, <const double *>bsrSortedValA,
+        <const int *>bsrSortedRowPtrA, <const int *>bsrSortedColIndA,
+        blockSize, <const double *>B, ldb, <const double *>beta,
+        <double *>C, ldc)
+    check_status(status)
+
+cpdef void cbsrmm(
+        intptr_t handle, int dirA, int transA, int transB, int mb, int n,
+        int kb, int nnzb, size_t alpha, size_t descrA, size_t bsrSortedValA,
+        size_t bsrSortedRowPtrA, size_t bsrSortedColIndA, int blockSize,
+        size_t B, int ldb, size_t beta, size_t C, int ldc) except *:
+    _setStream(handle)
+    status = cusparseCbsrmm(
+        <Handle>handle, <cusparseDirection_t>dirA, <Operation>transA,
+        <Operation>transB, mb, n, kb, nnzb, <const cuComplex *>alpha,
+        <MatDescr>descrA, <const cuComplex *>bsrSortedValA,
+        <const int *>bsrSortedRowPtrA, <const int *>bsrSortedColIndA,
+        blockSize, <const cuComplex *>B, ldb, <const cuComplex *>beta,
+        <cuComplex *>C, ldc)
+    check_status(status)
+
+cpdef void zbsrmm(
+        intptr_t handle, int dirA, int transA, int transB, int mb, int n,
+        int kb, int nnzb, size_t alpha, size_t descrA, size_t bsrSortedValA,
+        size_t bsrSortedRowPtrA, size_t bsrSortedColIndA, int blockSize,
+        size_t B, int ldb, size_t beta, size_t C, int ldc) except *:
+    _setStream(handle)
+    status = cusparseZbsrmm(
+        <Handle>handle, <cusparseDirection_t>dirA, <Operation>transA,
+        <Operation>transB, mb, n, kb, nnzb, <const cuDoubleComplex *>alpha,
+        <MatDescr>descrA, <const cuDoubleComplex *>bsrSortedValA,
+        <const int *>bsrSortedRowPtrA, <const int *>bsrSortedColIndA,
+        blockSize, <const cuDoubleComplex *>B, ldb,
+        <const cuDoubleComplex *>beta, <cuDoubleComplex *>C, ldc)
+    check_status(status)
+
 cpdef void scsrmm2(
         intptr_t handle, int transA, int transB, int m, int n, int k, int nnz,
         size_t alpha, size_t descrA, size_t csrValA,
@@ -5096,6 +5290,61 @@ cpdef void spGEMM_copy(
         <SpGEMMAlg>alg, <SpGEMMDescr>spgemmDescr)
     check_status(status)
 
+cpdef size_t spGEMMreuse_workEstimation(
+        intptr_t handle, Operation opA, Operation opB, size_t matA,
+        size_t matB, size_t matC, int alg, size_t spgemmDescr,
+        size_t bufferSize, intptr_t externalBuffer1) except? -1:
+    cdef size_t bufferSize1 = bufferSize
+    _setStream(handle)
+    status = cusparseSpGEMMreuse_workEstimation(
+        <Handle>handle, opA, opB, <SpMatDescr>matA, <SpMatDescr>matB,
+        <SpMatDescr>matC, <SpGEMMAlg>alg, <SpGEMMDescr>spgemmDescr,
+        &bufferSize1, <void*>externalBuffer1)
+    check_status(status)
+    return bufferSize1
+
+cpdef tuple spGEMMreuse_nnz(
+        intptr_t handle, Operation opA, Operation opB, size_t matA,
+        size_t matB, size_t matC, int alg, size_t spgemmDescr,
+        size_t bufferSize2, intptr_t externalBuffer2, size_t bufferSize3,
+        intptr_t externalBuffer3, size_t bufferSize4,
+        intptr_t externalBuffer4):
+    cdef size_t size2 = bufferSize2
+    cdef size_t size3 = bufferSize3
+    cdef size_t size4 = bufferSize4
+    _setStream(handle)
+    status = cusparseSpGEMMreuse_nnz(
+        <Handle>handle, opA, opB, <SpMatDescr>matA, <SpMatDescr>matB,
+        <SpMatDescr>matC, <SpGEMMAlg>alg, <SpGEMMDescr>spgemmDescr,
+        &size2, <void*>externalBuffer2, &size3, <void*>externalBuffer3,
+        &size4, <void*>externalBuffer4)
+    check_status(status)
+    return size2, size3, size4
+
+cpdef size_t spGEMMreuse_copy(
+        intptr_t handle, Operation opA, Operation opB, size_t matA,
+        size_t matB, size_t matC, int alg, size_t spgemmDescr,
+        size_t bufferSize, intptr_t externalBuffer5) except? -1:
+    cdef size_t bufferSize5 = bufferSize
+    _setStream(handle)
+    status = cusparseSpGEMMreuse_copy(
+        <Handle>handle, opA, opB, <SpMatDescr>matA, <SpMatDescr>matB,
+        <SpMatDescr>matC, <SpGEMMAlg>alg, <SpGEMMDescr>spgemmDescr,
+        &bufferSize5, <void*>externalBuffer5)
+    check_status(status)
+    return bufferSize5
+
+cpdef void spGEMMreuse_compute(
+        intptr_t handle, Operation opA, Operation opB, intptr_t alpha,
+        size_t matA, size_t matB, intptr_t beta, size_t matC,
+        DataType computeType, int alg, size_t spgemmDescr) except *:
+    _setStream(handle)
+    status = cusparseSpGEMMreuse_compute(
+        <Handle>handle, opA, opB, <const void*>alpha, <SpMatDescr>matA,
+        <SpMatDescr>matB, <const void*>beta, <SpMatDescr>matC, computeType,
+        <SpGEMMAlg>alg, <SpGEMMDescr>spgemmDescr)
+    check_status(status)
+
 cpdef void gather(intptr_t handle, size_t vecY, size_t vecX) except *:
     status = cusparseGather(<Handle>handle, <DnVecDescr>vecY, <SpVecDescr>vecX)
     check_status(status)
@@ -443,24 +443,26 @@ cpdef matmul(Handle handle, MatmulPlan plan,
              size_t alpha, size_t d_A, size_t d_B,
              size_t beta, size_t d_C, size_t d_D, size_t workspace):
     """Computes the matrix multiplication"""
+    cdef intptr_t stream = stream_module.get_current_stream_ptr()
     status = cusparseLtMatmul(
         <const cusparseLtHandle_t*> handle._ptr,
         <const cusparseLtMatmulPlan_t*> plan._ptr,
         <const void*> alpha, <const void*> d_A, <const void*> d_B,
         <const void*> beta, <const void*> d_C, <void*> d_D,
-        <void*> workspace, <runtime.Stream*> NULL, <int32_t> 0)
+        <void*> workspace, <runtime.Stream*> &stream, <int32_t> 1)
     check_status(status)
 
 cpdef matmulSearch(Handle handle, MatmulPlan plan,
                    size_t alpha, size_t d_A, size_t d_B,
                    size_t beta, size_t d_C, size_t d_D, size_t workspace):
     """Evaluates all available algorithms for the matrix multiplication"""
+    cdef intptr_t stream = stream_module.get_current_stream_ptr()
     status = cusparseLtMatmulSearch(
         <const cusparseLtHandle_t*> handle._ptr,
         <cusparseLtMatmulPlan_t*> plan._ptr,
         <const void*> alpha, <const void*> d_A, <const void*> d_B,
         <const void*> beta, <const void*> d_C, <void*> d_D,
-        <void*> workspace, <runtime.Stream*> NULL, <int32_t> 0)
+        <void*> workspace, <runtime.Stream*> &stream, <int32_t> 1)
     check_status(status)
 
 ###############################################################################
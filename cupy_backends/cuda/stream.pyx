@@ -1,6 +1,8 @@
 import os as _os
 import threading as _threading
 
+from libcpp cimport vector
+
 from cupy_backends.cuda.api cimport runtime
 
 
@@ -12,11 +14,11 @@ cdef bint _ptds = bool(int(
 
 
 cdef class _ThreadLocal:
-    cdef list current_stream  # list of intptr_t
+    # not a list, so that switching streams does not allocate an int object
+    cdef vector.vector[intptr_t] current_stream
 
     def __init__(self):
-        cdef int i, num_devices = runtime.getDeviceCount()
-        self.current_stream = [0 for i in range(num_devices)]
+        self.current_stream.resize(runtime.getDeviceCount(), 0)
 
     @staticmethod
     cdef _ThreadLocal get():
@@ -18,6 +18,43 @@
 #endif // #if !defined(CUPY_NO_CUDA) && !defined(CUPY_USE_HIP)
 
 
+/*
+ * Spreads the matrices of a loop-based batched solver over a pool of
+ * streams, so that the (small) per-matrix calls can overlap: the i-th matrix
+ * runs on streams[i % n_streams] with its own slot of the workspace. With
+ * n_streams == 0 everything runs on the handle's stream. The caller orders
+ * the pool streams with respect to the handle's stream, and the handle's
+ * stream is restored on destruction.
+ */
+class batch_stream_pool {
+  public:
+    batch_stream_pool(intptr_t handle, intptr_t streams_ptr, int n_streams)
+            : handle_(reinterpret_cast<cusolverDnHandle_t>(handle)),
+              streams_(reinterpret_cast<cudaStream_t*>(streams_ptr)),
+              n_streams_(n_streams), orig_(0) {
+        if (n_streams_ > 0) cusolverDnGetStream(handle_, &orig_);
+    }
+
+    ~batch_stream_pool() {
+        if (n_streams_ > 0) cusolverDnSetStream(handle_, orig_);
+    }
+
+    // Sets the stream for the i-th matrix and returns its workspace slot.
+    int select(int i) {
+        if (n_streams_ == 0) return 0;
+        int slot = i % n_streams_;
+        cusolverDnSetStream(handle_, streams_[slot]);
+        return slot;
+    }
+
+  private:
+    cusolverDnHandle_t handle_;
+    cudaStream_t* streams_;
+    int n_streams_;
+    cudaStream_t orig_;
+};
+
+
 #if !defined(CUPY_USE_HIP)
 /*
  * loop-based batched gesvd (only used on CUDA)
@@ -36,15 +73,17 @@ int gesvd_loop(
         intptr_t handle, char jobu, char jobvt, int m, int n, intptr_t a_ptr,
         intptr_t s_ptr, intptr_t u_ptr, intptr_t vt_ptr,
         intptr_t w_ptr, int buffersize, intptr_t info_ptr,
-        int batch_size) {
+        int batch_size, intptr_t streams_ptr, int n_streams) {
     /*
      * Assumptions:
      * 1. the stream is set prior to calling this function
-     * 2. the workspace is reused in the loop
+     * 2. the workspace holds max(n_streams, 1) slots of buffersize, and each
+     *    slot is reused by the matrices on the same stream
      */
 
     cusolverStatus_t status;
     int k = (m<n?m:n);
+    batch_stream_pool pool(handle, streams_ptr, n_streams);
     typedef typename std::conditional<(std::is_same<T, float>::value) || (std::is_same<T, cuComplex>::value), float,
                                       /* double or cuDoubleComplex */ double>::type real_type;
     T* A = reinterpret_cast<T*>(a_ptr);
@@ -59,10 +98,11 @@ int gesvd_loop(
     gesvd<T, real_type> func = gesvd_func<T, real_type>().ptr;
 
     for (int i=0; i<batch_size; i++) {
+        int slot = pool.select(i);
         // setting rwork to NULL as we don't need it
         status = func(
             reinterpret_cast<cusolverDnHandle_t>(handle), jobu, jobvt, m, n, A, m,
-            S, U, m, VT, n, Work, buffersize, NULL, devInfo);
+            S, U, m, VT, n, Work + slot * buffersize, buffersize, NULL, devInfo);
         if (status != 0) break;
         A += m * n;
         S += k;
@@ -91,15 +131,17 @@ int geqrf_loop(
         intptr_t handle, int m, int n, intptr_t a_ptr, int lda,
         intptr_t tau_ptr, intptr_t w_ptr,
         int buffersize, intptr_t info_ptr,
-        int batch_size) {
+        int batch_size, intptr_t streams_ptr, int n_streams) {
     /*
      * Assumptions:
      * 1. the stream is set prior to calling this function
-     * 2. the workspace is reused in the loop
+     * 2. the workspace holds max(n_streams, 1) slots of buffersize, and each
+     *    slot is reused by the matrices on the same stream
      */
 
     cusolverStatus_t status;
     int k = (m<n?m:n);
+    batch_stream_pool pool(handle, streams_ptr, n_streams);
     T* A = reinterpret_cast<T*>(a_ptr);
     T* Tau = reinterpret_cast<T*>(tau_ptr);
     T* Work = reinterpret_cast<T*>(w_ptr);
@@ -110,8 +152,9 @@ int geqrf_loop(
     geqrf<T> func = geqrf_func<T>().ptr;
 
     for (int i=0; i<batch_size; i++) {
+        int slot = pool.select(i);
         status = func(reinterpret_cast<cusolverDnHandle_t>(handle),
-                      m, n, A, lda, Tau, Work, buffersize, devInfo);
+                      m, n, A, lda, Tau, Work + slot * buffersize, buffersize, devInfo);
         if (status != 0) break;
         A += m * n;
         Tau += k;
@@ -127,35 +170,36 @@ int gesvd_loop(
         intptr_t handle, char jobu, char jobvt, int m, int n, intptr_t a_ptr,
         intptr_t s_ptr, intptr_t u_ptr, intptr_t vt_ptr,
         intptr_t w_ptr, int buffersize, intptr_t info_ptr,
-        int batch_size) {
+        int batch_size, intptr_t streams_ptr, int n_streams) {
     // we need a dummy stub for HIP as it's not used
     return 0;
 }
 
 
 /*
- * batched geqrf (only used on HIP)
+ * strided-batched geqrf (only used on HIP)
  */
 template<typename T>
-using geqrf = cusolverStatus_t (*)(cusolverDnHandle_t, int, int, T* const[], int, T*, long int, int);
+using geqrf = cusolverStatus_t (*)(cusolverDnHandle_t, int, int, T*, int, rocblas_stride, T*, rocblas_stride, int);
 
 template<typename T> struct geqrf_func { geqrf<T> ptr; };
-template<> struct geqrf_func<float> { geqrf<float> ptr = rocsolver_sgeqrf_batched; };
-template<> struct geqrf_func<double> { geqrf<double> ptr = rocsolver_dgeqrf_batched; };
+template<> struct geqrf_func<float> { geqrf<float> ptr = rocsolver_sgeqrf_strided_batched; };
+template<> struct geqrf_func<double> { geqrf<double> ptr = rocsolver_dgeqrf_strided_batched; };
 // we need the correct func pointer here, so can't cast!
-template<> struct geqrf_func<rocblas_float_complex> { geqrf<rocblas_float_complex> ptr = rocsolver_cgeqrf_batched; };
-template<> struct geqrf_func<rocblas_double_complex> { geqrf<rocblas_double_complex> ptr = rocsolver_zgeqrf_batched; };
+template<> struct geqrf_func<rocblas_float_complex> { geqrf<rocblas_float_complex> ptr = rocsolver_cgeqrf_strided_batched; };
+template<> struct geqrf_func<rocblas_double_complex> { geqrf<rocblas_double_complex> ptr = rocsolver_zgeqrf_strided_batched; };
 
 template<typename T>
 int geqrf_loop(
         intptr_t handle, int m, int n, intptr_t a_ptr, int lda,
         intptr_t tau_ptr, intptr_t w_ptr,
         int buffersize, intptr_t info_ptr,
-        int batch_size) {
+        int batch_size, intptr_t streams_ptr, int n_streams) {
     /*
      * Assumptions:
      * 1. the stream is set prior to calling this function
-     * 2. ignore w_ptr, buffersize, and info_ptr as rocSOLVER does not need them
+     * 2. ignore w_ptr, buffersize, info_ptr and the stream pool as
+     *    rocSOLVER does not need them
      */
 
     cusolverStatus_t status;
@@ -170,12 +214,12 @@ int geqrf_loop(
                                   rocblas_double_complex>::type
         >::type data_type;
     geqrf<data_type> func = geqrf_func<data_type>().ptr;
-    data_type* const* A = reinterpret_cast<data_type* const*>(a_ptr);
+    data_type* A = reinterpret_cast<data_type*>(a_ptr);
     data_type* Tau = reinterpret_cast<data_type*>(tau_ptr);
     int k = (m<n)?m:n;
 
-    // use rocSOLVER's batched geqrf
-    status = func((cusolverDnHandle_t)handle, m, n, A, lda, Tau, k, batch_size);
+    // use rocSOLVER's strided-batched geqrf, so that no pointer array is needed
+    status = func((cusolverDnHandle_t)handle, m, n, A, lda, (rocblas_stride)m * n, Tau, k, batch_size);
 
     return status;
 }
@@ -199,14 +243,16 @@ int orgqr_loop(
         intptr_t handle, int m, int n, int k, intptr_t a_ptr, int lda,
         intptr_t tau_ptr, intptr_t w_ptr,
         int buffersize, intptr_t info_ptr,
-        int batch_size, int origin_n) {
+        int batch_size, int origin_n, intptr_t streams_ptr, int n_streams) {
     /*
      * Assumptions:
      * 1. the stream is set prior to calling this function
-     * 2. the workspace is reused in the loop
+     * 2. the workspace holds max(n_streams, 1) slots of buffersize, and each
+     *    slot is reused by the matrices on the same stream
      */
 
     cusolverStatus_t status;
+    batch_stream_pool pool(handle, streams_ptr, n_streams);
     T* A = reinterpret_cast<T*>(a_ptr);
     const T* Tau = reinterpret_cast<const T*>(tau_ptr);
     T* Work = reinterpret_cast<T*>(w_ptr);
@@ -217,8 +263,9 @@ int orgqr_loop(
     orgqr<T> func = orgqr_func<T>().ptr;
 
     for (int i=0; i<batch_size; i++) {
+        int slot = pool.select(i);
         status = func(reinterpret_cast<cusolverDnHandle_t>(handle),
-                      m, n, k, A, lda, Tau, Work, buffersize, devInfo);
+                      m, n, k, A, lda, Tau, Work + slot * buffersize, buffersize, devInfo);
         if (status != 0) break;
         A += m * origin_n;
         Tau += k;
@@ -227,4 +274,85 @@ int orgqr_loop(
 
     return status;
 }
+
+
+#if defined(CUPY_USE_HIP)
+/*
+ * strided-batched potrf and getrf (only used on HIP)
+ *
+ * Unlike the *Batched APIs, which take a device array of matrix pointers that
+ * has to be built for every call, these take the base pointer of a uniformly
+ * strided batch.
+ */
+template<typename T>
+using potrf_strided = cusolverStatus_t (*)(cusolverDnHandle_t, rocblas_fill, int, T*, int, rocblas_stride, int*, int);
+
+template<typename T> struct potrf_strided_func { potrf_strided<T> ptr; };
+template<> struct potrf_strided_func<float> { potrf_strided<float> ptr = rocsolver_spotrf_strided_batched; };
+template<> struct potrf_strided_func<double> { potrf_strided<double> ptr = rocsolver_dpotrf_strided_batched; };
+template<> struct potrf_strided_func<rocblas_float_complex> { potrf_strided<rocblas_float_complex> ptr = rocsolver_cpotrf_strided_batched; };
+template<> struct potrf_strided_func<rocblas_double_complex> { potrf_strided<rocblas_double_complex> ptr = rocsolver_zpotrf_strided_batched; };
+
+template<typename T>
+using getrf_strided = cusolverStatus_t (*)(cusolverDnHandle_t, int, int, T*, int, rocblas_stride, int*, rocblas_stride, int*, int);
+
+template<typename T> struct getrf_strided_func { getrf_strided<T> ptr; };
+template<> struct getrf_strided_func<float> { getrf_strided<float> ptr = rocsolver_sgetrf_strided_batched; };
+template<> struct getrf_strided_func<double> { getrf_strided<double> ptr = rocsolver_dgetrf_strided_batched; };
+template<> struct getrf_strided_func<rocblas_float_complex> { getrf_strided<rocblas_float_complex> ptr = rocsolver_cgetrf_strided_batched; };
+template<> struct getrf_strided_func<rocblas_double_complex> { getrf_strided<rocblas_double_complex> ptr = rocsolver_zgetrf_strided_batched; };
+
+template<typename T>
+struct rocsolver_data_type {
+    typedef typename std::conditional<
+        std::is_floating_point<T>::value,
+        T,
+        typename std::conditional<std::is_same<T, cuComplex>::value,
+                                  rocblas_float_complex,
+                                  rocblas_double_complex>::type
+        >::type type;
+};
+
+template<typename T>
+int potrf_strided_batched(
+        intptr_t handle, int uplo, int n, intptr_t a_ptr, int lda,
+        long long stride, intptr_t info_ptr, int batch_size) {
+    // the stream is set prior to calling this function
+    typedef typename rocsolver_data_type<T>::type data_type;
+    potrf_strided<data_type> func = potrf_strided_func<data_type>().ptr;
+    return func((cusolverDnHandle_t)handle, convert_rocblas_fill((cublasFillMode_t)uplo),
+                n, reinterpret_cast<data_type*>(a_ptr), lda, stride,
+                reinterpret_cast<int*>(info_ptr), batch_size);
+}
+
+template<typename T>
+int getrf_strided_batched(
+        intptr_t handle, int n, intptr_t a_ptr, int lda, long long stride,
+        intptr_t ipiv_ptr, intptr_t info_ptr, int batch_size) {
+    // the stream is set prior to calling this function
+    typedef typename rocsolver_data_type<T>::type data_type;
+    getrf_strided<data_type> func = getrf_strided_func<data_type>().ptr;
+    return func((cusolverDnHandle_t)handle, n, n,
+                reinterpret_cast<data_type*>(a_ptr), lda, stride,
+                reinterpret_cast<int*>(ipiv_ptr), n,
+                reinterpret_cast<int*>(info_ptr), batch_size);
+}
+
+#else
+
+// we need dummy stubs for CUDA as they're not used
+template<typename T>
+int potrf_strided_batched(
+        intptr_t handle, int uplo, int n, intptr_t a_ptr, int lda,
+        long long stride, intptr_t info_ptr, int batch_size) {
+    return 0;
+}
+
+template<typename T>
+int getrf_strided_batched(
+        intptr_t handle, int n, intptr_t a_ptr, int lda, long long stride,
+        intptr_t ipiv_ptr, intptr_t info_ptr, int batch_size) {
+    return 0;
+}
+#endif // #if defined(CUPY_USE_HIP)
 #endif // #ifndef INCLUDE_GUARD_CUPY_CUSOLVER_H
@@ -133,6 +133,81 @@ CUresult cuStreamGetCtx(...) {
     return hipErrorUnknown;
 }
 
+// Virtual memory management
+#if HIP_VERSION >= 60000000
+CUresult cuMemGetAllocationGranularity(
+        size_t* granularity, const CUmemAllocationProp* prop,
+        CUmemAllocationGranularity_flags option) {
+    return hipMemGetAllocationGranularity(granularity, prop, option);
+}
+
+CUresult cuMemAddressReserve(CUdeviceptr* ptr, size_t size, size_t alignment,
+                             CUdeviceptr addr, unsigned long long flags) {
+    return hipMemAddressReserve(ptr, size, alignment, addr, flags);
+}
+
+CUresult cuMemAddressFree(CUdeviceptr ptr, size_t size) {
+    return hipMemAddressFree(ptr, size);
+}
+
+CUresult cuMemCreate(CUmemGenericAllocationHandle* handle, size_t size,
+                     const CUmemAllocationProp* prop,
+                     unsigned long long flags) {
+    return hipMemCreate(handle, size, prop, flags);
+}
+
+CUresult cuMemRelease(CUmemGenericAllocationHandle handle) {
+    return hipMemRelease(handle);
+}
+
+CUresult cuMemMap(CUdeviceptr ptr, size_t size, size_t offset,
+                  CUmemGenericAllocationHandle handle,
+                  unsigned long long flags) {
+    return hipMemMap(ptr, size, offset, handle, flags);
+}
+
+CUresult cuMemUnmap(CUdeviceptr ptr, size_t size) {
+    return hipMemUnmap(ptr, size);
+}
+
+CUresult cuMemSetAccess(CUdeviceptr ptr, size_t size,
+                        const CUmemAccessDesc* desc, size_t count) {
+    return hipMemSetAccess(ptr, size, desc, count);
+}
+#else
+CUresult cuMemGetAllocationGranularity(...) {
+    return hipErrorUnknown;
+}
+
+CUresult cuMemAddressReserve(...) {
+    return hipErrorUnknown;
+}
+
+CUresult cuMemAddressFree(...) {
+    return hipErrorUnknown;
+}
+
+CUresult cuMemCreate(...) {
+    return hipErrorUnknown;
+}
+
+CUresult cuMemRelease(...) {
+    return hipErrorUnknown;
+}
+
+CUresult cuMemMap(...) {
+    return hipErrorUnknown;
+}
+
+CUresult cuMemUnmap(...) {
+    return hipErrorUnknown;
+}
+
+CUresult cuMemSetAccess(...) {
+    return hipErrorUnknown;
+}
+#endif
+
 } // extern "C"
 
 #endif // #ifndef INCLUDE_GUARD_HIP_CUPY_CUDA_H
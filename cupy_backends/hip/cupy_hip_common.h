@@ -52,6 +52,11 @@ typedef void* cudaGraph_t;
 typedef void* cudaGraphNode_t;
 typedef void* cudaGraphExec_t;
 #endif
+#if HIP_VERSION >= 50000000
+typedef hipGraphExecUpdateResult cudaGraphExecUpdateResult;
+#else
+enum cudaGraphExecUpdateResult {};
+#endif
 typedef struct CUlinkState_st* CUlinkState;
 typedef struct CUarray_st* CUarray;
 struct CUDA_ARRAY_DESCRIPTOR {
@@ -60,6 +65,34 @@ struct CUDA_ARRAY_DESCRIPTOR {
     unsigned int NumChannels;
     size_t Width;
 };
+#if HIP_VERSION >= 60000000
+typedef hipMemGenericAllocationHandle_t CUmemGenericAllocationHandle;
+typedef hipMemAllocationType CUmemAllocationType;
+typedef hipMemLocationType CUmemLocationType;
+typedef hipMemAccessFlags CUmemAccess_flags;
+typedef hipMemAllocationGranularity_flags CUmemAllocationGranularity_flags;
+typedef hipMemLocation CUmemLocation;
+typedef hipMemAllocationProp CUmemAllocationProp;
+typedef hipMemAccessDesc CUmemAccessDesc;
+#else
+typedef unsigned long long CUmemGenericAllocationHandle;
+enum CUmemAllocationType {};
+enum CUmemLocationType {};
+enum CUmemAccess_flags {};
+enum CUmemAllocationGranularity_flags {};
+struct CUmemLocation {
+    CUmemLocationType type;
+    int id;
+};
+struct CUmemAllocationProp {
+    CUmemAllocationType type;
+    CUmemLocation location;
+};
+struct CUmemAccessDesc {
+    CUmemLocation location;
+    CUmemAccess_flags flags;
+};
+#endif
 
 
 ///////////////////////////////////////////////////////////////////////////////
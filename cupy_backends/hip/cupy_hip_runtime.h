@@ -136,6 +136,9 @@ struct cudaMemPoolProps {  // stub
     unsigned char reserved[64];
     void* win32SecurityAttributes;
 };
+struct cudaMemPoolPtrExportData {  // stub
+    unsigned char reserved[64];
+};
 
 cudaError_t cudaMalloc(void** ptr, size_t size) {
     return hipMalloc(ptr, size);
@@ -354,6 +357,22 @@ cudaError_t cudaMemPoolSetAttribute(...) {
     return hipErrorUnknown;
 }
 
+cudaError_t cudaMemPoolExportToShareableHandle(...) {
+    return hipErrorUnknown;
+}
+
+cudaError_t cudaMemPoolImportFromShareableHandle(...) {
+    return hipErrorUnknown;
+}
+
+cudaError_t cudaMemPoolExportPointer(...) {
+    return hipErrorUnknown;
+}
+
+cudaError_t cudaMemPoolImportPointer(...) {
+    return hipErrorUnknown;
+}
+
 
 // Stream and Event
 #if HIP_VERSION >= 40300000
@@ -566,6 +585,18 @@ cudaError_t cudaGraphUpload(cudaGraphExec_t graphExec, cudaStream_t stream) {
 #endif
 }
 
+cudaError_t cudaGraphExecUpdate(
+	cudaGraphExec_t hGraphExec,
+	cudaGraph_t hGraph,
+	cudaGraphNode_t* hErrorNode_out,
+	cudaGraphExecUpdateResult* updateResult_out) {
+#if HIP_VERSION >= 50000000
+    return hipGraphExecUpdate(hGraphExec, hGraph, hErrorNode_out, updateResult_out);
+#else
+    return hipErrorUnknown;
+#endif
+}
+
 cudaError_t cudaGraphDebugDotPrint(cudaGraph_t graph, const char* path, unsigned int flags) {
 #if HIP_VERSION >= 50500000
     return hipGraphDebugDotPrint(graph, path, flags);
@@ -533,12 +533,72 @@ cublasStatus_t cublasGemmEx(cublasHandle_t handle, cublasOperation_t transa, cub
                          static_cast<hipblasGemmAlgo_t>(160));  // HIPBLAS_GEMM_DEFAULT
 }
 
+#if HIP_VERSION >= 60000000
+// hipBLAS takes the compute types of cuBLAS, and hipDataType has the values
+// of cudaDataType.
+static hipblasComputeType_t convert_hipblasComputeType_t(cublasComputeType_t type) {
+    switch(static_cast<int>(type)) {
+        case 64 /* CUBLAS_COMPUTE_16F */: return HIPBLAS_COMPUTE_16F;
+        case 65 /* CUBLAS_COMPUTE_16F_PEDANTIC */: return HIPBLAS_COMPUTE_16F_PEDANTIC;
+        case 68 /* CUBLAS_COMPUTE_32F */: return HIPBLAS_COMPUTE_32F;
+        case 69 /* CUBLAS_COMPUTE_32F_PEDANTIC */: return HIPBLAS_COMPUTE_32F_PEDANTIC;
+        case 74 /* CUBLAS_COMPUTE_32F_FAST_16F */: return HIPBLAS_COMPUTE_32F_FAST_16F;
+        case 75 /* CUBLAS_COMPUTE_32F_FAST_16BF */: return HIPBLAS_COMPUTE_32F_FAST_16BF;
+        case 77 /* CUBLAS_COMPUTE_32F_FAST_TF32 */: return HIPBLAS_COMPUTE_32F_FAST_TF32;
+        case 70 /* CUBLAS_COMPUTE_64F */: return HIPBLAS_COMPUTE_64F;
+        case 71 /* CUBLAS_COMPUTE_64F_PEDANTIC */: return HIPBLAS_COMPUTE_64F_PEDANTIC;
+        case 72 /* CUBLAS_COMPUTE_32I */: return HIPBLAS_COMPUTE_32I;
+        case 73 /* CUBLAS_COMPUTE_32I_PEDANTIC */: return HIPBLAS_COMPUTE_32I_PEDANTIC;
+        default: throw std::runtime_error("unrecognized type");
+    }
+}
+
+// the algorithm is ignored, as hipBLAS only has HIPBLAS_GEMM_DEFAULT
+cublasStatus_t cublasGemmEx_v11(cublasHandle_t handle, cublasOperation_t transa, cublasOperation_t transb,
+                                int m, int n, int k, const void *alpha,
+                                const void *A, cudaDataType_t Atype, int lda,
+                                const void *B, cudaDataType_t Btype, int ldb,
+                                const void *beta,
+                                void *C, cudaDataType_t Ctype, int ldc,
+                                cublasComputeType_t computetype, cublasGemmAlgo_t algo) {
+    return hipblasGemmEx_v2(handle, convert_hipblasOperation_t(transa), convert_hipblasOperation_t(transb),
+                            m, n, k, alpha,
+                            A, static_cast<hipDataType>(Atype), lda,
+                            B, static_cast<hipDataType>(Btype), ldb,
+                            beta,
+                            C, static_cast<hipDataType>(Ctype), ldc,
+                            convert_hipblasComputeType_t(computetype),
+                            HIPBLAS_GEMM_DEFAULT);
+}
+
+cublasStatus_t cublasGemmStridedBatchedEx_v11(cublasHandle_t handle, cublasOperation_t transa, cublasOperation_t transb,
+                                              int m, int n, int k, const void* alpha,
+                                              const void* A, cudaDataType Atype, int lda, long long int strideA,
+                                              const void* B, cudaDataType Btype, int ldb, long long int strideB,
+                                              const void* beta,
+                                              void* C, cudaDataType Ctype, int ldc, long long int strideC,
+                                              int batchCount, cublasComputeType_t computeType, cublasGemmAlgo_t algo) {
+    return hipblasGemmStridedBatchedEx_v2(handle, convert_hipblasOperation_t(transa), convert_hipblasOperation_t(transb),
+                                          m, n, k, alpha,
+                                          A, static_cast<hipDataType>(Atype), lda, strideA,
+                                          B, static_cast<hipDataType>(Btype), ldb, strideB,
+                                          beta,
+                                          C, static_cast<hipDataType>(Ctype), ldc, strideC,
+                                          batchCount, convert_hipblasComputeType_t(computeType),
+                                          HIPBLAS_GEMM_DEFAULT);
+}
+#else
 cublasStatus_t cublasGemmEx_v11(...) {
     return HIPBLAS_STATUS_NOT_SUPPORTED;
 }
 cublasStatus_t cublasGemmStridedBatchedEx_v11(...) {
     return HIPBLAS_STATUS_NOT_SUPPORTED;
 }
+#endif  // #if HIP_VERSION >= 60000000
+
+cublasStatus_t cublasGemmGroupedBatchedEx(...) {
+    return HIPBLAS_STATUS_NOT_SUPPORTED;
+}
 
 cublasStatus_t cublasStrsm(cublasHandle_t handle, cublasSideMode_t size, cublasFillMode_t uplo, cublasOperation_t trans,
                            cublasDiagType_t diag, int m, int n, const float* alpha,
@@ -427,6 +427,94 @@ cusparseStatus_t cusparseXcsrsv2_zeroPivot(cusparseHandle_t handle,
   return hipsparseXcsrsv2_zeroPivot(handle, info, position);
 }
 
+cusparseStatus_t cusparseSbsrmv(cusparseHandle_t         handle,
+                                cusparseDirection_t      dirA,
+                                cusparseOperation_t      transA,
+                                int                      mb,
+                                int                      nb,
+                                int                      nnzb,
+                                const float*             alpha,
+                                const cusparseMatDescr_t descrA,
+                                const float*             bsrSortedValA,
+                                const int*               bsrSortedRowPtrA,
+                                const int*               bsrSortedColIndA,
+                                int                      blockDim,
+                                const float*             x,
+                                const float*             beta,
+                                float*                   y) {
+#if HIP_VERSION >= 305
+  return hipsparseSbsrmv(handle, dirA, transA, mb, nb, nnzb, alpha, descrA, bsrSortedValA, bsrSortedRowPtrA, bsrSortedColIndA, blockDim, x, beta, y);
+#else
+  return HIPSPARSE_STATUS_NOT_SUPPORTED;
+#endif
+}
+
+cusparseStatus_t cusparseDbsrmv(cusparseHandle_t         handle,
+                                cusparseDirection_t      dirA,
+                                cusparseOperation_t      transA,
+                                int                      mb,
+                                int                      nb,
+                                int                      nnzb,
+                                const double*            alpha,
+                                const cusparseMatDescr_t descrA,
+                                const double*            bsrSortedValA,
+                                const int*               bsrSortedRowPtrA,
+                                const int*               bsrSortedColIndA,
+                                int                      blockDim,
+                                const double*            x,
+                                const double*            beta,
+                                double*                  y) {
+#if HIP_VERSION >= 305
+  return hipsparseDbsrmv(handle, dirA, transA, mb, nb, nnzb, alpha, descrA, bsrSortedValA, bsrSortedRowPtrA, bsrSortedColIndA, blockDim, x, beta, y);
+#else
+  return HIPSPARSE_STATUS_NOT_SUPPORTED;
+#endif
+}
+
+cusparseStatus_t cusparseCbsrmv(cusparseHandle_t         handle,
+                                cusparseDirection_t      dirA,
+                                cusparseOperation_t      transA,
+                                int                      mb,
+                                int                      nb,
+                                int                      nnzb,
+                                const cuComplex*         alpha,
+                                const cusparseMatDescr_t descrA,
+                                const cuComplex*         bsrSortedValA,
+                                const int*               bsrSortedRowPtrA,
+                                const int*               bsrSortedColIndA,
+                                int                      blockDim,
+                                const cuComplex*         x,
+                                const cuComplex*         beta,
+                                cuComplex*               y) {
+#if HIP_VERSION >= 305
+  return hipsparseCbsrmv(handle, dirA, transA, mb, nb, nnzb, reinterpret_cast<const hipComplex*>(alpha), descrA, reinterpret_cast<const hipComplex*>(bsrSortedValA), bsrSortedRowPtrA, bsrSortedColIndA, blockDim, reinterpret_cast<const hipComplex*>(x), reinterpret_cast<const hipComplex*>(beta), reinterpret_cast<hipComplex*>(y));
+#else
+  return HIPSPARSE_STATUS_NOT_SUPPORTED;
+#endif
+}
+
+cusparseStatus_t cusparseZbsrmv(cusparseHandle_t         handle,
+                                cusparseDirection_t      dirA,
+                                cusparseOperation_t      transA,
+                                int                      mb,
+                                int                      nb,
+                                int                      nnzb,
+                                const cuDoubleComplex*   alpha,
+                                const cusparseMatDescr_t descrA,
+                                const cuDoubleComplex*   bsrSortedValA,
+                                const int*               bsrSortedRowPtrA,
+                                const int*               bsrSortedColIndA,
+                                int                      blockDim,
+                                const cuDoubleComplex*   x,
+                                const cuDoubleComplex*   beta,
+                                cuDoubleComplex*         y) {
+#if HIP_VERSION >= 305
+  return hipsparseZbsrmv(handle, dirA, transA, mb, nb, nnzb, reinterpret_cast<const hipDoubleComplex*>(alpha), descrA, reinterpret_cast<const hipDoubleComplex*>(bsrSortedValA), bsrSortedRowPtrA, bsrSortedColIndA, blockDim, reinterpret_cast<const hipDoubleComplex*>(x), reinterpret_cast<const hipDoubleComplex*>(beta), reinterpret_cast<hipDoubleComplex*>(y));
+#else
+  return HIPSPARSE_STATUS_NOT_SUPPORTED;
+#endif
+}
+
 // cuSPARSE Level3 Function
 cusparseStatus_t cusparseScsrmm(cusparseHandle_t         handle,
                                 cusparseOperation_t      transA,
@@ -828,6 +916,110 @@ cusparseStatus_t cusparseXcsrsm2_zeroPivot(cusparseHandle_t handle,
   return hipsparseXcsrsm2_zeroPivot(handle, info, position);
 }
 
+cusparseStatus_t cusparseSbsrmm(cusparseHandle_t         handle,
+                                cusparseDirection_t      dirA,
+                                cusparseOperation_t      transA,
+                                cusparseOperation_t      transB,
+                                int                      mb,
+                                int                      n,
+                                int                      kb,
+                                int                      nnzb,
+                                const float*             alpha,
+                                const cusparseMatDescr_t descrA,
+                                const float*             bsrSortedValA,
+                                const int*               bsrSortedRowPtrA,
+                                const int*               bsrSortedColIndA,
+                                int                      blockSize,
+                                const float*             B,
+                                int                      ldb,
+                                const float*             beta,
+                                float*                   C,
+                                int                      ldc) {
+#if HIP_VERSION >= 402
+  return hipsparseSbsrmm(handle, dirA, transA, transB, mb, n, kb, nnzb, alpha, descrA, bsrSortedValA, bsrSortedRowPtrA, bsrSortedColIndA, blockSize, B, ldb, beta, C, ldc);
+#else
+  return HIPSPARSE_STATUS_NOT_SUPPORTED;
+#endif
+}
+
+cusparseStatus_t cusparseDbsrmm(cusparseHandle_t         handle,
+                                cusparseDirection_t      dirA,
+                                cusparseOperation_t      transA,
+                                cusparseOperation_t      transB,
+                                int                      mb,
+                                int                      n,
+                                int                      kb,
+                                int                      nnzb,
+                                const double*            alpha,
+                                const cusparseMatDescr_t descrA,
+                                const double*            bsrSortedValA,
+                                const int*               bsrSortedRowPtrA,
+                                const int*               bsrSortedColIndA,
+                                int                      blockSize,
+                                const double*            B,
+                                int                      ldb,
+                                const double*            beta,
+                                double*                  C,
+                                int                      ldc) {
+#if HIP_VERSION >= 402
+  return hipsparseDbsrmm(handle, dirA, transA, transB, mb, n, kb, nnzb, alpha, descrA, bsrSortedValA, bsrSortedRowPtrA, bsrSortedColIndA, blockSize, B, ldb, beta, C, ldc);
+#else
+  return HIPSPARSE_STATUS_NOT_SUPPORTED;
+#endif
+}
+
+cusparseStatus_t cusparseCbsrmm(cusparseHandle_t         handle,
+                                cusparseDirection_t      dirA,
+                                cusparseOperation_t      transA,
+                                cusparseOperation_t      transB,
+                                int                      mb,
+                                int                      n,
+                                int                      kb,
+                                int                      nnzb,
+                                const cuComplex*         alpha,
+                                const cusparseMatDescr_t descrA,
+                                const cuComplex*         bsrSortedValA,
+                                const int*               bsrSortedRowPtrA,
+                                const int*               bsrSortedColIndA,
+                                int                      blockSize,
+                                const cuComplex*         B,
+                                int                      ldb,
+                                const cuComplex*         beta,
+                                cuComplex*               C,
+                                int                      ldc) {
+#if HIP_VERSION >= 402
+  return hipsparseCbsrmm(handle, dirA, transA, transB, mb, n, kb, nnzb, reinterpret_cast<const hipComplex*>(alpha), descrA, reinterpret_cast<const hipComplex*>(bsrSortedValA), bsrSortedRowPtrA, bsrSortedColIndA, blockSize, reinterpret_cast<const hipComplex*>(B), ldb, reinterpret_cast<const hipComplex*>(beta), reinterpret_cast<hipComplex*>(C), ldc);
+#else
+  return HIPSPARSE_STATUS_NOT_SUPPORTED;
+#endif
+}
+
+cusparseStatus_t cusparseZbsrmm(cusparseHandle_t         handle,
+                                cusparseDirection_t      dirA,
+                                cusparseOperation_t      transA,
+                                cusparseOperation_t      transB,
+                                int                      mb,
+                                int                      n,
+                                int                      kb,
+                                int                      nnzb,
+                                const cuDoubleComplex*   alpha,
+                                const cusparseMatDescr_t descrA,
+                                const cuDoubleComplex*   bsrSortedValA,
+                                const int*               bsrSortedRowPtrA,
+                                const int*               bsrSortedColIndA,
+                                int                      blockSize,
+                                const cuDoubleComplex*   B,
+                                int                      ldb,
+                                const cuDoubleComplex*   beta,
+                                cuDoubleComplex*         C,
+                                int                      ldc) {
+#if HIP_VERSION >= 402
+  return hipsparseZbsrmm(handle, dirA, transA, transB, mb, n, kb, nnzb, reinterpret_cast<const hipDoubleComplex*>(alpha), descrA, reinterpret_cast<const hipDoubleComplex*>(bsrSortedValA), bsrSortedRowPtrA, bsrSortedColIndA, blockSize, reinterpret_cast<const hipDoubleComplex*>(B), ldb, reinterpret_cast<const hipDoubleComplex*>(beta), reinterpret_cast<hipDoubleComplex*>(C), ldc);
+#else
+  return HIPSPARSE_STATUS_NOT_SUPPORTED;
+#endif
+}
+
 // cuSPARSE Extra Function
 cusparseStatus_t cusparseXcsrgeamNnz(cusparseHandle_t         handle,
                                      int                      m,
@@ -3751,6 +3943,22 @@ cusparseStatus_t cusparseSpGEMM_copy(...) {
   return HIPSPARSE_STATUS_NOT_SUPPORTED;
 }
 
+cusparseStatus_t cusparseSpGEMMreuse_workEstimation(...) {
+  return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+cusparseStatus_t cusparseSpGEMMreuse_nnz(...) {
+  return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+cusparseStatus_t cusparseSpGEMMreuse_copy(...) {
+  return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
+cusparseStatus_t cusparseSpGEMMreuse_compute(...) {
+  return HIPSPARSE_STATUS_NOT_SUPPORTED;
+}
+
 cusparseStatus_t cusparseGather(...) {
   return HIPSPARSE_STATUS_NOT_SUPPORTED;
 }
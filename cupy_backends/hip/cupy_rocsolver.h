@@ -954,6 +954,8 @@ cusolverStatus_t cusolverDnZgesvd(cusolverDnHandle_t handle,
 
 /* ---------- batched gesvd ---------- */
 // Because rocSOLVER provides no counterpart for gesvdjBatched, we wrap its batched version directly.
+// As in cuSOLVER, A is a uniformly strided batch (not an array of pointers), so that we use the
+// strided-batched variant and don't have to build and upload a pointer array for every call.
 typedef enum {
     CUSOLVER_EIG_MODE_NOVECTOR=0,
     CUSOLVER_EIG_MODE_VECTOR=1
@@ -1091,16 +1093,16 @@ cusolverStatus_t cusolverDnSgesvdjBatched(
         stU = ldu * m;
         stV = ldv * n;
     }
-    return rocsolver_sgesvd_batched(handle, leftv, rightv,
-                                    m, n, reinterpret_cast<float* const*>(A), lda,
-                                    S, m<n?m:n,
-                                    U, ldu, stU,
-                                    V, ldv, stV,
-                                    // since we can't pass in another array through the API, and work is unused,
-                                    // we use it to store the temporary E array, to be discarded after calculation
-                                    work, (m<n?m:n)-1,
-                                    rocblas_outofplace, // always out-of-place
-                                    info, batchSize);
+    return rocsolver_sgesvd_strided_batched(handle, leftv, rightv,
+                                            m, n, A, lda, lda * n,
+                                            S, m<n?m:n,
+                                            U, ldu, stU,
+                                            V, ldv, stV,
+                                            // since we can't pass in another array through the API, and work is unused,
+                                            // we use it to store the temporary E array, to be discarded after calculation
+                                            work, (m<n?m:n)-1,
+                                            rocblas_outofplace, // always out-of-place
+                                            info, batchSize);
     #endif
 }
 
@@ -1137,16 +1139,16 @@ cusolverStatus_t cusolverDnDgesvdjBatched(
         stU = ldu * m;
         stV = ldv * n;
     }
-    return rocsolver_dgesvd_batched(handle, leftv, rightv,
-                                    m, n, reinterpret_cast<double* const*>(A), lda,
-                                    S, m<n?m:n,
-                                    U, ldu, stU,
-                                    V, ldv, stV,
-                                    // since we can't pass in another array through the API, and work is unused,
-                                    // we use it to store the temporary E array, to be discarded after calculation
-                                    work, (m<n?m:n)-1,
-                                    rocblas_outofplace, // always out-of-place
-                                    info, batchSize);
+    return rocsolver_dgesvd_strided_batched(handle, leftv, rightv,
+                                            m, n, A, lda, lda * n,
+                                            S, m<n?m:n,
+                                            U, ldu, stU,
+                                            V, ldv, stV,
+                                            // since we can't pass in another array through the API, and work is unused,
+                                            // we use it to store the temporary E array, to be discarded after calculation
+                                            work, (m<n?m:n)-1,
+                                            rocblas_outofplace, // always out-of-place
+                                            info, batchSize);
     #endif
 }
 
@@ -1183,16 +1185,16 @@ cusolverStatus_t cusolverDnCgesvdjBatched(
         stU = ldu * m;
         stV = ldv * n;
     }
-    return rocsolver_cgesvd_batched(handle, leftv, rightv,
-                                    m, n, reinterpret_cast<rocblas_float_complex* const*>(A), lda,
-                                    S, m<n?m:n,
-                                    reinterpret_cast<rocblas_float_complex*>(U), ldu, stU,
-                                    reinterpret_cast<rocblas_float_complex*>(V), ldv, stV,
-                                    // since we can't pass in another array through the API, and work is unused,
-                                    // we use it to store the temporary E array, to be discarded after calculation
-                                    reinterpret_cast<float*>(work), (m<n?m:n)-1,
-                                    rocblas_outofplace, // always out-of-place
-                                    info, batchSize);
+    return rocsolver_cgesvd_strided_batched(handle, leftv, rightv,
+                                            m, n, reinterpret_cast<rocblas_float_complex*>(A), lda, lda * n,
+                                            S, m<n?m:n,
+                                            reinterpret_cast<rocblas_float_complex*>(U), ldu, stU,
+                                            reinterpret_cast<rocblas_float_complex*>(V), ldv, stV,
+                                            // since we can't pass in another array through the API, and work is unused,
+                                            // we use it to store the temporary E array, to be discarded after calculation
+                                            reinterpret_cast<float*>(work), (m<n?m:n)-1,
+                                            rocblas_outofplace, // always out-of-place
+                                            info, batchSize);
     #endif
 }
 
@@ -1229,16 +1231,16 @@ cusolverStatus_t cusolverDnZgesvdjBatched(
         stU = ldu * m;
         stV = ldv * n;
     }
-    return rocsolver_zgesvd_batched(handle, leftv, rightv,
-                                    m, n, reinterpret_cast<rocblas_double_complex* const*>(A), lda,
-                                    S, m<n?m:n,
-                                    reinterpret_cast<rocblas_double_complex*>(U), ldu, stU,
-                                    reinterpret_cast<rocblas_double_complex*>(V), ldv, stV,
-                                    // since we can't pass in another array through the API, and work is unused,
-                                    // we use it to store the temporary E array, to be discarded after calculation
-                                    reinterpret_cast<double*>(work), (m<n?m:n)-1,
-                                    rocblas_outofplace, // always out-of-place
-                                    info, batchSize);
+    return rocsolver_zgesvd_strided_batched(handle, leftv, rightv,
+                                            m, n, reinterpret_cast<rocblas_double_complex*>(A), lda, lda * n,
+                                            S, m<n?m:n,
+                                            reinterpret_cast<rocblas_double_complex*>(U), ldu, stU,
+                                            reinterpret_cast<rocblas_double_complex*>(V), ldv, stV,
+                                            // since we can't pass in another array through the API, and work is unused,
+                                            // we use it to store the temporary E array, to be discarded after calculation
+                                            reinterpret_cast<double*>(work), (m<n?m:n)-1,
+                                            rocblas_outofplace, // always out-of-place
+                                            info, batchSize);
     #endif
 }
 
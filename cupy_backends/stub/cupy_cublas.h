@@ -344,6 +344,10 @@ cublasStatus_t cublasGemmStridedBatchedEx_v11(...) {
     return CUBLAS_STATUS_SUCCESS;
 }
 
+cublasStatus_t cublasGemmGroupedBatchedEx(...) {
+    return CUBLAS_STATUS_SUCCESS;
+}
+
 // BLAS extension
 cublasStatus_t cublasSgeam(...) {
     return CUBLAS_STATUS_SUCCESS;
@@ -51,6 +51,23 @@ struct CUDA_ARRAY_DESCRIPTOR {
     unsigned int NumChannels;
     size_t Width;
 };
+typedef unsigned long long CUmemGenericAllocationHandle;
+enum CUmemAllocationType {};
+enum CUmemLocationType {};
+enum CUmemAccess_flags {};
+enum CUmemAllocationGranularity_flags {};
+struct CUmemLocation {
+    CUmemLocationType type;
+    int id;
+};
+struct CUmemAllocationProp {
+    CUmemAllocationType type;
+    CUmemLocation location;
+};
+struct CUmemAccessDesc {
+    CUmemLocation location;
+    CUmemAccess_flags flags;
+};
 
 
 ///////////////////////////////////////////////////////////////////////////////
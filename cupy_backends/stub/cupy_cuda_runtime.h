@@ -122,6 +122,9 @@ struct cudaMemPoolProps {
     unsigned char reserved[64];
     void* win32SecurityAttributes;
 };
+struct cudaMemPoolPtrExportData {
+    unsigned char reserved[64];
+};
 
 cudaError_t cudaMalloc(...) {
     return cudaSuccess;
@@ -279,6 +282,22 @@ cudaError_t cudaMemPoolSetAttribute(...) {
     return cudaSuccess;
 }
 
+cudaError_t cudaMemPoolExportToShareableHandle(...) {
+    return cudaSuccess;
+}
+
+cudaError_t cudaMemPoolImportFromShareableHandle(...) {
+    return cudaSuccess;
+}
+
+cudaError_t cudaMemPoolExportPointer(...) {
+    return cudaSuccess;
+}
+
+cudaError_t cudaMemPoolImportPointer(...) {
+    return cudaSuccess;
+}
+
 
 // Stream and Event
 enum cudaStreamCaptureMode {};
@@ -414,6 +433,12 @@ cudaError_t cudaDestroySurfaceObject(...) {
 }
 
 // CUDA Graph
+enum cudaGraphExecUpdateResult {};
+
+cudaError_t cudaGraphExecUpdate(...) {
+    return cudaSuccess;
+}
+
 cudaError_t cudaGraphInstantiate(...) {
     return cudaSuccess;
 }
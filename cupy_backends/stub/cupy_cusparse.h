@@ -195,6 +195,22 @@ cusparseStatus_t cusparseXcsrsv2_zeroPivot(...) {
   return CUSPARSE_STATUS_SUCCESS;
 }
 
+cusparseStatus_t cusparseSbsrmv(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
+cusparseStatus_t cusparseDbsrmv(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
+cusparseStatus_t cusparseCbsrmv(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
+cusparseStatus_t cusparseZbsrmv(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
 // cuSPARSE Level3 Function
 cusparseStatus_t cusparseScsrmm(...) {
   return CUSPARSE_STATUS_SUCCESS;
@@ -278,6 +294,22 @@ cusparseStatus_t cusparseXcsrsm2_zeroPivot(...) {
   return CUSPARSE_STATUS_SUCCESS;
 }
 
+cusparseStatus_t cusparseSbsrmm(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
+cusparseStatus_t cusparseDbsrmm(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
+cusparseStatus_t cusparseCbsrmm(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
+cusparseStatus_t cusparseZbsrmm(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
 // cuSPARSE Extra Function
 cusparseStatus_t cusparseXcsrgeamNnz(...) {
   return CUSPARSE_STATUS_SUCCESS;
@@ -1207,6 +1239,22 @@ cusparseStatus_t cusparseSpGEMM_copy(...) {
   return CUSPARSE_STATUS_SUCCESS;
 }
 
+cusparseStatus_t cusparseSpGEMMreuse_workEstimation(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
+cusparseStatus_t cusparseSpGEMMreuse_nnz(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
+cusparseStatus_t cusparseSpGEMMreuse_copy(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
+cusparseStatus_t cusparseSpGEMMreuse_compute(...) {
+  return CUSPARSE_STATUS_SUCCESS;
+}
+
 cusparseStatus_t cusparseGather(...) {
   return CUSPARSE_STATUS_SUCCESS;
 }
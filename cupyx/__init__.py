@@ -1,9 +1,23 @@
 # "NOQA" to suppress flake8 warning
+from cupy.linalg._einsum import einsum_plan  # NOQA
+from cupyx._grouped_matmul import grouped_matmul  # NOQA
+from cupyx._kmeans import kmeans  # NOQA
+from cupyx._kmeans import nearest_centroid  # NOQA
+from cupyx._matmul_precision import matmul_precision  # NOQA
+from cupyx._moments import moments  # NOQA
+from cupyx._moments import MomentState  # NOQA
+from cupyx._nonzero import argwhere_async  # NOQA
+from cupyx._nonzero import flatnonzero_async  # NOQA
 from cupyx._rsqrt import rsqrt  # NOQA
 from cupyx._runtime import get_runtime_info  # NOQA
 from cupyx._scatter import scatter_add  # NOQA
 from cupyx._scatter import scatter_max  # NOQA
 from cupyx._scatter import scatter_min  # NOQA
+from cupyx._segmented_sort import segmented_argsort  # NOQA
+from cupyx._sorted_indexing import sorted_scatter_add  # NOQA
+from cupyx._sorted_indexing import sorted_take  # NOQA
+from cupyx._segmented_sort import segmented_sort  # NOQA
+from cupyx._topk import topk  # NOQA
 
 from cupyx import linalg  # NOQA
 from cupyx import time  # NOQA
@@ -21,8 +35,19 @@ from cupyx._pinned_array import empty_like_pinned  # NOQA
 from cupyx._pinned_array import zeros_pinned  # NOQA
 from cupyx._pinned_array import zeros_like_pinned  # NOQA
 
+from cupyx._pipelined_transfer import to_device_pipelined  # NOQA
+from cupyx._pipelined_transfer import to_host_pipelined  # NOQA
+from cupyx._memmap import DeviceMemmap  # NOQA
+
+from cupyx._graph import graph_function  # NOQA
+from cupyx._lazy import lazy_evaluation  # NOQA
+from cupyx._task_graph import Task  # NOQA
+from cupyx._task_graph import TaskGraph  # NOQA
+
 from cupyx._gufunc import GeneralizedUFunc  # NOQA
 
+from cupyx._prefetch import prefetch_kernels  # NOQA
+
 
 def __getattr__(key):
     if key == 'lapack':
@@ -0,0 +1,150 @@
+import collections
+import functools
+
+import cupy
+from cupy import _util
+from cupy import cuda
+from cupy.cuda import device
+from cupy.cuda import memory
+from cupy.cuda import runtime
+from cupy.cuda import stream as stream_module
+
+
+@_util.memoize(for_each_device=True)
+def _get_capture_stream():
+    return stream_module.Stream(non_blocking=True)
+
+
+def _add_key(obj, sig, ptrs):
+    # Splits an argument into the part that selects the captured code (the
+    # shapes, dtypes and other values) and the pointers of its arrays.
+    if isinstance(obj, cupy.ndarray):
+        sig.append((cupy.ndarray, obj.shape, obj.dtype.char, obj.strides))
+        ptrs.append(obj.data.ptr)
+    elif isinstance(obj, (list, tuple)):
+        sig.append((type(obj), len(obj)))
+        for x in obj:
+            _add_key(x, sig, ptrs)
+    else:
+        hash(obj)  # raises TypeError if the value cannot be a key
+        sig.append((type(obj), obj))
+
+
+class _Entry:
+
+    def __init__(self, graph, outputs):
+        self.graph = graph
+        self.outputs = outputs
+
+
+class _GraphFunction:
+
+    def __init__(self, func, max_graphs):
+        if max_graphs < 1:
+            raise ValueError('max_graphs must be positive')
+        functools.update_wrapper(self, func)
+        self._func = func
+        self._max_graphs = max_graphs
+        # (device id, signature) -> OrderedDict of pointers -> _Entry
+        self._entries = {}
+        # The memory used by the captured work, which must not be reused
+        # by other work while the graphs are alive.
+        self._pool = memory.MemoryPool()
+
+    def _capture(self, args, kwargs):
+        s = _get_capture_stream()
+        with cuda.using_allocator(self._pool.malloc), s:
+            s.begin_capture()
+            try:
+                outputs = self._func(*args, **kwargs)
+            except Exception:
+                try:
+                    s.end_capture()
+                except Exception:
+                    pass
+                raise
+            graph = s.end_capture(instantiate=False)
+        return graph, outputs
+
+    def __call__(self, *args, **kwargs):
+        if runtime.is_hip:
+            return self._func(*args, **kwargs)
+        sig = []
+        ptrs = []
+        _add_key(args, sig, ptrs)
+        _add_key(tuple(sorted(kwargs.items())), sig, ptrs)
+        key = (device.get_device_id(), tuple(sig))
+        ptrs = tuple(ptrs)
+
+        entries = self._entries.get(key)
+        if entries is None:
+            entries = self._entries[key] = collections.OrderedDict()
+        entry = entries.get(ptrs)
+        if entry is None:
+            graph, outputs = self._capture(args, kwargs)
+            if len(entries) >= self._max_graphs:
+                # Replace the least recently used graph; its instantiated
+                # graph is updated with the new pointers if possible.
+                _, old = entries.popitem(last=False)
+                if old.graph.update(graph):
+                    graph = old.graph
+            entry = entries[ptrs] = _Entry(graph, outputs)
+        else:
+            entries.move_to_end(ptrs)
+        entry.graph.launch(stream_module.get_current_stream())
+        return entry.outputs
+
+    def clear(self):
+        """Drops the captured graphs."""
+        self._entries.clear()
+
+
+def graph_function(func=None, *, max_graphs=2):
+    """Decorator to replay a function as a CUDA graph.
+
+    The first call with given arguments captures the CUDA work issued by the
+    function into a graph, which is launched on the current stream by this
+    and the later calls with the same arguments, instead of running the
+    function again. This removes the launch overhead of a sequence of many
+    small kernels.
+
+    The arguments select the graph by the shapes, dtypes and strides of the
+    :class:`cupy.ndarray` (also in lists and tuples) and the values of the
+    other arguments, which must be hashable, and by the pointers of the
+    arrays. Up to ``max_graphs`` graphs are kept for each set of shapes and
+    values, e.g. one for each set of buffers that rotate between the calls.
+    When another set of pointers is seen, the least recently used graph is
+    updated with the newly captured pointers (``cudaGraphExecUpdate``),
+    which is cheaper than instantiating a new graph.
+
+    Args:
+        func (callable): The function. It must only issue work on the
+            current stream, with no synchronization or host-device transfer,
+            as required by the stream capture.
+        max_graphs (int): The number of graphs kept for each signature.
+
+    Returns:
+        callable: The function that replays the graphs. Its ``clear()``
+        method drops the captured graphs.
+
+    .. warning::
+        The values returned by the function are computed only once, during
+        the capture: the same arrays are returned by every call with the
+        same graph, and they are overwritten by each replay. Copy them if
+        they are needed after the next call. The graphs of one function must
+        not be replayed concurrently on different streams, as they share
+        their temporary buffers.
+
+    .. note::
+        On HIP, the function is called as is.
+
+    Example:
+        >>> @cupyx.graph_function
+        ... def step(x, w, out):
+        ...     cupy.matmul(x, w, out=out)
+        ...     cupy.tanh(out, out=out)
+
+    """
+    if func is None:
+        return functools.partial(graph_function, max_graphs=max_graphs)
+    return _GraphFunction(func, max_graphs)
@@ -0,0 +1,276 @@
+import numpy
+
+import cupy
+from cupy._core._scalar import get_typename
+from cupy.cuda import device
+from cupy.cuda import runtime
+
+
+_grouped_matmul_code = r'''
+#include <cupy/complex.cuh>
+#include <cupy/carray.cuh>
+
+// Block b computes a TILE x TILE tile of the product of the group g such
+// that tile_offsets[g] <= b < tile_offsets[g + 1]. The operands are
+// C-contiguous: a is m x k, b is k x n and c is m x n. Each of the
+// THREADS x THREADS threads accumulates PER_THREAD x PER_THREAD elements
+// of the tile in registers, and the operands are staged in shared memory
+// TK columns of a (rows of b) at a time.
+#define TILE 64
+#define TK 16
+#define THREADS 16
+#define PER_THREAD 4
+
+extern "C" __global__ void grouped_matmul(
+        const long long* __restrict__ tile_offsets, const int n_groups,
+        const unsigned long long* __restrict__ ptrs,
+        const int* __restrict__ shapes) {
+
+    // raw storage, as the complex types cannot be __shared__ variables
+    __shared__ __align__(16) char smem[2 * TK * TILE * sizeof(ACC)];
+    ACC (*sa)[TILE] = reinterpret_cast<ACC(*)[TILE]>(smem);
+    ACC (*sb)[TILE] = reinterpret_cast<ACC(*)[TILE]>(
+        smem + TK * TILE * sizeof(ACC));
+    const long long block = blockIdx.x;
+    int g = 0;
+    int hi = n_groups;
+    while(hi - g > 1) {
+        const int mid = (g + hi) / 2;
+        if(tile_offsets[mid] <= block) {
+            g = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    const int m = shapes[3 * g];
+    const int n = shapes[3 * g + 1];
+    const int k = shapes[3 * g + 2];
+    const T* a = (const T*)ptrs[3 * g];
+    const T* b = (const T*)ptrs[3 * g + 1];
+    T* c = (T*)ptrs[3 * g + 2];
+    const int n_col_tiles = (n + TILE - 1) / TILE;
+    const long long local = block - tile_offsets[g];
+    const int row0 = local / n_col_tiles * TILE;
+    const int col0 = local % n_col_tiles * TILE;
+
+    const int tx = threadIdx.x;
+    const int ty = threadIdx.y;
+    const int t = ty * THREADS + tx;
+    ACC acc[PER_THREAD][PER_THREAD];
+#pragma unroll
+    for(int i = 0; i < PER_THREAD; i++) {
+#pragma unroll
+        for(int j = 0; j < PER_THREAD; j++) {
+            acc[i][j] = 0;
+        }
+    }
+
+    for(int k0 = 0; k0 < k; k0 += TK) {
+        for(int q = t; q < TK * TILE; q += THREADS * THREADS) {
+            const int r = q / TK;
+            const int ka = k0 + q % TK;
+            sa[q % TK][r] = (row0 + r < m && ka < k)
+                ? (ACC)a[(long long)(row0 + r) * k + ka] : (ACC)0;
+            const int kb = k0 + q / TILE;
+            const int col = col0 + q % TILE;
+            sb[q / TILE][q % TILE] = (col < n && kb < k)
+                ? (ACC)b[(long long)kb * n + col] : (ACC)0;
+        }
+        __syncthreads();
+
+#pragma unroll
+        for(int kk = 0; kk < TK; kk++) {
+            ACC x[PER_THREAD], y[PER_THREAD];
+#pragma unroll
+            for(int i = 0; i < PER_THREAD; i++) {
+                x[i] = sa[kk][ty + THREADS * i];
+                y[i] = sb[kk][tx + THREADS * i];
+            }
+#pragma unroll
+            for(int i = 0; i < PER_THREAD; i++) {
+#pragma unroll
+                for(int j = 0; j < PER_THREAD; j++) {
+                    acc[i][j] += x[i] * y[j];
+                }
+            }
+        }
+        __syncthreads();
+    }
+
+#pragma unroll
+    for(int i = 0; i < PER_THREAD; i++) {
+        const int row = row0 + ty + THREADS * i;
+#pragma unroll
+        for(int j = 0; j < PER_THREAD; j++) {
+            const int col = col0 + tx + THREADS * j;
+            if(row < m && col < n) {
+                c[(long long)row * n + col] = (T)acc[i][j];
+            }
+        }
+    }
+}
+'''
+
+_TILE = 64
+_THREADS = 16
+
+
+@cupy.memoize(for_each_device=True)
+def _get_kernel(dtype):
+    acc = 'float' if dtype.char == 'e' else get_typename(dtype)
+    code = '#define T {}\n#define ACC {}\n'.format(
+        get_typename(dtype), acc) + _grouped_matmul_code
+    return cupy.RawKernel(code, 'grouped_matmul', options=('-std=c++11',))
+
+
+def _native_grouped_matmul(problems):
+    tile_counts = [
+        -(-m // _TILE) * -(-n // _TILE) for _, _, _, m, n, _ in problems]
+    tile_offsets = numpy.cumsum([0] + tile_counts)
+    if tile_offsets[-1] == 0:
+        return
+    ptrs = numpy.array(
+        [[a.data.ptr, b.data.ptr, c.data.ptr]
+         for a, b, c, _, _, _ in problems], dtype=numpy.uint64)
+    shapes = numpy.array(
+        [[m, n, k] for _, _, _, m, n, k in problems], dtype=numpy.int32)
+    kernel = _get_kernel(problems[0][2].dtype)
+    kernel((int(tile_offsets[-1]),), (_THREADS, _THREADS),
+           (cupy.asarray(tile_offsets[:-1]), numpy.int32(len(problems)),
+            cupy.asarray(ptrs), cupy.asarray(shapes)))
+
+
+def _can_use_cublas(dtype):
+    if runtime.is_hip or dtype.char not in 'fd':
+        return False
+    from cupy_backends.cuda.libs import cublas
+    # cublasGemmGroupedBatchedEx is available since cuBLAS 12.5
+    return cublas.getVersion(device.get_cublas_handle()) >= 120500
+
+
+def _cublas_grouped_matmul(problems):
+    # Returns False when cuBLAS is built without the grouped GEMM. The
+    # products are computed in column-major order, as c.T = b.T @ a.T.
+    from cupy_backends.cuda.libs import cublas
+    dtype = problems[0][2].dtype
+    if dtype.char == 'f':
+        cuda_dtype = runtime.CUDA_R_32F
+        compute_type = cublas.CUBLAS_COMPUTE_32F
+    else:
+        cuda_dtype = runtime.CUDA_R_64F
+        compute_type = cublas.CUBLAS_COMPUTE_64F
+    n_groups = len(problems)
+    trans = numpy.full(n_groups, cublas.CUBLAS_OP_N, dtype=numpy.int32)
+    shapes = numpy.array(
+        [[n, m, k] for _, _, _, m, n, k in problems], dtype=numpy.int32).T
+    ms, ns, ks = (numpy.ascontiguousarray(s) for s in shapes)
+    alpha = numpy.ones(n_groups, dtype=dtype)
+    beta = numpy.zeros(n_groups, dtype=dtype)
+    group_size = numpy.ones(n_groups, dtype=numpy.int32)
+    a_array = cupy.array([b.data.ptr for _, b, _, _, _, _ in problems],
+                         dtype=numpy.uint64)
+    b_array = cupy.array([a.data.ptr for a, _, _, _, _, _ in problems],
+                         dtype=numpy.uint64)
+    c_array = cupy.array([c.data.ptr for _, _, c, _, _, _ in problems],
+                         dtype=numpy.uint64)
+
+    handle = device.get_cublas_handle()
+    orig_mode = cublas.getPointerMode(handle)
+    cublas.setPointerMode(handle, cublas.CUBLAS_POINTER_MODE_HOST)
+    try:
+        cublas.gemmGroupedBatchedEx(
+            handle, trans.ctypes.data, trans.ctypes.data,
+            ms.ctypes.data, ns.ctypes.data, ks.ctypes.data,
+            alpha.ctypes.data,
+            a_array.data.ptr, cuda_dtype, ms.ctypes.data,
+            b_array.data.ptr, cuda_dtype, ks.ctypes.data,
+            beta.ctypes.data,
+            c_array.data.ptr, cuda_dtype, ms.ctypes.data,
+            n_groups, group_size.ctypes.data, compute_type)
+    except cublas.CUBLASError as e:
+        if e.status != 15:  # CUBLAS_STATUS_NOT_SUPPORTED
+            raise
+        return False
+    finally:
+        cublas.setPointerMode(handle, orig_mode)
+    return True
+
+
+def grouped_matmul(a, b, out=None):
+    """Computes the matrix products of groups of matrices of varying sizes.
+
+    The products ``a[i] @ b[i]`` are all computed by a single launch, with
+    the grouped GEMM of cuBLAS (``cublasGemmGroupedBatchedEx``, cuBLAS 12.5
+    and later) for ``float32`` and ``float64`` operands, and a tiled kernel
+    otherwise. This avoids the launch of a :func:`cupy.matmul` per group,
+    e.g. for the experts of a mixture of experts.
+
+    Args:
+        a (sequence of cupy.ndarray): The left operands, of shape
+            ``(m_i, k_i)``.
+        b (sequence of cupy.ndarray): The right operands, of shape
+            ``(k_i, n_i)``.
+        out (sequence of cupy.ndarray, optional): The C-contiguous outputs,
+            of shape ``(m_i, n_i)`` and of the result dtype.
+
+    Returns:
+        list of cupy.ndarray: The products. They have the common dtype of all
+        the operands, which must be ``float16``, ``float32``, ``float64``,
+        ``complex64`` or ``complex128``.
+
+    .. note::
+        This function is specific to CuPy.
+
+    .. seealso:: :func:`cupy.matmul`
+    """
+    a = [cupy.asarray(x) for x in a]
+    b = [cupy.asarray(x) for x in b]
+    if len(a) != len(b):
+        raise ValueError('a and b must have the same number of matrices')
+    if out is not None:
+        out = list(out)
+        if len(out) != len(a):
+            raise ValueError('out must have a matrix per product')
+    if not a:
+        return []
+    dtype = numpy.result_type(*a, *b)
+    if dtype.char not in 'efdFD':
+        raise TypeError('dtype is not supported: {}'.format(dtype))
+
+    problems = []
+    results = []
+    for i, (x, y) in enumerate(zip(a, b)):
+        if x.ndim != 2 or y.ndim != 2:
+            raise ValueError('the operands must be 2-dimensional')
+        m, k = x.shape
+        if y.shape[0] != k:
+            raise ValueError(
+                'shapes {} and {} of group {} are not aligned'.format(
+                    x.shape, y.shape, i))
+        n = y.shape[1]
+        if max(m, n, k) > 0x7fffffff:
+            raise ValueError('the matrices are too large')
+        if out is None:
+            c = cupy.empty((m, n), dtype=dtype)
+        else:
+            c = out[i]
+            if (c.shape != (m, n) or c.dtype != dtype
+                    or not c.flags.c_contiguous):
+                raise ValueError(
+                    'out[{}] must be a C-contiguous {} array of shape '
+                    '{}'.format(i, dtype, (m, n)))
+        results.append(c)
+        if m == 0 or n == 0:
+            continue
+        if k == 0:
+            c.fill(0)
+            continue
+        x = cupy.ascontiguousarray(x, dtype=dtype)
+        y = cupy.ascontiguousarray(y, dtype=dtype)
+        problems.append((x, y, c, m, n, k))
+
+    if not problems:
+        return results
+    if not (_can_use_cublas(dtype) and _cublas_grouped_matmul(problems)):
+        _native_grouped_matmul(problems)
+    return results
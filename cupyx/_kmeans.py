@@ -0,0 +1,308 @@
+import numpy
+
+import cupy
+from cupy._core._scalar import get_typename
+from cupy.cuda import device
+from cupy.cuda import runtime
+
+
+# The distances of a chunk of samples to all the centroids are computed by a
+# GEMM into a workspace, and a single epilogue kernel finds the nearest
+# centroid of each sample with a warp per sample and accumulates the sums
+# and counts of the clusters. The accumulators are private to each block in
+# shared memory when they fit, and are merged into global memory at the end
+# of the block, so that the samples of a cluster do not collide on the same
+# global addresses.
+_kmeans_code = r'''
+#define FULL_MASK 0xffffffff
+
+extern "C" __global__ void kmeans_assign(
+        const long long n, const int k, const int d,
+        const T* __restrict__ x, const T* __restrict__ dots,
+        const T* __restrict__ c_norms, long long* __restrict__ labels,
+        T* __restrict__ dists, T* sums, unsigned long long* counts,
+        const int accumulate, const int private_sums,
+        const int private_counts) {
+    extern __shared__ __align__(8) unsigned char kmeans_smem[];
+    T* s_sums = reinterpret_cast<T*>(kmeans_smem);
+    unsigned int* s_counts = reinterpret_cast<unsigned int*>(
+        kmeans_smem + (private_sums ? (size_t)k * d * sizeof(T) : 0));
+    const long long kd = (long long)k * d;
+
+    if (accumulate) {
+        if (private_sums) {
+            for (long long j = threadIdx.x; j < kd; j += blockDim.x) {
+                s_sums[j] = 0;
+            }
+        }
+        if (private_counts) {
+            for (int j = threadIdx.x; j < k; j += blockDim.x) {
+                s_counts[j] = 0;
+            }
+        }
+        __syncthreads();
+    }
+
+    const int lane = threadIdx.x % 32;
+    const long long n_warps = (long long)gridDim.x * blockDim.x / 32;
+    for (long long row = ((long long)blockIdx.x * blockDim.x
+                          + threadIdx.x) / 32;
+         row < n; row += n_warps) {
+        const T* xr = x + row * d;
+        const T* dr = dots + row * k;
+
+        // |c|^2 - 2 x.c is minimized, the first centroid on ties
+        T best = 0;
+        int best_j = -1;
+        for (int j = lane; j < k; j += 32) {
+            const T v = c_norms[j] - 2 * dr[j];
+            if (best_j < 0 || v < best) {
+                best = v;
+                best_j = j;
+            }
+        }
+        T norm = 0;
+        for (int f = lane; f < d; f += 32) {
+            norm += xr[f] * xr[f];
+        }
+        for (int offset = 16; offset > 0; offset /= 2) {
+            const T best2 = __shfl_xor_sync(FULL_MASK, best, offset, 32);
+            const int j2 = __shfl_xor_sync(FULL_MASK, best_j, offset, 32);
+            if (j2 >= 0 && (best_j < 0 || best2 < best
+                            || (best2 == best && j2 < best_j))) {
+                best = best2;
+                best_j = j2;
+            }
+            norm += __shfl_xor_sync(FULL_MASK, norm, offset, 32);
+        }
+        if (lane == 0) {
+            labels[row] = best_j;
+            dists[row] = max(norm + best, T(0));
+        }
+
+        if (accumulate) {
+            T* target = (private_sums ? s_sums : sums) + (long long)best_j * d;
+            for (int f = lane; f < d; f += 32) {
+                atomicAdd(target + f, xr[f]);
+            }
+            if (lane == 0) {
+                if (private_counts) {
+                    atomicAdd(s_counts + best_j, 1u);
+                } else {
+                    atomicAdd(counts + best_j, 1ull);
+                }
+            }
+        }
+    }
+
+    if (accumulate && (private_sums || private_counts)) {
+        __syncthreads();
+        if (private_sums) {
+            for (long long j = threadIdx.x; j < kd; j += blockDim.x) {
+                if (s_sums[j] != 0) {
+                    atomicAdd(sums + j, s_sums[j]);
+                }
+            }
+        }
+        if (private_counts) {
+            for (int j = threadIdx.x; j < k; j += blockDim.x) {
+                if (s_counts[j] != 0) {
+                    atomicAdd(counts + j, (unsigned long long)s_counts[j]);
+                }
+            }
+        }
+    }
+}
+'''
+
+# The distances of a chunk are at most this many bytes.
+_workspace_bytes = 1 << 28
+# Budget for the private accumulators; the default limit is 48 KiB per block.
+_max_shared_bytes = 32 * 1024
+_block_size = 256
+_blocks_per_sm = 8
+
+
+@cupy.memoize(for_each_device=True)
+def _get_assign_kernel(dtype):
+    code = '#define T {}\n'.format(get_typename(dtype))
+    return cupy.RawKernel(code + _kmeans_code, 'kmeans_assign')
+
+
+@cupy.memoize(for_each_device=True)
+def _get_max_blocks():
+    n_sm = runtime.deviceGetAttribute(
+        runtime.cudaDevAttrMultiProcessorCount, device.get_device_id())
+    return n_sm * _blocks_per_sm
+
+
+def _as_samples(x):
+    x = cupy.asarray(x)
+    if x.ndim != 2:
+        raise ValueError('x must be a 2-D array of samples')
+    if x.dtype.char not in 'fd':
+        x = x.astype(numpy.float32 if x.dtype.char == 'e' else numpy.float64)
+    return cupy.ascontiguousarray(x)
+
+
+class _Assigner:
+
+    # Finds the nearest centroids of the samples chunk by chunk, and
+    # optionally accumulates the sums and counts of the clusters.
+
+    def __init__(self, x, k):
+        n, d = x.shape
+        itemsize = x.dtype.itemsize
+        self.x = x
+        self.k = k
+        self.chunk = max(1, min(n, _workspace_bytes // (k * itemsize)))
+        self.dots = cupy.empty((self.chunk, k), dtype=x.dtype)
+        self.labels = cupy.empty(n, dtype=numpy.int64)
+        self.dists = cupy.empty(n, dtype=x.dtype)
+        self.sums = cupy.empty((k, d), dtype=x.dtype)
+        self.counts = cupy.empty(k, dtype=numpy.uint64)
+        self.private_sums = k * d * itemsize + k * 4 <= _max_shared_bytes
+        self.private_counts = k * 4 <= _max_shared_bytes
+        self.kernel = _get_assign_kernel(x.dtype)
+        self.max_blocks = _get_max_blocks()
+
+    def __call__(self, centers, accumulate):
+        x = self.x
+        n, d = x.shape
+        k = self.k
+        c_norms = (centers * centers).sum(axis=1)
+        if accumulate:
+            self.sums.fill(0)
+            self.counts.fill(0)
+        private_sums = accumulate and self.private_sums
+        private_counts = accumulate and self.private_counts
+        shared_mem = 0
+        if private_sums:
+            shared_mem += k * d * x.dtype.itemsize
+        if private_counts:
+            shared_mem += k * 4
+        for start in range(0, n, self.chunk):
+            stop = min(start + self.chunk, n)
+            rows = stop - start
+            x_chunk = x[start:stop]
+            dots = self.dots[:rows]
+            cupy.matmul(x_chunk, centers.T, out=dots)
+            n_blocks = min(
+                (rows * 32 + _block_size - 1) // _block_size, self.max_blocks)
+            self.kernel(
+                (n_blocks,), (_block_size,),
+                (rows, numpy.int32(k), numpy.int32(d), x_chunk, dots,
+                 c_norms, self.labels[start:stop], self.dists[start:stop],
+                 self.sums, self.counts, numpy.int32(accumulate),
+                 numpy.int32(private_sums), numpy.int32(private_counts)),
+                shared_mem=shared_mem)
+        return self.labels, self.dists
+
+
+def nearest_centroid(x, centers):
+    """Finds the nearest centroid of each sample.
+
+    The distances of a chunk of samples to the centroids are computed by a
+    matrix product, and the nearest centroids are found by a single kernel
+    per chunk, so that the full matrix of distances is never allocated.
+
+    Args:
+        x (cupy.ndarray): The samples, of shape ``(n, d)``.
+        centers (cupy.ndarray): The centroids, of shape ``(k, d)``.
+
+    Returns:
+        tuple of cupy.ndarray: The index of the nearest centroid of each
+        sample (the first one on ties) and the squared Euclidean distance
+        to it.
+
+    .. seealso:: :func:`cupyx.kmeans`
+    """
+    x = _as_samples(x)
+    centers = cupy.asarray(centers, dtype=x.dtype)
+    if centers.ndim != 2 or centers.shape[1] != x.shape[1]:
+        raise ValueError('centers must be of shape (k, {})'.format(
+            x.shape[1]))
+    if centers.shape[0] == 0:
+        raise ValueError('centers must not be empty')
+    labels, dists = _Assigner(x, centers.shape[0])(centers, False)
+    return labels, dists
+
+
+def kmeans(x, n_clusters, *, init=None, max_iter=300, tol=1e-4,
+           check_interval=10, seed=None):
+    """Clusters samples by the k-means algorithm (Lloyd's iterations).
+
+    Each iteration finds the nearest centroid of each sample as
+    :func:`cupyx.nearest_centroid` does, and the same kernel accumulates the
+    sums and counts of the clusters, into private copies in shared memory
+    when they fit. The centroids are then updated and their shift is
+    compared with ``tol`` on the device, so that the host only waits for the
+    convergence flag every ``check_interval`` iterations. The iterations
+    after the convergence keep the centroids as they are.
+
+    Args:
+        x (cupy.ndarray): The samples, of shape ``(n, d)``.
+        n_clusters (int): The number of clusters.
+        init (cupy.ndarray, optional): The initial centroids, of shape
+            ``(n_clusters, d)``. By default, ``n_clusters`` distinct samples
+            are chosen at random.
+        max_iter (int): The maximum number of iterations.
+        tol (float): The iterations converge when the sum of the squared
+            shifts of the centroids is at most ``tol`` times the mean of the
+            variances of the features, as in scikit-learn.
+        check_interval (int): The number of iterations between the checks
+            of the convergence on the host.
+        seed (int, optional): The seed of the initial choice of the
+            centroids.
+
+    Returns:
+        tuple: The centroids of shape ``(n_clusters, d)``, the label of
+        each sample, the inertia (the sum of the squared distances of the
+        samples to their centroids, as a 0-dim array) and the number of
+        iterations run until the convergence.
+
+    .. note::
+        The labels and the inertia are those of the returned centroids. A
+        cluster that becomes empty keeps its previous centroid.
+
+    .. seealso:: :func:`cupyx.nearest_centroid`
+    """
+    x = _as_samples(x)
+    n, d = x.shape
+    if not 0 < n_clusters <= n:
+        raise ValueError('n_clusters must be between 1 and the number of '
+                         'samples, got {}'.format(n_clusters))
+    if max_iter < 1:
+        raise ValueError('max_iter must be positive')
+    if check_interval < 1:
+        raise ValueError('check_interval must be positive')
+    if init is None:
+        rs = cupy.random.RandomState(seed)
+        centers = x[rs.choice(n, n_clusters, replace=False)]
+    else:
+        centers = cupy.array(init, dtype=x.dtype)
+        if centers.shape != (n_clusters, d):
+            raise ValueError('init must be of shape ({}, {})'.format(
+                n_clusters, d))
+
+    threshold = 0
+    if tol > 0:
+        threshold = x.var(axis=0).mean() * tol
+    assign = _Assigner(x, n_clusters)
+    converged = cupy.zeros((), dtype=numpy.bool_)
+    n_iter = cupy.zeros((), dtype=numpy.int64)
+    for i in range(max_iter):
+        assign(centers, True)
+        counts = assign.counts[:, None]
+        new_centers = cupy.where(
+            counts > 0, assign.sums / cupy.maximum(counts, 1), centers)
+        new_centers = cupy.where(converged, centers, new_centers)
+        shift = ((new_centers - centers) ** 2).sum()
+        n_iter += ~converged
+        converged |= shift <= threshold
+        centers = new_centers
+        if (i + 1) % check_interval == 0 and converged:
+            break
+
+    labels, dists = assign(centers, False)
+    return centers, labels, dists.sum(), int(n_iter)
@@ -0,0 +1,459 @@
+import contextlib
+
+import numpy
+
+import cupy
+from cupy._core import _fusion_thread_local
+from cupy._core import _scalar
+from cupy._core import internal
+from cupy._core import fusion
+
+
+# The number of operations of an expression above which it is computed
+# without waiting for its result to be used, so that the fused kernels stay
+# small.
+_max_ops = 64
+
+_scalar_types = (int, float, complex, bool, numpy.generic)
+
+# The structure of an expression -> the fused function that computes it, or
+# None if it cannot be fused.
+_fused = {}
+
+
+def _is_concrete(x):
+    return isinstance(x, cupy.ndarray) or isinstance(x, _scalar_types)
+
+
+def _concrete(x):
+    if isinstance(x, LazyArray):
+        return x.compute()
+    return x
+
+
+def _as_dtype_arg(x):
+    # Returns an argument of the type resolution of ufuncs for an input, and
+    # whether it is a weak scalar.
+    if isinstance(x, (LazyArray, cupy.ndarray)):
+        return x.dtype.type(0), False
+    if isinstance(x, numpy.generic):
+        return x, False
+    weak = type(x) if type(x) in (int, float, complex) else False
+    return _scalar._python_scalar_to_numpy_scalar(x), weak
+
+
+def _call_eagerly(func, args, kwargs):
+    prev = _fusion_thread_local.set_lazy(False)
+    try:
+        return func(*[_concrete(a) for a in args], **{
+            k: _concrete(v) for k, v in kwargs.items()})
+    finally:
+        _fusion_thread_local.set_lazy(prev)
+
+
+def _call_ufunc(ufunc, args, kwargs):
+    # Called by the ufuncs with lazy arrays or in lazy evaluation mode.
+    if (kwargs or ufunc.nout != 1 or len(args) != ufunc.nin
+            or not all([isinstance(a, LazyArray) or _is_concrete(a)
+                        for a in args])):
+        # with out, dtype or where
+        return _call_eagerly(ufunc, args, kwargs)
+    in_args = []
+    weaks = []
+    shapes = []
+    for a in args:
+        in_arg, weak = _as_dtype_arg(a)
+        in_args.append(in_arg)
+        weaks.append(weak)
+        if not isinstance(a, _scalar_types):
+            shapes.append(a.shape)
+    if not shapes:
+        return _call_eagerly(ufunc, args, kwargs)
+    op = ufunc._ops.guess_routine(
+        ufunc.name, ufunc._routine_cache, in_args, tuple(weaks), None,
+        ufunc._out_ops)
+    shape = numpy.broadcast_shapes(*shapes)
+    return LazyArray._new(ufunc, tuple(args), None, shape,
+                          numpy.dtype(op.out_types[0]))
+
+
+def _reduction_dtype(name, dtype, in_dtype):
+    if name in ('max', 'min'):
+        return in_dtype
+    if dtype is not None:
+        return numpy.dtype(dtype)
+    # same as the automatic dtype of cupy.sum and cupy.prod
+    if in_dtype.kind in 'bi':
+        return numpy.dtype('l')
+    if in_dtype.kind == 'u':
+        return numpy.dtype('L')
+    return in_dtype
+
+
+def _linearize(root):
+    # Returns the concrete inputs, the program of the operations and its
+    # structure, in which the inputs and the results are referred to by their
+    # indices.
+    leaves = []
+    program = []
+    index = {}
+    stack = [(root, False)]
+    while stack:
+        node, ready = stack.pop()
+        if id(node) in index:
+            continue
+        if not isinstance(node, LazyArray) or node._value is not None:
+            index[id(node)] = None, len(leaves)
+            leaves.append(_concrete(node))
+            continue
+        if not ready:
+            stack.append((node, True))
+            stack.extend([(x, False) for x in reversed(node._inputs)])
+            continue
+        refs = tuple([index[id(x)] for x in node._inputs])
+        index[id(node)] = True, len(program)
+        program.append((node._op, refs, node._params))
+    # The results are numbered after the leaves.
+    n_leaves = len(leaves)
+    program = tuple([
+        (op, tuple([i if r is None else n_leaves + i for r, i in refs]),
+         params)
+        for op, refs, params in program])
+    return leaves, program
+
+
+def _replay(program):
+    def compute(*leaves):
+        values = list(leaves)
+        for op, refs, params in program:
+            args = [values[i] for i in refs]
+            if params is None:
+                values.append(op(*args))
+            else:
+                axis, dtype, keepdims = params
+                kwargs = {'axis': axis, 'keepdims': keepdims}
+                if dtype is not None:
+                    kwargs['dtype'] = dtype
+                values.append(getattr(args[0], op)(**kwargs))
+        return values[-1]
+    return compute
+
+
+class LazyArray:
+    """An array whose value is computed when it is used.
+
+    The lazy arrays are returned by the ufuncs called within
+    :func:`cupyx.lazy_evaluation`. The ufuncs and the arithmetic
+    operators applied to them, and their ``sum``, ``prod``, ``max`` and
+    ``min`` methods, return other lazy arrays. The value of a lazy array is
+    computed with a single fused kernel, as if the expression was written in
+    a function decorated by :func:`cupy.fuse`, when it is used: by
+    :meth:`compute`, :meth:`get`, a conversion to a NumPy array or a Python
+    scalar, :func:`print`, indexing, or by passing it to any other CuPy
+    function.
+
+    Attributes:
+        shape (tuple of ints): The shape.
+        dtype (numpy.dtype): The dtype.
+    """
+
+    __slots__ = ('_op', '_inputs', '_params', '_n_ops', '_value',
+                 'shape', 'dtype', '__weakref__')
+
+    __hash__ = None
+
+    # so that the operators of cupy.ndarray defer to the lazy arrays
+    __array_priority__ = 100
+
+    @classmethod
+    def _new(cls, op, inputs, params, shape, dtype):
+        self = cls.__new__(cls)
+        self._op = op
+        self._inputs = inputs
+        self._params = params
+        self._n_ops = 1 + sum([
+            x._n_ops for x in inputs if isinstance(x, LazyArray)])
+        self._value = None
+        self.shape = shape
+        self.dtype = dtype
+        if self._n_ops > _max_ops:
+            self.compute()
+        return self
+
+    @property
+    def ndim(self):
+        return len(self.shape)
+
+    @property
+    def size(self):
+        return internal.prod(self.shape)
+
+    def compute(self):
+        """Computes the value of the expression.
+
+        Returns:
+            cupy.ndarray: The value. It is also kept by the lazy array, so
+            that the expression is computed only once.
+        """
+        if self._value is not None:
+            return self._value
+        leaves, program = _linearize(self)
+        prev = _fusion_thread_local.set_lazy(False)
+        try:
+            func = _fused.get(program, ())
+            if func is ():
+                func = None
+                if len(program) > 1:
+                    func = fusion.Fusion(_replay(program), 'lazy_expression')
+                _fused[program] = func
+            value = None
+            if func is not None:
+                try:
+                    value = func(*leaves)
+                except Exception:
+                    # e.g. a combination of reductions that cannot be fused
+                    _fused[program] = None
+            if value is None:
+                value = _replay(program)(*leaves)
+        finally:
+            _fusion_thread_local.set_lazy(prev)
+        self._value = value
+        # the expression and its inputs are not needed anymore
+        self._inputs = ()
+        self._n_ops = 0
+        return value
+
+    def get(self, stream=None, order='C', out=None, blocking=True):
+        """Returns a copy of the value on host memory.
+
+        .. seealso:: :meth:`cupy.ndarray.get`
+        """
+        return self.compute().get(stream, order, out, blocking)
+
+    def item(self):
+        return self.compute().item()
+
+    def tolist(self):
+        return self.compute().tolist()
+
+    def __cupy_get_ndarray__(self):
+        return self.compute()
+
+    def __array__(self, dtype=None):
+        return numpy.asarray(self.get(), dtype)
+
+    def __repr__(self):
+        return repr(self.compute())
+
+    def __str__(self):
+        return str(self.compute())
+
+    def __len__(self):
+        if not self.shape:
+            raise TypeError('len() of unsized object')
+        return self.shape[0]
+
+    def __iter__(self):
+        return iter(self.compute())
+
+    def __getitem__(self, key):
+        return self.compute()[key]
+
+    def __bool__(self):
+        return bool(self.compute())
+
+    def __int__(self):
+        return int(self.compute())
+
+    def __float__(self):
+        return float(self.compute())
+
+    def __complex__(self):
+        return complex(self.compute())
+
+    def __cupy_override_elementwise_kernel__(self, kernel, *args, **kwargs):
+        if isinstance(kernel, cupy.ufunc):
+            return _call_ufunc(kernel, args, kwargs)
+        return _call_eagerly(kernel, args, kwargs)
+
+    def __cupy_override_reduction_kernel__(
+            self, kernel, axis, dtype, out, keepdims):
+        return _call_eagerly(kernel, (self, axis, dtype, out, keepdims), {})
+
+    def _reduce(self, name, axis, dtype, out, keepdims):
+        if out is not None:
+            kwargs = {'axis': axis, 'out': out, 'keepdims': keepdims}
+            if dtype is not None:
+                kwargs['dtype'] = dtype
+            return _call_eagerly(getattr(cupy.ndarray, name), (self,), kwargs)
+        if isinstance(axis, list):
+            axis = tuple(axis)
+        axes = internal._normalize_axis_indices(axis, self.ndim)
+        if keepdims:
+            shape = tuple([
+                1 if i in axes else s for i, s in enumerate(self.shape)])
+        else:
+            shape = tuple([
+                s for i, s in enumerate(self.shape) if i not in axes])
+        return LazyArray._new(
+            name, (self,), (axis, dtype, bool(keepdims)), shape,
+            _reduction_dtype(name, dtype, self.dtype))
+
+    def sum(self, axis=None, dtype=None, out=None, keepdims=False):
+        """Returns the sum along given axes, computed lazily.
+
+        .. seealso:: :meth:`cupy.ndarray.sum`
+        """
+        return self._reduce('sum', axis, dtype, out, keepdims)
+
+    def prod(self, axis=None, dtype=None, out=None, keepdims=False):
+        """Returns the product along given axes, computed lazily.
+
+        .. seealso:: :meth:`cupy.ndarray.prod`
+        """
+        return self._reduce('prod', axis, dtype, out, keepdims)
+
+    def max(self, axis=None, out=None, keepdims=False):
+        """Returns the maximum along given axes, computed lazily.
+
+        .. seealso:: :meth:`cupy.ndarray.max`
+        """
+        return self._reduce('max', axis, None, out, keepdims)
+
+    def min(self, axis=None, out=None, keepdims=False):
+        """Returns the minimum along given axes, computed lazily.
+
+        .. seealso:: :meth:`cupy.ndarray.min`
+        """
+        return self._reduce('min', axis, None, out, keepdims)
+
+    def __neg__(self):
+        return cupy.negative(self)
+
+    def __pos__(self):
+        return cupy.positive(self)
+
+    def __abs__(self):
+        return cupy.absolute(self)
+
+    def __invert__(self):
+        return cupy.invert(self)
+
+    def __add__(self, other):
+        return cupy.add(self, other)
+
+    def __radd__(self, other):
+        return cupy.add(other, self)
+
+    def __sub__(self, other):
+        return cupy.subtract(self, other)
+
+    def __rsub__(self, other):
+        return cupy.subtract(other, self)
+
+    def __mul__(self, other):
+        return cupy.multiply(self, other)
+
+    def __rmul__(self, other):
+        return cupy.multiply(other, self)
+
+    def __truediv__(self, other):
+        return cupy.true_divide(self, other)
+
+    def __rtruediv__(self, other):
+        return cupy.true_divide(other, self)
+
+    def __floordiv__(self, other):
+        return cupy.floor_divide(self, other)
+
+    def __rfloordiv__(self, other):
+        return cupy.floor_divide(other, self)
+
+    def __mod__(self, other):
+        return cupy.remainder(self, other)
+
+    def __rmod__(self, other):
+        return cupy.remainder(other, self)
+
+    def __pow__(self, other):
+        return cupy.power(self, other)
+
+    def __rpow__(self, other):
+        return cupy.power(other, self)
+
+    def __and__(self, other):
+        return cupy.bitwise_and(self, other)
+
+    def __rand__(self, other):
+        return cupy.bitwise_and(other, self)
+
+    def __or__(self, other):
+        return cupy.bitwise_or(self, other)
+
+    def __ror__(self, other):
+        return cupy.bitwise_or(other, self)
+
+    def __xor__(self, other):
+        return cupy.bitwise_xor(self, other)
+
+    def __rxor__(self, other):
+        return cupy.bitwise_xor(other, self)
+
+    def __lt__(self, other):
+        return cupy.less(self, other)
+
+    def __le__(self, other):
+        return cupy.less_equal(self, other)
+
+    def __gt__(self, other):
+        return cupy.greater(self, other)
+
+    def __ge__(self, other):
+        return cupy.greater_equal(self, other)
+
+    def __eq__(self, other):
+        return cupy.equal(self, other)
+
+    def __ne__(self, other):
+        return cupy.not_equal(self, other)
+
+
+@contextlib.contextmanager
+def lazy_evaluation():
+    """Evaluates the ufuncs lazily and fuses them across statements.
+
+    Within the with statement, the ufuncs (including the arithmetic
+    operators of :class:`cupy.ndarray`) called in this thread do not launch
+    kernels, but return :class:`~cupyx._lazy.LazyArray` objects that record
+    the expression. The expression is compiled and computed by one fused
+    kernel, as if it was written in a function decorated by
+    :func:`cupy.fuse`, when its value is used, so that the temporary arrays
+    of the intermediate results are not allocated.
+
+    >>> with cupyx.lazy_evaluation():
+    ...     y = a * b + c
+    ...     y = cupy.exp(y - y.max(axis=-1, keepdims=True))
+    ...     z = y / y.sum(axis=-1, keepdims=True)  # still no kernel launched
+    ...     print(z)  # computed with one kernel
+
+    The ufuncs with the ``out``, ``dtype`` or ``where`` arguments and with
+    more than one output, and the other functions, are computed immediately,
+    and compute the lazy arrays given to them. The reductions of the
+    :class:`cupy.ndarray` are also computed immediately; the reductions of
+    the lazy arrays are recorded. A lazy array is computed once, and its
+    value is reused by the expressions that refer to it. The expressions are
+    also computed when more than a few tens of operations are accumulated.
+
+    .. note::
+        The intermediate results used by several expressions are computed by
+        each of them. The code that needs a :class:`cupy.ndarray`, e.g. that
+        checks the type or reads other attributes, needs to call
+        :meth:`~cupyx._lazy.LazyArray.compute`.
+
+    .. seealso:: :func:`cupy.fuse`
+    """
+    prev = _fusion_thread_local.set_lazy(True)
+    try:
+        yield
+    finally:
+        _fusion_thread_local.set_lazy(prev)
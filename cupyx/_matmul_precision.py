@@ -0,0 +1,74 @@
+import contextlib
+import warnings
+
+from cupy._core import _routines_linalg as _linalg
+from cupy.cuda import device
+
+
+_TBD = _linalg.COMPUTE_TYPE_TBD
+
+# precision -> compute types of float16, float32 and float64
+_precisions = {
+    'default': (_linalg.COMPUTE_TYPE_DEFAULT,) * 3,
+    'pedantic': (_linalg.COMPUTE_TYPE_PEDANTIC,) * 3,
+    'tf32': (_TBD, _linalg.COMPUTE_TYPE_TF32, _TBD),
+    'fp16': (_TBD, _linalg.COMPUTE_TYPE_FP16, _TBD),
+    'bf16': (_TBD, _linalg.COMPUTE_TYPE_BF16, _TBD),
+}
+
+
+@contextlib.contextmanager
+def matmul_precision(precision):
+    """Sets the compute precision of the matrix products of the thread.
+
+    Within this context, the GEMMs of CuPy (:func:`cupy.matmul`,
+    :func:`cupy.dot`, :func:`cupy.tensordot`, ...) of the current thread
+    use the given precision, instead of the one set by
+    ``cupy._core.set_compute_type`` or :envvar:`CUPY_TF32`. The contexts can
+    be nested.
+
+    Args:
+        precision (str): One of:
+
+            - ``'default'``: the default precision of each dtype.
+            - ``'pedantic'``: the precision of each dtype, without the
+              algorithmic optimizations that can change the results.
+            - ``'tf32'``: the ``float32`` (and ``complex64``) inputs are
+              converted to TF32 for the tensor cores, with ``float32``
+              accumulation.
+            - ``'fp16'``: the same with a conversion to ``float16``.
+            - ``'bf16'``: the same with a conversion to ``bfloat16``.
+
+            The GEMMs of the other dtypes are not changed by the last three.
+
+    .. note::
+        ``'tf32'`` and ``'bf16'`` require a GPU of compute capability 8.0
+        or higher; ``'default'`` is used instead on the other GPUs. On ROCm,
+        the reduced precisions require ROCm 6.0 or later, and are used by
+        the matrix cores of the GPUs that have them. This function is
+        specific to CuPy.
+
+    Example:
+        >>> a = cupy.random.random((1024, 1024), dtype=cupy.float32)
+        >>> with cupyx.matmul_precision('tf32'):
+        ...     b = a @ a
+    """
+    try:
+        types = _precisions[precision]
+    except KeyError:
+        raise ValueError('Unknown precision: {}'.format(precision))
+    if (precision in ('tf32', 'bf16')
+            and int(device.get_compute_capability()) < 80):
+        warnings.warn('The {} precision is only available on GPUs with '
+                      'compute capability 8.0 or higher. The default '
+                      'precision will be used instead.'.format(precision))
+        types = _precisions['default']
+    prev = _linalg._get_thread_compute_types()
+    if prev is not None:
+        # the dtypes left alone keep the types of the outer context
+        types = [p if t == _TBD else t for t, p in zip(types, prev)]
+    _linalg._set_thread_compute_types(list(types))
+    try:
+        yield
+    finally:
+        _linalg._set_thread_compute_types(prev)
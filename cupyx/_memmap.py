@@ -0,0 +1,243 @@
+import collections
+import threading
+
+import numpy
+from numpy.lib import format as _format
+
+import cupy
+from cupy.cuda import device
+from cupy.cuda import stream as stream_module
+from cupyx import _pipelined_transfer
+
+
+def _read_npy_header(f):
+    version = _format.read_magic(f)
+    if version == (1, 0):
+        shape, fortran_order, dtype = _format.read_array_header_1_0(f)
+    elif version == (2, 0):
+        shape, fortran_order, dtype = _format.read_array_header_2_0(f)
+    else:
+        raise ValueError(
+            'unsupported .npy format version: {}'.format(version))
+    if fortran_order:
+        raise ValueError('Fortran-ordered .npy files are not supported')
+    return dtype, shape, f.tell()
+
+
+class DeviceMemmap(object):
+    """A read-only array on disk whose slices are read to the device lazily.
+
+    This is an analogue of :class:`numpy.memmap` for arrays too large to be
+    loaded at once. The array is divided into tiles of whole rows along
+    axis 0. Indexing reads the tiles that the rows selected along axis 0
+    touch into a cache on the current device, and returns a new
+    :class:`cupy.ndarray` computed from them; the other tiles are not read.
+    The tiles are read through pinned staging buffers and copied to the
+    device asynchronously (see :func:`cupyx.to_device_pipelined`), and the
+    least recently used tiles are dropped when the cache is full.
+
+    Args:
+        filename (str or path-like): The file. It is read as a ``.npy`` file
+            unless ``dtype`` and ``shape`` are given.
+        dtype: The dtype of a raw binary file.
+        shape (tuple of ints): The shape of a raw binary file, in C order.
+        offset (int): The offset of the data in a raw binary file in bytes.
+        tile_size (int): The approximate size of a tile in bytes.
+        cache_size (int): The size of the cache of each device in bytes. The
+            tiles needed by a single indexing are kept even if they exceed
+            it.
+
+    .. note::
+        The rows along axis 0 can be selected by an integer, a slice, or an
+        array of integers; the other axes are indexed on the device once the
+        rows are read. Fortran-ordered ``.npy`` files are not supported.
+
+    """
+
+    def __init__(self, filename, dtype=None, shape=None, offset=0, *,
+                 tile_size=1 << 26, cache_size=1 << 30):
+        if (dtype is None) != (shape is None):
+            raise ValueError('dtype and shape must be given together')
+        if tile_size <= 0 or cache_size < 0:
+            raise ValueError('invalid tile_size or cache_size')
+        self._file = open(filename, 'rb')
+        try:
+            if dtype is None:
+                dtype, shape, offset = _read_npy_header(self._file)
+            else:
+                dtype = numpy.dtype(dtype)
+                shape = tuple(shape) if numpy.iterable(shape) else (shape,)
+        except Exception:
+            self._file.close()
+            raise
+        if dtype.hasobject or not dtype.isnative:
+            self._file.close()
+            raise ValueError('unsupported dtype: {}'.format(dtype))
+        if len(shape) == 0:
+            self._file.close()
+            raise ValueError('0-dimensional arrays are not supported')
+        self.dtype = dtype
+        self.shape = shape
+        self.offset = offset
+        self._row_bytes = dtype.itemsize * int(numpy.prod(shape[1:]))
+        self._tile_rows = max(1, tile_size // max(1, self._row_bytes))
+        self._cache_size = cache_size
+        self._lock = threading.Lock()
+        # device id -> OrderedDict of tile -> (ndarray, event of its read)
+        self._caches = {}
+        self._cached_bytes = {}
+
+    @property
+    def ndim(self):
+        return len(self.shape)
+
+    @property
+    def size(self):
+        return int(numpy.prod(self.shape))
+
+    @property
+    def nbytes(self):
+        return self.size * self.dtype.itemsize
+
+    def __len__(self):
+        return self.shape[0]
+
+    def __repr__(self):
+        return 'DeviceMemmap(shape={}, dtype={})'.format(
+            self.shape, self.dtype)
+
+    def close(self):
+        """Closes the file and drops the cached tiles."""
+        with self._lock:
+            self._file.close()
+            self._caches.clear()
+            self._cached_bytes.clear()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def clear_cache(self):
+        """Drops the cached tiles of all devices."""
+        with self._lock:
+            self._caches.clear()
+            self._cached_bytes.clear()
+
+    def _read_tile(self, t):
+        start = t * self._tile_rows
+        stop = min(self.shape[0], start + self._tile_rows)
+        self._file.seek(self.offset + start * self._row_bytes)
+        return _pipelined_transfer.to_device_pipelined(
+            self._file, dtype=self.dtype,
+            shape=(stop - start,) + self.shape[1:])
+
+    def _get_tiles(self, tiles):
+        dev_id = device.get_device_id()
+        with self._lock:
+            if self._file.closed:
+                raise ValueError('the file is closed')
+            cache = self._caches.get(dev_id)
+            if cache is None:
+                cache = self._caches[dev_id] = collections.OrderedDict()
+                self._cached_bytes[dev_id] = 0
+            stream = stream_module.get_current_stream()
+            out = []
+            for t in tiles:
+                entry = cache.get(t)
+                if entry is None:
+                    a = self._read_tile(t)
+                    cache[t] = a, stream.record()
+                    self._cached_bytes[dev_id] += a.nbytes
+                else:
+                    # the tile may have been read on another stream
+                    a, event = entry
+                    stream.wait_event(event)
+                    cache.move_to_end(t)
+                out.append(a)
+            while cache and self._cached_bytes[dev_id] > self._cache_size:
+                _, (a, _) = cache.popitem(last=False)
+                self._cached_bytes[dev_id] -= a.nbytes
+        return out
+
+    def _rows(self, first):
+        # Returns the rows to read along axis 0, as a range or a sorted
+        # numpy array, and the index into the rows read.
+        n = self.shape[0]
+        if isinstance(first, cupy.ndarray):
+            first = first.get()
+        if isinstance(first, slice):
+            r = range(*first.indices(n))
+            if r.step == 1:
+                return r, slice(None)
+            # only the tiles touched by a strided slice are read
+            first = numpy.arange(r.start, r.stop, r.step)
+        if isinstance(first, (bool, numpy.bool_)):
+            raise IndexError('boolean indices are not supported')
+        if numpy.ndim(first) == 0:
+            i = int(first)
+            if not -n <= i < n:
+                raise IndexError(
+                    'index {} is out of bounds for axis 0 with size {}'
+                    .format(i, n))
+            i %= n
+            return range(i, i + 1), 0
+        idx = numpy.asarray(first)
+        if idx.size == 0:
+            return range(0, 0), slice(None)
+        if idx.dtype.kind not in 'iu':
+            raise IndexError('only integers, slices and integer arrays are '
+                             'supported along axis 0')
+        if idx.min() < -n or idx.max() >= n:
+            raise IndexError(
+                'index out of bounds for axis 0 with size {}'.format(n))
+        rows, pos = numpy.unique(idx % n, return_inverse=True)
+        return rows, cupy.asarray(pos.reshape(idx.shape))
+
+    def _gather(self, rows):
+        if len(rows) == 0:
+            return cupy.empty((0,) + self.shape[1:], self.dtype)
+        r = self._tile_rows
+        if isinstance(rows, range):
+            tiles = list(range(rows[0] // r, (rows[-1] // r) + 1))
+            parts = self._get_tiles(tiles)
+            base = tiles[0] * r
+            buf = parts[0] if len(parts) == 1 else cupy.concatenate(parts)
+            return buf[rows[0] - base:rows[-1] + 1 - base]
+        tiles = numpy.unique(rows // r).tolist()
+        parts = self._get_tiles(tiles)
+        buf = parts[0] if len(parts) == 1 else cupy.concatenate(parts)
+        # the positions of the rows in the concatenated tiles
+        tile_pos = numpy.searchsorted(tiles, rows // r)
+        pos = tile_pos * r + rows % r
+        return buf[cupy.asarray(pos)]
+
+    def __getitem__(self, key):
+        key = key if isinstance(key, tuple) else (key,)
+        if not key or key[0] is Ellipsis or key[0] is None:
+            # all the rows are read
+            return self._gather(range(self.shape[0]))[key].copy()
+        rows, first = self._rows(key[0])
+        block = self._gather(rows)
+        return block[(first,) + key[1:]].copy()
+
+    def prefetch(self, key):
+        """Reads the tiles needed for ``self[key]`` into the cache.
+
+        Args:
+            key: The rows along axis 0, in the same forms as for indexing.
+        """
+        if isinstance(key, tuple):
+            key = key[0] if key else slice(None)
+        if key is Ellipsis or key is None:
+            key = slice(None)
+        rows, _ = self._rows(key)
+        if len(rows) == 0:
+            return
+        r = self._tile_rows
+        if isinstance(rows, range):
+            tiles = range(rows[0] // r, rows[-1] // r + 1)
+        else:
+            tiles = numpy.unique(rows // r).tolist()
+        self._get_tiles(tiles)
@@ -0,0 +1,226 @@
+import numpy
+
+import cupy
+from cupy._core import _reduction
+from cupy._core import internal
+
+
+# The state of a slice is its count, its mean and the sums of the 2nd, 3rd
+# and 4th powers of the deviations from the mean, in float64. Partial states
+# are merged with the formulas of Pebay (2008), which extend those of Chan et
+# al. for the variance, so that the input is read once and the states of
+# several arrays (or devices) can be merged later.
+_moment_preamble = r'''
+struct moment_st {
+    double n, mean, m2, m3, m4;
+    __device__ moment_st() : n(0), mean(0), m2(0), m3(0), m4(0) { }
+    __device__ moment_st(double n, double mean, double m2, double m3,
+                         double m4)
+        : n(n), mean(mean), m2(m2), m3(m3), m4(m4) { }
+};
+
+template <typename T>
+__device__ moment_st moment_of(const T& x) {
+    return moment_st(1, (double)x, 0, 0, 0);
+}
+
+template <typename T>
+__device__ moment_st nanmoment_of(const T& x) {
+    return isnan((double)x) ? moment_st() : moment_of(x);
+}
+
+__device__ moment_st moment_merge(const moment_st& a, const moment_st& b) {
+    if (a.n == 0) {
+        return b;
+    }
+    if (b.n == 0) {
+        return a;
+    }
+    const double n = a.n + b.n;
+    const double d = b.mean - a.mean;
+    const double d_n = d / n;
+    const double d_n2 = d_n * d_n;
+    const double t = d * d_n * a.n * b.n;
+    moment_st r;
+    r.n = n;
+    r.mean = a.mean + d_n * b.n;
+    r.m2 = a.m2 + b.m2 + t;
+    r.m3 = a.m3 + b.m3 + t * d_n * (a.n - b.n)
+        + 3 * d_n * (a.n * b.m2 - b.n * a.m2);
+    r.m4 = a.m4 + b.m4 + t * d_n2 * (a.n * a.n - a.n * b.n + b.n * b.n)
+        + 6 * d_n2 * (a.n * a.n * b.m2 + b.n * b.n * a.m2)
+        + 4 * d_n * (a.n * b.m3 - b.n * a.m3);
+    return r;
+}
+'''
+
+_moment_out_params = ('float64 n, float64 mean, float64 m2, float64 m3, '
+                      'float64 m4')
+_moment_post_map = 'n = a.n; mean = a.mean; m2 = a.m2; m3 = a.m3; m4 = a.m4'
+
+_moment_kernel = cupy._core.ReductionKernel(
+    'T x', _moment_out_params, 'moment_of(x)', 'moment_merge(a, b)',
+    _moment_post_map, 'moment_st()', 'cupyx_moments',
+    reduce_type='moment_st', preamble=_moment_preamble)
+
+_nanmoment_kernel = cupy._core.ReductionKernel(
+    'T x', _moment_out_params, 'nanmoment_of(x)', 'moment_merge(a, b)',
+    _moment_post_map, 'moment_st()', 'cupyx_nanmoments',
+    reduce_type='moment_st', preamble=_moment_preamble)
+
+_merge_state_kernel = cupy._core.ReductionKernel(
+    'float64 n_in, float64 mean_in, float64 m2_in, float64 m3_in, '
+    'float64 m4_in', _moment_out_params,
+    'moment_st(n_in, mean_in, m2_in, m3_in, m4_in)', 'moment_merge(a, b)',
+    _moment_post_map, 'moment_st()', 'cupyx_merge_moments',
+    reduce_type='moment_st', preamble=_moment_preamble)
+
+
+class MomentState(object):
+    """The first four central moments of slices of an array.
+
+    A state holds, for each slice, the number of items, their mean and the
+    sums of the 2nd, 3rd and 4th powers of the deviations from the mean. The
+    states of different parts of the data are merged exactly, e.g. those of
+    the shards of a dataset on several devices: gather the :attr:`data` of
+    each device, for instance with ``allGather`` of
+    :class:`cupy.cuda.nccl.NcclCommunicator`, and merge the stacked arrays
+    with :meth:`merge_all`.
+
+    Args:
+        data (cupy.ndarray): A float64 array of shape ``(5,) + shape``,
+            where ``shape`` is the shape of the statistics.
+
+    .. seealso:: :func:`cupyx.moments`
+    """
+
+    def __init__(self, data):
+        data = cupy.asarray(data, dtype=numpy.float64)
+        if data.ndim == 0 or data.shape[0] != 5:
+            raise ValueError('the moment state must be of shape (5, ...)')
+        self.data = data
+
+    @property
+    def shape(self):
+        """The shape of the statistics."""
+        return self.data.shape[1:]
+
+    @property
+    def count(self):
+        """The number of items of each slice, as float64."""
+        return self.data[0]
+
+    @property
+    def mean(self):
+        """The mean of each slice."""
+        return self.data[1]
+
+    def _central(self, k):
+        # the k-th central moment, NaN for an empty slice
+        return self.data[k] / self.data[0]
+
+    def var(self, ddof=0):
+        """The variance of each slice, NaN if ``count <= ddof``."""
+        dof = self.data[0] - ddof
+        return cupy.where(dof > 0, self.data[2] / cupy.maximum(dof, 1),
+                          numpy.nan)
+
+    def std(self, ddof=0):
+        """The standard deviation of each slice, NaN if ``count <= ddof``."""
+        return cupy.sqrt(self.var(ddof))
+
+    def skew(self, bias=True):
+        """The sample skewness of each slice, as :func:`scipy.stats.skew`.
+
+        Slices of a zero variance have a NaN skewness.
+        """
+        n = self.data[0]
+        m2 = self._central(2)
+        m3 = self._central(3)
+        zero = m2 <= (numpy.finfo(numpy.float64).resolution * self.mean) ** 2
+        vals = cupy.where(zero, numpy.nan, m3 / m2 ** 1.5)
+        if not bias:
+            correct = ~zero & (n > 2)
+            corrected = cupy.sqrt((n - 1) * n) / (n - 2) * vals
+            vals = cupy.where(correct, corrected, vals)
+        return vals
+
+    def kurtosis(self, fisher=True, bias=True):
+        """The sample kurtosis of each slice, as :func:`scipy.stats.kurtosis`.
+
+        Slices of a zero variance have a NaN kurtosis.
+        """
+        n = self.data[0]
+        m2 = self._central(2)
+        m4 = self._central(4)
+        zero = m2 <= (numpy.finfo(numpy.float64).resolution * self.mean) ** 2
+        vals = cupy.where(zero, numpy.nan, m4 / m2 ** 2)
+        if not bias:
+            correct = ~zero & (n > 3)
+            corrected = ((n * n - 1) * vals - 3 * (n - 1) ** 2) / (
+                (n - 2) * (n - 3)) + 3
+            vals = cupy.where(correct, corrected, vals)
+        return vals - 3 if fisher else vals
+
+    def merge(self, other):
+        """Returns the state of the union of the data of two states.
+
+        The shapes of the states must be broadcastable.
+        """
+        data = cupy.stack(cupy.broadcast_arrays(self.data, other.data))
+        return MomentState.merge_all(data)
+
+    @staticmethod
+    def merge_all(data, axis=0):
+        """Merges states stacked along an axis.
+
+        Args:
+            data (cupy.ndarray): The stacked :attr:`data` of the states, of
+                shape ``(m, 5) + shape`` for the default ``axis``.
+            axis (int): The axis along which the states are stacked. It
+                must not be the one of the five items of a state.
+
+        Returns:
+            MomentState: The merged state.
+        """
+        data = cupy.asarray(data, dtype=numpy.float64)
+        axis = internal._normalize_axis_index(axis, data.ndim)
+        data = cupy.moveaxis(data, axis, 0)
+        if data.ndim < 2 or data.shape[1] != 5:
+            raise ValueError('the moment states must be stacked along a '
+                             'different axis than the one of their items')
+        out = cupy.empty(data.shape[1:], dtype=numpy.float64)
+        _merge_state_kernel(*data.swapaxes(0, 1), *out, axis=0)
+        return MomentState(out)
+
+
+def moments(a, axis=None, keepdims=False, skipna=False):
+    """Computes the first four moments of an array in a single pass.
+
+    Args:
+        a (cupy.ndarray): A real array.
+        axis (int or tuple of ints): The axes along which the moments are
+            computed. By default, over the whole array.
+        keepdims (bool): If ``True``, the reduced axes are kept with a size
+            of one.
+        skipna (bool): If ``True``, the items that are NaN are ignored.
+
+    Returns:
+        MomentState: The mergeable state of each slice.
+
+    .. note::
+        The moments are accumulated in float64. This function is specific
+        to CuPy.
+
+    .. seealso:: :class:`cupyx.MomentState`
+    """
+    a = cupy.asarray(a)
+    if a.dtype.kind not in 'biuf':
+        raise TypeError('dtype is not supported: {}'.format(a.dtype))
+    reduce_axis, out_axis = _reduction._get_axis(axis, a.ndim)
+    shape = _reduction._get_out_shape(a.shape, reduce_axis, out_axis,
+                                      keepdims)
+    data = cupy.empty((5,) + tuple(shape), dtype=numpy.float64)
+    kernel = _nanmoment_kernel if skipna else _moment_kernel
+    kernel(a, *data, axis=axis, keepdims=keepdims)
+    return MomentState(data)
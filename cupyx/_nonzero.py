@@ -0,0 +1,59 @@
+import cupy
+from cupy._core import _routines_indexing
+
+
+def argwhere_async(a, out=None):
+    """Returns the indices of the nonzero items without synchronizing.
+
+    :func:`cupy.argwhere` has to read the number of nonzero items back to
+    the host to allocate its result. This function instead writes the
+    indices into an array with a row for every item of ``a``, and returns
+    the number of nonzero items as a 0-dim array on the device, so that it
+    can be queued without stalling the host.
+
+    Args:
+        a (cupy.ndarray): The input array.
+        out (cupy.ndarray, optional): A C-contiguous ``int64`` array of
+            shape ``(m, a.ndim)`` with ``m >= a.size`` to write the indices
+            to.
+
+    Returns:
+        tuple: The array of the indices (``out`` if given), of which only
+        the first ``count`` rows are valid, and ``count`` as a 0-dim
+        ``int64`` array on the device. ``indices[:int(count)]`` is equal to
+        ``cupy.argwhere(a)``.
+
+    .. note::
+        The indices are selected with CUB's ``DeviceSelect::Flagged`` when
+        the dtype is supported, and with a scan otherwise. This function is
+        specific to CuPy.
+
+    .. seealso:: :func:`cupy.argwhere`, :func:`cupyx.flatnonzero_async`
+    """
+    if not isinstance(a, cupy.ndarray):
+        raise TypeError('a must be a cupy.ndarray')
+    return _routines_indexing._ndarray_argwhere_bounded(a, out, False)
+
+
+def flatnonzero_async(a, out=None):
+    """Returns the flat indices of the nonzero items without synchronizing.
+
+    Args:
+        a (cupy.ndarray): The input array.
+        out (cupy.ndarray, optional): A C-contiguous 1-dim ``int64`` array of
+            at least ``a.size`` items to write the indices to.
+
+    Returns:
+        tuple: The array of the indices (``out`` if given), of which only
+        the first ``count`` items are valid, and ``count`` as a 0-dim
+        ``int64`` array on the device. ``indices[:int(count)]`` is equal to
+        ``cupy.flatnonzero(a)``.
+
+    .. note::
+        This function is specific to CuPy.
+
+    .. seealso:: :func:`cupy.flatnonzero`, :func:`cupyx.argwhere_async`
+    """
+    if not isinstance(a, cupy.ndarray):
+        raise TypeError('a must be a cupy.ndarray')
+    return _routines_indexing._ndarray_argwhere_bounded(a, out, True)
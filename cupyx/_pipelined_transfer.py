@@ -0,0 +1,219 @@
+"""Chunked host-device transfers through pinned staging buffers.
+
+A large transfer is split into chunks, which go through a few pinned
+buffers in turn: while the copy engine moves one chunk on a dedicated copy
+stream, the CPU fills (or drains) the next buffer from (or to) the pageable
+source (or destination). The current stream waits for the copies with an
+event, so that the transfer overlaps with the compute queued before it.
+"""
+
+import numpy
+
+import cupy
+from cupy import _util
+from cupy.cuda import pinned_memory
+from cupy.cuda import stream as stream_module
+
+
+_default_chunk_size = 1 << 25  # 32 MiB
+
+
+@_util.memoize(for_each_device=True)
+def _get_copy_stream():
+    return stream_module.Stream(non_blocking=True)
+
+
+def _check_args(chunk_size, n_buffers):
+    if chunk_size <= 0:
+        raise ValueError('chunk_size must be positive')
+    if n_buffers < 1:
+        raise ValueError('n_buffers must be positive')
+
+
+def _get_chunks(nbytes, shape, itemsize, chunk_size, by_rows):
+    # Yields (offset, size) in bytes. For arrays, the chunks are made of
+    # whole rows along axis 0, so that they can be copied with numpy in any
+    # layout.
+    if nbytes == 0:
+        return
+    if by_rows and len(shape) > 0:
+        row = itemsize * int(numpy.prod(shape[1:]))
+        chunk_size = max(1, chunk_size // row) * row
+    chunk_size = min(chunk_size, nbytes)
+    for offset in range(0, nbytes, chunk_size):
+        yield offset, min(chunk_size, nbytes - offset)
+
+
+def _rows(x, offset, size):
+    # The rows of x in the chunk of bytes [offset, offset + size).
+    if x.ndim == 0:
+        return x.reshape(1)
+    row = x.nbytes // x.shape[0]
+    return x[offset // row:(offset + size) // row]
+
+
+def _staging_view(buf, size, like):
+    a = numpy.frombuffer(buf, numpy.uint8, size)
+    if like is None:
+        return a
+    return a.view(like.dtype).reshape(like.shape)
+
+
+def _read_into(f, view):
+    n = 0
+    while n < len(view):
+        count = f.readinto(view[n:])
+        if not count:
+            raise EOFError('the source ended before the array was filled')
+        n += count
+
+
+def to_device_pipelined(src, out=None, *, dtype=None, shape=None,
+                        chunk_size=_default_chunk_size, n_buffers=2):
+    """Copies host data to the device through pinned staging buffers.
+
+    This is an alternative to :func:`cupy.asarray` for large pageable
+    arrays and files: the data is copied chunk by chunk into ``n_buffers``
+    pinned buffers, and from them to the device on a separate stream, so
+    that copying to the staging buffers on the CPU overlaps with the
+    transfers. The returned array can be used on the current stream right
+    away, as the stream waits for the transfers.
+
+    Args:
+        src (numpy.ndarray or file-like object): The source. A file-like
+            object must have ``readinto``, as e.g. a file opened in binary
+            mode, and ``dtype`` and ``shape`` must be given to read from it.
+        out (cupy.ndarray): The C-contiguous array to copy to. It must have
+            the shape and dtype of the source.
+        dtype: The dtype of the data read from a file.
+        shape (tuple of ints): The shape of the data read from a file.
+        chunk_size (int): The size of each staging buffer in bytes.
+        n_buffers (int): The number of staging buffers.
+
+    Returns:
+        cupy.ndarray: The array on the current device.
+
+    .. note::
+        The call returns once the last chunk has been staged; the copy of
+        that chunk to the device may still be in flight.
+
+    """
+    _check_args(chunk_size, n_buffers)
+    is_array = isinstance(src, numpy.ndarray)
+    if is_array:
+        dtype, shape = src.dtype, src.shape
+    elif not hasattr(src, 'readinto'):
+        raise TypeError('src must be a numpy.ndarray or a file-like object')
+    elif dtype is None or shape is None:
+        raise ValueError('dtype and shape are needed to read from a file')
+    dtype = numpy.dtype(dtype)
+    if not is_array:
+        shape = tuple(shape) if numpy.iterable(shape) else (shape,)
+    if out is None:
+        out = cupy.empty(shape, dtype)
+    elif out.shape != tuple(shape) or out.dtype != dtype:
+        raise ValueError('out must be of shape {} and dtype {}'.format(
+            tuple(shape), dtype))
+    elif not out.flags.c_contiguous:
+        raise ValueError('out must be C-contiguous')
+
+    stream = stream_module.get_current_stream()
+    copy_stream = _get_copy_stream()
+    # out may have just been allocated on the current stream
+    copy_stream.wait_event(stream.record())
+    buffers = []
+    events = [None] * n_buffers
+    chunks = _get_chunks(out.nbytes, shape, dtype.itemsize, chunk_size,
+                         is_array)
+    for i, (offset, size) in enumerate(chunks):
+        k = i % n_buffers
+        if k == len(buffers):
+            buffers.append(pinned_memory.alloc_pinned_memory(size))
+        if events[k] is not None:
+            # the previous copy from this buffer
+            events[k].synchronize()
+        if is_array:
+            rows = _rows(src, offset, size)
+            numpy.copyto(_staging_view(buffers[k], size, rows), rows)
+        else:
+            _read_into(src, memoryview(_staging_view(buffers[k], size, None)))
+        (out.data + offset).copy_from_host_async(
+            buffers[k].ptr, size, copy_stream)
+        events[k] = copy_stream.record()
+    stream.wait_event(copy_stream.record())
+    # the pool reuses the buffers once the copies are done
+    pinned_memory._record_and_watch(copy_stream, buffers)
+    return out
+
+
+def to_host_pipelined(a, out=None, *, chunk_size=_default_chunk_size,
+                      n_buffers=2):
+    """Copies a device array to the host through pinned staging buffers.
+
+    The reverse of :func:`to_device_pipelined`: the chunks are copied from
+    the device to ``n_buffers`` pinned buffers on a separate stream, and from
+    them to the destination on the CPU while the next chunks are in flight.
+    The copies start after the work queued on the current stream.
+
+    Args:
+        a (cupy.ndarray): The array to copy. It is made C-contiguous first if
+            it is not.
+        out (numpy.ndarray or file-like object): The destination. An array
+            must have the shape and dtype of ``a``; a file-like object must
+            have ``write``, and receives the data in C order.
+        chunk_size (int): The size of each staging buffer in bytes.
+        n_buffers (int): The number of staging buffers.
+
+    Returns:
+        numpy.ndarray or file-like object: ``out``, or a new array if it is
+        ``None``.
+
+    """
+    _check_args(chunk_size, n_buffers)
+    a = cupy.ascontiguousarray(a)
+    if out is None:
+        out = numpy.empty(a.shape, a.dtype)
+    is_array = isinstance(out, numpy.ndarray)
+    if is_array:
+        if out.shape != a.shape or out.dtype != a.dtype:
+            raise ValueError('out must be of shape {} and dtype {}'.format(
+                a.shape, a.dtype))
+    elif not hasattr(out, 'write'):
+        raise TypeError('out must be a numpy.ndarray or a file-like object')
+
+    stream = stream_module.get_current_stream()
+    copy_stream = _get_copy_stream()
+    copy_stream.wait_event(stream.record())
+    buffers = []
+    # (event, offset, size) of the copy to each buffer in flight
+    pending = [None] * n_buffers
+
+    def drain(k):
+        event, offset, size = pending[k]
+        event.synchronize()
+        if is_array:
+            rows = _rows(out, offset, size)
+            numpy.copyto(rows, _staging_view(buffers[k], size, rows))
+        else:
+            out.write(memoryview(_staging_view(buffers[k], size, None)))
+        pending[k] = None
+
+    chunks = _get_chunks(a.nbytes, a.shape, a.dtype.itemsize, chunk_size,
+                         is_array)
+    i = 0
+    for i, (offset, size) in enumerate(chunks):
+        k = i % n_buffers
+        if k == len(buffers):
+            buffers.append(pinned_memory.alloc_pinned_memory(size))
+        if pending[k] is not None:
+            drain(k)
+        (a.data + offset).copy_to_host_async(
+            buffers[k].ptr, size, copy_stream)
+        pending[k] = (copy_stream.record(), offset, size)
+    # the chunks still in flight, in order
+    for j in range(i + 1, i + 1 + n_buffers):
+        if pending[j % n_buffers] is not None:
+            drain(j % n_buffers)
+    # a may be freed on the current stream once the copies are done
+    stream.wait_event(copy_stream.record())
+    return out
@@ -0,0 +1,88 @@
+import concurrent.futures
+import os
+import threading
+
+import numpy
+
+import cupy
+from cupy import _util
+from cupy.cuda import device
+
+
+_executor = None
+_executor_lock = threading.Lock()
+
+
+def _get_executor(max_workers):
+    global _executor
+    with _executor_lock:
+        if _executor is None:
+            if max_workers is None:
+                max_workers = min(8, os.cpu_count() or 1)
+            _executor = concurrent.futures.ThreadPoolExecutor(
+                max_workers, thread_name_prefix='cupy_prefetch')
+    return _executor
+
+
+@_util.memoize(for_each_device=True)
+def _get_stream():
+    return cupy.cuda.Stream(non_blocking=True)
+
+
+def _compile(kernel, dtypes, device_id):
+    with device.Device(device_id):
+        if isinstance(kernel, (cupy.RawKernel, cupy.RawModule)):
+            kernel.compile()
+            return kernel
+        # The kernels are compiled on their first call, so call them with
+        # the dtypes on tiny arrays. These are C-contiguous and 1-D, which
+        # is what the arguments of most calls are reduced to.
+        stream = _get_stream()
+        with stream:
+            kernel(*[cupy.zeros((1,), dtype) for dtype in dtypes])
+        stream.synchronize()
+    return kernel
+
+
+def prefetch_kernels(hints, *, max_workers=None):
+    """Compiles kernels in the background.
+
+    The kernels are compiled concurrently by a pool of threads, so that their
+    first real call does not wait for the compiler. A call that needs a
+    kernel while it is still being compiled waits for that compilation
+    instead of starting another one.
+
+    Args:
+        hints (iterable): The kernels to compile. Each item is either a
+            :class:`cupy.RawKernel` or :class:`cupy.RawModule`, or a pair
+            ``(kernel, dtypes)`` of a :class:`cupy.ElementwiseKernel`,
+            :class:`cupy.ReductionKernel` or :class:`cupy.ufunc` and the
+            dtypes of its input arguments.
+        max_workers (int): The number of threads of the pool. It is only
+            used when the pool is created by the first call. Defaults to the
+            number of CPUs, up to 8.
+
+    Returns:
+        list of concurrent.futures.Future: One future for each hint, which
+        resolves to the kernel once it has been compiled for the current
+        device, or raises the compilation error.
+
+    .. note::
+        The kernels other than raw ones are compiled by calling them with
+        one-element arrays on a separate stream. The variant compiled is the
+        one used for C-contiguous arguments, which is also what
+        non-contiguous arguments are often reduced to.
+
+    """
+    executor = _get_executor(max_workers)
+    device_id = device.get_device_id()
+    futures = []
+    for hint in hints:
+        if isinstance(hint, (cupy.RawKernel, cupy.RawModule)):
+            kernel, dtypes = hint, ()
+        else:
+            kernel, dtypes = hint
+            dtypes = tuple(numpy.dtype(dtype) for dtype in dtypes)
+        futures.append(
+            executor.submit(_compile, kernel, dtypes, device_id))
+    return futures
@@ -0,0 +1,67 @@
+import numpy
+
+import cupy
+
+
+def _prepare(a, offsets):
+    a = cupy.asarray(a)
+    if a.ndim != 1:
+        raise ValueError('a must be a 1-dim array')
+    offsets = cupy.asarray(offsets)
+    if offsets.ndim != 1 or offsets.size == 0:
+        raise ValueError('offsets must be a non-empty 1-dim array')
+    if offsets.dtype.kind not in 'iu':
+        raise TypeError('offsets must be of an integer dtype')
+    offsets = cupy.ascontiguousarray(offsets, dtype=numpy.int64)
+    return a, offsets
+
+
+def segmented_sort(a, offsets):
+    """Returns a copy of a ragged array with every segment sorted.
+
+    The segments are given by CSR-style offsets: segment ``i`` is
+    ``a[offsets[i]:offsets[i + 1]]``. Integer and floating point arrays are
+    sorted with CUB's segmented sort, which sorts small segments within a
+    warp, so no padding to a dense matrix is needed.
+
+    Args:
+        a (cupy.ndarray): 1-dim array to be sorted.
+        offsets (cupy.ndarray): Non-decreasing offsets of the segments. The
+            first one must be 0 and the last one must be ``a.size``.
+
+    Returns:
+        cupy.ndarray: The sorted array.
+
+    .. seealso:: :func:`cupy.sort`
+
+    """
+    from cupy.cuda import thrust
+    a, offsets = _prepare(a, offsets)
+    out = a.copy()
+    thrust.segmented_sort(out.dtype, out.data.ptr, offsets.data.ptr,
+                          out.size, offsets.size - 1)
+    return out
+
+
+def segmented_argsort(a, offsets):
+    """Returns the indices that sort every segment of a ragged array.
+
+    Args:
+        a (cupy.ndarray): 1-dim array to be sorted.
+        offsets (cupy.ndarray): Offsets of the segments. See
+            :func:`cupyx.segmented_sort`.
+
+    Returns:
+        cupy.ndarray: Indices into ``a`` (not into the segments), so that
+        ``a[idx]`` is the segment-wise sorted array. The sort is stable.
+
+    .. seealso:: :func:`cupy.argsort`
+
+    """
+    from cupy.cuda import thrust
+    a, offsets = _prepare(a, offsets)
+    data = a.copy()
+    idx = cupy.empty(a.shape, dtype=numpy.intp)
+    thrust.segmented_argsort(data.dtype, idx.data.ptr, data.data.ptr,
+                             offsets.data.ptr, data.size, offsets.size - 1)
+    return idx
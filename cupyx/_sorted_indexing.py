@@ -0,0 +1,162 @@
+import numpy
+
+import cupy
+from cupy._core import internal
+
+
+# The output is laid out as (ldim, m, rdim) and a as (ldim, n, rdim), where
+# m is the number of indices and n the length of the indexed axis. Item j of
+# the sorted order reads the row keys[j] of a and writes the row order[j],
+# so that consecutive threads copy the same or adjacent rows of a.
+_sorted_take_kernel = cupy.ElementwiseKernel(
+    'raw T a, raw int64 keys, raw int64 order, int64 m, int64 n, int64 rdim',
+    'raw T out',
+    '''
+    const ptrdiff_t r = i % rdim;
+    const ptrdiff_t j = i / rdim % m;
+    const ptrdiff_t l = i / (rdim * m);
+    out[(l * m + order[j]) * rdim + r] = a[(l * n + keys[j]) * rdim + r];
+    ''',
+    'cupyx_sorted_take')
+
+# A thread per item of the row of each run of equal keys, which adds up the
+# values of the run in sorted order. Every item of a is updated by at most
+# one thread, so no atomics are needed.
+_sorted_scatter_add_kernel = cupy.ElementwiseKernel(
+    'raw T v, raw int64 keys, raw int64 order, raw int64 starts, '
+    'int64 n_runs, int64 m, int64 n, int64 rdim',
+    'raw T a',
+    '''
+    const ptrdiff_t r = i % rdim;
+    const ptrdiff_t s = i / rdim % n_runs;
+    const ptrdiff_t l = i / (rdim * n_runs);
+    const ptrdiff_t begin = starts[s];
+    const ptrdiff_t end = starts[s + 1];
+    T acc = v[(l * m + order[begin]) * rdim + r];
+    for (ptrdiff_t j = begin + 1; j < end; j++) {
+        acc += v[(l * m + order[j]) * rdim + r];
+    }
+    a[(l * n + keys[begin]) * rdim + r] += acc;
+    ''',
+    'cupyx_sorted_scatter_add')
+
+
+def _prepare(a, indices, axis):
+    # Returns the wrapped and sorted indices, the positions they come from,
+    # and the (ldim, n, rdim) layout of a around the axis.
+    if axis is None:
+        a = a.ravel()
+        axis = 0
+    else:
+        axis = internal._normalize_axis_index(axis, a.ndim)
+    indices = cupy.asarray(indices)
+    if indices.dtype.kind not in 'iu':
+        raise TypeError('indices must be of an integer dtype')
+    n = a.shape[axis]
+    if n == 0 and indices.size != 0:
+        raise IndexError('cannot index an empty axis')
+    keys = indices.ravel().astype(numpy.int64)
+    if n != 0:
+        # wrapped as cupy.take does
+        keys %= n
+    # argsort of integer keys is a radix sort, and it is stable, so that the
+    # positions of equal keys stay in order
+    order = cupy.argsort(keys)
+    keys = keys[order]
+    ldim = internal.prod(a.shape[:axis])
+    rdim = internal.prod(a.shape[axis + 1:])
+    return a, axis, indices.shape, keys, order, ldim, n, rdim
+
+
+def sorted_take(a, indices, axis=None):
+    """Takes elements of an array along an axis, in the order of the indices.
+
+    The result is the one of :func:`cupy.take`. The indices are sorted first,
+    and the slices of ``a`` are gathered in the sorted order and written back
+    to their positions. For random indices into a large table, e.g. embedding
+    lookups, consecutive threads then read the same or nearby rows, which
+    makes a better use of the caches and the TLB than the order of the
+    indices.
+
+    Args:
+        a (cupy.ndarray): The source array.
+        indices (cupy.ndarray): The integer indices. They are wrapped into
+            the length of the axis.
+        axis (int): The axis along which to take the elements. If ``None``,
+            ``a`` is treated as a flattened array.
+
+    Returns:
+        cupy.ndarray: The gathered array, of shape
+        ``a.shape[:axis] + indices.shape + a.shape[axis + 1:]``.
+
+    .. note::
+        Sorting costs a few passes over the indices, so this only pays off
+        for large tables and many indices. This function is specific to
+        CuPy.
+
+    .. seealso:: :func:`cupy.take`
+    """
+    a = cupy.asarray(a)
+    a, axis, indices_shape, keys, order, ldim, n, rdim = _prepare(
+        a, indices, axis)
+    out = cupy.empty(a.shape[:axis] + indices_shape + a.shape[axis + 1:],
+                     dtype=a.dtype)
+    if out.size == 0:
+        return out
+    a = cupy.ascontiguousarray(a)
+    _sorted_take_kernel(a, keys, order, keys.size, n, rdim, out,
+                        size=out.size)
+    return out
+
+
+def sorted_scatter_add(a, indices, values, axis=None):
+    """Adds values to the slices of an array along an axis, without atomics.
+
+    This computes ``cupyx.scatter_add`` along an axis, i.e. it adds
+    ``values`` into ``a`` at ``indices`` and accumulates the values of
+    repeated indices. The indices are sorted, and the values of each run of
+    equal indices are added up in a single thread before updating ``a``.
+    Contrary to the atomics of :func:`cupyx.scatter_add`, this works for any
+    numeric dtype, its result does not depend on the scheduling, and it does
+    not slow down when many indices collide, e.g. for the gradient of an
+    embedding lookup.
+
+    Args:
+        a (cupy.ndarray): The array updated in place.
+        indices (cupy.ndarray): The integer indices. They are wrapped into
+            the length of the axis.
+        values (cupy.ndarray or scalar): The values to add. They are
+            broadcast to ``a.shape[:axis] + indices.shape +
+            a.shape[axis + 1:]``.
+        axis (int): The axis along which to add the values. If ``None``,
+            ``a`` is treated as a flattened array.
+
+    .. note::
+        The values of a run are added up in the order of their positions in
+        ``indices``. This function is specific to CuPy.
+
+    .. seealso:: :func:`cupyx.scatter_add`
+    """
+    if not isinstance(a, cupy.ndarray):
+        raise TypeError('a must be a cupy.ndarray')
+    if a.dtype.kind not in 'iufc':
+        raise TypeError('dtype is not supported: {}'.format(a.dtype))
+    target = a
+    if not a._c_contiguous:
+        a = a.copy()
+    a_, axis, indices_shape, keys, order, ldim, n, rdim = _prepare(
+        a, indices, axis)
+    v_shape = a_.shape[:axis] + indices_shape + a_.shape[axis + 1:]
+    values = cupy.asarray(values).astype(a.dtype, copy=False)
+    values = cupy.ascontiguousarray(cupy.broadcast_to(values, v_shape))
+    if values.size == 0:
+        return
+    starts = cupy.flatnonzero(cupy.concatenate((
+        cupy.ones(1, dtype=bool), keys[1:] != keys[:-1])))
+    n_runs = starts.size
+    starts = cupy.concatenate((starts, cupy.array([keys.size])))
+    _sorted_scatter_add_kernel(
+        values, keys, order, starts, n_runs, keys.size, n, rdim, a_,
+        size=ldim * n_runs * rdim)
+    if a is not target:
+        target[...] = a
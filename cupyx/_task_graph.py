@@ -0,0 +1,196 @@
+from cupy.cuda import device
+from cupy.cuda import stream as stream_module
+
+
+class Task:
+
+    """A computation submitted to a :class:`cupyx.TaskGraph`.
+
+    A task is passed as an argument of the later tasks that consume its
+    result, which makes them depend on it.
+
+    Attributes:
+        result: The value returned by the function of the task. Its work is
+            ordered on the current stream once the graph is exited.
+    """
+
+    def __init__(self, lane, index, result):
+        self._lane = lane
+        self._index = index
+        self.result = result
+
+    def __repr__(self):
+        return '<Task {} on {}>'.format(self._index, self._lane.stream)
+
+
+class _Lane:
+
+    def __init__(self, priority):
+        self.stream = stream_module.Stream(
+            non_blocking=True, priority=priority)
+        self.priority = priority
+        self.started = False  # waited for the fork of the block
+        self.tail = None  # the last task issued on the stream
+        self.event = None  # recorded after the tail
+        # lane -> the index of the last task of the lane waited for
+        self.waited = {}
+
+
+def _resolve(obj, deps):
+    # Replaces the tasks in an argument with their results.
+    if isinstance(obj, Task):
+        deps.append(obj)
+        return obj.result
+    if type(obj) in (list, tuple):
+        return type(obj)([_resolve(x, deps) for x in obj])
+    return obj
+
+
+class TaskGraph:
+
+    """Runs independent computations on a pool of prioritized streams.
+
+    The functions submitted in the ``with`` block are issued immediately on
+    one of the streams of their priority, without synchronizing the host.
+    A task that consumes the results of other tasks, or depends on them
+    explicitly, is issued after them: it reuses the stream of a dependency
+    when that dependency is the last work of its stream, and waits for
+    events of the other streams otherwise. Independent tasks are spread
+    over the streams in turn, so that their kernels overlap.
+
+    The streams start after the work issued on the current stream before
+    the ``with`` block, and the current stream waits for all of them at
+    its end. So the results are used on the current stream as usual, and
+    the block can be captured in a CUDA graph as a whole, e.g. in a
+    function decorated with :func:`cupyx.graph_function`, as its streams
+    join the capture.
+
+    The memory allocated by a task comes from the pool for its stream, so
+    that the temporary arrays of a task are reused in stream order. The
+    graph holds the arguments and results of the tasks until the end of
+    the block, so that they are not reused while other streams read them.
+
+    Args:
+        n_streams (int): The number of streams for each priority.
+
+    .. note::
+        The streams are created on the current device when the graph is
+        first used, and reused by the later blocks of the same graph. A
+        graph must be used by one thread at a time.
+
+    Example:
+        >>> with cupyx.TaskGraph() as g:
+        ...     a = g.submit(cupy.fft.fft, x)
+        ...     b = g.submit(cupy.sort, y, priority=-1)
+        ...     c = g.submit(lambda a, b: a[:b.size] * b, a, b)
+        >>> out = c.result
+
+    """
+
+    def __init__(self, n_streams=2):
+        if n_streams < 1:
+            raise ValueError('n_streams must be positive')
+        self._n_streams = n_streams
+        self._device_id = None
+        self._lanes = {}  # priority -> list of _Lane
+        self._next = {}  # priority -> the lane for the next independent task
+        self._tasks = None
+        self._origin = None
+        self._fork = None
+
+    def _get_lanes(self, priority):
+        lanes = self._lanes.get(priority)
+        if lanes is None:
+            lanes = self._lanes[priority] = [
+                _Lane(priority) for _ in range(self._n_streams)]
+            self._next[priority] = 0
+        return lanes
+
+    def _select_lane(self, deps, priority):
+        for dep in deps:
+            lane = dep._lane
+            if lane.priority == priority and lane.tail is dep:
+                return lane
+        lanes = self._get_lanes(priority)
+        i = self._next[priority]
+        self._next[priority] = (i + 1) % len(lanes)
+        return lanes[i]
+
+    def __enter__(self):
+        if self._tasks is not None:
+            raise RuntimeError('the task graph is already in use')
+        device_id = device.get_device_id()
+        if self._device_id is None:
+            self._device_id = device_id
+        elif self._device_id != device_id:
+            raise RuntimeError(
+                'the task graph is created on device {}, but the current '
+                'device is {}'.format(self._device_id, device_id))
+        self._tasks = []
+        self._origin = stream_module.get_current_stream()
+        self._fork = self._origin.record(stream_module.Event(
+            disable_timing=True))
+        return self
+
+    def __exit__(self, *args):
+        try:
+            for lanes in self._lanes.values():
+                for lane in lanes:
+                    if lane.event is not None:
+                        self._origin.wait_event(lane.event)
+                    lane.started = False
+                    lane.tail = lane.event = None
+                    lane.waited.clear()
+        finally:
+            self._tasks = None
+            self._origin = self._fork = None
+
+    def submit(self, func, *args, depends_on=(), priority=0, **kwargs):
+        """Issues a computation on a stream of the graph.
+
+        Args:
+            func (callable): The function, which issues its work on the
+                current stream.
+            args: The arguments of the function. The :class:`Task` given as
+                the arguments, or in their lists and tuples, are replaced by
+                their results.
+            depends_on (list of Task): The tasks that must complete before
+                the function, besides those in the arguments.
+            priority (int): The priority of the stream, where a lower value
+                is a higher priority as in :class:`cupy.cuda.Stream`.
+            kwargs: The keyword arguments of the function.
+
+        Returns:
+            Task: The task, which holds the result of the function.
+        """
+        if self._tasks is None:
+            raise RuntimeError(
+                'tasks must be submitted in the with block of the graph')
+        deps = list(depends_on)
+        args = _resolve(args, deps)
+        kwargs = {k: _resolve(v, deps) for k, v in kwargs.items()}
+        for dep in deps:
+            i = dep._index
+            if i >= len(self._tasks) or self._tasks[i] is not dep:
+                raise ValueError('{} is not a task of this block'.format(dep))
+        lane = self._select_lane(deps, priority)
+        if not lane.started:
+            # the first task of the lane in this block
+            lane.stream.wait_event(self._fork)
+            lane.started = True
+        for dep in deps:
+            other = dep._lane
+            if other is lane or lane.waited.get(other, -1) >= dep._index:
+                continue
+            lane.stream.wait_event(other.event)
+            # the event is recorded after the tail of the other lane
+            lane.waited[other] = other.tail._index
+        with lane.stream:
+            result = func(*args, **kwargs)
+        task = Task(lane, len(self._tasks), result)
+        self._tasks.append(task)
+        lane.tail = task
+        if lane.event is None:
+            lane.event = stream_module.Event(disable_timing=True)
+        lane.event.record(lane.stream)
+        return task
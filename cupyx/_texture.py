@@ -1,3 +1,5 @@
+import weakref
+
 import cupy
 
 from cupy import _core
@@ -50,11 +52,39 @@ _affine_transform_3d_array_kernel = _core.ElementwiseKernel(
     ''')
 
 
+_map_coordinates_2d_array_kernel = _core.ElementwiseKernel(
+    'U texObj, raw C coords, uint64 n, float32 s0, float32 s1',
+    'T mapped_image',
+    '''
+    float y = ((float)coords[i] + .5f) * s0;
+    float x = ((float)coords[n + i] + .5f) * s1;
+    mapped_image = tex2D<T>(texObj, x, y);
+    ''',
+    'cupyx_texture_map_coordinates_2d_array')
+
+
+_map_coordinates_3d_array_kernel = _core.ElementwiseKernel(
+    'U texObj, raw C coords, uint64 n, float32 s0, float32 s1, float32 s2',
+    'T mapped_volume',
+    '''
+    float z = ((float)coords[i] + .5f) * s0;
+    float y = ((float)coords[n + i] + .5f) * s1;
+    float x = ((float)coords[2 * n + i] + .5f) * s2;
+    mapped_volume = tex3D<T>(texObj, x, y, z);
+    ''',
+    'cupyx_texture_map_coordinates_3d_array')
+
+
+# The address modes that are only supported with normalized coordinates
+_normalized_modes = ('grid-wrap', 'reflect', 'grid-mirror')
+
+
 def _create_texture_object(data,
                            address_mode: str,
                            filter_mode: str,
                            read_mode: str,
-                           border_color=0):
+                           border_color=0,
+                           normalized=False):
 
     if cupy.issubdtype(data.dtype, cupy.unsignedinteger):
         fmt_kind = runtime.cudaChannelFormatKindUnsigned
@@ -67,12 +97,17 @@ def _create_texture_object(data,
 
     if address_mode == 'nearest':
         address_mode = runtime.cudaAddressModeClamp
-    elif address_mode == 'constant':
+    elif address_mode in ('constant', 'grid-constant'):
         address_mode = runtime.cudaAddressModeBorder
+    elif address_mode == 'grid-wrap' and normalized:
+        address_mode = runtime.cudaAddressModeWrap
+    elif address_mode in ('reflect', 'grid-mirror') and normalized:
+        address_mode = runtime.cudaAddressModeMirror
     else:
         raise ValueError(
             f'Unsupported address mode {address_mode} '
-            '(supported: constant, nearest)')
+            '(supported: constant, grid-constant, nearest, reflect, '
+            'grid-mirror, grid-wrap)')
 
     if filter_mode == 'nearest':
         filter_mode = runtime.cudaFilterModePoint
@@ -102,13 +137,145 @@ def _create_texture_object(data,
     # TODO(the-lay): border color/value can be defined for up to 4 channels
     tex_desc = texture.TextureDescriptor(
         (address_mode, ) * data.ndim, filter_mode, read_mode,
-        borderColors=(border_color, ))
+        borderColors=(border_color, ),
+        normalizedCoords=1 if normalized else 0)
     tex_obj = texture.TextureObject(res_desc, tex_desc)
     array.copy_from(data)
 
     return tex_obj
 
 
+# id of an input array -> (weak reference to the array, the parameters of the
+# texture, the texture object)
+_texture_cache = {}
+
+
+def _get_texture_object(data, address_mode, filter_mode, border_color):
+    """Returns the texture object of an array, reusing the cached one.
+
+    The CUDA array and the texture object are created once for each input
+    array and set of parameters. The values of the array are copied to the
+    CUDA array at each call, so that the in-place updates of the array are
+    seen.
+    """
+    normalized = address_mode in _normalized_modes
+    key = (data.shape, data.dtype, data.device.id, address_mode, filter_mode,
+           border_color)
+    data_id = id(data)
+    entry = _texture_cache.get(data_id)
+    if entry is not None and entry[0]() is data and entry[1] == key:
+        tex_obj = entry[2]
+        tex_obj.ResDesc.cuArr.copy_from(data)
+        return tex_obj, normalized
+    tex_obj = _create_texture_object(data,
+                                     address_mode=address_mode,
+                                     filter_mode=filter_mode,
+                                     read_mode='element_type',
+                                     border_color=border_color,
+                                     normalized=normalized)
+
+    def remove(ref):
+        entry = _texture_cache.get(data_id)
+        if entry is not None and entry[0] is ref:
+            del _texture_cache[data_id]
+
+    _texture_cache[data_id] = (weakref.ref(data, remove), key, tex_obj)
+    return tex_obj, normalized
+
+
+def _check_texture_input(data, name):
+    ndim = data.ndim
+    if (ndim < 2) or (ndim > 3):
+        raise ValueError(
+            f'Texture memory {name} is defined only for '
+            '2D and 3D arrays without channel dimension.')
+
+    dtype = data.dtype
+    if dtype != cupy.float32:
+        raise ValueError(f'Texture memory {name} is available '
+                         f'only for float32 data type (not {dtype})')
+
+
+def _get_texture_output(output, output_shape, name):
+    if output is None:
+        output = cupy.zeros(output_shape, dtype=cupy.float32)
+    elif isinstance(output, (type, cupy.dtype)):
+        if output != cupy.float32:
+            raise ValueError(f'Texture memory {name} is '
+                             f'available only for float32 data type (not '
+                             f'{output})')
+        output = cupy.zeros(output_shape, dtype=output)
+    elif isinstance(output, cupy.ndarray):
+        if output.shape != output_shape:
+            raise ValueError('Output shapes do not match')
+    else:
+        raise ValueError('Output must be None, cupy.ndarray or cupy.dtype')
+    return output
+
+
+def map_coordinates(data,
+                    coordinates,
+                    output=None,
+                    interpolation: str = 'linear',
+                    mode: str = 'constant',
+                    border_value=0):
+    """
+    Map the input array to new coordinates by interpolation.
+
+    The method uses texture memory and supports only 2D and 3D float32 arrays
+    without channel dimension.
+
+    Args:
+        data (cupy.ndarray): The input array.
+        coordinates (cupy.ndarray): The coordinates at which ``data`` is
+            evaluated, with shape ``(ndim, ...)``.
+        output (cupy.ndarray or ~cupy.dtype): The array in which to place the
+            output, or the dtype of the returned array. Default is None.
+        interpolation (str): Specifies interpolation mode: ``'linear'`` or
+            ``'nearest'``. Default is ``'linear'``.
+        mode (str): Specifies addressing mode for points outside of the array:
+            (``'constant'``, ``'grid-constant'``, ``'nearest'``,
+            ``'reflect'``, ``'grid-mirror'``, ``'grid-wrap'``). Default is
+            ``'constant'``.
+        border_value: Specifies value to be used for coordinates outside
+            of the array for ``'constant'`` mode. Default is 0.
+
+    Returns:
+        cupy.ndarray:
+            The mapped input, with the shape of ``coordinates`` without its
+            first axis.
+
+    .. seealso:: :func:`cupyx.scipy.ndimage.map_coordinates`
+    """
+    _check_texture_input(data, 'map_coordinates')
+    ndim = data.ndim
+    if interpolation not in ['linear', 'nearest']:
+        raise ValueError(
+            f'Unsupported interpolation {interpolation} '
+            f'(supported: linear, nearest)')
+    coordinates = cupy.asarray(coordinates)
+    if coordinates.shape[0] != ndim:
+        raise ValueError('invalid shape for coordinate array')
+    if coordinates.dtype not in (cupy.float32, cupy.float64):
+        coordinates = coordinates.astype(cupy.float32)
+    coordinates = cupy.ascontiguousarray(coordinates)
+
+    texture_object, normalized = _get_texture_object(
+        data, mode, interpolation, border_value)
+    if normalized:
+        scales = [1.0 / s for s in data.shape]
+    else:
+        scales = [1.0] * ndim
+    output = _get_texture_output(
+        output, coordinates.shape[1:], 'map_coordinates')
+    if ndim == 2:
+        kernel = _map_coordinates_2d_array_kernel
+    else:
+        kernel = _map_coordinates_3d_array_kernel
+    kernel(texture_object, coordinates, output.size, *scales, output)
+    return output
+
+
 def affine_transformation(data,
                           transformation_matrix,
                           output_shape=None,
@@ -135,7 +302,9 @@ def affine_transformation(data,
         interpolation (str): Specifies interpolation mode: ``'linear'`` or
             ``'nearest'``. Default is ``'linear'``.
         mode (str): Specifies addressing mode for points outside of the array:
-            (`'constant'``, ``'nearest'``). Default is ``'constant'``.
+            (``'constant'``, ``'grid-constant'``, ``'nearest'``,
+            ``'reflect'``, ``'grid-mirror'``, ``'grid-wrap'``). Default is
+            ``'constant'``.
         border_value: Specifies value to be used for coordinates outside
             of the array for ``'constant'`` mode. Default is 0.
 
@@ -146,16 +315,8 @@ def affine_transformation(data,
     .. seealso:: :func:`cupyx.scipy.ndimage.affine_transform`
     """
 
+    _check_texture_input(data, 'affine transformation')
     ndim = data.ndim
-    if (ndim < 2) or (ndim > 3):
-        raise ValueError(
-            'Texture memory affine transformation is defined only for '
-            '2D and 3D arrays without channel dimension.')
-
-    dtype = data.dtype
-    if dtype != cupy.float32:
-        raise ValueError(f'Texture memory affine transformation is available '
-                         f'only for float32 data type (not {dtype})')
 
     if interpolation not in ['linear', 'nearest']:
         raise ValueError(
@@ -165,11 +326,17 @@ def affine_transformation(data,
     if transformation_matrix.shape != (ndim + 1, ndim + 1):
         raise ValueError('Matrix must be have shape (ndim + 1, ndim + 1)')
 
-    texture_object = _create_texture_object(data,
-                                            address_mode=mode,
-                                            filter_mode=interpolation,
-                                            read_mode='element_type',
-                                            border_color=border_value)
+    texture_object, normalized = _get_texture_object(
+        data, mode, interpolation, border_value)
+    if normalized:
+        # the kernels add 0.5 to the coordinates of the rows of the matrix,
+        # which are then scaled by the size of each axis
+        transformation_matrix = cupy.array(
+            transformation_matrix, dtype=cupy.float32)
+        scales = cupy.asarray(
+            [1.0 / s for s in data.shape] + [1.0], dtype=cupy.float32)
+        transformation_matrix *= scales[:, None]
+        transformation_matrix[:-1, -1] += 0.5 * scales[:-1] - 0.5
 
     if ndim == 2:
         kernel = _affine_transform_2d_array_kernel
@@ -178,20 +345,8 @@ def affine_transformation(data,
 
     if output_shape is None:
         output_shape = data.shape
-
-    if output is None:
-        output = cupy.zeros(output_shape, dtype=dtype)
-    elif isinstance(output, (type, cupy.dtype)):
-        if output != cupy.float32:
-            raise ValueError(f'Texture memory affine transformation is '
-                             f'available only for float32 data type (not '
-                             f'{output})')
-        output = cupy.zeros(output_shape, dtype=output)
-    elif isinstance(output, cupy.ndarray):
-        if output.shape != output_shape:
-            raise ValueError('Output shapes do not match')
-    else:
-        raise ValueError('Output must be None, cupy.ndarray or cupy.dtype')
+    output = _get_texture_output(
+        output, tuple(output_shape), 'affine transformation')
 
     kernel(texture_object, transformation_matrix, *output_shape[1:], output)
     return output
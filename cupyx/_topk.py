@@ -0,0 +1,64 @@
+import numpy
+
+import cupy
+from cupy._core import internal
+
+
+# dtypes for which the radix select kernel is available
+_radix_select_dtypes = 'bhilqBHILQfd'
+
+
+def topk(a, k, axis=-1, largest=True):
+    """Returns the ``k`` largest (or smallest) elements along an axis.
+
+    Unlike :func:`cupy.partition`, only the selected elements are returned,
+    and they are sorted. Integer and floating point arrays are processed with
+    a radix select, so that only the selected elements get sorted. NaNs are
+    treated as larger than any other value, as in :func:`cupy.sort`.
+
+    Args:
+        a (cupy.ndarray): Array to select from.
+        k (int): Number of elements to select.
+        axis (int): Axis along which to select. Default is -1, which means
+            the last axis.
+        largest (bool): If ``True`` (default), the largest elements are
+            returned in descending order. Otherwise the smallest elements are
+            returned in ascending order.
+
+    Returns:
+        tuple of cupy.ndarray: The selected elements and their indices along
+        ``axis``. Both have the shape of ``a`` except that the size of
+        ``axis`` is ``k``. Ties are ordered by their indices.
+
+    .. seealso:: :func:`cupy.partition`, :func:`cupy.argpartition`
+
+    """
+    a = cupy.asarray(a)
+    if a.ndim == 0:
+        raise ValueError('topk does not support 0-dim arrays')
+    axis = internal._normalize_axis_index(axis, a.ndim)
+    length = a.shape[axis]
+    if not 0 <= k <= length:
+        raise ValueError('k(={}) out of bounds {}'.format(k, length))
+
+    data = cupy.ascontiguousarray(cupy.moveaxis(a, axis, -1))
+    out_shape = data.shape[:-1] + (k,)
+    n_rows = data.size // length if length else 0
+
+    if (data.dtype.char in _radix_select_dtypes
+            and n_rows * max(k, length) <= 0x7fffffff):
+        values = cupy.empty(out_shape, dtype=a.dtype)
+        indices = cupy.empty(out_shape, dtype=numpy.intp)
+        if values.size > 0:
+            from cupy.cuda import thrust
+            thrust.topk(a.dtype, data.data.ptr, values.data.ptr,
+                        indices.data.ptr, n_rows, length, k, largest, False)
+    else:
+        indices = cupy.argsort(data, axis=-1)
+        if largest:
+            indices = indices[..., ::-1]
+        indices = cupy.ascontiguousarray(indices[..., :k])
+        values = cupy.take_along_axis(data, indices, axis=-1)
+
+    return (cupy.moveaxis(values, -1, axis),
+            cupy.moveaxis(indices, -1, axis))
@@ -2,12 +2,15 @@ from libcpp cimport vector
 from libc.stdint cimport int64_t
 
 import atexit as _atexit
+import collections as _collections
+import json as _json
 import threading as _threading
 import warnings as _warnings
 
 import numpy as _numpy
 
 from cupy import _core
+from cupy._core import _tuning
 from cupy._core._carray cimport shape_t
 from cupy._core cimport _routines_manipulation as _manipulation
 from cupy._core cimport core
@@ -326,6 +329,77 @@ def create_convolution_descriptor(pad, stride, dtype,
     return desc
 
 
+# The descriptors of the convolutions are kept in a per-thread LRU cache, as
+# networks call the same few convolutions again and again.
+cdef Py_ssize_t _max_descriptor_cache_size = 64
+
+
+cdef object _get_descriptor_cache():
+    if not hasattr(_thread_local, 'cudnn_descriptor_cache'):
+        _thread_local.cudnn_descriptor_cache = _collections.OrderedDict()
+    return _thread_local.cudnn_descriptor_cache
+
+
+cdef Descriptor _lookup_descriptor(tuple key):
+    cache = _get_descriptor_cache()
+    desc = cache.get(key)
+    if desc is not None:
+        cache.move_to_end(key)
+    return desc
+
+
+cdef _add_descriptor(tuple key, Descriptor desc):
+    # An evicted descriptor is destroyed once its last user releases it.
+    cache = _get_descriptor_cache()
+    cache[key] = desc
+    if len(cache) > _max_descriptor_cache_size:
+        cache.popitem(last=False)
+
+
+cdef Descriptor _get_tensor_descriptor(_ndarray_base arr, int format):
+    if not arr._c_contiguous:
+        raise ValueError('cupyx.cudnn supports c-contiguous arrays only')
+    key = ('tensor', arr.dtype.char, arr.shape, format)
+    desc = _lookup_descriptor(key)
+    if desc is None:
+        desc = Descriptor(cudnn.createTensorDescriptor(),
+                          _py_cudnn.destroyTensorDescriptor)
+        _create_tensor_descriptor(desc.value, arr, format)
+        _add_descriptor(key, desc)
+    return desc
+
+
+cdef Descriptor _get_filter_descriptor(_ndarray_base arr, int format):
+    key = ('filter', arr.dtype.char, arr.shape, format)
+    desc = _lookup_descriptor(key)
+    if desc is None:
+        desc = Descriptor(cudnn.createFilterDescriptor(),
+                          _py_cudnn.destroyFilterDescriptor)
+        _create_filter_descriptor(desc.value, arr, format)
+        _add_descriptor(key, desc)
+    return desc
+
+
+cdef Descriptor _get_convolution_descriptor(
+        tuple pad, tuple stride, tuple dilation, int groups, object dtype,
+        bint use_tensor_core):
+    key = ('conv', pad, stride, dilation, groups, dtype.char, use_tensor_core)
+    desc = _lookup_descriptor(key)
+    if desc is None:
+        desc = Descriptor(cudnn.createConvolutionDescriptor(),
+                          _py_cudnn.destroyConvolutionDescriptor)
+        _create_convolution_descriptor(
+            desc.value, pad, stride, dilation, groups, dtype,
+            cudnn.CUDNN_CROSS_CORRELATION, use_tensor_core)
+        _add_descriptor(key, desc)
+    elif cudnn_version() >= 7000:
+        # the math type is set to the one of the algorithm before each call
+        cudnn.setConvolutionMathType(
+            desc.value, cudnn.CUDNN_TENSOR_OP_MATH if use_tensor_core
+            else cudnn.CUDNN_DEFAULT_MATH)
+    return desc
+
+
 cdef _create_pooling_descriptor(
         size_t desc, tuple ksize, tuple stride, tuple pad, int mode):
     cdef vector.vector[int] c_ksize, c_pad, c_stride
@@ -1345,6 +1419,73 @@ cdef dict _algorithm_fwd_cache = {}
 cdef dict _algorithm_bwd_filter_cache = {}
 cdef dict _algorithm_bwd_data_cache = {}
 
+# The algorithms found by cudnnFind* are also saved to the tuning database of
+# the GPU model (see cupy._core._tuning), so that later processes do not run
+# the search again. The heuristics are cheap and are not saved.
+cdef tuple _algorithm_kinds = (
+    'cudnn_conv_fwd', 'cudnn_conv_bwd_filter', 'cudnn_conv_bwd_data')
+
+
+cdef str _get_algorithm_db_key(tuple key):
+    # the device is dropped, as the database is per GPU model
+    return 'v{}:{!r}'.format(cudnn_version(), key[1:])
+
+
+cdef _Algorithm _lookup_saved_algorithm(str kind, tuple key):
+    value = _tuning.lookup(key[0], kind, _get_algorithm_db_key(key))
+    if value is None:
+        return None
+    algo, memory, math_type = value
+    return _Algorithm(algo, memory, math_type)
+
+
+cdef _save_algorithm(str kind, tuple key, _Algorithm algo):
+    _tuning.record(key[0], kind, _get_algorithm_db_key(key),
+                   [algo.algo, algo.memory, algo.mathType])
+
+
+def save_algorithm_cache(path, device_id=None):
+    """Saves the convolution algorithms found by cuDNN to a file.
+
+    The algorithms found with ``auto_tune=True`` on GPUs of the model of the
+    device are written, so that :func:`load_algorithm_cache` can install them
+    on other nodes before deployment. The algorithms of other versions of
+    cuDNN are kept, but not used by them.
+
+    Args:
+        path (str): The file to write.
+        device_id (int): The device. The current device is used by default.
+
+    """
+    if device_id is None:
+        device_id = device.get_device_id()
+    entries = _tuning._get_db(device_id).get_entries(_algorithm_kinds)
+    with open(path, 'w') as f:
+        _json.dump(entries, f, indent=1, sort_keys=True)
+
+
+def load_algorithm_cache(path, device_id=None):
+    """Adds the convolution algorithms saved to a file to the cache.
+
+    The algorithms are added to the tuning database of the GPU model of the
+    device in :envvar:`CUPY_TUNING_DIR`, and are used by the convolutions
+    with ``auto_tune=True`` instead of running ``cudnnFind*``.
+
+    Args:
+        path (str): The file written by :func:`save_algorithm_cache`.
+        device_id (int): The device. The current device is used by default.
+
+    """
+    if device_id is None:
+        device_id = device.get_device_id()
+    with open(path) as f:
+        entries = _json.load(f)
+    if not isinstance(entries, dict) or any(
+            kind not in _algorithm_kinds or not isinstance(values, dict)
+            for kind, values in entries.items()):
+        raise ValueError('{} is not a cuDNN algorithm cache'.format(path))
+    _tuning._get_db(device_id).merge(entries)
+
 
 cpdef _warn_algorithm_fwd(
         _ndarray_base x, _ndarray_base W, _ndarray_base y, tuple conv_param):
@@ -1367,6 +1508,10 @@ cpdef _Algorithm _find_algorithm_fwd(
     algo = _algorithm_fwd_cache.get(key, None)
     if algo is not None:
         return algo
+    algo = _lookup_saved_algorithm('cudnn_conv_fwd', key)
+    if algo is not None:
+        _algorithm_fwd_cache[key] = algo
+        return algo
     workspace = _memory.alloc(max_workspace_size)
     if cudnn_version() >= 7000:
         perf = cudnn.findConvolutionForwardAlgorithmEx_v7(
@@ -1382,6 +1527,7 @@ cpdef _Algorithm _find_algorithm_fwd(
         raise RuntimeError('No available algorithm found.')
     algo = _Algorithm(perf.algo, perf.memory, perf.mathType)
     _algorithm_fwd_cache[key] = algo
+    _save_algorithm('cudnn_conv_fwd', key, algo)
     return algo
 
 
@@ -1455,6 +1601,10 @@ cpdef _Algorithm _find_algorithm_bwd_filter(
     algo = _algorithm_bwd_filter_cache.get(key, None)
     if algo is not None:
         return algo
+    algo = _lookup_saved_algorithm('cudnn_conv_bwd_filter', key)
+    if algo is not None:
+        _algorithm_bwd_filter_cache[key] = algo
+        return algo
     workspace = _memory.alloc(max_workspace_size)
     if cudnn_version() >= 7000:
         if deterministic:
@@ -1484,6 +1634,7 @@ cpdef _Algorithm _find_algorithm_bwd_filter(
         raise RuntimeError('No available algorithm found.')
     algo = _Algorithm(perf.algo, perf.memory, perf.mathType)
     _algorithm_bwd_filter_cache[key] = algo
+    _save_algorithm('cudnn_conv_bwd_filter', key, algo)
     return algo
 
 
@@ -1560,6 +1711,10 @@ cpdef _Algorithm _find_algorithm_bwd_data(
     algo = _algorithm_bwd_data_cache.get(key, None)
     if algo is not None:
         return algo
+    algo = _lookup_saved_algorithm('cudnn_conv_bwd_data', key)
+    if algo is not None:
+        _algorithm_bwd_data_cache[key] = algo
+        return algo
     workspace = _memory.alloc(max_workspace_size)
     if cudnn_version() >= 7000:
         if deterministic:
@@ -1587,6 +1742,7 @@ cpdef _Algorithm _find_algorithm_bwd_data(
         raise RuntimeError('No available algorithm found.')
     algo = _Algorithm(perf.algo, perf.memory, perf.mathType)
     _algorithm_bwd_data_cache[key] = algo
+    _save_algorithm('cudnn_conv_bwd_data', key, algo)
     return algo
 
 
@@ -1682,7 +1838,9 @@ def convolution_forward(
         one = <size_t>&float_one
 
     cdef bint use_tensor_core = _should_use_tensor_core(tensor_core, x.dtype)
-    cdef tuple conv_param = (pad, stride, x.dtype, use_tensor_core)
+    cdef tuple conv_param = (
+        pad, stride, dilation, groups, x.dtype, use_tensor_core, d_layout,
+        w_layout)
 
     # cuDNN 7 supports dilation only in *_FWD_ALGO_IMPLICIT_GEMM, but
     # it supports Tensor Cores only in *_FWD_ALGO_IMPLICIT_PRECOMP_GEMM.
@@ -1696,76 +1854,64 @@ def convolution_forward(
     x = core._internal_ascontiguousarray(x)
     W = core._internal_ascontiguousarray(W)
 
-    # TODO(okuta) check performance
-    cdef size_t x_desc = cudnn.createTensorDescriptor()
-    cdef size_t y_desc = cudnn.createTensorDescriptor()
-    cdef size_t b_desc = cudnn.createTensorDescriptor()
-    cdef size_t filter_desc = cudnn.createFilterDescriptor()
-    cdef size_t conv_desc = cudnn.createConvolutionDescriptor()
+    cdef Descriptor x_desc = _get_tensor_descriptor(x, d_layout)
+    cdef Descriptor y_desc = _get_tensor_descriptor(y, d_layout)
+    cdef Descriptor filter_desc = _get_filter_descriptor(W, w_layout)
+    cdef Descriptor conv_desc = _get_convolution_descriptor(
+        pad, stride, dilation, groups, x.dtype, use_tensor_core)
+    cdef Descriptor b_desc
 
     cdef size_t max_workspace_size = get_max_workspace_size()
     cdef shape_t b_shape
     cdef _Algorithm perf
-    try:
-        _create_tensor_descriptor(x_desc, x, format=d_layout)
-        _create_tensor_descriptor(y_desc, y, format=d_layout)
-        _create_filter_descriptor(filter_desc, W, w_layout)
-        _create_convolution_descriptor(
-            conv_desc, pad, stride, dilation, groups, x.dtype,
-            cudnn.CUDNN_CROSS_CORRELATION, use_tensor_core)
-
-        if auto_tune:
-            perf = _find_algorithm_fwd(
-                x, W, y, conv_param, handle, x_desc, filter_desc,
-                conv_desc, y_desc, max_workspace_size, use_tensor_core)
-        else:
-            perf = _get_algorithm_fwd(
-                x, W, y, conv_param, handle, x_desc, filter_desc,
-                conv_desc, y_desc, max_workspace_size, use_tensor_core)
+    if auto_tune:
+        perf = _find_algorithm_fwd(
+            x, W, y, conv_param, handle, x_desc.value, filter_desc.value,
+            conv_desc.value, y_desc.value, max_workspace_size,
+            use_tensor_core)
+    else:
+        perf = _get_algorithm_fwd(
+            x, W, y, conv_param, handle, x_desc.value, filter_desc.value,
+            conv_desc.value, y_desc.value, max_workspace_size,
+            use_tensor_core)
 
-        if cudnn_version() >= 7000:
-            cudnn.setConvolutionMathType(conv_desc, perf.mathType)
+    if cudnn_version() >= 7000:
+        cudnn.setConvolutionMathType(conv_desc.value, perf.mathType)
 
-        workspace = _memory.alloc(perf.memory)
+    workspace = _memory.alloc(perf.memory)
 
-        try:
-            cudnn.convolutionForward(
-                handle, one, x_desc, x.data.ptr, filter_desc, W.data.ptr,
-                conv_desc, perf.algo, workspace.ptr, perf.memory, zero, y_desc,
-                y.data.ptr)
-        except _py_cudnn.CuDNNError as e:
-            infos = [
-                'func: cudnnConvolutionForward',
-                'x: {}'.format(_get_array_info(x)),
-                'W: {}'.format(_get_array_info(W)),
-                'b: {}'.format(_get_array_info(b)),
-                'y: {}'.format(_get_array_info(y)),
-                'pad={!r}, stride={!r}, dilation={!r}, groups={!r}'.format(
-                    pad, stride, dilation, groups),
-                'auto_tune={!r}, tensor_core={!r}'.format(
-                    auto_tune, tensor_core),
-                'd_layout={!r}, w_layout={!r}'.format(d_layout, w_layout),
-            ]
-            e.add_infos(infos)
-            raise
-
-        del workspace, x, W
-
-        if b is not None:
-            assert dev_id == b.data.device.id
-            b_shape.assign(y._shape.size(), 1)
-            b_shape[1] = -1
-            b = _manipulation._reshape(
-                core._internal_ascontiguousarray(b), b_shape)
-            _create_tensor_nd_descriptor(b_desc, b, -1)
-            cudnn.addTensor_v3(handle, one, b_desc,
-                               b.data.ptr, one, y_desc, y.data.ptr)
-    finally:
-        cudnn.destroyTensorDescriptor(x_desc)
-        cudnn.destroyTensorDescriptor(y_desc)
-        cudnn.destroyTensorDescriptor(b_desc)
-        cudnn.destroyFilterDescriptor(filter_desc)
-        cudnn.destroyConvolutionDescriptor(conv_desc)
+    try:
+        cudnn.convolutionForward(
+            handle, one, x_desc.value, x.data.ptr, filter_desc.value,
+            W.data.ptr, conv_desc.value, perf.algo, workspace.ptr,
+            perf.memory, zero, y_desc.value, y.data.ptr)
+    except _py_cudnn.CuDNNError as e:
+        infos = [
+            'func: cudnnConvolutionForward',
+            'x: {}'.format(_get_array_info(x)),
+            'W: {}'.format(_get_array_info(W)),
+            'b: {}'.format(_get_array_info(b)),
+            'y: {}'.format(_get_array_info(y)),
+            'pad={!r}, stride={!r}, dilation={!r}, groups={!r}'.format(
+                pad, stride, dilation, groups),
+            'auto_tune={!r}, tensor_core={!r}'.format(
+                auto_tune, tensor_core),
+            'd_layout={!r}, w_layout={!r}'.format(d_layout, w_layout),
+        ]
+        e.add_infos(infos)
+        raise
+
+    del workspace, x, W
+
+    if b is not None:
+        assert dev_id == b.data.device.id
+        b_shape.assign(y._shape.size(), 1)
+        b_shape[1] = -1
+        b = _manipulation._reshape(
+            core._internal_ascontiguousarray(b), b_shape)
+        b_desc = create_tensor_nd_descriptor(b)
+        cudnn.addTensor_v3(handle, one, b_desc.value,
+                           b.data.ptr, one, y_desc.value, y.data.ptr)
 
 
 def convolution_backward_filter(
@@ -1793,69 +1939,58 @@ def convolution_backward_filter(
     cdef bint use_tensor_core = (
         not deterministic and _should_use_tensor_core(tensor_core, x.dtype))
     cdef tuple conv_param = (
-        pad, stride, x.dtype, use_tensor_core, deterministic)
+        pad, stride, dilation, groups, x.dtype, use_tensor_core,
+        deterministic, d_layout, w_layout)
 
     handle = get_handle()
     x = core._internal_ascontiguousarray(x)
     gy = core._internal_ascontiguousarray(gy)
 
-    # TODO(okuta) check performance
-    cdef size_t x_desc = cudnn.createTensorDescriptor()
-    cdef size_t gy_desc = cudnn.createTensorDescriptor()
-    cdef size_t filter_desc = cudnn.createFilterDescriptor()
-    cdef size_t conv_desc = cudnn.createConvolutionDescriptor()
+    cdef Descriptor x_desc = _get_tensor_descriptor(x, d_layout)
+    cdef Descriptor gy_desc = _get_tensor_descriptor(gy, d_layout)
+    cdef Descriptor filter_desc = _get_filter_descriptor(gW, w_layout)
+    cdef Descriptor conv_desc = _get_convolution_descriptor(
+        pad, stride, dilation, groups, x.dtype, use_tensor_core)
 
     cdef _Algorithm perf
     cdef int algo
     cdef size_t max_workspace_size = get_max_workspace_size()
     cdef size_t workspace_size = 0
-    try:
-        _create_tensor_descriptor(x_desc, x, format=d_layout)
-        _create_tensor_descriptor(gy_desc, gy, format=d_layout)
-        _create_filter_descriptor(filter_desc, gW, w_layout)
-        _create_convolution_descriptor(
-            conv_desc, pad, stride, dilation, groups, x.dtype,
-            cudnn.CUDNN_CROSS_CORRELATION, use_tensor_core)
-
-        if deterministic and cudnn_version() < 7000:
-            # TODO(imanishi): Support Tensor Core in deterministic mode.
-            algo = cudnn.CUDNN_CONVOLUTION_BWD_FILTER_ALGO_1
-            workspace_size = cudnn.getConvolutionBackwardFilterWorkspaceSize(
-                handle, x_desc, gy_desc, conv_desc, filter_desc, algo)
-            math_type = cudnn.CUDNN_DEFAULT_MATH
-            if workspace_size > max_workspace_size:
-                raise RuntimeError(
-                    'No conv bwd filter algo available with workspace size '
-                    'less equal {}'.format(max_workspace_size))
+    if deterministic and cudnn_version() < 7000:
+        # TODO(imanishi): Support Tensor Core in deterministic mode.
+        algo = cudnn.CUDNN_CONVOLUTION_BWD_FILTER_ALGO_1
+        workspace_size = cudnn.getConvolutionBackwardFilterWorkspaceSize(
+            handle, x_desc.value, gy_desc.value, conv_desc.value,
+            filter_desc.value, algo)
+        math_type = cudnn.CUDNN_DEFAULT_MATH
+        if workspace_size > max_workspace_size:
+            raise RuntimeError(
+                'No conv bwd filter algo available with workspace size '
+                'less equal {}'.format(max_workspace_size))
+    else:
+        if auto_tune and not deterministic:
+            perf = _find_algorithm_bwd_filter(
+                x, gy, gW, conv_param, handle, x_desc.value, gy_desc.value,
+                conv_desc.value, filter_desc.value, max_workspace_size,
+                use_tensor_core, deterministic)
         else:
-            if auto_tune and not deterministic:
-                perf = _find_algorithm_bwd_filter(
-                    x, gy, gW, conv_param, handle, x_desc, gy_desc, conv_desc,
-                    filter_desc, max_workspace_size, use_tensor_core,
-                    deterministic)
-            else:
-                perf = _get_algorithm_bwd_filter(
-                    x, gy, gW, conv_param, handle, x_desc, gy_desc, conv_desc,
-                    filter_desc, max_workspace_size, use_tensor_core,
-                    deterministic)
-            algo = perf.algo
-            workspace_size = perf.memory
-            math_type = perf.mathType
-
-        if cudnn_version() >= 7000:
-            cudnn.setConvolutionMathType(conv_desc, math_type)
-
-        workspace = _memory.alloc(workspace_size)
-
-        cudnn.convolutionBackwardFilter_v3(
-            handle, one, x_desc, x.data.ptr, gy_desc,
-            gy.data.ptr, conv_desc, algo, workspace.ptr,
-            workspace_size, zero, filter_desc, gW.data.ptr)
-    finally:
-        cudnn.destroyTensorDescriptor(x_desc)
-        cudnn.destroyTensorDescriptor(gy_desc)
-        cudnn.destroyFilterDescriptor(filter_desc)
-        cudnn.destroyConvolutionDescriptor(conv_desc)
+            perf = _get_algorithm_bwd_filter(
+                x, gy, gW, conv_param, handle, x_desc.value, gy_desc.value,
+                conv_desc.value, filter_desc.value, max_workspace_size,
+                use_tensor_core, deterministic)
+        algo = perf.algo
+        workspace_size = perf.memory
+        math_type = perf.mathType
+
+    if cudnn_version() >= 7000:
+        cudnn.setConvolutionMathType(conv_desc.value, math_type)
+
+    workspace = _memory.alloc(workspace_size)
+
+    cudnn.convolutionBackwardFilter_v3(
+        handle, one, x_desc.value, x.data.ptr, gy_desc.value,
+        gy.data.ptr, conv_desc.value, algo, workspace.ptr,
+        workspace_size, zero, filter_desc.value, gW.data.ptr)
 
 
 def convolution_backward_data(
@@ -1883,7 +2018,8 @@ def convolution_backward_data(
     cdef bint use_tensor_core = (
         not deterministic and _should_use_tensor_core(tensor_core, x.dtype))
     cdef tuple conv_param = (
-        pad, stride, x.dtype, use_tensor_core, deterministic)
+        pad, stride, dilation, groups, x.dtype, use_tensor_core,
+        deterministic, d_layout, w_layout)
 
     # cuDNN 7 supports dilation only in *_FWD_ALGO_IMPLICIT_GEMM, but
     # it supports Tensor Cores only in *_FWD_ALGO_IMPLICIT_PRECOMP_GEMM.
@@ -1897,78 +2033,65 @@ def convolution_backward_data(
     x = core._internal_ascontiguousarray(x)
     W = core._internal_ascontiguousarray(W)
 
-    # TODO(okuta) check performance
-    cdef size_t x_desc = cudnn.createTensorDescriptor()
-    cdef size_t y_desc = cudnn.createTensorDescriptor()
-    cdef size_t b_desc = cudnn.createTensorDescriptor()
-    cdef size_t filter_desc = cudnn.createFilterDescriptor()
-    cdef size_t conv_desc = cudnn.createConvolutionDescriptor()
+    cdef Descriptor x_desc = _get_tensor_descriptor(x, d_layout)
+    cdef Descriptor y_desc = _get_tensor_descriptor(y, d_layout)
+    cdef Descriptor filter_desc = _get_filter_descriptor(W, w_layout)
+    cdef Descriptor conv_desc = _get_convolution_descriptor(
+        pad, stride, dilation, groups, x.dtype, use_tensor_core)
+    cdef Descriptor b_desc
 
     cdef _Algorithm perf
     cdef int algo
     cdef size_t max_workspace_size = get_max_workspace_size()
     cdef size_t workspace_size = 0
     cdef shape_t b_shape
-    try:
-        _create_tensor_descriptor(x_desc, x, format=d_layout)
-        _create_tensor_descriptor(y_desc, y, format=d_layout)
-        _create_filter_descriptor(filter_desc, W, w_layout)
-        _create_convolution_descriptor(
-            conv_desc, pad, stride, dilation, groups, x.dtype,
-            cudnn.CUDNN_CROSS_CORRELATION, use_tensor_core)
-
-        if deterministic and cudnn_version() < 7000:
-            # TODO(imanishi): Support Tensor Core in deterministic mode.
-            algo = cudnn.CUDNN_CONVOLUTION_BWD_DATA_ALGO_1
-            workspace_size = cudnn.getConvolutionBackwardDataWorkspaceSize(
-                handle, filter_desc, x_desc, conv_desc, y_desc, algo)
-            math_type = cudnn.CUDNN_DEFAULT_MATH
-            if workspace_size > max_workspace_size:
-                raise RuntimeError(
-                    'No conv bwd data algo available with workspace size less '
-                    'equal {}'.format(max_workspace_size))
+    if deterministic and cudnn_version() < 7000:
+        # TODO(imanishi): Support Tensor Core in deterministic mode.
+        algo = cudnn.CUDNN_CONVOLUTION_BWD_DATA_ALGO_1
+        workspace_size = cudnn.getConvolutionBackwardDataWorkspaceSize(
+            handle, filter_desc.value, x_desc.value, conv_desc.value,
+            y_desc.value, algo)
+        math_type = cudnn.CUDNN_DEFAULT_MATH
+        if workspace_size > max_workspace_size:
+            raise RuntimeError(
+                'No conv bwd data algo available with workspace size less '
+                'equal {}'.format(max_workspace_size))
+    else:
+        if auto_tune and not deterministic:
+            perf = _find_algorithm_bwd_data(
+                W, x, y, conv_param, handle, filter_desc.value, x_desc.value,
+                conv_desc.value, y_desc.value, max_workspace_size,
+                use_tensor_core, deterministic)
         else:
-            if auto_tune and not deterministic:
-                perf = _find_algorithm_bwd_data(
-                    W, x, y, conv_param, handle, filter_desc, x_desc,
-                    conv_desc, y_desc, max_workspace_size, use_tensor_core,
-                    deterministic)
-            else:
-                perf = _get_algorithm_bwd_data(
-                    W, x, y, conv_param, handle, filter_desc, x_desc,
-                    conv_desc, y_desc, max_workspace_size, use_tensor_core,
-                    deterministic)
-            algo = perf.algo
-            workspace_size = perf.memory
-            math_type = perf.mathType
-
-        if cudnn_version() >= 7000:
-            cudnn.setConvolutionMathType(conv_desc, math_type)
-
-        workspace = _memory.alloc(workspace_size)
-
-        cudnn.convolutionBackwardData_v3(
-            handle, one, filter_desc, W.data.ptr, x_desc, x.data.ptr,
-            conv_desc, algo, workspace.ptr, workspace_size, zero, y_desc,
-            y.data.ptr)
-
-        del workspace, x, W
-
-        if b is not None:
-            assert dev_id == b.data.device.id
-            b_shape.assign(y._shape.size(), 1)
-            b_shape[1] = -1
-            b = _manipulation._reshape(
-                core._internal_ascontiguousarray(b), b_shape)
-            _create_tensor_nd_descriptor(b_desc, b, -1)
-            cudnn.addTensor_v3(handle, one, b_desc, b.data.ptr, one, y_desc,
-                               y.data.ptr)
-    finally:
-        cudnn.destroyTensorDescriptor(x_desc)
-        cudnn.destroyTensorDescriptor(y_desc)
-        cudnn.destroyTensorDescriptor(b_desc)
-        cudnn.destroyFilterDescriptor(filter_desc)
-        cudnn.destroyConvolutionDescriptor(conv_desc)
+            perf = _get_algorithm_bwd_data(
+                W, x, y, conv_param, handle, filter_desc.value, x_desc.value,
+                conv_desc.value, y_desc.value, max_workspace_size,
+                use_tensor_core, deterministic)
+        algo = perf.algo
+        workspace_size = perf.memory
+        math_type = perf.mathType
+
+    if cudnn_version() >= 7000:
+        cudnn.setConvolutionMathType(conv_desc.value, math_type)
+
+    workspace = _memory.alloc(workspace_size)
+
+    cudnn.convolutionBackwardData_v3(
+        handle, one, filter_desc.value, W.data.ptr, x_desc.value, x.data.ptr,
+        conv_desc.value, algo, workspace.ptr, workspace_size, zero,
+        y_desc.value, y.data.ptr)
+
+    del workspace, x, W
+
+    if b is not None:
+        assert dev_id == b.data.device.id
+        b_shape.assign(y._shape.size(), 1)
+        b_shape[1] = -1
+        b = _manipulation._reshape(
+            core._internal_ascontiguousarray(b), b_shape)
+        b_desc = create_tensor_nd_descriptor(b)
+        cudnn.addTensor_v3(handle, one, b_desc.value, b.data.ptr, one,
+                           y_desc.value, y.data.ptr)
 
 
 def pooling_forward(
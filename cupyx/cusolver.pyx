@@ -45,25 +45,36 @@ cdef extern from '../cupy_backends/cupy_lapack.h' nogil:
         intptr_t handle, char jobu, char jobvt, int m, int n, intptr_t A,
         intptr_t s_ptr, intptr_t u_ptr, intptr_t vt_ptr,
         intptr_t w_ptr, int buffersize, intptr_t info_ptr,
-        int batch_size)
+        int batch_size, intptr_t streams_ptr, int n_streams)
     int geqrf_loop[T](
         intptr_t handle, int m, int n, intptr_t a_ptr, int lda,
         intptr_t tau_ptr, intptr_t w_ptr,
         int buffersize, intptr_t info_ptr,
-        int batch_size)
+        int batch_size, intptr_t streams_ptr, int n_streams)
     int orgqr_loop[T](
         intptr_t handle, int m, int n, int k, intptr_t a_ptr, int lda,
         intptr_t tau_ptr, intptr_t w_ptr,
         int buffersize, intptr_t info_ptr,
-        int batch_size, int origin_n)
+        int batch_size, int origin_n, intptr_t streams_ptr, int n_streams)
+    int potrf_strided_batched[T](
+        intptr_t handle, int uplo, int n, intptr_t a_ptr, int lda,
+        long long stride, intptr_t info_ptr, int batch_size)
+    int getrf_strided_batched[T](
+        intptr_t handle, int n, intptr_t a_ptr, int lda, long long stride,
+        intptr_t ipiv_ptr, intptr_t info_ptr, int batch_size)
 
 ctypedef int(*gesvd_ptr)(intptr_t, char, char, int, int, intptr_t,
                          intptr_t, intptr_t, intptr_t,
-                         intptr_t, int, intptr_t, int) nogil
+                         intptr_t, int, intptr_t, int, intptr_t, int) nogil
 ctypedef int(*geqrf_ptr)(intptr_t, int, int, intptr_t, int, intptr_t,
-                         intptr_t, int, intptr_t, int) nogil
+                         intptr_t, int, intptr_t, int, intptr_t, int) nogil
 ctypedef int(*orgqr_ptr)(intptr_t, int, int, int, intptr_t, int, intptr_t,
-                         intptr_t, int, intptr_t, int, int) nogil
+                         intptr_t, int, intptr_t, int, int,
+                         intptr_t, int) nogil
+ctypedef int(*potrf_strided_ptr)(intptr_t, int, int, intptr_t, int,
+                                 long long, intptr_t, int) nogil
+ctypedef int(*getrf_strided_ptr)(intptr_t, int, intptr_t, int, long long,
+                                 intptr_t, intptr_t, int) nogil
 
 
 _available_cuda_version = {
@@ -121,6 +132,50 @@ def check_availability(name):
     return True
 
 
+# The loop-based batched solvers spread the matrices over this many streams,
+# as the per-matrix calls are too small to fill the device on their own.
+# Larger matrices are left on the current stream as they do not gain from it
+# but each stream needs its own workspace.
+_n_batch_streams = 4
+_max_batch_stream_matrix_size = 128 * 128
+
+
+@_util.memoize(for_each_device=True)
+def _get_batch_streams():
+    streams = [_cupy.cuda.Stream(non_blocking=True)
+               for _ in range(_n_batch_streams)]
+    ptrs = _numpy.array([s.ptr for s in streams], dtype=_numpy.intp)
+    return streams, ptrs
+
+
+cdef int _fork_batch_streams(
+        int batch_size, int m, int n, intptr_t* streams_ptr) except -1:
+    # Returns the number of streams to use (0 for the current stream only)
+    # and makes them wait for the work queued on the current stream.
+    cdef int n_streams
+    if batch_size < 2 or m * n > _max_batch_stream_matrix_size:
+        streams_ptr[0] = 0
+        return 0
+    streams, ptrs = _get_batch_streams()
+    n_streams = min(len(streams), batch_size)
+    event = _cupy.cuda.get_current_stream().record()
+    for stream in streams[:n_streams]:
+        stream.wait_event(event)
+    streams_ptr[0] = ptrs.ctypes.data
+    return n_streams
+
+
+cdef _join_batch_streams(int n_streams):
+    # Makes the current stream wait for the forked streams, so that the
+    # results and the workspace are safe to use (or free) on it afterwards.
+    if n_streams == 0:
+        return
+    streams, _ = _get_batch_streams()
+    current = _cupy.cuda.get_current_stream()
+    for stream in streams[:n_streams]:
+        current.wait_event(stream.record())
+
+
 def gesvdj(a, full_matrices=True, compute_uv=True, overwrite_a=False):
     """Singular value decomposition using cusolverDn<t>gesvdj().
 
@@ -233,11 +288,6 @@ cpdef _gesvdj_batched(a, full_matrices, compute_uv, overwrite_a):
     batch_size, m, n = a.shape
     a = _cupy.array(a.swapaxes(-2, -1), order='C',
                     copy=(None if overwrite_a else True))
-    if runtime._is_hip_environment:
-        # rocsolver_<t>gesvd_batched has a different signature...
-        ap = _linalg._mat_ptrs(a)
-    else:
-        ap = a
     lda = m
     mn = min(m, n)
     s = _cupy.empty((batch_size, mn), dtype=s_dtype)
@@ -252,11 +302,11 @@ cpdef _gesvdj_batched(a, full_matrices, compute_uv, overwrite_a):
     u = _cupy.empty((batch_size, m, ldu), dtype=a.dtype).swapaxes(-2, -1)
     v = _cupy.empty((batch_size, n, ldv), dtype=a.dtype).swapaxes(-2, -1)
     params = _cusolver.createGesvdjInfo()
-    lwork = helper(handle, jobz, m, n, ap.data.ptr, lda, s.data.ptr,
+    lwork = helper(handle, jobz, m, n, a.data.ptr, lda, s.data.ptr,
                    u.data.ptr, ldu, v.data.ptr, ldv, params, batch_size)
     work = _cupy.empty(lwork, dtype=a.dtype)
     info = _cupy.empty(batch_size, dtype=_numpy.int32)
-    solver(handle, jobz, m, n, ap.data.ptr, lda, s.data.ptr,
+    solver(handle, jobz, m, n, a.data.ptr, lda, s.data.ptr,
            u.data.ptr, ldu, v.data.ptr, ldv, work.data.ptr, lwork,
            info.data.ptr, params, batch_size)
     _cupy.linalg._util._check_cusolver_dev_info_if_synchronization_allowed(
@@ -287,11 +337,9 @@ cpdef _gesvd_batched(a, a_dtype, full_matrices, compute_uv, overwrite_a):
         raise RuntimeError("This function is disabled on HIP as "
                            "it is not needed")
 
-    # TODO(leofang): try overlapping using a small stream pool?
-
     cdef _ndarray_base x, s, u, vt, dev_info
-    cdef int n, m, k, batch_size, buffersize, status
-    cdef intptr_t a_ptr, s_ptr, u_ptr, vt_ptr, w_ptr, info_ptr
+    cdef int n, m, k, batch_size, buffersize, status, n_streams
+    cdef intptr_t a_ptr, s_ptr, u_ptr, vt_ptr, w_ptr, info_ptr, streams_ptr
     cdef str s_dtype
     cdef char job_u, job_vt
     cdef bint trans_flag
@@ -354,8 +402,10 @@ cpdef _gesvd_batched(a, a_dtype, full_matrices, compute_uv, overwrite_a):
 
     # this wrapper also sets the stream for us
     buffersize = gesvd_bufferSize(handle, m, n)
-    # we are on the same stream, so the workspace can be reused in the loop
-    workspace = memory.alloc(buffersize * x.dtype.itemsize)
+    # one workspace slot per stream, reused by the matrices on that stream
+    n_streams = _fork_batch_streams(batch_size, m, n, &streams_ptr)
+    workspace = memory.alloc(
+        buffersize * x.dtype.itemsize * max(n_streams, 1))
     w_ptr = workspace.ptr
 
     # the loop starts here, with gil released to reduce overhead
@@ -363,7 +413,8 @@ cpdef _gesvd_batched(a, a_dtype, full_matrices, compute_uv, overwrite_a):
         status = gesvd(
             handle, job_u, job_vt, m, n, a_ptr,
             s_ptr, u_ptr, vt_ptr,
-            w_ptr, buffersize, info_ptr, batch_size)
+            w_ptr, buffersize, info_ptr, batch_size, streams_ptr, n_streams)
+    _join_batch_streams(n_streams)
     if status != 0:
         raise _cusolver.CUSOLVERError(status)
 
@@ -871,8 +922,8 @@ cpdef _geqrf_orgqr_batched(a, mode):
     '''Internal helper for batched QR solver. The input array ``a''
     is of shape (batch_size, m, n)
     '''
-    cdef intptr_t x_ptr, tau_ptr, w_ptr, info_ptr
-    cdef int m, n, mn, mc, batch_size, buffersize, orig_n
+    cdef intptr_t x_ptr, tau_ptr, w_ptr, info_ptr, streams_ptr
+    cdef int m, n, mn, mc, batch_size, buffersize, orig_n, n_streams
 
     # support float32, float64, complex64, and complex128
     dtype, out_dtype = _cupy.linalg._util.linalg_common_type(a)
@@ -881,12 +932,7 @@ cpdef _geqrf_orgqr_batched(a, mode):
     mn = min(m, n)
 
     x = a.swapaxes(-2, -1).astype(dtype, order='C', copy=True)
-    if runtime._is_hip_environment:
-        # rocsolver_<t>geqrf_batched has a different signature...
-        ap = _linalg._mat_ptrs(x)
-    else:
-        ap = x
-    x_ptr = ap.data.ptr
+    x_ptr = x.data.ptr
 
     cdef intptr_t handle = _device.get_cusolver_handle()
     dev_info = _ndarray_init(_cupy.ndarray, (batch_size,), _numpy.int32, None)
@@ -912,17 +958,25 @@ cpdef _geqrf_orgqr_batched(a, mode):
 
     # this wrapper also sets the stream for us
     buffersize = geqrf_bufferSize(handle, m, n, x.data.ptr, n)
-    # we are on the same stream, so the workspace can be reused in the loop
-    workspace = memory.alloc(buffersize * a.dtype.itemsize)
-    w_ptr = workspace.ptr
     tau = _cupy.empty((batch_size, mn), dtype=dtype)
     tau_ptr = tau.data.ptr
+    # rocSOLVER has a batched geqrf, so only the loop on CUDA is spread over
+    # streams, with one workspace slot per stream
+    if runtime._is_hip_environment:
+        n_streams = streams_ptr = 0
+    else:
+        n_streams = _fork_batch_streams(batch_size, m, n, &streams_ptr)
+    workspace = memory.alloc(
+        buffersize * a.dtype.itemsize * max(n_streams, 1))
+    w_ptr = workspace.ptr
 
     # compute working space of geqrf and solve R
     # the loop starts here, with gil released to reduce overhead
     with nogil:
         status = geqrf(handle, m, n, x_ptr, m, tau_ptr,
-                       w_ptr, buffersize, info_ptr, batch_size)
+                       w_ptr, buffersize, info_ptr, batch_size,
+                       streams_ptr, n_streams)
+    _join_batch_streams(n_streams)
     if status != 0:
         raise _cusolver.CUSOLVERError(status)
     _cupy.linalg._util._check_cusolver_dev_info_if_synchronization_allowed(
@@ -967,13 +1021,16 @@ cpdef _geqrf_orgqr_batched(a, mode):
     # this wrapper also sets the stream for us
     buffersize = orgqr_bufferSize(
         handle, m, mc, mn, x_ptr, m, tau_ptr)
-    workspace = memory.alloc(buffersize * a.dtype.itemsize)
+    n_streams = _fork_batch_streams(batch_size, m, mc, &streams_ptr)
+    workspace = memory.alloc(
+        buffersize * a.dtype.itemsize * max(n_streams, 1))
     w_ptr = workspace.ptr
 
     with nogil:
         status = orgqr(
             handle, m, mc, mn, x_ptr, m, tau_ptr, w_ptr,
-            buffersize, info_ptr, batch_size, orig_n)
+            buffersize, info_ptr, batch_size, orig_n, streams_ptr, n_streams)
+    _join_batch_streams(n_streams)
     if status != 0:
         raise _cusolver.CUSOLVERError(status)
     _cupy.linalg._util._check_cusolver_dev_info_if_synchronization_allowed(
@@ -983,3 +1040,70 @@ cpdef _geqrf_orgqr_batched(a, mode):
     r = x[..., :mc].swapaxes(-2, -1)
     return (q.astype(out_dtype, copy=False),
             _cupy.linalg._util._triu(r).astype(out_dtype, copy=False))
+
+
+cpdef _potrf_strided_batched(_ndarray_base x, int uplo,
+                             _ndarray_base dev_info):
+    '''Internal helper for batched Cholesky decomposition on HIP. The input
+    array ``x`` is C-contiguous of shape (batch_size, n, n) and overwritten.
+    '''
+    cdef int n, batch_size, status
+    cdef intptr_t handle, x_ptr, info_ptr
+    cdef potrf_strided_ptr potrf
+
+    assert runtime._is_hip_environment
+    dtype = x.dtype
+    if dtype == 'f':
+        potrf = potrf_strided_batched[float]
+    elif dtype == 'd':
+        potrf = potrf_strided_batched[double]
+    elif dtype == 'F':
+        potrf = potrf_strided_batched[cuComplex]
+    elif dtype == 'D':
+        potrf = potrf_strided_batched[cuDoubleComplex]
+    else:
+        raise TypeError
+
+    batch_size, n = x.shape[:2]
+    handle = _device.get_cusolver_handle()
+    x_ptr = x.data.ptr
+    info_ptr = dev_info.data.ptr
+    with nogil:
+        status = potrf(handle, uplo, n, x_ptr, n, <long long>n * n,
+                       info_ptr, batch_size)
+    if status != 0:
+        raise _cusolver.CUSOLVERError(status)
+
+
+cpdef _getrf_strided_batched(_ndarray_base x, _ndarray_base ipiv,
+                             _ndarray_base dev_info):
+    '''Internal helper for batched LU decomposition on HIP. The input array
+    ``x`` is C-contiguous of shape (batch_size, n, n) and overwritten.
+    '''
+    cdef int n, batch_size, status
+    cdef intptr_t handle, x_ptr, ipiv_ptr, info_ptr
+    cdef getrf_strided_ptr getrf
+
+    assert runtime._is_hip_environment
+    dtype = x.dtype
+    if dtype == 'f':
+        getrf = getrf_strided_batched[float]
+    elif dtype == 'd':
+        getrf = getrf_strided_batched[double]
+    elif dtype == 'F':
+        getrf = getrf_strided_batched[cuComplex]
+    elif dtype == 'D':
+        getrf = getrf_strided_batched[cuDoubleComplex]
+    else:
+        raise TypeError
+
+    batch_size, n = x.shape[:2]
+    handle = _device.get_cusolver_handle()
+    x_ptr = x.data.ptr
+    ipiv_ptr = ipiv.data.ptr
+    info_ptr = dev_info.data.ptr
+    with nogil:
+        status = getrf(handle, n, x_ptr, n, <long long>n * n,
+                       ipiv_ptr, info_ptr, batch_size)
+    if status != 0:
+        raise _cusolver.CUSOLVERError(status)
@@ -81,6 +81,8 @@ _available_cusparse_version = {
     'csrmvEx': (8000, 11000),  # TODO(anaruse): failure in cuSparse 11.0
     'csrmm': (8000, 11000),
     'csrmm2': (8000, 11000),
+    'bsrmv': (8000, None),
+    'bsrmm': (8000, None),
     'csrgeam': (8000, 11000),
     'csrgeam2': (9020, None),
     'csrgemm': (8000, 11000),
@@ -111,6 +113,7 @@ _available_cusparse_version = {
     'denseToSparse': (11300, None),
     'sparseToDense': (11300, None),
     'spgemm': (11100, None),
+    'spgemm_reuse': (11600, None),  # CUDA 11.3.1
     'spsm': (11600, None),  # CUDA 11.3.1
 }
 
@@ -122,6 +125,8 @@ _available_hipsparse_version = {
     'csrmvEx': (_numpy.inf, None),
     'csrmm': (305, None),
     'csrmm2': (305, None),
+    'bsrmv': (305, None),
+    'bsrmm': (402, None),
     'csrgeam': (305, None),
     'csrgeam2': (305, None),
     'csrgemm': (305, None),
@@ -148,6 +153,7 @@ _available_hipsparse_version = {
     'denseToSparse': (402, None),
     'sparseToDense': (402, None),
     'spgemm': (_numpy.inf, None),
+    'spgemm_reuse': (_numpy.inf, None),
     'spsm': (50000000, None),
 }
 
@@ -456,6 +462,104 @@ def csrmm2(a, b, c=None, alpha=1.0, beta=0.0, transa=False, transb=False):
     return c
 
 
+def bsrmv(a, x, y=None, alpha=1, beta=0):
+    """Matrix-vector product for a BSR matrix and a dense vector.
+
+    .. math::
+
+       y = \\alpha A x + \\beta y,
+
+    Args:
+        a (cupyx.scipy.sparse.bsr_matrix): Matrix A. Its blocks must be
+            square.
+        x (cupy.ndarray): Vector x. It must be C-contiguous.
+        y (cupy.ndarray or None): Vector y. It must be C-contiguous.
+        alpha (float): Coefficient for x.
+        beta (float): Coefficient for y.
+
+    Returns:
+        cupy.ndarray: Calculated ``y``.
+
+    """
+    if not check_availability('bsrmv'):
+        raise RuntimeError('bsrmv is not available.')
+
+    R, C = a.blocksize
+    if R != C:
+        raise ValueError('the blocks must be square')
+    if a.shape[1] != len(x):
+        raise ValueError('dimension mismatch')
+    assert x.flags.c_contiguous
+    assert y is None or y.flags.c_contiguous
+
+    handle = _device.get_cusparse_handle()
+    m, n = a.shape
+    a, x, y = _cast_common_type(a, x, y)
+    dtype = a.dtype
+    if y is None:
+        y = _cupy.zeros(m, dtype)
+    alpha = _numpy.array(alpha, dtype).ctypes
+    beta = _numpy.array(beta, dtype).ctypes
+    _call_cusparse(
+        'bsrmv', dtype,
+        handle, _cusparse.CUSPARSE_DIRECTION_ROW,
+        _cusparse.CUSPARSE_OPERATION_NON_TRANSPOSE, m // R, n // R,
+        a.indices.size, alpha.data, a._descr.descriptor, a.data.data.ptr,
+        a.indptr.data.ptr, a.indices.data.ptr, R, x.data.ptr, beta.data,
+        y.data.ptr)
+    return y
+
+
+def bsrmm(a, b, c=None, alpha=1, beta=0):
+    """Matrix-matrix product for a BSR matrix and a dense matrix.
+
+    .. math::
+
+       C = \\alpha A B + \\beta C,
+
+    Args:
+        a (cupyx.scipy.sparse.bsr_matrix): Matrix A. Its blocks must be
+            square.
+        b (cupy.ndarray): Dense matrix B. It must be F-contiguous.
+        c (cupy.ndarray or None): Dense matrix C. It must be F-contiguous.
+        alpha (float): Coefficient for AB.
+        beta (float): Coefficient for C.
+
+    Returns:
+        cupy.ndarray: Calculated C.
+
+    """
+    if not check_availability('bsrmm'):
+        raise RuntimeError('bsrmm is not available.')
+
+    assert b.ndim == 2
+    assert b.flags.f_contiguous
+    assert c is None or c.flags.f_contiguous
+    R, C = a.blocksize
+    if R != C:
+        raise ValueError('the blocks must be square')
+    if a.shape[1] != b.shape[0]:
+        raise ValueError('dimension mismatch')
+
+    handle = _device.get_cusparse_handle()
+    m, k = a.shape
+    n = b.shape[1]
+    a, b, c = _cast_common_type(a, b, c)
+    if c is None:
+        c = _cupy.zeros((m, n), a.dtype, 'F')
+
+    op = _cusparse.CUSPARSE_OPERATION_NON_TRANSPOSE
+    alpha = _numpy.array(alpha, a.dtype).ctypes
+    beta = _numpy.array(beta, a.dtype).ctypes
+    _call_cusparse(
+        'bsrmm', a.dtype,
+        handle, _cusparse.CUSPARSE_DIRECTION_ROW, op, op, m // R, n, k // R,
+        a.indices.size, alpha.data, a._descr.descriptor, a.data.data.ptr,
+        a.indptr.data.ptr, a.indices.data.ptr, R, b.data.ptr, k, beta.data,
+        c.data.ptr, m)
+    return c
+
+
 def csrgeam(a, b, alpha=1, beta=1):
     """Matrix-matrix addition.
 
@@ -1368,6 +1472,67 @@ class DnMatDescriptor(BaseDescriptor):
         return DnMatDescriptor(desc, get, destroy)
 
 
+class _DescriptorCache(object):
+
+    """Descriptors and work buffers of a sparse matrix, reused across calls.
+
+    The descriptors only hold the pointers and the sizes of the arrays, so
+    that they stay valid as long as the matrix has the same arrays; they are
+    recreated when it does not (see :func:`_get_descriptor_cache`). The
+    dense descriptors are updated with the pointer of the operand of each
+    call, and the buffers are kept for each stream, as the calls on a stream
+    are serialized.
+    """
+
+    def __init__(self, key, a):
+        self.key = key
+        self.desc = SpMatDescriptor.create(a)
+        self._dense = {}
+        self._buffers = {}
+
+    def dense(self, name, x):
+        key = (name, x.shape, x.dtype)
+        desc = self._dense.get(key)
+        if desc is None:
+            if x.ndim == 1:
+                desc = DnVecDescriptor.create(x)
+            else:
+                desc = DnMatDescriptor.create(x)
+            self._dense[key] = desc
+        elif x.ndim == 1:
+            _cusparse.dnVecSetValues(desc.desc, x.data.ptr)
+        else:
+            _cusparse.dnMatSetValues(desc.desc, x.data.ptr)
+        return desc
+
+    def buffer(self, key, get_size):
+        key += (_stream.get_current_stream_ptr(),)
+        buff = self._buffers.get(key)
+        if buff is None:
+            buff = self._buffers[key] = _cupy.empty(get_size(), _cupy.int8)
+        return buff
+
+
+def _get_descriptor_cache(a, owner=None):
+    """Returns the descriptor cache of a sparse matrix.
+
+    The cache is attached to ``owner`` (``a`` by default), e.g. the CSC
+    matrix whose transpose ``a`` is.
+    """
+    if owner is None:
+        owner = a
+    if a.format == 'coo':
+        arrays = (a.data, a.row, a.col)
+    else:
+        arrays = (a.data, a.indptr, a.indices)
+    key = (a.format, a.shape, a.nnz, a.dtype, _device.get_device_id()) + tuple(
+        x.data.ptr for x in arrays)
+    cache = getattr(owner, '_descriptor_cache', None)
+    if cache is None or cache.key != key:
+        cache = owner._descriptor_cache = _DescriptorCache(key, a)
+    return cache
+
+
 def spmv(a, x, y=None, alpha=1, beta=0, transa=False):
     """Multiplication of sparse matrix and dense vector.
 
@@ -1390,6 +1555,7 @@ def spmv(a, x, y=None, alpha=1, beta=0, transa=False):
     if not check_availability('spmv'):
         raise RuntimeError('spmv is not available.')
 
+    owner = a
     if isinstance(a, cupyx.scipy.sparse.csc_matrix):
         aT = a.T
         if not isinstance(aT, cupyx.scipy.sparse.csr_matrix):
@@ -1407,6 +1573,8 @@ def spmv(a, x, y=None, alpha=1, beta=0, transa=False):
 
     m, n = a_shape
     a, x, y = _cast_common_type(a, x, y)
+    if a.dtype != owner.dtype:
+        owner = a
     if y is None:
         y = _cupy.zeros(m, a.dtype)
     elif len(y) != m:
@@ -1415,9 +1583,10 @@ def spmv(a, x, y=None, alpha=1, beta=0, transa=False):
         y.fill(0)
         return y
 
-    desc_a = SpMatDescriptor.create(a)
-    desc_x = DnVecDescriptor.create(x)
-    desc_y = DnVecDescriptor.create(y)
+    cache = _get_descriptor_cache(a, owner)
+    desc_a = cache.desc
+    desc_x = cache.dense('x', x)
+    desc_y = cache.dense('y', y)
 
     handle = _device.get_cusparse_handle()
     op_a = _transpose_flag(transa)
@@ -1425,10 +1594,9 @@ def spmv(a, x, y=None, alpha=1, beta=0, transa=False):
     beta = _numpy.array(beta, a.dtype).ctypes
     cuda_dtype = _dtype.to_cuda_dtype(a.dtype)
     alg = _cusparse.CUSPARSE_MV_ALG_DEFAULT
-    buff_size = _cusparse.spMV_bufferSize(handle, op_a, alpha.data,
-                                          desc_a.desc, desc_x.desc, beta.data,
-                                          desc_y.desc, cuda_dtype, alg)
-    buff = _cupy.empty(buff_size, _cupy.int8)
+    buff = cache.buffer(('spmv', op_a, alg), lambda: _cusparse.spMV_bufferSize(
+        handle, op_a, alpha.data, desc_a.desc, desc_x.desc, beta.data,
+        desc_y.desc, cuda_dtype, alg))
     _cusparse.spMV(handle, op_a, alpha.data, desc_a.desc, desc_x.desc,
                    beta.data, desc_y.desc, cuda_dtype, alg, buff.data.ptr)
 
@@ -1462,6 +1630,7 @@ def spmm(a, b, c=None, alpha=1, beta=0, transa=False, transb=False):
     assert b.flags.f_contiguous
     assert c is None or c.flags.f_contiguous
 
+    owner = a
     if isinstance(a, cupyx.scipy.sparse.csc_matrix):
         aT = a.T
         if not isinstance(aT, cupyx.scipy.sparse.csr_matrix):
@@ -1481,6 +1650,8 @@ def spmm(a, b, c=None, alpha=1, beta=0, transa=False, transb=False):
     m, k = a_shape
     _, n = b_shape
     a, b, c = _cast_common_type(a, b, c)
+    if a.dtype != owner.dtype:
+        owner = a
     if c is None:
         c = _cupy.zeros((m, n), a.dtype, 'F')
     elif c.shape[0] != m or c.shape[1] != n:
@@ -1489,9 +1660,10 @@ def spmm(a, b, c=None, alpha=1, beta=0, transa=False, transb=False):
         c.fill(0)
         return c
 
-    desc_a = SpMatDescriptor.create(a)
-    desc_b = DnMatDescriptor.create(b)
-    desc_c = DnMatDescriptor.create(c)
+    cache = _get_descriptor_cache(a, owner)
+    desc_a = cache.desc
+    desc_b = cache.dense('b', b)
+    desc_c = cache.dense('c', c)
 
     handle = _device.get_cusparse_handle()
     op_a = _transpose_flag(transa)
@@ -1500,10 +1672,11 @@ def spmm(a, b, c=None, alpha=1, beta=0, transa=False, transb=False):
     beta = _numpy.array(beta, a.dtype).ctypes
     cuda_dtype = _dtype.to_cuda_dtype(a.dtype)
     alg = _cusparse.CUSPARSE_MM_ALG_DEFAULT
-    buff_size = _cusparse.spMM_bufferSize(handle, op_a, op_b, alpha.data,
-                                          desc_a.desc, desc_b.desc, beta.data,
-                                          desc_c.desc, cuda_dtype, alg)
-    buff = _cupy.empty(buff_size, _cupy.int8)
+    buff = cache.buffer(
+        ('spmm', op_a, op_b, b.shape, alg),
+        lambda: _cusparse.spMM_bufferSize(
+            handle, op_a, op_b, alpha.data, desc_a.desc, desc_b.desc,
+            beta.data, desc_c.desc, cuda_dtype, alg))
     buff_size = _cusparse.spMM(handle, op_a, op_b, alpha.data, desc_a.desc,
                                desc_b.desc, beta.data, desc_c.desc,
                                cuda_dtype, alg, buff.data.ptr)
@@ -2108,3 +2281,168 @@ def spgemm(a, b, alpha=1):
 
     _cusparse.spGEMM_destroyDescr(spgemm_descr)
     return c
+
+
+class SpGEMMPlan(object):
+    """The product of two CSR matrices, for their structure.
+
+    The structure of ``C = A * B`` is computed once, and the descriptors and
+    work buffers of cuSPARSE are kept, so that :meth:`multiply` only redoes
+    the numeric phase for new values of ``A`` and ``B`` of the same sparsity
+    pattern, as in iterative solvers and Newton methods.
+
+    Use :func:`spgemm_plan` to make a plan.
+    """
+
+    def __init__(self, a, b):
+        m, _ = a.shape
+        _, n = b.shape
+        self.shape = (m, n)
+        self.dtype = a.dtype
+        self._a_shape, self._a_nnz = a.shape, a.nnz
+        self._b_shape, self._b_nnz = b.shape, b.nnz
+        # the operands are kept, as their descriptors point to their arrays
+        self._a = a
+        self._b = b
+        c = cupyx.scipy.sparse.csr_matrix(self.shape, dtype=self.dtype)
+
+        self._handle = _device.get_cusparse_handle()
+        self._mat_a = SpMatDescriptor.create(a)
+        self._mat_b = SpMatDescriptor.create(b)
+        self._mat_c = SpMatDescriptor.create(c)
+        self._op = _cusparse.CUSPARSE_OPERATION_NON_TRANSPOSE
+        self._algo = _cusparse.CUSPARSE_SPGEMM_DEFAULT
+        self._descr = _cusparse.spGEMM_createDescr()
+        args = (self._handle, self._op, self._op, self._mat_a.desc,
+                self._mat_b.desc, self._mat_c.desc, self._algo, self._descr)
+        null_ptr = 0
+
+        try:
+            # Analyze the structures of A and B
+            buff1_size = _cusparse.spGEMMreuse_workEstimation(
+                *args, 0, null_ptr)
+            buff1 = _cupy.empty(buff1_size, _cupy.int8)
+            _cusparse.spGEMMreuse_workEstimation(
+                *args, buff1_size, buff1.data.ptr)
+
+            # Compute the structure of C
+            sizes = _cusparse.spGEMMreuse_nnz(
+                *args, 0, null_ptr, 0, null_ptr, 0, null_ptr)
+            buff2, buff3, buff4 = [_cupy.empty(size, _cupy.int8)
+                                   for size in sizes]
+            _cusparse.spGEMMreuse_nnz(
+                *args, sizes[0], buff2.data.ptr, sizes[1], buff3.data.ptr,
+                sizes[2], buff4.data.ptr)
+            del buff1, buff2
+
+            c_num_rows = _numpy.array(0, dtype='int64')
+            c_num_cols = _numpy.array(0, dtype='int64')
+            c_nnz = _numpy.array(0, dtype='int64')
+            _cusparse.spMatGetSize(self._mat_c.desc, c_num_rows.ctypes.data,
+                                   c_num_cols.ctypes.data, c_nnz.ctypes.data)
+            self.nnz = int(c_nnz)
+            self._c_indptr = c.indptr
+            self._c_indices = _cupy.empty(self.nnz, 'i')
+            self._c_data = _cupy.zeros(self.nnz, self.dtype)
+            _cusparse.csrSetPointers(
+                self._mat_c.desc, self._c_indptr.data.ptr,
+                self._c_indices.data.ptr, self._c_data.data.ptr)
+
+            # Copy the structure to C
+            buff5_size = _cusparse.spGEMMreuse_copy(*args, 0, null_ptr)
+            buff5 = _cupy.empty(buff5_size, _cupy.int8)
+            _cusparse.spGEMMreuse_copy(*args, buff5_size, buff5.data.ptr)
+            del buff3
+        except Exception:
+            _cusparse.spGEMM_destroyDescr(self._descr)
+            self._descr = None
+            raise
+        # the buffers that the numeric phase reads
+        self._buffers = (buff4, buff5)
+
+    def __del__(self):
+        if getattr(self, '_descr', None) is not None:
+            _cusparse.spGEMM_destroyDescr(self._descr)
+            self._descr = None
+
+    def _check_operand(self, x, shape, nnz, name):
+        if not isinstance(x, cupyx.scipy.sparse.csr_matrix):
+            raise TypeError('unsupported type (actual: {})'.format(type(x)))
+        if x.shape != shape or x.nnz != nnz:
+            raise ValueError(
+                '{} does not have the structure of the plan'.format(name))
+        if x.dtype != self.dtype:
+            x = x.astype(self.dtype)
+        return x
+
+    def multiply(self, a=None, b=None, alpha=1):
+        """Computes ``alpha * A * B`` with the structure of the plan.
+
+        Args:
+            a (cupyx.scipy.sparse.csr_matrix): The new matrix A. It must have
+                the sparsity pattern of the one of the plan, which is used if
+                ``None``.
+            b (cupyx.scipy.sparse.csr_matrix): The new matrix B, likewise.
+            alpha (scalar): Coefficient.
+
+        Returns:
+            cupyx.scipy.sparse.csr_matrix: The product. Its ``indices`` and
+            ``indptr`` are shared with the plan and must not be modified.
+
+        .. note::
+            Only the shapes and the numbers of nonzeros of the new matrices
+            are checked, not their column indices.
+        """
+        if a is not None:
+            a = self._check_operand(a, self._a_shape, self._a_nnz, 'A')
+            _cusparse.csrSetPointers(self._mat_a.desc, a.indptr.data.ptr,
+                                     a.indices.data.ptr, a.data.data.ptr)
+            self._a = a
+        if b is not None:
+            b = self._check_operand(b, self._b_shape, self._b_nnz, 'B')
+            _cusparse.csrSetPointers(self._mat_b.desc, b.indptr.data.ptr,
+                                     b.indices.data.ptr, b.data.data.ptr)
+            self._b = b
+
+        c_data = _cupy.zeros(self.nnz, self.dtype)
+        _cusparse.csrSetPointers(self._mat_c.desc, self._c_indptr.data.ptr,
+                                 self._c_indices.data.ptr, c_data.data.ptr)
+        self._c_data = c_data
+        alpha = _numpy.array(alpha, dtype=self.dtype).ctypes
+        beta = _numpy.array(0, dtype=self.dtype).ctypes
+        _cusparse.spGEMMreuse_compute(
+            self._handle, self._op, self._op, alpha.data, self._mat_a.desc,
+            self._mat_b.desc, beta.data, self._mat_c.desc,
+            _dtype.to_cuda_dtype(self.dtype), self._algo, self._descr)
+        return cupyx.scipy.sparse.csr_matrix(
+            (c_data, self._c_indices, self._c_indptr), shape=self.shape)
+
+
+def spgemm_plan(a, b):
+    """Plans the product of two CSR matrices for repeated multiplications.
+
+    Args:
+        a (cupyx.scipy.sparse.csr_matrix): Sparse matrix A.
+        b (cupyx.scipy.sparse.csr_matrix): Sparse matrix B.
+
+    Returns:
+        SpGEMMPlan: The plan, whose :meth:`SpGEMMPlan.multiply` computes
+        ``alpha * A * B`` for new values of A and B.
+
+    .. seealso:: :func:`spgemm`
+    """
+    if not check_availability('spgemm_reuse'):
+        raise RuntimeError('spgemm_reuse is not available.')
+
+    assert a.ndim == b.ndim == 2
+    if not isinstance(a, cupyx.scipy.sparse.csr_matrix):
+        raise TypeError('unsupported type (actual: {})'.format(type(a)))
+    if not isinstance(b, cupyx.scipy.sparse.csr_matrix):
+        raise TypeError('unsupported type (actual: {})'.format(type(b)))
+    assert a.has_canonical_format
+    assert b.has_canonical_format
+    if a.shape[1] != b.shape[0]:
+        raise ValueError('mismatched shape')
+
+    a, b = _cast_common_type(a, b)
+    return SpGEMMPlan(a, b)
@@ -0,0 +1,244 @@
+"""Matrix multiplication with 2:4 structured-sparse matrices (cuSPARSELt).
+
+A matrix whose rows hold at most two nonzeros in each group of four
+consecutive elements is compressed once to about half its size, and then
+multiplied by dense matrices on the sparse tensor cores. The plan of each
+shape of the dense operand, and the algorithm found for it by
+``matmulSearch``, are cached on the compressed matrix.
+"""
+
+import numpy as _numpy
+
+import cupy as _cupy
+from cupy import _util
+from cupy_backends.cuda.api import runtime as _runtime
+from cupy_backends.cuda.libs import cusparse as _cusparse
+from cupy_backends.cuda.libs import cusparselt as _cusparselt
+
+
+# the alignment in bytes of the pointers and leading dimensions
+_alignment = 16
+
+# dtype -> (data type, compute type)
+_types = {
+    _numpy.dtype(_numpy.float16): (
+        _runtime.CUDA_R_16F, _cusparselt.CUSPARSE_COMPUTE_32F),
+    _numpy.dtype(_numpy.int8): (
+        _runtime.CUDA_R_8I, _cusparselt.CUSPARSE_COMPUTE_32I),
+}
+
+_prune_algs = {
+    'tile': _cusparselt.CUSPARSELT_PRUNE_SPMMA_TILE,
+    'strip': _cusparselt.CUSPARSELT_PRUNE_SPMMA_STRIP,
+}
+
+
+@_util.memoize(for_each_device=True)
+def _get_handle():
+    handle = _cusparselt.Handle()
+    _cusparselt.init(handle)
+    return handle
+
+
+def _aligned(x):
+    return x.data.ptr % _alignment == 0
+
+
+def _dense_descriptor(handle, rows, cols, cuda_dtype):
+    desc = _cusparselt.MatDescriptor()
+    _cusparselt.denseDescriptorInit(
+        handle, desc, rows, cols, cols, _alignment, cuda_dtype,
+        _cusparse.CUSPARSE_ORDER_ROW)
+    return desc
+
+
+class _Plan:
+
+    def __init__(self, handle, mat_a, shape, cuda_dtype, compute_type):
+        m, k, n = shape
+        self.mat_b = _dense_descriptor(handle, k, n, cuda_dtype)
+        self.mat_c = _dense_descriptor(handle, m, n, cuda_dtype)
+        self.matmul = _cusparselt.MatmulDescriptor()
+        op = _cusparse.CUSPARSE_OPERATION_NON_TRANSPOSE
+        _cusparselt.matmulDescriptorInit(
+            handle, self.matmul, op, op, mat_a, self.mat_b, self.mat_c,
+            self.mat_c, compute_type)
+        self.alg_sel = _cusparselt.MatmulAlgSelection()
+        _cusparselt.matmulAlgSelectionInit(
+            handle, self.alg_sel, self.matmul,
+            _cusparselt.CUSPARSELT_MATMUL_ALG_DEFAULT)
+        self.plan = _cusparselt.MatmulPlan()
+        _cusparselt.matmulPlanInit(
+            handle, self.plan, self.matmul, self.alg_sel)
+        self.workspace = _cupy.empty(
+            _cusparselt.matmulGetWorkspace(handle, self.plan), 'b')
+        self.searched = False
+
+    def destroy(self):
+        _cusparselt.matmulPlanDestroy(self.plan)
+        _cusparselt.matDescriptorDestroy(self.mat_b)
+        _cusparselt.matDescriptorDestroy(self.mat_c)
+
+
+class StructuredSparseMatrix(object):
+    """A 2:4 structured-sparse matrix compressed for cuSPARSELt.
+
+    The matrix is compressed when the object is created, so that the dense
+    matrix can be released afterwards. The first :meth:`matmul` with a
+    given number of columns of the dense operand creates a plan and selects
+    the fastest algorithm for it with ``cusparseLtMatmulSearch``; the later
+    calls with that shape reuse them.
+
+    Args:
+        a (cupy.ndarray): The 2-D matrix, of shape ``(m, k)``. Its dtype must
+            be ``float16`` or ``int8``.
+        prune (str or None): If ``None``, ``a`` must already have the 2:4
+            sparsity along its rows, which is checked. Otherwise ``a`` is
+            pruned first, with the ``'tile'`` or ``'strip'`` algorithm of
+            cuSPARSELt; ``a`` itself is not modified.
+
+    .. note::
+        The sizes of the matrices must satisfy the constraints of
+        cuSPARSELt, e.g. be multiples of 16 for ``int8``, and the sparse
+        tensor cores need a GPU of compute capability 8.0 or later.
+
+    .. seealso:: `cuSPARSELt <https://docs.nvidia.com/cuda/cusparselt/>`_
+
+    """
+
+    def __init__(self, a, prune=None):
+        if a.ndim != 2:
+            raise ValueError('a must be a 2-D array')
+        dtype = a.dtype
+        if dtype not in _types:
+            raise TypeError('unsupported dtype: {}'.format(dtype))
+        if prune is not None and prune not in _prune_algs:
+            raise ValueError('unsupported prune algorithm: {}'.format(prune))
+        self.shape = a.shape
+        self.dtype = dtype
+        self.device = a.device
+        self._cuda_dtype, self._compute_type = _types[dtype]
+        self._plans = {}
+        self._mat_a = None
+        with self.device:
+            self._compress(a, prune)
+
+    def _compress(self, a, prune):
+        handle = _get_handle()
+        a = _cupy.ascontiguousarray(a)
+        if not _aligned(a):
+            a = a.copy()
+        m, k = self.shape
+        self._mat_a = _cusparselt.MatDescriptor()
+        _cusparselt.structuredDescriptorInit(
+            handle, self._mat_a, m, k, k, _alignment, self._cuda_dtype,
+            _cusparse.CUSPARSE_ORDER_ROW,
+            _cusparselt.CUSPARSELT_SPARSITY_50_PERCENT)
+        op = _cusparse.CUSPARSE_OPERATION_NON_TRANSPOSE
+
+        if prune is not None:
+            pruned = _cupy.empty_like(a)
+            _cusparselt.spMMAPrune2(
+                handle, self._mat_a, 1, op, a.data.ptr, pruned.data.ptr,
+                _prune_algs[prune])
+            a = pruned
+        else:
+            is_valid = _cupy.empty((), _numpy.int32)
+            _cusparselt.spMMAPruneCheck2(
+                handle, self._mat_a, 1, op, a.data.ptr, is_valid.data.ptr)
+            if int(is_valid) != 0:
+                raise ValueError(
+                    'a does not have the 2:4 structured sparsity; '
+                    'prune it first or pass prune')
+
+        size, buffer_size = _cusparselt.spMMACompressedSize2(
+            handle, self._mat_a)
+        self._compressed = _cupy.empty(size, 'b')
+        buffer = _cupy.empty(buffer_size, 'b')
+        _cusparselt.spMMACompress2(
+            handle, self._mat_a, 1, op, a.data.ptr, self._compressed.data.ptr,
+            buffer.data.ptr)
+
+    def __del__(self, is_shutting_down=_util.is_shutting_down):
+        if is_shutting_down() or self._mat_a is None:
+            return
+        with self.device:
+            for plan in self._plans.values():
+                plan.destroy()
+            _cusparselt.matDescriptorDestroy(self._mat_a)
+        self._plans = {}
+        self._mat_a = None
+
+    def _get_plan(self, n):
+        plan = self._plans.get(n)
+        if plan is None:
+            m, k = self.shape
+            plan = _Plan(_get_handle(), self._mat_a, (m, k, n),
+                         self._cuda_dtype, self._compute_type)
+            self._plans[n] = plan
+        return plan
+
+    def matmul(self, b, out=None):
+        """Computes the product with a dense matrix.
+
+        Args:
+            b (cupy.ndarray): The dense matrix of shape ``(k, n)``, or a
+                vector of shape ``(k,)``, of the same dtype as this matrix.
+            out (cupy.ndarray): The C-contiguous array of shape ``(m, n)``, or
+                ``(m,)`` for a vector, to store the result in.
+
+        Returns:
+            cupy.ndarray: The product, of the dtype of this matrix.
+
+        """
+        if b.dtype != self.dtype:
+            raise TypeError('b must be of dtype {}'.format(self.dtype))
+        if b.ndim not in (1, 2) or b.shape[0] != self.shape[1]:
+            raise ValueError('shape mismatch: {} and {}'.format(
+                self.shape, b.shape))
+        if b.device != self.device:
+            raise ValueError('b must be on device {}'.format(self.device.id))
+        m = self.shape[0]
+        out_shape = (m,) + b.shape[1:]
+        if out is not None:
+            if out.shape != out_shape or out.dtype != self.dtype:
+                raise ValueError('out must be of shape {} and dtype {}'.format(
+                    out_shape, self.dtype))
+            if not out.flags.c_contiguous:
+                raise ValueError('out must be C-contiguous')
+        vector = b.ndim == 1
+        n = 1 if vector else b.shape[1]
+        b = _cupy.ascontiguousarray(b)
+        if not _aligned(b):
+            b = b.copy()
+        if out is None or not _aligned(out):
+            c = _cupy.empty(out_shape, self.dtype)
+        else:
+            c = out
+
+        with self.device:
+            handle = _get_handle()
+            plan = self._get_plan(n)
+            alpha = _numpy.array(1, _numpy.float32)
+            beta = _numpy.array(0, _numpy.float32)
+            args = (handle, plan.plan, alpha.ctypes.data,
+                    self._compressed.data.ptr, b.data.ptr, beta.ctypes.data,
+                    c.data.ptr, c.data.ptr, plan.workspace.data.ptr)
+            if not plan.searched:
+                # the search updates the algorithm of the plan; it also
+                # writes c, which is computed again below
+                _cusparselt.matmulSearch(*args)
+                size = _cusparselt.matmulGetWorkspace(handle, plan.plan)
+                if size > plan.workspace.size:
+                    plan.workspace = _cupy.empty(size, 'b')
+                    args = args[:-1] + (plan.workspace.data.ptr,)
+                plan.searched = True
+            _cusparselt.matmul(*args)
+
+        if out is not None and c is not out:
+            out[...] = c
+            return out
+        return c
+
+    def __matmul__(self, other):
+        return self.matmul(other)
@@ -7,7 +7,7 @@ from cupy.cuda import device as _device
 cimport cython
 from libcpp cimport vector
 from libc.stdint cimport intptr_t, uint32_t, uint64_t, int64_t
-from cupy._core._carray cimport shape_t
+from cupy._core._carray cimport shape_t, strides_t
 from cupy._core.core cimport _ndarray_base
 from cupy._core cimport internal
 
@@ -31,6 +31,8 @@ cdef dict _elementwise_binary_operators = {}
 cdef dict _elementwise_trinary_operators = {}
 cdef dict _reduction_operators = {}
 cdef dict _contraction_operators = {}
+cdef dict _contraction_ws_sizes = {}
+cdef dict _reduction_ws_sizes = {}
 cdef dict _mg_handles = {}
 cdef dict _mg_tensor_descriptors = {}
 cdef dict _mg_copy_descriptors = {}
@@ -798,8 +800,12 @@ def contraction(
         desc_A, mode_A, op_A, desc_B, mode_B, op_B, desc_C, mode_C, op_C,
         compute_desc)
     plan_pref = create_plan_preference(algo=algo, jit_mode=jit_mode)
-    ws_size = cutensor.estimateWorkspaceSize(
-        _get_handle().ptr, operator.ptr, plan_pref.ptr, ws_pref)
+    # The operator and the preference are cached, so is the estimate
+    key = (_get_handle().ptr, operator.ptr, plan_pref.ptr, ws_pref)
+    if key not in _contraction_ws_sizes:
+        _contraction_ws_sizes[key] = cutensor.estimateWorkspaceSize(
+            _get_handle().ptr, operator.ptr, plan_pref.ptr, ws_pref)
+    ws_size = _contraction_ws_sizes[key]
     plan = create_plan(operator, plan_pref, ws_limit=ws_size)
     ws = core._ndarray_init(
         _cupy.ndarray, shape_t(1, ws_size), dtype=_numpy.int8, obj=None)
@@ -907,9 +913,12 @@ def reduction(
     operator = create_reduction(
         desc_A, mode_A, op_A, desc_C, mode_C, op_C, op_reduce, compute_desc)
     plan_pref = create_plan_preference()
-    ws_size = cutensor.estimateWorkspaceSize(
-        _get_handle().ptr, operator.ptr, plan_pref.ptr,
-        cutensor.WORKSPACE_RECOMMENDED)
+    key = (_get_handle().ptr, operator.ptr, plan_pref.ptr)
+    if key not in _reduction_ws_sizes:
+        _reduction_ws_sizes[key] = cutensor.estimateWorkspaceSize(
+            _get_handle().ptr, operator.ptr, plan_pref.ptr,
+            cutensor.WORKSPACE_RECOMMENDED)
+    ws_size = _reduction_ws_sizes[key]
     plan = create_plan(operator, plan_pref, ws_limit=ws_size)
     ws = core._ndarray_init(
         _cupy.ndarray, shape_t(1, ws_size), dtype=_numpy.int8, obj=None)
@@ -931,6 +940,41 @@ _cutensor_dtypes = [
 ]
 
 
+cpdef _ndarray_base _strided_operand(_ndarray_base a):
+    # A view of `a` that cuTENSOR takes as is, e.g. a transposed array, or
+    # None if it must be copied. The strides of the axes of extent 1 are not
+    # used, so they are replaced by the item size, and the others must be
+    # positive.
+    cdef Py_ssize_t i, itemsize = a.dtype.itemsize
+    cdef strides_t strides = a._strides
+    cdef bint changed = False
+    for i in range(<Py_ssize_t>strides.size()):
+        if a._shape[i] == 1:
+            if strides[i] != itemsize:
+                strides[i] = itemsize
+                changed = True
+        elif strides[i] <= 0:
+            return None
+    if not changed:
+        return a
+    return a._view(type(a), a._shape, strides, False, False, a)
+
+
+cdef bint _is_permuted_contiguous(_ndarray_base a):
+    # Whether `a` is a transposed view of a contiguous array.
+    cdef Py_ssize_t i, expected = a.dtype.itemsize
+    cdef list extents = []
+    for i in range(<Py_ssize_t>a._shape.size()):
+        if a._shape[i] != 1:
+            extents.append((a._strides[i], a._shape[i]))
+    extents.sort()
+    for stride, extent in extents:
+        if stride != expected:
+            return False
+        expected *= extent
+    return True
+
+
 def _try_reduction_routine(
         _ndarray_base x, axis, dtype, _ndarray_base out, keepdims, reduce_op,
         alpha, beta):
@@ -953,15 +997,15 @@ def _try_reduction_routine(
         return None
     if x.size == 0:
         return None
-    if not x._c_contiguous:
-        # TODO(asi1024): Support also for F-contiguous array
-        return None
 
     # if x.size == 1 and cutensor.get_version() == 10400:
     #     # WAR: element-1 reduction is buggy
     #     return None
 
-    in_arg = x
+    # the modes of A follow its strides, so permuted arrays are not copied
+    in_arg = _strided_operand(x)
+    if in_arg is None:
+        return None
 
     reduce_axis, out_axis = _reduction._get_axis(axis, x.ndim)
     if len(reduce_axis) == 0:
@@ -988,7 +1032,6 @@ def _try_reduction_routine(
     # TODO(kmaeahshi): need to zero out when beta != 0
 
     # TODO(asi1024): Remove temporary fix
-    in_arg._set_contiguous_strides(in_arg.itemsize, True)
     out_arg._set_contiguous_strides(out_arg.itemsize, True)
 
     try:
@@ -1026,7 +1069,9 @@ def _try_elementwise_binary_routine(
         return None
     if a.size == 0:
         return None
-    if not (_all_positive(a._strides) and _all_positive(c._strides)):
+    a = _strided_operand(a)
+    c = _strided_operand(c)
+    if a is None or c is None:
         return None
     compute_dtype = a.dtype
 
@@ -1045,6 +1090,13 @@ def _try_elementwise_binary_routine(
         elif a._f_contiguous:
             a, c = c, a
             alpha, gamma = gamma, alpha
+        elif _is_permuted_contiguous(c):
+            # e.g. the sum of two transposed arrays, which keeps the layout
+            # of C as NumPy does for the order 'K'
+            pass
+        elif _is_permuted_contiguous(a):
+            a, c = c, a
+            alpha, gamma = gamma, alpha
         else:
             return None
 
@@ -0,0 +1,168 @@
+"""All-reduce of many arrays packed into flat buckets (tensor fusion).
+
+The arrays of each dtype are copied by one kernel into a bucket taken from
+the memory pool, which is all-reduced with one collective on a background
+stream as soon as it holds ``bucket_size`` bytes, and copied back to the
+arrays by one kernel once the collective is done.
+"""
+
+import numpy
+
+import cupy
+from cupy import _util
+
+
+_default_bucket_size = 25 << 20  # 25 MiB
+
+# The dtypes that NCCL can reduce.
+_supported_dtypes = 'bBiIlLqQefdFD'
+
+_fusion_code = r'''
+__device__ int find_array(const long long* offsets, int n, long long i) {
+    // offsets[0] == 0 and offsets[n] is the total size
+    int lo = 0, hi = n;
+    while (hi - lo > 1) {
+        int mid = (lo + hi) / 2;
+        if (offsets[mid] <= i) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+template<typename T>
+__global__ void fusion_pack(
+        T* bucket, T* const* arrays, const long long* offsets, int n) {
+    long long total = offsets[n];
+    for (long long i = blockIdx.x * (long long)blockDim.x + threadIdx.x;
+            i < total; i += (long long)blockDim.x * gridDim.x) {
+        int k = find_array(offsets, n, i);
+        bucket[i] = arrays[k][i - offsets[k]];
+    }
+}
+
+template<typename T>
+__global__ void fusion_unpack(
+        const T* bucket, T* const* arrays, const long long* offsets, int n) {
+    long long total = offsets[n];
+    for (long long i = blockIdx.x * (long long)blockDim.x + threadIdx.x;
+            i < total; i += (long long)blockDim.x * gridDim.x) {
+        int k = find_array(offsets, n, i);
+        arrays[k][i - offsets[k]] = bucket[i];
+    }
+}
+'''
+
+# The arrays are copied in units of their itemsize, or of 8 bytes for the
+# complex128 arrays.
+_unit_types = {
+    1: 'unsigned char',
+    2: 'unsigned short',
+    4: 'unsigned int',
+    8: 'unsigned long long',
+}
+
+
+@_util.memoize(for_each_device=True)
+def _get_module():
+    names = []
+    for t in _unit_types.values():
+        names.append(f'fusion_pack<{t}>')
+        names.append(f'fusion_unpack<{t}>')
+    return cupy.RawModule(code=_fusion_code, name_expressions=names)
+
+
+@_util.memoize(for_each_device=True)
+def _get_comm_stream():
+    return cupy.cuda.Stream(non_blocking=True)
+
+
+def _flat(array):
+    if not array.flags.c_contiguous and not array.flags.f_contiguous:
+        raise RuntimeError(
+            'NCCL requires arrays to be either c- or f-contiguous')
+    unit = min(array.dtype.itemsize, 8)
+    return cupy.ndarray((array.nbytes // unit,), f'u{unit}', array.data)
+
+
+def _copy(kernel_name, bucket, arrays):
+    # Copies between the bucket and the arrays with a single kernel.
+    units = [_flat(a) for a in arrays]
+    offsets = numpy.cumsum([0] + [u.size for u in units])
+    table = numpy.concatenate((
+        numpy.array([u.data.ptr for u in units], numpy.uint64).view(
+            numpy.int64),
+        offsets.astype(numpy.int64)))
+    table = cupy.asarray(table)
+    n = len(units)
+    unit_type = _unit_types[bucket.dtype.itemsize]
+    kernel = _get_module().get_function(f'{kernel_name}<{unit_type}>')
+    block = 256
+    grid = min(max(1, -(-int(offsets[-1]) // block)), 1024)
+    kernel((grid,), (block,), (bucket, table[:n], table[n:], numpy.int32(n)))
+
+
+class _AllReduceBuckets:
+    """All-reduces arrays in place through fused buckets.
+
+    Created by :meth:`cupyx.distributed.NCCLBackend.all_reduce_buckets`.
+    """
+
+    def __init__(self, comm, op, stream, bucket_size):
+        if bucket_size <= 0:
+            raise ValueError('bucket_size must be positive')
+        self._comm = comm
+        self._op = op
+        self._stream = stream
+        self._bucket_size = bucket_size
+        # dtype char -> (list of arrays, bytes)
+        self._pending = {}
+        # (bucket, arrays, event of the collective)
+        self._launched = []
+
+    def add(self, array):
+        """Adds an array, and starts the collective of its bucket if full.
+
+        The array must not be modified until :meth:`wait` is called.
+        """
+        char = array.dtype.char
+        if char not in _supported_dtypes:
+            raise TypeError(f'Unknown dtype {array.dtype} for NCCL')
+        if array.size == 0:
+            return
+        arrays, nbytes = self._pending.get(char, ([], 0))
+        arrays.append(array)
+        nbytes += array.nbytes
+        self._pending[char] = arrays, nbytes
+        if nbytes >= self._bucket_size:
+            self._launch(char)
+
+    def _launch(self, char):
+        arrays, nbytes = self._pending.pop(char)
+        stream = self._stream
+        with stream:
+            bucket = cupy.empty(nbytes, numpy.uint8)
+            bucket = bucket.view(f'u{min(arrays[0].dtype.itemsize, 8)}')
+            _copy('fusion_pack', bucket, arrays)
+            data = bucket.view(arrays[0].dtype)
+        comm_stream = _get_comm_stream()
+        comm_stream.wait_event(stream.record())
+        self._comm.all_reduce(data, data, self._op, comm_stream)
+        self._launched.append((bucket, arrays, comm_stream.record()))
+
+    def wait(self):
+        """Starts the remaining buckets and copies the results back.
+
+        The results are ready on the stream given at the creation once this
+        returns.
+        """
+        for char in list(self._pending):
+            self._launch(char)
+        stream = self._stream
+        with stream:
+            for bucket, arrays, event in self._launched:
+                stream.wait_event(event)
+                _copy('fusion_unpack', bucket, arrays)
+        self._launched = []
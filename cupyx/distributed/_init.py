@@ -11,7 +11,7 @@ _backends = {'nccl': NCCLBackend}
 
 def init_process_group(
         n_devices, rank, *, backend='nccl', host=None, port=None,
-        use_mpi=False):
+        use_mpi=False, local_size=None):
     """Start `cupyx.distributed` and obtain a communicator.
 
     This call initializes the distributed environment, it needs to be
@@ -68,6 +68,10 @@ def init_process_group(
             and uses the provided TCP server for exchanging CPU only
             information.
             defaults to `False`.
+        local_size (int): number of ranks in each node. If given, the
+            all-reduce of dense arrays is hierarchical, see
+            :class:`~cupyx.distributed.NCCLBackend`.
+            defaults to `None`.
     Returns:
         Backend: object used to perform communications, adheres to the
             :class:`~cupyx.distributed.Backend` specification:
@@ -86,4 +90,5 @@ def init_process_group(
         port = int(os.environ.get(
             'CUPYX_DISTRIBUTED_PORT', _store._DEFAULT_PORT))
 
-    return _backends[backend](n_devices, rank, host, port, use_mpi)
+    return _backends[backend](
+        n_devices, rank, host, port, use_mpi, local_size=local_size)
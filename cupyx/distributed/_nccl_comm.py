@@ -3,6 +3,7 @@ import warnings
 
 import cupy
 from cupy.cuda import nccl
+from cupyx.distributed import _fusion
 from cupyx.distributed import _store
 from cupyx.distributed._comm import _Backend
 from cupyx.scipy import sparse
@@ -43,6 +44,11 @@ else:
     _nccl_ops = {}
 
 
+# The size in bytes of the pieces that the hierarchical all-reduce pipelines
+# through its intra-node and inter-node steps.
+_hierarchical_chunk_size = 1 << 24
+
+
 def _get_nccl_dtype_and_count(array, count=None):
     dtype = array.dtype.char
     if dtype not in _nccl_dtypes:
@@ -69,12 +75,28 @@ class NCCLBackend(_Backend):
             initialization. Defaults to `13333`.
         use_mpi(bool, optional): switch between MPI and use the included TCP
             server for initialization & synchronization. Defaults to `False`.
+        local_size(int, optional): number of ranks in each node, which must
+            divide `n_devices`. The ranks `[i * local_size, (i + 1) *
+            local_size)` are assumed to be in the same node. If given, the
+            all-reduce of dense arrays is hierarchical: a reduce-scatter
+            among the ranks of each node, an all-reduce of each part among
+            the ranks with the same position in the other nodes, and an
+            all-gather among the ranks of each node, which replaces most of
+            the inter-node traffic by traffic over NVLink or PCIe. The
+            communicators of the nodes are created by the first all-reduce.
+            Defaults to `None`.
     """
 
     def __init__(self, n_devices, rank,
                  host=_store._DEFAULT_HOST, port=_store._DEFAULT_PORT,
-                 use_mpi=False):
+                 use_mpi=False, *, local_size=None):
+        if local_size is not None and (
+                local_size <= 0 or n_devices % local_size != 0):
+            raise ValueError(
+                f'local_size {local_size} must divide n_devices {n_devices}')
         super().__init__(n_devices, rank, host, port)
+        self._local_size = local_size
+        self._hierarchy = None
         self._use_mpi = _mpi_available and use_mpi
         if self._use_mpi:
             self._init_with_mpi(n_devices, rank)
@@ -95,21 +117,34 @@ class NCCLBackend(_Backend):
         self._comm = nccl.NcclCommunicator(n_devices, nccl_id, rank)
 
     def _init_with_tcp_store(self, n_devices, rank, host, port):
-        nccl_id = None
         if rank == 0:
             self._store.run(host, port)
-            nccl_id = nccl.get_unique_id()
+        nccl_id = self._exchange_nccl_id('nccl_id', 0)
+        self._comm = nccl.NcclCommunicator(n_devices, nccl_id, rank)
+
+    def _exchange_nccl_id(self, key, root):
+        # Returns the NCCL unique id created by the rank `root`. All the
+        # ranks must call it together with the same key; each group of
+        # ranks passes the root of the group.
+        nccl_id = nccl.get_unique_id() if self.rank == root else None
+        if self._use_mpi:
+            ids = dict(self._mpi_comm.allgather((self.rank, nccl_id)))
+            return ids[root]
+        key = f'{key}_{root}'
+        if nccl_id is not None:
             # get_unique_id return negative values due to cython issues
             # with bytes && c strings. We shift them by 128 to
             # make them positive and send them as bytes to the proxy store
-            shifted_nccl_id = bytes([b + 128 for b in nccl_id])
-            self._store_proxy['nccl_id'] = shifted_nccl_id
-            self._store_proxy.barrier()
-        else:
-            self._store_proxy.barrier()
-            nccl_id = self._store_proxy['nccl_id']
-            nccl_id = tuple([int(b) - 128 for b in nccl_id])
-        self._comm = nccl.NcclCommunicator(n_devices, nccl_id, rank)
+            self._store_proxy[key] = bytes([b + 128 for b in nccl_id])
+        self._store_proxy.barrier()
+        if nccl_id is None:
+            nccl_id = tuple([int(b) - 128 for b in self._store_proxy[key]])
+        return nccl_id
+
+    def _get_hierarchy(self):
+        if self._hierarchy is None:
+            self._hierarchy = _Hierarchy(self, self._local_size)
+        return self._hierarchy
 
     def _check_contiguous(self, array):
         if not array.flags.c_contiguous and not array.flags.f_contiguous:
@@ -154,6 +189,57 @@ class NCCLBackend(_Backend):
         self._dispatch_arg_type(
             'all_reduce', (in_array, out_array, op, stream))
 
+    def all_reduce_buckets(self, op='sum', stream=None,
+                           bucket_size=_fusion._default_bucket_size):
+        """Starts all-reducing many dense arrays in place in fused buckets.
+
+        Instead of a collective for each array, the arrays added to the
+        returned object are packed by one kernel into a flat buffer for each
+        dtype, whose all-reduce starts on a background stream as soon as it
+        holds ``bucket_size`` bytes, e.g. while the next gradients are
+        computed. ``wait()`` starts the remaining buckets and copies the
+        results back to the arrays with one kernel for each bucket.
+
+        Args:
+            op (str): reduction operation, see :meth:`all_reduce`.
+            stream (cupy.cuda.Stream, optional): stream on which the arrays
+                are read and written. Defaults to the current stream.
+            bucket_size (int): size in bytes above which a bucket is
+                started.
+
+        Returns:
+            object: an object with ``add(array)`` and ``wait()`` methods.
+
+        .. code-block:: python
+
+            buckets = comm.all_reduce_buckets()
+            for grad in grads:
+                buckets.add(grad)
+            buckets.wait()
+        """
+        if stream is None:
+            stream = cupy.cuda.get_current_stream()
+        return _fusion._AllReduceBuckets(self, op, stream, bucket_size)
+
+    def all_reduce_fused(self, arrays, op='sum', stream=None,
+                         bucket_size=_fusion._default_bucket_size):
+        """Performs an all reduce of many dense arrays in place.
+
+        The arrays are fused into a few collectives, see
+        :meth:`all_reduce_buckets`.
+
+        Args:
+            arrays (list of cupy.ndarray): arrays to be reduced.
+            op (str): reduction operation, see :meth:`all_reduce`.
+            stream (cupy.cuda.Stream, optional): stream on which the arrays
+                are read and written. Defaults to the current stream.
+            bucket_size (int): size in bytes of the buckets.
+        """
+        buckets = self.all_reduce_buckets(op, stream, bucket_size)
+        for array in arrays:
+            buckets.add(array)
+        buckets.wait()
+
     def reduce(self, in_array, out_array, root=0, op='sum', stream=None):
         """Performs a reduce operation.
 
@@ -309,12 +395,83 @@ class NCCLBackend(_Backend):
             self._store_proxy.barrier()
 
 
+class _Hierarchy:
+    """The communicators and streams of the hierarchical all-reduce.
+
+    ``intra`` connects the ranks of a node, and ``inter`` the ranks at the
+    same position in each node. Each has a stream of its own, so that the
+    inter-node all-reduce of a piece of the array overlaps with the
+    intra-node reduce-scatter of the next one.
+    """
+
+    def __init__(self, comm, local_size):
+        node, local_rank = divmod(comm.rank, local_size)
+        n_nodes = comm._n_devices // local_size
+        # every rank creates both communicators in the same order
+        intra_id = comm._exchange_nccl_id('nccl_id_intra', node * local_size)
+        inter_id = comm._exchange_nccl_id('nccl_id_inter', local_rank)
+        self.local_size = local_size
+        self.intra = nccl.NcclCommunicator(local_size, intra_id, local_rank)
+        self.inter = nccl.NcclCommunicator(n_nodes, inter_id, node)
+        self.intra_stream = cupy.cuda.Stream(non_blocking=True)
+        self.inter_stream = cupy.cuda.Stream(non_blocking=True)
+
+    def all_reduce(self, in_array, out_array, op, stream):
+        dtype, count = _get_nccl_dtype_and_count(in_array)
+        char = in_array.dtype.char
+        # flat views of the memory in the elements that NCCL sees
+        item = numpy.dtype(char.lower()) if char in 'FD' else in_array.dtype
+        src = cupy.ndarray((count,), item, in_array.data)
+        dst = cupy.ndarray((count,), item, out_array.data)
+        n = self.local_size
+        padded = -(-count // n) * n
+        piece = max(1, _hierarchical_chunk_size // (item.itemsize * n)) * n
+        if padded != count:
+            # the reduce-scatter needs a multiple of the number of ranks
+            send = cupy.empty(padded, item)
+            send[:count] = src
+            recv = cupy.empty(padded, item)
+        else:
+            send, recv = src, dst
+        shards = cupy.empty(padded // n, item)
+
+        start = stream.record()
+        self.intra_stream.wait_event(start)
+        self.inter_stream.wait_event(start)
+        done = []
+        for offset in range(0, padded, piece):
+            size = min(piece, padded - offset) // n
+            shard = shards[offset // n:offset // n + size]
+            self.intra.reduceScatter(
+                send.data.ptr + offset * item.itemsize, shard.data.ptr,
+                size, dtype, op, self.intra_stream.ptr)
+            self.inter_stream.wait_event(self.intra_stream.record())
+            self.inter.allReduce(
+                shard.data.ptr, shard.data.ptr, size, dtype, op,
+                self.inter_stream.ptr)
+            done.append((offset, shard, self.inter_stream.record()))
+        for offset, shard, event in done:
+            self.intra_stream.wait_event(event)
+            self.intra.allGather(
+                shard.data.ptr, recv.data.ptr + offset * item.itemsize,
+                shard.size, dtype, self.intra_stream.ptr)
+        stream.wait_event(self.intra_stream.record())
+        if recv is not dst:
+            dst[...] = recv[:count]
+
+
 class _DenseNCCLCommunicator:
 
     @classmethod
     def all_reduce(cls, comm, in_array, out_array, op='sum', stream=None):
         comm._check_contiguous(in_array)
         comm._check_contiguous(out_array)
+        if comm._local_size is not None:
+            if stream is None:
+                stream = cupy.cuda.get_current_stream()
+            op = comm._get_op(op, in_array.dtype.char)
+            comm._get_hierarchy().all_reduce(in_array, out_array, op, stream)
+            return
         stream = comm._get_stream(stream)
         dtype, count = _get_nccl_dtype_and_count(in_array)
         op = comm._get_op(op, in_array.dtype.char)
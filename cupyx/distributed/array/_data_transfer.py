@@ -2,9 +2,11 @@ import contextlib
 import dataclasses
 from typing import Any, Iterable, Iterator
 
+from cupy import _util
 from cupy._core.core import ndarray
 import cupy._creation.from_data as _creation_from_data
 import cupy._creation.basic as _creation_basic
+from cupy.cuda import runtime
 from cupy.cuda.device import Device
 from cupy.cuda.stream import Event
 from cupy.cuda.stream import Stream
@@ -54,14 +56,11 @@ if nccl.available:
         comms_list = _Communicator.initAll(list(devices))
         return {comm.device_id(): comm for comm in comms_list}
 
-    def _transfer(
+    def _transfer_default(
         src_comm: _Communicator, src_stream: Stream, src_data: _AsyncData,
         dst_comm: _Communicator, dst_stream: Stream, dst_dev: int,
     ) -> _AsyncData:
         src_dev = src_data.array.device.id
-        if src_dev == dst_dev:
-            return _AsyncData(src_data.array, src_data.ready)
-
         prev_src_stream = get_current_stream(src_dev)
         prev_dst_stream = get_current_stream(dst_dev)
         try:
@@ -101,14 +100,10 @@ else:
     ) -> dict[int, _Communicator]:
         return {dev: _Communicator() for dev in devices}
 
-    def _transfer(
+    def _transfer_default(
         src_comm: _Communicator, src_stream: Stream, src_data: _AsyncData,
         dst_comm: _Communicator, dst_stream: Stream, dst_dev: int,
     ) -> _AsyncData:
-        src_dev = src_data.array.device.id
-        if src_dev == dst_dev:
-            return _AsyncData(src_data.array, src_data.ready)
-
         with Device(dst_dev):
             prev_stream = get_current_stream()
             try:
@@ -120,3 +115,47 @@ else:
                     dst_array, dst_stream.record(), prevent_gc=src_data.array)
             finally:
                 prev_stream.use()
+
+
+@_util.memoize()
+def _can_copy_peer(src_dev: int, dst_dev: int) -> bool:
+    # The transfers between devices with peer access are copied directly by
+    # the copy engines over NVLink or PCIe, without the kernels of NCCL.
+    if not runtime.deviceCanAccessPeer(dst_dev, src_dev):
+        return False
+    with Device(dst_dev):
+        runtime._deviceEnsurePeerAccess(src_dev)
+    return True
+
+
+def _transfer_peer(
+    src_stream: Stream, src_data: _AsyncData,
+    dst_stream: Stream, dst_dev: int,
+) -> _AsyncData:
+    src_dev = src_data.array.device.id
+    with Device(src_dev), src_stream:
+        src_stream.wait_event(src_data.ready)
+        src_array = _creation_from_data.ascontiguousarray(src_data.array)
+        src_ready = src_stream.record()
+
+    with Device(dst_dev), dst_stream:
+        dst_buf = _creation_basic.empty(src_array.shape, src_array.dtype)
+        dst_stream.wait_event(src_ready)
+        runtime.memcpyPeerAsync(
+            dst_buf.data.ptr, dst_dev, src_array.data.ptr, src_dev,
+            src_array.nbytes, dst_stream.ptr)
+        return _AsyncData(dst_buf, dst_stream.record(),
+                          prevent_gc=(src_data, src_array))
+
+
+def _transfer(
+    src_comm: _Communicator, src_stream: Stream, src_data: _AsyncData,
+    dst_comm: _Communicator, dst_stream: Stream, dst_dev: int,
+) -> _AsyncData:
+    src_dev = src_data.array.device.id
+    if src_dev == dst_dev:
+        return _AsyncData(src_data.array, src_data.ready)
+    if _can_copy_peer(src_dev, dst_dev):
+        return _transfer_peer(src_stream, src_data, dst_stream, dst_dev)
+    return _transfer_default(
+        src_comm, src_stream, src_data, dst_comm, dst_stream, dst_dev)
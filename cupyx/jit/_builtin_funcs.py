@@ -220,6 +220,31 @@ class SharedMemory(BuiltinFunc):
         return Data(name, _cuda_types.Ptr(ctype))
 
 
+class LocalMemory(BuiltinFunc):
+
+    def __call__(self, dtype, size):
+        """Allocates an array in the local memory of each thread.
+
+        Unlike a pointer, the array keeps its extent, so it can be passed
+        as the items of a thread to the block-level algorithms of
+        :mod:`cupyx.jit.cub`.
+
+        Args:
+            dtype (dtype):
+                The dtype of the returned array.
+            size (int): The number of elements.
+        """
+        super().__call__()
+
+    def call_const(self, env, dtype, size):
+        name = env.get_fresh_variable_name(prefix='_lmem')
+        ctype = _cuda_typerules.to_ctype(dtype)
+        var = Data(name, _cuda_types.LocalMem(ctype, size))
+        env.decls[name] = var
+        env.locals[name] = var
+        return var
+
+
 class AtomicOp(BuiltinFunc):
 
     def __init__(self, op, dtypes):
@@ -448,6 +473,7 @@ range_ = RangeFunc()
 syncthreads = SyncThreads()
 syncwarp = SyncWarp()
 shared_memory = SharedMemory()
+local_memory = LocalMemory()
 grid = GridFunc('grid')
 gridsize = GridFunc('gridsize')
 laneid = LaneID()
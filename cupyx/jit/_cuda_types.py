@@ -244,6 +244,30 @@ class SharedMem(ArrayBase):
         return code
 
 
+class LocalMem(ArrayBase):
+
+    def __init__(self, child_type: TypeBase, size: int) -> None:
+        if not isinstance(size, int):
+            raise TypeError('size of local_memory must be integer')
+        self._size = size
+        super().__init__(child_type, 1)
+
+    def declvar(self, x: str, init: Optional['Data']) -> str:
+        if init is None:
+            return f'{self.child_type} {x}[{self._size}]'
+        # a reference keeps the extent of the array, e.g. for CUB
+        return f'{self.child_type} (&{x})[{self._size}] = {init.code}'
+
+    def __eq__(self, other: object) -> bool:
+        assert isinstance(other, TypeBase)
+        return (isinstance(other, LocalMem) and
+                self.child_type == other.child_type and
+                self._size == other._size)
+
+    def __hash__(self) -> int:
+        return hash((self.child_type, self._size))
+
+
 class Ptr(PointerBase):
 
     def __init__(self, child_type: TypeBase) -> None:
@@ -54,6 +54,91 @@ class _JitRawKernel:
         self._cache = {}
         self._cached_codes = {}
 
+    def _to_ctype(self, arg):
+        # the type of an argument of the call, or of a signature
+        if isinstance(arg, cupy.ndarray):
+            return _cuda_types.CArray.from_ndarray(arg)
+        if isinstance(arg, _cuda_types.TypeBase):
+            return arg
+        if isinstance(arg, (type, numpy.dtype, str)):
+            return Scalar(numpy.dtype(arg))
+        if isinstance(arg, tuple):
+            # (dtype, ndim[, c_contiguous[, index_32_bits]])
+            if not 2 <= len(arg) <= 4:
+                raise ValueError(
+                    'an array type must be (dtype, ndim[, c_contiguous'
+                    f'[, index_32_bits]]) (actual: {arg})')
+            dtype, ndim, c_contiguous, index_32_bits = arg + (
+                True, True)[len(arg) - 2:]
+            return _cuda_types.CArray(
+                dtype, ndim, bool(c_contiguous), bool(index_32_bits))
+        if numpy.isscalar(arg):
+            return _cuda_typerules.get_ctype_from_scalar(self._mode, arg)
+        raise TypeError(f'{type(arg)} is not supported for RawKernel')
+
+    def _get_kernel(self, in_types, device_id):
+        kern, enable_cg = self._cache.get((in_types, device_id), (None, None))
+        if kern is None:
+            result = self._cached_codes.get(in_types)
+            if result is None:
+                result = _compile.transpile(
+                    self._func,
+                    ['extern "C"', '__global__'],
+                    self._mode,
+                    in_types,
+                    _cuda_types.void,
+                )
+                self._cached_codes[in_types] = result
+
+            fname = result.func_name
+            enable_cg = result.enable_cooperative_groups
+            options = result.options
+            backend = result.backend
+            if backend == 'nvcc':
+                options += ('-DCUPY_JIT_NVCC',)
+            jitify = result.jitify
+            module = core.compile_with_cache(
+                source=result.code,
+                options=options,
+                backend=backend,
+                jitify=jitify)
+            kern = module.get_function(fname)
+            self._cache[(in_types, device_id)] = (kern, enable_cg)
+        return kern, enable_cg
+
+    def specialize(self, *signatures):
+        """Compiles the kernel ahead of its calls.
+
+        The kernel is transpiled and compiled for each signature on the
+        current device, so that the first calls with these types do not
+        compile. The binaries are also stored in the kernel cache on disk
+        (see ``CUPY_CACHE_DIR``), so running this method once, e.g. at
+        build time, also avoids the compilation by NVRTC in the later
+        processes.
+
+        Args:
+            signatures (tuple):
+                The types of the arguments. An argument is given by
+                an example value (a ``cupy.ndarray`` or a scalar), a dtype
+                for a scalar, or ``(dtype, ndim[, c_contiguous[,
+                index_32_bits]])`` for an array, where the flags default
+                to ``True``. The flags must match the arrays of the calls,
+                as ``index_32_bits`` does for arrays of fewer than
+                ``2**31`` elements.
+
+        Returns:
+            _JitRawKernel: The kernel itself.
+
+        .. seealso:: :func:`cupyx.jit.rawkernel`
+        """
+        if self._device:
+            raise TypeError('a device function cannot be specialized')
+        device_id = cupy.cuda.get_device_id()
+        for signature in signatures:
+            in_types = tuple([self._to_ctype(x) for x in signature])
+            self._get_kernel(in_types, device_id)
+        return self
+
     def __call__(
             self, grid, block, args, shared_mem=0, stream=None):
         """Calls the CUDA kernel.
@@ -87,34 +172,7 @@ class _JitRawKernel:
             in_types.append(t)
         in_types = tuple(in_types)
         device_id = cupy.cuda.get_device_id()
-
-        kern, enable_cg = self._cache.get((in_types, device_id), (None, None))
-        if kern is None:
-            result = self._cached_codes.get(in_types)
-            if result is None:
-                result = _compile.transpile(
-                    self._func,
-                    ['extern "C"', '__global__'],
-                    self._mode,
-                    in_types,
-                    _cuda_types.void,
-                )
-                self._cached_codes[in_types] = result
-
-            fname = result.func_name
-            enable_cg = result.enable_cooperative_groups
-            options = result.options
-            backend = result.backend
-            if backend == 'nvcc':
-                options += ('-DCUPY_JIT_NVCC',)
-            jitify = result.jitify
-            module = core.compile_with_cache(
-                source=result.code,
-                options=options,
-                backend=backend,
-                jitify=jitify)
-            kern = module.get_function(fname)
-            self._cache[(in_types, device_id)] = (kern, enable_cg)
+        kern, enable_cg = self._get_kernel(in_types, device_id)
 
         new_args = []
         for a, t in zip(args, in_types):
@@ -167,14 +225,26 @@ class _JitRawKernel:
         return next(iter(codes.values()))
 
 
-def rawkernel(*, mode='cuda', device=False):
+def rawkernel(*, mode='cuda', device=False, signatures=None):
     """A decorator compiles a Python function into CUDA kernel.
+
+    Args:
+        mode (str): ``'cuda'`` or ``'numpy'``, which selects the types of
+            Python scalars.
+        device (bool): If ``True``, the function is a device function.
+        signatures (list of tuple): If given, the kernel is compiled for
+            each of these types of arguments when it is decorated, e.g. at
+            import time, instead of at its first call. See
+            :meth:`~cupyx.jit._interface._JitRawKernel.specialize`.
     """
     cupy._util.experimental('cupyx.jit.rawkernel')
 
     def wrapper(func):
-        return functools.update_wrapper(
+        kernel = functools.update_wrapper(
             _JitRawKernel(func, mode, device), func)
+        if signatures is not None:
+            kernel.specialize(*signatures)
+        return kernel
     return wrapper
 
 
@@ -17,7 +17,7 @@ class _ClassTemplate:
             return self._class_type(args)
 
 
-def _include_cub(env):
+def _include_cub(env, header='block/block_reduce.cuh'):
     if _runtime.is_hip:
         env.generated.add_code('#include <hipcub/hipcub.hpp>')
         env.generated.backend = 'nvcc'
@@ -27,7 +27,7 @@ def _include_cub(env):
         # hard time. We only include what we need (for block-/warp- level
         # algorithms).
         # WAR: warp_reduce.cuh is implicitly included.
-        env.generated.add_code('#include <cub/block/block_reduce.cuh>')
+        env.generated.add_code(f'#include <cub/{header}>')
         env.generated.backend = 'nvrtc'
         env.generated.jitify = False
 
@@ -39,7 +39,7 @@ def _get_cub_namespace():
 class _TempStorageType(_cuda_types.TypeBase):
 
     def __init__(self, parent_type):
-        assert isinstance(parent_type, _CubReduceBaseType)
+        assert isinstance(parent_type, _CubBaseType)
         self.parent_type = parent_type
         super().__init__()
 
@@ -47,34 +47,105 @@ class _TempStorageType(_cuda_types.TypeBase):
         return f'typename {self.parent_type}::TempStorage'
 
 
-class _CubReduceBaseType(_cuda_types.TypeBase):
+class _CubBaseType(_cuda_types.TypeBase):
+
+    _header = 'block/block_reduce.cuh'
 
     def _instantiate(self, env, temp_storage) -> _internal_types.Data:
-        _include_cub(env)
+        _include_cub(env, self._header)
         if temp_storage.ctype != self.TempStorage:
             raise TypeError(
                 f'Invalid temp_storage type {temp_storage.ctype}. '
                 f'({self.TempStorage} is expected.)')
         return _internal_types.Data(f'{self}({temp_storage.code})', self)
 
-    @_internal_types.wraps_class_method
-    def Sum(self, env, instance, input) -> _internal_types.Data:
+    def _check_input(self, input):
         if input.ctype != self.T:
             raise TypeError(
                 f'Invalid input type {input.ctype}. ({self.T} is expected.)')
+
+    def _check_items(self, items):
+        expected = _cuda_types.LocalMem(self.T, self.ITEMS_PER_THREAD)
+        if items.ctype != expected:
+            raise TypeError(
+                f'Invalid items type {items.ctype}. (an array of '
+                f'{self.ITEMS_PER_THREAD} {self.T} allocated by '
+                'jit.local_memory is expected.)')
+
+    def _check_pointer(self, block_ptr):
+        if not (isinstance(block_ptr.ctype, _cuda_types.PointerBase)
+                and block_ptr.ctype.child_type == self.T):
+            raise TypeError(
+                f'Invalid block pointer type {block_ptr.ctype}. (a pointer '
+                f'to {self.T} is expected.)')
+
+
+class _CubReduceBaseType(_CubBaseType):
+
+    @_internal_types.wraps_class_method
+    def Sum(self, env, instance, input) -> _internal_types.Data:
+        self._check_input(input)
         return _internal_types.Data(
             f'{instance.code}.Sum({input.code})', input.ctype)
 
     @_internal_types.wraps_class_method
     def Reduce(self, env, instance, input, reduction_op):
-        if input.ctype != self.T:
-            raise TypeError(
-                f'Invalid input type {input.ctype}. ({self.T} is expected.)')
+        self._check_input(input)
         return _internal_types.Data(
             f'{instance.code}.Reduce({input.code}, {reduction_op.code})',
             input.ctype)
 
 
+# The scans of CUB write their output to a reference, which the kernels
+# return instead.
+_scan_code = """
+template <typename S, typename T>
+__device__ T _cupy_jit_cub_inclusive_sum(S&& s, T x) {
+    T y; s.InclusiveSum(x, y); return y;
+}
+template <typename S, typename T>
+__device__ T _cupy_jit_cub_exclusive_sum(S&& s, T x) {
+    T y; s.ExclusiveSum(x, y); return y;
+}
+template <typename S, typename T, typename Op>
+__device__ T _cupy_jit_cub_inclusive_scan(S&& s, T x, Op op) {
+    T y; s.InclusiveScan(x, y, op); return y;
+}
+template <typename S, typename T, typename Op>
+__device__ T _cupy_jit_cub_exclusive_scan(S&& s, T x, T init, Op op) {
+    T y; s.ExclusiveScan(x, y, init, op); return y;
+}
+"""
+
+
+class _CubScanBaseType(_CubBaseType):
+
+    def _scan(self, env, name, instance, *args):
+        env.generated.add_code(_scan_code)
+        self._check_input(args[0])
+        codes = ', '.join([instance.code] + [a.code for a in args])
+        return _internal_types.Data(
+            f'_cupy_jit_cub_{name}({codes})', args[0].ctype)
+
+    @_internal_types.wraps_class_method
+    def InclusiveSum(self, env, instance, input) -> _internal_types.Data:
+        return self._scan(env, 'inclusive_sum', instance, input)
+
+    @_internal_types.wraps_class_method
+    def ExclusiveSum(self, env, instance, input) -> _internal_types.Data:
+        return self._scan(env, 'exclusive_sum', instance, input)
+
+    @_internal_types.wraps_class_method
+    def InclusiveScan(self, env, instance, input, scan_op):
+        return self._scan(env, 'inclusive_scan', instance, input, scan_op)
+
+    @_internal_types.wraps_class_method
+    def ExclusiveScan(self, env, instance, input, initial_value, scan_op):
+        initial_value = _internal_types.Data.init(initial_value, env)
+        return self._scan(
+            env, 'exclusive_scan', instance, input, initial_value, scan_op)
+
+
 class _WarpReduceType(_CubReduceBaseType):
 
     def __init__(self, T) -> None:
@@ -100,8 +171,249 @@ class _BlockReduceType(_CubReduceBaseType):
         return f'{namespace}::BlockReduce<{self.T}, {self.BLOCK_DIM_X}>'
 
 
+class _WarpScanType(_CubScanBaseType):
+
+    _header = 'warp/warp_scan.cuh'
+
+    def __init__(self, T) -> None:
+        self.T = _cuda_typerules.to_ctype(T)
+        self.TempStorage = _TempStorageType(self)
+        super().__init__()
+
+    def __str__(self) -> str:
+        namespace = _get_cub_namespace()
+        return f'{namespace}::WarpScan<{self.T}>'
+
+
+class _BlockScanType(_CubScanBaseType):
+
+    _header = 'block/block_scan.cuh'
+
+    def __init__(self, T, BLOCK_DIM_X: int) -> None:
+        self.T = _cuda_typerules.to_ctype(T)
+        self.BLOCK_DIM_X = BLOCK_DIM_X
+        self.TempStorage = _TempStorageType(self)
+        super().__init__()
+
+    def __str__(self) -> str:
+        namespace = _get_cub_namespace()
+        return f'{namespace}::BlockScan<{self.T}, {self.BLOCK_DIM_X}>'
+
+
+class _Algorithm:
+
+    def __init__(self, name):
+        self.name = name
+
+    def __str__(self) -> str:
+        return f'{_get_cub_namespace()}::{self.name}'
+
+    def __repr__(self) -> str:
+        return f'cupyx.jit.cub.{self.name}'
+
+
+BLOCK_LOAD_DIRECT = _Algorithm('BLOCK_LOAD_DIRECT')
+BLOCK_LOAD_STRIPED = _Algorithm('BLOCK_LOAD_STRIPED')
+BLOCK_LOAD_VECTORIZE = _Algorithm('BLOCK_LOAD_VECTORIZE')
+BLOCK_LOAD_TRANSPOSE = _Algorithm('BLOCK_LOAD_TRANSPOSE')
+BLOCK_LOAD_WARP_TRANSPOSE = _Algorithm('BLOCK_LOAD_WARP_TRANSPOSE')
+BLOCK_STORE_DIRECT = _Algorithm('BLOCK_STORE_DIRECT')
+BLOCK_STORE_STRIPED = _Algorithm('BLOCK_STORE_STRIPED')
+BLOCK_STORE_VECTORIZE = _Algorithm('BLOCK_STORE_VECTORIZE')
+BLOCK_STORE_TRANSPOSE = _Algorithm('BLOCK_STORE_TRANSPOSE')
+BLOCK_STORE_WARP_TRANSPOSE = _Algorithm('BLOCK_STORE_WARP_TRANSPOSE')
+BLOCK_HISTO_SORT = _Algorithm('BLOCK_HISTO_SORT')
+BLOCK_HISTO_ATOMIC = _Algorithm('BLOCK_HISTO_ATOMIC')
+
+
+def _check_algorithm(algorithm, prefix):
+    if not (isinstance(algorithm, _Algorithm)
+            and algorithm.name.startswith(prefix)):
+        raise TypeError(f'Invalid algorithm {algorithm!r}. (one of '
+                        f'cupyx.jit.cub.{prefix}* is expected.)')
+
+
+class _BlockLoadType(_CubBaseType):
+
+    _header = 'block/block_load.cuh'
+
+    def __init__(self, T, BLOCK_DIM_X: int, ITEMS_PER_THREAD: int,
+                 ALGORITHM=BLOCK_LOAD_DIRECT) -> None:
+        _check_algorithm(ALGORITHM, 'BLOCK_LOAD_')
+        self.T = _cuda_typerules.to_ctype(T)
+        self.BLOCK_DIM_X = BLOCK_DIM_X
+        self.ITEMS_PER_THREAD = ITEMS_PER_THREAD
+        self.ALGORITHM = ALGORITHM
+        self.TempStorage = _TempStorageType(self)
+        super().__init__()
+
+    def __str__(self) -> str:
+        namespace = _get_cub_namespace()
+        return (f'{namespace}::BlockLoad<{self.T}, {self.BLOCK_DIM_X}, '
+                f'{self.ITEMS_PER_THREAD}, {self.ALGORITHM}>')
+
+    @_internal_types.wraps_class_method
+    def Load(self, env, instance, block_ptr, items, valid_items=None,
+             oob_default=None) -> _internal_types.Data:
+        self._check_pointer(block_ptr)
+        self._check_items(items)
+        args = [block_ptr, items]
+        if valid_items is not None:
+            args.append(_internal_types.Data.init(valid_items, env))
+        if oob_default is not None:
+            args.append(_internal_types.Data.init(oob_default, env))
+        codes = ', '.join([a.code for a in args])
+        return _internal_types.Data(
+            f'{instance.code}.Load({codes})', _cuda_types.void)
+
+
+class _BlockStoreType(_CubBaseType):
+
+    _header = 'block/block_store.cuh'
+
+    def __init__(self, T, BLOCK_DIM_X: int, ITEMS_PER_THREAD: int,
+                 ALGORITHM=BLOCK_STORE_DIRECT) -> None:
+        _check_algorithm(ALGORITHM, 'BLOCK_STORE_')
+        self.T = _cuda_typerules.to_ctype(T)
+        self.BLOCK_DIM_X = BLOCK_DIM_X
+        self.ITEMS_PER_THREAD = ITEMS_PER_THREAD
+        self.ALGORITHM = ALGORITHM
+        self.TempStorage = _TempStorageType(self)
+        super().__init__()
+
+    def __str__(self) -> str:
+        namespace = _get_cub_namespace()
+        return (f'{namespace}::BlockStore<{self.T}, {self.BLOCK_DIM_X}, '
+                f'{self.ITEMS_PER_THREAD}, {self.ALGORITHM}>')
+
+    @_internal_types.wraps_class_method
+    def Store(self, env, instance, block_ptr, items,
+              valid_items=None) -> _internal_types.Data:
+        self._check_pointer(block_ptr)
+        self._check_items(items)
+        args = [block_ptr, items]
+        if valid_items is not None:
+            args.append(_internal_types.Data.init(valid_items, env))
+        codes = ', '.join([a.code for a in args])
+        return _internal_types.Data(
+            f'{instance.code}.Store({codes})', _cuda_types.void)
+
+
+class _BlockRadixSortType(_CubBaseType):
+
+    _header = 'block/block_radix_sort.cuh'
+
+    def __init__(self, KeyT, BLOCK_DIM_X: int, ITEMS_PER_THREAD: int,
+                 ValueT=None) -> None:
+        self.T = _cuda_typerules.to_ctype(KeyT)
+        self.BLOCK_DIM_X = BLOCK_DIM_X
+        self.ITEMS_PER_THREAD = ITEMS_PER_THREAD
+        self.ValueT = (None if ValueT is None
+                       else _cuda_typerules.to_ctype(ValueT))
+        self.TempStorage = _TempStorageType(self)
+        super().__init__()
+
+    def __str__(self) -> str:
+        namespace = _get_cub_namespace()
+        value = '' if self.ValueT is None else f', {self.ValueT}'
+        return (f'{namespace}::BlockRadixSort<{self.T}, {self.BLOCK_DIM_X}, '
+                f'{self.ITEMS_PER_THREAD}{value}>')
+
+    def _sort(self, env, name, instance, keys, values):
+        self._check_items(keys)
+        args = [keys]
+        if values is not None:
+            if self.ValueT is None:
+                raise TypeError('values need the ValueT of the template.')
+            expected = _cuda_types.LocalMem(self.ValueT, self.ITEMS_PER_THREAD)
+            if values.ctype != expected:
+                raise TypeError(
+                    f'Invalid values type {values.ctype}. (an array of '
+                    f'{self.ITEMS_PER_THREAD} {self.ValueT} is expected.)')
+            args.append(values)
+        codes = ', '.join([a.code for a in args])
+        return _internal_types.Data(
+            f'{instance.code}.{name}({codes})', _cuda_types.void)
+
+    @_internal_types.wraps_class_method
+    def Sort(self, env, instance, keys, values=None):
+        return self._sort(env, 'Sort', instance, keys, values)
+
+    @_internal_types.wraps_class_method
+    def SortDescending(self, env, instance, keys, values=None):
+        return self._sort(env, 'SortDescending', instance, keys, values)
+
+    @_internal_types.wraps_class_method
+    def SortBlockedToStriped(self, env, instance, keys, values=None):
+        return self._sort(env, 'SortBlockedToStriped', instance, keys, values)
+
+    @_internal_types.wraps_class_method
+    def SortDescendingBlockedToStriped(self, env, instance, keys,
+                                       values=None):
+        return self._sort(
+            env, 'SortDescendingBlockedToStriped', instance, keys, values)
+
+
+class _BlockHistogramType(_CubBaseType):
+
+    _header = 'block/block_histogram.cuh'
+
+    def __init__(self, T, BLOCK_DIM_X: int, ITEMS_PER_THREAD: int,
+                 BINS: int, ALGORITHM=BLOCK_HISTO_SORT) -> None:
+        _check_algorithm(ALGORITHM, 'BLOCK_HISTO_')
+        self.T = _cuda_typerules.to_ctype(T)
+        self.BLOCK_DIM_X = BLOCK_DIM_X
+        self.ITEMS_PER_THREAD = ITEMS_PER_THREAD
+        self.BINS = BINS
+        self.ALGORITHM = ALGORITHM
+        self.TempStorage = _TempStorageType(self)
+        super().__init__()
+
+    def __str__(self) -> str:
+        namespace = _get_cub_namespace()
+        return (f'{namespace}::BlockHistogram<{self.T}, {self.BLOCK_DIM_X}, '
+                f'{self.ITEMS_PER_THREAD}, {self.BINS}, {self.ALGORITHM}>')
+
+    def _check_histogram(self, histogram):
+        if not (isinstance(histogram.ctype, _cuda_types.PointerBase)
+                and isinstance(histogram.ctype.child_type, _cuda_types.Scalar)
+                and histogram.ctype.child_type.dtype.kind in 'iu'):
+            raise TypeError(
+                f'Invalid histogram type {histogram.ctype}. (a pointer to '
+                f'{self.BINS} integer counters is expected.)')
+
+    @_internal_types.wraps_class_method
+    def InitHistogram(self, env, instance, histogram):
+        self._check_histogram(histogram)
+        return _internal_types.Data(
+            f'{instance.code}.InitHistogram({histogram.code})',
+            _cuda_types.void)
+
+    @_internal_types.wraps_class_method
+    def Histogram(self, env, instance, items, histogram):
+        self._check_items(items)
+        self._check_histogram(histogram)
+        return _internal_types.Data(
+            f'{instance.code}.Histogram({items.code}, {histogram.code})',
+            _cuda_types.void)
+
+    @_internal_types.wraps_class_method
+    def Composite(self, env, instance, items, histogram):
+        self._check_items(items)
+        self._check_histogram(histogram)
+        return _internal_types.Data(
+            f'{instance.code}.Composite({items.code}, {histogram.code})',
+            _cuda_types.void)
+
+
 WarpReduce = _ClassTemplate(_WarpReduceType)
 BlockReduce = _ClassTemplate(_BlockReduceType)
+WarpScan = _ClassTemplate(_WarpScanType)
+BlockScan = _ClassTemplate(_BlockScanType)
+BlockLoad = _ClassTemplate(_BlockLoadType)
+BlockStore = _ClassTemplate(_BlockStoreType)
+BlockRadixSort = _ClassTemplate(_BlockRadixSortType)
+BlockHistogram = _ClassTemplate(_BlockHistogramType)
 
 
 class _CubFunctor(_internal_types.BuiltinFunc):
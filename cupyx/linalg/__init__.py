@@ -1,3 +1,6 @@
 # "NOQA" to suppress flake8 warning
 from cupyx.linalg import sparse  # NOQA
+from cupyx.linalg._epilogue import matmul_epilogue  # NOQA
 from cupyx.linalg._solve import invh  # NOQA
+from cupyx.linalg._randomized import randomized_svd  # NOQA
+from cupyx.linalg._randomized import SVDSketch  # NOQA
@@ -0,0 +1,89 @@
+import cupy
+
+
+_activations = {
+    None: 'v',
+    'relu': 'v > 0 ? v : (A)0',
+    'gelu': 'v * (A)0.5 * ((A)1 + erf(v * (A)0.70710678118654752))',
+    'gelu_tanh': ('v * (A)0.5 * ((A)1 + tanh((A)0.79788456080286536 * '
+                  '(v + (A)0.044715 * v * v * v)))'),
+    'sigmoid': '(A)1 / ((A)1 + exp(-v))',
+}
+
+# float16 is computed in single precision
+_preamble = '''
+template<typename T> struct cupyx_epilogue_acc { typedef float type; };
+template<> struct cupyx_epilogue_acc<double> { typedef double type; };
+'''
+
+
+@cupy.memoize(for_each_device=True)
+def _get_epilogue_kernel(activation, with_bias):
+    if with_bias:
+        in_params = 'T x, T bias'
+        value = '(A)x + (A)bias'
+    else:
+        in_params = 'T x'
+        value = '(A)x'
+    return cupy.ElementwiseKernel(
+        in_params, 'T y',
+        '''
+        typedef typename cupyx_epilogue_acc<T>::type A;
+        A v = {};
+        y = (T)({});
+        '''.format(value, _activations[activation]),
+        'cupyx_matmul_epilogue_{}{}'.format(
+            activation, '_bias' if with_bias else ''),
+        preamble=_preamble)
+
+
+def matmul_epilogue(a, b, bias=None, activation=None, *, out=None):
+    """Computes ``activation(a @ b + bias)`` as a matrix product epilogue.
+
+    The matrix product is computed by :func:`cupy.matmul`, and the bias and
+    the activation are then applied in place by a single elementwise kernel,
+    so that the product is only read and written once more. The epilogue is
+    not fused into the product yet: that needs the cuBLASLt or hipBLASLt
+    matmul, which CuPy does not bind, and this is the fallback it would
+    keep where Lt is not available.
+
+    Args:
+        a (cupy.ndarray): The left operand, as for :func:`cupy.matmul`.
+        b (cupy.ndarray): The right operand, as for :func:`cupy.matmul`.
+        bias (cupy.ndarray, optional): The bias added to the product. It is
+            broadcast against the product, e.g. a bias of shape ``(n,)`` is
+            added to each row.
+        activation (str, optional): The activation applied after the bias:
+            ``'relu'``, ``'gelu'``, ``'gelu_tanh'`` (the tanh approximation
+            of GELU) or ``'sigmoid'``. ``None`` (default) applies nothing.
+        out (cupy.ndarray, optional): The output array, as for
+            :func:`cupy.matmul`.
+
+    Returns:
+        cupy.ndarray: The result. Its dtype is the one of ``a @ b``, which
+        must be ``float16``, ``float32`` or ``float64``.
+
+    .. note::
+        ``float16`` results are computed in single precision in the
+        epilogue. This function is specific to CuPy.
+
+    .. seealso:: :func:`cupy.matmul`
+    """
+    if activation not in _activations:
+        raise ValueError('unknown activation: {}'.format(activation))
+    a = cupy.asarray(a)
+    b = cupy.asarray(b)
+    dtype = cupy.result_type(a, b)
+    if dtype.char not in 'efd':
+        raise TypeError('dtype is not supported: {}'.format(dtype))
+    y = cupy.matmul(a, b, out=out)
+    if bias is None:
+        if activation is not None:
+            _get_epilogue_kernel(activation, False)(y, y)
+        return y
+    bias = cupy.asarray(bias, dtype=y.dtype)
+    if cupy.broadcast(y, bias).shape != y.shape:
+        raise ValueError('bias of shape {} cannot be broadcast to {}'.format(
+            bias.shape, y.shape))
+    _get_epilogue_kernel(activation, True)(y, bias, y)
+    return y
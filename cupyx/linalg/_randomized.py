@@ -0,0 +1,204 @@
+import numpy
+
+import cupy
+from cupy.linalg import _util
+
+
+def _gaussian(rng, shape, dtype):
+    # a Gaussian sketch, with independent real and imaginary parts for a
+    # complex dtype
+    real = dtype.char.lower()
+    g = rng.standard_normal(shape, dtype=real)
+    if dtype.kind == 'c':
+        g = g + 1j * rng.standard_normal(shape, dtype=real)
+    return g.astype(dtype, copy=False)
+
+
+def _orthonormal(y):
+    return cupy.linalg.qr(y)[0]
+
+
+def _check_rank(k, n_samples, shape):
+    if k <= 0:
+        raise ValueError('k must be positive (actual: {})'.format(k))
+    if n_samples > min(shape):
+        raise ValueError(
+            'k + n_oversamples must not exceed min(m, n) (actual: {} for '
+            'shape {})'.format(n_samples, shape))
+
+
+def randomized_svd(a, k, *, n_oversamples=10, n_iter=4, random_state=None,
+                   compute_uv=True):
+    """Computes a rank-``k`` approximation of the SVD of a matrix.
+
+    The range of ``a`` is found by multiplying it with a Gaussian matrix of
+    ``k + n_oversamples`` columns, followed by ``n_iter`` power iterations
+    (each of them orthonormalized with a QR decomposition) to sharpen the
+    decay of the singular values, as in the randomized range finder of
+    Halko et al. The SVD of the projection of ``a`` on this range then gives
+    the ``k`` largest singular triplets. Only products with ``a`` and
+    decompositions of matrices of ``k + n_oversamples`` columns are
+    computed, which is much cheaper than :func:`cupy.linalg.svd` for
+    ``k << min(m, n)``.
+
+    Args:
+        a (cupy.ndarray or cupyx.scipy.sparse.spmatrix): The matrix of shape
+            ``(m, n)``.
+        k (int): The number of singular values and vectors.
+        n_oversamples (int): The number of additional samples of the range,
+            which improve the accuracy.
+        n_iter (int): The number of power iterations. More iterations are
+            needed when the singular values decay slowly.
+        random_state (None, int or cupy.random.Generator): The seed or the
+            generator of the sketch.
+        compute_uv (bool): If ``False``, only the singular values are
+            returned.
+
+    Returns:
+        cupy.ndarray or tuple of cupy.ndarray: The singular values ``s`` of
+        shape ``(k,)`` in descending order, or ``(u, s, vh)`` where ``u`` is
+        of shape ``(m, k)`` and ``vh`` of shape ``(k, n)``.
+
+    .. seealso:: :func:`cupy.linalg.svd`
+
+    Reference:
+        N. Halko, P. G. Martinsson and J. A. Tropp, "Finding structure with
+        randomness: Probabilistic algorithms for constructing approximate
+        matrix decompositions", SIAM Review 53(2) (2011).
+    """
+    if a.ndim != 2:
+        raise ValueError('expected 2D (shape: {})'.format(a.shape))
+    dtype, out_dtype = _util.linalg_common_type(a)
+    if a.dtype != dtype:
+        a = a.astype(dtype)
+    m, n = a.shape
+    n_samples = k + n_oversamples
+    _check_rank(k, n_samples, a.shape)
+    rng = cupy.random.default_rng(random_state)
+    ah = a.conj().T
+
+    q = _orthonormal(a @ _gaussian(rng, (n, n_samples), dtype))
+    for _ in range(n_iter):
+        q = _orthonormal(a @ _orthonormal(ah @ q))
+    # b = q^H a, computed as (a^H q)^H for a sparse a
+    b = (ah @ q).conj().T
+    if not compute_uv:
+        return cupy.linalg.svd(b, compute_uv=False)[:k].astype(
+            out_dtype.char.lower(), copy=False)
+    ub, s, vh = cupy.linalg.svd(b, full_matrices=False)
+    u = q @ ub[:, :k]
+    return (u.astype(out_dtype, copy=False),
+            s[:k].astype(out_dtype.char.lower(), copy=False),
+            vh[:k].astype(out_dtype, copy=False))
+
+
+class SVDSketch(object):
+    """A single-pass sketch of a matrix that arrives in blocks of rows.
+
+    Each block ``a_i`` of rows updates the range sketch ``y_i = a_i @ g``
+    of ``s = k + n_oversamples`` columns and the co-range sketch
+    ``w = sum(p_i @ a_i)`` of ``2 * s + 1`` rows, where ``g`` and the
+    ``p_i`` are Gaussian matrices, after which the block is no longer
+    needed. :meth:`svd` finds the rank-``k`` approximation of the SVD from
+    the sketches, as in the single-pass algorithm of Tropp et al. Only the
+    range sketch grows with the number of rows, and it is not kept at all
+    for the singular values only.
+
+    Args:
+        n (int): The number of columns of the matrix.
+        k (int): The number of singular values and vectors.
+        n_oversamples (int): The number of additional samples of the range.
+        dtype: The dtype of the matrix, one of float32, float64, complex64
+            and complex128.
+        random_state (None, int or cupy.random.Generator): The seed or the
+            generator of the sketches.
+        compute_uv (bool): If ``False``, only the singular values are found
+            and the memory used does not depend on the number of rows.
+
+    .. seealso:: :func:`cupyx.linalg.randomized_svd`
+
+    Reference:
+        J. A. Tropp, A. Yurtsever, M. Udell and V. Cevher, "Practical Sketching
+        Algorithms for Low-Rank Matrix Approximation", SIAM J. Matrix Anal.
+        Appl. 38(4) (2017).
+    """
+
+    def __init__(self, n, k, *, n_oversamples=10, dtype=numpy.float64,
+                 random_state=None, compute_uv=True):
+        dtype = numpy.dtype(dtype)
+        if dtype.char not in 'fdFD':
+            raise TypeError('unsupported dtype (actual: {})'.format(dtype))
+        n_samples = k + n_oversamples
+        _check_rank(k, n_samples, (n_samples, n))
+        self.n = n
+        self.k = k
+        self.dtype = dtype
+        self.compute_uv = compute_uv
+        self._rng = cupy.random.default_rng(random_state)
+        self._g = _gaussian(self._rng, (n, n_samples), dtype)
+        self._n_corange = 2 * n_samples + 1
+        self._w = cupy.zeros((self._n_corange, n), dtype=dtype)
+        self._py = cupy.zeros((self._n_corange, n_samples), dtype=dtype)
+        # the blocks of y, or the R factor of y without compute_uv
+        self._y = []
+        self._r = None
+        self._m = 0
+
+    @property
+    def shape(self):
+        """The shape of the rows seen so far."""
+        return self._m, self.n
+
+    def update(self, a):
+        """Adds a block of rows to the sketches.
+
+        Args:
+            a (cupy.ndarray): The next rows, of shape ``(m_i, n)``.
+
+        Returns:
+            SVDSketch: The sketch itself.
+        """
+        if a.ndim != 2 or a.shape[1] != self.n:
+            raise ValueError('expected rows of {} columns (shape: {})'.format(
+                self.n, a.shape))
+        a = a.astype(self.dtype, copy=False)
+        y = a @ self._g
+        p = _gaussian(self._rng, (self._n_corange, a.shape[0]), self.dtype)
+        self._w += p @ a
+        self._py += p @ y
+        if self.compute_uv:
+            self._y.append(y)
+        elif self._r is None:
+            self._r = cupy.linalg.qr(y, mode='r')
+        else:
+            y = cupy.concatenate([self._r, y])
+            self._r = cupy.linalg.qr(y, mode='r')
+        self._m += a.shape[0]
+        return self
+
+    def svd(self):
+        """Computes the approximate SVD of the rows seen so far.
+
+        Returns:
+            cupy.ndarray or tuple of cupy.ndarray: The singular values ``s``
+            of shape ``(k,)`` in descending order, or ``(u, s, vh)`` where
+            ``u`` is of shape ``(m, k)`` and ``vh`` of shape ``(k, n)``.
+        """
+        from cupyx.scipy.linalg import solve_triangular
+
+        n_samples = self._g.shape[1]
+        if self._m < n_samples:
+            raise ValueError('at least {} rows are needed (actual: {})'.format(
+                n_samples, self._m))
+        if self.compute_uv:
+            q, r = cupy.linalg.qr(cupy.concatenate(self._y))
+        else:
+            r = self._r[:n_samples]
+        # p @ q = (p @ y) @ r^-1, and q^H a is the least-squares solution of
+        # (p @ q) x = p @ a
+        pq = solve_triangular(r, self._py.T, trans='T').T
+        x = cupy.linalg.lstsq(pq, self._w, rcond=None)[0]
+        if not self.compute_uv:
+            return cupy.linalg.svd(x, compute_uv=False)[:self.k]
+        ux, s, vh = cupy.linalg.svd(x, full_matrices=False)
+        return q @ ux[:, :self.k], s[:self.k], vh[:self.k]
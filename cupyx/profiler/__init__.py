@@ -1,5 +1,7 @@
 import contextlib as _contextlib
+from cupy.cuda import function as _function
 from cupy.cuda import runtime as _runtime
+from cupyx.profiler._kernel_stats import kernel_stats  # NOQA
 from cupyx.profiler._time import benchmark  # NOQA
 from cupyx.profiler._time_range import time_range  # NOQA
 
@@ -29,3 +31,43 @@ def profile():
         yield
     finally:
         _runtime.profilerStop()
+
+
+@_contextlib.contextmanager
+def kernel_ranges(enabled=True):
+    """Mark every kernel launch with a range using NVTX/rocTX.
+
+    Within the with statement, each launch of a kernel compiled by CuPy
+    (elementwise and reduction kernels, :class:`cupy.RawKernel` and
+    :class:`cupy.RawModule`) and each CUB or Thrust call made by CuPy is
+    enclosed in a range. The range is named after the kernel, and lists the
+    dtypes and shapes of the arrays passed to it and the total bytes of
+    these arrays, e.g. ``cupy_add__float32_float32_float32 [float32(1000,),
+    float32(1000,), float32(1000,), 12000 bytes]``.
+
+    >>> with cupyx.profiler.kernel_ranges():
+    ...    y = x * 2 + 1
+
+    The previous setting is restored on leaving the statement. The ranges
+    can also be enabled for the whole process by setting the
+    :envvar:`CUPY_KERNEL_RANGES` environment variable to ``1``.
+
+    Args:
+        enabled (bool): If ``False``, the ranges are disabled instead within
+            the with statement.
+
+    .. note::
+        The setting is global to the process, not to the current thread.
+        Describing each launch adds a few microseconds of host overhead
+        while the ranges are enabled; the disabled mode costs a single
+        check per launch.
+
+    .. seealso:: :func:`cupyx.profiler.time_range`,
+        :func:`cupyx.profiler.kernel_stats`
+    """
+    previous = _function._kernel_ranges_enabled()
+    _function._set_kernel_ranges(enabled)
+    try:
+        yield
+    finally:
+        _function._set_kernel_ranges(previous)
@@ -0,0 +1,224 @@
+import contextlib
+import json
+import threading
+
+import numpy
+
+from cupy import cuda
+from cupy.cuda import device
+from cupy.cuda import function
+from cupy_backends.cuda.api import runtime
+
+
+# The number of timed launches kept before their events are read.
+_max_pending = 1024
+
+
+def _peak_bandwidth(device_id):
+    # Returns the theoretical memory bandwidth of the device in bytes/s.
+    attrs = cuda.Device(device_id).attributes
+    try:
+        # the memory clock rate is in kHz, and the memory is double data rate
+        return (2 * attrs['MemoryClockRate'] * 1000 *
+                attrs['GlobalMemoryBusWidth'] // 8)
+    except KeyError:
+        return None
+
+
+class KernelStats:
+    """Per-kernel statistics collected by :func:`kernel_stats`.
+
+    The launches are grouped by the kernel name, the dtypes and shapes of the
+    array arguments (the signature) and the device.
+    """
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self._local = threading.local()
+        # device id -> list of free events
+        self._events = {}
+        # (key, nbytes, start event, end event)
+        self._pending = []
+        # (name, signature, device id) -> (list of times in ms, bytes)
+        self._times = {}
+
+    def _get_event(self, device_id):
+        with self._lock:
+            events = self._events.get(device_id)
+            if events:
+                return events.pop()
+        return cuda.Event()
+
+    def _start(self, name, signature, nbytes, stream):
+        # Called by the launches before the kernel is issued to the stream.
+        stack = getattr(self._local, 'stack', None)
+        if stack is None:
+            stack = self._local.stack = []
+        if runtime.streamIsCapturing(stream):
+            # the events of a graph being captured cannot be timed
+            stack.append(None)
+            return
+        device_id = device.get_device_id()
+        start = self._get_event(device_id)
+        runtime.eventRecord(start.ptr, stream)
+        stack.append(((name, signature, device_id), nbytes, start))
+
+    def _stop(self, stream):
+        stack = getattr(self._local, 'stack', None)
+        if not stack:
+            return
+        entry = stack.pop()
+        if entry is None:
+            return
+        key, nbytes, start = entry
+        end = self._get_event(key[2])
+        runtime.eventRecord(end.ptr, stream)
+        with self._lock:
+            self._pending.append((key, nbytes, start, end))
+            n_pending = len(self._pending)
+        if n_pending >= _max_pending:
+            self._resolve()
+
+    def _resolve(self):
+        # Reads the times of the pending launches and reuses their events.
+        with self._lock:
+            pending, self._pending = self._pending, []
+        for key, nbytes, start, end in pending:
+            end.synchronize()
+            elapsed = cuda.get_elapsed_time(start, end)
+            with self._lock:
+                times, total = self._times.get(key, ([], 0))
+                times.append(elapsed)
+                self._times[key] = times, total + nbytes
+                self._events.setdefault(key[2], []).extend((start, end))
+
+    def records(self):
+        """Returns the statistics of each kernel.
+
+        Returns:
+            list of dict: The statistics sorted by the total time in
+            descending order, with the following keys: ``name``,
+            ``signature``, ``device``, ``count``, ``total_ms``, ``mean_ms``,
+            ``p99_ms``, ``bytes`` (the total size of the array arguments),
+            ``bandwidth_gbs`` (the bytes per second of the kernel time, in
+            GB/s) and ``peak_bandwidth_ratio`` (its ratio to the theoretical
+            memory bandwidth of the device, or ``None`` if unknown).
+        """
+        self._resolve()
+        with self._lock:
+            times = dict(self._times)
+        peaks = {}
+        records = []
+        for (name, signature, device_id), (ts, nbytes) in times.items():
+            ts = numpy.array(ts)
+            total = float(ts.sum())
+            bandwidth = nbytes / (total * 1e-3) if total > 0 else 0.0
+            if device_id not in peaks:
+                peaks[device_id] = _peak_bandwidth(device_id)
+            peak = peaks[device_id]
+            records.append({
+                'name': name,
+                'signature': signature,
+                'device': device_id,
+                'count': len(ts),
+                'total_ms': total,
+                'mean_ms': float(ts.mean()),
+                'p99_ms': float(numpy.percentile(ts, 99)),
+                'bytes': nbytes,
+                'bandwidth_gbs': bandwidth * 1e-9,
+                'peak_bandwidth_ratio': bandwidth / peak if peak else None,
+            })
+        records.sort(key=lambda r: r['total_ms'], reverse=True)
+        return records
+
+    def to_json(self, **kwargs):
+        """Returns the statistics of :meth:`records` as a JSON string.
+
+        Args:
+            kwargs: The arguments passed to :func:`json.dumps`.
+        """
+        return json.dumps(self.records(), **kwargs)
+
+    def table(self, limit=None):
+        """Returns the statistics as a table.
+
+        Args:
+            limit (int): The number of kernels shown, in descending order of
+                the total time. All of them are shown by default.
+
+        Returns:
+            str: The table.
+        """
+        records = self.records()
+        if limit is not None:
+            records = records[:limit]
+        header = ('kernel', 'count', 'total(ms)', 'mean(ms)', 'p99(ms)',
+                  'GB/s', '%peak')
+        rows = []
+        for r in records:
+            ratio = r['peak_bandwidth_ratio']
+            rows.append((
+                '{} [{}]'.format(r['name'], r['signature']),
+                str(r['count']),
+                '{:.3f}'.format(r['total_ms']),
+                '{:.3f}'.format(r['mean_ms']),
+                '{:.3f}'.format(r['p99_ms']),
+                '{:.1f}'.format(r['bandwidth_gbs']),
+                '-' if ratio is None else '{:.1f}'.format(ratio * 100),
+            ))
+        widths = [max([len(h)] + [len(row[i]) for row in rows])
+                  for i, h in enumerate(header)]
+        lines = []
+        for row in [header] + rows:
+            cells = [row[0].ljust(widths[0])]
+            cells += [c.rjust(w) for c, w in zip(row[1:], widths[1:])]
+            lines.append('  '.join(cells).rstrip())
+        return '\n'.join(lines)
+
+    def __str__(self):
+        return self.table()
+
+
+@contextlib.contextmanager
+def kernel_stats():
+    """Collect per-kernel timing statistics during with statement.
+
+    Within the with statement, each launch of a kernel compiled by CuPy
+    (elementwise and reduction kernels, :class:`cupy.RawKernel` and
+    :class:`cupy.RawModule`) and each CUB or Thrust call made by CuPy is
+    timed on the GPU with a pair of events taken from a pool. The
+    statistics of each kernel name and signature (the dtypes and shapes of
+    the array arguments) are aggregated into the yielded
+    :class:`~cupyx.profiler._kernel_stats.KernelStats`: the number of
+    launches, the total, mean and 99th percentile time, and the bandwidth
+    achieved by moving the bytes of the array arguments, also relative to
+    the theoretical memory bandwidth of the device.
+
+    >>> with cupyx.profiler.kernel_stats() as stats:
+    ...     for _ in range(100):
+    ...         y = cupy.tanh(x) * 2
+    >>> print(stats.table(limit=10))  # doctest: +SKIP
+
+    Returns:
+        KernelStats: The statistics, complete once the statement is left.
+        They can be read as a table with ``table()`` or ``str()``, as a list
+        of dicts with ``records()``, or as JSON with ``to_json()``.
+
+    .. note::
+        The bytes of a kernel are the total size of its array arguments,
+        which is the traffic of a kernel that reads or writes each element
+        once. The timing adds a few microseconds of host overhead to each
+        launch, and the launches made while capturing a CUDA graph are not
+        timed. The collection is global to the process.
+
+    .. seealso:: :func:`cupyx.profiler.kernel_ranges`,
+        :func:`cupyx.profiler.benchmark`
+    """
+    stats = KernelStats()
+    previous = function._get_kernel_stats()
+    function._set_kernel_stats(stats)
+    try:
+        yield stats
+    finally:
+        function._set_kernel_stats(previous)
+        stats._resolve()
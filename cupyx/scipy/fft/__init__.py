@@ -8,6 +8,9 @@ from cupyx.scipy.fft._fft import (
     __ua_domain__, __ua_convert__, __ua_function__)
 from cupyx.scipy.fft._fft import _scipy_150, _scipy_160
 from cupyx.scipy.fft._fftlog import fht, ifht
+from cupyx.scipy.fft._distributed import (
+    distributed_fftn, distributed_ifftn
+)
 from cupyx.scipy.fft._helper import next_fast_len  # NOQA
 from cupy.fft import fftshift, ifftshift, fftfreq, rfftfreq
 from cupyx.scipy.fftpack import get_fft_plan
@@ -0,0 +1,291 @@
+"""Distributed N-D FFT over several devices with slab decomposition.
+
+An N-D array (N >= 2) is given as a list of slabs, one per device, split
+along axis 0 (the "row" layout) or along axis 1 (the "column" layout). A
+transform is computed in two passes:
+
+1. Each device transforms its slab over the axes it holds entirely, and the
+   slabs are redistributed (an all-to-all transpose) into the other layout.
+2. Each device transforms the remaining axis.
+
+The first pass is pipelined: the local slab is processed in chunks along
+its split axis, and each chunk is sent to the other devices on a separate
+stream while the next chunk is being transformed. The transfers go through
+NCCL (RCCL on ROCm) if available, and through peer-to-peer copies
+otherwise.
+"""
+
+import numpy
+
+import cupy
+from cupy.cuda import device
+from cupy.cuda import nccl
+from cupy.cuda import runtime
+from cupy.cuda import stream as stream_module
+from cupyx.scipy.fft import _fft
+
+
+_comm_streams: dict = {}
+_communicators: dict = {}
+
+
+def _get_comm_stream(dev):
+    s = _comm_streams.get(dev)
+    if s is None:
+        with device.Device(dev):
+            s = stream_module.Stream(non_blocking=True)
+        _comm_streams[dev] = s
+    return s
+
+
+def _get_communicators(devices):
+    if not nccl.available:
+        return None
+    comms = _communicators.get(devices)
+    if comms is None:
+        comms = nccl.NcclCommunicator.initAll(list(devices))
+        _communicators[devices] = comms
+    return comms
+
+
+def _bounds(n, n_parts):
+    return [n * i // n_parts for i in range(n_parts + 1)]
+
+
+def _take(x, axis, start, stop):
+    return x[(slice(None),) * axis + (slice(start, stop),)]
+
+
+def _exchange(transfers, devices, comms, comm_streams):
+    # transfers: list of (src index, dst index, src array, dst array), where
+    # both arrays are C-contiguous and of the same size. Each copy is issued
+    # on the communication stream of the receiving device, and on that of
+    # the sending device for NCCL.
+    if comms is not None:
+        nccl.groupStart()
+    try:
+        for k, j, src, dst in transfers:
+            if comms is None or k == j:
+                with device.Device(devices[j]):
+                    runtime.memcpyPeerAsync(
+                        dst.data.ptr, devices[j], src.data.ptr, devices[k],
+                        src.nbytes, comm_streams[j].ptr)
+                continue
+            with device.Device(devices[k]):
+                comms[k].send(src.data.ptr, src.nbytes, nccl.NCCL_INT8, j,
+                              comm_streams[k].ptr)
+            with device.Device(devices[j]):
+                comms[j].recv(dst.data.ptr, dst.nbytes, nccl.NCCL_INT8, k,
+                              comm_streams[j].ptr)
+    finally:
+        if comms is not None:
+            nccl.groupEnd()
+
+
+def _fft_redistribute(parts, devices, split_from, split_to, axes, func,
+                      norm, n_chunks):
+    # Transforms each part over ``axes`` and moves the result from the
+    # split along ``split_from`` to the split along ``split_to``.
+    n_parts = len(parts)
+    comms = _get_communicators(devices) if n_parts > 1 else None
+    comm_streams = [_get_comm_stream(dev) for dev in devices]
+
+    from_sizes = [p.shape[split_from] for p in parts]
+    from_offsets = numpy.cumsum([0] + from_sizes).tolist()
+    shape = list(parts[0].shape)
+    shape[split_from] = from_offsets[-1]
+    to_bounds = _bounds(shape[split_to], n_parts)
+
+    outs = []
+    for j, dev in enumerate(devices):
+        out_shape = list(shape)
+        out_shape[split_to] = to_bounds[j + 1] - to_bounds[j]
+        with device.Device(dev):
+            outs.append(cupy.empty(out_shape, parts[j].dtype))
+            ready = stream_module.get_current_stream().record()
+        comm_streams[j].wait_event(ready)
+
+    # The chunks in flight: their buffers must outlive the transfers, and
+    # for split_from != 0 the received blocks are scattered into ``outs``
+    # on the compute streams one chunk later.
+    in_flight = None
+    for c in range(n_chunks + 1):
+        events = []
+        blocks = []
+        if c < n_chunks:
+            for k, dev in enumerate(devices):
+                chunk = _bounds(from_sizes[k], n_chunks)[c:c + 2]
+                row = []
+                with device.Device(dev):
+                    if chunk[1] > chunk[0]:
+                        y = _take(parts[k], split_from, *chunk)
+                        if axes:
+                            y = func(y, axes=axes, norm=norm)
+                        for j in range(n_parts):
+                            row.append(cupy.ascontiguousarray(_take(
+                                y, split_to, to_bounds[j], to_bounds[j + 1])))
+                        del y
+                    events.append(
+                        stream_module.get_current_stream().record())
+                blocks.append((chunk, row))
+
+        if in_flight is not None:
+            # wait for the previous chunk; this overlaps with the transform
+            # of the current chunk issued above
+            done, scatters, _ = in_flight
+            for j, dev in enumerate(devices):
+                with device.Device(dev):
+                    s = stream_module.get_current_stream()
+                    for ev in done:
+                        s.wait_event(ev)
+                    for start, buf in scatters[j]:
+                        _take(outs[j], split_from, start,
+                              start + buf.shape[split_from])[...] = buf
+            # the buffers of the previous chunk are released here, after
+            # the compute streams have waited for their transfers
+            in_flight = None
+        if c == n_chunks:
+            break
+
+        for s in comm_streams:
+            for ev in events:
+                s.wait_event(ev)
+        transfers = []
+        scatters = [[] for _ in range(n_parts)]
+        for k, (chunk, row) in enumerate(blocks):
+            if not row:
+                continue
+            start = from_offsets[k] + chunk[0]
+            for j in range(n_parts):
+                src = row[j]
+                if src.size == 0:
+                    continue
+                if split_from == 0:
+                    # contiguous, so that it is received in place
+                    dst = outs[j][start:start + src.shape[0]]
+                else:
+                    with device.Device(devices[j]):
+                        dst = cupy.empty(src.shape, src.dtype)
+                    scatters[j].append((start, dst))
+                transfers.append((k, j, src, dst))
+        _exchange(transfers, devices, comms, comm_streams)
+        done = []
+        for dev, s in zip(devices, comm_streams):
+            with device.Device(dev):
+                done.append(s.record())
+        in_flight = (done, scatters, blocks)
+
+    return outs
+
+
+def _check_parts(x, split_axis):
+    if isinstance(x, cupy.ndarray) or not isinstance(x, (list, tuple)):
+        raise TypeError('x must be a list of cupy.ndarray, one per device')
+    if len(x) == 0:
+        raise ValueError('x must not be empty')
+    parts = list(x)
+    devices = tuple(p.device.id for p in parts)
+    if len(set(devices)) != len(devices):
+        raise ValueError('the parts must be on distinct devices')
+    ndim = parts[0].ndim
+    if ndim < 2:
+        raise ValueError('the distributed FFT needs at least 2 dimensions')
+    dtype = parts[0].dtype
+    for p in parts:
+        if p.ndim != ndim or p.dtype != dtype:
+            raise ValueError('the parts must have the same ndim and dtype')
+        shape = list(p.shape)
+        shape[split_axis] = parts[0].shape[split_axis]
+        if tuple(shape) != parts[0].shape:
+            raise ValueError(
+                'the parts must have the same shape except for axis '
+                '{}'.format(split_axis))
+    if dtype.kind != 'c':
+        dtype = numpy.promote_types(dtype, numpy.complex64)
+        converted = []
+        for p in parts:
+            with p.device:
+                converted.append(p.astype(dtype))
+        parts = converted
+    return parts, devices
+
+
+def _distributed_fftn(x, norm, transposed_input, transposed_output,
+                      n_chunks, func1, funcn):
+    if n_chunks < 1:
+        raise ValueError('n_chunks must be positive')
+    split_in = 1 if transposed_input else 0
+    split_other = 1 - split_in
+    split_out = 1 if transposed_output else 0
+    parts, devices = _check_parts(x, split_in)
+    ndim = parts[0].ndim
+
+    # the first pass transforms all the axes but the other split axis
+    axes = tuple(i for i in range(ndim) if i != split_other)
+    parts = _fft_redistribute(parts, devices, split_in, split_other,
+                              axes, funcn, norm, n_chunks)
+    if split_out == split_other:
+        outs = []
+        for dev, p in zip(devices, parts):
+            with device.Device(dev):
+                outs.append(func1(p, axis=split_other, norm=norm,
+                                  overwrite_x=True))
+        return outs
+    return _fft_redistribute(parts, devices, split_other, split_in,
+                             (split_other,), funcn, norm, n_chunks)
+
+
+def distributed_fftn(x, norm=None, *, transposed_input=False,
+                     transposed_output=False, n_chunks=4):
+    """Compute the N-D FFT of an array distributed over several devices.
+
+    Args:
+        x (list of cupy.ndarray): The parts of the array, one per device.
+            They are concatenated along axis 0, or along axis 1 if
+            ``transposed_input`` is ``True``, to form the global array, which
+            must have at least two dimensions. Real inputs are converted to
+            complex.
+        norm (``"backward"``, ``"ortho"``, or ``"forward"``): Optional keyword
+            to specify the normalization mode. Default is ``None``, which is
+            an alias of ``"backward"``.
+        transposed_input (bool): Whether ``x`` is split along axis 1.
+        transposed_output (bool): If ``True``, the result is returned split
+            evenly along axis 1, which saves one redistribution of the data.
+            Otherwise it is split evenly along axis 0.
+        n_chunks (int): The number of chunks each part is processed in, so
+            that the transfers of a chunk overlap with the transform of the
+            next one.
+
+    Returns:
+        list of cupy.ndarray:
+            The parts of the transformed array, one on each device of ``x``.
+
+    .. note::
+        Each device holds a slab of the array, so that up to as many devices
+        as the length of the split axis can be used. The transfers use NCCL
+        if available, and peer-to-peer copies otherwise.
+
+    .. seealso:: :func:`scipy.fft.fftn`
+    """
+    return _distributed_fftn(x, norm, transposed_input, transposed_output,
+                             n_chunks, _fft.fft, _fft.fftn)
+
+
+def distributed_ifftn(x, norm=None, *, transposed_input=False,
+                      transposed_output=False, n_chunks=4):
+    """Compute the N-D inverse FFT of an array distributed over several
+    devices.
+
+    The arguments and the layout of the data are the same as in
+    :func:`distributed_fftn`. In particular, the output of
+    ``distributed_fftn(..., transposed_output=True)`` can be transformed
+    back with ``distributed_ifftn(..., transposed_input=True)``.
+
+    Returns:
+        list of cupy.ndarray:
+            The parts of the transformed array, one on each device of ``x``.
+
+    .. seealso:: :func:`scipy.fft.ifftn`
+    """
+    return _distributed_fftn(x, norm, transposed_input, transposed_output,
+                             n_chunks, _fft.ifft, _fft.ifftn)
@@ -174,6 +174,178 @@ D_BOOR_MODULE = cupy.RawModule(
     name_expressions=[f'd_boor<{type_name}>' for type_name in TYPES])
 
 
+# The device functions of the fused evaluation kernels, where the maximum
+# degree is specialized at compile time so that the basis functions stay in
+# registers.
+SPLINE_DEVICE_CODE = r'''
+#include <cupy/complex.cuh>
+#include <cupy/math_constants.h>
+#define SPLINE_COLS 4
+
+__device__ long long find_interval(
+        const double* t, double xp, int k, int n, bool extrapolate) {
+
+    double tb = t[k];
+    double te = t[n];
+
+    if(isnan(xp)) {
+        return -1;
+    }
+
+    if((xp < tb || xp > te) && !extrapolate) {
+        return -1;
+    }
+
+    int left = k;
+    int right = n;
+    int mid;
+    bool found = false;
+
+    while(left < right && !found) {
+        mid = ((right + left) / 2);
+        if(xp > t[mid]) {
+            left = mid + 1;
+        } else if (xp < t[mid]) {
+            right = mid - 1;
+        } else {
+            found = true;
+        }
+    }
+
+    int default_value = left - 1 < k ? k : left - 1;
+    int result = found ? mid + 1 : default_value + 1;
+
+    while(result != n && xp >= t[result]) {
+        result++;
+    }
+
+    return result - 1;
+}
+
+/*
+ * The k+1 non-zero values of the mu-th derivative of the B-splines of degree
+ * k <= MAXK at xp, computed as in d_boor. The loops are unrolled, so that h
+ * and hh are kept in registers.
+ */
+template<int MAXK>
+__device__ void d_boor_registers(
+        const double* t, double xp, long long interval, int k, int mu,
+        double* h) {
+
+    double hh[MAXK + 1];
+
+    h[0] = 1.0;
+#pragma unroll
+    for(int j = 1; j <= MAXK; j++) {
+        if(j > k) {
+            break;
+        }
+        const bool derivative = j > k - mu;
+#pragma unroll
+        for(int p = 0; p < j; p++) {
+            hh[p] = h[p];
+        }
+        h[0] = 0.0;
+#pragma unroll
+        for(int n = 1; n <= j; n++) {
+            long long ind = interval + n;
+            double xb = t[ind];
+            double xa = t[ind - j];
+            if(xb == xa) {
+                if(derivative) {
+#pragma unroll
+                    for(int p = 0; p <= MAXK; p++) {
+                        if(p == mu) {
+                            h[p] = 0.0;
+                        }
+                    }
+                } else {
+                    h[n] = 0.0;
+                }
+                continue;
+            }
+            if(derivative) {
+                double w = ((double) j) * hh[n - 1]/(xb - xa);
+                h[n - 1] -= w;
+                h[n] = w;
+            } else {
+                double w = hh[n - 1]/(xb - xa);
+                h[n - 1] += w*(xb - xp);
+                h[n] = w*(xp - xa);
+            }
+        }
+    }
+}
+'''
+
+# The interval search, the de Boor recursion and the linear combination of
+# the coefficients fused in one kernel for each point, for a degree K. Each
+# thread evaluates the columns of the coefficients (i.e., the curves of a
+# batch) in tiles of SPLINE_COLS.
+SPLINE_EVAL_KERNEL = SPLINE_DEVICE_CODE + r'''
+template<int K, typename T>
+__global__ void eval_spline(
+        const double* t, int n, const T* c, long long num_c,
+        const double* x, long long num_x, int mu, bool extrapolate,
+        T* out) {
+
+    long long idx = blockDim.x * (long long) blockIdx.x + threadIdx.x;
+    if(idx >= num_x) {
+        return;
+    }
+
+    double xp = x[idx];
+    long long interval = find_interval(t, xp, K, n, extrapolate);
+    T* out_x = out + num_c * idx;
+
+    long long j0 = blockIdx.y * (long long) SPLINE_COLS;
+    const long long step = gridDim.y * (long long) SPLINE_COLS;
+    if(interval < 0) {
+        for(; j0 < num_c; j0 += step) {
+            for(int j = 0; j < SPLINE_COLS && j0 + j < num_c; j++) {
+                out_x[j0 + j] = CUDART_NAN;
+            }
+        }
+        return;
+    }
+
+    double h[K + 1];
+    d_boor_registers<K>(t, xp, interval, K, mu, h);
+
+    const T* c_x = c + (interval - K) * num_c;
+    for(; j0 < num_c; j0 += step) {
+        const int cols = num_c - j0 < SPLINE_COLS ? num_c - j0 : SPLINE_COLS;
+        T acc[SPLINE_COLS];
+#pragma unroll
+        for(int j = 0; j < SPLINE_COLS; j++) {
+            acc[j] = T(0);
+        }
+#pragma unroll
+        for(int m = 0; m <= K; m++) {
+            const T* c_m = c_x + m * num_c + j0;
+#pragma unroll
+            for(int j = 0; j < SPLINE_COLS; j++) {
+                if(j < cols) {
+                    acc[j] += c_m[j] * ((T) h[m]);
+                }
+            }
+        }
+        for(int j = 0; j < cols; j++) {
+            out_x[j0 + j] = acc[j];
+        }
+    }
+}
+'''
+
+
+@cupy._util.memoize()
+def _get_spline_eval_module(k):
+    return cupy.RawModule(
+        code=SPLINE_EVAL_KERNEL, options=('-std=c++11',),
+        name_expressions=[f'eval_spline<{k}, {type_name}>'
+                          for type_name in TYPES])
+
+
 DESIGN_MAT_KERNEL = r'''
 #include <cupy/complex.cuh>
 
@@ -259,21 +431,21 @@ def _evaluate_spline(t, c, k, xp, nu, extrapolate, out):
         Computed values of the spline at each of the input points.
         This argument is modified in-place.
     """
+    k = int(k)
     n = t.shape[0] - k - 1
-    intervals = cupy.empty_like(xp, dtype=cupy.int64)
-
-    # Compute intervals for each value
-    interval_kernel = _get_module_func(INTERVAL_MODULE, 'find_interval')
-    interval_kernel(((xp.shape[0] + 128 - 1) // 128,), (128,),
-                    (t, xp, intervals, k, n, extrapolate, xp.shape[0]))
-
-    # Compute interpolation
+    num_x = xp.shape[0]
     num_c = int(np.prod(c.shape[1:]))
-    temp = cupy.empty(xp.shape[0] * (2 * k + 1))
-    d_boor_kernel = _get_module_func(D_BOOR_MODULE, 'd_boor', c)
-    d_boor_kernel(((xp.shape[0] + 128 - 1) // 128,), (128,),
-                  (t, c, k, nu, xp, intervals, out, temp, num_c, 1,
-                   xp.shape[0]))
+    if num_x == 0 or num_c == 0:
+        return
+
+    # Find the intervals, compute the B-splines and combine the coefficients
+    # in a single kernel for each point.
+    type_name = TYPES[1] if c.dtype.kind == 'c' else TYPES[0]
+    eval_kernel = _get_spline_eval_module(k).get_function(
+        f'eval_spline<{k}, {type_name}>')
+    eval_kernel(((num_x + 128 - 1) // 128, min((num_c + 3) // 4, 65535)),
+                (128,),
+                (t, n, c, num_c, xp, num_x, nu, extrapolate, out))
 
 
 def _make_design_matrix(x, t, k, extrapolate, indices):
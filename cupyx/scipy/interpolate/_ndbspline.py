@@ -4,7 +4,7 @@ from math import prod
 
 import cupy
 
-from cupyx.scipy.interpolate._bspline import _get_dtype, _get_module_func
+from cupyx.scipy.interpolate._bspline import _get_dtype, SPLINE_DEVICE_CODE
 from cupyx.scipy.interpolate._bspline2 import _not_a_knot
 from cupyx.scipy.sparse import csr_matrix
 from cupyx.scipy.sparse.linalg import spsolve
@@ -164,48 +164,6 @@ __global__ void compute_nd_bsplines(
     }
 }
 
-template<typename T>
-__global__ void eval_nd_bspline(
-        const long long* indices_k1d, const long long* strides_c1,
-        const double* b, const long long* intervals, const long long* k,
-        bool* invalid, T* c1r, long long* volume, int ndim, int num_c,
-        int n_xi, const long long* max_k, T* out) {
-
-    for(int idx = getCurThreadIdx(); idx < n_xi; idx += getThreadNum()) {
-        if(invalid[idx]) {
-            for(int i = 0; i < num_c; i++) {
-                out[num_c * idx + i] = CUDART_NAN;
-            }
-            continue;
-        }
-
-        for(int i = 0; i < num_c; i++) {
-            out[num_c * idx + i] = 0;
-        }
-
-        const double* idx_splines = b + ndim * (2 * max_k[0] + 2) * idx;
-
-        for(long long iflat = 0; iflat < *volume; iflat++) {
-            const long long* idx_b = indices_k1d + ndim * iflat;
-            long long idx_cflat_base = 0;
-            double factor = 1.0;
-
-            for(int d = 0; d < ndim; d++) {
-                const double* dim_splines = (
-                    idx_splines + (2 * max_k[0] + 2) * d);
-                factor *= dim_splines[idx_b[d]];
-                long long d_idx = idx_b[d] + intervals[ndim * idx + d] - k[d];
-                idx_cflat_base += d_idx * strides_c1[d];
-            }
-
-            for(int i = 0; i < num_c; i++) {
-                out[num_c * idx + i] += c1r[idx_cflat_base + i] * factor;
-            }
-        }
-    }
-}
-
-
 __global__ void store_nd_bsplines(
         const long long* indices_k1d, const long long* strides_c1,
         const double* b, const long long* intervals, const long long* k,
@@ -240,13 +198,113 @@ __global__ void store_nd_bsplines(
 
 NDBSPL_MOD = cupy.RawModule(
     code=NDBSPL_DEF, options=('-std=c++11',),
-    name_expressions=['compute_nd_bsplines', 'store_nd_bsplines'] +
-                     [f'eval_nd_bspline<{t}>' for t in TYPES])
+    name_expressions=['compute_nd_bsplines', 'store_nd_bsplines'])
+
+
+# Evaluates the tensor product spline at each point in one kernel: the
+# intervals and the B-splines of the NDIM dimensions, of degrees up to MAXK,
+# are computed per thread and combined with the coefficients, without the
+# intermediate arrays of `compute_nd_bsplines`.
+NDBSPL_EVAL_KERNEL = SPLINE_DEVICE_CODE + r"""
+template<int NDIM, int MAXK, typename T>
+__global__ void eval_nd_spline(
+        const double* xi, long long n_xi, const double* t,
+        const long long* t_sz, int max_t, const long long* k, const int* nu,
+        bool extrapolate, const T* c1r, const long long* strides_c1,
+        long long num_c, T* out) {
+
+    long long idx = blockDim.x * (long long) blockIdx.x + threadIdx.x;
+    if(idx >= n_xi) {
+        return;
+    }
+
+    double b[NDIM][MAXK + 1];
+    int kd[NDIM];
+    long long base = 0;
+    bool valid = true;
+#pragma unroll
+    for(int d = 0; d < NDIM; d++) {
+        const double* dim_t = t + (long long) max_t * d;
+        double xd = xi[NDIM * idx + d];
+        kd[d] = k[d];
+        long long interval = find_interval(
+            dim_t, xd, kd[d], t_sz[d] - kd[d] - 1, extrapolate);
+        if(interval < 0) {
+            valid = false;
+            break;
+        }
+        d_boor_registers<MAXK>(dim_t, xd, interval, kd[d], nu[d], b[d]);
+        base += (interval - kd[d]) * strides_c1[d];
+    }
+
+    T* out_x = out + num_c * idx;
+    long long j0 = blockIdx.y * (long long) SPLINE_COLS;
+    const long long step = gridDim.y * (long long) SPLINE_COLS;
+    if(!valid) {
+        for(; j0 < num_c; j0 += step) {
+            for(int j = 0; j < SPLINE_COLS && j0 + j < num_c; j++) {
+                out_x[j0 + j] = CUDART_NAN;
+            }
+        }
+        return;
+    }
+
+    for(; j0 < num_c; j0 += step) {
+        const int cols = num_c - j0 < SPLINE_COLS ? num_c - j0 : SPLINE_COLS;
+        T acc[SPLINE_COLS];
+#pragma unroll
+        for(int j = 0; j < SPLINE_COLS; j++) {
+            acc[j] = T(0);
+        }
+
+        // iterate over the (k[0] + 1) x ... x (k[NDIM - 1] + 1) products
+        int ib[NDIM];
+#pragma unroll
+        for(int d = 0; d < NDIM; d++) {
+            ib[d] = 0;
+        }
+        while(true) {
+            double factor = 1.0;
+            long long offset = base + j0;
+#pragma unroll
+            for(int d = 0; d < NDIM; d++) {
+                factor *= b[d][ib[d]];
+                offset += ib[d] * strides_c1[d];
+            }
+#pragma unroll
+            for(int j = 0; j < SPLINE_COLS; j++) {
+                if(j < cols) {
+                    acc[j] += c1r[offset + j] * ((T) factor);
+                }
+            }
+            int d = NDIM - 1;
+            while(d >= 0 && ++ib[d] > kd[d]) {
+                ib[d] = 0;
+                d--;
+            }
+            if(d < 0) {
+                break;
+            }
+        }
+
+        for(int j = 0; j < cols; j++) {
+            out_x[j0 + j] = acc[j];
+        }
+    }
+}
+"""
+
+
+@cupy._util.memoize()
+def _get_nd_eval_module(ndim, max_k):
+    return cupy.RawModule(
+        code=NDBSPL_EVAL_KERNEL, options=('-std=c++11',),
+        name_expressions=[f'eval_nd_spline<{ndim}, {max_k}, {t}>'
+                          for t in TYPES])
 
 
 def evaluate_ndbspline(
-        xi, t, len_t, k, nu, extrapolate, c1r, num_c_tr,
-        strides_c1, indices_k1d, out):
+        xi, t, len_t, k, nu, extrapolate, c1r, num_c_tr, strides_c1, out):
     """Evaluate an N-dim tensor product spline or its derivative.
 
     Parameters
@@ -283,12 +341,6 @@ def evaluate_ndbspline(
         Note: These are *data* strides, not numpy-style byte strides.
         This array is equivalent to
         ``[stride // s1.dtype.itemsize for stride in s1.strides]``.
-    indices_k1d : ndarray, shape((k+1)**ndim, ndim)
-        Pre-computed mapping between indices for iterating over a flattened
-        array of shape ``[k[d] + 1) for d in range(ndim)`` and
-        ndim-dimensional indices of the ``(k+1,)*ndim`` dimensional array.
-        This is essentially a transposed version of
-        ``cupy.unravel_index(cupy.arange((k+1)**ndim), (k+1,)*ndim)``.
     out : ndarray, shape (npoints, num_c_tr)
         Output values of the b-spline at given ``xi`` points.
 
@@ -316,27 +368,26 @@ def evaluate_ndbspline(
         result += term
     ```
 
-    For efficiency reasons, we iterate over the flattened versions of the
-    arrays.
+    The intervals, the b-splines and the sum are computed by one kernel for
+    each point, where the degrees are specialized at compile time.
 
     """
-    max_k = k.max()
-    volume = cupy.prod(k + 1)
-    intervals = cupy.empty((xi.shape[0], t.shape[0]), dtype=cupy.int64)
-    splines = cupy.empty((xi.shape[0], t.shape[0], 2 * max_k.item() + 2),
-                         dtype=cupy.float64)
-    invalid = cupy.zeros(xi.shape[0], dtype=cupy.bool_)
-
-    compute_nd_bsplines = NDBSPL_MOD.get_function('compute_nd_bsplines')
-    compute_nd_bsplines((512,), (128,), (
-        xi, xi.shape[0], t, len_t, xi.shape[1], t.shape[1], k, max_k,
-        nu, extrapolate, True, intervals, splines, invalid
-    ))
-
-    eval_nd_bspline = _get_module_func(NDBSPL_MOD, 'eval_nd_bspline', c1r)
-    eval_nd_bspline((512,), (128,), (
-        indices_k1d, strides_c1, splines, intervals, k, invalid, c1r, volume,
-        xi.shape[1], num_c_tr, xi.shape[0], max_k, out))
+    n_xi, ndim = xi.shape
+    if n_xi == 0 or num_c_tr == 0:
+        return
+
+    # The degrees are specialized up to the next power of two, so that few
+    # kernels are compiled.
+    max_k = 1
+    while max_k < int(k.max()):
+        max_k *= 2
+    type_name = TYPES[1] if c1r.dtype.kind == 'c' else TYPES[0]
+    eval_nd_spline = _get_nd_eval_module(ndim, max_k).get_function(
+        f'eval_nd_spline<{ndim}, {max_k}, {type_name}>')
+    eval_nd_spline(
+        ((n_xi + 128 - 1) // 128, min((num_c_tr + 3) // 4, 65535)), (128,),
+        (xi, n_xi, t, len_t, t.shape[1], k, nu, extrapolate, c1r,
+         strides_c1, num_c_tr, out))
 
 
 def colloc_nd(xvals, t, len_t, k):
@@ -602,11 +653,6 @@ class NdBSpline:
             _t[d, :len(self.t[d])] = self.t[d]
         len_t = cupy.asarray(len_t, dtype=cupy.int64)
 
-        # tabulate the flat indices for iterating over the (k+1)**ndim subarray
-        shape = tuple(kd + 1 for kd in self.k)
-        indices = cupy.unravel_index(cupy.arange(prod(shape)), shape)
-        _indices_k1d = cupy.asarray(indices, dtype=cupy.int64).T.copy()
-
         # prepare the coefficients: flatten the trailing dimensions
         c1 = self.c.reshape(self.c.shape[:ndim] + (-1,))
         c1r = c1.ravel()
@@ -627,7 +673,6 @@ class NdBSpline:
                            c1r,
                            num_c_tr,
                            _strides_c1,
-                           _indices_k1d,
                            out,)
 
         return out.reshape(xi_shape[:-1] + self.c.shape[ndim:])
@@ -225,6 +225,218 @@ NAME_TO_FUNC = {
 }
 
 
+# Kernels assembling and evaluating the interpolant without the
+# intermediate arrays of the functions below, i.e. the (P, P, N) differences
+# and the (Q, P) evaluation matrix. Each system `b` of a batch is made of the
+# data points `y[idx[b]]`.
+
+_rbf_definitions = kernel_definitions + """
+#define RBF_TILE 32
+#define RBF_TILE_K 8
+#define RBF_TILE_S 4
+
+""" + "".join("""
+struct rbf_{0} {{
+    __device__ double operator()(double r) const {{ return {0}(r); }}
+}};
+""".format(name) for name in NAME_TO_FUNC) + r"""
+
+static __device__ double rbf_monomial(
+        const double* x, const double* shift, const double* scale,
+        const long long* powers, int ndim)
+{
+    double m = 1.0;
+    for (int k = 0; k < ndim; ++k) {
+        double xhat = (x[k] - shift[k]) / scale[k];
+        for (long long e = 0; e < powers[k]; ++e) {
+            m *= xhat;
+        }
+    }
+    return m;
+}
+
+// Assembles the symmetric (P + R, P + R) matrices of the systems, in tiles
+// of RBF_TILE x RBF_TILE entries where each of the 16 x 16 threads computes
+// 2 x 2 entries. The coordinates are staged in tiles of RBF_TILE_K
+// dimensions in the shared memory. The blocks outside the kernel matrix
+// write the polynomial terms and the zeros.
+template<typename Phi>
+__global__ void rbf_system(
+        const double* y, const long long* idx, const double* smoothing,
+        const double* shift, const double* scale, const long long* powers,
+        double eps, int p, int r, int ndim, double* lhs)
+{
+    __shared__ double yi[RBF_TILE][RBF_TILE_K + 1];
+    __shared__ double yj[RBF_TILE][RBF_TILE_K + 1];
+    const int n = p + r;
+    const int b = blockIdx.z;
+    const int i0 = blockIdx.y * RBF_TILE;
+    const int j0 = blockIdx.x * RBF_TILE;
+    const int tx = threadIdx.x;
+    const int ty = threadIdx.y;
+    const long long* bidx = idx + (long long)b * p;
+    double acc[2][2] = {{0.0, 0.0}, {0.0, 0.0}};
+
+    if (i0 < p && j0 < p) {
+        for (int k0 = 0; k0 < ndim; k0 += RBF_TILE_K) {
+            for (int t = ty * 16 + tx; t < RBF_TILE * RBF_TILE_K; t += 256) {
+                int row = t / RBF_TILE_K;
+                int k = k0 + t % RBF_TILE_K;
+                int i = i0 + row;
+                int j = j0 + row;
+                yi[row][t % RBF_TILE_K] = (i < p && k < ndim) ?
+                    y[bidx[i] * ndim + k] : 0.0;
+                yj[row][t % RBF_TILE_K] = (j < p && k < ndim) ?
+                    y[bidx[j] * ndim + k] : 0.0;
+            }
+            __syncthreads();
+            for (int c = 0; c < RBF_TILE_K; ++c) {
+                double a[2] = {yi[ty][c], yi[ty + 16][c]};
+                double e[2] = {yj[tx][c], yj[tx + 16][c]};
+                for (int u = 0; u < 2; ++u) {
+                    for (int v = 0; v < 2; ++v) {
+                        double d = a[u] - e[v];
+                        acc[u][v] += d * d;
+                    }
+                }
+            }
+            __syncthreads();
+        }
+    }
+
+    Phi phi;
+    const double* bshift = shift + (long long)b * ndim;
+    const double* bscale = scale + (long long)b * ndim;
+    for (int u = 0; u < 2; ++u) {
+        int i = i0 + ty + 16 * u;
+        if (i >= n) {
+            continue;
+        }
+        for (int v = 0; v < 2; ++v) {
+            int j = j0 + tx + 16 * v;
+            if (j >= n) {
+                continue;
+            }
+            double val;
+            if (i < p && j < p) {
+                val = phi(eps * sqrt(acc[u][v]));
+                if (i == j) {
+                    val += smoothing[bidx[i]];
+                }
+            } else if (i < p) {
+                val = rbf_monomial(y + bidx[i] * ndim, bshift, bscale,
+                                   powers + (long long)(j - p) * ndim, ndim);
+            } else if (j < p) {
+                val = rbf_monomial(y + bidx[j] * ndim, bshift, bscale,
+                                   powers + (long long)(i - p) * ndim, ndim);
+            } else {
+                val = 0.0;
+            }
+            lhs[((long long)b * n + i) * n + j] = val;
+        }
+    }
+}
+
+// Evaluates sum_i w_i phi(|x - y_i|) plus the polynomial terms at each
+// point, for RBF_TILE_S columns of the coefficients per thread. The
+// threads of a block read the same data point at a time.
+template<typename Phi>
+__global__ void rbf_evaluate(
+        const double* x, const double* y, const long long* idx,
+        const long long* group, int grouped, const double* coeffs,
+        const double* shift, const double* scale, const long long* powers,
+        double eps, long long q, int p, int r, int ndim, int s, double* out)
+{
+    long long t = blockIdx.x * (long long)blockDim.x + threadIdx.x;
+    if (t >= q) {
+        return;
+    }
+    const int s0 = blockIdx.y * RBF_TILE_S;
+    const long long b = grouped ? group[t] : 0;
+    const long long* bidx = idx + b * p;
+    const double* bc = coeffs + b * (p + r) * s + s0;
+    const double* xt = x + t * ndim;
+    const int ns = min(RBF_TILE_S, s - s0);
+    double acc[RBF_TILE_S] = {0.0};
+    Phi phi;
+
+    for (int i = 0; i < p; ++i) {
+        const double* yi = y + bidx[i] * ndim;
+        double d2 = 0.0;
+        for (int k = 0; k < ndim; ++k) {
+            double d = xt[k] - yi[k];
+            d2 += d * d;
+        }
+        double w = phi(eps * sqrt(d2));
+        for (int c = 0; c < ns; ++c) {
+            acc[c] += w * bc[(long long)i * s + c];
+        }
+    }
+    for (int k = 0; k < r; ++k) {
+        double m = rbf_monomial(xt, shift + b * ndim, scale + b * ndim,
+                                powers + (long long)k * ndim, ndim);
+        for (int c = 0; c < ns; ++c) {
+            acc[c] += m * bc[(long long)(p + k) * s + c];
+        }
+    }
+    for (int c = 0; c < ns; ++c) {
+        out[t * s + s0 + c] = acc[c];
+    }
+}
+"""
+
+_rbf_module = cp.RawModule(
+    code=_rbf_definitions, options=('-std=c++11',),
+    name_expressions=[
+        'rbf_{}<rbf_{}>'.format(func, name)
+        for func in ('system', 'evaluate') for name in NAME_TO_FUNC])
+
+
+def _system_matrices(y, indices, smoothing, kernel, epsilon, powers,
+                     shift, scale):
+    """Assemble the (B, P + R, P + R) lhs of the systems of `y[indices]`."""
+    nb, p = indices.shape
+    r, ndim = powers.shape
+    n = p + r
+    indices = cp.ascontiguousarray(indices)
+    lhs = cp.empty((nb, n, n), dtype=float)
+    tiles = (n + 31) // 32
+    _rbf_module.get_function('rbf_system<rbf_{}>'.format(kernel))(
+        (tiles, tiles, nb), (16, 16),
+        (y, indices, smoothing, shift, scale,
+         powers.astype(cp.int64, copy=False), cp.float64(abs(epsilon)),
+         cp.int32(p), cp.int32(r), cp.int32(ndim), lhs))
+    return lhs
+
+
+def _evaluate(x, y, indices, group, coeffs, kernel, epsilon, powers,
+              shift, scale):
+    """Evaluate the interpolants without forming the evaluation matrix.
+
+    The point ``x[i]`` is evaluated with the system ``group[i]`` of the
+    batch, or with the single system if `group` is None.
+    """
+    q, ndim = x.shape
+    p = indices.shape[1]
+    r = powers.shape[0]
+    s = coeffs.shape[-1]
+    out = cp.empty((q, s), dtype=float)
+    if q == 0:
+        return out
+    indices = cp.ascontiguousarray(indices)
+    grouped = group is not None
+    if not grouped:
+        group = indices
+    _rbf_module.get_function('rbf_evaluate<rbf_{}>'.format(kernel))(
+        ((q + 127) // 128, (s + 3) // 4), (128,),
+        (x, y, indices, group, cp.int32(grouped),
+         cp.ascontiguousarray(coeffs), cp.ascontiguousarray(shift),
+         cp.ascontiguousarray(scale), powers.astype(cp.int64, copy=False),
+         cp.float64(abs(epsilon)), cp.int64(q), cp.int32(p), cp.int32(r),
+         cp.int32(ndim), cp.int32(s), out))
+    return out
+
+
 def kernel_matrix(x, kernel_func, out):
     """Evaluate RBFs, with centers at `x`, at `x`."""
     delta = x[None, :, :] - x[:, None, :]
@@ -245,7 +457,7 @@ def polynomial_matrix(x, powers, out):
 #            out[i, j] = cp.prod(x[i]**powers[j])
 
 
-def _build_system(y, d, smoothing, kernel, epsilon, powers):
+def _build_system(y, d, smoothing, kernel, epsilon, powers, indices=None):
     """Build the system used to solve for the RBF interpolant coefficients.
 
     Parameters
@@ -262,6 +474,9 @@ def _build_system(y, d, smoothing, kernel, epsilon, powers):
         Shape parameter.
     powers : (R, N) int ndarray
         The exponents for each monomial in the polynomial.
+    indices : (B, K) int ndarray, optional
+        If given, B systems are built, each from the K data points
+        ``y[indices[b]]``, and the outputs have a leading axis of length B.
 
     Returns
     -------
@@ -275,14 +490,17 @@ def _build_system(y, d, smoothing, kernel, epsilon, powers):
         Domain scaling used to create the polynomial matrix.
 
     """
-    p = d.shape[0]
+    batched = indices is not None
+    if not batched:
+        indices = cp.arange(y.shape[0])[None]
+    p = indices.shape[1]
     s = d.shape[1]
     r = powers.shape[0]
-    kernel_func = NAME_TO_FUNC[kernel]
 
     # Shift and scale the polynomial domain to be between -1 and 1
-    mins = cp.min(y, axis=0)
-    maxs = cp.max(y, axis=0)
+    ynbr = y[indices]
+    mins = cp.min(ynbr, axis=1)
+    maxs = cp.max(ynbr, axis=1)
     shift = (maxs + mins)/2
     scale = (maxs - mins)/2
     # The scale may be zero if there is a single point or all the points have
@@ -290,78 +508,21 @@ def _build_system(y, d, smoothing, kernel, epsilon, powers):
     # zeros with ones.
     scale[scale == 0.0] = 1.0
 
-    yeps = y * epsilon
-    yhat = (y - shift)/scale
+    # The kernel matrix, the polynomial terms and the smoothing are written
+    # by a single kernel.
+    lhs = _system_matrices(y, indices, smoothing, kernel, epsilon, powers,
+                           shift, scale)
 
-    # Transpose to make the array fortran contiguous. This is required for
-    # dgesv to not make a copy of lhs.
-    lhs = cp.empty((p + r, p + r), dtype=float).T
-    kernel_matrix(yeps, kernel_func, lhs[:p, :p])
-    polynomial_matrix(yhat, powers, lhs[:p, p:])
-    lhs[p:, :p] = lhs[:p, p:].T
-    lhs[p:, p:] = 0.0
-    for i in range(p):
-        lhs[i, i] += smoothing[i]
-
-    # Transpose to make the array fortran contiguous.
-    rhs = cp.empty((s, p + r), dtype=float).T
-    rhs[:p] = d
-    rhs[p:] = 0.0
+    rhs = cp.zeros((indices.shape[0], p + r, s), dtype=float)
+    rhs[:, :p] = d[indices]
 
+    if not batched:
+        # lhs is symmetric, so its transpose is the fortran contiguous array
+        # required for dgesv to not make a copy of lhs.
+        return lhs[0].T, cp.asfortranarray(rhs[0]), shift[0], scale[0]
     return lhs, rhs, shift, scale
 
 
-def _build_evaluation_coefficients(x, y, kernel, epsilon, powers,
-                                   shift, scale):
-    """Construct the coefficients needed to evaluate
-    the RBF.
-
-    Parameters
-    ----------
-    x : (Q, N) float ndarray
-        Evaluation point coordinates.
-    y : (P, N) float ndarray
-        Data point coordinates.
-    kernel : str
-        Name of the RBF.
-    epsilon : float
-        Shape parameter.
-    powers : (R, N) int ndarray
-        The exponents for each monomial in the polynomial.
-    shift : (N,) float ndarray
-        Shifts the polynomial domain for numerical stability.
-    scale : (N,) float ndarray
-        Scales the polynomial domain for numerical stability.
-
-    Returns
-    -------
-    (Q, P + R) float ndarray
-
-    """
-    q = x.shape[0]
-    p = y.shape[0]
-    r = powers.shape[0]
-    kernel_func = NAME_TO_FUNC[kernel]
-
-    yeps = y*epsilon
-    xeps = x*epsilon
-    xhat = (x - shift)/scale
-
-    vec = cp.empty((q, p + r), dtype=float)
-
-    # Evaluate RBFs, with centers at `y`, at the point `x`.
-    delta = xeps[:, None, :] - yeps[None, :, :]
-    vec[:, :p] = kernel_func(cp.linalg.norm(delta, axis=-1))
-
-    # Evaluate monomials, with exponents from `powers`, at the point `x`.
-    pwr = xhat[:, None, :]**powers[None, :, :]
-    vec[:, p:] = cp.prod(pwr, axis=-1)
-#    for i in range(q):
-#        polynomial_vector(xhat[i], powers, vec[i, p:])
-
-    return vec
-
-
 ###############################################################################
 
 # These RBFs are implemented.
@@ -435,7 +596,8 @@ def _monomial_powers(ndim, degree):
     return out
 
 
-def _build_and_solve_system(y, d, smoothing, kernel, epsilon, powers):
+def _build_and_solve_system(y, d, smoothing, kernel, epsilon, powers,
+                            indices=None):
     """Build and solve the RBF interpolation system of equations.
 
     Parameters
@@ -452,6 +614,9 @@ def _build_and_solve_system(y, d, smoothing, kernel, epsilon, powers):
         Shape parameter.
     powers : (R, N) int ndarray
         The exponents for each monomial in the polynomial.
+    indices : (B, K) int ndarray, optional
+        If given, the B systems of the data points ``y[indices[b]]`` are
+        solved in a batch.
 
     Returns
     -------
@@ -464,7 +629,7 @@ def _build_and_solve_system(y, d, smoothing, kernel, epsilon, powers):
 
     """
     lhs, rhs, shift, scale = _build_system(
-        y, d, smoothing, kernel, epsilon, powers
+        y, d, smoothing, kernel, epsilon, powers, indices
     )
     coeffs = cp.linalg.solve(lhs, rhs)
     return shift, scale, coeffs
@@ -574,7 +739,13 @@ class RBFInterpolator:
     impractical when interpolating more than about a thousand data points.
     To overcome memory limitations for large interpolation problems, the
     `neighbors` argument can be specified to compute an RBF interpolant for
-    each evaluation point using only the nearest data points.
+    each evaluation point using only the nearest data points, which are
+    found with a `KDTree`. The systems of the neighborhoods are then solved
+    in batches, which scales to millions of data points.
+
+    The interpolant is evaluated by a kernel that accumulates the RBF and
+    polynomial terms at each point, without forming the matrix of the RBFs
+    evaluated at the points.
 
     See Also
     --------
@@ -716,31 +887,20 @@ class RBFInterpolator:
         """
         nx, ndim = x.shape
         nnei = len(y)
+        indices = cp.arange(nnei)[None]
 
-        # in each chunk we consume the same space we already occupy
+        # The interpolant is evaluated without the (Q, P + R) evaluation
+        # matrix, so the chunks only bound the size of each launch.
         chunksize = memory_budget // ((self.powers.shape[0] + nnei)) + 1
         if chunksize <= nx:
             out = cp.empty((nx, self.d.shape[1]), dtype=float)
             for i in range(0, nx, chunksize):
-                vec = _build_evaluation_coefficients(
-                    x[i:i + chunksize, :],
-                    y,
-                    self.kernel,
-                    self.epsilon,
-                    self.powers,
-                    shift,
-                    scale)
-                out[i:i + chunksize, :] = cp.dot(vec, coeffs)
+                out[i:i + chunksize, :] = _evaluate(
+                    x[i:i + chunksize, :], y, indices, None, coeffs,
+                    self.kernel, self.epsilon, self.powers, shift, scale)
         else:
-            vec = _build_evaluation_coefficients(
-                x,
-                y,
-                self.kernel,
-                self.epsilon,
-                self.powers,
-                shift,
-                scale)
-            out = cp.dot(vec, coeffs)
+            out = _evaluate(x, y, indices, None, coeffs, self.kernel,
+                            self.epsilon, self.powers, shift, scale)
 
         return out
 
@@ -796,37 +956,40 @@ class RBFInterpolator:
             # neighborhood.
             yindices = cp.sort(yindices, axis=1)
             yindices, inv = cp.unique(yindices, return_inverse=True, axis=0)
+            inv = inv.reshape(-1)
             # `inv` tells us which neighborhood will be used by each evaluation
-            # point. Now we find which evaluation points will be using each
-            # neighborhood.
-            xindices = [[] for _ in range(len(yindices))]
-            for i, j in enumerate(inv.tolist()):
-                xindices[j].append(i)
-
+            # point. Sort the evaluation points by their neighborhoods, so
+            # that the points of consecutive neighborhoods are contiguous.
+            nnbr = len(yindices)
+            xindices = cp.argsort(inv)
+            bounds = cp.zeros(nnbr + 1, dtype=cp.int64)
+            cp.cumsum(cp.bincount(inv, minlength=nnbr), out=bounds[1:])
+            bounds = bounds.get()
+
+            # The systems of the neighborhoods are built and solved in
+            # batches, each of which takes about the memory budget.
+            n = self.neighbors + self.powers.shape[0]
+            batch = max(1, min(memory_budget // (n * n), 65535))
             out = cp.empty((nx, self.d.shape[1]), dtype=float)
-            for xidx, yidx in zip(xindices, yindices):
-                # `yidx` are the indices of the observations in this
-                # neighborhood. `xidx` are the indices of the evaluation points
-                # that are using this neighborhood.
-                xnbr = x[xidx]
-                ynbr = self.y[yidx]
-                dnbr = self.d[yidx]
-                snbr = self.smoothing[yidx]
+            for b0 in range(0, nnbr, batch):
+                b1 = min(b0 + batch, nnbr)
+                # `yidx` are the indices of the observations in these
+                # neighborhoods. `xidx` are the indices of the evaluation
+                # points that are using them.
+                yidx = yindices[b0:b1]
+                xidx = xindices[bounds[b0]:bounds[b1]]
                 shift, scale, coeffs = _build_and_solve_system(
-                    ynbr,
-                    dnbr,
-                    snbr,
+                    self.y,
+                    self.d,
+                    self.smoothing,
                     self.kernel,
                     self.epsilon,
                     self.powers,
+                    yidx,
                 )
-                out[xidx] = self._chunk_evaluator(
-                    xnbr,
-                    ynbr,
-                    shift,
-                    scale,
-                    coeffs,
-                    memory_budget=memory_budget)
+                out[xidx] = _evaluate(
+                    x[xidx], self.y, yidx, inv[xidx] - b0, coeffs,
+                    self.kernel, self.epsilon, self.powers, shift, scale)
 
         out = out.view(self.d_dtype)
         out = out.reshape((nx, ) + self.d_shape)
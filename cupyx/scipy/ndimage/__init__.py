@@ -71,3 +71,4 @@ from cupyx.scipy.ndimage._morphology import morphological_laplace  # NOQA
 from cupyx.scipy.ndimage._morphology import white_tophat  # NOQA
 from cupyx.scipy.ndimage._morphology import black_tophat  # NOQA
 from cupyx.scipy.ndimage._distance_transform import distance_transform_edt  # NOQA
+from cupyx.scipy.ndimage._distance_transform_tiled import distance_transform_edt_tiled  # NOQA
@@ -6,7 +6,8 @@ from ._pba_3d import _pba_3d
 
 def distance_transform_edt(image, sampling=None, return_distances=True,
                            return_indices=False, distances=None, indices=None,
-                           *, block_params=None, float64_distances=True):
+                           *, block_params=None, float64_distances=True,
+                           batched=False):
     r"""Exact Euclidean distance transform.
 
     This function calculates the distance transform of the `input`, by
@@ -53,6 +54,13 @@ def distance_transform_edt(image, sampling=None, return_distances=True,
         SciPy behavior). Otherwise, single precision will be used for
         efficiency. Note: This parameter is specific to cuCIM and does not
         exist in SciPy.
+    batched : bool, optional
+        If True, `image` must be 3D and is treated as a stack of 2D images
+        along its first axis, which are transformed independently in the same
+        kernel launches. `sampling` then applies to the last two axes, and
+        `indices` has shape ``(2,) + image.shape`` with the coordinates within
+        each image. Note: This parameter is specific to CuPy and does not
+        exist in SciPy.
 
     Returns
     -------
@@ -150,7 +158,11 @@ def distance_transform_edt(image, sampling=None, return_distances=True,
             scalar_sampling = float(sampling[0])
             sampling = None
 
-    if image.ndim == 3:
+    if batched:
+        if image.ndim != 3:
+            raise ValueError("batched requires a 3D stack of 2D images")
+        pba_func = _pba_2d
+    elif image.ndim == 3:
         pba_func = _pba_3d
     elif image.ndim == 2:
         pba_func = _pba_2d
@@ -0,0 +1,251 @@
+import concurrent.futures
+import numbers
+
+import numpy
+
+import cupy
+
+
+_edt_1d_code = r'''
+#include <cupy/math_constants.h>
+
+// The squared distance transform of the lines of an array along one axis,
+// computed as the lower envelope of the parabolas rooted at each element
+// (Felzenszwalb and Huttenlocher).  Element k of line l is at
+// (l / stride * n + k) * stride + l % stride.  The (n_lines, n) scratch
+// arrays are stored transposed so that the accesses are coalesced.  The
+// values of the envelope are kept in the scratch, so out may alias f.
+extern "C" __global__ void edt_1d(
+        const F* f, F* out, int* v, double* z, double* g,
+        long long n_lines, int n, long long stride, double w) {
+    long long l = blockIdx.x * (long long)blockDim.x + threadIdx.x;
+    if (l >= n_lines) {
+        return;
+    }
+    long long base = l / stride * n * stride + l % stride;
+    int k = -1;
+    for (int q = 0; q < n; q++) {
+        double fq = f[base + q * stride];
+        if (isinf(fq)) {
+            continue;
+        }
+        double pq = q * w;
+        double s = -CUDART_INF;
+        while (k >= 0) {
+            double pv = v[k * n_lines + l] * w;
+            s = ((fq + pq * pq) - (g[k * n_lines + l] + pv * pv))
+                / (2.0 * (pq - pv));
+            if (s > z[k * n_lines + l]) {
+                break;
+            }
+            k--;
+        }
+        k++;
+        v[k * n_lines + l] = q;
+        z[k * n_lines + l] = k == 0 ? -CUDART_INF : s;
+        g[k * n_lines + l] = fq;
+    }
+    int j = 0;
+    for (int q = 0; q < n; q++) {
+        double d = CUDART_INF;
+        if (k >= 0) {
+            double pq = q * w;
+            while (j < k && z[(j + 1) * n_lines + l] < pq) {
+                j++;
+            }
+            double dp = pq - v[j * n_lines + l] * w;
+            d = dp * dp + g[j * n_lines + l];
+        }
+        out[base + q * stride] = (F)d;
+    }
+}
+'''
+
+
+@cupy.memoize(for_each_device=True)
+def _get_edt_1d_kernel(dtype):
+    dtype = numpy.dtype(dtype)
+    c_type = 'float' if dtype == numpy.float32 else 'double'
+    return cupy.RawKernel('#define F {}\n'.format(c_type) + _edt_1d_code,
+                          'edt_1d')
+
+
+@cupy.memoize(for_each_device=True)
+def _get_init_kernel():
+    return cupy.ElementwiseKernel(
+        'T x', 'F y', 'y = x ? (F)CUDART_INF : (F)0',
+        'cupyx_scipy_ndimage_edt_tiled_init',
+        preamble='#include <cupy/math_constants.h>')
+
+
+def _edt_1d(f, axis, w):
+    # Squared distance transform of the C-contiguous f along axis, in-place.
+    n = f.shape[axis]
+    if f.size == 0 or n == 0:
+        return
+    stride = 1
+    for dim in f.shape[axis + 1:]:
+        stride *= dim
+    n_lines = f.size // n
+    v = cupy.empty(f.size, numpy.int32)
+    z = cupy.empty(f.size, numpy.float64)
+    g = cupy.empty(f.size, numpy.float64)
+    block_size = 128
+    grid_size = (n_lines + block_size - 1) // block_size
+    _get_edt_1d_kernel(f.dtype)(
+        (grid_size,), (block_size,),
+        (f, f, v, z, g, numpy.int64(n_lines), numpy.int32(n),
+         numpy.int64(stride), numpy.float64(w)))
+
+
+def _slab_ranges(n, slab_size):
+    return [(i, min(i + slab_size, n)) for i in range(0, n, slab_size)]
+
+
+def _default_slab_size(shape, axis, dtype):
+    # Uses about half of the free memory of the current device for a slab:
+    # the input, the distances and the 20 bytes per element of scratch.
+    free, _ = cupy.cuda.Device().mem_info
+    per_element = 1 + numpy.dtype(dtype).itemsize + 20
+    per_slice = per_element
+    for i, dim in enumerate(shape):
+        if i != axis:
+            per_slice *= dim
+    return max(1, int(free // 2 // max(per_slice, 1)))
+
+
+def distance_transform_edt_tiled(image, sampling=None, *, distances=None,
+                                 slab_size=None, devices=None,
+                                 float64_distances=True):
+    r"""Exact Euclidean distance transform of an array in host memory.
+
+    This function computes the same distances as
+    :func:`distance_transform_edt`, for a 2D or 3D `image` that does not fit
+    in the memory of a GPU. The squared distance transform is separable: the
+    1D transforms along the trailing axes are computed on slabs of the first
+    axis copied from the host, and the result is stored in the host output.
+    The transform along the first axis is then computed on slabs of the
+    second axis, which contain whole lines of the first axis, so that no
+    information has to be exchanged between the slabs. Only one slab is on
+    a device at a time.
+
+    Parameters
+    ----------
+    image : numpy.ndarray
+        Input data to transform, typically a :class:`numpy.ndarray` or a
+        :class:`numpy.memmap`. It is converted into binary: 1 wherever image
+        equates to True, 0 elsewhere.
+    sampling : float, or sequence of float, optional
+        Spacing of elements along each dimension. If a sequence, must be of
+        length equal to the image rank; if a single number, this is used for
+        all axes. If not specified, a grid spacing of unity is implied.
+    distances : numpy.ndarray, optional
+        An output array to store the calculated distance transform, instead of
+        returning it. It must be C-contiguous and have the same shape as
+        `image`. Should have dtype ``numpy.float32`` if `float64_distances`
+        is ``False``, otherwise it should be ``numpy.float64``.
+    slab_size : int, optional
+        The number of elements along the axis sliced into slabs. By default,
+        the slabs are sized to use about half of the free memory of a device.
+    devices : sequence of int, optional
+        The IDs of the devices the slabs are spread over. By default, the
+        current device is used.
+    float64_distances : bool, optional
+        If True, use double precision in the distance computation (to match
+        SciPy behavior). Otherwise, single precision will be used, which is
+        exact for squared distances below ``2**24``.
+
+    Returns
+    -------
+    distances : numpy.ndarray
+        The calculated distance transform. Returned only when `distances` is
+        not supplied.
+
+    Notes
+    -----
+    Unlike :func:`distance_transform_edt`, the feature transform (the
+    indices of the closest background elements) is not supported. The
+    foreground elements of an image without background are set to ``inf``.
+    The image is read from the host once, and the output is written twice
+    and read once.
+
+    This function is specific to CuPy and does not exist in SciPy.
+
+    .. seealso:: :func:`cupyx.scipy.ndimage.distance_transform_edt`
+    """
+    if image.ndim not in (2, 3):
+        raise NotImplementedError(
+            "Only 2D and 3D distance transforms are supported.")
+    ndim = image.ndim
+    if sampling is None:
+        sampling = (1.0,) * ndim
+    elif isinstance(sampling, numbers.Number):
+        sampling = (float(sampling),) * ndim
+    else:
+        sampling = tuple(float(s) for s in sampling)
+        if len(sampling) != ndim:
+            raise ValueError(
+                "sampling must have length equal to the input rank")
+    dtype = numpy.float64 if float64_distances else numpy.float32
+    if distances is None:
+        out = numpy.empty(image.shape, dtype)
+    else:
+        if not isinstance(distances, numpy.ndarray):
+            raise TypeError("distances must be a numpy.ndarray")
+        if distances.shape != image.shape:
+            raise RuntimeError("distances array has wrong shape")
+        if distances.dtype != dtype:
+            raise RuntimeError(
+                "distances array must have dtype: {}".format(
+                    numpy.dtype(dtype)))
+        if not distances.flags.c_contiguous:
+            raise RuntimeError("distances array must be C-contiguous")
+        out = distances
+    if devices is None:
+        devices = (cupy.cuda.Device().id,)
+    else:
+        devices = tuple(devices)
+        if not devices:
+            raise ValueError("devices must not be empty")
+    if slab_size is not None and slab_size < 1:
+        raise ValueError("slab_size must be positive")
+
+    def first_pass(start, stop):
+        # the transforms along the trailing axes of a slab of the first axis
+        f = _get_init_kernel()(cupy.asarray(image[start:stop]), dtype)
+        for axis in range(ndim - 1, 0, -1):
+            _edt_1d(f, axis, sampling[axis])
+        out[start:stop] = f.get()
+
+    def second_pass(start, stop):
+        # the transform along the first axis of a slab of the second axis
+        f = cupy.asarray(out[:, start:stop])
+        _edt_1d(f, 0, sampling[0])
+        cupy.sqrt(f, out=f)
+        out[:, start:stop] = f.get()
+
+    def run(func, axis):
+        with cupy.cuda.Device(devices[0]):
+            size = slab_size
+            if size is None:
+                size = _default_slab_size(image.shape, axis, dtype)
+        slabs = _slab_ranges(image.shape[axis], size)
+
+        def worker(i):
+            with cupy.cuda.Device(devices[i]):
+                for start, stop in slabs[i::len(devices)]:
+                    func(start, stop)
+                cupy.cuda.Device().synchronize()
+
+        if len(devices) == 1:
+            worker(0)
+            return
+        with concurrent.futures.ThreadPoolExecutor(len(devices)) as executor:
+            for future in [executor.submit(worker, i)
+                           for i in range(len(devices))]:
+                future.result()
+
+    run(first_pass, 0)
+    run(second_pass, 1)
+    if distances is None:
+        return out
@@ -4,6 +4,7 @@ import cupy
 
 from cupy import _core
 from cupy._core import internal
+from cupy._core._scalar import get_typename
 from cupyx.scipy.ndimage import _util
 from cupyx.scipy.ndimage import _filters_core
 from cupyx.scipy.ndimage import _filters_generic
@@ -173,6 +174,17 @@ def _correlate_or_convolve(input, weights, output, mode, cval, origin,
         weights = weights.conj()
     weights_dtype = _util._get_weights_dtype(input, weights)
     offsets = _filters_core._origins_to_offsets(origins, weights.shape)
+    axis = _filters_core._get_1d_filter_axis(weights.shape)
+    if axis is not None:
+        # separable passes use the tiled kernel when the layout allows it
+        complex_output = (input.dtype.kind == 'c' or
+                          cupy.dtype(weights_dtype).kind == 'c')
+        output = _util._get_output(output, input, None, complex_output)
+        out = _filters_core._call_tiled_1d_kernel(
+            input, weights, output, axis, offsets[axis], modes[axis], cval,
+            weights_dtype)
+        if out is not None:
+            return out
     kernel = _get_correlate_kernel(modes, weights.shape, int_type,
                                    offsets, cval)
     output = _filters_core._call_kernel(kernel, input, weights, output,
@@ -242,6 +254,20 @@ def uniform_filter1d(input, size, axis=-1, output=None, mode="reflect",
         from SciPy due to floating-point rounding of intermediate results.
     """
     weights_dtype = _util._init_weights_dtype(input)
+    if size >= _filters_core._running_sum_min_size:
+        # the cost of the running sum does not depend on the size
+        axis = internal._normalize_axis_index(axis, input.ndim)
+        origin = _util._check_origin(origin, size)
+        _util._check_mode(mode)
+        _util._check_cval(mode, cval, _util._is_integer_output(output, input))
+        out = _util._get_output(output, input, None,
+                                input.dtype.kind == 'c')
+        out = _filters_core._call_running_sum_1d_kernel(
+            input, size, out, axis, size // 2 + origin, mode, cval,
+            weights_dtype)
+        if out is not None:
+            return out
+        output = out
     weights = cupy.full(size, 1 / size, dtype=weights_dtype)
     return correlate1d(input, weights, axis, output, mode, cval, origin)
 
@@ -292,13 +318,9 @@ def uniform_filter(input, size=3, output=None, mode="reflect", cval=0.0,
     origins = _util._fix_sequence_arg(origin, num_axes, 'origin', int)
     modes = _util._fix_sequence_arg(mode, num_axes, 'mode', str)
 
-    weights_dtype = _util._init_weights_dtype(input)
-
-    def get(size, dtype=weights_dtype):
-        return None if size <= 1 else cupy.full(size, 1 / size, dtype=dtype)
-
-    return _run_1d_correlates(input, axes, sizes, get, output, modes, cval,
-                              origins)
+    filters = [None if size <= 1 else uniform_filter1d for size in sizes]
+    return _filters_core._run_1d_filters(filters, input, axes, sizes, output,
+                                         modes, cval, origins)
 
 
 def gaussian_filter1d(input, sigma, axis=-1, order=0, output=None,
@@ -1060,6 +1082,11 @@ def median_filter(input, size=None, footprint=None, output=None,
     Returns:
         cupy.ndarray: The result of the filtering.
 
+    .. note::
+        For 2D arrays of 8 or 16-bit integers and rectangular windows of at
+        least 49 elements, a sliding histogram is used, whose cost per
+        element grows with the width of the window rather than its area.
+
     .. seealso:: :func:`scipy.ndimage.median_filter`
     """
     return _rank_filter(input, lambda fs: fs//2,
@@ -1147,8 +1174,14 @@ def _rank_filter(input, get_rank, size=None, footprint=None, output=None,
         return _min_or_max_filter(input, None, footprint, None, output, modes,
                                   cval, origins, 'max', axes)
     offsets = _filters_core._origins_to_offsets(origins, footprint.shape)
+    full = filter_size == footprint.size
+    if full and filter_size >= _HISTOGRAM_RANK_MIN_SIZE:
+        result = _rank_filter_histogram_2d(input, rank, footprint.shape,
+                                           offsets, modes, cval, output)
+        if result is not None:
+            return result
     kernel = _get_rank_kernel(filter_size, rank, modes, footprint.shape,
-                              offsets, float(cval), int_type)
+                              offsets, float(cval), int_type, full)
     return _filters_core._call_kernel(kernel, input, footprint, output,
                                       weights_dtype=bool)
 
@@ -1179,9 +1212,64 @@ def _get_shell_gap(filter_size):
     return gap
 
 
+# The full footprints up to this size use a selection network
+_NETWORK_RANK_MAX_SIZE = 25
+
+
+@cupy._util.memoize()
+def _get_forgetful_selection(filter_size, rank):
+    # Forgetful selection: the values are added to a buffer one at a time and
+    # its maximum (minimum) is dropped as soon as the buffer holds enough
+    # values for it to be above (below) the rank. The minimum and maximum are
+    # moved by compare-exchanges between fixed elements of the array, so that
+    # the whole selection is straight-line code that can be kept in registers.
+    ops = []
+    buf = []
+    low, high = rank, filter_size - 1 - rank
+    for i in range(filter_size):
+        buf.append(i)
+        while len(buf) > 1:
+            if len(buf) >= low + 2:
+                # drop the maximum
+                ops += ['cswap(values[{}], values[{}]);'.format(j, buf[-1])
+                        for j in buf[:-1]]
+                buf.pop()
+                high -= 1
+            elif len(buf) >= high + 2:
+                # drop the minimum
+                ops += ['cswap(values[{}], values[{}]);'.format(buf[-1], j)
+                        for j in buf[:-1]]
+                buf.pop()
+                low -= 1
+            else:
+                break
+    return '\n'.join(ops), buf[0]
+
+
+__CSWAP = '''
+__device__ __forceinline__ void cswap(X& a, X& b) {
+    X lo = b < a ? b : a;
+    X hi = b < a ? a : b;
+    a = lo;
+    b = hi;
+}'''
+
+
 @cupy._util.memoize(for_each_device=True)
 def _get_rank_kernel(filter_size, rank, modes, w_shape, offsets, cval,
-                     int_type):
+                     int_type, full=False):
+    if full and filter_size <= _NETWORK_RANK_MAX_SIZE:
+        # The loops over the footprint are unrolled so that the values are
+        # stored to and selected from registers.
+        network, index = _get_forgetful_selection(filter_size, rank)
+        return _filters_core._generate_nd_kernel(
+            'rank_network_{}_{}'.format(filter_size, rank),
+            'int iv = 0;\nX values[{}];'.format(filter_size),
+            'values[iv++] = {value};',
+            '{}\ny=cast<Y>(values[{}]);'.format(network, index),
+            modes, w_shape, int_type, offsets, cval, preamble=__CSWAP,
+            all_weights_nonzero=True, unroll_loops=True)
+
     s_rank = min(rank, filter_size - rank - 1)
     # The threshold was set based on the measurements on a V100
     # TODO(leofang, anaruse): Use Optuna to automatically tune the threshold,
@@ -1234,6 +1322,184 @@ def _get_rank_kernel(filter_size, rank, modes, w_shape, offsets, cval,
         modes, w_shape, int_type, offsets, cval, preamble=sorter)
 
 
+# The full footprints from this size use the histogram kernel when possible
+_HISTOGRAM_RANK_MIN_SIZE = 49
+
+# The rank filter of arrays of 8 or 16-bit integers with a rectangular
+# window by a sliding histogram (Huang's algorithm). Each thread computes
+# a column of a strip of rows of the output: the histogram of its window is
+# updated by the rows that enter and leave it, and the bin of the result is
+# moved from the previous one, so that the cost per element is O(kw) instead
+# of the O(kh * kw) of a selection over the window. The 16-bit values are
+# binned by their high byte, and a histogram of the low bytes of the values
+# in the bin of the result is kept and only rebuilt when that bin changes.
+# Per-column histograms shared by the neighboring pixels (Perreault and
+# Hebert) do not reduce the cost further here, as each thread still needs its
+# own window histogram.
+_RANK_HISTOGRAM_2D_KERNEL = r'''
+#define KEY(v) ((int)(v) + BIAS)
+
+extern "C" __global__ void cupyx_scipy_ndimage_rank_histogram_2d(
+        const T* x, T* y, int h, int w, int xw, int kh, int kw, int rank,
+        int strip) {
+    int j = blockIdx.x * blockDim.x + threadIdx.x;
+    if (j >= w) {
+        return;
+    }
+    int i0 = blockIdx.y * strip;
+    int i1 = i0 + strip < h ? i0 + strip : h;
+    const T* col = x + j;
+    // the histogram of the window, the bin m of the result and the number
+    // lt of the values in the bins below it
+    int hist[256];
+    int m = 0, lt = 0;
+#if FINE
+    // the histogram of the low bytes of the values in the bin fc
+    int fine[256];
+    int fc = -1, fm = 0, flt = 0;
+#endif
+    for (int b = 0; b < 256; b++) {
+        hist[b] = 0;
+    }
+    for (int i = i0; i < i0 + kh - 1; i++) {
+        for (int k = 0; k < kw; k++) {
+            hist[KEY(col[i * xw + k]) >> SHIFT]++;
+        }
+    }
+    auto update = [&](T v, int d) {
+        int key = KEY(v);
+        int b = key >> SHIFT;
+        hist[b] += d;
+        lt += b < m ? d : 0;
+#if FINE
+        if (b == fc) {
+            int lo = key & 255;
+            fine[lo] += d;
+            flt += lo < fm ? d : 0;
+        }
+#endif
+    };
+    for (int i = i0; i < i1; i++) {
+        // the row entering the window, and the one leaving it
+        for (int k = 0; k < kw; k++) {
+            update(col[(i + kh - 1) * xw + k], 1);
+            if (i > i0) {
+                update(col[(i - 1) * xw + k], -1);
+            }
+        }
+        while (lt > rank) {
+            m--;
+            lt -= hist[m];
+        }
+        while (lt + hist[m] <= rank) {
+            lt += hist[m];
+            m++;
+        }
+        int key = m;
+#if FINE
+        if (m != fc) {
+            for (int b = 0; b < 256; b++) {
+                fine[b] = 0;
+            }
+            for (int ii = i; ii < i + kh; ii++) {
+                for (int k = 0; k < kw; k++) {
+                    int v = KEY(col[ii * xw + k]);
+                    if ((v >> SHIFT) == m) {
+                        fine[v & 255]++;
+                    }
+                }
+            }
+            fc = m;
+            fm = 0;
+            flt = 0;
+        }
+        int r = rank - lt;
+        while (flt > r) {
+            fm--;
+            flt -= fine[fm];
+        }
+        while (flt + fine[fm] <= r) {
+            flt += fine[fm];
+            fm++;
+        }
+        key = (m << 8) | fm;
+#endif
+        y[i * w + j] = (T)(key - BIAS);
+    }
+}
+'''
+
+# The numpy.pad modes of the boundary modes of the filters
+_pad_modes = {
+    'reflect': 'symmetric', 'grid-reflect': 'symmetric',
+    'grid-mirror': 'symmetric', 'mirror': 'reflect', 'nearest': 'edge',
+    'wrap': 'wrap', 'grid-wrap': 'wrap', 'constant': 'constant',
+}
+
+
+@cupy._util.memoize(for_each_device=True)
+def _get_rank_histogram_2d_kernel(dtype):
+    unsigned = dtype.kind == 'u'
+    bias = 0 if unsigned else 1 << (dtype.itemsize * 8 - 1)
+    code = '#define T {}\n#define BIAS {}\n#define SHIFT {}\n' \
+        '#define FINE {}\n'.format(get_typename(dtype), bias,
+                                    8 * (dtype.itemsize - 1),
+                                    int(dtype.itemsize == 2))
+    return cupy.RawKernel(code + _RANK_HISTOGRAM_2D_KERNEL,
+                          'cupyx_scipy_ndimage_rank_histogram_2d',
+                          options=('--std=c++11',))
+
+
+def _rank_filter_histogram_2d(input, rank, w_shape, offsets, modes, cval,
+                              output):
+    # Returns None when the histogram kernel does not apply.
+    if (input.ndim != 2 or input.dtype.kind not in 'iu'
+            or input.dtype.itemsize > 2):
+        return None
+    if isinstance(modes, str):
+        modes = (modes,) * 2
+    pad_width = [(o, k - 1 - o) for k, o in zip(w_shape, offsets)]
+    for mode, (before, after), n in zip(modes, pad_width, input.shape):
+        if mode != 'constant' and max(before, after) >= n:
+            return None
+    if 'constant' in modes:
+        info = numpy.iinfo(input.dtype)
+        if cval != int(cval) or not info.min <= cval <= info.max:
+            return None
+        cval = int(cval)
+    x = input
+    for axis, mode in enumerate(modes):
+        width = [(0, 0), (0, 0)]
+        width[axis] = pad_width[axis]
+        kwargs = {'constant_values': cval} if mode == 'constant' else {}
+        x = cupy.pad(x, width, _pad_modes[mode], **kwargs)
+    x = cupy.ascontiguousarray(x)
+    if x.size >= 1 << 31:
+        return None
+
+    h, w = input.shape
+    kh, kw = w_shape
+    out = _util._get_output(output, input)
+    y = out
+    if (out.dtype != input.dtype or not out.flags.c_contiguous
+            or cupy.shares_memory(out, input, 'MAY_SHARE_BOUNDS')):
+        y = cupy.empty(input.shape, input.dtype)
+    if y.size:
+        # the strips are long enough to amortize the initial histograms
+        strip = max(4 * kh, 32)
+        block_size = 128
+        grid = ((w + block_size - 1) // block_size,
+                (h + strip - 1) // strip)
+        _get_rank_histogram_2d_kernel(input.dtype)(
+            grid, (block_size,),
+            (x, y, numpy.int32(h), numpy.int32(w), numpy.int32(x.shape[1]),
+             numpy.int32(kh), numpy.int32(kw), numpy.int32(rank),
+             numpy.int32(strip)))
+    if y is not out:
+        _core.elementwise_copy(y, out)
+    return out
+
+
 def generic_filter(input, function, size=None, footprint=None,
                    output=None, mode="reflect", cval=0.0, origin=0):
     """Compute a multi-dimensional filter using the provided raw kernel or
@@ -6,6 +6,7 @@ import cupy
 from cupy_backends.cuda.api import runtime
 from cupy import _core
 from cupy._core import internal
+from cupy._core._scalar import get_typename
 from cupyx.scipy.ndimage import _util
 
 
@@ -233,10 +234,21 @@ __device__ __forceinline__ bool nonzero(T x) { return x != static_cast<T>(0); }
 """
 
 
+def _format_cval(cval):
+    if cval is numpy.nan:
+        return 'CUDART_NAN'
+    elif cval == numpy.inf:
+        return 'CUDART_INF'
+    elif cval == -numpy.inf:
+        return '-CUDART_INF'
+    return cval
+
+
 def _generate_nd_kernel(name, pre, found, post, modes, w_shape, int_type,
                         offsets, cval, ctype='X', preamble='', options=(),
                         has_weights=True, has_structure=False, has_mask=False,
-                        binary_morphology=False, all_weights_nonzero=False):
+                        binary_morphology=False, all_weights_nonzero=False,
+                        unroll_loops=False):
     # Currently this code uses CArray for weights but avoids using CArray for
     # the input data and instead does the indexing itself since it is faster.
     # If CArray becomes faster than follow the comments that start with
@@ -282,6 +294,9 @@ def _generate_nd_kernel(name, pre, found, post, modes, w_shape, int_type,
         ws_post = 'iws++;'
 
     loops = []
+    # fully unrolled loops allow arrays indexed by the iterations to be kept
+    # in registers
+    unroll = '#pragma unroll' if unroll_loops else ''
     for j in range(ndim):
         if w_shape[j] == 1:
             # CArray: string becomes 'inds[{j}] = ind_{j};', remove (int_)type
@@ -291,6 +306,7 @@ def _generate_nd_kernel(name, pre, found, post, modes, w_shape, int_type,
                 modes[j], f'ix_{j}', f'xsize_{j}', int_type)
             # CArray: last line of string becomes inds[{j}] = ix_{j};
             loops.append(f'''
+    {unroll}
     for (int iw_{j} = 0; iw_{j} < {w_shape[j]}; iw_{j}++)
     {{
         {int_type} ix_{j} = ind_{j} + iw_{j};
@@ -303,12 +319,7 @@ def _generate_nd_kernel(name, pre, found, post, modes, w_shape, int_type,
     if constant_mode:
         cond = ' || '.join([f'(ix_{j} < 0)' for j in range(ndim)])
 
-    if cval is numpy.nan:
-        cval = 'CUDART_NAN'
-    elif cval == numpy.inf:
-        cval = 'CUDART_INF'
-    elif cval == -numpy.inf:
-        cval = '-CUDART_INF'
+    cval = _format_cval(cval)
 
     if binary_morphology:
         found = found.format(cond=cond, value=value)
@@ -359,3 +370,258 @@ def _generate_nd_kernel(name, pre, found, post, modes, w_shape, int_type,
     return cupy.ElementwiseKernel(in_params, out_params, operation, name,
                                   reduce_dims=False, preamble=preamble,
                                   options=options)
+
+
+# The tiled kernels of the 1D filters are used along one axis of C-contiguous
+# arrays, that are viewed as (outer, n, inner) arrays. A block of (BX, BY)
+# threads stages the halo'd tile of TN = BY * R elements along the axis and
+# BX elements of the inner axis in shared memory, and each thread computes R
+# outputs from it. The boundary mode is only evaluated for the elements of
+# the tile that are outside of the array.
+_TILED_1D_KERNEL = r'''
+#define BX {bx}
+#define BY {by}
+#define R {r}
+#define TN (BY * R)
+#define TILE_LEN (TN + {wsize} - 1)
+#define TILE_BYTES ((sizeof(W) * TILE_LEN * BX + 15) / 16 * 16)
+
+extern "C" __global__ void {name}(
+        const X* x, const W* w, Y* y, long long outer, {int_t} n,
+        {int_t} inner) {{
+    __shared__ __align__(16) unsigned char smem[
+        TILE_BYTES + sizeof(W) * {wsize}];
+    W (*tile)[BX] = (W (*)[BX])smem;
+    W* ws = (W*)(smem + TILE_BYTES);
+    for (int k = threadIdx.y * BX + threadIdx.x; k < {wsize}; k += BX * BY) {{
+        ws[k] = w[k];
+    }}
+    {int_t} j = ({int_t})blockIdx.x * BX + threadIdx.x;
+    {int_t} t0 = ({int_t})blockIdx.y * TN;
+    for (long long o = blockIdx.z; o < outer; o += gridDim.z) {{
+        const X* xo = x + o * n * inner;
+        // the tile of the previous line has been read by all threads
+        __syncthreads();
+        if (j < inner) {{
+            for (int t = threadIdx.y; t < TILE_LEN; t += BY) {{
+                {int_t} ix = t0 + t - {offset};
+                if ((ix < 0) || (ix >= n)) {{
+                    {boundary}
+                }}
+                tile[t][threadIdx.x] = {load};
+            }}
+        }}
+        __syncthreads();
+        if (j < inner) {{
+            #pragma unroll
+            for (int s = 0; s < R; s++) {{
+                int t = threadIdx.y + s * BY;
+                if (t0 + t < n) {{
+                    W sum = (W)0;
+                    for (int k = 0; k < {wsize}; k++) {{
+                        sum += tile[t + k][threadIdx.x] * ws[k];
+                    }}
+                    y[(o * n + t0 + t) * inner + j] = cast<Y>(sum);
+                }}
+            }}
+        }}
+    }}
+}}
+'''
+
+
+# The running-sum kernel of the uniform filters along one axis. Each thread
+# computes the outputs of a segment of SEG elements of a line, updating the
+# sum of the window with the element that enters it and the one that leaves
+# it, so that the cost does not depend on the size of the window.
+_RUNNING_SUM_1D_KERNEL = r'''
+#define BX {bx}
+#define BY {by}
+#define SEG {seg}
+
+__device__ __forceinline__ W load_{name}(
+        const X* xo, {int_t} ix, {int_t} n, {int_t} inner, {int_t} j) {{
+    if ((ix < 0) || (ix >= n)) {{
+        {boundary}
+    }}
+    return {load};
+}}
+
+extern "C" __global__ void {name}(
+        const X* x, Y* y, long long outer, {int_t} n, {int_t} inner) {{
+    {int_t} j = ({int_t})blockIdx.x * BX + threadIdx.x;
+    {int_t} p0 = (({int_t})blockIdx.y * BY + threadIdx.y) * SEG;
+    if ((j >= inner) || (p0 >= n)) {{
+        return;
+    }}
+    {int_t} p1 = (p0 + SEG < n) ? p0 + SEG : n;
+    for (long long o = blockIdx.z; o < outer; o += gridDim.z) {{
+        const X* xo = x + o * n * inner;
+        Y* yo = y + o * n * inner;
+        W sum = (W)0;
+        for (int k = 0; k < {size}; k++) {{
+            sum += load_{name}(xo, p0 - {offset} + k, n, inner, j);
+        }}
+        yo[p0 * inner + j] = cast<Y>(sum / (W){size});
+        for ({int_t} p = p0 + 1; p < p1; p++) {{
+            sum += load_{name}(xo, p - {offset} + {size} - 1, n, inner, j);
+            sum -= load_{name}(xo, p - {offset} - 1, n, inner, j);
+            yo[p * inner + j] = cast<Y>(sum / (W){size});
+        }}
+    }}
+}}
+'''
+
+
+# The shared memory used by the tile of a block
+_tiled_max_shared_bytes = 48 * 1024
+_tiled_max_grid_y = 65535
+_tiled_max_grid_z = 65535
+# The running sum is used from this size of uniform filters
+_running_sum_min_size = 16
+_running_sum_segment = 64
+_tiled_modes = ('reflect', 'grid-mirror', 'mirror', 'nearest', 'grid-wrap',
+                'constant')
+
+
+def _get_1d_filter_axis(w_shape):
+    """Returns the axis of a filter that is 1D, or None."""
+    axes = [i for i, s in enumerate(w_shape) if s != 1]
+    return axes[0] if len(axes) == 1 else None
+
+
+def _get_tiled_block(inner):
+    # (BX, BY, R): a line at a time along the last axis, otherwise the inner
+    # axis is read by consecutive threads for coalescing
+    if inner == 1:
+        return 1, 128, 2
+    bx = min(32, 1 << (inner - 1).bit_length())
+    by = 256 // bx
+    return bx, by, max(1, 32 // by)
+
+
+def _get_tiled_layout(input, output, axis, mode):
+    """Returns (outer, n, inner) if the tiled kernels can be used."""
+    if mode not in _tiled_modes:
+        return None
+    if not (input.flags.c_contiguous and output.flags.c_contiguous):
+        return None
+    if input.size == 0 or cupy.shares_memory(
+            output, input, 'MAY_SHARE_BOUNDS'):
+        return None
+    outer = internal.prod(input.shape[:axis])
+    inner = internal.prod(input.shape[axis + 1:])
+    return outer, input.shape[axis], inner
+
+
+def _get_tiled_load(mode, cval):
+    load = 'cast<W>(xo[ix * inner + j])'
+    if mode == 'constant':
+        load = f'(ix < 0) ? cast<W>({_format_cval(cval)}) : {load}'
+    return load
+
+
+@cupy._util.memoize(for_each_device=True)
+def _get_tiled_1d_kernel(x_type, w_type, y_type, wsize, offset, mode, cval,
+                         int_type, block):
+    bx, by, r = block
+    name = 'cupyx_scipy_ndimage_correlate1d_tiled_{}_w{}_o{}_b{}x{}x{}'.format(
+        mode.replace('-', '_'), wsize, offset, bx, by, r)
+    if int_type == 'ptrdiff_t':
+        name += '_i64'
+    code = _TILED_1D_KERNEL.format(
+        name=name, bx=bx, by=by, r=r, wsize=wsize, offset=offset,
+        int_t=int_type, load=_get_tiled_load(mode, cval),
+        boundary=_util._generate_boundary_condition_ops(
+            mode, 'ix', 'n', int_type))
+    code = ('#include <cupy/carray.cuh>\n' + includes + _CAST_FUNCTION +
+            f'typedef {x_type} X;\ntypedef {w_type} W;\ntypedef {y_type} Y;\n'
+            + code)
+    return cupy.RawKernel(code, name, options=('--std=c++11',))
+
+
+@cupy._util.memoize(for_each_device=True)
+def _get_running_sum_1d_kernel(x_type, w_type, y_type, size, offset, mode,
+                               cval, int_type, block):
+    bx, by = block
+    name = 'cupyx_scipy_ndimage_uniform1d_running_sum_{}_s{}_o{}_b{}x{}'
+    name = name.format(mode.replace('-', '_'), size, offset, bx, by)
+    if int_type == 'ptrdiff_t':
+        name += '_i64'
+    code = _RUNNING_SUM_1D_KERNEL.format(
+        name=name, bx=bx, by=by, seg=_running_sum_segment, size=size,
+        offset=offset, int_t=int_type, load=_get_tiled_load(mode, cval),
+        boundary=_util._generate_boundary_condition_ops(
+            mode, 'ix', 'n', int_type))
+    code = ('#include <cupy/carray.cuh>\n' + includes + _CAST_FUNCTION +
+            f'typedef {x_type} X;\ntypedef {w_type} W;\ntypedef {y_type} Y;\n'
+            + code)
+    return cupy.RawKernel(code, name, options=('--std=c++11',))
+
+
+def _call_tiled_1d_kernel(input, weights, output, axis, offset, mode, cval,
+                          weights_dtype):
+    """Runs a 1D correlation along an axis with the tiled kernel.
+
+    Returns the output, or None if the tiled kernel cannot be used, in which
+    case nothing is computed. The output must be a C-contiguous array that
+    does not overlap the input.
+    """
+    mode = 'grid-wrap' if mode == 'wrap' else mode
+    layout = _get_tiled_layout(input, output, axis, mode)
+    if layout is None:
+        return None
+    outer, n, inner = layout
+    weights = cupy.ascontiguousarray(weights, weights_dtype).ravel()
+    wsize = weights.size
+    block = _get_tiled_block(inner)
+    bx, by, r = block
+    tn = by * r
+    smem = ((weights.itemsize * (tn + wsize - 1) * bx + 15) // 16 * 16 +
+            weights.itemsize * wsize)
+    grid_y = (n + tn - 1) // tn
+    if smem > _tiled_max_shared_bytes or grid_y > _tiled_max_grid_y:
+        return None
+    int_type = _util._get_inttype(input)
+    kernel = _get_tiled_1d_kernel(
+        get_typename(input.dtype), get_typename(weights.dtype),
+        get_typename(output.dtype), wsize, offset, mode, cval, int_type,
+        block)
+    int_t = numpy.int32 if int_type == 'int' else numpy.int64
+    grid = ((inner + bx - 1) // bx, grid_y, min(outer, _tiled_max_grid_z))
+    kernel(grid, (bx, by), (input, weights, output, numpy.int64(outer),
+                            int_t(n), int_t(inner)))
+    return output
+
+
+def _call_running_sum_1d_kernel(input, size, output, axis, offset, mode,
+                                cval, weights_dtype):
+    """Runs a 1D uniform filter along an axis with the running-sum kernel.
+
+    Returns the output, or None if the kernel cannot be used, in which case
+    nothing is computed.
+    """
+    mode = 'grid-wrap' if mode == 'wrap' else mode
+    if size < _running_sum_min_size or output.dtype.kind not in 'fc':
+        return None
+    if numpy.dtype(weights_dtype).kind not in 'fc':
+        return None
+    layout = _get_tiled_layout(input, output, axis, mode)
+    if layout is None:
+        return None
+    outer, n, inner = layout
+    bx, by, _ = _get_tiled_block(inner)
+    seg = _running_sum_segment
+    grid_y = (n + by * seg - 1) // (by * seg)
+    if grid_y > _tiled_max_grid_y:
+        return None
+    int_type = _util._get_inttype(input)
+    kernel = _get_running_sum_1d_kernel(
+        get_typename(input.dtype), get_typename(weights_dtype),
+        get_typename(output.dtype), size, offset, mode, cval, int_type,
+        (bx, by))
+    int_t = numpy.int32 if int_type == 'int' else numpy.int64
+    grid = ((inner + bx - 1) // bx, grid_y, min(outer, _tiled_max_grid_z))
+    kernel(grid, (bx, by), (input, output, numpy.int64(outer), int_t(n),
+                            int_t(inner)))
+    return output
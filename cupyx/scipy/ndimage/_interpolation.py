@@ -15,6 +15,22 @@ from cupyx.scipy.ndimage import _spline_prefilter_core
 _prod = cupy._core.internal.prod
 
 
+def _texture_call(func, input, order, **kwargs):
+    # Runs a function of the texture memory backend
+    if runtime.is_hip:
+        raise RuntimeError(
+            'HIP currently does not support texture acceleration')
+    tm_interp = 'linear' if order > 0 else 'nearest'
+    return func(data=input, interpolation=tm_interp, **kwargs)
+
+
+def _homogeneous_matrix(matrix, offset):
+    m = numpy.identity(len(offset) + 1, dtype=numpy.float32)
+    m[:-1, :-1] = matrix
+    m[:-1, -1] = offset
+    return cupy.asarray(m)
+
+
 def _check_parameter(func_name, order, mode):
     if order is None:
         warnings.warn(f'Currently the default order of {func_name} is 1. In a '
@@ -250,7 +266,8 @@ def _filter_input(image, prefilter, mode, cval, order):
 
 
 def map_coordinates(input, coordinates, output=None, order=3,
-                    mode='constant', cval=0.0, prefilter=True):
+                    mode='constant', cval=0.0, prefilter=True, *,
+                    texture_memory=False):
     """Map the input array to new coordinates by interpolation.
 
     The array of coordinates is used to find, for each point in the output, the
@@ -283,6 +300,18 @@ def map_coordinates(input, coordinates, output=None, order=3,
             slightly blurred if ``order > 1``, unless the input is prefiltered,
             i.e. it is the result of calling ``spline_filter`` on the original
             input.
+        texture_memory (bool): If True, uses GPU texture memory. Supports only:
+
+            - 2D and 3D float32 arrays as input
+            - ``mode='constant'``, ``'grid-constant'``, ``'nearest'``,
+                ``'reflect'``, ``'grid-mirror'`` and ``'grid-wrap'``
+            - ``order=0`` (nearest neighbor) and ``order=1`` (linear
+                interpolation)
+            - NVIDIA CUDA GPUs
+
+            The texture object is cached for the input array. The hardware
+            interpolation uses 8-bit fixed-point weights, so the results are
+            less accurate than with the default backend.
 
     Returns:
         cupy.ndarray:
@@ -292,6 +321,11 @@ def map_coordinates(input, coordinates, output=None, order=3,
     .. seealso:: :func:`scipy.ndimage.map_coordinates`
     """
 
+    if texture_memory:
+        return _texture_call(_texture.map_coordinates, input, order,
+                             coordinates=coordinates, output=output,
+                             mode=mode, border_value=cval)
+
     _check_parameter('map_coordinates', order, mode)
 
     if mode == 'opencv' or mode == '_opencv_edge':
@@ -371,11 +405,16 @@ def affine_transform(input, matrix, offset=0.0, output_shape=None, output=None,
             - 2D and 3D float32 arrays as input
             - ``(ndim + 1, ndim + 1)`` homogeneous float32 transformation
                 matrix
-            - ``mode='constant'`` and ``mode='nearest'``
+            - ``mode='constant'``, ``'grid-constant'``, ``'nearest'``,
+                ``'reflect'``, ``'grid-mirror'`` and ``'grid-wrap'``
             - ``order=0`` (nearest neighbor) and ``order=1`` (linear
                 interpolation)
             - NVIDIA CUDA GPUs
 
+            The texture object is cached for the input array. The hardware
+            interpolation uses 8-bit fixed-point weights, so the results are
+            less accurate than with the default backend.
+
     Returns:
         cupy.ndarray or None:
             The transformed input. If ``output`` is given as a parameter,
@@ -385,17 +424,10 @@ def affine_transform(input, matrix, offset=0.0, output_shape=None, output=None,
     """
 
     if texture_memory:
-        if runtime.is_hip:
-            raise RuntimeError(
-                'HIP currently does not support texture acceleration')
-        tm_interp = 'linear' if order > 0 else 'nearest'
-        return _texture.affine_transformation(data=input,
-                                              transformation_matrix=matrix,
-                                              output_shape=output_shape,
-                                              output=output,
-                                              interpolation=tm_interp,
-                                              mode=mode,
-                                              border_value=cval)
+        return _texture_call(_texture.affine_transformation, input, order,
+                             transformation_matrix=matrix,
+                             output_shape=output_shape, output=output,
+                             mode=mode, border_value=cval)
 
     _check_parameter('affine_transform', order, mode)
 
@@ -479,7 +511,8 @@ def _minmax(coor, minc, maxc):
 
 
 def rotate(input, angle, axes=(1, 0), reshape=True, output=None, order=3,
-           mode='constant', cval=0.0, prefilter=True):
+           mode='constant', cval=0.0, prefilter=True, *,
+           texture_memory=False):
     """Rotate an array.
 
     The array is rotated in the plane defined by the two axes given by the
@@ -511,6 +544,18 @@ def rotate(input, angle, axes=(1, 0), reshape=True, output=None, order=3,
             slightly blurred if ``order > 1``, unless the input is prefiltered,
             i.e. it is the result of calling ``spline_filter`` on the original
             input.
+        texture_memory (bool): If True, uses GPU texture memory. Supports only:
+
+            - 2D and 3D float32 arrays as input
+            - ``mode='constant'``, ``'grid-constant'``, ``'nearest'``,
+                ``'reflect'``, ``'grid-mirror'`` and ``'grid-wrap'``
+            - ``order=0`` (nearest neighbor) and ``order=1`` (linear
+                interpolation)
+            - NVIDIA CUDA GPUs
+
+            The texture object is cached for the input array. The hardware
+            interpolation uses 8-bit fixed-point weights, so the results are
+            less accurate than with the default backend.
 
     Returns:
         cupy.ndarray or None:
@@ -573,6 +618,13 @@ def rotate(input, angle, axes=(1, 0), reshape=True, output=None, order=3,
     offset = numpy.zeros(ndim, dtype=cupy.float64)
     offset[axes] = in_center - out_center
 
+    if texture_memory:
+        return _texture_call(_texture.affine_transformation, input, order,
+                             transformation_matrix=_homogeneous_matrix(
+                                 matrix, offset),
+                             output_shape=output_shape, output=output,
+                             mode=mode, border_value=cval)
+
     matrix = cupy.asarray(matrix)
     offset = cupy.asarray(offset)
 
@@ -658,7 +710,7 @@ def shift(input, shift, output=None, order=3, mode='constant', cval=0.0,
 
 
 def zoom(input, zoom, output=None, order=3, mode='constant', cval=0.0,
-         prefilter=True, *, grid_mode=False):
+         prefilter=True, *, grid_mode=False, texture_memory=False):
     """Zoom an array.
 
     The array is zoomed using spline interpolation of the requested order.
@@ -701,6 +753,18 @@ def zoom(input, zoom, output=None, order=3, mode='constant', cval=0.0,
 
             The starting point of the arrow in the diagram above corresponds to
             coordinate location 0 in each mode.
+        texture_memory (bool): If True, uses GPU texture memory. Supports only:
+
+            - 2D and 3D float32 arrays as input
+            - ``mode='constant'``, ``'grid-constant'``, ``'nearest'``,
+                ``'reflect'``, ``'grid-mirror'`` and ``'grid-wrap'``
+            - ``order=0`` (nearest neighbor) and ``order=1`` (linear
+                interpolation)
+            - NVIDIA CUDA GPUs
+
+            The texture object is cached for the input array. The hardware
+            interpolation uses 8-bit fixed-point weights, so the results are
+            less accurate than with the default backend.
 
     Returns:
         cupy.ndarray or None:
@@ -719,6 +783,9 @@ def zoom(input, zoom, output=None, order=3, mode='constant', cval=0.0,
     output_shape = tuple(output_shape)
 
     if mode == 'opencv':
+        if texture_memory:
+            raise ValueError(
+                'Unsupported address mode opencv for texture memory')
         zoom = []
         offset = []
         for in_size, out_size in zip(input.shape, output_shape):
@@ -764,6 +831,17 @@ def zoom(input, zoom, output=None, order=3, mode='constant', cval=0.0,
             else:
                 zoom.append(0)
 
+        if texture_memory:
+            if grid_mode:
+                offset = [0.5 * z - 0.5 for z in zoom]
+            else:
+                offset = [0.0] * input.ndim
+            return _texture_call(_texture.affine_transformation, input, order,
+                                 transformation_matrix=_homogeneous_matrix(
+                                     numpy.diag(zoom), offset),
+                                 output_shape=output_shape, output=output,
+                                 mode=mode, border_value=cval)
+
         output = _util._get_output(output, input, shape=output_shape)
         if input.dtype.kind in 'iu':
             input = input.astype(cupy.float32)
@@ -0,0 +1,374 @@
+"""Statistics of the values of an array for each of its labels.
+
+:class:`_LabeledReduction` maps the labels to the positions of the unique
+values of ``index`` once, and then computes the count, sum, (centered) sum
+of squares, minimum and maximum of the values of each label, with the
+positions of the extrema, in a single pass over the data:
+
+* With few labels, each thread block privatizes the accumulators in shared
+  memory, and adds them to the global ones once at the end. The positions
+  of the extrema are found by a second pass over the elements that are
+  equal to them.
+* With many labels, the elements are sorted by label and a thread block
+  reduces the segment of each label, so that no atomics are needed.
+
+The minimum and maximum are accumulated as unsigned 64-bit keys that keep
+the order of the values, so that any real dtype is reduced exactly.
+"""
+
+import builtins
+
+import numpy
+
+import cupy
+from cupy import _core
+from cupy._core._scalar import get_typename
+from cupy import _util
+
+
+# 5 accumulators of 8 bytes per label fit in 20 KiB of shared memory
+_max_shared_bins = 512
+_block_size = 256
+_max_blocks = 512
+_segment_block_size = 128
+
+
+def _get_key_kind(dtype):
+    if dtype.kind == 'f':
+        return 0
+    if dtype.kind == 'i':
+        return 1
+    return 2
+
+
+_key_code = r'''
+#if KEY_KIND == 0
+typedef double key_value_t;
+__device__ unsigned long long to_key(double v) {
+    unsigned long long b = (unsigned long long)__double_as_longlong(v);
+    return (b >> 63) ? ~b : b | (1ULL << 63);
+}
+__device__ double from_key(unsigned long long k) {
+    return __longlong_as_double(
+        (long long)((k >> 63) ? k & ~(1ULL << 63) : ~k));
+}
+#elif KEY_KIND == 1
+typedef long long key_value_t;
+__device__ unsigned long long to_key(long long v) {
+    return (unsigned long long)v ^ (1ULL << 63);
+}
+__device__ long long from_key(unsigned long long k) {
+    return (long long)(k ^ (1ULL << 63));
+}
+#else
+typedef unsigned long long key_value_t;
+__device__ unsigned long long to_key(unsigned long long v) {
+    return v;
+}
+__device__ unsigned long long from_key(unsigned long long k) {
+    return k;
+}
+#endif
+'''
+
+
+_reduce_code = r'''
+extern "C" __global__ void cupyx_scipy_ndimage_labeled_stats_shared(
+        const T* x, const int* bins, const long long size, const int n_bins,
+        const double* center, unsigned long long* count, double* sum,
+        double* sumsq, unsigned long long* kmin, unsigned long long* kmax) {
+    extern __shared__ unsigned long long smem[];
+    unsigned long long* s_count = smem;
+    double* s_sum = (double*)(smem + n_bins);
+    double* s_sumsq = (double*)(smem + 2 * n_bins);
+    unsigned long long* s_min = smem + 3 * n_bins;
+    unsigned long long* s_max = smem + 4 * n_bins;
+    for (int j = threadIdx.x; j < n_bins; j += blockDim.x) {
+        s_count[j] = 0;
+        s_sum[j] = 0;
+        s_sumsq[j] = 0;
+        s_min[j] = ~0ULL;
+        s_max[j] = 0;
+    }
+    __syncthreads();
+
+    for (long long i = blockIdx.x * (long long)blockDim.x + threadIdx.x;
+            i < size; i += (long long)gridDim.x * blockDim.x) {
+        const int b = bins[i];
+        if (b < 0) continue;
+        const T v = x[i];
+        atomicAdd(&s_count[b], 1ULL);
+#if WITH_SUM
+        atomicAdd(&s_sum[b], (double)v);
+#endif
+#if WITH_SUMSQ
+        const double d = (double)v - center[b];
+        atomicAdd(&s_sumsq[b], d * d);
+#endif
+#if WITH_MIN || WITH_MAX
+        const unsigned long long k = to_key((key_value_t)v);
+#endif
+#if WITH_MIN
+        atomicMin(&s_min[b], k);
+#endif
+#if WITH_MAX
+        atomicMax(&s_max[b], k);
+#endif
+    }
+    __syncthreads();
+
+    for (int j = threadIdx.x; j < n_bins; j += blockDim.x) {
+        if (s_count[j] == 0) continue;
+        atomicAdd(&count[j], s_count[j]);
+#if WITH_SUM
+        atomicAdd(&sum[j], s_sum[j]);
+#endif
+#if WITH_SUMSQ
+        atomicAdd(&sumsq[j], s_sumsq[j]);
+#endif
+#if WITH_MIN
+        atomicMin(&kmin[j], s_min[j]);
+#endif
+#if WITH_MAX
+        atomicMax(&kmax[j], s_max[j]);
+#endif
+    }
+}
+
+// A block reduces the elements of a label, which are order[starts[b]:
+// starts[b + 1]]. Of equal extrema, the first minimum and the last maximum
+// are kept, as the sort-based selection does.
+extern "C" __global__ void cupyx_scipy_ndimage_labeled_stats_sorted(
+        const T* x, const long long* order, const long long* starts,
+        const double* center, unsigned long long* count, double* sum,
+        double* sumsq, unsigned long long* kmin, unsigned long long* kmax,
+        long long* pmin, long long* pmax) {
+    __shared__ unsigned long long s_count[BLOCK];
+    __shared__ double s_sum[BLOCK];
+    __shared__ double s_sumsq[BLOCK];
+    __shared__ unsigned long long s_kmin[BLOCK];
+    __shared__ unsigned long long s_kmax[BLOCK];
+    __shared__ long long s_pmin[BLOCK];
+    __shared__ long long s_pmax[BLOCK];
+    const int b = blockIdx.x;
+    const int t = threadIdx.x;
+    unsigned long long n = 0, k_lo = ~0ULL, k_hi = 0;
+    double s = 0, s2 = 0;
+    long long p_lo = -1, p_hi = -1;
+    for (long long j = starts[b] + t; j < starts[b + 1]; j += BLOCK) {
+        const long long p = order[j];
+        const T v = x[p];
+        n++;
+        s += (double)v;
+#if WITH_SUMSQ
+        const double d = (double)v - center[b];
+        s2 += d * d;
+#endif
+        const unsigned long long k = to_key((key_value_t)v);
+        if (n == 1 || k < k_lo || (k == k_lo && p < p_lo)) {
+            k_lo = k;
+            p_lo = p;
+        }
+        if (n == 1 || k > k_hi || (k == k_hi && p > p_hi)) {
+            k_hi = k;
+            p_hi = p;
+        }
+    }
+    s_count[t] = n;
+    s_sum[t] = s;
+    s_sumsq[t] = s2;
+    s_kmin[t] = k_lo;
+    s_kmax[t] = k_hi;
+    s_pmin[t] = p_lo;
+    s_pmax[t] = p_hi;
+    __syncthreads();
+    for (int w = BLOCK / 2; w > 0; w /= 2) {
+        const int u = t + w;
+        if (t < w && s_count[u] != 0) {
+            const bool empty = s_count[t] == 0;
+            s_count[t] += s_count[u];
+            s_sum[t] += s_sum[u];
+            s_sumsq[t] += s_sumsq[u];
+            if (empty || s_kmin[u] < s_kmin[t] ||
+                    (s_kmin[u] == s_kmin[t] && s_pmin[u] < s_pmin[t])) {
+                s_kmin[t] = s_kmin[u];
+                s_pmin[t] = s_pmin[u];
+            }
+            if (empty || s_kmax[u] > s_kmax[t] ||
+                    (s_kmax[u] == s_kmax[t] && s_pmax[u] > s_pmax[t])) {
+                s_kmax[t] = s_kmax[u];
+                s_pmax[t] = s_pmax[u];
+            }
+        }
+        __syncthreads();
+    }
+    if (t == 0) {
+        count[b] = s_count[0];
+        sum[b] = s_sum[0];
+        sumsq[b] = s_sumsq[0];
+        kmin[b] = s_kmin[0];
+        kmax[b] = s_kmax[0];
+        pmin[b] = s_pmin[0];
+        pmax[b] = s_pmax[0];
+    }
+}
+'''
+
+
+@_util.memoize(for_each_device=True)
+def _get_reduce_module(dtype, with_sum, with_sumsq, with_min, with_max):
+    code = ('#include <cupy/carray.cuh>\ntypedef {} T;\n#define KEY_KIND {}\n'
+            '#define BLOCK {}\n').format(
+        get_typename(dtype), _get_key_kind(dtype), _segment_block_size)
+    for name, flag in (('SUM', with_sum), ('SUMSQ', with_sumsq),
+                       ('MIN', with_min), ('MAX', with_max)):
+        code += '#define WITH_{} {}\n'.format(name, int(flag))
+    return cupy.RawModule(code=code + _key_code + _reduce_code)
+
+
+@_util.memoize(for_each_device=True)
+def _get_positions_kernel(dtype):
+    # the first position of the minimum and the last one of the maximum
+    return _core.ElementwiseKernel(
+        'T x, int32 b, raw uint64 kmin, raw uint64 kmax', 'raw int64 pmin, '
+        'raw int64 pmax',
+        '''
+        if (b >= 0) {
+            unsigned long long k = to_key((key_value_t)x);
+            if (k == kmin[b]) atomicMin(&pmin[b], (long long)i);
+            if (k == kmax[b]) atomicMax(&pmax[b], (long long)i);
+        }
+        ''',
+        'cupyx_scipy_ndimage_labeled_stats_positions',
+        preamble='#define KEY_KIND {}\n'.format(_get_key_kind(dtype)) +
+        _key_code)
+
+
+@_util.memoize(for_each_device=True)
+def _get_decode_kernel(dtype):
+    return _core.ElementwiseKernel(
+        'uint64 k, uint64 n', 'T v', 'v = n ? (T)from_key(k) : (T)0',
+        'cupyx_scipy_ndimage_labeled_stats_decode',
+        preamble='#define KEY_KIND {}\n'.format(_get_key_kind(dtype)) +
+        _key_code)
+
+
+class _LabeledReduction:
+    """Reductions of ``input`` over the labels of ``index``.
+
+    Args:
+        input (cupy.ndarray): The values, of a real dtype.
+        labels (cupy.ndarray): The labels, of the shape of ``input``.
+        index (cupy.ndarray): The labels to reduce over.
+    """
+
+    def __init__(self, input, labels, index):
+        self.input = input.ravel()
+        labels = labels.ravel()
+        self.index_shape = index.shape
+        uniques, self.inverse = cupy.unique(index.ravel(),
+                                            return_inverse=True)
+        self.inverse = self.inverse.ravel()
+        self.n_bins = uniques.size
+        if (labels.dtype.kind in 'iub' and uniques.dtype.kind in 'iub'
+                and self.n_bins and 0 <= int(uniques[0])
+                and int(uniques[-1]) <= labels.size):
+            # a lookup table of the positions of the labels in uniques
+            table = cupy.full(int(uniques[-1]) + 2, -1, numpy.int32)
+            table[uniques] = cupy.arange(self.n_bins, dtype=numpy.int32)
+            in_range = (labels >= 0) & (labels <= uniques[-1])
+            bins = table[cupy.where(in_range, labels, -1)]
+        else:
+            pos = cupy.searchsorted(uniques, labels)
+            pos = cupy.minimum(pos, max(self.n_bins - 1, 0))
+            found = uniques[pos] == labels if self.n_bins else False
+            bins = cupy.where(found, pos, -1)
+        self.bins = bins.astype(numpy.int32, copy=False)
+        self._order = None
+
+    def reduce(self, count=False, sum=False, sumsq=False, min=False,
+               max=False, argmin=False, argmax=False, center=None):
+        """Computes the statistics of the values of each unique label.
+
+        ``sumsq`` is the sum of ``(x - center) ** 2``, where ``center`` has a
+        value per unique label. The results are in the order of the unique
+        labels, and are mapped to ``index`` by :meth:`gather`. The extrema
+        and their positions are 0 for the labels without values.
+
+        Returns:
+            dict: The requested statistics by name.
+        """
+        x = self.input
+        n_bins = self.n_bins
+        min = min or argmin
+        max = max or argmax
+        out_count = cupy.zeros(n_bins, numpy.uint64)
+        out_sum = cupy.zeros(n_bins, numpy.float64)
+        out_sumsq = cupy.zeros(n_bins, numpy.float64)
+        kmin = cupy.full(n_bins, numpy.iinfo(numpy.uint64).max, numpy.uint64)
+        kmax = cupy.zeros(n_bins, numpy.uint64)
+        pmin = cupy.full(n_bins, numpy.iinfo(numpy.int64).max, numpy.int64)
+        pmax = cupy.full(n_bins, -1, numpy.int64)
+        if center is None:
+            center = out_sumsq
+        else:
+            center = cupy.ascontiguousarray(center, numpy.float64)
+        if x.size and n_bins:
+            # the count is always needed to tell the empty labels apart
+            module = _get_reduce_module(x.dtype, sum, sumsq, min, max)
+            args = (center, out_count, out_sum, out_sumsq, kmin, kmax)
+            if n_bins <= _max_shared_bins:
+                kernel = module.get_function(
+                    'cupyx_scipy_ndimage_labeled_stats_shared')
+                n_blocks = -(-x.size // _block_size)
+                kernel((builtins.min(n_blocks, _max_blocks),),
+                       (_block_size,),
+                       (x, self.bins, numpy.int64(x.size),
+                        numpy.int32(n_bins)) + args,
+                       shared_mem=5 * 8 * n_bins)
+                if argmin or argmax:
+                    _get_positions_kernel(x.dtype)(
+                        x, self.bins, kmin, kmax, pmin, pmax)
+            else:
+                order, starts = self._get_segments()
+                kernel = module.get_function(
+                    'cupyx_scipy_ndimage_labeled_stats_sorted')
+                kernel((n_bins,), (_segment_block_size,),
+                       (x, order, starts) + args + (pmin, pmax))
+
+        result = {}
+        empty = out_count == 0
+        if count:
+            result['count'] = out_count
+        if sum:
+            result['sum'] = out_sum
+        if sumsq:
+            result['sumsq'] = out_sumsq
+        if min:
+            result['min'] = _get_decode_kernel(x.dtype)(
+                kmin, out_count, cupy.empty(n_bins, x.dtype))
+        if max:
+            result['max'] = _get_decode_kernel(x.dtype)(
+                kmax, out_count, cupy.empty(n_bins, x.dtype))
+        if argmin:
+            result['argmin'] = cupy.where(empty, 0, pmin)
+        if argmax:
+            result['argmax'] = cupy.where(empty, 0, pmax)
+        return result
+
+    def gather(self, values):
+        """Maps the values of the unique labels to ``index``."""
+        return values[self.inverse].reshape(self.index_shape)
+
+    def _get_segments(self):
+        # the elements of each label, which are sorted once for all the
+        # reductions; the unmatched elements (-1) come first
+        if self._order is None:
+            self._order = cupy.argsort(self.bins).astype(
+                numpy.int64, copy=False)
+            self._starts = cupy.searchsorted(
+                self.bins[self._order],
+                cupy.arange(self.n_bins + 1, dtype=numpy.int32)).astype(
+                    numpy.int64, copy=False)
+        return self._order, self._starts
+
@@ -1,10 +1,9 @@
-import warnings
-
 import numpy
 
 import cupy
 from cupy import _core
 from cupy import _util
+from cupyx.scipy.ndimage import _labeled_stats
 
 
 def label(input, structure=None, output=None):
@@ -100,8 +99,19 @@ def _label(x, structure, y):
     ndirs = indxs.shape[0]
     y_shape = cupy.array(y.shape, dtype=numpy.int32)
     count = cupy.zeros(2, dtype=numpy.int32)
+    # The components are first labeled inside the tiles in shared memory,
+    # and then only the pairs of neighbors across the boundaries of the tiles
+    # are merged in global memory. The root of a component is its element of
+    # the smallest index in both steps.
+    tile = _get_label_tile(x.ndim)
+    n_tiles = [-(-s // t) for s, t in zip(y.shape, tile)]
+    tile = cupy.array(tile, dtype=numpy.int32)
     _kernel_init()(x, y)
-    _kernel_connect()(y_shape, dirs, ndirs, x.ndim, y, size=y.size)
+    _get_label_tile_kernel(x.ndim)(
+        (int(numpy.prod(n_tiles)),), (_label_block_size,),
+        (y, y_shape, tile, cupy.array(n_tiles, dtype=numpy.int32), dirs,
+         numpy.int32(ndirs)))
+    _kernel_connect()(y_shape, tile, dirs, ndirs, x.ndim, y, size=y.size)
     _kernel_count()(y, count, size=y.size)
     maxlabel = int(count[0])
     labels = cupy.empty(maxlabel, dtype=numpy.int32)
@@ -110,6 +120,117 @@ def _label(x, structure, y):
     return maxlabel
 
 
+# The tiles have 1024 elements, and the last axis is the longest side.
+_label_tile_size = 1024
+_label_block_size = 256
+
+
+def _get_label_tile(ndim):
+    if ndim == 1:
+        return (1024,)
+    if ndim == 2:
+        return (32, 32)
+    return (1,) * (ndim - 3) + (8, 8, 16)
+
+
+_label_tile_code = r'''
+__device__ bool tile_to_global(
+        int t, const int* origin, const int* shape, const int* tile,
+        int* coord, int* g) {
+    int index = 0;
+    int stride = 1;
+    for (int d = NDIM - 1; d >= 0; d--) {
+        coord[d] = t % tile[d];
+        t /= tile[d];
+    }
+    for (int d = 0; d < NDIM; d++) {
+        int pos = origin[d] + coord[d];
+        if (pos >= shape[d]) {
+            return false;
+        }
+        index = index * shape[d] + pos;
+    }
+    *g = index;
+    return true;
+}
+
+// Labels the components inside a tile with a union-find in shared memory,
+// and writes the index of the root of each element to y.
+extern "C" __global__ void cupyx_scipy_ndimage_label_tile(
+        int* y, const int* shape, const int* tile, const int* n_tiles,
+        const int* dirs, const int ndirs) {
+    __shared__ int s[TILE_SIZE];
+    int origin[NDIM];
+    int coord[NDIM];
+    int g;
+    int b = blockIdx.x;
+    for (int d = NDIM - 1; d >= 0; d--) {
+        origin[d] = (b % n_tiles[d]) * tile[d];
+        b /= n_tiles[d];
+    }
+    for (int t = threadIdx.x; t < TILE_SIZE; t += blockDim.x) {
+        bool inside = tile_to_global(t, origin, shape, tile, coord, &g);
+        s[t] = (inside && y[g] >= 0) ? t : -1;
+    }
+    __syncthreads();
+
+    for (int t = threadIdx.x; t < TILE_SIZE; t += blockDim.x) {
+        if (s[t] < 0) continue;
+        tile_to_global(t, origin, shape, tile, coord, &g);
+        for (int dr = 0; dr < ndirs; dr++) {
+            int k = 0;
+            for (int d = 0; d < NDIM; d++) {
+                int pos = coord[d] + dirs[d + dr * NDIM];
+                if (pos < 0 || pos >= tile[d]) {
+                    k = -1;
+                    break;
+                }
+                k = k * tile[d] + pos;
+            }
+            // the elements out of the array are -1 too
+            if (k < 0 || s[k] < 0) continue;
+            int j = t;
+            while (1) {
+                while (j != s[j]) { j = s[j]; }
+                while (k != s[k]) { k = s[k]; }
+                if (j == k) break;
+                if (j < k) {
+                    int old = atomicCAS(&s[k], k, j);
+                    if (old == k) break;
+                    k = old;
+                } else {
+                    int old = atomicCAS(&s[j], j, k);
+                    if (old == j) break;
+                    j = old;
+                }
+            }
+        }
+    }
+    __syncthreads();
+
+    for (int t = threadIdx.x; t < TILE_SIZE; t += blockDim.x) {
+        if (s[t] < 0) continue;
+        int r = t;
+        while (r != s[r]) { r = s[r]; }
+        int root;
+        tile_to_global(r, origin, shape, tile, coord, &root);
+        tile_to_global(t, origin, shape, tile, coord, &g);
+        y[g] = root;
+    }
+}
+'''
+
+
+@_util.memoize(for_each_device=True)
+def _get_label_tile_kernel(ndim):
+    # the raster order inside a tile is the one of the array, so that the
+    # smallest element of a tile is also the smallest of the array
+    code = '#define NDIM {}\n#define TILE_SIZE {}\n'.format(
+        ndim, _label_tile_size)
+    return cupy.RawKernel(code + _label_tile_code,
+                          'cupyx_scipy_ndimage_label_tile')
+
+
 def _kernel_init():
     return _core.ElementwiseKernel(
         'X x', 'Y y', 'if (x == 0) { y = -1; } else { y = i; }',
@@ -117,8 +238,10 @@ def _kernel_init():
 
 
 def _kernel_connect():
+    # merges the components of neighbors in different tiles
     return _core.ElementwiseKernel(
-        'raw int32 shape, raw int32 dirs, int32 ndirs, int32 ndim',
+        'raw int32 shape, raw int32 tile, raw int32 dirs, int32 ndirs, '
+        'int32 ndim',
         'raw Y y',
         '''
         if (y[i] < 0) continue;
@@ -127,17 +250,20 @@ def _kernel_connect():
             int rest = j;
             int stride = 1;
             int k = 0;
+            bool across = false;
             for (int dm = ndim-1; dm >= 0; dm--) {
-                int pos = rest % shape[dm] + dirs[dm + dr * ndim];
+                int p = rest % shape[dm];
+                int pos = p + dirs[dm + dr * ndim];
                 if (pos < 0 || pos >= shape[dm]) {
                     k = -1;
                     break;
                 }
+                across |= pos / tile[dm] != p / tile[dm];
                 k += pos * stride;
                 rest /= shape[dm];
                 stride *= shape[dm];
             }
-            if (k < 0) continue;
+            if (k < 0 || !across) continue;
             if (y[k] < 0) continue;
             while (1) {
                 while (j != y[j]) { j = y[j]; }
@@ -206,87 +332,9 @@ def _kernel_finalize():
         'cupyx_scipy_ndimage_label_finalize')
 
 
-_ndimage_variance_kernel = _core.ElementwiseKernel(
-    'T input, R labels, raw X index, uint64 size, raw float64 mean',
-    'raw float64 out',
-    """
-    for (ptrdiff_t j = 0; j < size; j++) {
-      if (labels == index[j]) {
-        atomicAdd(&out[j], (input - mean[j]) * (input - mean[j]));
-        break;
-      }
-    }
-    """,
-    'cupyx_scipy_ndimage_variance')
-
-
-_ndimage_sum_kernel = _core.ElementwiseKernel(
-    'T input, R labels, raw X index, uint64 size',
-    'raw float64 out',
-    """
-    for (ptrdiff_t j = 0; j < size; j++) {
-      if (labels == index[j]) {
-        atomicAdd(&out[j], input);
-        break;
-      }
-    }
-    """,
-    'cupyx_scipy_ndimage_sum')
-
-
-def _ndimage_sum_kernel_2(input, labels, index, sum_val, batch_size=4):
-    for i in range(0, index.size, batch_size):
-        matched = labels == index[i:i + batch_size].reshape(
-            (-1,) + (1,) * input.ndim)
-        sum_axes = tuple(range(1, 1 + input.ndim))
-        sum_val[i:i + batch_size] = cupy.where(matched, input, 0).sum(
-            axis=sum_axes)
-    return sum_val
-
-
-_ndimage_mean_kernel = _core.ElementwiseKernel(
-    'T input, R labels, raw X index, uint64 size',
-    'raw float64 out, raw uint64 count',
-    """
-    for (ptrdiff_t j = 0; j < size; j++) {
-      if (labels == index[j]) {
-        atomicAdd(&out[j], input);
-        atomicAdd(&count[j], 1);
-        break;
-      }
-    }
-    """,
-    'cupyx_scipy_ndimage_mean')
-
-
-def _ndimage_mean_kernel_2(input, labels, index, batch_size=4,
-                           return_count=False):
-    sum_val = cupy.empty_like(index, dtype=cupy.float64)
-    count = cupy.empty_like(index, dtype=cupy.uint64)
-    for i in range(0, index.size, batch_size):
-        matched = labels == index[i:i + batch_size].reshape(
-            (-1,) + (1,) * input.ndim)
-        mean_axes = tuple(range(1, 1 + input.ndim))
-        count[i:i + batch_size] = matched.sum(axis=mean_axes)
-        sum_val[i:i + batch_size] = cupy.where(matched, input, 0).sum(
-            axis=mean_axes)
-    if return_count:
-        return sum_val / count, count
-    return sum_val / count
-
-
-def _mean_driver(input, labels, index, return_count=False, use_kern=False):
-    if use_kern:
-        return _ndimage_mean_kernel_2(input, labels, index,
-                                      return_count=return_count)
-
-    out = cupy.zeros_like(index, cupy.float64)
-    count = cupy.zeros_like(index, dtype=cupy.uint64)
-    sum, count = _ndimage_mean_kernel(input,
-                                      labels, index, index.size, out, count)
-    if return_count:
-        return sum / count, count
-    return sum / count
+def _labeled_mean(reduction):
+    stats = reduction.reduce(count=True, sum=True)
+    return stats['sum'] / stats['count'], stats['count']
 
 
 def variance(input, labels=None, index=None):
@@ -313,19 +361,6 @@ def variance(input, labels=None, index=None):
         raise TypeError("cupyx.scipy.ndimage.variance doesn't support %{}"
                         "".format(input.dtype.type))
 
-    use_kern = False
-    # There are constraints on types because of atomicAdd() in CUDA.
-    if input.dtype not in [cupy.int32, cupy.float16, cupy.float32,
-                           cupy.float64, cupy.uint32, cupy.uint64,
-                           cupy.ulonglong]:
-        warnings.warn(
-            'Using the slower implementation because the provided '
-            f'type {input.dtype} is not supported by cupyx.scipy.ndimage.sum. '
-            'Consider using an array of type int32, float16, '
-            'float32, float64, uint32, uint64 as data types '
-            'for the fast implementation', _util.PerformanceWarning)
-        use_kern = True
-
     def calc_var_with_intermediate_float(input):
         vals_c = input - input.mean()
         count = vals_c.size
@@ -354,15 +389,11 @@ def variance(input, labels=None, index=None):
             return (input[labels == index]).var().astype(cupy.float64,
                                                          copy=False)
 
-    mean_val, count = _mean_driver(input, labels, index, True, use_kern)
-    if use_kern:
-        new_axis = (..., *(cupy.newaxis for _ in range(input.ndim)))
-        return cupy.where(labels[None, ...] == index[new_axis],
-                          cupy.square(input - mean_val[new_axis]),
-                          0).sum(tuple(range(1, input.ndim + 1))) / count
-    out = cupy.zeros_like(index, dtype=cupy.float64)
-    return _ndimage_variance_kernel(input, labels, index, index.size, mean_val,
-                                    out) / count
+    # the squares are summed around the means, in a second pass
+    reduction = _labeled_stats._LabeledReduction(input, labels, index)
+    mean_val, count = _labeled_mean(reduction)
+    sumsq = reduction.reduce(sumsq=True, center=mean_val)['sumsq']
+    return reduction.gather(sumsq / count)
 
 
 def sum_labels(input, labels=None, index=None):
@@ -389,18 +420,6 @@ def sum_labels(input, labels=None, index=None):
         raise TypeError("cupyx.scipy.ndimage.sum does not support %{}".format(
             input.dtype.type))
 
-    use_kern = False
-    # There is constraints on types because of atomicAdd() in CUDA.
-    if input.dtype not in [cupy.int32, cupy.float16, cupy.float32,
-                           cupy.float64, cupy.uint32, cupy.uint64,
-                           cupy.ulonglong]:
-        warnings.warn(
-            'Using the slower implementation as '
-            'cupyx.scipy.ndimage.sum supports int32, float16, '
-            'float32, float64, uint32, uint64 as data types'
-            'for the fast implmentation', _util.PerformanceWarning)
-        use_kern = True
-
     if labels is None:
         return input.sum()
 
@@ -421,12 +440,8 @@ def sum_labels(input, labels=None, index=None):
     if index.size == 0:
         return cupy.array([], dtype=cupy.int64)
 
-    out = cupy.zeros_like(index, dtype=cupy.float64)
-
-    # The following parameters for sum where determined using a Tesla P100.
-    if (input.size >= 262144 and index.size <= 4) or use_kern:
-        return _ndimage_sum_kernel_2(input, labels, index, out)
-    return _ndimage_sum_kernel(input, labels, index, index.size, out)
+    reduction = _labeled_stats._LabeledReduction(input, labels, index)
+    return reduction.gather(reduction.reduce(sum=True)['sum'])
 
 
 def sum(input, labels=None, index=None):
@@ -479,18 +494,6 @@ def mean(input, labels=None, index=None):
         raise TypeError("cupyx.scipy.ndimage.mean does not support %{}".format(
             input.dtype.type))
 
-    use_kern = False
-    # There is constraints on types because of atomicAdd() in CUDA.
-    if input.dtype not in [cupy.int32, cupy.float16, cupy.float32,
-                           cupy.float64, cupy.uint32, cupy.uint64,
-                           cupy.ulonglong]:
-        warnings.warn(
-            'Using the slower implementation as '
-            'cupyx.scipy.ndimage.mean supports int32, float16, '
-            'float32, float64, uint32, uint64 as data types '
-            'for the fast implmentation', _util.PerformanceWarning)
-        use_kern = True
-
     def calc_mean_with_intermediate_float(input):
         sum = input.sum()
         count = input.size
@@ -518,7 +521,8 @@ def mean(input, labels=None, index=None):
         else:
             return (input[labels == index]).mean(dtype=cupy.float64)
 
-    return _mean_driver(input, labels, index, use_kern=use_kern)
+    reduction = _labeled_stats._LabeledReduction(input, labels, index)
+    return reduction.gather(_labeled_mean(reduction)[0])
 
 
 def standard_deviation(input, labels=None, index=None):
@@ -613,6 +617,22 @@ def _select_via_looping(input, labels, idxs, positions, find_min,
     return result
 
 
+def _select_via_reduction(input, labels, index, find_min, find_min_positions,
+                          find_max, find_max_positions):
+    """Internal helper routine for _select, without the median."""
+    reduction = _labeled_stats._LabeledReduction(input, labels, index)
+    stats = reduction.reduce(min=find_min, max=find_max,
+                             argmin=find_min_positions,
+                             argmax=find_max_positions)
+    result = []
+    # the order below matches the order expected by cupy.ndimage.extrema
+    for name, find in (('min', find_min), ('argmin', find_min_positions),
+                       ('max', find_max), ('argmax', find_max_positions)):
+        if find:
+            result += [reduction.gather(stats[name])]
+    return result
+
+
 def _select(input, labels=None, index=None, find_min=False, find_max=False,
             find_min_positions=False, find_max_positions=False,
             find_median=False):
@@ -668,6 +688,11 @@ def _select(input, labels=None, index=None, find_min=False, find_max=False,
 
     index = cupy.asarray(index)
 
+    if not find_median:
+        return _select_via_reduction(
+            input, labels, index, find_min, find_min_positions, find_max,
+            find_max_positions)
+
     safe_int = _safely_castable_to_int(labels.dtype)
     min_label = labels.min()
     max_label = labels.max()
@@ -10,6 +10,7 @@ from cupy import _core
 from cupyx.scipy.ndimage import _filters_core
 from cupyx.scipy.ndimage import _util
 from cupyx.scipy.ndimage import _filters
+from cupyx.scipy.ndimage import _morphology_iterations
 
 
 @cupy.memoize(for_each_device=True)
@@ -251,6 +252,15 @@ def _binary_erosion(input, structure, iterations, mask, output, border_value,
     else:
         if cupy.shares_memory(output, input, 'MAY_SHARE_BOUNDS'):
             raise ValueError('output and input may not overlap in memory')
+        # bit-packed iterations in shared memory, or thresholded distances
+        result = _morphology_iterations.iterate(
+            input, structure, structure_shape, offsets, iterations, mask,
+            output, border_value, invert, center_is_true)
+        if result is not None:
+            if temp_needed:
+                _core.elementwise_copy(result, temp)
+                result = temp
+            return result
         tmp_in = cupy.empty_like(input, dtype=output.dtype)
         tmp_out = output
         if iterations >= 1 and not iterations & 1:
@@ -0,0 +1,323 @@
+"""Repeated binary erosions and dilations.
+
+Two methods replace the launch of a filter per iteration:
+
+* For 1-D and 2-D arrays, the images are packed to 32 pixels per word, and
+  a launch runs several iterations on a tile in shared memory. The tile is
+  loaded with a halo as wide as the distance the iterations can reach, so
+  only its center is written back. A shift of a word by the column offset
+  of the structure gives 32 neighbors at once.
+* For many iterations of the cross (connectivity 1) or of the full box
+  structure in any dimension, the iterated structures are balls of the
+  city block or of the chessboard distance. The erosions are then found by
+  thresholding distances computed with a forward and a backward scan of
+  the lines along each axis.
+"""
+
+import math
+
+import numpy
+
+import cupy
+from cupy import _core
+from cupy import _util
+
+
+# tiles of 8 words (256 pixels) by 32 rows
+_tile_words = 8
+_tile_rows = 32
+_block_size = 256
+_max_iterations_per_launch = 8
+_max_shared_bytes = 32 * 1024
+# the distance shortcut is taken from this number of iterations on
+_distance_min_iterations = 8
+_infinity = 1 << 29
+
+
+@_util.memoize(for_each_device=True)
+def _get_pack_kernel():
+    return _core.ElementwiseKernel(
+        'raw T x, int32 width, int32 n_words', 'uint32 p',
+        '''
+        int row = i / n_words;
+        int col = (i % n_words) * 32;
+        unsigned int v = 0;
+        for (int j = 0; j < 32 && col + j < width; j++) {
+            if ((bool)x[(ptrdiff_t)row * width + col + j]) v |= 1u << j;
+        }
+        p = v;
+        ''',
+        'cupyx_scipy_ndimage_binary_pack')
+
+
+@_util.memoize(for_each_device=True)
+def _get_unpack_kernel():
+    return _core.ElementwiseKernel(
+        'raw uint32 p, int32 width, int32 n_words', 'Y y',
+        '''
+        int row = i / width;
+        int col = i % width;
+        y = (Y)((p[(ptrdiff_t)row * n_words + col / 32] >> (col % 32)) & 1);
+        ''',
+        'cupyx_scipy_ndimage_binary_unpack')
+
+
+_iterate_code = r'''
+__device__ __forceinline__ unsigned int inside_bits(
+        int gy, int gw, int height, int width, int n_words) {
+    if (gy < 0 || gy >= height || gw < 0 || gw >= n_words) return 0u;
+    int rest = width - gw * 32;
+    return rest >= 32 ? ~0u : (1u << rest) - 1u;
+}
+
+// The pixels at a column offset dx of the 32 pixels of the word (r, c).
+__device__ __forceinline__ unsigned int shifted(
+        const unsigned int* s, int r, int c, int dx) {
+    const unsigned int* row = s + r * SW;
+    if (dx == 0) return row[c];
+    if (dx > 0) return (row[c] >> dx) | (row[c + 1] << (32 - dx));
+    return (row[c] << -dx) | (row[c - 1] >> (32 + dx));
+}
+
+extern "C" __global__ void cupyx_scipy_ndimage_binary_iterate(
+        const unsigned int* x, const unsigned int* mask, unsigned int* y,
+        const int height, const int width, const int n_words,
+        const int n_tile_cols, const int n_iterations, int* changed) {
+    extern __shared__ unsigned int smem[];
+    unsigned int* a = smem;
+    unsigned int* b = smem + SH * SW;
+#if MASKED
+    unsigned int* m = smem + 2 * SH * SW;
+#endif
+    const int y0 = (blockIdx.x / n_tile_cols) * TILE_ROWS - HR;
+    const int w0 = (blockIdx.x % n_tile_cols) * TILE_WORDS - HW;
+    const unsigned int border = BORDER ? ~0u : 0u;
+    for (int idx = threadIdx.x; idx < SH * SW; idx += blockDim.x) {
+        const int gy = y0 + idx / SW;
+        const int gw = w0 + idx % SW;
+        const unsigned int ins = inside_bits(gy, gw, height, width, n_words);
+        unsigned int v = border;
+        if (ins) {
+            const long long g = (long long)gy * n_words + gw;
+            v = (x[g] & ins) | (border & ~ins);
+#if MASKED
+            m[idx] = mask[g] & ins;
+        } else {
+            m[idx] = 0u;
+#endif
+        }
+        a[idx] = v;
+    }
+    __syncthreads();
+
+    for (int it = 0; it < n_iterations; it++) {
+        for (int idx = threadIdx.x; idx < SH * SW; idx += blockDim.x) {
+            const int r = idx / SW;
+            const int c = idx % SW;
+            const unsigned int old = a[idx];
+            unsigned int v = old;
+            if (r >= RY && r < SH - RY && c >= 1 && c < SW - 1) {
+                unsigned int acc = INVERT ? 0u : ~0u;
+                OPS
+#if MASKED
+                const unsigned int upd = m[idx];
+#else
+                const unsigned int upd = inside_bits(
+                    y0 + r, w0 + c, height, width, n_words);
+#endif
+                v = (acc & upd) | (old & ~upd);
+            }
+            b[idx] = v;
+        }
+        __syncthreads();
+        unsigned int* t = a;
+        a = b;
+        b = t;
+    }
+
+    for (int idx = threadIdx.x; idx < TILE_ROWS * TILE_WORDS;
+            idx += blockDim.x) {
+        const int r = HR + idx / TILE_WORDS;
+        const int c = HW + idx % TILE_WORDS;
+        const int gy = y0 + r;
+        const int gw = w0 + c;
+        const unsigned int ins = inside_bits(gy, gw, height, width, n_words);
+        if (!ins) continue;
+        const long long g = (long long)gy * n_words + gw;
+        const unsigned int v = a[r * SW + c] & ins;
+        if (v != x[g]) *changed = 1;
+        y[g] = v;
+    }
+}
+'''
+
+
+@_util.memoize(for_each_device=True)
+def _get_iterate_kernel(offsets, n_iterations, invert, border_value, masked):
+    ry = max(abs(dy) for dy, _ in offsets)
+    rx = max(abs(dx) for _, dx in offsets)
+    hr = n_iterations * ry
+    hw = 1 + -(-n_iterations * rx // 32)
+    op = '|=' if invert else '&='
+    ops = ''.join('acc {} shifted(a, r + {}, c, {});'.format(op, dy, dx)
+                  for dy, dx in offsets)
+    defines = {
+        'TILE_ROWS': _tile_rows, 'TILE_WORDS': _tile_words, 'HR': hr,
+        'HW': hw, 'RY': ry, 'SH': _tile_rows + 2 * hr,
+        'SW': _tile_words + 2 * hw, 'INVERT': int(invert),
+        'BORDER': int(border_value), 'MASKED': int(masked), 'OPS': ops}
+    code = ''.join('#define {} {}\n'.format(k, v) for k, v in defines.items())
+    shared = (3 if masked else 2) * defines['SH'] * defines['SW'] * 4
+    kernel = cupy.RawKernel(code + _iterate_code,
+                            'cupyx_scipy_ndimage_binary_iterate')
+    return kernel, shared
+
+
+def _get_offsets(structure, structure_shape, offsets):
+    # the offsets of the neighbors, as (row, column) pairs
+    if isinstance(structure, tuple):
+        footprint = numpy.ones(structure_shape, dtype=bool)
+    else:
+        footprint = cupy.asnumpy(structure).astype(bool)
+    result = numpy.argwhere(footprint) - numpy.asarray(offsets)
+    if footprint.ndim == 1:
+        result = numpy.stack([numpy.zeros_like(result[:, 0]), result[:, 0]],
+                             axis=1)
+    return tuple((int(dy), int(dx)) for dy, dx in result)
+
+
+def _iterations_per_launch(offsets, masked):
+    n = _max_iterations_per_launch
+    while n > 1:
+        _, shared = _get_iterate_kernel(offsets, n, False, 0, masked)
+        if shared <= _max_shared_bytes:
+            break
+        n //= 2
+    return n
+
+
+def _iterate_packed(input, offsets, iterations, mask, output, border_value,
+                    invert):
+    shape = input.shape
+    height, width = (1,) + shape if input.ndim == 1 else shape
+    n_words = -(-width // 32)
+    pack = _get_pack_kernel()
+    x = pack(cupy.ascontiguousarray(input), width, n_words,
+             cupy.empty((height, n_words), numpy.uint32))
+    y = cupy.empty_like(x)
+    masked = mask is not None
+    if masked:
+        packed_mask = pack(mask, width, n_words, cupy.empty_like(x))
+    else:
+        packed_mask = x
+    n_tile_cols = -(-n_words // _tile_words)
+    n_tiles = -(-height // _tile_rows) * n_tile_cols
+    per_launch = _iterations_per_launch(offsets, masked)
+    changed = cupy.zeros((), numpy.int32)
+    done = 0
+    while iterations < 1 or done < iterations:
+        n = per_launch if iterations < 1 else min(per_launch,
+                                                  iterations - done)
+        kernel, shared = _get_iterate_kernel(
+            offsets, n, invert, border_value, masked)
+        changed.fill(0)
+        kernel((n_tiles,), (_block_size,),
+               (x, packed_mask, y, numpy.int32(height), numpy.int32(width),
+                numpy.int32(n_words), numpy.int32(n_tile_cols),
+                numpy.int32(n), changed), shared_mem=shared)
+        x, y = y, x
+        done += n
+        # the iterations are monotonic, so an unchanged image is final
+        if iterations < 1 and not int(changed):  # synchronize!
+            break
+    return _get_unpack_kernel()(x, width, n_words, output)
+
+
+@_util.memoize(for_each_device=True)
+def _get_scan_kernel():
+    return _core.ElementwiseKernel(
+        'int32 n, int64 stride, int32 outside', 'raw int32 g',
+        '''
+        ptrdiff_t base = (i / stride) * n * stride + i % stride;
+        int d = outside;
+        for (int j = 0; j < n; j++) {
+            ptrdiff_t p = base + j * stride;
+            d = min(g[p], d + 1);
+            g[p] = d;
+        }
+        d = outside;
+        for (int j = n - 1; j >= 0; j--) {
+            ptrdiff_t p = base + j * stride;
+            d = min(g[p], d + 1);
+            g[p] = d;
+        }
+        ''',
+        'cupyx_scipy_ndimage_binary_distance_scan')
+
+
+def _iterate_distance(input, iterations, output, border_value, invert, box):
+    # a dilation is the complement of the erosion of the complement
+    x = cupy.asarray(input, dtype=bool)
+    if invert:
+        x = ~x
+        border_value = not border_value
+    g = cupy.where(x, numpy.int32(_infinity), numpy.int32(0))
+    outside = _infinity if border_value else 0
+    scan = _get_scan_kernel()
+    for axis in range(g.ndim):
+        n = g.shape[axis]
+        stride = math.prod(g.shape[axis + 1:])
+        scan(n, stride, outside, g, size=g.size // n)
+        if box:
+            # the chessboard ball is the product of the segments
+            g = cupy.where(g > iterations, numpy.int32(_infinity),
+                           numpy.int32(0))
+    result = g > iterations
+    if invert:
+        result = ~result
+    _core.elementwise_copy(result, output)
+    return output
+
+
+def _is_cross_or_box(structure, structure_shape):
+    if any(s != 3 for s in structure_shape):
+        return None
+    ndim = len(structure_shape)
+    if isinstance(structure, tuple):
+        return 'box'
+    footprint = cupy.asnumpy(structure).astype(bool)
+    if footprint.all():
+        return 'box'
+    cross = numpy.abs(numpy.indices((3,) * ndim) - 1).sum(axis=0) <= 1
+    if (footprint == cross).all():
+        return 'cross'
+    return None
+
+
+def iterate(input, structure, structure_shape, offsets, iterations, mask,
+            output, border_value, invert, center_is_true):
+    """Runs ``iterations`` erosions, or dilations if ``invert``.
+
+    Returns ``output``, or ``None`` if neither method applies, in which case
+    the filter has to be iterated.
+    """
+    if iterations == 1 or input.size == 0:
+        return None
+    centered = all(o == s // 2 for o, s in zip(offsets, structure_shape))
+    if (iterations >= _distance_min_iterations and mask is None
+            and centered):
+        kind = _is_cross_or_box(structure, structure_shape)
+        if kind is not None:
+            return _iterate_distance(input, iterations, output,
+                                     bool(border_value), invert,
+                                     kind == 'box')
+    if input.ndim > 2 or (iterations < 1 and not center_is_true):
+        # until convergence, only a monotonic iteration is sure to end
+        return None
+    neighbors = _get_offsets(structure, structure_shape, offsets)
+    if not neighbors or max(abs(dx) for _, dx in neighbors) >= 32:
+        return None
+    if mask is not None:
+        mask = cupy.ascontiguousarray(mask)
+    return _iterate_packed(input, neighbors, iterations, mask, output,
+                           bool(border_value), invert)
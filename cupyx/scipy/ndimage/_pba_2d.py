@@ -75,6 +75,10 @@ def get_pba2d_src(block_size_2d=64, marker=-32768, pixel_int2_t="short2"):
     return pba2d_code
 
 
+# The limit of gridDim.z, which indexes the images of a batch
+_max_grid_z = 65535
+
+
 def _get_block_size(check_warp_size=False):
     if check_warp_size:
         dev = cupy.cuda.runtime.getDevice()
@@ -85,26 +89,28 @@ def _get_block_size(check_warp_size=False):
 
 
 @cupy.memoize(for_each_device=True)
-def _get_pack_kernel(int_type, marker=-32768):
+def _get_pack_kernel(int_type, marker=-32768, ndim=2):
     """Pack coordinates into array of type short2 (or int2).
 
-    This kernel works with 2D input data, `arr` (typically boolean).
+    This kernel works with 2D input data, `arr` (typically boolean), or with
+    a 3D stack of 2D images.
 
-    The output array, `out` will be 3D with a signed integer dtype.
-    It will have size 2 on the last axis so that it can be viewed as a CUDA
-    vector type such as `int2` or `float2`.
+    The output array, `out` will have one more axis than `arr` and a signed
+    integer dtype. It will have size 2 on the last axis so that it can be
+    viewed as a CUDA vector type such as `int2` or `float2`.
     """
     code = f"""
     if (arr[i]) {{
         out[2*i] = {marker};
         out[2*i + 1] = {marker};
     }} else {{
-        int shape_1 = arr.shape()[1];
-        int _i = i;
+        int shape_1 = arr.shape()[{ndim - 1}];
+        int shape_0 = arr.shape()[{ndim - 2}];
+        ptrdiff_t _i = i;
         int ind_1 = _i % shape_1;
         _i /= shape_1;
-        out[2*i] = ind_1;   // out.x
-        out[2*i + 1] = _i;  // out.y
+        out[2*i] = ind_1;              // out.x
+        out[2*i + 1] = _i % shape_0;   // out.y
     }}
     """
     return cupy.ElementwiseKernel(
@@ -116,17 +122,18 @@ def _get_pack_kernel(int_type, marker=-32768):
 
 
 def _pack_int2(arr, marker=-32768, int_dtype=cupy.int16):
-    if arr.ndim != 2:
-        raise ValueError("only 2d arr supported")
+    if arr.ndim not in (2, 3):
+        raise ValueError("only 2d arr (or a 3d stack of 2d arr) supported")
     int2_dtype = cupy.dtype({"names": ["x", "y"], "formats": [int_dtype] * 2})
     out = cupy.zeros(arr.shape + (2,), dtype=int_dtype)
     assert out.size == 2 * arr.size
     pack_kernel = _get_pack_kernel(
         int_type="short" if int_dtype == cupy.int16 else "int",
-        marker=marker
+        marker=marker,
+        ndim=arr.ndim,
     )
     pack_kernel(arr, out, size=arr.size)
-    out = cupy.squeeze(out.view(int2_dtype))
+    out = out.view(int2_dtype).reshape(arr.shape)
     return out
 
 
@@ -140,9 +147,9 @@ def _unpack_int2(img, make_copy=False, int_dtype=cupy.int16):
 def _determine_padding(shape, padded_size, block_size):
     # all kernels assume equal size along both axes, so pad up to equal size if
     # shape is not isotropic
-    orig_sy, orig_sx = shape
+    orig_sy, orig_sx = shape[-2:]
     if orig_sx != padded_size or orig_sy != padded_size:
-        padding_width = (
+        padding_width = ((0, 0),) * (len(shape) - 2) + (
             (0, padded_size - orig_sy), (0, padded_size - orig_sx)
         )
     else:
@@ -167,17 +174,18 @@ def _generate_indices_ops(ndim, int_type):
     return code
 
 
-def _get_distance_kernel_code(int_type, dist_int_type, raw_out_var=True):
+def _get_distance_kernel_code(int_type, dist_int_type, raw_out_var=True,
+                              ndim=2):
     code = _generate_shape(
-        ndim=2, int_type=int_type, var_name="dist", raw_var=raw_out_var
+        ndim=ndim, int_type=int_type, var_name="dist", raw_var=raw_out_var
     )
-    code += _generate_indices_ops(ndim=2, int_type=int_type)
+    code += _generate_indices_ops(ndim=ndim, int_type=int_type)
     code += f"""
     {int_type} tmp;
     {dist_int_type} sq_dist;
-    tmp = y[i] - ind_0;
+    tmp = y[i] - ind_{ndim - 2};
     sq_dist = tmp * tmp;
-    tmp = x[i] - ind_1;
+    tmp = x[i] - ind_{ndim - 1};
     sq_dist += tmp * tmp;
     dist[i] = sqrt(static_cast<F>(sq_dist));
     """
@@ -185,10 +193,10 @@ def _get_distance_kernel_code(int_type, dist_int_type, raw_out_var=True):
 
 
 @cupy.memoize(for_each_device=True)
-def _get_distance_kernel(int_type, dist_int_type):
+def _get_distance_kernel(int_type, dist_int_type, ndim=2):
     """Returns kernel computing the Euclidean distance from coordinates."""
     operation = _get_distance_kernel_code(
-        int_type, dist_int_type, raw_out_var=True
+        int_type, dist_int_type, raw_out_var=True, ndim=ndim
     )
     return cupy.ElementwiseKernel(
         in_params="raw I y, raw I x",
@@ -198,17 +206,17 @@ def _get_distance_kernel(int_type, dist_int_type):
     )
 
 
-def _get_aniso_distance_kernel_code(int_type, raw_out_var=True):
+def _get_aniso_distance_kernel_code(int_type, raw_out_var=True, ndim=2):
     code = _generate_shape(
-        ndim=2, int_type=int_type, var_name="dist", raw_var=raw_out_var
+        ndim=ndim, int_type=int_type, var_name="dist", raw_var=raw_out_var
     )
-    code += _generate_indices_ops(ndim=2, int_type=int_type)
-    code += """
+    code += _generate_indices_ops(ndim=ndim, int_type=int_type)
+    code += f"""
     F tmp;
     F sq_dist;
-    tmp = static_cast<F>(y[i] - ind_0) * sampling[0];
+    tmp = static_cast<F>(y[i] - ind_{ndim - 2}) * sampling[0];
     sq_dist = tmp * tmp;
-    tmp = static_cast<F>(x[i] - ind_1) * sampling[1];
+    tmp = static_cast<F>(x[i] - ind_{ndim - 1}) * sampling[1];
     sq_dist += tmp * tmp;
     dist[i] = sqrt(sq_dist);
     """
@@ -216,9 +224,10 @@ def _get_aniso_distance_kernel_code(int_type, raw_out_var=True):
 
 
 @cupy.memoize(for_each_device=True)
-def _get_aniso_distance_kernel(int_type):
+def _get_aniso_distance_kernel(int_type, ndim=2):
     """Returns kernel computing the Euclidean distance from coordinates."""
-    operation = _get_aniso_distance_kernel_code(int_type, raw_out_var=True)
+    operation = _get_aniso_distance_kernel_code(
+        int_type, raw_out_var=True, ndim=ndim)
     return cupy.ElementwiseKernel(
         in_params="raw I y, raw I x, raw F sampling",
         out_params="raw F dist",
@@ -285,7 +294,7 @@ def _pba_2d(arr, sampling=None, return_distances=True, return_indices=False,
     block_size = _get_block_size(check_warp_size)
 
     if block_params is None:
-        padded_size = math.ceil(max(arr.shape) / block_size) * block_size
+        padded_size = math.ceil(max(arr.shape[-2:]) / block_size) * block_size
 
         # should be <= size / block_size. sy must be a multiple of m1
         m1 = padded_size // block_size
@@ -303,7 +312,7 @@ def _pba_2d(arr, sampling=None, return_distances=True, return_indices=False,
         if math.log2(m2) % 1 > 1e-5:
             raise ValueError("m2 must be a power of 2")
         multiple = lcm(block_size, m1, m2, m3)
-        padded_size = math.ceil(max(arr.shape) / multiple) * multiple
+        padded_size = math.ceil(max(arr.shape[-2:]) / multiple) * multiple
 
     if m1 > padded_size // block_size:
         raise ValueError(
@@ -324,7 +333,7 @@ def _pba_2d(arr, sampling=None, return_distances=True, return_indices=False,
                 f"disivible by each element of block_params: {(m1, m2, m3)}."
             )
 
-    shape_max = max(arr.shape)
+    shape_max = max(arr.shape[-2:])
     if shape_max <= 32768:
         int_dtype = cupy.int16
         pixel_int2_type = "short2"
@@ -341,17 +350,18 @@ def _pba_2d(arr, sampling=None, return_distances=True, return_indices=False,
 
     marker = _init_marker(int_dtype)
 
-    orig_sy, orig_sx = arr.shape
+    orig_sy, orig_sx = arr.shape[-2:]
     padding_width = _determine_padding(arr.shape, padded_size, block_size)
     if padding_width is not None:
         arr = cupy.pad(arr, padding_width, mode="constant", constant_values=1)
-    size = arr.shape[0]
+    size = arr.shape[-1]
+    batch_size = arr.shape[0] if arr.ndim == 3 else 1
 
     input_arr = _pack_int2(arr, marker=marker, int_dtype=int_dtype)
     output = cupy.zeros_like(input_arr)
 
     int2_dtype = cupy.dtype({"names": ["x", "y"], "formats": [int_dtype] * 2})
-    margin = cupy.empty((2 * m1 * size,), dtype=int2_dtype)
+    margin = cupy.empty((batch_size, 2 * m1 * size), dtype=int2_dtype)
 
     # phase 1 of PBA. m1 must divide texture size and be <= 64
     pba2d = cupy.RawModule(
@@ -381,39 +391,6 @@ def _pba_2d(arr, sampling=None, return_distances=True, return_indices=False,
         kernelMergeBands = pba2d.get_function("kernelMergeBandsWithSpacing")
         kernelColor = pba2d.get_function("kernelColorWithSpacing")
 
-    block = (block_size, 1, 1)
-    grid = (math.ceil(size / block[0]), m1, 1)
-    bandSize1 = size // m1
-    # kernelFloodDown modifies input_arr in-place
-    kernelFloodDown(
-        grid,
-        block,
-        (input_arr, input_arr, size, bandSize1),
-    )
-    # kernelFloodUp modifies input_arr in-place
-    kernelFloodUp(
-        grid,
-        block,
-        (input_arr, input_arr, size, bandSize1),
-    )
-    # kernelFloodUp fills values into margin
-    kernelPropagateInterband(
-        grid,
-        block,
-        (input_arr, margin, size, bandSize1),
-    )
-    # kernelUpdateVertical stores output into an intermediate array of
-    # transposed shape
-    kernelUpdateVertical(
-        grid,
-        block,
-        (input_arr, margin, output, size, bandSize1),
-    )
-
-    # phase 2
-    block = (block_size, 1, 1)
-    grid = (math.ceil(size / block[0]), m2, 1)
-    bandSize2 = size // m2
     if sampling is None:
         sampling_args = ()
     else:
@@ -423,48 +400,92 @@ def _pba_2d(arr, sampling=None, return_distances=True, return_indices=False,
         # accordingly.
         sampling = tuple(map(float, sampling))
         sampling_args = (sampling[0], sampling[1])
-    kernelProximatePoints(
-        grid,
-        block,
-        (output, input_arr, size, bandSize2) + sampling_args,
-    )
-    kernelCreateForwardPointers(
-        grid,
-        block,
-        (input_arr, input_arr, size, bandSize2),
-    )
-    # Repeatedly merging two bands into one
-    noBand = m2
-    while noBand > 1:
-        grid = (math.ceil(size / block[0]), noBand // 2)
-        kernelMergeBands(
+
+    # blockIdx.z indexes the images of a batch; the images beyond the limit
+    # of gridDim.z are processed by further launches on views of the arrays
+    for start in range(0, batch_size, _max_grid_z):
+        n = min(batch_size - start, _max_grid_z)
+        if arr.ndim == 3:
+            _input, _output = input_arr[start:], output[start:]
+        else:
+            _input, _output = input_arr, output
+        _margin = margin[start:]
+
+        block = (block_size, 1, 1)
+        grid = (math.ceil(size / block[0]), m1, n)
+        bandSize1 = size // m1
+        # kernelFloodDown modifies input_arr in-place
+        kernelFloodDown(
             grid,
             block,
-            (output, input_arr, input_arr, size, size // noBand) + sampling_args,  # noqa
+            (_input, _input, size, bandSize1),
+        )
+        # kernelFloodUp modifies input_arr in-place
+        kernelFloodUp(
+            grid,
+            block,
+            (_input, _input, size, bandSize1),
+        )
+        # kernelFloodUp fills values into margin
+        kernelPropagateInterband(
+            grid,
+            block,
+            (_input, _margin, size, bandSize1),
+        )
+        # kernelUpdateVertical stores output into an intermediate array of
+        # transposed shape
+        kernelUpdateVertical(
+            grid,
+            block,
+            (_input, _margin, _output, size, bandSize1),
         )
-        noBand //= 2
-    # Replace the forward link with the X coordinate of the seed to remove
-    # the need of looking at the other texture. We need it for coloring.
-    grid = (math.ceil(size / block[0]), size)
-    kernelDoubleToSingleList(
-        grid,
-        block,
-        (output, input_arr, input_arr, size),
-    )
 
-    # Phase 3 of PBA
-    block = (block_size, m3, 1)
-    grid = (math.ceil(size / block[0]), 1, 1)
-    kernelColor(
-        grid,
-        block,
-        (input_arr, output, size) + sampling_args,
-    )
+        # phase 2
+        block = (block_size, 1, 1)
+        grid = (math.ceil(size / block[0]), m2, n)
+        bandSize2 = size // m2
+        kernelProximatePoints(
+            grid,
+            block,
+            (_output, _input, size, bandSize2) + sampling_args,
+        )
+        kernelCreateForwardPointers(
+            grid,
+            block,
+            (_input, _input, size, bandSize2),
+        )
+        # Repeatedly merging two bands into one
+        noBand = m2
+        while noBand > 1:
+            grid = (math.ceil(size / block[0]), noBand // 2, n)
+            kernelMergeBands(
+                grid,
+                block,
+                (_output, _input, _input, size, size // noBand) + sampling_args,  # noqa
+            )
+            noBand //= 2
+        # Replace the forward link with the X coordinate of the seed to remove
+        # the need of looking at the other texture. We need it for coloring.
+        grid = (math.ceil(size / block[0]), size, n)
+        kernelDoubleToSingleList(
+            grid,
+            block,
+            (_output, _input, _input, size),
+        )
+
+        # Phase 3 of PBA
+        block = (block_size, m3, 1)
+        grid = (math.ceil(size / block[0]), 1, n)
+        kernelColor(
+            grid,
+            block,
+            (_input, _output, size) + sampling_args,
+        )
 
     output = _unpack_int2(output, make_copy=False, int_dtype=int_dtype)
     # make sure to crop any padding that was added here!
-    x = output[:orig_sy, :orig_sx, 0]
-    y = output[:orig_sy, :orig_sx, 1]
+    x = output[..., :orig_sy, :orig_sx, 0]
+    y = output[..., :orig_sy, :orig_sx, 1]
 
     vals = ()
     if return_distances:
@@ -475,18 +496,20 @@ def _pba_2d(arr, sampling=None, return_distances=True, return_indices=False,
             distances = cupy.zeros(y.shape, dtype=dtype_out)
 
         # make sure maximum possible distance doesn"t overflow
-        max_possible_dist = sum((s - 1)**2 for s in y.shape)
+        max_possible_dist = sum((s - 1)**2 for s in y.shape[-2:])
         dist_int_type = "int" if max_possible_dist < 2**31 else "ptrdiff_t"
 
         if sampling is None:
             distance_kernel = _get_distance_kernel(
                 int_type=_get_inttype(distances),
                 dist_int_type=dist_int_type,
+                ndim=y.ndim,
             )
             distance_kernel(y, x, distances, size=distances.size)
         else:
             distance_kernel = _get_aniso_distance_kernel(
                 int_type=_get_inttype(distances),
+                ndim=y.ndim,
             )
             sampling = cupy.asarray(sampling, dtype=dtype_out)
             distance_kernel(y, x, sampling, distances, size=distances.size)
@@ -494,7 +517,7 @@ def _pba_2d(arr, sampling=None, return_distances=True, return_indices=False,
         vals = vals + (distances,)
     if return_indices:
         if indices_inplace:
-            _check_indices(indices, (arr.ndim,) + arr.shape, x.dtype.itemsize)
+            _check_indices(indices, (2,) + y.shape, x.dtype.itemsize)
             indices[0, ...] = y
             indices[1, ...] = x
         else:
@@ -14,6 +14,7 @@ pba3d_defines_template = """
 #define MARKER     {marker}
 #define MAX_INT    {max_int}
 #define BLOCKSIZE  {block_size_3d}
+#define INDEX_TYPE {index_type}
 
 """
 
@@ -47,8 +48,8 @@ pba3d_defines_encode_64bit = """
 // Sites     : ENCODE(x, y, z, 0, 0)
 // Not sites : ENCODE(0, 0, 0, 1, 0) or MARKER
 #define ENCODED_INT_TYPE long long
-#define ZERO 0L
-#define ONE 1L
+#define ZERO 0LL
+#define ONE 1LL
 #define ENCODE(x, y, z, a, b)  (((x) << 40) | ((y) << 20) | (z) | ((a) << 61) | ((b) << 60))
 #define DECODE(value, x, y, z) \
     x = ((value) >> 40) & 0xfffff; \
@@ -67,9 +68,10 @@ pba3d_defines_encode_64bit = """
 
 @cupy.memoize(True)
 def get_pba3d_src(block_size_3d=32, marker=-2147483648, max_int=2147483647,
-                  size_max=1024):
+                  size_max=1024, index_type="int"):
     pba3d_code = pba3d_defines_template.format(
-        block_size_3d=block_size_3d, marker=marker, max_int=max_int
+        block_size_3d=block_size_3d, marker=marker, max_int=max_int,
+        index_type=index_type
     )
     if size_max > 1024:
         pba3d_code += pba3d_defines_encode_64bit
@@ -291,7 +293,8 @@ def _get_aniso_distance_kernel(int_type):
 
 
 @cupy.memoize(for_each_device=True)
-def _get_decode_as_distance_kernel(size_max, large_dist=False, sampling=None):
+def _get_decode_as_distance_kernel(size_max, large_dist=False, sampling=None,
+                                   int_type="int"):
     """Fused decode3d and distance computation.
 
     This kernel is for use when `return_distances=True`, but
@@ -302,7 +305,6 @@ def _get_decode_as_distance_kernel(size_max, large_dist=False, sampling=None):
     """
     if sampling is None:
         dist_int_type = "ptrdiff_t" if large_dist else "int"
-    int_type = "int"
 
     # Step 1: decode the (z, y, x) coordinate
     code = _get_decode3d_code(size_max, int_type=int_type)
@@ -372,6 +374,8 @@ def _pba_3d(arr, sampling=None, return_distances=True, return_indices=False,
     # coordinates. input_arr will be C-contiguous, int32
     size_max = max(arr.shape)
     input_arr = encode3d(arr, size_max=size_max)
+    # the linear indices of the (cubic) padded volume
+    index_type = "long long" if arr.size >= 2**31 else "int"
     buffer_idx = 0
     output = cupy.zeros_like(input_arr)
     pba_images = [input_arr, output]
@@ -379,7 +383,8 @@ def _pba_3d(arr, sampling=None, return_distances=True, return_indices=False,
     block = (blockx, blocky, 1)
     grid = (size // block[0], size // block[1], 1)
     pba3d = cupy.RawModule(
-        code=get_pba3d_src(block_size_3d=block_size, size_max=size_max)
+        code=get_pba3d_src(block_size_3d=block_size, size_max=size_max,
+                           index_type=index_type)
     )
 
     kernelFloodZ = pba3d.get_function("kernelFloodZ")
@@ -455,7 +460,8 @@ def _pba_3d(arr, sampling=None, return_distances=True, return_indices=False,
             kern = _get_decode_as_distance_kernel(
                 size_max=size_max,
                 large_dist=large_dist,
-                sampling=sampling
+                sampling=sampling,
+                int_type=_get_inttype(distances),
             )
             if sampling is None:
                 kern(output[:orig_sz, :orig_sy, :orig_sx], distances)
@@ -13,6 +13,8 @@
 //   indicating the pixel size along the x and y axes. The kernels are identical
 //   except that the `dominate` function is replaced by `dominate_sp` and the
 //   physical spacings are used when computing distances.
+// - process a batch of images in one launch, with blockIdx.z indexing the
+//   image
 //
 
 
@@ -43,6 +45,12 @@
 
 #define TOID(x, y, size)  ((y) * (size) + (x))
 
+// The images of a batch are stored one after the other, and indexed by
+// blockIdx.z. Each kernel first moves its pointers to the image of its block.
+#define IMAGE_OFFSET(size)  ((long long)blockIdx.z * (size) * (size))
+#define MARGIN_OFFSET(size, bandSize) \
+    ((long long)blockIdx.z * 2 * ((size) / (bandSize)) * (size))
+
 #define LL long long
 __device__ bool dominate(LL x1, LL y1, LL x2, LL y2, LL x3, LL y3, LL x0)
 {
@@ -73,6 +81,9 @@ extern "C"{
 
 __global__ void kernelFloodDown(pixel_int2_t *input, pixel_int2_t *output, int size, int bandSize)
 {
+    input += IMAGE_OFFSET(size);
+    output += IMAGE_OFFSET(size);
+
     int tx = blockIdx.x * blockDim.x + threadIdx.x;
     int ty = blockIdx.y * bandSize;
     int id = TOID(tx, ty, size);
@@ -93,6 +104,9 @@ __global__ void kernelFloodDown(pixel_int2_t *input, pixel_int2_t *output, int s
 
 __global__ void kernelFloodUp(pixel_int2_t *input, pixel_int2_t *output, int size, int bandSize)
 {
+    input += IMAGE_OFFSET(size);
+    output += IMAGE_OFFSET(size);
+
     int tx = blockIdx.x * blockDim.x + threadIdx.x;
     int ty = (blockIdx.y+1) * bandSize - 1;
     int id = TOID(tx, ty, size);
@@ -117,6 +131,9 @@ __global__ void kernelFloodUp(pixel_int2_t *input, pixel_int2_t *output, int siz
 
 __global__ void kernelPropagateInterband(pixel_int2_t *input, pixel_int2_t *margin_out, int size, int bandSize)
 {
+    input += IMAGE_OFFSET(size);
+    margin_out += MARGIN_OFFSET(size, bandSize);
+
     int tx = blockIdx.x * blockDim.x + threadIdx.x;
     int inc = bandSize * size;
     int ny, nid, nDist;
@@ -168,6 +185,10 @@ __global__ void kernelPropagateInterband(pixel_int2_t *input, pixel_int2_t *marg
 
 __global__ void kernelUpdateVertical(pixel_int2_t *color, pixel_int2_t *margin, pixel_int2_t *output, int size, int bandSize)
 {
+    color += IMAGE_OFFSET(size);
+    margin += MARGIN_OFFSET(size, bandSize);
+    output += IMAGE_OFFSET(size);
+
     __shared__ pixel_int2_t block[BLOCKSIZE][BLOCKSIZE];
 
     int tx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -217,6 +238,9 @@ __global__ void kernelUpdateVertical(pixel_int2_t *color, pixel_int2_t *margin,
 
 __global__ void kernelProximatePoints(pixel_int2_t *input, pixel_int2_t *stack, int size, int bandSize)
 {
+    input += IMAGE_OFFSET(size);
+    stack += IMAGE_OFFSET(size);
+
     int tx = blockIdx.x * blockDim.x + threadIdx.x;
     int ty = blockIdx.y * bandSize;
     int id = TOID(tx, ty, size);
@@ -254,6 +278,9 @@ __global__ void kernelProximatePoints(pixel_int2_t *input, pixel_int2_t *stack,
 
 __global__ void kernelProximatePointsWithSpacing(pixel_int2_t *input, pixel_int2_t *stack, int size, int bandSize, double sx, double sy)
 {
+    input += IMAGE_OFFSET(size);
+    stack += IMAGE_OFFSET(size);
+
     int tx = blockIdx.x * blockDim.x + threadIdx.x;
     int ty = blockIdx.y * bandSize;
     int id = TOID(tx, ty, size);
@@ -290,6 +317,9 @@ __global__ void kernelProximatePointsWithSpacing(pixel_int2_t *input, pixel_int2
 
 __global__ void kernelCreateForwardPointers(pixel_int2_t *input, pixel_int2_t *output, int size, int bandSize)
 {
+    input += IMAGE_OFFSET(size);
+    output += IMAGE_OFFSET(size);
+
     int tx = blockIdx.x * blockDim.x + threadIdx.x;
     int ty = (blockIdx.y+1) * bandSize - 1;
     int id = TOID(tx, ty, size);
@@ -320,6 +350,10 @@ __global__ void kernelCreateForwardPointers(pixel_int2_t *input, pixel_int2_t *o
 
 __global__ void kernelMergeBands(pixel_int2_t *color, pixel_int2_t *link, pixel_int2_t *output, int size, int bandSize)
 {
+    color += IMAGE_OFFSET(size);
+    link += IMAGE_OFFSET(size);
+    output += IMAGE_OFFSET(size);
+
     int tx = blockIdx.x * blockDim.x + threadIdx.x;
     int band1 = blockIdx.y * 2;
     int band2 = band1 + 1;
@@ -440,6 +474,10 @@ __global__ void kernelMergeBands(pixel_int2_t *color, pixel_int2_t *link, pixel_
 
 __global__ void kernelMergeBandsWithSpacing(pixel_int2_t *color, pixel_int2_t *link, pixel_int2_t *output, int size, int bandSize, double sx, double sy)
 {
+    color += IMAGE_OFFSET(size);
+    link += IMAGE_OFFSET(size);
+    output += IMAGE_OFFSET(size);
+
     int tx = blockIdx.x * blockDim.x + threadIdx.x;
     int band1 = blockIdx.y * 2;
     int band2 = band1 + 1;
@@ -559,6 +597,10 @@ __global__ void kernelMergeBandsWithSpacing(pixel_int2_t *color, pixel_int2_t *l
 
 __global__ void kernelDoubleToSingleList(pixel_int2_t *color, pixel_int2_t *link, pixel_int2_t *output, int size)
 {
+    color += IMAGE_OFFSET(size);
+    link += IMAGE_OFFSET(size);
+    output += IMAGE_OFFSET(size);
+
     int tx = blockIdx.x * blockDim.x + threadIdx.x;
     int ty = blockIdx.y;
     int id = TOID(tx, ty, size);
@@ -568,6 +610,9 @@ __global__ void kernelDoubleToSingleList(pixel_int2_t *color, pixel_int2_t *link
 
 __global__ void kernelColor(pixel_int2_t *input, pixel_int2_t *output, int size)
 {
+    input += IMAGE_OFFSET(size);
+    output += IMAGE_OFFSET(size);
+
     __shared__ pixel_int2_t block[BLOCKSIZE][BLOCKSIZE];
 
     int col = threadIdx.x;
@@ -631,6 +676,9 @@ __global__ void kernelColor(pixel_int2_t *input, pixel_int2_t *output, int size)
 
 __global__ void kernelColorWithSpacing(pixel_int2_t *input, pixel_int2_t *output, int size, double sx, double sy)
 {
+    input += IMAGE_OFFSET(size);
+    output += IMAGE_OFFSET(size);
+
     __shared__ pixel_int2_t block[BLOCKSIZE][BLOCKSIZE];
 
     int col = threadIdx.x;
@@ -7,6 +7,8 @@
 //
 // Modifications by Gregory Lee (2022) (NVIDIA)
 // - allow user-defined ENCODED_INT_TYPE, ENCODE, DECODE
+// - allow a user-defined INDEX_TYPE for the linear indices of volumes with
+//   2**31 or more voxels
 // - Add variant kernels with support for non-isotropic pixel dimensions
 //   These kernels differ from the originals in that they also take sx, sy and
 //   sz values indicating the pixel size along the x, y and z axes. The kernels
@@ -36,6 +38,10 @@
 #define BLOCKSIZE  32
 #endif
 
+#ifndef INDEX_TYPE
+#define INDEX_TYPE int
+#endif
+
 #ifndef ENCODE
 
 // Sites     : ENCODE(x, y, z, 0, 0)
@@ -91,7 +97,7 @@ __device__ bool dominate_sp(int _x_1, int _y_1, int _z_1, int _x_2, int _y_2, in
             ((y_2 + y_3) * k_2 + ((x_3 - x_2) * (x_2 + x_3 - (x_0_2)) + (z_3 - z_2) * (z_2 + z_3 - (z_0_2)))) * k_1);
 }
 
-#define TOID(x, y, z, size)    ((((z) * (size)) + (y)) * (size) + (x))
+#define TOID(x, y, z, size)    (((((INDEX_TYPE)(z)) * (size)) + (y)) * (size) + (x))
 
 
 extern "C"{
@@ -103,8 +109,8 @@ __global__ void kernelFloodZ(ENCODED_INT_TYPE *input, ENCODED_INT_TYPE *output,
     int ty = blockIdx.y * blockDim.y + threadIdx.y;
     int tz = 0;
 
-    int plane = size * size;
-    int id = TOID(tx, ty, tz, size);
+    INDEX_TYPE plane = (INDEX_TYPE)size * size;
+    INDEX_TYPE id = TOID(tx, ty, tz, size);
     ENCODED_INT_TYPE pixel1, pixel2;
 
     pixel1 = ENCODE(ZERO,ZERO,ZERO,ONE,ZERO);
@@ -146,7 +152,7 @@ __global__ void kernelMaurerAxis(ENCODED_INT_TYPE *input, ENCODED_INT_TYPE *stac
     int tz = blockIdx.y * blockDim.y + threadIdx.y;
     int ty = 0;
 
-    int id = TOID(tx, ty, tz, size);
+    INDEX_TYPE id = TOID(tx, ty, tz, size);
 
     ENCODED_INT_TYPE lasty = 0;
     ENCODED_INT_TYPE x1, y1, z1, x2, y2, z2, nx, ny, nz;
@@ -194,7 +200,7 @@ __global__ void kernelMaurerAxisWithSpacing(ENCODED_INT_TYPE *input, ENCODED_INT
     int tz = blockIdx.y * blockDim.y + threadIdx.y;
     int ty = 0;
 
-    int id = TOID(tx, ty, tz, size);
+    INDEX_TYPE id = TOID(tx, ty, tz, size);
 
     ENCODED_INT_TYPE lasty = 0;
     ENCODED_INT_TYPE x1, y1, z1, x2, y2, z2, nx, ny, nz;
@@ -297,7 +303,7 @@ __global__ void kernelColorAxis(ENCODED_INT_TYPE *input, ENCODED_INT_TYPE *outpu
         __syncthreads();
 
         if(!threadIdx.y) {
-            int id = TOID(y_end + threadIdx.x, blockIdx.x * blockDim.x, tz, size);
+            INDEX_TYPE id = TOID(y_end + threadIdx.x, blockIdx.x * blockDim.x, tz, size);
             for(int i = 0; i < blockDim.x; i++, id+=size) {
                 output[id] = block[i][threadIdx.x];
             }
@@ -373,7 +379,7 @@ __global__ void kernelColorAxisWithSpacing(ENCODED_INT_TYPE *input, ENCODED_INT_
         __syncthreads();
 
         if(!threadIdx.y) {
-            int id = TOID(y_end + threadIdx.x, blockIdx.x * blockDim.x, tz, size);
+            INDEX_TYPE id = TOID(y_end + threadIdx.x, blockIdx.x * blockDim.x, tz, size);
             for(int i = 0; i < blockDim.x; i++, id+=size) {
                 output[id] = block[i][threadIdx.x];
             }
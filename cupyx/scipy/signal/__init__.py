@@ -4,6 +4,7 @@ from cupyx.scipy.signal._signaltools import deconvolve  # NOQA
 from cupyx.scipy.signal._signaltools import fftconvolve  # NOQA
 from cupyx.scipy.signal._signaltools import choose_conv_method  # NOQA
 from cupyx.scipy.signal._signaltools import oaconvolve  # NOQA
+from cupyx.scipy.signal._signaltools import StreamingConvolver  # NOQA
 from cupyx.scipy.signal._signaltools import convolve2d  # NOQA
 from cupyx.scipy.signal._signaltools import correlate2d  # NOQA
 from cupyx.scipy.signal._signaltools import correlation_lags  # NOQA
@@ -157,6 +157,30 @@ __global__ void correct_carries(
     }
 }
 
+template<typename T>
+__global__ void scan_carries(
+        const int k, const int n_groups, const int step, const int total,
+        const T* power, const T* carries_in, T* carries_out) {
+
+    int idx = blockDim.x * blockIdx.x + threadIdx.x;
+    if(idx >= total) {
+        return;
+    }
+
+    int i = idx % k;
+    int group = (idx / k) % n_groups;
+
+    T carry = carries_in[idx];
+    if(group >= step) {
+        const T* prev_carries = carries_in + idx - i - step * k;
+        for(int j = 0; j < k; j++) {
+            carry += power[i * k + j] * prev_carries[j];
+        }
+    }
+
+    carries_out[idx] = carry;
+}
+
 template<typename T>
 __global__ void second_pass_iir(
         const int m, const int k, const int n, const int carries_stride,
@@ -478,6 +502,7 @@ IIR_MODULE = cupy.RawModule(
     name_expressions=[f'compute_correction_factors<{x}, {y}>'
                       for x, y in TYPE_PAIR_NAMES] +
                      [f'correct_carries<{x}>' for x in TYPE_NAMES] +
+                     [f'scan_carries<{x}>' for x in TYPE_NAMES] +
                      [f'first_pass_iir<{x}>' for x in TYPE_NAMES] +
                      [f'second_pass_iir<{x}>' for x in TYPE_NAMES])
 
@@ -518,6 +543,40 @@ def collapse_2d_rest(x, axis):
     return x, x_shape
 
 
+# The carries of the blocks are patched by a parallel scan from this number
+# of blocks, and sequentially below it
+_SCAN_MIN_GROUPS = 32
+
+
+def scan_carries(carries, transition):
+    # Patches the carries of the blocks, that is the last k outputs of each
+    # block computed with a zero initial state, with the carries of the
+    # previous blocks: carries[:, g] += transition @ carries[:, g - 1] for
+    # increasing g. Rather than walking the blocks sequentially, the affine
+    # recurrence is solved by recursive doubling: after the step d, each
+    # carry holds the contributions of the d blocks up to it, and the step
+    # 2d adds the contributions of the d blocks before them through the
+    # transition matrix to the power of d.
+    num_rows, n_groups, k = carries.shape
+    scan_kernel = _get_module_func(IIR_MODULE, 'scan_carries', carries)
+    power = cupy.ascontiguousarray(transition, dtype=carries.dtype)
+    total = carries.size
+    block_sz = 256
+    n_blocks = (total + block_sz - 1) // block_sz
+    src, dst = carries, cupy.empty_like(carries)
+    step = 1
+    while step < n_groups:
+        scan_kernel((n_blocks,), (block_sz,),
+                    (k, n_groups, step, total, power, src, dst))
+        src, dst = dst, src
+        step *= 2
+        if step < n_groups:
+            power = cupy.matmul(power, power)
+    if src is not carries:
+        carries[...] = src
+    return carries
+
+
 def compute_correction_factors(a, block_sz, dtype):
     k = a.size
     correction = cupy.eye(k, dtype=dtype)
@@ -594,10 +653,15 @@ def apply_iir(x, a, axis=-1, zi=None, dtype=None, block_sz=1024):
         starting_group = int(zi is None)
         blocks_to_merge = n_blocks - starting_group
         carries_stride = (n_blocks + (1 - starting_group)) * k
-        carry_correction_kernel(
-            (num_rows,), (k,),
-            (block_sz, k, n_blocks, carries_stride, starting_group,
-             correction, carries))
+        if carries.shape[1] >= _SCAN_MIN_GROUPS:
+            # the transition of the carries of a block to the next one
+            transition = correction[::-1, block_sz:block_sz + k].T
+            scan_carries(carries, transition)
+        else:
+            carry_correction_kernel(
+                (num_rows,), (k,),
+                (block_sz, k, n_blocks, carries_stride, starting_group,
+                 correction, carries))
         second_pass_kernel(
             (num_rows * blocks_to_merge,), (block_sz,),
             (block_sz, k, n, carries_stride, blocks_to_merge,
@@ -701,10 +765,15 @@ def apply_iir_sos(x, sos, axis=-1, zi=None, dtype=None, block_sz=1024,
                 all_carries[:, 0, :] = section_zi
                 all_carries[:, 1:, :] = carries
 
-            carry_correction_kernel(
-                (num_rows,), (k,),
-                (block_sz, n_blocks, carries_stride, starting_group,
-                    correction[s], all_carries))
+            if all_carries.shape[1] >= _SCAN_MIN_GROUPS:
+                # the transition of the carries of a block to the next one
+                transition = correction[s, ::-1, block_sz - k:].T
+                scan_carries(all_carries, transition)
+            else:
+                carry_correction_kernel(
+                    (num_rows,), (k,),
+                    (block_sz, n_blocks, carries_stride, starting_group,
+                        correction[s], all_carries))
             second_pass_kernel(
                 (num_rows * blocks_to_merge,), (block_sz,),
                 (block_sz, n, carries_stride, blocks_to_merge,
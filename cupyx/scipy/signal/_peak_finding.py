@@ -73,24 +73,28 @@ PEAKS_KERNEL = r"""
 
 template<typename T>
 __global__ void local_maxima_1d(
-        const int n, const T* __restrict__ x, long long* midpoints,
-        long long* left_edges, long long* right_edges) {
-
-    const int orig_idx = blockDim.x * blockIdx.x + threadIdx.x;
-    const int idx = orig_idx + 1;
-
-    if(idx >= n - 1) {
+        const long long n, const long long size, const T* __restrict__ x,
+        long long* midpoints, long long* left_edges, long long* right_edges) {
+
+    // Each row of `n` samples of `x` is a signal, and the first and last
+    // samples of a row are never peaks
+    const long long orig_idx = (long long) blockDim.x * blockIdx.x + threadIdx.x;
+    const long long samples = n - 2;
+    if(orig_idx >= size / n * samples) {
         return;
     }
 
+    const long long row_end = orig_idx / samples * n + n - 1;
+    const long long idx = orig_idx / samples * n + orig_idx % samples + 1;
+
     long long midpoint = -1;
     long long left = -1;
     long long right = -1;
 
     if(x[idx - 1] < x[idx]) {
-        int i_ahead = idx + 1;
+        long long i_ahead = idx + 1;
 
-        while(i_ahead < n - 1 && x[i_ahead] == x[idx]) {
+        while(i_ahead < row_end && x[i_ahead] == x[idx]) {
             i_ahead++;
         }
 
@@ -106,112 +110,241 @@ __global__ void local_maxima_1d(
     right_edges[orig_idx] = right;
 }
 
+// NaN is propagated, so that the minimum or maximum of a block holding a
+// NaN stops the searches below as the NaN itself does.
 template<typename T>
-__global__ void peak_prominences(
-        const int n, const int n_peaks, const T* __restrict__ x,
-        const long long* __restrict__ peaks, const long long wlen,
-        T* prominences, long long* left_bases, long long* right_bases) {
+__device__ __forceinline__ T nan_min(const T a, const T b) {
+    return (a != a || a < b) ? a : b;
+}
 
-    const int idx = blockDim.x * blockIdx.x + threadIdx.x;
-    if(idx >= n_peaks) {
+template<typename T>
+__device__ __forceinline__ T nan_max(const T a, const T b) {
+    return (a != a || b < a) ? a : b;
+}
+
+// Stops at a sample above `v` (or NaN), searched with the block maxima.
+template<typename V>
+struct peak_exceeds {
+    V v;
+
+    template<typename T>
+    __device__ bool operator()(const T a) const {
+        return !(static_cast<V>(a) <= v);
+    }
+};
+
+// Stops at a sample at or below `v` (or NaN), searched with the block minima.
+template<typename V>
+struct peak_reaches {
+    V v;
+
+    template<typename T>
+    __device__ bool operator()(const T a) const {
+        return !(v < static_cast<V>(a));
+    }
+};
+
+// The tables hold the extrema of the blocks of `block` samples: level `k`
+// holds the extremum of blocks `s` to `s + 2^k - 1` at `k * n_blocks + s`.
+template<typename T>
+__global__ void peak_block_extrema(
+        const long long size, const long long block,
+        const long long n_blocks, const T* __restrict__ x,
+        T* mins, T* maxs) {
+
+    const long long b = (long long) blockDim.x * blockIdx.x + threadIdx.x;
+    if(b >= n_blocks) {
         return;
     }
 
-    const long long peak = peaks[idx];
-    long long i_min = 0;
-    long long i_max = n - 1;
+    const long long end = min(size, b * block + block);
+    T lo = x[b * block];
+    T hi = lo;
+    for(long long i = b * block + 1; i < end; i++) {
+        lo = nan_min(lo, x[i]);
+        hi = nan_max(hi, x[i]);
+    }
+    mins[b] = lo;
+    maxs[b] = hi;
+}
 
-    if(wlen >= 2) {
-        i_min = max(peak - wlen / 2, i_min);
-        i_max = min(peak + wlen / 2, i_max);
+template<typename T>
+__global__ void peak_block_level(
+        const long long n_blocks, const int k, T* mins, T* maxs) {
+
+    const long long s = (long long) blockDim.x * blockIdx.x + threadIdx.x;
+    const long long step = 1LL << (k - 1);
+    if(s + 2 * step > n_blocks) {
+        return;
     }
 
-    left_bases[idx] = peak;
-    long long i = peak;
-    T left_min = x[peak];
+    const long long prev = (k - 1) * n_blocks;
+    mins[k * n_blocks + s] = nan_min(mins[prev + s], mins[prev + s + step]);
+    maxs[k * n_blocks + s] = nan_max(maxs[prev + s], maxs[prev + s + step]);
+}
 
-    while(i_min <= i && x[i] <= x[peak]) {
-        if(x[i] < left_min) {
-            left_min = x[i];
-            left_bases[idx] = i;
+// Returns the last index in [lo, i] where `stop` holds, or lo - 1. The
+// samples are scanned up to the block boundaries, and the blocks in between
+// are skipped by halving jumps over the table.
+template<typename T, typename P>
+__device__ long long peak_search_left(
+        const T* __restrict__ x, const T* __restrict__ table,
+        const long long n_blocks, const int n_levels, const long long block,
+        const long long lo, long long i, const P& stop) {
+
+    const long long begin = max(lo, i / block * block);
+    for(; i >= begin; i--) {
+        if(stop(x[i])) {
+            return i;
         }
-        i--;
+    }
+    if(i < lo) {
+        return lo - 1;
     }
 
-    right_bases[idx] = peak;
-    i = peak;
-    T right_min = x[peak];
+    const long long lo_block = lo / block;
+    long long b = i / block;
+    for(int k = n_levels - 1; k >= 0; k--) {
+        const long long s = b - (1LL << k) + 1;
+        if(s > lo_block && !stop(table[k * n_blocks + s])) {
+            b = s - 1;
+        }
+    }
+    for(i = min(i, b * block + block - 1); i >= lo; i--) {
+        if(stop(x[i])) {
+            return i;
+        }
+    }
+    return lo - 1;
+}
 
-    while(i <= i_max && x[i] <= x[peak]) {
-        if(x[i] < right_min) {
-            right_min = x[i];
-            right_bases[idx] = i;
+// Returns the first index in [i, hi] where `stop` holds, or hi + 1.
+template<typename T, typename P>
+__device__ long long peak_search_right(
+        const T* __restrict__ x, const T* __restrict__ table,
+        const long long n_blocks, const int n_levels, const long long block,
+        long long i, const long long hi, const P& stop) {
+
+    const long long end = min(hi, i / block * block + block - 1);
+    for(; i <= end; i++) {
+        if(stop(x[i])) {
+            return i;
         }
-        i++;
     }
+    if(i > hi) {
+        return hi + 1;
+    }
+
+    const long long hi_block = hi / block;
+    long long b = i / block;
+    for(int k = n_levels - 1; k >= 0; k--) {
+        const long long e = b + (1LL << k) - 1;
+        if(e < hi_block && !stop(table[k * n_blocks + b])) {
+            b = e + 1;
+        }
+    }
+    for(i = max(i, b * block); i <= hi; i++) {
+        if(stop(x[i])) {
+            return i;
+        }
+    }
+    return hi + 1;
+}
 
-    prominences[idx] = x[peak] - max(left_min, right_min);
+// The minimum of x[lo:hi + 1], with the full blocks read from two
+// overlapping ranges of the table.
+template<typename T>
+__device__ T peak_range_min(
+        const T* __restrict__ x, const T* __restrict__ mins,
+        const long long n_blocks, const long long block,
+        const long long lo, const long long hi) {
+
+    const long long lo_block = (lo + block - 1) / block;
+    const long long hi_block = (hi + 1) / block;
+    T m = x[hi];
+    if(hi_block <= lo_block) {
+        for(long long i = lo; i < hi; i++) {
+            m = nan_min(m, x[i]);
+        }
+        return m;
+    }
+    for(long long i = lo; i < lo_block * block; i++) {
+        m = nan_min(m, x[i]);
+    }
+    for(long long i = hi_block * block; i < hi; i++) {
+        m = nan_min(m, x[i]);
+    }
+    const int k = 63 - __clzll(hi_block - lo_block);
+    m = nan_min(m, mins[k * n_blocks + lo_block]);
+    return nan_min(m, mins[k * n_blocks + hi_block - (1LL << k)]);
 }
 
-template<>
-__global__ void peak_prominences<half>(
-        const int n, const int n_peaks, const half* __restrict__ x,
+template<typename T>
+__global__ void peak_prominences(
+        const long long n, const long long n_peaks, const T* __restrict__ x,
         const long long* __restrict__ peaks, const long long wlen,
-        half* prominences, long long* left_bases, long long* right_bases) {
+        const T* __restrict__ mins, const T* __restrict__ maxs,
+        const long long n_blocks, const int n_levels, const long long block,
+        T* prominences, long long* left_bases, long long* right_bases) {
 
-    const int idx = blockDim.x * blockIdx.x + threadIdx.x;
+    const long long idx = (long long) blockDim.x * blockIdx.x + threadIdx.x;
     if(idx >= n_peaks) {
         return;
     }
 
     const long long peak = peaks[idx];
-    long long i_min = 0;
-    long long i_max = n - 1;
+    long long i_min = peak / n * n;
+    long long i_max = i_min + n - 1;
 
     if(wlen >= 2) {
         i_min = max(peak - wlen / 2, i_min);
         i_max = min(peak + wlen / 2, i_max);
     }
 
-    left_bases[idx] = peak;
-    long long i = peak;
-    half left_min = x[peak];
+    // The bases are the minima between the peak and the nearest higher
+    // samples in the window, the closest to the peak on ties
+    const T height = x[peak];
+    const peak_exceeds<T> higher = {height};
 
-    while(i_min <= i && x[i] <= x[peak]) {
-        if(x[i] < left_min) {
-            left_min = x[i];
-            left_bases[idx] = i;
-        }
-        i--;
+    const long long left = peak_search_left(
+        x, maxs, n_blocks, n_levels, block, i_min, peak, higher) + 1;
+    T left_min = height;
+    left_bases[idx] = peak;
+    if(left <= peak) {
+        left_min = peak_range_min(x, mins, n_blocks, block, left, peak);
+        const peak_reaches<T> lowest = {left_min};
+        left_bases[idx] = peak_search_left(
+            x, mins, n_blocks, n_levels, block, left, peak, lowest);
     }
 
+    const long long right = peak_search_right(
+        x, maxs, n_blocks, n_levels, block, peak, i_max, higher) - 1;
+    T right_min = height;
     right_bases[idx] = peak;
-    i = peak;
-    half right_min = x[peak];
-
-    while(i <= i_max && x[i] <= x[peak]) {
-        if(x[i] < right_min) {
-            right_min = x[i];
-            right_bases[idx] = i;
-        }
-        i++;
+    if(peak <= right) {
+        right_min = peak_range_min(x, mins, n_blocks, block, peak, right);
+        const peak_reaches<T> lowest = {right_min};
+        right_bases[idx] = peak_search_right(
+            x, mins, n_blocks, n_levels, block, peak, right, lowest);
     }
 
-    prominences[idx] = x[peak] - __hmax(left_min, right_min);
+    prominences[idx] = height - (left_min < right_min ? right_min : left_min);
 }
 
 template<typename T>
 __global__ void peak_widths(
-        const int n, const T* __restrict__ x,
+        const long long n, const T* __restrict__ x,
         const long long* __restrict__ peaks,
         const double rel_height,
         const T* __restrict__ prominences,
         const long long* __restrict__ left_bases,
         const long long* __restrict__ right_bases,
+        const T* __restrict__ mins, const long long n_blocks,
+        const int n_levels, const long long block,
         double* widths, double* width_heights,
         double* left_ips, double* right_ips) {
 
-    const int idx = blockDim.x * blockIdx.x + threadIdx.x;
+    const long long idx = (long long) blockDim.x * blockIdx.x + threadIdx.x;
     if(idx >= n) {
         return;
     }
@@ -220,31 +353,34 @@ __global__ void peak_widths(
     long long i_max = right_bases[idx];
     long long peak = peaks[idx];
 
-    double height = x[peak] - prominences[idx] * rel_height;
+    double height = ((double) x[peak]) - ((double) prominences[idx]) * rel_height;
     width_heights[idx] = height;
+    const peak_reaches<double> below = {height};
 
     // Find intersection point on left side
     long long i = peak;
-    while (i_min < i && height < x[i]) {
-        i--;
+    if(i_min < peak) {
+        i = peak_search_left(
+            x, mins, n_blocks, n_levels, block, i_min + 1, peak, below);
     }
 
     double left_ip = (double) i;
-    if(x[i] < height) {
+    if(((double) x[i]) < height) {
         // Interpolate if true intersection height is between samples
-        left_ip += (height - x[i]) / (x[i + 1] - x[i]);
+        left_ip += (height - ((double) x[i])) / (((double) x[i + 1]) - ((double) x[i]));
     }
 
     // Find intersection point on right side
     i = peak;
-    while(i < i_max && height < x[i]) {
-        i++;
+    if(peak < i_max) {
+        i = peak_search_right(
+            x, mins, n_blocks, n_levels, block, peak, i_max - 1, below);
     }
 
     double right_ip = (double) i;
-    if(x[i] < height) {
+    if(((double) x[i]) < height) {
         // Interpolate if true intersection height is between samples
-        right_ip -= (height - x[i]) / (x[i - 1] - x[i]);
+        right_ip -= (height - ((double) x[i])) / (((double) x[i - 1]) - ((double) x[i]));
     }
 
     widths[idx] = right_ip - left_ip;
@@ -252,64 +388,93 @@ __global__ void peak_widths(
     right_ips[idx] = right_ip;
 }
 
-template<>
-__global__ void peak_widths<half>(
-        const int n, const half* __restrict__ x,
-        const long long* __restrict__ peaks,
-        const double rel_height,
-        const half* __restrict__ prominences,
-        const long long* __restrict__ left_bases,
-        const long long* __restrict__ right_bases,
-        double* widths, double* width_heights,
-        double* left_ips, double* right_ips) {
-
-    const int idx = blockDim.x * blockIdx.x + threadIdx.x;
-    if(idx >= n) {
-        return;
+// Whether peak `i` is visited before peak `j` when the peaks are visited by
+// decreasing priority: NaN first, then the later peak on ties.
+template<typename T>
+__device__ __forceinline__ bool peak_outranks(
+        const T a, const long long i, const T b, const long long j) {
+    if(b != b) {
+        return a != a && i > j;
     }
+    return a != a || b < a || (!(a < b) && i > j);
+}
 
-    long long i_min = left_bases[idx];
-    long long i_max = right_bases[idx];
-    long long peak = peaks[idx];
-
-    double height = ((double) x[peak]) - ((double) prominences[idx]) * rel_height;
-    width_heights[idx] = height;
+// The greedy selection by priority, run as rounds by a single block: a
+// peak with the highest priority among the undecided peaks in its distance
+// is kept, and the undecided peaks in its distance are removed. The kept
+// peaks are the ones of the sequential selection, with no round trip to
+// the host. `state` holds 0 for undecided peaks, 1 for kept peaks, 2 for
+// the peaks kept in the current round and -1 for removed peaks.
+template<typename T>
+__global__ void select_by_peak_distance(
+        const long long n, const long long n_peaks,
+        const long long* __restrict__ peaks, const T* __restrict__ priority,
+        const long long distance, signed char* state, bool* keep) {
 
-    // Find intersection point on left side
-    long long i = peak;
-    while (i_min < i && height < ((double) x[i])) {
-        i--;
+    for(long long j = threadIdx.x; j < n_peaks; j += blockDim.x) {
+        state[j] = keep[j] ? 0 : -1;
     }
+    __syncthreads();
 
-    double left_ip = (double) i;
-    if(((double) x[i]) < height) {
-        // Interpolate if true intersection height is between samples
-        left_ip += (height - ((double) x[i])) / ((double) (x[i + 1] - x[i]));
-    }
+    for(;;) {
+        int undecided = 0;
+        for(long long j = threadIdx.x; j < n_peaks; j += blockDim.x) {
+            if(state[j] != 0) {
+                continue;
+            }
+            undecided = 1;
+            const long long row = peaks[j] / n;
+            bool top = true;
+            for(long long k = j - 1; top && 0 <= k && peaks[k] / n == row
+                    && peaks[j] - peaks[k] < distance; k--) {
+                top = !((state[k] == 0 || state[k] == 2) && peak_outranks(
+                    priority[k], k, priority[j], j));
+            }
+            for(long long k = j + 1; top && k < n_peaks && peaks[k] / n == row
+                    && peaks[k] - peaks[j] < distance; k++) {
+                top = !((state[k] == 0 || state[k] == 2) && peak_outranks(
+                    priority[k], k, priority[j], j));
+            }
+            if(top) {
+                state[j] = 2;
+            }
+        }
+        if(!__syncthreads_or(undecided)) {
+            break;
+        }
 
-    // Find intersection point on right side
-    i = peak;
-    while(i < i_max && height < ((double) x[i])) {
-        i++;
+        for(long long j = threadIdx.x; j < n_peaks; j += blockDim.x) {
+            if(state[j] != 2) {
+                continue;
+            }
+            state[j] = 1;
+            const long long row = peaks[j] / n;
+            for(long long k = j - 1; 0 <= k && peaks[k] / n == row
+                    && peaks[j] - peaks[k] < distance; k--) {
+                state[k] = -1;
+            }
+            for(long long k = j + 1; k < n_peaks && peaks[k] / n == row
+                    && peaks[k] - peaks[j] < distance; k++) {
+                state[k] = -1;
+            }
+        }
+        __syncthreads();
     }
 
-    double right_ip = (double) i;
-    if(((double) x[i]) < height) {
-        // Interpolate if true intersection height is between samples
-        right_ip -= (height - ((double) x[i])) / ((double) (x[i - 1] - x[i]));
+    for(long long j = threadIdx.x; j < n_peaks; j += blockDim.x) {
+        keep[j] = state[j] == 1;
     }
-
-    widths[idx] = right_ip - left_ip;
-    left_ips[idx] = left_ip;
-    right_ips[idx] = right_ip;
 }
 """  # NOQA
 
 PEAKS_MODULE = cupy.RawModule(
     code=PEAKS_KERNEL, options=('-std=c++11',),
     name_expressions=[f'local_maxima_1d<{x}>' for x in TYPE_NAMES] +
+    [f'peak_block_extrema<{x}>' for x in TYPE_NAMES] +
+    [f'peak_block_level<{x}>' for x in TYPE_NAMES] +
     [f'peak_prominences<{x}>' for x in TYPE_NAMES] +
-    [f'peak_widths<{x}>' for x in TYPE_NAMES])
+    [f'peak_widths<{x}>' for x in TYPE_NAMES] +
+    [f'select_by_peak_distance<{x}>' for x in TYPE_NAMES])
 
 
 ARGREL_KERNEL = r"""
@@ -487,8 +652,11 @@ def _get_module_func(module, func_name, *template_args):
     return kernel
 
 
-def _local_maxima_1d(x):
-    samples = x.shape[0] - 2
+def _local_maxima_1d(x, n=None):
+    # The rows of `n` samples of `x` are searched separately, and the indices
+    # are in the flattened `x`
+    n = x.size if n is None else n
+    samples = x.size // n * (n - 2) if n > 2 else 0
     block_sz = 128
     n_blocks = (samples + block_sz - 1) // block_sz
 
@@ -496,11 +664,13 @@ def _local_maxima_1d(x):
     left_edges = cupy.empty(samples, dtype=cupy.int64)
     right_edges = cupy.empty(samples, dtype=cupy.int64)
 
-    local_max_kernel = _get_module_func(PEAKS_MODULE, 'local_maxima_1d', x)
-    local_max_kernel((n_blocks,), (block_sz,),
-                     (x.shape[0], x, midpoints, left_edges, right_edges))
+    if samples > 0:
+        local_max_kernel = _get_module_func(
+            PEAKS_MODULE, 'local_maxima_1d', x)
+        local_max_kernel((n_blocks,), (block_sz,),
+                         (n, x.size, x, midpoints, left_edges, right_edges))
 
-    pos_idx = midpoints > 0
+    pos_idx = midpoints >= 0
     midpoints = midpoints[pos_idx]
     left_edges = left_edges[pos_idx]
     right_edges = right_edges[pos_idx]
@@ -545,12 +715,12 @@ def _unpack_condition_args(interval, x, peaks):
         if imin.size != x.size:
             raise ValueError(
                 'array size of lower interval border must match x')
-        imin = imin[peaks]
+        imin = imin.ravel()[peaks]
     if isinstance(imax, cupy.ndarray):
         if imax.size != x.size:
             raise ValueError(
                 'array size of upper interval border must match x')
-        imax = imax[peaks]
+        imax = imax.ravel()[peaks]
 
     return imin, imax
 
@@ -630,7 +800,7 @@ def _select_by_peak_threshold(x, peaks, tmin, tmax):
     return keep, stacked_thresholds[0], stacked_thresholds[1]
 
 
-def _select_by_peak_distance(peaks, priority, distance):
+def _select_by_peak_distance(peaks, priority, distance, n=None, keep=None):
     """
     Evaluate which peaks fulfill the distance condition.
 
@@ -643,6 +813,12 @@ def _select_by_peak_distance(peaks, priority, distance):
         peak with a higher priority value is kept over one with a lower one.
     distance : np.float64
         Minimal distance that peaks must be spaced.
+    n : int, optional
+        The length of the rows of the signal, whose peaks are selected
+        separately. The whole signal is a row by default.
+    keep : ndarray[bool], optional
+        A boolean mask of the `peaks` to select from. The other peaks are
+        ignored, and are not kept.
 
     Returns
     -------
@@ -652,47 +828,28 @@ def _select_by_peak_distance(peaks, priority, distance):
 
     Notes
     -----
-    Declaring the input arrays as C-contiguous doesn't seem to have performance
-    advantages.
+    The peaks are selected by decreasing priority as in the sequential
+    algorithm, but in rounds by a single thread block: each round keeps the
+    peaks that have the highest priority among the undecided peaks within
+    `distance`, and removes the others within `distance` of them.
     """
     peaks_size = peaks.shape[0]
-    # Round up because actual peak distance can only be natural number
-    distance_ = cupy.ceil(distance)
-    keep = cupy.ones(peaks_size, dtype=cupy.bool_)  # Prepare array of flags
-
-    # Create map from `i` (index for `peaks` sorted by `priority`) to `j`
-    # (index for `peaks` sorted by position). This allows to iterate `peaks`
-    # and `keep` with `j` by order of `priority` while still maintaining the
-    # ability to step to neighbouring peaks with (`j` + 1) or (`j` - 1).
-    priority_to_position = cupy.argsort(priority)
-
-    # Highest priority first -> iterate in reverse order (decreasing)
-
-    # NOTE: There's not an alternative way to do this procedure in a parallel
-    # fashion, since discarding a peak requires to know if there's a valid
-    # neighbour that subsumes it, which in turn requires to know
-    # if that neighbour is valid. If it was to done in parallel, there would be
-    # tons of repeated computations per peak, thus increasing the total runtime
-    # per peak compared to a sequential implementation.
-    for i in range(peaks_size - 1, -1, -1):
-        # "Translate" `i` to `j` which points to current peak whose
-        # neighbours are to be evaluated
-        j = priority_to_position[i]
-        if keep[j] == 0:
-            # Skip evaluation for peak already marked as "don't keep"
-            continue
-
-        k = j - 1
-        # Flag "earlier" peaks for removal until minimal distance is exceeded
-        while 0 <= k and peaks[j] - peaks[k] < distance_:
-            keep[k] = 0
-            k -= 1
-
-        k = j + 1
-        # Flag "later" peaks for removal until minimal distance is exceeded
-        while k < peaks_size and peaks[k] - peaks[j] < distance_:
-            keep[k] = 0
-            k += 1
+    if n is None:
+        n = 1 << 62
+    if keep is None:
+        keep = cupy.ones(peaks_size, dtype=cupy.bool_)
+    else:
+        keep = keep.copy()
+    # Round up because actual peak distance can only be natural number.
+    # Distances beyond the length of the rows are all the same.
+    distance_ = math.ceil(min(distance, n + 1))
+    state = cupy.empty(peaks_size, dtype=cupy.int8)
+
+    distance_kernel = _get_module_func(
+        PEAKS_MODULE, 'select_by_peak_distance', priority)
+    distance_kernel(
+        (1,), (1024,),
+        (n, peaks_size, peaks, priority, distance_, state, keep))
     return keep
 
 
@@ -770,7 +927,39 @@ def _check_prominence_invalid(n, peaks, left_bases, right_bases, out):
     out[tid] = not valid
 
 
-def _peak_prominences(x, peaks, wlen=None, check=False):
+_PEAK_BLOCK = 256
+
+
+def _peak_block_tables(x):
+    """Build the sparse tables of the extrema of the blocks of `x`.
+
+    The prominences and widths are found by searching the nearest samples
+    above or below a height and by querying the minimum of ranges, which
+    read the samples up to the block boundaries and the tables in between.
+    """
+    n_blocks = (x.size + _PEAK_BLOCK - 1) // _PEAK_BLOCK
+    n_levels = n_blocks.bit_length()
+    mins = cupy.empty((n_levels, n_blocks), dtype=x.dtype)
+    maxs = cupy.empty((n_levels, n_blocks), dtype=x.dtype)
+
+    block_sz = 128
+    if n_blocks > 0:
+        extrema_kernel = _get_module_func(
+            PEAKS_MODULE, 'peak_block_extrema', x)
+        extrema_kernel(
+            ((n_blocks + block_sz - 1) // block_sz,), (block_sz,),
+            (x.size, _PEAK_BLOCK, n_blocks, x, mins, maxs))
+    level_kernel = _get_module_func(PEAKS_MODULE, 'peak_block_level', x)
+    for k in range(1, n_levels):
+        n_starts = n_blocks - (1 << k) + 1
+        level_kernel(
+            ((n_starts + block_sz - 1) // block_sz,), (block_sz,),
+            (n_blocks, k, mins, maxs))
+    return mins, maxs
+
+
+def _peak_prominences(x, peaks, wlen=None, check=False, n=None,
+                      tables=None):
     if check and cupy.any(cupy.logical_or(peaks < 0, peaks > x.shape[0] - 1)):
         raise ValueError('peaks are not a valid index')
 
@@ -778,20 +967,26 @@ def _peak_prominences(x, peaks, wlen=None, check=False):
     left_bases = cupy.empty(peaks.shape[0], dtype=cupy.int64)
     right_bases = cupy.empty(peaks.shape[0], dtype=cupy.int64)
 
-    n = peaks.shape[0]
+    n_peaks = peaks.shape[0]
     block_sz = 128
-    n_blocks = (n + block_sz - 1) // block_sz
+    n_blocks = (n_peaks + block_sz - 1) // block_sz
 
+    if n is None:
+        n = x.size
+    if tables is None:
+        tables = _peak_block_tables(x)
+    mins, maxs = tables
     peak_prom_kernel = _get_module_func(PEAKS_MODULE, 'peak_prominences', x)
     peak_prom_kernel(
         (n_blocks,), (block_sz,),
-        (x.shape[0], n, x, peaks, wlen, prominences, left_bases, right_bases))
+        (n, n_peaks, x, peaks, wlen, mins, maxs, mins.shape[1],
+         mins.shape[0], _PEAK_BLOCK, prominences, left_bases, right_bases))
 
     return prominences, left_bases, right_bases
 
 
 def _peak_widths(x, peaks, rel_height, prominences, left_bases, right_bases,
-                 check=False):
+                 check=False, tables=None):
     if rel_height < 0:
         raise ValueError('`rel_height` must be greater or equal to 0.0')
     if prominences is None:
@@ -822,10 +1017,14 @@ def _peak_widths(x, peaks, rel_height, prominences, left_bases, right_bases,
     left_ips = cupy.empty(peaks.shape[0], dtype=cupy.float64)
     right_ips = cupy.empty(peaks.shape[0], dtype=cupy.float64)
 
+    if tables is None:
+        tables = _peak_block_tables(x)
+    mins = tables[0]
     peak_widths_kernel = _get_module_func(PEAKS_MODULE, 'peak_widths', x)
     peak_widths_kernel(
         (n_blocks,), (block_sz,),
         (n, x, peaks, rel_height, prominences, left_bases, right_bases,
+         mins, mins.shape[1], mins.shape[0], _PEAK_BLOCK,
          widths, width_heights, left_ips, right_ips))
     return widths, width_heights, left_ips, right_ips
 
@@ -1149,76 +1348,86 @@ def find_peaks(x, height=None, threshold=None, distance=None,
     """  # NOQA
 
     x = _arg_x_as_expected(x)
+    return _find_peaks(x, x.size, height, threshold, distance, prominence,
+                       width, wlen, rel_height, plateau_size)
+
+
+def _find_peaks(x, n, height=None, threshold=None, distance=None,
+                prominence=None, width=None, wlen=None, rel_height=0.5,
+                plateau_size=None):
+    """Find the peaks of each row of `n` samples of the C-contiguous `x`.
+
+    The indices of the peaks and of the properties are in the flattened `x`.
+    The conditions narrow a mask of the local maxima, and the peaks and
+    their properties are selected once at the end, so that the host only
+    waits for the number of local maxima and of selected peaks.
+    """
     if distance is not None and distance < 1:
         raise ValueError('`distance` must be greater or equal to 1')
 
-    peaks, left_edges, right_edges = _local_maxima_1d(x)
+    x = x.ravel()
+    peaks, left_edges, right_edges = _local_maxima_1d(x, n)
+    keep = cupy.ones(peaks.size, dtype=cupy.bool_)
     properties = {}
 
     if plateau_size is not None:
         # Evaluate plateau size
         plateau_sizes = right_edges - left_edges + 1
         pmin, pmax = _unpack_condition_args(plateau_size, x, peaks)
-        keep = _select_by_property(plateau_sizes, pmin, pmax)
-        peaks = peaks[keep]
+        keep &= _select_by_property(plateau_sizes, pmin, pmax)
         properties["plateau_sizes"] = plateau_sizes
         properties["left_edges"] = left_edges
         properties["right_edges"] = right_edges
-        properties = {key: array[keep] for key, array in properties.items()}
 
     if height is not None:
         # Evaluate height condition
         peak_heights = x[peaks]
         hmin, hmax = _unpack_condition_args(height, x, peaks)
-        keep = _select_by_property(peak_heights, hmin, hmax)
-        peaks = peaks[keep]
+        keep &= _select_by_property(peak_heights, hmin, hmax)
         properties["peak_heights"] = peak_heights
-        properties = {key: array[keep] for key, array in properties.items()}
 
     if threshold is not None:
         # Evaluate threshold condition
         tmin, tmax = _unpack_condition_args(threshold, x, peaks)
-        keep, left_thresholds, right_thresholds = _select_by_peak_threshold(
-            x, peaks, tmin, tmax)
-        peaks = peaks[keep]
+        keep_threshold, left_thresholds, right_thresholds = \
+            _select_by_peak_threshold(x, peaks, tmin, tmax)
+        keep &= keep_threshold
         properties["left_thresholds"] = left_thresholds
         properties["right_thresholds"] = right_thresholds
-        properties = {key: array[keep] for key, array in properties.items()}
 
     if distance is not None:
-        # Evaluate distance condition
-        keep = _select_by_peak_distance(peaks, x[peaks], distance)  # NOQA
-        peaks = peaks[keep]
-        properties = {key: array[keep] for key, array in properties.items()}
+        # Evaluate distance condition among the peaks kept so far
+        keep = _select_by_peak_distance(
+            peaks, x[peaks], distance, n, keep)
 
     if prominence is not None or width is not None:
         # Calculate prominence (required for both conditions)
-        wlen = _arg_wlen_as_expected(wlen)  # NOQA
+        wlen = _arg_wlen_as_expected(wlen)
+        tables = _peak_block_tables(x)
         properties.update(zip(
             ['prominences', 'left_bases', 'right_bases'],
-            _peak_prominences(x, peaks, wlen=wlen)  # NOQA
+            _peak_prominences(x, peaks, wlen=wlen, n=n, tables=tables)
         ))
 
     if prominence is not None:
         # Evaluate prominence condition
-        pmin, pmax = _unpack_condition_args(prominence, x, peaks)  # NOQA
-        keep = _select_by_property(properties['prominences'], pmin, pmax)  # NOQA
-        peaks = peaks[keep]
-        properties = {key: array[keep] for key, array in properties.items()}
+        pmin, pmax = _unpack_condition_args(prominence, x, peaks)
+        keep &= _select_by_property(properties['prominences'], pmin, pmax)
 
     if width is not None:
         # Calculate widths
         properties.update(zip(
             ['widths', 'width_heights', 'left_ips', 'right_ips'],
-            _peak_widths(x, peaks, rel_height, properties['prominences'],  # NOQA
-                         properties['left_bases'], properties['right_bases'])
+            _peak_widths(x, peaks, rel_height, properties['prominences'],
+                         properties['left_bases'], properties['right_bases'],
+                         tables=tables)
         ))
         # Evaluate width condition
-        wmin, wmax = _unpack_condition_args(width, x, peaks)  # NOQA
-        keep = _select_by_property(properties['widths'], wmin, wmax)  # NOQA
-        peaks = peaks[keep]
-        properties = {key: array[keep] for key, array in properties.items()}
+        wmin, wmax = _unpack_condition_args(width, x, peaks)
+        keep &= _select_by_property(properties['widths'], wmin, wmax)
 
+    peaks = peaks[keep]
+    properties = {key: array[keep] for key, array in properties.items()}
     return peaks, properties
 
 
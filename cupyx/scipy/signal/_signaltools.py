@@ -5,6 +5,7 @@ from cupy._core import internal
 from cupy.linalg import lstsq
 
 import cupyx.scipy.fft as sp_fft
+from cupyx.scipy.fftpack import get_fft_plan
 from cupyx.scipy.ndimage import _util
 from cupyx.scipy.ndimage import _filters
 from cupyx.scipy.signal import _signaltools_core as _st_core
@@ -310,6 +311,131 @@ def oaconvolve(in1, in2, mode="full", axes=None):
     return _st_core._apply_conv_mode(ret, s1, s2, mode, axes)
 
 
+class StreamingConvolver:
+    """Convolution of a stream of chunks with a fixed filter.
+
+    The convolution of a signal received in chunks of ``chunk_size`` samples
+    with a 1D filter ``h``, by the overlap-save method. The spectrum of the
+    filter and the FFT plans are computed once, and the last samples of the
+    stream are kept on the device, so that each chunk costs one forward FFT,
+    one pointwise multiplication and one inverse FFT of
+    ``next_fast_len(chunk_size + len(h) - 1)`` points.
+
+    Args:
+        h (cupy.ndarray): The 1D filter.
+        chunk_size (int): The number of samples of each chunk.
+        shape (tuple of int): The shape of the chunks except for their last
+            axis, for several channels filtered by the same filter. The
+            default is ``()``.
+        dtype: The dtype of the computation and of the outputs. It is
+            promoted with the dtype of ``h`` and ``float32``. The default is
+            the dtype of ``h``.
+
+    .. note::
+        Calling the object with the chunks of a signal ``x`` and then
+        :meth:`flush` returns, concatenated, the same values as
+        ``fftconvolve(x, h)`` along the last axis.
+
+    .. seealso:: :func:`cupyx.scipy.signal.oaconvolve`
+
+    .. note::
+        This class is specific to CuPy and does not exist in SciPy.
+    """
+
+    def __init__(self, h, chunk_size, shape=(), dtype=None):
+        h = cupy.asarray(h)
+        if h.ndim != 1 or h.size == 0:
+            raise ValueError('h must be 1D with non-zero length')
+        chunk_size = int(chunk_size)
+        if chunk_size < 1:
+            raise ValueError('chunk_size must be positive')
+        self._dtype = cupy.result_type(
+            h.dtype, h.dtype if dtype is None else dtype, cupy.float32)
+        self._real = self._dtype.kind != 'c'
+        self._chunk_size = chunk_size
+        self._n_taps = h.size
+        self._shape = tuple(shape)
+        # the FFT size, of which the first n_fft - chunk_size samples are
+        # kept from the previous chunks
+        self._n_fft = sp_fft.next_fast_len(chunk_size + h.size - 1,
+                                           self._real)
+        self._buffer = cupy.zeros(self._shape + (self._n_fft,), self._dtype)
+        h = h.astype(self._dtype, copy=False)
+        if self._real:
+            self._fft, self._ifft = sp_fft.rfft, sp_fft.irfft
+            self._fft_plan = get_fft_plan(
+                self._buffer, axes=-1, value_type='R2C')
+            self._spectrum = self._fft(h, self._n_fft)
+            spectrum = cupy.empty(
+                self._shape + self._spectrum.shape, self._spectrum.dtype)
+            self._ifft_plan = get_fft_plan(
+                spectrum, shape=(self._n_fft,), axes=-1, value_type='C2R')
+        else:
+            self._fft, self._ifft = sp_fft.fft, sp_fft.ifft
+            self._fft_plan = get_fft_plan(self._buffer, axes=-1)
+            self._ifft_plan = self._fft_plan
+            self._spectrum = self._fft(h, self._n_fft)
+
+    @property
+    def chunk_size(self):
+        """The number of samples of each chunk."""
+        return self._chunk_size
+
+    def __call__(self, x):
+        """Convolves the next chunk of the stream.
+
+        Args:
+            x (cupy.ndarray): The chunk, of shape
+                ``shape + (chunk_size,)``.
+
+        Returns:
+            cupy.ndarray: The next ``chunk_size`` samples of the convolution.
+        """
+        if x.shape != self._shape + (self._chunk_size,):
+            raise ValueError(
+                'the chunk must have shape {} (actual: {})'.format(
+                    self._shape + (self._chunk_size,), x.shape))
+        n_keep = self._n_fft - self._chunk_size
+        buffer = self._buffer
+        # the overlap: the last samples of the previous chunks
+        buffer[..., :n_keep] = buffer[..., self._chunk_size:].copy()
+        buffer[..., n_keep:] = x
+        y = self._fft(buffer, axis=-1, plan=self._fft_plan)
+        y *= self._spectrum
+        if self._real:
+            y = self._ifft(y, self._n_fft, axis=-1, overwrite_x=True,
+                           plan=self._ifft_plan)
+        else:
+            y = self._ifft(y, axis=-1, overwrite_x=True,
+                           plan=self._ifft_plan)
+        # the first outputs are aliased by the circular convolution
+        return y[..., n_keep:]
+
+    def flush(self):
+        """Returns the last ``len(h) - 1`` samples of the convolution.
+
+        The stream is then reset.
+
+        Returns:
+            cupy.ndarray: The samples of the convolution after the last
+            chunk.
+        """
+        n_tail = self._n_taps - 1
+        zeros = cupy.zeros(self._shape + (self._chunk_size,), self._dtype)
+        tails = []
+        while n_tail > 0:
+            tails.append(self(zeros)[..., :n_tail])
+            n_tail -= self._chunk_size
+        self.reset()
+        if not tails:
+            return zeros[..., :0]
+        return cupy.concatenate(tails, axis=-1)
+
+    def reset(self):
+        """Starts a new stream, with zeros before its first sample."""
+        self._buffer.fill(0)
+
+
 def convolve2d(in1, in2, mode='full', boundary='fill', fillvalue=0):
     """Convolve two 2-dimensional arrays.
 
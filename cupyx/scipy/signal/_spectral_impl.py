@@ -28,6 +28,7 @@ DEALINGS IN THE SOFTWARE.
 import warnings
 
 import cupy
+from cupy._core._scalar import get_typename
 
 import cupyx.scipy.signal._signaltools as filtering
 from cupyx.scipy.signal._arraytools import (
@@ -490,24 +491,44 @@ def _spectral_helper(
     elif sides == "onesided":
         freqs = cupy.fft.rfftfreq(nfft, 1 / fs)
 
-    # Perform the windowed FFTs
-    result = _fft_helper(x, win, detrend_func, nperseg, noverlap, nfft, sides)
+    if not detrend or detrend in ("constant", "linear"):
+        # The segments are framed, detrended and windowed by one kernel, and
+        # the scaling is applied while the spectra are combined.
+        detrend_type = {False: 0, "constant": 1, "linear": 2}[detrend or False]
+        result = _fft_frames(x, win, detrend_type, nperseg, noverlap, nfft,
+                             sides)
+        result_y = None
+        if not same_data:
+            result_y = _fft_frames(y, win, detrend_type, nperseg, noverlap,
+                                   nfft, sides)
+        result = _scale_spectra(result, result_y, scale, mode, sides, nfft,
+                                outdtype)
+    else:
+        # Perform the windowed FFTs
+        result = _fft_helper(
+            x, win, detrend_func, nperseg, noverlap, nfft, sides)
 
-    if not same_data:
-        # All the same operations on the y data
-        result_y = _fft_helper(y, win, detrend_func,  # NOQA
-                               nperseg, noverlap, nfft, sides)
-        result = cupy.conj(result) * result_y
-    elif mode == "psd":
-        result = cupy.conj(result) * result
-
-    result *= scale
-    if sides == "onesided" and mode == "psd":
-        if nfft % 2:
-            result[..., 1:] *= 2
-        else:
-            # Last point is unpaired Nyquist freq point, don't double
-            result[..., 1:-1] *= 2
+        if not same_data:
+            # All the same operations on the y data
+            result_y = _fft_helper(y, win, detrend_func,  # NOQA
+                                   nperseg, noverlap, nfft, sides)
+            result = cupy.conj(result) * result_y
+        elif mode == "psd":
+            result = cupy.conj(result) * result
+
+        result *= scale
+        if sides == "onesided" and mode == "psd":
+            if nfft % 2:
+                result[..., 1:] *= 2
+            else:
+                # Last point is unpaired Nyquist freq point, don't double
+                result[..., 1:-1] *= 2
+
+        result = result.astype(outdtype)
+
+        # All imaginary parts are zero anyways
+        if same_data and mode != "stft":
+            result = result.real
 
     time = cupy.arange(
         nperseg / 2, x.shape[-1] - nperseg / 2 + 1, nperseg - noverlap
@@ -515,12 +536,6 @@ def _spectral_helper(
     if boundary is not None:
         time -= (nperseg / 2) / fs
 
-    result = result.astype(outdtype)
-
-    # All imaginary parts are zero anyways
-    if same_data and mode != "stft":
-        result = result.real
-
     # Output is going to have new last axis for time/window index, so a
     # negative axis index shifts down one
     if axis < 0:
@@ -645,6 +660,153 @@ def _fft_helper(x, win, detrend_func, nperseg, noverlap, nfft, sides):
     return result
 
 
+# The segments of the rows of a C-contiguous (rows, x_len) array, detrended
+# (1: constant, 2: linear), windowed and zero-padded to nfft, in a
+# (rows, nseg, nfft) array. A block computes a segment: the sums of the
+# samples and of the samples weighted by their index for the least-squares
+# fit are reduced in shared memory, in double precision.
+_FRAMES_KERNEL = r'''
+#include <cupy/complex.cuh>
+
+#define BLOCK 128
+
+extern "C" __global__ void cupyx_scipy_signal_stft_frames(
+        const X* x, const F* win, F* y, long long x_len, int nperseg,
+        int nfft, int step, int nseg, long long n_frames, int detrend) {
+    // raw storage, as complex<double> has a constructor
+    __shared__ __align__(16) unsigned char smem[2 * BLOCK * sizeof(A)];
+    A* s0 = reinterpret_cast<A*>(smem);
+    A* s1 = s0 + BLOCK;
+    for (long long frame = blockIdx.x; frame < n_frames;
+            frame += gridDim.x) {
+        const X* xs = x + frame / nseg * x_len + frame % nseg * step;
+        A a = 0, b = 0;
+        if (detrend) {
+            A t0 = 0, t1 = 0;
+            for (int j = threadIdx.x; j < nperseg; j += BLOCK) {
+                A v = (A)xs[j];
+                t0 += v;
+                t1 += v * (double)j;
+            }
+            s0[threadIdx.x] = t0;
+            s1[threadIdx.x] = t1;
+            __syncthreads();
+            for (int k = BLOCK / 2; k > 0; k /= 2) {
+                if (threadIdx.x < k) {
+                    s0[threadIdx.x] += s0[threadIdx.x + k];
+                    s1[threadIdx.x] += s1[threadIdx.x + k];
+                }
+                __syncthreads();
+            }
+            double n = nperseg;
+            double sj = n * (n - 1) / 2;
+            if (detrend == 2 && nperseg > 1) {
+                double sjj = (n - 1) * n * (2 * n - 1) / 6;
+                b = (n * s1[0] - sj * s0[0]) / (n * sjj - sj * sj);
+            }
+            a = (s0[0] - b * sj) / n;
+            // the sums are read before the next frame overwrites them
+            __syncthreads();
+        }
+        F* yf = y + frame * nfft;
+        for (int j = threadIdx.x; j < nfft; j += BLOCK) {
+            yf[j] = j < nperseg ? F((A)xs[j] - a - b * (double)j) * win[j]
+                                : F(0);
+        }
+    }
+}
+'''
+
+
+@cupy._util.memoize(for_each_device=True)
+def _get_frames_kernel(x_dtype, dtype):
+    acc_dtype = cupy.complex128 if x_dtype.kind == 'c' else cupy.float64
+    code = '#define X {}\n#define F {}\n#define A {}\n'.format(
+        get_typename(x_dtype), get_typename(dtype), get_typename(acc_dtype))
+    return cupy.RawKernel(code + _FRAMES_KERNEL,
+                          'cupyx_scipy_signal_stft_frames')
+
+
+def _fft_frames(x, win, detrend, nperseg, noverlap, nfft, sides):
+    """
+    Calculate the windowed FFT of the segments of x along its last axis, like
+    _fft_helper with a detrend of type ``False``, ``'constant'`` or
+    ``'linear'``, without strided copies of the segments.
+    """
+    if x.dtype.kind == 'c':
+        x_dtype = cupy.result_type(x.dtype, cupy.complex64)
+    else:
+        x_dtype = cupy.result_type(x.dtype, cupy.float32)
+    x = cupy.ascontiguousarray(x, x_dtype)
+    if sides == "twosided":
+        dtype = cupy.result_type(x_dtype, win.dtype, cupy.complex64)
+        win = win.astype(dtype, copy=False)
+        func = cupy.fft.fft
+    else:
+        # the real part of the windowed segments is transformed
+        dtype = win.real.dtype
+        win = cupy.ascontiguousarray(win.real)
+        func = cupy.fft.rfft
+
+    step = nperseg - noverlap
+    x_len = x.shape[-1]
+    nseg = (x_len - noverlap) // step
+    frames = cupy.empty(x.shape[:-1] + (nseg, nfft), dtype)
+    n_frames = frames.size // nfft
+    if n_frames:
+        kernel = _get_frames_kernel(x.dtype, dtype)
+        kernel((min(n_frames, 65535),), (128,),
+               (x, win, frames, x_len, nperseg, nfft, step, nseg, n_frames,
+                detrend))
+    return func(frames, n=nfft)
+
+
+_scale_psd_kernel = cupy.ElementwiseKernel(
+    'C z, raw float64 scale, int64 nfreq, bool double_freqs, bool even_nfft',
+    'R y',
+    '''
+    // the unpaired Nyquist frequency of an even nfft is not doubled
+    long long k = i % nfreq;
+    double factor = double_freqs && k > 0 && !(even_nfft && k == nfreq - 1)
+        ? 2.0 : 1.0;
+    double re = z.real(), im = z.imag();
+    y = (re * re + im * im) * scale[0] * factor;
+    ''', 'cupyx_scipy_signal_scale_psd')
+
+_scale_csd_kernel = cupy.ElementwiseKernel(
+    'C zx, C zy, raw float64 scale, int64 nfreq, bool double_freqs, '
+    'bool even_nfft',
+    'O y',
+    '''
+    long long k = i % nfreq;
+    double factor = double_freqs && k > 0 && !(even_nfft && k == nfreq - 1)
+        ? 2.0 : 1.0;
+    y = O(conj(zx) * zy) * (scale[0] * factor);
+    ''', 'cupyx_scipy_signal_scale_csd')
+
+
+def _scale_spectra(result, result_y, scale, mode, sides, nfft, outdtype):
+    # The spectra of x and y combined and scaled into an array of outdtype
+    # (of its real dtype for a PSD), in one kernel. The positive frequencies
+    # of a onesided PSD are doubled.
+    scale = cupy.asarray(scale).real.astype(cupy.float64).reshape(1)
+    if mode == "stft":
+        out = result.astype(outdtype, copy=False)
+        out *= scale.astype(out.real.dtype)
+        return out
+    nfreq = result.shape[-1]
+    double_freqs = sides == "onesided"
+    even_nfft = nfft % 2 == 0
+    if result_y is None:
+        out = cupy.empty(result.shape, cupy.finfo(outdtype).dtype)
+        return _scale_psd_kernel(result, scale, nfreq, double_freqs,
+                                 even_nfft, out)
+    shape = cupy.broadcast(result, result_y).shape
+    out = cupy.empty(shape, outdtype)
+    return _scale_csd_kernel(result, result_y, scale, nfreq, double_freqs,
+                             even_nfft, out)
+
+
 def _median_bias(n):
     """
     Returns the bias of the median of a set of periodograms relative to
@@ -28,6 +28,7 @@ DEALINGS IN THE SOFTWARE.
 
 from math import ceil
 import cupy
+from cupy._core import internal
 
 _upfirdn_modes = [
     'constant', 'wrap', 'edge', 'smooth', 'symmetric', 'reflect',
@@ -297,6 +298,96 @@ UPFIRDN_MODULE = cupy.RawModule(
     ])
 
 
+# The polyphase kernel filters the rows of a C-contiguous (rows, x_len) array.
+# A block computes blockDim.x consecutive outputs of a row, for the rows
+# blockIdx.y, blockIdx.y + gridDim.y, ...: the taps are staged in shared
+# memory once, and the input samples that the outputs of the block depend on
+# are staged with coalesced loads (zero outside of the input) for each row.
+# Each output then only reads the h_per_phase taps of its phase, and no work
+# is spent on the zeros inserted by the upsampling.
+UPFIRDN_POLYPHASE_KERNEL = r'''
+#include <cupy/complex.cuh>
+
+template<typename T>
+__global__ void _cupy_upfirdn_polyphase(
+        const T* __restrict__ inp, const T* __restrict__ h_trans_flip,
+        const int up, const int down, const int n_rows, const int x_len,
+        const int h_per_phase, T* __restrict__ out, const int out_len) {
+
+    extern __shared__ __align__(16) unsigned char smem[];
+    T* s_h = reinterpret_cast<T*>(smem);
+    T* s_x = s_h + up * h_per_phase;
+
+    for(int i = threadIdx.x; i < up * h_per_phase; i += blockDim.x) {
+        s_h[i] = h_trans_flip[i];
+    }
+
+    const long long o_first = (long long)blockIdx.x * blockDim.x;
+    const long long o_last = min(o_first + blockDim.x, (long long)out_len) - 1;
+    const long long x_first = o_first * down / up - h_per_phase + 1;
+    const int span = (int)(o_last * down / up - x_first + 1);
+
+    const long long o = o_first + threadIdx.x;
+    const int phase = (int)(o * down % up);
+    const int x_off = (int)(o * down / up - h_per_phase + 1 - x_first);
+
+    for(int row = blockIdx.y; row < n_rows; row += gridDim.y) {
+        const T* x_row = inp + (long long)row * x_len;
+
+        // the samples of the previous row are no longer used
+        __syncthreads();
+        for(int i = threadIdx.x; i < span; i += blockDim.x) {
+            long long xi = x_first + i;
+            s_x[i] = (xi >= 0 && xi < x_len) ? x_row[xi] : T(0);
+        }
+        __syncthreads();
+
+        if(o < out_len) {
+            const T* h = s_h + phase * h_per_phase;
+            const T* x = s_x + x_off;
+            T acc {};
+            for(int j = 0; j < h_per_phase; j++) {
+                acc += x[j] * h[j];
+            }
+            out[(long long)row * out_len + o] = acc;
+        }
+    }
+}
+'''
+
+
+UPFIRDN_POLYPHASE_MODULE = cupy.RawModule(
+    code=UPFIRDN_POLYPHASE_KERNEL, options=('-std=c++11',),
+    name_expressions=[
+        '_cupy_upfirdn_polyphase<float>',
+        '_cupy_upfirdn_polyphase<double>',
+        '_cupy_upfirdn_polyphase<thrust::complex<float>>',
+        '_cupy_upfirdn_polyphase<thrust::complex<double>>',
+    ])
+
+_polyphase_typenames = {
+    'float32': 'float',
+    'float64': 'double',
+    'complex64': 'thrust::complex<float>',
+    'complex128': 'thrust::complex<double>',
+}
+
+# The shared memory used by a block of the polyphase kernel
+_POLYPHASE_MAX_SHARED = 48 * 1024
+
+
+def _polyphase_block_size(n_taps, h_per_phase, up, down, itemsize):
+    # Returns the largest block size whose taps and input samples fit in the
+    # shared memory, or None.
+    block_sz = 256
+    while block_sz >= 32:
+        span = -(-(block_sz - 1) * down // up) + h_per_phase
+        if (n_taps + span) * itemsize <= _POLYPHASE_MAX_SHARED:
+            return block_sz, (n_taps + span) * itemsize
+        block_sz //= 2
+    return None
+
+
 def _pad_h(h, up):
     """Store coefficients in a transposed, flipped arrangement.
     For example, suppose upRate is 3, and the
@@ -378,6 +469,12 @@ class _UpFIRDn(object):
         h_per_phase = len(self._h_trans_flip) // self._up
         padded_len = x.shape[axis] + (len(self._h_trans_flip) // self._up) - 1
 
+        launch = _polyphase_block_size(
+            len(self._h_trans_flip), h_per_phase, self._up, self._down,
+            out.dtype.itemsize)
+        if launch is not None:
+            return self._apply_polyphase(x, axis, out, h_per_phase, *launch)
+
         if out.ndim == 1:
 
             threadsperblock, blockspergrid = _get_tpb_bpg()
@@ -434,6 +531,31 @@ class _UpFIRDn(object):
 
         return out
 
+    def _apply_polyphase(self, x, axis, out, h_per_phase, block_sz,
+                         shared_mem):
+        # The signals along axis are filtered as the rows of a 2D array.
+        x = cupy.ascontiguousarray(cupy.moveaxis(x, axis, -1))
+        x_len = x.shape[-1]
+        n_rows = internal.prod(x.shape[:-1])
+        out_len = out.shape[axis]
+        if out.size == 0:
+            return out
+        y = out if axis == out.ndim - 1 else cupy.empty(
+            x.shape[:-1] + (out_len,), out.dtype)
+        if n_rows:
+            kernel = UPFIRDN_POLYPHASE_MODULE.get_function(
+                '_cupy_upfirdn_polyphase<{}>'.format(
+                    _polyphase_typenames[out.dtype.name]))
+            grid = ((out_len + block_sz - 1) // block_sz,
+                    min(n_rows, 65535))
+            kernel(grid, (block_sz,),
+                   (x, self._h_trans_flip, self._up, self._down, n_rows,
+                    x_len, h_per_phase, y, out_len),
+                   shared_mem=shared_mem)
+        if y is not out:
+            out[...] = cupy.moveaxis(y, -1, axis)
+        return out
+
 
 def upfirdn(
     h,
@@ -3,6 +3,8 @@ from cupyx.scipy.sparse._base import isspmatrix  # NOQA
 from cupyx.scipy.sparse._base import spmatrix  # NOQA
 from cupyx.scipy.sparse._base import SparseWarning  # NOQA
 from cupyx.scipy.sparse._base import SparseEfficiencyWarning  # NOQA
+from cupyx.scipy.sparse._bsr import bsr_matrix  # NOQA
+from cupyx.scipy.sparse._bsr import isspmatrix_bsr  # NOQA
 from cupyx.scipy.sparse._coo import coo_matrix  # NOQA
 from cupyx.scipy.sparse._coo import isspmatrix_coo  # NOQA
 from cupyx.scipy.sparse._csc import csc_matrix  # NOQA
@@ -23,7 +25,6 @@ from cupyx.scipy.sparse._construct import bmat  # NOQA
 from cupyx.scipy.sparse._construct import hstack  # NOQA
 from cupyx.scipy.sparse._construct import vstack  # NOQA
 
-# TODO(unno): implement bsr_matrix
 # TODO(unno): implement dok_matrix
 # TODO(unno): implement lil_matrix
 
@@ -39,6 +40,5 @@ from cupyx.scipy.sparse._extract import triu  # NOQA
 # TODO(unno): implement save_npz
 # TODO(unno): implement load_npz
 
-# TODO(unno): implement isspmatrix_bsr(x)
 # TODO(unno): implement isspmatrix_lil(x)
 # TODO(unno): implement isspmatrix_dok(x)
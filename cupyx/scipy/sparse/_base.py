@@ -539,7 +539,7 @@ class spmatrix(object):
 
     def tobsr(self, blocksize=None, copy=False):
         """Convert this matrix to Block Sparse Row format."""
-        return self.tocsr(copy=copy).tobsr(copy=False)
+        return self.tocsr(copy=copy).tobsr(blocksize=blocksize, copy=False)
 
     def tocoo(self, copy=False):
         """Convert this matrix to COOrdinate format."""
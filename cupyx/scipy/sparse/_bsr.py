@@ -0,0 +1,504 @@
+import numpy
+try:
+    import scipy.sparse
+    _scipy_available = True
+except ImportError:
+    _scipy_available = False
+
+import cupy
+from cupy import _core
+from cupy._core._dtype import bfloat16
+from cupyx.scipy.sparse import _base
+from cupyx.scipy.sparse import _bsr_mma
+from cupyx.scipy.sparse import _coo
+from cupyx.scipy.sparse import _csr
+from cupyx.scipy.sparse import _data
+from cupyx.scipy.sparse import _util
+
+
+_bsr_preamble = '''
+template <typename T> struct bsr_acc { typedef T type; };
+template <> struct bsr_acc<float16> { typedef float type; };
+template <> struct bsr_acc<bfloat16> { typedef float type; };
+'''
+
+# Item i is item (r, c) of block b, which goes to row r of its block row in
+# the CSR matrix, after the items of the previous blocks of the row.
+_bsr_tocsr_kernel = _core.ElementwiseKernel(
+    'T x, raw int32 block_row, raw int32 bsr_indptr, raw int32 bsr_indices, '
+    'int32 R, int32 C',
+    'raw T data, raw int32 indices',
+    '''
+    const int b = i / (R * C);
+    const int r = i / C % R;
+    const int c = i % C;
+    const int begin = bsr_indptr[block_row[b]];
+    const int n_blocks = bsr_indptr[block_row[b] + 1] - begin;
+    const ptrdiff_t p = (ptrdiff_t)begin * R * C
+        + ((ptrdiff_t)r * n_blocks + (b - begin)) * C + c;
+    data[p] = x;
+    indices[p] = bsr_indices[b] * C + c;
+    ''',
+    'cupyx_scipy_sparse_bsr_tocsr')
+
+_bsr_toarray_kernel = _core.ElementwiseKernel(
+    'T x, raw int32 block_row, raw int32 bsr_indices, int32 R, int32 C, '
+    'int64 N',
+    'raw T out',
+    '''
+    const int b = i / (R * C);
+    const ptrdiff_t row = (ptrdiff_t)block_row[b] * R + i / C % R;
+    const ptrdiff_t col = (ptrdiff_t)bsr_indices[b] * C + i % C;
+    out[row * N + col] = x;
+    ''',
+    'cupyx_scipy_sparse_bsr_toarray')
+
+# One thread per item of the product, which goes through the row of the
+# blocks of its block row. The products of 16-bit floats are added up in
+# float32.
+_bsr_spmm_kernel = _core.ElementwiseKernel(
+    'raw T data, raw int32 indptr, raw int32 indices, raw T x, int32 R, '
+    'int32 C, int32 n',
+    'T y',
+    '''
+    typedef typename bsr_acc<T>::type U;
+    const int row = i / n;
+    const int j = i % n;
+    const int br = row / R;
+    const int r = row % R;
+    U acc = U(0);
+    for (int b = indptr[br]; b < indptr[br + 1]; b++) {
+        const ptrdiff_t blk = ((ptrdiff_t)b * R + r) * C;
+        const ptrdiff_t col = (ptrdiff_t)indices[b] * C;
+        for (int c = 0; c < C; c++) {
+            acc += U(data[blk + c]) * U(x[(col + c) * n + j]);
+        }
+    }
+    y = T(acc);
+    ''',
+    'cupyx_scipy_sparse_bsr_spmm',
+    preamble=_bsr_preamble)
+
+
+def _supported_dtype(dtype):
+    return dtype.char in '?efdFD' or (bfloat16 is not None
+                                      and dtype == bfloat16)
+
+
+def _count_blocks(row, col, R, C, n_block_cols):
+    keys = (row // R).astype('q') * n_block_cols + col // C
+    return int(cupy.unique(keys).size)
+
+
+def _estimate_blocksize(row, col, shape, efficiency=0.7):
+    # The heuristic of scipy.sparse, which keeps the blocks at least
+    # efficiency full.
+    nnz = row.size
+    if nnz == 0:
+        return 1, 1
+    M, N = shape
+    high_efficiency = (1.0 + efficiency) / 2.0
+
+    def block_efficiency(s):
+        if M % s or N % s:
+            return 0.0
+        return nnz / (s * s * _count_blocks(row, col, s, s, N // s))
+
+    e22 = block_efficiency(2)
+    e33 = block_efficiency(3)
+    if e22 > high_efficiency and e33 > high_efficiency:
+        return (6, 6) if block_efficiency(6) > efficiency else (3, 3)
+    e44 = block_efficiency(4)
+    if e44 > efficiency:
+        return 4, 4
+    elif e22 > efficiency:
+        return 2, 2
+    return 1, 1
+
+
+def _check_blocksize(shape, blocksize):
+    R, C = int(blocksize[0]), int(blocksize[1])
+    if R < 1 or C < 1:
+        raise ValueError('invalid blocksize %s' % (blocksize,))
+    M, N = shape
+    if M % R or N % C:
+        raise ValueError('shape must be multiple of blocksize')
+    return R, C
+
+
+def _from_coordinates(row, col, values, shape, blocksize):
+    # Returns the data, indices and indptr of the blocks of the items, which
+    # must not be repeated.
+    R, C = _check_blocksize(shape, blocksize)
+    n_block_rows = shape[0] // R
+    n_block_cols = shape[1] // C
+    keys = (row // R).astype('q') * n_block_cols + col // C
+    block_keys, inverse = cupy.unique(keys, return_inverse=True)
+    indices = (block_keys % n_block_cols).astype('i')
+    counts = cupy.bincount(block_keys // n_block_cols,
+                           minlength=n_block_rows)
+    indptr = cupy.empty(n_block_rows + 1, dtype='i')
+    indptr[:-1] = counts
+    _util._exclusive_cumsum(indptr)
+    data = cupy.zeros((block_keys.size, R, C), dtype=values.dtype)
+    data[inverse, row % R, col % C] = values
+    return data, indices, indptr
+
+
+def _csr_to_bsr(x, blocksize):
+    x = x.copy()
+    x.sum_duplicates()
+    coo = x.tocoo(copy=False)
+    if blocksize is None:
+        blocksize = _estimate_blocksize(coo.row, coo.col, x.shape)
+    return _from_coordinates(coo.row, coo.col, coo.data, x.shape, blocksize)
+
+
+def _dense_to_bsr(x, blocksize):
+    if blocksize is None:
+        row, col = cupy.nonzero(x != 0)
+        blocksize = _estimate_blocksize(row, col, x.shape)
+    R, C = _check_blocksize(x.shape, blocksize)
+    M, N = x.shape
+    blocks = x.reshape(M // R, R, N // C, C).transpose(0, 2, 1, 3)
+    mask = (blocks != 0).any(axis=(2, 3))
+    taken = cupy.flatnonzero(mask)
+    indices = (taken % (N // C)).astype('i')
+    indptr = cupy.empty(M // R + 1, dtype='i')
+    indptr[:-1] = mask.sum(axis=1)
+    _util._exclusive_cumsum(indptr)
+    data = blocks.reshape(-1, R, C)[taken]
+    return data, indices, indptr
+
+
+class bsr_matrix(_data._data_matrix):
+
+    """Block Sparse Row matrix.
+
+    This can be instantiated in several ways.
+
+    ``bsr_matrix(D, blocksize=(R, C))``
+        ``D`` is a rank-2 :class:`cupy.ndarray`.
+
+    ``bsr_matrix(S, blocksize=(R, C))``
+        ``S`` is another sparse matrix. It is equivalent to
+        ``S.tobsr(blocksize=(R, C))``.
+
+    ``bsr_matrix((M, N), [dtype, blocksize])``
+        It constructs an empty matrix whose shape is ``(M, N)``. Default dtype
+        is float64.
+
+    ``bsr_matrix((data, (row, col)), [shape, blocksize])``
+        The matrix of the COO items ``data`` at ``(row, col)``.
+
+    ``bsr_matrix((data, indices, indptr), [shape])``
+        The blocks of the block row ``i`` are ``data[indptr[i]:indptr[i +
+        1]]``, of shape ``(nnzb, R, C)``, and their block columns are
+        ``indices[indptr[i]:indptr[i + 1]]``.
+
+    The products with dense vectors and matrices use cuSPARSE for square
+    blocks of float32, float64, complex64 and complex128. For float16 and
+    bfloat16 blocks whose sides are multiples of 16, the products with dense
+    matrices use the tensor cores of the device.
+
+    Args:
+        arg1: Arguments for the initializer.
+        shape (tuple): Shape of a matrix. Its length must be two.
+        dtype: Data type. It must be an argument of :class:`numpy.dtype`.
+        copy (bool): If ``True``, copies of given arrays are always used.
+        blocksize (tuple): The shape ``(R, C)`` of the blocks. If ``None``,
+            it is estimated from the sparsity pattern as SciPy does.
+
+    .. seealso::
+       :class:`scipy.sparse.bsr_matrix`
+
+    """
+
+    format = 'bsr'
+
+    def __init__(self, arg1, shape=None, dtype=None, copy=False,
+                 blocksize=None):
+        from cupyx import cusparse
+
+        if shape is not None:
+            if not _util.isshape(shape):
+                raise ValueError('invalid shape (must be a 2-tuple of int)')
+            shape = int(shape[0]), int(shape[1])
+
+        if _base.issparse(arg1):
+            x = arg1.tobsr(blocksize=blocksize)
+            data, indices, indptr = x.data, x.indices, x.indptr
+            if x is not arg1:
+                copy = False
+            shape = x.shape
+
+        elif _util.isshape(arg1):
+            m, n = int(arg1[0]), int(arg1[1])
+            shape = (m, n)
+            R, C = _check_blocksize(shape, blocksize or (1, 1))
+            data = cupy.zeros((0, R, C), dtype if dtype else 'd')
+            indices = cupy.zeros(0, 'i')
+            indptr = cupy.zeros(m // R + 1, 'i')
+            copy = False
+
+        elif _scipy_available and scipy.sparse.issparse(arg1):
+            x = arg1.tobsr(blocksize=blocksize)
+            data = cupy.array(x.data)
+            indices = cupy.array(x.indices, dtype='i')
+            indptr = cupy.array(x.indptr, dtype='i')
+            shape = x.shape
+            copy = False
+
+        elif isinstance(arg1, tuple) and len(arg1) == 2:
+            x = _coo.coo_matrix(arg1, shape=shape, dtype=dtype, copy=copy)
+            data, indices, indptr = _csr_to_bsr(x.tocsr(), blocksize)
+            shape = x.shape
+            copy = False
+
+        elif isinstance(arg1, tuple) and len(arg1) == 3:
+            data, indices, indptr = arg1
+            data = cupy.asarray(data)
+            indices = cupy.asarray(indices)
+            indptr = cupy.asarray(indptr)
+            if data.ndim != 3 or indices.ndim != 1 or indptr.ndim != 1:
+                raise ValueError('data must be 3-D, and indices and indptr '
+                                 'must be 1-D')
+            if len(data) != len(indices):
+                raise ValueError('indices and data should have the same size')
+            if blocksize is not None and tuple(blocksize) != data.shape[1:]:
+                raise ValueError('mismatching blocksize={} vs {}'.format(
+                    tuple(blocksize), data.shape[1:]))
+            if shape is None:
+                R, C = data.shape[1:]
+                n_block_cols = int(indices.max()) + 1 if indices.size else 0
+                shape = (len(indptr) - 1) * R, n_block_cols * C
+
+        elif _base.isdense(arg1):
+            if arg1.ndim > 2:
+                raise TypeError('expected dimension <= 2 array or matrix')
+            arg1 = arg1.reshape((1,) * (2 - arg1.ndim) + arg1.shape)
+            data, indices, indptr = _dense_to_bsr(arg1, blocksize)
+            shape = arg1.shape
+            copy = False
+
+        else:
+            raise ValueError(
+                'unrecognized form for bsr_matrix constructor')
+
+        dtype = data.dtype if dtype is None else numpy.dtype(dtype)
+        if not _supported_dtype(dtype):
+            raise ValueError(
+                'Only bool, float16, bfloat16, float32, float64, complex64 '
+                'and complex128 are supported')
+
+        data = cupy.ascontiguousarray(data.astype(dtype, copy=copy))
+        _data._data_matrix.__init__(self, data)
+        self.indices = indices.astype('i', copy=copy)
+        self.indptr = indptr.astype('i', copy=copy)
+
+        R, C = _check_blocksize(shape, data.shape[1:])
+        if len(self.indptr) != shape[0] // R + 1:
+            raise ValueError('index pointer size (%d) should be (%d)'
+                             % (len(self.indptr), shape[0] // R + 1))
+        self._descr = cusparse.MatDescriptor.create()
+        self._shape = shape
+
+    def _with_data(self, data, copy=True):
+        if copy:
+            return bsr_matrix(
+                (data, self.indices.copy(), self.indptr.copy()),
+                shape=self.shape)
+        else:
+            return bsr_matrix(
+                (data, self.indices, self.indptr), shape=self.shape)
+
+    @property
+    def blocksize(self):
+        """The shape ``(R, C)`` of the blocks."""
+        return self.data.shape[1:]
+
+    def get(self, stream=None):
+        """Returns a copy of the array on host memory.
+
+        Args:
+            stream (cupy.cuda.Stream): CUDA stream object. If it is given, the
+                copy runs asynchronously. Otherwise, the copy is synchronous.
+
+        Returns:
+            scipy.sparse.bsr_matrix: Copy of the array on host memory.
+
+        """
+        if not _scipy_available:
+            raise RuntimeError('scipy is not available')
+        data = self.data.get(stream)
+        indices = self.indices.get(stream)
+        indptr = self.indptr.get(stream)
+        return scipy.sparse.bsr_matrix(
+            (data, indices, indptr), shape=self._shape)
+
+    def get_shape(self):
+        """Returns the shape of the matrix.
+
+        Returns:
+            tuple: Shape of the matrix.
+        """
+        return self._shape
+
+    def getnnz(self, axis=None):
+        """Returns the number of stored values, including explicit zeros.
+
+        Args:
+            axis: Not supported yet.
+
+        Returns:
+            int: The number of stored values.
+
+        """
+        if axis is not None:
+            raise NotImplementedError(
+                'getnnz over an axis is not implemented for BSR format')
+        return self.data.size
+
+    def _block_rows(self):
+        # the block row of each block
+        blocks = cupy.arange(self.indices.size, dtype='i')
+        return (cupy.searchsorted(self.indptr, blocks, side='right')
+                - 1).astype('i')
+
+    def __mul__(self, other):
+        if cupy.isscalar(other) or (_base.isdense(other)
+                                    and other.ndim == 0):
+            return self._with_data(self.data * other)
+        elif _base.isspmatrix(other):
+            return self.tocsr() * other
+        elif _base.isdense(other):
+            if other.ndim not in (1, 2):
+                raise ValueError('could not interpret dimensions')
+            if other.shape[0] != self.shape[1]:
+                raise ValueError('dimension mismatch')
+            return self._mul_dense(other)
+        else:
+            return NotImplemented
+
+    def _mul_dense(self, other):
+        from cupyx import cusparse
+
+        dtype = cupy.result_type(self.dtype, other.dtype)
+        a = self if self.dtype == dtype else self.astype(dtype)
+        x = other.astype(dtype, copy=False)
+        R, C = self.blocksize
+        if _bsr_mma.available(a, x):
+            return _bsr_mma.spmm(a, x)
+        if dtype.char in 'fdFD' and R == C > 1 and a.nnz > 0:
+            if x.ndim == 1 and cusparse.check_availability('bsrmv'):
+                return cusparse.bsrmv(a, cupy.ascontiguousarray(x))
+            if x.ndim == 2 and cusparse.check_availability('bsrmm'):
+                return cusparse.bsrmm(a, cupy.asfortranarray(x))
+        x = cupy.ascontiguousarray(x)
+        n = 1 if x.ndim == 1 else x.shape[1]
+        y = cupy.empty((self.shape[0],) + x.shape[1:], dtype=dtype)
+        _bsr_spmm_kernel(a.data, a.indptr, a.indices, x, R, C, n, y)
+        return y
+
+    def toarray(self, order=None, out=None):
+        """Returns a dense matrix representing the same value.
+
+        Args:
+            order ({'C', 'F', None}): Whether to store data in C (row-major)
+                order or F (column-major) order. Default is C-major.
+            out: Not supported.
+
+        Returns:
+            cupy.ndarray: Dense array representing the same value.
+
+        .. seealso:: :meth:`scipy.sparse.bsr_matrix.toarray`
+
+        """
+        if out is not None:
+            raise NotImplementedError('out is not supported')
+        order = 'C' if order is None else order.upper()
+        if order not in 'CF':
+            raise ValueError('order not understood')
+        _, N = self.shape
+        out = cupy.zeros(self.shape, dtype=self.dtype, order=order)
+        if self.data.size:
+            # the items are indexed in C order whatever the layout of out
+            R, C = self.blocksize
+            _bsr_toarray_kernel(self.data, self._block_rows(), self.indices,
+                                R, C, N, out)
+        return out
+
+    def tobsr(self, blocksize=None, copy=False):
+        """Converts the matrix to Block Sparse Row format.
+
+        Args:
+            blocksize (tuple): The shape of the blocks. If ``None`` or equal
+                to the one of the matrix, the matrix is kept as is.
+            copy (bool): If ``False``, it shares data arrays as much as
+                possible.
+
+        Returns:
+            cupyx.scipy.sparse.bsr_matrix: Converted matrix.
+
+        """
+        if blocksize is None or tuple(blocksize) == self.blocksize:
+            return self.copy() if copy else self
+        return self.tocsr().tobsr(blocksize=blocksize)
+
+    def tocsr(self, copy=False):
+        """Converts the matrix to Compressed Sparse Row format.
+
+        Args:
+            copy (bool): If ``False``, it shares data arrays as much as
+                possible. Actually this option is ignored because all
+                arrays in a matrix cannot be shared in bsr to csr conversion.
+
+        Returns:
+            cupyx.scipy.sparse.csr_matrix: Converted matrix.
+
+        """
+        M, _ = self.shape
+        R, C = self.blocksize
+        nnz = self.data.size
+        lengths = self.indptr[1:] - self.indptr[:-1]
+        rows = cupy.arange(M, dtype='i')
+        indptr = cupy.empty(M + 1, dtype='i')
+        indptr[:-1] = (self.indptr[rows // R] * R
+                       + rows % R * lengths[rows // R]) * C
+        indptr[-1] = nnz
+        data = cupy.empty(nnz, dtype=self.dtype)
+        indices = cupy.empty(nnz, dtype='i')
+        if nnz:
+            _bsr_tocsr_kernel(self.data, self._block_rows(), self.indptr,
+                              self.indices, R, C, data, indices)
+        return _csr.csr_matrix((data, indices, indptr), shape=self.shape)
+
+    def transpose(self, axes=None, copy=False):
+        """Returns a transpose matrix.
+
+        Args:
+            axes: This option is not supported.
+            copy (bool): Ignored, as the blocks are always transposed into
+                new arrays.
+
+        Returns:
+            cupyx.scipy.sparse.bsr_matrix: Transpose matrix, whose blocks
+            are of shape ``(C, R)``.
+
+        """
+        if axes is not None:
+            raise ValueError(
+                'Sparse matrices do not support an \'axes\' parameter because '
+                'swapping dimensions is the only logical permutation.')
+        R, C = self.blocksize
+        return self.tocsr().T.tobsr(blocksize=(C, R))
+
+
+def isspmatrix_bsr(x):
+    """Checks if a given matrix is of BSR format.
+
+    Returns:
+        bool: Returns if ``x`` is :class:`cupyx.scipy.sparse.bsr_matrix`.
+
+    """
+    return isinstance(x, bsr_matrix)
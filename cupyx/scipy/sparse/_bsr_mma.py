@@ -0,0 +1,139 @@
+"""Products of BSR matrices of 16-bit floats with tensor cores.
+
+Each warp computes a 16 x 16 tile of the product, for 16 rows of a block row
+of the matrix and 16 columns of the dense operand, with the warp matrix
+multiply-accumulate (WMMA) instructions. The blocks are loaded straight from
+the ``data`` of the matrix, as their sides are multiples of 16, and the
+products are accumulated in float32 before being rounded once. The dense
+operand is padded to a multiple of 16 columns when needed.
+
+float16 needs a device of compute capability 7.0, and bfloat16 one of 8.0.
+"""
+
+import numpy
+
+import cupy
+from cupy._core._dtype import bfloat16
+from cupy.cuda import device
+from cupy.cuda import runtime
+from cupy import _util
+
+
+_tile = 16
+_warps = 4
+# load_matrix_sync needs 256-bit aligned tiles
+_alignment = 32
+
+
+_mma_code = r'''
+#include <mma.h>
+#include <cuda_fp16.h>
+#ifdef CUPY_BSR_BF16
+#include <cuda_bf16.h>
+#endif
+using namespace nvcuda;
+
+#define WARPS 4
+
+// y (m x ldx) = alpha * A x, where A has R x C blocks and x is k x ldx.
+extern "C" __global__ void cupy_bsr_mma(
+        const IN* __restrict__ data, const int* __restrict__ indptr,
+        const int* __restrict__ indices, const IN* __restrict__ x,
+        IN* __restrict__ y, const int R, const int C, const int ldx,
+        const int n_tiles, const int col_tiles, const float alpha) {
+    __shared__ __align__(32) float stage[WARPS][16 * 16];
+    const int warp = threadIdx.x / 32;
+    const int lane = threadIdx.x % 32;
+    const int tile = blockIdx.x * WARPS + warp;
+    if (tile >= n_tiles) {
+        return;
+    }
+    const int tr = tile / col_tiles;
+    const int tc = tile % col_tiles;
+    const int br = tr / (R / 16);
+    const int rs = tr % (R / 16);
+
+    wmma::fragment<wmma::matrix_a, 16, 16, 16, IN, wmma::row_major> a;
+    wmma::fragment<wmma::matrix_b, 16, 16, 16, IN, wmma::row_major> b;
+    wmma::fragment<wmma::accumulator, 16, 16, 16, float> acc;
+    wmma::fill_fragment(acc, 0.0f);
+    for (int k = indptr[br]; k < indptr[br + 1]; k++) {
+        const IN* a_tile = data + ((long long)k * R + rs * 16) * C;
+        const IN* x_tile = x + (long long)indices[k] * C * ldx + tc * 16;
+        for (int c = 0; c < C; c += 16) {
+            wmma::load_matrix_sync(a, a_tile + c, C);
+            wmma::load_matrix_sync(b, x_tile + (long long)c * ldx, ldx);
+            wmma::mma_sync(acc, a, b, acc);
+        }
+    }
+    wmma::store_matrix_sync(stage[warp], acc, 16, wmma::mem_row_major);
+    __syncwarp();
+    IN* y_tile = y + ((long long)br * R + rs * 16) * ldx + tc * 16;
+    for (int e = lane; e < 16 * 16; e += 32) {
+        y_tile[(e / 16) * ldx + e % 16] = TO_IN(alpha * stage[warp][e]);
+    }
+}
+'''
+
+
+@_util.memoize(for_each_device=True)
+def _get_kernel(is_bfloat16):
+    if is_bfloat16:
+        code = ('#define CUPY_BSR_BF16\n#define IN __nv_bfloat16\n'
+                '#define TO_IN __float2bfloat16_rn\n')
+    else:
+        code = '#define IN __half\n#define TO_IN __float2half_rn\n'
+    return cupy.RawKernel(code + _mma_code, 'cupy_bsr_mma')
+
+
+def _is_bfloat16(dtype):
+    return bfloat16 is not None and dtype == bfloat16
+
+
+def available(a, x):
+    """Tells if ``a * x`` may be computed with tensor cores.
+
+    ``x`` must be a 2-D array of the dtype of the BSR matrix ``a``.
+    """
+    if runtime.is_hip or x.ndim != 2 or x.dtype != a.dtype:
+        return False
+    R, C = a.blocksize
+    if R % _tile or C % _tile:
+        return False
+    cc = int(device.get_compute_capability())
+    if a.dtype == numpy.float16:
+        return cc >= 70
+    if _is_bfloat16(a.dtype):
+        return cc >= 80
+    return False
+
+
+def spmm(a, x, alpha=1):
+    """Computes ``alpha * a * x`` with tensor cores.
+
+    The ``available`` conditions must hold.
+    """
+    m = a.shape[0]
+    k, n = x.shape
+    R, C = a.blocksize
+    ldx = -(-n // _tile) * _tile
+    if ldx != n or not x.flags.c_contiguous or x.data.ptr % _alignment:
+        xp = cupy.zeros((k, ldx), dtype=a.dtype)
+        xp[:, :n] = x
+        x = xp
+    data = a.data
+    if data.data.ptr % _alignment:
+        data = data.copy()
+    y = cupy.empty((m, ldx), dtype=a.dtype)
+    col_tiles = ldx // _tile
+    n_tiles = m // _tile * col_tiles
+    if n_tiles == 0:
+        return y[:, :n]
+    kernel = _get_kernel(_is_bfloat16(a.dtype))
+    kernel(((n_tiles + _warps - 1) // _warps,), (32 * _warps,),
+           (data, a.indptr, a.indices, x, y, numpy.int32(R), numpy.int32(C),
+            numpy.int32(ldx), numpy.int32(n_tiles), numpy.int32(col_tiles),
+            numpy.float32(alpha)))
+    if ldx != n:
+        y = cupy.ascontiguousarray(y[:, :n])
+    return y
@@ -578,11 +578,10 @@ class _compressed_sparse_matrix(sparse_data._data_matrix,
         indptr_diff[rows] += row_counts
 
         new_indptr = cupy.empty(self.indptr.shape, dtype=idx_dtype)
-        new_indptr[0] = idx_dtype(0)
-        new_indptr[1:] = indptr_diff
+        new_indptr[:-1] = indptr_diff
 
         # Build output arrays
-        cupy.cumsum(new_indptr, out=new_indptr)
+        _util._exclusive_cumsum(new_indptr)
         out_nnz = int(new_indptr[-1])
 
         new_indices = cupy.empty(out_nnz, dtype=idx_dtype)
@@ -591,8 +590,8 @@ class _compressed_sparse_matrix(sparse_data._data_matrix,
         # Build an indexed indptr that contains the offsets for each
         # row but only for in i, j, and x.
         new_indptr_lookup = cupy.zeros(new_indptr.size, dtype=idx_dtype)
-        new_indptr_lookup[1:][rows] = row_counts
-        cupy.cumsum(new_indptr_lookup, out=new_indptr_lookup)
+        new_indptr_lookup[:-1][rows] = row_counts
+        _util._exclusive_cumsum(new_indptr_lookup)
 
         _index._insert_many_populate_arrays(
             indices_inserts, data_inserts, new_indptr_lookup,
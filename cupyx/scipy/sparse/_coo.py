@@ -6,8 +6,8 @@ except ImportError:
     _scipy_available = False
 
 import cupy
-from cupy import _core
 from cupyx.scipy.sparse import _base
+from cupyx.scipy.sparse import _counting_sort
 from cupyx.scipy.sparse import _csc
 from cupyx.scipy.sparse import _csr
 from cupyx.scipy.sparse import _data as sparse_data
@@ -48,17 +48,6 @@ class coo_matrix(sparse_data._data_matrix):
 
     format = 'coo'
 
-    _sum_duplicates_diff = _core.ElementwiseKernel(
-        'raw T row, raw T col',
-        'T diff',
-        '''
-        T diff_out = 1;
-        if (i == 0 || row[i - 1] == row[i] && col[i - 1] == col[i]) {
-          diff_out = 0;
-        }
-        diff = diff_out;
-        ''', 'cupyx_scipy_sparse_coo_sum_duplicates_diff')
-
     def __init__(self, arg1, shape=None, dtype=None, copy=False):
         if shape is not None and len(shape) != 2:
             raise ValueError(
@@ -395,62 +384,8 @@ class coo_matrix(sparse_data._data_matrix):
         # the cuSPARSE functions such as cusparseSpMV() assume this sorting
         # order.
         # See https://docs.nvidia.com/cuda/cusparse/index.html#coo-format
-        keys = cupy.stack([self.col, self.row])
-        order = cupy.lexsort(keys)
-        src_data = self.data[order]
-        src_row = self.row[order]
-        src_col = self.col[order]
-        diff = self._sum_duplicates_diff(src_row, src_col, size=self.row.size)
-
-        if diff[1:].all():
-            # All elements have different indices.
-            data = src_data
-            row = src_row
-            col = src_col
-        else:
-            # TODO(leofang): move the kernels outside this method
-            index = cupy.cumsum(diff, dtype='i')
-            size = int(index[-1]) + 1
-            data = cupy.zeros(size, dtype=self.data.dtype)
-            row = cupy.empty(size, dtype='i')
-            col = cupy.empty(size, dtype='i')
-            if self.data.dtype.kind == 'b':
-                cupy.ElementwiseKernel(
-                    'T src_data, int32 src_row, int32 src_col, int32 index',
-                    'raw T data, raw int32 row, raw int32 col',
-                    '''
-                    if (src_data) data[index] = true;
-                    row[index] = src_row;
-                    col[index] = src_col;
-                    ''',
-                    'cupyx_scipy_sparse_coo_sum_duplicates_assign'
-                )(src_data, src_row, src_col, index, data, row, col)
-            elif self.data.dtype.kind == 'f':
-                cupy.ElementwiseKernel(
-                    'T src_data, int32 src_row, int32 src_col, int32 index',
-                    'raw T data, raw int32 row, raw int32 col',
-                    '''
-                    atomicAdd(&data[index], src_data);
-                    row[index] = src_row;
-                    col[index] = src_col;
-                    ''',
-                    'cupyx_scipy_sparse_coo_sum_duplicates_assign'
-                )(src_data, src_row, src_col, index, data, row, col)
-            elif self.data.dtype.kind == 'c':
-                cupy.ElementwiseKernel(
-                    'T src_real, T src_imag, int32 src_row, int32 src_col, '
-                    'int32 index',
-                    'raw T real, raw T imag, raw int32 row, raw int32 col',
-                    '''
-                    atomicAdd(&real[index], src_real);
-                    atomicAdd(&imag[index], src_imag);
-                    row[index] = src_row;
-                    col[index] = src_col;
-                    ''',
-                    'cupyx_scipy_sparse_coo_sum_duplicates_assign_complex'
-                )(src_data.real, src_data.imag, src_row, src_col, index,
-                  data.real, data.imag, row, col)
-
+        data, col, _, row = _counting_sort.coo_to_csr(
+            self.row, self.col, self.data, *self.shape)
         self.data = data
         self.row = row
         self.col = col
@@ -499,16 +434,14 @@ class coo_matrix(sparse_data._data_matrix):
             cupyx.scipy.sparse.csc_matrix: Converted matrix.
 
         """
-        from cupyx import cusparse
-
         if self.nnz == 0:
             return _csc.csc_matrix(self.shape, dtype=self.dtype)
-        # copy is silently ignored (in line with SciPy) because both
-        # sum_duplicates and coosort change the underlying data
-        x = self.copy()
-        x.sum_duplicates()
-        cusparse.coosort(x, 'c')
-        x = cusparse.coo2csc(x)
+        # copy is silently ignored (in line with SciPy) because the entries
+        # are always sorted into new arrays
+        m, n = self.shape
+        data, indices, indptr, _ = _counting_sort.coo_to_csr(
+            self.col, self.row, self.data, n, m)
+        x = _csc.csc_matrix((data, indices, indptr), shape=self.shape)
         x.has_canonical_format = True
         return x
 
@@ -524,16 +457,13 @@ class coo_matrix(sparse_data._data_matrix):
             cupyx.scipy.sparse.csr_matrix: Converted matrix.
 
         """
-        from cupyx import cusparse
-
         if self.nnz == 0:
             return _csr.csr_matrix(self.shape, dtype=self.dtype)
-        # copy is silently ignored (in line with SciPy) because both
-        # sum_duplicates and coosort change the underlying data
-        x = self.copy()
-        x.sum_duplicates()
-        cusparse.coosort(x, 'r')
-        x = cusparse.coo2csr(x)
+        # copy is silently ignored (in line with SciPy) because the entries
+        # are always sorted into new arrays
+        data, indices, indptr, _ = _counting_sort.coo_to_csr(
+            self.row, self.col, self.data, *self.shape)
+        x = _csr.csr_matrix((data, indices, indptr), shape=self.shape)
         x.has_canonical_format = True
         return x
 
@@ -0,0 +1,143 @@
+"""Conversion of COO entries to sorted CSR rows without a global sort.
+
+The entries are bucketed by row with a counting sort: the rows are
+counted with atomics, the counts are scanned into the ``indptr`` of the
+result, and each entry is scattered to a free slot of its row. The columns
+of each row are then sorted and their duplicates summed in a single pass by
+one thread per row. As an insertion sort is only cheap for short rows, the
+entries of the rows of more than ``_max_insertion_sort`` items are sorted
+together by a radix sort of their (row, column) keys instead.
+"""
+
+import cupy
+from cupy import _core
+from cupyx.scipy.sparse import _util
+
+
+# Longer rows are radix sorted, as the cost of an insertion sort grows with
+# the square of the length of a row and a warp waits for its longest row.
+_max_insertion_sort = 64
+
+
+_count_rows_kernel = _core.ElementwiseKernel(
+    'int32 row', 'raw int32 counts',
+    'atomicAdd(&counts[row], 1)',
+    'cupyx_scipy_sparse_count_rows')
+
+# The order of the entries within a row depends on the scheduling, and it
+# is restored by the sort of the columns.
+_scatter_rows_kernel = _core.ElementwiseKernel(
+    'int32 row, int32 col, T x, raw int32 indptr, raw int32 cursor',
+    'raw int32 dst_row, raw int32 dst_col, raw T dst_data',
+    '''
+    const int p = indptr[row] + atomicAdd(&cursor[row], 1);
+    dst_row[p] = row;
+    dst_col[p] = col;
+    dst_data[p] = x;
+    ''',
+    'cupyx_scipy_sparse_scatter_rows')
+
+# Sorts the columns of a short row and sums the values of equal columns
+# into the first items of the row.
+_sort_sum_rows_kernel = _core.ElementwiseKernel(
+    'raw int32 indptr, int32 max_sort',
+    'raw int32 col, raw T data, int32 row_nnz',
+    '''
+    const int begin = indptr[i];
+    const int end = indptr[i + 1];
+    if (end - begin <= max_sort) {
+        for (int j = begin + 1; j < end; j++) {
+            const int c = col[j];
+            const T x = data[j];
+            int k = j;
+            for (; k > begin && col[k - 1] > c; k--) {
+                col[k] = col[k - 1];
+                data[k] = data[k - 1];
+            }
+            col[k] = c;
+            data[k] = x;
+        }
+    }
+    int k = begin;
+    for (int j = begin; j < end; j++) {
+        if (k > begin && col[k - 1] == col[j]) {
+            data[k - 1] = data[k - 1] + data[j];
+        } else {
+            col[k] = col[j];
+            data[k] = data[j];
+            k++;
+        }
+    }
+    row_nnz = k - begin;
+    ''',
+    'cupyx_scipy_sparse_sort_sum_rows')
+
+_compact_rows_kernel = _core.ElementwiseKernel(
+    'int32 row, raw int32 indptr, raw int32 new_indptr, raw int32 row_nnz, '
+    'raw int32 src_col, raw T src_data',
+    'raw int32 dst_row, raw int32 dst_col, raw T dst_data',
+    '''
+    const int k = i - indptr[row];
+    if (k < row_nnz[row]) {
+        const int p = new_indptr[row] + k;
+        dst_row[p] = row;
+        dst_col[p] = src_col[i];
+        dst_data[p] = src_data[i];
+    }
+    ''',
+    'cupyx_scipy_sparse_compact_rows')
+
+
+def _indptr(counts):
+    indptr = cupy.empty(counts.size + 1, dtype='i')
+    indptr[:-1] = counts
+    return _util._exclusive_cumsum(indptr)
+
+
+def coo_to_csr(row, col, data, n_rows, n_cols):
+    """Sorts COO entries by row and column and sums their duplicates.
+
+    Args:
+        row (cupy.ndarray): The int32 row of each entry.
+        col (cupy.ndarray): The int32 column of each entry.
+        data (cupy.ndarray): The value of each entry.
+        n_rows (int): The number of rows.
+        n_cols (int): The number of columns.
+
+    Returns:
+        tuple: The ``data``, ``indices`` and ``indptr`` of the canonical CSR
+        matrix, and the row of each of its entries. This synchronizes the
+        device.
+    """
+    nnz = row.size
+    counts = cupy.zeros(n_rows, dtype='i')
+    _count_rows_kernel(row, counts)
+    indptr = _indptr(counts)
+    cursor = cupy.zeros(n_rows, dtype='i')
+    s_row = cupy.empty(nnz, dtype='i')
+    s_col = cupy.empty(nnz, dtype='i')
+    s_data = cupy.empty(nnz, dtype=data.dtype)
+    _scatter_rows_kernel(row, col, data, indptr, cursor, s_row, s_col, s_data)
+
+    long_items = cupy.flatnonzero(counts[s_row] > _max_insertion_sort)
+    if long_items.size:
+        # the items of the long rows stay in place as a whole, so that
+        # sorting them by (row, column) sorts each of these rows
+        keys = s_row[long_items].astype('q') * n_cols + s_col[long_items]
+        order = long_items[cupy.argsort(keys)]
+        s_col[long_items] = s_col[order]
+        s_data[long_items] = s_data[order]
+
+    new_counts = cupy.empty(n_rows, dtype='i')
+    _sort_sum_rows_kernel(indptr, _max_insertion_sort, s_col, s_data,
+                          new_counts)
+    new_indptr = _indptr(new_counts)
+    new_nnz = int(new_indptr[-1])
+    if new_nnz == nnz:
+        return s_data, s_col, indptr, s_row
+    d_row = cupy.empty(new_nnz, dtype='i')
+    d_col = cupy.empty(new_nnz, dtype='i')
+    d_data = cupy.empty(new_nnz, dtype=data.dtype)
+    _compact_rows_kernel(s_row, indptr, new_indptr, new_counts, s_col, s_data,
+                         d_row, d_col, d_data)
+    return d_data, d_col, new_indptr, d_row
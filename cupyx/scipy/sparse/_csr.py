@@ -188,17 +188,8 @@ class csr_matrix(_compressed._compressed_sparse_matrix):
             elif other.ndim == 1:
                 self.sum_duplicates()
                 other = cupy.asfortranarray(other)
-                # need extra padding to ensure not stepping on the CUB bug,
-                # see cupy/cupy#3679 for discussion
-                is_cub_safe = (self.indptr.data.mem.size
-                               > self.indptr.size * self.indptr.dtype.itemsize)
-                # CUB spmv is buggy since CUDA 11.0, see
-                # https://github.com/cupy/cupy/issues/3822#issuecomment-782607637
-                is_cub_safe &= (cub._get_cuda_build_version() < 11000)
                 for accelerator in _accelerator.get_routine_accelerators():
-                    if (accelerator == _accelerator.ACCELERATOR_CUB
-                            and not runtime.is_hip
-                            and is_cub_safe and other.flags.c_contiguous):
+                    if accelerator == _accelerator.ACCELERATOR_CUB:
                         return cub.device_csrmv(
                             self.shape[0], self.shape[1], self.nnz,
                             self.data, self.indptr, self.indices, other)
@@ -215,6 +206,11 @@ class csr_matrix(_compressed._compressed_sparse_matrix):
                 return csrmv(self, other)
             elif other.ndim == 2:
                 self.sum_duplicates()
+                for accelerator in _accelerator.get_routine_accelerators():
+                    if accelerator == _accelerator.ACCELERATOR_CUB:
+                        return cub.device_csrmm(
+                            self.shape[0], self.shape[1], self.data,
+                            self.indptr, self.indices, other)
                 if cusparse.check_availability('csrmm2'):
                     csrmm = cusparse.csrmm2
                 elif cusparse.check_availability('spmm'):
@@ -434,8 +430,24 @@ class csr_matrix(_compressed._compressed_sparse_matrix):
                 raise ValueError('order not understood')
 
     def tobsr(self, blocksize=None, copy=False):
-        # TODO(unno): Implement tobsr
-        raise NotImplementedError
+        """Converts the matrix to Block Sparse Row format.
+
+        Args:
+            blocksize (tuple): The shape ``(R, C)`` of the blocks. If
+                ``None``, it is estimated from the sparsity pattern as SciPy
+                does.
+            copy (bool): If ``False``, it shares data arrays as much as
+                possible. Actually this option is ignored because all
+                arrays in a matrix cannot be shared in csr to bsr conversion.
+
+        Returns:
+            cupyx.scipy.sparse.bsr_matrix: Converted matrix.
+
+        """
+        from cupyx.scipy.sparse import _bsr
+
+        data, indices, indptr = _bsr._csr_to_bsr(self, blocksize)
+        return _bsr.bsr_matrix((data, indices, indptr), shape=self.shape)
 
     def tocoo(self, copy=False):
         """Converts the matrix to COOrdinate format.
@@ -168,8 +168,8 @@ class dia_matrix(_data._data_matrix):
             'cupyx_scipy_sparse_dia_tocsc')(offset_len, self.offsets[:, None],
                                             num_rows, num_cols, self.data)
         indptr = cupy.zeros(num_cols + 1, dtype='i')
-        indptr[1: offset_len + 1] = cupy.cumsum(mask.sum(axis=0))
-        indptr[offset_len + 1:] = indptr[offset_len]
+        indptr[:offset_len] = mask.sum(axis=0)
+        _util._exclusive_cumsum(indptr)
         indices = row.T[mask.T].astype('i', copy=False)
         data = self.data.T[mask.T]
         return _csc.csc_matrix(
@@ -6,6 +6,7 @@ from cupy import _core
 
 from cupyx.scipy.sparse._base import isspmatrix
 from cupyx.scipy.sparse._base import spmatrix
+from cupyx.scipy.sparse import _util
 
 from cupy.cuda import device
 from cupy.cuda import runtime
@@ -83,9 +84,8 @@ def _get_csr_submatrix_minor_axis(Ax, Aj, Ap, start, stop):
     """
     mask = (start <= Aj) & (Aj < stop)
     mask_sum = cupy.empty(Aj.size + 1, dtype=Aj.dtype)
-    mask_sum[0] = 0
-    mask_sum[1:] = mask
-    cupy.cumsum(mask_sum, out=mask_sum)
+    mask_sum[:-1] = mask
+    _util._exclusive_cumsum(mask_sum)
     Bp = mask_sum[Ap]
     Bj = Aj[mask] - start
     Bx = Ax[mask]
@@ -124,8 +124,8 @@ def _csr_row_index(Ax, Aj, Ap, rows):
     """
     row_nnz = cupy.diff(Ap)
     Bp = cupy.empty(rows.size + 1, dtype=Ap.dtype)
-    Bp[0] = 0
-    cupy.cumsum(row_nnz[rows], out=Bp[1:])
+    Bp[:-1] = row_nnz[rows]
+    _util._exclusive_cumsum(Bp)
     nnz = int(Bp[-1])
 
     out_rows = _csr_indptr_to_coo_rows(nnz, Bp)
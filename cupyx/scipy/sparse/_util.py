@@ -1,5 +1,7 @@
 import cupy
+from cupy._core import _accelerator
 from cupy._core import core
+from cupy.cuda import cub
 
 
 def isdense(x):
@@ -24,3 +26,23 @@ def isshape(x):
     if isinstance(n, tuple):
         return False
     return isintlike(m) and isintlike(n)
+
+
+def _exclusive_cumsum(x):
+    """Replaces each item of a 1-D array by the sum of the items before it.
+
+    The last item becomes the sum of all the others, so a buffer of ``n + 1``
+    items holding ``n`` counts becomes their offsets (e.g. an ``indptr``)
+    in a single scan, without zero-filling its head. ``x`` must be
+    C-contiguous; it is returned.
+    """
+    if x.size == 0:
+        return x
+    if (_accelerator.ACCELERATOR_CUB in
+            _accelerator.get_routine_accelerators()
+            and cub.cub_scan(x, cub.CUPY_CUB_EXCLUSIVE_CUMSUM) is not None):
+        return x
+    sums = cupy.cumsum(x[:-1])
+    x[0] = 0
+    x[1:] = sums
+    return x
@@ -2,3 +2,7 @@
 # https://docs.scipy.org/doc/scipy/reference/sparse.csgraph.html
 
 from cupyx.scipy.sparse.csgraph._traversal import connected_components  # NOQA
+from cupyx.scipy.sparse.csgraph._traversal import breadth_first_order  # NOQA
+from cupyx.scipy.sparse.csgraph._shortest_path import dijkstra  # NOQA
+from cupyx.scipy.sparse.csgraph._shortest_path import shortest_path  # NOQA
+from cupyx.scipy.sparse.csgraph._pagerank import pagerank  # NOQA
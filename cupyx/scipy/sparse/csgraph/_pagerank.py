@@ -0,0 +1,123 @@
+import numpy
+
+import cupy
+from cupyx.scipy.sparse.csgraph import _traversal
+
+
+_spmv_code = r'''
+extern "C" __global__ void cupyx_csgraph_pull_spmv(
+        const int* indptr, const int* indices, const double* data,
+        const double* x, const int n, double* y) {
+    // y += A^T x for the in-edges of A, a group of threads for each vertex
+    __shared__ double partial[BLOCK_SIZE];
+    const int lane = threadIdx.x % GROUP_SIZE;
+    const int groups_per_block = BLOCK_SIZE / GROUP_SIZE;
+    for (int base = blockIdx.x * groups_per_block; base < n;
+            base += gridDim.x * groups_per_block) {
+        const int v = base + threadIdx.x / GROUP_SIZE;
+        double s = 0;
+        if (v < n) {
+            for (int j = indptr[v] + lane; j < indptr[v + 1];
+                    j += GROUP_SIZE) {
+                s += data[j] * x[indices[j]];
+            }
+        }
+        partial[threadIdx.x] = s;
+        __syncthreads();
+        for (int k = GROUP_SIZE / 2; k > 0; k /= 2) {
+            if (lane < k) partial[threadIdx.x] += partial[threadIdx.x + k];
+            __syncthreads();
+        }
+        if (lane == 0 && v < n) y[v] += partial[threadIdx.x];
+        __syncthreads();
+    }
+}
+'''
+
+
+@cupy.memoize(for_each_device=True)
+def _get_spmv_kernel():
+    code = '#define GROUP_SIZE {}\n#define BLOCK_SIZE {}\n'.format(
+        _traversal._group_size, _traversal._block_size)
+    return cupy.RawKernel(code + _spmv_code, 'cupyx_csgraph_pull_spmv')
+
+
+_row_sums = cupy.ElementwiseKernel(
+    'raw I indptr, raw float64 data', 'float64 s',
+    '''
+    for (I j = indptr[i]; j < indptr[i + 1]; j++) s += data[j];
+    ''',
+    'cupyx_csgraph_row_sums')
+
+
+def pagerank(csgraph, alpha=0.85, personalization=None, directed=True,
+             max_iter=100, tol=1e-6):
+    """Computes the PageRank of the vertices of a graph.
+
+    The ranks ``x`` are iterated as ``x = alpha * (A^T D^-1 x + d p) +
+    (1 - alpha) * p``, where ``D`` are the sums of the weights of the
+    out-edges, ``d`` is the rank of the vertices without out-edges and ``p``
+    is the personalization. The product with ``A^T`` is computed by a kernel
+    that reduces the in-edges of each vertex, so that it runs on ROCm and
+    does not need ``pylibcugraph``. This function is not in SciPy.
+
+    Args:
+        csgraph (cupy.ndarray of cupyx.scipy.sparse.csr_matrix): The adjacency
+            matrix of non-negative weights.
+        alpha (float): The damping factor.
+        personalization (cupy.ndarray): The probabilities of the teleports
+            to each vertex, which are normalized. Uniform if ``None``.
+        directed (bool): If ``False``, the edges are followed in both
+            directions.
+        max_iter (int): The maximum number of iterations.
+        tol (float): The iterations stop when the sum of the absolute
+            changes of the ranks is less than ``n * tol``.
+
+    Returns:
+        cupy.ndarray: The ranks of the vertices, which sum to 1.
+
+    .. seealso:: :func:`networkx.pagerank`
+    """
+    csgraph = _traversal._validate_graph(csgraph, numpy.float64)
+    n = csgraph.shape[0]
+    if not 0 <= alpha <= 1:
+        raise ValueError('alpha must be in [0, 1]')
+    if csgraph.nnz and float(csgraph.data.min()) < 0:
+        raise ValueError('graph has negative weights')
+    if n == 0:
+        return cupy.empty(0, dtype=numpy.float64)
+    if personalization is None:
+        p = cupy.full(n, 1 / n)
+    else:
+        p = cupy.asarray(personalization, dtype=numpy.float64)
+        if p.shape != (n,):
+            raise ValueError('personalization must be of shape ({},)'.format(
+                n))
+        total = float(p.sum())
+        if total <= 0 or bool((p < 0).any()):
+            raise ValueError('personalization must be non-negative and not '
+                             'all zero')
+        p = p / total
+    out_edges, in_edges = _traversal._get_edges(csgraph, directed)
+    out_weight = cupy.zeros(n)
+    for indptr, _, data in out_edges:
+        _row_sums(indptr, data, out_weight)
+    dangling = out_weight == 0
+    scale = cupy.where(dangling, 0, 1 / cupy.where(dangling, 1, out_weight))
+    spmv = _get_spmv_kernel()
+    n_blocks = _traversal._n_blocks(n * _traversal._group_size)
+    x = p.copy()
+    y = cupy.empty_like(x)
+    for _ in range(max_iter):
+        xs = x * scale
+        y.fill(0)
+        for indptr, indices, data in in_edges:
+            spmv((n_blocks,), (_traversal._block_size,),
+                 (indptr, indices, data, xs, numpy.int32(n), y))
+        y = alpha * (y + x[dangling].sum() * p) + (1 - alpha) * p
+        err = float(abs(y - x).sum())  # synchronize!
+        x, y = y, x
+        if err < n * tol:
+            return x
+    raise RuntimeError(
+        'pagerank did not converge in {} iterations'.format(max_iter))
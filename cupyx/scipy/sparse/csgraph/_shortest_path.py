@@ -0,0 +1,256 @@
+import math
+
+import numpy
+
+import cupy
+from cupyx.scipy.sparse.csgraph import _traversal
+
+
+_relax_code = r'''
+extern "C" __global__ void cupyx_csgraph_relax(
+        const int* indptr, const int* indices, const double* weights,
+        const int* frontier, const int n_frontier, unsigned long long* dist,
+        int* pending) {
+    // the bits of non-negative doubles are ordered as the doubles
+    const int lane = threadIdx.x % GROUP_SIZE;
+    const int n_groups = gridDim.x * blockDim.x / GROUP_SIZE;
+    for (int f = (blockIdx.x * blockDim.x + threadIdx.x) / GROUP_SIZE;
+            f < n_frontier; f += n_groups) {
+        const int u = frontier[f];
+        const double du = __longlong_as_double((long long)dist[u]);
+        for (int j = indptr[u] + lane; j < indptr[u + 1]; j += GROUP_SIZE) {
+            const int v = indices[j];
+            const unsigned long long d =
+                (unsigned long long)__double_as_longlong(du + weights[j]);
+            if (d < dist[v] && atomicMin(&dist[v], d) > d) {
+                pending[v] = 1;
+            }
+        }
+    }
+}
+'''
+
+
+@cupy.memoize(for_each_device=True)
+def _get_relax_kernel():
+    code = '#define GROUP_SIZE {}\n'.format(_traversal._group_size)
+    return cupy.RawKernel(code + _relax_code, 'cupyx_csgraph_relax')
+
+
+_predecessors = cupy.ElementwiseKernel(
+    'raw I indptr, raw I indices, raw float64 weights, raw float64 dist, '
+    'raw int32 resolved, bool zero',
+    'int32 pred, int32 next_resolved',
+    '''
+    double dv = dist[i];
+    if (!resolved[i] && !isinf(dv)) {
+        for (I j = indptr[i]; j < indptr[i + 1]; j++) {
+            I u = indices[j];
+            double w = weights[j];
+            double du = dist[u];
+            bool tight = zero ? (w == 0 && resolved[u] && du == dv)
+                              : (w > 0 && du < dv && du + w == dv);
+            if (tight && (pred < 0 || u < pred)) pred = u;
+        }
+        if (pred >= 0) next_resolved = 1;
+    }
+    ''',
+    'cupyx_csgraph_sssp_predecessors')
+
+
+def _delta_stepping(out_edges, n, sources, delta, limit):
+    """Finds the distances from the nearest source with delta-stepping.
+
+    The vertices are processed in buckets of distances of width ``delta``.
+    The edges of the vertices of the current bucket are relaxed in parallel
+    until no distance in the bucket decreases, after which the next
+    non-empty bucket is processed.
+    """
+    relax = _get_relax_kernel()
+    dist = cupy.full(n, numpy.inf)
+    dist[sources] = 0
+    pending = cupy.zeros(n, dtype=numpy.int32)
+    frontier = cupy.unique(cupy.asarray(sources, dtype=numpy.int32))
+    bound = delta
+    while True:
+        while frontier.size:
+            for indptr, indices, weights in out_edges:
+                relax((_traversal._n_blocks(
+                          frontier.size * _traversal._group_size),),
+                      (_traversal._block_size,),
+                      (indptr, indices, weights, frontier,
+                       numpy.int32(frontier.size), dist, pending))
+            frontier = cupy.nonzero(pending.astype(bool) & (dist < bound))[0]
+            frontier = frontier.astype(numpy.int32)
+            pending[frontier] = 0
+        rest = cupy.nonzero(pending)[0]
+        if rest.size == 0:
+            break
+        nearest = float(dist[rest].min())  # synchronize!
+        if nearest > limit:
+            break
+        bound = (math.floor(nearest / delta) + 1) * delta
+        frontier = rest[dist[rest] < bound].astype(numpy.int32)
+        pending[frontier] = 0
+    if limit < numpy.inf:
+        dist[dist > limit] = numpy.inf
+    return dist
+
+
+def _get_predecessors(in_edges, dist, sources):
+    # The predecessor of a vertex is its in-neighbor of smallest index with
+    # a path as short. An in-neighbor through an edge of weight zero is only
+    # taken once its own predecessor is known, so that they form a tree.
+    n = dist.size
+    pred = cupy.full(n, -9999, dtype=numpy.int32)
+    resolved = cupy.zeros(n, dtype=numpy.int32)
+    resolved[sources] = 1
+    zero = False
+    while True:
+        next_resolved = resolved.copy()
+        for indptr, indices, weights in in_edges:
+            _predecessors(indptr, indices, weights, dist, resolved, zero,
+                          pred, next_resolved)
+        if zero and (next_resolved == resolved).all():  # synchronize!
+            return pred
+        resolved = next_resolved
+        zero = True
+
+
+def _get_sources(pred, sources):
+    # the roots of the trees of the predecessors, by pointer jumping
+    n = pred.size
+    root = cupy.where(pred >= 0, pred, cupy.arange(n, dtype=numpy.int32))
+    while True:
+        next_root = root[root]
+        if (next_root == root).all():  # synchronize!
+            break
+        root = next_root
+    reached = cupy.zeros(n, dtype=bool)
+    reached[sources] = True
+    return cupy.where(reached[root], root, -9999).astype(numpy.int32)
+
+
+def dijkstra(csgraph, directed=True, indices=None, return_predecessors=False,
+             unweighted=False, limit=numpy.inf, min_only=False):
+    """Finds the shortest paths in a graph of non-negative weights.
+
+    The distances are found with delta-stepping, a parallel relaxation of
+    the edges of the vertices in buckets of increasing distances, instead
+    of the sequential priority queue of Dijkstra's algorithm. For
+    ``unweighted=True``, a breadth-first traversal is used.
+
+    Args:
+        csgraph (cupy.ndarray of cupyx.scipy.sparse.csr_matrix): The adjacency
+            matrix of non-negative weights. Explicit zeros of a sparse matrix
+            are edges of weight zero.
+        directed (bool): If ``False``, the edges are followed in both
+            directions.
+        indices (int or array_like of ints): The sources. All vertices are
+            sources if ``None``.
+        return_predecessors (bool): If ``True``, the predecessors are also
+            returned.
+        unweighted (bool): If ``True``, the number of edges is minimized.
+        limit (float): The distances larger than ``limit`` are not computed
+            and are ``inf``.
+        min_only (bool): If ``True``, the distances from the nearest source
+            are computed.
+
+    Returns:
+        cupy.ndarray or tuple of cupy.ndarray:
+            The ``dist_matrix`` of shape ``(len(indices), n)``, or of shape
+            ``(n,)`` if ``indices`` is an integer or ``min_only`` is true,
+            followed by the ``predecessors`` of the same shape if
+            ``return_predecessors`` is ``True`` and by the ``sources`` of the
+            paths if ``min_only`` is also ``True``. Missing predecessors and
+            sources are ``-9999``.
+
+    .. note::
+        The predecessor of a vertex is its neighbor of smallest index on a
+        shortest path, which may be another one than the one of SciPy.
+
+    .. seealso:: :func:`scipy.sparse.csgraph.dijkstra`
+    """
+    csgraph = _traversal._validate_graph(csgraph, numpy.float64)
+    n = csgraph.shape[0]
+    if limit < 0:
+        raise ValueError('limit must be >= 0')
+    if indices is None:
+        indices = cupy.arange(n, dtype=numpy.int32)
+    indices = numpy.asarray(cupy.asnumpy(indices))
+    scalar = indices.ndim == 0 and not min_only
+    indices = indices.ravel().astype(numpy.int64)
+    if ((indices < 0) | (indices >= n)).any():
+        raise ValueError('indices must be in [0, {})'.format(n))
+    if unweighted:
+        csgraph = csgraph.copy()
+        csgraph.data.fill(1)
+    elif csgraph.nnz and float(csgraph.data.min()) < 0:
+        raise ValueError('graph has negative weights')
+    out_edges, in_edges = _traversal._get_edges(csgraph, directed)
+    # a bucket of the mean weight of an edge
+    delta = float(csgraph.data.mean()) if csgraph.nnz else 1.0
+    delta = delta if delta > 0 else 1.0
+
+    def search(sources):
+        if unweighted:
+            level = _traversal._bfs_levels(out_edges, in_edges, n, sources)
+            dist = cupy.where(level >= 0, level.astype(numpy.float64),
+                              numpy.inf)
+            if limit < numpy.inf:
+                dist[dist > limit] = numpy.inf
+        else:
+            dist = _delta_stepping(out_edges, n, sources, delta, limit)
+        if not return_predecessors:
+            return dist, None
+        return dist, _get_predecessors(in_edges, dist, sources)
+
+    if min_only:
+        dist, pred = search(indices.tolist())
+        if not return_predecessors:
+            return dist
+        return dist, pred, _get_sources(pred, indices.tolist())
+    results = [search([i]) for i in indices.tolist()]
+    dist = cupy.stack([d for d, _ in results])
+    if scalar:
+        dist = dist[0]
+    if not return_predecessors:
+        return dist
+    pred = cupy.stack([p for _, p in results])
+    if scalar:
+        pred = pred[0]
+    return dist, pred
+
+
+def shortest_path(csgraph, method='auto', directed=True,
+                  return_predecessors=False, unweighted=False,
+                  overwrite=False, indices=None):
+    """Finds the shortest paths in a graph of non-negative weights.
+
+    Args:
+        csgraph (cupy.ndarray of cupyx.scipy.sparse.csr_matrix): The adjacency
+            matrix of non-negative weights.
+        method (str): ``'auto'`` or ``'D'``. The paths are found by
+            :func:`dijkstra` in both cases.
+        directed (bool): If ``False``, the edges are followed in both
+            directions.
+        return_predecessors (bool): If ``True``, the predecessors are also
+            returned.
+        unweighted (bool): If ``True``, the number of edges is minimized.
+        overwrite (bool): Ignored.
+        indices (int or array_like of ints): The sources. All vertices are
+            sources if ``None``.
+
+    Returns:
+        cupy.ndarray or tuple of cupy.ndarray:
+            The ``dist_matrix`` and, if ``return_predecessors`` is ``True``,
+            the ``predecessors``, as returned by :func:`dijkstra`.
+
+    .. seealso:: :func:`scipy.sparse.csgraph.shortest_path`
+    """
+    if method not in ('auto', 'D'):
+        raise NotImplementedError(
+            'method {!r} is not supported'.format(method))
+    return dijkstra(csgraph, directed=directed, indices=indices,
+                    return_predecessors=return_predecessors,
+                    unweighted=unweighted)
@@ -1,3 +1,5 @@
+import numpy
+
 import cupy
 import cupyx.scipy.sparse
 try:
@@ -117,3 +119,211 @@ _cupy_adjust_labels = cupy.ElementwiseKernel(
     labels = j;
     ''',
     '_cupy_adjust_labels')
+
+
+def _validate_graph(csgraph, dtype=None):
+    if csgraph.ndim != 2:
+        raise ValueError('graph should have two dimensions')
+    if not cupyx.scipy.sparse.isspmatrix_csr(csgraph):
+        csgraph = cupyx.scipy.sparse.csr_matrix(csgraph)
+    m, m1 = csgraph.shape
+    if m != m1:
+        raise ValueError('graph should be a square array')
+    if dtype is not None and csgraph.dtype != dtype:
+        csgraph = csgraph.astype(dtype)
+    return csgraph
+
+
+def _get_edges(csgraph, directed):
+    # The (indptr, indices, data) buffers of the out-edges and of the
+    # in-edges of the vertices. An undirected graph has the edges in both
+    # directions.
+    csc = csgraph.tocsc()
+    out_edges = (csgraph.indptr, csgraph.indices, csgraph.data)
+    in_edges = (csc.indptr, csc.indices, csc.data)
+    if directed:
+        return [out_edges], [in_edges]
+    return [out_edges, in_edges], [in_edges, out_edges]
+
+
+# A group of 32 threads (independent of the warp size, so that the kernels
+# also run on ROCm) visits the edges of a vertex of the frontier, so that
+# vertices of high degree do not serialize a thread.
+_group_size = 32
+_block_size = 256
+
+_bfs_code = r"""
+extern "C" __global__ void cupyx_csgraph_bfs_push(
+        const int* indptr, const int* indices, const int* frontier,
+        const int n_frontier, const int depth, int* level, int* next,
+        int* n_next) {
+    const int lane = threadIdx.x % GROUP_SIZE;
+    const int n_groups = gridDim.x * blockDim.x / GROUP_SIZE;
+    for (int f = (blockIdx.x * blockDim.x + threadIdx.x) / GROUP_SIZE;
+            f < n_frontier; f += n_groups) {
+        const int u = frontier[f];
+        for (int j = indptr[u] + lane; j < indptr[u + 1]; j += GROUP_SIZE) {
+            const int v = indices[j];
+            if (level[v] == -1 && atomicCAS(&level[v], -1, depth + 1) == -1) {
+                next[atomicAdd(n_next, 1)] = v;
+            }
+        }
+    }
+}
+
+extern "C" __global__ void cupyx_csgraph_bfs_pull(
+        const int* indptr, const int* indices, const int n, const int depth,
+        int* level, int* n_next) {
+    for (int v = blockIdx.x * blockDim.x + threadIdx.x; v < n;
+            v += gridDim.x * blockDim.x) {
+        if (level[v] != -1) continue;
+        for (int j = indptr[v]; j < indptr[v + 1]; j++) {
+            if (level[indices[j]] == depth) {
+                level[v] = depth + 1;
+                atomicAdd(n_next, 1);
+                break;
+            }
+        }
+    }
+}
+"""
+
+
+@cupy.memoize(for_each_device=True)
+def _get_bfs_module():
+    return cupy.RawModule(
+        code='#define GROUP_SIZE {}\n'.format(_group_size) + _bfs_code)
+
+
+def _n_blocks(n_threads):
+    return min(-(-n_threads // _block_size), 65535)
+
+
+_bfs_predecessors = cupy.ElementwiseKernel(
+    'raw I indptr, raw I indices, raw int32 level',
+    'int32 pred',
+    """
+    int d = level[i];
+    if (d > 0) {
+        for (I j = indptr[i]; j < indptr[i + 1]; j++) {
+            I u = indices[j];
+            if (level[u] == d - 1 && (pred < 0 || u < pred)) pred = u;
+        }
+    }
+    """,
+    'cupyx_csgraph_bfs_predecessors')
+
+# the switches between pushing from the frontier and pulling to the
+# unvisited vertices of Beamer et al.
+_bfs_alpha = 14
+_bfs_beta = 24
+
+
+def _bfs_levels(out_edges, in_edges, n, sources):
+    """Finds the number of edges from the nearest source to each vertex.
+
+    A level is pushed from the frontier to its neighbors while the edges of
+    the frontier are few compared to the edges of the unvisited vertices,
+    and pulled by the unvisited vertices from their in-edges otherwise,
+    which visits an edge of a large frontier at most once.
+    """
+    module = _get_bfs_module()
+    push = module.get_function('cupyx_csgraph_bfs_push')
+    pull = module.get_function('cupyx_csgraph_bfs_pull')
+    degree = sum(indptr[1:] - indptr[:-1] for indptr, _, _ in out_edges)
+    level = cupy.full(n, -1, dtype=numpy.int32)
+    level[sources] = 0
+    # the queues of the frontier and of the next frontier
+    queues = [cupy.empty(n, dtype=numpy.int32) for _ in range(2)]
+    sources = cupy.unique(cupy.asarray(sources, dtype=numpy.int32))
+    n_frontier = sources.size
+    frontier = queues[0][:n_frontier]
+    frontier[...] = sources
+    n_next = cupy.zeros((), dtype=numpy.int32)
+    frontier_edges = int(degree[frontier].sum())
+    unexplored_edges = sum(int(indptr[-1]) for indptr, _, _ in out_edges)
+    pulling = False
+    depth = 0
+    while n_frontier:
+        if pulling and n_frontier < n / _bfs_beta:
+            pulling = False
+            frontier = queues[0][:n_frontier]
+            frontier[...] = cupy.nonzero(level == depth)[0]
+        elif not pulling and frontier_edges > unexplored_edges / _bfs_alpha:
+            pulling = True
+        unexplored_edges -= frontier_edges
+        n_next.fill(0)
+        if pulling:
+            for indptr, indices, _ in in_edges:
+                pull((_n_blocks(n),), (_block_size,),
+                     (indptr, indices, numpy.int32(n), numpy.int32(depth),
+                      level, n_next))
+        else:
+            for indptr, indices, _ in out_edges:
+                push((_n_blocks(n_frontier * _group_size),), (_block_size,),
+                     (indptr, indices, frontier, numpy.int32(n_frontier),
+                      numpy.int32(depth), level, queues[1], n_next))
+        n_frontier = int(n_next)  # synchronize!
+        depth += 1
+        if pulling:
+            frontier_edges = int(
+                cupy.where(level == depth, degree, 0).sum())
+        else:
+            queues.reverse()
+            frontier = queues[0][:n_frontier]
+            frontier_edges = int(degree[frontier].sum())
+    return level
+
+
+def breadth_first_order(csgraph, i_start, directed=True,
+                        return_predecessors=True):
+    """Returns the vertices of a graph in a breadth-first order.
+
+    The traversal is direction optimizing: a level is pushed from the
+    frontier along its out-edges while the frontier is small, and pulled by
+    the unvisited vertices along their in-edges when it is large. Unlike
+    :func:`connected_components`, it does not need ``pylibcugraph``.
+
+    Args:
+        csgraph (cupy.ndarray of cupyx.scipy.sparse.csr_matrix): The adjacency
+            matrix of the graph.
+        i_start (int): The vertex to start from.
+        directed (bool): If ``False``, the edges are followed in both
+            directions.
+        return_predecessors (bool): If ``True``, the predecessors are also
+            returned.
+
+    Returns:
+        cupy.ndarray or tuple of cupy.ndarray:
+            The reached vertices ``node_array`` and, if
+            ``return_predecessors`` is ``True``, the ``predecessors`` of the
+            vertices in the tree of the traversal, ``-9999`` for ``i_start``
+            and the vertices that are not reached.
+
+    .. note::
+        The vertices of a level are in ascending order and the predecessor
+        of a vertex is its neighbor of smallest index in the previous level,
+        so that the results do not depend on the scheduling of the threads.
+        They may be a different breadth-first order than the one of SciPy.
+
+    .. seealso:: :func:`scipy.sparse.csgraph.breadth_first_order`
+    """
+    csgraph = _validate_graph(csgraph)
+    if csgraph.dtype.char not in 'fdFD':
+        # for the transpose
+        csgraph = csgraph.astype(numpy.float32)
+    n = csgraph.shape[0]
+    i_start = int(i_start)
+    if not 0 <= i_start < n:
+        raise ValueError('i_start must be in [0, {})'.format(n))
+    out_edges, in_edges = _get_edges(csgraph, directed)
+    level = _bfs_levels(out_edges, in_edges, n, [i_start])
+    reached = cupy.nonzero(level >= 0)[0]
+    keys = level[reached].astype(numpy.int64) * n + reached
+    node_array = reached[cupy.argsort(keys)].astype(numpy.int32)
+    if not return_predecessors:
+        return node_array
+    predecessors = cupy.full(n, -9999, dtype=numpy.int32)
+    for indptr, indices, _ in in_edges:
+        _bfs_predecessors(indptr, indices, level, predecessors)
+    return node_array, predecessors
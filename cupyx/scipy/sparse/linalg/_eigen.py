@@ -9,6 +9,11 @@ from cupyx.scipy.sparse import _csr
 from cupyx.scipy.sparse.linalg import _interface
 
 
+# eigsh uses the block Lanczos method for k of at least this many vectors,
+# with blocks of this many vectors.
+_block_size = 16
+
+
 def eigsh(a, k=6, *, which='LM', v0=None, ncv=None, maxiter=None,
           tol=0, return_eigenvectors=True):
     """
@@ -51,7 +56,10 @@ def eigsh(a, k=6, *, which='LM', v0=None, ncv=None, maxiter=None,
 
     .. note::
         This function uses the thick-restart Lanczos methods
-        (https://sdm.lbl.gov/~kewu/ps/trlan.html).
+        (https://sdm.lbl.gov/~kewu/ps/trlan.html). For 16 or more
+        eigenvalues and no ``v0``, it uses a thick-restart block Lanczos
+        method instead, which multiplies ``a`` with blocks of 16 vectors
+        and solves the Rayleigh-Ritz problems on the device.
 
     """
     n = a.shape[0]
@@ -75,6 +83,12 @@ def eigsh(a, k=6, *, which='LM', v0=None, ncv=None, maxiter=None,
     if tol == 0:
         tol = numpy.finfo(a.dtype).eps
 
+    if v0 is None and k >= _block_size:
+        m = k + -(-(ncv - k) // _block_size) * _block_size
+        if max(m, -(-ncv // _block_size) * _block_size) + _block_size <= n:
+            return _eigsh_block(a, k, which, ncv, maxiter, tol,
+                                return_eigenvectors)
+
     alpha = cupy.zeros((ncv,), dtype=a.dtype)
     beta = cupy.zeros((ncv,), dtype=a.dtype.char.lower())
     V = cupy.empty((ncv, n), dtype=a.dtype)
@@ -143,6 +157,76 @@ def eigsh(a, k=6, *, which='LM', v0=None, ncv=None, maxiter=None,
         return cupy.sort(w)
 
 
+def _eigsh_block(a, k, which, ncv, maxiter, tol, return_eigenvectors):
+    # The basis Q is made of blocks of b vectors, each orthonormalized
+    # against the previous ones, and AQ = a @ Q. As a @ Q[:, :m] is
+    # Q[:, :m+b] times a block Hessenberg matrix, the residuals of the Ritz
+    # vectors of Q[:, :m] are in the span of the last block. The restarts
+    # keep the k Ritz vectors wanted in place of the basis.
+    n = a.shape[0]
+    b = _block_size
+    m = k + -(-(ncv - k) // b) * b
+    stop = -(-ncv // b) * b
+    Q = cupy.empty((n, max(m, stop) + b), dtype=a.dtype, order='F')
+    AQ = cupy.empty((n, max(m, stop)), dtype=a.dtype, order='F')
+    u = cupy.random.random((n, b)).astype(a.dtype)
+    Q[:, :b] = cupy.linalg.qr(u)[0]
+
+    start = 0
+    iters = 0
+    while True:
+        r = _block_lanczos(a, Q, AQ, start, stop, b)
+        iters += stop - start
+
+        # Rayleigh-Ritz
+        t = Q[:, :stop].conj().T @ AQ[:, :stop]
+        w, s = cupy.linalg.eigh((t + t.conj().T) / 2)
+        if which == 'LA':
+            idx = slice(-k, None)
+        elif which == 'LM':
+            idx = cupy.argsort(cupy.absolute(w))[-k:]
+        elif which == 'SA':
+            idx = slice(None, k)
+        w, s = w[idx], s[:, idx]
+
+        # Compute residual
+        res = cupy.linalg.norm(r @ s[stop-b:stop], axis=0)
+        if not (float(res.max()) > tol and iters < maxiter):
+            break
+
+        # Setup for thick-restart
+        q = Q[:, stop:stop+b].copy()
+        x = Q[:, :stop] @ s
+        ax = AQ[:, :stop] @ s
+        Q[:, :k] = x
+        Q[:, k:k+b] = q
+        AQ[:, :k] = ax
+        start, stop = k, m
+
+    x = Q[:, :stop] @ s
+    if return_eigenvectors:
+        idx = cupy.argsort(w)
+        return w[idx], x[:, idx]
+    else:
+        return cupy.sort(w)
+
+
+def _block_lanczos(A, Q, AQ, i_start, i_end, b):
+    # Extends the basis from the block at i_start to the one at i_end, and
+    # returns the R factor of the last block.
+    for i in range(i_start, i_end, b):
+        u = A @ Q[:, i:i+b]
+        AQ[:, i:i+b] = u
+
+        # Orthogonalize twice, which is as stable as the modified
+        # Gram-Schmidt
+        V = Q[:, :i+b]
+        for _ in range(2):
+            u -= V @ (V.conj().T @ u)
+        Q[:, i+b:i+2*b], r = cupy.linalg.qr(u)
+    return r
+
+
 def _lanczos_asis(a, V, u, alpha, beta, i_start, i_end):
     for i in range(i_start, i_end):
         u[...] = a @ V[i]
@@ -207,17 +291,19 @@ def _lanczos_fast(A, n, ncv):
 
         # Get ready for spmv if enabled
         if cusparse_handle is not None:
-            # Note: I would like to reuse descriptors and working buffer
-            # on the next update, but I gave it up because it sometimes
-            # caused illegal memory access error.
-            spmv_desc_A = cusparse.SpMatDescriptor.create(A)
-            spmv_desc_v = cusparse.DnVecDescriptor.create(v)
-            spmv_desc_u = cusparse.DnVecDescriptor.create(u)
-            buff_size = _cusparse.spMV_bufferSize(
-                cusparse_handle, spmv_op_a, spmv_alpha.ctypes.data,
-                spmv_desc_A.desc, spmv_desc_v.desc, spmv_beta.ctypes.data,
-                spmv_desc_u.desc, spmv_cuda_dtype, spmv_alg)
-            spmv_buff = cupy.empty(buff_size, cupy.int8)
+            # The descriptors are those of the arrays of this update; the
+            # cache recreates the one of A if its arrays have changed.
+            spmv_cache = cusparse._get_descriptor_cache(A)
+            spmv_desc_A = spmv_cache.desc
+            spmv_desc_v = spmv_cache.dense('x', v)
+            spmv_desc_u = spmv_cache.dense('y', u)
+            spmv_buff = spmv_cache.buffer(
+                ('spmv', spmv_op_a, spmv_alg),
+                lambda: _cusparse.spMV_bufferSize(
+                    cusparse_handle, spmv_op_a, spmv_alpha.ctypes.data,
+                    spmv_desc_A.desc, spmv_desc_v.desc,
+                    spmv_beta.ctypes.data, spmv_desc_u.desc,
+                    spmv_cuda_dtype, spmv_alg))
 
         v[...] = V[i_start]
         for i in range(i_start, i_end):
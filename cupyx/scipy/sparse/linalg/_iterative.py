@@ -2,13 +2,23 @@ import numpy
 
 import cupy
 from cupy import cublas
+from cupy import _util
 from cupy._core import _dtype
+from cupy._core._scalar import get_typename
 from cupy.cuda import device
 from cupy_backends.cuda.libs import cublas as _cublas
+from cupyx import _graph
 from cupyx.scipy.sparse import _csr
 from cupyx.scipy.sparse.linalg import _interface
 
 
+# The convergence of cg is read on the host every this many iterations. The
+# iterations run after the convergence leave x unchanged.
+_cg_check_every = 10
+_cg_block_size = 256
+_cg_max_blocks = 256
+
+
 def cg(A, b, x0=None, *, rtol=1e-5, atol=0.0, maxiter=None, M=None,
        callback=None):
     """Uses Conjugate Gradient iteration to solve ``Ax = b``.
@@ -39,11 +49,20 @@ def cg(A, b, x0=None, *, rtol=1e-5, atol=0.0, maxiter=None, M=None,
             the converged solution and ``info`` provides convergence
             information.
 
+    .. note::
+        The iterations are those of the pipelined CG of Chronopoulos and
+        Gear, whose inner products are all computed in one pass, and the
+        step lengths stay on the device. Without ``callback``, the
+        convergence is only read every few iterations, and the iterations
+        of a CSR ``A`` (and ``M``) are replayed as a CUDA graph.
+
     .. seealso:: :func:`scipy.sparse.linalg.cg`
     """
+    capturable = _is_capturable(A) and (M is None or _is_capturable(M))
+    no_precond = M is None
     A, M, x, b = _make_system(A, M, x0, b)
     matvec = A.matvec
-    psolve = M.matvec
+    psolve = None if no_precond else M.matvec
 
     n = A.shape[0]
     if maxiter is None:
@@ -55,33 +74,47 @@ def cg(A, b, x0=None, *, rtol=1e-5, atol=0.0, maxiter=None, M=None,
         return b, 0
     atol = max(float(atol), rtol * float(b_norm))
 
+    # state holds whether the iterations stopped, their number and whether
+    # they converged; scalars holds alpha, beta, and the previous gamma and
+    # alpha.
     r = b - matvec(x)
+    p = cupy.zeros_like(x)
+    s = cupy.zeros_like(x)
+    scalars = cupy.zeros(4, dtype=x.dtype)
+    state = cupy.zeros(3, dtype=numpy.int32)
+    real_dtype = numpy.dtype(x.dtype.char.lower())
+    n_blocks = min(-(-n // _cg_block_size), _cg_max_blocks)
+    partial = cupy.empty((5, n_blocks), dtype=real_dtype)
+    count = cupy.zeros(1, dtype=numpy.uint32)
+    dots = _get_cg_dots_kernel(x.dtype)
+    dots_args = (numpy.int64(n), partial, count, scalars, state,
+                 real_dtype.type(atol * atol),
+                 numpy.int32(min(maxiter, 0x7fffffff)))
+
+    def step():
+        u = r if psolve is None else psolve(r)
+        w = matvec(u)
+        dots((n_blocks,), (_cg_block_size,), (r, u, w) + dots_args)
+        _cg_update_kernel(u, w, scalars, p, s, x, r)
+
+    # The first iteration runs as is, so that the products set up their
+    # buffers out of the capture.
+    run = step
+    replay = _graph.graph_function(step) if capturable else step
+    check = 1 if callback is not None else _cg_check_every
     iters = 0
-    rho = 0
-    while iters < maxiter:
-        z = psolve(r)
-        rho1 = rho
-        rho = cublas.dotc(r, z)
-        if iters == 0:
-            p = z
-        else:
-            beta = rho / rho1
-            p = z + beta * p
-        q = matvec(p)
-        alpha = rho / cublas.dotc(p, q)
-        x = x + alpha * p
-        r = r - alpha * q
-        iters += 1
-        if callback is not None:
+    while True:
+        for _ in range(check):
+            run()
+            run = replay
+        done, new_iters, converged = state.get().tolist()
+        if callback is not None and new_iters > iters:
             callback(x)
-        resid = cublas.nrm2(r)
-        if resid <= atol:
+        iters = new_iters
+        if done:
             break
 
-    info = 0
-    if iters == maxiter and not (resid <= atol):
-        info = iters
-
+    info = 0 if converged else iters
     return x, info
 
 
@@ -176,8 +209,7 @@ def gmres(A, b, x0=None, *, rtol=1e-5, atol=0.0, restart=None, maxiter=None,
             H[:j+1, j], u = compute_hu(u, j)
             cublas.nrm2(u, out=H[j+1, j])
             if j+1 < restart:
-                v = u / H[j+1, j]
-                V[:, j+1] = v
+                v = cupy.divide(u, H[j+1, j], out=V[:, j+1])
 
         # Note: The least-square solution to equation Hy = e is computed on CPU
         # because it is faster if the matrix size is small.
@@ -284,6 +316,152 @@ def cgs(A, b, x0=None, *, rtol=1e-5, atol=0.0, maxiter=None, M=None,
     return x, info
 
 
+_cg_dots_code = r'''
+#include <cupy/complex.cuh>
+
+#ifdef IS_COMPLEX
+#define CONJ(x) conj(x)
+#define REAL(x) (x).real()
+#define IMAG(x) (x).imag()
+#define MAKE(re, im) T(re, im)
+#else
+#define CONJ(x) (x)
+#define REAL(x) (x)
+#define IMAG(x) RT(0)
+#define MAKE(re, im) T(re)
+#endif
+
+#define BLOCK 256
+
+// With u = M r and w = A u, sums gamma = (r, u), delta = (u, w) and
+// rr = (r, r) in one pass. The last block adds up the partial sums of the
+// blocks and turns them into the step lengths alpha and beta. The
+// iterations stop once rr <= atol2 or maxiter iterations are done, after
+// which the step lengths are zero.
+extern "C" __global__ void cupy_cg_dots(
+        const T* __restrict__ r, const T* __restrict__ u,
+        const T* __restrict__ w, const long long n, RT* partial,
+        unsigned int* count, T* scalars, int* state, const RT atol2,
+        const int maxiter) {
+    __shared__ RT sh[5][BLOCK];
+    __shared__ bool last;
+    const int t = threadIdx.x;
+    T g = T(0);
+    T d = T(0);
+    RT rr = 0;
+    for (long long i = (long long)blockIdx.x * BLOCK + t; i < n;
+            i += (long long)gridDim.x * BLOCK) {
+        const T ri = r[i];
+        const T ui = u[i];
+        g += CONJ(ri) * ui;
+        d += CONJ(ui) * w[i];
+        rr += REAL(ri) * REAL(ri) + IMAG(ri) * IMAG(ri);
+    }
+    sh[0][t] = REAL(g);
+    sh[1][t] = IMAG(g);
+    sh[2][t] = REAL(d);
+    sh[3][t] = IMAG(d);
+    sh[4][t] = rr;
+    for (int k = BLOCK / 2; k > 0; k >>= 1) {
+        __syncthreads();
+        if (t < k) {
+            for (int j = 0; j < 5; j++) {
+                sh[j][t] += sh[j][t + k];
+            }
+        }
+    }
+    if (t == 0) {
+        for (int j = 0; j < 5; j++) {
+            partial[j * gridDim.x + blockIdx.x] = sh[j][0];
+        }
+        __threadfence();
+        last = atomicAdd(count, 1u) == gridDim.x - 1;
+    }
+    __syncthreads();
+    if (!last) {
+        return;
+    }
+
+    const volatile RT* v = partial;
+    for (int j = 0; j < 5; j++) {
+        RT a = 0;
+        for (int b = t; b < gridDim.x; b += BLOCK) {
+            a += v[j * gridDim.x + b];
+        }
+        sh[j][t] = a;
+    }
+    for (int k = BLOCK / 2; k > 0; k >>= 1) {
+        __syncthreads();
+        if (t < k) {
+            for (int j = 0; j < 5; j++) {
+                sh[j][t] += sh[j][t + k];
+            }
+        }
+    }
+    if (t != 0) {
+        return;
+    }
+    *count = 0;
+    const T gamma = MAKE(sh[0][0], sh[1][0]);
+    const T delta = MAKE(sh[2][0], sh[3][0]);
+    T alpha = T(0);
+    T beta = T(0);
+    if (!state[0]) {
+        if (sh[4][0] <= atol2) {
+            state[0] = 1;
+            state[2] = 1;
+        } else if (state[1] >= maxiter) {
+            state[0] = 1;
+        } else {
+            if (state[1] == 0) {
+                alpha = gamma / delta;
+            } else {
+                beta = gamma / scalars[2];
+                alpha = gamma / (delta - beta * gamma / scalars[3]);
+            }
+            scalars[2] = gamma;
+            scalars[3] = alpha;
+            state[1]++;
+        }
+    }
+    scalars[0] = alpha;
+    scalars[1] = beta;
+}
+'''
+
+
+@_util.memoize(for_each_device=True)
+def _get_cg_dots_kernel(dtype):
+    code = '#define T {}\n#define RT {}\n'.format(
+        get_typename(dtype), get_typename(numpy.dtype(dtype.char.lower())))
+    if dtype.kind == 'c':
+        code += '#define IS_COMPLEX\n'
+    return cupy.RawKernel(code + _cg_dots_code, 'cupy_cg_dots')
+
+
+# p and s = A p are the search direction and its product.
+_cg_update_kernel = cupy.ElementwiseKernel(
+    'T u, T w, raw T scalars', 'T p, T s, T x, T r',
+    '''
+    const T alpha = scalars[0];
+    const T beta = scalars[1];
+    p = u + beta * p;
+    s = w + beta * s;
+    x += alpha * p;
+    r -= alpha * s;
+    ''',
+    'cupy_cg_update')
+
+
+def _is_capturable(A):
+    # Tells if the products with A only issue work on the current stream,
+    # with buffers set up by the first product, so that they may be
+    # captured in a graph.
+    from cupyx import cusparse
+
+    return _csr.isspmatrix_csr(A) and cusparse.check_availability('spmv')
+
+
 def _make_system(A, M, x0, b):
     """Make a linear system Ax = b
 
@@ -346,21 +524,20 @@ def _make_fast_matvec(A):
         beta = numpy.array(0.0, A.dtype)
         cuda_dtype = _dtype.to_cuda_dtype(A.dtype)
         alg = _cusparse.CUSPARSE_MV_ALG_DEFAULT
-        x = cupy.empty((A.shape[0],), dtype=A.dtype)
-        y = cupy.empty((A.shape[0],), dtype=A.dtype)
-        desc_A = cusparse.SpMatDescriptor.create(A)
-        desc_x = cusparse.DnVecDescriptor.create(x)
-        desc_y = cusparse.DnVecDescriptor.create(y)
-        buff_size = _cusparse.spMV_bufferSize(
-            handle, op_a, alpha.ctypes.data, desc_A.desc, desc_x.desc,
-            beta.ctypes.data, desc_y.desc, cuda_dtype, alg)
-        buff = cupy.empty(buff_size, cupy.int8)
-        del x, desc_x, y, desc_y
 
         def matvec(x):
+            # the descriptors and the buffer are reused across the calls,
+            # and across the solvers called with the same matrix
             y = cupy.empty_like(x)
-            desc_x = cusparse.DnVecDescriptor.create(x)
-            desc_y = cusparse.DnVecDescriptor.create(y)
+            cache = cusparse._get_descriptor_cache(A)
+            desc_A = cache.desc
+            desc_x = cache.dense('x', x)
+            desc_y = cache.dense('y', y)
+            buff = cache.buffer(('spmv', op_a, alg), lambda: (
+                _cusparse.spMV_bufferSize(
+                    handle, op_a, alpha.ctypes.data, desc_A.desc,
+                    desc_x.desc, beta.ctypes.data, desc_y.desc, cuda_dtype,
+                    alg)))
             _cusparse.spMV(
                 handle, op_a, alpha.ctypes.data, desc_A.desc, desc_x.desc,
                 beta.ctypes.data, desc_y.desc, cuda_dtype, alg, buff.data.ptr)
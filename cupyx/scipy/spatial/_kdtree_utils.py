@@ -77,30 +77,113 @@ __device__ long long ss(
     return ss_s;
 }
 
-__global__ void update_tags(
-        const int n, const int level, long long* tags) {
-
-    int idx = blockIdx.x * blockDim.x + threadIdx.x;
+__device__ long long update_tag(
+        const int n, const int level, const int idx, long long tag) {
 
     int level_size = (1 << level) - 1;
-    if(idx >= n || idx < level_size) {
-        return;
+    if(idx < level_size) {
+        return tag;
     }
 
     const int num_levels = 32 - __clz(n);
 
-    long long tag = tags[idx];
     long long left_child = 2 * tag + 1;
     long long right_child = 2 * tag + 2;
     long long subtree_size = ss(n, num_levels, left_child);
     long long segment_begin = sb(level, n, num_levels, tag);
     long long pivot_pos = segment_begin + subtree_size;
     if(idx < pivot_pos) {
-        tags[idx] = left_child;
+        return left_child;
     } else if(idx > pivot_pos) {
-        tags[idx] = right_child;
+        return right_child;
+    }
+    return tag;
+}
+
+// Order-preserving unsigned forms of the coordinates, as the radix keys of
+// cupy.sort: the NaNs go last and -0.0 is folded into +0.0.
+__device__ unsigned long long radix_key(half x) {
+    if(__hisnan(x)) {
+        return 0xffffull;
+    }
+    unsigned short b = __half_as_ushort(x);
+    if((b & 0x7fff) == 0) {
+        b = 0;
+    }
+    return (b & 0x8000) ? (unsigned short)~b : (b | 0x8000);
+}
+
+__device__ unsigned long long radix_key(float x) {
+    if(isnan(x)) {
+        return 0xffffffffull;
+    }
+    unsigned int b = __float_as_uint(x == 0.0f ? 0.0f : x);
+    return (b & 0x80000000u) ? ~b : (b | 0x80000000u);
+}
+
+__device__ unsigned long long radix_key(double x) {
+    if(isnan(x)) {
+        return 0xffffffffffffffffull;
+    }
+    unsigned long long b = __double_as_longlong(x == 0.0 ? 0.0 : x);
+    return (b & 0x8000000000000000ull) ? ~b : (b | 0x8000000000000000ull);
+}
+
+template<typename T>
+__device__ unsigned long long radix_key(T x) {
+    const int bits = 8 * sizeof(T);
+    unsigned long long key = (unsigned long long)x;
+    if((T)-1 < 0) {
+        // flips the sign bit of the two's complement
+        if(bits < 64) {
+            key &= (1ull << bits) - 1;
+        }
+        key ^= 1ull << (bits - 1);
+    }
+    return key;
+}
+
+// The sort keys of a level of the construction: the order-preserving form
+// of the coordinate of the points along dim, gathered through perm, with
+// the tag of the point above it when shift is below 64.
+template<typename T>
+__global__ void level_keys(
+        const int n, const int n_dims, const int dim, const int shift,
+        const T* __restrict__ points, const long long* __restrict__ perm,
+        const long long* __restrict__ tags, unsigned long long* keys) {
+
+    const int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if(idx >= n) {
+        return;
+    }
+
+    unsigned long long key = radix_key(points[perm[idx] * n_dims + dim]);
+    if(shift < 64) {
+        key |= (unsigned long long)tags[idx] << shift;
+    }
+    keys[idx] = key;
+}
+
+// Applies the sorted order of a level to the permutation and the tags, and
+// updates the tags for the next level unless level is negative.
+__global__ void permute_level(
+        const int n, const int level, const long long* __restrict__ order,
+        const long long* __restrict__ perm,
+        const long long* __restrict__ tags,
+        long long* perm_out, long long* tags_out) {
+
+    const int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if(idx >= n) {
+        return;
     }
 
+    const long long src = order[idx];
+    perm_out[idx] = perm[src];
+    long long tag = tags[src];
+    if(level >= 0) {
+        tag = update_tag(n, level, idx, tag);
+    }
+    tags_out[idx] = tag;
 }
 
 __device__ half max(half a, half b) {
@@ -690,10 +773,219 @@ __global__ void query_ball_periodic(
 '''
 
 
+# kNN queries with a warp per query point, for large k. The warp follows
+# the same traversal as compute_knn, and keeps the candidates sorted by
+# (distance, index) in the registers of its lanes: the candidate i is in
+# the slot i / 32 of the lane i % 32, so an insertion is a ballot and a
+# shuffle of each slot. The subtrees of the last KNN_WARP_LEAF_LEVELS
+# levels of the tree are not traversed; their nodes are evaluated at once,
+# one per lane.
+KNN_WARP_KERNEL = r'''
+#define KNN_WARP_LEAF_LEVELS 5
+#define FULL_MASK 0xffffffffu
+
+template<int SLOTS>
+__device__ void warp_insort(
+        const int k, const double dist, const long long node,
+        double* distances, long long* nodes) {
+
+    const int lane = threadIdx.x % 32;
+    int pos = 0;
+#pragma unroll
+    for(int s = 0; s < SLOTS; s++) {
+        const bool less = distances[s] < dist ||
+                          (distances[s] == dist && nodes[s] < node);
+        pos += __popc(__ballot_sync(FULL_MASK, less));
+    }
+    if(pos >= k) {
+        return;
+    }
+
+#pragma unroll
+    for(int s = SLOTS - 1; s >= 0; s--) {
+        double up_dist = __shfl_up_sync(FULL_MASK, distances[s], 1);
+        long long up_node = __shfl_up_sync(FULL_MASK, nodes[s], 1);
+        if(s > 0) {
+            const double last_dist = __shfl_sync(
+                FULL_MASK, distances[s > 0 ? s - 1 : 0], 31);
+            const long long last_node = __shfl_sync(
+                FULL_MASK, nodes[s > 0 ? s - 1 : 0], 31);
+            if(lane == 0) {
+                up_dist = last_dist;
+                up_node = last_node;
+            }
+        }
+        const int i = 32 * s + lane;
+        if(i > pos) {
+            distances[s] = up_dist;
+            nodes[s] = up_node;
+        } else if(i == pos) {
+            distances[s] = dist;
+            nodes[s] = node;
+        }
+    }
+}
+
+template<int SLOTS>
+__device__ double warp_kth(
+        const int k, const double* distances) {
+    double kth = 0.0;
+#pragma unroll
+    for(int s = 0; s < SLOTS; s++) {
+        if(s == (k - 1) / 32) {
+            kth = distances[s];
+        }
+    }
+    return __shfl_sync(FULL_MASK, kth, (k - 1) % 32);
+}
+
+template<typename T, int SLOTS>
+__global__ void knn_warp(
+        const int k, const int n, const int points_size, const int n_dims,
+        const double eps, const double p, const double dist_bound,
+        const T* __restrict__ points, const T* __restrict__ tree,
+        const long long* __restrict__ index,
+        const double* __restrict__ box_bounds,
+        double* all_distances, long long* all_nodes) {
+
+    const long long query = (
+        blockIdx.x * (long long)blockDim.x + threadIdx.x) / 32;
+    const int lane = threadIdx.x % 32;
+    if(query >= points_size) {
+        return;
+    }
+
+    const T* point = points + n_dims * query;
+    double distances[SLOTS];
+    long long nodes[SLOTS];
+#pragma unroll
+    for(int s = 0; s < SLOTS; s++) {
+        distances[s] = CUDART_INF;
+        nodes[s] = n;
+    }
+
+    const double bound = !isinf(p) ? pow(dist_bound, p) : dist_bound;
+    double radius = bound;
+    double epsfac = 1.0;
+    if(eps != 0) {
+        if(p == 2) {
+            epsfac = 1.0 / ((1 + eps) * (1 + eps));
+        } else if(isinf(p) || p == 1) {
+            epsfac = 1.0 / (1 + eps);
+        } else {
+            epsfac = 1.0 / pow(1 + eps, p);
+        }
+    }
+
+    const int n_levels = 64 - __clzll(n);
+    const int leaf_level = max(n_levels - KNN_WARP_LEAF_LEVELS, 0);
+
+    // the offset of the node of this lane in a subtree
+    const int lane_level = 31 - __clz(lane + 1);
+    const int lane_offset = lane + 1 - (1 << lane_level);
+
+    long long prev = -1;
+    long long curr = 0;
+    while(true) {
+        const long long parent = (curr + 1) / 2 - 1;
+        const long long cur_level = 63 - __clzll(curr + 1);
+
+        if(cur_level == leaf_level) {
+            const long long node = (
+                ((curr + 1) << lane_level) - 1 + lane_offset);
+            const bool valid = lane < 31 && node < n;
+            double dist = CUDART_INF;
+            long long node_index = n;
+            if(valid) {
+                dist = compute_distance(
+                    point, tree + n_dims * node, box_bounds, n_dims, p, 1,
+                    false);
+                node_index = index[node];
+            }
+            unsigned int found = __ballot_sync(
+                FULL_MASK, valid && dist <= radius);
+            while(found) {
+                const int src = __ffs(found) - 1;
+                found &= found - 1;
+                const double src_dist = __shfl_sync(FULL_MASK, dist, src);
+                const long long src_node = __shfl_sync(
+                    FULL_MASK, node_index, src);
+                if(src_dist <= radius) {
+                    warp_insort<SLOTS>(
+                        k, src_dist, src_node, distances, nodes);
+                    radius = min(bound, warp_kth<SLOTS>(k, distances));
+                }
+            }
+            if(curr == 0) {
+                break;
+            }
+            prev = curr;
+            curr = parent;
+            continue;
+        }
+
+        const long long child = 2 * curr + 1;
+        const long long r_child = 2 * curr + 2;
+        const bool from_child = prev >= child;
+        const T* cur_point = tree + n_dims * curr;
+
+        if(!from_child) {
+            const double dist = compute_distance(
+                point, cur_point, box_bounds, n_dims, p, 1, false);
+            if(dist <= radius) {
+                warp_insort<SLOTS>(k, dist, index[curr], distances, nodes);
+                radius = min(bound, warp_kth<SLOTS>(k, distances));
+            }
+        }
+
+        const long long cur_dim = cur_level % n_dims;
+        double curr_dim_dist = abs(point[cur_dim] - cur_point[cur_dim]);
+        curr_dim_dist = !isinf(p) ? pow(curr_dim_dist, p) : curr_dim_dist;
+
+        long long cur_close_child = child;
+        long long cur_far_child = r_child;
+        if(point[cur_dim] > cur_point[cur_dim]) {
+            cur_close_child = r_child;
+            cur_far_child = child;
+        }
+
+        // the levels above the leaf level are complete
+        long long next;
+        if(prev == cur_close_child) {
+            next = curr_dim_dist <= radius * epsfac ? cur_far_child : parent;
+        } else if(prev == cur_far_child) {
+            next = parent;
+        } else {
+            next = cur_close_child;
+        }
+
+        if(next == -1) {
+            break;
+        }
+        prev = curr;
+        curr = next;
+    }
+
+    double* distances_out = all_distances + (long long)k * query;
+    long long* nodes_out = all_nodes + (long long)k * query;
+#pragma unroll
+    for(int s = 0; s < SLOTS; s++) {
+        const int i = 32 * s + lane;
+        if(i < k) {
+            distances_out[i] = distances[s];
+            nodes_out[i] = nodes[s];
+        }
+    }
+}
+'''
+
+
 KD_MODULE = cupy.RawModule(
     code=KD_KERNEL, options=('-std=c++11',),
-    name_expressions=['update_tags', 'tag_pairs'] + [
-        f'compute_bounds<{x}>' for x in TYPE_NAMES])
+    name_expressions=['permute_level', 'tag_pairs'] + [
+        f'compute_bounds<{x}>' for x in TYPE_NAMES] + [
+        f'level_keys<{_get_typename(x)}>'
+        for x in FLOAT_TYPES + INT_TYPES + UNSIGNED_TYPES])
 
 KNN_MODULE = cupy.RawModule(
     code=KNN_KERNEL, options=('-std=c++11',),
@@ -702,6 +994,56 @@ KNN_MODULE = cupy.RawModule(
     [f'query_ball<{x}>' for x in TYPE_NAMES])
 
 
+KNN_WARP_SLOTS = (1, 2, 4, 8)
+KNN_WARP_TYPES = [cupy.float32, cupy.float64]
+
+KNN_WARP_MODULE = cupy.RawModule(
+    code=KNN_KERNEL + KNN_WARP_KERNEL, options=('-std=c++11',),
+    name_expressions=[
+        f'knn_warp<{_get_typename(x)}, {s}>'
+        for x in KNN_WARP_TYPES for s in KNN_WARP_SLOTS])
+
+# The warp per query kernel is used for k in this range.
+_KNN_WARP_MIN_K = 16
+_KNN_WARP_MAX_K = 32 * KNN_WARP_SLOTS[-1]
+
+# The query points are sorted by their Morton codes from this number on,
+# so that the threads of a warp traverse nearby parts of the tree.
+_MORTON_MIN_POINTS = 1 << 14
+
+
+_morton_codes_kernel = cupy.ElementwiseKernel(
+    'raw T points, raw float64 lo, raw float64 scale, int32 n_dims, '
+    'int32 bits', 'uint64 code',
+    '''
+    unsigned long long c = 0;
+    const unsigned long long q_max = (1ull << bits) - 1;
+    const int n_used = min(n_dims, 64);
+    for(int b = bits - 1; b >= 0; b--) {
+        for(int d = 0; d < n_used; d++) {
+            double v = ((double)points[i * n_dims + d] - lo[d]) * scale[d];
+            v = fmin(fmax(v, 0.0), (double)q_max);
+            c = (c << 1) | (((unsigned long long)v >> b) & 1);
+        }
+    }
+    code = c;
+    ''',
+    'cupyx_scipy_spatial_morton_codes')
+
+
+def _morton_order(points):
+    # The order of the points along a Z-order curve of their bounding box.
+    n_points, n_dims = points.shape
+    bits = max(1, min(32, 64 // n_dims))
+    lo = points.min(axis=0).astype(cupy.float64)
+    extent = points.max(axis=0).astype(cupy.float64) - lo
+    scale = cupy.where(
+        extent > 0, ((1 << bits) - 1) / cupy.where(extent > 0, extent, 1), 0)
+    codes = cupy.empty(n_points, dtype=cupy.uint64)
+    _morton_codes_kernel(points, lo, scale, n_dims, bits, codes)
+    return cupy.argsort(codes)
+
+
 def _get_module_func(module, func_name, *template_args):
     args_dtypes = [_get_typename(arg.dtype) for arg in template_args]
     template = ', '.join(args_dtypes)
@@ -731,7 +1073,9 @@ def asm_kd_tree(points):
 
     Notes
     -----
-    This algorithm is derived from [1]_.
+    This algorithm is derived from [1]_. Each level sorts the points by
+    their tag and their coordinate along the dimension of the level with a
+    single radix sort, and only the indices of the points are moved.
 
     References
     ----------
@@ -739,39 +1083,47 @@ def asm_kd_tree(points):
            Construction of Left-Balanced k-d Trees, 2022.
            doi:10.48550/arXiv.2211.00120.
     """
-    x = points.copy()
-    track_idx = cupy.arange(x.shape[0], dtype=cupy.int64)
-    tags = cupy.zeros(x.shape[0], dtype=cupy.int64)
+    x = cupy.ascontiguousarray(points)
+    if x.dtype.kind not in 'fiu':
+        raise TypeError('KDTree does not support {} points'.format(x.dtype))
     length = x.shape[0]
     dims = x.shape[1]
     n_iter = int(np.log2(length))
 
+    # The tag and the coordinate are packed into a single radix key when
+    # they fit in 64 bits, otherwise the tags are sorted in a second pass.
+    coord_bits = 8 * x.dtype.itemsize
+    packed = coord_bits + length.bit_length() <= 64
+    shift = coord_bits if packed else 64
+
     block_sz = 128
     n_blocks = (length + block_sz - 1) // block_sz
-    update_tags = KD_MODULE.get_function('update_tags')
-    x_tags = cupy.empty((2, length), dtype=x.dtype)
-
-    level = 0
-    for level in range(n_iter):
-        dim = level % dims
-        x_tags[0, :] = x[:, dim]
-        x_tags[1, :] = tags
-        idx = cupy.lexsort(x_tags)
-        x = x[idx]
-        tags = tags[idx]
-        track_idx = track_idx[idx]
-        update_tags((n_blocks,), (block_sz,), (length, level, tags))
-
-    if n_iter > 1:
-        level += 1
-
-    dim = level % dims
-    x_tags[0, :] = x[:, dim]
-    x_tags[1, :] = tags
-    idx = cupy.lexsort(x_tags)
-    x = x[idx]
-    track_idx = track_idx[idx]
-    return x, track_idx
+    level_keys = _get_module_func(KD_MODULE, 'level_keys', x)
+    permute_level = KD_MODULE.get_function('permute_level')
+    track_idx = cupy.arange(length, dtype=cupy.int64)
+    tags = cupy.zeros(length, dtype=cupy.int64)
+    track_idx_out = cupy.empty_like(track_idx)
+    tags_out = cupy.empty_like(tags)
+    keys = cupy.empty(length, dtype=cupy.uint64)
+
+    # the last sort is along the dimension after the last level, and does
+    # not update the tags
+    levels = list(range(n_iter)) + [n_iter if n_iter > 1 else 0]
+    for i, level in enumerate(levels):
+        level_keys((n_blocks,), (block_sz,),
+                   (length, dims, level % dims, shift, x, track_idx, tags,
+                    keys))
+        if packed:
+            idx = cupy.argsort(keys)
+        else:
+            idx = cupy.lexsort(cupy.stack([keys, tags.astype(cupy.uint64)]))
+        permute_level((n_blocks,), (block_sz,),
+                      (length, level if i < n_iter else -1, idx, track_idx,
+                       tags, track_idx_out, tags_out))
+        track_idx, track_idx_out = track_idx_out, track_idx
+        tags, tags_out = tags_out, tags
+
+    return x[track_idx], track_idx
 
 
 def compute_tree_bounds(tree):
@@ -817,14 +1169,36 @@ def compute_knn(points, tree, index, boxdata, bounds, k=1, eps=0.0, p=2.0,
     distances = cupy.full((n_points, max_k), cupy.inf, dtype=cupy.float64)
     nodes = cupy.full((n_points, max_k), tree.shape[0], dtype=cupy.int64)
 
+    order = None
+    if points.ndim == 2 and n_points >= _MORTON_MIN_POINTS:
+        order = _morton_order(points)
+        points = points[order]
+
     block_sz = 128
-    n_blocks = (n_points + block_sz - 1) // block_sz
-    knn_fn, fn_args = (
-        ('knn', (points,)) if not adjust_to_box else ('knn_periodic', tuple()))
-    knn = _get_module_func(KNN_MODULE, knn_fn, *fn_args)
-    knn((n_blocks,), (block_sz,),
-        (max_k, tree.shape[0], n_points, n_dims, eps, p, distance_upper_bound,
-         points, tree, index, boxdata, bounds, distances, nodes))
+    if (not adjust_to_box and _KNN_WARP_MIN_K <= max_k <= _KNN_WARP_MAX_K
+            and points.dtype in KNN_WARP_TYPES):
+        slots = 1 << ((max_k + 31) // 32 - 1).bit_length()
+        knn = KNN_WARP_MODULE.get_function(
+            f'knn_warp<{_get_typename(points.dtype)}, {slots}>')
+        n_blocks = (32 * n_points + block_sz - 1) // block_sz
+        knn((n_blocks,), (block_sz,),
+            (max_k, tree.shape[0], n_points, n_dims, eps, p,
+             distance_upper_bound, points, tree, index, boxdata, distances,
+             nodes))
+    else:
+        n_blocks = (n_points + block_sz - 1) // block_sz
+        knn_fn, fn_args = (
+            ('knn', (points,)) if not adjust_to_box else
+            ('knn_periodic', tuple()))
+        knn = _get_module_func(KNN_MODULE, knn_fn, *fn_args)
+        knn((n_blocks,), (block_sz,),
+            (max_k, tree.shape[0], n_points, n_dims, eps, p,
+             distance_upper_bound, points, tree, index, boxdata, bounds,
+             distances, nodes))
+
+    if order is not None:
+        distances[order] = distances.copy()
+        nodes[order] = nodes.copy()
 
     if not isinstance(k, int):
         indices = [k_i - 1 for k_i in k]
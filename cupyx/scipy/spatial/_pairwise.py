@@ -0,0 +1,439 @@
+import math
+
+import numpy
+
+import cupy
+from cupy._core._scalar import get_typename
+
+
+# The metrics computed by the tiled kernels, with their codes in the kernels.
+METRICS = {
+    'sqeuclidean': 0,
+    'euclidean': 1,
+    'cityblock': 2,
+    'minkowski': 3,
+    'chebyshev': 4,
+    'cosine': 5,
+}
+
+
+_PAIRWISE_KERNEL = r'''
+#include <cupy/math_constants.h>
+
+// A block of THREADS x THREADS threads computes a TILE x TILE tile of the
+// distances, each thread a PER_THREAD x PER_THREAD block of registers like
+// a GEMM: the rows row0 + ty + THREADS * i of a, and the rows
+// col0 + tx + THREADS * j of b. The features are staged in shared memory TK
+// at a time.
+#define TILE 64
+#define TK 16
+#define THREADS 16
+#define PER_THREAD 4
+
+#define SQEUCLIDEAN 0
+#define EUCLIDEAN 1
+#define CITYBLOCK 2
+#define MINKOWSKI 3
+#define CHEBYSHEV 4
+#define COSINE 5
+
+template<int METRIC>
+__device__ __forceinline__ T accumulate(T acc, T x, T y, T p) {
+    if(METRIC == SQEUCLIDEAN || METRIC == EUCLIDEAN) {
+        T t = x - y;
+        return acc + t * t;
+    } else if(METRIC == CITYBLOCK) {
+        return acc + fabs(x - y);
+    } else if(METRIC == MINKOWSKI) {
+        return acc + pow(fabs(x - y), p);
+    } else if(METRIC == CHEBYSHEV) {
+        return max(acc, fabs(x - y));
+    }
+    return acc + x * y;
+}
+
+template<int METRIC>
+__device__ __forceinline__ T finalize(T acc, T p, T norm_x, T norm_y) {
+    if(METRIC == EUCLIDEAN) {
+        return sqrt(acc);
+    } else if(METRIC == MINKOWSKI) {
+        return pow(acc, 1 / p);
+    } else if(METRIC == COSINE) {
+        return 1 - acc / (norm_x * norm_y);
+    }
+    return acc;
+}
+
+// Leaves the distances in acc, and +inf out of the bounds.
+template<int METRIC>
+__device__ void distance_tile(
+        const T* __restrict__ a, const T* __restrict__ b,
+        const int m, const int n, const int d, const T p,
+        const T* __restrict__ norm_a, const T* __restrict__ norm_b,
+        const int row0, const int col0, T* smem,
+        T acc[PER_THREAD][PER_THREAD]) {
+
+    T* sa = smem;
+    T* sb = smem + TK * TILE;
+    const int tx = threadIdx.x;
+    const int ty = threadIdx.y;
+    const int t = ty * THREADS + tx;
+
+#pragma unroll
+    for(int i = 0; i < PER_THREAD; i++) {
+#pragma unroll
+        for(int j = 0; j < PER_THREAD; j++) {
+            acc[i][j] = 0;
+        }
+    }
+
+    for(int k0 = 0; k0 < d; k0 += TK) {
+        // the zero padding of the features does not change the distances
+        for(int q = t; q < TK * TILE; q += THREADS * THREADS) {
+            const int r = q / TK;
+            const int k = k0 + q % TK;
+            const bool in_k = k < d;
+            sa[(q % TK) * TILE + r] = (row0 + r < m && in_k)
+                ? a[(long long)(row0 + r) * d + k] : (T)0;
+            sb[(q % TK) * TILE + r] = (col0 + r < n && in_k)
+                ? b[(long long)(col0 + r) * d + k] : (T)0;
+        }
+        __syncthreads();
+
+#pragma unroll
+        for(int kk = 0; kk < TK; kk++) {
+            T x[PER_THREAD], y[PER_THREAD];
+#pragma unroll
+            for(int i = 0; i < PER_THREAD; i++) {
+                x[i] = sa[kk * TILE + ty + THREADS * i];
+                y[i] = sb[kk * TILE + tx + THREADS * i];
+            }
+#pragma unroll
+            for(int i = 0; i < PER_THREAD; i++) {
+#pragma unroll
+                for(int j = 0; j < PER_THREAD; j++) {
+                    acc[i][j] = accumulate<METRIC>(acc[i][j], x[i], y[j], p);
+                }
+            }
+        }
+        __syncthreads();
+    }
+
+#pragma unroll
+    for(int i = 0; i < PER_THREAD; i++) {
+        const int row = row0 + ty + THREADS * i;
+#pragma unroll
+        for(int j = 0; j < PER_THREAD; j++) {
+            const int col = col0 + tx + THREADS * j;
+            if(row < m && col < n) {
+                T norm_x = METRIC == COSINE ? norm_a[row] : (T)1;
+                T norm_y = METRIC == COSINE ? norm_b[col] : (T)1;
+                acc[i][j] = finalize<METRIC>(acc[i][j], p, norm_x, norm_y);
+            } else {
+                acc[i][j] = CUDART_INF;
+            }
+        }
+    }
+}
+
+// The full m x n matrix of distances.
+template<int METRIC>
+__global__ void pairwise_dense(
+        const T* __restrict__ a, const T* __restrict__ b,
+        const int m, const int n, const int d, const T p,
+        const T* __restrict__ norm_a, const T* __restrict__ norm_b,
+        const int n_col_tiles, T* out) {
+
+    __shared__ T smem[2 * TK * TILE];
+    const int row0 = blockIdx.x / n_col_tiles * TILE;
+    const int col0 = blockIdx.x % n_col_tiles * TILE;
+    T acc[PER_THREAD][PER_THREAD];
+    distance_tile<METRIC>(
+        a, b, m, n, d, p, norm_a, norm_b, row0, col0, smem, acc);
+
+#pragma unroll
+    for(int i = 0; i < PER_THREAD; i++) {
+        const int row = row0 + threadIdx.y + THREADS * i;
+#pragma unroll
+        for(int j = 0; j < PER_THREAD; j++) {
+            const int col = col0 + threadIdx.x + THREADS * j;
+            if(row < m && col < n) {
+                out[(long long)row * n + col] = acc[i][j];
+            }
+        }
+    }
+}
+
+// The k smallest distances of each row among the columns of the split-th
+// of n_splits ranges of column tiles, sorted, in top_dist[row, split] and
+// their columns in top_idx[row, split]. A block goes through the column tiles of
+// TILE rows, and the distances of each tile are merged into the lists by a
+// thread per row.
+template<int METRIC>
+__global__ void pairwise_topk(
+        const T* __restrict__ a, const T* __restrict__ b,
+        const int m, const int n, const int d, const T p,
+        const T* __restrict__ norm_a, const T* __restrict__ norm_b,
+        const int k, const int n_splits, T* top_dist, long long* top_idx) {
+
+    __shared__ T smem[TILE * (TILE + 1)];
+    const int row0 = blockIdx.x * TILE;
+    const int split = blockIdx.y;
+    const int t = threadIdx.y * THREADS + threadIdx.x;
+    const bool owner = t < TILE && row0 + t < m;
+    T* my_dist = top_dist + ((long long)(row0 + t) * n_splits + split) * k;
+    long long* my_idx = (
+        top_idx + ((long long)(row0 + t) * n_splits + split) * k);
+
+    T kth = CUDART_INF;
+    if(owner) {
+        for(int j = 0; j < k; j++) {
+            my_dist[j] = CUDART_INF;
+            my_idx[j] = -1;
+        }
+    }
+
+    const int n_col_tiles = (n + TILE - 1) / TILE;
+    const int per_split = (n_col_tiles + n_splits - 1) / n_splits;
+    const int end = min(n_col_tiles, (split + 1) * per_split);
+    for(int tile = split * per_split; tile < end; tile++) {
+        const int col0 = tile * TILE;
+        T acc[PER_THREAD][PER_THREAD];
+        distance_tile<METRIC>(
+            a, b, m, n, d, p, norm_a, norm_b, row0, col0, smem, acc);
+
+#pragma unroll
+        for(int i = 0; i < PER_THREAD; i++) {
+#pragma unroll
+            for(int j = 0; j < PER_THREAD; j++) {
+                smem[(threadIdx.y + THREADS * i) * (TILE + 1)
+                     + threadIdx.x + THREADS * j] = acc[i][j];
+            }
+        }
+        __syncthreads();
+
+        if(owner) {
+            for(int c = 0; c < TILE; c++) {
+                const T dist = smem[t * (TILE + 1) + c];
+                if(!(dist < kth)) {
+                    continue;
+                }
+                // the ties keep the column order
+                int j = k - 1;
+                while(j > 0 && my_dist[j - 1] > dist) {
+                    my_dist[j] = my_dist[j - 1];
+                    my_idx[j] = my_idx[j - 1];
+                    j--;
+                }
+                my_dist[j] = dist;
+                my_idx[j] = col0 + c;
+                kth = my_dist[k - 1];
+            }
+        }
+        __syncthreads();
+    }
+}
+
+// The pairs of distances not above threshold. Unless write, their number
+// is added to pos[row]; otherwise their columns and distances are written
+// from pos[row] on, and pos[row] is advanced. The pairs of a
+// row in a tile are reserved with a single atomic operation.
+template<int METRIC>
+__global__ void pairwise_threshold(
+        const T* __restrict__ a, const T* __restrict__ b,
+        const int m, const int n, const int d, const T p,
+        const T* __restrict__ norm_a, const T* __restrict__ norm_b,
+        const T threshold, const int n_col_tiles, const int write,
+        unsigned long long* pos, long long* cols, T* dists) {
+
+    __shared__ T smem[2 * TK * TILE];
+    __shared__ unsigned int tile_count[TILE];
+    __shared__ unsigned long long tile_pos[TILE];
+    const int row0 = blockIdx.x / n_col_tiles * TILE;
+    const int col0 = blockIdx.x % n_col_tiles * TILE;
+    const int t = threadIdx.y * THREADS + threadIdx.x;
+    if(t < TILE) {
+        tile_count[t] = 0;
+    }
+
+    T acc[PER_THREAD][PER_THREAD];
+    distance_tile<METRIC>(
+        a, b, m, n, d, p, norm_a, norm_b, row0, col0, smem, acc);
+
+    unsigned int slot[PER_THREAD][PER_THREAD];
+#pragma unroll
+    for(int i = 0; i < PER_THREAD; i++) {
+#pragma unroll
+        for(int j = 0; j < PER_THREAD; j++) {
+            if(acc[i][j] <= threshold) {
+                slot[i][j] = atomicAdd(
+                    &tile_count[threadIdx.y + THREADS * i], 1u);
+            }
+        }
+    }
+    __syncthreads();
+
+    if(t < TILE && tile_count[t] > 0) {
+        tile_pos[t] = atomicAdd(
+            &pos[row0 + t], (unsigned long long)tile_count[t]);
+    }
+    if(!write) {
+        return;
+    }
+    __syncthreads();
+
+#pragma unroll
+    for(int i = 0; i < PER_THREAD; i++) {
+        const int r = threadIdx.y + THREADS * i;
+#pragma unroll
+        for(int j = 0; j < PER_THREAD; j++) {
+            if(acc[i][j] <= threshold) {
+                const unsigned long long s = tile_pos[r] + slot[i][j];
+                cols[s] = col0 + threadIdx.x + THREADS * j;
+                dists[s] = acc[i][j];
+            }
+        }
+    }
+}
+'''
+
+_TILE = 64
+_THREADS = 16
+
+
+@cupy.memoize(for_each_device=True)
+def _get_kernel(name, dtype, metric):
+    code = '#define T {}\n'.format(get_typename(dtype)) + _PAIRWISE_KERNEL
+    expr = '{}<{}>'.format(name, METRICS[metric])
+    module = cupy.RawModule(
+        code=code, options=('-std=c++11',), name_expressions=[expr])
+    return module.get_function(expr)
+
+
+def _prepare(XA, XB, metric, p):
+    # Returns the contiguous inputs, the metric, p and the row norms.
+    XA = cupy.asarray(XA)
+    XB = cupy.asarray(XB)
+    if XA.ndim != 2:
+        raise ValueError('XA must be a 2-dimensional array.')
+    if XB.ndim != 2:
+        raise ValueError('XB must be a 2-dimensional array.')
+    if XA.shape[1] != XB.shape[1]:
+        raise ValueError('XA and XB must have the same number of columns '
+                         '(i.e. feature dimension.)')
+    dtype = numpy.promote_types(
+        numpy.promote_types(XA.dtype, XB.dtype), numpy.float32)
+    if dtype.kind != 'f' or dtype.itemsize > 8:
+        dtype = numpy.dtype(numpy.float64)
+    XA = cupy.ascontiguousarray(XA, dtype=dtype)
+    XB = cupy.ascontiguousarray(XB, dtype=dtype)
+    if metric == 'minkowski':
+        if p <= 0:
+            raise ValueError('p must be greater than 0')
+        # the special orders are computed without pow
+        if p == 1:
+            metric = 'cityblock'
+        elif p == 2:
+            metric = 'euclidean'
+        elif math.isinf(p):
+            metric = 'chebyshev'
+    if metric == 'cosine':
+        norm_a = cupy.linalg.norm(XA, axis=1)
+        norm_b = cupy.linalg.norm(XB, axis=1)
+    else:
+        norm_a = norm_b = cupy.empty((1,), dtype)
+    return XA, XB, metric, dtype.type(p), norm_a, norm_b
+
+
+def _n_tiles(size):
+    return (size + _TILE - 1) // _TILE
+
+
+def pairwise_distances(XA, XB, metric, p=2.0, out=None):
+    """The m_A by m_B matrix of the distances with the tiled kernel."""
+    XA, XB, metric, p, norm_a, norm_b = _prepare(XA, XB, metric, p)
+    m, d = XA.shape
+    n = XB.shape[0]
+    if out is None:
+        out = cupy.empty((m, n), dtype=XA.dtype)
+    elif (out.shape != (m, n) or out.dtype != XA.dtype
+            or not out.flags.c_contiguous):
+        raise ValueError('out must be a C-contiguous {} array of shape '
+                         '{}'.format(XA.dtype, (m, n)))
+    if m == 0 or n == 0:
+        return out
+    n_col_tiles = _n_tiles(n)
+    kernel = _get_kernel('pairwise_dense', XA.dtype, metric)
+    kernel((_n_tiles(m) * n_col_tiles,), (_THREADS, _THREADS),
+           (XA, XB, numpy.int32(m), numpy.int32(n), numpy.int32(d), p,
+            norm_a, norm_b, numpy.int32(n_col_tiles), out))
+    return out
+
+
+def pairwise_topk(XA, XB, k, metric, p=2.0):
+    """The k smallest distances of each row and their columns."""
+    XA, XB, metric, p, norm_a, norm_b = _prepare(XA, XB, metric, p)
+    m, d = XA.shape
+    n = XB.shape[0]
+    if not 1 <= k <= n:
+        raise ValueError('k must be between 1 and the number of rows of XB')
+    if m == 0:
+        return (cupy.empty((0, k), XA.dtype),
+                cupy.empty((0, k), numpy.int64))
+
+    # the column tiles are split over a few blocks when there are not
+    # enough row tiles to fill the device
+    n_row_tiles = _n_tiles(m)
+    n_sm = cupy.cuda.Device().attributes['MultiProcessorCount']
+    n_splits = min(_n_tiles(n), max(1, -(-4 * n_sm // n_row_tiles)), 65535)
+    dists = cupy.empty((m, n_splits * k), dtype=XA.dtype)
+    idx = cupy.empty((m, n_splits * k), dtype=numpy.int64)
+    kernel = _get_kernel('pairwise_topk', XA.dtype, metric)
+    kernel((n_row_tiles, n_splits), (_THREADS, _THREADS),
+           (XA, XB, numpy.int32(m), numpy.int32(n), numpy.int32(d), p,
+            norm_a, norm_b, numpy.int32(k), numpy.int32(n_splits), dists,
+            idx))
+    if n_splits > 1:
+        # the splits are in the column order, and the sort is stable
+        order = cupy.argsort(dists, axis=1)[:, :k]
+        dists = cupy.take_along_axis(dists, order, axis=1)
+        idx = cupy.take_along_axis(idx, order, axis=1)
+    return dists, idx
+
+
+def pairwise_threshold(XA, XB, threshold, metric, p=2.0):
+    """The pairs whose distance is not above threshold, sorted."""
+    from cupyx import segmented_argsort
+
+    XA, XB, metric, p, norm_a, norm_b = _prepare(XA, XB, metric, p)
+    m, d = XA.shape
+    n = XB.shape[0]
+    counts = cupy.zeros(m, dtype=numpy.uint64)
+    if m == 0 or n == 0:
+        return (cupy.empty(0, numpy.int64), cupy.empty(0, numpy.int64),
+                cupy.empty(0, XA.dtype))
+    n_col_tiles = _n_tiles(n)
+    kernel = _get_kernel('pairwise_threshold', XA.dtype, metric)
+    threshold = XA.dtype.type(threshold)
+
+    def run(write, pos, cols, dists):
+        kernel((_n_tiles(m) * n_col_tiles,), (_THREADS, _THREADS),
+               (XA, XB, numpy.int32(m), numpy.int32(n), numpy.int32(d), p,
+                norm_a, norm_b, threshold, numpy.int32(n_col_tiles),
+                numpy.int32(write), pos, cols, dists))
+
+    # the distances are computed twice: to count the pairs of each row,
+    # and to write them
+    run(False, counts, counts, norm_a)
+    offsets = cupy.zeros(m + 1, dtype=numpy.int64)
+    offsets[1:] = cupy.cumsum(counts)
+    n_pairs = int(offsets[-1])
+    cols = cupy.empty(n_pairs, dtype=numpy.int64)
+    dists = cupy.empty(n_pairs, dtype=XA.dtype)
+    if n_pairs == 0:
+        return cupy.empty(0, numpy.int64), cols, dists
+    run(True, offsets[:-1].astype(numpy.uint64), cols, dists)
+    order = segmented_argsort(cols, offsets)
+    rows = cupy.searchsorted(
+        offsets, cupy.arange(n_pairs, dtype=numpy.int64), side='right') - 1
+    return rows, cols[order], dists[order]
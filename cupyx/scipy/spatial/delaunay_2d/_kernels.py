@@ -1128,11 +1128,42 @@ int         insTriNum
     return;
 }
 
-__global__ void isTriActive(char* triInfo, bool* out, int nTriInfo) {
+// The active triangles are appended in any order, and their number is
+// counted on the device, so that the flipping kernels read it without
+// a round trip to the host.
+__global__ void
+kerCollectActiveTris
+(
+char*   triInfoArr,
+int     nTriInfo,
+int*    actTriArr,
+int*    actTriNum
+)
+{
     for ( int idx = getCurThreadIdx(); idx < nTriInfo; idx += getThreadNum() )
     {
-        out[idx] = ( isTriAlive( triInfo[idx] ) && (
-            Changed == getTriCheckState( triInfo[idx] ) ) );
+        const char triInfo = triInfoArr[ idx ];
+
+        if ( isTriAlive( triInfo ) && Changed == getTriCheckState( triInfo ) )
+            storeIntoBuffer( actTriArr, actTriNum, idx );
+    }
+}
+
+__global__ void
+kerCompactActTris
+(
+int*    inArr,
+int     inNum,
+int*    actTriArr,
+int*    actTriNum
+)
+{
+    for ( int idx = getCurThreadIdx(); idx < inNum; idx += getThreadNum() )
+    {
+        const int triIdx = inArr[ idx ];
+
+        if ( triIdx >= 0 )
+            storeIntoBuffer( actTriArr, actTriNum, triIdx );
     }
 }
 
@@ -1552,7 +1583,7 @@ Tri*    triArr,
 TriOpp* oppArr,
 char*   triInfoArr,
 int*    triVoteArr,
-int     actTriNum,
+int*    actTriNum,
 /** predWrapper values **/
 int         infIdx,
 Point2*     points,
@@ -1566,7 +1597,7 @@ RealType*   predConsts
         triInfoArr,
         triVoteArr,
         NULL,
-        actTriNum,
+        *actTriNum,
         NULL,
         NULL,
         infIdx,
@@ -1584,7 +1615,7 @@ TriOpp* oppArr,
 char*   triInfoArr,
 int*    triVoteArr,
 int2*   exactCheckVi,
-int     actTriNum,
+int*    actTriNum,
 int*    counter,
 /** predWrapper values **/
 int         infIdx,
@@ -1599,7 +1630,7 @@ RealType*   predConsts
         triInfoArr,
         triVoteArr,
         exactCheckVi,
-        actTriNum,
+        *actTriNum,
         counter,
         NULL,
         infIdx,
@@ -1673,6 +1704,7 @@ RealType*   predConsts
 }
 
 // Note: triVoteArr should *not* be modified here
+// The accepted flips are appended to flipToTri, and counted in flipNum
 __global__ void
 kerMarkRejectedFlips
 (
@@ -1681,11 +1713,14 @@ TriOpp*     oppArr,
 int*        triVoteArr,
 char*       triInfoArr,
 int*        flipToTri,
-int         actTriNum
+int*        actTriNum,
+int*        flipNum
 )
 {
     int* dbgRejFlipArr = NULL;
-    for ( int idx = getCurThreadIdx(); idx < actTriNum; idx += getThreadNum() )
+    const int actNum   = *actTriNum;
+
+    for ( int idx = getCurThreadIdx(); idx < actNum; idx += getThreadNum() )
     {
         int output = -1;
 
@@ -1717,7 +1752,8 @@ int         actTriNum
                 dbgRejFlipArr[ triIdx ] = 1;
         }
 
-        flipToTri[ idx ] = output;
+        if ( -1 != output )
+            storeIntoBuffer( flipToTri, flipNum, output );
     }
 
     return;
@@ -2980,7 +3016,8 @@ DELAUNAY_MODULE = cupy.RawModule(
                       'kerShiftValues<char>', 'kerShiftValues<int>',
                       'kerShiftOpp', 'kerShiftTriIdx',
                       'kerSplitPointsFast', 'kerSplitPointsExactSoS',
-                      'kerSplitTri', 'isTriActive', 'kerMarkSpecialTris',
+                      'kerSplitTri', 'kerCollectActiveTris',
+                      'kerCompactActTris', 'kerMarkSpecialTris',
                       'kerCheckDelaunayFast', 'kerCheckDelaunayExact_Fast',
                       'kerCheckDelaunayExact_Exact', 'kerMarkRejectedFlips',
                       'kerFlip', 'kerUpdateOpp', 'kerUpdateFlipTrace',
@@ -3091,12 +3128,17 @@ def split_tri(split_tri, tri, tri_opp, tri_info, ins_tri_map, tri_to_vert,
         ins_tri_map, tri_to_vert, int(tri_num), int(ins_tri_num)))
 
 
-def is_tri_active(tri_info):
-    out = cupy.empty_like(tri_info, dtype=cupy.bool_)
-    ker_is_tri_active = DELAUNAY_MODULE.get_function('isTriActive')
-    ker_is_tri_active((N_BLOCKS,), (BLOCK_SZ,), (
-        tri_info, out, tri_info.shape[0]))
-    return out
+def collect_active_tris(tri_info, act_tri, act_tri_num):
+    ker_collect_active_tris = DELAUNAY_MODULE.get_function(
+        'kerCollectActiveTris')
+    ker_collect_active_tris((N_BLOCKS,), (BLOCK_SZ,), (
+        tri_info, tri_info.shape[0], act_tri, act_tri_num))
+
+
+def compact_act_tris(in_arr, act_tri, act_tri_num):
+    ker_compact_act_tris = DELAUNAY_MODULE.get_function('kerCompactActTris')
+    ker_compact_act_tris((N_BLOCKS,), (BLOCK_SZ,), (
+        in_arr, in_arr.shape[0], act_tri, act_tri_num))
 
 
 def mark_special_tris(tri_info, tri_opp):
@@ -3137,11 +3179,12 @@ def check_delaunay_exact_exact(tri, tri_opp, tri_vote, exact_check_vi,
 
 
 def mark_rejected_flips(act_tri, tri_opp, tri_vote, tri_info,
-                        flip_to_tri, act_tri_num):
+                        flip_to_tri, act_tri_num, flip_num):
     ker_mark_rejected_flips = DELAUNAY_MODULE.get_function(
         'kerMarkRejectedFlips')
     ker_mark_rejected_flips((N_BLOCKS,), (BLOCK_SZ,), (
-        act_tri, tri_opp, tri_vote, tri_info, flip_to_tri, act_tri_num))
+        act_tri, tri_opp, tri_vote, tri_info, flip_to_tri, act_tri_num,
+        flip_num))
 
 
 def flip(flip_to_tri, tri, tri_opp, tri_info, tri_msg, act_tri, flip_arr,
@@ -5,9 +5,10 @@ from cupyx.scipy.spatial.delaunay_2d._kernels import (
     make_first_tri, init_point_location_fast, init_point_location_exact,
     vote_for_point, pick_winner_point, shift, shift_opp_tri,
     shift_tri_idx, split_points_fast, split_points_exact, split_tri,
-    is_tri_active, mark_special_tris, check_delaunay_fast,
-    check_delaunay_exact_fast, check_delaunay_exact_exact, mark_rejected_flips,
-    flip, update_opp, update_flip_trace, relocate_points_fast,
+    collect_active_tris, compact_act_tris, mark_special_tris,
+    check_delaunay_fast, check_delaunay_exact_fast,
+    check_delaunay_exact_exact, mark_rejected_flips, flip, update_opp,
+    update_flip_trace, relocate_points_fast,
     relocate_points_exact, mark_inf_tri, collect_free_slots, make_compact_map,
     compact_tris, update_vert_idx, get_morton_number, compute_distance_2d,
     init_predicate, make_key_from_tri_has_vert, check_if_coplanar_points,
@@ -317,19 +318,20 @@ class GDel2D:
         self._tri_msg_sz = 0
         self._org_flip_num = []
 
-    def _dispatch_check_delaunay(self, check_mode, org_act_num, tri_vote):
+    def _dispatch_check_delaunay(self, check_mode, act_tri, act_tri_num,
+                                 tri_vote):
         if check_mode == CheckDelaunayMode.CircleFastOrientFast:
             check_delaunay_fast(
-                self._act_tri, self.triangles, self.triangle_opp,
-                self.triangle_info, tri_vote, org_act_num, self.n_points - 1,
+                act_tri, self.triangles, self.triangle_opp,
+                self.triangle_info, tri_vote, act_tri_num, self.n_points - 1,
                 self.point_vec, self.pred_consts)
         elif check_mode == CheckDelaunayMode.CircleExactOrientSoS:
             exact_check_vi = self.tri_msg
             self._renew_counters()
 
             check_delaunay_exact_fast(
-                self._act_tri, self.triangles, self.triangle_opp,
-                self.triangle_info, tri_vote, exact_check_vi, org_act_num,
+                act_tri, self.triangles, self.triangle_opp,
+                self.triangle_info, tri_vote, exact_check_vi, act_tri_num,
                 self.counters, self.n_points - 1, self.point_vec,
                 self.pred_consts)
 
@@ -340,17 +342,39 @@ class GDel2D:
 
     def _do_flipping(self, check_mode):
         tri_num = self.triangles.shape[0]
+
+        # The active triangles and the accepted flips of the round are
+        # compacted and counted on the device, so that the kernels of the
+        # round are issued back to back, and the host reads both counts
+        # once at its end.
+        counts = self._flip_counts
+        counts.fill(0)
+        act_tri_num = counts[0:1]
+        flip_num = counts[1:2]
+
+        prev_act_tri, act_tri = self._act_tri_bufs
+        self._act_tri_bufs = (act_tri, prev_act_tri)
         if self._act_tri_mode == ActTriMode.ActTriMarkCompact:
-            active_tri = is_tri_active(self.triangle_info)
-            self._act_tri = cupy.arange(0, active_tri.shape[0])
-            self._act_tri = self._act_tri[active_tri].astype(cupy.int32)
+            collect_active_tris(self.triangle_info, act_tri, act_tri_num)
         elif self._act_tri_mode == ActTriMode.ActTriCollectCompact:
-            self._act_tri = self._act_tri[self._act_tri >= 0]
+            compact_act_tris(self._act_tri, act_tri, act_tri_num)
+
+        # Vote for flips
+        tri_vote = self._tri_vote
+        tri_vote.fill(0x7FFFFFFF)
+        self._dispatch_check_delaunay(
+            check_mode, act_tri, act_tri_num, tri_vote)
+
+        # Mark rejected flips and compact the others
+        flip_to_tri = self._flip_to_tri
+        mark_rejected_flips(
+            act_tri, self.triangle_opp, tri_vote, self.triangle_info,
+            flip_to_tri, act_tri_num, flip_num)
 
-        org_act_num = self._act_tri.shape[0]
+        org_act_num, flip_num = counts.tolist()
 
         # Check actNum, switch mode or quit if necessary
-        if org_act_num == 0:
+        if flip_num == 0:
             # No more work
             return False
 
@@ -367,24 +391,7 @@ class GDel2D:
         else:
             self._act_tri_mode = ActTriMode.ActTriMarkCompact
 
-        # Vote for flips
-        tri_vote = cupy.full(tri_num, 0x7FFFFFFF, dtype=cupy.int32)
-        self._dispatch_check_delaunay(check_mode, org_act_num, tri_vote)
-
-        # Mark rejected flips
-        flip_to_tri = cupy.empty(org_act_num, dtype=cupy.int32)
-        mark_rejected_flips(
-            self._act_tri, self.triangle_opp, tri_vote, self.triangle_info,
-            flip_to_tri, org_act_num)
-
-        del tri_vote
-
-        # Compact flips
-        flip_to_tri = flip_to_tri[flip_to_tri >= 0]
-        flip_num = flip_to_tri.shape[0]
-
-        if flip_num == 0:
-            return False
+        flip_to_tri = flip_to_tri[:flip_num]
 
         # Expand flip vector
         org_flip_num = self._flip_vec_sz
@@ -407,14 +414,13 @@ class GDel2D:
         # when we clear the flipVec and reset the flip indexing.
         self._resize_tri_msg(self.triangles.shape[0])
 
-        # Expand active tri vector
+        # Expand active tri vector, whose buffer holds all the triangles
         if self._act_tri_mode == ActTriMode.ActTriCollectCompact:
-            self._act_tri = self._expand_copy(
-                self._act_tri, org_act_num + flip_num)
+            self._act_tri = act_tri[:org_act_num + flip_num]
 
         # Flipping
         flip(flip_to_tri, self.triangles, self.triangle_opp,
-             self.triangle_info, self.tri_msg, self._act_tri, self.flip_vec,
+             self.triangle_info, self.tri_msg, act_tri, self.flip_vec,
              org_flip_num, org_act_num,
              int(self._act_tri_mode == ActTriMode.ActTriCollectCompact))
 
@@ -461,6 +467,15 @@ class GDel2D:
             (self.max_triangles, 2), -1, dtype=cupy.int32)
         self._tri_msg_sz = 0
 
+        # The number of triangles does not change while flipping, and it
+        # bounds the active triangles and the flips of every round.
+        tri_num = self.triangles.shape[0]
+        self._act_tri_bufs = (cupy.empty(tri_num, dtype=cupy.int32),
+                              cupy.empty(tri_num, dtype=cupy.int32))
+        self._flip_to_tri = cupy.empty(tri_num, dtype=cupy.int32)
+        self._tri_vote = cupy.empty(tri_num, dtype=cupy.int32)
+        self._flip_counts = cupy.empty(2, dtype=cupy.int32)
+
         self._act_tri_mode = ActTriMode.ActTriMarkCompact
 
         flip_loop = 0
@@ -471,6 +486,10 @@ class GDel2D:
 
         self._flip_vec = None
         self._act_tri = None
+        self._act_tri_bufs = None
+        self._flip_to_tri = None
+        self._tri_vote = None
+        self._flip_counts = None
         self._tri_msg = None
 
     def _split_and_flip(self):
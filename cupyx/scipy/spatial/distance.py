@@ -1,4 +1,5 @@
 import cupy
+from cupyx.scipy.spatial import _pairwise
 try:
     from pylibraft.distance import pairwise_distance
     pylibraft_available = True
@@ -478,9 +479,12 @@ def cdist(XA, XB, metric='euclidean', out=None, **kwargs):
             returned. For each :math:`i` and :math:`j`, the metric
             ``dist(u=XA[i], v=XB[j])`` is computed and stored in the
             :math:`ij` th entry.
+
+    .. note::
+        The 'chebyshev', 'cityblock', 'cosine', 'euclidean', 'minkowski' and
+        'sqeuclidean' metrics are computed by CuPy. The other metrics
+        require ``pylibraft``.
     """
-    if not pylibraft_available:
-        raise RuntimeError('pylibraft is not installed')
     XA = cupy.asarray(XA, dtype='float32')
     XB = cupy.asarray(XB, dtype='float32')
 
@@ -511,6 +515,18 @@ def cdist(XA, XB, metric='euclidean', out=None, **kwargs):
         mstr = metric.lower()
         metric_info = _METRIC_ALIAS.get(mstr, None)
         if metric_info is not None:
+            name = metric_info.canonical_name_
+            if name in _pairwise.METRICS:
+                if out is not None and out.flags.c_contiguous:
+                    return _pairwise.pairwise_distances(
+                        XA, XB, name, p=p, out=out)
+                output_arr = _pairwise.pairwise_distances(XA, XB, name, p=p)
+                if out is None:
+                    return output_arr
+                out[...] = output_arr
+                return out
+            if not pylibraft_available:
+                raise RuntimeError('pylibraft is not installed')
             output_arr = out if out is not None else cupy.zeros((mA, mB),
                                                                 dtype=XA.dtype)
             pairwise_distance(XA, XB, output_arr, metric, p=p)
@@ -521,6 +537,91 @@ def cdist(XA, XB, metric='euclidean', out=None, **kwargs):
         raise TypeError('2nd argument metric must be a string identifier')
 
 
+def _pairwise_metric(metric):
+    if not isinstance(metric, str):
+        raise TypeError('metric must be a string identifier')
+    metric_info = _METRIC_ALIAS.get(metric.lower(), None)
+    if metric_info is None:
+        raise ValueError('Unknown Distance Metric: %s' % metric)
+    name = metric_info.canonical_name_
+    if name not in _pairwise.METRICS:
+        raise NotImplementedError(
+            'metric {} is not supported'.format(name))
+    return name
+
+
+def cdist_topk(XA, XB, k, metric='euclidean', *, p=2.0):
+    """Find the `k` nearest observations of `XB` to each observation of `XA`.
+
+    This function gives the `k` smallest entries of each row of
+    ``cdist(XA, XB, metric)`` without computing the distance matrix: the
+    distances of a tile of the pairs are merged into the row-wise candidates
+    as soon as the tile is computed.
+
+    Args:
+        XA (array_like): An :math:`m_A` by :math:`n` array of :math:`m_A`
+            original observations in an :math:`n`-dimensional space.
+        XB (array_like): An :math:`m_B` by :math:`n` array of :math:`m_B`
+            original observations in an :math:`n`-dimensional space.
+        k (int): The number of neighbors, between 1 and :math:`m_B`.
+        metric (str, optional): The distance metric to use, among
+            'chebyshev', 'cityblock', 'cosine', 'euclidean', 'minkowski' and
+            'sqeuclidean'.
+        p (float, optional): The p-norm to apply for Minkowski.
+            Default: 2.0
+
+    Returns:
+        tuple of cupy.ndarray: The :math:`m_A` by `k` arrays of the
+        distances, sorted in ascending order, and of the indices of the
+        observations of `XB`. The ties are in the order of the indices.
+
+    .. note::
+        The distances are computed in double precision for ``float64``
+        inputs (and integer inputs), in single precision otherwise. This
+        function is specific to CuPy and does not exist in SciPy.
+
+    .. seealso:: :func:`cdist`, :class:`cupyx.scipy.spatial.KDTree`
+    """
+    name = _pairwise_metric(metric)
+    return _pairwise.pairwise_topk(XA, XB, int(k), name, p=p)
+
+
+def cdist_threshold(XA, XB, threshold, metric='euclidean', *, p=2.0):
+    """Find the pairs of observations within a distance of each other.
+
+    This function gives the sparse entries of ``cdist(XA, XB, metric)`` not
+    above `threshold` without computing the distance matrix: the distances
+    are computed once to count the pairs of each row, and once to write
+    them.
+
+    Args:
+        XA (array_like): An :math:`m_A` by :math:`n` array of :math:`m_A`
+            original observations in an :math:`n`-dimensional space.
+        XB (array_like): An :math:`m_B` by :math:`n` array of :math:`m_B`
+            original observations in an :math:`n`-dimensional space.
+        threshold (float): The largest distance of the pairs.
+        metric (str, optional): The distance metric to use, among
+            'chebyshev', 'cityblock', 'cosine', 'euclidean', 'minkowski' and
+            'sqeuclidean'.
+        p (float, optional): The p-norm to apply for Minkowski.
+            Default: 2.0
+
+    Returns:
+        tuple of cupy.ndarray: The indices of the observations of `XA` and
+        `XB` of the pairs, and their distances, sorted by rows then columns.
+
+    .. note::
+        The distances are computed in double precision for ``float64``
+        inputs (and integer inputs), in single precision otherwise. This
+        function is specific to CuPy and does not exist in SciPy.
+
+    .. seealso::
+        :func:`cdist`, :meth:`cupyx.scipy.spatial.KDTree.query_ball_point`
+    """
+    name = _pairwise_metric(metric)
+    return _pairwise.pairwise_threshold(XA, XB, threshold, name, p=p)
+
+
 def pdist(X, metric='euclidean', *, out=None, **kwargs):
     """Compute distance between observations in n-dimensional space.
 
@@ -5,6 +5,7 @@ from cupyx.scipy.special._bessel import i1  # NOQA
 from cupyx.scipy.special._bessel import i1e  # NOQA
 from cupyx.scipy.special._bessel import j0  # NOQA
 from cupyx.scipy.special._bessel import j1  # NOQA
+from cupyx.scipy.special._bessel import jn_orders  # NOQA
 from cupyx.scipy.special._bessel import k0  # NOQA
 from cupyx.scipy.special._bessel import k0e  # NOQA
 from cupyx.scipy.special._bessel import k1  # NOQA
@@ -12,7 +13,10 @@ from cupyx.scipy.special._bessel import k1e  # NOQA
 from cupyx.scipy.special._bessel import y0  # NOQA
 from cupyx.scipy.special._bessel import y1  # NOQA
 from cupyx.scipy.special._bessel import yn  # NOQA
+from cupyx.scipy.special._bessel import yn_orders  # NOQA
 from cupyx.scipy.special._spherical_bessel import spherical_yn  # NOQA
+from cupyx.scipy.special._spherical_bessel import spherical_jn_orders  # NOQA
+from cupyx.scipy.special._spherical_bessel import spherical_yn_orders  # NOQA
 from cupyx.scipy.special._wright_bessel import wright_bessel  # NOQA
 
 # Raw statistical functions
@@ -83,6 +87,7 @@ from cupyx.scipy.special._erf import erfcinv  # NOQA
 # Legendre functions
 from cupyx.scipy.special._lpmv import lpmv  # NOQA
 from cupyx.scipy.special._sph_harm import sph_harm  # NOQA
+from cupyx.scipy.special._sph_harm import sph_harm_orders  # NOQA
 
 # Other special functions
 from cupyx.scipy.special._binom import binom  # NOQA
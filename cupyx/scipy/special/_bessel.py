@@ -6,6 +6,12 @@
 # Cephes Math Library Release 2.8:  June, 2000
 # Copyright 1984, 1987, 1992, 2000 by Stephen L. Moshier
 
+import functools
+import operator
+
+import numpy
+
+import cupy
 from cupy import _core
 from cupyx.scipy.special._gamma import chbevl_implementation
 
@@ -460,3 +466,194 @@ k1e = _core.create_ufunc(
     .. seealso:: :meth:`scipy.special.k1e`
 
     ''')
+
+
+# The Bessel functions of integer orders 0..n_max at a point, written to the
+# n_max + 1 contiguous elements of out. The forward recurrence is stable for
+# the orders below |x|; above, J is computed by the backward recurrence of
+# Miller's algorithm.
+bessel_orders_definition = """
+#include <cupy/math_constants.h>
+
+// Miller's algorithm for the minimal solution of
+// f[k - 1] = (2 * k + s) / x * f[k] - f[k + 1], x > 0: the cylindrical
+// functions J_k when s is 0, normalized with J_0 + 2 J_2 + 2 J_4 + ... = 1,
+// and the spherical functions j_k when s is 1, normalized with j_0 or j_1.
+// The values are rescaled to avoid an overflow; the first pass finds the
+// normalization and the number of rescalings, and the second one writes
+// the values.
+template<typename T>
+__device__ void bessel_miller(double x, int n_max, int s, T* out) {
+    int m = 2 * ((n_max + (int)sqrt(160.0 * n_max) + 10) / 2);
+    double b, bp, sum;
+    int n_rescale = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        double norm = 0.0;
+        if (pass == 1) {
+            if (s == 0) {
+                norm = 1.0 / (2.0 * sum + b);
+            } else {
+                double sj0 = sin(x) / x;
+                double sj1 = (sj0 - cos(x)) / x;
+                norm = fabs(sj0) >= fabs(sj1) ? sj0 / b : sj1 / bp;
+            }
+        }
+        bp = 0.0;
+        b = 1.0;
+        sum = 0.0;
+        for (int k = m; k > 0; k--) {
+            double bm = (2.0 * k + s) / x * b - bp;
+            bp = b;
+            b = bm;
+            if (fabs(b) > 1e250) {
+                b *= 1e-250;
+                bp *= 1e-250;
+                sum *= 1e-250;
+                n_rescale += pass == 0 ? 1 : -1;
+            }
+            if (pass == 0 && (k - 1) % 2 == 0 && k > 1) {
+                sum += b;
+            } else if (pass == 1 && k - 1 <= n_max) {
+                // the values are negligible below the last two scales
+                out[k - 1] = n_rescale == 0 ? b * norm
+                    : n_rescale == 1 ? b * 1e-250 * norm : 0.0;
+            }
+        }
+    }
+}
+
+template<typename T>
+__device__ void bessel_jn_orders(double x, int n_max, T* out) {
+    double ax = fabs(x);
+    if (isnan(x) || isinf(x) || ax == 0.0) {
+        for (int k = 0; k <= n_max; k++) {
+            out[k] = isnan(x) ? x : 0.0;
+        }
+        if (ax == 0.0) {
+            out[0] = 1;
+        }
+        return;
+    }
+    if (n_max < ax) {
+        double b0 = j0(ax), b1 = j1(ax);
+        out[0] = b0;
+        if (n_max >= 1) {
+            out[1] = b1;
+        }
+        for (int k = 1; k < n_max; k++) {
+            double b = 2.0 * k / ax * b1 - b0;
+            b0 = b1;
+            b1 = b;
+            out[k + 1] = b;
+        }
+    } else {
+        bessel_miller(ax, n_max, 0, out);
+    }
+    if (x < 0) {
+        for (int k = 1; k <= n_max; k += 2) {
+            out[k] = -out[k];
+        }
+    }
+}
+
+template<typename T>
+__device__ void bessel_yn_orders(double x, int n_max, T* out) {
+    double b0, b1;
+    if (isnan(x) || x < 0) {
+        b0 = b1 = CUDART_NAN;
+    } else if (x == 0) {
+        b0 = b1 = -CUDART_INF;
+    } else {
+        b0 = y0(x);
+        b1 = y1(x);
+    }
+    out[0] = b0;
+    if (n_max >= 1) {
+        out[1] = b1;
+    }
+    for (int k = 1; k < n_max; k++) {
+        // the recurrence is stable, and the values overflow to -inf
+        double b = isinf(b1) ? b1 : 2.0 * k / x * b1 - b0;
+        b0 = b1;
+        b1 = b;
+        out[k + 1] = b;
+    }
+}
+"""
+
+
+def _evaluate_orders(kernel, n_max, args, order_shape, complex_output=False):
+    # Runs an ElementwiseKernel that writes the orders at each point of the
+    # broadcast args to a contiguous (points, orders) output.
+    n_max = operator.index(n_max)
+    if n_max < 0:
+        raise ValueError('n_max must be non-negative')
+    args = [cupy.asarray(a) for a in args]
+    if any(a.dtype.kind == 'c' for a in args):
+        raise NotImplementedError('complex arguments are not supported')
+    dtype = functools.reduce(
+        numpy.promote_types, [a.dtype for a in args], numpy.dtype('f'))
+    shape = cupy.broadcast(*args).shape
+    if complex_output:
+        out_dtype = numpy.promote_types(dtype, numpy.complex64)
+    else:
+        out_dtype = dtype
+    out = cupy.empty(shape + order_shape, out_dtype)
+    kernel(*[a.astype(dtype, copy=False) for a in args], n_max, out)
+    return out
+
+
+_jn_orders_kernel = _core.ElementwiseKernel(
+    'T x, int32 n_max', 'raw T out',
+    'bessel_jn_orders(x, n_max, &out[i * (n_max + 1)])',
+    'cupyx_scipy_special_jn_orders', preamble=bessel_orders_definition)
+
+
+_yn_orders_kernel = _core.ElementwiseKernel(
+    'T x, int32 n_max', 'raw T out',
+    'bessel_yn_orders(x, n_max, &out[i * (n_max + 1)])',
+    'cupyx_scipy_special_yn_orders', preamble=bessel_orders_definition)
+
+
+def jn_orders(n_max, x):
+    """Bessel functions of the first kind of the orders 0 to ``n_max``.
+
+    All the orders are computed at each point by a single recurrence, which
+    is faster than evaluating :func:`scipy.special.jv` for each order.
+
+    Args:
+        n_max (int): The maximum order.
+        x (cupy.ndarray): Real arguments.
+
+    Returns:
+        cupy.ndarray: An array of shape ``x.shape + (n_max + 1,)``, whose
+        element ``[..., n]`` is the Bessel function of order ``n`` at ``x``.
+
+    .. note::
+        This function is specific to CuPy and does not exist in SciPy.
+
+    .. seealso:: :meth:`scipy.special.jv`
+    """
+    return _evaluate_orders(_jn_orders_kernel, n_max, (x,), (n_max + 1,))
+
+
+def yn_orders(n_max, x):
+    """Bessel functions of the second kind of the orders 0 to ``n_max``.
+
+    All the orders are computed at each point by the forward recurrence,
+    which is faster than evaluating :func:`scipy.special.yn` for each order.
+
+    Args:
+        n_max (int): The maximum order.
+        x (cupy.ndarray): Real arguments.
+
+    Returns:
+        cupy.ndarray: An array of shape ``x.shape + (n_max + 1,)``, whose
+        element ``[..., n]`` is the Bessel function of order ``n`` at ``x``.
+
+    .. note::
+        This function is specific to CuPy and does not exist in SciPy.
+
+    .. seealso:: :meth:`scipy.special.yn`
+    """
+    return _evaluate_orders(_yn_orders_kernel, n_max, (x,), (n_max + 1,))
@@ -33,18 +33,70 @@ template<int N> static __device__ double polevl(double x, double coef[])
 digamma_preamble = "#include <cupy/xsf/digamma.h>"
 
 
+# The single precision digamma function. xsf::digamma(float) evaluates the
+# double precision implementation; this one is evaluated in float with the
+# rational approximations of Boost.Math for 24-bit precision: the recurrence
+# moves x into [1, 2], where the approximation is centered on the positive
+# root, and the asymptotic series is used for x >= 10. The error is at most
+# 3 ulp for x > 0, and 10 ulp for x < 0 away from the zeros of the function,
+# where the absolute error is at most 1e-6.
+digamma_float32_definition = '''
+__device__ float digamma_float32(float x) {
+    float y = 0.0f;
+    if (isnan(x) || x == CUDART_INF_F) {
+        return x;
+    }
+    if (x <= 0.0f) {
+        if (x == 0.0f) {
+            return copysignf(CUDART_INF_F, -x);
+        }
+        if (x == floorf(x)) {
+            return CUDART_NAN_F;
+        }
+        // sinpif and cospif reduce the argument exactly
+        y = -3.14159265358979f * cospif(x) / sinpif(x);
+        x = 1.0f - x;
+    }
+    if (x >= 10.0f) {
+        x -= 1.0f;
+        float z = 1.0f / (x * x);
+        float p = (0.003968253968253968f * z - 0.0083333333333333333f) * z
+                  + 0.083333333333333333f;
+        return y + (logf(x) + 0.5f / x - z * p);
+    }
+    while (x > 2.0f) {
+        x -= 1.0f;
+        y += 1.0f / x;
+    }
+    if (x < 1.0f) {
+        y -= 1.0f / x;
+        x += 1.0f;
+    }
+    // the root is split into two floats
+    float g = (x - 1532632.0f / 1048576.0f) - 0.3700660185912626595e-6f;
+    float t = x - 1.0f;
+    float p = ((-0.61041765350579073e-1f * t - 0.43916936919946835f) * t
+               - 0.44981331915268368f) * t + 0.25479851023250261f;
+    float q = ((0.63851690523355715e-1f * t + 0.65341249856146947f) * t
+               + 1.5890202430554952f) * t + 1.0f;
+    return y + (g * 0.99558162689208984f + g * (p / q));
+}
+'''
+
+
 digamma = _core.create_ufunc(
     'cupyx_scipy_special_digamma',
     (
         ('l->d', 'out0 = xsf::digamma(double(in0))'),
         ('e->d', 'out0 = xsf::digamma(double(in0))',),
-        'f->f',
+        ('f->f', 'out0 = digamma_float32(in0)'),
         'd->d',
         'F->F',
         'D->D',
     ),
     'out0 = xsf::digamma(in0)',
-    preamble=digamma_preamble,
+    preamble=(digamma_preamble + '\n#include <cupy/math_constants.h>\n'
+              + digamma_float32_definition),
     doc="""The digamma function.
 
     Args:
@@ -53,6 +105,11 @@ digamma = _core.create_ufunc(
     Returns:
         cupy.ndarray: Computed value of digamma function.
 
+    .. note::
+        For float32 inputs, the function is evaluated in single precision
+        with an error of at most 3 ulp for positive inputs, and 10 ulp for
+        negative inputs away from the zeros of the function.
+
     .. seealso:: :data:`scipy.special.digamma`
 
     """)
@@ -7,6 +7,7 @@ https://github.com/scipy/scipy/blob/master/scipy/special/sph_harm.pxd
 
 from cupy import _core
 
+from cupyx.scipy.special._bessel import _evaluate_orders
 from cupyx.scipy.special._poch import poch_definition
 from cupyx.scipy.special._lpmv import lpmv_definition
 
@@ -82,3 +83,92 @@ sph_harm = _core.create_ufunc(
 
     """,
 )
+
+
+# All the spherical harmonics of degrees 0..n_max at a point, written to
+# out[n * (2 * n_max + 1) + m + n_max]. The orthonormalized associated
+# Legendre functions are computed by the stable recurrences along the
+# diagonal and then along the degrees, and the negative orders follow from
+# Y_n^{-m} = (-1)^m conj(Y_n^m).
+sph_harmonic_orders_definition = """
+#include <cupy/complex.cuh>
+
+template<typename T>
+__device__ void sph_harmonic_orders(
+        double theta, double phi, int n_max, complex<T>* out) {
+    int width = 2 * n_max + 1;
+    double x = cos(phi), s = sin(phi);
+    double pmm = sqrt(0.25 / 3.141592653589793238462643383279502884);
+    for (int n = 0; n <= n_max; n++) {
+        for (int m = n + 1; m <= n_max; m++) {
+            out[n * width + n_max + m] = 0;
+            out[n * width + n_max - m] = 0;
+        }
+    }
+    for (int m = 0; m <= n_max; m++) {
+        if (m > 0) {
+            // includes the Condon-Shortley phase
+            pmm *= -sqrt((2.0 * m + 1.0) / (2.0 * m)) * s;
+        }
+        complex<double> e = exp(complex<double>(0, m * theta));
+        double sign = m % 2 == 0 ? 1.0 : -1.0;
+        double p2 = 0.0, p1 = pmm;
+        for (int n = m; n <= n_max; n++) {
+            double p = p1;
+            if (n == m + 1) {
+                p = sqrt(2.0 * m + 3.0) * x * pmm;
+            } else if (n > m + 1) {
+                double a = sqrt((4.0 * n * n - 1.0) / ((double)n * n - m * m));
+                double b = sqrt((((double)n - 1) * (n - 1) - m * m)
+                                / (4.0 * (n - 1) * (n - 1) - 1.0));
+                p = a * (x * p1 - b * p2);
+            }
+            if (n > m) {
+                p2 = p1;
+                p1 = p;
+            }
+            complex<double> v = p * e;
+            out[n * width + n_max + m] = complex<T>(v);
+            out[n * width + n_max - m] = complex<T>(sign * conj(v));
+        }
+    }
+}
+"""
+
+
+_sph_harm_orders_kernel = _core.ElementwiseKernel(
+    'T theta, T phi, int32 n_max', 'raw Y out',
+    'sph_harmonic_orders(theta, phi, n_max,'
+    ' &out[i * (n_max + 1) * (2 * n_max + 1)])',
+    'cupyx_scipy_special_sph_harm_orders',
+    preamble=sph_harmonic_orders_definition)
+
+
+def sph_harm_orders(n_max, theta, phi):
+    """Spherical harmonics of all the degrees and orders up to ``n_max``.
+
+    All the degrees and orders are computed at each point by a single
+    recurrence, which is faster than evaluating :func:`sph_harm` for each
+    of them. The arguments follow the conventions of :func:`sph_harm`.
+
+    Args:
+        n_max (int): The maximum degree.
+        theta (cupy.ndarray): Azimuthal (longitudinal) coordinates.
+        phi (cupy.ndarray): Polar (colatitudinal) coordinates.
+
+    Returns:
+        cupy.ndarray: A complex array of shape
+        ``shape + (n_max + 1, 2 * n_max + 1)``, where ``shape`` is the
+        broadcast shape of `theta` and `phi`, whose element
+        ``[..., n, n_max + m]`` is the spherical harmonic of order ``m`` and
+        degree ``n``. The elements with ``abs(m) > n`` are zero.
+
+    .. note::
+        This function is specific to CuPy and does not exist in SciPy.
+
+    .. seealso:: :meth:`scipy.special.sph_harm`
+
+    """
+    return _evaluate_orders(
+        _sph_harm_orders_kernel, n_max, (theta, phi),
+        (n_max + 1, 2 * n_max + 1), complex_output=True)
@@ -1,5 +1,7 @@
 import cupy
 from cupy import _core
+from cupyx.scipy.special._bessel import _evaluate_orders
+from cupyx.scipy.special._bessel import bessel_orders_definition
 
 spherical_bessel_preamble = """
 #include <cupy/math_constants.h>
@@ -90,6 +92,151 @@ _spherical_dyn_real = _core.create_ufunc(
 )
 
 
+spherical_bessel_orders_definition = bessel_orders_definition + """
+template<typename T>
+__device__ void spherical_jn_orders(double x, int n_max, T* out) {
+    double ax = fabs(x);
+    if (isnan(x) || isinf(x) || ax == 0.0) {
+        for (int k = 0; k <= n_max; k++) {
+            out[k] = isnan(x) ? x : 0.0;
+        }
+        if (ax == 0.0) {
+            out[0] = 1;
+        }
+        return;
+    }
+    if (n_max < ax) {
+        double s0 = sin(ax) / ax;
+        double s1 = (s0 - cos(ax)) / ax;
+        out[0] = s0;
+        if (n_max >= 1) {
+            out[1] = s1;
+        }
+        for (int k = 2; k <= n_max; k++) {
+            double s = (2.0 * k - 1.0) * s1 / ax - s0;
+            s0 = s1;
+            s1 = s;
+            out[k] = s;
+        }
+    } else {
+        bessel_miller(ax, n_max, 1, out);
+    }
+    if (x < 0) {
+        for (int k = 1; k <= n_max; k += 2) {
+            out[k] = -out[k];
+        }
+    }
+}
+
+template<typename T>
+__device__ void spherical_yn_orders(double x, int n_max, T* out) {
+    double ax = fabs(x);
+    double s0, s1;
+    if (isnan(x)) {
+        s0 = s1 = x;
+    } else if (isinf(x)) {
+        s0 = s1 = 0.0;
+    } else if (x == 0) {
+        s0 = s1 = -CUDART_INF;
+    } else {
+        s0 = -cos(ax) / ax;
+        s1 = (s0 - sin(ax)) / ax;
+    }
+    double sign = x < 0 ? -1.0 : 1.0;
+    out[0] = sign * s0;
+    if (n_max >= 1) {
+        out[1] = s1;
+    }
+    for (int k = 2; k <= n_max; k++) {
+        double s = isinf(s1) ? s1 : (2.0 * k - 1.0) * s1 / ax - s0;
+        s0 = s1;
+        s1 = s;
+        out[k] = (k % 2 == 0 ? sign : 1.0) * s;
+    }
+}
+"""
+
+
+_spherical_jn_orders_kernel = _core.ElementwiseKernel(
+    'T x, int32 n_max', 'raw T out',
+    'spherical_jn_orders(x, n_max, &out[i * (n_max + 1)])',
+    'cupyx_scipy_special_spherical_jn_orders',
+    preamble=spherical_bessel_orders_definition)
+
+
+_spherical_yn_orders_kernel = _core.ElementwiseKernel(
+    'T x, int32 n_max', 'raw T out',
+    'spherical_yn_orders(x, n_max, &out[i * (n_max + 1)])',
+    'cupyx_scipy_special_spherical_yn_orders',
+    preamble=spherical_bessel_orders_definition)
+
+
+def spherical_jn_orders(n_max, z):
+    """Spherical Bessel functions of the first kind of the orders 0 to n_max.
+
+    All the orders are computed at each point by a single recurrence, which
+    is faster than evaluating :func:`scipy.special.spherical_jn` for each
+    order.
+
+    Parameters
+    ----------
+    n_max : int
+        The maximum order.
+    z : cupy.ndarray
+        Real-valued arguments.
+
+    Returns
+    -------
+    jn : cupy.ndarray
+        An array of shape ``z.shape + (n_max + 1,)``, whose element
+        ``[..., n]`` is the spherical Bessel function of order ``n`` at `z`.
+
+    Notes
+    -----
+    This function is specific to CuPy and does not exist in SciPy.
+
+    See Also
+    -------
+    :func:`scipy.special.spherical_jn`
+
+    """
+    return _evaluate_orders(
+        _spherical_jn_orders_kernel, n_max, (z,), (n_max + 1,))
+
+
+def spherical_yn_orders(n_max, z):
+    """Spherical Bessel functions of the second kind of the orders 0 to n_max.
+
+    All the orders are computed at each point by the forward recurrence,
+    which is faster than evaluating :func:`scipy.special.spherical_yn` for
+    each order.
+
+    Parameters
+    ----------
+    n_max : int
+        The maximum order.
+    z : cupy.ndarray
+        Real-valued arguments.
+
+    Returns
+    -------
+    yn : cupy.ndarray
+        An array of shape ``z.shape + (n_max + 1,)``, whose element
+        ``[..., n]`` is the spherical Bessel function of order ``n`` at `z`.
+
+    Notes
+    -----
+    This function is specific to CuPy and does not exist in SciPy.
+
+    See Also
+    -------
+    :func:`scipy.special.spherical_yn`
+
+    """
+    return _evaluate_orders(
+        _spherical_yn_orders_kernel, n_max, (z,), (n_max + 1,))
+
+
 def spherical_yn(n, z, derivative=False):
     """Spherical Bessel function of the second kind or its derivative.
 
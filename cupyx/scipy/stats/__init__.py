@@ -2,6 +2,8 @@
 
 from cupyx.scipy.stats._distributions import entropy  # NOQA
 from cupyx.scipy.stats._stats import trim_mean  # NOQA
+from cupyx.scipy.stats._stats_py import kurtosis  # NOQA
+from cupyx.scipy.stats._stats_py import skew  # NOQA
 
 
 # Other statistical functionality
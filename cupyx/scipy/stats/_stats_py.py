@@ -1,4 +1,7 @@
+import numpy
+
 import cupy
+from cupyx._moments import moments
 
 
 def _first(arr, axis):
@@ -136,3 +139,84 @@ def zmap(scores, compare, axis=0, ddof=0, nan_policy='propagate'):
     # Set the outputs associated with a constant input to nan.
     z[cupy.broadcast_to(isconst, z.shape)] = cupy.nan
     return z
+
+
+def _moment_state(a, axis, nan_policy):
+    policies = ['propagate', 'raise', 'omit']
+    if nan_policy not in policies:
+        raise ValueError("nan_policy must be one of {%s}" %
+                         ', '.join("'%s'" % s for s in policies))
+    a = cupy.asarray(a)
+    if nan_policy == 'raise' and a.dtype.kind == 'f':
+        if cupy.isnan(a).any():  # synchronize!
+            raise ValueError("The input contains nan values")
+    state = moments(a, axis=axis, skipna=nan_policy == 'omit')
+    dtype = a.dtype if a.dtype.kind == 'f' else numpy.float64
+    return state, dtype
+
+
+def skew(a, axis=0, bias=True, nan_policy='propagate'):
+    """Compute the sample skewness of a data set.
+
+    The moments are computed in a single pass over ``a``; see
+    :func:`cupyx.moments`.
+
+    Parameters
+    ----------
+    a : cupy.ndarray
+        Input array.
+    axis : int or None, optional
+        Axis along which skewness is calculated. Default is 0.
+        If None, compute over the whole array `a`.
+    bias : bool, optional
+        If False, then the calculations are corrected for statistical bias.
+    nan_policy : {'propagate', 'raise', 'omit'}, optional
+        Defines how to handle when input contains nan. 'propagate'
+        returns nan, 'raise' throws an error, 'omit' performs
+        the calculations ignoring nan values. Default is 'propagate'.
+
+    Returns
+    -------
+    skewness : cupy.ndarray
+        The skewness of values along an axis, returning NaN where all
+        values are equal.
+
+    .. seealso:: :func:`scipy.stats.skew`
+    """
+    state, dtype = _moment_state(a, axis, nan_policy)
+    return state.skew(bias=bias).astype(dtype, copy=False)
+
+
+def kurtosis(a, axis=0, fisher=True, bias=True, nan_policy='propagate'):
+    """Compute the kurtosis (Fisher or Pearson) of a dataset.
+
+    The moments are computed in a single pass over ``a``; see
+    :func:`cupyx.moments`.
+
+    Parameters
+    ----------
+    a : cupy.ndarray
+        Input array.
+    axis : int or None, optional
+        Axis along which the kurtosis is calculated. Default is 0.
+        If None, compute over the whole array `a`.
+    fisher : bool, optional
+        If True, Fisher's definition is used (normal ==> 0.0). If False,
+        Pearson's definition is used (normal ==> 3.0).
+    bias : bool, optional
+        If False, then the calculations are corrected for statistical bias.
+    nan_policy : {'propagate', 'raise', 'omit'}, optional
+        Defines how to handle when input contains nan. 'propagate'
+        returns nan, 'raise' throws an error, 'omit' performs
+        the calculations ignoring nan values. Default is 'propagate'.
+
+    Returns
+    -------
+    kurtosis : cupy.ndarray
+        The kurtosis of values along an axis, returning NaN where all
+        values are equal.
+
+    .. seealso:: :func:`scipy.stats.kurtosis`
+    """
+    state, dtype = _moment_state(a, axis, nan_policy)
+    return state.kurtosis(fisher=fisher, bias=bias).astype(dtype, copy=False)
@@ -6,6 +6,7 @@ from cupyx.signal._convolution import convolve1d3o  # NOQA
 from cupyx.signal._filtering import channelize_poly  # NOQA
 from cupyx.signal._filtering import firfilter, firfilter2, firfilter_zi  # NOQA
 from cupyx.signal._filtering import freq_shift  # NOQA
+from cupyx.signal._peak_finding import find_peaks_batch  # NOQA
 from cupyx.signal._radartools import pulse_compression  # NOQA
 from cupyx.signal._radartools import pulse_doppler  # NOQA
 from cupyx.signal._radartools import cfar_alpha  # NOQA
@@ -0,0 +1 @@
+from cupyx.signal._peak_finding._peak_finding import find_peaks_batch  # NOQA
@@ -0,0 +1,96 @@
+import cupy
+from cupy._core.internal import _normalize_axis_index
+from cupyx.scipy.signal import _peak_finding
+
+
+# The properties that are indices or positions of samples
+_POSITION_KEYS = ('left_edges', 'right_edges', 'left_bases', 'right_bases',
+                  'left_ips', 'right_ips')
+
+
+def _move_condition(interval, x, axis):
+    # Moves the borders given as arrays matching `x` as `x` is moved
+    try:
+        imin, imax = interval
+    except (TypeError, ValueError):
+        imin, imax = (interval, None)
+    borders = []
+    for border in (imin, imax):
+        if isinstance(border, cupy.ndarray):
+            if border.size != x.size:
+                raise ValueError(
+                    'array size of interval border must match x')
+            border = cupy.moveaxis(border.reshape(x.shape), axis, -1)
+        borders.append(border)
+    return tuple(borders)
+
+
+def find_peaks_batch(x, height=None, threshold=None, distance=None,
+                     prominence=None, width=None, wlen=None, rel_height=0.5,
+                     plateau_size=None, axis=-1):
+    """
+    Find peaks inside each signal of a batch based on peak properties.
+
+    This function finds the peaks of each 1-D slice of `x` along `axis` as
+    :func:`cupyx.scipy.signal.find_peaks` does for one signal, with all the
+    signals processed together. The prominences and widths are computed by
+    range queries over tables of the block extrema of the signals, and the
+    distance condition is resolved on the device, so that the host only
+    waits for the number of local maxima and of selected peaks.
+
+    Parameters
+    ----------
+    x : ndarray
+        The signals with peaks, along `axis`.
+    height, threshold, distance, prominence, width, wlen, rel_height, \
+plateau_size :
+        The conditions of :func:`cupyx.scipy.signal.find_peaks`, which apply
+        to each signal. The borders of the intervals given as arrays must
+        match `x` in shape.
+    axis : int, optional
+        The axis of the signals. Default is -1.
+
+    Returns
+    -------
+    peaks : tuple of ndarray
+        The indices of the peaks in `x`, one array per dimension as in
+        :func:`cupy.nonzero`. The peaks are ordered by signal and by
+        position in the signal.
+    properties : dict
+        The properties of the peaks as in
+        :func:`cupyx.scipy.signal.find_peaks`. The edges, bases and
+        intersection points are positions along `axis`.
+
+    See Also
+    --------
+    cupyx.scipy.signal.find_peaks
+    """
+    x = cupy.asarray(x)
+    if x.ndim == 0:
+        raise ValueError('`x` must be at least 1-D')
+    axis = _normalize_axis_index(axis, x.ndim)
+    conditions = [None if c is None else _move_condition(c, x, axis)
+                  for c in (height, threshold, prominence, width,
+                            plateau_size)]
+    height, threshold, prominence, width, plateau_size = conditions
+
+    x = cupy.ascontiguousarray(cupy.moveaxis(x, axis, -1))
+    n = x.shape[-1]
+    flat_peaks, properties = _peak_finding._find_peaks(
+        x, n, height, threshold, distance, prominence, width, wlen,
+        rel_height, plateau_size)
+    positions = flat_peaks % n
+    offsets = flat_peaks - positions
+    for key in _POSITION_KEYS:
+        if key in properties:
+            properties[key] = properties[key] - offsets
+
+    # The signal of each peak is unraveled here, as `cupy.unravel_index`
+    # checks the indices on the host
+    indices = []
+    rows = flat_peaks // n
+    for dim in reversed(x.shape[:-1]):
+        indices.insert(0, rows % dim)
+        rows //= dim
+    indices.insert(axis, positions)
+    return tuple(indices), properties
@@ -0,0 +1,149 @@
+#!/usr/bin/env python
+
+"""
+Kernel Cache Bundle Tool
+
+Packs the kernel cache directory into a single bundle file, which can be
+shipped to other nodes and loaded with ``CUPY_CACHE_BUNDLE`` so that they
+start without compiling the kernels. The ``build`` action compiles the core
+ufuncs and reductions for the common dtypes ahead of time into the bundle
+installed with CuPy, which is looked up after those of ``CUPY_CACHE_BUNDLE``
+and before the cache directory.
+"""
+
+import argparse
+import json
+import os
+import shutil
+import sys
+import tempfile
+import warnings
+
+
+_default_dtypes = '?bBhHiIlLefdFD'
+
+# The ufuncs compiled by `build`, with the number of their inputs.
+_ufuncs = [
+    ('add', 2), ('subtract', 2), ('multiply', 2), ('true_divide', 2),
+    ('floor_divide', 2), ('power', 2), ('maximum', 2), ('minimum', 2),
+    ('equal', 2), ('not_equal', 2), ('less', 2), ('less_equal', 2),
+    ('greater', 2), ('greater_equal', 2), ('logical_and', 2),
+    ('negative', 1), ('absolute', 1), ('sqrt', 1), ('exp', 1), ('log', 1),
+    ('isnan', 1), ('logical_not', 1),
+]
+
+# The reductions compiled by `build`, over all the items and along the last
+# axis of a matrix.
+_reductions = ['sum', 'prod', 'max', 'min', 'argmax', 'argmin', 'any', 'all']
+
+
+def _compile_core_kernels(dtypes):
+    import cupy
+
+    count = 0
+    for dtype in dtypes:
+        x = cupy.zeros((1,), dtype)
+        m = cupy.zeros((1, 1), dtype)
+        with warnings.catch_warnings():
+            # the casts from complex to real numbers
+            warnings.simplefilter('ignore')
+            for other in dtypes:
+                x.astype(other)
+        calls = [(getattr(cupy, name), (x,) * n_in) for name, n_in in _ufuncs]
+        for name in _reductions:
+            func = getattr(cupy, name)
+            calls.append((func, (x,)))
+            calls.append((lambda a, func=func: func(a, axis=-1), (m,)))
+        for func, args in calls:
+            try:
+                func(*args)
+            except TypeError:
+                # no loop for the dtype
+                continue
+            count += 1
+    cupy.cuda.Device().synchronize()
+    return count
+
+
+def build(path, dtypes=_default_dtypes):
+    """Compiles the core kernels on the current device and bundles them.
+
+    The bundle is written to ``path``, or installed with CuPy for the
+    architecture of the current device when ``path`` is ``None``.
+    """
+    from cupy.cuda import compiler
+
+    if path is None:
+        path = compiler._get_installed_bundle_path()
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+    cache_dir = tempfile.mkdtemp()
+    env = {name: os.environ.get(name) for name in (
+        'CUPY_CACHE_DIR', 'CUPY_CACHE_IN_MEMORY')}
+    os.environ['CUPY_CACHE_DIR'] = cache_dir
+    os.environ['CUPY_CACHE_IN_MEMORY'] = '0'
+    # every kernel must be compiled into the fresh cache directory
+    bundles = compiler._bundles[:]
+    loaded = compiler._bundles_from_env_loaded
+    compiler._bundles[:] = []
+    compiler._bundles_from_env_loaded = True
+    try:
+        n_calls = _compile_core_kernels(dtypes)
+        count = compiler.export_cache_bundle(path, cache_dir)
+    finally:
+        compiler._bundles[:] = bundles
+        compiler._bundles_from_env_loaded = loaded
+        for name, value in env.items():
+            if value is None:
+                os.environ.pop(name, None)
+            else:
+                os.environ[name] = value
+        shutil.rmtree(cache_dir, ignore_errors=True)
+    return path, n_calls, count
+
+
+def main(args):
+    parser = argparse.ArgumentParser()
+    subparsers = parser.add_subparsers(dest='action', required=True)
+
+    export_parser = subparsers.add_parser(
+        'export', help='Pack the kernel cache into a bundle')
+    export_parser.add_argument('path', type=str, help='Bundle to write')
+    export_parser.add_argument('--cache-dir', type=str, default=None,
+                               help='Cache directory (CUPY_CACHE_DIR)')
+    export_parser.add_argument('--arch', type=str, default=None,
+                               help='Target architecture (current device)')
+
+    build_parser = subparsers.add_parser(
+        'build',
+        help='Compile the core ufuncs and reductions into a bundle')
+    build_parser.add_argument(
+        'path', type=str, nargs='?', default=None,
+        help='Bundle to write (the bundle installed with CuPy for the '
+             'architecture of the current device)')
+    build_parser.add_argument(
+        '--dtypes', type=str, default=_default_dtypes,
+        help=f'Dtype characters to compile for ({_default_dtypes})')
+
+    info_parser = subparsers.add_parser(
+        'info', help='Show the metadata of a bundle')
+    info_parser.add_argument('path', type=str, help='Bundle to read')
+    params = parser.parse_args(args)
+
+    from cupy.cuda import compiler
+    if params.action == 'export':
+        count = compiler.export_cache_bundle(
+            params.path, params.cache_dir, params.arch)
+        print(f'Exported {count} kernels to {params.path}')
+    elif params.action == 'build':
+        path, n_calls, count = build(params.path, params.dtypes)
+        print(f'Built {count} kernels from {n_calls} calls into {path}')
+    elif params.action == 'info':
+        bundle = compiler._CacheBundle(params.path)
+        info = dict(bundle.metadata, kernels=len(bundle))
+        print(json.dumps(info, indent=4))
+    else:
+        assert False
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
@@ -0,0 +1,84 @@
+import argparse
+import os
+import subprocess
+import sys
+
+
+# Runs in a child process: the time of the steps after the import, which
+# include the loading of the modules and binaries deferred by the import.
+_STEPS = '''
+import time
+t0 = time.perf_counter()
+import cupy
+t1 = time.perf_counter()
+cupy.cuda.runtime.free(cupy.cuda.runtime.malloc(1))
+t2 = time.perf_counter()
+a = cupy.arange(1 << 10, dtype=cupy.float32)[::-1]
+(a + 1).sum().item()
+t3 = time.perf_counter()
+cupy.sort(a).item(0)
+t4 = time.perf_counter()
+print(t1 - t0, t2 - t1, t3 - t2, t4 - t3)
+'''
+
+
+def parse_importtime(stderr, top):
+    # `-X importtime` prints "import time: self [us] | cumulative | name"
+    modules = []
+    for line in stderr.splitlines():
+        if not line.startswith('import time:') or 'self [us]' in line:
+            continue
+        self_us, cumulative, name = line[len('import time:'):].split('|')
+        modules.append((int(self_us), int(cumulative), name.rstrip()))
+    by_package = {}
+    for self_us, _, name in modules:
+        package = name.strip().split('.')[0]
+        by_package[package] = by_package.get(package, 0) + self_us
+    slowest = sorted(modules, key=lambda m: -m[0])[:top]
+    return slowest, sorted(by_package.items(), key=lambda p: -p[1])[:top]
+
+
+def run(env):
+    out = subprocess.run(
+        [sys.executable, '-X', 'importtime', '-c', _STEPS], env=env,
+        stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+        universal_newlines=True, check=True)
+    return [float(t) for t in out.stdout.split()], out.stderr
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Breaks down the time of importing CuPy and of its '
+                    'first calls')
+    parser.add_argument('--top', type=int, default=15,
+                        help='the number of modules and packages shown')
+    parser.add_argument('--eager', action='store_true',
+                        help='also run with CUDA_MODULE_LOADING=EAGER')
+    args = parser.parse_args()
+
+    modes = [('default', {})]
+    if args.eager:
+        modes.append(('eager', {'CUDA_MODULE_LOADING': 'EAGER',
+                                'HIP_ENABLE_DEFERRED_LOADING': '0'}))
+    for mode, extra in modes:
+        env = dict(os.environ)
+        env.update(extra)
+        times, stderr = run(env)
+        print('== {} =='.format(mode))
+        for step, t in zip(('import', 'first context', 'first kernel',
+                            'first sort'), times):
+            print('{:<16}{:>10.1f} ms'.format(step, t * 1e3))
+
+        slowest, packages = parse_importtime(stderr, args.top)
+        print('\n{:<12}{:>12}  {}'.format('self(ms)', 'cumul(ms)', 'module'))
+        for self_us, cumulative, name in slowest:
+            print('{:<12.1f}{:>12.1f}  {}'.format(
+                self_us / 1e3, cumulative / 1e3, name))
+        print('\n{:<12}  {}'.format('self(ms)', 'package'))
+        for package, self_us in packages:
+            print('{:<12.1f}  {}'.format(self_us / 1e3, package))
+        print()
+
+
+if __name__ == '__main__':
+    main()
@@ -3,6 +3,7 @@ import contextlib
 import time
 
 import cupy
+import cupyx
 import matplotlib.pyplot as plt
 import numpy
 
@@ -111,7 +112,15 @@ def draw(X, n_clusters, centers, pred, output):
     plt.savefig(output)
 
 
-def run(gpuid, n_clusters, num, max_iter, use_custom_kernel, output):
+def fit_cupyx(X, n_clusters, max_iter):
+    # The distances are computed by a matrix product and the labels and the
+    # sums of the clusters by a single kernel per iteration.
+    centers, pred, _, _ = cupyx.kmeans(X, n_clusters, max_iter=max_iter)
+    return centers, pred
+
+
+def run(gpuid, n_clusters, num, max_iter, use_custom_kernel, use_cupyx,
+        output):
     samples = numpy.random.randn(num, 2)
     X_train = numpy.r_[samples + 1, samples - 1]
 
@@ -122,7 +131,9 @@ def run(gpuid, n_clusters, num, max_iter, use_custom_kernel, output):
         X_train = cupy.asarray(X_train)
 
         with timer(' GPU '):
-            if use_custom_kernel:
+            if use_cupyx:
+                centers, pred = fit_cupyx(X_train, n_clusters, max_iter)
+            elif use_custom_kernel:
                 centers, pred = fit_custom(X_train, n_clusters, max_iter)
             else:
                 centers, pred = fit_xp(X_train, n_clusters, max_iter)
@@ -145,8 +156,10 @@ if __name__ == '__main__':
                         help='number of iterations')
     parser.add_argument('--use-custom-kernel', action='store_true',
                         default=False, help='use Elementwise kernel')
+    parser.add_argument('--use-cupyx', action='store_true', default=False,
+                        help='use cupyx.kmeans')
     parser.add_argument('--output-image', '-o', default=None, type=str,
                         help='output image file name')
     args = parser.parse_args()
     run(args.gpu_id, args.n_clusters, args.num, args.max_iter,
-        args.use_custom_kernel, args.output_image)
+        args.use_custom_kernel, args.use_cupyx, args.output_image)
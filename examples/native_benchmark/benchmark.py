@@ -0,0 +1,254 @@
+import argparse
+import contextlib
+import json
+import sys
+
+import numpy
+
+import cupy
+from cupy._core import _accelerator
+from cupyx import profiler
+
+
+def peak_bandwidth():
+    # The theoretical memory bandwidth of the current device in bytes/s.
+    attrs = cupy.cuda.Device().attributes
+    try:
+        return (2 * attrs['MemoryClockRate'] * 1000 *
+                attrs['GlobalMemoryBusWidth'] // 8)
+    except KeyError:
+        return None
+
+
+@contextlib.contextmanager
+def accelerators(names):
+    reduction = _accelerator.get_reduction_accelerators()
+    routine = _accelerator.get_routine_accelerators()
+    _accelerator.set_reduction_accelerators(names)
+    _accelerator.set_routine_accelerators(names)
+    try:
+        yield
+    finally:
+        _accelerator.set_reduction_accelerators(reduction)
+        _accelerator.set_routine_accelerators(routine)
+
+
+def make_input(dtype, size, layout):
+    # Returns the input and the axis to reduce, scan or sort along.
+    dtype = numpy.dtype(dtype)
+    x = cupy.random.default_rng(0).random(size, numpy.float32)
+    if dtype.kind in 'iu':
+        x = x * 1000
+    x = x.astype(dtype)
+    if layout == 'c':
+        return x, None
+    rows = 1024
+    x = x.reshape(size // rows, rows)
+    if layout == 'rows':
+        return x, 1
+    if layout == 'f':
+        return cupy.asfortranarray(x), 0
+    raise ValueError('unknown layout: {}'.format(layout))
+
+
+def reduce_cases(dtypes, sizes):
+    for op in ('sum', 'max', 'argmax'):
+        for dtype in dtypes:
+            for size in sizes:
+                for layout in ('c', 'rows', 'f'):
+                    x, axis = make_input(dtype, size, layout)
+                    func = getattr(cupy, op)
+                    yield (op, dtype, size, layout,
+                           lambda x=x, axis=axis, func=func: func(x, axis),
+                           x.nbytes)
+
+
+def scan_cases(dtypes, sizes):
+    for dtype in dtypes:
+        for size in sizes:
+            x, _ = make_input(dtype, size, 'c')
+            yield ('cumsum', dtype, size, 'c', lambda x=x: cupy.cumsum(x),
+                   2 * x.nbytes)
+
+
+def histogram_cases(dtypes, sizes):
+    for dtype in dtypes:
+        for size in sizes:
+            x, _ = make_input(dtype, size, 'c')
+            for bins in (16, 256, 4096):
+                yield ('histogram[{}]'.format(bins), dtype, size, 'c',
+                       lambda x=x, bins=bins: cupy.histogram(x, bins),
+                       x.nbytes)
+
+
+def sort_cases(dtypes, sizes):
+    for dtype in dtypes:
+        for size in sizes:
+            for layout in ('c', 'rows'):
+                x, axis = make_input(dtype, size, layout)
+                axis = -1 if axis is None else axis
+                # a radix sort reads and writes the keys a few times; the
+                # traffic of a single pass is used
+                yield ('sort', dtype, size, layout,
+                       lambda x=x, axis=axis: cupy.sort(x, axis), 2 * x.nbytes)
+                yield ('argsort', dtype, size, layout,
+                       lambda x=x, axis=axis: cupy.argsort(x, axis),
+                       x.nbytes + x.size * 8)
+            keys = cupy.stack([make_input(dtype, size, 'c')[0]] * 2)
+            yield ('lexsort', dtype, size, 'c',
+                   lambda keys=keys: cupy.lexsort(keys),
+                   keys.nbytes + size * 8)
+
+
+def _distributions(rng, size, dtype):
+    # name -> function of the distributions of cupy.random.Generator
+    float_dtype = {'dtype': dtype}
+    return {
+        'random': lambda: rng.random(size, **float_dtype),
+        'uniform': lambda: rng.uniform(0, 1, size, **float_dtype),
+        'standard_normal': lambda: rng.standard_normal(size, **float_dtype),
+        'standard_exponential':
+            lambda: rng.standard_exponential(size, **float_dtype),
+        'standard_gamma': lambda: rng.standard_gamma(2.0, size, **float_dtype),
+        'integers': lambda: rng.integers(0, 1000, size),
+        'exponential': lambda: rng.exponential(2.0, size),
+        'gamma': lambda: rng.gamma(2.0, 1.0, size),
+        'beta': lambda: rng.beta(2.0, 3.0, size),
+        'chisquare': lambda: rng.chisquare(3.0, size),
+        'f': lambda: rng.f(3.0, 4.0, size),
+        'power': lambda: rng.power(2.0, size),
+        'binomial': lambda: rng.binomial(10, 0.3, size),
+        'poisson': lambda: rng.poisson(3.0, size),
+        'geometric': lambda: rng.geometric(0.3, size),
+        'hypergeometric': lambda: rng.hypergeometric(10, 20, 5, size),
+        'logseries': lambda: rng.logseries(0.5, size),
+        'dirichlet': lambda: rng.dirichlet((1.0, 2.0, 3.0), size // 3),
+    }
+
+
+def random_cases(dtypes, sizes):
+    float_dtypes = [d for d in dtypes if numpy.dtype(d) in (
+        numpy.float32, numpy.float64)] or ['float64']
+    for dtype in float_dtypes:
+        for size in sizes:
+            rng = cupy.random.default_rng(0)
+            for name, func in _distributions(rng, size, dtype).items():
+                if dtype != 'float64' and name not in (
+                        'random', 'uniform', 'standard_normal',
+                        'standard_exponential', 'standard_gamma'):
+                    # the other distributions only generate one dtype
+                    continue
+                out = func()
+                yield (name, dtype, size, 'c', func, out.nbytes)
+
+
+suites = {
+    'reduce': reduce_cases,
+    'scan': scan_cases,
+    'histogram': histogram_cases,
+    'sort': sort_cases,
+    'random': random_cases,
+}
+
+
+def run(args):
+    peak = peak_bandwidth()
+    results = []
+    with accelerators(['cub']):
+        for suite in args.suites:
+            for op, dtype, size, layout, func, nbytes in suites[suite](
+                    args.dtypes, args.sizes):
+                try:
+                    perf = profiler.benchmark(
+                        func, n_repeat=args.n_repeat, n_warmup=args.n_warmup,
+                        name=op)
+                except (TypeError, ValueError, NotImplementedError) as e:
+                    # e.g. a dtype that the routine does not support
+                    print('{:>9} {:>22} {:>8} skipped: {}'.format(
+                        suite, op, str(dtype), e))
+                    continue
+                seconds = float(numpy.median(perf.gpu_times[0]))
+                result = {
+                    'suite': suite, 'op': op, 'dtype': str(dtype),
+                    'size': size, 'layout': layout,
+                    'time_us': seconds * 1e6,
+                    'gbs': nbytes / seconds * 1e-9,
+                    'elements_per_s': size / seconds,
+                    'peak_ratio': nbytes / seconds / peak if peak else None,
+                }
+                results.append(result)
+                print('{suite:>9} {op:>22} {dtype:>8} {size:>10} {layout:>4} '
+                      '{time_us:12.1f} us {gbs:9.1f} GB/s'.format(**result))
+    dev = cupy.cuda.Device()
+    meta = {
+        'cupy_version': cupy.__version__,
+        'backend': 'hip' if cupy.cuda.runtime.is_hip else 'cuda',
+        'runtime_version': cupy.cuda.runtime.runtimeGetVersion(),
+        'device': cupy.cuda.runtime.getDeviceProperties(dev.id)['name']
+        .decode(),
+        'peak_bandwidth_gbs': peak * 1e-9 if peak else None,
+    }
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump({'meta': meta, 'results': results}, f, indent=1)
+
+
+def compare(args):
+    def load(path):
+        with open(path) as f:
+            data = json.load(f)
+        return data['meta'], {
+            (r['suite'], r['op'], r['dtype'], r['size'], r['layout']): r
+            for r in data['results']}
+
+    base_meta, base = load(args.compare[0])
+    meta, new = load(args.compare[1])
+    print('base: {cupy_version} {backend} {device}'.format(**base_meta))
+    print('new:  {cupy_version} {backend} {device}'.format(**meta))
+    n_regressions = 0
+    for key in sorted(base.keys() & new.keys()):
+        ratio = new[key]['time_us'] / base[key]['time_us']
+        if ratio > 1 + args.threshold:
+            mark = 'SLOWER'
+            n_regressions += 1
+        elif ratio < 1 - args.threshold:
+            mark = 'faster'
+        else:
+            continue
+        print('{:>9} {:>22} {:>8} {:>10} {:>4} {:6.2f}x {}'.format(
+            *key, ratio, mark))
+    print('{} regressions in {} cases'.format(
+        n_regressions, len(base.keys() & new.keys())))
+    return 1 if n_regressions else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Benchmarks of the CUB, Thrust and random number '
+                    'generator primitives of CuPy')
+    parser.add_argument('--suites', nargs='+', default=list(suites),
+                        choices=list(suites))
+    parser.add_argument('--dtypes', nargs='+',
+                        default=['int32', 'int64', 'float16', 'float32',
+                                 'float64'])
+    parser.add_argument('--sizes', nargs='+', type=int,
+                        default=[1 << 14, 1 << 20, 1 << 24])
+    parser.add_argument('--n-repeat', type=int, default=20)
+    parser.add_argument('--n-warmup', type=int, default=3)
+    parser.add_argument('--output', '-o',
+                        help='write the results to this JSON file')
+    parser.add_argument('--compare', nargs=2, metavar=('BASE', 'NEW'),
+                        help='compare two JSON files instead of running')
+    parser.add_argument('--threshold', type=float, default=0.1,
+                        help='relative change reported by --compare')
+    args = parser.parse_args()
+    if args.compare:
+        sys.exit(compare(args))
+    for size in args.sizes:
+        if size % 1024:
+            parser.error('the sizes must be multiples of 1024')
+    run(args)
+
+
+if __name__ == '__main__':
+    main()
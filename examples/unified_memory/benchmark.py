@@ -0,0 +1,101 @@
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+import numpy
+
+
+def cases(size):
+    import cupy
+
+    x_cpu = numpy.random.default_rng(0).random(size, dtype=numpy.float32)
+    x = cupy.asarray(x_cpu)
+    y = cupy.empty_like(x)
+
+    def to_device():
+        return cupy.asarray(x_cpu)
+
+    def to_host():
+        return cupy.asnumpy(x)
+
+    def kernel():
+        cupy.multiply(x, 2, out=y)
+
+    def round_trip():
+        # a NumPy input processed on the GPU and read back by NumPy
+        return cupy.asnumpy(cupy.asarray(x_cpu) * 2 + 1).sum()
+
+    def host_reads():
+        # the host reads the result of a kernel
+        cupy.multiply(x, 2, out=y)
+        return numpy.add.reduce(cupy.asnumpy(y))
+
+    yield 'asarray', to_device, x.nbytes
+    yield 'asnumpy', to_host, x.nbytes
+    yield 'kernel', kernel, 2 * x.nbytes
+    yield 'round_trip', round_trip, 4 * x.nbytes
+    yield 'host_reads', host_reads, 3 * x.nbytes
+
+
+def run_mode(args):
+    # Runs in a child process, as CUPY_ENABLE_UMP is read on import.
+    import cupy
+    from cupyx import profiler
+
+    if args.mode == 'unified':
+        cupy.cuda.set_allocator(cupy.cuda.SystemMemoryAllocator(
+            prefetch=not args.no_prefetch).malloc)
+    results = []
+    for size in args.sizes:
+        for name, func, nbytes in cases(size):
+            perf = profiler.benchmark(
+                func, n_repeat=args.n_repeat, n_warmup=args.n_warmup)
+            # the copies are issued and waited for by the host
+            time = float(numpy.median(perf.cpu_times))
+            results.append({
+                'case': name, 'size': size, 'time': time,
+                'bandwidth': nbytes / time / 1e9,
+            })
+        cupy.get_default_memory_pool().free_all_blocks()
+    json.dump(results, sys.stdout)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compares the unified memory mode of CuPy with the '
+                    'copies between the device and the host')
+    parser.add_argument('--sizes', nargs='+', type=int,
+                        default=[1 << 16, 1 << 20, 1 << 24, 1 << 26])
+    parser.add_argument('--n-repeat', type=int, default=20)
+    parser.add_argument('--n-warmup', type=int, default=3)
+    parser.add_argument('--no-prefetch', action='store_true',
+                        help='do not prefetch the allocations in the '
+                             'unified mode')
+    parser.add_argument('--mode', choices=('discrete', 'unified'),
+                        help=argparse.SUPPRESS)
+    args = parser.parse_args()
+    if args.mode is not None:
+        run_mode(args)
+        return
+
+    results = {}
+    for mode in ('discrete', 'unified'):
+        env = dict(os.environ)
+        env['CUPY_ENABLE_UMP'] = '1' if mode == 'unified' else '0'
+        out = subprocess.run(
+            [sys.executable, __file__, '--mode', mode] + sys.argv[1:],
+            env=env, stdout=subprocess.PIPE, check=True).stdout
+        results[mode] = json.loads(out)
+
+    print('{:<12}{:>10}{:>14}{:>14}{:>10}'.format(
+        'case', 'size', 'discrete(us)', 'unified(us)', 'speedup'))
+    for d, u in zip(results['discrete'], results['unified']):
+        print('{:<12}{:>10}{:>14.1f}{:>14.1f}{:>9.2f}x'.format(
+            d['case'], d['size'], d['time'] * 1e6, u['time'] * 1e6,
+            d['time'] / u['time']))
+
+
+if __name__ == '__main__':
+    main()
@@ -201,6 +201,65 @@ class TestFusionMultistageReductionsMultiAxis(unittest.TestCase):
         return lambda x: x.prod(axis=(-1, 1)).sum(axis=(0, 1))
 
 
+@testing.parameterize(*testing.product({
+    'shape': [(3, 4), (5, 1), (2, 3, 4), (4, 1000)],
+}))
+class TestFusionRowByRow(unittest.TestCase):
+
+    def generate_inputs(self, xp):
+        x = testing.shaped_random(self.shape, xp, 'float32', seed=0)
+        return (x,), {}
+
+    @fusion_utils.check_fusion()
+    def test_keepdims(self, xp):
+        return lambda x: x - x.max(axis=-1, keepdims=True)
+
+    @fusion_utils.check_fusion()
+    def test_softmax(self, xp):
+        def impl(x):
+            e = xp.exp(x - x.max(axis=-1, keepdims=True))
+            return e / e.sum(axis=-1, keepdims=True)
+        return impl
+
+    @fusion_utils.check_fusion()
+    def test_logsumexp(self, xp):
+        def impl(x):
+            m = x.max(axis=-1)
+            return xp.log(xp.exp(x - m[..., None]).sum(axis=-1)) + m
+        return impl
+
+    @fusion_utils.check_fusion()
+    def test_variance(self, xp):
+        def impl(x):
+            d = x - x.sum(axis=-1, keepdims=True) * 0.25
+            return (d * d).sum(axis=-1), d
+        return impl
+
+    @unittest.skipUnless(
+        fusion_utils.can_use_grid_synchronization(),
+        'Requires CUDA grid synchronization')
+    @fusion_utils.check_fusion()
+    def test_leading_axis(self, xp):
+        # Not computed row by row.
+        return lambda x: x - x.max(axis=0, keepdims=True)
+
+    def test_row_plan(self):
+        from cupy._core import new_fusion
+
+        def softmax(x):
+            e = cupy.exp(x - x.max(axis=-1, keepdims=True))
+            return e / e.sum(axis=-1, keepdims=True)
+
+        def leading(x):
+            return x - x.max(axis=0, keepdims=True)
+
+        x = cupy.ones(self.shape, 'float32')
+        kernel = new_fusion._get_fused_kernel('softmax', softmax, (x,))
+        assert kernel._row_cuda_body is not None
+        kernel = new_fusion._get_fused_kernel('leading', leading, (x,))
+        assert kernel._row_cuda_body is None
+
+
 class TestFusionReductionRoutines(unittest.TestCase):
 
     def generate_inputs(self, xp):
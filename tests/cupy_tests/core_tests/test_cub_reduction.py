@@ -146,3 +146,81 @@ class TestSimpleCubReductionKernelMisc(CubReductionTestBase):
             a.sum(axis=0)
 
         _accelerator.set_routine_accelerators(old_routine_accelerators)
+
+
+class TestColumnReduction(unittest.TestCase):
+
+    def setUp(self):
+        self.old_accelerators = _accelerator.get_reduction_accelerators()
+        _accelerator.set_reduction_accelerators(['cub'])
+        self.old_routine_accelerators = (
+            _accelerator.get_routine_accelerators())
+        _accelerator.set_routine_accelerators([])
+        self.can_use = _cub_reduction._can_use_column_reduction
+
+    def tearDown(self):
+        _accelerator.set_reduction_accelerators(self.old_accelerators)
+        _accelerator.set_routine_accelerators(self.old_routine_accelerators)
+
+    def test_can_use(self):
+        a = cupy.empty((4, 5, 6))
+        assert self.can_use([a], [cupy.empty((6,))], (0, 1), (2,)) == (
+            20, 6, 6)
+        assert self.can_use([a], [cupy.empty((5, 6))], (0,), (1, 2)) == (
+            4, 30, 30)
+        # the rows may be far apart
+        b = a[::2]
+        assert self.can_use([b], [cupy.empty((5, 6))], (0,), (1, 2)) == (
+            2, 30, 60)
+
+    def test_can_use_not_columns(self):
+        a = cupy.empty((4, 5, 6))
+        # the columns are not contiguous
+        assert self.can_use([a], [cupy.empty((4,))], (1, 2), (0,)) is None
+        assert self.can_use(
+            [a[:, :, ::2]], [cupy.empty((5, 3))], (0,), (1, 2)) is None
+        # the reduced axes are not contiguous to each other
+        assert self.can_use([a], [cupy.empty((5,))], (0, 2), (1,)) is None
+        # the output is not C-contiguous
+        assert self.can_use(
+            [a], [cupy.empty((6, 5)).T], (0,), (1, 2)) is None
+
+    @testing.for_all_dtypes(no_bool=True, no_float16=True)
+    @testing.numpy_cupy_allclose(rtol=1e-5, contiguous_check=False)
+    def test_sum_axis0(self, xp, dtype):
+        a = testing.shaped_random((1000, 70), xp, dtype)
+        return a.sum(axis=0)
+
+    @testing.for_float_dtypes(no_float16=True)
+    @testing.numpy_cupy_allclose(rtol=1e-5, contiguous_check=False)
+    def test_mean_f_order(self, xp, dtype):
+        a = testing.shaped_random((70, 3000), xp, dtype, order='F')
+        return a.mean(axis=1)
+
+    @testing.numpy_cupy_allclose(rtol=1e-5, contiguous_check=False)
+    def test_sum_strided_rows(self, xp):
+        a = testing.shaped_random((20000, 3, 4), xp, 'f')
+        return a[::3].sum(axis=0)
+
+    @testing.for_all_dtypes(no_bool=True, no_complex=True)
+    @testing.numpy_cupy_array_equal()
+    def test_max_axis0(self, xp, dtype):
+        a = testing.shaped_random((500, 33), xp, dtype)
+        return a.max(axis=0)
+
+    @testing.numpy_cupy_array_equal()
+    def test_argmax_axis0(self, xp):
+        a = testing.shaped_random((100000, 40), xp, 'f')
+        return a.argmax(axis=0)
+
+    def test_kernel_used(self):
+        a = cupy.random.random((100, 10))
+        func_name = ''.join(('cupy._core._cub_reduction.',
+                             '_ColumnReductionKernel_get_cached_function'))
+        func = _cub_reduction._ColumnReductionKernel_get_cached_function
+        with testing.AssertFunctionIsCalled(
+                func_name, wraps=func, times_called=1):
+            a.sum(axis=0)
+        with testing.AssertFunctionIsCalled(
+                func_name, wraps=func, times_called=0):
+            a.sum(axis=1)
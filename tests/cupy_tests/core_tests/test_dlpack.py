@@ -95,10 +95,21 @@ class TestNewDLPackConversion:
         with pytest.raises(NotImplementedError):
             cupy.from_dlpack(orig_array, device=orig_array.device)
 
-        with pytest.raises(BufferError):
-            # Currently CuPy's `__dlpack__` only allows `copy=True`
-            # for host copies.
-            cupy.from_dlpack(orig_array, copy=True)
+    @pytest.mark.parametrize('max_version', [None, (1, 0)])
+    def test_conversion_copy(self, max_version):
+        orig_array = _gen_array(cupy.float32)
+        capsule = orig_array.__dlpack__(max_version=max_version, copy=True)
+        out_array = cupy.from_dlpack(
+            DLDummy(capsule, orig_array.__dlpack_device__()))
+        testing.assert_array_equal(orig_array, out_array)
+        assert orig_array.data.ptr != out_array.data.ptr
+
+        out_array = cupy.from_dlpack(orig_array, copy=True)
+        testing.assert_array_equal(orig_array, out_array)
+        assert orig_array.data.ptr != out_array.data.ptr
+
+        out_array = cupy.from_dlpack(orig_array, copy=False)
+        assert orig_array.data.ptr == out_array.data.ptr
 
     @pytest.mark.parametrize("kwargs, versioned", [
         ({}, False), ({"max_version": None}, False),
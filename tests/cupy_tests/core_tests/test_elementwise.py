@@ -7,6 +7,8 @@ import cupy
 from cupy import _core
 from cupy import cuda
 from cupy import testing
+from cupy._core._dtype import bfloat16 as _bfloat16
+from cupy.cuda import common
 
 
 class TestElementwise(unittest.TestCase):
@@ -69,6 +71,169 @@ class TestElementwise(unittest.TestCase):
         assert b.strides == b_cpu.strides
 
 
+class TestElementwiseVectorized:
+
+    # Contiguous, aligned ufunc calls load and store several elements per
+    # thread, and the remainder is processed element-wise.
+    @pytest.mark.parametrize('size', [1, 15, 16, 17, 1023])
+    @testing.for_dtypes('bBhefdF')
+    @testing.numpy_cupy_array_equal()
+    def test_add(self, xp, dtype, size):
+        a = testing.shaped_arange((size,), xp, dtype)
+        b = testing.shaped_reverse_arange((size,), xp, dtype)
+        return a + b
+
+    @pytest.mark.parametrize('offset', [1, 2, 3])
+    @testing.for_dtypes('bef')
+    @testing.numpy_cupy_array_equal()
+    def test_unaligned(self, xp, dtype, offset):
+        a = testing.shaped_arange((100,), xp, dtype)
+        b = testing.shaped_reverse_arange((100,), xp, dtype)
+        out = xp.zeros((100,), dtype)
+        xp.add(a[offset:], b[:-offset], out=out[offset:])
+        return out
+
+    @testing.numpy_cupy_array_equal()
+    def test_mixed_itemsize(self, xp):
+        a = testing.shaped_arange((101,), xp, numpy.int8)
+        b = testing.shaped_arange((101,), xp, numpy.float64)
+        return a * b
+
+    @testing.numpy_cupy_array_equal()
+    def test_in_place(self, xp):
+        a = testing.shaped_arange((99,), xp, numpy.float16)
+        a *= 2
+        return a
+
+    # float16 add, subtract, multiply and negative compute pairs of elements
+    # with float16x2, which must match the element-wise float16 results.
+    @pytest.mark.parametrize('name', ['add', 'subtract', 'multiply'])
+    @pytest.mark.parametrize('size', [2, 33, 1000])
+    @testing.numpy_cupy_array_equal()
+    def test_half2_binary(self, xp, name, size):
+        a = testing.shaped_random((size,), xp, numpy.float16, scale=100)
+        b = testing.shaped_random((size,), xp, numpy.float16, seed=1)
+        return getattr(xp, name)(a, b)
+
+    @testing.numpy_cupy_array_equal()
+    def test_half2_scalar(self, xp):
+        a = testing.shaped_random((100,), xp, numpy.float16, scale=100)
+        return a * numpy.float16(0.3) - numpy.float16(1.5)
+
+    @testing.numpy_cupy_array_equal()
+    def test_half2_negative(self, xp):
+        a = testing.shaped_random((100,), xp, numpy.float16)
+        a[3] = numpy.nan
+        a[4] = 0
+        return -a
+
+    @testing.numpy_cupy_array_equal()
+    def test_half2_special_values(self, xp):
+        a = xp.array([65504, -65504, 1e-7, 0, numpy.inf, numpy.nan] * 4,
+                     numpy.float16)
+        b = xp.array([65504, 1, 1e-7, -0., -numpy.inf, 1] * 4, numpy.float16)
+        return a + b, a * b
+
+    def test_half2_kernel(self):
+        a = cupy.ones((64,), cupy.float16)
+        a + a
+        assert any(key[-1] for key in cupy.add._kernel_memo)
+
+
+@pytest.mark.skipif(
+    _bfloat16 is None, reason='ml_dtypes is not installed')
+class TestElementwiseBfloat16:
+
+    # bfloat16 loops reuse the float16 routines, computing in float and
+    # rounding the results to bfloat16.
+    @pytest.mark.parametrize('name', ['add', 'subtract', 'multiply', 'sqrt'])
+    def test_ufunc(self, name):
+        bf16 = _bfloat16
+        a_np = numpy.arange(1, 101, dtype=numpy.float32).astype(bf16)
+        ufunc = getattr(cupy, name)
+        args = (cupy.asarray(a_np),) * ufunc.nin
+        out = ufunc(*args)
+        assert out.dtype == bf16
+        a32 = a_np.astype(numpy.float32)
+        expected = getattr(numpy, name)(*((a32,) * ufunc.nin)).astype(bf16)
+        testing.assert_array_equal(out.get().astype(numpy.float32),
+                                   expected.astype(numpy.float32))
+
+    def test_sort(self):
+        if not common._is_bf16_supported():
+            pytest.skip('bfloat16 sorting needs sm_80')
+        bf16 = _bfloat16
+        a_np = numpy.array([3, -1, numpy.nan, -0., 0, 2, -numpy.inf],
+                           dtype=numpy.float32)
+        a = cupy.asarray(a_np.astype(bf16))
+        testing.assert_array_equal(
+            cupy.sort(a).get().astype(numpy.float32), numpy.sort(a_np))
+
+
+class TestElementwiseBind:
+
+    def _kernel(self, **kwargs):
+        return cupy.ElementwiseKernel(
+            'T x, T y, T a', 'T z', 'z = a * x + y', 'cupy_bind_test',
+            **kwargs)
+
+    @pytest.mark.parametrize('vectorize', [False, True])
+    def test_launch(self, vectorize):
+        kernel = self._kernel(vectorize=vectorize)
+        x = testing.shaped_arange((3, 40), cupy, numpy.float32)
+        y = testing.shaped_reverse_arange((3, 40), cupy, numpy.float32)
+        bound = kernel.bind(x, y, numpy.float32(2))
+        assert bound.kernel is kernel
+        z = bound.launch(x, y, 2)
+        testing.assert_array_equal(z, 2 * x + y)
+
+        x2 = testing.shaped_random((3, 40), cupy, numpy.float32, seed=0)
+        y2 = testing.shaped_random((3, 40), cupy, numpy.float32, seed=1)
+        z2 = bound.launch(x2, y2, 3)
+        assert z2 is z
+        testing.assert_allclose(z2, 3 * x2 + y2)
+
+        out = cupy.empty_like(x)
+        assert bound.launch(x, y2, 4, out) is out
+        testing.assert_allclose(out, 4 * x + y2)
+
+    def test_broadcast_and_strides(self):
+        kernel = self._kernel()
+        x = testing.shaped_arange((4, 6), cupy, numpy.float64)[:, ::2]
+        y = testing.shaped_arange((3,), cupy, numpy.float64)
+        bound = kernel.bind(x, y, 1.0)
+        x2 = testing.shaped_random((4, 6), cupy, numpy.float64)[:, ::2]
+        testing.assert_allclose(bound.launch(x2, y, 1.0), x2 + y)
+
+    def test_invalid_array(self):
+        kernel = self._kernel()
+        x = cupy.ones((10,), numpy.float32)
+        bound = kernel.bind(x, x, 1)
+        with pytest.raises(ValueError):
+            bound.launch(cupy.ones((11,), numpy.float32), x, 1)
+        with pytest.raises(ValueError):
+            bound.launch(cupy.ones((10,), numpy.float64), x, 1)
+        with pytest.raises(ValueError):
+            bound.launch(cupy.ones((20,), numpy.float32)[::2], x, 1)
+        with pytest.raises(TypeError):
+            bound.launch(1, x, 1)
+        with pytest.raises(TypeError):
+            bound.launch(x, x)
+
+    def test_unaligned(self):
+        kernel = self._kernel(vectorize=True)
+        x = cupy.ones((101,), numpy.float16)
+        bound = kernel.bind(x[:100], x[:100], 1)
+        with pytest.raises(ValueError):
+            bound.launch(x[1:], x[:100], 1)
+
+    def test_zero_size(self):
+        kernel = self._kernel()
+        x = cupy.ones((0, 3), numpy.float32)
+        bound = kernel.bind(x, x, 1)
+        assert bound.launch(x, x, 1).shape == (0, 3)
+
+
 class TestElementwiseInvalidShape(unittest.TestCase):
 
     def test_invalid_shape(self):
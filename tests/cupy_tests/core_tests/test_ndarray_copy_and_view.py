@@ -364,6 +364,51 @@ class TestArrayAsType:
         return a.astype(numpy.int8)
 
 
+class TestPermuteCopy:
+
+    # large enough for the tiled copy of permuted layouts
+
+    @pytest.mark.parametrize('shape, axes', [
+        ((300, 200), (1, 0)),
+        ((257, 129), (1, 0)),
+        ((4, 100, 90), (0, 2, 1)),
+        ((30, 40, 50), (2, 1, 0)),
+        ((30, 40, 50), (1, 2, 0)),
+        ((5, 6, 40, 50), (3, 0, 2, 1)),
+        ((3, 4, 5, 40, 30), (4, 1, 0, 2, 3)),
+        ((2, 3, 4, 5, 40, 30), (5, 1, 0, 2, 4, 3)),
+    ])
+    @testing.for_all_dtypes()
+    @testing.numpy_cupy_array_equal(strides_check=True)
+    def test_copy(self, xp, dtype, shape, axes):
+        a = testing.shaped_arange(shape, xp, dtype).transpose(axes)
+        return a.copy()
+
+    @testing.for_all_dtypes_combination(('src_dtype', 'dst_dtype'))
+    @testing.numpy_cupy_array_equal()
+    def test_astype(self, xp, src_dtype, dst_dtype):
+        a = testing.shaped_arange((8, 200, 40), xp, src_dtype)
+        return astype_without_warning(
+            a.transpose(2, 0, 1), dst_dtype, order='C')
+
+    @testing.for_all_dtypes()
+    @testing.numpy_cupy_array_equal()
+    def test_ascontiguousarray(self, xp, dtype):
+        a = testing.shaped_arange((300, 400), xp, dtype)
+        return xp.ascontiguousarray(a[::-2, ::3].T)
+
+    @testing.numpy_cupy_array_equal()
+    def test_asfortranarray(self, xp):
+        a = testing.shaped_arange((300, 400), xp, xp.float32)
+        return xp.asfortranarray(a, dtype=xp.float64)
+
+    @testing.numpy_cupy_array_equal()
+    def test_broadcast(self, xp):
+        a = testing.shaped_arange((300, 1, 200), xp, xp.int32)
+        a = xp.broadcast_to(a, (300, 4, 200)).transpose(2, 1, 0)
+        return a.copy()
+
+
 class TestArrayDiagonal:
 
     @testing.for_all_dtypes()
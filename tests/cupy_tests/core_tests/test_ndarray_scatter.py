@@ -208,6 +208,21 @@ class TestScatterAdd:
             numpy.array([[1, 0, 0], [0, 1, 1]], dtype=src_dtype))
 
 
+    # Many lanes of a warp hit the same few addresses, which exercises the
+    # warp-aggregated atomics.
+    @testing.for_dtypes([numpy.int32, numpy.uint64, numpy.float16,
+                         numpy.float32, numpy.float64])
+    def test_scatter_add_contended(self, dtype):
+        if cupy.cuda.runtime.is_hip and dtype == numpy.float16:
+            pytest.skip('atomicAdd does not support float16 in HIP')
+        indices = numpy.arange(1000) % 7
+        indices[::3] = 2
+        a = cupy.zeros((7,), dtype)
+        cupy.add.at(a, cupy.asarray(indices), cupy.ones((1000,), dtype))
+        testing.assert_array_equal(
+            a, numpy.bincount(indices, minlength=7).astype(dtype))
+
+
 class TestScatterMinMax:
 
     @testing.for_dtypes([numpy.float32, numpy.int32, numpy.uint32,
@@ -9,6 +9,7 @@ import tempfile
 import unittest
 from unittest import mock
 
+import numpy
 import pytest
 
 import cupy
@@ -16,6 +17,7 @@ from cupy import testing
 from cupy import _util
 from cupy._core import _accelerator
 from cupy.cuda import compiler
+from cupy.cuda import function
 from cupy.cuda import memory
 from cupy_backends.cuda.libs import nvrtc
 
@@ -1138,6 +1140,102 @@ void test_grid_sync(const float* x1, const float* x2, float* y, int n) {
 '''
 
 
+_test_scalar_args = r"""
+struct pair { double x, y; };
+
+extern "C" __global__ void scalar_args(
+        long long i, double d, pair z, long long b, signed char i8,
+        unsigned short u16, double f8, pair c16, double* out) {
+    out[0] = i;
+    out[1] = d;
+    out[2] = z.x;
+    out[3] = z.y;
+    out[4] = b;
+    out[5] = i8;
+    out[6] = u16;
+    out[7] = f8;
+    out[8] = c16.x;
+    out[9] = c16.y;
+}
+"""
+
+_test_array_args = r"""
+#include <cupy/carray.cuh>
+
+extern "C" __global__ void array_args(
+        const double* s, CArray<double, 2> x, double* out, long long* info) {
+    out[0] = *s;
+    for (int i = 0; i < x.shape()[0]; i++) {
+        for (int j = 0; j < x.shape()[1]; j++) {
+            out[1 + i * x.shape()[1] + j] = x[{i, j}];
+        }
+    }
+    info[0] = x.size();
+    info[1] = x.shape()[0];
+    info[2] = x.shape()[1];
+    info[3] = x.strides()[0];
+    info[4] = x.strides()[1];
+}
+"""
+
+_test_pointer_args = r"""
+extern "C" __global__ void pointer_args(
+        int a, const double* p, double f, long long b, const double* q,
+        float g, const void* null, double* out) {
+    out[0] = a;
+    out[1] = *p;
+    out[2] = f;
+    out[3] = b;
+    out[4] = *q;
+    out[5] = g;
+    out[6] = null == 0;
+}
+"""
+
+
+class TestRawArguments:
+
+    # The arguments are marshalled by `cupy.cuda.function._launch`, without
+    # a CPointer for the common types.
+
+    def test_scalar_args(self):
+        kern = cupy.RawKernel(_test_scalar_args, 'scalar_args')
+        out = cupy.zeros(10, dtype=numpy.float64)
+        kern((1,), (1,), (
+            -(1 << 40), 2.5, 3 - 4j, True, numpy.int8(-7),
+            numpy.float16(1.5), numpy.float64(-0.125), numpy.complex128(5j),
+            out))
+        h = float(numpy.float16(1.5).view(numpy.uint16))
+        testing.assert_array_equal(
+            out, [-(1 << 40), 2.5, 3, -4, 1, -7, h, -0.125, 0, 5])
+
+    def test_array_args(self):
+        kern = cupy.RawKernel(_test_array_args, 'array_args')
+        s = cupy.array(1.25)
+        x = cupy.arange(24, dtype=numpy.float64).reshape(4, 6)[::2, 1::2]
+        out = cupy.zeros(1 + x.size, dtype=numpy.float64)
+        info = cupy.zeros(5, dtype=numpy.int64)
+        kern((1,), (1,), (s, x, out, info))
+        testing.assert_array_equal(out[0], 1.25)
+        testing.assert_array_equal(out[1:], x.ravel())
+        testing.assert_array_equal(
+            info, (x.size,) + x.shape + x.strides)
+
+    def test_pointer_args(self):
+        kern = cupy.RawKernel(_test_pointer_args, 'pointer_args')
+        p = cupy.array([2.5])
+        q = cupy.array([-3.5])
+        out = cupy.zeros(7, dtype=numpy.float64)
+        # MemoryPointers, CPointers and a numpy array of one element mixed
+        # with the marshalled arguments
+        kern((1,), (1,), (
+            function.CInt32(-3), p.data, 0.75, function.CInt64(1 << 33),
+            function.CIntptr(q.data.ptr), numpy.array([4.5], numpy.float32),
+            None, out.data))
+        testing.assert_array_equal(
+            out, [-3, 2.5, 0.75, 1 << 33, -3.5, 4.5, 1])
+
+
 @testing.parameterize(*testing.product({
     'n': [10, 100, 1000],
     'block': [64, 256],
@@ -1405,3 +1503,25 @@ class TestRawJitify(unittest.TestCase):
             with pytest.raises(cupy.cuda.compiler.CompileException) as ex:
                 self._helper(hdr, options=('-I'+self.temp_dir,))
             assert 'cannot open source file' in str(ex.value)
+
+
+@pytest.mark.skipif(cupy.cuda.runtime.is_hip,
+                    reason='Jitify does not support ROCm/HIP')
+class TestJitifyProgramCache:
+
+    def test_cached_resolution(self):
+        from cupy.cuda import jitify
+        from cupy._core.core import assemble_cupy_compiler_options
+
+        # a unique program, so that the first call resolves it from scratch
+        code = 'cupy_jitify_cache_test\n#include <cupy/complex.cuh>\n'
+        code += '// {}\n'.format(os.getpid())
+        code += 'extern "C" __global__ void f(thrust::complex<float>* x) {}\n'
+        options = assemble_cupy_compiler_options(('-std=c++14',))
+        jitify._init_module()
+        name1, opts1, codes1, names1 = jitify.jitify(code, options)
+        # resolved from the disk cache or from memory
+        name2, opts2, codes2, names2 = jitify.jitify(code, options)
+        assert name1 == name2 == 'cupy_jitify_cache_test'
+        assert opts1 == opts2
+        assert dict(zip(names1, codes1)) == dict(zip(names2, codes2))
@@ -223,6 +223,98 @@ class TestReductionKernelCachedCode:
         assert len(kernel._cached_codes) == 2
 
 
+class TestReductionItemsPerThread:
+
+    @pytest.fixture(autouse=True)
+    def setUp(self):
+        self.old_reduction_accelerators = _acc.get_reduction_accelerators()
+        _acc.set_reduction_accelerators([])
+        yield
+        _acc.set_reduction_accelerators(self.old_reduction_accelerators)
+
+    @pytest.fixture
+    def tuned(self):
+        previous = _core._reduction._set_autotune(True)
+        tuned = _core._reduction._tuned_items_per_thread
+        tuned.clear()
+        yield tuned
+        tuned.clear()
+        _core._reduction._set_autotune(previous)
+
+    @pytest.mark.parametrize('shape,axis', [
+        ((1000, 3), 0), ((3, 1000), 1), ((100, 70, 3), (0, 1)), ((7,), 0)])
+    def test_items_per_thread(self, tuned, shape, axis):
+        kernel = cupy.ReductionKernel(
+            'T x', 'T y', 'x', 'a + b', 'y = a', '0',
+            name='items_per_thread')
+        x = testing.shaped_arange(shape, cupy, numpy.int64)
+        expected = x.get().sum(axis=axis)
+        testing.assert_array_equal(kernel(x, axis=axis), expected)
+        key, = tuned.keys()
+        # run each variant by overriding the tuned value
+        for items_per_thread in (1, 2, 4, 8):
+            tuned[key] = items_per_thread
+            testing.assert_array_equal(kernel(x, axis=axis), expected)
+
+    @testing.for_dtypes('lfd')
+    def test_argmax(self, dtype):
+        # the reduce type is a struct, so that it is shuffled by words
+        x = testing.shaped_random((50, 4000), cupy, dtype)
+        testing.assert_array_equal(
+            x.argmax(axis=1), x.get().argmax(axis=1))
+
+    def test_autotune(self, tuned):
+        x = testing.shaped_arange((10, 100000), cupy, numpy.float32)
+        testing.assert_allclose(x.sum(axis=1), x.get().sum(axis=1))
+        assert len(tuned) == 1
+        value, = tuned.values()
+        assert value in _core._reduction._items_per_thread_candidates
+
+
+class TestSplitReduction:
+
+    @pytest.fixture(autouse=True)
+    def setUp(self):
+        self.old_reduction_accelerators = _acc.get_reduction_accelerators()
+        self.old_routine_accelerators = _acc.get_routine_accelerators()
+        _acc.set_reduction_accelerators([])
+        _acc.set_routine_accelerators([])
+        yield
+        _acc.set_reduction_accelerators(self.old_reduction_accelerators)
+        _acc.set_routine_accelerators(self.old_routine_accelerators)
+
+    def test_n_splits(self):
+        dev = cupy.cuda.Device().id
+        assert _core._reduction._get_n_splits(1 << 24, 1, 1, 1, dev) > 1
+        assert _core._reduction._get_n_splits(1 << 10, 1, 1, 1, dev) == 1
+        assert _core._reduction._get_n_splits(
+            1 << 24, 1 << 20, 32, 1 << 15, dev) == 1
+
+    @pytest.mark.parametrize('shape,axis', [
+        ((1 << 23,), None), ((3, 1 << 21), 1), ((1 << 21, 5), 0)])
+    @testing.for_dtypes('ld')
+    def test_sum(self, shape, axis, dtype):
+        x = testing.shaped_random(shape, cupy, dtype)
+        testing.assert_allclose(
+            x.sum(axis=axis), x.get().sum(axis=axis), rtol=1e-6)
+
+    @testing.for_dtypes('lfD')
+    def test_max_argmax(self, dtype):
+        x = testing.shaped_random((1 << 22,), cupy, dtype)
+        # the same maximum at two places; the first is taken
+        x[12345] = x[3000000] = 100
+        assert x.argmax() == 12345
+        testing.assert_array_equal(x.max(), 100)
+
+    def test_reduction_kernel(self):
+        kernel = cupy.ReductionKernel(
+            'T x', 'T y', 'x * x', 'a + b', 'y = sqrt(a)', '0',
+            name='split_norm')
+        x = testing.shaped_random((1 << 22,), cupy, numpy.float64)
+        testing.assert_allclose(
+            kernel(x), numpy.linalg.norm(x.get()), rtol=1e-10)
+
+
 class TestLargeMultiDimReduction(
         ReductionKernelTestBase, unittest.TestCase):
 
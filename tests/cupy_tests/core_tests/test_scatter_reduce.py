@@ -0,0 +1,64 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+from cupy._core import _accelerator
+from cupy._core import _scatter_reduce
+
+
+def _expected(out_size, indices, values, dtype):
+    valid = (0 <= indices) & (indices < out_size)
+    weights = None if values is None else values[valid]
+    return numpy.bincount(
+        indices[valid], weights, minlength=out_size).astype(dtype)
+
+
+class TestScatterAdd:
+
+    @pytest.mark.parametrize('method', ['shared', 'sort', 'atomic', None])
+    @pytest.mark.parametrize('out_size', [1, 100, 5000])
+    @testing.for_dtypes('ilfd')
+    def test_scatter_add(self, method, out_size, dtype):
+        if (method == 'sort' and _accelerator.ACCELERATOR_CUB
+                not in _accelerator.get_routine_accelerators()):
+            pytest.skip('CUB is not enabled')
+        if method == 'shared' and out_size * numpy.dtype(dtype).itemsize > (
+                _scatter_reduce._max_shared_bytes - 4):
+            pytest.skip('out does not fit in the shared memory')
+        indices = testing.shaped_random(
+            (10000,), numpy, numpy.int64, scale=out_size + 10) - 5
+        values = testing.shaped_random((10000,), numpy, dtype, scale=10)
+        out = cupy.zeros((out_size,), dtype)
+        _scatter_reduce.scatter_add(
+            out, cupy.asarray(indices), cupy.asarray(values), method=method)
+        testing.assert_allclose(
+            out, _expected(out_size, indices, values, dtype), rtol=1e-5)
+
+    @pytest.mark.parametrize('method', ['shared', 'atomic', None])
+    def test_count(self, method):
+        indices = numpy.arange(3000, dtype=numpy.int32) % 17
+        out = cupy.zeros((17,), numpy.int64)
+        _scatter_reduce.scatter_add(out, cupy.asarray(indices), method=method)
+        testing.assert_array_equal(
+            out, _expected(17, indices, None, numpy.int64))
+
+    def test_float16_shared(self):
+        indices = numpy.arange(1001) % 3
+        out = cupy.zeros((3,), numpy.float16)
+        _scatter_reduce.scatter_add(
+            out, cupy.asarray(indices), cupy.ones((1001,), numpy.float16),
+            method='shared')
+        testing.assert_array_equal(out, [334, 334, 333])
+
+    def test_choose_method(self):
+        out = cupy.zeros((10,), numpy.float32)
+        small = cupy.zeros((100,), numpy.int64)
+        assert _scatter_reduce._choose_method(out, small) == 'shared'
+        large_out = cupy.zeros((1 << 20,), numpy.float32)
+        assert _scatter_reduce._choose_method(large_out, small) == 'atomic'
+
+    def test_empty(self):
+        out = cupy.ones((4,), numpy.float32)
+        _scatter_reduce.scatter_add(out, cupy.empty((0,), numpy.int64))
+        testing.assert_array_equal(out, numpy.ones(4))
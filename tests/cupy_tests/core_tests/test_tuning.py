@@ -0,0 +1,84 @@
+import json
+import os
+
+import pytest
+
+import cupy
+from cupy._core import _tuning
+from cupy import testing
+
+
+@pytest.fixture
+def tuning_dir(tmp_path, monkeypatch):
+    monkeypatch.setenv('CUPY_TUNING_DIR', str(tmp_path))
+    monkeypatch.setattr(_tuning, '_dbs', {})
+    monkeypatch.setattr(_tuning, '_dbs_by_path', {})
+    monkeypatch.setattr(_tuning, '_counts', {})
+    return tmp_path
+
+
+class TestTuningDB:
+
+    def test_update(self, tmp_path):
+        path = str(tmp_path / 'gpu.json')
+        db = _tuning._TuningDB(path)
+        assert db.lookup('reduction', 'k') is None
+        db.update('reduction', 'k', [256, 4])
+        assert db.lookup('reduction', 'k') == [256, 4]
+        assert _tuning._TuningDB(path).lookup('reduction', 'k') == [256, 4]
+
+    def test_merge(self, tmp_path):
+        path = str(tmp_path / 'gpu.json')
+        db1 = _tuning._TuningDB(path)
+        db2 = _tuning._TuningDB(path)
+        db1.update('elementwise', 'a', 128)
+        db2.update('elementwise', 'b', 256)
+        with open(path) as f:
+            entries = json.load(f)
+        assert entries == {'elementwise': {'a': 128, 'b': 256}}
+
+    def test_broken(self, tmp_path):
+        path = tmp_path / 'gpu.json'
+        path.write_text('{')
+        with pytest.warns(UserWarning, match='Ignoring'):
+            db = _tuning._TuningDB(str(path))
+        assert db.lookup('elementwise', 'a') is None
+
+
+class TestMaybeTune:
+
+    def test_hot_kernel(self, tuning_dir, monkeypatch):
+        monkeypatch.setattr(_tuning, '_autotune', True)
+        monkeypatch.setattr(_tuning, '_hot_threshold', 2)
+        x = testing.shaped_arange((1000,), cupy)
+        prepared = []
+
+        def prepare():
+            prepared.append(1)
+            y = x.copy()
+
+            def tune(stream):
+                def launch(n):
+                    with stream:
+                        for _ in range(n):
+                            y.sum()
+                return _tuning.pick_fastest([100, 1], launch, stream)
+            return tune
+
+        dev = cupy.cuda.Device().id
+        for _ in range(3):
+            _tuning.maybe_tune(dev, 'reduction', 'key', prepare)
+        _tuning._wait()
+        assert prepared == [1]
+        assert _tuning.lookup(dev, 'reduction', 'key') == 1
+        name = _tuning._get_model_name(dev) + '.json'
+        assert os.path.exists(os.path.join(tuning_dir, name))
+
+    def test_disabled(self, tuning_dir, monkeypatch):
+        monkeypatch.setattr(_tuning, '_autotune', False)
+        monkeypatch.setattr(_tuning, '_hot_threshold', 1)
+
+        def prepare():
+            assert False
+
+        _tuning.maybe_tune(0, 'reduction', 'key', prepare)
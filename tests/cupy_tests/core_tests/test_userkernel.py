@@ -90,6 +90,162 @@ class TestUserkernel(unittest.TestCase):
         assert len(user_kernel_1._cached_codes) == 2
 
 
+class TestElementwiseKernelStaticShape(unittest.TestCase):
+
+    def _kernel(self):
+        return cupy.ElementwiseKernel(
+            'T x, T y', 'T z', 'z = x + y;', 'static_shape_kernel',
+            static_shape=True)
+
+    def test_static_shape(self):
+        kern = self._kernel()
+        # Transposed inputs keep three dimensions after reducing them
+        for shape in ((5, 3, 4), (7, 6, 3), (2, 8, 1)):
+            a = testing.shaped_random(shape[::-1], cupy, cupy.float32).T
+            b = testing.shaped_random(shape, cupy, cupy.float32)
+            testing.assert_array_equal(kern(a, b), a.get() + b.get())
+
+    def test_static_shape_code(self):
+        kern = self._kernel()
+        a = testing.shaped_random((4, 3), cupy, cupy.float32).T
+        kern(a, a)
+        assert 'CIndexer<2, 1, 3, 4>' in kern.cached_code
+
+    def test_cached_per_shape(self):
+        kern = self._kernel()
+        a = testing.shaped_random((4, 3), cupy, cupy.float32)
+        kern(a.T, a.T)
+        kern(a.T, a.T)
+        assert len(kern._elementwise_kernel_memo) == 1
+        b = testing.shaped_random((5, 3), cupy, cupy.float32)
+        kern(b.T, b.T)
+        assert len(kern._elementwise_kernel_memo) == 2
+
+
+class TestElementwiseKernelVectorize(unittest.TestCase):
+
+    def _kernel(self):
+        return cupy.ElementwiseKernel(
+            'T x', 'T y', 'y += x;', 'vectorize_kernel', vectorize=True)
+
+    def test_vectorize(self):
+        kern = self._kernel()
+        for dtype in (cupy.int8, cupy.float16, cupy.float32):
+            for size in (3, 64, 101):
+                x = testing.shaped_arange((size,), cupy, dtype)
+                y = testing.shaped_reverse_arange((size,), cupy, dtype)
+                expected = x.get() + y.get()
+                kern(x, y)
+                testing.assert_array_equal(y, expected)
+
+    def test_vectorize_code(self):
+        kern = self._kernel()
+        x = cupy.arange(64, dtype=cupy.float16)
+        kern(x, x.copy())
+        assert 'load_vec' in kern.cached_code
+        assert 'store_vec' in kern.cached_code
+
+    def test_vectorize_unaligned(self):
+        kern = self._kernel()
+        x = testing.shaped_arange((65,), cupy, cupy.int8)
+        y = testing.shaped_reverse_arange((65,), cupy, cupy.int8)
+        expected = x.get()[1:] + y.get()[1:]
+        y1 = y[1:]
+        kern(x[1:], y1)
+        testing.assert_array_equal(y1, expected)
+
+    def test_vectorize_non_contiguous(self):
+        kern = self._kernel()
+        x = testing.shaped_arange((64,), cupy, cupy.float32)[::2]
+        y = testing.shaped_reverse_arange((32,), cupy, cupy.float32)
+        expected = x.get() + y.get()
+        kern(x, y)
+        testing.assert_array_equal(y, expected)
+        assert 'load_vec' not in kern.cached_code
+
+
+class TestElementwiseKernelReducedDims(unittest.TestCase):
+
+    def test_cached(self):
+        kern = cupy.ElementwiseKernel(
+            'T x, T y', 'T z', 'z = x + y', 'reduced_dims_kernel')
+        a = testing.shaped_random((4, 5, 6), cupy, cupy.float32, seed=0)
+        b = testing.shaped_random((6, 5, 4), cupy, cupy.float32, seed=1).T
+        for _ in range(2):
+            for x, y in ((a, a), (a, b), (b, b), (a[:, ::2], b[:, ::2])):
+                testing.assert_array_equal(kern(x, y), x.get() + y.get())
+        assert len(kern._reduced_dims_cache._entries) == 4
+
+    def test_ufunc(self):
+        a = testing.shaped_random((3, 4, 5), cupy, cupy.float32)
+        c = testing.shaped_random((3, 4, 5), cupy, cupy.float32)
+        out = cupy.empty((5, 4, 3), dtype=cupy.float32).T
+        for x in (a, a.transpose(0, 2, 1).copy().transpose(0, 2, 1), a):
+            cupy.multiply(x, c, out=out)
+            testing.assert_array_equal(out, x.get() * c.get())
+
+
+class TestElementwiseKernelIndexType(unittest.TestCase):
+
+    def _kernel(self):
+        return cupy.ElementwiseKernel(
+            'raw T x', 'raw int32 y',
+            'if (i == 0) y[0] = sizeof(_index_t);',
+            'index_type_kernel')
+
+    def test_32_bits(self):
+        y = cupy.zeros(1, dtype=cupy.int32)
+        self._kernel()(cupy.arange(10), y, size=10)
+        assert int(y[0]) == 4
+
+    def test_64_bits(self):
+        y = cupy.zeros(1, dtype=cupy.int32)
+        self._kernel()(cupy.arange(10), y, size=2 ** 31 + 1)
+        assert int(y[0]) == 8
+
+    def test_take(self):
+        a = testing.shaped_arange((3, 50, 7), cupy)
+        indices = cupy.array([[4, -1], [49, 0]])
+        expected = numpy.take(a.get(), indices.get(), axis=1)
+        testing.assert_array_equal(cupy.take(a, indices, axis=1), expected)
+
+
+class TestComplexFastMath:
+
+    def _inputs(self, dtype):
+        a = testing.shaped_random((1000,), numpy, dtype, scale=4) - (2 + 2j)
+        # a few special values, so that some warps take the exact path
+        a[10] = complex(numpy.inf, 1)
+        a[20] = complex(1, numpy.nan)
+        a[30] = 0
+        a[40] = complex(-numpy.inf, numpy.inf)
+        return a
+
+    @pytest.mark.parametrize('func', ['exp', 'log', 'sqrt'])
+    @pytest.mark.parametrize('dtype', [numpy.complex64, numpy.complex128])
+    def test_fast_math_option(self, func, dtype):
+        kern = cupy.ElementwiseKernel(
+            'T x', 'T y', 'y = {}(x);'.format(func), 'fast_math_' + func,
+            options=('-DCUPY_COMPLEX_FAST_MATH',))
+        a = self._inputs(dtype)
+        with numpy.errstate(divide='ignore', invalid='ignore'):
+            expected = getattr(numpy, func)(a)
+        # log only keeps the absolute accuracy of its real part near |z| = 1
+        tol = 1e-5 if dtype == numpy.complex64 else 1e-12
+        testing.assert_allclose(
+            kern(cupy.asarray(a)), expected, rtol=tol, atol=tol)
+
+    @pytest.mark.parametrize('dtype', [numpy.complex64, numpy.complex128])
+    def test_fast_functions(self, dtype):
+        kern = cupy.ElementwiseKernel(
+            'T x', 'T y', 'y = fast_sqrt(fast_exp(fast_log(x)));',
+            'fast_functions')
+        a = testing.shaped_random((1000,), numpy, dtype, scale=4) + (1 + 1j)
+        rtol = 1e-5 if dtype == numpy.complex64 else 1e-12
+        testing.assert_allclose(
+            kern(cupy.asarray(a)), numpy.sqrt(a), rtol=rtol)
+
+
 class TestElementwiseKernelSize(unittest.TestCase):
     # Tests to check whether size argument raises ValueError correctly
     # depending on the raw specifiers of a user kernel.
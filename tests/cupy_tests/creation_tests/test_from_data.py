@@ -533,6 +533,21 @@ class TestFromData(unittest.TestCase):
             fh.seek(0)
             return xp.fromfile(fh, dtype="u1")
 
+    @testing.numpy_cupy_array_equal()
+    def test_fromfile_offset_count(self, xp):
+        with tempfile.TemporaryFile() as fh:
+            fh.write(numpy.arange(10, dtype='i4').tobytes())
+            fh.flush()
+            fh.seek(4)
+            return xp.fromfile(fh, dtype='i4', count=3, offset=8)
+
+    @testing.numpy_cupy_array_equal()
+    def test_fromfile_path(self, xp):
+        with tempfile.TemporaryDirectory() as d:
+            path = os.path.join(d, 'a.bin')
+            numpy.arange(12, dtype='f8').tofile(path)
+            return xp.fromfile(path, dtype='f8')
+
     @testing.numpy_cupy_array_equal()
     def test_fromfunction(self, xp):
         def function(i, j): return i == j
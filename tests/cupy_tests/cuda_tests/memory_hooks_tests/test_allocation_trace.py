@@ -0,0 +1,102 @@
+import io
+import json
+import unittest
+
+import pytest
+
+from cupy.cuda import memory
+from cupy.cuda import memory_hooks
+
+
+class TestAllocationTraceHook(unittest.TestCase):
+
+    def setUp(self):
+        self.pool = memory.MemoryPool()
+
+    def test_events(self):
+        hook = memory_hooks.AllocationTraceHook()
+        with hook:
+            p1 = self.pool.malloc(1000)
+            p2 = self.pool.malloc(2000)
+            ptr1 = p1.ptr
+            del p1
+        del p2
+        events = hook.events()
+        hooks = [e['hook'] for e in events]
+        assert hooks == ['alloc', 'malloc', 'alloc', 'malloc', 'free']
+        malloc = events[1]
+        assert malloc['mem_size'] == 1024
+        assert malloc['mem_ptr'] == ptr1
+        assert malloc['used'] == 1024
+        assert malloc['stack'][-1][2] == 'test_events'
+        assert events[3]['used'] == 3072
+        assert events[4]['mem_ptr'] == ptr1
+        assert events[4]['used'] == 2048
+        assert [e['time'] for e in events] == sorted(
+            e['time'] for e in events)
+
+    def test_ring_buffer(self):
+        hook = memory_hooks.AllocationTraceHook(capacity=3)
+        with hook:
+            for _ in range(4):
+                self.pool.malloc(1000)
+        events = hook.events()
+        assert len(events) == 3
+        assert hook.dropped_events == 6
+        assert events[-1]['hook'] == 'free'
+
+    def test_peak_attribution(self):
+        hook = memory_hooks.AllocationTraceHook()
+        device_id = self.pool.malloc(1).device_id
+        with hook:
+            p1 = self.pool.malloc(1000)
+            p2 = self._malloc(2000)
+            del p1, p2
+            p3 = self.pool.malloc(1000)
+            del p3
+        peak, stacks = hook.peak_attribution(device_id)
+        assert peak == 3072
+        assert [nbytes for nbytes, _ in stacks] == [2048, 1024]
+        assert stacks[0][1][-1][2] == '_malloc'
+        assert stacks[1][1][-1][2] == 'test_peak_attribution'
+        assert hook.peak_attribution(device_id + 1) == (0, [])
+
+        f = io.StringIO()
+        hook.print_report(file=f)
+        lines = f.getvalue().splitlines()
+        assert lines[0].startswith('device %d: peak 3.00KB' % device_id)
+        assert lines[1].strip().startswith('2.00KB')
+        assert lines[1].endswith(':_malloc')
+
+    def _malloc(self, size):
+        return self.pool.malloc(size)
+
+    def test_export_chrome_trace(self):
+        hook = memory_hooks.AllocationTraceHook()
+        with hook:
+            p = self.pool.malloc(1000)
+            del p
+        f = io.StringIO()
+        hook.export_chrome_trace(f)
+        data = json.loads(f.getvalue())
+        events = data['traceEvents']
+        names = [e['name'] for e in events if e['ph'] == 'i']
+        assert names == ['alloc', 'malloc', 'free']
+        used = [e['args']['used'] for e in events if e['ph'] == 'C']
+        assert used == [1024, 0]
+        frames = data['stackFrames']
+        for e in events:
+            if 'sf' in e:
+                assert str(e['sf']) in frames
+
+    def test_no_stack(self):
+        hook = memory_hooks.AllocationTraceHook(stack_depth=0)
+        with hook:
+            self.pool.malloc(1000)
+        assert all(e['stack'] == [] for e in hook.events())
+
+    def test_invalid(self):
+        with pytest.raises(ValueError):
+            memory_hooks.AllocationTraceHook(capacity=0)
+        with pytest.raises(ValueError):
+            memory_hooks.AllocationTraceHook(stack_depth=-1)
@@ -1,7 +1,13 @@
+import os
 import pickle
+import shutil
+import tempfile
+import threading
 import unittest
 from unittest import mock
 
+import pytest
+
 import cupy
 from cupy.cuda import compiler
 
@@ -128,3 +134,100 @@ class TestExceptionPicklable(unittest.TestCase):
 class TestCompileWithCache:
     def test_compile_module_with_cache(self):
         compiler._compile_module_with_cache('__device__ void func() {}')
+
+
+class TestCompileOnce(unittest.TestCase):
+
+    def test_concurrent_requests(self):
+        started = threading.Event()
+        release = threading.Event()
+        calls = []
+
+        def func():
+            calls.append(1)
+            started.set()
+            release.wait()
+            return 'compiled'
+
+        results = []
+        owner = threading.Thread(
+            target=lambda: results.append(compiler._compile_once('k', func)))
+        owner.start()
+        started.wait()
+        waiter = threading.Thread(
+            target=lambda: results.append(compiler._compile_once('k', func)))
+        waiter.start()
+        release.set()
+        owner.join()
+        waiter.join()
+        assert results == ['compiled', 'compiled']
+        assert len(calls) == 1
+        assert 'k' not in compiler._in_flight_compiles
+
+    def test_error(self):
+        def func():
+            raise ValueError('broken')
+
+        with self.assertRaises(ValueError):
+            compiler._compile_once('k', func)
+        assert 'k' not in compiler._in_flight_compiles
+
+
+class TestCacheBundle(unittest.TestCase):
+
+    def setUp(self):
+        self.temp_dir = tempfile.mkdtemp()
+        self.bundles = compiler._bundles[:]
+
+    def tearDown(self):
+        compiler._bundles[:] = self.bundles
+        shutil.rmtree(self.temp_dir)
+
+    def _write_entry(self, cache_dir, name, binary):
+        hash_value = compiler._hash_hexdigest(binary).encode('ascii')
+        with open(os.path.join(cache_dir, name), 'wb') as f:
+            f.write(hash_value + binary)
+
+    def test_export_and_load(self):
+        suffix = '.hsaco' if cupy.cuda.runtime.is_hip else '.cubin'
+        cache_dir = os.path.join(self.temp_dir, 'cache')
+        os.mkdir(cache_dir)
+        self._write_entry(cache_dir, 'a' + suffix, b'binary a')
+        self._write_entry(cache_dir, 'b' + suffix, b'binary b')
+        # corrupted entries are not exported
+        with open(os.path.join(cache_dir, 'c' + suffix), 'wb') as f:
+            f.write(b'broken')
+
+        path = os.path.join(self.temp_dir, 'kernels.bundle')
+        assert compiler.export_cache_bundle(path, cache_dir) == 2
+        assert compiler.load_cache_bundle(path)
+        assert compiler._get_bundled_binary('a' + suffix) == b'binary a'
+        assert compiler._get_bundled_binary('b' + suffix) == b'binary b'
+        assert compiler._get_bundled_binary('c' + suffix) is None
+
+    def test_arch_mismatch(self):
+        path = os.path.join(self.temp_dir, 'kernels.bundle')
+        compiler.export_cache_bundle(path, self.temp_dir, arch='unknown')
+        with pytest.warns(UserWarning, match='Ignoring'):
+            assert not compiler.load_cache_bundle(path)
+
+    def test_installed_bundle(self):
+        suffix = '.hsaco' if cupy.cuda.runtime.is_hip else '.cubin'
+        cache_dir = os.path.join(self.temp_dir, 'cache')
+        os.mkdir(cache_dir)
+        self._write_entry(cache_dir, 'a' + suffix, b'binary a')
+        path = os.path.join(self.temp_dir, 'installed.bundle')
+        compiler.export_cache_bundle(path, cache_dir)
+
+        compiler._bundles[:] = []
+        loaded = compiler._bundles_from_env_loaded
+        compiler._bundles_from_env_loaded = False
+        try:
+            with mock.patch.object(
+                    compiler, '_get_installed_bundle_path',
+                    return_value=path), \
+                    mock.patch.dict(os.environ, {'CUPY_CACHE_BUNDLE': ''}):
+                assert compiler._get_bundled_binary('a' + suffix) == (
+                    b'binary a')
+        finally:
+            compiler._bundles_from_env_loaded = loaded
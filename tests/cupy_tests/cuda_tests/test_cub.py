@@ -0,0 +1,251 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+from cupy.cuda import cub
+
+
+@pytest.mark.skipif(
+    not cub.available, reason='The CUB routine is not enabled')
+class TestDeviceMultiReduce:
+
+    @testing.for_dtypes('qQfdFD')
+    def test_multi_reduce(self, dtype):
+        a = testing.shaped_random((1000,), cupy, dtype)
+        ops = (cub.CUPY_CUB_SUM, cub.CUPY_CUB_MIN, cub.CUPY_CUB_MAX,
+               cub.CUPY_CUB_ARGMIN, cub.CUPY_CUB_ARGMAX)
+        s, mn, mx, amin, amax = cub.device_multi_reduce(a, ops)
+        a_np = a.get()
+        testing.assert_allclose(s, a_np.sum(), rtol=1e-5)
+        testing.assert_array_equal(mn, a_np.min())
+        testing.assert_array_equal(mx, a_np.max())
+        assert int(amin) == a_np.argmin()
+        assert int(amax) == a_np.argmax()
+
+    @testing.for_float_dtypes(no_float16=True)
+    def test_multi_reduce_nan(self, dtype):
+        a_np = numpy.arange(100, dtype=dtype)
+        a_np[[10, 30]] = numpy.nan
+        a = cupy.asarray(a_np)
+        mn, mx, amin, amax = cub.device_multi_reduce(
+            a, (cub.CUPY_CUB_MIN, cub.CUPY_CUB_MAX,
+                cub.CUPY_CUB_ARGMIN, cub.CUPY_CUB_ARGMAX))
+        assert cupy.isnan(mn) and cupy.isnan(mx)
+        assert int(amin) == 10
+        assert int(amax) == 10
+
+    def test_multi_reduce_prod(self):
+        a = cupy.arange(1, 11, dtype=cupy.float64)
+        p, = cub.device_multi_reduce(a, (cub.CUPY_CUB_PROD,))
+        testing.assert_allclose(p, numpy.prod(numpy.arange(1, 11)))
+
+    def test_multi_reduce_empty(self):
+        a = cupy.empty((0,), dtype=cupy.float32)
+        s, p = cub.device_multi_reduce(
+            a, (cub.CUPY_CUB_SUM, cub.CUPY_CUB_PROD))
+        assert float(s) == 0
+        assert float(p) == 1
+        with pytest.raises(ValueError):
+            cub.device_multi_reduce(a, (cub.CUPY_CUB_MAX,))
+
+    def test_multi_reduce_invalid_op(self):
+        a = cupy.arange(10, dtype=cupy.float32)
+        with pytest.raises(ValueError):
+            cub.device_multi_reduce(a, (cub.CUPY_CUB_CUMSUM,))
+        with pytest.raises(ValueError):
+            cub.device_multi_reduce(a, ())
+
+
+@pytest.mark.skipif(
+    not cub.available, reason='The CUB routine is not enabled')
+class TestDeviceNanReduce:
+
+    def _random_with_nan(self, dtype):
+        a_np = testing.shaped_random((5000,), numpy, dtype)
+        a_np[::7] = numpy.nan
+        return a_np
+
+    @testing.for_dtypes('fdFD')
+    def test_nan_reduce(self, dtype):
+        a_np = self._random_with_nan(dtype)
+        a = cupy.asarray(a_np)
+        s = cub.device_nan_reduce(a, cub.CUPY_CUB_NANSUM)
+        m = cub.device_nan_reduce(a, cub.CUPY_CUB_NANMEAN)
+        v = cub.device_nan_reduce(a, cub.CUPY_CUB_NANVAR)
+        testing.assert_allclose(s, numpy.nansum(a_np), rtol=1e-5)
+        testing.assert_allclose(m, numpy.nanmean(a_np), rtol=1e-5)
+        testing.assert_allclose(v, numpy.nanvar(a_np), rtol=1e-5)
+        assert v.dtype == a_np.real.dtype
+
+    @testing.for_dtypes('fd')
+    def test_nan_reduce_ddof(self, dtype):
+        a_np = self._random_with_nan(dtype)
+        a = cupy.asarray(a_np)
+        v = cub.device_nan_reduce(a, cub.CUPY_CUB_NANVAR, ddof=1)
+        testing.assert_allclose(v, numpy.nanvar(a_np, ddof=1), rtol=1e-5)
+        v = cub.device_nan_reduce(
+            cupy.array([1, numpy.nan], dtype=dtype), cub.CUPY_CUB_NANVAR,
+            ddof=1)
+        assert cupy.isnan(v)
+
+    def test_nan_reduce_all_nan(self):
+        a = cupy.full((100,), numpy.nan, dtype=cupy.float64)
+        assert float(cub.device_nan_reduce(a, cub.CUPY_CUB_NANSUM)) == 0
+        assert cupy.isnan(cub.device_nan_reduce(a, cub.CUPY_CUB_NANMEAN))
+        assert cupy.isnan(cub.device_nan_reduce(a, cub.CUPY_CUB_NANVAR))
+
+    def test_nan_reduce_invalid_op(self):
+        a = cupy.arange(10, dtype=cupy.float32)
+        with pytest.raises(ValueError):
+            cub.device_nan_reduce(a, cub.CUPY_CUB_SUM)
+
+
+@pytest.mark.skipif(
+    not cub.available, reason='The CUB routine is not enabled')
+class TestDeviceScan:
+
+    @testing.for_dtypes('ilqfd')
+    def test_exclusive_cumsum(self, dtype):
+        a = testing.shaped_random((100,), cupy, dtype)
+        expected = numpy.concatenate(([0], numpy.cumsum(a.get())[:-1]))
+        b = cub.device_scan(a.copy(), cub.CUPY_CUB_EXCLUSIVE_CUMSUM)
+        testing.assert_allclose(b, expected.astype(dtype), rtol=1e-5)
+
+    @testing.for_dtypes('ilqfd')
+    def test_cummin_cummax(self, dtype):
+        a = testing.shaped_random((100,), cupy, dtype)
+        a_np = a.get()
+        b = cub.device_scan(a.copy(), cub.CUPY_CUB_CUMMIN)
+        testing.assert_array_equal(b, numpy.minimum.accumulate(a_np))
+        b = cub.device_scan(a.copy(), cub.CUPY_CUB_CUMMAX)
+        testing.assert_array_equal(b, numpy.maximum.accumulate(a_np))
+
+    @testing.for_dtypes('ilqfd')
+    def test_scan_by_key(self, dtype):
+        a = testing.shaped_random((4, 25), cupy, dtype)
+        b = cub.device_scan_by_key(
+            a.ravel().copy(), cub.CUPY_CUB_CUMSUM, segment_size=25)
+        testing.assert_allclose(
+            b.reshape(4, 25), numpy.cumsum(a.get(), axis=1), rtol=1e-5)
+
+    def test_scan_by_key_explicit_keys(self):
+        keys = cupy.array([0, 0, 1, 1, 1, 2, 0], dtype=cupy.int32)
+        a = cupy.arange(1, 8, dtype=cupy.int64)
+        b = cub.device_scan_by_key(
+            a, cub.CUPY_CUB_EXCLUSIVE_CUMSUM, keys=keys)
+        testing.assert_array_equal(b, [0, 1, 0, 3, 7, 0, 0])
+
+
+@pytest.mark.skipif(
+    not cub.available, reason='The CUB routine is not enabled')
+class TestDeviceSelect:
+
+    @testing.for_all_dtypes(no_float16=True)
+    def test_select_flagged(self, dtype):
+        a = testing.shaped_random((100,), cupy, dtype)
+        flags = testing.shaped_random((100,), cupy, cupy.bool_)
+        y, n = cub.device_select_flagged(a, flags)
+        expected = a.get()[flags.get()]
+        assert int(n) == expected.size
+        testing.assert_array_equal(y[:int(n)], expected)
+
+    @testing.for_all_dtypes(no_float16=True)
+    def test_nonzero(self, dtype):
+        a = testing.shaped_random((4, 25), cupy, dtype)
+        idx = cub.cub_nonzero(a)
+        testing.assert_array_equal(idx, numpy.flatnonzero(a.get()))
+
+    @pytest.mark.parametrize('op, np_op', [
+        (cub.CUPY_CUB_SELECT_GREATER, numpy.greater),
+        (cub.CUPY_CUB_SELECT_GREATER_EQUAL, numpy.greater_equal),
+        (cub.CUPY_CUB_SELECT_LESS, numpy.less),
+        (cub.CUPY_CUB_SELECT_LESS_EQUAL, numpy.less_equal),
+        (cub.CUPY_CUB_SELECT_EQUAL, numpy.equal),
+        (cub.CUPY_CUB_SELECT_NOT_EQUAL, numpy.not_equal),
+    ])
+    @testing.for_dtypes('iqfd')
+    def test_select_if(self, op, np_op, dtype):
+        a = testing.shaped_random((100,), cupy, dtype, scale=10)
+        y, n = cub.device_select_if(a, op, 5)
+        a_np = a.get()
+        expected = a_np[np_op(a_np, dtype(5))]
+        testing.assert_array_equal(y[:int(n)], expected)
+
+    def test_select_if_not_nan(self):
+        a_np = numpy.arange(10, dtype=numpy.float64)
+        a_np[[2, 7]] = numpy.nan
+        y, n = cub.device_select_if(
+            cupy.asarray(a_np), cub.CUPY_CUB_SELECT_NOT_NAN)
+        testing.assert_array_equal(y[:int(n)], a_np[~numpy.isnan(a_np)])
+
+    @pytest.mark.parametrize('equal_nan', [True, False])
+    def test_unique(self, equal_nan):
+        a_np = numpy.array([0, 0, 1, 2, 2, 2, 5, numpy.nan, numpy.nan])
+        a = cupy.asarray(a_np)
+        y = cub.cub_unique(a, equal_nan)
+        expected = numpy.unique(a_np, equal_nan=equal_nan)
+        testing.assert_array_equal(y, expected)
+
+    @testing.for_all_dtypes(no_float16=True)
+    def test_partition(self, dtype):
+        a = testing.shaped_random((100,), cupy, dtype)
+        flags = testing.shaped_random((100,), cupy, cupy.bool_)
+        y, n = cub.device_partition(a, flags)
+        a_np, flags_np = a.get(), flags.get()
+        n = int(n)
+        testing.assert_array_equal(y[:n], a_np[flags_np])
+        testing.assert_array_equal(y[n:], a_np[~flags_np][::-1])
+
+    def test_empty(self):
+        a = cupy.empty((0,), dtype=cupy.float32)
+        y, n = cub.device_select_flagged(a, cupy.empty((0,), cupy.bool_))
+        assert int(n) == 0
+        y, n = cub.device_unique(a)
+        assert int(n) == 0
+
+
+@pytest.mark.skipif(
+    not cub.available, reason='The CUB routine is not enabled')
+class TestDeviceHistogram:
+
+    @testing.for_dtypes('iqfd')
+    def test_histogram_range(self, dtype):
+        a = testing.shaped_random((1000,), cupy, dtype, scale=10)
+        bins = cupy.array([0, 1, 2.5, 5, 10], dtype=(
+            numpy.float64 if a.dtype.kind in 'iu' else dtype))
+        y = cupy.zeros((4,), numpy.int64)
+        cub.device_histogram(a, y, bins)
+        expected, _ = numpy.histogram(a.get(), bins.get())
+        testing.assert_array_equal(y, expected)
+
+    @testing.for_dtypes('bhiq')
+    def test_histogram_even(self, dtype):
+        a = testing.shaped_random((1000,), cupy, dtype, scale=10)
+        y = cupy.zeros((10,), numpy.int64)
+        cub.device_histogram(a, y, 11)
+        testing.assert_array_equal(y, numpy.bincount(a.get(), minlength=10))
+
+    @pytest.mark.parametrize('mode, func', [
+        ('abs', numpy.abs), ('angle', numpy.angle)])
+    @testing.for_complex_dtypes()
+    def test_histogram_complex(self, mode, func, dtype):
+        a = testing.shaped_random((1000,), cupy, dtype) - (0.5 + 0.5j)
+        real_dtype = a.real.dtype
+        if mode == 'abs':
+            bins = cupy.linspace(0, 1, 9, dtype=real_dtype)
+        else:
+            bins = cupy.linspace(-numpy.pi, numpy.pi, 9, dtype=real_dtype)
+        y = cupy.zeros((8,), numpy.int64)
+        cub.device_histogram(a, y, bins, complex_mode=mode)
+        expected, _ = numpy.histogram(func(a.get()), bins.get())
+        testing.assert_array_equal(y, expected)
+
+    def test_histogram_complex_invalid(self):
+        a = cupy.zeros((10,), numpy.complex64)
+        y = cupy.zeros((2,), numpy.int64)
+        with pytest.raises(ValueError):
+            cub.device_histogram(a, y, cupy.array([0, 1, 2], numpy.float32))
+        with pytest.raises(ValueError):
+            cub.device_histogram(
+                a, y, cupy.array([0, 1, 2], numpy.float64), 'abs')
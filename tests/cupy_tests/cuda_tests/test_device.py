@@ -193,6 +193,20 @@ class TestDeviceSwitch(unittest.TestCase):
             assert 1 == cuda.Device().id
         assert 1 == cuda.Device().id
 
+    def test_context_same_device(self):
+        dev0 = cuda.Device(0)
+        dev1 = cuda.Device(1)
+
+        dev0.use()
+        with dev0:
+            with dev0:
+                assert 0 == cuda.Device().id
+                dev1.synchronize()
+                assert 0 == cuda.Device().id
+                dev1.use()
+            assert 0 == cuda.Device().id
+        assert 0 == cuda.Device().id
+
     def test_thread_safe(self):
         dev0 = cuda.Device(0)
         dev1 = cuda.Device(1)
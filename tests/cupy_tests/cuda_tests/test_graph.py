@@ -377,3 +377,95 @@ class TestGraph:
                 cupy.cuda.runtime.cudaGraphDebugDotFlagsVerbose)
             assert 'cupy_sin' in debug_str_verbose
             assert debug_str != debug_str_verbose
+
+    def test_update(self):
+        s = cupy.cuda.Stream(non_blocking=True)
+        a = cupy.arange(10, dtype=cupy.float32)
+        b = cupy.arange(10, 20, dtype=cupy.float32)
+        out_a = cupy.empty_like(a)
+        out_b = cupy.empty_like(b)
+        with s:
+            s.begin_capture()
+            cupy.multiply(a, 2, out=out_a)
+            g1 = s.end_capture()
+            s.begin_capture()
+            cupy.multiply(b, 2, out=out_b)
+            g2 = s.end_capture(instantiate=False)
+            assert g2.graphExec == 0
+            assert g1.update(g2)
+            g1.launch()
+        s.synchronize()
+        testing.assert_array_equal(out_b, b * 2)
+
+    def test_update_rejected(self):
+        s = cupy.cuda.Stream(non_blocking=True)
+        a = cupy.arange(10, dtype=cupy.float32)
+        with s:
+            s.begin_capture()
+            a * 2
+            g1 = s.end_capture()
+            s.begin_capture()
+            cupy.sin(a) + 1
+            g2 = s.end_capture(instantiate=False)
+        assert not g1.update(g2)
+
+
+@pytest.mark.skipif(cuda.runtime.is_hip,
+                    reason='HIP does not support stream capture')
+class TestGraphFunction:
+
+    def test_replay(self):
+        calls = []
+
+        @cupyx.graph_function
+        def f(x, y, out):
+            calls.append(None)
+            cupy.add(x * 2, y, out=out)
+
+        x = testing.shaped_random((100,), cupy, cupy.float32)
+        y = testing.shaped_random((100,), cupy, cupy.float32)
+        out = cupy.empty_like(x)
+        for _ in range(3):
+            f(x, y, out)
+            testing.assert_allclose(out, x * 2 + y)
+            x += 1
+        assert len(calls) == 1
+
+    def test_rotating_buffers(self):
+        calls = []
+
+        @cupyx.graph_function(max_graphs=1)
+        def f(x):
+            calls.append(None)
+            return cupy.sin(x) + 1
+
+        xs = [testing.shaped_random((10,), cupy, cupy.float32, seed=i)
+              for i in range(2)]
+        for i in range(4):
+            x = xs[i % 2]
+            testing.assert_allclose(f(x), cupy.sin(x) + 1)
+        # each set of pointers is captured, and replayed by updating the
+        # single instantiated graph
+        assert len(calls) == 4
+        entries, = f._entries.values()
+        assert len(entries) == 1
+
+    def test_signature(self):
+        calls = []
+
+        @cupyx.graph_function
+        def f(x, scale):
+            calls.append(None)
+            return x * scale
+
+        x = cupy.arange(10, dtype=cupy.float32)
+        testing.assert_array_equal(f(x, 2.0), x * 2)
+        testing.assert_array_equal(f(x, 3.0), x * 3)
+        testing.assert_array_equal(f(x[:5], 3.0), x[:5] * 3)
+        testing.assert_array_equal(f(x, 2.0), x * 2)
+        assert len(calls) == 3
+
+    def test_unhashable(self):
+        f = cupyx.graph_function(lambda x, d: x)
+        with pytest.raises(TypeError):
+            f(cupy.zeros(3), {})
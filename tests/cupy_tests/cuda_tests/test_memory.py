@@ -1,10 +1,12 @@
 import ctypes
 import gc
+import os
 import pickle
 import threading
 import unittest
 
 import fastrlock
+import numpy
 import pytest
 
 import cupy.cuda
@@ -531,6 +533,55 @@ class TestSingleDeviceMemoryPool(unittest.TestCase):
             assert ptr1 != p4.ptr
             assert ptr2 != p4.ptr
 
+    def test_trim(self):
+        p1 = self.pool.malloc(self.unit * 4)
+        p2 = self.pool.malloc(self.unit * 2)
+        del p1, p2
+        # both sizes were requested since the pool was created
+        self.pool.trim()
+        assert self.unit * 6 == self.pool.total_bytes()
+        p3 = self.pool.malloc(self.unit * 2)
+        del p3
+        self.pool.trim()
+        assert self.unit * 2 == self.pool.total_bytes()
+        self.pool.trim()
+        assert 0 == self.pool.total_bytes()
+
+    def test_best_fit_across_arenas(self):
+        with self.assertRaises(ValueError):
+            self.pool.set_arena_policy('unknown')
+        self.pool.set_arena_policy('best_fit')
+        p1 = self.pool.malloc(self.unit * 4)
+        p2 = self.pool.malloc(self.unit * 8)
+        ptr1 = p1.ptr
+        del p1, p2
+        with self.stream:
+            p3 = self.pool.malloc(self.unit * 2)
+            assert ptr1 == p3.ptr
+            assert self.unit * 12 == self.pool.total_bytes()
+            del p3
+            # the block now belongs to the arena of the stream
+            self.pool.set_arena_policy('per_stream')
+            p4 = self.pool.malloc(self.unit * 4)
+            assert ptr1 == p4.ptr
+            del p4
+
+    def test_get_fragmentation_info(self):
+        assert {} == self.pool.get_fragmentation_info()
+        with self.stream:
+            p1 = self.pool.malloc(self.unit * 4)
+            p2 = self.pool.malloc(self.unit * 2)
+            del p1
+            head = self.pool.malloc(self.unit)
+            del p2
+        info = self.pool.get_fragmentation_info()[self.stream_ident]
+        assert 2 == info['n_free_blocks']
+        assert self.unit * 5 == info['free_bytes']
+        assert self.unit * 3 == info['largest_free_block']
+        assert self.unit * 2 == info['releasable_bytes']
+        assert {self.unit * 3: 1, self.unit * 2: 1} == info['histogram']
+        del head
+
     def test_free_all_free(self):
         p1 = self.pool.malloc(self.unit * 4)
         ptr1 = p1.ptr
@@ -645,6 +696,89 @@ class TestSingleDeviceMemoryPool(unittest.TestCase):
         with self.assertRaises(ValueError):
             self.pool.set_limit(fraction=1.1)
 
+    def test_slab(self):
+        self.pool.set_slab_threshold(self.unit * 2)
+        p1 = self.pool.malloc(self.unit * 2 - 1)
+        p2 = self.pool.malloc(self.unit * 2)
+        assert p2.ptr == p1.ptr + self.unit * 2
+        slab_size = self.pool.total_bytes()
+        assert self.unit * 4 == self.pool.used_bytes()
+        assert slab_size - self.unit * 4 == self.pool.free_bytes()
+
+        # a freed slot is reused, and larger sizes use the blocks
+        ptr = p1.ptr
+        del p1
+        p1 = self.pool.malloc(self.unit)
+        p3 = self.pool.malloc(self.unit * 2)
+        assert p3.ptr == ptr
+        p4 = self.pool.malloc(self.unit * 3)
+        assert slab_size * 2 + self.unit * 3 == self.pool.total_bytes()
+        assert self.unit * 8 == self.pool.used_bytes()
+
+        # the slabs are released once all their slots are freed
+        del p2, p4
+        self.pool.free_all_blocks()
+        assert slab_size * 2 == self.pool.total_bytes()
+        del p1, p3
+        self.pool.free_all_blocks()
+        assert 0 == self.pool.total_bytes()
+        assert 0 == self.pool.used_bytes()
+
+    def test_slab_stream(self):
+        self.pool.set_slab_threshold(self.unit)
+        p1 = self.pool.malloc(self.unit)
+        ptr = p1.ptr
+        del p1
+        with self.stream:
+            p2 = self.pool.malloc(self.unit)
+        assert p2.ptr != ptr
+        p3 = self.pool.malloc(self.unit)
+        assert p3.ptr == ptr
+        del p2, p3
+
+    @pytest.mark.skipif(runtime.is_hip, reason='HIP does not support capture')
+    def test_capture_policy(self):
+        with self.assertRaises(ValueError):
+            self.pool.set_capture_policy('unknown')
+        self.pool.set_capture_policy('per_graph')
+        self.pool.set_slab_threshold(0)
+        stream = stream_module.Stream(non_blocking=True)
+        with stream:
+            stream.begin_capture()
+            p1 = self.pool.malloc(self.unit * 4)
+            ptr1 = p1.ptr
+            del p1
+            # the block is reused within the capture
+            p2 = self.pool.malloc(self.unit * 4)
+            assert ptr1 == p2.ptr
+            del p2
+            g = stream.end_capture(instantiate=False)
+
+            # but not by other work while the graph is alive
+            p3 = self.pool.malloc(self.unit * 4)
+            assert ptr1 != p3.ptr
+            del p3
+            self.pool.free_all_blocks()
+            assert self.unit * 4 == self.pool.total_bytes()
+            del g
+            p4 = self.pool.malloc(self.unit * 4)
+            assert ptr1 == p4.ptr
+            del p4
+
+    @pytest.mark.skipif(runtime.is_hip, reason='HIP does not support capture')
+    def test_capture_policy_shared(self):
+        self.pool.set_slab_threshold(0)
+        stream = stream_module.Stream(non_blocking=True)
+        with stream:
+            stream.begin_capture()
+            p1 = self.pool.malloc(self.unit * 4)
+            ptr1 = p1.ptr
+            del p1
+            g = stream.end_capture(instantiate=False)
+            p2 = self.pool.malloc(self.unit * 4)
+            assert ptr1 == p2.ptr
+            del p2, g
+
 
 class TestParseMempoolLimitEnvVar(unittest.TestCase):
     def test_parse_limit_string(self):
@@ -677,9 +811,87 @@ class TestParseMempoolLimitEnvVar(unittest.TestCase):
         assert 1.0 == param['fraction']
 
 
+class TestVirtualMemory(unittest.TestCase):
+
+    def setUp(self):
+        try:
+            memory.VirtualMemory(1)
+        except cupy.cuda.driver.CUDADriverError as e:
+            raise unittest.SkipTest(
+                'virtual memory management is unavailable: {}'.format(e))
+
+    def test_zero_size(self):
+        mem = memory.VirtualMemory(0)
+        assert mem.ptr == 0
+        assert mem.size == 0
+
+    def test_alloc(self):
+        mem = memory.VirtualMemory(1000)
+        assert mem.size == 1000
+        assert mem.reserved_size == mem.granularity
+        a = cupy.ndarray((1000,), numpy.int8, memory.MemoryPointer(mem, 0))
+        a[...] = 3
+        assert int(a.sum()) == 3000
+
+    def test_resize(self):
+        mem = memory.VirtualMemory(1000, reserve=16 * 1024 * 1024)
+        ptr = mem.ptr
+        n = mem.granularity + 1000
+        a = cupy.ndarray((1000,), numpy.int8, memory.MemoryPointer(mem, 0))
+        a[...] = 1
+        mem.resize(n)
+        assert mem.ptr == ptr
+        assert mem.size == n
+        b = cupy.ndarray((n,), numpy.int8, memory.MemoryPointer(mem, 0))
+        b[1000:] = 2
+        assert int(b.sum()) == 1000 + 2 * (n - 1000)
+        mem.resize(500)
+        assert int(a[:500].sum()) == 500
+        with pytest.raises(ValueError):
+            mem.resize(mem.reserved_size + 1)
+
+    def test_pool(self):
+        pool = memory.MemoryPool(memory.malloc_virtual)
+        p = pool.malloc(1000)
+        assert p.mem.identity == 'VirtualMemory'
+        del p
+        pool.free_all_blocks()
+        assert pool.total_bytes() == 0
+
+
 @testing.parameterize(*testing.product({
     'allocator': [memory._malloc, memory.malloc_managed],
 }))
+@pytest.mark.skipif(
+    not runtime.deviceGetAttribute(
+        runtime.cudaDevAttrPageableMemoryAccess, 0),
+    reason='HMM or ATS is not available')
+class TestSystemMemoryAllocator:
+
+    @pytest.mark.parametrize('preferred_location', ('device', 'host', None))
+    @pytest.mark.parametrize('prefetch', (True, False))
+    def test_malloc(self, preferred_location, prefetch):
+        allocator = memory.SystemMemoryAllocator(
+            prefetch=prefetch, preferred_location=preferred_location)
+        with cupy.cuda.using_allocator(allocator.malloc):
+            a = cupy.arange(1000, dtype=cupy.float32)
+            assert a.data.mem.identity == 'SystemMemory'
+            testing.assert_array_equal(a * 2, numpy.arange(1000) * 2)
+
+    def test_reuse(self):
+        allocator = memory.SystemMemoryAllocator()
+        ptr = allocator.malloc(1024).ptr
+        assert allocator.malloc(1024).ptr == ptr
+
+    def test_zero_size(self):
+        allocator = memory.SystemMemoryAllocator()
+        assert allocator.malloc(0).ptr == 0
+
+    def test_invalid_location(self):
+        with pytest.raises(ValueError):
+            memory.SystemMemoryAllocator(preferred_location='gpu')
+
+
 class TestMemoryPool(unittest.TestCase):
 
     def setUp(self):
@@ -1339,3 +1551,47 @@ class TestMemoryAsyncPool(unittest.TestCase):
 
         with self.assertRaises(ValueError):
             self.pool.set_limit(fraction=1.1)
+
+
+@pytest.mark.skipif(cupy.cuda.runtime.is_hip,
+                    reason='HIP does not support async allocator')
+@pytest.mark.skipif(cupy.cuda.driver._is_cuda_python()
+                    and cupy.cuda.runtime.runtimeGetVersion() < 11020,
+                    reason='malloc_async is supported since CUDA 11.2')
+@pytest.mark.skipif(not cupy.cuda.driver._is_cuda_python()
+                    and cupy.cuda.driver.get_build_version() < 11020,
+                    reason='malloc_async is supported since CUDA 11.2')
+class TestMemoryAsyncPoolExport(unittest.TestCase):
+
+    def setUp(self):
+        if cupy.cuda.runtime.deviceGetAttribute(
+                cupy.cuda.runtime.cudaDevAttrMemoryPoolsSupported, 0) == 0:
+            pytest.skip('malloc_async is not supported on device 0')
+        self.pool = memory.MemoryAsyncPool('create')
+
+    def tearDown(self):
+        for dev_id in range(runtime.getDeviceCount()):
+            runtime.deviceSetMemPool(
+                dev_id, runtime.deviceGetDefaultMemPool(dev_id))
+
+    def test_create(self):
+        pool = self.pool._pools[device.get_device_id()]
+        assert pool != runtime.deviceGetDefaultMemPool(
+            device.get_device_id())
+        assert pool == runtime.deviceGetMemPool(device.get_device_id())
+
+    def test_export(self):
+        try:
+            fd = self.pool.export_handle()
+        except runtime.CUDARuntimeError:
+            pytest.skip('the pool cannot be exported on this platform')
+        os.close(fd)
+        mem = self.pool.malloc(100)
+        data = self.pool.export_pointer(mem)
+        assert isinstance(data, bytes)
+        assert len(data) == 64
+
+    def test_export_pointer_invalid(self):
+        mem = memory.alloc(100)
+        with pytest.raises(ValueError):
+            self.pool.export_pointer(mem)
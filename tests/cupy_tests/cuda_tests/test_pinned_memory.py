@@ -1,3 +1,4 @@
+import threading
 import unittest
 
 from cupy.cuda import pinned_memory
@@ -127,3 +128,46 @@ class TestSingleDeviceMemoryPool(unittest.TestCase):
     def test_n_free_blocks_without_malloc(self):
         # call directly without malloc/free_all_blocks.
         assert self.pool.n_free_blocks() == 0
+
+    def test_free_other_thread(self):
+        p1 = self.pool.malloc(1000)
+        ptr1 = p1.ptr
+
+        def free():
+            nonlocal p1
+            del p1
+
+        t = threading.Thread(target=free)
+        t.start()
+        t.join()
+        assert self.pool.n_free_blocks() == 1
+        self.pool.free_all_blocks()
+        assert self.pool.n_free_blocks() == 0
+        p2 = self.pool.malloc(1000)
+        assert ptr1 != p2.ptr
+
+    def test_free_many(self):
+        ps = [self.pool.malloc(1000) for _ in range(10)]
+        ptrs = {p.ptr for p in ps}
+        del ps
+        assert self.pool.n_free_blocks() == 10
+        ps = [self.pool.malloc(1000) for _ in range(10)]
+        assert ptrs == {p.ptr for p in ps}
+
+    def test_reserve(self):
+        self.pool.reserve(1000, 3)
+        assert self.pool.n_free_blocks() == 3
+        ps = [self.pool.malloc(1000) for _ in range(3)]
+        ptrs = sorted(p.ptr for p in ps)
+        assert [ptrs[1] - ptrs[0], ptrs[2] - ptrs[1]] == [1024, 1024]
+        del ps
+        self.pool.free_all_blocks()
+        assert self.pool.n_free_blocks() == 3
+        p = self.pool.malloc(1000)
+        assert p.ptr in ptrs
+
+    def test_reserve_invalid(self):
+        with self.assertRaises(ValueError):
+            self.pool.reserve(1000, 0)
+        with self.assertRaises(ValueError):
+            self.pool.reserve(0, 1)
@@ -147,6 +147,17 @@ class TestStream(unittest.TestCase):
         # self.stream is "forgotten"!
         assert cuda.Stream.null == cuda.get_current_stream()
 
+    def test_with_same_stream(self):
+        stream1 = cuda.Stream()
+        with stream1:
+            with stream1:
+                stream1.use()
+                assert stream1 == cuda.get_current_stream()
+                a = cupy.arange(3)
+                assert stream1 == cuda.get_current_stream()
+            assert stream1 == cuda.get_current_stream()
+        testing.assert_array_equal(a, [0, 1, 2])
+
     def test_use(self):
         stream1 = cuda.Stream().use()
         assert stream1 == cuda.get_current_stream()
@@ -0,0 +1,109 @@
+import threading
+
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+from cupy.cuda import memory_hook
+from cupy.cuda import thrust
+
+
+class _MallocCountHook(memory_hook.MemoryHook):
+    name = 'MallocCountHook'
+
+    def __init__(self):
+        self.count = 0
+
+    def malloc_preprocess(self, **kwargs):
+        self.count += 1
+
+
+@pytest.mark.skipif(
+    not thrust.available, reason='Thrust is not available')
+class TestWorkspace:
+
+    def teardown_method(self):
+        thrust.free_workspace()
+
+    def test_sort_reuses_workspace(self):
+        a = testing.shaped_random((10000,), cupy, numpy.float32)
+        a.copy().sort()  # warm up the arena
+        b = a.copy()
+        hook = _MallocCountHook()
+        with hook:
+            b.sort()
+        assert hook.count == 0
+        testing.assert_array_equal(b, numpy.sort(a.get()))
+
+    def test_multiple_streams(self):
+        a = testing.shaped_random((4, 5000), cupy, numpy.int32)
+        expected = numpy.sort(a.get(), axis=-1)
+        streams = [cupy.cuda.Stream() for _ in range(3)]
+        results = []
+        for _ in range(2):
+            for s in streams:
+                with s:
+                    b = a.copy()
+                    b.sort()
+                    results.append(b)
+        for s in streams:
+            s.synchronize()
+        for b in results:
+            testing.assert_array_equal(b, expected)
+
+    def test_free_workspace(self):
+        a = testing.shaped_random((1000,), cupy, numpy.float64)
+        a.copy().sort()
+        thrust.free_workspace()
+        b = a.copy()
+        b.sort()
+        testing.assert_array_equal(b, numpy.sort(a.get()))
+
+    def test_per_thread_default_streams(self):
+        # the threads share the handle of the per-thread default stream but
+        # not the arena
+        a = testing.shaped_random((8, 20000), cupy, numpy.float32)
+        expected = numpy.sort(a.get(), axis=-1)
+        n_threads = 4
+        barrier = threading.Barrier(n_threads)
+        results = [None] * n_threads
+        errors = []
+
+        def job(i):
+            try:
+                with cupy.cuda.Stream.ptds:
+                    barrier.wait()
+                    out = []
+                    for _ in range(5):
+                        b = a.copy()
+                        b.sort()
+                        out.append(b)
+                    cupy.cuda.Stream.ptds.synchronize()
+                    results[i] = [b.get() for b in out]
+            except Exception as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=job, args=(i,))
+                   for i in range(n_threads)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        assert not errors
+        for out in results:
+            for b in out:
+                numpy.testing.assert_array_equal(b, expected)
+
+    def test_free_all_blocks_releases_workspace(self):
+        pool = cupy.cuda.MemoryPool()
+        with cupy.cuda.using_allocator(pool.malloc):
+            a = testing.shaped_random((100000,), cupy, numpy.float32)
+            b = a.copy()
+            b.sort()
+            del a, b
+            cupy.cuda.Device().synchronize()
+            assert pool.used_bytes() > 0
+            pool.free_all_blocks()
+            assert pool.used_bytes() == 0
+            assert pool.total_bytes() == 0
@@ -43,6 +43,8 @@ class TestPlanCache(unittest.TestCase):
         for i in range(n_devices):
             with device.Device(i):
                 cache = config.get_plan_cache()
+                cache.set_shared_work_area(False)
+                cache.set_deferred_work_area(False)
                 cache.clear()
                 cache.set_size(self.old_sizes[i])
                 cache.set_memsize(-1)
@@ -495,3 +497,106 @@ class TestPlanCache(unittest.TestCase):
         assert cache.get_curr_memsize() == 2048 == cache.get_memsize()
         plan2 = next(iter(cache))[1].plan
         assert plan2 is not plan
+
+    def test_shared_work_area(self):
+        cache = config.get_plan_cache()
+        cache.set_size(-1)
+        cache.set_shared_work_area(True)
+        assert cache.get_shared_work_area()
+        assert cache.get_shared_work_area_size() == 0
+
+        sizes = [(64,), (1000,), (127, 3)]
+        arrays = [testing.shaped_random(shape, cupy, cupy.complex64)
+                  for shape in sizes]
+        outs = [cupy.fft.fftn(a) for a in arrays]
+        assert cache.get_curr_size() == len(sizes)
+        max_work_size = 0
+        for _, node in cache:
+            # the plans own no work area
+            assert node.plan.work_area is None
+            assert node.plan.shared_work_area
+            assert node.memsize == 0
+            max_work_size = max(max_work_size, node.plan.work_size)
+        assert cache.get_curr_memsize() == 0
+        assert cache.get_shared_work_area_size() >= max_work_size
+        stdout = intercept_stdout(cache.show_info)
+        assert 'shared work area: enabled' in stdout
+
+        # the cached plans still work after the area has grown
+        for a, out in zip(arrays, outs):
+            testing.assert_allclose(cupy.fft.fftn(a), out)
+        cache.set_shared_work_area(False)
+        for a, out in zip(arrays, outs):
+            testing.assert_allclose(cupy.fft.fftn(a), out)
+
+        # switching the mode clears the cache and releases the area
+        assert cache.get_shared_work_area_size() == 0
+        for _, node in cache:
+            assert node.plan.work_area is not None
+
+    def test_deferred_work_area(self):
+        cache = config.get_plan_cache()
+        cache.set_size(-1)
+        cache.set_deferred_work_area(True)
+        assert cache.get_deferred_work_area()
+        with pytest.raises(ValueError):
+            cache.set_shared_work_area(True)
+
+        sizes = [(64,), (1000,), (127, 3)]
+        arrays = [testing.shaped_random(shape, cupy, cupy.complex64)
+                  for shape in sizes]
+        outs = [cupy.fft.fftn(a) for a in arrays]
+        assert cache.get_curr_size() == len(sizes)
+        for _, node in cache:
+            # the plans own no work area while they are cached
+            assert node.plan.work_area is None
+            assert node.plan.deferred_work_area
+            assert node.memsize == 0
+        assert cache.get_curr_memsize() == 0
+        stdout = intercept_stdout(cache.show_info)
+        assert 'deferred work area: enabled' in stdout
+
+        # the borrowed work areas are returned to the pool
+        pool = cupy.get_default_memory_pool()
+        used = pool.used_bytes()
+        for a, out in zip(arrays, outs):
+            testing.assert_allclose(cupy.fft.fftn(a), out)
+        assert pool.used_bytes() <= used
+
+        # switching the mode clears the cache
+        cache.set_deferred_work_area(False)
+        assert cache.get_curr_size() == 0
+
+    def test_evict_work_areas(self):
+        cache = config.get_plan_cache()
+        cache.set_size(-1)
+        # a plan holding a work area and one that holds none
+        a = testing.shaped_random((64,), cupy, cupy.complex64)
+        cupy.fft.fft(a)
+        cupy.fft.fft(cupy.empty((0, 16), dtype=cupy.complex64))
+        assert cache.get_curr_size() == 2
+        memsize = cache.get_curr_memsize()
+        assert memsize > 0
+
+        assert cache.evict_work_areas() == memsize
+        assert cache.get_curr_size() == 1
+        assert cache.get_curr_memsize() == 0
+        assert cache.evict_work_areas() == 0
+
+    def test_memsize_eviction_keeps_plans_without_work_area(self):
+        cache = config.get_plan_cache()
+        cache.set_size(-1)
+        # a 0-size transform has a plan without a work area
+        empty = cupy.empty((0, 16), dtype=cupy.complex64)
+        cupy.fft.fft(empty)
+        a = testing.shaped_random((64,), cupy, cupy.complex64)
+        cupy.fft.fft(a)
+        assert cache.get_curr_size() == 2
+        memsize = cache.get_curr_memsize()
+
+        # the plan with the work area is the most recently used, but it is
+        # the only one that frees memory
+        cache.set_memsize(memsize - 1)
+        assert cache.get_curr_size() == 1
+        assert cache.get_curr_memsize() == 0
+        assert next(iter(cache))[1].memsize == 0
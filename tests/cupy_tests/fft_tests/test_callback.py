@@ -1,4 +1,5 @@
 import contextlib
+import os
 import string
 import sys
 import tempfile
@@ -704,3 +705,115 @@ class TestNdCallbacks:
                                  contiguous_check=False)
     def test_irfftn_load_store_aux(self, xp, dtype):
         return self._test_load_store_aux_helper(xp, dtype, 'irfftn')
+
+
+@testing.with_requires('cython>=0.29.0')
+@pytest.mark.skipif(not sys.platform.startswith('linux'),
+                    reason='callbacks are only supported on Linux')
+@pytest.mark.skipif(cupy.cuda.runtime.is_hip,
+                    reason='hipFFT does not support callbacks')
+class TestWarmUpCallbacks:
+
+    def _callback(self):
+        return _set_load_cb(
+            _load_callback, 'x.x', 'cufftComplex', 'cufftCallbackLoadC')
+
+    def _modules(self, path):
+        return [f for f in os.listdir(path)
+                if f.startswith('cupy_callback_')]
+
+    def test_warm_up_registered(self):
+        cb_load = self._callback()
+        with use_temporary_cache_dir() as path:
+            cupy.fft.config.register_cufft_callbacks(cb_load=cb_load)
+            cupy.fft.config.warm_up_cufft_callbacks()
+            assert len(self._modules(path)) == 1
+
+            # the cached module is picked up without compiling again
+            a = testing.shaped_random((64,), cupy, np.complex64)
+            with cupy.fft.config.set_cufft_callbacks(cb_load=cb_load):
+                out = cupy.fft.fft(a)
+            testing.assert_allclose(out, cupy.fft.fft(a * 2.5), rtol=1e-4)
+            assert len(self._modules(path)) == 1
+
+    def test_warm_up_arch(self):
+        cb_load = self._callback()
+        arch = cupy.cuda.Device().compute_capability
+        with use_temporary_cache_dir() as path:
+            cupy.fft.config.warm_up_cufft_callbacks([(cb_load, '')], arch)
+            assert len(self._modules(path)) == 1
+            # same arch, same module
+            cupy.fft.config.warm_up_cufft_callbacks([(cb_load, '')])
+            assert len(self._modules(path)) == 1
+
+    def test_warm_up_invalid(self):
+        with pytest.raises(ValueError):
+            cupy.fft.config.warm_up_cufft_callbacks([('', '')])
+
+
+_jit_load_callback = r'''
+__device__ cufftComplex d_loadCallback(
+    void* dataIn, unsigned long long offset, void* callerInfo,
+    void* sharedPtr)
+{
+    cufftComplex x = ((cufftComplex*)dataIn)[offset];
+    x.x *= *((float*)callerInfo);
+    return x;
+}
+'''
+
+_jit_store_callback = r'''
+__device__ void d_storeCallback(
+    void* dataOut, unsigned long long offset, cufftComplex element,
+    void* callerInfo, void* sharedPtr)
+{
+    element.y /= 3.8f;
+    ((cufftComplex*)dataOut)[offset] = element;
+}
+'''
+
+
+def _cufft_version():
+    if cupy.cuda.runtime.is_hip:
+        return 0
+    return cupy.cuda.cufft.getVersion()
+
+
+@pytest.mark.skipif(_cufft_version() < 11300,
+                    reason='LTO callbacks require cuFFT 11.3+')
+class TestJITCallbacks:
+
+    @pytest.mark.parametrize('shape', [(64,), (8, 16)])
+    def test_fft_load_store(self, shape):
+        a = testing.shaped_random(shape, cupy, np.complex64)
+        aux = cupy.array([2.5], dtype=np.float32)
+        with cupy.fft.config.set_cufft_callbacks(
+                cb_load=_jit_load_callback, cb_store=_jit_store_callback,
+                cb_load_aux_arr=aux, backend='jit'):
+            out = cupy.fft.fft(a)
+        b = a.copy()
+        b.real *= 2.5
+        expected = cupy.fft.fft(b)
+        expected.imag /= 3.8
+        testing.assert_allclose(out, expected, rtol=1e-4, atol=1e-6)
+
+    def test_fftn_load(self):
+        a = testing.shaped_random((4, 8, 16), cupy, np.complex64)
+        aux = cupy.array([2.5], dtype=np.float32)
+        with cupy.fft.config.set_cufft_callbacks(
+                cb_load=_jit_load_callback, cb_load_aux_arr=aux,
+                backend='jit'):
+            out = cupy.fft.fftn(a)
+        b = a.copy()
+        b.real *= 2.5
+        testing.assert_allclose(out, cupy.fft.fftn(b), rtol=1e-4, atol=1e-6)
+
+    def test_missing_callback_name(self):
+        with pytest.raises(ValueError):
+            cupy.fft.config.set_cufft_callbacks(
+                cb_load=_jit_store_callback, backend='jit')
+
+    def test_invalid_backend(self):
+        with pytest.raises(ValueError):
+            cupy.fft.config.set_cufft_callbacks(
+                cb_load=_jit_load_callback, backend='nvcc')
@@ -7,7 +7,7 @@ import pytest
 import cupy
 from cupy.fft import config
 from cupy.fft._fft import (_default_fft_func, _fft, _fftn,
-                           _size_last_transform_axis)
+                           _size_last_transform_axis, _tuned_layout_key)
 from cupy import testing
 from cupy.testing._loops import _wraps_partial
 
@@ -304,6 +304,53 @@ class TestDefaultPlanType:
         assert _default_fft_func(ca, axes=(2, 1), value_type='C2R') is _fft
 
 
+@testing.with_requires('numpy>=2.0')
+class TestPlanAutotuning:
+
+    @pytest.fixture(autouse=True)
+    def autotuning(self):
+        config.clear_plan_cache()
+        config.enable_plan_autotuning = True
+        yield
+        config.enable_plan_autotuning = False
+        config.clear_plan_cache()
+
+    @pytest.mark.parametrize('func, value_type, shape, axes', [
+        ('fftn', 'C2C', (16, 18, 20), None),
+        ('fft2', 'C2C', (8, 30, 14), (1, 2)),
+        ('rfftn', 'R2C', (12, 10, 9), None),
+        ('irfftn', 'C2R', (6, 10, 9), (1, 2)),
+        # a PlanNd reads the first axis with a stride
+        ('fftn', 'C2C', (30, 4, 5), (0,)),
+    ])
+    def test_tuned_layout(self, func, value_type, shape, axes):
+        dtype = np.float64 if value_type == 'R2C' else np.complex128
+        a = testing.shaped_random(shape, cupy, dtype)
+        fft_func = _default_fft_func(a, axes=axes, value_type=value_type)
+        assert fft_func in (_fft, _fftn)
+
+        cache = config.get_plan_cache()
+        key = _tuned_layout_key(a, None, axes, value_type)
+        assert cache.get_tuned_layout(key) is fft_func
+        # the choice is reused without timing again
+        assert _default_fft_func(
+            a, axes=axes, value_type=value_type) is fft_func
+
+        out = getattr(cupy.fft, func)(a, axes=axes)
+        expected = getattr(np.fft, func)(a.get(), axes=axes)
+        testing.assert_allclose(out, expected, rtol=1e-6, atol=1e-7)
+
+        config.clear_plan_cache()
+        assert cache.get_tuned_layout(key) is None
+
+    def test_not_tuned(self):
+        # a single plan type is possible
+        a = testing.shaped_random((8, 10), cupy, np.complex128)
+        assert _default_fft_func(a, axes=(1,)) is _fft
+        key = _tuned_layout_key(a, None, (1,), 'C2C')
+        assert config.get_plan_cache().get_tuned_layout(key) is None
+
+
 @testing.with_requires('numpy>=2.0')
 @pytest.mark.skipif(10010 <= cupy.cuda.runtime.runtimeGetVersion() <= 11010,
                     reason='avoid a cuFFT bug (cupy/cupy#3777)')
@@ -202,6 +202,50 @@ class TestIndexing(unittest.TestCase):
         return xp.extract(b, a)
 
 
+class TestTakeRows:
+
+    # take along the first axis of wide rows copies a row at a time
+
+    @pytest.mark.parametrize('shape', [(100, 512), (50, 3, 40), (9, 33)])
+    @pytest.mark.parametrize('indices_shape', [(), (70,), (4, 30)])
+    @testing.for_all_dtypes()
+    @testing.numpy_cupy_array_equal()
+    def test_take_rows(self, xp, dtype, shape, indices_shape):
+        a = testing.shaped_arange(shape, xp, dtype)
+        indices = testing.shaped_random(
+            indices_shape, xp, numpy.int32, scale=2 * shape[0], seed=0)
+        return a.take(indices - shape[0], axis=0)
+
+    @pytest.mark.parametrize('offset', [0, 1, 2, 4, 8])
+    @testing.numpy_cupy_array_equal()
+    def test_take_rows_unaligned(self, xp, offset):
+        # the vector width follows the addresses and the row size
+        base = testing.shaped_arange((100 * 70 + offset,), xp, xp.float16)
+        a = base[offset:].reshape(100, 70)
+        indices = testing.shaped_random((50,), xp, numpy.int64, scale=100)
+        return a.take(indices, axis=0)
+
+    @testing.numpy_cupy_array_equal()
+    def test_getitem_rows(self, xp):
+        a = testing.shaped_arange((64, 256), xp, xp.float32)
+        indices = testing.shaped_random((3, 20), xp, numpy.int64, scale=64)
+        return a[indices]
+
+    @testing.numpy_cupy_array_equal()
+    def test_take_rows_out(self, xp):
+        a = testing.shaped_arange((64, 256), xp, xp.float32)
+        indices = xp.array([3, 0, 63, 3])
+        out = xp.zeros((4, 256), dtype=xp.float32)
+        a.take(indices, axis=0, out=out)
+        return out
+
+    @testing.numpy_cupy_array_equal()
+    def test_take_rows_non_contiguous(self, xp):
+        a = testing.shaped_arange((64, 512), xp, xp.float32)[:, ::2]
+        indices = xp.array([5, 1, 5])
+        return a.take(indices, axis=0)
+
+
 class TestChoose(unittest.TestCase):
 
     @testing.for_all_dtypes()
@@ -22,6 +22,26 @@ class TestNpz(unittest.TestCase):
 
         testing.assert_array_equal(a, b)
 
+    def test_save_load_fortran_order(self):
+        a = testing.shaped_arange((2, 3, 4), cupy, cupy.float32)
+        a = cupy.asfortranarray(a)
+        sio = io.BytesIO()
+        cupy.save(sio, a)
+        sio.seek(0)
+        b = cupy.load(sio)
+        assert b.flags.f_contiguous
+        testing.assert_array_equal(a, b)
+
+    def test_save_load_position(self):
+        # The file position is after the array, as with numpy.load
+        a = testing.shaped_arange((10,), dtype=cupy.int64)
+        sio = io.BytesIO()
+        cupy.save(sio, a)
+        cupy.save(sio, a * 2)
+        sio.seek(0)
+        testing.assert_array_equal(a, cupy.load(sio))
+        testing.assert_array_equal(a * 2, cupy.load(sio))
+
     def test_save_pickle(self):
         data = object()
 
@@ -92,6 +92,15 @@ class TestCholeskyDecomposition:
         return xp.linalg.cholesky(a)
 
 
+    @pytest.mark.parametrize('n', [1, 6, 32, 33])
+    @testing.for_dtypes([numpy.float32, numpy.float64, numpy.complex64,
+                         numpy.complex128])
+    def test_batched_small(self, dtype, n):
+        # stacks of up to 32 x 32 matrices use a kernel of their own
+        A = random_matrix((64, n, n), dtype, scale=(1, 100), sym=True)
+        self.check_L(A)
+
+
 class TestCholeskyInvalid(unittest.TestCase):
 
     def check_L(self, array):
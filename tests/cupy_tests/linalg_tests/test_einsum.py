@@ -561,3 +561,48 @@ class TestEinSumLarge:
             else:
                 assert len(ws) == 0
         return out
+
+
+class TestEinSumPlan:
+
+    def test_plan(self):
+        import cupyx
+        shapes = ((3, 4), (4, 5), (5, 2))
+        arrays = [testing.shaped_random(s, cupy, float) for s in shapes]
+        plan = cupyx.einsum_plan('ij,jk,kl->il', *arrays)
+        assert plan.path is None
+        expected = cupy.einsum('ij,jk,kl->il', *arrays, optimize='greedy')
+        testing.assert_allclose(plan(*arrays), expected)
+        path = plan.path
+        assert path is not None
+        arrays = [testing.shaped_random(s, cupy, float, seed=1)
+                  for s in shapes]
+        testing.assert_allclose(
+            plan(*arrays), cupy.einsum('ij,jk,kl->il', *arrays))
+        assert plan.path == path
+
+    def test_plan_from_shapes(self):
+        import cupyx
+        plan = cupyx.einsum_plan('ij,jk->ik', (2, 3), (3, 4))
+        a = testing.shaped_random((2, 3), cupy, float)
+        b = testing.shaped_random((3, 4), cupy, float)
+        testing.assert_allclose(plan(a, b), cupy.einsum('ij,jk->ik', a, b))
+
+    def test_plan_mismatch(self):
+        import cupyx
+        a = cupy.ones((2, 3))
+        plan = cupyx.einsum_plan('ij->ji', a)
+        with pytest.raises(ValueError):
+            plan(cupy.ones((3, 2)))
+        with pytest.raises(ValueError):
+            plan(cupy.ones((2, 3), dtype=cupy.float32))
+        with pytest.raises(ValueError):
+            plan(a, a)
+
+    def test_path_cache(self):
+        from cupy.linalg import _einsum
+        arrays = [cupy.ones((3, 4)), cupy.ones((4, 5)), cupy.ones((5, 2))]
+        cupy.einsum('ij,jk,kl->il', *arrays, optimize='greedy')
+        hits = _einsum._search_path.cache_info().hits
+        cupy.einsum('ij,jk,kl->il', *arrays, optimize='greedy')
+        assert _einsum._search_path.cache_info().hits == hits + 1
@@ -143,6 +143,41 @@ class TestInv(unittest.TestCase):
         self.check_shape((0, 2, 3))
 
 
+class TestBatchedSmall:
+
+    @pytest.mark.parametrize('n', [1, 2, 6, 17, 32, 33])
+    @pytest.mark.parametrize('nrhs', [None, 1, 3, 32])
+    @testing.for_dtypes('fdFD')
+    @testing.numpy_cupy_allclose(rtol=1e-3, atol=1e-3, contiguous_check=False)
+    def test_solve(self, xp, dtype, n, nrhs):
+        a = testing.shaped_random((5, 3, n, n), xp, dtype, seed=0, scale=1)
+        a += n * xp.eye(n, dtype=dtype)
+        b_shape = (5, 3, n) if nrhs is None else (5, 3, n, nrhs)
+        b = testing.shaped_random(b_shape, xp, dtype, seed=1)
+        return xp.linalg.solve(a, b)
+
+    @testing.numpy_cupy_allclose(rtol=1e-5, atol=1e-5)
+    def test_solve_pivoting(self, xp):
+        # a zero leading entry needs a row exchange
+        a = xp.array([[[0., 1., 2.], [1., 0., 3.], [4., -3., 8.]]] * 4)
+        b = xp.arange(12, dtype=xp.float64).reshape(4, 3)
+        return xp.linalg.solve(a, b)
+
+    @pytest.mark.parametrize('n', [1, 6, 32])
+    @testing.for_dtypes('fdFD')
+    @testing.numpy_cupy_allclose(rtol=1e-3, atol=1e-3, contiguous_check=False)
+    def test_inv(self, xp, dtype, n):
+        a = testing.shaped_random((100, n, n), xp, dtype, seed=0, scale=1)
+        return xp.linalg.inv(a + n * xp.eye(n, dtype=dtype))
+
+    def test_singular(self):
+        a = cupy.array([[[1., 2.], [3., 4.]], [[1., 2.], [2., 4.]]])
+        b = cupy.ones((2, 2))
+        with cupyx.errstate(linalg='raise'):
+            with pytest.raises(numpy.linalg.LinAlgError):
+                cupy.linalg.solve(a, b)
+
+
 class TestInvInvalid(unittest.TestCase):
 
     @testing.for_dtypes('ifdFD')
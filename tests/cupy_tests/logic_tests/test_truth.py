@@ -1,6 +1,9 @@
 import numpy
+import pytest
 
+import cupy
 from cupy import testing
+import cupyx
 
 
 def _calc_out_shape(shape, axis, keepdims):
@@ -108,6 +111,44 @@ class TestIn1DIsIn:
         return xp.isin(x, y, self.assume_unique, self.invert)
 
 
+class TestIsInLarge:
+
+    # Large enough for the hash table
+    @pytest.mark.parametrize('invert', [False, True])
+    @pytest.mark.parametrize('size_y', [10, 5000, 40000])
+    @testing.for_all_dtypes(no_float16=True, no_complex=True)
+    @testing.numpy_cupy_array_equal()
+    def test_isin_large(self, xp, dtype, size_y, invert):
+        x = testing.shaped_random((200, 100), xp, dtype, scale=1000, seed=0)
+        y = testing.shaped_random((size_y,), xp, dtype, scale=1000, seed=1)
+        return xp.isin(x, y, invert=invert)
+
+    @testing.for_float_dtypes(no_float16=True)
+    @testing.numpy_cupy_array_equal()
+    def test_isin_large_nan_zeros(self, xp, dtype):
+        x = xp.floor(testing.shaped_random((30000,), xp, dtype, scale=10))
+        x[::5] = xp.nan
+        x[1::9] = -0.0
+        y = xp.array([0.0, 3.0, xp.nan], dtype=dtype)
+        y = xp.concatenate([y] * 6000)
+        return xp.isin(x, y)
+
+    @pytest.mark.parametrize('size_y', [100, 1 << 18])
+    def test_isin_large_no_sync(self, size_y):
+        x = testing.shaped_random((30000,), cupy, numpy.int64, scale=1000)
+        y = testing.shaped_random((size_y,), cupy, numpy.int64, scale=1000,
+                                  seed=1)
+        with cupyx.allow_synchronize(False):
+            out = cupy.isin(x, y)
+        testing.assert_array_equal(out, numpy.isin(x.get(), y.get()))
+
+    @testing.numpy_cupy_array_equal()
+    def test_isin_large_mixed_dtypes(self, xp):
+        x = testing.shaped_arange((30000,), xp, numpy.int32)
+        y = testing.shaped_arange((20000,), xp, numpy.int64) * 2
+        return xp.isin(x, y)
+
+
 class TestSetdiff1d:
 
     @testing.for_all_dtypes()
@@ -261,6 +302,17 @@ class TestIntersect1d:
         b = xp.array([4, 6, 2, 5, 7, 6], dtype=dtype)
         return xp.intersect1d(a, b, return_indices=True)
 
+    # Large enough for the search of sorted needles
+    @pytest.mark.parametrize('return_indices', [True, False])
+    @testing.for_dtypes('iqd')
+    @testing.numpy_cupy_array_equal()
+    def test_large(self, xp, dtype, return_indices):
+        a = testing.shaped_random((200000,), xp, dtype, scale=10 ** 6,
+                                  seed=0)
+        b = testing.shaped_random((20000,), xp, dtype, scale=10 ** 6,
+                                  seed=1)
+        return xp.intersect1d(a, b, return_indices=return_indices)
+
 
 class TestUnion1d:
 
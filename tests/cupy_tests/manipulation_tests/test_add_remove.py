@@ -310,6 +310,42 @@ class TestUnique:
         a = testing.shaped_random((100, 100), xp, dtype)
         return xp.unique_values(a)
 
+    # Large enough for the hash table, with few or many distinct values
+    @pytest.mark.parametrize('scale', [3, 1000, 10 ** 6])
+    @testing.for_all_dtypes(no_float16=True, no_complex=True)
+    @testing.numpy_cupy_array_equal()
+    def test_unique_large(self, xp, dtype, scale):
+        a = testing.shaped_random((300, 200), xp, dtype, scale=scale)
+        return xp.unique(
+            a, return_index=True, return_inverse=True, return_counts=True)
+
+    @pytest.mark.parametrize('return_counts', [True, False])
+    @testing.for_dtypes('iqd')
+    @testing.numpy_cupy_array_equal()
+    def test_unique_large_counts(self, xp, dtype, return_counts):
+        a = testing.shaped_random((50000,), xp, dtype, scale=100)
+        return xp.unique(a, return_counts=return_counts)
+
+    @pytest.mark.parametrize('equal_nan', [True, False])
+    @testing.for_float_dtypes(no_float16=True)
+    @testing.numpy_cupy_array_equal()
+    @testing.with_requires('numpy>=1.23.1')
+    def test_unique_large_nan_zeros(self, xp, dtype, equal_nan):
+        a = testing.shaped_random((40000,), xp, dtype, scale=10)
+        a = xp.floor(a)
+        a[::7] = xp.nan
+        a[3::11] = -0.0
+        return xp.unique(a, return_index=True, return_counts=True,
+                         equal_nan=equal_nan)
+
+    def test_unique_too_many_distinct(self):
+        # falls back to sorting
+        a = cupy.random.RandomState(0).permutation(1 << 19)
+        a = cupy.concatenate([a, a[:100]])
+        values, counts = cupy.unique(a, return_counts=True)
+        testing.assert_array_equal(values, cupy.arange(1 << 19))
+        assert int(counts.sum()) == a.size
+
 
 @testing.parameterize(*testing.product({
     'trim': ['fb', 'f', 'b']
@@ -140,6 +140,31 @@ class TestJoin:
         b = testing.shaped_arange((2, 1), xp, 'f')
         return xp.concatenate((a, b) * 1024, axis=1)
 
+    @testing.for_all_dtypes(name='dtype')
+    @testing.numpy_cupy_array_equal()
+    @pytest.mark.skipif(runtime.is_hip, reason='ROCm/HIP may have a bug ')
+    def test_concatenate_many_different_sizes(self, xp, dtype):
+        arrs = [testing.shaped_arange((3, i % 7, 2), xp, dtype)
+                for i in range(300)]
+        arrs[5] = arrs[5][::-1]
+        arrs[6] = xp.asfortranarray(arrs[6])
+        return xp.concatenate(arrs, axis=1)
+
+    @testing.numpy_cupy_array_equal()
+    @pytest.mark.skipif(runtime.is_hip, reason='ROCm/HIP may have a bug ')
+    def test_concatenate_many_multiple_tiles(self, xp):
+        arrs = [testing.shaped_arange((i * 500 + 1,), xp, 'D')
+                for i in range(10)]
+        return xp.concatenate(arrs)
+
+    @testing.numpy_cupy_array_equal()
+    @pytest.mark.skipif(runtime.is_hip, reason='ROCm/HIP may have a bug ')
+    def test_concatenate_many_f_contiguous_out(self, xp):
+        arrs = [testing.shaped_arange((4, 3), xp, 'f') for i in range(10)]
+        out = xp.zeros((4, 30), 'f', order='F')
+        xp.concatenate(arrs, axis=1, out=out)
+        return out
+
     @testing.slow
     @pytest.mark.skipif(runtime.is_hip, reason='ROCm/HIP may have a bug ')
     def test_concatenate_32bit_boundary(self):
@@ -411,6 +436,11 @@ class TestJoin:
         a = testing.shaped_arange((2, 3), xp)
         return xp.stack((a, a), axis=2)
 
+    @testing.numpy_cupy_array_equal()
+    def test_stack_many(self, xp):
+        arrs = [testing.shaped_arange((2, 3), xp) + i for i in range(100)]
+        return xp.stack(arrs, axis=1)
+
     def test_stack_with_axis_over(self):
         for xp in (numpy, cupy):
             a = testing.shaped_arange((2, 3), xp)
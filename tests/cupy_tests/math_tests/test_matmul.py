@@ -7,6 +7,7 @@ import pytest
 import cupy
 from cupy._core import _routines_linalg as _linalg
 from cupy import testing
+import cupyx
 
 
 @testing.parameterize(
@@ -389,6 +390,44 @@ class TestMatmulAxes(unittest.TestCase):
         return out
 
 
+@pytest.mark.filterwarnings('ignore:The .* precision is only available')
+class TestMatmulPrecision:
+
+    @pytest.mark.parametrize('precision', [
+        'default', 'pedantic', 'tf32', 'fp16', 'bf16'])
+    @pytest.mark.parametrize('shapes', [
+        ((100, 200), (200, 300)), ((4, 64, 96), (4, 96, 32))])
+    @testing.for_dtypes('fdF')
+    @testing.numpy_cupy_allclose(rtol=2e-2, atol=2e-1)
+    def test_matmul(self, xp, dtype, shapes, precision):
+        x1 = testing.shaped_random(shapes[0], xp, dtype)
+        x2 = testing.shaped_random(shapes[1], xp, dtype)
+        if xp is numpy:
+            return xp.matmul(x1, x2)
+        with cupyx.matmul_precision(precision):
+            return xp.matmul(x1, x2)
+
+    def test_compute_type(self):
+        default = cupy._core.get_compute_type(numpy.float32)
+        with cupyx.matmul_precision('pedantic'):
+            assert (cupy._core.get_compute_type(numpy.float32)
+                    == _linalg.COMPUTE_TYPE_PEDANTIC)
+            with cupyx.matmul_precision('fp16'):
+                assert (cupy._core.get_compute_type(numpy.float32)
+                        == _linalg.COMPUTE_TYPE_FP16)
+                # float64 keeps the compute type of the outer context
+                assert (cupy._core.get_compute_type(numpy.float64)
+                        == _linalg.COMPUTE_TYPE_PEDANTIC)
+            assert (cupy._core.get_compute_type(numpy.float32)
+                    == _linalg.COMPUTE_TYPE_PEDANTIC)
+        assert cupy._core.get_compute_type(numpy.float32) == default
+
+    def test_invalid(self):
+        with pytest.raises(ValueError):
+            with cupyx.matmul_precision('fp8'):
+                pass
+
+
 class TestMatmulDispatch(unittest.TestCase):
 
     def test_matmul_dispatch(self):
@@ -344,6 +344,27 @@ class TestCubReduction:
         # ...then perform the actual computation
         return a.cumsum()
 
+    # don't test float16 as it's not as accurate?
+    @testing.for_dtypes('bhilBHILfdF')
+    @testing.numpy_cupy_allclose(rtol=1E-4)
+    def test_cub_cumsum_last_axis(self, xp, dtype):
+        if self.backend == 'block':
+            pytest.skip('does not support')
+
+        a = testing.shaped_random(self.shape, xp, dtype)
+        a = xp.ascontiguousarray(a)
+
+        if xp is numpy:
+            return a.cumsum(axis=-1)
+
+        # xp is cupy, first ensure we really use CUB
+        ret = cupy.empty(())  # Cython checks return type, need to fool it
+        func = 'cupy._core._routines_math.cub.device_scan_by_key'
+        with testing.AssertFunctionIsCalled(func, return_value=ret):
+            a.cumsum(axis=-1)
+        # ...then perform the actual computation
+        return a.cumsum(axis=-1)
+
     # TODO(leofang): test axis after support is added
     # don't test float16 as it's not as accurate?
     @testing.for_dtypes('bhilBHILfdF')
@@ -132,3 +132,67 @@ class TestPolynomial(unittest.TestCase):
             a = testing.shaped_random((5,), xp, dtype=bool)
             with pytest.raises(Exception):
                 xp.polynomial.polynomial.polycompanion(a)
+
+
+@testing.parameterize(*testing.product({
+    'c_shape': [(1,), (4,), (6, 3), (20, 2, 3)],
+    'x_shape': [(), (5,), (2, 3)],
+    'tensor': [True, False],
+}))
+class TestPolyval:
+
+    @testing.for_all_dtypes_combination(
+        names=['c_dtype', 'x_dtype'], no_float16=True, no_bool=True)
+    @testing.numpy_cupy_allclose(rtol=1e-5, accept_error=ValueError)
+    def test_polyval(self, xp, c_dtype, x_dtype):
+        c = testing.shaped_random(self.c_shape, xp, c_dtype, scale=2)
+        x = testing.shaped_random(self.x_shape, xp, x_dtype, scale=2)
+        return xp.polynomial.polynomial.polyval(x, c, tensor=self.tensor)
+
+
+class TestPolyroots:
+
+    @pytest.mark.parametrize('c', [
+        [1, -3, 2], [0, 0, 1], [-1, 0, 0, 1], [6, -5, -2, 1, 0],
+        [1, 2, 3, 4, 5, 6, 7, 8, 9], [1j, 2, 0.5 - 1j, 3], [4, 0],
+        [2, 5], [1, 0, 0, 0, 0, 0, 0, 0, 7]])
+    @testing.for_dtypes('ifdFD')
+    @testing.numpy_cupy_allclose(rtol=1e-4, atol=1e-4, type_check=False)
+    def test_polyroots(self, xp, dtype, c):
+        if numpy.dtype(dtype).kind != 'c' and any(
+                isinstance(v, complex) for v in c):
+            return xp.zeros(0)
+        c = xp.array(c, dtype)
+        roots = xp.polynomial.polynomial.polyroots(c)
+        # Rounded, so that the roots with the same real parts are ordered
+        # by their imaginary parts
+        return xp.sort(xp.around(roots.astype(numpy.complex128), 3))
+
+    @testing.for_dtypes('fdFD')
+    def test_polyroots_batch(self, dtype):
+        c = testing.shaped_random((5, 3, 4), cupy, dtype, scale=4, seed=2)
+        c -= 2
+        c[-1] += 4
+        roots = cupy.polynomial.polynomial.polyroots(c)
+        assert roots.shape == (4, 3, 4)
+        for i in range(3):
+            for j in range(4):
+                expected = cupy.polynomial.polynomial.polyroots(c[:, i, j])
+                testing.assert_allclose(roots[:, i, j], expected)
+        # The roots of the batch are the zeros of the polynomials
+        rtol = 1e-3 if numpy.dtype(dtype).char in 'fF' else 1e-8
+        values = cupy.polynomial.polynomial.polyvalfromroots(
+            cupy.zeros(()), roots, tensor=False) * c[-1]
+        testing.assert_allclose(values, c[0], rtol=rtol, atol=rtol)
+
+    def test_polyroots_batch_leading_zero(self):
+        c = cupy.array([[1, 1], [-3, 2], [0, 1]], dtype=cupy.float64)
+        roots = cupy.polynomial.polynomial.polyroots(c)
+        assert cupy.isnan(roots[:, 0]).all()
+        testing.assert_allclose(roots[:, 1], [-1, -1], atol=1e-6)
+
+    def test_polyroots_batch_degree(self):
+        with pytest.raises(NotImplementedError):
+            cupy.polynomial.polynomial.polyroots(cupy.ones((10, 2)))
+        with pytest.raises(ValueError):
+            cupy.polynomial.polynomial.polyroots(cupy.ones((1, 2)))
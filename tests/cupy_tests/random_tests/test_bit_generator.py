@@ -73,3 +73,140 @@ class TestBitGeneratorPhilox4x3210(BitGeneratorTestCase, unittest.TestCase):
     def setUp(self):
         super().setUp()
         self.bg = random._bit_generator.Philox4x3210
+
+
+@testing.with_requires('numpy>=1.17.0')
+@testing.fix_random()
+@pytest.mark.skipif(cupy.cuda.runtime.is_hip,
+                    reason='HIP does not support this')
+class TestBitGeneratorPhilox4x3210Counter(
+        BitGeneratorTestCase, unittest.TestCase):
+    def setUp(self):
+        super().setUp()
+        self.bg = random._bit_generator.Philox4x3210Counter
+
+    def test_launches_differ(self):
+        bg = self.bg(self.seed)
+        assert not cupy.array_equal(bg.random_raw(10), bg.random_raw(10))
+
+    def test_advance(self):
+        bg1 = self.bg(self.seed)
+        bg2 = self.bg(self.seed)
+        bg1.random_raw(10)
+        bg1.random_raw(10)
+        bg2.advance(2)
+        assert cupy.array_equal(bg1.random_raw(10), bg2.random_raw(10))
+
+
+@testing.with_requires('numpy>=1.17.0')
+@testing.fix_random()
+@pytest.mark.skipif(cupy.cuda.runtime.is_hip,
+                    reason='HIP does not support this')
+class TestBitGeneratorPhilox4x3210Sharded(
+        BitGeneratorTestCase, unittest.TestCase):
+    def setUp(self):
+        super().setUp()
+        self.bg = random._bit_generator.Philox4x3210Sharded
+
+    def _sharded(self, method, n, n_shards, **kwargs):
+        bg = self.bg(self.seed)
+        bounds = numpy.linspace(0, n, n_shards + 1).astype(int)
+        outs = []
+        for start, stop in zip(bounds[:-1], bounds[1:]):
+            rng = random.Generator(bg.shard(int(start)))
+            with cupy.cuda.Stream():
+                outs.append(getattr(rng, method)(
+                    size=int(stop - start), **kwargs))
+        return cupy.concatenate(outs)
+
+    def test_shard_count_invariant(self):
+        for method, kwargs in (('random', {}),
+                               ('standard_normal', {}),
+                               ('poisson', {'lam': 5.0})):
+            expected = self._sharded(method, 1001, 1, **kwargs)
+            for n_shards in (2, 3, 8):
+                actual = self._sharded(method, 1001, n_shards, **kwargs)
+                testing.assert_array_equal(actual, expected)
+
+    def test_shards_follow_parent(self):
+        bg = self.bg(self.seed)
+        bg.random_raw(10)
+        shard = bg.shard(0)
+        assert cupy.array_equal(bg.random_raw(10), shard.random_raw(10))
+
+    def test_invalid_start(self):
+        with pytest.raises(ValueError):
+            self.bg(self.seed, start=-1)
+
+
+class QuasiGeneratorTestCase(BitGeneratorTestCase):
+
+    def check_next_points(self, bg_class):
+        rng = random.Generator(bg_class(4, seed=self.seed))
+        x = rng.random((16, 4))
+        rng = random.Generator(bg_class(4, seed=self.seed))
+        y = cupy.concatenate([rng.random((4, 4)), rng.random((12, 4))])
+        testing.assert_array_equal(x, y)
+        bg = bg_class(4, seed=self.seed).fast_forward(6)
+        testing.assert_array_equal(random.Generator(bg).random((10, 4)),
+                                   x[6:])
+
+    def test_invalid_dims(self):
+        with pytest.raises(ValueError):
+            self.bg_class(0)
+
+
+@testing.with_requires('numpy>=1.17.0')
+@testing.fix_random()
+@pytest.mark.skipif(cupy.cuda.runtime.is_hip,
+                    reason='HIP does not support this')
+class TestBitGeneratorSobol(QuasiGeneratorTestCase, unittest.TestCase):
+    def setUp(self):
+        super().setUp()
+        self.bg_class = random._bit_generator.Sobol
+        self.bg = lambda seed: self.bg_class(3, seed=seed)
+
+    def test_unscrambled(self):
+        rng = random.Generator(self.bg_class(2, scramble=False))
+        testing.assert_array_equal(
+            rng.random((4, 2)),
+            [[0, 0], [0.5, 0.5], [0.75, 0.25], [0.25, 0.75]])
+
+    def test_balance(self):
+        # each coordinate of 2^m scrambled points is in its own 2^-m bin
+        for d in (1, 5, 300):
+            rng = random.Generator(self.bg_class(d, seed=self.seed))
+            u = rng.random((1024, d))
+            bins = cupy.sort(cupy.floor(u * 1024).astype(cupy.int64), axis=0)
+            testing.assert_array_equal(
+                bins, cupy.broadcast_to(cupy.arange(1024)[:, None], u.shape))
+
+    def test_next_points(self):
+        self.check_next_points(self.bg_class)
+
+    def test_normal(self):
+        # by inversion, so that the mean of the first points is very close
+        rng = random.Generator(self.bg_class(2, seed=self.seed))
+        z = rng.standard_normal((4096, 2))
+        assert float(abs(z.mean(axis=0)).max()) < 0.01
+
+
+@testing.with_requires('numpy>=1.17.0')
+@testing.fix_random()
+@pytest.mark.skipif(cupy.cuda.runtime.is_hip,
+                    reason='HIP does not support this')
+class TestBitGeneratorHalton(QuasiGeneratorTestCase, unittest.TestCase):
+    def setUp(self):
+        super().setUp()
+        self.bg_class = random._bit_generator.Halton
+        self.bg = lambda seed: self.bg_class(3, seed=seed)
+
+    def test_unscrambled(self):
+        rng = random.Generator(self.bg_class(2, scramble=False))
+        testing.assert_allclose(
+            rng.random((4, 2)),
+            [[0, 0], [1 / 2, 1 / 3], [1 / 4, 2 / 3], [3 / 4, 1 / 9]],
+            atol=1e-9)
+
+    def test_next_points(self):
+        self.check_next_points(self.bg_class)
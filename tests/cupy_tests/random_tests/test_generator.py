@@ -918,6 +918,34 @@ class TestChoiceReplaceFalse(RandomGeneratorTestCase):
         assert numpy.unique(val).size == val.size
 
 
+@testing.fix_random()
+class TestChoiceReplaceFalseWeighted(RandomGeneratorTestCase):
+
+    target_method = 'choice'
+
+    def test_bound(self):
+        p = [0.1, 0.0, 0.2, 0.3, 0.0, 0.4]
+        val = self.generate(6, 4, replace=False, p=p).get()
+        assert val.shape == (4,)
+        assert numpy.unique(val).size == 4
+        assert not numpy.isin(val, [1, 4]).any()
+
+    def test_too_few_nonzero(self):
+        with pytest.raises(ValueError):
+            self.rng.choice(3, 3, replace=False, p=[0.5, 0.5, 0.0])
+
+    @_condition.repeat_with_success_at_least(10, 9)
+    def test_goodness_of_fit(self):
+        # The first item of a sample without replacement is a weighted draw
+        trial = 100
+        vals = self.generate_many(
+            3, 2, False, [0.3, 0.3, 0.4], _count=trial)
+        vals = [val.get()[0] for val in vals]
+        counts = numpy.histogram(vals, bins=numpy.arange(4))[0]
+        expected = numpy.array([30, 30, 40])
+        assert _hypothesis.chi_square_test(counts, expected)
+
+
 @testing.fix_random()
 class TestGumbel(RandomGeneratorTestCase):
 
@@ -6,12 +6,29 @@ import numpy
 
 import cupy
 from cupy import random
+from cupy.random import _generator_api
 from cupy import testing
 from cupy.testing import _condition
 
 from cupy_tests.random_tests import common_distributions
 
 
+def _philox_raw(key, subsequence, i):
+    # The `i`-th value drawn by a cuRAND Philox4x32-10 state initialized as
+    # curand_init(key, subsequence, 0)
+    mask = 0xffffffff
+    ctr = [i // 4, 0, subsequence & mask, subsequence >> 32]
+    k = [key & mask, key >> 32]
+    for r in range(10):
+        if r > 0:
+            k = [(k[0] + 0x9E3779B9) & mask, (k[1] + 0xBB67AE85) & mask]
+        p0 = 0xD2511F53 * ctr[0]
+        p1 = 0xCD9E8D57 * ctr[2]
+        ctr = [(p1 >> 32) ^ ctr[1] ^ k[0], p1 & mask,
+               (p0 >> 32) ^ ctr[3] ^ k[1], p0 & mask]
+    return ctr[i % 4]
+
+
 @pytest.mark.skipif(cupy.cuda.runtime.is_hip
                     and (int(
                         str(cupy.cuda.runtime.runtimeGetVersion())[:3]) < 403),
@@ -31,6 +48,15 @@ class GeneratorTestCase(common_distributions.BaseGeneratorTestCase):
         self.rng.bit_generator = random._bit_generator.Philox4x3210(seed=seed)
 
 
+class ZigguratGeneratorTestCase(GeneratorTestCase):
+
+    def get_rng(self, xp, seed):
+        if xp is cupy:
+            return cupy.random.Generator(
+                random._bit_generator.Philox4x3210(seed=seed), ziggurat=True)
+        return super().get_rng(xp, seed)
+
+
 class InvalidOutsMixin:
 
     def invalid_dtype_out(self, **kwargs):
@@ -88,6 +114,39 @@ class TestPoisson(
     pass
 
 
+@testing.with_requires('numpy>=1.17.0')
+@testing.fix_random()
+class TestArrayParamsLayout(GeneratorTestCase):
+
+    target_method = 'poisson'
+
+    def _draw(self, lam, size=None):
+        rng = cupy.random.Generator(
+            random._bit_generator.Philox4x3210(seed=0))
+        return rng.poisson(lam, size=size)
+
+    def test_non_contiguous(self):
+        # Transposed and sliced parameters take the general indexing path
+        lam = testing.shaped_random((4, 3, 6), cupy, cupy.float64, scale=10)
+        lam = lam.transpose(2, 0, 1)[::2]
+        expected = self._draw(cupy.ascontiguousarray(lam))
+        testing.assert_array_equal(self._draw(lam), expected)
+
+    def test_broadcast(self):
+        lam = cupy.array([1.0, 5.0, 20.0])
+        for shape in ((4, 3), (3, 4)):
+            size = shape
+            param = lam if shape[-1] == 3 else lam[:, None]
+            expected = self._draw(
+                cupy.ascontiguousarray(cupy.broadcast_to(param, size)))
+            testing.assert_array_equal(self._draw(param, size), expected)
+
+    def test_scalar_array(self):
+        lam = cupy.array(3.0)
+        expected = self._draw(cupy.full((5, 7), 3.0))
+        testing.assert_array_equal(self._draw(lam, (5, 7)), expected)
+
+
 @testing.parameterize(*common_distributions.binomial_params)
 @testing.with_requires('numpy>=1.17.0')
 @testing.fix_random()
@@ -98,6 +157,164 @@ class TestBinomial(
     pass
 
 
+@testing.with_requires('numpy>=1.17.0')
+@testing.fix_random()
+class TestBinomialArrayParams(GeneratorTestCase):
+
+    target_method = 'binomial'
+
+    def test_broadcast_params(self):
+        # Both the inversion and the BTPE setups, and p > 0.5
+        n = cupy.array([5, 20, 1000, 1000], dtype=cupy.int64)
+        p = cupy.array([[0.1], [0.5], [0.9]])
+        y = self.generate(n=n, p=p)
+        assert y.shape == (3, 4)
+        assert bool(((0 <= y) & (y <= n)).all())
+
+    def test_size_larger_than_params(self):
+        n = cupy.array([10, 2000], dtype=cupy.int64)
+        p = cupy.array([0.3, 0.6])
+        y = self.rng.binomial(n, p, size=(20000, 2))
+        mean = y.mean(axis=0)
+        expected = (n * p).get()
+        std = numpy.sqrt(expected * (1 - p.get()) / 20000)
+        assert numpy.all(numpy.abs(mean.get() - expected) < 6 * std)
+
+
+@testing.fix_random()
+class TestMultinomial(GeneratorTestCase):
+
+    target_method = 'multinomial'
+
+    def test_shape(self):
+        y = self.generate(10, cupy.array([0.2, 0.3, 0.5]), size=(4, 5))
+        assert y.shape == (4, 5, 3)
+        assert y.dtype == numpy.int64
+        assert bool((y.sum(axis=-1) == 10).all())
+
+    def test_array_n(self):
+        n = cupy.array([0, 1, 50, 10000], dtype=cupy.int64)
+        y = self.generate(n, cupy.array([0.5, 0.0, 0.5]))
+        assert y.shape == (4, 3)
+        testing.assert_array_equal(y.sum(axis=-1), n)
+        assert bool((y[:, 1] == 0).all())
+
+    def test_mean(self):
+        pvals = numpy.array([0.1, 0.2, 0.3, 0.4])
+        y = self.rng.multinomial(1000, cupy.array(pvals), size=10000)
+        mean = y.mean(axis=0).get()
+        std = numpy.sqrt(1000 * pvals * (1 - pvals) / 10000)
+        assert numpy.all(numpy.abs(mean - 1000 * pvals) < 6 * std)
+
+    def test_invalid_pvals(self):
+        with pytest.raises(ValueError):
+            self.rng.multinomial(10, cupy.array([0.8, 0.7, 0.1]))
+        with pytest.raises(ValueError):
+            self.rng.multinomial(10, cupy.array([1.2, -0.2]))
+
+
+@testing.fix_random()
+class TestChoice(GeneratorTestCase):
+
+    target_method = 'choice'
+
+    def test_uniform(self):
+        y = self.generate(5, size=(3, 4))
+        assert y.shape == (3, 4)
+        assert bool(((0 <= y) & (y < 5)).all())
+
+    def test_array(self):
+        a = cupy.arange(12).reshape(3, 4)
+        y = self.generate(a, size=5, axis=1)
+        assert y.shape == (3, 5)
+        testing.assert_array_equal(y % 4, y[:1] % 4)
+
+    def test_weighted(self):
+        # enough items for many light and heavy columns of the table
+        p = numpy.random.RandomState(0).rand(1000)
+        p[::7] = 0
+        p /= p.sum()
+        y = self.rng.choice(1000, size=1000000, p=cupy.array(p))
+        freq = cupy.bincount(y, minlength=1000).get() / 1000000
+        assert freq[::7].sum() == 0
+        std = numpy.sqrt(p * (1 - p) / 1000000)
+        assert numpy.all(numpy.abs(freq - p) < 6 * std + 1e-12)
+
+    def check_alias_table(self, p):
+        # Each column keeps its own mass and receives what its aliases give
+        # away
+        n = p.size
+        prob, alias = _generator_api._alias_table(p)
+        mass = prob + cupy.bincount(alias, weights=1 - prob, minlength=n)
+        testing.assert_allclose(mass / n, p, atol=1e-12)
+
+    def test_alias_table(self):
+        p = cupy.array(numpy.random.RandomState(1).rand(100003) ** 3)
+        self.check_alias_table(p / p.sum())
+
+    def test_alias_table_lights_first(self):
+        # The light columns run out before the first heavy one turns light
+        self.check_alias_table(cupy.array([3.0, 1.0, 3.0, 1.0]) / 8)
+
+    def test_without_replacement(self):
+        p = cupy.array([0.1, 0.0, 0.2, 0.3, 0.0, 0.4])
+        y = self.generate(6, 4, replace=False, p=p).get()
+        assert numpy.unique(y).size == 4
+        assert not numpy.isin(y, [1, 4]).any()
+        y = self.generate(100, 100, replace=False).get()
+        testing.assert_array_equal(numpy.sort(y), numpy.arange(100))
+
+    def test_without_replacement_first(self):
+        # The first item of a sample without replacement is a weighted draw
+        p = numpy.array([0.5, 0.25, 0.125, 0.125])
+        firsts = cupy.stack([
+            self.rng.choice(4, 2, replace=False, p=cupy.array(p))[0]
+            for _ in range(2000)])
+        freq = cupy.bincount(firsts, minlength=4).get() / 2000
+        std = numpy.sqrt(p * (1 - p) / 2000)
+        assert numpy.all(numpy.abs(freq - p) < 6 * std)
+
+    def test_invalid(self):
+        with pytest.raises(ValueError):
+            self.rng.choice(3, 4, replace=False)
+        with pytest.raises(ValueError):
+            self.rng.choice(3, 3, replace=False,
+                            p=cupy.array([0.5, 0.5, 0.0]))
+        with pytest.raises(ValueError):
+            self.rng.choice(3, 1, p=cupy.array([0.5, 0.6, -0.1]))
+
+
+@testing.fix_random()
+class TestPermutation(GeneratorTestCase):
+
+    target_method = 'permutation'
+
+    def test_range(self):
+        for n in (0, 1, 2, 3, 1000, 65537):
+            y = self.generate(n).get()
+            assert y.dtype == numpy.int64
+            numpy.testing.assert_array_equal(numpy.sort(y), numpy.arange(n))
+
+    def test_array(self):
+        a = cupy.arange(100, dtype=cupy.float32) * 2
+        y = self.generate(a)
+        assert y.dtype == cupy.float32
+        testing.assert_array_equal(cupy.sort(y), a)
+
+    def test_axis(self):
+        a = cupy.arange(24).reshape(2, 3, 4)
+        y = self.generate(a, axis=2)
+        testing.assert_array_equal(cupy.sort(y, axis=2), a)
+        testing.assert_array_equal(y - y % 4, a - a % 4)
+
+    def test_shuffle(self):
+        a = cupy.arange(30).reshape(10, 3)
+        b = a.copy()
+        self.rng.shuffle(a)
+        testing.assert_array_equal(cupy.sort(a, axis=0), b)
+        testing.assert_array_equal(a % 3, b % 3)
+
+
 @testing.parameterize(*common_distributions.beta_params)
 @testing.with_requires('numpy>=1.17.0')
 @testing.fix_random()
@@ -136,6 +353,36 @@ class TestStandardGamma(
     pass
 
 
+@testing.with_requires('numpy>=1.17.0')
+@testing.fix_random()
+class TestStandardExponentialZiggurat(
+    common_distributions.StandardExponential,
+    ZigguratGeneratorTestCase,
+):
+
+    @_condition.repeat_with_success_at_least(10, 3)
+    def test_standard_exponential_ks(self):
+        self.check_ks(0.05)(size=2000)
+
+    def test_method_zig(self):
+        rng = cupy.random.Generator(random._bit_generator.Philox4x3210(0))
+        y = rng.standard_exponential(size=1000, method='zig')
+        assert bool((y >= 0).all())
+
+    def test_invalid_method(self):
+        with pytest.raises(ValueError):
+            self.generate(size=3, method='unknown')
+
+
+@testing.parameterize(*common_distributions.standard_gamma_params)
+@testing.fix_random()
+class TestStandardGammaZiggurat(
+    common_distributions.StandardGamma,
+    ZigguratGeneratorTestCase,
+):
+    pass
+
+
 @testing.fix_random()
 class TestStandardGammaInvalid(InvalidOutsMixin, GeneratorTestCase):
 
@@ -190,6 +437,16 @@ class TestStandardNormal(
     pass
 
 
+@testing.with_requires('numpy>=1.17.0')
+@testing.parameterize(*common_distributions.standard_normal_params)
+@testing.fix_random()
+class TestStandardNormalZiggurat(
+    common_distributions.StandardNormal,
+    ZigguratGeneratorTestCase
+):
+    pass
+
+
 @testing.with_requires('numpy>=1.17.0')
 @testing.fix_random()
 class TestStandardNormalInvalid(InvalidOutsMixin, GeneratorTestCase):
@@ -269,6 +526,50 @@ class TestRandom(InvalidOutsMixin, GeneratorTestCase):
     def test_random_ks(self, dtype):
         self.check_ks(0.05)(size=2000, dtype=dtype)
 
+    @testing.for_dtypes('fd')
+    def test_random_tail(self, dtype):
+        # Sizes that do not fill the vectors drawn by each thread
+        for size in (1, 3, 1027):
+            y = self.generate(size=size, dtype=dtype)
+            assert y.shape == (size,)
+            assert bool(((y >= 0) & (y < 1)).all())
+
+    def test_random_launch_config(self):
+        from cupy.random._generator_api import _get_launch_config
+        bg = random._bit_generator.Philox4x3210(seed=0, size=1024)
+        rng = cupy.random.Generator(bg)
+        rng.standard_gamma(1.5, size=10)
+        block_size, grid_size, n_threads = _get_launch_config()
+        assert block_size > 0
+        assert 0 < n_threads <= 10
+        assert grid_size * block_size >= n_threads
+        rng.random(size=100000, dtype=cupy.float32)
+        block_size, grid_size, n_threads = _get_launch_config()
+        assert 0 < n_threads <= 1024
+
+    @pytest.mark.skipif(cupy.cuda.runtime.is_hip,
+                        reason='the reference is the cuRAND Philox')
+    def test_random_raw_pinned(self):
+        # More states than any device keeps resident threads, so the
+        # launched threads run several logical threads each; the samples
+        # must still be those of one thread per state.
+        size = 1 << 20
+        bg = random._bit_generator.Philox4x3210(seed=0, size=size)
+        y = bg.random_raw(2 * size + 3).view(numpy.uint32).get()
+        key = int(numpy.random.SeedSequence(0).generate_state(
+            1, numpy.uint32)[0])
+        for state in (0, 1, 1000, size // 2 + 7, size - 1):
+            for i in range(3):
+                if i * size + state < len(y):
+                    assert y[i * size + state] == _philox_raw(key, state, i)
+
+    @testing.for_dtypes('fd')
+    def test_random_unaligned_out(self, dtype):
+        out = cupy.full(1025, -1, dtype=dtype)
+        self.generate(size=1024, dtype=dtype, out=out[1:])
+        assert float(out[0]) == -1
+        assert bool(((out[1:] >= 0) & (out[1:] < 1)).all())
+
 
 @testing.parameterize(*common_distributions.geometric_params)
 @testing.with_requires('numpy>=1.17.0')
@@ -110,7 +110,7 @@ class TestShuffle(unittest.TestCase):
 
 
 @testing.parameterize(*(testing.product({
-    'num': [0, 1, 100, 1000, 10000, 100000],
+    'num': [0, 1, 2, 3, 100, 1000, 10000, 65537, 100000],
 })))
 class TestPermutationSoundness(unittest.TestCase):
 
@@ -125,6 +125,20 @@ class TestPermutationSoundness(unittest.TestCase):
         assert (numpy.sort(self.a) == numpy.arange(self.num)).all()
 
 
+class TestPermutationUniformity(unittest.TestCase):
+
+    @_condition.repeat_with_success_at_least(5, 4)
+    def test_first_item(self):
+        # every item is as likely to be permuted to the front
+        num, trial = 7, 7000
+        rs = cupy.random.RandomState(seed=testing.generate_seed())
+        firsts = numpy.array(
+            [int(rs.permutation(num)[0]) for _ in range(trial)])
+        counts = numpy.bincount(firsts, minlength=num)
+        std = numpy.sqrt(trial / num * (1 - 1 / num))
+        assert numpy.all(numpy.abs(counts - trial / num) < 5 * std)
+
+
 @testing.parameterize(*(testing.product({
     'offset': [0, 17, 34, 51],
     'gap': [1, 2, 3, 5, 7],
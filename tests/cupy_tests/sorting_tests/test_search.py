@@ -748,6 +748,39 @@ class TestSearchSortedNanInf:
         return y,
 
 
+@pytest.mark.parametrize('side', ['left', 'right'])
+class TestSearchSortedLarge:
+
+    # Large enough for the shared-memory tree
+    @pytest.mark.parametrize('n_bins', [4096, 5000, 100000])
+    @testing.for_dtypes('ilqfd')
+    @testing.numpy_cupy_array_equal()
+    def test_searchsorted_large(self, xp, dtype, n_bins, side):
+        bins = xp.sort(testing.shaped_random((n_bins,), xp, dtype,
+                                             scale=1000, seed=0))
+        x = testing.shaped_random((300, 300), xp, dtype, scale=1100,
+                                  seed=1)
+        return xp.searchsorted(bins, x, side=side)
+
+    @testing.numpy_cupy_array_equal()
+    def test_searchsorted_large_nan(self, xp, side):
+        bins = xp.sort(testing.shaped_random((10000,), xp, xp.float64,
+                                             seed=0))
+        bins[-100:] = xp.nan
+        x = testing.shaped_random((100000,), xp, xp.float64, seed=1)
+        x[::13] = xp.nan
+        x[1::17] = xp.inf
+        x[2::19] = -xp.inf
+        return xp.searchsorted(bins, x, side=side)
+
+    @testing.numpy_cupy_array_equal()
+    def test_searchsorted_large_mixed_dtypes(self, xp, side):
+        bins = xp.arange(0, 20000, 3, dtype=xp.int32)
+        x = testing.shaped_random((100000,), xp, xp.float64, scale=20000,
+                                  seed=1)
+        return xp.searchsorted(bins, x, side=side)
+
+
 class TestSearchSortedInvalid:
 
     # Can't test unordered bins due to numpy undefined
@@ -192,6 +192,41 @@ class TestSort(unittest.TestCase):
         out = xp.sort(a, axis=2)
         return out
 
+    @testing.for_float_dtypes(no_float16=True)
+    @testing.numpy_cupy_array_equal()
+    def test_nan_negative_two_dim(self, xp, dtype):
+        # NaNs with the sign bit set and signed zeros in row sorts
+        a = testing.shaped_random((3, 8), xp, dtype)
+        a[0, 1] = -xp.nan
+        a[1, 3] = xp.nan
+        a[2, 2] = -0.0
+        a[2, 5] = 0.0
+        a[2, 6] = -0.0
+        return xp.sort(a, axis=-1)
+
+    @testing.for_complex_dtypes()
+    @testing.numpy_cupy_array_equal()
+    def test_nan_complex_parts(self, xp, dtype):
+        # every NaN class of the complex order in 1-D and row sorts
+        nan = float('nan')
+        row = [nan + 2j, 3 + 1j, complex(nan, nan), complex(1, nan),
+               complex(nan, -1), 3 - 1j, -0.0 + 0j, complex(-2, nan),
+               0j, -xp.inf + 5j]
+        a = xp.array([row, row[::-1]], dtype=dtype)
+        return xp.sort(a[0]), xp.sort(a, axis=-1)
+
+    @testing.numpy_cupy_array_equal()
+    def test_sort_complex128_two_dim(self, xp):
+        # the row sort of 16-byte items needs more scratch than the keys
+        a = testing.shaped_random((37, 129), xp, numpy.complex128, scale=4)
+        return xp.sort(a), xp.sort(a, axis=0)
+
+    @testing.numpy_cupy_array_equal()
+    def test_sort_complex128_three_dim(self, xp):
+        a = testing.shaped_random((5, 13, 257), xp, numpy.complex128,
+                                  scale=4)
+        return xp.sort(a), xp.sort(a, axis=1)
+
     # Large case
 
     @testing.slow
@@ -237,6 +272,20 @@ class TestLexsort(unittest.TestCase):
         a = testing.shaped_random((2, 10), xp, dtype)
         return xp.lexsort(a)
 
+    # Test both packed and per-key radix passes, with many ties
+
+    @testing.for_dtypes('bhilqBfd')
+    @testing.numpy_cupy_array_equal()
+    def test_lexsort_two_keys(self, xp, dtype):
+        a = testing.shaped_random((2, 1000), xp, dtype, scale=4)
+        return xp.lexsort(a)
+
+    @testing.for_dtypes('bhilqBfd')
+    @testing.numpy_cupy_array_equal()
+    def test_lexsort_five_keys(self, xp, dtype):
+        a = testing.shaped_random((5, 1000), xp, dtype, scale=4)
+        return xp.lexsort(a)
+
     # Test NaN ordering
 
     @testing.for_dtypes('efdFD')
@@ -397,6 +446,17 @@ class TestArgsort(unittest.TestCase):
         a[0, 2, 1] = a[1, 1, 3] = xp.nan
         return self.argsort(a)
 
+    @testing.for_float_dtypes(no_float16=True)
+    @testing.numpy_cupy_array_equal()
+    def test_nan_negative_two_dim(self, xp, dtype):
+        a = testing.shaped_random((3, 8), xp, dtype)
+        a[0, 1] = -xp.nan
+        a[1, 3] = xp.nan
+        a[2, 2] = -0.0
+        a[2, 5] = 0.0
+        a[2, 6] = -0.0
+        return self.argsort(a)
+
 
 class TestSort_complex(unittest.TestCase):
 
@@ -469,6 +529,17 @@ class TestPartition(unittest.TestCase):
         assert xp.all(x[:, :, kth:kth + 1] <= x[:, :, kth + 1:])
         return x[:, :, kth:kth + 1]
 
+    @testing.for_dtypes('ilqfd')
+    @testing.numpy_cupy_array_equal()
+    def test_partition_radix_select(self, xp, dtype):
+        # a large kth on long rows takes the radix select path
+        a = testing.shaped_random((3, 8192), xp, dtype, 10000)
+        kth = 1500
+        x = self.partition(a, kth)
+        assert xp.all(x[:, 0:kth] <= x[:, kth:kth + 1])
+        assert xp.all(x[:, kth:kth + 1] <= x[:, kth + 1:])
+        return xp.sort(x, axis=-1)
+
     # Test non-contiguous array
 
     @testing.numpy_cupy_equal()
@@ -644,6 +715,18 @@ class TestArgpartition(unittest.TestCase):
                 a[rows, cols, idx[:, :, kth + 1:]]).all()
         return idx[:, :, kth:kth + 1]
 
+    @testing.for_dtypes('ilqfd')
+    @testing.numpy_cupy_array_equal()
+    def test_argpartition_radix_select(self, xp, dtype):
+        # a large kth on long rows takes the radix select path
+        a = testing.shaped_random((3, 8192), xp, dtype, 10000)
+        kth = 1500
+        idx = self.argpartition(a, kth)
+        x = xp.take_along_axis(a, idx, axis=-1)
+        assert xp.all(x[:, 0:kth] <= x[:, kth:kth + 1])
+        assert xp.all(x[:, kth:kth + 1] <= x[:, kth + 1:])
+        return x[:, kth:kth + 1]
+
     # Test non-contiguous array
 
     @testing.numpy_cupy_equal()
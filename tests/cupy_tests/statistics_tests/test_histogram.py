@@ -6,6 +6,7 @@ import pytest
 
 import cupy
 from cupy import testing
+from cupy._core import _accelerator
 
 
 # Note that numpy.bincount does not support uint64 on 64-bit environment
@@ -359,6 +360,123 @@ class TestDigitize:
         return y,
 
 
+class TestDigitizeLarge:
+
+    # Large enough for the shared-memory tree of the searches
+    @pytest.mark.parametrize('increasing', [True, False])
+    @pytest.mark.parametrize('right', [True, False])
+    @testing.for_dtypes('ifd')
+    @testing.numpy_cupy_array_equal()
+    def test_digitize_large(self, xp, dtype, increasing, right):
+        bins = xp.unique(testing.shaped_random((8000,), xp, dtype,
+                                               scale=10000, seed=0))
+        if not increasing:
+            bins = bins[::-1]
+        x = testing.shaped_random((100000,), xp, dtype, scale=10000,
+                                  seed=1)
+        return xp.digitize(x, bins, right=right)
+
+
+class TestHistogramManyBins:
+
+    @testing.for_dtypes('ifd')
+    @testing.numpy_cupy_array_equal()
+    def test_histogram_many_bins(self, xp, dtype):
+        x = testing.shaped_random((200000,), xp, dtype, scale=10000, seed=0)
+        bins = xp.sort(testing.shaped_random((6000,), xp, numpy.float64,
+                                             scale=9000, seed=1))
+        bins = xp.concatenate([bins, bins[:10]])
+        bins.sort()
+        return xp.histogram(x, bins)
+
+    @testing.numpy_cupy_array_equal()
+    def test_histogram_many_bins_edges(self, xp):
+        bins = xp.arange(5000, dtype=xp.float64)
+        x = xp.concatenate([bins, bins[-1:], xp.array([-1.0, 5000.0])])
+        x = xp.concatenate([x] * 20)
+        return xp.histogram(x, bins)
+
+
+@testing.parameterize(*testing.product({
+    'accelerators': [['cub'], []],
+}))
+class TestHistogramAccelerators:
+
+    @pytest.fixture(autouse=True)
+    def set_accelerators(self):
+        if self.accelerators and not cupy.cuda.cub.available:
+            pytest.skip('The CUB routine is not enabled')
+        old_accelerators = _accelerator.get_routine_accelerators()
+        _accelerator.set_routine_accelerators(self.accelerators)
+        yield
+        _accelerator.set_routine_accelerators(old_accelerators)
+
+    def _check_cub(self, times_called=1):
+        return testing.AssertFunctionIsCalled(
+            'cupy.cuda.cub.cub_histogram',
+            times_called=times_called if self.accelerators else 0)
+
+    @testing.for_dtypes('bBhHi')
+    def test_histogram_even(self, dtype):
+        # unit-width bins of integer samples
+        x = testing.shaped_random((10000,), numpy, dtype, scale=50, seed=0)
+        for bins, range in ((49, None), (30, (5, 35))):
+            expected = numpy.histogram(x, bins, range)
+            with self._check_cub():
+                actual = cupy.histogram(cupy.asarray(x), bins, range)
+            testing.assert_array_equal(actual[0], expected[0])
+            testing.assert_allclose(actual[1], expected[1])
+
+    @testing.for_dtypes('ilfd')
+    def test_histogram_range(self, dtype):
+        x = testing.shaped_random((10000,), numpy, dtype, scale=50, seed=0)
+        bins = numpy.array([0, 1, 2.5, 10, 20, 30, 49])
+        # the samples on the last edge belong to the last bin
+        x[:10] = 49
+        expected, _ = numpy.histogram(x, bins)
+        with self._check_cub():
+            y, _ = cupy.histogram(cupy.asarray(x), cupy.asarray(bins))
+        testing.assert_array_equal(y, expected)
+
+    @testing.for_dtypes('fd')
+    def test_histogram_uniform_float(self, dtype):
+        x = testing.shaped_random((10000,), numpy, dtype, seed=0)
+        expected, _ = numpy.histogram(x, 17)
+        with self._check_cub():
+            y, _ = cupy.histogram(cupy.asarray(x), 17)
+        testing.assert_array_equal(y, expected)
+
+    @pytest.mark.parametrize('mode, func', [
+        ('abs', numpy.abs), ('angle', numpy.angle)])
+    @testing.for_complex_dtypes()
+    def test_histogram_complex(self, mode, func, dtype):
+        x = testing.shaped_random((10000,), numpy, dtype, seed=0) - (
+            0.5 + 0.5j)
+        real_dtype = x.real.dtype
+        if mode == 'abs':
+            bins = numpy.linspace(0, 1, 9, dtype=real_dtype)
+        else:
+            bins = numpy.linspace(-numpy.pi, numpy.pi, 9, dtype=real_dtype)
+        expected, _ = numpy.histogram(func(x), bins)
+        with self._check_cub():
+            y, _ = cupy.histogram(
+                cupy.asarray(x), cupy.asarray(bins), complex_mode=mode)
+        testing.assert_array_equal(y, expected)
+
+        # the range is found from the magnitudes or the phases
+        expected, expected_edges = numpy.histogram(func(x), 10)
+        y, edges = cupy.histogram(cupy.asarray(x), 10, complex_mode=mode)
+        testing.assert_array_equal(y, expected)
+        testing.assert_allclose(edges, expected_edges)
+
+    def test_histogram_complex_invalid(self):
+        x = cupy.zeros(10, numpy.complex64)
+        with pytest.raises(NotImplementedError):
+            cupy.histogram(x)
+        with pytest.raises(ValueError):
+            cupy.histogram(x, complex_mode='real')
+
+
 @testing.parameterize(
     {'right': True},
     {'right': False})
@@ -481,6 +599,31 @@ class TestHistogramdd:
         return [y, ] + [e for e in bin_edges]
 
 
+class TestHistogramddBins:
+
+    @pytest.mark.parametrize('bins', [5, 'array'])
+    @pytest.mark.parametrize('weighted', [False, True])
+    @testing.numpy_cupy_allclose()
+    def test_edges_and_outliers(self, xp, bins, weighted):
+        # the samples on the edges, out of the range and NaN
+        x = xp.array([[0., 1.], [1., 0.4], [0.2, 0.6], [0.5, 2.],
+                      [-0.1, 0.5], [numpy.nan, 0.5], [0.4, 0.4],
+                      [0.99999999, 0.]])
+        if bins == 'array':
+            bins = [xp.array([0., 0.1, 0.5, 1.]),
+                    xp.array([0., 0.4, 0.6, 2.])]
+        weights = xp.arange(1, 9, dtype=xp.float64) if weighted else None
+        hist, _ = xp.histogramdd(
+            x, bins=bins, range=((0, 1), (0, 2)), weights=weights)
+        return hist
+
+    @testing.numpy_cupy_allclose()
+    def test_many_bins(self, xp):
+        x = testing.shaped_random((1000, 3), xp, xp.float64, seed=0)
+        hist, _ = xp.histogramdd(x, bins=(64, 64, 16))
+        return hist
+
+
 class TestHistogramddErrors(unittest.TestCase):
 
     def test_histogramdd_invalid_bins(self):
@@ -75,6 +75,36 @@ class TestMedian:
         )
         return xp.median(a, axis=1)
 
+    @testing.for_all_dtypes()
+    @testing.numpy_cupy_allclose()
+    def test_median_long_axis(self, xp, dtype):
+        a = testing.shaped_random((3, 4097, 2), xp, dtype)
+        return xp.median(a, axis=1)
+
+    @testing.for_all_dtypes()
+    @testing.numpy_cupy_allclose()
+    def test_median_long_axis_keepdims(self, xp, dtype):
+        a = testing.shaped_random((3, 6000), xp, dtype)
+        return xp.median(a, keepdims=True)
+
+    @ignore_runtime_warnings
+    @testing.for_dtypes('fd')
+    @testing.numpy_cupy_allclose()
+    def test_median_long_axis_nan(self, xp, dtype):
+        a = testing.shaped_random((3, 5000), xp, dtype)
+        a[1, 17] = xp.nan
+        return xp.median(a, axis=1)
+
+    @ignore_runtime_warnings
+    @testing.for_dtypes('fd')
+    @testing.numpy_cupy_allclose()
+    def test_nanmedian_long_axis(self, xp, dtype):
+        a = testing.shaped_random((4, 5000), xp, dtype)
+        a[1, ::3] = xp.nan
+        a[2, :] = xp.nan
+        a[3, 1:] = xp.nan
+        return xp.nanmedian(a, axis=1)
+
 
 @testing.parameterize(
     *testing.product({
@@ -328,6 +358,26 @@ class TestMeanVar:
         a = testing.shaped_arange((2, 3, 4), xp, dtype)
         return xp.std(a, axis=1, ddof=1)
 
+    @testing.for_float_dtypes(no_float16=True)
+    @testing.numpy_cupy_allclose(rtol=1e-4)
+    def test_var_large_offset(self, xp, dtype):
+        a = testing.shaped_random((100, 1000), xp, dtype) + dtype(1000)
+        return a.var(axis=1)
+
+    @testing.for_all_dtypes(no_complex=True)
+    @testing.numpy_cupy_allclose(rtol=1e-6)
+    def test_var_out(self, xp, dtype):
+        a = testing.shaped_arange((2, 3, 4), xp, dtype)
+        out = xp.empty((2, 4), dtype=numpy.float32)
+        assert a.var(axis=1, out=out) is out
+        return out
+
+    @testing.for_complex_dtypes()
+    @testing.numpy_cupy_allclose(rtol=1e-6)
+    def test_var_complex_dtype(self, xp, dtype):
+        a = testing.shaped_arange((2, 3, 4), xp, numpy.float32)
+        return a.var(axis=1, dtype=dtype)
+
 
 @testing.parameterize(
     *testing.product({
@@ -455,6 +505,25 @@ class TestNanVarStdAdditional:
 
         return xp.nanvar(a, axis=1)
 
+    @ignore_runtime_warnings
+    @testing.for_float_dtypes(no_float16=True)
+    @testing.numpy_cupy_allclose(rtol=1e-6)
+    def test_nanvar_few_values(self, xp, dtype):
+        # slices with no values, or no more values than ddof
+        a = testing.shaped_random((4, 3), xp, dtype)
+        a[0, :] = xp.nan
+        a[1, 1:] = xp.nan
+        a[2, 2] = xp.nan
+        return xp.nanvar(a, axis=1, ddof=1)
+
+    @ignore_runtime_warnings
+    @testing.for_float_dtypes(no_float16=True)
+    @testing.numpy_cupy_allclose(rtol=1e-6)
+    def test_nanvar_full_reduction(self, xp, dtype):
+        a = testing.shaped_random((100, 50), xp, dtype)
+        a[::3, 1::2] = xp.nan
+        return xp.nanvar(a, ddof=2)
+
     @testing.numpy_cupy_allclose(rtol=1e-4)
     def test_nanvar_float16(self, xp):
         a = testing.shaped_arange((4, 5), xp, numpy.float16)
@@ -266,6 +266,30 @@ class TestQuantileMethods:
         q = testing.shaped_random((5,), xp, scale=1)
         return xp.quantile(a, q, axis=0, keepdims=True, method=method)
 
+    @testing.for_all_dtypes(no_float16=True, no_bool=True, no_complex=True)
+    @testing.numpy_cupy_allclose(rtol=1e-6)
+    def test_quantile_long_axis(self, xp, dtype, method):
+        a = testing.shaped_random((3, 5001), xp, dtype)
+        q = xp.array([0, 0.1, 0.5, 0.75, 1])
+        return xp.quantile(a, q, axis=-1, method=method)
+
+    @testing.for_all_dtypes(no_float16=True, no_bool=True, no_complex=True)
+    @testing.numpy_cupy_allclose(rtol=1e-6)
+    def test_quantile_long_axis_keeps_input(self, xp, dtype, method):
+        # the quantiles are selected without sorting or copying the input
+        a = testing.shaped_random((5001, 3), xp, dtype)
+        a_copy = a.copy()
+        q = xp.array([0, 0.1, 0.5, 0.75, 1])
+        res = xp.quantile(a, q, axis=0, method=method)
+        testing.assert_array_equal(a, a_copy)
+        return res
+
+    @testing.for_all_dtypes(no_float16=True, no_bool=True, no_complex=True)
+    @testing.numpy_cupy_allclose(rtol=1e-6)
+    def test_percentile_long_axis_no_axis(self, xp, dtype, method):
+        a = testing.shaped_random((4, 2000), xp, dtype)
+        return xp.percentile(a, 37.5, method=method)
+
 
 class TestOrder:
 
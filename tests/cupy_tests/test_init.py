@@ -92,6 +92,19 @@ class TestNotAvailable(unittest.TestCase):
         assert not available
 
 
+class TestLazyImport(unittest.TestCase):
+
+    def test_thrust(self):
+        returncode, stdoutdata, stderrdata = _run_script('''
+import sys
+import cupy
+print('cupy.cuda.thrust' in sys.modules)
+cupy.sort(cupy.arange(3)[::-1])
+print('cupy.cuda.thrust' in sys.modules)''')
+        assert returncode == 0, 'stderr: {!r}'.format(stderrdata)
+        assert stdoutdata.split() == [b'False', b'True']
+
+
 class TestMemoryPool(unittest.TestCase):
 
     def test_get_default_memory_pool(self):
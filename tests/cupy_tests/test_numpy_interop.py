@@ -151,6 +151,21 @@ class TestAsnumpy:
         assert isinstance(y.base, cupy.cuda.PinnedMemoryPointer)
         assert y.base.ptr == y.ctypes.data
 
+    @pytest.mark.parametrize('order', ('C', 'F', 'A'))
+    def test_asnumpy_out_pool(self, order):
+        pool = cupy.cuda.PinnedMemoryPool()
+        x = testing.shaped_random((2, 3, 4), cupy, cupy.float64)
+        x = cupy.asfortranarray(x)
+        y = cupy.asnumpy(x, order=order, out_pool=pool)
+        testing.assert_array_equal(x, y)
+        assert isinstance(y.base, cupy.cuda.PinnedMemoryPointer)
+        assert y.flags.f_contiguous == (order != 'C')
+        ptr = y.ctypes.data
+        del y
+        # the memory is reused
+        y = cupy.asnumpy(x, order=order, out_pool=pool)
+        assert y.ctypes.data == ptr
+
     @pytest.mark.skipif(
         int(os.environ.get('CUPY_ENABLE_UMP', 0)) == 1,
         reason='blocking or not is irrelevant when zero-copy is on'
@@ -183,3 +198,49 @@ class TestAsnumpy:
             ctx = contextlib.nullcontext()
         with ctx:
             assert cupy.allclose(a, c)
+
+
+class TestHostView:
+
+    def _managed(self, shape, dtype):
+        size = int(numpy.prod(shape)) * numpy.dtype(dtype).itemsize
+        mem = cupy.cuda.malloc_managed(size)
+        return cupy.ndarray(shape, dtype, mem)
+
+    @pytest.mark.parametrize('prefetch', (True, False))
+    def test_host_view(self, prefetch):
+        x = self._managed((3, 4), cupy.float32)
+        x[...] = cupy.arange(12, dtype=cupy.float32).reshape(3, 4)
+        y = x.host_view(prefetch=prefetch)
+        assert isinstance(y, numpy.ndarray)
+        assert y.ctypes.data == x.data.ptr
+        testing.assert_array_equal(y, numpy.arange(12).reshape(3, 4))
+        # the view shares the memory
+        y[0, 0] = -1
+        assert x[0, 0] == -1
+
+    def test_host_view_strided(self):
+        x = self._managed((4, 6), cupy.int64)
+        x[...] = cupy.arange(24).reshape(4, 6)
+        v = x[::-2, 1::2]
+        y = v.host_view()
+        assert y.strides == v.strides
+        testing.assert_array_equal(y, v)
+
+    def test_host_view_keeps_array(self):
+        x = self._managed((5,), cupy.float64)
+        x.fill(2)
+        y = x.host_view()
+        del x
+        testing.assert_array_equal(y, numpy.full(5, 2.))
+
+    def test_host_view_empty(self):
+        x = self._managed((0, 3), cupy.float32)
+        assert x.host_view().shape == (0, 3)
+
+    def test_host_view_device_memory(self):
+        if int(os.environ.get('CUPY_ENABLE_UMP', 0)) == 1:
+            pytest.skip('device memory is host accessible with UMP')
+        x = cupy.arange(3)
+        with pytest.raises(ValueError):
+            x.host_view()
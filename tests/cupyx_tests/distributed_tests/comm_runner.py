@@ -2,6 +2,8 @@ import sys
 import time
 import warnings
 
+import numpy
+
 import cupy
 from cupy import cuda
 from cupy.cuda import nccl
@@ -105,6 +107,67 @@ def all_reduce(dtype, use_mpi=False):
         _launch_workers(run_all_reduce, (dtype,))
 
 
+def hierarchical_all_reduce(dtype, use_mpi=False):
+    if dtype in 'hH':
+        return  # nccl does not support int16
+
+    def run_all_reduce(rank, local_size, dtype, use_mpi=False):
+        from cupyx.distributed import _nccl_comm
+        dev = cuda.Device(rank)
+        dev.use()
+        comm = NCCLBackend(
+            N_WORKERS, rank, use_mpi=use_mpi, local_size=local_size)
+        for shape in [(2, 3, 4), (5,)]:
+            in_array = cupy.arange(
+                numpy.prod(shape), dtype=dtype).reshape(shape)
+            out_array = cupy.zeros(shape, dtype=dtype)
+            comm.all_reduce(in_array, out_array)
+            testing.assert_allclose(out_array, 2 * in_array)
+        # pipelined in pieces of a few elements
+        _nccl_comm._hierarchical_chunk_size = 16
+        in_array = cupy.arange(37, dtype=dtype)
+        out_array = cupy.zeros(37, dtype=dtype)
+        comm.all_reduce(in_array, out_array)
+        testing.assert_allclose(out_array, 2 * in_array)
+
+    if use_mpi:
+        from mpi4py import MPI
+        # This process was run with mpiexec
+        run_all_reduce(MPI.COMM_WORLD.Get_rank(), 1, dtype, True)
+        run_all_reduce(MPI.COMM_WORLD.Get_rank(), 2, dtype, True)
+    else:
+        _launch_workers(run_all_reduce, (1, dtype))
+        _launch_workers(run_all_reduce, (2, dtype))
+
+
+def all_reduce_fused(dtype, use_mpi=False):
+    if dtype in 'hH':
+        return  # nccl does not support int16
+
+    def run_all_reduce_fused(rank, bucket_size, dtype, use_mpi=False):
+        dev = cuda.Device(rank)
+        dev.use()
+        comm = NCCLBackend(N_WORKERS, rank, use_mpi=use_mpi)
+        shapes = [(3,), (2, 5), (0,), (7, 1), (1,), (4, 4)]
+        arrays = [cupy.arange(numpy.prod(s), dtype=dtype).reshape(s)
+                  for s in shapes]
+        # an array of another dtype goes to another bucket
+        arrays.append(cupy.arange(10, dtype='f').reshape(2, 5).T)
+        expected = [2 * a for a in arrays]
+        comm.all_reduce_fused(arrays, bucket_size=bucket_size)
+        for a, e in zip(arrays, expected):
+            testing.assert_allclose(a, e)
+
+    if use_mpi:
+        from mpi4py import MPI
+        # This process was run with mpiexec
+        run_all_reduce_fused(MPI.COMM_WORLD.Get_rank(), 16, dtype, True)
+        run_all_reduce_fused(MPI.COMM_WORLD.Get_rank(), 1 << 20, dtype, True)
+    else:
+        _launch_workers(run_all_reduce_fused, (16, dtype))
+        _launch_workers(run_all_reduce_fused, (1 << 20, dtype))
+
+
 def reduce_scatter(dtype, use_mpi=False):
     if dtype in 'hH':
         return  # nccl does not support int16
@@ -739,3 +739,29 @@ class TestDistributedArray4Devices(_TestDistributedArray):
                 (np_a, d_a), (np_b, d_b) = arrs
                 testing.assert_array_equal(np_a, d_a)
                 testing.assert_array_equal(np_b, d_b)
+
+
+@testing.multi_gpu(2)
+class TestDataTransfer:
+
+    @pytest.mark.parametrize('peer', [True, False])
+    def test_transfer(self, peer, monkeypatch):
+        from cupyx.distributed.array import _data_transfer
+        if peer and not cupy.cuda.runtime.deviceCanAccessPeer(1, 0):
+            pytest.skip('peer access is unavailable')
+        monkeypatch.setattr(
+            _data_transfer, '_can_copy_peer', lambda src, dst: peer)
+        comms = _data_transfer._create_communicators([0, 1])
+        streams = {}
+        for dev in [0, 1]:
+            with cupy.cuda.Device(dev):
+                streams[dev] = cupy.cuda.Stream()
+        with cupy.cuda.Device(0):
+            a = testing.shaped_random((4, 6), cupy)
+            src = _data_transfer._AsyncData(
+                a[:, ::2], cupy.cuda.get_current_stream().record())
+        out = _data_transfer._transfer(
+            comms[0], streams[0], src, comms[1], streams[1], 1)
+        assert out.array.device.id == 1
+        out.ready.synchronize()
+        testing.assert_array_equal(out.array, a[:, ::2])
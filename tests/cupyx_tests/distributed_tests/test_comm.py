@@ -70,6 +70,14 @@ class TestNCCLBackend:
     def test_all_reduce(self, dtype):
         self._run_test('all_reduce', dtype)
 
+    @testing.for_all_dtypes(no_bool=True)
+    def test_all_reduce_fused(self, dtype):
+        self._run_test('all_reduce_fused', dtype)
+
+    @testing.for_all_dtypes(no_bool=True)
+    def test_hierarchical_all_reduce(self, dtype):
+        self._run_test('hierarchical_all_reduce', dtype)
+
     @testing.for_all_dtypes(no_bool=True)
     def test_reduce_scatter(self, dtype):
         self._run_test('reduce_scatter', dtype)
@@ -181,6 +189,10 @@ class TestInitDistributed(unittest.TestCase):
         with pytest.raises(ValueError):
             init_process_group(-1, 0)
 
+    def test_invalid_local_size(self):
+        with pytest.raises(ValueError):
+            init_process_group(2, 0, local_size=3)
+
     def test_invalid_rank(self):
         with pytest.raises(ValueError):
             init_process_group(2, -1)
@@ -1,3 +1,6 @@
+import numpy
+import pytest
+
 import cupy
 from cupy import testing
 from cupy_backends.cuda.api import runtime
@@ -126,3 +129,250 @@ class TestCubBlockReduce:
 
         block_reduce_min[h, w](x, y)
         testing.assert_allclose(y, expected, rtol=1e-6)
+
+
+class TestCubWarpScan:
+
+    @testing.for_dtypes('ilqfd')
+    def test_sum(self, dtype):
+
+        @jit.rawkernel()
+        def warp_scan_sum(x, y, z):
+            WarpScan = jit.cub.WarpScan[dtype]
+            temp_storage = jit.shared_memory(
+                dtype=WarpScan.TempStorage, size=1)
+            i, j = jit.blockIdx.x, jit.threadIdx.x
+            y[i, j] = WarpScan(temp_storage[0]).InclusiveSum(x[i, j])
+            z[i, j] = WarpScan(temp_storage[0]).ExclusiveSum(x[i, j])
+
+        warp_size = 64 if runtime.is_hip else 32
+        h, w = (8, warp_size)
+        x = testing.shaped_random((h, w), dtype=dtype)
+        y = cupy.empty_like(x)
+        z = cupy.empty_like(x)
+        warp_scan_sum[h, w](x, y, z)
+        expected = cupy.asnumpy(x).cumsum(axis=-1, dtype=dtype)
+        testing.assert_allclose(y, expected, rtol=1e-6)
+        testing.assert_allclose(z[:, 1:], expected[:, :-1], rtol=1e-6)
+
+    @testing.for_dtypes('ilfd')
+    def test_scan_max(self, dtype):
+
+        @jit.rawkernel()
+        def warp_scan_max(x, y):
+            WarpScan = jit.cub.WarpScan[dtype]
+            temp_storage = jit.shared_memory(
+                dtype=WarpScan.TempStorage, size=1)
+            i, j = jit.blockIdx.x, jit.threadIdx.x
+            scan = WarpScan(temp_storage[0])
+            y[i, j] = scan.InclusiveScan(x[i, j], jit.cub.Max())
+
+        warp_size = 64 if runtime.is_hip else 32
+        h, w = (8, warp_size)
+        x = testing.shaped_random((h, w), dtype=dtype)
+        y = cupy.empty_like(x)
+        warp_scan_max[h, w](x, y)
+        expected = numpy.maximum.accumulate(cupy.asnumpy(x), axis=-1)
+        testing.assert_array_equal(y, expected)
+
+
+class TestCubBlockScan:
+
+    @testing.for_dtypes('ilqfd')
+    def test_sum(self, dtype):
+
+        @jit.rawkernel()
+        def block_scan_sum(x, y):
+            BlockScan = jit.cub.BlockScan[dtype, 256]
+            temp_storage = jit.shared_memory(
+                dtype=BlockScan.TempStorage, size=1)
+            i, j = jit.blockIdx.x, jit.threadIdx.x
+            y[i, j] = BlockScan(temp_storage[0]).InclusiveSum(x[i, j])
+
+        h, w = (8, 256)
+        x = testing.shaped_random((h, w), dtype=dtype)
+        y = cupy.empty_like(x)
+        block_scan_sum[h, w](x, y)
+        expected = cupy.asnumpy(x).cumsum(axis=-1, dtype=dtype)
+        testing.assert_allclose(y, expected, rtol=1e-5)
+
+    @testing.for_dtypes('il')
+    def test_exclusive_scan_min(self, dtype):
+
+        @jit.rawkernel()
+        def block_scan_min(x, y, init):
+            BlockScan = jit.cub.BlockScan[dtype, 256]
+            temp_storage = jit.shared_memory(
+                dtype=BlockScan.TempStorage, size=1)
+            i, j = jit.blockIdx.x, jit.threadIdx.x
+            scan = BlockScan(temp_storage[0])
+            y[i, j] = scan.ExclusiveScan(x[i, j], init, jit.cub.Min())
+
+        h, w = (8, 256)
+        x = testing.shaped_random((h, w), dtype=dtype, scale=90)
+        y = cupy.empty_like(x)
+        block_scan_min[h, w](x, y, dtype(100))
+        expected = numpy.minimum.accumulate(cupy.asnumpy(x), axis=-1)
+        testing.assert_array_equal(y[:, 0], 100)
+        testing.assert_array_equal(y[:, 1:], expected[:, :-1])
+
+
+@pytest.mark.parametrize('load, store', [
+    ('BLOCK_LOAD_DIRECT', 'BLOCK_STORE_DIRECT'),
+    ('BLOCK_LOAD_STRIPED', 'BLOCK_STORE_STRIPED'),
+    ('BLOCK_LOAD_VECTORIZE', 'BLOCK_STORE_VECTORIZE'),
+    ('BLOCK_LOAD_TRANSPOSE', 'BLOCK_STORE_TRANSPOSE'),
+    ('BLOCK_LOAD_WARP_TRANSPOSE', 'BLOCK_STORE_WARP_TRANSPOSE'),
+])
+class TestCubBlockLoadStore:
+
+    @testing.for_dtypes('ifd')
+    def test_load_store(self, dtype, load, store):
+        load = getattr(jit.cub, load)
+        store = getattr(jit.cub, store)
+
+        @jit.rawkernel()
+        def copy_twice(x, y):
+            BlockLoad = jit.cub.BlockLoad[dtype, 128, 4, load]
+            BlockStore = jit.cub.BlockStore[dtype, 128, 4, store]
+            load_storage = jit.shared_memory(
+                dtype=BlockLoad.TempStorage, size=1)
+            store_storage = jit.shared_memory(
+                dtype=BlockStore.TempStorage, size=1)
+            items = jit.local_memory(dtype, 4)
+            offset = jit.blockIdx.x * 512
+            BlockLoad(load_storage[0]).Load(x.begin() + offset, items)
+            for k in range(4):
+                items[k] = items[k] * 2
+            jit.syncthreads()
+            BlockStore(store_storage[0]).Store(y.begin() + offset, items)
+
+        x = testing.shaped_random((512 * 6,), dtype=dtype)
+        y = cupy.zeros_like(x)
+        copy_twice[6, 128](x, y)
+        testing.assert_array_equal(y, x * 2)
+
+    def test_load_store_partial(self, load, store):
+        load = getattr(jit.cub, load)
+        store = getattr(jit.cub, store)
+
+        @jit.rawkernel()
+        def copy_partial(x, y, n):
+            BlockLoad = jit.cub.BlockLoad[numpy.int32, 128, 4, load]
+            BlockStore = jit.cub.BlockStore[numpy.int32, 128, 4, store]
+            load_storage = jit.shared_memory(
+                dtype=BlockLoad.TempStorage, size=1)
+            store_storage = jit.shared_memory(
+                dtype=BlockStore.TempStorage, size=1)
+            items = jit.local_memory(numpy.int32, 4)
+            BlockLoad(load_storage[0]).Load(x.begin(), items, n, -1)
+            jit.syncthreads()
+            BlockStore(store_storage[0]).Store(y.begin(), items)
+
+        x = cupy.arange(512, dtype=numpy.int32)
+        y = cupy.zeros_like(x)
+        copy_partial[1, 128](x, y, numpy.int32(300))
+        expected = x.copy()
+        expected[300:] = -1
+        testing.assert_array_equal(y, expected)
+
+
+class TestCubBlockRadixSort:
+
+    @testing.for_dtypes('ilIfd')
+    def test_sort(self, dtype):
+
+        @jit.rawkernel()
+        def block_sort(x, y):
+            BlockRadixSort = jit.cub.BlockRadixSort[dtype, 128, 4]
+            temp_storage = jit.shared_memory(
+                dtype=BlockRadixSort.TempStorage, size=1)
+            items = jit.local_memory(dtype, 4)
+            offset = jit.blockIdx.x * 512 + jit.threadIdx.x * 4
+            for k in range(4):
+                items[k] = x[offset + k]
+            BlockRadixSort(temp_storage[0]).Sort(items)
+            for k in range(4):
+                y[offset + k] = items[k]
+
+        x = testing.shaped_random((3, 512), dtype=dtype)
+        y = cupy.empty_like(x)
+        block_sort[3, 128](x, y)
+        testing.assert_array_equal(y, cupy.sort(x, axis=-1))
+
+    def test_sort_pairs_descending(self):
+
+        @jit.rawkernel()
+        def block_sort_pairs(keys, values):
+            BlockRadixSort = jit.cub.BlockRadixSort[
+                numpy.int32, 128, 2, numpy.int32]
+            temp_storage = jit.shared_memory(
+                dtype=BlockRadixSort.TempStorage, size=1)
+            k = jit.local_memory(numpy.int32, 2)
+            v = jit.local_memory(numpy.int32, 2)
+            offset = jit.threadIdx.x * 2
+            for j in range(2):
+                k[j] = keys[offset + j]
+                v[j] = offset + j
+            BlockRadixSort(temp_storage[0]).SortDescending(k, v)
+            for j in range(2):
+                keys[offset + j] = k[j]
+                values[offset + j] = v[j]
+
+        keys = cupy.random.permutation(256).astype(numpy.int32)
+        expected = cupy.argsort(-keys).astype(numpy.int32)
+        values = cupy.empty_like(keys)
+        block_sort_pairs[1, 128](keys, values)
+        testing.assert_array_equal(keys, cupy.arange(255, -1, -1))
+        testing.assert_array_equal(values, expected)
+
+
+@pytest.mark.parametrize('algorithm', ['BLOCK_HISTO_SORT',
+                                       'BLOCK_HISTO_ATOMIC'])
+class TestCubBlockHistogram:
+
+    def test_histogram(self, algorithm):
+        algorithm = getattr(jit.cub, algorithm)
+
+        @jit.rawkernel()
+        def block_histogram(x, y):
+            BlockHistogram = jit.cub.BlockHistogram[
+                numpy.uint8, 128, 4, 256, algorithm]
+            temp_storage = jit.shared_memory(
+                dtype=BlockHistogram.TempStorage, size=1)
+            histogram = jit.shared_memory(numpy.uint32, 256)
+            items = jit.local_memory(numpy.uint8, 4)
+            offset = jit.threadIdx.x * 4
+            for k in range(4):
+                items[k] = x[offset + k]
+            BlockHistogram(temp_storage[0]).Histogram(items, histogram)
+            jit.syncthreads()
+            j = jit.threadIdx.x
+            y[j] = histogram[j]
+            y[j + 128] = histogram[j + 128]
+
+        x = testing.shaped_random((512,), dtype=numpy.uint8, scale=256)
+        y = cupy.empty(256, dtype=numpy.uint32)
+        block_histogram[1, 128](x, y)
+        expected = cupy.bincount(x, minlength=256)
+        testing.assert_array_equal(y, expected)
+
+
+class TestCubInvalid:
+
+    def test_items_type(self):
+
+        @jit.rawkernel()
+        def f(x):
+            BlockRadixSort = jit.cub.BlockRadixSort[numpy.int32, 128, 4]
+            temp_storage = jit.shared_memory(
+                dtype=BlockRadixSort.TempStorage, size=1)
+            items = jit.local_memory(numpy.int32, 2)
+            BlockRadixSort(temp_storage[0]).Sort(items)
+
+        with pytest.raises(TypeError):
+            f[1, 128](cupy.empty(1))
+
+    def test_algorithm(self):
+        with pytest.raises(TypeError):
+            jit.cub.BlockLoad[numpy.int32, 128, 4, jit.cub.BLOCK_STORE_DIRECT]
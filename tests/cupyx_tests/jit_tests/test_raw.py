@@ -786,6 +786,61 @@ class TestRaw:
 
         assert len(f.cached_codes) == 2
 
+    def test_signatures(self):
+        @jit.rawkernel(signatures=[
+            ((numpy.int32, 1), (numpy.int32, 1), numpy.int32),
+            ((numpy.float32, 1), (numpy.float32, 1), numpy.int32),
+        ])
+        def f(x, y, n):
+            tid = jit.threadIdx.x + jit.blockDim.x * jit.blockIdx.x
+            if tid < n:
+                y[tid] = x[tid]
+
+        assert len(f.cached_codes) == 2
+        assert len(f._cache) == 2
+        for dtype in (numpy.int32, numpy.float32):
+            x = testing.shaped_random((30,), dtype=dtype, seed=0)
+            y = cupy.zeros_like(x)
+            f((5,), (6,), (x, y, 30))
+            testing.assert_array_equal(x, y)
+        # the calls use the kernels compiled ahead
+        assert len(f._cache) == 2
+
+    def test_specialize(self):
+        @jit.rawkernel()
+        def f(x, y):
+            tid = jit.threadIdx.x + jit.blockDim.x * jit.blockIdx.x
+            y[tid] = x[tid] * 2
+
+        x = cupy.arange(30, dtype=numpy.float64)
+        array_type = (numpy.float32, 1, True, True)
+        assert f.specialize((x, x), (array_type, array_type)) is f
+        assert len(f._cache) == 2
+        for dtype in (numpy.float64, numpy.float32):
+            y = cupy.empty_like(x, dtype=dtype)
+            f[5, 6](x.astype(dtype), y)
+            testing.assert_array_equal(y, x * 2)
+        assert len(f._cache) == 2
+        f[5, 6](x.astype(numpy.int32), y.astype(numpy.int32))
+        assert len(f._cache) == 3
+
+    def test_specialize_invalid(self):
+        @jit.rawkernel()
+        def f(x):
+            x[0] = 1
+
+        with pytest.raises(ValueError):
+            f.specialize(((numpy.int32,),))
+        with pytest.raises(TypeError):
+            f.specialize(([1, 2],))
+
+        @jit.rawkernel(device=True)
+        def g(x):
+            return x
+
+        with pytest.raises(TypeError):
+            g.specialize((numpy.int32,))
+
     @pytest.mark.parametrize(
         'unroll', (True, False, None, 5)
     )
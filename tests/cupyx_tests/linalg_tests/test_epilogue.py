@@ -0,0 +1,67 @@
+import math
+
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx
+
+
+def _gelu(x):
+    erf = numpy.vectorize(math.erf)
+    return x * 0.5 * (1 + erf(x / math.sqrt(2)))
+
+
+_expected_activations = {
+    None: lambda x: x,
+    'relu': lambda x: numpy.maximum(x, 0),
+    'gelu': _gelu,
+    'gelu_tanh': lambda x: 0.5 * x * (1 + numpy.tanh(
+        math.sqrt(2 / math.pi) * (x + 0.044715 * x ** 3))),
+    'sigmoid': lambda x: 1 / (1 + numpy.exp(-x)),
+}
+
+
+class TestMatmulEpilogue:
+
+    @pytest.mark.parametrize('activation', list(_expected_activations))
+    @pytest.mark.parametrize('with_bias', [True, False])
+    @pytest.mark.parametrize('shape', [((5, 7), (7, 3)), ((2, 4, 6), (6, 9))])
+    @testing.for_float_dtypes()
+    def test_matmul_epilogue(self, activation, with_bias, shape, dtype):
+        a = testing.shaped_random(shape[0], numpy, dtype, scale=2) - 1
+        b = testing.shaped_random(shape[1], numpy, dtype, scale=2) - 1
+        bias = None
+        expected = a.astype(numpy.float64) @ b.astype(numpy.float64)
+        if with_bias:
+            bias = testing.shaped_random(
+                (shape[1][-1],), numpy, dtype, seed=1) - 0.5
+            expected += bias
+        expected = _expected_activations[activation](expected)
+        y = cupyx.linalg.matmul_epilogue(
+            cupy.asarray(a), cupy.asarray(b),
+            None if bias is None else cupy.asarray(bias), activation)
+        assert y.dtype == dtype
+        tol = 1e-2 if dtype == numpy.float16 else 1e-5
+        testing.assert_allclose(y, expected, rtol=tol, atol=tol)
+
+    def test_out(self):
+        a = cupy.ones((3, 4), numpy.float32)
+        b = cupy.ones((4, 2), numpy.float32)
+        out = cupy.empty((3, 2), numpy.float32)
+        y = cupyx.linalg.matmul_epilogue(
+            a, b, cupy.array([-5, 1], numpy.float32), 'relu', out=out)
+        assert y is out
+        testing.assert_array_equal(out, [[0, 5]] * 3)
+
+    def test_invalid(self):
+        a = cupy.ones((3, 4))
+        b = cupy.ones((4, 2))
+        with pytest.raises(ValueError):
+            cupyx.linalg.matmul_epilogue(a, b, activation='tanh')
+        with pytest.raises(ValueError):
+            cupyx.linalg.matmul_epilogue(a, b, cupy.ones(3))
+        with pytest.raises(TypeError):
+            cupyx.linalg.matmul_epilogue(a.astype(numpy.int32),
+                                         b.astype(numpy.int32))
@@ -0,0 +1,115 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx
+from cupyx.scipy import sparse
+
+
+def _low_rank(m, n, rank, dtype, seed=0):
+    # a matrix of rank ``rank`` with singular values 1, 1/2, 1/4, ...
+    rs = numpy.random.RandomState(seed)
+
+    def randn(*shape):
+        x = rs.randn(*shape)
+        if numpy.dtype(dtype).kind == 'c':
+            x = x + 1j * rs.randn(*shape)
+        return x
+
+    u = numpy.linalg.qr(randn(m, rank))[0]
+    v = numpy.linalg.qr(randn(n, rank))[0]
+    s = 0.5 ** numpy.arange(rank)
+    return cupy.asarray(((u * s) @ v.conj().T).astype(dtype))
+
+
+def _tol(dtype):
+    return 1e-4 if numpy.dtype(dtype).char in 'fF' else 1e-10
+
+
+class TestRandomizedSvd:
+
+    @pytest.mark.parametrize('shape', [(300, 40), (40, 300)])
+    @testing.for_dtypes('fdFD')
+    def test_low_rank(self, dtype, shape):
+        a = _low_rank(*shape, 8, dtype)
+        u, s, vh = cupyx.linalg.randomized_svd(a, 8, random_state=0)
+        assert u.shape == (shape[0], 8)
+        assert s.shape == (8,)
+        assert vh.shape == (8, shape[1])
+        assert u.dtype == dtype
+        assert s.dtype == numpy.dtype(dtype).char.lower()
+        expected = cupy.linalg.svd(a, compute_uv=False)[:8]
+        testing.assert_allclose(s, expected, rtol=_tol(dtype) * 10)
+        testing.assert_allclose((u * s) @ vh, a, atol=_tol(dtype) * 10)
+        testing.assert_allclose(
+            u.conj().T @ u, cupy.eye(8), atol=_tol(dtype) * 10)
+
+    def test_singular_values(self):
+        a = testing.shaped_random((200, 50), cupy, numpy.float64, seed=0)
+        s = cupyx.linalg.randomized_svd(
+            a, 5, n_iter=8, random_state=0, compute_uv=False)
+        expected = cupy.linalg.svd(a, compute_uv=False)[:5]
+        testing.assert_allclose(s, expected, rtol=1e-2)
+
+    def test_sparse(self):
+        a = _low_rank(100, 60, 4, numpy.float64)
+        u, s, vh = cupyx.linalg.randomized_svd(
+            sparse.csr_matrix(a), 4, random_state=0)
+        testing.assert_allclose((u * s) @ vh, a, atol=1e-10)
+
+    def test_random_state(self):
+        a = testing.shaped_random((80, 30), cupy, numpy.float32, seed=0)
+        s1 = cupyx.linalg.randomized_svd(a, 3, random_state=1,
+                                         compute_uv=False)
+        s2 = cupyx.linalg.randomized_svd(
+            a, 3, random_state=cupy.random.default_rng(1), compute_uv=False)
+        testing.assert_array_equal(s1, s2)
+
+    def test_invalid(self):
+        a = cupy.ones((20, 10))
+        with pytest.raises(ValueError):
+            cupyx.linalg.randomized_svd(a, 0)
+        with pytest.raises(ValueError):
+            cupyx.linalg.randomized_svd(a, 5, n_oversamples=10)
+        with pytest.raises(ValueError):
+            cupyx.linalg.randomized_svd(cupy.ones(10), 1)
+
+
+class TestSVDSketch:
+
+    @pytest.mark.parametrize('block_rows', [7, 50, 400])
+    @testing.for_dtypes('fdFD')
+    def test_low_rank(self, dtype, block_rows):
+        a = _low_rank(400, 50, 6, dtype)
+        sketch = cupyx.linalg.SVDSketch(50, 6, dtype=dtype, random_state=0)
+        for i in range(0, 400, block_rows):
+            sketch.update(a[i:i + block_rows])
+        assert sketch.shape == (400, 50)
+        u, s, vh = sketch.svd()
+        assert u.shape == (400, 6)
+        assert vh.shape == (6, 50)
+        expected = cupy.linalg.svd(a, compute_uv=False)[:6]
+        tol = _tol(dtype) * 100
+        testing.assert_allclose(s, expected, rtol=tol)
+        testing.assert_allclose((u * s) @ vh, a, atol=tol)
+
+    @pytest.mark.parametrize('block_rows', [7, 400])
+    def test_singular_values_only(self, block_rows):
+        a = _low_rank(400, 50, 6, numpy.float64)
+        sketch = cupyx.linalg.SVDSketch(50, 6, random_state=0,
+                                        compute_uv=False)
+        for i in range(0, 400, block_rows):
+            sketch.update(a[i:i + block_rows])
+        expected = cupy.linalg.svd(a, compute_uv=False)[:6]
+        testing.assert_allclose(sketch.svd(), expected, rtol=1e-8)
+
+    def test_invalid(self):
+        with pytest.raises(TypeError):
+            cupyx.linalg.SVDSketch(10, 2, dtype=numpy.int32)
+        sketch = cupyx.linalg.SVDSketch(30, 2)
+        with pytest.raises(ValueError):
+            sketch.update(cupy.ones((5, 20)))
+        sketch.update(cupy.ones((5, 30)))
+        with pytest.raises(ValueError):
+            sketch.svd()
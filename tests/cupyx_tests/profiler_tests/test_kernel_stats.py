@@ -0,0 +1,47 @@
+import json
+import unittest
+
+import cupy
+from cupyx import profiler
+
+
+class TestKernelStats(unittest.TestCase):
+
+    def test_kernel_stats(self):
+        x = cupy.arange(1000, dtype=cupy.float32)
+        with profiler.kernel_stats() as stats:
+            for _ in range(3):
+                x + x
+            x.sum()
+        records = stats.records()
+        add, = [r for r in records if r['name'].startswith('cupy_add')]
+        assert add['count'] == 3
+        assert add['signature'] == ', '.join(['float32(1000,)'] * 3)
+        assert add['bytes'] == 3 * 3 * 4000
+        assert add['total_ms'] >= add['mean_ms'] > 0
+        assert add['p99_ms'] >= add['mean_ms'] * 0.999
+        assert len(records) >= 2
+        totals = [r['total_ms'] for r in records]
+        assert totals == sorted(totals, reverse=True)
+        assert json.loads(stats.to_json()) == stats.records()
+        assert 'cupy_add' in stats.table()
+        assert len(stats.table(limit=1).splitlines()) == 2
+
+    def test_kernel_stats_inactive(self):
+        x = cupy.arange(10, dtype=cupy.float32)
+        with profiler.kernel_stats() as stats:
+            pass
+        x + x
+        assert stats.records() == []
+        assert stats.table().splitlines()[0].startswith('kernel')
+
+    def test_kernel_stats_graph_capture(self):
+        if cupy.cuda.runtime.is_hip:
+            self.skipTest('HIP does not support graph capture')
+        x = cupy.arange(10, dtype=cupy.float32)
+        s = cupy.cuda.Stream(non_blocking=True)
+        with profiler.kernel_stats() as stats, s:
+            s.begin_capture()
+            x + x
+            s.end_capture()
+        assert stats.records() == []
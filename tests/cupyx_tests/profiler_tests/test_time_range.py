@@ -1,6 +1,7 @@
 import unittest
 from unittest import mock
 
+import cupy
 from cupy import cuda
 from cupyx import profiler
 
@@ -96,3 +97,31 @@ class TestTimeRangeNVTXUnavailable(unittest.TestCase):
     def test_time_range_decorator(self):
         with self.assertRaises(RuntimeError):
             profiler.time_range()
+
+
+@unittest.skipUnless(cuda.nvtx.available, 'nvtx is required for kernel_ranges')
+class TestKernelRanges(unittest.TestCase):
+
+    def test_kernel_ranges(self):
+        x = cupy.arange(10, dtype=cupy.float32)
+        push_patch = mock.patch('cupy.cuda.nvtx.RangePush')
+        pop_patch = mock.patch('cupy.cuda.nvtx.RangePop')
+        with push_patch as push, pop_patch as pop:
+            with profiler.kernel_ranges():
+                x + x
+            assert push.call_count == 1
+            message, = push.call_args[0]
+            assert message.startswith('cupy_add')
+            assert 'float32(10,)' in message
+            assert '120 bytes' in message
+            pop.assert_called_once_with()
+
+    def test_kernel_ranges_disabled(self):
+        x = cupy.arange(10, dtype=cupy.float32)
+        push_patch = mock.patch('cupy.cuda.nvtx.RangePush')
+        with push_patch as push:
+            with profiler.kernel_ranges():
+                with profiler.kernel_ranges(False):
+                    x + x
+            x + x
+            push.assert_not_called()
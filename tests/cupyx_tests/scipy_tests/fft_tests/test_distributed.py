@@ -0,0 +1,83 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx.scipy.fft as cp_fft
+
+
+def _scatter(a, devices, axis):
+    bounds = [a.shape[axis] * i // len(devices)
+              for i in range(len(devices) + 1)]
+    parts = []
+    for dev, start, stop in zip(devices, bounds[:-1], bounds[1:]):
+        with cupy.cuda.Device(dev):
+            index = (slice(None),) * axis + (slice(start, stop),)
+            parts.append(cupy.asarray(a[index]))
+    return parts
+
+
+def _gather(parts, axis):
+    return numpy.concatenate([cupy.asnumpy(p) for p in parts], axis=axis)
+
+
+@testing.parameterize(*testing.product({
+    'shape': [(8, 6), (7, 10, 5), (16, 4, 3, 2)],
+    'norm': [None, 'ortho', 'forward'],
+    'transposed_input': [False, True],
+    'transposed_output': [False, True],
+}))
+class TestDistributedFFT:
+
+    def _check(self, devices, dtype, inverse):
+        a = testing.shaped_random(self.shape, numpy, dtype)
+        x = _scatter(a, devices, 1 if self.transposed_input else 0)
+        func = cp_fft.distributed_ifftn if inverse else cp_fft.distributed_fftn
+        out = func(x, norm=self.norm,
+                   transposed_input=self.transposed_input,
+                   transposed_output=self.transposed_output, n_chunks=3)
+        assert [o.device.id for o in out] == list(devices)
+        out = _gather(out, 1 if self.transposed_output else 0)
+        expected = (numpy.fft.ifftn if inverse else numpy.fft.fftn)(
+            a, norm=self.norm)
+        rtol = 1e-4 if dtype in (numpy.float32, numpy.complex64) else 1e-10
+        testing.assert_allclose(out, expected, rtol=rtol, atol=rtol)
+
+    @testing.for_dtypes('fdFD')
+    def test_single_device(self, dtype):
+        self._check((0,), dtype, False)
+
+    @testing.multi_gpu(2)
+    @testing.for_complex_dtypes()
+    def test_fftn(self, dtype):
+        self._check((0, 1), dtype, False)
+
+    @testing.multi_gpu(2)
+    @testing.for_complex_dtypes()
+    def test_ifftn(self, dtype):
+        self._check((1, 0), dtype, True)
+
+
+class TestDistributedFFTInvalid:
+
+    def test_not_a_list(self):
+        with pytest.raises(TypeError):
+            cp_fft.distributed_fftn(cupy.zeros((4, 4), cupy.complex64))
+
+    def test_1d(self):
+        with pytest.raises(ValueError):
+            cp_fft.distributed_fftn([cupy.zeros((4,), cupy.complex64)])
+
+    def test_same_device(self):
+        x = [cupy.zeros((4, 4), cupy.complex64),
+             cupy.zeros((4, 5), cupy.complex64)]
+        with pytest.raises(ValueError):
+            cp_fft.distributed_fftn(x)
+
+    @testing.multi_gpu(2)
+    def test_round_trip_transposed(self):
+        a = testing.shaped_random((12, 8, 4), cupy, cupy.complex128)
+        x = _scatter(cupy.asnumpy(a), (0, 1), 0)
+        y = cp_fft.distributed_fftn(x, transposed_output=True)
+        z = cp_fft.distributed_ifftn(y, transposed_input=True)
+        testing.assert_allclose(_gather(z, 0), a, rtol=1e-10, atol=1e-10)
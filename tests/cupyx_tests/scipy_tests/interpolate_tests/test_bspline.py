@@ -487,3 +487,40 @@ class TestBSpline:
                         x, t, k, self.extrapolate).todense())
 
         return ret
+
+
+@testing.with_requires("scipy")
+class TestBSplineEvaluation:
+
+    # the degree is specialized at compile time
+    @pytest.mark.parametrize('k', [0, 1, 2, 5, 9])
+    @pytest.mark.parametrize('nu', [0, 1, 3])
+    @testing.numpy_cupy_allclose(scipy_name='scp', rtol=1e-10, atol=1e-10)
+    def test_degree(self, xp, scp, k, nu):
+        n = 30
+        t = xp.sort(testing.shaped_random((n + k + 1,), xp, xp.float64))
+        c = testing.shaped_random((n,), xp, xp.float64)
+        b = scp.interpolate.BSpline(t, c, k)
+        x = xp.linspace(t[k], t[n], 101)
+        return b(x, nu=nu)
+
+    # many curves evaluated at once, including a partial tile of columns
+    @pytest.mark.parametrize('shape', [(1,), (3,), (130, 3)])
+    @pytest.mark.parametrize('extrapolate', [True, False])
+    @testing.numpy_cupy_allclose(scipy_name='scp', rtol=1e-10, atol=1e-10)
+    def test_batched_coefficients(self, xp, scp, shape, extrapolate):
+        n, k = 25, 3
+        t = xp.sort(testing.shaped_random((n + k + 1,), xp, xp.float64))
+        c = testing.shaped_random((n,) + shape, xp, xp.float64, seed=1)
+        b = scp.interpolate.BSpline(t, c, k, extrapolate=extrapolate)
+        x = testing.shaped_random((50,), xp, xp.float64, scale=1.4) - 0.2
+        x[0] = xp.nan
+        return b(x)
+
+    @testing.numpy_cupy_allclose(scipy_name='scp', rtol=1e-10, atol=1e-10)
+    def test_batched_complex(self, xp, scp):
+        n, k = 20, 4
+        t = xp.sort(testing.shaped_random((n + k + 1,), xp, xp.float64))
+        c = testing.shaped_random((n, 9), xp, xp.complex128)
+        b = scp.interpolate.BSpline(t, c, k)
+        return b(xp.linspace(t[k], t[n], 33), nu=1)
@@ -255,6 +255,21 @@ class TestNdBSpline:
                    [0.9, 1.4, 1.9]]
         return r1, spl(xi)
 
+    # degrees of 0 to 5 and batched trailing coefficients
+    @pytest.mark.parametrize('k', [(0, 1, 2), (3, 5, 1), (4, 4, 4)])
+    @testing.numpy_cupy_allclose(scipy_name='scp', atol=1e-12)
+    def test_3D_mixed_degrees(self, xp, scp, k):
+        ts = []
+        for d, kd in enumerate(k):
+            v = xp.sort(testing.shaped_random((6,), xp, xp.float64, 3.0, d))
+            ts.append(xp.r_[[0.] * (kd + 1), v, [3.] * (kd + 1)])
+        c = testing.shaped_random(
+            tuple(t.size - kd - 1 for t, kd in zip(ts, k)) + (5, 2),
+            xp, xp.float64, 1.0)
+        spl = scp.interpolate.NdBSpline(tuple(ts), c, k=k)
+        xi = testing.shaped_random((40, 3), xp, xp.float64, 3.0, 7)
+        return spl(xi), spl(xi, nu=(0, 1, 0))
+
     @testing.numpy_cupy_allclose(scipy_name='scp')
     def test_3D_random_complex(self, xp, scp):
         k = 3
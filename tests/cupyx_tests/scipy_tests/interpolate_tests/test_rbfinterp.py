@@ -24,7 +24,8 @@ except ImportError:
 
 from cupyx.scipy.interpolate._rbfinterp import (
     _AVAILABLE, _SCALE_INVARIANT, _NAME_TO_MIN_DEGREE, NAME_TO_FUNC,
-    _monomial_powers, polynomial_matrix, kernel_matrix)
+    _monomial_powers, polynomial_matrix, kernel_matrix, _build_system,
+    _evaluate)
 
 
 def _kernel_matrix(x, kernel):
@@ -576,3 +577,81 @@ class TestRBFInterpolatorNeighborsInf(TestRBFInterpolatorNeighborsNone):
         y = _1d_test_function(x, xp)
         yitp1 = self.build(scp, x, y)(xitp)
         return yitp1
+
+
+@pytest.mark.parametrize('kernel', sorted(_AVAILABLE))
+class TestRBFKernels:
+
+    def _reference_system(self, y, smoothing, kernel, epsilon, powers):
+        p, r = y.shape[0], powers.shape[0]
+        shift = (y.max(axis=0) + y.min(axis=0)) / 2
+        scale = (y.max(axis=0) - y.min(axis=0)) / 2
+        lhs = cp.zeros((p + r, p + r))
+        lhs[:p, :p] = _kernel_matrix(y * epsilon, kernel)
+        lhs[:p, :p] += cp.diag(smoothing)
+        lhs[:p, p:] = _polynomial_matrix((y - shift) / scale, powers)
+        lhs[p:, :p] = lhs[:p, p:].T
+        return lhs, shift, scale
+
+    def test_system(self, kernel):
+        rng = _np.random.RandomState(0)
+        # not a multiple of the tiles, with more dimensions than a tile
+        y = cp.asarray(rng.rand(45, 10))
+        d = cp.asarray(rng.rand(45, 3))
+        smoothing = cp.asarray(rng.rand(45))
+        powers = _monomial_powers(10, 1)
+        lhs, rhs, shift, scale = _build_system(
+            y, d, smoothing, kernel, 1.5, powers)
+        expected, _, _ = self._reference_system(
+            y, smoothing, kernel, 1.5, powers)
+        testing.assert_allclose(lhs, expected, rtol=1e-10, atol=1e-12)
+        testing.assert_array_equal(rhs[:45], d)
+        testing.assert_array_equal(rhs[45:], 0)
+
+    def test_batched_system(self, kernel):
+        rng = _np.random.RandomState(1)
+        y = cp.asarray(rng.rand(50, 2))
+        d = cp.asarray(rng.rand(50, 1))
+        smoothing = cp.zeros(50)
+        powers = _monomial_powers(2, 1)
+        indices = cp.asarray(
+            _np.sort(rng.choice(50, (3, 20), replace=True), axis=1))
+        lhs, rhs, shift, scale = _build_system(
+            y, d, smoothing, kernel, 1.0, powers, indices)
+        assert lhs.shape == (3, 23, 23)
+        for b in range(3):
+            expected, eshift, escale = self._reference_system(
+                y[indices[b]], smoothing[indices[b]], kernel, 1.0, powers)
+            testing.assert_allclose(lhs[b], expected, rtol=1e-10, atol=1e-12)
+            testing.assert_allclose(shift[b], eshift)
+            testing.assert_allclose(scale[b], escale)
+            testing.assert_array_equal(rhs[b, :20], d[indices[b]])
+
+    def test_evaluate(self, kernel):
+        rng = _np.random.RandomState(2)
+        x = cp.asarray(rng.rand(300, 3))
+        y = cp.asarray(rng.rand(40, 3))
+        # more columns than a thread accumulates
+        coeffs = cp.asarray(rng.rand(44, 6))
+        powers = _monomial_powers(3, 1)
+        shift = cp.asarray(rng.rand(3))
+        scale = cp.asarray(rng.rand(3)) + 1
+        out = _evaluate(x, y, cp.arange(40)[None], None, coeffs, kernel,
+                        2.0, powers, shift, scale)
+        delta = 2.0 * (x[:, None, :] - y[None, :, :])
+        vec = cp.concatenate([
+            NAME_TO_FUNC[kernel](cp.linalg.norm(delta, axis=-1)),
+            _polynomial_matrix((x - shift) / scale, powers)], axis=1)
+        testing.assert_allclose(out, vec.dot(coeffs), rtol=1e-10)
+
+
+@testing.with_requires("scipy>=1.7.0")
+@pytest.mark.slow
+@testing.numpy_cupy_allclose(scipy_name='scp', atol=1e-8)
+def test_many_neighborhoods(xp, scp):
+    # thousands of neighborhoods, solved in batches
+    rng = _np.random.RandomState(0)
+    x = xp.asarray(rng.rand(20000, 2))
+    xitp = xp.asarray(rng.rand(5000, 2))
+    y = _2d_test_function(x, xp)
+    return scp.interpolate.RBFInterpolator(x, y, neighbors=16)(xitp)
@@ -282,6 +282,63 @@ class TestDistanceTransform:
         with pytest.raises(NotImplementedError):
             cupyx.scipy.ndimage.distance_transform_edt(cupy.zeros((8,) * ndim))
 
+    @pytest.mark.parametrize('shape', [(5, 32, 32), (3, 40, 27)])
+    @pytest.mark.parametrize('sampling', [None, 1.5, (2, 1)])
+    @testing.numpy_cupy_allclose(scipy_name='scp')
+    def test_distance_transform_edt_batched(self, xp, scp, shape, sampling):
+        img = self._binary_image(shape, xp=xp, pct_true=80)
+        if xp is cupy:
+            return scp.ndimage.distance_transform_edt(
+                img, sampling=sampling, batched=True)
+        return xp.stack([scp.ndimage.distance_transform_edt(
+            im, sampling=sampling) for im in img])
+
+    def test_distance_transform_edt_batched_indices(self):
+        img = self._binary_image((4, 40, 27), pct_true=80)
+        edt, inds = cupyx.scipy.ndimage.distance_transform_edt(
+            img, return_indices=True, batched=True)
+        assert inds.shape == (2,) + img.shape
+        for i, im in enumerate(img):
+            expected_edt, expected_inds = (
+                cupyx.scipy.ndimage.distance_transform_edt(
+                    im, return_indices=True))
+            testing.assert_array_equal(edt[i], expected_edt)
+            testing.assert_array_equal(inds[:, i], expected_inds)
+
+    def test_distance_transform_edt_batched_invalid(self):
+        with pytest.raises(ValueError):
+            cupyx.scipy.ndimage.distance_transform_edt(
+                cupy.ones((8, 8), dtype=bool), batched=True)
+
+    @pytest.mark.parametrize('shape', [(31, 48), (17, 20, 33)])
+    @pytest.mark.parametrize('sampling', [None, 1.5, 'aniso'])
+    @pytest.mark.parametrize('slab_size', [None, 1, 5])
+    @pytest.mark.parametrize('float64_distances', [False, True])
+    def test_distance_transform_edt_tiled(self, shape, sampling, slab_size,
+                                          float64_distances):
+        img = self._binary_image(shape, xp=numpy, pct_true=80)
+        if sampling == 'aniso':
+            sampling = tuple(range(1, len(shape) + 1))
+        out = cupyx.scipy.ndimage.distance_transform_edt_tiled(
+            img, sampling=sampling, slab_size=slab_size,
+            float64_distances=float64_distances)
+        assert isinstance(out, numpy.ndarray)
+        expected = scipy.ndimage.distance_transform_edt(img, sampling=sampling)
+        rtol = 1e-7 if float64_distances else 1e-5
+        numpy.testing.assert_allclose(out, expected, rtol=rtol)
+
+    def test_distance_transform_edt_tiled_inplace(self):
+        img = self._binary_image((20, 24, 28), xp=numpy, pct_true=80)
+        distances = numpy.empty(img.shape, dtype=numpy.float64)
+        ret = cupyx.scipy.ndimage.distance_transform_edt_tiled(
+            img, distances=distances, slab_size=3)
+        assert ret is None
+        numpy.testing.assert_allclose(
+            distances, scipy.ndimage.distance_transform_edt(img))
+        with pytest.raises(RuntimeError):
+            cupyx.scipy.ndimage.distance_transform_edt_tiled(
+                img, distances=numpy.empty(img.shape, dtype=numpy.float32))
+
     @pytest.mark.skip(reason="excessive memory requirement (and CPU runtime)")
     @testing.numpy_cupy_allclose(scipy_name='scp')
     def test_distance_transform_edt_3d_int64(self, xp, scp):
@@ -290,3 +347,11 @@ class TestDistanceTransform:
         shape = (1040, 1040, 1040)
         img = self._binary_image(shape, xp=xp, pct_true=80)
         return scp.ndimage.distance_transform_edt(img)
+
+    @pytest.mark.skip(reason="excessive memory requirement (and CPU runtime)")
+    @testing.numpy_cupy_allclose(scipy_name='scp')
+    def test_distance_transform_edt_3d_int64_index(self, xp, scp):
+        # Test 3D with more than 2**31 voxels to test the 64-bit indices
+        shape = (1300, 1300, 1300)
+        img = self._binary_image(shape, xp=xp, pct_true=80)
+        return scp.ndimage.distance_transform_edt(img)
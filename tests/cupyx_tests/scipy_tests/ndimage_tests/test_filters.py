@@ -282,6 +282,40 @@ class TestNearestFilterEdgeCase:
             [1, 1, 1, 1, 1], mode='nearest')
 
 
+@testing.with_requires('scipy')
+class TestTiled1DFilter:
+    # The 1D passes along each axis, with lines shorter and longer than a
+    # tile and windows larger than the running sum threshold
+
+    @pytest.mark.parametrize('shape', [(3, 7, 300), (40, 5, 3), (2, 600)])
+    @pytest.mark.parametrize('mode', ['reflect', 'constant', 'nearest',
+                                      'mirror', 'wrap'])
+    @pytest.mark.parametrize('dtype', [numpy.float32, numpy.float64,
+                                       numpy.complex64])
+    @testing.numpy_cupy_allclose(atol=1e-4, rtol=1e-4, scipy_name='scp')
+    def test_gaussian_filter(self, xp, scp, shape, mode, dtype):
+        x = testing.shaped_random(shape, xp, dtype)
+        return scp.ndimage.gaussian_filter(x, 2.5, mode=mode, cval=1.5)
+
+    @pytest.mark.parametrize('shape', [(3, 7, 300), (40, 5, 3), (2, 600)])
+    @pytest.mark.parametrize('mode', ['reflect', 'constant', 'nearest',
+                                      'mirror', 'wrap'])
+    @pytest.mark.parametrize('size', [3, 20, 65])
+    @pytest.mark.parametrize('origin', [0, -1])
+    @testing.numpy_cupy_allclose(atol=1e-4, rtol=1e-4, scipy_name='scp')
+    def test_uniform_filter(self, xp, scp, shape, mode, size, origin):
+        x = testing.shaped_random(shape, xp, numpy.float32)
+        return scp.ndimage.uniform_filter(x, size, mode=mode, cval=1.5,
+                                          origin=origin)
+
+    @pytest.mark.parametrize('axis', [0, 1, 2])
+    @testing.numpy_cupy_allclose(atol=1e-10, rtol=1e-10, scipy_name='scp')
+    def test_convolve1d(self, xp, scp, axis):
+        x = testing.shaped_random((30, 70, 50), xp, numpy.float64)
+        w = testing.shaped_random((9,), xp, numpy.float64)
+        return scp.ndimage.convolve1d(x, w, axis=axis, origin=1)
+
+
 def dummy_deriv_func(input, axis, output, mode, cval, *args, **kwargs):
     # For testing generic_laplace and generic_gradient_magnitude. Doesn't test
     # mode, cval, or extra argument but those are tested indirectly with
@@ -728,6 +762,65 @@ class TestShellSort(FilterTestCaseBase):
         return self._filter(xp, scp)
 
 
+@testing.with_requires('scipy')
+class TestRankFilterHistogram:
+
+    @pytest.mark.parametrize('dtype', [numpy.uint8, numpy.int8,
+                                       numpy.uint16, numpy.int16])
+    @pytest.mark.parametrize('size', [7, 15, (9, 13)])
+    @pytest.mark.parametrize('mode', ['reflect', 'constant', 'nearest',
+                                      'mirror', 'wrap'])
+    @testing.numpy_cupy_array_equal(scipy_name='scp')
+    def test_median_filter(self, xp, scp, dtype, size, mode):
+        info = numpy.iinfo(dtype)
+        x = numpy.random.RandomState(0).randint(
+            info.min, info.max + 1, (50, 70)).astype(dtype)
+        return scp.ndimage.median_filter(xp.asarray(x), size, mode=mode,
+                                         cval=3)
+
+    @pytest.mark.parametrize('dtype', [numpy.uint8, numpy.int16])
+    @pytest.mark.parametrize('rank', [1, 30, -2])
+    @testing.numpy_cupy_array_equal(scipy_name='scp')
+    def test_rank_filter(self, xp, scp, dtype, rank):
+        # a narrow range of values moves the result between few bins
+        x = numpy.random.RandomState(1).randint(
+            0, 600 if dtype == numpy.int16 else 20, (40, 33)).astype(dtype)
+        return scp.ndimage.rank_filter(xp.asarray(x), rank, (8, 9),
+                                       origin=(1, -2))
+
+    @testing.numpy_cupy_array_equal(scipy_name='scp')
+    def test_output(self, xp, scp):
+        x = testing.shaped_random((30, 40), xp, numpy.uint8, scale=255)
+        out = xp.zeros((30, 40), numpy.float32)
+        scp.ndimage.median_filter(x, 9, output=out)
+        return out
+
+    @testing.numpy_cupy_array_equal(scipy_name='scp')
+    def test_large_window(self, xp, scp):
+        # the window is larger than the input along the first axis
+        x = testing.shaped_random((5, 40), xp, numpy.uint16, scale=1000)
+        return scp.ndimage.median_filter(x, 9, mode='mirror')
+
+
+@testing.parameterize(*testing.product({
+    'dtype': [numpy.float32, numpy.float64, numpy.int32],
+    'size': [2, 3, 5, (3, 1, 3)],
+    'mode': ['reflect', 'constant'],
+}))
+@testing.with_requires('scipy')
+class TestRankFilterNetwork:
+
+    @testing.numpy_cupy_allclose(scipy_name='scp')
+    def test_median_filter(self, xp, scp):
+        x = testing.shaped_random((10, 11, 12), xp, self.dtype, scale=100)
+        return scp.ndimage.median_filter(x, self.size, mode=self.mode)
+
+    @testing.numpy_cupy_allclose(scipy_name='scp')
+    def test_rank_filter(self, xp, scp):
+        x = testing.shaped_random((10, 11, 12), xp, self.dtype, scale=100)
+        return scp.ndimage.rank_filter(x, 1, self.size, mode=self.mode)
+
+
 # Tests with Fortran-ordered arrays
 @testing.parameterize(*(
     testing.product_dict(
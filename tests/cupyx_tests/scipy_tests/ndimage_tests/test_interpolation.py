@@ -1,3 +1,5 @@
+import warnings
+
 import numpy
 import pytest
 
@@ -299,10 +301,9 @@ class TestAffineExceptions:
             aft(x[2], cupy.eye(3, dtype=cupy.float32), output='wrong',
                 texture_memory=True)
         # wrong mode
-        for m in ['mirror', 'reflect', 'wrap', 'grid-mirror',
-                  'grid-wrap', 'grid-constant', 'opencv']:
+        for m in ['mirror', 'wrap', 'opencv']:
             with pytest.raises(ValueError):
-                aft(x[2], cupy.eye(3, dtype=cupy.float32), mode=m,
+                aft(x[2], cupy.eye(4, dtype=cupy.float32), mode=m,
                     texture_memory=True)
         # non matching output_shape and output's shape
         with pytest.raises(ValueError):
@@ -410,6 +411,57 @@ class TestAffineTransformTextureMemory:
                      mode=self.mode)
 
 
+@pytest.mark.skipif(runtime.is_hip, reason='texture memory not supported yet')
+@testing.parameterize(*testing.product({
+    'order': [0, 1],
+    'mode': ['nearest', 'grid-constant', 'reflect', 'grid-wrap'],
+    'shape': [(20, 30), (10, 12, 14)],
+}))
+@testing.with_requires('scipy')
+class TestTextureMemoryBackend:
+
+    # the hardware interpolation uses 8-bit fixed-point weights
+    @testing.numpy_cupy_allclose(atol=1e-2, scipy_name='scp')
+    def test_map_coordinates(self, xp, scp):
+        a = testing.shaped_random(self.shape, xp, xp.float32, seed=0)
+        # coordinates half a pixel away from the centers and outside
+        coords = testing.shaped_random(
+            (len(self.shape), 50), xp, xp.float32, seed=1)
+        coords *= xp.asarray(self.shape, dtype=xp.float32)[:, None] + 4
+        coords -= 2.25
+        kwargs = {'texture_memory': True} if xp is cupy else {}
+        return scp.ndimage.map_coordinates(
+            a, coords, order=self.order, mode=self.mode, cval=0.5, **kwargs)
+
+    @pytest.mark.parametrize('grid_mode', [False, True])
+    @testing.numpy_cupy_allclose(atol=1e-2, scipy_name='scp')
+    def test_zoom(self, xp, scp, grid_mode):
+        a = testing.shaped_random(self.shape, xp, xp.float32, seed=0)
+        kwargs = {'texture_memory': True} if xp is cupy else {}
+        with warnings.catch_warnings():
+            warnings.simplefilter('ignore', UserWarning)
+            return scp.ndimage.zoom(a, 1.7, order=self.order, mode=self.mode,
+                                    grid_mode=grid_mode, **kwargs)
+
+    @testing.numpy_cupy_allclose(atol=1e-2, scipy_name='scp')
+    def test_rotate(self, xp, scp):
+        a = testing.shaped_random(self.shape, xp, xp.float32, seed=0)
+        kwargs = {'texture_memory': True} if xp is cupy else {}
+        return scp.ndimage.rotate(a, 30, order=self.order, mode=self.mode,
+                                  cval=0.5, **kwargs)
+
+    def test_texture_cache(self):
+        a = testing.shaped_random(self.shape, cupy, cupy.float32, seed=0)
+        coords = cupy.indices(self.shape, dtype=cupy.float32).reshape(
+            len(self.shape), -1)
+        m = cupyx.scipy.ndimage.map_coordinates
+        kwargs = dict(order=self.order, mode=self.mode, texture_memory=True)
+        testing.assert_allclose(m(a, coords, **kwargs), a.ravel())
+        # an in-place update of the input is seen by the cached texture
+        a += 1
+        testing.assert_allclose(m(a, coords, **kwargs), a.ravel())
+
+
 @testing.with_requires('opencv-python')
 @pytest.mark.skipif(runtime.is_hip, reason='ROCm/HIP may have a bug')
 class TestAffineTransformOpenCV:
@@ -70,6 +70,25 @@ class TestLabel:
         return labels
 
 
+@testing.parameterize(*testing.product({
+    'shape': [(3000,), (300, 257), (37, 45, 70), (3, 9, 17, 33)],
+    'density': [0.3, 0.6],
+    'connectivity': [1, 3],
+}))
+@testing.with_requires('scipy')
+@pytest.mark.skipif(runtime.is_hip, reason='ROCm/HIP may have a bug')
+class TestLabelTiles:
+
+    # the components span several tiles of the labeling kernel
+    @testing.numpy_cupy_array_equal(scipy_name='scp')
+    def test_label(self, xp, scp):
+        x = testing.shaped_random(self.shape, xp, seed=0) < self.density
+        structure = _generate_binary_structure(len(self.shape),
+                                               self.connectivity)
+        labels, num_features = scp.ndimage.label(x, structure=structure)
+        return labels
+
+
 @testing.with_requires('scipy')
 @pytest.mark.skipif(runtime.is_hip, reason='ROCm/HIP may have a bug')
 class TestLabelSpecialCases:
@@ -370,6 +389,34 @@ class TestMeasurementsSelect:
         return result
 
 
+@testing.parameterize(*testing.product({
+    'op': ['sum_labels', 'mean', 'variance', 'minimum', 'maximum',
+           'minimum_position', 'maximum_position', 'extrema'],
+    # the labels are reduced in shared memory or by sorted segments
+    'n_labels': [10, 2000],
+}))
+@testing.with_requires('scipy>=1.6.0')
+@pytest.mark.skipif(runtime.is_hip, reason='ROCm/HIP may have a bug')
+class TestLabeledReduction:
+
+    @testing.for_dtypes('ilf')
+    @testing.numpy_cupy_allclose(scipy_name='scp', rtol=1e-5)
+    def test_labels(self, xp, scp, dtype):
+        rstate = numpy.random.RandomState(0)
+        shape = (60, 70)
+        # unique values, so that the positions of the extrema are unique
+        x = xp.asarray(rstate.permutation(numpy.prod(shape)).reshape(shape)
+                       .astype(dtype) - 1000)
+        labels = xp.asarray(rstate.randint(0, self.n_labels + 1, shape))
+        # unordered, duplicated and missing labels
+        index = xp.asarray(rstate.choice(
+            self.n_labels + 5, self.n_labels // 2)[::-1])
+        result = getattr(scp.ndimage, self.op)(x, labels, index)
+        if isinstance(result, (list, tuple)):
+            result = [xp.asarray(r) for r in result]
+        return result
+
+
 @testing.parameterize(*testing.product({
     'labels': [None, 4, 6],
     'index': [None, [0, 2], [3, 1, 0], [1]],
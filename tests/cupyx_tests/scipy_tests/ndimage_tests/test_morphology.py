@@ -537,6 +537,42 @@ class TestBinaryErosionAndDilationContiguity:
         return self._filter(xp, scp, x)
 
 
+@testing.parameterize(*(
+    testing.product({
+        'shape': [(70,), (45, 300), (7, 9, 11)],
+        'structure': ['cross', 'box', 'random'],
+        'iterations': [3, 10, 40, 0],
+        'border_value': [0, 1],
+        'masked': [False, True],
+        'origin': [0, 1],
+        'filter': ['binary_erosion', 'binary_dilation']}
+    ))
+)
+@testing.with_requires('scipy')
+@pytest.mark.skipif(runtime.is_hip, reason='ROCm/HIP may have a bug')
+class TestBinaryIterations:
+
+    @testing.numpy_cupy_array_equal(scipy_name='scp')
+    def test_binary_iterations(self, xp, scp):
+        rstate = numpy.random.RandomState(5)
+        ndim = len(self.shape)
+        x = xp.asarray(rstate.randn(*self.shape) > -1.2)
+        if self.structure == 'random':
+            structure = rstate.randn(*(3,) * ndim) > 0
+            structure[(1,) * ndim] = True
+        else:
+            connectivity = 1 if self.structure == 'cross' else ndim
+            structure = scp.ndimage.generate_binary_structure(
+                ndim, connectivity)
+        structure = xp.asarray(structure)
+        mask = None
+        if self.masked:
+            mask = xp.asarray(rstate.randn(*self.shape) > -0.5)
+        filter = getattr(scp.ndimage, self.filter)
+        return filter(x, structure, iterations=self.iterations, mask=mask,
+                      border_value=self.border_value, origin=self.origin)
+
+
 @testing.parameterize(*(
     testing.product({
         'shape': [(3, 4), (2, 3, 4), (1, 2, 3, 4)],
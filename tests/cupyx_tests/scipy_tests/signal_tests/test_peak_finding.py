@@ -372,6 +372,22 @@ class TestFindPeaks:
             with pytest.raises(ValueError, match="distance"):
                 scp.signal.find_peaks(xp.arange(10), distance=-1)
 
+    @pytest.mark.parametrize('wlen', [None, 300])
+    @pytest.mark.parametrize('distance', [None, 1, 7, 500])
+    @testing.numpy_cupy_allclose(scipy_name="scp")
+    def test_many_peaks(self, wlen, distance, xp, scp):
+        """
+        Test conditions on a signal whose peaks span many blocks of samples.
+        """
+        x = testing.shaped_random((20000,), xp, xp.float64, seed=0)
+        x = xp.cumsum(x - 0.5)
+        x[::97] = 4 * x[::97]
+        peaks, props = scp.signal.find_peaks(
+            x, threshold=(None, None), distance=distance,
+            prominence=(0.5, None), width=(None, None), wlen=wlen)
+        return (peaks,) + tuple(
+            [props[k] for k in sorted(self.property_keys) if k in props])
+
     @pytest.mark.filterwarnings("ignore:some peaks have a prominence of 0",
                                 "ignore:some peaks have a width of 0")
     @testing.numpy_cupy_allclose(scipy_name="scp", type_check=False)
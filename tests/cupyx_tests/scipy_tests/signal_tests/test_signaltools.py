@@ -166,6 +166,49 @@ class TestOAConvolve:
         return scp.signal.oaconvolve(in1, in2, self.mode)
 
 
+@testing.with_requires('scipy')
+class TestStreamingConvolver:
+
+    @pytest.mark.parametrize('n_taps, chunk_size', [
+        (1, 16), (31, 64), (100, 37), (257, 1000)])
+    @pytest.mark.parametrize('shape', [(), (3,)])
+    @pytest.mark.parametrize('dtype', [np.float32, np.float64,
+                                       np.complex64, np.complex128])
+    def test_stream(self, n_taps, chunk_size, shape, dtype):
+        n_chunks = 5
+        x = testing.shaped_random(
+            shape + (n_chunks * chunk_size,), cupy, dtype)
+        h = testing.shaped_random((n_taps,), cupy, dtype)
+        conv = cupyx.scipy.signal.StreamingConvolver(h, chunk_size, shape)
+        outs = [conv(x[..., i * chunk_size:(i + 1) * chunk_size])
+                for i in range(n_chunks)]
+        outs.append(conv.flush())
+        expected = scipy.signal.fftconvolve(
+            x.get(), h.get().reshape((1,) * len(shape) + (-1,)))
+        tol = 1e-4 if dtype in (np.float32, np.complex64) else 1e-10
+        testing.assert_allclose(cupy.concatenate(outs, axis=-1), expected,
+                                rtol=tol, atol=tol)
+
+    def test_reset(self):
+        h = testing.shaped_random((20,), cupy, np.float64)
+        x = testing.shaped_random((50,), cupy, np.float64)
+        conv = cupyx.scipy.signal.StreamingConvolver(h, 50)
+        y = conv(x)
+        conv(x)
+        conv.reset()
+        testing.assert_allclose(conv(x), y)
+
+    def test_invalid(self):
+        h = cupy.ones(5)
+        with pytest.raises(ValueError):
+            cupyx.scipy.signal.StreamingConvolver(h, 0)
+        with pytest.raises(ValueError):
+            cupyx.scipy.signal.StreamingConvolver(cupy.ones((2, 2)), 4)
+        conv = cupyx.scipy.signal.StreamingConvolver(h, 8)
+        with pytest.raises(ValueError):
+            conv(cupy.ones(7))
+
+
 @testing.parameterize(*(testing.product({
     'size1': [(5, 10), (10, 7)],
     'size2': [(3, 2), (3, 3), (2, 2), (10, 10), (11, 11)],
@@ -624,6 +667,21 @@ class TestLFilter:
         out, _ = scp.signal.lfilter(b, a, x, zi=zi)
         return out
 
+    # enough blocks for the carries to be patched by a parallel scan
+    @pytest.mark.parametrize('size', [32 * 1024 + 7, 100 * 1024])
+    @pytest.mark.parametrize('iir_order', [1, 2, 3])
+    @pytest.mark.parametrize('use_zi', [False, True])
+    @testing.numpy_cupy_allclose(scipy_name='scp', rtol=1e-6, atol=1e-8)
+    def test_lfilter_long(self, size, iir_order, use_zi, xp, scp):
+        x = testing.shaped_random((2, size), xp, xp.float64, scale=0.5)
+        b = testing.shaped_random((2,), xp, xp.float64, scale=0.3)
+        a = testing.shaped_random((iir_order,), xp, xp.float64, scale=0.3)
+        a = xp.r_[1, a]
+        if not use_zi:
+            return scp.signal.lfilter(b, a, x)
+        zi = xp.ones((2, iir_order)) * scp.signal.lfilter_zi(b, a)
+        return scp.signal.lfilter(b, a, x, zi=zi)
+
 
 @testing.with_requires('scipy')
 class TestDeconvolve:
@@ -804,6 +862,20 @@ class TestSosFilt:
         out, _ = scp.signal.sosfilt(sos, x, zi=zi)
         return out
 
+    # enough blocks for the carries to be patched by a parallel scan
+    @pytest.mark.parametrize('size', [32 * 1024 + 7, 100 * 1024])
+    @pytest.mark.parametrize('sections', [1, 3])
+    @pytest.mark.parametrize('use_zi', [False, True])
+    @testing.numpy_cupy_allclose(scipy_name='scp', rtol=1e-6, atol=1e-8)
+    def test_sosfilt_long(self, size, sections, use_zi, xp, scp):
+        x = testing.shaped_random((size,), xp, xp.float64, scale=0.5)
+        sos = testing.shaped_random((sections, 6), xp, xp.float64, scale=0.2)
+        sos[:, 3] = 1
+        if not use_zi:
+            return scp.signal.sosfilt(sos, x)
+        zi = scp.signal.sosfilt_zi(sos)
+        return scp.signal.sosfilt(sos, x, zi=zi)
+
     @pytest.mark.parametrize(
         'zeros', [(4,), (5,), (4, 5)])
     @testing.numpy_cupy_array_almost_equal(scipy_name='scp', decimal=5)
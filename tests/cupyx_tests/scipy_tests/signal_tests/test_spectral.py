@@ -407,6 +407,18 @@ class TestWelch:
         f2, p2 = scp.signal.welch(x, nperseg=10, detrend=lambda x: x)
         return f1, p1, f2, p2
 
+    @pytest.mark.parametrize('detrend', [False, 'constant', 'linear'])
+    @pytest.mark.parametrize(
+        'dtype', [np.float32, np.float64, np.complex128])
+    @pytest.mark.parametrize('nfft', [None, 300])
+    @testing.numpy_cupy_allclose(scipy_name='scp', rtol=1e-4, atol=1e-6)
+    def test_fused_frames(self, xp, scp, detrend, dtype, nfft):
+        # long segments are reduced by several threads of a block
+        x = testing.shaped_random((2, 3, 3000), xp, dtype, seed=0)
+        x += xp.arange(3000) * 1e-3
+        return scp.signal.welch(x, nperseg=256, noverlap=100, nfft=nfft,
+                                detrend=detrend)
+
     @testing.numpy_cupy_allclose(scipy_name='scp', rtol=1e-5, atol=1e-5)
     def test_detrend_external(self, xp, scp):
         x = xp.arange(10, dtype=xp.float64) + 0.04
@@ -254,6 +254,24 @@ class TestUpfirdn:
             cases.append(y)
         return cases
 
+    @pytest.mark.parametrize('shape, axis', [
+        ((4, 3, 50), -1), ((4, 3, 50), 1), ((70, 2, 3), 0)])
+    @pytest.mark.parametrize('up, down', [(1, 1), (3, 2), (2, 7), (64, 1)])
+    @pytest.mark.parametrize('dtype', [np.float32, np.complex128])
+    @testing.numpy_cupy_allclose(scipy_name='scp', rtol=1e-5)
+    def test_batched(self, xp, scp, shape, axis, up, down, dtype):
+        x = testing.shaped_random(shape, xp, dtype)
+        h = testing.shaped_random((37,), xp, np.float64)
+        return scp.signal.upfirdn(h, x, up, down, axis=axis)
+
+    @pytest.mark.parametrize('up, down', [(1, 500), (3, 1000)])
+    @testing.numpy_cupy_allclose(scipy_name='scp', rtol=1e-5)
+    def test_large_down(self, xp, scp, up, down):
+        # the input of a block does not fit in shared memory
+        x = testing.shaped_random((20000,), xp, np.float64)
+        h = testing.shaped_random((50,), xp, np.float64)
+        return scp.signal.upfirdn(h, x, up, down)
+
 
 def test_output_len_long_input():
     # Regression test for scipy/gh-17375.  On Windows, a large enough input
@@ -0,0 +1,53 @@
+import unittest
+
+import numpy
+
+import cupy
+import cupyx.scipy.sparse
+import cupyx.scipy.sparse.csgraph  # NOQA
+from cupy import testing
+
+
+def _make_graph(n, nnz_per_row, seed=0):
+    rng = numpy.random.RandomState(seed)
+    a = rng.rand(n, n)
+    a[a > nnz_per_row / n] = 0
+    return cupyx.scipy.sparse.csr_matrix(cupy.asarray(a / nnz_per_row * n))
+
+
+@testing.parameterize(*testing.product({
+    'n': [1, 50, 2000],
+    'directed': [True, False],
+}))
+class TestPagerank(unittest.TestCase):
+
+    def _expected(self, a, alpha, p):
+        # the dense power iteration
+        a = a.toarray()
+        if not self.directed:
+            a = a + a.T
+        n = a.shape[0]
+        out = a.sum(axis=1)
+        dangling = out == 0
+        m = a / cupy.where(dangling, 1, out)[:, None]
+        x = p
+        for _ in range(200):
+            x = alpha * (m.T @ x + x[dangling].sum() * p) + (1 - alpha) * p
+        return x / x.sum() if n else x
+
+    def test_pagerank(self):
+        a = _make_graph(self.n, 3)
+        x = cupyx.scipy.sparse.csgraph.pagerank(a, directed=self.directed,
+                                                 tol=1e-12, max_iter=200)
+        p = cupy.full(self.n, 1 / self.n)
+        testing.assert_allclose(x, self._expected(a, 0.85, p), atol=1e-8)
+        testing.assert_allclose(x.sum(), 1)
+
+    def test_personalization(self):
+        a = _make_graph(self.n, 3)
+        p = cupy.arange(1, self.n + 1, dtype=numpy.float64)
+        x = cupyx.scipy.sparse.csgraph.pagerank(
+            a, alpha=0.5, personalization=p, directed=self.directed,
+            tol=1e-12, max_iter=200)
+        testing.assert_allclose(x, self._expected(a, 0.5, p / p.sum()),
+                                atol=1e-8)
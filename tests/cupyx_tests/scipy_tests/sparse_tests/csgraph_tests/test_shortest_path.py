@@ -0,0 +1,107 @@
+import unittest
+
+import numpy
+import pytest
+try:
+    import scipy.sparse  # NOQA
+    import scipy.sparse.csgraph  # NOQA
+    scipy_available = True
+except ImportError:
+    scipy_available = False
+
+import cupy
+import cupyx.scipy.sparse
+import cupyx.scipy.sparse.csgraph  # NOQA
+from cupy import testing
+
+
+def _make_graph(xp, sp, n, nnz_per_row, seed=0):
+    rng = numpy.random.RandomState(seed)
+    a = rng.rand(n, n)
+    a[a > nnz_per_row / n] = 0
+    return sp.csr_matrix(xp.asarray(a / nnz_per_row * n))
+
+
+def _check_predecessors(a, dist, pred, sources, directed):
+    # each predecessor is on a shortest path
+    a = a.toarray()
+    if not directed:
+        a = numpy.where(a > 0, a, numpy.inf)
+        a = numpy.minimum(a, a.T)
+    for s, d, p in zip(sources, dist, pred):
+        for v in numpy.nonzero(numpy.isfinite(d))[0]:
+            if v == s:
+                assert p[v] == -9999
+            else:
+                assert 0 < a[p[v], v] < numpy.inf
+                testing.assert_allclose(d[p[v]] + a[p[v], v], d[v])
+
+
+@testing.parameterize(*testing.product({
+    'n': [1, 30, 1000],
+    'nnz_per_row': [1, 3, 20],
+    'directed': [True, False],
+    'unweighted': [True, False],
+}))
+@unittest.skipUnless(scipy_available, 'requires scipy')
+class TestDijkstra(unittest.TestCase):
+
+    @testing.numpy_cupy_allclose(sp_name='sp')
+    def test_dijkstra(self, xp, sp):
+        a = _make_graph(xp, sp, self.n, self.nnz_per_row)
+        return sp.csgraph.dijkstra(
+            a, directed=self.directed, indices=[0, self.n // 2],
+            unweighted=self.unweighted)
+
+    @testing.numpy_cupy_allclose(sp_name='sp')
+    def test_limit(self, xp, sp):
+        a = _make_graph(xp, sp, self.n, self.nnz_per_row)
+        return sp.csgraph.dijkstra(
+            a, directed=self.directed, indices=0, limit=2.5,
+            unweighted=self.unweighted)
+
+    @testing.numpy_cupy_allclose(sp_name='sp')
+    def test_min_only(self, xp, sp):
+        a = _make_graph(xp, sp, self.n, self.nnz_per_row)
+        return sp.csgraph.dijkstra(
+            a, directed=self.directed, indices=[0, self.n - 1],
+            unweighted=self.unweighted, min_only=True)
+
+    def test_predecessors(self):
+        a = _make_graph(cupy, cupyx.scipy.sparse, self.n, self.nnz_per_row)
+        if self.unweighted:
+            a.data.fill(1)
+        sources = [0, self.n // 2]
+        dist, pred = cupyx.scipy.sparse.csgraph.dijkstra(
+            a, directed=self.directed, indices=sources,
+            return_predecessors=True)
+        _check_predecessors(a.get(), dist.get(), pred.get(), sources,
+                            self.directed)
+
+
+@unittest.skipUnless(scipy_available, 'requires scipy')
+class TestShortestPath(unittest.TestCase):
+
+    @testing.numpy_cupy_allclose(sp_name='sp')
+    def test_shortest_path(self, xp, sp):
+        a = _make_graph(xp, sp, 100, 4)
+        return sp.csgraph.shortest_path(a, method='D')
+
+    def test_zero_weights(self):
+        # a cycle of edges of weight zero
+        row = cupy.array([0, 1, 2, 3, 1])
+        col = cupy.array([1, 2, 3, 1, 4])
+        data = cupy.array([1., 0., 0., 0., 2.])
+        a = cupyx.scipy.sparse.csr_matrix((data, (row, col)), shape=(5, 5))
+        dist, pred = cupyx.scipy.sparse.csgraph.dijkstra(
+            a, indices=0, return_predecessors=True)
+        testing.assert_allclose(dist, [0, 1, 1, 1, 3])
+        testing.assert_array_equal(pred, [-9999, 0, 1, 2, 1])
+
+    def test_invalid(self):
+        a = cupyx.scipy.sparse.csr_matrix(cupy.array([[0, -1.], [1, 0]]))
+        with pytest.raises(ValueError):
+            cupyx.scipy.sparse.csgraph.dijkstra(a)
+        with pytest.raises(NotImplementedError):
+            cupyx.scipy.sparse.csgraph.shortest_path(a, method='FW')
+
@@ -7,6 +7,7 @@ try:
     scipy_available = True
 except ImportError:
     scipy_available = False
+import cupy
 import cupyx.scipy.sparse.csgraph  # NOQA
 try:
     import pylibcugraph  # NOQA
@@ -61,3 +62,51 @@ class TestConnectedComponents(unittest.TestCase):
             return sp.csgraph.connected_components(
                 a, directed=self.directed, connection=self.connection,
                 return_labels=self.return_labels)
+
+
+def _make_graph(xp, sp, n, nnz_per_row, seed=0):
+    rng = numpy.random.RandomState(seed)
+    a = rng.rand(n, n)
+    a[a > nnz_per_row / n] = 0
+    return sp.csr_matrix(xp.asarray(a / nnz_per_row * n))
+
+
+def _depths(node_array, predecessors, n):
+    depth = numpy.full(n, -1)
+    for v in node_array:
+        p = predecessors[v]
+        depth[v] = 0 if p < 0 else depth[p] + 1
+    return depth
+
+
+@testing.parameterize(*testing.product({
+    'n': [1, 30, 3000],
+    'nnz_per_row': [1, 3, 30],
+    'directed': [True, False],
+}))
+@unittest.skipUnless(scipy_available, 'requires scipy')
+class TestBreadthFirstOrder(unittest.TestCase):
+
+    def test_breadth_first_order(self):
+        a = _make_graph(cupy, cupyx.scipy.sparse, self.n, self.nnz_per_row)
+        nodes, pred = cupyx.scipy.sparse.csgraph.breadth_first_order(
+            a, 0, directed=self.directed)
+        expected = scipy.sparse.csgraph.shortest_path(
+            a.get(), directed=self.directed, unweighted=True, indices=0)
+        nodes, pred = nodes.get(), pred.get()
+        assert nodes[0] == 0
+        reached = numpy.isfinite(expected)
+        assert sorted(nodes) == list(numpy.nonzero(reached)[0])
+        depth = _depths(nodes, pred, self.n)
+        testing.assert_array_equal(depth[reached], expected[reached])
+        # the levels are in order
+        assert (numpy.diff(depth[nodes]) >= 0).all()
+        testing.assert_array_equal(pred[~reached], -9999)
+
+    def test_without_predecessors(self):
+        a = _make_graph(cupy, cupyx.scipy.sparse, self.n, self.nnz_per_row)
+        nodes = cupyx.scipy.sparse.csgraph.breadth_first_order(
+            a, 0, directed=self.directed, return_predecessors=False)
+        expected = scipy.sparse.csgraph.breadth_first_order(
+            a.get(), 0, directed=self.directed, return_predecessors=False)
+        assert sorted(nodes.get()) == sorted(expected)
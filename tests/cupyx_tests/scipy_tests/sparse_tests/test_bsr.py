@@ -0,0 +1,183 @@
+import numpy
+import pytest
+try:
+    import scipy.sparse  # NOQA
+    scipy_available = True
+except ImportError:
+    scipy_available = False
+
+import cupy
+from cupy import testing
+from cupyx.scipy import sparse
+
+
+def _make_dense(xp, dtype, shape, blocksize, density=0.3, seed=0):
+    # a random matrix made of full blocks, with some zeros in the blocks
+    M, N = shape
+    R, C = blocksize
+    rng = numpy.random.RandomState(seed)
+    mask = rng.rand(M // R, N // C) < density
+    mask = numpy.kron(mask, numpy.ones(blocksize, dtype=bool))
+    a = testing.shaped_random(shape, numpy, dtype, seed=seed)
+    a[~mask] = 0
+    a[0, 0] = 0
+    return xp.asarray(a)
+
+
+@testing.parameterize(*testing.product({
+    'dtype': [numpy.float32, numpy.float64, numpy.complex64, numpy.complex128],
+    'blocksize': [(1, 1), (2, 2), (3, 3), (2, 3)],
+}))
+@testing.with_requires('scipy')
+class TestBsrMatrix:
+
+    shape = (12, 18)
+
+    def _make(self, xp, sp):
+        a = _make_dense(xp, self.dtype, self.shape, self.blocksize)
+        return sp.bsr_matrix(a, blocksize=self.blocksize)
+
+    def test_blocksize(self):
+        m = self._make(cupy, sparse)
+        assert m.format == 'bsr'
+        assert m.blocksize == self.blocksize
+        assert m.dtype == self.dtype
+        assert sparse.isspmatrix_bsr(m)
+        assert not sparse.isspmatrix_bsr(m.tocsr())
+
+    @testing.numpy_cupy_equal(sp_name='sp')
+    def test_nnz(self, xp, sp):
+        return self._make(xp, sp).nnz
+
+    @testing.numpy_cupy_array_equal(sp_name='sp')
+    def test_toarray(self, xp, sp):
+        return self._make(xp, sp).toarray()
+
+    @testing.numpy_cupy_array_equal(sp_name='sp')
+    def test_toarray_f_order(self, xp, sp):
+        a = self._make(xp, sp).toarray(order='F')
+        assert a.flags.f_contiguous
+        return a
+
+    @testing.numpy_cupy_allclose(sp_name='sp')
+    def test_tocsr(self, xp, sp):
+        m = self._make(xp, sp).tocsr()
+        assert m.format == 'csr'
+        return m
+
+    @testing.numpy_cupy_allclose(sp_name='sp')
+    def test_from_csr(self, xp, sp):
+        a = _make_dense(xp, self.dtype, self.shape, self.blocksize)
+        m = sp.csr_matrix(a).tobsr(blocksize=self.blocksize)
+        assert m.blocksize == self.blocksize
+        return m
+
+    @testing.numpy_cupy_allclose(sp_name='sp')
+    def test_from_tuple(self, xp, sp):
+        m = self._make(xp, sp)
+        m = sp.bsr_matrix((m.data, m.indices, m.indptr), shape=self.shape)
+        assert m.blocksize == self.blocksize
+        return m
+
+    @testing.numpy_cupy_allclose(sp_name='sp')
+    def test_transpose(self, xp, sp):
+        m = self._make(xp, sp).T
+        assert m.blocksize == self.blocksize[::-1]
+        return m
+
+    def test_get(self):
+        m = self._make(cupy, sparse)
+        expected = self._make(numpy, scipy.sparse)
+        testing.assert_array_equal(m.get().toarray(), expected.toarray())
+
+    @testing.numpy_cupy_allclose(sp_name='sp', rtol=1e-5)
+    def test_mul_vector(self, xp, sp):
+        x = testing.shaped_random((self.shape[1],), xp, self.dtype, seed=1)
+        return self._make(xp, sp) * x
+
+    @testing.numpy_cupy_allclose(sp_name='sp', rtol=1e-5)
+    def test_mul_matrix(self, xp, sp):
+        x = testing.shaped_random((self.shape[1], 5), xp, self.dtype, seed=1)
+        return self._make(xp, sp) @ x
+
+    @testing.numpy_cupy_allclose(sp_name='sp')
+    def test_mul_scalar(self, xp, sp):
+        return self._make(xp, sp) * 2
+
+    @testing.numpy_cupy_allclose(sp_name='sp', rtol=1e-5)
+    def test_mul_sparse(self, xp, sp):
+        b = sp.csr_matrix(
+            _make_dense(xp, self.dtype, self.shape[::-1], (1, 1), seed=2))
+        return self._make(xp, sp) * b
+
+
+@testing.with_requires('scipy')
+class TestBsrMatrixInit:
+
+    @pytest.mark.parametrize('shape,blocksize', [
+        ((8, 8), (2, 2)), ((16, 16), (4, 4)), ((36, 36), (6, 6)),
+        ((12, 18), (3, 3)), ((7, 9), (1, 1))])
+    @testing.numpy_cupy_equal(sp_name='sp')
+    def test_estimated_blocksize(self, xp, sp, shape, blocksize):
+        a = _make_dense(xp, numpy.float64, shape, blocksize, density=0.5)
+        return sp.csr_matrix(a).tobsr().blocksize
+
+    @testing.numpy_cupy_allclose(sp_name='sp')
+    def test_from_coo(self, xp, sp):
+        data = xp.array([1, 2, 3, 4], 'f')
+        row = xp.array([0, 0, 3, 3], 'i')
+        col = xp.array([0, 0, 2, 5], 'i')
+        return sp.bsr_matrix((data, (row, col)), shape=(4, 6),
+                             blocksize=(2, 2))
+
+    def test_shape(self):
+        m = sparse.bsr_matrix((4, 6), blocksize=(2, 3))
+        assert m.shape == (4, 6)
+        assert m.blocksize == (2, 3)
+        assert m.nnz == 0
+        testing.assert_array_equal(m.toarray(), cupy.zeros((4, 6)))
+
+    def test_invalid_blocksize(self):
+        with pytest.raises(ValueError):
+            sparse.bsr_matrix((4, 6), blocksize=(3, 3))
+        a = cupy.ones((4, 6))
+        with pytest.raises(ValueError):
+            sparse.bsr_matrix(a, blocksize=(4, 4))
+
+    def test_invalid_indptr(self):
+        data = cupy.ones((1, 2, 2))
+        indices = cupy.array([0], 'i')
+        indptr = cupy.array([0, 1], 'i')
+        with pytest.raises(ValueError):
+            sparse.bsr_matrix((data, indices, indptr), shape=(4, 4))
+
+
+@testing.parameterize(*testing.product({
+    'blocksize': [(16, 16), (32, 16), (4, 4)],
+    'n': [1, 16, 20],
+}))
+class TestBsrMatrixFloat16:
+
+    shape = (64, 96)
+
+    def test_mul(self):
+        a = _make_dense(cupy, numpy.float16, self.shape, self.blocksize)
+        m = sparse.bsr_matrix(a, blocksize=self.blocksize)
+        assert m.dtype == numpy.float16
+        x = testing.shaped_random((self.shape[1], self.n), cupy,
+                                  numpy.float16, seed=1)
+        y = m @ x
+        assert y.dtype == numpy.float16
+        expected = a.astype(numpy.float32) @ x.astype(numpy.float32)
+        testing.assert_allclose(y.astype(numpy.float32), expected,
+                                rtol=1e-2, atol=1e-2)
+
+    def test_mul_vector(self):
+        a = _make_dense(cupy, numpy.float16, self.shape, self.blocksize)
+        m = sparse.bsr_matrix(a, blocksize=self.blocksize)
+        x = testing.shaped_random((self.shape[1],), cupy, numpy.float16,
+                                  seed=1)
+        y = m * x
+        expected = a.astype(numpy.float32) @ x.astype(numpy.float32)
+        testing.assert_allclose(y.astype(numpy.float32), expected,
+                                rtol=1e-2, atol=1e-2)
@@ -1094,6 +1094,49 @@ class TestCooMatrixSumDuplicates:
         return m
 
 
+@testing.parameterize(*testing.product({
+    'dtype': '?ifdFD',
+}))
+@testing.with_requires('scipy')
+class TestCooMatrixSumDuplicatesLarge:
+
+    shape = (300, 500)
+
+    def _make(self, xp, sp):
+        # short rows, and a few rows longer than the insertion sorts
+        rng = numpy.random.RandomState(0)
+        row = numpy.concatenate((
+            rng.randint(0, self.shape[0], 3000),
+            numpy.repeat([3, 100, 299], 400)))
+        col = rng.randint(0, self.shape[1], row.size)
+        data = testing.shaped_random((row.size,), numpy, self.dtype, seed=0)
+        return sp.coo_matrix(
+            (xp.asarray(data), (xp.asarray(row, 'i'), xp.asarray(col, 'i'))),
+            shape=self.shape)
+
+    @testing.numpy_cupy_allclose(sp_name='sp', rtol=1e-5)
+    def test_tocsr(self, xp, sp):
+        m = self._make(xp, sp).tocsr()
+        assert m.has_canonical_format
+        return m.indptr, m.indices, m.data
+
+    @testing.numpy_cupy_allclose(sp_name='sp', rtol=1e-5)
+    def test_tocsc(self, xp, sp):
+        m = self._make(xp, sp).tocsc()
+        assert m.has_canonical_format
+        return m.indptr, m.indices, m.data
+
+    @testing.numpy_cupy_allclose(sp_name='sp', rtol=1e-5)
+    def test_sum_duplicates(self, xp, sp):
+        m = self._make(xp, sp)
+        m.sum_duplicates()
+        assert m.has_canonical_format
+        # sorted by row then by column, as cuSPARSE does
+        order = numpy.lexsort((cupy.asnumpy(m.col), cupy.asnumpy(m.row)))
+        testing.assert_array_equal(order, numpy.arange(m.nnz))
+        return m
+
+
 @testing.parameterize(*testing.product({
     'dtype': [numpy.float32, numpy.float64, numpy.complex64, numpy.complex128],
     'ufunc': [
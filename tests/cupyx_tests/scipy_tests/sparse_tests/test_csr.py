@@ -1799,16 +1799,11 @@ class TestCsrMatrixGetitem2:
         return _make(xp, sp, self.dtype)[None:4]
 
 
-# CUB SpMV works only when the matrix size is nonzero
 @testing.parameterize(*testing.product({
     'make_method': ['_make', '_make_unordered', '_make_duplicate'],
     'dtype': [numpy.float32, numpy.float64, cupy.complex64, cupy.complex128],
 }))
 @testing.with_requires('scipy')
-@pytest.mark.skipif(
-    cupy.cuda.cub._get_cuda_build_version() >= 11000,
-    reason='CUDA built-in CUB SpMV is buggy, see cupy/cupy#3822')
-@pytest.mark.skipif(runtime.is_hip, reason='hipCUB does not provide spmv')
 @pytest.mark.skipif(
     not cupy.cuda.cub.available,
     reason='The CUB routine is not enabled')
@@ -1839,6 +1834,46 @@ class TestCubSpmv:
         # ...then perform the actual computation
         return m * x
 
+    @testing.numpy_cupy_allclose(sp_name='sp')
+    def test_mul_dense_matrix(self, xp, sp):
+        m = self.make(xp, sp, self.dtype)
+        x = xp.arange(4 * 3).reshape(4, 3).astype(self.dtype)
+        if xp is numpy:
+            return m * x
+
+        func = 'cupyx.scipy.sparse._csr.cub.device_csrmm'
+        with testing.AssertFunctionIsCalled(func):
+            m * x
+        return m * x
+
+    def _make_large(self, xp, sp):
+        # a row much longer than the share of a thread, and empty rows
+        a = testing.shaped_random((3000, 500), xp, self.dtype, seed=0)
+        a[a.real < 8] = 0
+        a[7] = 1
+        a[10:20] = 0
+        return sp.csr_matrix(a)
+
+    @testing.numpy_cupy_allclose(sp_name='sp', rtol=1e-4)
+    def test_mul_dense_vector_large(self, xp, sp):
+        m = self._make_large(xp, sp)
+        x = testing.shaped_random((500,), xp, self.dtype, seed=1)
+        return m * x
+
+    @testing.numpy_cupy_allclose(sp_name='sp', rtol=1e-4)
+    def test_mul_dense_matrix_large(self, xp, sp):
+        m = self._make_large(xp, sp)
+        x = testing.shaped_random((500, 40), xp, self.dtype, seed=1)
+        return m * x
+
+    def test_csrmv_int64_indices(self):
+        m = self._make_large(cupy, sparse)
+        x = testing.shaped_random((500,), cupy, self.dtype, seed=1)
+        y = cupy.cuda.cub.device_csrmv(
+            m.shape[0], m.shape[1], m.nnz, m.data, m.indptr.astype('q'),
+            m.indices.astype('q'), x)
+        testing.assert_allclose(y, m.toarray() @ x, rtol=1e-4)
+
 
 @testing.parameterize(*testing.product({
     'a_dtype': ['float32', 'float64', 'complex64', 'complex128'],
@@ -2194,3 +2229,75 @@ class TestCsrMatrixDiagonal:
                 scipy_a.setdiag(x, k=k)
             with pytest.raises(ValueError):
                 cupyx_a.setdiag(x, k=k)
+
+
+@testing.parameterize(*testing.product({
+    'accelerators': [['cub'], []],
+}))
+@testing.with_requires('scipy')
+class TestExclusiveScanOffsets:
+
+    # the offsets built by an exclusive scan, with and without CUB
+
+    @pytest.fixture(autouse=True)
+    def accelerators(self):
+        if self.accelerators and not cupy.cuda.cub.available:
+            pytest.skip('The CUB routine is not enabled')
+        old_accelerators = _accelerator.get_routine_accelerators()
+        _accelerator.set_routine_accelerators(self.accelerators)
+        yield
+        _accelerator.set_routine_accelerators(old_accelerators)
+
+    def _make(self, xp, sp, shape=(40, 30)):
+        a = testing.shaped_random(shape, xp, numpy.float64, seed=0)
+        a[a < 0.7] = 0
+        return sp.csr_matrix(a)
+
+    def test_exclusive_cumsum(self):
+        from cupyx.scipy.sparse import _util
+        counts = cupy.array([3, 0, 2, 5, 0, 1], dtype=numpy.int32)
+        x = cupy.empty(counts.size + 1, dtype=numpy.int32)
+        x[:-1] = counts
+        out = _util._exclusive_cumsum(x)
+        assert out is x
+        testing.assert_array_equal(x, [0, 3, 3, 5, 10, 10, 11])
+
+    @testing.numpy_cupy_array_equal(sp_name='sp')
+    def test_coo_tocsr(self, xp, sp):
+        row = xp.array([3, 0, 3, 1, 5, 0], dtype=numpy.int32)
+        col = xp.array([1, 2, 1, 0, 4, 2], dtype=numpy.int32)
+        data = xp.arange(6, dtype=numpy.float64)
+        m = sp.coo_matrix((data, (row, col)), shape=(7, 6)).tocsr()
+        return m.indptr, m.toarray()
+
+    @testing.numpy_cupy_array_equal(sp_name='sp')
+    def test_minor_axis_slice(self, xp, sp):
+        m = self._make(xp, sp)[:, 5:17]
+        return m.indptr, m.toarray()
+
+    @testing.numpy_cupy_array_equal(sp_name='sp')
+    def test_row_index(self, xp, sp):
+        rows = xp.array([7, 0, 39, 7, 12], dtype=numpy.int32)
+        m = self._make(xp, sp)[rows]
+        return m.indptr, m.toarray()
+
+    @testing.numpy_cupy_array_equal(sp_name='sp')
+    def test_insert(self, xp, sp):
+        m = self._make(xp, sp)
+        with warnings.catch_warnings():
+            warnings.simplefilter('ignore', sp.SparseEfficiencyWarning)
+            m[xp.array([0, 3, 3, 39]), xp.array([29, 0, 1, 5])] = 2.
+        m.sort_indices()
+        return m.indptr, m.toarray()
+
+    @testing.numpy_cupy_array_equal(sp_name='sp')
+    def test_bsr(self, xp, sp):
+        m = self._make(xp, sp).tobsr(blocksize=(4, 5))
+        return m.indptr, m.toarray()
+
+    @testing.numpy_cupy_array_equal(sp_name='sp')
+    def test_dia_tocsc(self, xp, sp):
+        data = xp.arange(12, dtype=numpy.float64).reshape(3, 4)
+        data[1, 2] = 0
+        m = sp.dia_matrix((data, [0, -1, 2]), shape=(5, 4)).tocsc()
+        return m.indptr, m.toarray()
@@ -242,6 +242,46 @@ class TestEigsh:
         assert cupy.linalg.norm(v - v_v0) < cupy.linalg.norm(v - v_aux)
 
 
+@testing.parameterize(*testing.product({
+    'which': ['LM', 'LA', 'SA'],
+    'k': [16, 20],
+    'return_eigenvectors': [True, False],
+}))
+@testing.with_requires('scipy')
+class TestEigshBlock:
+    n = 200
+    tol = {numpy.float32: 1e-4, numpy.complex64: 1e-4, 'default': 1e-10}
+    res_tol = {'f': 1e-4, 'd': 1e-10}
+
+    def _make_matrix(self, dtype, xp, sp):
+        # a graph Laplacian, shifted to have eigenvalues of both signs
+        a = testing.shaped_random((self.n, self.n), xp, dtype='f', scale=1)
+        a = ((a + a.T) > 1.5).astype(dtype)
+        a = xp.diag(a.sum(axis=1)) - a - 4 * xp.eye(self.n, dtype=dtype)
+        if numpy.dtype(dtype).kind == 'c':
+            a = a + 1j * (xp.triu(a, 1) - xp.tril(a, -1)) / 4
+        return sp.csr_matrix(a)
+
+    @testing.for_dtypes('fdFD')
+    @testing.numpy_cupy_allclose(rtol=tol, atol=tol, sp_name='sp')
+    def test_sparse(self, dtype, xp, sp):
+        a = self._make_matrix(dtype, xp, sp)
+        ret = sp.linalg.eigsh(a, k=self.k, which=self.which,
+                              return_eigenvectors=self.return_eigenvectors)
+        if self.return_eigenvectors:
+            w, x = ret
+            ax_xw = a @ x - xp.multiply(x, w.reshape(1, self.k))
+            res = xp.linalg.norm(ax_xw) / xp.linalg.norm(w)
+            tol = self.res_tol[numpy.dtype(a.dtype).char.lower()]
+            assert (res < tol)
+            # the eigenvectors are orthonormal
+            testing.assert_allclose(x.conj().T @ x, xp.eye(self.k),
+                                    atol=tol * 10)
+        else:
+            w = ret
+        return xp.sort(w)
+
+
 @testing.parameterize(*testing.product({
     'shape': [(30, 29), (29, 29), (29, 30)],
     'k': [3, 6, 12],
@@ -465,6 +505,40 @@ class TestCg:
             sp.linalg.cg(ng_a, b, atol=self.atol)
 
 
+@testing.with_requires('scipy>=1.12')
+class TestCgIterations:
+
+    def _make(self, xp, sp, dtype, n=200):
+        a = scipy.sparse.random(n, n, density=0.02, format='csr',
+                                dtype=dtype, random_state=0)
+        a = (a @ a.T + scipy.sparse.identity(n, dtype=dtype)).tocsr()
+        b = testing.shaped_random((n,), xp, dtype=dtype, seed=1)
+        return sp.csr_matrix(a), b
+
+    @testing.for_dtypes('fd')
+    @testing.numpy_cupy_allclose(rtol=1e-4, atol=1e-4, sp_name='sp')
+    def test_csr(self, dtype, xp, sp):
+        a, b = self._make(xp, sp, dtype)
+        return sp.linalg.cg(a, b)
+
+    @pytest.mark.parametrize('maxiter', [1, 3, 25])
+    @testing.numpy_cupy_allclose(rtol=1e-6, atol=1e-6, sp_name='sp')
+    def test_maxiter(self, xp, sp, maxiter):
+        a, b = self._make(xp, sp, numpy.float64)
+        x, info = sp.linalg.cg(a, b, rtol=1e-30, maxiter=maxiter)
+        assert info == maxiter
+        return x
+
+    def test_callback_count(self):
+        a, b = self._make(cupy, sparse, numpy.float64)
+        xs = []
+        x, info = sparse.linalg.cg(a, b, rtol=1e-30, maxiter=7,
+                                   callback=lambda x: xs.append(x.copy()))
+        assert info == 7
+        assert len(xs) == 7
+        testing.assert_array_equal(xs[-1], x)
+
+
 @testing.parameterize(*testing.product({
     'x0': [None, 'ones'],
     'M': [None, 'jacobi'],
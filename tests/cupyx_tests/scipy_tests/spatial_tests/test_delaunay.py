@@ -70,6 +70,22 @@ class TestDelaunay:
         tri = scp.spatial.Delaunay(points)
         return xp.sort(xp.sort(tri.simplices, axis=-1), axis=0)
 
+    @pytest.mark.parametrize('n_points', [10000, 100000])
+    @testing.numpy_cupy_allclose(scipy_name='scp')
+    def test_2d_triangulation_many_points(self, n_points, xp, scp):
+        # many insertion and flipping rounds, in both active triangle modes
+        points = testing.shaped_random((n_points, 2), xp, xp.float64)
+        tri = scp.spatial.Delaunay(points)
+        return xp.sort(xp.sort(tri.simplices, axis=-1), axis=0)
+
+    @testing.numpy_cupy_allclose(scipy_name='scp')
+    def test_2d_grid(self, xp, scp):
+        # cocircular points, which are flipped in the exact rounds
+        x, y = xp.meshgrid(xp.arange(64.0), xp.arange(64.0))
+        points = xp.stack([x.ravel(), y.ravel()], axis=-1)
+        tri = scp.spatial.Delaunay(points)
+        return points[tri.simplices].max(), points[tri.simplices].min()
+
     @pytest.mark.parametrize(
         'dataset', [pathological_data_1, pathological_data_2])
     @testing.numpy_cupy_allclose(scipy_name='scp')
@@ -230,3 +230,98 @@ class TestDistanceFunction(unittest.TestCase):
         a = self._make_matrix(xp, self.dtype, self.order)
         out = scp.spatial.distance.sqeuclidean(a, a)
         return out
+
+
+@testing.with_requires("scipy")
+@testing.parameterize(*testing.product({
+    'dtype': ['float32', 'float64'],
+    'shape': [(1, 3, 1), (70, 130, 17), (150, 65, 40)],
+    'metric': ['euclidean', 'sqeuclidean', 'cityblock', 'chebyshev',
+               'minkowski', 'cosine'],
+    'p': [2.0, 3.0],
+}))
+@pytest.mark.skipif(not scipy_available, reason='requires scipy')
+class TestCdistNative:
+
+    def _make_matrices(self, xp):
+        m, n, d = self.shape
+        a = testing.shaped_random((m, d), xp, self.dtype, scale=1, seed=0)
+        b = testing.shaped_random((n, d), xp, self.dtype, scale=1, seed=1)
+        return a, b
+
+    def _expected(self):
+        a, b = self._make_matrices(numpy)
+        kwargs = {'p': self.p} if self.metric == 'minkowski' else {}
+        return scipy.spatial.distance.cdist(a, b, self.metric, **kwargs)
+
+    @testing.numpy_cupy_allclose(rtol=1e-4, atol=1e-5, scipy_name='scp',
+                                 type_check=False)
+    def test_cdist(self, xp, scp):
+        a, b = self._make_matrices(xp)
+        kwargs = {'p': self.p} if self.metric == 'minkowski' else {}
+        return scp.spatial.distance.cdist(a, b, self.metric, **kwargs)
+
+    def test_cdist_topk(self):
+        a, b = self._make_matrices(cupy)
+        k = min(5, b.shape[0])
+        dists, idx = cupyx.scipy.spatial.distance.cdist_topk(
+            a, b, k, self.metric, p=self.p)
+        assert dists.dtype == self.dtype
+        assert dists.shape == idx.shape == (a.shape[0], k)
+        expected = self._expected()
+        rows = numpy.arange(a.shape[0])[:, None]
+        testing.assert_allclose(
+            dists, numpy.sort(expected, axis=1)[:, :k], rtol=1e-4, atol=1e-5)
+        testing.assert_allclose(
+            expected[rows, idx.get()], dists, rtol=1e-4, atol=1e-5)
+        assert (numpy.diff(dists.get(), axis=1) >= 0).all()
+
+    def test_cdist_threshold(self):
+        a, b = self._make_matrices(cupy)
+        expected = self._expected()
+        threshold = numpy.median(expected)
+        rows, cols, dists = cupyx.scipy.spatial.distance.cdist_threshold(
+            a, b, threshold, self.metric, p=self.p)
+        # the pairs on the edge can be missed or added by the rounding
+        inside = expected <= threshold * (1 - 1e-4)
+        outside = expected > threshold * (1 + 1e-4)
+        found = numpy.zeros(expected.shape, dtype=bool)
+        found[rows.get(), cols.get()] = True
+        assert found[inside].all()
+        assert not found[outside].any()
+        order = numpy.lexsort((cols.get(), rows.get()))
+        assert (order == numpy.arange(order.size)).all()
+        testing.assert_allclose(
+            dists, expected[rows.get(), cols.get()], rtol=1e-4, atol=1e-5)
+
+
+@pytest.mark.skipif(not scipy_available, reason='requires scipy')
+class TestCdistTopk:
+
+    def test_ties(self):
+        a = cupy.zeros((3, 2), dtype=numpy.float32)
+        b = cupy.zeros((200, 2), dtype=numpy.float32)
+        b[150:] = 1
+        dists, idx = cupyx.scipy.spatial.distance.cdist_topk(a, b, 100)
+        testing.assert_array_equal(dists, 0)
+        testing.assert_array_equal(idx, cupy.arange(100)[None].repeat(3, 0))
+
+    def test_all(self):
+        a = testing.shaped_random((10, 3), cupy, numpy.float64, seed=0)
+        b = testing.shaped_random((300, 3), cupy, numpy.float64, seed=1)
+        dists, idx = cupyx.scipy.spatial.distance.cdist_topk(a, b, 300)
+        full = cupyx.scipy.spatial.distance.cdist(a, b)
+        testing.assert_array_equal(
+            cupy.sort(idx, axis=1), cupy.arange(300)[None].repeat(10, 0))
+        testing.assert_allclose(dists, cupy.sort(full, axis=1), rtol=1e-5)
+
+    @pytest.mark.parametrize('k', [0, 4])
+    def test_invalid_k(self, k):
+        a = cupy.zeros((3, 2))
+        with pytest.raises(ValueError):
+            cupyx.scipy.spatial.distance.cdist_topk(a, a, k)
+
+    def test_invalid_metric(self):
+        a = cupy.zeros((3, 2))
+        with pytest.raises(NotImplementedError):
+            cupyx.scipy.spatial.distance.cdist_topk(a, a, 1, 'canberra')
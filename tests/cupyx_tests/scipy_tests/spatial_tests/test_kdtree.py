@@ -42,6 +42,37 @@ def create_small_kd_tree(xp, scp, n_points=1):
     return x, tree
 
 
+def _check_left_balanced(tree, n_dims):
+    # The points of the left (right) subtree of each node are not larger
+    # (smaller) than the node along the dimension of its level.
+    n = tree.shape[0]
+    lo = np.full((n, n_dims), -np.inf)
+    hi = np.full((n, n_dims), np.inf)
+    for i in range(n):
+        assert (lo[i] <= tree[i]).all() and (tree[i] <= hi[i]).all()
+        dim = int(np.log2(i + 1)) % n_dims
+        for child, bound in ((2 * i + 1, hi), (2 * i + 2, lo)):
+            if child < n:
+                lo[child] = lo[i]
+                hi[child] = hi[i]
+                bound[child, dim] = tree[i, dim]
+
+
+class TestConstruction:
+    @pytest.mark.parametrize('n, m', [(1, 2), (2, 3), (7, 2), (3000, 3)])
+    @pytest.mark.parametrize('dtype', [
+        np.float16, np.float32, np.float64, np.int16, np.int64, np.uint8])
+    def test_left_balanced(self, n, m, dtype):
+        from cupyx.scipy.spatial._kdtree_utils import asm_kd_tree
+        data = testing.shaped_random((n, m), cupy, dtype, scale=200, seed=0)
+        if np.dtype(dtype).kind == 'f':
+            data -= 100
+        tree, index = asm_kd_tree(data)
+        testing.assert_array_equal(tree, data[index])
+        testing.assert_array_equal(cupy.sort(index), cupy.arange(n))
+        _check_left_balanced(tree.get().astype(np.float64), m)
+
+
 @testing.with_requires('scipy')
 class TestRandomConsistency:
     @pytest.mark.parametrize('args', [
@@ -125,6 +156,36 @@ class TestRandomConsistency:
         return dd, ii
 
 
+@testing.with_requires('scipy')
+class TestLargeK:
+    @pytest.mark.parametrize('k', [16, 33, 64, 200])
+    @pytest.mark.parametrize('n', [20, 3000])
+    @pytest.mark.parametrize('dtype', [np.float32, np.float64])
+    @testing.numpy_cupy_allclose(scipy_name='scp', rtol=1e-5)
+    def test_query(self, xp, scp, k, n, dtype):
+        data = testing.shaped_random((n, 3), xp, dtype, seed=1234)
+        x = testing.shaped_random((50, 3), xp, dtype, seed=0)
+        tree = scp.spatial.KDTree(data)
+        return tree.query(x, k)
+
+    @pytest.mark.parametrize('p', [1, 2, np.inf])
+    @testing.numpy_cupy_allclose(scipy_name='scp')
+    def test_distance_upper_bound(self, xp, scp, p):
+        data = testing.shaped_random((1000, 2), xp, xp.float64, seed=1234)
+        x = testing.shaped_random((50, 2), xp, xp.float64, seed=0)
+        tree = scp.spatial.KDTree(data)
+        return tree.query(x, 20, p=p, distance_upper_bound=0.1)
+
+    @pytest.mark.parametrize('k', [4, 32])
+    @testing.numpy_cupy_allclose(scipy_name='scp')
+    def test_many_queries(self, xp, scp, k):
+        # the query points are reordered along a Morton curve
+        data = testing.shaped_random((1000, 3), xp, xp.float64, seed=1234)
+        x = testing.shaped_random((1 << 14, 3), xp, xp.float64, seed=0)
+        tree = scp.spatial.KDTree(data)
+        return tree.query(x, k)
+
+
 @testing.with_requires('scipy')
 class TestSmall:
     @testing.numpy_cupy_allclose(scipy_name='scp')
@@ -1,5 +1,8 @@
 import unittest
 
+import numpy
+import pytest
+
 import cupy
 from cupy import testing
 import cupyx.scipy.special  # NOQA
@@ -63,6 +66,33 @@ class TestSpecial:
         return scp.special.yn(n[:, xp.newaxis], a[xp.newaxis, :])
 
 
+    @testing.for_dtypes('fd')
+    @testing.numpy_cupy_allclose(atol={numpy.float32: 1e-6, 'default': 1e-12},
+                                 rtol={numpy.float32: 1e-6, 'default': 1e-10},
+                                 scipy_name='scp')
+    def test_jn_orders(self, xp, scp, dtype):
+        a = xp.linspace(-50, 50, 100, dtype=dtype).reshape(2, 50)
+        if xp is numpy:
+            n = numpy.arange(81)
+            return scp.special.jv(n, a[..., None]).astype(dtype)
+        return scp.special.jn_orders(80, a)
+
+    @testing.for_dtypes('fd')
+    @testing.numpy_cupy_allclose(atol={numpy.float32: 1e-6, 'default': 1e-12},
+                                 rtol={numpy.float32: 1e-6, 'default': 1e-10},
+                                 scipy_name='scp')
+    def test_yn_orders(self, xp, scp, dtype):
+        a = xp.array([0, 1e-3, 0.5, 3, 7.5, 40, -1, numpy.nan], dtype=dtype)
+        if xp is numpy:
+            n = numpy.arange(21)
+            return scp.special.yn(n, a[:, None]).astype(dtype)
+        return scp.special.yn_orders(20, a)
+
+    def test_orders_invalid(self):
+        with pytest.raises(ValueError):
+            cupyx.scipy.special.jn_orders(-1, cupy.ones(3))
+
+
 @testing.with_requires('scipy')
 class TestFusionSpecial(unittest.TestCase):
 
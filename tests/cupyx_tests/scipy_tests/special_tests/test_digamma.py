@@ -9,7 +9,9 @@ import numpy
 class TestDigamma(unittest.TestCase):
 
     @testing.for_all_dtypes()
-    @testing.numpy_cupy_allclose(atol=1e-13, rtol=1e-15, scipy_name='scp')
+    @testing.numpy_cupy_allclose(atol={numpy.float32: 1e-6, 'default': 1e-13},
+                                 rtol={numpy.float32: 1e-6, 'default': 1e-15},
+                                 scipy_name='scp')
     def test_arange(self, xp, scp, dtype):
         import scipy.special  # NOQA
 
@@ -17,7 +19,9 @@ class TestDigamma(unittest.TestCase):
         return scp.special.digamma(a)
 
     @testing.for_all_dtypes()
-    @testing.numpy_cupy_allclose(atol=1e-13, rtol=1e-10, scipy_name='scp')
+    @testing.numpy_cupy_allclose(atol={numpy.float32: 1e-6, 'default': 1e-13},
+                                 rtol={numpy.float32: 1e-6, 'default': 1e-10},
+                                 scipy_name='scp')
     def test_linspace_positive(self, xp, scp, dtype):
         import scipy.special  # NOQA
 
@@ -26,7 +30,9 @@ class TestDigamma(unittest.TestCase):
         return scp.special.digamma(a)
 
     @testing.for_all_dtypes()
-    @testing.numpy_cupy_allclose(atol=1e-13, rtol=1e-10, scipy_name='scp')
+    @testing.numpy_cupy_allclose(atol={numpy.float32: 2e-6, 'default': 1e-13},
+                                 rtol={numpy.float32: 2e-6, 'default': 1e-10},
+                                 scipy_name='scp')
     def test_linspace_negative(self, xp, scp, dtype):
         import scipy.special  # NOQA
 
@@ -35,7 +41,9 @@ class TestDigamma(unittest.TestCase):
         return scp.special.digamma(a)
 
     @testing.for_all_dtypes()
-    @testing.numpy_cupy_allclose(atol=1e-13, rtol=1e-10, scipy_name='scp')
+    @testing.numpy_cupy_allclose(atol={numpy.float32: 1e-6, 'default': 1e-13},
+                                 rtol={numpy.float32: 1e-6, 'default': 1e-10},
+                                 scipy_name='scp')
     def test_scalar(self, xp, scp, dtype):
         import scipy.special  # NOQA
 
@@ -63,3 +71,14 @@ class TestDigamma(unittest.TestCase):
         x, y = xp.meshgrid(x, y)
         z = (x + y*1j).ravel()
         return scp.special.digamma(z)
+
+    @testing.numpy_cupy_allclose(atol=1e-6, rtol=1.5e-6, scipy_name='scp')
+    def test_float32_ranges(self, xp, scp):
+        import scipy.special  # NOQA
+
+        a = numpy.concatenate([
+            numpy.geomspace(1e-6, 1e30, 1000),
+            numpy.linspace(1, 2, 1000),
+            numpy.linspace(-5.9, -0.1, 1000),
+        ]).astype(numpy.float32)
+        return scp.special.digamma(xp.asarray(a))
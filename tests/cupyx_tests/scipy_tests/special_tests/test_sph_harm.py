@@ -26,3 +26,18 @@ class TestBasic():
         phi = xp.linspace(0, cp.pi)
         theta, phi = xp.meshgrid(theta, phi)
         return scp.special.sph_harm(m, n, theta, phi)
+
+    @testing.for_dtypes(["f", "d"])
+    @numpy_cupy_allclose(atol=1e-6, rtol=1e-5, scipy_name="scp")
+    def test_sph_harm_orders(self, xp, scp, dtype):
+        n_max = 6
+        theta = xp.linspace(0, 2 * cp.pi, 7, dtype=dtype)
+        phi = xp.linspace(0, cp.pi, 5, dtype=dtype)[:, None]
+        if xp is not cp:
+            out = xp.zeros((5, 7, n_max + 1, 2 * n_max + 1),
+                           dtype=xp.result_type(dtype, xp.complex64))
+            for m, n in _get_harmonic_list(n_max):
+                out[..., n, n_max + m] = scp.special.sph_harm(
+                    m, n, theta, phi)
+            return out
+        return scp.special.sph_harm_orders(n_max, theta, phi)
@@ -27,3 +27,27 @@ class TestSphericalBessel:
         n = xp.arange(0, 10, dtype=order_dtype)
         a = xp.linspace(-10, 10, 100, dtype=dtype)
         return scp.special.spherical_yn(n[xp.newaxis, :], a[:, xp.newaxis])
+
+    @testing.for_float_dtypes(no_float16=True)
+    @testing.numpy_cupy_allclose(atol={numpy.float32: 1e-6, 'default': 1e-12},
+                                 rtol={numpy.float32: 1e-6, 'default': 1e-10},
+                                 scipy_name='scp')
+    def test_spherical_jn_orders(self, xp, scp, dtype):
+        a = xp.array([0, 1e-3, 0.5, 3, -7.5, 40, 200, numpy.nan],
+                     dtype=dtype)
+        if xp is numpy:
+            n = numpy.arange(61)
+            return scp.special.spherical_jn(n, a[:, None]).astype(dtype)
+        return scp.special.spherical_jn_orders(60, a)
+
+    @testing.for_float_dtypes(no_float16=True)
+    @testing.numpy_cupy_allclose(atol={numpy.float32: 1e-6, 'default': 1e-12},
+                                 rtol={numpy.float32: 1e-6, 'default': 1e-10},
+                                 scipy_name='scp')
+    def test_spherical_yn_orders(self, xp, scp, dtype):
+        a = xp.array([0, 0.5, 3, -7.5, 40, numpy.inf, numpy.nan],
+                     dtype=dtype)
+        if xp is numpy:
+            n = numpy.arange(11)
+            return scp.special.spherical_yn(n, a[:, None]).astype(dtype)
+        return scp.special.spherical_yn_orders(10, a)
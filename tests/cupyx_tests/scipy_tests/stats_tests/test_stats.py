@@ -242,3 +242,62 @@ class TestZscore:
             x = xp.array([1, 2, 3, xp.nan], dtype=dtype)
             with pytest.raises(ValueError):
                 scp.stats.zscore(x, nan_policy='raise')
+
+
+moments_rtol = {'default': 1e-5, cupy.float32: 1e-3}
+moments_atol = {'default': 1e-6, cupy.float32: 1e-4}
+
+
+@testing.with_requires('scipy')
+class TestSkewKurtosis:
+
+    @pytest.mark.parametrize('shape, axis', [
+        ((100,), 0), ((20, 30), 0), ((20, 30), 1), ((4, 5, 6), None)])
+    @pytest.mark.parametrize('bias', [True, False])
+    @testing.for_dtypes('ilfd')
+    @testing.numpy_cupy_allclose(
+        scipy_name='scp', rtol=moments_rtol, atol=moments_atol)
+    def test_skew(self, xp, scp, dtype, shape, axis, bias):
+        a = testing.shaped_random(shape, xp, dtype, scale=10)
+        return scp.stats.skew(a, axis=axis, bias=bias)
+
+    @pytest.mark.parametrize('shape, axis', [
+        ((100,), 0), ((20, 30), 0), ((20, 30), 1), ((4, 5, 6), None)])
+    @pytest.mark.parametrize('fisher', [True, False])
+    @pytest.mark.parametrize('bias', [True, False])
+    @testing.for_dtypes('ilfd')
+    @testing.numpy_cupy_allclose(
+        scipy_name='scp', rtol=moments_rtol, atol=moments_atol)
+    def test_kurtosis(self, xp, scp, dtype, shape, axis, fisher, bias):
+        a = testing.shaped_random(shape, xp, dtype, scale=10)
+        return scp.stats.kurtosis(a, axis=axis, fisher=fisher, bias=bias)
+
+    @pytest.mark.filterwarnings('ignore::RuntimeWarning')
+    @testing.numpy_cupy_allclose(scipy_name='scp')
+    def test_constant(self, xp, scp):
+        a = xp.full((3, 10), 4.0)
+        return scp.stats.skew(a, axis=1), scp.stats.kurtosis(a, axis=1)
+
+    @testing.numpy_cupy_allclose(scipy_name='scp')
+    def test_nan_propagate(self, xp, scp):
+        a = testing.shaped_random((10,), xp, numpy.float64)
+        a[3] = xp.nan
+        return scp.stats.skew(a), scp.stats.kurtosis(a)
+
+    def test_nan_omit(self):
+        a = testing.shaped_random((40,), cupy, numpy.float64)
+        b = a.copy()
+        b[::5] = cupy.nan
+        expected = scipy.stats.skew(b[~cupy.isnan(b)].get())
+        testing.assert_allclose(
+            cupyx.scipy.stats.skew(b, nan_policy='omit'), expected)
+        expected = scipy.stats.kurtosis(b[~cupy.isnan(b)].get())
+        testing.assert_allclose(
+            cupyx.scipy.stats.kurtosis(b, nan_policy='omit'), expected)
+
+    def test_nan_raise(self):
+        a = cupy.array([1, 2, cupy.nan])
+        with pytest.raises(ValueError):
+            cupyx.scipy.stats.skew(a, nan_policy='raise')
+        with pytest.raises(ValueError):
+            cupyx.scipy.stats.kurtosis(a, nan_policy='foo')
@@ -0,0 +1,77 @@
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx.scipy.signal
+from cupyx import signal
+
+
+class TestFindPeaksBatch:
+
+    conditions = [
+        {},
+        {'height': 0, 'threshold': (None, None)},
+        {'distance': 40},
+        {'prominence': 1.5, 'distance': 10},
+        {'width': (2, None), 'prominence': (None, None), 'wlen': 101},
+        {'plateau_size': (None, None), 'rel_height': 0.8,
+         'width': (None, None)},
+    ]
+
+    def _signals(self, shape):
+        x = testing.shaped_random(shape, cupy, cupy.float64, seed=1)
+        x = cupy.cumsum(x - 0.5, axis=-1)
+        return cupy.around(x, 1)
+
+    @pytest.mark.parametrize('shape', [(1, 700), (5, 3000), (2, 3, 600)])
+    @pytest.mark.parametrize('kwargs', conditions)
+    def test_find_peaks_batch(self, shape, kwargs):
+        x = self._signals(shape)
+        indices, props = signal.find_peaks_batch(x, **kwargs)
+        rows = x.reshape(-1, shape[-1])
+        for i, row in enumerate(rows):
+            peaks, expected = cupyx.scipy.signal.find_peaks(row, **kwargs)
+            index = cupy.unravel_index(cupy.array([i]), shape[:-1])
+            mask = cupy.ones(indices[-1].size, dtype=bool)
+            for coord, j in zip(indices[:-1], index):
+                mask &= coord == j
+            testing.assert_array_equal(indices[-1][mask], peaks)
+            assert props.keys() == expected.keys()
+            for key in expected:
+                testing.assert_allclose(props[key][mask], expected[key])
+
+    @pytest.mark.parametrize('kwargs', conditions[1:4])
+    def test_axis(self, kwargs):
+        x = self._signals((3, 800))
+        indices, props = signal.find_peaks_batch(x.T, axis=0, **kwargs)
+        expected_indices, expected = signal.find_peaks_batch(x, **kwargs)
+        # The peaks are ordered by signal either way
+        testing.assert_array_equal(indices[0], expected_indices[1])
+        testing.assert_array_equal(indices[1], expected_indices[0])
+        for key in expected:
+            testing.assert_allclose(props[key], expected[key])
+
+    def test_array_condition(self):
+        x = self._signals((4, 500))
+        height = cupy.broadcast_to(
+            cupy.linspace(-1, 1, 4)[:, None], x.shape).copy()
+        indices, props = signal.find_peaks_batch(x, height=height)
+        for i in range(4):
+            peaks, _ = cupyx.scipy.signal.find_peaks(x[i], height=height[i])
+            testing.assert_array_equal(indices[1][indices[0] == i], peaks)
+        indices_t, _ = signal.find_peaks_batch(x.T, height=height.T, axis=0)
+        testing.assert_array_equal(indices_t[0], indices[1])
+
+    def test_empty(self):
+        for shape in [(3, 0), (3, 2), (0, 10)]:
+            indices, props = signal.find_peaks_batch(
+                cupy.zeros(shape), prominence=1)
+            assert len(indices) == 2
+            assert all(i.size == 0 for i in indices)
+            assert props['prominences'].size == 0
+
+    def test_raises(self):
+        with pytest.raises(ValueError, match='1-D'):
+            signal.find_peaks_batch(cupy.array(1.))
+        with pytest.raises(ValueError, match='distance'):
+            signal.find_peaks_batch(cupy.ones((2, 10)), distance=0.5)
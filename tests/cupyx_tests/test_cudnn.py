@@ -1,3 +1,4 @@
+import json
 import sys
 
 import numpy
@@ -455,3 +456,34 @@ class TestConvolutionNoAvailableAlgorithm:
             return RuntimeError
         else:
             return libcudnn.CuDNNError
+
+
+@pytest.mark.skipif(not cudnn_enabled, reason='cuDNN is not available')
+class TestAlgorithmCache:
+
+    def _forward(self, x):
+        W = cupy.ones((4, 3, 3, 3), numpy.float32)
+        y = cupy.empty((2, 4, 6, 6), numpy.float32)
+        cudnn.convolution_forward(
+            x, W, None, y, (1, 1), (1, 1), (1, 1), 1,
+            auto_tune=True, tensor_core='never')
+        return y
+
+    def test_save_load(self, tmp_path):
+        x = cupy.ones((2, 3, 6, 6), numpy.float32)
+        y1 = self._forward(x)
+        path = str(tmp_path / 'algorithms.json')
+        cudnn.save_algorithm_cache(path)
+        with open(path) as f:
+            entries = json.load(f)
+        assert len(entries['cudnn_conv_fwd']) >= 1
+        cudnn.load_algorithm_cache(path)
+        # the cached descriptors and algorithms give the same result
+        testing.assert_array_equal(self._forward(x), y1)
+
+    def test_load_invalid(self, tmp_path):
+        path = str(tmp_path / 'algorithms.json')
+        with open(path, 'w') as f:
+            json.dump({'reduction': {}}, f)
+        with pytest.raises(ValueError):
+            cudnn.load_algorithm_cache(path)
@@ -314,3 +314,39 @@ class TestCsrlsvqr:
                                     reorder=self.reorder)
         cupy.testing.assert_allclose(x, ref_x, rtol=test_tol,
                                      atol=test_tol)
+
+
+@testing.parameterize(*testing.product({
+    'dtype': [numpy.float32, numpy.float64, numpy.complex64, numpy.complex128],
+    'batch_size': [1, 3, 10],
+}))
+class TestBatchStreams:
+    # the loop-based batched solvers spread the matrices over streams
+
+    def _make(self, shape):
+        a = testing.shaped_random(shape, numpy, self.dtype, seed=0)
+        return a + numpy.eye(shape[-2], shape[-1], dtype=self.dtype)
+
+    def _tol(self):
+        if self.dtype in (numpy.float32, numpy.complex64):
+            return 1e-4
+        return 1e-10
+
+    @pytest.mark.parametrize('use_stream', [False, True])
+    def test_svd(self, use_stream):
+        # larger than 32 x 32, so that the gesvd loop is used
+        a = self._make((self.batch_size, 40, 36))
+        stream = cupy.cuda.Stream() if use_stream else cupy.cuda.Stream.null
+        with stream:
+            s = cupy.linalg.svd(cupy.asarray(a), compute_uv=False)
+        expect = numpy.linalg.svd(a, compute_uv=False)
+        testing.assert_allclose(s, expect, rtol=self._tol())
+
+    @pytest.mark.parametrize('use_stream', [False, True])
+    def test_qr(self, use_stream):
+        a = self._make((self.batch_size, 8, 6))
+        stream = cupy.cuda.Stream() if use_stream else cupy.cuda.Stream.null
+        with stream:
+            q, r = cupy.linalg.qr(cupy.asarray(a))
+            aa = cupy.matmul(q, r)
+        testing.assert_allclose(aa, a, rtol=self._tol(), atol=self._tol())
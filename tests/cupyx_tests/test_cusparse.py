@@ -407,6 +407,62 @@ class TestSpgemm:
         testing.assert_array_almost_equal(c.toarray(), expect.toarray())
 
 
+@testing.parameterize(*testing.product({
+    'dtype': [numpy.float32, numpy.float64, numpy.complex64, numpy.complex128],
+    'shape': [(2, 3, 4), (4, 3, 2), (50, 40, 30)]
+}))
+@testing.with_requires('scipy>=1.2.0')
+class TestSpgemmPlan:
+
+    alpha = 0.5
+
+    @pytest.fixture(autouse=True)
+    def setUp(self):
+        if not cusparse.check_availability('spgemm_reuse'):
+            pytest.skip('spgemm_reuse is not available.')
+        m, n, k = self.shape
+        self.a = scipy.sparse.random(m, k, density=0.3, dtype=self.dtype,
+                                     format='csr')
+        self.b = scipy.sparse.random(k, n, density=0.3, dtype=self.dtype,
+                                     format='csr')
+
+    def _with_new_values(self, x):
+        x = x.copy()
+        x.data = testing.shaped_random(x.data.shape, numpy, self.dtype,
+                                       seed=1)
+        return x
+
+    def test_multiply(self):
+        plan = cusparse.spgemm_plan(sparse.csr_matrix(self.a),
+                                    sparse.csr_matrix(self.b))
+        c = plan.multiply(alpha=self.alpha)
+        expect = self.alpha * self.a.dot(self.b)
+        testing.assert_array_almost_equal(c.toarray(), expect.toarray())
+
+    def test_multiply_new_values(self):
+        plan = cusparse.spgemm_plan(sparse.csr_matrix(self.a),
+                                    sparse.csr_matrix(self.b))
+        c0 = plan.multiply()
+        a = self._with_new_values(self.a)
+        b = self._with_new_values(self.b)
+        c = plan.multiply(sparse.csr_matrix(a), sparse.csr_matrix(b),
+                          alpha=self.alpha)
+        expect = self.alpha * a.dot(b)
+        testing.assert_array_almost_equal(c.toarray(), expect.toarray())
+        # the previous product is not overwritten
+        testing.assert_array_almost_equal(
+            c0.toarray(), self.a.dot(self.b).toarray())
+
+    def test_multiply_invalid_structure(self):
+        plan = cusparse.spgemm_plan(sparse.csr_matrix(self.a),
+                                    sparse.csr_matrix(self.b))
+        a = sparse.csr_matrix(self.a[:-1])
+        with pytest.raises(ValueError):
+            plan.multiply(a)
+        with pytest.raises(TypeError):
+            plan.multiply(sparse.csc_matrix(self.a))
+
+
 @testing.with_requires('scipy')
 class TestSpgemmInvalidCases:
 
@@ -692,6 +748,31 @@ class TestSpmv:
         assert y is z
         testing.assert_array_almost_equal(y, expect)
 
+    def test_spmv_cached_descriptors(self):
+        if not cusparse.check_availability('spmv'):
+            pytest.skip('spmv is not available')
+        if runtime.is_hip:
+            if ((self.format == 'csr' and self.transa is True)
+                    or (self.format == 'csc' and self.transa is False)
+                    or (self.format == 'coo' and self.transa is True)):
+                pytest.xfail('may be buggy')
+
+        a = self.sparse_matrix(self.a)
+        if not a.has_canonical_format:
+            a.sum_duplicates()
+        x = cupy.array(self.x)
+        cusparse.spmv(a, x, transa=self.transa)
+        cache = a._descriptor_cache
+        y = cusparse.spmv(a, cupy.array(self.x), transa=self.transa)
+        assert a._descriptor_cache is cache
+        testing.assert_array_almost_equal(y, self.op_a.dot(self.x))
+
+        # the descriptors are recreated for the new arrays
+        a.data = a.data * 2
+        y = cusparse.spmv(a, x, transa=self.transa)
+        assert a._descriptor_cache is not cache
+        testing.assert_array_almost_equal(y, 2 * self.op_a.dot(self.x))
+
 
 @testing.with_requires('scipy')
 class TestErrorSpmv:
@@ -0,0 +1,70 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+
+try:
+    from cupyx import cusparselt
+except ImportError:
+    cusparselt = None
+
+
+def _prune_2_4(a):
+    # keeps the two largest of each group of four elements along the rows
+    g = a.reshape(a.shape[0], -1, 4)
+    order = numpy.argsort(numpy.abs(g), axis=-1)
+    numpy.put_along_axis(g, order[..., :2], 0, axis=-1)
+    return g.reshape(a.shape)
+
+
+@pytest.mark.skipif(cusparselt is None, reason='cuSPARSELt is unavailable')
+class TestStructuredSparseMatrix:
+
+    def _make(self, dtype):
+        a = testing.shaped_random((64, 128), numpy, dtype, scale=2, seed=0)
+        return _prune_2_4(a)
+
+    @pytest.mark.parametrize('dtype', [numpy.float16, numpy.int8])
+    @pytest.mark.parametrize('n', [32, 64])
+    def test_matmul(self, dtype, n):
+        a = self._make(dtype)
+        # small values, so that the int8 products do not overflow
+        b = testing.shaped_random((128, n), numpy, dtype, scale=2, seed=1)
+        s = cusparselt.StructuredSparseMatrix(cupy.asarray(a))
+        expected = a.astype(numpy.float32) @ b.astype(numpy.float32)
+        for _ in range(2):
+            c = s.matmul(cupy.asarray(b))
+            assert c.dtype == dtype
+            testing.assert_allclose(c.astype(numpy.float32), expected,
+                                    rtol=1e-2, atol=1e-1)
+        assert len(s._plans) == 1
+
+    def test_out(self):
+        a = self._make(numpy.float16)
+        b = testing.shaped_random((128, 32), cupy, numpy.float16, seed=1)
+        s = cusparselt.StructuredSparseMatrix(cupy.asarray(a))
+        out = cupy.empty((64, 32), numpy.float16)
+        assert s.matmul(b, out=out) is out
+        testing.assert_allclose(out, s @ b)
+
+    def test_prune(self):
+        a = testing.shaped_random((64, 128), cupy, numpy.float16, seed=0)
+        with pytest.raises(ValueError):
+            cusparselt.StructuredSparseMatrix(a)
+        s = cusparselt.StructuredSparseMatrix(a, prune='tile')
+        b = cupy.eye(128, dtype=numpy.float16)
+        c = s.matmul(b)
+        # every group of four holds at most two nonzeros of a
+        nonzeros = (c.reshape(64, -1, 4) != 0).sum(axis=-1)
+        assert int(nonzeros.max()) <= 2
+
+    def test_invalid(self):
+        a = cupy.asarray(self._make(numpy.float16))
+        s = cusparselt.StructuredSparseMatrix(a)
+        with pytest.raises(TypeError):
+            s.matmul(cupy.ones((128, 32), numpy.float32))
+        with pytest.raises(ValueError):
+            s.matmul(cupy.ones((64, 32), numpy.float16))
+        with pytest.raises(TypeError):
+            cusparselt.StructuredSparseMatrix(a.astype(numpy.float64))
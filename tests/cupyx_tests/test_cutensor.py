@@ -469,6 +469,51 @@ class TestCuTensorIncontiguous:
                                              rtol=self.tol, atol=self.tol)
 
 
+@testing.parameterize(*testing.product({
+    'dtype_char': ['f', 'd', 'F', 'D'],
+}))
+@pytest.mark.skipif(not ct.available, reason='cuTensor is unavailable')
+class TestCuTensorPermutedRoutines:
+
+    @pytest.fixture(autouse=True)
+    def setUp(self):
+        self.dtype = numpy.dtype(self.dtype_char)
+        self.tol = 1e-5 if self.dtype_char in 'fF' else 1e-12
+
+    def test_reduction(self):
+        a = testing.shaped_random(
+            (20, 30, 40), cupy, self.dtype).transpose(2, 0, 1)
+        out = cutensor._try_reduction_routine(
+            a, (0, 2), None, None, False, ct.OP_ADD, 1, 0)
+        assert out is not None
+        testing.assert_allclose(
+            out, cupy.asnumpy(a).sum(axis=(0, 2)),
+            rtol=self.tol, atol=self.tol)
+
+    def test_elementwise_binary(self):
+        a = testing.shaped_random(
+            (20, 30, 40), cupy, self.dtype, seed=0).transpose(1, 2, 0)
+        c = testing.shaped_random(
+            (40, 20, 30), cupy, self.dtype, seed=1).transpose(1, 2, 0)
+        out = cutensor._try_elementwise_binary_routine(
+            a, c, None, None, ct.OP_ADD, 1, 1)
+        assert out is not None
+        assert out.strides == c.strides
+        testing.assert_allclose(
+            out, cupy.asnumpy(a) + cupy.asnumpy(c),
+            rtol=self.tol, atol=self.tol)
+
+    def test_strided_operand(self):
+        a = testing.shaped_random((20, 30), cupy, self.dtype)
+        t = a.T
+        assert cutensor._strided_operand(t) is t
+        view = cutensor._strided_operand(a[:, None])
+        assert view.strides[1] == a.itemsize
+        assert cutensor._strided_operand(a[::-1]) is None
+        assert cutensor._strided_operand(
+            cupy.broadcast_to(a[0], (20, 30))) is None
+
+
 @testing.parameterize(*testing.product({
     'dtype_char': ['e', 'f', 'd', 'F', 'D'],
     'shape': [32],
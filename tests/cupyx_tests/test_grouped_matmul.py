@@ -0,0 +1,76 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx
+from cupyx import _grouped_matmul
+
+
+_shapes = [(3, 5, 7), (64, 64, 64), (130, 17, 65), (0, 4, 3), (4, 0, 3),
+           (5, 6, 0), (1, 200, 1), (97, 1, 300)]
+
+
+class TestGroupedMatmul:
+
+    def _operands(self, dtype):
+        a = [testing.shaped_random((m, k), numpy, dtype, seed=i)
+             for i, (m, n, k) in enumerate(_shapes)]
+        b = [testing.shaped_random((k, n), numpy, dtype, seed=i + 100)
+             for i, (m, n, k) in enumerate(_shapes)]
+        return a, b
+
+    def _check(self, dtype):
+        a, b = self._operands(dtype)
+        results = cupyx.grouped_matmul(
+            [cupy.asarray(x) for x in a], [cupy.asarray(y) for y in b])
+        assert len(results) == len(_shapes)
+        rtol = 1e-2 if dtype == numpy.float16 else 1e-5
+        for x, y, c in zip(a, b, results):
+            assert c.dtype == dtype
+            expected = x.astype(numpy.float64) @ y.astype(numpy.float64)
+            testing.assert_allclose(c, expected, rtol=rtol, atol=rtol)
+
+    @testing.for_float_dtypes()
+    def test_grouped_matmul(self, dtype):
+        self._check(dtype)
+
+    @testing.for_complex_dtypes()
+    def test_grouped_matmul_complex(self, dtype):
+        self._check(dtype)
+
+    @testing.for_float_dtypes(no_float16=True)
+    def test_native(self, dtype, monkeypatch):
+        monkeypatch.setattr(
+            _grouped_matmul, '_can_use_cublas', lambda dtype: False)
+        self._check(dtype)
+
+    def test_out(self):
+        a = [cupy.ones((3, 4)), cupy.ones((5, 2))]
+        b = [cupy.ones((4, 6)), cupy.ones((2, 1))]
+        out = [cupy.empty((3, 6)), cupy.empty((5, 1))]
+        results = cupyx.grouped_matmul(a, b, out=out)
+        assert results[0] is out[0] and results[1] is out[1]
+        testing.assert_array_equal(out[0], 4)
+        testing.assert_array_equal(out[1], 2)
+
+    def test_mixed_dtypes(self):
+        a = [cupy.ones((3, 4), numpy.float32), cupy.ones((5, 2))]
+        b = [cupy.ones((4, 6), numpy.float32), cupy.ones((2, 1))]
+        results = cupyx.grouped_matmul(a, b)
+        assert all(c.dtype == numpy.float64 for c in results)
+
+    def test_empty(self):
+        assert cupyx.grouped_matmul([], []) == []
+
+    def test_invalid(self):
+        with pytest.raises(ValueError):
+            cupyx.grouped_matmul([cupy.ones((3, 4))], [cupy.ones((5, 2))])
+        with pytest.raises(ValueError):
+            cupyx.grouped_matmul([cupy.ones((3, 4))], [])
+        with pytest.raises(TypeError):
+            cupyx.grouped_matmul([cupy.ones((3, 4), numpy.int32)],
+                                 [cupy.ones((4, 2), numpy.int32)])
+        with pytest.raises(ValueError):
+            cupyx.grouped_matmul([cupy.ones((3, 4))], [cupy.ones((4, 2))],
+                                 out=[cupy.empty((2, 3))])
@@ -0,0 +1,122 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx
+from cupyx import _kmeans
+
+
+def _nearest(x, centers):
+    d = ((x[:, None, :] - centers[None, :, :]) ** 2).sum(axis=2)
+    return d.argmin(axis=1), d.min(axis=1)
+
+
+def _blobs(n_per_cluster, k, d, dtype, seed=0):
+    rng = numpy.random.default_rng(seed)
+    centers = numpy.zeros((k, d))
+    for i in range(k):
+        centers[i, i % d] = 5 * (1 + i // d)
+    x = centers.repeat(n_per_cluster, axis=0)
+    x += rng.standard_normal(x.shape) * 0.1
+    perm = rng.permutation(len(x))
+    return cupy.asarray(x[perm], dtype=dtype), centers
+
+
+class TestNearestCentroid:
+
+    @pytest.mark.parametrize('n, k, d', [
+        (1, 1, 1),
+        (100, 3, 2),
+        (1000, 40, 33),
+        (513, 70, 200),
+    ])
+    @testing.for_float_dtypes(no_float16=True)
+    def test_nearest_centroid(self, dtype, n, k, d):
+        x = testing.shaped_random((n, d), cupy, dtype, seed=0)
+        centers = testing.shaped_random((k, d), cupy, dtype, seed=1)
+        labels, dists = cupyx.nearest_centroid(x, centers)
+        assert labels.dtype == numpy.int64
+        assert dists.dtype == dtype
+        expected_dists = _nearest(x, centers)[1]
+        testing.assert_allclose(dists, expected_dists, rtol=1e-4, atol=1e-4)
+        # the chosen centroid is at the minimum distance
+        chosen = ((x - centers[labels]) ** 2).sum(axis=1)
+        testing.assert_allclose(chosen, expected_dists, rtol=1e-4, atol=1e-4)
+
+    def test_nearest_centroid_ties(self):
+        x = cupy.zeros((10, 3), dtype=numpy.float32)
+        centers = cupy.ones((5, 3), dtype=numpy.float32)
+        labels, _ = cupyx.nearest_centroid(x, centers)
+        testing.assert_array_equal(labels, 0)
+
+    def test_nearest_centroid_chunks(self, monkeypatch):
+        monkeypatch.setattr(_kmeans, '_workspace_bytes', 4 * 7 * 5)
+        x = testing.shaped_random((100, 4), cupy, numpy.float32, seed=0)
+        centers = testing.shaped_random((5, 4), cupy, numpy.float32, seed=1)
+        labels, dists = cupyx.nearest_centroid(x, centers)
+        testing.assert_array_equal(labels, _nearest(x, centers)[0])
+        testing.assert_allclose(dists, _nearest(x, centers)[1], rtol=1e-5,
+                                atol=1e-5)
+
+    def test_nearest_centroid_float16(self):
+        x = testing.shaped_random((50, 3), cupy, numpy.float16, seed=0)
+        centers = testing.shaped_random((4, 3), cupy, numpy.float16, seed=1)
+        labels, dists = cupyx.nearest_centroid(x, centers)
+        assert dists.dtype == numpy.float32
+
+    def test_nearest_centroid_invalid(self):
+        x = cupy.zeros((10, 3))
+        with pytest.raises(ValueError):
+            cupyx.nearest_centroid(x, cupy.zeros((2, 4)))
+        with pytest.raises(ValueError):
+            cupyx.nearest_centroid(x, cupy.zeros((0, 3)))
+        with pytest.raises(ValueError):
+            cupyx.nearest_centroid(cupy.zeros(10), cupy.zeros((2, 1)))
+
+
+class TestKMeans:
+
+    @pytest.mark.parametrize('k, d', [
+        (1, 2),
+        (4, 2),
+        (8, 16),
+        # the sums do not fit in shared memory
+        (16, 600),
+    ])
+    @testing.for_float_dtypes(no_float16=True)
+    def test_kmeans(self, dtype, k, d):
+        x, expected = _blobs(200, k, d, dtype)
+        # start near the centroids of the blobs
+        init = expected + 0.05
+        centers, labels, inertia, n_iter = cupyx.kmeans(
+            x, k, init=init, check_interval=3)
+        assert centers.dtype == dtype
+        assert 1 <= n_iter < 300
+        testing.assert_allclose(centers, expected, atol=0.05)
+        expected_labels, dists = _nearest(x, centers)
+        testing.assert_array_equal(labels, expected_labels)
+        testing.assert_allclose(inertia, dists.sum(), rtol=1e-4)
+
+    def test_kmeans_random_init(self):
+        x, expected = _blobs(100, 3, 2, numpy.float64)
+        centers, labels, inertia, n_iter = cupyx.kmeans(x, 3, seed=0)
+        testing.assert_array_equal(labels, _nearest(x, centers)[0])
+        assert centers.shape == (3, 2)
+
+    def test_kmeans_max_iter(self):
+        x, expected = _blobs(100, 3, 2, numpy.float32)
+        _, _, _, n_iter = cupyx.kmeans(x, 3, max_iter=2, tol=0, seed=0)
+        assert n_iter == 2
+
+    def test_kmeans_invalid(self):
+        x = cupy.zeros((10, 2))
+        for k in (0, 11):
+            with pytest.raises(ValueError):
+                cupyx.kmeans(x, k)
+        with pytest.raises(ValueError):
+            cupyx.kmeans(x, 2, init=cupy.zeros((3, 2)))
+        with pytest.raises(ValueError):
+            cupyx.kmeans(x, 2, max_iter=0)
+        with pytest.raises(ValueError):
+            cupyx.kmeans(x, 2, check_interval=0)
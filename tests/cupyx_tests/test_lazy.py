@@ -0,0 +1,112 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx
+from cupyx import _lazy
+
+
+class TestLazyEvaluation:
+
+    def test_elementwise(self):
+        a = testing.shaped_random((3, 4), cupy, numpy.float32, seed=0)
+        b = testing.shaped_random((4,), cupy, numpy.float32, seed=1)
+        with cupyx.lazy_evaluation():
+            y = a * b + 1
+            z = cupy.exp(y) - y
+            assert isinstance(z, _lazy.LazyArray)
+            assert z.shape == (3, 4)
+            assert z.dtype == numpy.float32
+        ay = a * b + 1
+        testing.assert_allclose(z.compute(), cupy.exp(ay) - ay, rtol=1e-6)
+        assert isinstance(z.compute(), cupy.ndarray)
+        assert z.compute() is z.compute()
+
+    def test_not_lazy_outside(self):
+        a = cupy.arange(4)
+        with cupyx.lazy_evaluation():
+            pass
+        assert isinstance(a + 1, cupy.ndarray)
+
+    @testing.for_all_dtypes(no_bool=True)
+    def test_dtype(self, dtype):
+        a = testing.shaped_arange((2, 3), cupy, dtype)
+        with cupyx.lazy_evaluation():
+            ys = [a + 1, a * 2.5, a < 2, a / a, -a, a ** 2]
+        for y, expected in zip(ys, [a + 1, a * 2.5, a < 2, a / a, -a, a ** 2]):
+            assert y.dtype == expected.dtype
+            testing.assert_allclose(y.compute(), expected)
+
+    @testing.for_dtypes('bhilBHILfd')
+    def test_reduction_dtype(self, dtype):
+        a = testing.shaped_arange((2, 3), cupy, dtype)
+        with cupyx.lazy_evaluation():
+            ys = [(a + 0).sum(), (a + 0).max(axis=1), (a + 0).prod(axis=0)]
+        for y, expected in zip(ys, [a.sum(), a.max(axis=1), a.prod(axis=0)]):
+            assert y.dtype == expected.dtype
+            assert y.shape == expected.shape
+            testing.assert_allclose(y.compute(), expected)
+
+    @pytest.mark.parametrize('shape', [(3, 4), (2, 3, 5)])
+    def test_softmax(self, shape):
+        x = testing.shaped_random(shape, cupy, numpy.float32, seed=0)
+        with cupyx.lazy_evaluation():
+            e = cupy.exp(x - x.max(axis=-1, keepdims=True))
+            y = e / e.sum(axis=-1, keepdims=True)
+            assert y.shape == shape
+        e = cupy.exp(x - x.max(axis=-1, keepdims=True))
+        testing.assert_allclose(
+            y.compute(), e / e.sum(axis=-1, keepdims=True), rtol=1e-6)
+
+    def test_materialized_by_use(self):
+        a = cupy.arange(6, dtype=numpy.float64).reshape(2, 3)
+        expected = a * 2
+        with cupyx.lazy_evaluation():
+            y = a * 2
+            assert repr(y) == repr(expected)
+            numpy.testing.assert_array_equal(y.get(), expected.get())
+            numpy.testing.assert_array_equal(numpy.asarray(y), expected.get())
+            assert float(y.sum()) == 30
+            testing.assert_array_equal(y[1], expected[1])
+            # functions other than ufuncs take the value
+            testing.assert_array_equal(cupy.asarray(y), expected)
+            testing.assert_array_equal(
+                cupy.dot(y, expected.T), expected @ expected.T)
+
+    def test_out(self):
+        a = cupy.arange(4, dtype=numpy.float32)
+        out = cupy.empty_like(a)
+        with cupyx.lazy_evaluation():
+            y = a + 1
+            ret = cupy.multiply(y, 2, out=out)
+            assert ret is out
+        testing.assert_array_equal(out, (a + 1) * 2)
+
+    def test_reuse(self):
+        a = cupy.arange(4, dtype=numpy.float32)
+        with cupyx.lazy_evaluation():
+            y = a + 1
+            z1 = y * 2
+            y.compute()
+            z2 = y * 3
+        testing.assert_array_equal(z1.compute(), (a + 1) * 2)
+        testing.assert_array_equal(z2.compute(), (a + 1) * 3)
+
+    def test_max_ops(self):
+        a = cupy.zeros(4, dtype=numpy.float32)
+        with cupyx.lazy_evaluation():
+            y = a
+            for _ in range(_lazy._max_ops * 2):
+                y = y + 1
+        testing.assert_array_equal(y.compute(), a + _lazy._max_ops * 2)
+
+    def test_broadcast_error(self):
+        with cupyx.lazy_evaluation():
+            with pytest.raises(ValueError):
+                cupy.zeros(3) + cupy.zeros(4)
+
+    def test_get_array_module(self):
+        with cupyx.lazy_evaluation():
+            y = cupy.zeros(3) + 1
+        assert cupy.get_array_module(y) is cupy
@@ -0,0 +1,80 @@
+import os
+import tempfile
+
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx
+
+
+class TestDeviceMemmap:
+
+    @pytest.fixture(autouse=True)
+    def tmpdir(self):
+        with tempfile.TemporaryDirectory() as d:
+            self.dir = d
+            yield
+
+    def _save(self, a):
+        path = os.path.join(self.dir, 'a.npy')
+        numpy.save(path, a)
+        return path
+
+    @pytest.mark.parametrize('key', [
+        0, -1, 5, slice(None), slice(3, 17), slice(2, 40, 7),
+        slice(None, None, -3), (slice(4, 9), 2), (3, slice(1, 3)),
+        [0, 39, 3, 3], numpy.array([[1, 2], [30, 1]]), Ellipsis,
+        (Ellipsis, 1), (slice(5, 5),), [],
+    ])
+    def test_getitem(self, key):
+        a = testing.shaped_random((40, 6, 3), numpy, numpy.float32)
+        with cupyx.DeviceMemmap(self._save(a), tile_size=200) as m:
+            assert m.shape == a.shape
+            assert m.dtype == a.dtype
+            assert len(m) == 40
+            b = m[key]
+            assert isinstance(b, cupy.ndarray)
+            testing.assert_array_equal(b, a[key])
+
+    def test_raw(self):
+        a = testing.shaped_arange((10, 4), numpy, numpy.int16)
+        path = os.path.join(self.dir, 'a.bin')
+        with open(path, 'wb') as f:
+            f.write(b'\0' * 16)
+            f.write(a.tobytes())
+        m = cupyx.DeviceMemmap(path, dtype=a.dtype, shape=a.shape, offset=16)
+        testing.assert_array_equal(m[2:7], a[2:7])
+        m.close()
+
+    def test_cache(self):
+        a = testing.shaped_arange((100, 10), numpy, numpy.float64)
+        m = cupyx.DeviceMemmap(self._save(a), tile_size=800, cache_size=2400)
+        m.prefetch(slice(0, 30))
+        assert list(m._caches[cupy.cuda.get_device_id()]) == [0, 1, 2]
+        testing.assert_array_equal(m[95], a[95])
+        # the least recently used tile is dropped
+        assert list(m._caches[cupy.cuda.get_device_id()]) == [1, 2, 9]
+        m.clear_cache()
+        testing.assert_array_equal(m[10:20], a[10:20])
+        m.close()
+
+    def test_out_of_bounds(self):
+        a = numpy.zeros((10,), numpy.float32)
+        with cupyx.DeviceMemmap(self._save(a)) as m:
+            with pytest.raises(IndexError):
+                m[10]
+            with pytest.raises(IndexError):
+                m[[0, -11]]
+
+    def test_fortran_order(self):
+        a = numpy.asfortranarray(numpy.zeros((3, 4)))
+        with pytest.raises(ValueError):
+            cupyx.DeviceMemmap(self._save(a))
+
+    def test_closed(self):
+        m = cupyx.DeviceMemmap(self._save(numpy.zeros(3)))
+        m.close()
+        with pytest.raises(ValueError):
+            m[0]
@@ -0,0 +1,105 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx
+
+
+def _moments(a, axis=None):
+    # count, mean and the sums of the powers of the deviations
+    a = a.astype(numpy.float64)
+    mean = a.mean(axis=axis, keepdims=True)
+    d = a - mean
+    return numpy.stack([
+        numpy.broadcast_to(numpy.float64(a.size / mean.size),
+                           mean.squeeze(axis).shape),
+        mean.squeeze(axis),
+        (d ** 2).sum(axis=axis),
+        (d ** 3).sum(axis=axis),
+        (d ** 4).sum(axis=axis)])
+
+
+class TestMoments:
+
+    @pytest.mark.parametrize('shape, axis', [
+        ((1000,), None),
+        ((30, 40), 0),
+        ((30, 40), 1),
+        ((5, 6, 7), (0, 2)),
+    ])
+    @testing.for_dtypes('ilfd')
+    def test_moments(self, dtype, shape, axis):
+        a = testing.shaped_random(shape, numpy, dtype, scale=10)
+        state = cupyx.moments(cupy.asarray(a), axis=axis)
+        testing.assert_allclose(state.data, _moments(a, axis), rtol=1e-8,
+                                atol=1e-6)
+        testing.assert_allclose(state.var(ddof=1),
+                                a.var(axis=axis, ddof=1), rtol=1e-8)
+
+    def test_moments_keepdims(self):
+        a = testing.shaped_random((4, 5), cupy, numpy.float64)
+        state = cupyx.moments(a, axis=1, keepdims=True)
+        assert state.shape == (4, 1)
+        testing.assert_allclose(state.mean, a.mean(axis=1, keepdims=True))
+
+    def test_moments_large_offset(self):
+        # the deviations are accumulated, not the powers of the items
+        a_np = numpy.random.RandomState(0).standard_normal(10000) + 1e8
+        state = cupyx.moments(cupy.asarray(a_np))
+        testing.assert_allclose(state.var(), a_np.var(), rtol=1e-6)
+
+    def test_moments_skipna(self):
+        a_np = testing.shaped_random((20, 30), numpy, numpy.float64)
+        a_np[::3, ::4] = numpy.nan
+        a = cupy.asarray(a_np)
+        state = cupyx.moments(a, axis=1, skipna=True)
+        testing.assert_allclose(state.mean, numpy.nanmean(a_np, axis=1))
+        testing.assert_allclose(state.var(), numpy.nanvar(a_np, axis=1))
+        state = cupyx.moments(a, axis=1)
+        assert bool(cupy.isnan(state.mean[0]))
+
+    def test_moments_empty(self):
+        state = cupyx.moments(cupy.empty((0, 3)), axis=0)
+        testing.assert_array_equal(state.count, numpy.zeros(3))
+        assert bool(cupy.isnan(state.var()).all())
+
+    def test_moments_complex(self):
+        with pytest.raises(TypeError):
+            cupyx.moments(cupy.ones((3,), dtype=numpy.complex64))
+
+    def test_merge(self):
+        a_np = testing.shaped_random((100, 8), numpy, numpy.float64)
+        a = cupy.asarray(a_np)
+        left = cupyx.moments(a[:37], axis=0)
+        right = cupyx.moments(a[37:], axis=0)
+        merged = left.merge(right)
+        testing.assert_allclose(merged.data, _moments(a_np, 0), rtol=1e-10,
+                                atol=1e-10)
+
+    def test_merge_all(self):
+        a_np = testing.shaped_random((4, 50, 6), numpy, numpy.float64)
+        a = cupy.asarray(a_np)
+        # the states of four shards, as gathered from four devices
+        data = cupy.stack([cupyx.moments(a[i], axis=0).data for i in
+                           range(4)])
+        merged = cupyx.MomentState.merge_all(data)
+        expected = _moments(a_np.reshape(200, 6), 0)
+        testing.assert_allclose(merged.data, expected, rtol=1e-10,
+                                atol=1e-10)
+        merged = cupyx.MomentState.merge_all(cupy.moveaxis(data, 0, -1),
+                                             axis=-1)
+        testing.assert_allclose(merged.data, expected, rtol=1e-10,
+                                atol=1e-10)
+
+    def test_merge_empty_state(self):
+        a = testing.shaped_random((10,), cupy, numpy.float64)
+        state = cupyx.moments(a)
+        merged = state.merge(cupyx.moments(cupy.empty((0,))))
+        testing.assert_allclose(merged.data, state.data)
+
+    def test_invalid_state(self):
+        with pytest.raises(ValueError):
+            cupyx.MomentState(cupy.zeros((4, 3)))
+        with pytest.raises(ValueError):
+            cupyx.MomentState.merge_all(cupy.zeros((5, 2, 3)), axis=0)
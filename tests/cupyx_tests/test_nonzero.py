@@ -0,0 +1,50 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx
+
+
+class TestNonzeroAsync:
+
+    @pytest.mark.parametrize('shape', [(), (0,), (17,), (4, 5), (3, 0, 2),
+                                       (2, 3, 4), (1000,)])
+    @testing.for_all_dtypes()
+    def test_argwhere_async(self, dtype, shape):
+        a = testing.shaped_random(shape, cupy, dtype, seed=0)
+        indices, count = cupyx.argwhere_async(a)
+        assert isinstance(count, cupy.ndarray) and count.shape == ()
+        assert indices.shape == (a.size, a.ndim)
+        testing.assert_array_equal(
+            indices[:int(count)], numpy.argwhere(a.get()))
+
+    @pytest.mark.parametrize('shape', [(0,), (17,), (4, 5), (2, 3, 4)])
+    @testing.for_all_dtypes()
+    def test_flatnonzero_async(self, dtype, shape):
+        a = testing.shaped_random(shape, cupy, dtype, seed=0)
+        indices, count = cupyx.flatnonzero_async(a)
+        assert indices.shape == (a.size,)
+        testing.assert_array_equal(
+            indices[:int(count)], numpy.flatnonzero(a.get()))
+
+    def test_out(self):
+        a = cupy.array([[0, 1, 0], [2, 0, 3]])
+        out = cupy.full((10, 2), -1, dtype=cupy.int64)
+        indices, count = cupyx.argwhere_async(a, out=out)
+        assert indices is out
+        assert int(count) == 3
+        testing.assert_array_equal(out[:3], [[0, 1], [1, 0], [1, 2]])
+        flat = cupy.empty(6, dtype=cupy.int64)
+        indices, count = cupyx.flatnonzero_async(a, out=flat)
+        assert indices is flat
+        testing.assert_array_equal(flat[:int(count)], [1, 3, 5])
+
+    def test_invalid_out(self):
+        a = cupy.ones((2, 3))
+        with pytest.raises(ValueError):
+            cupyx.argwhere_async(a, out=cupy.empty((5, 2), cupy.int64))
+        with pytest.raises(ValueError):
+            cupyx.argwhere_async(a, out=cupy.empty((6, 2), cupy.int32))
+        with pytest.raises(ValueError):
+            cupyx.flatnonzero_async(a, out=cupy.empty((6, 1), cupy.int64))
@@ -0,0 +1,84 @@
+import io
+
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx
+
+
+@testing.parameterize(*testing.product({
+    'shape': [(), (0,), (1000,), (37, 11), (5, 7, 3)],
+    'chunk_size': [64, 1 << 20],
+    'n_buffers': [1, 2, 3],
+}))
+class TestPipelinedTransfer:
+
+    def test_to_device(self):
+        x = testing.shaped_random(self.shape, numpy, numpy.float32)
+        y = cupyx.to_device_pipelined(
+            x, chunk_size=self.chunk_size, n_buffers=self.n_buffers)
+        assert isinstance(y, cupy.ndarray)
+        testing.assert_array_equal(y, x)
+
+    def test_to_device_non_contiguous(self):
+        x = testing.shaped_random(self.shape, numpy, numpy.float64).T
+        y = cupyx.to_device_pipelined(
+            x, chunk_size=self.chunk_size, n_buffers=self.n_buffers)
+        assert y.flags.c_contiguous
+        testing.assert_array_equal(y, x)
+
+    def test_to_device_file(self):
+        x = testing.shaped_random(self.shape, numpy, numpy.int32)
+        f = io.BytesIO(x.tobytes())
+        y = cupyx.to_device_pipelined(
+            f, dtype=x.dtype, shape=x.shape, chunk_size=self.chunk_size,
+            n_buffers=self.n_buffers)
+        testing.assert_array_equal(y, x)
+
+    def test_to_host(self):
+        x = testing.shaped_random(self.shape, cupy, numpy.float32)
+        y = cupyx.to_host_pipelined(
+            x, chunk_size=self.chunk_size, n_buffers=self.n_buffers)
+        assert isinstance(y, numpy.ndarray)
+        testing.assert_array_equal(y, x)
+
+    def test_to_host_non_contiguous(self):
+        x = testing.shaped_random(self.shape, cupy, numpy.float32)
+        out = numpy.empty(self.shape[::-1], numpy.float32).T
+        y = cupyx.to_host_pipelined(
+            x, out, chunk_size=self.chunk_size, n_buffers=self.n_buffers)
+        assert y is out
+        testing.assert_array_equal(y, x)
+
+    def test_to_host_file(self):
+        x = testing.shaped_random(self.shape, cupy, numpy.int32)
+        f = io.BytesIO()
+        assert cupyx.to_host_pipelined(
+            x, f, chunk_size=self.chunk_size,
+            n_buffers=self.n_buffers) is f
+        assert f.getvalue() == x.get().tobytes()
+
+
+class TestPipelinedTransferInvalid:
+
+    def test_short_file(self):
+        with pytest.raises(EOFError):
+            cupyx.to_device_pipelined(
+                io.BytesIO(b'\0' * 10), dtype='f', shape=(10,))
+
+    def test_file_without_shape(self):
+        with pytest.raises(ValueError):
+            cupyx.to_device_pipelined(io.BytesIO(b''), dtype='f')
+
+    def test_out_mismatch(self):
+        with pytest.raises(ValueError):
+            cupyx.to_device_pipelined(
+                numpy.zeros(10), out=cupy.empty(9))
+
+    def test_invalid_args(self):
+        with pytest.raises(ValueError):
+            cupyx.to_device_pipelined(numpy.zeros(10), chunk_size=0)
+        with pytest.raises(ValueError):
+            cupyx.to_host_pipelined(cupy.zeros(10), n_buffers=0)
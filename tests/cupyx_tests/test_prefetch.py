@@ -0,0 +1,46 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx
+
+
+class TestPrefetchKernels:
+
+    def test_elementwise(self):
+        kernel = cupy.ElementwiseKernel(
+            'T x, T y', 'T z', 'z = x * y + 1', 'cupy_prefetch_test')
+        futures = cupyx.prefetch_kernels(
+            [(kernel, (numpy.float32, numpy.float32)),
+             (kernel, ('d', 'd'))])
+        assert [f.result() for f in futures] == [kernel, kernel]
+        assert set(kernel.cached_codes) == {('f', 'f', 'f'), ('d', 'd', 'd')}
+
+        x = testing.shaped_random((10, 3), cupy, numpy.float32)
+        testing.assert_allclose(kernel(x, x), x * x + 1)
+
+    def test_reduction_and_ufunc(self):
+        kernel = cupy.ReductionKernel(
+            'T x', 'T y', 'x * x', 'a + b', 'y = a', '0',
+            'cupy_prefetch_test_sum')
+        futures = cupyx.prefetch_kernels(
+            [(kernel, (numpy.float64,)), (cupy.add, ('i', 'i'))])
+        for f in futures:
+            f.result()
+        x = testing.shaped_random((100,), cupy, numpy.float64)
+        testing.assert_allclose(kernel(x), (x * x).sum())
+
+    def test_raw(self):
+        kernel = cupy.RawKernel(
+            r'extern "C" __global__ void cupy_prefetch_raw(int* x) {}',
+            'cupy_prefetch_raw')
+        future, = cupyx.prefetch_kernels([kernel])
+        assert future.result() is kernel
+
+    def test_error(self):
+        kernel = cupy.ElementwiseKernel(
+            'T x', 'T y', 'y = x +* 1', 'cupy_prefetch_broken')
+        future, = cupyx.prefetch_kernels([(kernel, ('f',))])
+        with pytest.raises(cupy.cuda.compiler.CompileException):
+            future.result()
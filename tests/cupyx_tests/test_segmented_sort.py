@@ -0,0 +1,54 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx
+
+
+def _segments(sizes):
+    return numpy.concatenate(([0], numpy.cumsum(sizes))).astype(numpy.int64)
+
+
+class TestSegmentedSort:
+
+    sizes = [0, 1, 5, 3000, 17, 0, 256, 2]
+
+    def _expected(self, a, offsets, kind):
+        parts = [a[s:e] for s, e in zip(offsets[:-1], offsets[1:])]
+        if kind == 'sort':
+            return numpy.concatenate([numpy.sort(p) for p in parts])
+        return numpy.concatenate([
+            s + numpy.argsort(p, kind='stable')
+            for s, p in zip(offsets[:-1], parts)])
+
+    @testing.for_all_dtypes(no_bool=True)
+    def test_segmented_sort(self, dtype):
+        offsets = _segments(self.sizes)
+        a = testing.shaped_random((int(offsets[-1]),), numpy, dtype)
+        out = cupyx.segmented_sort(cupy.asarray(a), cupy.asarray(offsets))
+        testing.assert_array_equal(out, self._expected(a, offsets, 'sort'))
+
+    @testing.for_all_dtypes(no_bool=True, no_complex=True)
+    def test_segmented_argsort(self, dtype):
+        offsets = _segments(self.sizes)
+        a = testing.shaped_random((int(offsets[-1]),), numpy, dtype)
+        idx = cupyx.segmented_argsort(cupy.asarray(a), cupy.asarray(offsets))
+        testing.assert_array_equal(idx, self._expected(a, offsets, 'argsort'))
+
+    @testing.for_float_dtypes(no_float16=True)
+    def test_segmented_sort_nan(self, dtype):
+        a = numpy.array([3, numpy.nan, -numpy.nan, 1, -0.0, 0.0, 2],
+                        dtype=dtype)
+        offsets = numpy.array([0, 4, 7])
+        out = cupyx.segmented_sort(cupy.asarray(a), cupy.asarray(offsets))
+        testing.assert_array_equal(out, self._expected(a, offsets, 'sort'))
+
+    def test_invalid_offsets(self):
+        a = cupy.arange(10)
+        with pytest.raises(ValueError):
+            cupyx.segmented_sort(a, cupy.array([], dtype=cupy.int64))
+        with pytest.raises(TypeError):
+            cupyx.segmented_sort(a, cupy.array([0.0, 10.0]))
+        with pytest.raises(ValueError):
+            cupyx.segmented_sort(a.reshape(2, 5), cupy.array([0, 10]))
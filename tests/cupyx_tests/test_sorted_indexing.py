@@ -0,0 +1,86 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx
+
+
+class TestSortedTake:
+
+    @pytest.mark.parametrize('shape, indices_shape, axis', [
+        ((1000, 16), (300,), 0),
+        ((1000, 16), (20, 15), 0),
+        ((7, 50, 3), (40,), 1),
+        ((6, 5), (9,), None),
+        ((30,), (), 0),
+        ((0, 4), (0,), 0),
+    ])
+    @testing.for_all_dtypes()
+    @testing.numpy_cupy_array_equal()
+    def test_sorted_take(self, xp, dtype, shape, indices_shape, axis):
+        a = testing.shaped_arange(shape, xp, dtype)
+        size = a.size if axis is None else shape[axis]
+        indices = testing.shaped_random(
+            indices_shape, xp, numpy.int64, scale=max(size, 1), seed=0)
+        if xp is numpy:
+            return numpy.take(a, indices, axis=axis)
+        return cupyx.sorted_take(a, indices, axis=axis)
+
+    @testing.numpy_cupy_array_equal()
+    def test_sorted_take_negative(self, xp):
+        a = testing.shaped_arange((10, 3), xp)
+        indices = xp.array([-1, 3, -10, 3, 0])
+        if xp is numpy:
+            return numpy.take(a, indices, axis=0)
+        return cupyx.sorted_take(a, indices, axis=0)
+
+    def test_invalid_indices(self):
+        a = cupy.arange(10)
+        with pytest.raises(TypeError):
+            cupyx.sorted_take(a, cupy.array([1.0]))
+        with pytest.raises(IndexError):
+            cupyx.sorted_take(cupy.empty((0,)), cupy.array([0]))
+
+
+class TestSortedScatterAdd:
+
+    @pytest.mark.parametrize('shape, indices_shape, axis', [
+        ((100, 8), (500,), 0),
+        ((100, 8), (20, 25), 0),
+        ((3, 40, 5), (70,), 1),
+        ((6, 5), (40,), None),
+        ((10,), (0,), 0),
+    ])
+    @testing.for_dtypes('ilfdFD')
+    @testing.numpy_cupy_allclose(rtol=1e-5)
+    def test_sorted_scatter_add(self, xp, dtype, shape, indices_shape, axis):
+        a = testing.shaped_arange(shape, xp, dtype)
+        size = a.size if axis is None else shape[axis]
+        indices = testing.shaped_random(
+            indices_shape, xp, numpy.int64, scale=size, seed=0)
+        if axis is None:
+            v_shape = indices_shape
+        else:
+            v_shape = shape[:axis] + indices_shape + shape[axis + 1:]
+        values = testing.shaped_random(v_shape, xp, dtype, seed=1)
+        if xp is numpy:
+            if axis is None:
+                numpy.add.at(a.reshape(-1), indices, values)
+            else:
+                index = (slice(None),) * axis + (indices,)
+                numpy.add.at(a, index, values)
+        else:
+            cupyx.sorted_scatter_add(a, indices, values, axis=axis)
+        return a
+
+    @testing.numpy_cupy_array_equal()
+    def test_sorted_scatter_add_non_contiguous(self, xp):
+        a = testing.shaped_arange((10, 6), xp, numpy.int64)
+        view = a[:, ::2]
+        indices = xp.array([1, 1, -1, 4])
+        if xp is numpy:
+            numpy.add.at(view, indices, 3)
+        else:
+            cupyx.sorted_scatter_add(view, indices, 3, axis=0)
+        return a
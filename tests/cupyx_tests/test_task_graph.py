@@ -0,0 +1,92 @@
+import pytest
+
+import cupy
+from cupy import testing
+from cupy_backends.cuda.api import runtime
+import cupyx
+
+
+class TestTaskGraph:
+
+    def test_dependencies(self):
+        x = testing.shaped_random((1000,), cupy, cupy.float32, seed=0)
+        y = testing.shaped_random((1000,), cupy, cupy.float32, seed=1)
+        with cupyx.TaskGraph() as g:
+            a = g.submit(cupy.sin, x)
+            b = g.submit(cupy.cos, y, priority=-1)
+            c = g.submit(cupy.add, a, b)
+            d = g.submit(lambda xs: xs[0] * xs[1], [c, a])
+        testing.assert_allclose(c.result, cupy.sin(x) + cupy.cos(y))
+        testing.assert_allclose(
+            d.result, (cupy.sin(x) + cupy.cos(y)) * cupy.sin(x))
+
+    def test_streams(self):
+        g = cupyx.TaskGraph(n_streams=2)
+        with g:
+            a = g.submit(cupy.arange, 10)
+            b = g.submit(cupy.arange, 20)
+            c = g.submit(lambda a: a + 1, a)
+            d = g.submit(lambda a: a + 2, a, priority=-1)
+        # independent tasks are spread, chains stay on a stream
+        assert a._lane is not b._lane
+        assert c._lane is a._lane
+        assert d._lane.priority == -1
+        testing.assert_array_equal(b.result, cupy.arange(20))
+        testing.assert_array_equal(d.result, cupy.arange(10) + 2)
+
+    def test_depends_on(self):
+        x = cupy.zeros(1000, dtype=cupy.int64)
+
+        def fill(v):
+            x[...] = v
+
+        with cupyx.TaskGraph() as g:
+            a = g.submit(fill, 3)
+            b = g.submit(lambda: x.sum(), depends_on=[a])
+        assert int(b.result) == 3000
+
+    def test_reuse(self):
+        g = cupyx.TaskGraph()
+        x = cupy.arange(100)
+        for i in range(3):
+            with g:
+                a = g.submit(lambda: x * i)
+                b = g.submit(lambda: x + i)
+                c = g.submit(cupy.add, a, b)
+            testing.assert_array_equal(c.result, x * i + x + i)
+
+    @pytest.mark.skipif(runtime.is_hip, reason='graph_function is a no-op')
+    def test_graph_function(self):
+        calls = []
+
+        @cupyx.graph_function
+        def f(x, y, out):
+            calls.append(None)
+            with cupyx.TaskGraph() as g:
+                a = g.submit(cupy.sin, x)
+                b = g.submit(cupy.cos, y)
+                g.submit(cupy.add, a, b, out=out)
+
+        x = testing.shaped_random((100,), cupy, cupy.float32, seed=0)
+        y = testing.shaped_random((100,), cupy, cupy.float32, seed=1)
+        out = cupy.empty_like(x)
+        for _ in range(2):
+            f(x, y, out)
+            testing.assert_allclose(out, cupy.sin(x) + cupy.cos(y))
+            x += 1
+        assert len(calls) == 1
+
+    def test_invalid(self):
+        with pytest.raises(ValueError):
+            cupyx.TaskGraph(n_streams=0)
+        g = cupyx.TaskGraph()
+        with pytest.raises(RuntimeError):
+            g.submit(cupy.arange, 3)
+        with g:
+            a = g.submit(cupy.arange, 3)
+        with g:
+            with pytest.raises(ValueError):
+                g.submit(cupy.negative, a)
+            with pytest.raises(RuntimeError):
+                with g:
+                    pass
@@ -0,0 +1,66 @@
+import numpy
+import pytest
+
+import cupy
+from cupy import testing
+import cupyx
+
+
+class TestTopk:
+
+    def _expected(self, a, k, axis, largest):
+        a = numpy.sort(a, axis=axis)
+        n = a.shape[axis]
+        if largest:
+            idx = numpy.arange(n - 1, n - 1 - k, -1)
+        else:
+            idx = numpy.arange(k)
+        return numpy.take(a, idx, axis=axis)
+
+    @pytest.mark.parametrize('shape, axis', [
+        ((1000,), -1), ((8, 3000), -1), ((3000, 4), 0)])
+    @pytest.mark.parametrize('largest', [True, False])
+    @testing.for_all_dtypes(no_bool=True, no_float16=True, no_complex=True)
+    def test_topk(self, shape, axis, largest, dtype):
+        a_np = testing.shaped_random(shape, numpy, dtype)
+        values, indices = cupyx.topk(cupy.asarray(a_np), 10, axis, largest)
+        expected = self._expected(a_np, 10, axis, largest)
+        testing.assert_array_equal(values, expected)
+        testing.assert_array_equal(
+            numpy.take_along_axis(a_np, indices.get(), axis=axis), expected)
+
+    @testing.for_dtypes('ilqfd')
+    def test_topk_ties(self, dtype):
+        a = cupy.zeros((2, 2048), dtype=dtype)
+        a[:, 100] = 1
+        values, indices = cupyx.topk(a, 3, largest=True)
+        testing.assert_array_equal(values, [[1, 0, 0], [1, 0, 0]])
+        testing.assert_array_equal(indices, [[100, 0, 1], [100, 0, 1]])
+
+    @testing.for_float_dtypes(no_float16=True)
+    def test_topk_nan(self, dtype):
+        a_np = numpy.arange(2000, dtype=dtype)
+        a_np[[5, 1000]] = numpy.nan
+        a_np[7] = -0.0
+        a = cupy.asarray(a_np)
+        values, _ = cupyx.topk(a, 4, largest=False)
+        testing.assert_array_equal(values, [0, 0, 1, 2])
+        values, indices = cupyx.topk(a, 3, largest=True)
+        testing.assert_array_equal(values, [numpy.nan, numpy.nan, 1999])
+        testing.assert_array_equal(indices, [5, 1000, 1999])
+
+    @testing.for_dtypes('?eF')
+    def test_topk_fallback(self, dtype):
+        a_np = testing.shaped_random((4, 50), numpy, dtype)
+        values, _ = cupyx.topk(cupy.asarray(a_np), 5, largest=False)
+        testing.assert_array_equal(values, numpy.sort(a_np, axis=-1)[:, :5])
+
+    def test_topk_zero(self):
+        a = cupy.arange(10, dtype=cupy.float32)
+        values, indices = cupyx.topk(a, 0)
+        assert values.shape == (0,) and indices.shape == (0,)
+
+    def test_topk_invalid_k(self):
+        a = cupy.arange(10)
+        with pytest.raises(ValueError):
+            cupyx.topk(a, 11)